@@ -1,3557 +1,6369 @@
-/** \file
-\brief Foundation module
-\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
-
-Part of CommonLib library. \n
-Encoding UTF-8, end of line CR+LF \n
-License: GNU LGPL. \n
-Documentation: \ref Module_Base \n
-Module components: \ref code_base
-*/
-#include "Base.hpp"
-#include <cstdio> // dla sprintf, sscanf
-#include <cctype> // dla tolower, isalnum itp.
-#include <ctime> // dla time potrzebnego w RandomGenerator
-#include <memory.h>
-#ifdef _WIN32
-	#include <windows.h>
-	#include <float.h> // dla _finite i _isnan
-    #include <intrin.h> // for _debugbreak
-#else
-	#include <sys/time.h> // dla gettimeofday
-#endif
-
-
-namespace common
-{
-
-namespace Internal
-{
-
-#ifdef _WIN32
-
-void DebugBreak()
-{
-    __debugbreak();
-}
-
-#endif // #ifdef _WIN32
-
-} // namespace Internal
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-// Oglne
-
-void SwapEndian16_Array(void *p, size_t count)
-{
-	uint16 *u = (uint16*)p;
-	for (size_t i = 0; i < count; i++)
-		SwapEndian16(&u[i]);
-}
-void SwapEndian32_Array(void *p, size_t count)
-{
-	uint32 *u = (uint32*)p;
-	for (size_t i = 0; i < count; i++)
-		SwapEndian32(&u[i]);
-}
-void SwapEndian64_Array(void *p, size_t count)
-{
-	uint64 *u = (uint64*)p;
-	for (size_t i = 0; i < count; i++)
-		SwapEndian64(&u[i]);
-}
-
-void SwapEndian16_Data(void *p, size_t count, ptrdiff_t stepBytes)
-{
-	char *bytes = (char*)p;
-	for (size_t i = 0; i < count; i++, bytes += stepBytes)
-		SwapEndian16(bytes);
-}
-void SwapEndian32_Data(void *p, size_t count, ptrdiff_t stepBytes)
-{
-	char *bytes = (char*)p;
-	for (size_t i = 0; i < count; i++, bytes += stepBytes)
-		SwapEndian32(bytes);
-}
-void SwapEndian64_Data(void *p, size_t count, ptrdiff_t stepBytes)
-{
-	char *bytes = (char*)p;
-	for (size_t i = 0; i < count; i++, bytes += stepBytes)
-		SwapEndian64(bytes);
-}
-
-void Wait(uint32 Miliseconds)
-{
-#ifdef _WIN32
-	Sleep(Miliseconds);
-#else
-	timeval t;
-	t.tv_sec = Miliseconds / 1000;
-	t.tv_usec = (Miliseconds % 1000) * 1000;
-	select(0, 0, 0, 0, &t);
-#endif
-}
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-// acuchy
-
-#ifdef _WIN32
-	const tchar * const EOL = _T("\r\n");
-#else
-	const tchar * const EOL = _T("\n");
-#endif
-
-const tstring EMPTY_STRING = tstring();
-
-// Liczba obslugiwanych stron kodowych
-static const int CHARSET_COUNT = 5;
-// Kody znakow poszczegolnych stron kodowych
-static const string CHARSET_CHARS[CHARSET_COUNT][18] = {
-	{ "\x61", "\x63", "\x65", "\x6C", "\x6E", "\x6F", "\x73", "\x7A", "\x7A",    // brak, male
-	  "\x41", "\x43", "\x45", "\x4C", "\x4E", "\x4F", "\x53", "\x5A", "\x5A", }, // brak, duze
-	{ "\xB9", "\xE6", "\xEA", "\xB3", "\xF1", "\xF3", "\x9C", "\x9F", "\xBF",    // Windows, male
-	  "\xA5", "\xC6", "\xCA", "\xA3", "\xD1", "\xD3", "\x8C", "\x8F", "\xAF", }, // Windows, duze
-	{ "\xB1", "\xE6", "\xEA", "\xB3", "\xF1", "\xF3", "\xB6", "\xBC", "\xBF",    // ISO, male
-	  "\xA1", "\xC6", "\xCA", "\xA3", "\xD1", "\xD3", "\xA6", "\xAC", "\xAF", }, // ISO, duze
-	{ "\xA5", "\x86", "\xA9", "\x88", "\xE4", "\xA2", "\x98", "\xAB", "\xBE",    // IBM, male
-	  "\xA4", "\x8F", "\xA8", "\x9D", "\xE3", "\xE0", "\x97", "\x8D", "\xBD", }, // IBM, duze
-	{ "\xC4\x85", "\xC4\x87", "\xC4\x99", "\xC5\x82", "\xC5\x84", "\xC3\xB3", "\xC5\x9B", "\xC5\xBA", "\xC5\xBC",    // UTF-8, male
-	  "\xC4\x84", "\xC4\x86", "\xC4\x98", "\xC5\x81", "\xC5\x83", "\xC3\x93", "\xC5\x9A", "\xC5\xB9", "\xC5\xBB", }, // UTF-8, duze
-};
-
-bool CharIsAlphaNumeric(tchar ch)
-{
-#ifdef _WIN32
-	return (IsCharAlphaNumeric(ch) != 0);
-#else
-	return (isalnum(static_cast<unsigned char>(ch)) != 0);
-#endif
-}
-
-bool CharIsAlpha(tchar ch)
-{
-#ifdef _WIN32
-	return (IsCharAlpha(ch) != 0);
-#else
-	return (isalpha(static_cast<unsigned char>(ch)) != 0);
-#endif
-}
-
-bool CharIsLower(tchar ch)
-{
-#ifdef _WIN32
-	return (IsCharLower(ch) != 0);
-#else
-	return (islower(static_cast<unsigned char>(ch)) != 0);
-#endif
-}
-
-bool CharIsUpper(tchar ch)
-{
-#ifdef _WIN32
-	return (IsCharUpper(ch) != 0);
-#else
-	return (isupper(static_cast<unsigned char>(ch)) != 0);
-#endif
-}
-
-bool CharIsWhitespace(char ch)
-{
-	return (isspace(static_cast<unsigned char>(ch)) != 0);
-}
-
-#ifdef _WIN32
-bool CharIsWhitespace(wchar_t ch)
-{
-	return (iswspace(ch) != 0);
-	// Z funkcj IsCharSpace z WinAPI s jakie cyrki - patrz MSDN.
-}
-#endif
-
-size_t StrStrI(const tstring &Str, const tstring &SubStr, size_t Count)
-{
-	const tchar *StrSz    = Str.c_str();
-	const tchar *SubStrSz = SubStr.c_str();
-	const tchar *R = StrStrI(StrSz, SubStrSz, Count);
-	return (R == NULL) ? SIZE_MAX : (R - StrSz);
-}
-
-const tchar * StrStrI(const tchar *Str, const tchar *SubStr, size_t Count)
-{
-	size_t nLen, nOffset, nMaxOffset, nStringLenInt;
-	const tchar *pPos;
-	assert(Str && SubStr);
-#ifdef _WIN32
-	nLen = _tcslen(SubStr);
-#else
-	nLen = strlen(SubStr);
-#endif
-	if (nLen == 0)
-		return Str;
-#ifdef _WIN32
-	size_t nStringToBeSearched = _tcslen(Str);
-#else
-	size_t nStringToBeSearched = strlen(Str);
-#endif
-	if (nLen > nStringToBeSearched)
-		return NULL;
-	if (Count > nStringToBeSearched)
-		nStringLenInt = nStringToBeSearched;
-	else
-		nStringLenInt = Count;
-	nMaxOffset = nStringLenInt - nLen;
-	pPos = Str;
-	for (nOffset = 0; nOffset <= nMaxOffset; nOffset++)
-	{
-		if (StrCmpI(pPos, SubStr, nLen) == 0)
-			return pPos;
-		pPos++;
-	}
-	return NULL;
-}
-
-void ReverseString(tstring *s)
-{
-	size_t i = 0;
-	size_t j = s->length()-1;
-	while (i < j)
-		std::swap( (*s)[i++], (*s)[j--] );
-}
-
-void Trim(tstring *s)
-{
-	if (s->empty()) return;
-	// pocztek
-	size_t i = 0;
-	while (CharIsWhitespace((*s)[i]))
-		if (++i == s->size())
-		{
-			s->clear();
-			return;
-		}
-	s->erase(0, i);
-	// koniec
-	i = s->size()-1;
-	while (CharIsWhitespace((*s)[i]))
-		i--;
-	s->erase(i+1);
-}
-
-void Trim(tstring *Out, const tstring &s)
-{
-	if (s.empty())
-	{
-		Out->clear();
-		return;
-	}
-	// pocztek
-	size_t start = 0;
-	while (CharIsWhitespace(s[start]))
-		if (++start == s.size())
-		{
-			Out->clear();
-			return;
-		}
-	// koniec
-	size_t count = s.size()-start;
-	while (CharIsWhitespace(s[start+count-1]))
-		count--;
-	// zwrcenie
-	*Out = s.substr(start, count);
-}
-
-/* UWAGA!
-Funkcje CharUpper() i CharLower() z Win32API powoduja blad ochorony, kiedy
-uruchamia sie je w trybie konwersji pojedynczego znaku, a tym znakiem jest
-polska litera!
-W sumie to chyba daloby sie napisac lepiej, ten blad wynika przeciez z tego,
-e podaje liczbe ze znakiem (char jest signed, polskie litery sa na minusie).
-Gdyby to przekonwertowac... No ale to wymaga dosc zaawansowanego rzutowania,
-wiec niech tak sobie juz zostanie :PPP
-*/
-
-tchar CharToLower(tchar ch)
-{
-#ifdef _WIN32
-	tchar s[2];
-	s[0] = ch;
-	s[1] = '\0';
-	CharLower(s);
-	return s[0];
-#else
-	return static_cast<char>( tolower(static_cast<unsigned char>(ch)) );
-#endif
-}
-
-tchar CharToUpper(tchar ch)
-{
-#ifdef _WIN32
-	tchar s[2];
-	s[0] = ch;
-	s[1] = '\0';
-	CharUpper(s);
-	return s[0];
-#else
-	return static_cast<char>( toupper(static_cast<unsigned char>(ch)) );
-#endif
-}
-
-void LowerCase(tstring *s)
-{
-	for (size_t i = 0; i < s->size(); i++)
-		(*s)[i] = CharToLower((*s)[i]);
-}
-
-void UpperCase(tstring *s)
-{
-	for (size_t i = 0; i < s->size(); i++)
-		(*s)[i] = CharToUpper((*s)[i]);
-}
-
-bool Charset_WindowsSpecialChar(char a_c, string *a_s)
-{
-	switch (a_c)
-	{
-	case '\x84':
-	case '\x94':
-	case '\x93':
-		if (a_s) *a_s = "\""; return true;
-	case '\x85':
-		if (a_s) *a_s = "..."; return true;
-	case '\x96':
-	case '\x97':
-		if (a_s) *a_s = "-"; return true;
-	case '\x92':
-		if (a_s) *a_s = "'"; return true;
-	default:
-		return false;
-	}
-}
-
-char Charset_Convert_Char(char a_c, CHARSET a_Charset1, CHARSET a_Charset2)
-{
-	if (a_Charset1 == a_Charset2) return a_c;
-	for (int i = 0; i < 18; ++i)
-		if (CHARSET_CHARS[a_Charset1][i][0] == a_c)
-			return CHARSET_CHARS[a_Charset2][i][0];
-	return a_c;
-}
-
-// Funkcja wewntrzna, potrzebna tylko dla Charset_Convert.
-static bool _StrBeginsA(const string &s, const string &sub, size_t Begin)
-{
-	if (Begin+sub.size() > s.size())
-		return false;
-	for (size_t i = 0; i < sub.size(); i++)
-		if (s[Begin+i] != sub[i])
-			return false;
-	return true;
-}
-
-void Charset_Convert(string *out, const string &s, CHARSET Charset1, CHARSET Charset2)
-{
-	if (Charset1 == Charset2) {
-		*out = s;
-		return;
-	}
-
-	size_t i, index = 0; string tmp; bool converted;
-	out->clear();
-	while (index < s.size()) {
-		if (Charset1 == CHARSET_WINDOWS && Charset_WindowsSpecialChar(s[index], &tmp)) {
-			*out += tmp;
-			index++;
-		}
-		else {
-			converted = false;
-			for (i = 0; i < 18; i++) {
-				if (_StrBeginsA(s, CHARSET_CHARS[Charset1][i], index)) {
-					*out += CHARSET_CHARS[Charset2][i];
-					index += CHARSET_CHARS[Charset1][i].size();
-					converted = true;
-					break;
-				}
-			}
-			if (!converted) {
-				*out += s[index];
-				index++;
-			}
-		}
-	}
-}
-
-void EolModeToStr(tstring *Out, EOLMODE EolMode)
-{
-	switch (EolMode)
-	{
-	case EOL_CRLF:
-		*Out = _T("\r\n");
-		return;
-	case EOL_LF:
-		*Out = _T("\n");
-		return;
-	case EOL_CR:
-		*Out = _T("\r");
-		return;
-	default:
-		Out->clear();
-		return;
-	}
-}
-
-void Replace(tstring *result, const tstring &s, const tstring &s1, const tstring &s2)
-{
-	if (s1.empty())
-	{
-		*result = s;
-		return;
-	}
-	result->clear();
-	size_t index1 = 0;
-	size_t index2 = 0;
-	while ( (index2 = s.find(s1, index1)) != tstring::npos )
-	{
-		*result += s.substr(index1, index2-index1);
-		*result += s2;
-		index1 = index2 + s1.size();
-	}
-	*result += s.substr(index1);
-}
-
-void Replace(tstring *Out, const tstring &s, tchar Ch1, tchar Ch2)
-{
-	size_t Length = s.length();
-	Out->resize(Length);
-	tchar Ch;
-	for (size_t i = 0; i < Length; i++)
-	{
-		Ch = s[i];
-		if (Ch == Ch1)
-			(*Out)[i] = Ch2;
-		else
-			(*Out)[i] = Ch;
-	}
-}
-
-void Replace(tstring *InOut, tchar Ch1, tchar Ch2)
-{
-	size_t Length = InOut->length();
-	for (size_t i = 0; i < Length; i++)
-	{
-		if ((*InOut)[i] == Ch1)
-			(*InOut)[i] = Ch2;
-	}
-}
-
-void ReplaceEOL(tstring *result, const tstring &s, EOLMODE EOLMode)
-{
-	if (EOLMode == EOL_NONE)
-	{
-		*result = s;
-		return;
-	}
-
-	result->clear();
-	tstring Tmp;
-	bool ItWasCR = false;
-	for (size_t i = 0; i < s.size(); i++)
-	{
-		if (s[i] == _T('\r'))
-			ItWasCR = true;
-		else if (s[i] == _T('\n'))
-		{
-			EolModeToStr(&Tmp, EOLMode);
-			*result += Tmp;
-			ItWasCR = false;
-		}
-		else
-		{
-			if (ItWasCR)
-			{
-				EolModeToStr(&Tmp, EOLMode);
-				*result += Tmp;
-				ItWasCR = false;
-			}
-			*result += s[i];
-		}
-	}
-	if (ItWasCR)
-	{
-		EolModeToStr(&Tmp, EOLMode);
-		*result += Tmp;
-	}
-}
-
-void NormalizeWhitespace(tstring *result, const tstring &s)
-{
-	bool inside = false;
-	for (size_t i = 0; i < s.size(); i++)
-	{
-		if (CharIsWhitespace(s[i]))
-			inside = true;
-		else
-		{
-			if (inside)
-			{
-				*result += _T(' ');
-				inside = false;
-			}
-			*result += s[i];
-		}
-	}
-	if (inside)
-		*result += ' ';
-}
-
-void DuplicateString(tstring *Out, const tstring &s, size_t count)
-{
-	Out->clear();
-	for (size_t i = 0; i < count; i++)
-		*Out += s;
-}
-
-void RightStr(tstring *Out, const tstring &s, size_t Length)
-{
-	Length = std::min(Length, s.length());
-	*Out = s.substr(s.length() - Length);
-}
-
-size_t SubstringCount(const tstring &str, const tstring &substr)
-{
-	if (substr.empty())
-		return 0;
-	size_t result = 0;
-	size_t index = 0;
-	size_t i;
-	for (;;)
-	{
-		i = str.find(substr, index);
-		if (i == tstring::npos)
-			break;
-		++result;
-		index = i + substr.size();
-	}
-	return result;
-}
-
-int StrCmpI(const tstring &s1, const tstring &s2, size_t Count)
-{
-	return StrCmpI(s1.c_str(), s2.c_str(), Count);
-}
-
-int StrCmpI(const tchar *s1, const tchar *s2, size_t Count)
-{
-#ifdef _WIN32
-	if (Count == SIZE_MAX)
-		return _tcsicmp(s1, s2);
-	else
-		return _tcsnicmp(s1, s2, Count);
-#else
-	if (Count == MAXUINT32)
-		return stricmp(s1, s2);
-	else
-		return strnicmp(s1, s2, Count);
-#endif
-}
-
-int SubStrCmp(const tstring &s1, size_t off1, const tstring &s2, size_t off2, size_t length)
-{
-#ifdef _UNICODE
-	if (length == SIZE_MAX)
-		return wcscmp(s1.c_str()+off1, s2.c_str()+off2);
-	else
-		return wcsncmp(s1.c_str()+off1, s2.c_str()+off2, length);
-#else
-	if (length == MAXUINT32)
-		return strcmp(s1.c_str()+off1, s2.c_str()+off2);
-	else
-		return strncmp(s1.c_str()+off1, s2.c_str()+off2, length);
-#endif
-}
-
-int SubStrCmpI(const tstring &s1, size_t off1, const tstring &s2, size_t off2, size_t length)
-{
-#ifdef _WIN32
-	if (length == SIZE_MAX)
-		return _tcsicmp(s1.c_str()+off1, s2.c_str()+off2);
-	else
-		return _tcsncicmp(s1.c_str()+off1, s2.c_str()+off2, length);
-#else
-	size_t i1 = off1, i2 = off2;
-	bool s1_end, s2_end;
-	char ch1, ch2;
-	for (;;)
-	{
-		if (length == 0) return 0; // Char count limit reached
-		s1_end = i1 >= s1.length();
-		s2_end = i2 >= s2.length();
-		if (s1_end && s2_end) return 0; // Both strings ended
-		if (s1_end) return -1; // Only first string ended - first is before
-		if (s2_end) return  1; // Only second string ended - first is after
-
-		ch1 = s1[i1];
-		ch2 = s2[i2];
-
-		if (ch1 != ch2 && CharToLower(ch1) != CharToLower(ch2))
-			return TCHAR_TO_INT(ch1) - TCHAR_TO_INT(ch2);
-
-		i1++; i2++; length--;
-	}
-#endif
-}
-
-bool ContainsEOL(const tstring &s)
-{
-	for (size_t i = 0; i < s.size(); ++i)
-		if (s[i] == _T('\r') || s[i] == _T('\n'))
-			return true;
-	return false;
-}
-
-bool StrBegins(const tstring &s, const tstring &sub, bool caseSensitive, size_t Begin)
-{
-	if (Begin+sub.size() > s.size())
-		return false;
-	
-	if (caseSensitive)
-	{
-		for (size_t i = 0; i < sub.size(); i++)
-			if (s[Begin+i] != sub[i])
-				return false;
-	}
-	else
-	{
-		for (size_t i = 0; i < sub.size(); i++)
-			if (CharToLower(s[Begin+i]) != CharToLower(sub[i]))
-				return false;
-	}
-
-	return true;
-}
-
-bool StrEnds(const tstring &s, const tstring &Sub, bool caseSensitive)
-{
-	if (Sub.length() > s.length())
-		return false;
-	size_t si = s.length() - Sub.length();
-	size_t subi = 0;
-
-	if (caseSensitive)
-	{
-		for ( ; si < s.length(); si++, subi++)
-		{
-			if (s[si] != Sub[subi])
-				return false;
-		}
-	}
-	else
-	{
-		for ( ; si < s.length(); si++, subi++)
-		{
-			if (CharToLower(s[si]) != CharToLower(Sub[subi]))
-				return false;
-		}
-	}
-
-	return true;
-}
-
-bool Split(const tstring &s, const tstring &delimiter, tstring *out, size_t *index)
-{
-	if (delimiter.empty())
-		return false;
-	if (*index >= s.size())
-		return false;
-
-	size_t pos = s.find(delimiter, *index);
-	if (pos == tstring::npos)
-	{
-		*out = s.substr(*index);
-		*index = s.size();
-		return true;
-	}
-
-	*out = s.substr(*index, pos-*index);
-	*index = pos + delimiter.size();
-	return true;
-}
-
-bool SplitFirstOf(const tstring &s, const tstring &delimiters, tstring *out, size_t *index)
-{
-	if (delimiters.empty())
-		return false;
-	if (*index >= s.size())
-		return false;
-
-	size_t pos = s.find_first_of(delimiters, *index);
-	if (pos == tstring::npos)
-	{
-		*out = s.substr(*index);
-		*index = s.size();
-		return true;
-	}
-
-	*out = s.substr(*index, pos-*index);
-	*index = pos + 1;
-	return true;
-}
-
-void Split(STRING_VECTOR *Out, const tstring &s, const tstring &Delimiter)
-{
-	size_t Index = 0;
-	tstring Tmp;
-	Out->clear();
-	while (Split(s, Delimiter, &Tmp, &Index))
-		Out->push_back(Tmp);
-}
-
-bool SplitEOL(const tstring &s, tstring *out, size_t *index)
-{
-	if (*index >= s.size())
-		return false;
-
-	size_t posr = s.find('\r', *index);
-	size_t posn = s.find('\n', *index);
-	if (posr == tstring::npos && posn == tstring::npos)
-	{
-		*out = s.substr(*index);
-		*index = s.size();
-		return true;
-	}
-
-	if (posn == tstring::npos || posr < posn)
-	{
-		*out = s.substr(*index, posr-*index);
-		if (*index < s.size()-1 && s[posr+1] == _T('\n'))
-			*index = posr + 2;
-		else
-			*index = posr + 1;
-		return true;
-	}
-
-	*out = s.substr(*index, posn-*index);
-	*index = posn + 1;
-	return true;
-}
-
-bool SplitQuery(const tstring &s, tstring *out, size_t *index)
-{
-	if (*index >= s.size())
-		return false;
-
-	size_t i;
-	size_t l = s.size();
-
-	while (CharIsWhitespace(s[*index]))
-		if (++(*index) >= l)
-			return false;
-
-    if (s[*index] == _T('"'))
-	{
-		(*index)++;
-		i = s.find(_T('"'), *index);
-	}
-	else
-	{
-		i = tstring::npos;
-		for (size_t j = *index; j < s.size(); j++)
-			if (CharIsWhitespace(s[j]))
-			{
-				i = j;
-				break;
-			}
-	}
-
-	if (i == tstring::npos)
-	{
-		*out = s.substr(*index);
-		*index = l+1;
-	}
-	else
-	{
-		*out = s.substr(*index, i-*index);
-		*index = i+1;
-	}
-	return true;
-}
-
-bool ValidateWildcard_Asterisk(const tstring &Mask, const tstring &S, size_t *Mask_i, size_t *S_i, bool CaseSensitive)
-{
-	// Warning: uses multiple returns.
-	bool Fit = true;
-
-	// Erase the leading asterisk
-	(*Mask_i)++;
-	while (*S_i < S.length() && (Mask[*Mask_i] == _T('?') || Mask[*Mask_i] == _T('*')))
-	{
-		if (Mask[*Mask_i] == _T('?'))
-			(*S_i)++;
-		(*Mask_i)++;
-	}
-	// Now it could be that test is empty and wildcard contains aterisks. Then we delete them to get a proper state
-	while (Mask[*Mask_i] == _T('*'))
-		(*Mask_i)++;
-	if (*S_i == S.length() && *Mask_i < Mask.length())
-		return !Fit;
-	if (*S_i == S.length() && *Mask_i < Mask.length())
-		return Fit;
-	// Neither test nor wildcard are empty! the first character of wildcard isn't in [*?]
-	if (!ValidateWildcard(Mask, S, CaseSensitive, *Mask_i, *S_i))
-	{
-		do
-		{
-			(*S_i)++;
-			// skip as much characters as possible in the teststring; stop if a character match occurs
-			if (CaseSensitive)
-			{
-				while (*S_i < S.length() && Mask[*Mask_i] != S[*S_i])
-					(*S_i)++;
-			}
-			else
-			{
-				while (*S_i < S.length() && CharToLower(Mask[*Mask_i]) != CharToLower(S[*S_i]))
-					(*S_i)++;
-			}
-		}
-		while ( (*S_i < S.length()) ? !ValidateWildcard(Mask, S, CaseSensitive, *Mask_i, *S_i) : ((Fit = 0) == true) );
-	}
-	if (*S_i == S.length() && *Mask_i == Mask.length())
-		Fit = true;
-	return Fit;
-}
-
-bool ValidateWildcard(const tstring &Mask, const tstring &S, bool CaseSensitive, size_t MaskOff, size_t SOff)
-{
-	// Algoryt na podstawie:
-	// Wildcards Pattern Matching Algorithm, Florian Schintke
-	// http://user.cs.tu-berlin.de/~schintke/references/wildcards/
-
-	bool Fit = true;
-
-	for ( ; MaskOff < Mask.length() && Fit && SOff < S.length(); MaskOff++)
-	{
-		switch (Mask[MaskOff])
-		{
-		case _T('?'):
-			SOff++;
-			break;
-		case _T('*'):
-			Fit = ValidateWildcard_Asterisk(Mask, S, &MaskOff, &SOff, CaseSensitive);
-			MaskOff--;
-			break;
-		default:
-			if (CaseSensitive)
-				Fit = (S[SOff] == Mask[MaskOff]);
-			else
-				Fit = (CharToLower(S[SOff]) == CharToLower(Mask[MaskOff]));
-			SOff++;
-		}
-	}
-
-	while (Mask[MaskOff] == _T('*') && Fit)
-		MaskOff++;
-
-	return (Fit && SOff == S.length() && MaskOff == Mask.length());
-}
-
-// Funkcja do uytku wewntrznego dla FineSearch
-// Zwraca liczb zalen od okolicznoci, w jakich wystpuje znaleziony string: 1.0 .. 4.0
-// Mnoona jest przez ni obliczana trafno.
-static float _MnoznikOkolicznosci(const tstring &str, size_t start, size_t length)
-{
-	bool l = (start == 0);
-	bool r = (start+length == str.size());
-	// Cae pole
-	if (l && r)
-		return 4.f;
-	// Pocztek pola
-	else if (l)
-		return 3.f;
-	else
-	{
-//			if (!l)
-			if (CharIsAlphaNumeric(str[start-1]))
-				l = true;
-		if (!r)
-			if (CharIsAlphaNumeric(str[start+length]))
-				r = true;
-		// Cay cig
-		if (l && r)
-			return 2.f;
-		// Nic ciekawego
-		else
-			return 1.f;
-	}
-}
-
-float FineSearch(const tstring &SubStr, const tstring &Str)
-{
-	tstring usubstr; LowerCase(&usubstr, SubStr);
-	tstring ustr; LowerCase(&ustr, Str);
-	float result = 0.f;
-
-	size_t i = 0;
-	size_t p; float x;
-
-	while (true)
-	{
-		p = ustr.find(usubstr, i);
-		// Koniec szukania
-		if (p == tstring::npos)
-			break;
-		x = std::max( usubstr.size()/5.f - Str.size()/100.f + 1.f, 1.f);
-		// Jeli zgadza si wielko liter
-		if (SubStrCmp(Str, p, SubStr, 0, SubStr.size()) == 0)
-			x *= 1.5;
-		// Mnonik okolicznoci - jeli to cae pole, pocztek pola lub cay cig
-		x *= _MnoznikOkolicznosci(Str, p+Str.size()-Str.size(), SubStr.size());
-		// Dodajemy wyliczon trafno
-		result += x;
-		i = p + SubStr.length();
-	}
-
-	return result;
-}
-
-size_t LevenshteinDistance(const tstring &s1, const tstring &s2)
-{
-	size_t L1 = s1.length();
-	size_t L2 = s2.length();
-	size_t i, j, cost;
-	tchar c1, c2;
-
-	if (L1 == 0) return L2;
-	if (L2 == 0) return L1;
-
-	size_t *D_PrevRow = new size_t[L2+1];
-	size_t *D_CurrRow = new size_t[L2+1];
-
-	for (j = 0; j <= L2; j++)
-		D_PrevRow[j] = j;
-
-	for (i = 1; i <= L1; i++)
-	{
-		D_CurrRow[0] = i;
-		c1 = s1[i-1];
-		for (j = 1; j <= L2; j++)
-		{
-			c2 = s2[j-1];
-			cost = (c1 == c2 ? 0 : 1);
-			D_CurrRow[j] = min3(D_PrevRow[j] + 1, D_CurrRow[j-1] + 1, D_PrevRow[j-1] + cost);
-		}
-		std::swap(D_PrevRow, D_CurrRow);
-	}
-
-	size_t R = D_PrevRow[L2]; // Prev, bo zostao na koniec ostatniego przebiegu ptli zamienione z Curr
-	delete [] D_CurrRow;
-	delete [] D_PrevRow;
-	return R;
-}
-
-size_t LevenshteinDistanceI(const tstring &s1, const tstring &s2)
-{
-	size_t L1 = s1.length();
-	size_t L2 = s2.length();
-	size_t i, j, cost;
-	tchar c1, c2;
-
-	if (L1 == 0) return L2;
-	if (L2 == 0) return L1;
-
-	size_t *D_PrevRow = new size_t[L2+1];
-	size_t *D_CurrRow = new size_t[L2+1];
-
-	for (j = 0; j <= L2; j++)
-		D_PrevRow[j] = j;
-
-	for (i = 1; i <= L1; i++)
-	{
-		D_CurrRow[0] = i;
-		c1 = CharToLower(s1[i-1]);
-		for (j = 1; j <= L2; j++)
-		{
-			c2 = CharToLower(s2[j-1]);
-			cost = (c1 == c2 ? 0 : 1);
-			D_CurrRow[j] = min3(D_PrevRow[j] + 1, D_CurrRow[j-1] + 1, D_PrevRow[j-1] + cost);
-		}
-		std::swap(D_PrevRow, D_CurrRow);
-	}
-
-	size_t R = D_PrevRow[L2]; // Prev, bo zostao na koniec ostatniego przebiegu ptli zamienione z Curr
-	delete [] D_CurrRow;
-	delete [] D_PrevRow;
-	return R;
-}
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-// C-style strings
-
-const tchar * strnistr(const tchar *str, const tchar *substr, size_t count)
-{
-	size_t nLen, nOffset, nMaxOffset, nStringLenInt;
-	const tchar *pPos;
-	nLen = common_strlen(substr);
-	if (nLen == 0)
-		return str;
-	size_t nStringToBeSearched = common_strlen(str);
-	if (nLen > nStringToBeSearched)
-		return NULL;
-	if (count > nStringToBeSearched)
-		nStringLenInt = nStringToBeSearched;
-	else
-		nStringLenInt = count;
-	nMaxOffset = nStringLenInt - nLen;
-	pPos = str;
-	for ( nOffset = 0; nOffset <= nMaxOffset; nOffset++ )
-	{
-		if ( common_strnicmp(pPos, substr, nLen) == 0 )
-			return pPos;
-		pPos++;
-	}
-	return NULL;
-}
-
-bool StrBegins(const tchar *str, const tchar *substr, bool caseSensitive)
-{
-	size_t strLen = common_strlen(str);
-	size_t substrLen = common_strlen(substr);
-	if (substrLen > strLen) return false;
-
-	if (caseSensitive)
-		return common_strncmp(str, substr, substrLen) == 0;
-	else
-		return common_strnicmp(str, substr, substrLen) == 0;
-}
-
-bool StrEnds(const tchar *str, const tchar *substr, bool caseSensitive)
-{
-	size_t strLen = common_strlen(str);
-	size_t substrLen = common_strlen(substr);
-	if (substrLen > strLen) return false;
-
-	if (caseSensitive)
-		return common_strncmp(str + (strLen - substrLen), substr, substrLen) == 0;
-	else
-		return common_strnicmp(str + (strLen - substrLen), substr, substrLen) == 0;
-}
-
-void StrErase(tchar *str, size_t off, size_t count)
-{
-	if (count == 0) return;
-	size_t strLen = common_strlen(str);
-	if (off >= strLen) return;
-	// obetnij
-	if (count >= strLen - off)
-		str[off] = _T('\0');
-	// przesu dalsze znaki
-	else
-	{
-		size_t c = strLen - off - count;
-		size_t dstIndex = off;
-		size_t srcIndex = off + count;
-		while (c > 0 && dstIndex < strLen)
-		{
-			str[dstIndex] = str[srcIndex];
-			srcIndex++; dstIndex++; c--;
-		}
-		str[dstIndex] =  _T('\0');
-	}
-}
-
-void StrInsert(tchar *str, size_t strCapacity, const tchar *newStr, size_t off, size_t count)
-{
-	if (count == 0) return;
-	size_t strLen = common_strlen(str);
-	assert(off <= strLen);
-	assert(strLen + count < strCapacity);
-	// Zrb miejsce
-	size_t c = strLen - off;
-	size_t srcIndex = off + c - 1;
-	size_t dstIndex = srcIndex + count;
-	str[dstIndex + 1] =  _T('\0');
-	while (c > 0)
-	{
-		str[dstIndex] = str[srcIndex];
-		srcIndex--; dstIndex--; c--;
-	}
-	// Wpisz nowy acuch
-	srcIndex = 0; dstIndex = off;
-	while (count > 0)
-	{
-		str[dstIndex] = newStr[srcIndex];
-		srcIndex++; dstIndex++; count--;
-	}
-}
-
-void StrInsert(tchar *str, size_t strCapacity, const tchar *newStr, size_t off)
-{
-	StrInsert(str, strCapacity, newStr, off, common_strlen(newStr));
-}
-
-void Trim(tchar *s)
-{
-	size_t sLen = common_strlen(s);
-
-	size_t begPos = 0;
-	while (begPos < sLen && CharIsWhitespace(s[begPos]))
-		begPos++;
-	
-	// Cay string to biae znaki
-	if (begPos == sLen)
-	{
-		ClearStr(s);
-		return;
-	}
-
-	size_t endPos = sLen;
-	while (CharIsWhitespace(s[endPos-1]))
-		endPos--;
-
-	// Obetnij koniec, a potem pocztek
-	StrErase(s, endPos);
-	StrErase(s, 0, begPos);
-}
-
-unsigned StrReplace(tchar *str, tchar from, tchar to)
-{
-	unsigned R = 0;
-	while (*str != _T('\0'))
-	{
-		if (*str == from)
-		{
-			*str = to;
-			R++;
-		}
-		str++;
-	}
-	return R;
-}
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-// Obsuga Unicode (tylko Windows)
-#ifdef _WIN32
-
-bool ConvertUnicodeToChars(string *Out, const wstring &S, unsigned CodePage)
-{
-	if (S.empty())
-	{
-		Out->clear(); return true;
-	}
-
-	// Phase 1 - Get buffer size.
-	int Size = WideCharToMultiByte(CodePage, 0, S.data(), (int)S.length(), NULL, 0, NULL, NULL);
-	if (Size == 0)
-	{
-		Out->clear(); return false;
-	}
-
-	// Phase 2 - Do conversion.
-	scoped_ptr<char, DeleteArrayPolicy> Buf(new char[(size_t)Size]);
-	int R = WideCharToMultiByte(CodePage, 0, S.data(), (int)S.length(), Buf.get(), Size, NULL, NULL);
-	if (R == 0)
-	{
-		Out->clear(); return false;
-	}
-	
-	Out->assign(Buf.get(), (size_t)Size);
-	return true;
-}
-
-bool ConvertUnicodeToChars(string *Out, const wchar_t *S, size_t NumChars, unsigned CodePage)
-{
-	if (NumChars == 0)
-	{
-		Out->clear(); return true;
-	}
-
-    assert(NumChars <= (size_t)INT_MAX);
-
-	// Phase 1 - Get buffer size.
-	int Size = WideCharToMultiByte(CodePage, 0, S, (int)NumChars, NULL, 0, NULL, NULL);
-	if (Size == 0)
-	{
-		Out->clear(); return false;
-	}
-
-	// Phase 2 - Do conversion.
-	scoped_ptr<char, DeleteArrayPolicy> Buf(new char[(size_t)Size]);
-	int R = WideCharToMultiByte(CodePage, 0, S, (int)NumChars, Buf.get(), Size, NULL, NULL);
-	if (R == 0)
-	{
-		Out->clear(); return false;
-	}
-	
-	Out->assign(Buf.get(), (size_t)Size);
-	return true;
-}
-
-bool ConvertCharsToUnicode(wstring *Out, const string &S, unsigned CodePage)
-{
-	if (S.empty())
-	{
-		Out->clear(); return true;
-	}
-
-	// Phase 1 - Get buffer size.
-	int Size = MultiByteToWideChar(CodePage, 0, S.data(), (int)S.length(), NULL, 0);
-	if (Size == 0)
-	{
-		Out->clear(); return false;
-	}
-
-	// Phase 2 - Do conversion.
-	scoped_ptr<wchar_t, DeleteArrayPolicy> Buf(new wchar_t[(size_t)Size]);
-	int R = MultiByteToWideChar(CodePage, 0, S.data(), (int)S.length(), Buf.get(), Size);
-	if (R == 0)
-	{
-		Out->clear(); return false;
-	}
-
-	Out->assign(Buf.get(), (size_t)Size);
-	return true;
-}
-
-bool ConvertCharsToUnicode(wstring *Out, const char *S, size_t NumChars, unsigned CodePage)
-{
-	if (NumChars == 0)
-	{
-		Out->clear(); return true;
-	}
-
-    assert(NumChars <= (size_t)INT_MAX);
-
-	// Phase 1 - Get buffer size.
-	int Size = MultiByteToWideChar(CodePage, 0, S, (int)NumChars, NULL, 0);
-	if (Size == 0)
-	{
-		Out->clear(); return false;
-	}
-
-	// Phase 2 - Do conversion.
-	scoped_ptr<wchar_t, DeleteArrayPolicy> Buf(new wchar_t[(size_t)Size]);
-	int R = MultiByteToWideChar(CodePage, 0, S, (int)NumChars, Buf.get(), Size);
-	if (R == 0)
-	{
-		Out->clear(); return false;
-	}
-
-	Out->assign(Buf.get(), (size_t)Size);
-	return true;
-}
-
-bool UnicodeToChars_CalcBufLen(size_t &outLen, const wchar_t *wcs, unsigned CodePage)
-{
-	return UnicodeToChars_CalcBufLen(outLen, wcs, wcslen(wcs), CodePage);
-}
-
-bool UnicodeToChars_CalcBufLen(size_t &outLen, const wchar_t *wcs, size_t wcsLen, unsigned CodePage)
-{
-	if (wcsLen == 0 || wcs == NULL)
-	{
-		outLen = 0;
-		return true;
-	}
-
-	int len = WideCharToMultiByte(CodePage, 0, wcs, (int)wcsLen, NULL, 0, NULL, NULL);
-	outLen = (size_t)len;
-	return len > 0;
-}
-
-bool CharsToUnicode_CalcBufLen(size_t &outLen, const char *str, unsigned CodePage)
-{
-	return CharsToUnicode_CalcBufLen(outLen, str, strlen(str), CodePage);
-}
-
-bool CharsToUnicode_CalcBufLen(size_t &outLen, const char *str, size_t strLen, unsigned CodePage)
-{
-	if (strLen == 0 || str == NULL)
-	{
-		outLen = 0;
-		return false;
-	}
-	int len = MultiByteToWideChar(CodePage, 0, str, (int)strLen, NULL, 0);
-	outLen = (size_t)len;
-	return len > 0;
-}
-
-bool ConvertUnicodeToChars(char *outBuf, size_t bufLen, const wchar_t *wcs, unsigned CodePage)
-{
-	return ConvertUnicodeToChars(outBuf, bufLen, wcs, wcslen(wcs), CodePage);
-}
-
-bool ConvertUnicodeToChars(char *outBuf, size_t bufLen, const wchar_t *wcs, size_t wcsLen, unsigned CodePage)
-{
-	assert(outBuf != NULL && bufLen > 0);
-
-	if (wcsLen == 0 || StrIsEmpty(wcs))
-	{
-		ClearStr(outBuf);
-		return true;
-	}
-
-	int R = WideCharToMultiByte(CodePage, 0, wcs, (int)wcsLen, outBuf, (int)bufLen, NULL, NULL);
-	return R > 0;
-}
-
-bool ConvertCharsToUnicode(wchar_t *outBuf, size_t bufLen, const char *str, unsigned CodePage)
-{
-	return ConvertCharsToUnicode(outBuf, bufLen, str, strlen(str), CodePage);
-}
-
-bool ConvertCharsToUnicode(wchar_t *outBuf, size_t bufLen, const char *str, size_t strLen, unsigned CodePage)
-{
-	assert(outBuf != NULL && bufLen > 0);
-	
-	if (strLen == 0 || StrIsEmpty(str))
-	{
-		ClearStr(outBuf);
-		return true;
-	}
-
-	int R = MultiByteToWideChar(CodePage, 0, str, (int)strLen, outBuf, (int)bufLen);
-	return R > 0;
-}
-
-
-const char * const BOM_UTF8     = "\xEF\xBB\xBF";
-const char * const BOM_UTF16_LE = "\xFF\xFE";
-const char * const BOM_UTF16_BE = "\xFE\xFF";
-
-#endif
-
-#ifdef _UNICODE
-	bool TstringToString(string *Out, const tstring &S) { return ConvertUnicodeToChars(Out, S, CP_ACP); }
-	bool StringToTstring(tstring *Out, const string &S) { return ConvertCharsToUnicode(Out, S, CP_ACP); }
-#else
-	#ifdef _WIN32
-		bool TstringToWstring(wstring *Out, const tstring &S) { return ConvertCharsToUnicode(Out, S, CP_ACP); }
-		bool WstringToTstring(tstring *Out, const wstring &S) { return ConvertUnicodeToChars(Out, S, CP_ACP); }
-	#endif
-#endif
-
-/*
-Sortowanie naturalne
-Napisane od pocztku, ale na podstawie kodu:
-  strnatcmp.c -- Perform 'natural order' comparisons of strings in C.
-  Copyright (C) 2000, 2004 by Martin Pool <mbp sourcefrog net>
-  http://sourcefrog.net/projects/natsort/
-Mj algorytm dziaa jednak troch inaczej i daje inne wyniki (przydaoby si
-kiedy go poprawi).
-*/
-
-int StringNaturalCompare::CompareNumbers(const tstring &s1, size_t i1, const tstring &s2, size_t i2)
-{
-	// pomi pocztkowe zera
-	while (i1 < s1.length() && s1[i1] == _T('0'))
-		i1++;
-	while (i2 < s2.length() && s2[i2] == _T('0'))
-		i2++;
-
-	// The longest run of digits wins.  That aside, the greatest
-	// value wins, but we can't know that it will until we've scanned
-	// both numbers to know that they have the same magnitude, so we
-	// remember it in BIAS.
-	int bias = 0;
-
-	for ( ; ; i1++, i2++)
-	{
-		// koniec lancucha
-		if (i1 == s1.length() || !CharIsDigit(s1[i1]))
-		{
-			if (i2 == s2.length() || !CharIsDigit(s2[i2]))
-				return bias;
-			else
-				return -1;
-		}
-		else if (i2 == s2.length() || !CharIsDigit(s2[i2]))
-			return +1;
-
-		// porwnanie znakw
-		if (s1[i1] < s2[i2])
-		{
-			if (bias == 0)
-				bias = -1;
-		}
-		else if (s1[i1] > s2[i2])
-		{
-			if (bias == 0)
-				bias = +1;
-		}
-	}
-	return 0;
-}
-
-int StringNaturalCompare::Compare(const tstring &s1, const tstring &s2)
-{
-	size_t i1 = 0, i2 = 0;
-	tchar c1, c2;
-	int result;
-
-	for (;;)
-	{
-		// koniec acucha
-		if (i1 == s1.length())
-		{
-			if (i2 == s2.length())
-				return 0;
-			else
-				return -1;
-		}
-		else if (i2 == s2.length())
-			return +1;
-
-		// pobierz znaki
-		c1 = s1[i1];
-		c2 = s2[i2];
-
-		// pomi biae znaki
-		if (CharIsWhitespace(c1))
-		{
-			i1++;
-			continue;
-		}
-		if (CharIsWhitespace(c2))
-		{
-			i2++;
-			continue;
-		}
-
-		// obydwa to cyfry - porwnujemy liczby
-		if (CharIsDigit(c1) && CharIsDigit(c2))
-		{
-			if ((result = CompareNumbers(s1, i1, s2, i2)) != 0)
-				return result;
-		}
-
-		// nieuwzgldnianie wielkoci liter
-		if (m_CaseInsensitive)
-		{
-			c1 = CharToLower(c1);
-			c2 = CharToLower(c2);
-		}
-
-		// porwnanie znakw
-		if (c1 < c2)
-			return -1;
-		if (c1 > c2)
-			return +1;
-
-		// nastpne znaki
-		i1++;
-		i2++;
-	}
-}
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-// cieki do plikw
-
-// [Wewntrzna]
-// Zwraca true, jeli znak jest jakim separatorem katalogw
-inline bool IsPathSlash(tchar Ch)
-{
-	return (Ch == _T('\\')) || (Ch == _T('/'));
-}
-
-// [Wewntrzna]
-// Porwnuje dwie nazwy plikw lub katalogw
-// Z rozrnianiem lub bez rozrniania wielkoci znakw, zalenie od systemu
-bool PathCmp(const tstring &s1, const tstring &s2)
-{
-#ifdef _WIN32
-	return StrCmpI(s1, s2) == 0;
-#else
-	return (s1 == s2);
-#endif
-}
-
-// [Wewntrzna]
-// Rozkada ciek na czci
-void DecomposePath(const tstring &s, tstring *OutPrefix, tstring *OutPath, tstring *OutTrailingPathDelimiter)
-{
-	OutPrefix->clear();
-	OutPath->clear();
-	OutTrailingPathDelimiter->clear();
-	size_t Beg = 0, End = s.length();
-
-	// Prefix
-	if (!s.empty())
-	{
-		// Zaczyna si od <slash>
-		if (IsPathSlash(s[0]))
-		{
-			// <slash> <slash> <serwer> <slash> <udzia> <slash>
-			if (s.length() > 1 && IsPathSlash(s[1]))
-			{
-				size_t i = s.find_first_of(_T("/\\"), 2);
-				if (i == tstring::npos) { *OutPrefix = s; return; }
-				i = s.find_first_of(_T("/\\"), i+1);
-				if (i == tstring::npos) { *OutPrefix = s; return; }
-				*OutPrefix = s.substr(0, i+1);
-				Beg = i+1;
-			}
-			// Nie - po prostu <slash>
-			else
-			{
-				CharToStr(OutPrefix, s[0]);
-				Beg = 1;
-			}
-		}
-		// <dysk> : <slash>
-		else
-		{
-			size_t i = s.find(':');
-			if (i != tstring::npos)
-			{
-				size_t j = s.find_first_of(_T("/\\"));
-				if (j == tstring::npos || j > i+1)
-				{
-					*OutPrefix = s.substr(0, i+1);
-					Beg = i+1;
-				}
-				else if (j > i)
-				{
-					*OutPrefix = s.substr(0, j+1);
-					Beg = j+1;
-				}
-			}
-		}
-	}
-
-	// TrailingPathDelimiter
-	if (End > Beg)
-	{
-		if (IsPathSlash(s[End-1]))
-		{
-			CharToStr(OutTrailingPathDelimiter, s[End-1]);
-			End--;
-		}
-	}
-
-	assert(End >= Beg);
-	*OutPath = s.substr(Beg, End-Beg);
-}
-
-bool PathIsAbsolute(const tstring &s)
-{
-	// Przepisane z czci Prefix funkcji DecomposePath
-	if (s.empty())
-		return false;
-	// Zaczyna si od <slash>
-	if (IsPathSlash(s[0]))
-		return true;
-	// <dysk> : <slash>
-	size_t i = s.find(_T(':'));
-	if (i == tstring::npos)
-		return false;
-	size_t j = s.find_first_of(_T("/\\"));
-	if (j == tstring::npos || j > i)
-		return true;
-	return false;
-}
-
-void IncludeTrailingPathDelimiter(tstring *InOutPath)
-{
-	if (InOutPath->empty())
-		CharToStr(InOutPath, DIR_SEP);
-	else
-	{
-		if (!IsPathSlash((*InOutPath)[InOutPath->length()-1]))
-			*InOutPath += DIR_SEP;
-	}
-}
-
-void IncludeTrailingPathDelimiter(tstring *OutPath, const tstring &InPath)
-{
-	if (InPath.empty())
-		CharToStr(OutPath, DIR_SEP);
-	else
-	{
-		if (!IsPathSlash(InPath[InPath.length()-1]))
-			*OutPath = InPath + CharToStrR(DIR_SEP);
-		else
-			*OutPath = InPath;
-	}
-}
-
-void ExcludeTrailingPathDelimiter(tstring *InOutPath)
-{
-	if (InOutPath->empty())
-		return;
-	if (IsPathSlash((*InOutPath)[InOutPath->length()-1]))
-		InOutPath->erase(InOutPath->length()-1, 1);
-}
-
-void ExcludeTrailingPathDelimiter(tstring *OutPath, const tstring &InPath)
-{
-	if (InPath.empty())
-		OutPath->clear();
-	else
-	{
-		if (IsPathSlash(InPath[InPath.length()-1]))
-			*OutPath = InPath.substr(0, InPath.length()-1);
-		else
-			*OutPath = InPath;
-	}
-}
-
-void ExtractPathPrefix(tstring *OutPrefix, const tstring &s)
-{
-	OutPrefix->clear();
-	size_t Beg = 0;
-
-	// Skopiowana cz Prefix z funkcji DecomposePath
-	if (!s.empty())
-	{
-		// Zaczyna si od <slash>
-		if (IsPathSlash(s[0]))
-		{
-			// <slash> <slash> <serwer> <slash> <udzia> <slash>
-			if (s.length() > 1 && IsPathSlash(s[1]))
-			{
-				size_t i = s.find_first_of(_T("/\\"), 2);
-				if (i == tstring::npos) { *OutPrefix = s; return; }
-				i = s.find_first_of(_T("/\\"), i+1);
-				if (i == tstring::npos) { *OutPrefix = s; return; }
-				*OutPrefix = s.substr(0, i+1);
-				Beg = i+1;
-			}
-			// Nie - po prostu <slash>
-			else
-			{
-				CharToStr(OutPrefix, s[0]);
-				Beg = 1;
-			}
-		}
-		// <dysk> : <slash>
-		else
-		{
-			size_t i = s.find(_T(':'));
-			if (i != tstring::npos)
-			{
-				size_t j = s.find_first_of(_T("/\\"));
-				if (j == tstring::npos || j > i+1)
-				{
-					*OutPrefix = s.substr(0, i+1);
-					Beg = i+1;
-				}
-				else if (j > i)
-				{
-					*OutPrefix = s.substr(0, j+1);
-					Beg = j+1;
-				}
-			}
-		}
-	}
-
-	if (Beg > 0)
-		*OutPrefix = s.substr(0, Beg+1);
-}
-
-void ExtractFilePath(tstring *OutPath, const tstring &s)
-{
-	size_t i = s.find_last_of(_T("\\/:"));
-	if (i == tstring::npos)
-		OutPath->clear();
-	else
-		*OutPath = s.substr(0, i + 1);
-}
-
-void ExtractFileName(tstring *OutFileName, const tstring &s)
-{
-	size_t i = s.find_last_of(_T("\\/:"));
-	if (i == tstring::npos)
-		*OutFileName = s;
-	else
-		*OutFileName = s.substr(i + 1);
-}
-
-void ExtractFileExt(tstring *OutExt, const tstring &s)
-{
-	size_t i = s.find_last_of(_T(".\\/:"));
-	if ( (i != tstring::npos) && (i > 0) && (s[i] == _T('.')) )
-		*OutExt = s.substr(i);
-	else
-		OutExt->clear();
-}
-
-void ChangeFileExt(tstring *Out, const tstring &FileName, const tstring &Ext)
-{
-	size_t i = FileName.find_last_of(_T(".\\/:"));
-	if ( (i == tstring::npos) || (FileName[i] != _T('.')) )
-		*Out = FileName + Ext;
-	else
-		*Out = FileName.substr(0, i) + Ext;
-}
-
-void NormalizePath(tstring *OutPath, const tstring &s)
-{
-	const tstring Delimiters = _T("/\\");
-	tstring Path, Trailing, Tmp;
-	DecomposePath(s, OutPath, &Path, &Trailing);
-	STRING_VECTOR Dirs;
-	size_t Index = 0;
-	while (SplitFirstOf(Path, Delimiters, &Tmp, &Index))
-	{
-		if (Tmp.empty())
-		{
-			*OutPath = s;
-			return;
-		}
-		if (Tmp[0] == _T('.'))
-		{
-			// ".."
-			if (Tmp.length() == 2 && Tmp[1] == _T('.'))
-			{
-				if (Dirs.empty())
-					Dirs.push_back(Tmp);
-				else
-					Dirs.pop_back();
-			}
-			// "." - nie rb nic
-		}
-		// Zwyky katalog
-		else
-			Dirs.push_back(Tmp);
-	}
-
-	for (size_t i = 0; i < Dirs.size(); i++)
-	{
-		if (!OutPath->empty())
-			IncludeTrailingPathDelimiter(OutPath);
-		*OutPath += Dirs[i];
-	}
-	OutPath->append(Trailing);
-}
-
-void RelativeToAbsolutePath(tstring *Out, const tstring &Base, const tstring &Path)
-{
-	if (PathIsAbsolute(Path))
-		*Out = Path;
-	else
-	{
-		tstring Tmp = Base;
-		IncludeTrailingPathDelimiter(&Tmp);
-		Tmp.append(Path);
-		NormalizePath(Out, Tmp);
-	}
-}
-
-void AbsoluteToRelativePath(tstring *Out, const tstring &Base, const tstring &Target)
-{
-	tstring BasePrefix, BasePath, BaseTrailing;
-	tstring TargetPrefix, TargetPath, TargetTrailing;
-	DecomposePath(Base, &BasePrefix, &BasePath, &BaseTrailing);
-	DecomposePath(Target, &TargetPrefix, &TargetPath, &TargetTrailing);
-
-	if (!PathCmp(BasePrefix, TargetPrefix))
-	{
-		*Out = Target;
-		return;
-	}
-
-	// Spisz katalogi Base i Target
-	const tstring DELIMITER = _T("/\\");
-	STRING_VECTOR BaseDirs, TargetDirs;
-	size_t i = 0;
-	tstring Tmp;
-	while (SplitFirstOf(BasePath, DELIMITER, &Tmp, &i))
-		BaseDirs.push_back(Tmp);
-	i = 0;
-	while (SplitFirstOf(TargetPath, DELIMITER, &Tmp, &i))
-		TargetDirs.push_back(Tmp);
-
-	tstring R;
-	// Wyeliminuj wsplne katalogi z pocztku cieek
-	size_t DirsDifferenceIndex = 0;
-	while (DirsDifferenceIndex < BaseDirs.size() && DirsDifferenceIndex < TargetDirs.size() && PathCmp(BaseDirs[DirsDifferenceIndex], TargetDirs[DirsDifferenceIndex]))
-		DirsDifferenceIndex++;
-
-	// Przepisz na wyjcie "/.." lub "\.."
-	for (size_t i = DirsDifferenceIndex; i < BaseDirs.size(); i++)
-	{
-		if (!R.empty())
-			IncludeTrailingPathDelimiter(&R);
-		R.append(_T(".."));
-	}
-	// Przepisz na wyjcie to co w Target
-	for (size_t i = DirsDifferenceIndex; i < TargetDirs.size(); i++)
-	{
-		if (!R.empty())
-			IncludeTrailingPathDelimiter(&R);
-		R.append(TargetDirs[i]);
-	}
-	// Opcjonalny koczcy '/' lub '\'
-	bool TrailingPathDelimiter = (!Target.empty() && Target[Target.length()-1] == DIR_SEP);
-	if (TrailingPathDelimiter)
-		IncludeTrailingPathDelimiter(&R);
-	NormalizePath(Out, R);
-}
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-// KONWERSJE
-
-/*
-Locale dla funkcji konwertujcych, eby nie uwzgldniay aktualnie ustawionego,
-tylko zawsze uyway standardowego, eby np. przy konwersji float i double
-uywana bya zawsze kropka, a nie przecinek jeli ustawiony jest polski locale.
-Niestety nie zwalniam tego obiektu na koniec, cho powinienem wywoa
-_free_locale.
-*/
-#ifdef _WIN32
-	static _locale_t g_MainLocale = _create_locale(LC_ALL, "C");
-#endif
-
-static const tchar _DIGITS_L[] = _T("0123456789abcdefghijklmnopqrstuvwxyz");
-static const tchar _DIGITS_U[] = _T("0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ");
-
-// Zalenie od precyzji
-static const tchar * const DOUBLE_TO_STR_FORMAT[] = {
-	_T("%.0"), _T("%.1"), _T("%.2"), _T("%.3"), _T("%.4"), _T("%.5"), _T("%.6"), _T("%.7"), _T("%.8"), _T("%.9"), _T("%.10"), _T("%.11"), _T("%.12"), _T("%.13"), _T("%.14"), _T("%.15"), _T("%.16"), _T("%.17"), _T("%.18"), _T("%.19"), _T("%.20"),
-};
-
-void DoubleToStr(tstring *Out, double x, char mode, int precision)
-{
-	tchar sz[256], Format[7];
-
-#ifdef _WIN32
-	#ifdef _UNICODE
-		wcscpy_s(Format, _countof(Format), DOUBLE_TO_STR_FORMAT[precision]);
-		size_t l = _tcslen(Format);
-		Format[l] = mode;
-		Format[l+1] = L'\0';
-		_stprintf_s_l(sz, _countof(sz), Format, g_MainLocale, x);
-	#else
-		#ifdef _MSC_VER
-			strcpy_s(Format, _countof(Format), DOUBLE_TO_STR_FORMAT[precision]);
-		#else
-			strcpy(Format, DOUBLE_TO_STR_FORMAT[precision]);
-		#endif
-		size_t l = strlen(Format);
-		Format[l] = mode;
-		Format[l+1] = '\0';
-		_sprintf_s_l(sz, _countof(sz), Format, g_MainLocale, x);
-	#endif
-#else
-	strcpy(Format, DOUBLE_TO_STR_FORMAT[precision]);
-	size_t l = strlen(Format);
-	Format[l] = mode;
-	Format[l+1] = '\0';
-	sprintf(sz, Format, x);
-#endif
-
-	*Out = sz;
-}
-
-void FloatToStr(tstring *Out, float x, char mode, int precision)
-{
-	DoubleToStr(Out, static_cast<double>(x), mode, precision);
-}
-
-int StrToDouble(double *out, const tstring &s)
-{
-	////// Sprawdzenie skadni
-	size_t pos = 0;
-	// Whitespace
-	for (;;)
-	{
-		if (pos == s.length())
-			return -1;
-		if (s[pos] == ' ' || s[pos] == _T('\t'))
-			pos++;
-		else
-			break;
-	}
-	// Sign
-	if (pos == s.length())
-		return -1;
-	if (s[pos] == _T('+') || s[pos] == _T('-'))
-		pos++;
-	// Digits
-	if (pos == s.length())
-		return -1;
-	bool DigitsBeforePoint = false;
-	while (pos < s.length() && (s[pos] >= _T('0') && s[pos] <= _T('9')))
-	{
-		DigitsBeforePoint = true;
-		pos++;
-	}
-	// .Digits
-	bool DigitsAfterPoint = false;
-	if (pos == s.length() && !DigitsBeforePoint)
-		return -1;
-	if (pos < s.length() && s[pos] == _T('.'))
-	{
-		pos++;
-		while (pos < s.length())
-		{
-			if (s[pos] >= _T('0') && s[pos] <= _T('9'))
-			{
-				pos++;
-				DigitsAfterPoint = true;
-			}
-			else
-				break;
-		}
-	}
-	if (!DigitsBeforePoint && !DigitsAfterPoint)
-		return -1;
-	// {DdEe}
-	if (pos < s.length())
-	{
-		if (!(s[pos] == _T('d') || s[pos] == _T('D') || s[pos] == _T('e') || s[pos] == _T('E')))
-			return -1;
-		pos++;
-		// Sign
-		if (pos <= s.length() && (s[pos] == _T('+') || s[pos] == _T('-')))
-			pos++;
-		// Digits
-		if (pos == s.length())
-			return -1;
-		while (pos < s.length() && (s[pos] >= _T('0') && s[pos] <= _T('9')))
-			pos++;
-		if (pos < s.length())
-			return -1;
-	}
-
-	////// Konwersja waciwa
-	#ifdef _WIN32
-		#ifdef _UNICODE
-			*out = _wtof_l(s.c_str(), g_MainLocale);
-		#else
-			*out = _atof_l(s.c_str(), g_MainLocale);
-		#endif
-	#else
-		*out = atof(s.c_str());
-	#endif
-
-	return 0;
-}
-
-int StrToFloat(float *out, const tstring &s)
-{
-	double d;
-	int r = StrToDouble(&d, s);
-	if (r != 0)
-		return r;
-	*out = (float)d;
-	return 0;
-}
-
-void BoolToStr(tstring *Out, bool x, char mode)
-{
-	switch (mode)
-	{
-	case '0':
-		*Out = (x ? _T("1") : _T("0"));
-		return;
-	case 'F':
-		*Out = (x ? _T("True") : _T("False"));
-		return;
-	case 'U':
-		*Out = (x ? _T("TRUE") : _T("FALSE"));
-		return;
-	case 'g':
-		*Out = (x ? _T("t") : _T("f"));
-		return;
-	case 'G':
-		*Out = (x ? _T("T") : _T("F"));
-		return;
-	default: // 'f'
-		*Out = (x ? _T("true") : _T("false"));
-		return;
-	}
-}
-
-bool StrToBool(bool *result, const tstring &s)
-{
-	if (s == _T("0") || s == _T("f") || s == _T("F") || s == _T("false") || s == _T("False") || s == _T("FALSE"))
-		*result = false;
-	else if (s == _T("1") || s == _T("t") || s == _T("T") || s == _T("true") || s == _T("True") || s == _T("TRUE"))
-		*result = true;
-	else
-		return false;
-
-	return true;
-}
-
-void PtrToStr(tstring *Out, const void* p)
-{
-	tchar sz[17];
-#ifdef _UNICODE
-	_stprintf_s(sz, _countof(sz), L"%p", p);
-#else
-	#ifdef _MSC_VER
-		sprintf_s(sz, _countof(sz), "%p", p);
-	#else
-		sprintf(sz, "%p", p);
-	#endif
-#endif
-	*Out = sz;
-}
-
-static uint8 ROT13_TABLE[] = { 0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,52,53,54,55,56,57,58,59,60,61,62,63,64,78,79,80,81,82,83,84,85,86,87,88,89,90,65,66,67,68,69,70,71,72,73,74,75,76,77,91,92,93,94,95,96,110,111,112,113,114,115,116,117,118,119,120,121,122,97,98,99,100,101,102,103,104,105,106,107,108,109,123,124,125,126,127,128,129,130,131,132,133,134,135,136,137,138,139,140,141,142,143,144,145,146,147,148,149,150,151,152,153,154,155,156,157,158,159,160,161,162,163,164,165,166,167,168,169,170,171,172,173,174,175,176,177,178,179,180,181,182,183,184,185,186,187,188,189,190,191,192,193,194,195,196,197,198,199,200,201,202,203,204,205,206,207,208,209,210,211,212,213,214,215,216,217,218,219,220,221,222,223,224,225,226,227,228,229,230,231,232,233,234,235,236,237,238,239,240,241,242,243,244,245,246,247,248,249,250,251,252,253,254,255 };
-
-void Rot13(tstring *InOut)
-{
-#ifdef _UNICODE
-	int ci;
-	for (size_t i = 0; i < InOut->length(); i++)
-	{
-		ci = TCHAR_TO_INT((*InOut)[i]);
-		if (ci < 256)
-			(*InOut)[i] = INT_TO_TCHAR(ROT13_TABLE[ci]);
-	}
-#else
-	for (size_t i = 0; i < InOut->length(); i++)
-		(*InOut)[i] = (char)ROT13_TABLE[(uint8)(*InOut)[i]];
-#endif
-}
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-// Matematyka
-
-#ifdef _WIN32
-	bool is_finite(float x)  { return (_finite(x) != 0); }
-	bool is_finite(double x) { return (_finite(x) != 0); }
-	bool is_nan(float x)  { return (_isnan(x) != 0); }
-	bool is_nan(double x) { return (_isnan(x) != 0); }
-#endif
-
-static const uint BIT_MASKS[33] = {
-	0x00000000, 0x00000001, 0x00000003, 0x00000007,
-	0x0000000F, 0x0000001F, 0x0000003F, 0x0000007F,
-	0x000000FF, 0x000001FF, 0x000003FF, 0x000007FF,
-	0x00000FFF, 0x00001FFF, 0x00003FFF, 0x00007FFF,
-	0x0000FFFF, 0x0001FFFF, 0x0003FFFF, 0x0007FFFF,
-	0x000FFFFF, 0x001FFFFF, 0x003FFFFF, 0x007FFFFF,
-	0x00FFFFFF, 0x01FFFFFF, 0x03FFFFFF, 0x07FFFFFF,
-	0x0FFFFFFF, 0x1FFFFFFF, 0x3FFFFFFF, 0x7FFFFFFF,
-	0xFFFFFFFF,
-};
-
-uint32 GetBitMask(uint32 n)
-{
-	assert(n <= 32);
-	return BIT_MASKS[n];
-}
-
-/// \internal
-static const int MultiplyDeBruijnBitPosition[32] = {
-	0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
-	31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9,
-};
-
-uint log2u(uint v)
-{
-	v |= v >> 1;
-	v |= v >> 2;
-	v |= v >> 4;
-	v |= v >> 8;
-	v |= v >> 16;
-	v = (v >> 1) + 1;
-	return MultiplyDeBruijnBitPosition[(v * 0x077CB531UL) >> 27];
-}
-
-/// \internal
-static unsigned int const PowersOf10[] = {
-	1, 10, 100, 1000, 10000, 100000,
-	1000000, 10000000, 100000000, 1000000000,
-};
-
-uint log10u(uint v)
-{
-	uint t = (log2u(v) + 1) * 1233 >> 12;
-	return t - (v < PowersOf10[t]);
-}
-
-/// \internal
-static const unsigned int InterleaveBits_B[] = {0x55555555, 0x33333333, 0x0F0F0F0F, 0x00FF00FF};
-/// \internal
-static const unsigned int InterleaveBits_S[] = {1, 2, 4, 8};
-
-uint InterleaveBits(uint a, uint b)
-{
-	a = (a | (a << InterleaveBits_S[3])) & InterleaveBits_B[3];
-	a = (a | (a << InterleaveBits_S[2])) & InterleaveBits_B[2];
-	a = (a | (a << InterleaveBits_S[1])) & InterleaveBits_B[1];
-	a = (a | (a << InterleaveBits_S[0])) & InterleaveBits_B[0];
-
-	b = (b | (b << InterleaveBits_S[3])) & InterleaveBits_B[3];
-	b = (b | (b << InterleaveBits_S[2])) & InterleaveBits_B[2];
-	b = (b | (b << InterleaveBits_S[1])) & InterleaveBits_B[1];
-	b = (b | (b << InterleaveBits_S[0])) & InterleaveBits_B[0];
-
-	return a | (b << 1);
-}
-
-uint Extend10BitsBy2Zeros(uint n)
-{
-	// Na podstawie ksiki: Real-Time Collision Detection, Christer Ericson
-
-    // n = ----------------------9876543210 : Bits initially
-    // n = ------98----------------76543210 : After (1)
-    // n = ------98--------7654--------3210 : After (2)
-    // n = ------98----76----54----32----10 : After (3)
-    // n = ----9--8--7--6--5--4--3--2--1--0 : After (4)
-    n = (n ^ (n << 16)) & 0xff0000ff; // (1)
-    n = (n ^ (n <<  8)) & 0x0300f00f; // (2)
-    n = (n ^ (n <<  4)) & 0x030c30c3; // (3)
-    n = (n ^ (n <<  2)) & 0x09249249; // (4)
-    return n;
-}
-
-uint Extend16BitsBy1Zero(uint n)
-{
-	// Na podstawie ksiki: Real-Time Collision Detection, Christer Ericson
-
-    // n = ----------------fedcba9876543210 : Bits initially
-    // n = --------fedcba98--------76543210 : After (1)
-    // n = ----fedc----ba98----7654----3210 : After (2)
-    // n = --fe--dc--ba--98--76--54--32--10 : After (3)
-    // n = -f-e-d-c-b-a-9-8-7-6-5-4-3-2-1-0 : After (4)
-    n = (n ^ (n <<  8)) & 0x00ff00ff; // (1)
-    n = (n ^ (n <<  4)) & 0x0f0f0f0f; // (2)
-    n = (n ^ (n <<  2)) & 0x33333333; // (3)
-    n = (n ^ (n <<  1)) & 0x55555555; // (4)
-    return n;
-}
-
-void sincos(float angle, float *sine, float *cosine)
-{
-	#if defined(_WIN32) && !defined(_WIN64)
-		// Procedur mam od: Karol Kuczmarski "Xion"
-		__asm
-		{
-			mov eax, sine
-			mov edx, cosine
-			fld     angle
-			fsincos
-			fstp    dword ptr [edx]
-			fstp    dword ptr [eax]
-		}
-
-	#else
-		*sine = sinf(angle);
-		*cosine = cosf(angle);
-
-	#endif
-}
-
-bool is_prime(unsigned n)
-{
-	if (n == 1) return false;
-	if (n < 4) return true; // 2 and 3 are prime
-	if (n % 2 == 0) return false;
-	if (n < 9) return true; // we have already excluded 4, 6 and 8.
-	if (n % 3 == 0) return false;
-	unsigned r = (unsigned)sqrt((double)n);
-	unsigned f = 5;
-	while (f <= r) {
-		if (n % f == 0) return false;
-		if (n % (f+2) == 0) return false;
-		f += 6;
-	}
-	return true;
-}
-
-// Funkcje SmoothCD s napisane na podstawie ksiki:
-// "Game Programming Gems", tom 4, rozdz. 1.10, str. 95.
-
-void SmoothCD(float *InOutPos, float Dest, float *InOutVel, float SmoothTime, float TimeDelta)
-{
-	float Omega = 2.f / SmoothTime;
-	float x = Omega * TimeDelta;
-	// Przyblienie funkcji 1 / exp(x) do dokadne dla wartoci 0..1
-	float Exp = 1.f / (1.f + x + 0.48f * x * x + 0.235f * x * x * x);
-	float Change = *InOutPos - Dest;
-	float Temp = (*InOutVel + Omega * Change) * TimeDelta;
-	*InOutVel = (*InOutVel - Omega * Temp) * Exp;
-	*InOutPos = Dest + (Change + Temp) * Exp;
-}
-
-void SmoothCD(float *InOutPos, float Dest, float *InOutVel, float SmoothTime, float TimeDelta, float MaxSpeed)
-{
-	float Omega = 2.f / SmoothTime;
-	float x = Omega * TimeDelta;
-	// Przyblienie funkcji 1 / exp(x) do dokadne dla wartoci 0..1
-	float Exp = 1.f / (1.f + x + 0.48f * x * x + 0.235f * x * x * x);
-	float Change = *InOutPos - Dest;
-	float MaxChange = MaxSpeed*SmoothTime;
-	Change = minmax(-MaxChange, Change, MaxChange);
-	float Temp = (*InOutVel + Omega * Change) * TimeDelta;
-	*InOutVel = (*InOutVel - Omega * Temp) * Exp;
-	*InOutPos = Dest + (Change + Temp) * Exp;
-}
-
-int QuadraticEquation(float a, float b, float c, float *Out_x1, float *Out_x2)
-{
-	float delta = (b * b) - (4.0f * a * c);
-	if (delta < 0.f)
-		return 0;
-	else if (FLOAT_ALMOST_ZERO(delta))
-	{
-		*Out_x1 = *Out_x2 = - b / (2.0f * a);
-		return 1;
-	}
-	else
-	{
-		float denominator = 1.0f / (2.0f * a);
-		float delta_sqr = sqrtf(delta);
-		*Out_x1 = (- b - delta_sqr) * denominator;
-		*Out_x2 = (- b + delta_sqr) * denominator;
-		return 2;
-	}
-}
-
-void CalcMeanAndVariance(const float Numbers[], size_t NumberCount, float *OutMean, float *OutVariance, bool VarianceBiased)
-{
-	CalcMeanAndVariance(Numbers, NumberCount, sizeof(float), OutMean, OutVariance, VarianceBiased);
-}
-
-void CalcMeanAndVariance(const void *NumberData, size_t NumberCount, ptrdiff_t NumberStride, float *OutMean, float *OutVariance, bool VarianceBiased)
-{
-	assert(NumberCount > 0);
-	const char *NumberBytes = (const char*)NumberData;
-	*OutMean = *(const float*)NumberBytes;
-	NumberBytes += NumberStride;
-
-	for (size_t i = 1; i < NumberCount; i++)
-	{
-		*OutMean += *(const float*)NumberBytes;
-		NumberBytes += NumberStride;
-	}
-
-	float NumberCountRcp = 1.0f / (float)NumberCount;
-	*OutMean *= NumberCountRcp;
-
-	if (OutVariance)
-	{
-		NumberBytes = (const char*)NumberData;
-		*OutVariance = (*(const float*)NumberBytes - *OutMean) * (*(const float*)NumberBytes - *OutMean);
-		NumberBytes += NumberStride;
-		float Tmp;
-
-		for (size_t i = 1; i < NumberCount; i++)
-		{
-			Tmp = *(const float*)NumberBytes - *OutMean;
-			*OutVariance += Tmp * Tmp;
-			NumberBytes += NumberStride;
-		}
-
-		if (VarianceBiased)
-			*OutVariance /= (float)(NumberCount - 1);
-		else
-			*OutVariance *= NumberCountRcp;
-	}
-}
-
-uint MurmurHash(const void *Data, uint DataLen, uint Seed)
-{
-	// Autor: Austin Appleby, http://murmurhash.googlepages.com/
-
-	// 'm' and 'r' are mixing constants generated offline.
-	// They're not really 'magic', they just happen to work well.
-	const unsigned int m = 0x5bd1e995;
-	const int r = 24;
-
-	// Initialize the hash to a 'random' value
-	unsigned int h = Seed ^ DataLen;
-
-	// Mix 4 bytes at a time into the hash
-	const unsigned char * data = (const unsigned char *)Data;
-
-	while(DataLen >= 4)
-	{
-		unsigned int k = *(unsigned int *)data;
-		k *= m; 
-		k ^= k >> r; 
-		k *= m; 
-		h *= m; 
-		h ^= k;
-		data += 4;
-		DataLen -= 4;
-	}
-
-	// Handle the last few bytes of the input array
-	switch(DataLen)
-	{
-	case 3: h ^= data[2] << 16;
-	case 2: h ^= data[1] << 8;
-	case 1: h ^= data[0];
-	h *= m;
-	};
-
-	// Do a few final mixes of the hash to ensure the last few
-	// bytes are well-incorporated.
-	h ^= h >> 13;
-	h *= m;
-	h ^= h >> 15;
-
-	return h;
-}
-
-#define get16bits(d) ((((uint)(((const uint8 *)(d))[1])) << 8)\
-                       +(uint)(((const uint8 *)(d))[0]) )
-
-uint SuperFastHash(const void *DataBytes, size_t DataLen)
-{
-	const char *data = (const char *)DataBytes;
-    assert(DataLen <= (size_t)UINT32_MAX);
-	uint hash = (uint)DataLen, tmp;
-	int rem;
-
-	assert(data != NULL && DataLen > 0);
-
-    rem = DataLen & 3;
-    DataLen >>= 2;
-
-    // Main loop
-    for (;DataLen > 0; DataLen--) {
-        hash  += get16bits (data);
-        tmp    = (get16bits (data+2) << 11) ^ hash;
-        hash   = (hash << 16) ^ tmp;
-        data  += 2*sizeof (uint16);
-        hash  += hash >> 11;
-    }
-
-    // Handle end cases
-    switch (rem) {
-        case 3: hash += get16bits (data);
-                hash ^= hash << 16;
-                hash ^= data[sizeof (uint16)] << 18;
-                hash += hash >> 11;
-                break;
-        case 2: hash += get16bits (data);
-                hash ^= hash << 11;
-                hash += hash >> 17;
-                break;
-        case 1: hash += *data;
-                hash ^= hash << 10;
-                hash += hash >> 1;
-    }
-
-    // Force "avalanching" of final 127 bits
-    hash ^= hash << 3;
-    hash += hash >> 5;
-    hash ^= hash << 4;
-    hash += hash >> 17;
-    hash ^= hash << 25;
-    hash += hash >> 6;
-
-    return hash;
-}
-
-#undef get16bits
-
-/*
-Szum Perlina (Perlin Noise) - algorytm na podstawie implementacji referencyjnej
-w jzyku Java - "Improved Noise reference implementation", Ken Perlin, 2002,
-http://mrl.nyu.edu/~perlin/noise/
-*/
-
-inline float Perlin_Fade(float t)
-{
-	return t * t * t * (t * (t * 6 - 15) + 10);
-}
-
-inline float Perlin_Lerp(float t, float a, float b)
-{
-	return a + t * (b - a);
-}
-
-inline float Perlin_Grad1(int hash, float x)
-{
-	// Convert lo 4 bits of hash code into 12 gradient directions
-	int h = hash & 15;
-	float u = h<8 ? x : 0.f, v = h<4 ? 0.f : h==12||h==14 ? x : 0.f;
-	return ((h&1) == 0 ? u : -u) + ((h&2) == 0 ? v : -v);
-}
-
-inline float Perlin_Grad2(int hash, float x, float y)
-{
-	// Convert lo 4 bits of hash code into 12 gradient directions
-	int h = hash & 15;
-	float u = h<8 ? x : y, v = h<4 ? y : h==12||h==14 ? x : 0.f;
-	return ((h&1) == 0 ? u : -u) + ((h&2) == 0 ? v : -v);
-}
-
-inline float Perlin_Grad3(int hash, float x, float y, float z)
-{
-	// Convert lo 4 bits of hash code into 12 gradient directions
-	int h = hash & 15;
-	float u = h<8 ? x : y, v = h<4 ? y : h==12||h==14 ? x : z;
-	return ((h&1) == 0 ? u : -u) + ((h&2) == 0 ? v : -v);
-}
-
-int Perlin_P[] = {
-	151,160,137,91,90,15,
-	131,13,201,95,96,53,194,233,7,225,140,36,103,30,69,142,8,99,37,240,21,10,23,
-	190, 6,148,247,120,234,75,0,26,197,62,94,252,219,203,117,35,11,32,57,177,33,
-	88,237,149,56,87,174,20,125,136,171,168, 68,175,74,165,71,134,139,48,27,166,
-	77,146,158,231,83,111,229,122,60,211,133,230,220,105,92,41,55,46,245,40,244,
-	102,143,54, 65,25,63,161, 1,216,80,73,209,76,132,187,208, 89,18,169,200,196,
-	135,130,116,188,159,86,164,100,109,198,173,186, 3,64,52,217,226,250,124,123,
-	5,202,38,147,118,126,255,82,85,212,207,206,59,227,47,16,58,17,182,189,28,42,
-	223,183,170,213,119,248,152, 2,44,154,163, 70,221,153,101,155,167, 43,172,9,
-	129,22,39,253, 19,98,108,110,79,113,224,232,178,185, 112,104,218,246,97,228,
-	251,34,242,193,238,210,144,12,191,179,162,241, 81,51,145,235,249,14,239,107,
-	49,192,214, 31,181,199,106,157,184, 84,204,176,115,121,50,45,127, 4,150,254,
-	138,236,205,93,222,114,67,29,24,72,243,141,128,195,78,66,215,61,156,180
-	,
-	151,160,137,91,90,15,
-	131,13,201,95,96,53,194,233,7,225,140,36,103,30,69,142,8,99,37,240,21,10,23,
-	190, 6,148,247,120,234,75,0,26,197,62,94,252,219,203,117,35,11,32,57,177,33,
-	88,237,149,56,87,174,20,125,136,171,168, 68,175,74,165,71,134,139,48,27,166,
-	77,146,158,231,83,111,229,122,60,211,133,230,220,105,92,41,55,46,245,40,244,
-	102,143,54, 65,25,63,161, 1,216,80,73,209,76,132,187,208, 89,18,169,200,196,
-	135,130,116,188,159,86,164,100,109,198,173,186, 3,64,52,217,226,250,124,123,
-	5,202,38,147,118,126,255,82,85,212,207,206,59,227,47,16,58,17,182,189,28,42,
-	223,183,170,213,119,248,152, 2,44,154,163, 70,221,153,101,155,167, 43,172,9,
-	129,22,39,253, 19,98,108,110,79,113,224,232,178,185, 112,104,218,246,97,228,
-	251,34,242,193,238,210,144,12,191,179,162,241, 81,51,145,235,249,14,239,107,
-	49,192,214, 31,181,199,106,157,184, 84,204,176,115,121,50,45,127, 4,150,254,
-	138,236,205,93,222,114,67,29,24,72,243,141,128,195,78,66,215,61,156,180
-};
-
-float PerlinNoise1(float x)
-{
-	// Find unit cube that contains point
-	int X = (int)x & 255;
-	// Find relative x,y,z of point in cube
-	x -= floorf(x);
-	// Compute Perlin_Fade curves for each x,y,z
-	float u = Perlin_Fade(x);
-	// Hash coordinates of the 8 cube corners
-	int A = Perlin_P[X  ], AA = Perlin_P[A];
-	int B = Perlin_P[X+1], BA = Perlin_P[B];
-
-	// and add blended results from 8 curners of cube
-	return Perlin_Lerp(u,
-		Perlin_Grad1(Perlin_P[AA  ], x   ),
-		Perlin_Grad1(Perlin_P[BA  ], x-1 ));
-}
-
-float PerlinNoise2(float x, float y)
-{
-	// Find unit cube that contains point
-	int X = (int)x & 255;
-	int Y = (int)y & 255;
-	// Find relative x,y,z of point in cube
-	x -= floorf(x);
-	y -= floorf(y);
-	// Compute Perlin_Fade curves for each x,y,z
-	float u = Perlin_Fade(x);
-	float v = Perlin_Fade(y);
-	// Hash coordinates of the 8 cube corners
-	int A = Perlin_P[X  ]+Y, AA = Perlin_P[A], AB = Perlin_P[A+1];
-	int B = Perlin_P[X+1]+Y, BA = Perlin_P[B], BB = Perlin_P[B+1];
-
-	// and add blended results from 8 curners of cube
-	return Perlin_Lerp(v,
-		Perlin_Lerp(u,
-			Perlin_Grad2(Perlin_P[AA  ], x  , y   ),
-			Perlin_Grad2(Perlin_P[BA  ], x-1, y   )),
-		Perlin_Lerp(u,
-			Perlin_Grad2(Perlin_P[AB  ], x  , y-1 ),
-			Perlin_Grad2(Perlin_P[BB  ], x-1, y-1 )));
-}
-
-float PerlinNoise3(float x, float y, float z)
-{
-	// Find unit cube that contains point
-	int X = (int)x & 255;
-	int Y = (int)y & 255;
-	int Z = (int)z & 255;
-	// Find relative x,y,z of point in cube
-	x -= floorf(x);
-	y -= floorf(y);
-	z -= floorf(z);
-	// Compute Perlin_Fade curves for each x,y,z
-	float u = Perlin_Fade(x);
-	float v = Perlin_Fade(y);
-	float w = Perlin_Fade(z);
-	// Hash coordinates of the 8 cube corners
-	int A = Perlin_P[X  ]+Y, AA = Perlin_P[A]+Z, AB = Perlin_P[A+1]+Z;
-	int B = Perlin_P[X+1]+Y, BA = Perlin_P[B]+Z, BB = Perlin_P[B+1]+Z;
-
-	// and add blended results from 8 curners of cube
-	return Perlin_Lerp(w,
-		Perlin_Lerp(v,
-			Perlin_Lerp(u,
-				Perlin_Grad3(Perlin_P[AA  ], x  , y  , z   ),
-				Perlin_Grad3(Perlin_P[BA  ], x-1, y  , z   )),
-			Perlin_Lerp(u,
-				Perlin_Grad3(Perlin_P[AB  ], x  , y-1, z   ),
-				Perlin_Grad3(Perlin_P[BB  ], x-1, y-1, z   ))),
-		Perlin_Lerp(v,
-			Perlin_Lerp(u,
-				Perlin_Grad3(Perlin_P[AA+1], x  , y  , z-1 ),
-				Perlin_Grad3(Perlin_P[BA+1], x-1, y  , z-1 )),
-			Perlin_Lerp(u,
-				Perlin_Grad3(Perlin_P[AB+1], x  , y-1, z-1 ),
-				Perlin_Grad3(Perlin_P[BB+1], x-1, y-1, z-1 ))));
-}
-
-float BrownianNoise1(float x, uint i, float Persistence)
-{
-	float R = 0.f;
-	float Frequency = 1.f, Amplitude = 1.f;
-	for (uint j = 0; j < i; j++)
-	{
-		R += PerlinNoise1(x * Frequency) * Amplitude;
-		Frequency *= 2.f;
-		Amplitude *= Persistence;
-	}
-	return R;
-}
-
-float BrownianNoise2(float x, float y, uint i, float Persistence)
-{
-	float R = 0.f;
-	float Frequency = 1.f, Amplitude = 1.f;
-	for (uint j = 0; j < i; j++)
-	{
-		R += PerlinNoise2(x * Frequency, y * Frequency) * Amplitude;
-		Frequency *= 2.f;
-		Amplitude *= Persistence;
-	}
-	return R;
-}
-
-float BrownianNoise3(float x, float y, float z, uint i, float Persistence)
-{
-	float R = 0.f;
-	float Frequency = 1.f, Amplitude = 1.f;
-	for (uint j = 0; j < i; j++)
-	{
-		R += PerlinNoise3(x * Frequency, y * Frequency, z * Frequency) * Amplitude;
-		Frequency *= 2.f;
-		Amplitude *= Persistence;
-	}
-	return R;
-}
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-// GENERATOR LICZB PSEUDOLOSOWYCH
-
-RandomGenerator::RandomGenerator() :
-	m_HasNextNormalNumber(false)
-{
-	m_Seed = (uint32)time(0);
-}
-
-void RandomGenerator::RandData(void *OutData, size_t DataLength)
-{
-	size_t WordCount = DataLength >> 2;
-	size_t RemainingBytes = DataLength & 0x3;
-
-	uint *OutWords = (uint*)OutData;
-	while (WordCount > 0)
-	{
-		*OutWords = RandUint();
-		OutWords++;
-		WordCount--;
-	}
-
-	if (RemainingBytes > 0)
-	{
-		uint x = RandUint();
-		uint8 *OutBytes = (uint8*)OutWords;
-		switch (RemainingBytes)
-		{
-		case 3:
-			*OutBytes = (x >> 23) & 0xFF; // Te przesunicia bitowe s przypadkowe
-			OutBytes++;
-		case 2:
-			*OutBytes = (x >> 9) & 0xFF;
-			OutBytes++;
-		case 1:
-			*OutBytes = x & 0xFF;
-		}
-	}
-}
-
-float RandomGenerator::RandNormal(float sigma)
-{
-	// Nowa implementacja
-	// The polar form of the Box-Muller transformation
-	// rdo: http://www.taygeta.com/random/gaussian.html
-	// Ten algorytm generuje dwie liczby na raz, wic jedn zwraca od razu, a drug
-	// zapamituje do nastpnego wywoania tej metody.
-	if (m_HasNextNormalNumber)
-	{
-		m_HasNextNormalNumber = false;
-		return m_NextNormalNumber * sigma;
-	}
-	else
-	{
-		float x1, x2, w;
-		do {
-			x1 = 2.0f * RandFloat() - 1.0f;
-			x2 = 2.0f * RandFloat() - 1.0f;
-			w = x1 * x1 + x2 * x2;
-		} while (w >= 1.0f);
-		w = sqrtf((-2.0f * logf(w)) / w);
-		m_NextNormalNumber = x2 * w; // Druga wygenerowana liczba
-		m_HasNextNormalNumber = true;
-		return x1 * w * sigma; // Pierwsza wygenerowana liczba
-	}
-
-	// Stara implementacja
-/*	float u1 = RandFloat(), u2 = RandFloat();
-	float z = sqrtf(-2.0f*log(u1)) * cosf(2*PI*u2);
-	if (RandBool())
-		return z * sigma;
-	else
-		return -z * sigma;*/
-}
-
-RandomGenerator g_Rand;
-
-
-#define MERSENNE_N 624
-#define MERSENNE_M 397
-#define MERSENNE_MATRIX_A 0x9908b0dfUL   /* constant vector a */
-#define MERSENNE_UMASK 0x80000000UL /* most significant w-r bits */
-#define MERSENNE_LMASK 0x7fffffffUL /* least significant r bits */
-#define MERSENNE_MIXBITS(u,v) ( ((u) & MERSENNE_UMASK) | ((v) & MERSENNE_LMASK) )
-#define MERSENNE_TWIST(u,v) ((MERSENNE_MIXBITS(u,v) >> 1) ^ ((v)&1U ? MERSENNE_MATRIX_A : 0U))
-
-MersenneTwister::MersenneTwister()
-{
-	Init((uint32)time(0));
-}
-
-MersenneTwister::MersenneTwister(uint Seed)
-{
-	Init(Seed);
-}
-
-MersenneTwister::MersenneTwister(uint InitKeys[], int KeyCount)
-{
-	int i, j, k;
-	Init(19650218U);
-	i=1; j=0;
-	k = (MERSENNE_N>KeyCount ? MERSENNE_N : KeyCount);
-	for (; k; k--)
-	{
-		m_State[i] = (m_State[i] ^ ((m_State[i-1] ^ (m_State[i-1] >> 30)) * 1664525U)) + InitKeys[j] + j;
-		m_State[i] &= 0xffffffffU;
-		i++; j++;
-		if (i>=MERSENNE_N) { m_State[0] = m_State[MERSENNE_N-1]; i=1; }
-		if (j>=KeyCount) j=0;
-	}
-	for (k=MERSENNE_N-1; k; k--)
-	{
-		m_State[i] = (m_State[i] ^ ((m_State[i-1] ^ (m_State[i-1] >> 30)) * 1566083941U)) - i;
-		//m_State[i] &= 0xffffffffU; /* for WORDSIZE > 32 machines */
-		i++;
-		if (i>=MERSENNE_N) { m_State[0] = m_State[MERSENNE_N-1]; i=1; }
-	}
-
-	m_State[0] = 0x80000000UL; /* MSB is 1; assuring non-zero initial array */ 
-	m_Left = 1;
-}
-
-void MersenneTwister::Init(uint Seed)
-{
-	int j;
-	m_State[0] = Seed & 0xffffffffU;
-	for (j=1; j<MERSENNE_N; j++)
-	{
-		m_State[j] = (1812433253U * (m_State[j-1] ^ (m_State[j-1] >> 30)) + j); 
-		m_State[j] &= 0xffffffffU;
-	}
-	m_Left = 1;
-}
-
-void MersenneTwister::NextState()
-{
-	unsigned *p=m_State;
-	int j;
-
-	m_Left = MERSENNE_N;
-	m_Next = m_State;
-
-	for (j=MERSENNE_N-MERSENNE_M+1; --j; p++) 
-		*p = p[MERSENNE_M] ^ MERSENNE_TWIST(p[0], p[1]);
-
-	for (j=MERSENNE_M; --j; p++) 
-		*p = p[MERSENNE_M-MERSENNE_N] ^ MERSENNE_TWIST(p[0], p[1]);
-
-	*p = p[MERSENNE_M-MERSENNE_N] ^ MERSENNE_TWIST(p[0], m_State[0]);
-}
-
-uint MersenneTwister::NextUint()
-{
-	unsigned y;
-
-	if (--m_Left == 0) NextState();
-	y = *m_Next++;
-
-	y ^= (y >> 11);
-	y ^= (y << 7) & 0x9d2c5680U;
-	y ^= (y << 15) & 0xefc60000U;
-	y ^= (y >> 18);
-
-	return y;
-}
-
-int MersenneTwister::NextInt31()
-{
-	unsigned y;
-
-	if (--m_Left == 0) NextState();
-	y = *m_Next++;
-
-	y ^= (y >> 11);
-	y ^= (y << 7) & 0x9d2c5680U;
-	y ^= (y << 15) & 0xefc60000U;
-	y ^= (y >> 18);
-
-	return (int)(y>>1);
-}
-
-double MersenneTwister::NextReal1()
-{
-	unsigned y;
-
-	if (--m_Left == 0) NextState();
-	y = *m_Next++;
-
-	y ^= (y >> 11);
-	y ^= (y << 7) & 0x9d2c5680U;
-	y ^= (y << 15) & 0xefc60000U;
-	y ^= (y >> 18);
-
-	return (double)y * (1.0/4294967295.0); 
-	// divided by 2^32-1
-}
-
-double MersenneTwister::NextReal2()
-{
-	unsigned y;
-
-	if (--m_Left == 0) NextState();
-	y = *m_Next++;
-
-	y ^= (y >> 11);
-	y ^= (y << 7) & 0x9d2c5680U;
-	y ^= (y << 15) & 0xefc60000U;
-	y ^= (y >> 18);
-
-	return (double)y * (1.0/4294967296.0); 
-	// divided by 2^32
-}
-
-double MersenneTwister::NextReal3()
-{
-	unsigned y;
-
-	if (--m_Left == 0) NextState();
-	y = *m_Next++;
-
-	y ^= (y >> 11);
-	y ^= (y << 7) & 0x9d2c5680U;
-	y ^= (y << 15) & 0xefc60000U;
-	y ^= (y >> 18);
-
-	return ((double)y + 0.5) * (1.0/4294967296.0); 
-	// divided by 2^32
-}
-
-double MersenneTwister::NextReal_Res53()
-{
-	unsigned a=NextUint()>>5, b=NextUint()>>6; 
-	return(a*67108864.0+b)*(1.0/9007199254740992.0); 
-}
-
-
-UniqueGenerator::UniqueGenerator() :
-	m_Next(1)
-{
-}
-
-UniqueGenerator::UniqueGenerator(uint32 First) :
-	m_Next(First)
-{
-}
-
-void UniqueGenerator::GetString(tstring *Out)
-{
-	UintToStr2(Out, m_Next, 8, 16);
-	m_Next++;
-}
-
-void UniqueGenerator::GetString(tstring *Out, const tstring &Prefix)
-{
-	tstring s;
-	UintToStr2(&s, m_Next, 8, 16);
-
-	*Out = Prefix;
-	*Out += s;
-
-	m_Next++;
-}
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-// Parser wiersza polece
-
-class CmdLineParser_pimpl
-{
-private:
-	struct SHORT_OPT
-	{
-		uint Id;
-		tchar Opt;
-		bool Parameter;
-
-		SHORT_OPT(uint Id, tchar Opt, bool Parameter) : Id(Id), Opt(Opt), Parameter(Parameter) { }
-	};
-
-	struct LONG_OPT
-	{
-		uint Id;
-		tstring Opt;
-		bool Parameter;
-
-		LONG_OPT(uint Id, tstring Opt, bool Parameter) : Id(Id), Opt(Opt), Parameter(Parameter) { }
-	};
-
-	// ==== Warstwa I ====
-
-	// Zawsze niezerowe jest albo m_argv, albo m_CmdLine.
-	tchar **m_argv;
-	const tchar *m_CmdLine;
-	// Wane tylko, jeli m_argv != NULL
-	int m_argc;
-	// Wane tylko jeli m_CmdLine != NULL
-	size_t m_CmdLineLength;
-	// Jeli m_argv != NULL, przechowuje indeks nastpnego argumentu w m_argv.
-	// Jeli m_CmdLine != NULL, przechowuje indeks nastpnego znaku w m_CmdLine.
-	size_t m_ArgIndex;
-
-	// Zwraca nastpny argumet
-	// Zwraca false, jeli nie odczytano nastpnego argumentu, bo ju koniec.
-	bool ReadNextArg(tstring *OutArg);
-
-	// ==== Zarejestrowane argumenty ====
-
-	std::vector<SHORT_OPT> m_ShortOpts;
-	std::vector<LONG_OPT> m_LongOpts;
-
-	// Zwraca wskank do struktury ze znalezion opcj lub NULL jeli nie znalaz
-	SHORT_OPT * FindShortOpt(tchar Opt);
-	LONG_OPT * FindLongOpt(const tstring &Opt);
-
-	// ==== Warstwa II ====
-
-	// Stan - czy jestemy wewnrz parsowania cigu poczonych opcji jednoznakowych
-	bool m_InsideMultioption;
-	// Zapamitany ostatnio pobrany argument - tylko jeli m_InsideMultioption == true
-	tstring m_LastArg;
-	// Indeks nastpnego znaku do sparsowania w tym argumencie - tylko jeli m_InsideMultioption == true
-	size_t m_LastArgIndex;
-	// Dane do zwracania w zwizku z ostatnio odczytan informacj
-	uint m_LastOptId;
-	tstring m_LastParameter;
-
-public:
-	CmdLineParser_pimpl(int argc, tchar **argv);
-	CmdLineParser_pimpl(const tchar *CmdLine);
-
-	void RegisterOpt(uint Id, tchar Opt, bool Parameter);
-	void RegisterOpt(uint Id, const tstring &Opt, bool Parameter);
-
-	CmdLineParser::RESULT ReadNext();
-	uint GetOptId();
-	const tstring & GetParameter();
-};
-
-bool CmdLineParser_pimpl::ReadNextArg(tstring *OutArg)
-{
-	if (m_argv != NULL)
-	{
-		if (m_ArgIndex >= (size_t)m_argc) return false;
-
-		*OutArg = m_argv[m_ArgIndex];
-		m_ArgIndex++;
-		return true;
-	}
-	else
-	{
-		if (m_ArgIndex >= m_CmdLineLength) return false;
-		
-		// Algorytm parsowania opracowany na podstawie dogbnych bada zachowania wiersza polece Windows
-		// z rnymi dziwnymi kombinacjami znakw w parametrach i sposobu ich przetwarzania na argc i argv
-		// przekazywane przez system do main().
-		OutArg->clear();
-		bool InsideQuotes = false;
-		while (m_ArgIndex < m_CmdLineLength)
-		{
-			tchar Ch = m_CmdLine[m_ArgIndex];
-			if (Ch == _T('\\'))
-			{
-				// Analiza dalszego cigu acucha
-				bool FollowedByQuote = false; // wynik analizy 1
-				size_t BackslashCount = 1; // wynik analizy 2
-				size_t TmpIndex = m_ArgIndex + 1;
-				while (TmpIndex < m_CmdLineLength)
-				{
-					tchar TmpCh = m_CmdLine[TmpIndex];
-					if (TmpCh == _T('\\'))
-					{
-						BackslashCount++;
-						TmpIndex++;
-					}
-					else if (TmpCh == _T('"'))
-					{
-						FollowedByQuote = true;
-						break;
-					}
-					else
-						break;
-				}
-
-				// Stosowne do wynikw analizy dalsze postpowanie
-				if (FollowedByQuote)
-				{
-					// Parzysta liczba '\'
-					if (BackslashCount % 2 == 0)
-					{
-						for (size_t i = 0; i < BackslashCount / 2; i++)
-							*OutArg += _T('\\');
-						m_ArgIndex += BackslashCount + 1;
-						InsideQuotes = !InsideQuotes;
-					}
-					// Nieparzysta liczba '\'
-					else
-					{
-						for (size_t i = 0; i < BackslashCount / 2; i++)
-							*OutArg += _T('\\');
-						*OutArg += _T('"');
-						m_ArgIndex += BackslashCount + 1;
-					}
-				}
-				else
-				{
-					for (size_t i = 0; i < BackslashCount; i++)
-						*OutArg += _T('\\');
-					m_ArgIndex += BackslashCount;
-				}
-			}
-			else if (Ch == _T('"'))
-			{
-				InsideQuotes = !InsideQuotes;
-				m_ArgIndex++;
-			}
-			else if (CharIsWhitespace(Ch))
-			{
-				if (InsideQuotes)
-				{
-					*OutArg += Ch;
-					m_ArgIndex++;
-				}
-				else
-				{
-					m_ArgIndex++;
-					break;
-				}
-			}
-			else
-			{
-				*OutArg += Ch;
-				m_ArgIndex++;
-			}
-		}
-
-		// Pomi dodatkowe odstpy
-		while (m_ArgIndex < m_CmdLineLength && CharIsWhitespace(m_CmdLine[m_ArgIndex]))
-			m_ArgIndex++;
-
-		return true;
-	}
-}
-
-CmdLineParser_pimpl::SHORT_OPT * CmdLineParser_pimpl::FindShortOpt(tchar Opt)
-{
-	for (size_t i = 0; i < m_ShortOpts.size(); i++)
-		if (m_ShortOpts[i].Opt == Opt)
-			return &m_ShortOpts[i];
-	return NULL;
-}
-
-CmdLineParser_pimpl::LONG_OPT * CmdLineParser_pimpl::FindLongOpt(const tstring &Opt)
-{
-	for (size_t i = 0; i < m_LongOpts.size(); i++)
-		if (m_LongOpts[i].Opt == Opt)
-			return &m_LongOpts[i];
-	return NULL;
-}
-
-CmdLineParser_pimpl::CmdLineParser_pimpl(int argc, tchar **argv) :
-	m_argv(argv),
-	m_CmdLine(NULL),
-	m_argc(argc),
-	m_CmdLineLength(0),
-	m_ArgIndex(1),
-	m_InsideMultioption(false),
-	m_LastArgIndex(0),
-	m_LastOptId(0)
-{
-	assert(argc > 0);
-	assert(argv != NULL);
-}
-
-CmdLineParser_pimpl::CmdLineParser_pimpl(const tchar *CmdLine) :
-	m_argv(NULL),
-	m_CmdLine(CmdLine),
-	m_argc(0),
-	m_ArgIndex(0),
-	m_InsideMultioption(false),
-	m_LastArgIndex(0),
-	m_LastOptId(0)
-{
-	assert(CmdLine != NULL);
-
-#ifdef _UNICODE
-	m_CmdLineLength = _tcslen(m_CmdLine);
-#else
-	m_CmdLineLength = strlen(m_CmdLine);
-#endif
-
-	// Pomi pocztkowe odstpy
-	while (m_ArgIndex < m_CmdLineLength && CharIsWhitespace(m_CmdLine[m_ArgIndex]))
-		m_ArgIndex++;
-}
-
-void CmdLineParser_pimpl::RegisterOpt(uint Id, tchar Opt, bool Parameter)
-{
-	assert(Opt != _T('\0'));
-
-	m_ShortOpts.push_back(SHORT_OPT(Id, Opt, Parameter));
-}
-
-void CmdLineParser_pimpl::RegisterOpt(uint Id, const tstring &Opt, bool Parameter)
-{
-	assert(!Opt.empty());
-	
-	m_LongOpts.push_back(LONG_OPT(Id, Opt, Parameter));
-}
-
-CmdLineParser::RESULT CmdLineParser_pimpl::ReadNext()
-{
-	if (m_InsideMultioption)
-	{
-		// acuch rozpoczynajcy si od m_LastArg[m_LastArgIndex] jest krtk opcj - jeden znak, dalej mog by rne rzeczy.
-		assert(m_LastArgIndex < m_LastArg.length());
-		SHORT_OPT *so = FindShortOpt(m_LastArg[m_LastArgIndex]);
-		// Nie ma takiej opcji - bd
-		if (so == NULL)
-		{
-			m_LastOptId = 0;
-			m_LastParameter.clear();
-			return CmdLineParser::RESULT_ERROR;
-		}
-		// Ta opcja powinna mie parametr
-		if (so->Parameter)
-		{
-			// Co jest dalej?
-			// Dalej nie ma nic
-			if (m_LastArg.length() == m_LastArgIndex+1)
-			{
-				// Nastpny argument to parameter - wczytaj go prosto tam gdzie trzeba
-				if (!ReadNextArg(&m_LastParameter))
-				{
-					// Nie ma nastpnego argumentu, a oczekiwany jest parametr - bd
-					m_LastOptId = 0;
-					m_LastParameter.clear();
-					return CmdLineParser::RESULT_ERROR;
-				}
-				m_InsideMultioption = false;
-				m_LastOptId = so->Id;
-				return CmdLineParser::RESULT_OPT;
-			}
-			// Dalej jest '='
-			else if (m_LastArg[m_LastArgIndex+1] == '=')
-			{
-				m_InsideMultioption = false;
-				m_LastParameter = m_LastArg.substr(m_LastArgIndex+2);
-				m_LastOptId = so->Id;
-				return CmdLineParser::RESULT_OPT;
-			}
-			// Dalej jest co innego - to bezporednio parametr
-			else
-			{
-				m_InsideMultioption = false;
-				m_LastParameter = m_LastArg.substr(m_LastArgIndex+1);
-				m_LastOptId = so->Id;
-				return CmdLineParser::RESULT_OPT;
-			}
-		}
-		// Ta opcja nie powinna mie parametru
-		else
-		{
-			// Koniec
-			if (m_LastArg.length() == m_LastArgIndex+1)
-			{
-				m_InsideMultioption = false;
-				m_LastParameter.clear();
-				m_LastOptId = so->Id;
-				return CmdLineParser::RESULT_OPT;
-			}
-			// Nie koniec - nastpne parametry w tej samej komendzie - dalej ten specjalny stan!
-			else
-			{
-				// m_InsideMultioption = true; - pozostaje
-				// m_LastArg pozostaje wypeniony
-				m_LastArgIndex++;
-
-				m_LastParameter.clear();
-				m_LastOptId = so->Id;
-				return CmdLineParser::RESULT_OPT;
-			}
-		}
-	}
-	else
-	{
-		// Pobierz nastpny argument
-		// Uyjemy tu sobie m_LastArg, bo i czemu nie - dopki m_InsideMultioption == false, i tak jest nieistotny.
-		if (!ReadNextArg(&m_LastArg))
-		{
-			// Koniec
-			m_LastParameter.clear();
-			m_LastOptId = 0;
-			return CmdLineParser::RESULT_END;
-		}
-		
-		// Sprawd pierwszy znak
-		// - Zaczyna si od '-'
-		if (!m_LastArg.empty() && m_LastArg[0] == _T('-'))
-		{
-			// Zaczyna si od '--'
-			if (m_LastArg.length() > 1 && m_LastArg[1] == _T('-'))
-			{
-				size_t EqualIndex = m_LastArg.find(_T('='), 2);
-				// Jest znak '='
-				if (EqualIndex != tstring::npos)
-				{
-					// To ma by duga opcja "--nazwa=param"
-					LONG_OPT *lo = FindLongOpt(m_LastArg.substr(2, EqualIndex-2));
-					// Jeli nie ma takiej dugiej opcji - bd
-					// Ta opcja musi oczekiwa parametru skoro jest '=' - jeli nie oczekuje, to bd
-					if (lo == NULL || lo->Parameter == false)
-					{
-						m_LastOptId = 0;
-						m_LastParameter.clear();
-						return CmdLineParser::RESULT_ERROR;
-					}
-					m_LastParameter = m_LastArg.substr(EqualIndex+1);
-					m_LastOptId = lo->Id;
-					return CmdLineParser::RESULT_OPT;
-				}
-				// Nie ma znaku '='
-				else
-				{
-					// To ma by duga opcja "--nazwa" lub "--nazwa param"
-					LONG_OPT *lo = FindLongOpt(m_LastArg.substr(2));
-					// Jeli nie ma takiej dugiej opcji - bd
-					if (lo == NULL)
-					{
-						m_LastOptId = 0;
-						m_LastParameter.clear();
-						return CmdLineParser::RESULT_ERROR;
-					}
-					// Jeli ta opcja oczekuje parametru
-					if (lo->Parameter)
-					{
-						// Nastpny argument to parameter - wczytaj go prosto tam gdzie trzeba
-						if (!ReadNextArg(&m_LastParameter))
-						{
-							// Nie ma nastpnego argumentu, a oczekiwany jest parametr - bd
-							m_LastOptId = 0;
-							m_LastParameter.clear();
-							return CmdLineParser::RESULT_ERROR;
-						}
-					}
-					// Nie oczekuje parametru
-					else
-						m_LastParameter.clear();
-					// Koniec - sukces
-					m_LastOptId = lo->Id;
-					return CmdLineParser::RESULT_OPT;
-				}
-			}
-			// Zaczyna si od samego '-'
-			else
-			{
-				// Krtka opcja
-				// To jest opcja jednoznakowa. Dalej mog by rne rzeczy
-				// Samo '-' - bd
-				if (m_LastArg.length() < 2)
-				{
-					m_LastOptId = 0;
-					m_LastParameter.clear();
-					return CmdLineParser::RESULT_ERROR;
-				}
-				SHORT_OPT *so = FindShortOpt(m_LastArg[1]);
-				// Nie ma takiej opcji - bd
-				if (so == NULL)
-				{
-					m_LastOptId = 0;
-					m_LastParameter.clear();
-					return CmdLineParser::RESULT_ERROR;
-				}
-				// Ta opcja powinna mie parametr
-				if (so->Parameter)
-				{
-					// Co jest dalej?
-					// Dalej nie ma nic
-					if (m_LastArg.length() == 2)
-					{
-						// Nastpny argument to parameter - wczytaj go prosto tam gdzie trzeba
-						if (!ReadNextArg(&m_LastParameter))
-						{
-							// Nie ma nastpnego argumentu, a oczekiwany jest parametr - bd
-							m_LastOptId = 0;
-							m_LastParameter.clear();
-							return CmdLineParser::RESULT_ERROR;
-						}
-						m_LastOptId = so->Id;
-						return CmdLineParser::RESULT_OPT;
-					}
-					// Dalej jest '='
-					else if (m_LastArg[2] == _T('='))
-					{
-						m_LastParameter = m_LastArg.substr(3);
-						m_LastOptId = so->Id;
-						return CmdLineParser::RESULT_OPT;
-					}
-					// Dalej jest co innego - to bezporednio parametr
-					else
-					{
-						m_LastParameter = m_LastArg.substr(2);
-						m_LastOptId = so->Id;
-						return CmdLineParser::RESULT_OPT;
-					}
-				}
-				// Ta opcja nie powinna mie parametru
-				else
-				{
-					// Koniec
-					if (m_LastArg.length() == 2)
-					{
-						m_LastParameter.clear();
-						m_LastOptId = so->Id;
-						return CmdLineParser::RESULT_OPT;
-					}
-					// Nie koniec - nastpne parametry w tej samej komendzie - specjalny stan!
-					else
-					{
-						m_InsideMultioption = true;
-						// m_LastArg ju wypeniony
-						m_LastArgIndex = 2;
-
-						m_LastParameter.clear();
-						m_LastOptId = so->Id;
-						return CmdLineParser::RESULT_OPT;
-					}
-				}
-			}
-		}
-		// - Zaczyna si od '/'
-		else if (!m_LastArg.empty() && m_LastArg[0] == _T('/'))
-		{
-			size_t EqualIndex = m_LastArg.find(_T('='), 1);
-			// Jest znak '='
-			if (EqualIndex != tstring::npos)
-			{
-				// To ma by krtka lub duga opcja "/nazwa=param"
-				// To moe by krtka
-				if (EqualIndex == 2)
-				{
-					SHORT_OPT *so = FindShortOpt(m_LastArg[1]);
-					// Znaleziono krtk opcj
-					if (so != NULL)
-					{
-						// Ta opcja musi oczekiwa parametru skoro jest '=' - jeli nie oczekuje, to bd
-						if (so->Parameter == false)	
-						{
-							m_LastOptId = 0;
-							m_LastParameter.clear();
-							return CmdLineParser::RESULT_ERROR;
-						}
-						m_LastParameter = m_LastArg.substr(EqualIndex+1);
-						m_LastOptId = so->Id;
-						return CmdLineParser::RESULT_OPT;
-					}
-				}
-				// To nie jest krtka opcja bo nazwa za duga lub bo nie znaleziono takiej krtkiej - to musi by duga opcja
-				LONG_OPT *lo = FindLongOpt(m_LastArg.substr(1, EqualIndex-1));
-				// Jeli nie ma takiej dugiej opcji - bd
-				// Ta opcja musi oczekiwa parametru skoro jest '=' - jeli nie oczekuje, to bd
-				if (lo == NULL || lo->Parameter == false)
-				{
-					m_LastOptId = 0;
-					m_LastParameter.clear();
-					return CmdLineParser::RESULT_ERROR;
-				}
-				m_LastParameter = m_LastArg.substr(EqualIndex+1);
-				m_LastOptId = lo->Id;
-				return CmdLineParser::RESULT_OPT;
-			}
-			// Nie ma znaku '='
-			else
-			{
-				// To ma by krtka lub duga opcja "/nazwa" lub "/nazwa param"
-				// To moe by krtka opcja
-				if (m_LastArg.length() == 2)
-				{
-					SHORT_OPT *so = FindShortOpt(m_LastArg[1]);
-					// Znaleziono krtk opcj
-					if (so != NULL)
-					{
-						// Jeli ta opcja oczekuje parametru
-						if (so->Parameter)
-						{
-							// Nastpny argument to parameter - wczytaj go prosto tam gdzie trzeba
-							if (!ReadNextArg(&m_LastParameter))
-							{
-								// Nie ma nastpnego argumentu, a oczekiwany jest parametr - bd
-								m_LastOptId = 0;
-								m_LastParameter.clear();
-								return CmdLineParser::RESULT_ERROR;
-							}
-						}
-						// Nie ma parametru
-						else
-							m_LastParameter.clear();
-						// Koniec - sukces
-						m_LastOptId = so->Id;
-						return CmdLineParser::RESULT_OPT;
-					}
-				}
-				// To nie jest krtka opcja bo nazwa za duga lub bo nie znaleziono takiej krtkiej - to musi by duga opcja
-				LONG_OPT *lo = FindLongOpt(m_LastArg.substr(1));
-				// Jeli nie ma takiej dugiej opcji - bd
-				if (lo == NULL)
-				{
-					m_LastOptId = 0;
-					m_LastParameter.clear();
-					return CmdLineParser::RESULT_ERROR;
-				}
-				// Jeli ta opcja oczekuje parametru
-				if (lo->Parameter)
-				{
-					// Nastpny argument to parameter - wczytaj go prosto tam gdzie trzeba
-					if (!ReadNextArg(&m_LastParameter))
-					{
-						// Nie ma nastpnego argumentu, a oczekiwany jest parametr - bd
-						m_LastOptId = 0;
-						m_LastParameter.clear();
-						return CmdLineParser::RESULT_ERROR;
-					}
-				}
-				// Nie ma parametru
-				else
-					m_LastParameter.clear();
-				// Koniec - sukces
-				m_LastOptId = lo->Id;
-				return CmdLineParser::RESULT_OPT;
-			}
-		}
-		// - Zaczyna si od innego znaku lub jest pusty
-		else
-		{
-			// To jest goy parametr bez opcji
-			m_LastOptId = 0;
-			m_LastParameter = m_LastArg;
-			return CmdLineParser::RESULT_PARAMETER;
-		}
-	}
-}
-
-uint CmdLineParser_pimpl::GetOptId()
-{
-	return m_LastOptId;
-}
-
-const tstring & CmdLineParser_pimpl::GetParameter()
-{
-	return m_LastParameter;
-}
-
-CmdLineParser::CmdLineParser(int argc, tchar **argv) :
-	pimpl(new CmdLineParser_pimpl(argc, argv))
-{
-}
-
-CmdLineParser::CmdLineParser(const tchar *CmdLine) :
-	pimpl(new CmdLineParser_pimpl(CmdLine))
-{
-}
-
-CmdLineParser::~CmdLineParser()
-{
-	pimpl.reset();
-}
-
-void CmdLineParser::RegisterOpt(uint Id, tchar Opt, bool Parameter)
-{
-	pimpl->RegisterOpt(Id, Opt, Parameter);
-}
-
-void CmdLineParser::RegisterOpt(uint Id, const tstring &Opt, bool Parameter)
-{
-	pimpl->RegisterOpt(Id, Opt, Parameter);
-}
-
-CmdLineParser::RESULT CmdLineParser::ReadNext()
-{
-	return pimpl->ReadNext();
-}
-
-uint CmdLineParser::GetOptId()
-{
-	return pimpl->GetOptId();
-}
-
-const tstring & CmdLineParser::GetParameter()
-{
-	return pimpl->GetParameter();
-}
-
-const CommonGUID CommonGUID::NIL = CommonGUID(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
-
-int CommonGUID::Cmp(const CommonGUID &v1, const CommonGUID &v2)
-{
-	int v;
-	for (uint i = 16; i--; )
-	{
-		v = (int)v1.Data[i] - (int)v2.Data[i];
-		if (v != 0) return v;
-	}
-	return 0;
-}
-
-CommonGUID::CommonGUID(uint8 v0, uint8 v1, uint8 v2, uint8 v3, uint8 v4, uint8 v5, uint8 v6, uint8 v7, uint8 v8, uint8 v9, uint8 v10, uint8 v11, uint8 v12, uint8 v13, uint8 v14, uint8 v15)
-{
-	Data[ 0] = v0;  Data[ 1] = v1;  Data[ 2] =  v2; Data[ 3] = v3;
-	Data[ 4] = v4;  Data[ 5] = v5;  Data[ 6] =  v6; Data[ 7] = v7;
-	Data[ 8] = v8;  Data[ 9] = v9;  Data[10] = v10; Data[11] = v11;
-	Data[12] = v12; Data[13] = v13; Data[14] = v14; Data[15] = v15;
-}
-
-void CommonGUID::ToString(tchar *out) const
-{
-#ifdef _UNICODE
-	swprintf_s(out, 37, L"%02X%02X%02X%02X-%02X%02X-%02X%02X-%02X%02X-%02X%02X%02X%02X%02X%02X",
-		(int)Data[15], (int)Data[14], (int)Data[13], (int)Data[12],
-		(int)Data[11], (int)Data[10], (int)Data[ 9], (int)Data[ 8],
-		(int)Data[ 7], (int)Data[ 6], (int)Data[ 5], (int)Data[ 4],
-		(int)Data[ 3], (int)Data[ 2], (int)Data[ 1], (int)Data[ 0] );
-#elif defined(_MSC_VER)
-	sprintf_s(out, 37, "%02X%02X%02X%02X-%02X%02X-%02X%02X-%02X%02X-%02X%02X%02X%02X%02X%02X",
-		(int)Data[15], (int)Data[14], (int)Data[13], (int)Data[12],
-		(int)Data[11], (int)Data[10], (int)Data[ 9], (int)Data[ 8],
-		(int)Data[ 7], (int)Data[ 6], (int)Data[ 5], (int)Data[ 4],
-		(int)Data[ 3], (int)Data[ 2], (int)Data[ 1], (int)Data[ 0] );
-#else
-	sprintf(out, "%02X%02X%02X%02X-%02X%02X-%02X%02X-%02X%02X-%02X%02X%02X%02X%02X%02X",
-		(int)Data[15], (int)Data[14], (int)Data[13], (int)Data[12],
-		(int)Data[11], (int)Data[10], (int)Data[ 9], (int)Data[ 8],
-		(int)Data[ 7], (int)Data[ 6], (int)Data[ 5], (int)Data[ 4],
-		(int)Data[ 3], (int)Data[ 2], (int)Data[ 1], (int)Data[ 0] );
-#endif
-}
-
-void CommonGUID::ToString(tstring &out) const
-{
-	tchar buf[37];
-	ToString(buf);
-	out = buf;
-}
-
-void CommonGUID::GenerateVersion4()
-{
-	for (uint i = 0; i < 16; i++)
-		Data[i] = g_Rand.RandByte();
-
-	Data[7] = Data[7] & 0x3F | 0x80;
-	Data[9] = Data[9] & 0x0F | 0x40;
-}
-
-bool CommonGUID::FromString(const tchar *s)
-{
-	uint ints[16];
-#ifdef _UNICODE
-	int R = swscanf_s(s, L"%02X%02X%02X%02X-%02X%02X-%02X%02X-%02X%02X-%02X%02X%02X%02X%02X%02X",
-		&ints[15], &ints[14], &ints[13], &ints[12],
-		&ints[11], &ints[10], &ints[ 9], &ints[ 8],
-		&ints[ 7], &ints[ 6], &ints[ 5], &ints[ 4],
-		&ints[ 3], &ints[ 2], &ints[ 1], &ints[ 0] );
-#elif defined(_MSC_VER)
-	int R = sscanf_s(s, "%02X%02X%02X%02X-%02X%02X-%02X%02X-%02X%02X-%02X%02X%02X%02X%02X%02X",
-		&ints[15], &ints[14], &ints[13], &ints[12],
-		&ints[11], &ints[10], &ints[ 9], &ints[ 8],
-		&ints[ 7], &ints[ 6], &ints[ 5], &ints[ 4],
-		&ints[ 3], &ints[ 2], &ints[ 1], &ints[ 0] );
-#else
-	int R = sscanf(s, "%02X%02X%02X%02X-%02X%02X-%02X%02X-%02X%02X-%02X%02X%02X%02X%02X%02X",
-		&ints[15], &ints[14], &ints[13], &ints[12],
-		&ints[11], &ints[10], &ints[ 9], &ints[ 8],
-		&ints[ 7], &ints[ 6], &ints[ 5], &ints[ 4],
-		&ints[ 3], &ints[ 2], &ints[ 1], &ints[ 0] );
-#endif
-	if (R != 16) return false;
-	for (uint i = 0; i < 16; i++)
-		Data[i] = (uint8)ints[i];
-	return true;
-}
-
-bool CommonGUID::FromString(const tstring &s)
-{
-	return FromString(s.c_str());
-}
-
-Format::Format(const Format &f, const tstring &Element) :
-	pimpl(f.pimpl)
-{
-    tstring& str = pimpl->m_String;
-	size_t index = str.find(pimpl->m_Sep, pimpl->m_Index);
-
-	// nie ma ju gdzie doda - nie zmieniamy
-	if (index == tstring::npos) return;
-
-	str.erase(index, 1);
-	str.insert(index, Element);
-	pimpl->m_Index = index + Element.length();
-}
-
-Format::Format(const Format &f, const tchar *Element) :
-	pimpl(f.pimpl)
-{
-    tstring& str = pimpl->m_String;
-	size_t index = str.find(pimpl->m_Sep, pimpl->m_Index);
-
-	// nie ma ju gdzie doda - nie zmieniamy
-	if (index == tstring::npos) return;
-
-	str.erase(index, 1);
-	str.insert(index, Element);
-#ifdef _UNICODE
-	pimpl->m_Index = index + _tcslen(Element);
-#else
-	pimpl->m_Index = index + strlen(Element);
-#endif
-}
-
-} // namespace common
+/** \file
+\brief Foundation module
+\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
+
+Part of CommonLib library. \n
+Encoding UTF-8, end of line CR+LF \n
+License: GNU LGPL. \n
+Documentation: \ref Module_Base \n
+Module components: \ref code_base
+*/
+#include "Base.hpp"
+#include <cstdio> // dla sprintf, sscanf
+#include <cctype> // dla tolower, isalnum itp.
+#include <ctime> // dla time potrzebnego w RandomGenerator
+#include <memory.h>
+#ifdef _WIN32
+	#include <windows.h>
+	#include <float.h> // dla _finite i _isnan
+    #include <intrin.h> // for _debugbreak
+#else
+	#include <sys/time.h> // dla gettimeofday
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h> // dla konwersji UTF
+	#define COMMON_UTF_SSE2
+#endif
+
+
+namespace common
+{
+
+namespace Internal
+{
+
+#ifdef _WIN32
+
+void DebugBreak()
+{
+    __debugbreak();
+}
+
+#endif // #ifdef _WIN32
+
+} // namespace Internal
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Ogólne
+
+void SwapEndian16_Array(void *p, size_t count)
+{
+	uint16 *u = (uint16*)p;
+	for (size_t i = 0; i < count; i++)
+		SwapEndian16(&u[i]);
+}
+void SwapEndian32_Array(void *p, size_t count)
+{
+	uint32 *u = (uint32*)p;
+	for (size_t i = 0; i < count; i++)
+		SwapEndian32(&u[i]);
+}
+void SwapEndian64_Array(void *p, size_t count)
+{
+	uint64 *u = (uint64*)p;
+	for (size_t i = 0; i < count; i++)
+		SwapEndian64(&u[i]);
+}
+
+void SwapEndian16_Data(void *p, size_t count, ptrdiff_t stepBytes)
+{
+	char *bytes = (char*)p;
+	for (size_t i = 0; i < count; i++, bytes += stepBytes)
+		SwapEndian16(bytes);
+}
+void SwapEndian32_Data(void *p, size_t count, ptrdiff_t stepBytes)
+{
+	char *bytes = (char*)p;
+	for (size_t i = 0; i < count; i++, bytes += stepBytes)
+		SwapEndian32(bytes);
+}
+void SwapEndian64_Data(void *p, size_t count, ptrdiff_t stepBytes)
+{
+	char *bytes = (char*)p;
+	for (size_t i = 0; i < count; i++, bytes += stepBytes)
+		SwapEndian64(bytes);
+}
+
+void Wait(uint32 Miliseconds)
+{
+#ifdef _WIN32
+	Sleep(Miliseconds);
+#else
+	timeval t;
+	t.tv_sec = Miliseconds / 1000;
+	t.tv_usec = (Miliseconds % 1000) * 1000;
+	select(0, 0, 0, 0, &t);
+#endif
+}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Łańcuchy
+
+#ifdef _WIN32
+	const tchar * const EOL = _T("\r\n");
+#else
+	const tchar * const EOL = _T("\n");
+#endif
+
+const tstring EMPTY_STRING = tstring();
+
+// Liczba obslugiwanych stron kodowych
+static const int CHARSET_COUNT = 5;
+// Kody znakow poszczegolnych stron kodowych
+static const string CHARSET_CHARS[CHARSET_COUNT][18] = {
+	{ "\x61", "\x63", "\x65", "\x6C", "\x6E", "\x6F", "\x73", "\x7A", "\x7A",    // brak, male
+	  "\x41", "\x43", "\x45", "\x4C", "\x4E", "\x4F", "\x53", "\x5A", "\x5A", }, // brak, duze
+	{ "\xB9", "\xE6", "\xEA", "\xB3", "\xF1", "\xF3", "\x9C", "\x9F", "\xBF",    // Windows, male
+	  "\xA5", "\xC6", "\xCA", "\xA3", "\xD1", "\xD3", "\x8C", "\x8F", "\xAF", }, // Windows, duze
+	{ "\xB1", "\xE6", "\xEA", "\xB3", "\xF1", "\xF3", "\xB6", "\xBC", "\xBF",    // ISO, male
+	  "\xA1", "\xC6", "\xCA", "\xA3", "\xD1", "\xD3", "\xA6", "\xAC", "\xAF", }, // ISO, duze
+	{ "\xA5", "\x86", "\xA9", "\x88", "\xE4", "\xA2", "\x98", "\xAB", "\xBE",    // IBM, male
+	  "\xA4", "\x8F", "\xA8", "\x9D", "\xE3", "\xE0", "\x97", "\x8D", "\xBD", }, // IBM, duze
+	{ "\xC4\x85", "\xC4\x87", "\xC4\x99", "\xC5\x82", "\xC5\x84", "\xC3\xB3", "\xC5\x9B", "\xC5\xBA", "\xC5\xBC",    // UTF-8, male
+	  "\xC4\x84", "\xC4\x86", "\xC4\x98", "\xC5\x81", "\xC5\x83", "\xC3\x93", "\xC5\x9A", "\xC5\xB9", "\xC5\xBB", }, // UTF-8, duze
+};
+
+bool CharIsAlphaNumeric(tchar ch)
+{
+#ifdef _WIN32
+	return (IsCharAlphaNumeric(ch) != 0);
+#else
+	return (isalnum(static_cast<unsigned char>(ch)) != 0);
+#endif
+}
+
+bool CharIsAlpha(tchar ch)
+{
+#ifdef _WIN32
+	return (IsCharAlpha(ch) != 0);
+#else
+	return (isalpha(static_cast<unsigned char>(ch)) != 0);
+#endif
+}
+
+bool CharIsLower(tchar ch)
+{
+#ifdef _WIN32
+	return (IsCharLower(ch) != 0);
+#else
+	return (islower(static_cast<unsigned char>(ch)) != 0);
+#endif
+}
+
+bool CharIsUpper(tchar ch)
+{
+#ifdef _WIN32
+	return (IsCharUpper(ch) != 0);
+#else
+	return (isupper(static_cast<unsigned char>(ch)) != 0);
+#endif
+}
+
+bool CharIsWhitespace(char ch)
+{
+	return (isspace(static_cast<unsigned char>(ch)) != 0);
+}
+
+#ifdef _WIN32
+bool CharIsWhitespace(wchar_t ch)
+{
+	return (iswspace(ch) != 0);
+	// Z funkcją IsCharSpace z WinAPI są jakieś cyrki - patrz MSDN.
+}
+#endif
+
+size_t StrStrI(const tstring &Str, const tstring &SubStr, size_t Count)
+{
+	const tchar *StrSz    = Str.c_str();
+	const tchar *SubStrSz = SubStr.c_str();
+	const tchar *R = StrStrI(StrSz, SubStrSz, Count);
+	return (R == NULL) ? SIZE_MAX : (R - StrSz);
+}
+
+const tchar * StrStrI(const tchar *Str, const tchar *SubStr, size_t Count)
+{
+	size_t nLen, nOffset, nMaxOffset, nStringLenInt;
+	const tchar *pPos;
+	assert(Str && SubStr);
+#ifdef _WIN32
+	nLen = _tcslen(SubStr);
+#else
+	nLen = strlen(SubStr);
+#endif
+	if (nLen == 0)
+		return Str;
+#ifdef _WIN32
+	size_t nStringToBeSearched = _tcslen(Str);
+#else
+	size_t nStringToBeSearched = strlen(Str);
+#endif
+	if (nLen > nStringToBeSearched)
+		return NULL;
+	if (Count > nStringToBeSearched)
+		nStringLenInt = nStringToBeSearched;
+	else
+		nStringLenInt = Count;
+	nMaxOffset = nStringLenInt - nLen;
+	pPos = Str;
+	for (nOffset = 0; nOffset <= nMaxOffset; nOffset++)
+	{
+		if (StrCmpI(pPos, SubStr, nLen) == 0)
+			return pPos;
+		pPos++;
+	}
+	return NULL;
+}
+
+void ReverseString(tstring *s)
+{
+	size_t i = 0;
+	size_t j = s->length()-1;
+	while (i < j)
+		std::swap( (*s)[i++], (*s)[j--] );
+}
+
+void Trim(tstring *s)
+{
+	if (s->empty()) return;
+	// początek
+	size_t i = 0;
+	while (CharIsWhitespace((*s)[i]))
+		if (++i == s->size())
+		{
+			s->clear();
+			return;
+		}
+	s->erase(0, i);
+	// koniec
+	i = s->size()-1;
+	while (CharIsWhitespace((*s)[i]))
+		i--;
+	s->erase(i+1);
+}
+
+void Trim(tstring *Out, const tstring &s)
+{
+	if (s.empty())
+	{
+		Out->clear();
+		return;
+	}
+	// początek
+	size_t start = 0;
+	while (CharIsWhitespace(s[start]))
+		if (++start == s.size())
+		{
+			Out->clear();
+			return;
+		}
+	// koniec
+	size_t count = s.size()-start;
+	while (CharIsWhitespace(s[start+count-1]))
+		count--;
+	// zwrócenie
+	*Out = s.substr(start, count);
+}
+
+/* UWAGA!
+Funkcje CharUpper() i CharLower() z Win32API powoduja blad ochorony, kiedy
+uruchamia sie je w trybie konwersji pojedynczego znaku, a tym znakiem jest
+polska litera!
+W sumie to chyba daloby sie napisac lepiej, ten blad wynika przeciez z tego,
+że podaje liczbe ze znakiem (char jest signed, polskie litery sa na minusie).
+Gdyby to przekonwertowac... No ale to wymaga dosc zaawansowanego rzutowania,
+wiec niech tak sobie juz zostanie :PPP
+*/
+
+tchar CharToLower(tchar ch)
+{
+#ifdef _WIN32
+	tchar s[2];
+	s[0] = ch;
+	s[1] = '\0';
+	CharLower(s);
+	return s[0];
+#else
+	return static_cast<char>( tolower(static_cast<unsigned char>(ch)) );
+#endif
+}
+
+tchar CharToUpper(tchar ch)
+{
+#ifdef _WIN32
+	tchar s[2];
+	s[0] = ch;
+	s[1] = '\0';
+	CharUpper(s);
+	return s[0];
+#else
+	return static_cast<char>( toupper(static_cast<unsigned char>(ch)) );
+#endif
+}
+
+void LowerCase(tstring *s)
+{
+	for (size_t i = 0; i < s->size(); i++)
+		(*s)[i] = CharToLower((*s)[i]);
+}
+
+void UpperCase(tstring *s)
+{
+	for (size_t i = 0; i < s->size(); i++)
+		(*s)[i] = CharToUpper((*s)[i]);
+}
+
+bool Charset_WindowsSpecialChar(char a_c, string *a_s)
+{
+	switch (a_c)
+	{
+	case '\x84':
+	case '\x94':
+	case '\x93':
+		if (a_s) *a_s = "\""; return true;
+	case '\x85':
+		if (a_s) *a_s = "..."; return true;
+	case '\x96':
+	case '\x97':
+		if (a_s) *a_s = "-"; return true;
+	case '\x92':
+		if (a_s) *a_s = "'"; return true;
+	default:
+		return false;
+	}
+}
+
+char Charset_Convert_Char(char a_c, CHARSET a_Charset1, CHARSET a_Charset2)
+{
+	if (a_Charset1 == a_Charset2) return a_c;
+	for (int i = 0; i < 18; ++i)
+		if (CHARSET_CHARS[a_Charset1][i][0] == a_c)
+			return CHARSET_CHARS[a_Charset2][i][0];
+	return a_c;
+}
+
+// Funkcja wewnętrzna, potrzebna tylko dla Charset_Convert.
+static bool _StrBeginsA(const string &s, const string &sub, size_t Begin)
+{
+	if (Begin+sub.size() > s.size())
+		return false;
+	for (size_t i = 0; i < sub.size(); i++)
+		if (s[Begin+i] != sub[i])
+			return false;
+	return true;
+}
+
+void Charset_Convert(string *out, const string &s, CHARSET Charset1, CHARSET Charset2)
+{
+	if (Charset1 == Charset2) {
+		*out = s;
+		return;
+	}
+
+	size_t i, index = 0; string tmp; bool converted;
+	out->clear();
+	while (index < s.size()) {
+		if (Charset1 == CHARSET_WINDOWS && Charset_WindowsSpecialChar(s[index], &tmp)) {
+			*out += tmp;
+			index++;
+		}
+		else {
+			converted = false;
+			for (i = 0; i < 18; i++) {
+				if (_StrBeginsA(s, CHARSET_CHARS[Charset1][i], index)) {
+					*out += CHARSET_CHARS[Charset2][i];
+					index += CHARSET_CHARS[Charset1][i].size();
+					converted = true;
+					break;
+				}
+			}
+			if (!converted) {
+				*out += s[index];
+				index++;
+			}
+		}
+	}
+}
+
+void EolModeToStr(tstring *Out, EOLMODE EolMode)
+{
+	switch (EolMode)
+	{
+	case EOL_CRLF:
+		*Out = _T("\r\n");
+		return;
+	case EOL_LF:
+		*Out = _T("\n");
+		return;
+	case EOL_CR:
+		*Out = _T("\r");
+		return;
+	default:
+		Out->clear();
+		return;
+	}
+}
+
+void Replace(tstring *result, const tstring &s, const tstring &s1, const tstring &s2)
+{
+	if (s1.empty())
+	{
+		*result = s;
+		return;
+	}
+	result->clear();
+	size_t index1 = 0;
+	size_t index2 = 0;
+	while ( (index2 = s.find(s1, index1)) != tstring::npos )
+	{
+		*result += s.substr(index1, index2-index1);
+		*result += s2;
+		index1 = index2 + s1.size();
+	}
+	*result += s.substr(index1);
+}
+
+void Replace(tstring *Out, const tstring &s, tchar Ch1, tchar Ch2)
+{
+	size_t Length = s.length();
+	Out->resize(Length);
+	tchar Ch;
+	for (size_t i = 0; i < Length; i++)
+	{
+		Ch = s[i];
+		if (Ch == Ch1)
+			(*Out)[i] = Ch2;
+		else
+			(*Out)[i] = Ch;
+	}
+}
+
+void Replace(tstring *InOut, tchar Ch1, tchar Ch2)
+{
+	size_t Length = InOut->length();
+	for (size_t i = 0; i < Length; i++)
+	{
+		if ((*InOut)[i] == Ch1)
+			(*InOut)[i] = Ch2;
+	}
+}
+
+void ReplaceEOL(tstring *result, const tstring &s, EOLMODE EOLMode)
+{
+	if (EOLMode == EOL_NONE)
+	{
+		*result = s;
+		return;
+	}
+
+	result->clear();
+	tstring Tmp;
+	bool ItWasCR = false;
+	for (size_t i = 0; i < s.size(); i++)
+	{
+		if (s[i] == _T('\r'))
+			ItWasCR = true;
+		else if (s[i] == _T('\n'))
+		{
+			EolModeToStr(&Tmp, EOLMode);
+			*result += Tmp;
+			ItWasCR = false;
+		}
+		else
+		{
+			if (ItWasCR)
+			{
+				EolModeToStr(&Tmp, EOLMode);
+				*result += Tmp;
+				ItWasCR = false;
+			}
+			*result += s[i];
+		}
+	}
+	if (ItWasCR)
+	{
+		EolModeToStr(&Tmp, EOLMode);
+		*result += Tmp;
+	}
+}
+
+void NormalizeWhitespace(tstring *result, const tstring &s)
+{
+	bool inside = false;
+	for (size_t i = 0; i < s.size(); i++)
+	{
+		if (CharIsWhitespace(s[i]))
+			inside = true;
+		else
+		{
+			if (inside)
+			{
+				*result += _T(' ');
+				inside = false;
+			}
+			*result += s[i];
+		}
+	}
+	if (inside)
+		*result += ' ';
+}
+
+void DuplicateString(tstring *Out, const tstring &s, size_t count)
+{
+	Out->clear();
+	for (size_t i = 0; i < count; i++)
+		*Out += s;
+}
+
+void RightStr(tstring *Out, const tstring &s, size_t Length)
+{
+	Length = std::min(Length, s.length());
+	*Out = s.substr(s.length() - Length);
+}
+
+size_t SubstringCount(const tstring &str, const tstring &substr)
+{
+	if (substr.empty())
+		return 0;
+	size_t result = 0;
+	size_t index = 0;
+	size_t i;
+	for (;;)
+	{
+		i = str.find(substr, index);
+		if (i == tstring::npos)
+			break;
+		++result;
+		index = i + substr.size();
+	}
+	return result;
+}
+
+int StrCmpI(const tstring &s1, const tstring &s2, size_t Count)
+{
+	return StrCmpI(s1.c_str(), s2.c_str(), Count);
+}
+
+int StrCmpI(const tchar *s1, const tchar *s2, size_t Count)
+{
+#ifdef _WIN32
+	if (Count == SIZE_MAX)
+		return _tcsicmp(s1, s2);
+	else
+		return _tcsnicmp(s1, s2, Count);
+#else
+	if (Count == MAXUINT32)
+		return stricmp(s1, s2);
+	else
+		return strnicmp(s1, s2, Count);
+#endif
+}
+
+int SubStrCmp(const tstring &s1, size_t off1, const tstring &s2, size_t off2, size_t length)
+{
+#ifdef _UNICODE
+	if (length == SIZE_MAX)
+		return wcscmp(s1.c_str()+off1, s2.c_str()+off2);
+	else
+		return wcsncmp(s1.c_str()+off1, s2.c_str()+off2, length);
+#else
+	if (length == MAXUINT32)
+		return strcmp(s1.c_str()+off1, s2.c_str()+off2);
+	else
+		return strncmp(s1.c_str()+off1, s2.c_str()+off2, length);
+#endif
+}
+
+int SubStrCmpI(const tstring &s1, size_t off1, const tstring &s2, size_t off2, size_t length)
+{
+#ifdef _WIN32
+	if (length == SIZE_MAX)
+		return _tcsicmp(s1.c_str()+off1, s2.c_str()+off2);
+	else
+		return _tcsncicmp(s1.c_str()+off1, s2.c_str()+off2, length);
+#else
+	size_t i1 = off1, i2 = off2;
+	bool s1_end, s2_end;
+	char ch1, ch2;
+	for (;;)
+	{
+		if (length == 0) return 0; // Char count limit reached
+		s1_end = i1 >= s1.length();
+		s2_end = i2 >= s2.length();
+		if (s1_end && s2_end) return 0; // Both strings ended
+		if (s1_end) return -1; // Only first string ended - first is before
+		if (s2_end) return  1; // Only second string ended - first is after
+
+		ch1 = s1[i1];
+		ch2 = s2[i2];
+
+		if (ch1 != ch2 && CharToLower(ch1) != CharToLower(ch2))
+			return TCHAR_TO_INT(ch1) - TCHAR_TO_INT(ch2);
+
+		i1++; i2++; length--;
+	}
+#endif
+}
+
+bool ContainsEOL(const tstring &s)
+{
+	for (size_t i = 0; i < s.size(); ++i)
+		if (s[i] == _T('\r') || s[i] == _T('\n'))
+			return true;
+	return false;
+}
+
+bool StrBegins(const tstring &s, const tstring &sub, bool caseSensitive, size_t Begin)
+{
+	if (Begin+sub.size() > s.size())
+		return false;
+	
+	if (caseSensitive)
+	{
+		for (size_t i = 0; i < sub.size(); i++)
+			if (s[Begin+i] != sub[i])
+				return false;
+	}
+	else
+	{
+		for (size_t i = 0; i < sub.size(); i++)
+			if (CharToLower(s[Begin+i]) != CharToLower(sub[i]))
+				return false;
+	}
+
+	return true;
+}
+
+bool StrEnds(const tstring &s, const tstring &Sub, bool caseSensitive)
+{
+	if (Sub.length() > s.length())
+		return false;
+	size_t si = s.length() - Sub.length();
+	size_t subi = 0;
+
+	if (caseSensitive)
+	{
+		for ( ; si < s.length(); si++, subi++)
+		{
+			if (s[si] != Sub[subi])
+				return false;
+		}
+	}
+	else
+	{
+		for ( ; si < s.length(); si++, subi++)
+		{
+			if (CharToLower(s[si]) != CharToLower(Sub[subi]))
+				return false;
+		}
+	}
+
+	return true;
+}
+
+bool Split(const tstring &s, const tstring &delimiter, tstring *out, size_t *index)
+{
+	if (delimiter.empty())
+		return false;
+	if (*index >= s.size())
+		return false;
+
+	size_t pos = s.find(delimiter, *index);
+	if (pos == tstring::npos)
+	{
+		*out = s.substr(*index);
+		*index = s.size();
+		return true;
+	}
+
+	*out = s.substr(*index, pos-*index);
+	*index = pos + delimiter.size();
+	return true;
+}
+
+bool SplitFirstOf(const tstring &s, const tstring &delimiters, tstring *out, size_t *index)
+{
+	if (delimiters.empty())
+		return false;
+	if (*index >= s.size())
+		return false;
+
+	size_t pos = s.find_first_of(delimiters, *index);
+	if (pos == tstring::npos)
+	{
+		*out = s.substr(*index);
+		*index = s.size();
+		return true;
+	}
+
+	*out = s.substr(*index, pos-*index);
+	*index = pos + 1;
+	return true;
+}
+
+void Split(STRING_VECTOR *Out, const tstring &s, const tstring &Delimiter)
+{
+	size_t Index = 0;
+	tstring Tmp;
+	Out->clear();
+	while (Split(s, Delimiter, &Tmp, &Index))
+		Out->push_back(Tmp);
+}
+
+bool SplitEOL(const tstring &s, tstring *out, size_t *index)
+{
+	if (*index >= s.size())
+		return false;
+
+	size_t posr = s.find('\r', *index);
+	size_t posn = s.find('\n', *index);
+	if (posr == tstring::npos && posn == tstring::npos)
+	{
+		*out = s.substr(*index);
+		*index = s.size();
+		return true;
+	}
+
+	if (posn == tstring::npos || posr < posn)
+	{
+		*out = s.substr(*index, posr-*index);
+		if (*index < s.size()-1 && s[posr+1] == _T('\n'))
+			*index = posr + 2;
+		else
+			*index = posr + 1;
+		return true;
+	}
+
+	*out = s.substr(*index, posn-*index);
+	*index = posn + 1;
+	return true;
+}
+
+bool SplitQuery(const tstring &s, tstring *out, size_t *index)
+{
+	if (*index >= s.size())
+		return false;
+
+	size_t i;
+	size_t l = s.size();
+
+	while (CharIsWhitespace(s[*index]))
+		if (++(*index) >= l)
+			return false;
+
+    if (s[*index] == _T('"'))
+	{
+		(*index)++;
+		i = s.find(_T('"'), *index);
+	}
+	else
+	{
+		i = tstring::npos;
+		for (size_t j = *index; j < s.size(); j++)
+			if (CharIsWhitespace(s[j]))
+			{
+				i = j;
+				break;
+			}
+	}
+
+	if (i == tstring::npos)
+	{
+		*out = s.substr(*index);
+		*index = l+1;
+	}
+	else
+	{
+		*out = s.substr(*index, i-*index);
+		*index = i+1;
+	}
+	return true;
+}
+
+bool ValidateWildcard_Asterisk(const tstring &Mask, const tstring &S, size_t *Mask_i, size_t *S_i, bool CaseSensitive)
+{
+	// Warning: uses multiple returns.
+	bool Fit = true;
+
+	// Erase the leading asterisk
+	(*Mask_i)++;
+	while (*S_i < S.length() && (Mask[*Mask_i] == _T('?') || Mask[*Mask_i] == _T('*')))
+	{
+		if (Mask[*Mask_i] == _T('?'))
+			(*S_i)++;
+		(*Mask_i)++;
+	}
+	// Now it could be that test is empty and wildcard contains aterisks. Then we delete them to get a proper state
+	while (Mask[*Mask_i] == _T('*'))
+		(*Mask_i)++;
+	if (*S_i == S.length() && *Mask_i < Mask.length())
+		return !Fit;
+	if (*S_i == S.length() && *Mask_i < Mask.length())
+		return Fit;
+	// Neither test nor wildcard are empty! the first character of wildcard isn't in [*?]
+	if (!ValidateWildcard(Mask, S, CaseSensitive, *Mask_i, *S_i))
+	{
+		do
+		{
+			(*S_i)++;
+			// skip as much characters as possible in the teststring; stop if a character match occurs
+			if (CaseSensitive)
+			{
+				while (*S_i < S.length() && Mask[*Mask_i] != S[*S_i])
+					(*S_i)++;
+			}
+			else
+			{
+				while (*S_i < S.length() && CharToLower(Mask[*Mask_i]) != CharToLower(S[*S_i]))
+					(*S_i)++;
+			}
+		}
+		while ( (*S_i < S.length()) ? !ValidateWildcard(Mask, S, CaseSensitive, *Mask_i, *S_i) : ((Fit = 0) == true) );
+	}
+	if (*S_i == S.length() && *Mask_i == Mask.length())
+		Fit = true;
+	return Fit;
+}
+
+bool ValidateWildcard(const tstring &Mask, const tstring &S, bool CaseSensitive, size_t MaskOff, size_t SOff)
+{
+	// Algoryt na podstawie:
+	// Wildcards Pattern Matching Algorithm, Florian Schintke
+	// http://user.cs.tu-berlin.de/~schintke/references/wildcards/
+
+	bool Fit = true;
+
+	for ( ; MaskOff < Mask.length() && Fit && SOff < S.length(); MaskOff++)
+	{
+		switch (Mask[MaskOff])
+		{
+		case _T('?'):
+			SOff++;
+			break;
+		case _T('*'):
+			Fit = ValidateWildcard_Asterisk(Mask, S, &MaskOff, &SOff, CaseSensitive);
+			MaskOff--;
+			break;
+		default:
+			if (CaseSensitive)
+				Fit = (S[SOff] == Mask[MaskOff]);
+			else
+				Fit = (CharToLower(S[SOff]) == CharToLower(Mask[MaskOff]));
+			SOff++;
+		}
+	}
+
+	while (Mask[MaskOff] == _T('*') && Fit)
+		MaskOff++;
+
+	return (Fit && SOff == S.length() && MaskOff == Mask.length());
+}
+
+// Funkcja do użytku wewnętrznego dla FineSearch
+// Zwraca liczbę zależną od okoliczności, w jakich występuje znaleziony string: 1.0 .. 4.0
+// Mnożona jest przez nią obliczana trafność.
+static float _MnoznikOkolicznosci(const tstring &str, size_t start, size_t length)
+{
+	bool l = (start == 0);
+	bool r = (start+length == str.size());
+	// Całe pole
+	if (l && r)
+		return 4.f;
+	// Początek pola
+	else if (l)
+		return 3.f;
+	else
+	{
+//			if (!l)
+			if (CharIsAlphaNumeric(str[start-1]))
+				l = true;
+		if (!r)
+			if (CharIsAlphaNumeric(str[start+length]))
+				r = true;
+		// Cały ciąg
+		if (l && r)
+			return 2.f;
+		// Nic ciekawego
+		else
+			return 1.f;
+	}
+}
+
+float FineSearch(const tstring &SubStr, const tstring &Str)
+{
+	tstring usubstr; LowerCase(&usubstr, SubStr);
+	tstring ustr; LowerCase(&ustr, Str);
+	float result = 0.f;
+
+	size_t i = 0;
+	size_t p; float x;
+
+	while (true)
+	{
+		p = ustr.find(usubstr, i);
+		// Koniec szukania
+		if (p == tstring::npos)
+			break;
+		x = std::max( usubstr.size()/5.f - Str.size()/100.f + 1.f, 1.f);
+		// Jeśli zgadza się wielkość liter
+		if (SubStrCmp(Str, p, SubStr, 0, SubStr.size()) == 0)
+			x *= 1.5;
+		// Mnożnik okoliczności - jeśli to całe pole, początek pola lub cały ciąg
+		x *= _MnoznikOkolicznosci(Str, p+Str.size()-Str.size(), SubStr.size());
+		// Dodajemy wyliczoną trafność
+		result += x;
+		i = p + SubStr.length();
+	}
+
+	return result;
+}
+
+size_t LevenshteinDistance(const tstring &s1, const tstring &s2)
+{
+	size_t L1 = s1.length();
+	size_t L2 = s2.length();
+	size_t i, j, cost;
+	tchar c1, c2;
+
+	if (L1 == 0) return L2;
+	if (L2 == 0) return L1;
+
+	size_t *D_PrevRow = new size_t[L2+1];
+	size_t *D_CurrRow = new size_t[L2+1];
+
+	for (j = 0; j <= L2; j++)
+		D_PrevRow[j] = j;
+
+	for (i = 1; i <= L1; i++)
+	{
+		D_CurrRow[0] = i;
+		c1 = s1[i-1];
+		for (j = 1; j <= L2; j++)
+		{
+			c2 = s2[j-1];
+			cost = (c1 == c2 ? 0 : 1);
+			D_CurrRow[j] = min3(D_PrevRow[j] + 1, D_CurrRow[j-1] + 1, D_PrevRow[j-1] + cost);
+		}
+		std::swap(D_PrevRow, D_CurrRow);
+	}
+
+	size_t R = D_PrevRow[L2]; // Prev, bo zostało na koniec ostatniego przebiegu pętli zamienione z Curr
+	delete [] D_CurrRow;
+	delete [] D_PrevRow;
+	return R;
+}
+
+size_t LevenshteinDistanceI(const tstring &s1, const tstring &s2)
+{
+	size_t L1 = s1.length();
+	size_t L2 = s2.length();
+	size_t i, j, cost;
+	tchar c1, c2;
+
+	if (L1 == 0) return L2;
+	if (L2 == 0) return L1;
+
+	size_t *D_PrevRow = new size_t[L2+1];
+	size_t *D_CurrRow = new size_t[L2+1];
+
+	for (j = 0; j <= L2; j++)
+		D_PrevRow[j] = j;
+
+	for (i = 1; i <= L1; i++)
+	{
+		D_CurrRow[0] = i;
+		c1 = CharToLower(s1[i-1]);
+		for (j = 1; j <= L2; j++)
+		{
+			c2 = CharToLower(s2[j-1]);
+			cost = (c1 == c2 ? 0 : 1);
+			D_CurrRow[j] = min3(D_PrevRow[j] + 1, D_CurrRow[j-1] + 1, D_PrevRow[j-1] + cost);
+		}
+		std::swap(D_PrevRow, D_CurrRow);
+	}
+
+	size_t R = D_PrevRow[L2]; // Prev, bo zostało na koniec ostatniego przebiegu pętli zamienione z Curr
+	delete [] D_CurrRow;
+	delete [] D_PrevRow;
+	return R;
+}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// C-style strings
+
+const tchar * strnistr(const tchar *str, const tchar *substr, size_t count)
+{
+	size_t nLen, nOffset, nMaxOffset, nStringLenInt;
+	const tchar *pPos;
+	nLen = common_strlen(substr);
+	if (nLen == 0)
+		return str;
+	size_t nStringToBeSearched = common_strlen(str);
+	if (nLen > nStringToBeSearched)
+		return NULL;
+	if (count > nStringToBeSearched)
+		nStringLenInt = nStringToBeSearched;
+	else
+		nStringLenInt = count;
+	nMaxOffset = nStringLenInt - nLen;
+	pPos = str;
+	for ( nOffset = 0; nOffset <= nMaxOffset; nOffset++ )
+	{
+		if ( common_strnicmp(pPos, substr, nLen) == 0 )
+			return pPos;
+		pPos++;
+	}
+	return NULL;
+}
+
+bool StrBegins(const tchar *str, const tchar *substr, bool caseSensitive)
+{
+	size_t strLen = common_strlen(str);
+	size_t substrLen = common_strlen(substr);
+	if (substrLen > strLen) return false;
+
+	if (caseSensitive)
+		return common_strncmp(str, substr, substrLen) == 0;
+	else
+		return common_strnicmp(str, substr, substrLen) == 0;
+}
+
+bool StrEnds(const tchar *str, const tchar *substr, bool caseSensitive)
+{
+	size_t strLen = common_strlen(str);
+	size_t substrLen = common_strlen(substr);
+	if (substrLen > strLen) return false;
+
+	if (caseSensitive)
+		return common_strncmp(str + (strLen - substrLen), substr, substrLen) == 0;
+	else
+		return common_strnicmp(str + (strLen - substrLen), substr, substrLen) == 0;
+}
+
+void StrErase(tchar *str, size_t off, size_t count)
+{
+	if (count == 0) return;
+	size_t strLen = common_strlen(str);
+	if (off >= strLen) return;
+	// obetnij
+	if (count >= strLen - off)
+		str[off] = _T('\0');
+	// przesuń dalsze znaki
+	else
+	{
+		size_t c = strLen - off - count;
+		size_t dstIndex = off;
+		size_t srcIndex = off + count;
+		while (c > 0 && dstIndex < strLen)
+		{
+			str[dstIndex] = str[srcIndex];
+			srcIndex++; dstIndex++; c--;
+		}
+		str[dstIndex] =  _T('\0');
+	}
+}
+
+void StrInsert(tchar *str, size_t strCapacity, const tchar *newStr, size_t off, size_t count)
+{
+	if (count == 0) return;
+	size_t strLen = common_strlen(str);
+	assert(off <= strLen);
+	assert(strLen + count < strCapacity);
+	// Zrób miejsce
+	size_t c = strLen - off;
+	size_t srcIndex = off + c - 1;
+	size_t dstIndex = srcIndex + count;
+	str[dstIndex + 1] =  _T('\0');
+	while (c > 0)
+	{
+		str[dstIndex] = str[srcIndex];
+		srcIndex--; dstIndex--; c--;
+	}
+	// Wpisz nowy łańcuch
+	srcIndex = 0; dstIndex = off;
+	while (count > 0)
+	{
+		str[dstIndex] = newStr[srcIndex];
+		srcIndex++; dstIndex++; count--;
+	}
+}
+
+void StrInsert(tchar *str, size_t strCapacity, const tchar *newStr, size_t off)
+{
+	StrInsert(str, strCapacity, newStr, off, common_strlen(newStr));
+}
+
+void Trim(tchar *s)
+{
+	size_t sLen = common_strlen(s);
+
+	size_t begPos = 0;
+	while (begPos < sLen && CharIsWhitespace(s[begPos]))
+		begPos++;
+	
+	// Cały string to białe znaki
+	if (begPos == sLen)
+	{
+		ClearStr(s);
+		return;
+	}
+
+	size_t endPos = sLen;
+	while (CharIsWhitespace(s[endPos-1]))
+		endPos--;
+
+	// Obetnij koniec, a potem początek
+	StrErase(s, endPos);
+	StrErase(s, 0, begPos);
+}
+
+unsigned StrReplace(tchar *str, tchar from, tchar to)
+{
+	unsigned R = 0;
+	while (*str != _T('\0'))
+	{
+		if (*str == from)
+		{
+			*str = to;
+			R++;
+		}
+		str++;
+	}
+	return R;
+}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Konwersje UTF
+
+namespace Internal
+{
+
+// Dostęp do jednostek kodu. Typ jednostki wynika z formatu.
+template <UTF_FORMAT F> inline uint32 LoadUnit(const uint8 *p);
+template <> inline uint32 LoadUnit<UTF_8    >(const uint8 *p) { return p[0]; }
+template <> inline uint32 LoadUnit<UTF_16_LE>(const uint8 *p) { return (uint32)p[0] | ((uint32)p[1] << 8); }
+template <> inline uint32 LoadUnit<UTF_16_BE>(const uint8 *p) { return (uint32)p[1] | ((uint32)p[0] << 8); }
+template <> inline uint32 LoadUnit<UTF_32_LE>(const uint8 *p) { return (uint32)p[0] | ((uint32)p[1] << 8) | ((uint32)p[2] << 16) | ((uint32)p[3] << 24); }
+template <> inline uint32 LoadUnit<UTF_32_BE>(const uint8 *p) { return (uint32)p[3] | ((uint32)p[2] << 8) | ((uint32)p[1] << 16) | ((uint32)p[0] << 24); }
+
+template <UTF_FORMAT F> inline void StoreUnit(uint8 *p, uint32 u);
+template <> inline void StoreUnit<UTF_8    >(uint8 *p, uint32 u) { p[0] = (uint8)u; }
+template <> inline void StoreUnit<UTF_16_LE>(uint8 *p, uint32 u) { p[0] = (uint8)u; p[1] = (uint8)(u >> 8); }
+template <> inline void StoreUnit<UTF_16_BE>(uint8 *p, uint32 u) { p[1] = (uint8)u; p[0] = (uint8)(u >> 8); }
+template <> inline void StoreUnit<UTF_32_LE>(uint8 *p, uint32 u) { p[0] = (uint8)u; p[1] = (uint8)(u >> 8); p[2] = (uint8)(u >> 16); p[3] = (uint8)(u >> 24); }
+template <> inline void StoreUnit<UTF_32_BE>(uint8 *p, uint32 u) { p[3] = (uint8)u; p[2] = (uint8)(u >> 8); p[1] = (uint8)(u >> 16); p[0] = (uint8)(u >> 24); }
+
+template <UTF_FORMAT F> struct UnitSize { enum { Value = 4 }; };
+template <> struct UnitSize<UTF_8> { enum { Value = 1 }; };
+template <> struct UnitSize<UTF_16_LE> { enum { Value = 2 }; };
+template <> struct UnitSize<UTF_16_BE> { enum { Value = 2 }; };
+
+// Dekoduje jeden punkt kodowy. Zwraca false, jeśli sekwencja pod p jest błędna lub ucięta.
+template <UTF_FORMAT F> inline bool Decode(const uint8 *&p, const uint8 *End, uint32 *OutCp);
+
+template <> inline bool Decode<UTF_8>(const uint8 *&p, const uint8 *End, uint32 *OutCp)
+{
+	uint32 b0 = p[0];
+	if (b0 < 0x80)
+	{
+		*OutCp = b0;
+		p++;
+		return true;
+	}
+	// 0x80..0xBF to bajty kontynuacji, 0xC0 i 0xC1 dałyby zbyt długą sekwencję 2-bajtową
+	if (b0 < 0xC2)
+		return false;
+	if (b0 < 0xE0)
+	{
+		if (End - p < 2 || (p[1] & 0xC0) != 0x80)
+			return false;
+		*OutCp = ((b0 & 0x1F) << 6) | (p[1] & 0x3F);
+		p += 2;
+		return true;
+	}
+	if (b0 < 0xF0)
+	{
+		if (End - p < 3 || (p[1] & 0xC0) != 0x80 || (p[2] & 0xC0) != 0x80)
+			return false;
+		uint32 Cp = ((b0 & 0x0F) << 12) | ((p[1] & 0x3F) << 6) | (p[2] & 0x3F);
+		// Zbyt długa sekwencja lub surogat
+		if (Cp < 0x800 || (Cp >= 0xD800 && Cp <= 0xDFFF))
+			return false;
+		*OutCp = Cp;
+		p += 3;
+		return true;
+	}
+	if (b0 < 0xF5)
+	{
+		if (End - p < 4 || (p[1] & 0xC0) != 0x80 || (p[2] & 0xC0) != 0x80 || (p[3] & 0xC0) != 0x80)
+			return false;
+		uint32 Cp = ((b0 & 0x07) << 18) | ((p[1] & 0x3F) << 12) | ((p[2] & 0x3F) << 6) | (p[3] & 0x3F);
+		if (Cp < 0x10000 || Cp > 0x10FFFF)
+			return false;
+		*OutCp = Cp;
+		p += 4;
+		return true;
+	}
+	return false;
+}
+
+template <UTF_FORMAT F> inline bool Decode16(const uint8 *&p, const uint8 *End, uint32 *OutCp)
+{
+	if (End - p < 2)
+		return false;
+	uint32 u = LoadUnit<F>(p);
+	if (u < 0xD800 || u > 0xDFFF)
+	{
+		*OutCp = u;
+		p += 2;
+		return true;
+	}
+	// Dolny surogat bez górnego
+	if (u > 0xDBFF || End - p < 4)
+		return false;
+	uint32 u2 = LoadUnit<F>(p + 2);
+	if (u2 < 0xDC00 || u2 > 0xDFFF)
+		return false;
+	*OutCp = 0x10000 + ((u - 0xD800) << 10) + (u2 - 0xDC00);
+	p += 4;
+	return true;
+}
+template <> inline bool Decode<UTF_16_LE>(const uint8 *&p, const uint8 *End, uint32 *OutCp) { return Decode16<UTF_16_LE>(p, End, OutCp); }
+template <> inline bool Decode<UTF_16_BE>(const uint8 *&p, const uint8 *End, uint32 *OutCp) { return Decode16<UTF_16_BE>(p, End, OutCp); }
+
+template <UTF_FORMAT F> inline bool Decode32(const uint8 *&p, const uint8 *End, uint32 *OutCp)
+{
+	if (End - p < 4)
+		return false;
+	uint32 u = LoadUnit<F>(p);
+	if (u > 0x10FFFF || (u >= 0xD800 && u <= 0xDFFF))
+		return false;
+	*OutCp = u;
+	p += 4;
+	return true;
+}
+template <> inline bool Decode<UTF_32_LE>(const uint8 *&p, const uint8 *End, uint32 *OutCp) { return Decode32<UTF_32_LE>(p, End, OutCp); }
+template <> inline bool Decode<UTF_32_BE>(const uint8 *&p, const uint8 *End, uint32 *OutCp) { return Decode32<UTF_32_BE>(p, End, OutCp); }
+
+// Koduje poprawny punkt kodowy
+template <UTF_FORMAT F> inline void Encode(uint8 *&o, uint32 Cp);
+
+template <> inline void Encode<UTF_8>(uint8 *&o, uint32 Cp)
+{
+	if (Cp < 0x80)
+		*o++ = (uint8)Cp;
+	else if (Cp < 0x800)
+	{
+		o[0] = (uint8)(0xC0 | (Cp >> 6));
+		o[1] = (uint8)(0x80 | (Cp & 0x3F));
+		o += 2;
+	}
+	else if (Cp < 0x10000)
+	{
+		o[0] = (uint8)(0xE0 | (Cp >> 12));
+		o[1] = (uint8)(0x80 | ((Cp >> 6) & 0x3F));
+		o[2] = (uint8)(0x80 | (Cp & 0x3F));
+		o += 3;
+	}
+	else
+	{
+		o[0] = (uint8)(0xF0 | (Cp >> 18));
+		o[1] = (uint8)(0x80 | ((Cp >> 12) & 0x3F));
+		o[2] = (uint8)(0x80 | ((Cp >> 6) & 0x3F));
+		o[3] = (uint8)(0x80 | (Cp & 0x3F));
+		o += 4;
+	}
+}
+
+template <UTF_FORMAT F> inline void Encode16(uint8 *&o, uint32 Cp)
+{
+	if (Cp < 0x10000)
+	{
+		StoreUnit<F>(o, Cp);
+		o += 2;
+	}
+	else
+	{
+		Cp -= 0x10000;
+		StoreUnit<F>(o, 0xD800 + (Cp >> 10));
+		StoreUnit<F>(o + 2, 0xDC00 + (Cp & 0x3FF));
+		o += 4;
+	}
+}
+template <> inline void Encode<UTF_16_LE>(uint8 *&o, uint32 Cp) { Encode16<UTF_16_LE>(o, Cp); }
+template <> inline void Encode<UTF_16_BE>(uint8 *&o, uint32 Cp) { Encode16<UTF_16_BE>(o, Cp); }
+template <> inline void Encode<UTF_32_LE>(uint8 *&o, uint32 Cp) { StoreUnit<UTF_32_LE>(o, Cp); o += 4; }
+template <> inline void Encode<UTF_32_BE>(uint8 *&o, uint32 Cp) { StoreUnit<UTF_32_BE>(o, Cp); o += 4; }
+
+// Kopiuje początkowy ciąg znaków ASCII, które nie wymagają dekodowania.
+template <UTF_FORMAT In, UTF_FORMAT Out> struct ScalarAsciiRun
+{
+	static void Copy(const uint8 *&p, const uint8 *End, uint8 *&o)
+	{
+		while (End - p >= UnitSize<In>::Value)
+		{
+			uint32 u = LoadUnit<In>(p);
+			if (u >= 0x80)
+				break;
+			StoreUnit<Out>(o, u);
+			p += UnitSize<In>::Value;
+			o += UnitSize<Out>::Value;
+		}
+	}
+};
+
+// Poniżej specjalizacje dla najczęstszych par formatów
+template <UTF_FORMAT In, UTF_FORMAT Out> struct AsciiRun : public ScalarAsciiRun<In, Out> { };
+
+#ifdef COMMON_UTF_SSE2
+
+	inline __m128i ByteSwap16(__m128i v) { return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)); }
+
+	// UTF-8 -> UTF-8: po 16 bajtów naraz
+	template <> struct AsciiRun<UTF_8, UTF_8>
+	{
+		static void Copy(const uint8 *&p, const uint8 *End, uint8 *&o)
+		{
+			while (End - p >= 16)
+			{
+				__m128i v = _mm_loadu_si128((const __m128i*)p);
+				if (_mm_movemask_epi8(v) != 0)
+					break;
+				_mm_storeu_si128((__m128i*)o, v);
+				p += 16;
+				o += 16;
+			}
+			ScalarAsciiRun<UTF_8, UTF_8>::Copy(p, End, o);
+		}
+	};
+
+	// UTF-8 -> UTF-16: 16 bajtów rozszerzanych zerami
+	template <UTF_FORMAT Out> struct AsciiRun8To16
+	{
+		static void Copy(const uint8 *&p, const uint8 *End, uint8 *&o)
+		{
+			const __m128i Zero = _mm_setzero_si128();
+			while (End - p >= 16)
+			{
+				__m128i v = _mm_loadu_si128((const __m128i*)p);
+				if (_mm_movemask_epi8(v) != 0)
+					break;
+				if (Out == UTF_16_BE)
+				{
+					_mm_storeu_si128((__m128i*)o,        _mm_unpacklo_epi8(Zero, v));
+					_mm_storeu_si128((__m128i*)(o + 16), _mm_unpackhi_epi8(Zero, v));
+				}
+				else
+				{
+					_mm_storeu_si128((__m128i*)o,        _mm_unpacklo_epi8(v, Zero));
+					_mm_storeu_si128((__m128i*)(o + 16), _mm_unpackhi_epi8(v, Zero));
+				}
+				p += 16;
+				o += 32;
+			}
+			ScalarAsciiRun<UTF_8, Out>::Copy(p, End, o);
+		}
+	};
+	template <> struct AsciiRun<UTF_8, UTF_16_LE> : public AsciiRun8To16<UTF_16_LE> { };
+	template <> struct AsciiRun<UTF_8, UTF_16_BE> : public AsciiRun8To16<UTF_16_BE> { };
+
+	// UTF-8 -> UTF-32 LE: 16 bajtów rozszerzanych dwukrotnie
+	template <> struct AsciiRun<UTF_8, UTF_32_LE>
+	{
+		static void Copy(const uint8 *&p, const uint8 *End, uint8 *&o)
+		{
+			const __m128i Zero = _mm_setzero_si128();
+			while (End - p >= 16)
+			{
+				__m128i v = _mm_loadu_si128((const __m128i*)p);
+				if (_mm_movemask_epi8(v) != 0)
+					break;
+				__m128i Lo = _mm_unpacklo_epi8(v, Zero);
+				__m128i Hi = _mm_unpackhi_epi8(v, Zero);
+				_mm_storeu_si128((__m128i*)o,        _mm_unpacklo_epi16(Lo, Zero));
+				_mm_storeu_si128((__m128i*)(o + 16), _mm_unpackhi_epi16(Lo, Zero));
+				_mm_storeu_si128((__m128i*)(o + 32), _mm_unpacklo_epi16(Hi, Zero));
+				_mm_storeu_si128((__m128i*)(o + 48), _mm_unpackhi_epi16(Hi, Zero));
+				p += 16;
+				o += 64;
+			}
+			ScalarAsciiRun<UTF_8, UTF_32_LE>::Copy(p, End, o);
+		}
+	};
+
+	// UTF-16 -> UTF-8: 8 jednostek sprawdzanych na < 0x80 i pakowanych do bajtów
+	template <UTF_FORMAT In> struct AsciiRun16To8
+	{
+		static void Copy(const uint8 *&p, const uint8 *End, uint8 *&o)
+		{
+			const __m128i Mask = _mm_set1_epi16((short)0xFF80);
+			const __m128i Zero = _mm_setzero_si128();
+			while (End - p >= 16)
+			{
+				__m128i v = _mm_loadu_si128((const __m128i*)p);
+				if (In == UTF_16_BE)
+					v = ByteSwap16(v);
+				if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(v, Mask), Zero)) != 0xFFFF)
+					break;
+				_mm_storel_epi64((__m128i*)o, _mm_packus_epi16(v, v));
+				p += 16;
+				o += 8;
+			}
+			ScalarAsciiRun<In, UTF_8>::Copy(p, End, o);
+		}
+	};
+	template <> struct AsciiRun<UTF_16_LE, UTF_8> : public AsciiRun16To8<UTF_16_LE> { };
+	template <> struct AsciiRun<UTF_16_BE, UTF_8> : public AsciiRun16To8<UTF_16_BE> { };
+
+	// UTF-16 -> UTF-16: kopiowane są wszystkie jednostki spoza zakresu surogatów, w razie potrzeby z zamianą bajtów
+	template <UTF_FORMAT In, UTF_FORMAT Out> struct AsciiRun16To16
+	{
+		static void Copy(const uint8 *&p, const uint8 *End, uint8 *&o)
+		{
+			const __m128i Mask = _mm_set1_epi16((short)0xF800);
+			const __m128i Surrogate = _mm_set1_epi16((short)0xD800);
+			while (End - p >= 16)
+			{
+				__m128i v = _mm_loadu_si128((const __m128i*)p);
+				__m128i Swapped = ByteSwap16(v);
+				if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(In == UTF_16_BE ? Swapped : v, Mask), Surrogate)) != 0)
+					break;
+				_mm_storeu_si128((__m128i*)o, In != Out ? Swapped : v);
+				p += 16;
+				o += 16;
+			}
+			ScalarAsciiRun<In, Out>::Copy(p, End, o);
+		}
+	};
+	template <> struct AsciiRun<UTF_16_LE, UTF_16_LE> : public AsciiRun16To16<UTF_16_LE, UTF_16_LE> { };
+	template <> struct AsciiRun<UTF_16_LE, UTF_16_BE> : public AsciiRun16To16<UTF_16_LE, UTF_16_BE> { };
+	template <> struct AsciiRun<UTF_16_BE, UTF_16_LE> : public AsciiRun16To16<UTF_16_BE, UTF_16_LE> { };
+	template <> struct AsciiRun<UTF_16_BE, UTF_16_BE> : public AsciiRun16To16<UTF_16_BE, UTF_16_BE> { };
+
+	// UTF-32 LE -> UTF-8: 16 jednostek sprawdzanych i dwukrotnie pakowanych
+	template <> struct AsciiRun<UTF_32_LE, UTF_8>
+	{
+		static void Copy(const uint8 *&p, const uint8 *End, uint8 *&o)
+		{
+			const __m128i Mask = _mm_set1_epi32((int)0xFFFFFF80);
+			const __m128i Zero = _mm_setzero_si128();
+			while (End - p >= 64)
+			{
+				__m128i v0 = _mm_loadu_si128((const __m128i*)p);
+				__m128i v1 = _mm_loadu_si128((const __m128i*)(p + 16));
+				__m128i v2 = _mm_loadu_si128((const __m128i*)(p + 32));
+				__m128i v3 = _mm_loadu_si128((const __m128i*)(p + 48));
+				__m128i Any = _mm_or_si128(_mm_or_si128(v0, v1), _mm_or_si128(v2, v3));
+				if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(Any, Mask), Zero)) != 0xFFFF)
+					break;
+				__m128i w0 = _mm_packs_epi32(v0, v1);
+				__m128i w1 = _mm_packs_epi32(v2, v3);
+				_mm_storeu_si128((__m128i*)o, _mm_packus_epi16(w0, w1));
+				p += 64;
+				o += 16;
+			}
+			ScalarAsciiRun<UTF_32_LE, UTF_8>::Copy(p, End, o);
+		}
+	};
+
+#else
+
+	// UTF-8 -> UTF-8: po 8 bajtów naraz
+	template <> struct AsciiRun<UTF_8, UTF_8>
+	{
+		static void Copy(const uint8 *&p, const uint8 *End, uint8 *&o)
+		{
+			while (End - p >= 8)
+			{
+				uint64 v;
+				memcpy(&v, p, 8);
+				if ((v & 0x8080808080808080ull) != 0)
+					break;
+				memcpy(o, &v, 8);
+				p += 8;
+				o += 8;
+			}
+			ScalarAsciiRun<UTF_8, UTF_8>::Copy(p, End, o);
+		}
+	};
+
+#endif
+
+template <UTF_FORMAT In, UTF_FORMAT Out>
+bool Convert(uint8 *OutBuf, size_t *OutBytes, const uint8 *In_, size_t InBytes, size_t *OutErrorOffset)
+{
+	const uint8 *p = In_, *End = In_ + InBytes;
+	uint8 *o = OutBuf;
+	for (;;)
+	{
+		AsciiRun<In, Out>::Copy(p, End, o);
+		if (p == End)
+			break;
+		uint32 Cp;
+		const uint8 *SeqBeg = p;
+		if (!Decode<In>(p, End, &Cp))
+		{
+			if (OutErrorOffset != NULL)
+				*OutErrorOffset = (size_t)(SeqBeg - In_);
+			*OutBytes = 0;
+			return false;
+		}
+		Encode<Out>(o, Cp);
+	}
+	*OutBytes = (size_t)(o - OutBuf);
+	return true;
+}
+
+template <UTF_FORMAT In>
+bool ConvertFrom(uint8 *OutBuf, size_t *OutBytes, UTF_FORMAT OutFormat, const uint8 *In_, size_t InBytes, size_t *OutErrorOffset)
+{
+	switch (OutFormat)
+	{
+	case UTF_8:     return Convert<In, UTF_8    >(OutBuf, OutBytes, In_, InBytes, OutErrorOffset);
+	case UTF_16_LE: return Convert<In, UTF_16_LE>(OutBuf, OutBytes, In_, InBytes, OutErrorOffset);
+	case UTF_16_BE: return Convert<In, UTF_16_BE>(OutBuf, OutBytes, In_, InBytes, OutErrorOffset);
+	case UTF_32_LE: return Convert<In, UTF_32_LE>(OutBuf, OutBytes, In_, InBytes, OutErrorOffset);
+	default:        return Convert<In, UTF_32_BE>(OutBuf, OutBytes, In_, InBytes, OutErrorOffset);
+	}
+}
+
+} // namespace Internal
+
+size_t ConvertUtf_MaxLength(UTF_FORMAT OutFormat, size_t InBytes, UTF_FORMAT InFormat)
+{
+	size_t InUnits = InBytes / GetUtfUnitSize(InFormat);
+	size_t OutUnitSize = GetUtfUnitSize(OutFormat);
+	// Najgorszy przypadek liczby jednostek wyjściowych na jednostkę wejściową: 1 bajt UTF-8 daje co najwyżej 1 jednostkę dowolnego formatu,
+	// jednostka UTF-16 daje do 3 bajtów UTF-8, jednostka UTF-32 do 4 bajtów UTF-8 lub 2 jednostek UTF-16.
+	size_t Factor = 1;
+	if (OutFormat == UTF_8 && InFormat != UTF_8)
+		Factor = (InFormat <= UTF_16_BE ? 3 : 4);
+	else if (OutUnitSize == 2 && InFormat >= UTF_32_LE)
+		Factor = 2;
+	return InUnits * Factor * OutUnitSize;
+}
+
+bool ConvertUtf(void *OutBuf, size_t *OutBytes, UTF_FORMAT OutFormat, const void *In, size_t InBytes, UTF_FORMAT InFormat, size_t *OutErrorOffset)
+{
+	const uint8 *InPtr = (const uint8*)In;
+	uint8 *OutPtr = (uint8*)OutBuf;
+	switch (InFormat)
+	{
+	case UTF_8:     return Internal::ConvertFrom<UTF_8    >(OutPtr, OutBytes, OutFormat, InPtr, InBytes, OutErrorOffset);
+	case UTF_16_LE: return Internal::ConvertFrom<UTF_16_LE>(OutPtr, OutBytes, OutFormat, InPtr, InBytes, OutErrorOffset);
+	case UTF_16_BE: return Internal::ConvertFrom<UTF_16_BE>(OutPtr, OutBytes, OutFormat, InPtr, InBytes, OutErrorOffset);
+	case UTF_32_LE: return Internal::ConvertFrom<UTF_32_LE>(OutPtr, OutBytes, OutFormat, InPtr, InBytes, OutErrorOffset);
+	default:        return Internal::ConvertFrom<UTF_32_BE>(OutPtr, OutBytes, OutFormat, InPtr, InBytes, OutErrorOffset);
+	}
+}
+
+bool ConvertUtf(string *Out, UTF_FORMAT OutFormat, const void *In, size_t InBytes, UTF_FORMAT InFormat, size_t *OutErrorOffset)
+{
+	size_t MaxLength = ConvertUtf_MaxLength(OutFormat, InBytes, InFormat);
+	if (MaxLength == 0)
+	{
+		Out->clear();
+		// Wciąż może być błędne, np. 1 bajt UTF-16
+		size_t Dummy;
+		return ConvertUtf(NULL, &Dummy, OutFormat, In, InBytes, InFormat, OutErrorOffset);
+	}
+	Out->resize(MaxLength);
+	size_t Length;
+	if (!ConvertUtf(&(*Out)[0], &Length, OutFormat, In, InBytes, InFormat, OutErrorOffset))
+	{
+		Out->clear();
+		return false;
+	}
+	Out->resize(Length);
+	return true;
+}
+
+bool Utf8ToWstring(wstring *Out, const char *S, size_t NumBytes, size_t *OutErrorOffset)
+{
+	UTF_FORMAT WcharFormat = GetWcharUtfFormat();
+	size_t MaxLength = ConvertUtf_MaxLength(WcharFormat, NumBytes, UTF_8);
+	if (MaxLength == 0)
+	{
+		Out->clear();
+		return true;
+	}
+	Out->resize(MaxLength / sizeof(wchar_t));
+	size_t Length;
+	if (!ConvertUtf(&(*Out)[0], &Length, WcharFormat, S, NumBytes, UTF_8, OutErrorOffset))
+	{
+		Out->clear();
+		return false;
+	}
+	Out->resize(Length / sizeof(wchar_t));
+	return true;
+}
+
+bool WstringToUtf8(string *Out, const wchar_t *S, size_t NumChars, size_t *OutErrorOffset)
+{
+	if (!ConvertUtf(Out, UTF_8, S, NumChars * sizeof(wchar_t), GetWcharUtfFormat(), OutErrorOffset))
+	{
+		if (OutErrorOffset != NULL)
+			*OutErrorOffset /= sizeof(wchar_t);
+		return false;
+	}
+	return true;
+}
+
+size_t DetectUtfBom(UTF_FORMAT *OutFormat, const void *Data, size_t NumBytes)
+{
+	const uint8 *p = (const uint8*)Data;
+	if (NumBytes >= 4 && p[0] == 0xFF && p[1] == 0xFE && p[2] == 0x00 && p[3] == 0x00)
+	{
+		*OutFormat = UTF_32_LE;
+		return 4;
+	}
+	if (NumBytes >= 4 && p[0] == 0x00 && p[1] == 0x00 && p[2] == 0xFE && p[3] == 0xFF)
+	{
+		*OutFormat = UTF_32_BE;
+		return 4;
+	}
+	if (NumBytes >= 3 && p[0] == 0xEF && p[1] == 0xBB && p[2] == 0xBF)
+	{
+		*OutFormat = UTF_8;
+		return 3;
+	}
+	if (NumBytes >= 2 && p[0] == 0xFF && p[1] == 0xFE)
+	{
+		*OutFormat = UTF_16_LE;
+		return 2;
+	}
+	if (NumBytes >= 2 && p[0] == 0xFE && p[1] == 0xFF)
+	{
+		*OutFormat = UTF_16_BE;
+		return 2;
+	}
+	return 0;
+}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Obsługa Unicode (tylko Windows)
+#ifdef _WIN32
+
+bool ConvertUnicodeToChars(string *Out, const wstring &S, unsigned CodePage)
+{
+	// UTF-8 własną, szybszą i ściśle sprawdzającą konwersją
+	if (CodePage == CP_UTF8)
+		return WstringToUtf8(Out, S.data(), S.length());
+
+	if (S.empty())
+	{
+		Out->clear(); return true;
+	}
+
+	// Phase 1 - Get buffer size.
+	int Size = WideCharToMultiByte(CodePage, 0, S.data(), (int)S.length(), NULL, 0, NULL, NULL);
+	if (Size == 0)
+	{
+		Out->clear(); return false;
+	}
+
+	// Phase 2 - Do conversion.
+	scoped_ptr<char, DeleteArrayPolicy> Buf(new char[(size_t)Size]);
+	int R = WideCharToMultiByte(CodePage, 0, S.data(), (int)S.length(), Buf.get(), Size, NULL, NULL);
+	if (R == 0)
+	{
+		Out->clear(); return false;
+	}
+	
+	Out->assign(Buf.get(), (size_t)Size);
+	return true;
+}
+
+bool ConvertUnicodeToChars(string *Out, const wchar_t *S, size_t NumChars, unsigned CodePage)
+{
+	// UTF-8 własną, szybszą i ściśle sprawdzającą konwersją
+	if (CodePage == CP_UTF8)
+		return WstringToUtf8(Out, S, NumChars);
+
+	if (NumChars == 0)
+	{
+		Out->clear(); return true;
+	}
+
+    assert(NumChars <= (size_t)INT_MAX);
+
+	// Phase 1 - Get buffer size.
+	int Size = WideCharToMultiByte(CodePage, 0, S, (int)NumChars, NULL, 0, NULL, NULL);
+	if (Size == 0)
+	{
+		Out->clear(); return false;
+	}
+
+	// Phase 2 - Do conversion.
+	scoped_ptr<char, DeleteArrayPolicy> Buf(new char[(size_t)Size]);
+	int R = WideCharToMultiByte(CodePage, 0, S, (int)NumChars, Buf.get(), Size, NULL, NULL);
+	if (R == 0)
+	{
+		Out->clear(); return false;
+	}
+	
+	Out->assign(Buf.get(), (size_t)Size);
+	return true;
+}
+
+bool ConvertCharsToUnicode(wstring *Out, const string &S, unsigned CodePage)
+{
+	// UTF-8 własną, szybszą i ściśle sprawdzającą konwersją
+	if (CodePage == CP_UTF8)
+		return Utf8ToWstring(Out, S.data(), S.length());
+
+	if (S.empty())
+	{
+		Out->clear(); return true;
+	}
+
+	// Phase 1 - Get buffer size.
+	int Size = MultiByteToWideChar(CodePage, 0, S.data(), (int)S.length(), NULL, 0);
+	if (Size == 0)
+	{
+		Out->clear(); return false;
+	}
+
+	// Phase 2 - Do conversion.
+	scoped_ptr<wchar_t, DeleteArrayPolicy> Buf(new wchar_t[(size_t)Size]);
+	int R = MultiByteToWideChar(CodePage, 0, S.data(), (int)S.length(), Buf.get(), Size);
+	if (R == 0)
+	{
+		Out->clear(); return false;
+	}
+
+	Out->assign(Buf.get(), (size_t)Size);
+	return true;
+}
+
+bool ConvertCharsToUnicode(wstring *Out, const char *S, size_t NumChars, unsigned CodePage)
+{
+	// UTF-8 własną, szybszą i ściśle sprawdzającą konwersją
+	if (CodePage == CP_UTF8)
+		return Utf8ToWstring(Out, S, NumChars);
+
+	if (NumChars == 0)
+	{
+		Out->clear(); return true;
+	}
+
+    assert(NumChars <= (size_t)INT_MAX);
+
+	// Phase 1 - Get buffer size.
+	int Size = MultiByteToWideChar(CodePage, 0, S, (int)NumChars, NULL, 0);
+	if (Size == 0)
+	{
+		Out->clear(); return false;
+	}
+
+	// Phase 2 - Do conversion.
+	scoped_ptr<wchar_t, DeleteArrayPolicy> Buf(new wchar_t[(size_t)Size]);
+	int R = MultiByteToWideChar(CodePage, 0, S, (int)NumChars, Buf.get(), Size);
+	if (R == 0)
+	{
+		Out->clear(); return false;
+	}
+
+	Out->assign(Buf.get(), (size_t)Size);
+	return true;
+}
+
+bool UnicodeToChars_CalcBufLen(size_t &outLen, const wchar_t *wcs, unsigned CodePage)
+{
+	return UnicodeToChars_CalcBufLen(outLen, wcs, wcslen(wcs), CodePage);
+}
+
+bool UnicodeToChars_CalcBufLen(size_t &outLen, const wchar_t *wcs, size_t wcsLen, unsigned CodePage)
+{
+	if (wcsLen == 0 || wcs == NULL)
+	{
+		outLen = 0;
+		return true;
+	}
+
+	int len = WideCharToMultiByte(CodePage, 0, wcs, (int)wcsLen, NULL, 0, NULL, NULL);
+	outLen = (size_t)len;
+	return len > 0;
+}
+
+bool CharsToUnicode_CalcBufLen(size_t &outLen, const char *str, unsigned CodePage)
+{
+	return CharsToUnicode_CalcBufLen(outLen, str, strlen(str), CodePage);
+}
+
+bool CharsToUnicode_CalcBufLen(size_t &outLen, const char *str, size_t strLen, unsigned CodePage)
+{
+	if (strLen == 0 || str == NULL)
+	{
+		outLen = 0;
+		return false;
+	}
+	int len = MultiByteToWideChar(CodePage, 0, str, (int)strLen, NULL, 0);
+	outLen = (size_t)len;
+	return len > 0;
+}
+
+bool ConvertUnicodeToChars(char *outBuf, size_t bufLen, const wchar_t *wcs, unsigned CodePage)
+{
+	return ConvertUnicodeToChars(outBuf, bufLen, wcs, wcslen(wcs), CodePage);
+}
+
+bool ConvertUnicodeToChars(char *outBuf, size_t bufLen, const wchar_t *wcs, size_t wcsLen, unsigned CodePage)
+{
+	assert(outBuf != NULL && bufLen > 0);
+
+	if (wcsLen == 0 || StrIsEmpty(wcs))
+	{
+		ClearStr(outBuf);
+		return true;
+	}
+
+	int R = WideCharToMultiByte(CodePage, 0, wcs, (int)wcsLen, outBuf, (int)bufLen, NULL, NULL);
+	return R > 0;
+}
+
+bool ConvertCharsToUnicode(wchar_t *outBuf, size_t bufLen, const char *str, unsigned CodePage)
+{
+	return ConvertCharsToUnicode(outBuf, bufLen, str, strlen(str), CodePage);
+}
+
+bool ConvertCharsToUnicode(wchar_t *outBuf, size_t bufLen, const char *str, size_t strLen, unsigned CodePage)
+{
+	assert(outBuf != NULL && bufLen > 0);
+	
+	if (strLen == 0 || StrIsEmpty(str))
+	{
+		ClearStr(outBuf);
+		return true;
+	}
+
+	int R = MultiByteToWideChar(CodePage, 0, str, (int)strLen, outBuf, (int)bufLen);
+	return R > 0;
+}
+
+
+const char * const BOM_UTF8     = "\xEF\xBB\xBF";
+const char * const BOM_UTF16_LE = "\xFF\xFE";
+const char * const BOM_UTF16_BE = "\xFE\xFF";
+
+#endif
+
+#ifdef _UNICODE
+	bool TstringToString(string *Out, const tstring &S) { return ConvertUnicodeToChars(Out, S, CP_ACP); }
+	bool StringToTstring(tstring *Out, const string &S) { return ConvertCharsToUnicode(Out, S, CP_ACP); }
+#else
+	#ifdef _WIN32
+		bool TstringToWstring(wstring *Out, const tstring &S) { return ConvertCharsToUnicode(Out, S, CP_ACP); }
+		bool WstringToTstring(tstring *Out, const wstring &S) { return ConvertUnicodeToChars(Out, S, CP_ACP); }
+	#endif
+#endif
+
+/*
+Sortowanie naturalne
+Napisane od początku, ale na podstawie kodu:
+  strnatcmp.c -- Perform 'natural order' comparisons of strings in C.
+  Copyright (C) 2000, 2004 by Martin Pool <mbp sourcefrog net>
+  http://sourcefrog.net/projects/natsort/
+Mój algorytm działa jednak trochę inaczej i daje inne wyniki (przydałoby się
+kiedyś go poprawić).
+*/
+
+int StringNaturalCompare::CompareNumbers(const tstring &s1, size_t i1, const tstring &s2, size_t i2)
+{
+	// pomiń początkowe zera
+	while (i1 < s1.length() && s1[i1] == _T('0'))
+		i1++;
+	while (i2 < s2.length() && s2[i2] == _T('0'))
+		i2++;
+
+	// The longest run of digits wins.  That aside, the greatest
+	// value wins, but we can't know that it will until we've scanned
+	// both numbers to know that they have the same magnitude, so we
+	// remember it in BIAS.
+	int bias = 0;
+
+	for ( ; ; i1++, i2++)
+	{
+		// koniec lancucha
+		if (i1 == s1.length() || !CharIsDigit(s1[i1]))
+		{
+			if (i2 == s2.length() || !CharIsDigit(s2[i2]))
+				return bias;
+			else
+				return -1;
+		}
+		else if (i2 == s2.length() || !CharIsDigit(s2[i2]))
+			return +1;
+
+		// porównanie znaków
+		if (s1[i1] < s2[i2])
+		{
+			if (bias == 0)
+				bias = -1;
+		}
+		else if (s1[i1] > s2[i2])
+		{
+			if (bias == 0)
+				bias = +1;
+		}
+	}
+	return 0;
+}
+
+int StringNaturalCompare::Compare(const tstring &s1, const tstring &s2)
+{
+	size_t i1 = 0, i2 = 0;
+	tchar c1, c2;
+	int result;
+
+	for (;;)
+	{
+		// koniec łańcucha
+		if (i1 == s1.length())
+		{
+			if (i2 == s2.length())
+				return 0;
+			else
+				return -1;
+		}
+		else if (i2 == s2.length())
+			return +1;
+
+		// pobierz znaki
+		c1 = s1[i1];
+		c2 = s2[i2];
+
+		// pomiń białe znaki
+		if (CharIsWhitespace(c1))
+		{
+			i1++;
+			continue;
+		}
+		if (CharIsWhitespace(c2))
+		{
+			i2++;
+			continue;
+		}
+
+		// obydwa to cyfry - porównujemy liczby
+		if (CharIsDigit(c1) && CharIsDigit(c2))
+		{
+			if ((result = CompareNumbers(s1, i1, s2, i2)) != 0)
+				return result;
+		}
+
+		// nieuwzględnianie wielkości liter
+		if (m_CaseInsensitive)
+		{
+			c1 = CharToLower(c1);
+			c2 = CharToLower(c2);
+		}
+
+		// porównanie znaków
+		if (c1 < c2)
+			return -1;
+		if (c1 > c2)
+			return +1;
+
+		// następne znaki
+		i1++;
+		i2++;
+	}
+}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Ścieżki do plików
+
+// [Wewnętrzna]
+// Zwraca true, jeśli znak jest jakimś separatorem katalogów
+inline bool IsPathSlash(tchar Ch)
+{
+	return (Ch == _T('\\')) || (Ch == _T('/'));
+}
+
+// [Wewnętrzna]
+// Porównuje dwie nazwy plików lub katalogów
+// Z rozróżnianiem lub bez rozróżniania wielkości znaków, zależnie od systemu
+bool PathCmp(const tstring &s1, const tstring &s2)
+{
+#ifdef _WIN32
+	return StrCmpI(s1, s2) == 0;
+#else
+	return (s1 == s2);
+#endif
+}
+
+// [Wewnętrzna]
+// Rozkłada ścieżkę na części
+void DecomposePath(const tstring &s, tstring *OutPrefix, tstring *OutPath, tstring *OutTrailingPathDelimiter)
+{
+	OutPrefix->clear();
+	OutPath->clear();
+	OutTrailingPathDelimiter->clear();
+	size_t Beg = 0, End = s.length();
+
+	// Prefix
+	if (!s.empty())
+	{
+		// Zaczyna się od <slash>
+		if (IsPathSlash(s[0]))
+		{
+			// <slash> <slash> <serwer> <slash> <udział> <slash>
+			if (s.length() > 1 && IsPathSlash(s[1]))
+			{
+				size_t i = s.find_first_of(_T("/\\"), 2);
+				if (i == tstring::npos) { *OutPrefix = s; return; }
+				i = s.find_first_of(_T("/\\"), i+1);
+				if (i == tstring::npos) { *OutPrefix = s; return; }
+				*OutPrefix = s.substr(0, i+1);
+				Beg = i+1;
+			}
+			// Nie - po prostu <slash>
+			else
+			{
+				CharToStr(OutPrefix, s[0]);
+				Beg = 1;
+			}
+		}
+		// <dysk> : <slash>
+		else
+		{
+			size_t i = s.find(':');
+			if (i != tstring::npos)
+			{
+				size_t j = s.find_first_of(_T("/\\"));
+				if (j == tstring::npos || j > i+1)
+				{
+					*OutPrefix = s.substr(0, i+1);
+					Beg = i+1;
+				}
+				else if (j > i)
+				{
+					*OutPrefix = s.substr(0, j+1);
+					Beg = j+1;
+				}
+			}
+		}
+	}
+
+	// TrailingPathDelimiter
+	if (End > Beg)
+	{
+		if (IsPathSlash(s[End-1]))
+		{
+			CharToStr(OutTrailingPathDelimiter, s[End-1]);
+			End--;
+		}
+	}
+
+	assert(End >= Beg);
+	*OutPath = s.substr(Beg, End-Beg);
+}
+
+bool PathIsAbsolute(const tstring &s)
+{
+	// Przepisane z części Prefix funkcji DecomposePath
+	if (s.empty())
+		return false;
+	// Zaczyna się od <slash>
+	if (IsPathSlash(s[0]))
+		return true;
+	// <dysk> : <slash>
+	size_t i = s.find(_T(':'));
+	if (i == tstring::npos)
+		return false;
+	size_t j = s.find_first_of(_T("/\\"));
+	if (j == tstring::npos || j > i)
+		return true;
+	return false;
+}
+
+void IncludeTrailingPathDelimiter(tstring *InOutPath)
+{
+	if (InOutPath->empty())
+		CharToStr(InOutPath, DIR_SEP);
+	else
+	{
+		if (!IsPathSlash((*InOutPath)[InOutPath->length()-1]))
+			*InOutPath += DIR_SEP;
+	}
+}
+
+void IncludeTrailingPathDelimiter(tstring *OutPath, const tstring &InPath)
+{
+	if (InPath.empty())
+		CharToStr(OutPath, DIR_SEP);
+	else
+	{
+		if (!IsPathSlash(InPath[InPath.length()-1]))
+			*OutPath = InPath + CharToStrR(DIR_SEP);
+		else
+			*OutPath = InPath;
+	}
+}
+
+void ExcludeTrailingPathDelimiter(tstring *InOutPath)
+{
+	if (InOutPath->empty())
+		return;
+	if (IsPathSlash((*InOutPath)[InOutPath->length()-1]))
+		InOutPath->erase(InOutPath->length()-1, 1);
+}
+
+void ExcludeTrailingPathDelimiter(tstring *OutPath, const tstring &InPath)
+{
+	if (InPath.empty())
+		OutPath->clear();
+	else
+	{
+		if (IsPathSlash(InPath[InPath.length()-1]))
+			*OutPath = InPath.substr(0, InPath.length()-1);
+		else
+			*OutPath = InPath;
+	}
+}
+
+void ExtractPathPrefix(tstring *OutPrefix, const tstring &s)
+{
+	OutPrefix->clear();
+	size_t Beg = 0;
+
+	// Skopiowana część Prefix z funkcji DecomposePath
+	if (!s.empty())
+	{
+		// Zaczyna się od <slash>
+		if (IsPathSlash(s[0]))
+		{
+			// <slash> <slash> <serwer> <slash> <udział> <slash>
+			if (s.length() > 1 && IsPathSlash(s[1]))
+			{
+				size_t i = s.find_first_of(_T("/\\"), 2);
+				if (i == tstring::npos) { *OutPrefix = s; return; }
+				i = s.find_first_of(_T("/\\"), i+1);
+				if (i == tstring::npos) { *OutPrefix = s; return; }
+				*OutPrefix = s.substr(0, i+1);
+				Beg = i+1;
+			}
+			// Nie - po prostu <slash>
+			else
+			{
+				CharToStr(OutPrefix, s[0]);
+				Beg = 1;
+			}
+		}
+		// <dysk> : <slash>
+		else
+		{
+			size_t i = s.find(_T(':'));
+			if (i != tstring::npos)
+			{
+				size_t j = s.find_first_of(_T("/\\"));
+				if (j == tstring::npos || j > i+1)
+				{
+					*OutPrefix = s.substr(0, i+1);
+					Beg = i+1;
+				}
+				else if (j > i)
+				{
+					*OutPrefix = s.substr(0, j+1);
+					Beg = j+1;
+				}
+			}
+		}
+	}
+
+	if (Beg > 0)
+		*OutPrefix = s.substr(0, Beg+1);
+}
+
+void ExtractFilePath(tstring *OutPath, const tstring &s)
+{
+	size_t i = s.find_last_of(_T("\\/:"));
+	if (i == tstring::npos)
+		OutPath->clear();
+	else
+		*OutPath = s.substr(0, i + 1);
+}
+
+void ExtractFileName(tstring *OutFileName, const tstring &s)
+{
+	size_t i = s.find_last_of(_T("\\/:"));
+	if (i == tstring::npos)
+		*OutFileName = s;
+	else
+		*OutFileName = s.substr(i + 1);
+}
+
+void ExtractFileExt(tstring *OutExt, const tstring &s)
+{
+	size_t i = s.find_last_of(_T(".\\/:"));
+	if ( (i != tstring::npos) && (i > 0) && (s[i] == _T('.')) )
+		*OutExt = s.substr(i);
+	else
+		OutExt->clear();
+}
+
+void ChangeFileExt(tstring *Out, const tstring &FileName, const tstring &Ext)
+{
+	size_t i = FileName.find_last_of(_T(".\\/:"));
+	if ( (i == tstring::npos) || (FileName[i] != _T('.')) )
+		*Out = FileName + Ext;
+	else
+		*Out = FileName.substr(0, i) + Ext;
+}
+
+void NormalizePath(tstring *OutPath, const tstring &s)
+{
+	const tstring Delimiters = _T("/\\");
+	tstring Path, Trailing, Tmp;
+	DecomposePath(s, OutPath, &Path, &Trailing);
+	STRING_VECTOR Dirs;
+	size_t Index = 0;
+	while (SplitFirstOf(Path, Delimiters, &Tmp, &Index))
+	{
+		if (Tmp.empty())
+		{
+			*OutPath = s;
+			return;
+		}
+		if (Tmp[0] == _T('.'))
+		{
+			// ".."
+			if (Tmp.length() == 2 && Tmp[1] == _T('.'))
+			{
+				if (Dirs.empty())
+					Dirs.push_back(Tmp);
+				else
+					Dirs.pop_back();
+			}
+			// "." - nie rób nic
+		}
+		// Zwykły katalog
+		else
+			Dirs.push_back(Tmp);
+	}
+
+	for (size_t i = 0; i < Dirs.size(); i++)
+	{
+		if (!OutPath->empty())
+			IncludeTrailingPathDelimiter(OutPath);
+		*OutPath += Dirs[i];
+	}
+	OutPath->append(Trailing);
+}
+
+void RelativeToAbsolutePath(tstring *Out, const tstring &Base, const tstring &Path)
+{
+	if (PathIsAbsolute(Path))
+		*Out = Path;
+	else
+	{
+		tstring Tmp = Base;
+		IncludeTrailingPathDelimiter(&Tmp);
+		Tmp.append(Path);
+		NormalizePath(Out, Tmp);
+	}
+}
+
+void AbsoluteToRelativePath(tstring *Out, const tstring &Base, const tstring &Target)
+{
+	tstring BasePrefix, BasePath, BaseTrailing;
+	tstring TargetPrefix, TargetPath, TargetTrailing;
+	DecomposePath(Base, &BasePrefix, &BasePath, &BaseTrailing);
+	DecomposePath(Target, &TargetPrefix, &TargetPath, &TargetTrailing);
+
+	if (!PathCmp(BasePrefix, TargetPrefix))
+	{
+		*Out = Target;
+		return;
+	}
+
+	// Spisz katalogi Base i Target
+	const tstring DELIMITER = _T("/\\");
+	STRING_VECTOR BaseDirs, TargetDirs;
+	size_t i = 0;
+	tstring Tmp;
+	while (SplitFirstOf(BasePath, DELIMITER, &Tmp, &i))
+		BaseDirs.push_back(Tmp);
+	i = 0;
+	while (SplitFirstOf(TargetPath, DELIMITER, &Tmp, &i))
+		TargetDirs.push_back(Tmp);
+
+	tstring R;
+	// Wyeliminuj wspólne katalogi z początku ścieżek
+	size_t DirsDifferenceIndex = 0;
+	while (DirsDifferenceIndex < BaseDirs.size() && DirsDifferenceIndex < TargetDirs.size() && PathCmp(BaseDirs[DirsDifferenceIndex], TargetDirs[DirsDifferenceIndex]))
+		DirsDifferenceIndex++;
+
+	// Przepisz na wyjście "/.." lub "\.."
+	for (size_t i = DirsDifferenceIndex; i < BaseDirs.size(); i++)
+	{
+		if (!R.empty())
+			IncludeTrailingPathDelimiter(&R);
+		R.append(_T(".."));
+	}
+	// Przepisz na wyjście to co w Target
+	for (size_t i = DirsDifferenceIndex; i < TargetDirs.size(); i++)
+	{
+		if (!R.empty())
+			IncludeTrailingPathDelimiter(&R);
+		R.append(TargetDirs[i]);
+	}
+	// Opcjonalny kończący '/' lub '\'
+	bool TrailingPathDelimiter = (!Target.empty() && Target[Target.length()-1] == DIR_SEP);
+	if (TrailingPathDelimiter)
+		IncludeTrailingPathDelimiter(&R);
+	NormalizePath(Out, R);
+}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// KONWERSJE
+
+static const tchar _DIGITS_L[] = _T("0123456789abcdefghijklmnopqrstuvwxyz");
+static const tchar _DIGITS_U[] = _T("0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ");
+
+// Zapis dziesiętny liczb całkowitych: długość z liczby bitów i jednego porównania
+// z potęgą dziesiątki, potem cyfry od końca po dwie naraz z tablicy par "00".."99"
+// - połowa dzieleń w porównaniu z zapisem cyfra po cyfrze i bez odwracania łańcucha.
+
+static const tchar DIGIT_PAIRS[] = _T(
+	"0001020304050607080910111213141516171819"
+	"2021222324252627282930313233343536373839"
+	"4041424344454647484950515253545556575859"
+	"6061626364656667686970717273747576777879"
+	"8081828384858687888990919293949596979899");
+
+static const uint64 POWERS_OF_TEN_64[] = {
+	1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull,
+	10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull, 100000000000000ull,
+	1000000000000000ull, 10000000000000000ull, 100000000000000000ull, 1000000000000000000ull,
+	10000000000000000000ull,
+};
+
+// x != 0
+inline int CountLeadingZeros64(uint64 x)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+	unsigned long Index;
+	_BitScanReverse64(&Index, x);
+	return 63 - (int)Index;
+#elif defined(__GNUC__)
+	return __builtin_clzll(x);
+#else
+	int n = 0;
+	while ((x & 0x8000000000000000ull) == 0) { x <<= 1; n++; }
+	return n;
+#endif
+}
+
+// Liczba cyfr dziesiętnych x (1 dla zera). 1233/4096 ~ log10(2).
+inline uint CountDecimalDigits(uint64 x)
+{
+	uint Bits = 64 - (uint)CountLeadingZeros64(x | 1);
+	uint t = (Bits * 1233) >> 12;
+	return t + ((x | 1) >= POWERS_OF_TEN_64[t] ? 1 : 0);
+}
+
+// Zapisuje cyfry x kończąc przed End. T to uint32 lub uint64 - dzielenie na typie
+// tej szerokości, której potrzeba.
+template <typename T>
+inline void WriteDigitPairs(tchar *End, T x)
+{
+	while (x >= 100)
+	{
+		uint r = (uint)(x % 100) * 2;
+		x /= 100;
+		*--End = DIGIT_PAIRS[r + 1];
+		*--End = DIGIT_PAIRS[r];
+	}
+	if (x >= 10)
+	{
+		uint r = (uint)x * 2;
+		*--End = DIGIT_PAIRS[r + 1];
+		*--End = DIGIT_PAIRS[r];
+	}
+	else
+		*--End = (tchar)(_T('0') + (uint)x);
+}
+
+size_t _UintToDecimal32(tchar *Out, uint32 x)
+{
+	uint Length = CountDecimalDigits(x);
+	WriteDigitPairs<uint32>(Out + Length, x);
+	Out[Length] = _T('\0');
+	return Length;
+}
+
+size_t _UintToDecimal64(tchar *Out, uint64 x)
+{
+	uint Length = CountDecimalDigits(x);
+	tchar *End = Out + Length;
+	// Młodsze 8 cyfr osobno, żeby reszta szła na 32 bitach
+	while (x > 0xFFFFFFFFull)
+	{
+		uint32 Low = (uint32)(x % 100000000);
+		x /= 100000000;
+		for (uint i = 0; i < 4; i++)
+		{
+			uint r = (Low % 100) * 2;
+			Low /= 100;
+			*--End = DIGIT_PAIRS[r + 1];
+			*--End = DIGIT_PAIRS[r];
+		}
+	}
+	WriteDigitPairs<uint32>(End, (uint32)x);
+	Out[Length] = _T('\0');
+	return Length;
+}
+
+size_t _UintToStrBase(tchar *Out, uint64 x, uint32 Base, bool UpperCase)
+{
+	assert(Base >= 2 && Base <= 36);
+	const tchar *Digits = UpperCase ? _DIGITS_U : _DIGITS_L;
+	tchar Tmp[64];
+	tchar *p = Tmp + 64;
+	// Podstawa to potęga dwójki - przesuwanie bitowe zamiast dzielenia
+	if (IsPow2<uint32>(Base))
+	{
+		uint32 Bits = log2u(Base);
+		uint32 BitMask = GetBitMask(Bits);
+		do
+		{
+			*--p = Digits[x & BitMask];
+			x >>= Bits;
+		}
+		while (x != 0);
+	}
+	else
+	{
+		do
+		{
+			*--p = Digits[x % Base];
+			x /= Base;
+		}
+		while (x != 0);
+	}
+	size_t Length = (size_t)(Tmp + 64 - p);
+	memcpy(Out, p, Length * sizeof(tchar));
+	Out[Length] = _T('\0');
+	return Length;
+}
+
+// Parsowanie liczb z łańcucha nie używa strtod ani locale i nie alokuje pamięci.
+// Liczby zmiennoprzecinkowe: algorytm Eisel-Lemire (D. Lemire, "Number Parsing at
+// a Gigabyte per Second") na pierwszych 19 cyfrach znaczących, a jeśli to nie
+// wystarcza do rozstrzygnięcia - dokładne porównanie z punktem w połowie między
+// sąsiednimi wartościami na dużych liczbach całkowitych. Wynik jest zawsze
+// poprawnie zaokrąglony (do najbliższej, remis do parzystej).
+
+// Przybliżenia 5^q dla q = -342..308 znormalizowane do 128 bitów - starsza i młodsza połowa.
+static const uint64 POWERS_OF_FIVE_128[] = {
+	0xeef453d6923bd65aull, 0x113faa2906a13b3full,
+	0x9558b4661b6565f8ull, 0x4ac7ca59a424c507ull,
+	0xbaaee17fa23ebf76ull, 0x5d79bcf00d2df649ull,
+	0xe95a99df8ace6f53ull, 0xf4d82c2c107973dcull,
+	0x91d8a02bb6c10594ull, 0x79071b9b8a4be869ull,
+	0xb64ec836a47146f9ull, 0x9748e2826cdee284ull,
+	0xe3e27a444d8d98b7ull, 0xfd1b1b2308169b25ull,
+	0x8e6d8c6ab0787f72ull, 0xfe30f0f5e50e20f7ull,
+	0xb208ef855c969f4full, 0xbdbd2d335e51a935ull,
+	0xde8b2b66b3bc4723ull, 0xad2c788035e61382ull,
+	0x8b16fb203055ac76ull, 0x4c3bcb5021afcc31ull,
+	0xaddcb9e83c6b1793ull, 0xdf4abe242a1bbf3dull,
+	0xd953e8624b85dd78ull, 0xd71d6dad34a2af0dull,
+	0x87d4713d6f33aa6bull, 0x8672648c40e5ad68ull,
+	0xa9c98d8ccb009506ull, 0x680efdaf511f18c2ull,
+	0xd43bf0effdc0ba48ull, 0x0212bd1b2566def2ull,
+	0x84a57695fe98746dull, 0x014bb630f7604b57ull,
+	0xa5ced43b7e3e9188ull, 0x419ea3bd35385e2dull,
+	0xcf42894a5dce35eaull, 0x52064cac828675b9ull,
+	0x818995ce7aa0e1b2ull, 0x7343efebd1940993ull,
+	0xa1ebfb4219491a1full, 0x1014ebe6c5f90bf8ull,
+	0xca66fa129f9b60a6ull, 0xd41a26e077774ef6ull,
+	0xfd00b897478238d0ull, 0x8920b098955522b4ull,
+	0x9e20735e8cb16382ull, 0x55b46e5f5d5535b0ull,
+	0xc5a890362fddbc62ull, 0xeb2189f734aa831dull,
+	0xf712b443bbd52b7bull, 0xa5e9ec7501d523e4ull,
+	0x9a6bb0aa55653b2dull, 0x47b233c92125366eull,
+	0xc1069cd4eabe89f8ull, 0x999ec0bb696e840aull,
+	0xf148440a256e2c76ull, 0xc00670ea43ca250dull,
+	0x96cd2a865764dbcaull, 0x380406926a5e5728ull,
+	0xbc807527ed3e12bcull, 0xc605083704f5ecf2ull,
+	0xeba09271e88d976bull, 0xf7864a44c633682eull,
+	0x93445b8731587ea3ull, 0x7ab3ee6afbe0211dull,
+	0xb8157268fdae9e4cull, 0x5960ea05bad82964ull,
+	0xe61acf033d1a45dfull, 0x6fb92487298e33bdull,
+	0x8fd0c16206306babull, 0xa5d3b6d479f8e056ull,
+	0xb3c4f1ba87bc8696ull, 0x8f48a4899877186cull,
+	0xe0b62e2929aba83cull, 0x331acdabfe94de87ull,
+	0x8c71dcd9ba0b4925ull, 0x9ff0c08b7f1d0b14ull,
+	0xaf8e5410288e1b6full, 0x07ecf0ae5ee44dd9ull,
+	0xdb71e91432b1a24aull, 0xc9e82cd9f69d6150ull,
+	0x892731ac9faf056eull, 0xbe311c083a225cd2ull,
+	0xab70fe17c79ac6caull, 0x6dbd630a48aaf406ull,
+	0xd64d3d9db981787dull, 0x092cbbccdad5b108ull,
+	0x85f0468293f0eb4eull, 0x25bbf56008c58ea5ull,
+	0xa76c582338ed2621ull, 0xaf2af2b80af6f24eull,
+	0xd1476e2c07286faaull, 0x1af5af660db4aee1ull,
+	0x82cca4db847945caull, 0x50d98d9fc890ed4dull,
+	0xa37fce126597973cull, 0xe50ff107bab528a0ull,
+	0xcc5fc196fefd7d0cull, 0x1e53ed49a96272c8ull,
+	0xff77b1fcbebcdc4full, 0x25e8e89c13bb0f7aull,
+	0x9faacf3df73609b1ull, 0x77b191618c54e9acull,
+	0xc795830d75038c1dull, 0xd59df5b9ef6a2417ull,
+	0xf97ae3d0d2446f25ull, 0x4b0573286b44ad1dull,
+	0x9becce62836ac577ull, 0x4ee367f9430aec32ull,
+	0xc2e801fb244576d5ull, 0x229c41f793cda73full,
+	0xf3a20279ed56d48aull, 0x6b43527578c1110full,
+	0x9845418c345644d6ull, 0x830a13896b78aaa9ull,
+	0xbe5691ef416bd60cull, 0x23cc986bc656d553ull,
+	0xedec366b11c6cb8full, 0x2cbfbe86b7ec8aa8ull,
+	0x94b3a202eb1c3f39ull, 0x7bf7d71432f3d6a9ull,
+	0xb9e08a83a5e34f07ull, 0xdaf5ccd93fb0cc53ull,
+	0xe858ad248f5c22c9ull, 0xd1b3400f8f9cff68ull,
+	0x91376c36d99995beull, 0x23100809b9c21fa1ull,
+	0xb58547448ffffb2dull, 0xabd40a0c2832a78aull,
+	0xe2e69915b3fff9f9ull, 0x16c90c8f323f516cull,
+	0x8dd01fad907ffc3bull, 0xae3da7d97f6792e3ull,
+	0xb1442798f49ffb4aull, 0x99cd11cfdf41779cull,
+	0xdd95317f31c7fa1dull, 0x40405643d711d583ull,
+	0x8a7d3eef7f1cfc52ull, 0x482835ea666b2572ull,
+	0xad1c8eab5ee43b66ull, 0xda3243650005eecfull,
+	0xd863b256369d4a40ull, 0x90bed43e40076a82ull,
+	0x873e4f75e2224e68ull, 0x5a7744a6e804a291ull,
+	0xa90de3535aaae202ull, 0x711515d0a205cb36ull,
+	0xd3515c2831559a83ull, 0x0d5a5b44ca873e03ull,
+	0x8412d9991ed58091ull, 0xe858790afe9486c2ull,
+	0xa5178fff668ae0b6ull, 0x626e974dbe39a872ull,
+	0xce5d73ff402d98e3ull, 0xfb0a3d212dc8128full,
+	0x80fa687f881c7f8eull, 0x7ce66634bc9d0b99ull,
+	0xa139029f6a239f72ull, 0x1c1fffc1ebc44e80ull,
+	0xc987434744ac874eull, 0xa327ffb266b56220ull,
+	0xfbe9141915d7a922ull, 0x4bf1ff9f0062baa8ull,
+	0x9d71ac8fada6c9b5ull, 0x6f773fc3603db4a9ull,
+	0xc4ce17b399107c22ull, 0xcb550fb4384d21d3ull,
+	0xf6019da07f549b2bull, 0x7e2a53a146606a48ull,
+	0x99c102844f94e0fbull, 0x2eda7444cbfc426dull,
+	0xc0314325637a1939ull, 0xfa911155fefb5308ull,
+	0xf03d93eebc589f88ull, 0x793555ab7eba27caull,
+	0x96267c7535b763b5ull, 0x4bc1558b2f3458deull,
+	0xbbb01b9283253ca2ull, 0x9eb1aaedfb016f16ull,
+	0xea9c227723ee8bcbull, 0x465e15a979c1cadcull,
+	0x92a1958a7675175full, 0x0bfacd89ec191ec9ull,
+	0xb749faed14125d36ull, 0xcef980ec671f667bull,
+	0xe51c79a85916f484ull, 0x82b7e12780e7401aull,
+	0x8f31cc0937ae58d2ull, 0xd1b2ecb8b0908810ull,
+	0xb2fe3f0b8599ef07ull, 0x861fa7e6dcb4aa15ull,
+	0xdfbdcece67006ac9ull, 0x67a791e093e1d49aull,
+	0x8bd6a141006042bdull, 0xe0c8bb2c5c6d24e0ull,
+	0xaecc49914078536dull, 0x58fae9f773886e18ull,
+	0xda7f5bf590966848ull, 0xaf39a475506a899eull,
+	0x888f99797a5e012dull, 0x6d8406c952429603ull,
+	0xaab37fd7d8f58178ull, 0xc8e5087ba6d33b83ull,
+	0xd5605fcdcf32e1d6ull, 0xfb1e4a9a90880a64ull,
+	0x855c3be0a17fcd26ull, 0x5cf2eea09a55067full,
+	0xa6b34ad8c9dfc06full, 0xf42faa48c0ea481eull,
+	0xd0601d8efc57b08bull, 0xf13b94daf124da26ull,
+	0x823c12795db6ce57ull, 0x76c53d08d6b70858ull,
+	0xa2cb1717b52481edull, 0x54768c4b0c64ca6eull,
+	0xcb7ddcdda26da268ull, 0xa9942f5dcf7dfd09ull,
+	0xfe5d54150b090b02ull, 0xd3f93b35435d7c4cull,
+	0x9efa548d26e5a6e1ull, 0xc47bc5014a1a6dafull,
+	0xc6b8e9b0709f109aull, 0x359ab6419ca1091bull,
+	0xf867241c8cc6d4c0ull, 0xc30163d203c94b62ull,
+	0x9b407691d7fc44f8ull, 0x79e0de63425dcf1dull,
+	0xc21094364dfb5636ull, 0x985915fc12f542e4ull,
+	0xf294b943e17a2bc4ull, 0x3e6f5b7b17b2939dull,
+	0x979cf3ca6cec5b5aull, 0xa705992ceecf9c42ull,
+	0xbd8430bd08277231ull, 0x50c6ff782a838353ull,
+	0xece53cec4a314ebdull, 0xa4f8bf5635246428ull,
+	0x940f4613ae5ed136ull, 0x871b7795e136be99ull,
+	0xb913179899f68584ull, 0x28e2557b59846e3full,
+	0xe757dd7ec07426e5ull, 0x331aeada2fe589cfull,
+	0x9096ea6f3848984full, 0x3ff0d2c85def7621ull,
+	0xb4bca50b065abe63ull, 0x0fed077a756b53a9ull,
+	0xe1ebce4dc7f16dfbull, 0xd3e8495912c62894ull,
+	0x8d3360f09cf6e4bdull, 0x64712dd7abbbd95cull,
+	0xb080392cc4349decull, 0xbd8d794d96aacfb3ull,
+	0xdca04777f541c567ull, 0xecf0d7a0fc5583a0ull,
+	0x89e42caaf9491b60ull, 0xf41686c49db57244ull,
+	0xac5d37d5b79b6239ull, 0x311c2875c522ced5ull,
+	0xd77485cb25823ac7ull, 0x7d633293366b828bull,
+	0x86a8d39ef77164bcull, 0xae5dff9c02033197ull,
+	0xa8530886b54dbdebull, 0xd9f57f830283fdfcull,
+	0xd267caa862a12d66ull, 0xd072df63c324fd7bull,
+	0x8380dea93da4bc60ull, 0x4247cb9e59f71e6dull,
+	0xa46116538d0deb78ull, 0x52d9be85f074e608ull,
+	0xcd795be870516656ull, 0x67902e276c921f8bull,
+	0x806bd9714632dff6ull, 0x00ba1cd8a3db53b6ull,
+	0xa086cfcd97bf97f3ull, 0x80e8a40eccd228a4ull,
+	0xc8a883c0fdaf7df0ull, 0x6122cd128006b2cdull,
+	0xfad2a4b13d1b5d6cull, 0x796b805720085f81ull,
+	0x9cc3a6eec6311a63ull, 0xcbe3303674053bb0ull,
+	0xc3f490aa77bd60fcull, 0xbedbfc4411068a9cull,
+	0xf4f1b4d515acb93bull, 0xee92fb5515482d44ull,
+	0x991711052d8bf3c5ull, 0x751bdd152d4d1c4aull,
+	0xbf5cd54678eef0b6ull, 0xd262d45a78a0635dull,
+	0xef340a98172aace4ull, 0x86fb897116c87c34ull,
+	0x9580869f0e7aac0eull, 0xd45d35e6ae3d4da0ull,
+	0xbae0a846d2195712ull, 0x8974836059cca109ull,
+	0xe998d258869facd7ull, 0x2bd1a438703fc94bull,
+	0x91ff83775423cc06ull, 0x7b6306a34627ddcfull,
+	0xb67f6455292cbf08ull, 0x1a3bc84c17b1d542ull,
+	0xe41f3d6a7377eecaull, 0x20caba5f1d9e4a93ull,
+	0x8e938662882af53eull, 0x547eb47b7282ee9cull,
+	0xb23867fb2a35b28dull, 0xe99e619a4f23aa43ull,
+	0xdec681f9f4c31f31ull, 0x6405fa00e2ec94d4ull,
+	0x8b3c113c38f9f37eull, 0xde83bc408dd3dd04ull,
+	0xae0b158b4738705eull, 0x9624ab50b148d445ull,
+	0xd98ddaee19068c76ull, 0x3badd624dd9b0957ull,
+	0x87f8a8d4cfa417c9ull, 0xe54ca5d70a80e5d6ull,
+	0xa9f6d30a038d1dbcull, 0x5e9fcf4ccd211f4cull,
+	0xd47487cc8470652bull, 0x7647c3200069671full,
+	0x84c8d4dfd2c63f3bull, 0x29ecd9f40041e073ull,
+	0xa5fb0a17c777cf09ull, 0xf468107100525890ull,
+	0xcf79cc9db955c2ccull, 0x7182148d4066eeb4ull,
+	0x81ac1fe293d599bfull, 0xc6f14cd848405530ull,
+	0xa21727db38cb002full, 0xb8ada00e5a506a7cull,
+	0xca9cf1d206fdc03bull, 0xa6d90811f0e4851cull,
+	0xfd442e4688bd304aull, 0x908f4a166d1da663ull,
+	0x9e4a9cec15763e2eull, 0x9a598e4e043287feull,
+	0xc5dd44271ad3cdbaull, 0x40eff1e1853f29fdull,
+	0xf7549530e188c128ull, 0xd12bee59e68ef47cull,
+	0x9a94dd3e8cf578b9ull, 0x82bb74f8301958ceull,
+	0xc13a148e3032d6e7ull, 0xe36a52363c1faf01ull,
+	0xf18899b1bc3f8ca1ull, 0xdc44e6c3cb279ac1ull,
+	0x96f5600f15a7b7e5ull, 0x29ab103a5ef8c0b9ull,
+	0xbcb2b812db11a5deull, 0x7415d448f6b6f0e7ull,
+	0xebdf661791d60f56ull, 0x111b495b3464ad21ull,
+	0x936b9fcebb25c995ull, 0xcab10dd900beec34ull,
+	0xb84687c269ef3bfbull, 0x3d5d514f40eea742ull,
+	0xe65829b3046b0afaull, 0x0cb4a5a3112a5112ull,
+	0x8ff71a0fe2c2e6dcull, 0x47f0e785eaba72abull,
+	0xb3f4e093db73a093ull, 0x59ed216765690f56ull,
+	0xe0f218b8d25088b8ull, 0x306869c13ec3532cull,
+	0x8c974f7383725573ull, 0x1e414218c73a13fbull,
+	0xafbd2350644eeacfull, 0xe5d1929ef90898faull,
+	0xdbac6c247d62a583ull, 0xdf45f746b74abf39ull,
+	0x894bc396ce5da772ull, 0x6b8bba8c328eb783ull,
+	0xab9eb47c81f5114full, 0x066ea92f3f326564ull,
+	0xd686619ba27255a2ull, 0xc80a537b0efefebdull,
+	0x8613fd0145877585ull, 0xbd06742ce95f5f36ull,
+	0xa798fc4196e952e7ull, 0x2c48113823b73704ull,
+	0xd17f3b51fca3a7a0ull, 0xf75a15862ca504c5ull,
+	0x82ef85133de648c4ull, 0x9a984d73dbe722fbull,
+	0xa3ab66580d5fdaf5ull, 0xc13e60d0d2e0ebbaull,
+	0xcc963fee10b7d1b3ull, 0x318df905079926a8ull,
+	0xffbbcfe994e5c61full, 0xfdf17746497f7052ull,
+	0x9fd561f1fd0f9bd3ull, 0xfeb6ea8bedefa633ull,
+	0xc7caba6e7c5382c8ull, 0xfe64a52ee96b8fc0ull,
+	0xf9bd690a1b68637bull, 0x3dfdce7aa3c673b0ull,
+	0x9c1661a651213e2dull, 0x06bea10ca65c084eull,
+	0xc31bfa0fe5698db8ull, 0x486e494fcff30a62ull,
+	0xf3e2f893dec3f126ull, 0x5a89dba3c3efccfaull,
+	0x986ddb5c6b3a76b7ull, 0xf89629465a75e01cull,
+	0xbe89523386091465ull, 0xf6bbb397f1135823ull,
+	0xee2ba6c0678b597full, 0x746aa07ded582e2cull,
+	0x94db483840b717efull, 0xa8c2a44eb4571cdcull,
+	0xba121a4650e4ddebull, 0x92f34d62616ce413ull,
+	0xe896a0d7e51e1566ull, 0x77b020baf9c81d17ull,
+	0x915e2486ef32cd60ull, 0x0ace1474dc1d122eull,
+	0xb5b5ada8aaff80b8ull, 0x0d819992132456baull,
+	0xe3231912d5bf60e6ull, 0x10e1fff697ed6c69ull,
+	0x8df5efabc5979c8full, 0xca8d3ffa1ef463c1ull,
+	0xb1736b96b6fd83b3ull, 0xbd308ff8a6b17cb2ull,
+	0xddd0467c64bce4a0ull, 0xac7cb3f6d05ddbdeull,
+	0x8aa22c0dbef60ee4ull, 0x6bcdf07a423aa96bull,
+	0xad4ab7112eb3929dull, 0x86c16c98d2c953c6ull,
+	0xd89d64d57a607744ull, 0xe871c7bf077ba8b7ull,
+	0x87625f056c7c4a8bull, 0x11471cd764ad4972ull,
+	0xa93af6c6c79b5d2dull, 0xd598e40d3dd89bcfull,
+	0xd389b47879823479ull, 0x4aff1d108d4ec2c3ull,
+	0x843610cb4bf160cbull, 0xcedf722a585139baull,
+	0xa54394fe1eedb8feull, 0xc2974eb4ee658828ull,
+	0xce947a3da6a9273eull, 0x733d226229feea32ull,
+	0x811ccc668829b887ull, 0x0806357d5a3f525full,
+	0xa163ff802a3426a8ull, 0xca07c2dcb0cf26f7ull,
+	0xc9bcff6034c13052ull, 0xfc89b393dd02f0b5ull,
+	0xfc2c3f3841f17c67ull, 0xbbac2078d443ace2ull,
+	0x9d9ba7832936edc0ull, 0xd54b944b84aa4c0dull,
+	0xc5029163f384a931ull, 0x0a9e795e65d4df11ull,
+	0xf64335bcf065d37dull, 0x4d4617b5ff4a16d5ull,
+	0x99ea0196163fa42eull, 0x504bced1bf8e4e45ull,
+	0xc06481fb9bcf8d39ull, 0xe45ec2862f71e1d6ull,
+	0xf07da27a82c37088ull, 0x5d767327bb4e5a4cull,
+	0x964e858c91ba2655ull, 0x3a6a07f8d510f86full,
+	0xbbe226efb628afeaull, 0x890489f70a55368bull,
+	0xeadab0aba3b2dbe5ull, 0x2b45ac74ccea842eull,
+	0x92c8ae6b464fc96full, 0x3b0b8bc90012929dull,
+	0xb77ada0617e3bbcbull, 0x09ce6ebb40173744ull,
+	0xe55990879ddcaabdull, 0xcc420a6a101d0515ull,
+	0x8f57fa54c2a9eab6ull, 0x9fa946824a12232dull,
+	0xb32df8e9f3546564ull, 0x47939822dc96abf9ull,
+	0xdff9772470297ebdull, 0x59787e2b93bc56f7ull,
+	0x8bfbea76c619ef36ull, 0x57eb4edb3c55b65aull,
+	0xaefae51477a06b03ull, 0xede622920b6b23f1ull,
+	0xdab99e59958885c4ull, 0xe95fab368e45ecedull,
+	0x88b402f7fd75539bull, 0x11dbcb0218ebb414ull,
+	0xaae103b5fcd2a881ull, 0xd652bdc29f26a119ull,
+	0xd59944a37c0752a2ull, 0x4be76d3346f0495full,
+	0x857fcae62d8493a5ull, 0x6f70a4400c562ddbull,
+	0xa6dfbd9fb8e5b88eull, 0xcb4ccd500f6bb952ull,
+	0xd097ad07a71f26b2ull, 0x7e2000a41346a7a7ull,
+	0x825ecc24c873782full, 0x8ed400668c0c28c8ull,
+	0xa2f67f2dfa90563bull, 0x728900802f0f32faull,
+	0xcbb41ef979346bcaull, 0x4f2b40a03ad2ffb9ull,
+	0xfea126b7d78186bcull, 0xe2f610c84987bfa8ull,
+	0x9f24b832e6b0f436ull, 0x0dd9ca7d2df4d7c9ull,
+	0xc6ede63fa05d3143ull, 0x91503d1c79720dbbull,
+	0xf8a95fcf88747d94ull, 0x75a44c6397ce912aull,
+	0x9b69dbe1b548ce7cull, 0xc986afbe3ee11abaull,
+	0xc24452da229b021bull, 0xfbe85badce996168ull,
+	0xf2d56790ab41c2a2ull, 0xfae27299423fb9c3ull,
+	0x97c560ba6b0919a5ull, 0xdccd879fc967d41aull,
+	0xbdb6b8e905cb600full, 0x5400e987bbc1c920ull,
+	0xed246723473e3813ull, 0x290123e9aab23b68ull,
+	0x9436c0760c86e30bull, 0xf9a0b6720aaf6521ull,
+	0xb94470938fa89bceull, 0xf808e40e8d5b3e69ull,
+	0xe7958cb87392c2c2ull, 0xb60b1d1230b20e04ull,
+	0x90bd77f3483bb9b9ull, 0xb1c6f22b5e6f48c2ull,
+	0xb4ecd5f01a4aa828ull, 0x1e38aeb6360b1af3ull,
+	0xe2280b6c20dd5232ull, 0x25c6da63c38de1b0ull,
+	0x8d590723948a535full, 0x579c487e5a38ad0eull,
+	0xb0af48ec79ace837ull, 0x2d835a9df0c6d851ull,
+	0xdcdb1b2798182244ull, 0xf8e431456cf88e65ull,
+	0x8a08f0f8bf0f156bull, 0x1b8e9ecb641b58ffull,
+	0xac8b2d36eed2dac5ull, 0xe272467e3d222f3full,
+	0xd7adf884aa879177ull, 0x5b0ed81dcc6abb0full,
+	0x86ccbb52ea94baeaull, 0x98e947129fc2b4e9ull,
+	0xa87fea27a539e9a5ull, 0x3f2398d747b36224ull,
+	0xd29fe4b18e88640eull, 0x8eec7f0d19a03aadull,
+	0x83a3eeeef9153e89ull, 0x1953cf68300424acull,
+	0xa48ceaaab75a8e2bull, 0x5fa8c3423c052dd7ull,
+	0xcdb02555653131b6ull, 0x3792f412cb06794dull,
+	0x808e17555f3ebf11ull, 0xe2bbd88bbee40bd0ull,
+	0xa0b19d2ab70e6ed6ull, 0x5b6aceaeae9d0ec4ull,
+	0xc8de047564d20a8bull, 0xf245825a5a445275ull,
+	0xfb158592be068d2eull, 0xeed6e2f0f0d56712ull,
+	0x9ced737bb6c4183dull, 0x55464dd69685606bull,
+	0xc428d05aa4751e4cull, 0xaa97e14c3c26b886ull,
+	0xf53304714d9265dfull, 0xd53dd99f4b3066a8ull,
+	0x993fe2c6d07b7fabull, 0xe546a8038efe4029ull,
+	0xbf8fdb78849a5f96ull, 0xde98520472bdd033ull,
+	0xef73d256a5c0f77cull, 0x963e66858f6d4440ull,
+	0x95a8637627989aadull, 0xdde7001379a44aa8ull,
+	0xbb127c53b17ec159ull, 0x5560c018580d5d52ull,
+	0xe9d71b689dde71afull, 0xaab8f01e6e10b4a6ull,
+	0x9226712162ab070dull, 0xcab3961304ca70e8ull,
+	0xb6b00d69bb55c8d1ull, 0x3d607b97c5fd0d22ull,
+	0xe45c10c42a2b3b05ull, 0x8cb89a7db77c506aull,
+	0x8eb98a7a9a5b04e3ull, 0x77f3608e92adb242ull,
+	0xb267ed1940f1c61cull, 0x55f038b237591ed3ull,
+	0xdf01e85f912e37a3ull, 0x6b6c46dec52f6688ull,
+	0x8b61313bbabce2c6ull, 0x2323ac4b3b3da015ull,
+	0xae397d8aa96c1b77ull, 0xabec975e0a0d081aull,
+	0xd9c7dced53c72255ull, 0x96e7bd358c904a21ull,
+	0x881cea14545c7575ull, 0x7e50d64177da2e54ull,
+	0xaa242499697392d2ull, 0xdde50bd1d5d0b9e9ull,
+	0xd4ad2dbfc3d07787ull, 0x955e4ec64b44e864ull,
+	0x84ec3c97da624ab4ull, 0xbd5af13bef0b113eull,
+	0xa6274bbdd0fadd61ull, 0xecb1ad8aeacdd58eull,
+	0xcfb11ead453994baull, 0x67de18eda5814af2ull,
+	0x81ceb32c4b43fcf4ull, 0x80eacf948770ced7ull,
+	0xa2425ff75e14fc31ull, 0xa1258379a94d028dull,
+	0xcad2f7f5359a3b3eull, 0x096ee45813a04330ull,
+	0xfd87b5f28300ca0dull, 0x8bca9d6e188853fcull,
+	0x9e74d1b791e07e48ull, 0x775ea264cf55347eull,
+	0xc612062576589ddaull, 0x95364afe032a819eull,
+	0xf79687aed3eec551ull, 0x3a83ddbd83f52205ull,
+	0x9abe14cd44753b52ull, 0xc4926a9672793543ull,
+	0xc16d9a0095928a27ull, 0x75b7053c0f178294ull,
+	0xf1c90080baf72cb1ull, 0x5324c68b12dd6339ull,
+	0x971da05074da7beeull, 0xd3f6fc16ebca5e04ull,
+	0xbce5086492111aeaull, 0x88f4bb1ca6bcf585ull,
+	0xec1e4a7db69561a5ull, 0x2b31e9e3d06c32e6ull,
+	0x9392ee8e921d5d07ull, 0x3aff322e62439fd0ull,
+	0xb877aa3236a4b449ull, 0x09befeb9fad487c3ull,
+	0xe69594bec44de15bull, 0x4c2ebe687989a9b4ull,
+	0x901d7cf73ab0acd9ull, 0x0f9d37014bf60a11ull,
+	0xb424dc35095cd80full, 0x538484c19ef38c95ull,
+	0xe12e13424bb40e13ull, 0x2865a5f206b06fbaull,
+	0x8cbccc096f5088cbull, 0xf93f87b7442e45d4ull,
+	0xafebff0bcb24aafeull, 0xf78f69a51539d749ull,
+	0xdbe6fecebdedd5beull, 0xb573440e5a884d1cull,
+	0x89705f4136b4a597ull, 0x31680a88f8953031ull,
+	0xabcc77118461cefcull, 0xfdc20d2b36ba7c3eull,
+	0xd6bf94d5e57a42bcull, 0x3d32907604691b4dull,
+	0x8637bd05af6c69b5ull, 0xa63f9a49c2c1b110ull,
+	0xa7c5ac471b478423ull, 0x0fcf80dc33721d54ull,
+	0xd1b71758e219652bull, 0xd3c36113404ea4a9ull,
+	0x83126e978d4fdf3bull, 0x645a1cac083126eaull,
+	0xa3d70a3d70a3d70aull, 0x3d70a3d70a3d70a4ull,
+	0xccccccccccccccccull, 0xcccccccccccccccdull,
+	0x8000000000000000ull, 0x0000000000000000ull,
+	0xa000000000000000ull, 0x0000000000000000ull,
+	0xc800000000000000ull, 0x0000000000000000ull,
+	0xfa00000000000000ull, 0x0000000000000000ull,
+	0x9c40000000000000ull, 0x0000000000000000ull,
+	0xc350000000000000ull, 0x0000000000000000ull,
+	0xf424000000000000ull, 0x0000000000000000ull,
+	0x9896800000000000ull, 0x0000000000000000ull,
+	0xbebc200000000000ull, 0x0000000000000000ull,
+	0xee6b280000000000ull, 0x0000000000000000ull,
+	0x9502f90000000000ull, 0x0000000000000000ull,
+	0xba43b74000000000ull, 0x0000000000000000ull,
+	0xe8d4a51000000000ull, 0x0000000000000000ull,
+	0x9184e72a00000000ull, 0x0000000000000000ull,
+	0xb5e620f480000000ull, 0x0000000000000000ull,
+	0xe35fa931a0000000ull, 0x0000000000000000ull,
+	0x8e1bc9bf04000000ull, 0x0000000000000000ull,
+	0xb1a2bc2ec5000000ull, 0x0000000000000000ull,
+	0xde0b6b3a76400000ull, 0x0000000000000000ull,
+	0x8ac7230489e80000ull, 0x0000000000000000ull,
+	0xad78ebc5ac620000ull, 0x0000000000000000ull,
+	0xd8d726b7177a8000ull, 0x0000000000000000ull,
+	0x878678326eac9000ull, 0x0000000000000000ull,
+	0xa968163f0a57b400ull, 0x0000000000000000ull,
+	0xd3c21bcecceda100ull, 0x0000000000000000ull,
+	0x84595161401484a0ull, 0x0000000000000000ull,
+	0xa56fa5b99019a5c8ull, 0x0000000000000000ull,
+	0xcecb8f27f4200f3aull, 0x0000000000000000ull,
+	0x813f3978f8940984ull, 0x4000000000000000ull,
+	0xa18f07d736b90be5ull, 0x5000000000000000ull,
+	0xc9f2c9cd04674edeull, 0xa400000000000000ull,
+	0xfc6f7c4045812296ull, 0x4d00000000000000ull,
+	0x9dc5ada82b70b59dull, 0xf020000000000000ull,
+	0xc5371912364ce305ull, 0x6c28000000000000ull,
+	0xf684df56c3e01bc6ull, 0xc732000000000000ull,
+	0x9a130b963a6c115cull, 0x3c7f400000000000ull,
+	0xc097ce7bc90715b3ull, 0x4b9f100000000000ull,
+	0xf0bdc21abb48db20ull, 0x1e86d40000000000ull,
+	0x96769950b50d88f4ull, 0x1314448000000000ull,
+	0xbc143fa4e250eb31ull, 0x17d955a000000000ull,
+	0xeb194f8e1ae525fdull, 0x5dcfab0800000000ull,
+	0x92efd1b8d0cf37beull, 0x5aa1cae500000000ull,
+	0xb7abc627050305adull, 0xf14a3d9e40000000ull,
+	0xe596b7b0c643c719ull, 0x6d9ccd05d0000000ull,
+	0x8f7e32ce7bea5c6full, 0xe4820023a2000000ull,
+	0xb35dbf821ae4f38bull, 0xdda2802c8a800000ull,
+	0xe0352f62a19e306eull, 0xd50b2037ad200000ull,
+	0x8c213d9da502de45ull, 0x4526f422cc340000ull,
+	0xaf298d050e4395d6ull, 0x9670b12b7f410000ull,
+	0xdaf3f04651d47b4cull, 0x3c0cdd765f114000ull,
+	0x88d8762bf324cd0full, 0xa5880a69fb6ac800ull,
+	0xab0e93b6efee0053ull, 0x8eea0d047a457a00ull,
+	0xd5d238a4abe98068ull, 0x72a4904598d6d880ull,
+	0x85a36366eb71f041ull, 0x47a6da2b7f864750ull,
+	0xa70c3c40a64e6c51ull, 0x999090b65f67d924ull,
+	0xd0cf4b50cfe20765ull, 0xfff4b4e3f741cf6dull,
+	0x82818f1281ed449full, 0xbff8f10e7a8921a4ull,
+	0xa321f2d7226895c7ull, 0xaff72d52192b6a0dull,
+	0xcbea6f8ceb02bb39ull, 0x9bf4f8a69f764490ull,
+	0xfee50b7025c36a08ull, 0x02f236d04753d5b4ull,
+	0x9f4f2726179a2245ull, 0x01d762422c946590ull,
+	0xc722f0ef9d80aad6ull, 0x424d3ad2b7b97ef5ull,
+	0xf8ebad2b84e0d58bull, 0xd2e0898765a7deb2ull,
+	0x9b934c3b330c8577ull, 0x63cc55f49f88eb2full,
+	0xc2781f49ffcfa6d5ull, 0x3cbf6b71c76b25fbull,
+	0xf316271c7fc3908aull, 0x8bef464e3945ef7aull,
+	0x97edd871cfda3a56ull, 0x97758bf0e3cbb5acull,
+	0xbde94e8e43d0c8ecull, 0x3d52eeed1cbea317ull,
+	0xed63a231d4c4fb27ull, 0x4ca7aaa863ee4bddull,
+	0x945e455f24fb1cf8ull, 0x8fe8caa93e74ef6aull,
+	0xb975d6b6ee39e436ull, 0xb3e2fd538e122b44ull,
+	0xe7d34c64a9c85d44ull, 0x60dbbca87196b616ull,
+	0x90e40fbeea1d3a4aull, 0xbc8955e946fe31cdull,
+	0xb51d13aea4a488ddull, 0x6babab6398bdbe41ull,
+	0xe264589a4dcdab14ull, 0xc696963c7eed2dd1ull,
+	0x8d7eb76070a08aecull, 0xfc1e1de5cf543ca2ull,
+	0xb0de65388cc8ada8ull, 0x3b25a55f43294bcbull,
+	0xdd15fe86affad912ull, 0x49ef0eb713f39ebeull,
+	0x8a2dbf142dfcc7abull, 0x6e3569326c784337ull,
+	0xacb92ed9397bf996ull, 0x49c2c37f07965404ull,
+	0xd7e77a8f87daf7fbull, 0xdc33745ec97be906ull,
+	0x86f0ac99b4e8dafdull, 0x69a028bb3ded71a3ull,
+	0xa8acd7c0222311bcull, 0xc40832ea0d68ce0cull,
+	0xd2d80db02aabd62bull, 0xf50a3fa490c30190ull,
+	0x83c7088e1aab65dbull, 0x792667c6da79e0faull,
+	0xa4b8cab1a1563f52ull, 0x577001b891185938ull,
+	0xcde6fd5e09abcf26ull, 0xed4c0226b55e6f86ull,
+	0x80b05e5ac60b6178ull, 0x544f8158315b05b4ull,
+	0xa0dc75f1778e39d6ull, 0x696361ae3db1c721ull,
+	0xc913936dd571c84cull, 0x03bc3a19cd1e38e9ull,
+	0xfb5878494ace3a5full, 0x04ab48a04065c723ull,
+	0x9d174b2dcec0e47bull, 0x62eb0d64283f9c76ull,
+	0xc45d1df942711d9aull, 0x3ba5d0bd324f8394ull,
+	0xf5746577930d6500ull, 0xca8f44ec7ee36479ull,
+	0x9968bf6abbe85f20ull, 0x7e998b13cf4e1ecbull,
+	0xbfc2ef456ae276e8ull, 0x9e3fedd8c321a67eull,
+	0xefb3ab16c59b14a2ull, 0xc5cfe94ef3ea101eull,
+	0x95d04aee3b80ece5ull, 0xbba1f1d158724a12ull,
+	0xbb445da9ca61281full, 0x2a8a6e45ae8edc97ull,
+	0xea1575143cf97226ull, 0xf52d09d71a3293bdull,
+	0x924d692ca61be758ull, 0x593c2626705f9c56ull,
+	0xb6e0c377cfa2e12eull, 0x6f8b2fb00c77836cull,
+	0xe498f455c38b997aull, 0x0b6dfb9c0f956447ull,
+	0x8edf98b59a373fecull, 0x4724bd4189bd5eacull,
+	0xb2977ee300c50fe7ull, 0x58edec91ec2cb657ull,
+	0xdf3d5e9bc0f653e1ull, 0x2f2967b66737e3edull,
+	0x8b865b215899f46cull, 0xbd79e0d20082ee74ull,
+	0xae67f1e9aec07187ull, 0xecd8590680a3aa11ull,
+	0xda01ee641a708de9ull, 0xe80e6f4820cc9495ull,
+	0x884134fe908658b2ull, 0x3109058d147fdcddull,
+	0xaa51823e34a7eedeull, 0xbd4b46f0599fd415ull,
+	0xd4e5e2cdc1d1ea96ull, 0x6c9e18ac7007c91aull,
+	0x850fadc09923329eull, 0x03e2cf6bc604ddb0ull,
+	0xa6539930bf6bff45ull, 0x84db8346b786151cull,
+	0xcfe87f7cef46ff16ull, 0xe612641865679a63ull,
+	0x81f14fae158c5f6eull, 0x4fcb7e8f3f60c07eull,
+	0xa26da3999aef7749ull, 0xe3be5e330f38f09dull,
+	0xcb090c8001ab551cull, 0x5cadf5bfd3072cc5ull,
+	0xfdcb4fa002162a63ull, 0x73d9732fc7c8f7f6ull,
+	0x9e9f11c4014dda7eull, 0x2867e7fddcdd9afaull,
+	0xc646d63501a1511dull, 0xb281e1fd541501b8ull,
+	0xf7d88bc24209a565ull, 0x1f225a7ca91a4226ull,
+	0x9ae757596946075full, 0x3375788de9b06958ull,
+	0xc1a12d2fc3978937ull, 0x0052d6b1641c83aeull,
+	0xf209787bb47d6b84ull, 0xc0678c5dbd23a49aull,
+	0x9745eb4d50ce6332ull, 0xf840b7ba963646e0ull,
+	0xbd176620a501fbffull, 0xb650e5a93bc3d898ull,
+	0xec5d3fa8ce427affull, 0xa3e51f138ab4cebeull,
+	0x93ba47c980e98cdfull, 0xc66f336c36b10137ull,
+	0xb8a8d9bbe123f017ull, 0xb80b0047445d4184ull,
+	0xe6d3102ad96cec1dull, 0xa60dc059157491e5ull,
+	0x9043ea1ac7e41392ull, 0x87c89837ad68db2full,
+	0xb454e4a179dd1877ull, 0x29babe4598c311fbull,
+	0xe16a1dc9d8545e94ull, 0xf4296dd6fef3d67aull,
+	0x8ce2529e2734bb1dull, 0x1899e4a65f58660cull,
+	0xb01ae745b101e9e4ull, 0x5ec05dcff72e7f8full,
+	0xdc21a1171d42645dull, 0x76707543f4fa1f73ull,
+	0x899504ae72497ebaull, 0x6a06494a791c53a8ull,
+	0xabfa45da0edbde69ull, 0x0487db9d17636892ull,
+	0xd6f8d7509292d603ull, 0x45a9d2845d3c42b6ull,
+	0x865b86925b9bc5c2ull, 0x0b8a2392ba45a9b2ull,
+	0xa7f26836f282b732ull, 0x8e6cac7768d7141eull,
+	0xd1ef0244af2364ffull, 0x3207d795430cd926ull,
+	0x8335616aed761f1full, 0x7f44e6bd49e807b8ull,
+	0xa402b9c5a8d3a6e7ull, 0x5f16206c9c6209a6ull,
+	0xcd036837130890a1ull, 0x36dba887c37a8c0full,
+	0x802221226be55a64ull, 0xc2494954da2c9789ull,
+	0xa02aa96b06deb0fdull, 0xf2db9baa10b7bd6cull,
+	0xc83553c5c8965d3dull, 0x6f92829494e5acc7ull,
+	0xfa42a8b73abbf48cull, 0xcb772339ba1f17f9ull,
+	0x9c69a97284b578d7ull, 0xff2a760414536efbull,
+	0xc38413cf25e2d70dull, 0xfef5138519684abaull,
+	0xf46518c2ef5b8cd1ull, 0x7eb258665fc25d69ull,
+	0x98bf2f79d5993802ull, 0xef2f773ffbd97a61ull,
+	0xbeeefb584aff8603ull, 0xaafb550ffacfd8faull,
+	0xeeaaba2e5dbf6784ull, 0x95ba2a53f983cf38ull,
+	0x952ab45cfa97a0b2ull, 0xdd945a747bf26183ull,
+	0xba756174393d88dfull, 0x94f971119aeef9e4ull,
+	0xe912b9d1478ceb17ull, 0x7a37cd5601aab85dull,
+	0x91abb422ccb812eeull, 0xac62e055c10ab33aull,
+	0xb616a12b7fe617aaull, 0x577b986b314d6009ull,
+	0xe39c49765fdf9d94ull, 0xed5a7e85fda0b80bull,
+	0x8e41ade9fbebc27dull, 0x14588f13be847307ull,
+	0xb1d219647ae6b31cull, 0x596eb2d8ae258fc8ull,
+	0xde469fbd99a05fe3ull, 0x6fca5f8ed9aef3bbull,
+	0x8aec23d680043beeull, 0x25de7bb9480d5854ull,
+	0xada72ccc20054ae9ull, 0xaf561aa79a10ae6aull,
+	0xd910f7ff28069da4ull, 0x1b2ba1518094da04ull,
+	0x87aa9aff79042286ull, 0x90fb44d2f05d0842ull,
+	0xa99541bf57452b28ull, 0x353a1607ac744a53ull,
+	0xd3fa922f2d1675f2ull, 0x42889b8997915ce8ull,
+	0x847c9b5d7c2e09b7ull, 0x69956135febada11ull,
+	0xa59bc234db398c25ull, 0x43fab9837e699095ull,
+	0xcf02b2c21207ef2eull, 0x94f967e45e03f4bbull,
+	0x8161afb94b44f57dull, 0x1d1be0eebac278f5ull,
+	0xa1ba1ba79e1632dcull, 0x6462d92a69731732ull,
+	0xca28a291859bbf93ull, 0x7d7b8f7503cfdcfeull,
+	0xfcb2cb35e702af78ull, 0x5cda735244c3d43eull,
+	0x9defbf01b061adabull, 0x3a0888136afa64a7ull,
+	0xc56baec21c7a1916ull, 0x088aaa1845b8fdd0ull,
+	0xf6c69a72a3989f5bull, 0x8aad549e57273d45ull,
+	0x9a3c2087a63f6399ull, 0x36ac54e2f678864bull,
+	0xc0cb28a98fcf3c7full, 0x84576a1bb416a7ddull,
+	0xf0fdf2d3f3c30b9full, 0x656d44a2a11c51d5ull,
+	0x969eb7c47859e743ull, 0x9f644ae5a4b1b325ull,
+	0xbc4665b596706114ull, 0x873d5d9f0dde1feeull,
+	0xeb57ff22fc0c7959ull, 0xa90cb506d155a7eaull,
+	0x9316ff75dd87cbd8ull, 0x09a7f12442d588f2ull,
+	0xb7dcbf5354e9beceull, 0x0c11ed6d538aeb2full,
+	0xe5d3ef282a242e81ull, 0x8f1668c8a86da5faull,
+	0x8fa475791a569d10ull, 0xf96e017d694487bcull,
+	0xb38d92d760ec4455ull, 0x37c981dcc395a9acull,
+	0xe070f78d3927556aull, 0x85bbe253f47b1417ull,
+	0x8c469ab843b89562ull, 0x93956d7478ccec8eull,
+	0xaf58416654a6babbull, 0x387ac8d1970027b2ull,
+	0xdb2e51bfe9d0696aull, 0x06997b05fcc0319eull,
+	0x88fcf317f22241e2ull, 0x441fece3bdf81f03ull,
+	0xab3c2fddeeaad25aull, 0xd527e81cad7626c3ull,
+	0xd60b3bd56a5586f1ull, 0x8a71e223d8d3b074ull,
+	0x85c7056562757456ull, 0xf6872d5667844e49ull,
+	0xa738c6bebb12d16cull, 0xb428f8ac016561dbull,
+	0xd106f86e69d785c7ull, 0xe13336d701beba52ull,
+	0x82a45b450226b39cull, 0xecc0024661173473ull,
+	0xa34d721642b06084ull, 0x27f002d7f95d0190ull,
+	0xcc20ce9bd35c78a5ull, 0x31ec038df7b441f4ull,
+	0xff290242c83396ceull, 0x7e67047175a15271ull,
+	0x9f79a169bd203e41ull, 0x0f0062c6e984d386ull,
+	0xc75809c42c684dd1ull, 0x52c07b78a3e60868ull,
+	0xf92e0c3537826145ull, 0xa7709a56ccdf8a82ull,
+	0x9bbcc7a142b17ccbull, 0x88a66076400bb691ull,
+	0xc2abf989935ddbfeull, 0x6acff893d00ea435ull,
+	0xf356f7ebf83552feull, 0x0583f6b8c4124d43ull,
+	0x98165af37b2153deull, 0xc3727a337a8b704aull,
+	0xbe1bf1b059e9a8d6ull, 0x744f18c0592e4c5cull,
+	0xeda2ee1c7064130cull, 0x1162def06f79df73ull,
+	0x9485d4d1c63e8be7ull, 0x8addcb5645ac2ba8ull,
+	0xb9a74a0637ce2ee1ull, 0x6d953e2bd7173692ull,
+	0xe8111c87c5c1ba99ull, 0xc8fa8db6ccdd0437ull,
+	0x910ab1d4db9914a0ull, 0x1d9c9892400a22a2ull,
+	0xb54d5e4a127f59c8ull, 0x2503beb6d00cab4bull,
+	0xe2a0b5dc971f303aull, 0x2e44ae64840fd61dull,
+	0x8da471a9de737e24ull, 0x5ceaecfed289e5d2ull,
+	0xb10d8e1456105dadull, 0x7425a83e872c5f47ull,
+	0xdd50f1996b947518ull, 0xd12f124e28f77719ull,
+	0x8a5296ffe33cc92full, 0x82bd6b70d99aaa6full,
+	0xace73cbfdc0bfb7bull, 0x636cc64d1001550bull,
+	0xd8210befd30efa5aull, 0x3c47f7e05401aa4eull,
+	0x8714a775e3e95c78ull, 0x65acfaec34810a71ull,
+	0xa8d9d1535ce3b396ull, 0x7f1839a741a14d0dull,
+	0xd31045a8341ca07cull, 0x1ede48111209a050ull,
+	0x83ea2b892091e44dull, 0x934aed0aab460432ull,
+	0xa4e4b66b68b65d60ull, 0xf81da84d5617853full,
+	0xce1de40642e3f4b9ull, 0x36251260ab9d668eull,
+	0x80d2ae83e9ce78f3ull, 0xc1d72b7c6b426019ull,
+	0xa1075a24e4421730ull, 0xb24cf65b8612f81full,
+	0xc94930ae1d529cfcull, 0xdee033f26797b627ull,
+	0xfb9b7cd9a4a7443cull, 0x169840ef017da3b1ull,
+	0x9d412e0806e88aa5ull, 0x8e1f289560ee864eull,
+	0xc491798a08a2ad4eull, 0xf1a6f2bab92a27e2ull,
+	0xf5b5d7ec8acb58a2ull, 0xae10af696774b1dbull,
+	0x9991a6f3d6bf1765ull, 0xacca6da1e0a8ef29ull,
+	0xbff610b0cc6edd3full, 0x17fd090a58d32af3ull,
+	0xeff394dcff8a948eull, 0xddfc4b4cef07f5b0ull,
+	0x95f83d0a1fb69cd9ull, 0x4abdaf101564f98eull,
+	0xbb764c4ca7a4440full, 0x9d6d1ad41abe37f1ull,
+	0xea53df5fd18d5513ull, 0x84c86189216dc5edull,
+	0x92746b9be2f8552cull, 0x32fd3cf5b4e49bb4ull,
+	0xb7118682dbb66a77ull, 0x3fbc8c33221dc2a1ull,
+	0xe4d5e82392a40515ull, 0x0fabaf3feaa5334aull,
+	0x8f05b1163ba6832dull, 0x29cb4d87f2a7400eull,
+	0xb2c71d5bca9023f8ull, 0x743e20e9ef511012ull,
+	0xdf78e4b2bd342cf6ull, 0x914da9246b255416ull,
+	0x8bab8eefb6409c1aull, 0x1ad089b6c2f7548eull,
+	0xae9672aba3d0c320ull, 0xa184ac2473b529b1ull,
+	0xda3c0f568cc4f3e8ull, 0xc9e5d72d90a2741eull,
+	0x8865899617fb1871ull, 0x7e2fa67c7a658892ull,
+	0xaa7eebfb9df9de8dull, 0xddbb901b98feeab7ull,
+	0xd51ea6fa85785631ull, 0x552a74227f3ea565ull,
+	0x8533285c936b35deull, 0xd53a88958f87275full,
+	0xa67ff273b8460356ull, 0x8a892abaf368f137ull,
+	0xd01fef10a657842cull, 0x2d2b7569b0432d85ull,
+	0x8213f56a67f6b29bull, 0x9c3b29620e29fc73ull,
+	0xa298f2c501f45f42ull, 0x8349f3ba91b47b8full,
+	0xcb3f2f7642717713ull, 0x241c70a936219a73ull,
+	0xfe0efb53d30dd4d7ull, 0xed238cd383aa0110ull,
+	0x9ec95d1463e8a506ull, 0xf4363804324a40aaull,
+	0xc67bb4597ce2ce48ull, 0xb143c6053edcd0d5ull,
+	0xf81aa16fdc1b81daull, 0xdd94b7868e94050aull,
+	0x9b10a4e5e9913128ull, 0xca7cf2b4191c8326ull,
+	0xc1d4ce1f63f57d72ull, 0xfd1c2f611f63a3f0ull,
+	0xf24a01a73cf2dccfull, 0xbc633b39673c8cecull,
+	0x976e41088617ca01ull, 0xd5be0503e085d813ull,
+	0xbd49d14aa79dbc82ull, 0x4b2d8644d8a74e18ull,
+	0xec9c459d51852ba2ull, 0xddf8e7d60ed1219eull,
+	0x93e1ab8252f33b45ull, 0xcabb90e5c942b503ull,
+	0xb8da1662e7b00a17ull, 0x3d6a751f3b936243ull,
+	0xe7109bfba19c0c9dull, 0x0cc512670a783ad4ull,
+	0x906a617d450187e2ull, 0x27fb2b80668b24c5ull,
+	0xb484f9dc9641e9daull, 0xb1f9f660802dedf6ull,
+	0xe1a63853bbd26451ull, 0x5e7873f8a0396973ull,
+	0x8d07e33455637eb2ull, 0xdb0b487b6423e1e8ull,
+	0xb049dc016abc5e5full, 0x91ce1a9a3d2cda62ull,
+	0xdc5c5301c56b75f7ull, 0x7641a140cc7810fbull,
+	0x89b9b3e11b6329baull, 0xa9e904c87fcb0a9dull,
+	0xac2820d9623bf429ull, 0x546345fa9fbdcd44ull,
+	0xd732290fbacaf133ull, 0xa97c177947ad4095ull,
+	0x867f59a9d4bed6c0ull, 0x49ed8eabcccc485dull,
+	0xa81f301449ee8c70ull, 0x5c68f256bfff5a74ull,
+	0xd226fc195c6a2f8cull, 0x73832eec6fff3111ull,
+	0x83585d8fd9c25db7ull, 0xc831fd53c5ff7eabull,
+	0xa42e74f3d032f525ull, 0xba3e7ca8b77f5e55ull,
+	0xcd3a1230c43fb26full, 0x28ce1bd2e55f35ebull,
+	0x80444b5e7aa7cf85ull, 0x7980d163cf5b81b3ull,
+	0xa0555e361951c366ull, 0xd7e105bcc332621full,
+	0xc86ab5c39fa63440ull, 0x8dd9472bf3fefaa7ull,
+	0xfa856334878fc150ull, 0xb14f98f6f0feb951ull,
+	0x9c935e00d4b9d8d2ull, 0x6ed1bf9a569f33d3ull,
+	0xc3b8358109e84f07ull, 0x0a862f80ec4700c8ull,
+	0xf4a642e14c6262c8ull, 0xcd27bb612758c0faull,
+	0x98e7e9cccfbd7dbdull, 0x8038d51cb897789cull,
+	0xbf21e44003acdd2cull, 0xe0470a63e6bd56c3ull,
+	0xeeea5d5004981478ull, 0x1858ccfce06cac74ull,
+	0x95527a5202df0ccbull, 0x0f37801e0c43ebc8ull,
+	0xbaa718e68396cffdull, 0xd30560258f54e6baull,
+	0xe950df20247c83fdull, 0x47c6b82ef32a2069ull,
+	0x91d28b7416cdd27eull, 0x4cdc331d57fa5441ull,
+	0xb6472e511c81471dull, 0xe0133fe4adf8e952ull,
+	0xe3d8f9e563a198e5ull, 0x58180fddd97723a6ull,
+	0x8e679c2f5e44ff8full, 0x570f09eaa7ea7648ull
+};
+static const int POWERS_OF_FIVE_MIN_EXP = -342;
+
+// 5^0..5^13 mieszczą się w uint32
+static const uint32 POWERS_OF_FIVE_32[] = {
+	1u, 5u, 25u, 125u, 625u, 3125u, 15625u, 78125u, 390625u, 1953125u, 9765625u, 48828125u, 244140625u, 1220703125u,
+};
+
+// Parametry formatu IEEE 754
+struct FLOAT_FORMAT
+{
+	int MantissaBits;       // Jawne bity mantysy
+	int MinExponent;        // -bias
+	int InfinitePower;      // Pole wykładnika dla nieskończoności
+	int SignBit;
+	int MinRoundToEven, MaxRoundToEven; // Zakres q, w którym iloczyn może być dokładnie w połowie
+	int SmallestPowerOfTen, LargestPowerOfTen; // Poza tym zakresem wynik to 0 lub nieskończoność
+};
+
+static const FLOAT_FORMAT DOUBLE_FORMAT = { 52, -1023, 0x7FF, 63,  -4, 23, -342, 308 };
+static const FLOAT_FORMAT SINGLE_FORMAT = { 23,  -127,  0xFF, 31, -17, 10,  -65,  38 };
+
+// Wynik a*b jako 128 bitów
+inline void Multiply64(uint64 *Hi, uint64 *Lo, uint64 a, uint64 b)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+	*Lo = _umul128(a, b, Hi);
+#elif defined(__SIZEOF_INT128__)
+	unsigned __int128 r = (unsigned __int128)a * b;
+	*Hi = (uint64)(r >> 64);
+	*Lo = (uint64)r;
+#else
+	uint64 aLo = a & 0xFFFFFFFFull, aHi = a >> 32;
+	uint64 bLo = b & 0xFFFFFFFFull, bHi = b >> 32;
+	uint64 LL = aLo * bLo, LH = aLo * bHi, HL = aHi * bLo, HH = aHi * bHi;
+	uint64 Mid = (LL >> 32) + (LH & 0xFFFFFFFFull) + (HL & 0xFFFFFFFFull);
+	*Lo = (Mid << 32) | (LL & 0xFFFFFFFFull);
+	*Hi = HH + (LH >> 32) + (HL >> 32) + (Mid >> 32);
+#endif
+}
+
+inline bool IsDecimalDigit(tchar ch)
+{
+	return ch >= _T('0') && ch <= _T('9');
+}
+
+#ifndef _UNICODE
+
+// 8 znaków jako liczba, pierwszy znak w najmłodszym bajcie - niezależnie od platformy.
+inline uint64 LoadEightChars(const char *p)
+{
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__) || \
+	(defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+	uint64 v;
+	memcpy(&v, p, sizeof(v));
+	return v;
+#else
+	uint64 v = 0;
+	for (uint i = 0; i < 8; i++)
+		v |= (uint64)(uint8)p[i] << (i * 8);
+	return v;
+#endif
+}
+
+// Czy wszystkie 8 znaków to cyfry '0'..'9' (SWAR)
+inline bool IsEightDigits(uint64 v)
+{
+	return ( (v & 0xF0F0F0F0F0F0F0F0ull) |
+		(((v + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4) ) == 0x3333333333333333ull;
+}
+
+// Wartość 8 cyfr dziesiętnych - trzy mnożenia zamiast ośmiu
+inline uint32 EightDigitsValue(uint64 v)
+{
+	const uint64 Mask = 0x000000FF000000FFull;
+	const uint64 Mul1 = 0x000F424000000064ull; // 100 + (1000000 << 32)
+	const uint64 Mul2 = 0x0000271000000001ull; // 1 + (10000 << 32)
+	v -= 0x3030303030303030ull;
+	v = (v * 10) + (v >> 8);
+	v = (((v & Mask) * Mul1) + (((v >> 16) & Mask) * Mul2)) >> 32;
+	return (uint32)v;
+}
+
+#endif // #ifndef _UNICODE
+
+const tchar * _ParseDecimalDigits(uint64 *Value, bool *Overflow, const tchar *p, const tchar *End)
+{
+	uint64 v = 0;
+	bool Over = false;
+#ifndef _UNICODE
+	// Dopóki v < 10^11, dopisanie 8 cyfr na pewno nie przepełni
+	while (End - p >= 8 && v < 100000000000ull)
+	{
+		uint64 Chars = LoadEightChars(p);
+		if (!IsEightDigits(Chars))
+			break;
+		v = v * 100000000ull + EightDigitsValue(Chars);
+		p += 8;
+	}
+#endif
+	for (; p != End && IsDecimalDigit(*p); ++p)
+	{
+		uint64 Digit = (uint64)(*p - _T('0'));
+		if (!Over)
+		{
+			if (v > (0xFFFFFFFFFFFFFFFFull - Digit) / 10)
+				Over = true;
+			else
+				v = v * 10 + Digit;
+		}
+	}
+	*Value = v;
+	*Overflow = Over;
+	return p;
+}
+
+// Eisel-Lemire: w * 10^q jako mantysa i pole wykładnika.
+// Zwraca false, jeśli wynik może być błędny o 1 ulp - wtedy jest tylko przybliżeniem.
+static bool EiselLemire(uint64 *OutMantissa, int *OutPower2, uint64 w, int64 q, const FLOAT_FORMAT &F)
+{
+	if (w == 0 || q < F.SmallestPowerOfTen)
+	{
+		*OutMantissa = 0; *OutPower2 = 0;
+		return true;
+	}
+	if (q > F.LargestPowerOfTen)
+	{
+		*OutMantissa = 0; *OutPower2 = F.InfinitePower;
+		return true;
+	}
+
+	int lz = CountLeadingZeros64(w);
+	w <<= lz;
+
+	// Wystarczająco dokładny iloczyn w * 5^q - drugie mnożenie tylko gdy bity poniżej mantysy są same jedynki
+	const uint64 *Power = &POWERS_OF_FIVE_128[(size_t)(q - POWERS_OF_FIVE_MIN_EXP) * 2];
+	uint64 Hi, Lo;
+	Multiply64(&Hi, &Lo, w, Power[0]);
+	uint64 PrecisionMask = 0xFFFFFFFFFFFFFFFFull >> (F.MantissaBits + 3);
+	if ((Hi & PrecisionMask) == PrecisionMask)
+	{
+		uint64 Hi2, Lo2;
+		Multiply64(&Hi2, &Lo2, w, Power[1]);
+		Lo += Hi2;
+		if (Hi2 > Lo)
+			Hi++;
+	}
+	bool Exact = !(Lo == 0xFFFFFFFFFFFFFFFFull && (q < -27 || q > 55));
+
+	int UpperBit = (int)(Hi >> 63);
+	int Shift = UpperBit + 64 - F.MantissaBits - 3;
+	uint64 Mantissa = Hi >> Shift;
+	int Power2 = (int)((((152170 + 65536) * (int)q) >> 16) + 63) + UpperBit - lz - F.MinExponent;
+
+	if (Power2 <= 0)
+	{
+		// Liczba zdenormalizowana
+		if (-Power2 + 1 >= 64)
+		{
+			*OutMantissa = 0; *OutPower2 = 0;
+			return Exact;
+		}
+		Mantissa >>= -Power2 + 1;
+		Mantissa += (Mantissa & 1);
+		Mantissa >>= 1;
+		*OutMantissa = Mantissa & ~(1ull << F.MantissaBits);
+		*OutPower2 = (Mantissa < (1ull << F.MantissaBits)) ? 0 : 1;
+		return Exact;
+	}
+
+	// Dokładnie w połowie - remis do parzystej
+	if (Lo <= 1 && q >= F.MinRoundToEven && q <= F.MaxRoundToEven && (Mantissa & 3) == 1)
+	{
+		if ((Mantissa << Shift) == Hi)
+			Mantissa &= ~1ull;
+	}
+	Mantissa += (Mantissa & 1);
+	Mantissa >>= 1;
+	if (Mantissa >= (2ull << F.MantissaBits))
+	{
+		Mantissa = 1ull << F.MantissaBits;
+		Power2++;
+	}
+	Mantissa &= ~(1ull << F.MantissaBits);
+	if (Power2 >= F.InfinitePower)
+	{
+		Power2 = F.InfinitePower;
+		Mantissa = 0;
+	}
+	*OutMantissa = Mantissa;
+	*OutPower2 = Power2;
+	return Exact;
+}
+
+// Duża liczba całkowita o stałym rozmiarze, na stosie - tylko do rozstrzygania trudnych przypadków.
+// Wystarcza na MAX_FALLBACK_DIGITS cyfr razy potęgi 5 i 2 potrzebne do porównania.
+struct BIG_NUMBER
+{
+	static const uint MAX_LIMBS = 256;
+	uint32 Limbs[MAX_LIMBS]; // Od najmłodszego
+	uint Count;
+
+	BIG_NUMBER() : Count(0) { }
+	void Set(uint64 v)
+	{
+		Count = 0;
+		for (; v != 0; v >>= 32)
+			Limbs[Count++] = (uint32)v;
+	}
+	// this = this * Mul + Add
+	void MulAdd(uint32 Mul, uint32 Add)
+	{
+		uint64 Carry = Add;
+		for (uint i = 0; i < Count; i++)
+		{
+			uint64 t = (uint64)Limbs[i] * Mul + Carry;
+			Limbs[i] = (uint32)t;
+			Carry = t >> 32;
+		}
+		if (Carry != 0)
+		{
+			assert(Count < MAX_LIMBS);
+			if (Count < MAX_LIMBS)
+				Limbs[Count++] = (uint32)Carry;
+		}
+	}
+	void MulPow5(int64 e)
+	{
+		for (; e >= 13; e -= 13)
+			MulAdd(POWERS_OF_FIVE_32[13], 0);
+		if (e > 0)
+			MulAdd(POWERS_OF_FIVE_32[e], 0);
+	}
+	void ShiftLeft(int64 Bits)
+	{
+		if (Count == 0 || Bits == 0)
+			return;
+		uint Words = (uint)(Bits / 32), Rem = (uint)(Bits % 32);
+		assert(Count + Words + 1 <= MAX_LIMBS);
+		if (Count + Words + 1 > MAX_LIMBS)
+			return;
+		if (Rem != 0)
+		{
+			uint32 Carry = 0;
+			for (uint i = 0; i < Count; i++)
+			{
+				uint32 v = Limbs[i];
+				Limbs[i] = (v << Rem) | Carry;
+				Carry = v >> (32 - Rem);
+			}
+			if (Carry != 0)
+				Limbs[Count++] = Carry;
+		}
+		if (Words != 0)
+		{
+			memmove(&Limbs[Words], &Limbs[0], Count * sizeof(uint32));
+			memset(&Limbs[0], 0, Words * sizeof(uint32));
+			Count += Words;
+		}
+	}
+	uint BitLength() const
+	{
+		if (Count == 0)
+			return 0;
+		return Count * 32 - (uint)CountLeadingZeros64(Limbs[Count - 1]) + 32;
+	}
+	// Usuwa zerowe najstarsze słowa
+	void Normalize()
+	{
+		while (Count > 0 && Limbs[Count - 1] == 0)
+			Count--;
+	}
+	// this -= b, gdzie this >= b
+	void Sub(const BIG_NUMBER &b)
+	{
+		uint32 Borrow = 0;
+		for (uint i = 0; i < Count; i++)
+		{
+			uint64 Sub = (uint64)(i < b.Count ? b.Limbs[i] : 0) + Borrow;
+			Borrow = (uint64)Limbs[i] < Sub ? 1 : 0;
+			Limbs[i] = (uint32)((uint64)Limbs[i] - Sub);
+		}
+		Normalize();
+	}
+	void ShiftRight1()
+	{
+		for (uint i = 0; i < Count; i++)
+			Limbs[i] = (Limbs[i] >> 1) | (i + 1 < Count ? (Limbs[i + 1] << 31) : 0);
+		Normalize();
+	}
+	// this /= Div, zwraca resztę
+	uint32 DivSmall(uint32 Div)
+	{
+		uint64 Rem = 0;
+		for (uint i = Count; i-- > 0; )
+		{
+			uint64 Cur = (Rem << 32) | Limbs[i];
+			Limbs[i] = (uint32)(Cur / Div);
+			Rem = Cur % Div;
+		}
+		Normalize();
+		return (uint32)Rem;
+	}
+	static int Compare(const BIG_NUMBER &a, const BIG_NUMBER &b)
+	{
+		if (a.Count != b.Count)
+			return a.Count < b.Count ? -1 : 1;
+		for (uint i = a.Count; i-- > 0; )
+		{
+			if (a.Limbs[i] != b.Limbs[i])
+				return a.Limbs[i] < b.Limbs[i] ? -1 : 1;
+		}
+		return 0;
+	}
+};
+
+// Więcej cyfr nie ma znaczenia - punkt w połowie między dwoma double ma najwyżej 767 cyfr znaczących.
+// Dalsze cyfry zastępuje jedna niezerowa cyfra "sticky".
+static const uint MAX_FALLBACK_DIGITS = 780;
+
+// Rozpoznana składnia liczby
+struct DECIMAL_STRING
+{
+	bool Negative;
+	uint64 Mantissa;  // Do 19 pierwszych cyfr znaczących
+	int64 Exponent;   // Wykładnik dziesiętny dla Mantissa
+	bool Truncated;   // Odrzucone cyfry nie były same zera
+	const tchar *IntBegin, *IntEnd, *FracBegin, *FracEnd;
+	int64 ExplicitExponent;
+};
+
+static void AccumulateDigits(DECIMAL_STRING *Dec, uint *SigDigits, const tchar *p, const tchar *End, bool Fraction)
+{
+	if (*SigDigits == 0)
+	{
+		for (; p != End && *p == _T('0'); ++p)
+		{
+			if (Fraction)
+				Dec->Exponent--;
+		}
+	}
+#ifndef _UNICODE
+	// Składnia jest już sprawdzona - same cyfry
+	for (; End - p >= 8 && *SigDigits <= 19 - 8; p += 8)
+	{
+		Dec->Mantissa = Dec->Mantissa * 100000000ull + EightDigitsValue(LoadEightChars(p));
+		*SigDigits += 8;
+		if (Fraction)
+			Dec->Exponent -= 8;
+	}
+#endif
+	for (; p != End; ++p)
+	{
+		uint Digit = (uint)(*p - _T('0'));
+		if (*SigDigits < 19)
+		{
+			Dec->Mantissa = Dec->Mantissa * 10 + Digit;
+			(*SigDigits)++;
+			if (Fraction)
+				Dec->Exponent--;
+		}
+		else
+		{
+			if (Digit != 0)
+				Dec->Truncated = true;
+			if (!Fraction)
+				Dec->Exponent++;
+		}
+	}
+}
+
+// Sprawdza składnię: [spacje][+-]cyfry[.cyfry][{DdEe}[+-]cyfry]
+// Zwraca false, jeśli łańcuch nie jest poprawną liczbą.
+static bool ParseDecimalString(DECIMAL_STRING *Out, const tchar *p, const tchar *End)
+{
+	while (p != End && (*p == _T(' ') || *p == _T('\t')))
+		++p;
+	if (p == End)
+		return false;
+
+	Out->Negative = (*p == _T('-'));
+	if (*p == _T('+') || *p == _T('-'))
+		++p;
+	if (p == End)
+		return false;
+
+	Out->IntBegin = p;
+	while (p != End && IsDecimalDigit(*p))
+		++p;
+	Out->IntEnd = Out->FracBegin = Out->FracEnd = p;
+	if (p == End && Out->IntBegin == Out->IntEnd)
+		return false;
+	if (p != End && *p == _T('.'))
+	{
+		++p;
+		Out->FracBegin = p;
+		while (p != End && IsDecimalDigit(*p))
+			++p;
+		Out->FracEnd = p;
+	}
+	if (Out->IntBegin == Out->IntEnd && Out->FracBegin == Out->FracEnd)
+		return false;
+
+	Out->ExplicitExponent = 0;
+	if (p != End)
+	{
+		if (!(*p == _T('d') || *p == _T('D') || *p == _T('e') || *p == _T('E')))
+			return false;
+		++p;
+		bool NegativeExponent = false;
+		if (p != End && (*p == _T('+') || *p == _T('-')))
+		{
+			NegativeExponent = (*p == _T('-'));
+			++p;
+		}
+		if (p == End)
+			return false;
+		int64 ExpValue = 0;
+		for (; p != End && IsDecimalDigit(*p); ++p)
+		{
+			// Dalej i tak wynik to 0 albo nieskończoność
+			if (ExpValue < 100000)
+				ExpValue = ExpValue * 10 + (*p - _T('0'));
+		}
+		if (p != End)
+			return false;
+		Out->ExplicitExponent = NegativeExponent ? -ExpValue : ExpValue;
+	}
+
+	Out->Mantissa = 0;
+	Out->Exponent = 0;
+	Out->Truncated = false;
+	uint SigDigits = 0;
+	AccumulateDigits(Out, &SigDigits, Out->IntBegin, Out->IntEnd, false);
+	AccumulateDigits(Out, &SigDigits, Out->FracBegin, Out->FracEnd, true);
+	Out->Exponent += Out->ExplicitExponent;
+	return true;
+}
+
+// Wszystkie cyfry jako D * 10^e, najwyżej MAX_FALLBACK_DIGITS cyfr
+static void DigitsToBigNumber(BIG_NUMBER *D, int64 *e, const DECIMAL_STRING &Dec)
+{
+	D->Count = 0;
+	*e = Dec.ExplicitExponent;
+	uint Count = 0, ChunkLength = 0;
+	uint32 Chunk = 0;
+	bool Sticky = false;
+	for (uint Part = 0; Part < 2; Part++)
+	{
+		bool Fraction = (Part == 1);
+		const tchar *p = Fraction ? Dec.FracBegin : Dec.IntBegin;
+		const tchar *End = Fraction ? Dec.FracEnd : Dec.IntEnd;
+		for (; p != End; ++p)
+		{
+			uint32 Digit = (uint32)(*p - _T('0'));
+			if (Count == 0 && Digit == 0)
+			{
+				if (Fraction)
+					(*e)--;
+			}
+			else if (Count < MAX_FALLBACK_DIGITS)
+			{
+				Chunk = Chunk * 10 + Digit;
+				if (++ChunkLength == 9)
+				{
+					D->MulAdd(1000000000u, Chunk);
+					Chunk = 0;
+					ChunkLength = 0;
+				}
+				Count++;
+				if (Fraction)
+					(*e)--;
+			}
+			else
+			{
+				if (Digit != 0)
+					Sticky = true;
+				if (!Fraction)
+					(*e)++;
+			}
+		}
+	}
+	if (ChunkLength > 0)
+		D->MulAdd(POWERS_OF_FIVE_32[ChunkLength] << ChunkLength, Chunk);
+	if (Sticky)
+	{
+		D->MulAdd(10, 1);
+		(*e)--;
+	}
+}
+
+// Porównuje dokładnie D * 10^e z m * 2^k.
+static int CompareDecimalWithBinary(const BIG_NUMBER &D, int64 e, uint64 m, int64 k)
+{
+	// D * 5^e * 2^e  <=>  m * 2^k
+	BIG_NUMBER L = D, R;
+	R.Set(m);
+	int64 Power2L = 0, Power2R = k;
+	if (e >= 0)
+	{
+		L.MulPow5(e);
+		Power2L += e;
+	}
+	else
+	{
+		R.MulPow5(-e);
+		Power2R -= e;
+	}
+	if (Power2L > Power2R)
+		L.ShiftLeft(Power2L - Power2R);
+	else
+		R.ShiftLeft(Power2R - Power2L);
+	return BIG_NUMBER::Compare(L, R);
+}
+
+// Mantysa z ukrytą jedynką i wykładnik: wartość bitów Bits (bez znaku) to m * 2^k.
+static void DecodeFloatBits(uint64 *m, int *k, uint64 Bits, const FLOAT_FORMAT &F)
+{
+	uint64 Fraction = Bits & ((1ull << F.MantissaBits) - 1);
+	int Power = (int)((Bits >> F.MantissaBits) & (uint64)F.InfinitePower);
+	*m = (Power != 0) ? (Fraction | (1ull << F.MantissaBits)) : Fraction;
+	*k = (Power != 0 ? Power : 1) + F.MinExponent - F.MantissaBits;
+}
+
+// Porównuje D * 10^e z punktem w połowie między Bits a następną wartością.
+static int CompareWithHalfway(const BIG_NUMBER &D, int64 e, uint64 Bits, const FLOAT_FORMAT &F)
+{
+	uint64 m;
+	int k;
+	DecodeFloatBits(&m, &k, Bits, F);
+	return CompareDecimalWithBinary(D, e, 2 * m + 1, k - 1);
+}
+
+// Poprawia przybliżenie Bits do wartości dokładnie zaokrąglonej
+static uint64 RoundExactly(const DECIMAL_STRING &Dec, uint64 Bits, const FLOAT_FORMAT &F)
+{
+	BIG_NUMBER D;
+	int64 e;
+	DigitsToBigNumber(&D, &e, Dec);
+
+	uint64 InfiniteBits = (uint64)F.InfinitePower << F.MantissaBits;
+	for (;;)
+	{
+		if (Bits < InfiniteBits)
+		{
+			int Cmp = CompareWithHalfway(D, e, Bits, F);
+			if (Cmp > 0 || (Cmp == 0 && (Bits & 1) != 0))
+			{
+				Bits++;
+				continue;
+			}
+		}
+		if (Bits > 0)
+		{
+			int Cmp = CompareWithHalfway(D, e, Bits - 1, F);
+			if (Cmp < 0 || (Cmp == 0 && (Bits & 1) != 0))
+			{
+				Bits--;
+				continue;
+			}
+		}
+		return Bits;
+	}
+}
+
+// Zwraca bity liczby w formacie F
+static int ParseFloatingPoint(uint64 *OutBits, const tchar *s, size_t Length, const FLOAT_FORMAT &F)
+{
+	DECIMAL_STRING Dec;
+	if (!ParseDecimalString(&Dec, s, s + Length))
+		return -1;
+
+	uint64 Bits = 0;
+	if (Dec.Mantissa != 0)
+	{
+		uint64 Mantissa;
+		int Power2;
+		bool Exact = EiselLemire(&Mantissa, &Power2, Dec.Mantissa, Dec.Exponent, F);
+		// Dalsze cyfry mogą zmienić wynik tylko jeśli w i w+1 dają różne wartości
+		if (Exact && Dec.Truncated)
+		{
+			uint64 Mantissa2;
+			int Power2_2;
+			Exact = EiselLemire(&Mantissa2, &Power2_2, Dec.Mantissa + 1, Dec.Exponent, F) &&
+				Mantissa2 == Mantissa && Power2_2 == Power2;
+		}
+		Bits = Mantissa | ((uint64)Power2 << F.MantissaBits);
+		if (!Exact)
+			Bits = RoundExactly(Dec, Bits, F);
+	}
+	if (Dec.Negative)
+		Bits |= 1ull << F.SignBit;
+	*OutBits = Bits;
+	return 0;
+}
+
+int StrToDouble(double *out, const tchar *s, size_t Length)
+{
+	uint64 Bits;
+	int r = ParseFloatingPoint(&Bits, s, Length, DOUBLE_FORMAT);
+	if (r != 0)
+		return r;
+	memcpy(out, &Bits, sizeof(double));
+	return 0;
+}
+
+int StrToFloat(float *out, const tchar *s, size_t Length)
+{
+	uint64 Bits;
+	int r = ParseFloatingPoint(&Bits, s, Length, SINGLE_FORMAT);
+	if (r != 0)
+		return r;
+	uint32 Bits32 = (uint32)Bits;
+	memcpy(out, &Bits32, sizeof(float));
+	return 0;
+}
+
+// Formatowanie bez sprintf i locale. Najkrótsza postać (tryb 'r') to algorytm Schubfach
+// (R. Giulietti, "The Schubfach way to render doubles"). Tryby z precyzją zaokrąglają jego
+// cyfry, jeśli da to na pewno ten sam wynik co zaokrąglenie dokładnej wartości,
+// a w przeciwnym razie liczą dokładnie na BIG_NUMBER.
+
+// 10^e znormalizowane do 128 bitów, zaokrąglone w górę (floor + 1), dla e = -292..324 - starsza i młodsza połowa.
+static const uint64 POWERS_OF_TEN_128[] = {
+	0xff77b1fcbebcdc4full, 0x25e8e89c13bb0f7bull,
+	0x9faacf3df73609b1ull, 0x77b191618c54e9adull,
+	0xc795830d75038c1dull, 0xd59df5b9ef6a2418ull,
+	0xf97ae3d0d2446f25ull, 0x4b0573286b44ad1eull,
+	0x9becce62836ac577ull, 0x4ee367f9430aec33ull,
+	0xc2e801fb244576d5ull, 0x229c41f793cda740ull,
+	0xf3a20279ed56d48aull, 0x6b43527578c11110ull,
+	0x9845418c345644d6ull, 0x830a13896b78aaaaull,
+	0xbe5691ef416bd60cull, 0x23cc986bc656d554ull,
+	0xedec366b11c6cb8full, 0x2cbfbe86b7ec8aa9ull,
+	0x94b3a202eb1c3f39ull, 0x7bf7d71432f3d6aaull,
+	0xb9e08a83a5e34f07ull, 0xdaf5ccd93fb0cc54ull,
+	0xe858ad248f5c22c9ull, 0xd1b3400f8f9cff69ull,
+	0x91376c36d99995beull, 0x23100809b9c21fa2ull,
+	0xb58547448ffffb2dull, 0xabd40a0c2832a78bull,
+	0xe2e69915b3fff9f9ull, 0x16c90c8f323f516dull,
+	0x8dd01fad907ffc3bull, 0xae3da7d97f6792e4ull,
+	0xb1442798f49ffb4aull, 0x99cd11cfdf41779dull,
+	0xdd95317f31c7fa1dull, 0x40405643d711d584ull,
+	0x8a7d3eef7f1cfc52ull, 0x482835ea666b2573ull,
+	0xad1c8eab5ee43b66ull, 0xda3243650005eed0ull,
+	0xd863b256369d4a40ull, 0x90bed43e40076a83ull,
+	0x873e4f75e2224e68ull, 0x5a7744a6e804a292ull,
+	0xa90de3535aaae202ull, 0x711515d0a205cb37ull,
+	0xd3515c2831559a83ull, 0x0d5a5b44ca873e04ull,
+	0x8412d9991ed58091ull, 0xe858790afe9486c3ull,
+	0xa5178fff668ae0b6ull, 0x626e974dbe39a873ull,
+	0xce5d73ff402d98e3ull, 0xfb0a3d212dc81290ull,
+	0x80fa687f881c7f8eull, 0x7ce66634bc9d0b9aull,
+	0xa139029f6a239f72ull, 0x1c1fffc1ebc44e81ull,
+	0xc987434744ac874eull, 0xa327ffb266b56221ull,
+	0xfbe9141915d7a922ull, 0x4bf1ff9f0062baa9ull,
+	0x9d71ac8fada6c9b5ull, 0x6f773fc3603db4aaull,
+	0xc4ce17b399107c22ull, 0xcb550fb4384d21d4ull,
+	0xf6019da07f549b2bull, 0x7e2a53a146606a49ull,
+	0x99c102844f94e0fbull, 0x2eda7444cbfc426eull,
+	0xc0314325637a1939ull, 0xfa911155fefb5309ull,
+	0xf03d93eebc589f88ull, 0x793555ab7eba27cbull,
+	0x96267c7535b763b5ull, 0x4bc1558b2f3458dfull,
+	0xbbb01b9283253ca2ull, 0x9eb1aaedfb016f17ull,
+	0xea9c227723ee8bcbull, 0x465e15a979c1caddull,
+	0x92a1958a7675175full, 0x0bfacd89ec191ecaull,
+	0xb749faed14125d36ull, 0xcef980ec671f667cull,
+	0xe51c79a85916f484ull, 0x82b7e12780e7401bull,
+	0x8f31cc0937ae58d2ull, 0xd1b2ecb8b0908811ull,
+	0xb2fe3f0b8599ef07ull, 0x861fa7e6dcb4aa16ull,
+	0xdfbdcece67006ac9ull, 0x67a791e093e1d49bull,
+	0x8bd6a141006042bdull, 0xe0c8bb2c5c6d24e1ull,
+	0xaecc49914078536dull, 0x58fae9f773886e19ull,
+	0xda7f5bf590966848ull, 0xaf39a475506a899full,
+	0x888f99797a5e012dull, 0x6d8406c952429604ull,
+	0xaab37fd7d8f58178ull, 0xc8e5087ba6d33b84ull,
+	0xd5605fcdcf32e1d6ull, 0xfb1e4a9a90880a65ull,
+	0x855c3be0a17fcd26ull, 0x5cf2eea09a550680ull,
+	0xa6b34ad8c9dfc06full, 0xf42faa48c0ea481full,
+	0xd0601d8efc57b08bull, 0xf13b94daf124da27ull,
+	0x823c12795db6ce57ull, 0x76c53d08d6b70859ull,
+	0xa2cb1717b52481edull, 0x54768c4b0c64ca6full,
+	0xcb7ddcdda26da268ull, 0xa9942f5dcf7dfd0aull,
+	0xfe5d54150b090b02ull, 0xd3f93b35435d7c4dull,
+	0x9efa548d26e5a6e1ull, 0xc47bc5014a1a6db0ull,
+	0xc6b8e9b0709f109aull, 0x359ab6419ca1091cull,
+	0xf867241c8cc6d4c0ull, 0xc30163d203c94b63ull,
+	0x9b407691d7fc44f8ull, 0x79e0de63425dcf1eull,
+	0xc21094364dfb5636ull, 0x985915fc12f542e5ull,
+	0xf294b943e17a2bc4ull, 0x3e6f5b7b17b2939eull,
+	0x979cf3ca6cec5b5aull, 0xa705992ceecf9c43ull,
+	0xbd8430bd08277231ull, 0x50c6ff782a838354ull,
+	0xece53cec4a314ebdull, 0xa4f8bf5635246429ull,
+	0x940f4613ae5ed136ull, 0x871b7795e136be9aull,
+	0xb913179899f68584ull, 0x28e2557b59846e40ull,
+	0xe757dd7ec07426e5ull, 0x331aeada2fe589d0ull,
+	0x9096ea6f3848984full, 0x3ff0d2c85def7622ull,
+	0xb4bca50b065abe63ull, 0x0fed077a756b53aaull,
+	0xe1ebce4dc7f16dfbull, 0xd3e8495912c62895ull,
+	0x8d3360f09cf6e4bdull, 0x64712dd7abbbd95dull,
+	0xb080392cc4349decull, 0xbd8d794d96aacfb4ull,
+	0xdca04777f541c567ull, 0xecf0d7a0fc5583a1ull,
+	0x89e42caaf9491b60ull, 0xf41686c49db57245ull,
+	0xac5d37d5b79b6239ull, 0x311c2875c522ced6ull,
+	0xd77485cb25823ac7ull, 0x7d633293366b828cull,
+	0x86a8d39ef77164bcull, 0xae5dff9c02033198ull,
+	0xa8530886b54dbdebull, 0xd9f57f830283fdfdull,
+	0xd267caa862a12d66ull, 0xd072df63c324fd7cull,
+	0x8380dea93da4bc60ull, 0x4247cb9e59f71e6eull,
+	0xa46116538d0deb78ull, 0x52d9be85f074e609ull,
+	0xcd795be870516656ull, 0x67902e276c921f8cull,
+	0x806bd9714632dff6ull, 0x00ba1cd8a3db53b7ull,
+	0xa086cfcd97bf97f3ull, 0x80e8a40eccd228a5ull,
+	0xc8a883c0fdaf7df0ull, 0x6122cd128006b2ceull,
+	0xfad2a4b13d1b5d6cull, 0x796b805720085f82ull,
+	0x9cc3a6eec6311a63ull, 0xcbe3303674053bb1ull,
+	0xc3f490aa77bd60fcull, 0xbedbfc4411068a9dull,
+	0xf4f1b4d515acb93bull, 0xee92fb5515482d45ull,
+	0x991711052d8bf3c5ull, 0x751bdd152d4d1c4bull,
+	0xbf5cd54678eef0b6ull, 0xd262d45a78a0635eull,
+	0xef340a98172aace4ull, 0x86fb897116c87c35ull,
+	0x9580869f0e7aac0eull, 0xd45d35e6ae3d4da1ull,
+	0xbae0a846d2195712ull, 0x8974836059cca10aull,
+	0xe998d258869facd7ull, 0x2bd1a438703fc94cull,
+	0x91ff83775423cc06ull, 0x7b6306a34627ddd0ull,
+	0xb67f6455292cbf08ull, 0x1a3bc84c17b1d543ull,
+	0xe41f3d6a7377eecaull, 0x20caba5f1d9e4a94ull,
+	0x8e938662882af53eull, 0x547eb47b7282ee9dull,
+	0xb23867fb2a35b28dull, 0xe99e619a4f23aa44ull,
+	0xdec681f9f4c31f31ull, 0x6405fa00e2ec94d5ull,
+	0x8b3c113c38f9f37eull, 0xde83bc408dd3dd05ull,
+	0xae0b158b4738705eull, 0x9624ab50b148d446ull,
+	0xd98ddaee19068c76ull, 0x3badd624dd9b0958ull,
+	0x87f8a8d4cfa417c9ull, 0xe54ca5d70a80e5d7ull,
+	0xa9f6d30a038d1dbcull, 0x5e9fcf4ccd211f4dull,
+	0xd47487cc8470652bull, 0x7647c32000696720ull,
+	0x84c8d4dfd2c63f3bull, 0x29ecd9f40041e074ull,
+	0xa5fb0a17c777cf09ull, 0xf468107100525891ull,
+	0xcf79cc9db955c2ccull, 0x7182148d4066eeb5ull,
+	0x81ac1fe293d599bfull, 0xc6f14cd848405531ull,
+	0xa21727db38cb002full, 0xb8ada00e5a506a7dull,
+	0xca9cf1d206fdc03bull, 0xa6d90811f0e4851dull,
+	0xfd442e4688bd304aull, 0x908f4a166d1da664ull,
+	0x9e4a9cec15763e2eull, 0x9a598e4e043287ffull,
+	0xc5dd44271ad3cdbaull, 0x40eff1e1853f29feull,
+	0xf7549530e188c128ull, 0xd12bee59e68ef47dull,
+	0x9a94dd3e8cf578b9ull, 0x82bb74f8301958cfull,
+	0xc13a148e3032d6e7ull, 0xe36a52363c1faf02ull,
+	0xf18899b1bc3f8ca1ull, 0xdc44e6c3cb279ac2ull,
+	0x96f5600f15a7b7e5ull, 0x29ab103a5ef8c0baull,
+	0xbcb2b812db11a5deull, 0x7415d448f6b6f0e8ull,
+	0xebdf661791d60f56ull, 0x111b495b3464ad22ull,
+	0x936b9fcebb25c995ull, 0xcab10dd900beec35ull,
+	0xb84687c269ef3bfbull, 0x3d5d514f40eea743ull,
+	0xe65829b3046b0afaull, 0x0cb4a5a3112a5113ull,
+	0x8ff71a0fe2c2e6dcull, 0x47f0e785eaba72acull,
+	0xb3f4e093db73a093ull, 0x59ed216765690f57ull,
+	0xe0f218b8d25088b8ull, 0x306869c13ec3532dull,
+	0x8c974f7383725573ull, 0x1e414218c73a13fcull,
+	0xafbd2350644eeacfull, 0xe5d1929ef90898fbull,
+	0xdbac6c247d62a583ull, 0xdf45f746b74abf3aull,
+	0x894bc396ce5da772ull, 0x6b8bba8c328eb784ull,
+	0xab9eb47c81f5114full, 0x066ea92f3f326565ull,
+	0xd686619ba27255a2ull, 0xc80a537b0efefebeull,
+	0x8613fd0145877585ull, 0xbd06742ce95f5f37ull,
+	0xa798fc4196e952e7ull, 0x2c48113823b73705ull,
+	0xd17f3b51fca3a7a0ull, 0xf75a15862ca504c6ull,
+	0x82ef85133de648c4ull, 0x9a984d73dbe722fcull,
+	0xa3ab66580d5fdaf5ull, 0xc13e60d0d2e0ebbbull,
+	0xcc963fee10b7d1b3ull, 0x318df905079926a9ull,
+	0xffbbcfe994e5c61full, 0xfdf17746497f7053ull,
+	0x9fd561f1fd0f9bd3ull, 0xfeb6ea8bedefa634ull,
+	0xc7caba6e7c5382c8ull, 0xfe64a52ee96b8fc1ull,
+	0xf9bd690a1b68637bull, 0x3dfdce7aa3c673b1ull,
+	0x9c1661a651213e2dull, 0x06bea10ca65c084full,
+	0xc31bfa0fe5698db8ull, 0x486e494fcff30a63ull,
+	0xf3e2f893dec3f126ull, 0x5a89dba3c3efccfbull,
+	0x986ddb5c6b3a76b7ull, 0xf89629465a75e01dull,
+	0xbe89523386091465ull, 0xf6bbb397f1135824ull,
+	0xee2ba6c0678b597full, 0x746aa07ded582e2dull,
+	0x94db483840b717efull, 0xa8c2a44eb4571cddull,
+	0xba121a4650e4ddebull, 0x92f34d62616ce414ull,
+	0xe896a0d7e51e1566ull, 0x77b020baf9c81d18ull,
+	0x915e2486ef32cd60ull, 0x0ace1474dc1d122full,
+	0xb5b5ada8aaff80b8ull, 0x0d819992132456bbull,
+	0xe3231912d5bf60e6ull, 0x10e1fff697ed6c6aull,
+	0x8df5efabc5979c8full, 0xca8d3ffa1ef463c2ull,
+	0xb1736b96b6fd83b3ull, 0xbd308ff8a6b17cb3ull,
+	0xddd0467c64bce4a0ull, 0xac7cb3f6d05ddbdfull,
+	0x8aa22c0dbef60ee4ull, 0x6bcdf07a423aa96cull,
+	0xad4ab7112eb3929dull, 0x86c16c98d2c953c7ull,
+	0xd89d64d57a607744ull, 0xe871c7bf077ba8b8ull,
+	0x87625f056c7c4a8bull, 0x11471cd764ad4973ull,
+	0xa93af6c6c79b5d2dull, 0xd598e40d3dd89bd0ull,
+	0xd389b47879823479ull, 0x4aff1d108d4ec2c4ull,
+	0x843610cb4bf160cbull, 0xcedf722a585139bbull,
+	0xa54394fe1eedb8feull, 0xc2974eb4ee658829ull,
+	0xce947a3da6a9273eull, 0x733d226229feea33ull,
+	0x811ccc668829b887ull, 0x0806357d5a3f5260ull,
+	0xa163ff802a3426a8ull, 0xca07c2dcb0cf26f8ull,
+	0xc9bcff6034c13052ull, 0xfc89b393dd02f0b6ull,
+	0xfc2c3f3841f17c67ull, 0xbbac2078d443ace3ull,
+	0x9d9ba7832936edc0ull, 0xd54b944b84aa4c0eull,
+	0xc5029163f384a931ull, 0x0a9e795e65d4df12ull,
+	0xf64335bcf065d37dull, 0x4d4617b5ff4a16d6ull,
+	0x99ea0196163fa42eull, 0x504bced1bf8e4e46ull,
+	0xc06481fb9bcf8d39ull, 0xe45ec2862f71e1d7ull,
+	0xf07da27a82c37088ull, 0x5d767327bb4e5a4dull,
+	0x964e858c91ba2655ull, 0x3a6a07f8d510f870ull,
+	0xbbe226efb628afeaull, 0x890489f70a55368cull,
+	0xeadab0aba3b2dbe5ull, 0x2b45ac74ccea842full,
+	0x92c8ae6b464fc96full, 0x3b0b8bc90012929eull,
+	0xb77ada0617e3bbcbull, 0x09ce6ebb40173745ull,
+	0xe55990879ddcaabdull, 0xcc420a6a101d0516ull,
+	0x8f57fa54c2a9eab6ull, 0x9fa946824a12232eull,
+	0xb32df8e9f3546564ull, 0x47939822dc96abfaull,
+	0xdff9772470297ebdull, 0x59787e2b93bc56f8ull,
+	0x8bfbea76c619ef36ull, 0x57eb4edb3c55b65bull,
+	0xaefae51477a06b03ull, 0xede622920b6b23f2ull,
+	0xdab99e59958885c4ull, 0xe95fab368e45eceeull,
+	0x88b402f7fd75539bull, 0x11dbcb0218ebb415ull,
+	0xaae103b5fcd2a881ull, 0xd652bdc29f26a11aull,
+	0xd59944a37c0752a2ull, 0x4be76d3346f04960ull,
+	0x857fcae62d8493a5ull, 0x6f70a4400c562ddcull,
+	0xa6dfbd9fb8e5b88eull, 0xcb4ccd500f6bb953ull,
+	0xd097ad07a71f26b2ull, 0x7e2000a41346a7a8ull,
+	0x825ecc24c873782full, 0x8ed400668c0c28c9ull,
+	0xa2f67f2dfa90563bull, 0x728900802f0f32fbull,
+	0xcbb41ef979346bcaull, 0x4f2b40a03ad2ffbaull,
+	0xfea126b7d78186bcull, 0xe2f610c84987bfa9ull,
+	0x9f24b832e6b0f436ull, 0x0dd9ca7d2df4d7caull,
+	0xc6ede63fa05d3143ull, 0x91503d1c79720dbcull,
+	0xf8a95fcf88747d94ull, 0x75a44c6397ce912bull,
+	0x9b69dbe1b548ce7cull, 0xc986afbe3ee11abbull,
+	0xc24452da229b021bull, 0xfbe85badce996169ull,
+	0xf2d56790ab41c2a2ull, 0xfae27299423fb9c4ull,
+	0x97c560ba6b0919a5ull, 0xdccd879fc967d41bull,
+	0xbdb6b8e905cb600full, 0x5400e987bbc1c921ull,
+	0xed246723473e3813ull, 0x290123e9aab23b69ull,
+	0x9436c0760c86e30bull, 0xf9a0b6720aaf6522ull,
+	0xb94470938fa89bceull, 0xf808e40e8d5b3e6aull,
+	0xe7958cb87392c2c2ull, 0xb60b1d1230b20e05ull,
+	0x90bd77f3483bb9b9ull, 0xb1c6f22b5e6f48c3ull,
+	0xb4ecd5f01a4aa828ull, 0x1e38aeb6360b1af4ull,
+	0xe2280b6c20dd5232ull, 0x25c6da63c38de1b1ull,
+	0x8d590723948a535full, 0x579c487e5a38ad0full,
+	0xb0af48ec79ace837ull, 0x2d835a9df0c6d852ull,
+	0xdcdb1b2798182244ull, 0xf8e431456cf88e66ull,
+	0x8a08f0f8bf0f156bull, 0x1b8e9ecb641b5900ull,
+	0xac8b2d36eed2dac5ull, 0xe272467e3d222f40ull,
+	0xd7adf884aa879177ull, 0x5b0ed81dcc6abb10ull,
+	0x86ccbb52ea94baeaull, 0x98e947129fc2b4eaull,
+	0xa87fea27a539e9a5ull, 0x3f2398d747b36225ull,
+	0xd29fe4b18e88640eull, 0x8eec7f0d19a03aaeull,
+	0x83a3eeeef9153e89ull, 0x1953cf68300424adull,
+	0xa48ceaaab75a8e2bull, 0x5fa8c3423c052dd8ull,
+	0xcdb02555653131b6ull, 0x3792f412cb06794eull,
+	0x808e17555f3ebf11ull, 0xe2bbd88bbee40bd1ull,
+	0xa0b19d2ab70e6ed6ull, 0x5b6aceaeae9d0ec5ull,
+	0xc8de047564d20a8bull, 0xf245825a5a445276ull,
+	0xfb158592be068d2eull, 0xeed6e2f0f0d56713ull,
+	0x9ced737bb6c4183dull, 0x55464dd69685606cull,
+	0xc428d05aa4751e4cull, 0xaa97e14c3c26b887ull,
+	0xf53304714d9265dfull, 0xd53dd99f4b3066a9ull,
+	0x993fe2c6d07b7fabull, 0xe546a8038efe402aull,
+	0xbf8fdb78849a5f96ull, 0xde98520472bdd034ull,
+	0xef73d256a5c0f77cull, 0x963e66858f6d4441ull,
+	0x95a8637627989aadull, 0xdde7001379a44aa9ull,
+	0xbb127c53b17ec159ull, 0x5560c018580d5d53ull,
+	0xe9d71b689dde71afull, 0xaab8f01e6e10b4a7ull,
+	0x9226712162ab070dull, 0xcab3961304ca70e9ull,
+	0xb6b00d69bb55c8d1ull, 0x3d607b97c5fd0d23ull,
+	0xe45c10c42a2b3b05ull, 0x8cb89a7db77c506bull,
+	0x8eb98a7a9a5b04e3ull, 0x77f3608e92adb243ull,
+	0xb267ed1940f1c61cull, 0x55f038b237591ed4ull,
+	0xdf01e85f912e37a3ull, 0x6b6c46dec52f6689ull,
+	0x8b61313bbabce2c6ull, 0x2323ac4b3b3da016ull,
+	0xae397d8aa96c1b77ull, 0xabec975e0a0d081bull,
+	0xd9c7dced53c72255ull, 0x96e7bd358c904a22ull,
+	0x881cea14545c7575ull, 0x7e50d64177da2e55ull,
+	0xaa242499697392d2ull, 0xdde50bd1d5d0b9eaull,
+	0xd4ad2dbfc3d07787ull, 0x955e4ec64b44e865ull,
+	0x84ec3c97da624ab4ull, 0xbd5af13bef0b113full,
+	0xa6274bbdd0fadd61ull, 0xecb1ad8aeacdd58full,
+	0xcfb11ead453994baull, 0x67de18eda5814af3ull,
+	0x81ceb32c4b43fcf4ull, 0x80eacf948770ced8ull,
+	0xa2425ff75e14fc31ull, 0xa1258379a94d028eull,
+	0xcad2f7f5359a3b3eull, 0x096ee45813a04331ull,
+	0xfd87b5f28300ca0dull, 0x8bca9d6e188853fdull,
+	0x9e74d1b791e07e48ull, 0x775ea264cf55347eull,
+	0xc612062576589ddaull, 0x95364afe032a819eull,
+	0xf79687aed3eec551ull, 0x3a83ddbd83f52205ull,
+	0x9abe14cd44753b52ull, 0xc4926a9672793543ull,
+	0xc16d9a0095928a27ull, 0x75b7053c0f178294ull,
+	0xf1c90080baf72cb1ull, 0x5324c68b12dd6339ull,
+	0x971da05074da7beeull, 0xd3f6fc16ebca5e04ull,
+	0xbce5086492111aeaull, 0x88f4bb1ca6bcf585ull,
+	0xec1e4a7db69561a5ull, 0x2b31e9e3d06c32e6ull,
+	0x9392ee8e921d5d07ull, 0x3aff322e62439fd0ull,
+	0xb877aa3236a4b449ull, 0x09befeb9fad487c3ull,
+	0xe69594bec44de15bull, 0x4c2ebe687989a9b4ull,
+	0x901d7cf73ab0acd9ull, 0x0f9d37014bf60a11ull,
+	0xb424dc35095cd80full, 0x538484c19ef38c95ull,
+	0xe12e13424bb40e13ull, 0x2865a5f206b06fbaull,
+	0x8cbccc096f5088cbull, 0xf93f87b7442e45d4ull,
+	0xafebff0bcb24aafeull, 0xf78f69a51539d749ull,
+	0xdbe6fecebdedd5beull, 0xb573440e5a884d1cull,
+	0x89705f4136b4a597ull, 0x31680a88f8953031ull,
+	0xabcc77118461cefcull, 0xfdc20d2b36ba7c3eull,
+	0xd6bf94d5e57a42bcull, 0x3d32907604691b4dull,
+	0x8637bd05af6c69b5ull, 0xa63f9a49c2c1b110ull,
+	0xa7c5ac471b478423ull, 0x0fcf80dc33721d54ull,
+	0xd1b71758e219652bull, 0xd3c36113404ea4a9ull,
+	0x83126e978d4fdf3bull, 0x645a1cac083126eaull,
+	0xa3d70a3d70a3d70aull, 0x3d70a3d70a3d70a4ull,
+	0xccccccccccccccccull, 0xcccccccccccccccdull,
+	0x8000000000000000ull, 0x0000000000000001ull,
+	0xa000000000000000ull, 0x0000000000000001ull,
+	0xc800000000000000ull, 0x0000000000000001ull,
+	0xfa00000000000000ull, 0x0000000000000001ull,
+	0x9c40000000000000ull, 0x0000000000000001ull,
+	0xc350000000000000ull, 0x0000000000000001ull,
+	0xf424000000000000ull, 0x0000000000000001ull,
+	0x9896800000000000ull, 0x0000000000000001ull,
+	0xbebc200000000000ull, 0x0000000000000001ull,
+	0xee6b280000000000ull, 0x0000000000000001ull,
+	0x9502f90000000000ull, 0x0000000000000001ull,
+	0xba43b74000000000ull, 0x0000000000000001ull,
+	0xe8d4a51000000000ull, 0x0000000000000001ull,
+	0x9184e72a00000000ull, 0x0000000000000001ull,
+	0xb5e620f480000000ull, 0x0000000000000001ull,
+	0xe35fa931a0000000ull, 0x0000000000000001ull,
+	0x8e1bc9bf04000000ull, 0x0000000000000001ull,
+	0xb1a2bc2ec5000000ull, 0x0000000000000001ull,
+	0xde0b6b3a76400000ull, 0x0000000000000001ull,
+	0x8ac7230489e80000ull, 0x0000000000000001ull,
+	0xad78ebc5ac620000ull, 0x0000000000000001ull,
+	0xd8d726b7177a8000ull, 0x0000000000000001ull,
+	0x878678326eac9000ull, 0x0000000000000001ull,
+	0xa968163f0a57b400ull, 0x0000000000000001ull,
+	0xd3c21bcecceda100ull, 0x0000000000000001ull,
+	0x84595161401484a0ull, 0x0000000000000001ull,
+	0xa56fa5b99019a5c8ull, 0x0000000000000001ull,
+	0xcecb8f27f4200f3aull, 0x0000000000000001ull,
+	0x813f3978f8940984ull, 0x4000000000000001ull,
+	0xa18f07d736b90be5ull, 0x5000000000000001ull,
+	0xc9f2c9cd04674edeull, 0xa400000000000001ull,
+	0xfc6f7c4045812296ull, 0x4d00000000000001ull,
+	0x9dc5ada82b70b59dull, 0xf020000000000001ull,
+	0xc5371912364ce305ull, 0x6c28000000000001ull,
+	0xf684df56c3e01bc6ull, 0xc732000000000001ull,
+	0x9a130b963a6c115cull, 0x3c7f400000000001ull,
+	0xc097ce7bc90715b3ull, 0x4b9f100000000001ull,
+	0xf0bdc21abb48db20ull, 0x1e86d40000000001ull,
+	0x96769950b50d88f4ull, 0x1314448000000001ull,
+	0xbc143fa4e250eb31ull, 0x17d955a000000001ull,
+	0xeb194f8e1ae525fdull, 0x5dcfab0800000001ull,
+	0x92efd1b8d0cf37beull, 0x5aa1cae500000001ull,
+	0xb7abc627050305adull, 0xf14a3d9e40000001ull,
+	0xe596b7b0c643c719ull, 0x6d9ccd05d0000001ull,
+	0x8f7e32ce7bea5c6full, 0xe4820023a2000001ull,
+	0xb35dbf821ae4f38bull, 0xdda2802c8a800001ull,
+	0xe0352f62a19e306eull, 0xd50b2037ad200001ull,
+	0x8c213d9da502de45ull, 0x4526f422cc340001ull,
+	0xaf298d050e4395d6ull, 0x9670b12b7f410001ull,
+	0xdaf3f04651d47b4cull, 0x3c0cdd765f114001ull,
+	0x88d8762bf324cd0full, 0xa5880a69fb6ac801ull,
+	0xab0e93b6efee0053ull, 0x8eea0d047a457a01ull,
+	0xd5d238a4abe98068ull, 0x72a4904598d6d881ull,
+	0x85a36366eb71f041ull, 0x47a6da2b7f864751ull,
+	0xa70c3c40a64e6c51ull, 0x999090b65f67d925ull,
+	0xd0cf4b50cfe20765ull, 0xfff4b4e3f741cf6eull,
+	0x82818f1281ed449full, 0xbff8f10e7a8921a5ull,
+	0xa321f2d7226895c7ull, 0xaff72d52192b6a0eull,
+	0xcbea6f8ceb02bb39ull, 0x9bf4f8a69f764491ull,
+	0xfee50b7025c36a08ull, 0x02f236d04753d5b5ull,
+	0x9f4f2726179a2245ull, 0x01d762422c946591ull,
+	0xc722f0ef9d80aad6ull, 0x424d3ad2b7b97ef6ull,
+	0xf8ebad2b84e0d58bull, 0xd2e0898765a7deb3ull,
+	0x9b934c3b330c8577ull, 0x63cc55f49f88eb30ull,
+	0xc2781f49ffcfa6d5ull, 0x3cbf6b71c76b25fcull,
+	0xf316271c7fc3908aull, 0x8bef464e3945ef7bull,
+	0x97edd871cfda3a56ull, 0x97758bf0e3cbb5adull,
+	0xbde94e8e43d0c8ecull, 0x3d52eeed1cbea318ull,
+	0xed63a231d4c4fb27ull, 0x4ca7aaa863ee4bdeull,
+	0x945e455f24fb1cf8ull, 0x8fe8caa93e74ef6bull,
+	0xb975d6b6ee39e436ull, 0xb3e2fd538e122b45ull,
+	0xe7d34c64a9c85d44ull, 0x60dbbca87196b617ull,
+	0x90e40fbeea1d3a4aull, 0xbc8955e946fe31ceull,
+	0xb51d13aea4a488ddull, 0x6babab6398bdbe42ull,
+	0xe264589a4dcdab14ull, 0xc696963c7eed2dd2ull,
+	0x8d7eb76070a08aecull, 0xfc1e1de5cf543ca3ull,
+	0xb0de65388cc8ada8ull, 0x3b25a55f43294bccull,
+	0xdd15fe86affad912ull, 0x49ef0eb713f39ebfull,
+	0x8a2dbf142dfcc7abull, 0x6e3569326c784338ull,
+	0xacb92ed9397bf996ull, 0x49c2c37f07965405ull,
+	0xd7e77a8f87daf7fbull, 0xdc33745ec97be907ull,
+	0x86f0ac99b4e8dafdull, 0x69a028bb3ded71a4ull,
+	0xa8acd7c0222311bcull, 0xc40832ea0d68ce0dull,
+	0xd2d80db02aabd62bull, 0xf50a3fa490c30191ull,
+	0x83c7088e1aab65dbull, 0x792667c6da79e0fbull,
+	0xa4b8cab1a1563f52ull, 0x577001b891185939ull,
+	0xcde6fd5e09abcf26ull, 0xed4c0226b55e6f87ull,
+	0x80b05e5ac60b6178ull, 0x544f8158315b05b5ull,
+	0xa0dc75f1778e39d6ull, 0x696361ae3db1c722ull,
+	0xc913936dd571c84cull, 0x03bc3a19cd1e38eaull,
+	0xfb5878494ace3a5full, 0x04ab48a04065c724ull,
+	0x9d174b2dcec0e47bull, 0x62eb0d64283f9c77ull,
+	0xc45d1df942711d9aull, 0x3ba5d0bd324f8395ull,
+	0xf5746577930d6500ull, 0xca8f44ec7ee3647aull,
+	0x9968bf6abbe85f20ull, 0x7e998b13cf4e1eccull,
+	0xbfc2ef456ae276e8ull, 0x9e3fedd8c321a67full,
+	0xefb3ab16c59b14a2ull, 0xc5cfe94ef3ea101full,
+	0x95d04aee3b80ece5ull, 0xbba1f1d158724a13ull,
+	0xbb445da9ca61281full, 0x2a8a6e45ae8edc98ull,
+	0xea1575143cf97226ull, 0xf52d09d71a3293beull,
+	0x924d692ca61be758ull, 0x593c2626705f9c57ull,
+	0xb6e0c377cfa2e12eull, 0x6f8b2fb00c77836dull,
+	0xe498f455c38b997aull, 0x0b6dfb9c0f956448ull,
+	0x8edf98b59a373fecull, 0x4724bd4189bd5eadull,
+	0xb2977ee300c50fe7ull, 0x58edec91ec2cb658ull,
+	0xdf3d5e9bc0f653e1ull, 0x2f2967b66737e3eeull,
+	0x8b865b215899f46cull, 0xbd79e0d20082ee75ull,
+	0xae67f1e9aec07187ull, 0xecd8590680a3aa12ull,
+	0xda01ee641a708de9ull, 0xe80e6f4820cc9496ull,
+	0x884134fe908658b2ull, 0x3109058d147fdcdeull,
+	0xaa51823e34a7eedeull, 0xbd4b46f0599fd416ull,
+	0xd4e5e2cdc1d1ea96ull, 0x6c9e18ac7007c91bull,
+	0x850fadc09923329eull, 0x03e2cf6bc604ddb1ull,
+	0xa6539930bf6bff45ull, 0x84db8346b786151dull,
+	0xcfe87f7cef46ff16ull, 0xe612641865679a64ull,
+	0x81f14fae158c5f6eull, 0x4fcb7e8f3f60c07full,
+	0xa26da3999aef7749ull, 0xe3be5e330f38f09eull,
+	0xcb090c8001ab551cull, 0x5cadf5bfd3072cc6ull,
+	0xfdcb4fa002162a63ull, 0x73d9732fc7c8f7f7ull,
+	0x9e9f11c4014dda7eull, 0x2867e7fddcdd9afbull,
+	0xc646d63501a1511dull, 0xb281e1fd541501b9ull,
+	0xf7d88bc24209a565ull, 0x1f225a7ca91a4227ull,
+	0x9ae757596946075full, 0x3375788de9b06959ull,
+	0xc1a12d2fc3978937ull, 0x0052d6b1641c83afull,
+	0xf209787bb47d6b84ull, 0xc0678c5dbd23a49bull,
+	0x9745eb4d50ce6332ull, 0xf840b7ba963646e1ull,
+	0xbd176620a501fbffull, 0xb650e5a93bc3d899ull,
+	0xec5d3fa8ce427affull, 0xa3e51f138ab4cebfull,
+	0x93ba47c980e98cdfull, 0xc66f336c36b10138ull,
+	0xb8a8d9bbe123f017ull, 0xb80b0047445d4185ull,
+	0xe6d3102ad96cec1dull, 0xa60dc059157491e6ull,
+	0x9043ea1ac7e41392ull, 0x87c89837ad68db30ull,
+	0xb454e4a179dd1877ull, 0x29babe4598c311fcull,
+	0xe16a1dc9d8545e94ull, 0xf4296dd6fef3d67bull,
+	0x8ce2529e2734bb1dull, 0x1899e4a65f58660dull,
+	0xb01ae745b101e9e4ull, 0x5ec05dcff72e7f90ull,
+	0xdc21a1171d42645dull, 0x76707543f4fa1f74ull,
+	0x899504ae72497ebaull, 0x6a06494a791c53a9ull,
+	0xabfa45da0edbde69ull, 0x0487db9d17636893ull,
+	0xd6f8d7509292d603ull, 0x45a9d2845d3c42b7ull,
+	0x865b86925b9bc5c2ull, 0x0b8a2392ba45a9b3ull,
+	0xa7f26836f282b732ull, 0x8e6cac7768d7141full,
+	0xd1ef0244af2364ffull, 0x3207d795430cd927ull,
+	0x8335616aed761f1full, 0x7f44e6bd49e807b9ull,
+	0xa402b9c5a8d3a6e7ull, 0x5f16206c9c6209a7ull,
+	0xcd036837130890a1ull, 0x36dba887c37a8c10ull,
+	0x802221226be55a64ull, 0xc2494954da2c978aull,
+	0xa02aa96b06deb0fdull, 0xf2db9baa10b7bd6dull,
+	0xc83553c5c8965d3dull, 0x6f92829494e5acc8ull,
+	0xfa42a8b73abbf48cull, 0xcb772339ba1f17faull,
+	0x9c69a97284b578d7ull, 0xff2a760414536efcull,
+	0xc38413cf25e2d70dull, 0xfef5138519684abbull,
+	0xf46518c2ef5b8cd1ull, 0x7eb258665fc25d6aull,
+	0x98bf2f79d5993802ull, 0xef2f773ffbd97a62ull,
+	0xbeeefb584aff8603ull, 0xaafb550ffacfd8fbull,
+	0xeeaaba2e5dbf6784ull, 0x95ba2a53f983cf39ull,
+	0x952ab45cfa97a0b2ull, 0xdd945a747bf26184ull,
+	0xba756174393d88dfull, 0x94f971119aeef9e5ull,
+	0xe912b9d1478ceb17ull, 0x7a37cd5601aab85eull,
+	0x91abb422ccb812eeull, 0xac62e055c10ab33bull,
+	0xb616a12b7fe617aaull, 0x577b986b314d600aull,
+	0xe39c49765fdf9d94ull, 0xed5a7e85fda0b80cull,
+	0x8e41ade9fbebc27dull, 0x14588f13be847308ull,
+	0xb1d219647ae6b31cull, 0x596eb2d8ae258fc9ull,
+	0xde469fbd99a05fe3ull, 0x6fca5f8ed9aef3bcull,
+	0x8aec23d680043beeull, 0x25de7bb9480d5855ull,
+	0xada72ccc20054ae9ull, 0xaf561aa79a10ae6bull,
+	0xd910f7ff28069da4ull, 0x1b2ba1518094da05ull,
+	0x87aa9aff79042286ull, 0x90fb44d2f05d0843ull,
+	0xa99541bf57452b28ull, 0x353a1607ac744a54ull,
+	0xd3fa922f2d1675f2ull, 0x42889b8997915ce9ull,
+	0x847c9b5d7c2e09b7ull, 0x69956135febada12ull,
+	0xa59bc234db398c25ull, 0x43fab9837e699096ull,
+	0xcf02b2c21207ef2eull, 0x94f967e45e03f4bcull,
+	0x8161afb94b44f57dull, 0x1d1be0eebac278f6ull,
+	0xa1ba1ba79e1632dcull, 0x6462d92a69731733ull,
+	0xca28a291859bbf93ull, 0x7d7b8f7503cfdcffull,
+	0xfcb2cb35e702af78ull, 0x5cda735244c3d43full,
+	0x9defbf01b061adabull, 0x3a0888136afa64a8ull,
+	0xc56baec21c7a1916ull, 0x088aaa1845b8fdd1ull,
+	0xf6c69a72a3989f5bull, 0x8aad549e57273d46ull,
+	0x9a3c2087a63f6399ull, 0x36ac54e2f678864cull,
+	0xc0cb28a98fcf3c7full, 0x84576a1bb416a7deull,
+	0xf0fdf2d3f3c30b9full, 0x656d44a2a11c51d6ull,
+	0x969eb7c47859e743ull, 0x9f644ae5a4b1b326ull,
+	0xbc4665b596706114ull, 0x873d5d9f0dde1fefull,
+	0xeb57ff22fc0c7959ull, 0xa90cb506d155a7ebull,
+	0x9316ff75dd87cbd8ull, 0x09a7f12442d588f3ull,
+	0xb7dcbf5354e9beceull, 0x0c11ed6d538aeb30ull,
+	0xe5d3ef282a242e81ull, 0x8f1668c8a86da5fbull,
+	0x8fa475791a569d10ull, 0xf96e017d694487bdull,
+	0xb38d92d760ec4455ull, 0x37c981dcc395a9adull,
+	0xe070f78d3927556aull, 0x85bbe253f47b1418ull,
+	0x8c469ab843b89562ull, 0x93956d7478ccec8full,
+	0xaf58416654a6babbull, 0x387ac8d1970027b3ull,
+	0xdb2e51bfe9d0696aull, 0x06997b05fcc0319full,
+	0x88fcf317f22241e2ull, 0x441fece3bdf81f04ull,
+	0xab3c2fddeeaad25aull, 0xd527e81cad7626c4ull,
+	0xd60b3bd56a5586f1ull, 0x8a71e223d8d3b075ull,
+	0x85c7056562757456ull, 0xf6872d5667844e4aull,
+	0xa738c6bebb12d16cull, 0xb428f8ac016561dcull,
+	0xd106f86e69d785c7ull, 0xe13336d701beba53ull,
+	0x82a45b450226b39cull, 0xecc0024661173474ull,
+	0xa34d721642b06084ull, 0x27f002d7f95d0191ull,
+	0xcc20ce9bd35c78a5ull, 0x31ec038df7b441f5ull,
+	0xff290242c83396ceull, 0x7e67047175a15272ull,
+	0x9f79a169bd203e41ull, 0x0f0062c6e984d387ull,
+	0xc75809c42c684dd1ull, 0x52c07b78a3e60869ull,
+	0xf92e0c3537826145ull, 0xa7709a56ccdf8a83ull,
+	0x9bbcc7a142b17ccbull, 0x88a66076400bb692ull,
+	0xc2abf989935ddbfeull, 0x6acff893d00ea436ull,
+	0xf356f7ebf83552feull, 0x0583f6b8c4124d44ull,
+	0x98165af37b2153deull, 0xc3727a337a8b704bull,
+	0xbe1bf1b059e9a8d6ull, 0x744f18c0592e4c5dull,
+	0xeda2ee1c7064130cull, 0x1162def06f79df74ull,
+	0x9485d4d1c63e8be7ull, 0x8addcb5645ac2ba9ull,
+	0xb9a74a0637ce2ee1ull, 0x6d953e2bd7173693ull,
+	0xe8111c87c5c1ba99ull, 0xc8fa8db6ccdd0438ull,
+	0x910ab1d4db9914a0ull, 0x1d9c9892400a22a3ull,
+	0xb54d5e4a127f59c8ull, 0x2503beb6d00cab4cull,
+	0xe2a0b5dc971f303aull, 0x2e44ae64840fd61eull,
+	0x8da471a9de737e24ull, 0x5ceaecfed289e5d3ull,
+	0xb10d8e1456105dadull, 0x7425a83e872c5f48ull,
+	0xdd50f1996b947518ull, 0xd12f124e28f7771aull,
+	0x8a5296ffe33cc92full, 0x82bd6b70d99aaa70ull,
+	0xace73cbfdc0bfb7bull, 0x636cc64d1001550cull,
+	0xd8210befd30efa5aull, 0x3c47f7e05401aa4full,
+	0x8714a775e3e95c78ull, 0x65acfaec34810a72ull,
+	0xa8d9d1535ce3b396ull, 0x7f1839a741a14d0eull,
+	0xd31045a8341ca07cull, 0x1ede48111209a051ull,
+	0x83ea2b892091e44dull, 0x934aed0aab460433ull,
+	0xa4e4b66b68b65d60ull, 0xf81da84d56178540ull,
+	0xce1de40642e3f4b9ull, 0x36251260ab9d668full,
+	0x80d2ae83e9ce78f3ull, 0xc1d72b7c6b42601aull,
+	0xa1075a24e4421730ull, 0xb24cf65b8612f820ull,
+	0xc94930ae1d529cfcull, 0xdee033f26797b628ull,
+	0xfb9b7cd9a4a7443cull, 0x169840ef017da3b2ull,
+	0x9d412e0806e88aa5ull, 0x8e1f289560ee864full,
+	0xc491798a08a2ad4eull, 0xf1a6f2bab92a27e3ull,
+	0xf5b5d7ec8acb58a2ull, 0xae10af696774b1dcull,
+	0x9991a6f3d6bf1765ull, 0xacca6da1e0a8ef2aull,
+	0xbff610b0cc6edd3full, 0x17fd090a58d32af4ull,
+	0xeff394dcff8a948eull, 0xddfc4b4cef07f5b1ull,
+	0x95f83d0a1fb69cd9ull, 0x4abdaf101564f98full,
+	0xbb764c4ca7a4440full, 0x9d6d1ad41abe37f2ull,
+	0xea53df5fd18d5513ull, 0x84c86189216dc5eeull,
+	0x92746b9be2f8552cull, 0x32fd3cf5b4e49bb5ull,
+	0xb7118682dbb66a77ull, 0x3fbc8c33221dc2a2ull,
+	0xe4d5e82392a40515ull, 0x0fabaf3feaa5334bull,
+	0x8f05b1163ba6832dull, 0x29cb4d87f2a7400full,
+	0xb2c71d5bca9023f8ull, 0x743e20e9ef511013ull,
+	0xdf78e4b2bd342cf6ull, 0x914da9246b255417ull,
+	0x8bab8eefb6409c1aull, 0x1ad089b6c2f7548full,
+	0xae9672aba3d0c320ull, 0xa184ac2473b529b2ull,
+	0xda3c0f568cc4f3e8ull, 0xc9e5d72d90a2741full,
+	0x8865899617fb1871ull, 0x7e2fa67c7a658893ull,
+	0xaa7eebfb9df9de8dull, 0xddbb901b98feeab8ull,
+	0xd51ea6fa85785631ull, 0x552a74227f3ea566ull,
+	0x8533285c936b35deull, 0xd53a88958f872760ull,
+	0xa67ff273b8460356ull, 0x8a892abaf368f138ull,
+	0xd01fef10a657842cull, 0x2d2b7569b0432d86ull,
+	0x8213f56a67f6b29bull, 0x9c3b29620e29fc74ull,
+	0xa298f2c501f45f42ull, 0x8349f3ba91b47b90ull,
+	0xcb3f2f7642717713ull, 0x241c70a936219a74ull,
+	0xfe0efb53d30dd4d7ull, 0xed238cd383aa0111ull,
+	0x9ec95d1463e8a506ull, 0xf4363804324a40abull,
+	0xc67bb4597ce2ce48ull, 0xb143c6053edcd0d6ull,
+	0xf81aa16fdc1b81daull, 0xdd94b7868e94050bull,
+	0x9b10a4e5e9913128ull, 0xca7cf2b4191c8327ull,
+	0xc1d4ce1f63f57d72ull, 0xfd1c2f611f63a3f1ull,
+	0xf24a01a73cf2dccfull, 0xbc633b39673c8cedull,
+	0x976e41088617ca01ull, 0xd5be0503e085d814ull,
+	0xbd49d14aa79dbc82ull, 0x4b2d8644d8a74e19ull,
+	0xec9c459d51852ba2ull, 0xddf8e7d60ed1219full,
+	0x93e1ab8252f33b45ull, 0xcabb90e5c942b504ull,
+	0xb8da1662e7b00a17ull, 0x3d6a751f3b936244ull,
+	0xe7109bfba19c0c9dull, 0x0cc512670a783ad5ull,
+	0x906a617d450187e2ull, 0x27fb2b80668b24c6ull,
+	0xb484f9dc9641e9daull, 0xb1f9f660802dedf7ull,
+	0xe1a63853bbd26451ull, 0x5e7873f8a0396974ull,
+	0x8d07e33455637eb2ull, 0xdb0b487b6423e1e9ull,
+	0xb049dc016abc5e5full, 0x91ce1a9a3d2cda63ull,
+	0xdc5c5301c56b75f7ull, 0x7641a140cc7810fcull,
+	0x89b9b3e11b6329baull, 0xa9e904c87fcb0a9eull,
+	0xac2820d9623bf429ull, 0x546345fa9fbdcd45ull,
+	0xd732290fbacaf133ull, 0xa97c177947ad4096ull,
+	0x867f59a9d4bed6c0ull, 0x49ed8eabcccc485eull,
+	0xa81f301449ee8c70ull, 0x5c68f256bfff5a75ull,
+	0xd226fc195c6a2f8cull, 0x73832eec6fff3112ull,
+	0x83585d8fd9c25db7ull, 0xc831fd53c5ff7eacull,
+	0xa42e74f3d032f525ull, 0xba3e7ca8b77f5e56ull,
+	0xcd3a1230c43fb26full, 0x28ce1bd2e55f35ecull,
+	0x80444b5e7aa7cf85ull, 0x7980d163cf5b81b4ull,
+	0xa0555e361951c366ull, 0xd7e105bcc3326220ull,
+	0xc86ab5c39fa63440ull, 0x8dd9472bf3fefaa8ull,
+	0xfa856334878fc150ull, 0xb14f98f6f0feb952ull,
+	0x9c935e00d4b9d8d2ull, 0x6ed1bf9a569f33d4ull,
+	0xc3b8358109e84f07ull, 0x0a862f80ec4700c9ull,
+	0xf4a642e14c6262c8ull, 0xcd27bb612758c0fbull,
+	0x98e7e9cccfbd7dbdull, 0x8038d51cb897789dull,
+	0xbf21e44003acdd2cull, 0xe0470a63e6bd56c4ull,
+	0xeeea5d5004981478ull, 0x1858ccfce06cac75ull,
+	0x95527a5202df0ccbull, 0x0f37801e0c43ebc9ull,
+	0xbaa718e68396cffdull, 0xd30560258f54e6bbull,
+	0xe950df20247c83fdull, 0x47c6b82ef32a206aull,
+	0x91d28b7416cdd27eull, 0x4cdc331d57fa5442ull,
+	0xb6472e511c81471dull, 0xe0133fe4adf8e953ull,
+	0xe3d8f9e563a198e5ull, 0x58180fddd97723a7ull,
+	0x8e679c2f5e44ff8full, 0x570f09eaa7ea7649ull,
+	0xb201833b35d63f73ull, 0x2cd2cc6551e513dbull,
+	0xde81e40a034bcf4full, 0xf8077f7ea65e58d2ull,
+	0x8b112e86420f6191ull, 0xfb04afaf27faf783ull,
+	0xadd57a27d29339f6ull, 0x79c5db9af1f9b564ull,
+	0xd94ad8b1c7380874ull, 0x18375281ae7822bdull,
+	0x87cec76f1c830548ull, 0x8f2293910d0b15b6ull,
+	0xa9c2794ae3a3c69aull, 0xb2eb3875504ddb23ull,
+	0xd433179d9c8cb841ull, 0x5fa60692a46151ecull,
+	0x849feec281d7f328ull, 0xdbc7c41ba6bcd334ull,
+	0xa5c7ea73224deff3ull, 0x12b9b522906c0801ull,
+	0xcf39e50feae16befull, 0xd768226b34870a01ull,
+	0x81842f29f2cce375ull, 0xe6a1158300d46641ull,
+	0xa1e53af46f801c53ull, 0x60495ae3c1097fd1ull,
+	0xca5e89b18b602368ull, 0x385bb19cb14bdfc5ull,
+	0xfcf62c1dee382c42ull, 0x46729e03dd9ed7b6ull,
+	0x9e19db92b4e31ba9ull, 0x6c07a2c26a8346d2ull
+};
+static const int POWERS_OF_TEN_MIN_EXP = -292;
+
+// Przybliżenia logarytmów całkowitoliczbowo, poprawne dla |e| < 1000
+inline int FloorLog2Pow10(int e) { return (e * 1741647) >> 19; }
+inline int FloorLog10Pow2(int e) { return (e * 1262611) >> 22; }
+inline int FloorLog10ThreeQuartersPow2(int e) { return (e * 1262611 - 524031) >> 22; }
+
+// Starsze 64 bity iloczynu g (128 bitów) i cp, najmłodszy bit ustawiony, jeśli reszta nie jest zerem.
+inline uint64 RoundToOdd(const uint64 *g, uint64 cp)
+{
+	uint64 xHi, xLo, yHi, yLo;
+	Multiply64(&xHi, &xLo, g[1], cp);
+	Multiply64(&yHi, &yLo, g[0], cp);
+	uint64 z = yLo + xHi;
+	uint64 vbp = yHi + (z < yLo ? 1 : 0);
+	return vbp | (z > 1 ? 1 : 0);
+}
+
+// Liczba Digits * 10^Exponent
+struct DECIMAL_FLOAT
+{
+	uint64 Digits;
+	int Exponent;
+};
+
+// Najkrótsza liczba dziesiętna, która wczytana da dokładnie m * 2^k (m > 0).
+// Spośród najkrótszych - najbliższa. Bez zer na końcu Digits.
+static void ShortestDecimal(DECIMAL_FLOAT *Out, uint64 m, int k, const FLOAT_FORMAT &F)
+{
+	bool Normal = (m >> F.MantissaBits) != 0;
+	if (Normal && k <= 0 && -k <= F.MantissaBits && (m & ((1ull << -k) - 1)) == 0)
+	{
+		// Liczba całkowita
+		Out->Digits = m >> -k;
+		Out->Exponent = 0;
+	}
+	else
+	{
+		bool IsEven = (m & 1) == 0;
+		// Dla potęgi dwójki poprzednia wartość jest bliżej niż następna
+		bool LowerCloser = (m == (1ull << F.MantissaBits)) && k > 1 + F.MinExponent - F.MantissaBits;
+
+		// Granice przedziału wartości, które wczytane dają m * 2^k - w jednostkach 2^(k-2)
+		uint64 cbl = 4 * m - 2 + (LowerCloser ? 1 : 0);
+		uint64 cb  = 4 * m;
+		uint64 cbr = 4 * m + 2;
+
+		int e10 = LowerCloser ? FloorLog10ThreeQuartersPow2(k) : FloorLog10Pow2(k);
+		int h = k + FloorLog2Pow10(-e10) + 1;
+		const uint64 *g = &POWERS_OF_TEN_128[(size_t)(-e10 - POWERS_OF_TEN_MIN_EXP) * 2];
+
+		// Granice razy 4 * 10^-e10
+		uint64 vbl = RoundToOdd(g, cbl << h);
+		uint64 vb  = RoundToOdd(g, cb  << h);
+		uint64 vbr = RoundToOdd(g, cbr << h);
+		uint64 Lower = vbl + (IsEven ? 0 : 1);
+		uint64 Upper = vbr - (IsEven ? 0 : 1);
+
+		uint64 s = vb / 4;
+		bool Done = false;
+		if (s >= 10)
+		{
+			// O jedną cyfrę krócej
+			uint64 sp = s / 10;
+			bool UpInside = Lower <= 40 * sp;
+			bool WpInside = 40 * sp + 40 <= Upper;
+			if (UpInside != WpInside)
+			{
+				Out->Digits = sp + (WpInside ? 1 : 0);
+				Out->Exponent = e10 + 1;
+				Done = true;
+			}
+		}
+		if (!Done)
+		{
+			bool UInside = Lower <= 4 * s;
+			bool WInside = 4 * s + 4 <= Upper;
+			if (UInside != WInside)
+				Out->Digits = s + (WInside ? 1 : 0);
+			else
+			{
+				// Obie lub żadna - bliższa, remis do parzystej
+				uint64 Mid = 4 * s + 2;
+				bool RoundUp = vb > Mid || (vb == Mid && (s & 1) != 0);
+				Out->Digits = s + (RoundUp ? 1 : 0);
+			}
+			Out->Exponent = e10;
+		}
+	}
+
+	while (Out->Digits % 10 == 0)
+	{
+		Out->Digits /= 10;
+		Out->Exponent++;
+	}
+}
+
+// Zapisuje cyfry liczby od najstarszej, zwraca ich liczbę
+static uint WriteDecimalDigits(tchar *Out, uint64 v)
+{
+	return (uint)_UintToDecimal64(Out, v);
+}
+
+// Wolna, dokładna ścieżka: cyfry round(m * 2^k * 10^s), remis do parzystej.
+// Zwraca liczbę cyfr (0 dla zera), *LastExp = -s.
+static uint ExactScaledDigits(tchar *Out, uint64 m, int k, int s)
+{
+	BIG_NUMBER Num, Den;
+	Num.Set(m);
+	Den.Set(1);
+	if (k > 0)
+		Num.ShiftLeft(k);
+	else
+		Den.ShiftLeft(-k);
+	if (s > 0)
+	{
+		Num.MulPow5(s);
+		Num.ShiftLeft(s);
+	}
+	else if (s < 0)
+	{
+		Den.MulPow5(-s);
+		Den.ShiftLeft(-s);
+	}
+
+	// Dzielenie pisemne dwójkowo
+	BIG_NUMBER Quot;
+	int Shift = (int)Num.BitLength() - (int)Den.BitLength();
+	if (Shift >= 0)
+	{
+		Quot.Count = (uint)Shift / 32 + 1;
+		memset(Quot.Limbs, 0, Quot.Count * sizeof(uint32));
+		Den.ShiftLeft(Shift);
+		for (int i = Shift; i >= 0; i--)
+		{
+			if (BIG_NUMBER::Compare(Num, Den) >= 0)
+			{
+				Num.Sub(Den);
+				Quot.Limbs[i / 32] |= 1u << (i % 32);
+			}
+			if (i > 0)
+				Den.ShiftRight1();
+		}
+		Quot.Normalize();
+	}
+	// Reszta Num < Den: zaokrąglenie
+	Num.ShiftLeft(1);
+	int Cmp = BIG_NUMBER::Compare(Num, Den);
+	if (Cmp > 0 || (Cmp == 0 && Quot.Count > 0 && (Quot.Limbs[0] & 1) != 0))
+		Quot.MulAdd(1, 1);
+	if (Quot.Count == 0)
+		return 0;
+
+	// Na dziesiętny po 9 cyfr od końca
+	tchar Tmp[DOUBLE_TO_STR_BUFFER_SIZE];
+	uint Length = 0;
+	while (Quot.Count > 0)
+	{
+		uint32 Chunk = Quot.DivSmall(1000000000u);
+		for (uint i = 0; i < 9; i++)
+		{
+			Tmp[Length++] = (tchar)(_T('0') + Chunk % 10);
+			Chunk /= 10;
+		}
+	}
+	while (Tmp[Length - 1] == _T('0'))
+		Length--;
+	for (uint i = 0; i < Length; i++)
+		Out[i] = Tmp[Length - 1 - i];
+	return Length;
+}
+
+// Cyfry round(x * 10^s) bez zer na końcu, gdzie x = m * 2^k, a Shortest to jego najkrótsza postać.
+// Zwraca liczbę cyfr (0 dla zera), *X = wykładnik pierwszej cyfry.
+static uint RoundedDigits(tchar *Out, int *X, uint64 m, int k, const DECIMAL_FLOAT &Shortest, int s)
+{
+	uint64 Q;
+	int LastExp;
+	if (Shortest.Exponent + s >= 0)
+	{
+		// Najkrótsza postać uzupełniona zerami jest dokładna, jeśli 2^k <= 10^-s
+		if (k > FloorLog2Pow10(-s))
+		{
+			uint Length = ExactScaledDigits(Out, m, k, s);
+			*X = -s + (int)Length - 1;
+			while (Length > 0 && Out[Length - 1] == _T('0'))
+				Length--;
+			return Length;
+		}
+		Q = Shortest.Digits;
+		LastExp = Shortest.Exponent;
+	}
+	else
+	{
+		// Zaokrąglenie najkrótszej postaci jest poprawne, o ile nie wypada dokładnie w połowie
+		int Drop = -(Shortest.Exponent + s);
+		LastExp = -s;
+		if (Drop > 19)
+			Q = 0;
+		else
+		{
+			uint64 Pow = POWERS_OF_TEN_64[Drop];
+			Q = Shortest.Digits / Pow;
+			uint64 Rem = Shortest.Digits % Pow, Half = Pow / 2;
+			bool RoundUp = Rem > Half;
+			if (Rem == Half)
+			{
+				// Czy dokładna wartość jest powyżej najkrótszej postaci
+				BIG_NUMBER D;
+				D.Set(Shortest.Digits);
+				int Cmp = CompareDecimalWithBinary(D, Shortest.Exponent, m, k);
+				RoundUp = Cmp < 0 || (Cmp == 0 && (Q & 1) != 0);
+			}
+			if (RoundUp)
+				Q++;
+		}
+	}
+	if (Q == 0)
+		return 0;
+	while (Q % 10 == 0)
+	{
+		Q /= 10;
+		LastExp++;
+	}
+	uint Length = WriteDecimalDigits(Out, Q);
+	*X = LastExp + (int)Length - 1;
+	return Length;
+}
+
+static tchar * WriteExponent(tchar *p, int X, bool Upper)
+{
+	*p++ = Upper ? _T('E') : _T('e');
+	if (X < 0)
+	{
+		*p++ = _T('-');
+		X = -X;
+	}
+	else
+		*p++ = _T('+');
+	if (X >= 100)
+	{
+		*p++ = (tchar)(_T('0') + X / 100);
+		X %= 100;
+	}
+	*p++ = (tchar)(_T('0') + X / 10);
+	*p++ = (tchar)(_T('0') + X % 10);
+	return p;
+}
+
+// d.ddde+XX
+static tchar * WriteScientific(tchar *p, const tchar *Digits, uint Length, int X, int Decimals, bool Upper)
+{
+	*p++ = (Length > 0) ? Digits[0] : _T('0');
+	if (Decimals > 0)
+	{
+		*p++ = _T('.');
+		for (int i = 1; i <= Decimals; i++)
+			*p++ = ((uint)i < Length) ? Digits[i] : _T('0');
+	}
+	return WriteExponent(p, X, Upper);
+}
+
+// ddd.ddd
+static tchar * WriteFixed(tchar *p, const tchar *Digits, uint Length, int X, int Decimals)
+{
+	if (X < 0)
+		*p++ = _T('0');
+	else
+	{
+		for (int i = 0; i <= X; i++)
+			*p++ = ((uint)i < Length) ? Digits[i] : _T('0');
+	}
+	if (Decimals > 0)
+	{
+		*p++ = _T('.');
+		for (int Pos = -1; Pos >= -Decimals; Pos--)
+		{
+			int i = X - Pos;
+			*p++ = (i >= 0 && (uint)i < Length) ? Digits[i] : _T('0');
+		}
+	}
+	return p;
+}
+
+// Formatuje wartość o bitach Bits w formacie F. Zwraca liczbę znaków, dopisuje zero na końcu.
+static size_t FormatFloatingPoint(tchar *Out, uint64 Bits, const FLOAT_FORMAT &F, char Mode, int Precision)
+{
+	assert(Precision >= 0 && Precision <= 20);
+	Precision = std::max(0, std::min(20, Precision));
+	bool Upper = (Mode == 'E' || Mode == 'G');
+	tchar *p = Out;
+	if ((Bits >> F.SignBit) & 1)
+		*p++ = _T('-');
+
+	uint64 m;
+	int k;
+	DecodeFloatBits(&m, &k, Bits, F);
+	if (((Bits >> F.MantissaBits) & (uint64)F.InfinitePower) == (uint64)F.InfinitePower)
+	{
+		const tchar *Str = (m & ((1ull << F.MantissaBits) - 1)) != 0 ?
+			(Upper ? _T("NAN") : _T("nan")) :
+			(Upper ? _T("INF") : _T("inf"));
+		for (; *Str != _T('\0'); ++Str)
+			*p++ = *Str;
+		*p = _T('\0');
+		return p - Out;
+	}
+
+	tchar Digits[DOUBLE_TO_STR_BUFFER_SIZE];
+	uint Length = 0;
+	int X = 0;
+	DECIMAL_FLOAT Shortest = { 0, 0 };
+	int ShortestX = 0;
+	if (m != 0)
+	{
+		ShortestDecimal(&Shortest, m, k, F);
+		Length = WriteDecimalDigits(Digits, Shortest.Digits);
+		ShortestX = X = Shortest.Exponent + (int)Length - 1;
+	}
+
+	switch (Mode)
+	{
+	case 'r':
+		if (X < -4 || X >= 16)
+			p = WriteScientific(p, Digits, Length, X, (int)Length - 1, false);
+		else
+			p = WriteFixed(p, Digits, Length, X, std::max(0, (int)Length - 1 - X));
+		break;
+	case 'f':
+		if (m != 0)
+			Length = RoundedDigits(Digits, &X, m, k, Shortest, Precision);
+		p = WriteFixed(p, Digits, Length, Length > 0 ? X : 0, Precision);
+		break;
+	default:
+		assert((Mode == 'e' || Mode == 'E' || Mode == 'g' || Mode == 'G') && "Invalid Mode in DoubleToStr.");
+		{
+			bool Scientific = (Mode == 'e' || Mode == 'E');
+			// Liczba cyfr znaczących
+			int P = Scientific ? Precision + 1 : std::max(Precision, 1);
+			if (m != 0)
+			{
+				// Dokładna wartość może być tuż poniżej potęgi 10, którą jest najkrótsza postać
+				int ExactX = ShortestX;
+				if (Shortest.Digits == 1)
+				{
+					BIG_NUMBER One;
+					One.Set(1);
+					if (CompareDecimalWithBinary(One, ShortestX, m, k) > 0)
+						ExactX--;
+				}
+				Length = RoundedDigits(Digits, &X, m, k, Shortest, P - 1 - ExactX);
+			}
+			if (Scientific)
+				p = WriteScientific(p, Digits, Length, X, Precision, Upper);
+			else if (X < -4 || X >= P)
+				p = WriteScientific(p, Digits, Length, X, std::max(0, (int)Length - 1), Upper);
+			else
+				p = WriteFixed(p, Digits, Length, X, std::max(0, (int)Length - 1 - X));
+		}
+		break;
+	}
+
+	*p = _T('\0');
+	return p - Out;
+}
+
+size_t DoubleToStr(tchar *Out, double x, char Mode, int Precision)
+{
+	uint64 Bits;
+	memcpy(&Bits, &x, sizeof(double));
+	return FormatFloatingPoint(Out, Bits, DOUBLE_FORMAT, Mode, Precision);
+}
+
+size_t FloatToStr(tchar *Out, float x, char Mode, int Precision)
+{
+	// Najkrótsza postać dla float jest krótsza niż dla tej samej liczby jako double
+	if (Mode == 'r')
+	{
+		uint32 Bits;
+		memcpy(&Bits, &x, sizeof(float));
+		return FormatFloatingPoint(Out, Bits, SINGLE_FORMAT, Mode, Precision);
+	}
+	return DoubleToStr(Out, static_cast<double>(x), Mode, Precision);
+}
+
+void DoubleToStr(tstring *Out, double x, char Mode, int Precision)
+{
+	tchar Buf[DOUBLE_TO_STR_BUFFER_SIZE];
+	size_t Length = DoubleToStr(Buf, x, Mode, Precision);
+	Out->assign(Buf, Length);
+}
+
+void FloatToStr(tstring *Out, float x, char Mode, int Precision)
+{
+	tchar Buf[DOUBLE_TO_STR_BUFFER_SIZE];
+	size_t Length = FloatToStr(Buf, x, Mode, Precision);
+	Out->assign(Buf, Length);
+}
+
+void BoolToStr(tstring *Out, bool x, char mode)
+{
+	switch (mode)
+	{
+	case '0':
+		*Out = (x ? _T("1") : _T("0"));
+		return;
+	case 'F':
+		*Out = (x ? _T("True") : _T("False"));
+		return;
+	case 'U':
+		*Out = (x ? _T("TRUE") : _T("FALSE"));
+		return;
+	case 'g':
+		*Out = (x ? _T("t") : _T("f"));
+		return;
+	case 'G':
+		*Out = (x ? _T("T") : _T("F"));
+		return;
+	default: // 'f'
+		*Out = (x ? _T("true") : _T("false"));
+		return;
+	}
+}
+
+bool StrToBool(bool *result, const tstring &s)
+{
+	if (s == _T("0") || s == _T("f") || s == _T("F") || s == _T("false") || s == _T("False") || s == _T("FALSE"))
+		*result = false;
+	else if (s == _T("1") || s == _T("t") || s == _T("T") || s == _T("true") || s == _T("True") || s == _T("TRUE"))
+		*result = true;
+	else
+		return false;
+
+	return true;
+}
+
+void PtrToStr(tstring *Out, const void* p)
+{
+	tchar sz[17];
+#ifdef _UNICODE
+	_stprintf_s(sz, _countof(sz), L"%p", p);
+#else
+	#ifdef _MSC_VER
+		sprintf_s(sz, _countof(sz), "%p", p);
+	#else
+		sprintf(sz, "%p", p);
+	#endif
+#endif
+	*Out = sz;
+}
+
+static uint8 ROT13_TABLE[] = { 0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,52,53,54,55,56,57,58,59,60,61,62,63,64,78,79,80,81,82,83,84,85,86,87,88,89,90,65,66,67,68,69,70,71,72,73,74,75,76,77,91,92,93,94,95,96,110,111,112,113,114,115,116,117,118,119,120,121,122,97,98,99,100,101,102,103,104,105,106,107,108,109,123,124,125,126,127,128,129,130,131,132,133,134,135,136,137,138,139,140,141,142,143,144,145,146,147,148,149,150,151,152,153,154,155,156,157,158,159,160,161,162,163,164,165,166,167,168,169,170,171,172,173,174,175,176,177,178,179,180,181,182,183,184,185,186,187,188,189,190,191,192,193,194,195,196,197,198,199,200,201,202,203,204,205,206,207,208,209,210,211,212,213,214,215,216,217,218,219,220,221,222,223,224,225,226,227,228,229,230,231,232,233,234,235,236,237,238,239,240,241,242,243,244,245,246,247,248,249,250,251,252,253,254,255 };
+
+void Rot13(tstring *InOut)
+{
+#ifdef _UNICODE
+	int ci;
+	for (size_t i = 0; i < InOut->length(); i++)
+	{
+		ci = TCHAR_TO_INT((*InOut)[i]);
+		if (ci < 256)
+			(*InOut)[i] = INT_TO_TCHAR(ROT13_TABLE[ci]);
+	}
+#else
+	for (size_t i = 0; i < InOut->length(); i++)
+		(*InOut)[i] = (char)ROT13_TABLE[(uint8)(*InOut)[i]];
+#endif
+}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Matematyka
+
+#ifdef _WIN32
+	bool is_finite(float x)  { return (_finite(x) != 0); }
+	bool is_finite(double x) { return (_finite(x) != 0); }
+	bool is_nan(float x)  { return (_isnan(x) != 0); }
+	bool is_nan(double x) { return (_isnan(x) != 0); }
+#endif
+
+static const uint BIT_MASKS[33] = {
+	0x00000000, 0x00000001, 0x00000003, 0x00000007,
+	0x0000000F, 0x0000001F, 0x0000003F, 0x0000007F,
+	0x000000FF, 0x000001FF, 0x000003FF, 0x000007FF,
+	0x00000FFF, 0x00001FFF, 0x00003FFF, 0x00007FFF,
+	0x0000FFFF, 0x0001FFFF, 0x0003FFFF, 0x0007FFFF,
+	0x000FFFFF, 0x001FFFFF, 0x003FFFFF, 0x007FFFFF,
+	0x00FFFFFF, 0x01FFFFFF, 0x03FFFFFF, 0x07FFFFFF,
+	0x0FFFFFFF, 0x1FFFFFFF, 0x3FFFFFFF, 0x7FFFFFFF,
+	0xFFFFFFFF,
+};
+
+uint32 GetBitMask(uint32 n)
+{
+	assert(n <= 32);
+	return BIT_MASKS[n];
+}
+
+/// \internal
+static const int MultiplyDeBruijnBitPosition[32] = {
+	0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+	31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9,
+};
+
+uint log2u(uint v)
+{
+	v |= v >> 1;
+	v |= v >> 2;
+	v |= v >> 4;
+	v |= v >> 8;
+	v |= v >> 16;
+	v = (v >> 1) + 1;
+	return MultiplyDeBruijnBitPosition[(v * 0x077CB531UL) >> 27];
+}
+
+/// \internal
+static unsigned int const PowersOf10[] = {
+	1, 10, 100, 1000, 10000, 100000,
+	1000000, 10000000, 100000000, 1000000000,
+};
+
+uint log10u(uint v)
+{
+	uint t = (log2u(v) + 1) * 1233 >> 12;
+	return t - (v < PowersOf10[t]);
+}
+
+/// \internal
+static const unsigned int InterleaveBits_B[] = {0x55555555, 0x33333333, 0x0F0F0F0F, 0x00FF00FF};
+/// \internal
+static const unsigned int InterleaveBits_S[] = {1, 2, 4, 8};
+
+uint InterleaveBits(uint a, uint b)
+{
+	a = (a | (a << InterleaveBits_S[3])) & InterleaveBits_B[3];
+	a = (a | (a << InterleaveBits_S[2])) & InterleaveBits_B[2];
+	a = (a | (a << InterleaveBits_S[1])) & InterleaveBits_B[1];
+	a = (a | (a << InterleaveBits_S[0])) & InterleaveBits_B[0];
+
+	b = (b | (b << InterleaveBits_S[3])) & InterleaveBits_B[3];
+	b = (b | (b << InterleaveBits_S[2])) & InterleaveBits_B[2];
+	b = (b | (b << InterleaveBits_S[1])) & InterleaveBits_B[1];
+	b = (b | (b << InterleaveBits_S[0])) & InterleaveBits_B[0];
+
+	return a | (b << 1);
+}
+
+uint Extend10BitsBy2Zeros(uint n)
+{
+	// Na podstawie książki: Real-Time Collision Detection, Christer Ericson
+
+    // n = ----------------------9876543210 : Bits initially
+    // n = ------98----------------76543210 : After (1)
+    // n = ------98--------7654--------3210 : After (2)
+    // n = ------98----76----54----32----10 : After (3)
+    // n = ----9--8--7--6--5--4--3--2--1--0 : After (4)
+    n = (n ^ (n << 16)) & 0xff0000ff; // (1)
+    n = (n ^ (n <<  8)) & 0x0300f00f; // (2)
+    n = (n ^ (n <<  4)) & 0x030c30c3; // (3)
+    n = (n ^ (n <<  2)) & 0x09249249; // (4)
+    return n;
+}
+
+uint Extend16BitsBy1Zero(uint n)
+{
+	// Na podstawie książki: Real-Time Collision Detection, Christer Ericson
+
+    // n = ----------------fedcba9876543210 : Bits initially
+    // n = --------fedcba98--------76543210 : After (1)
+    // n = ----fedc----ba98----7654----3210 : After (2)
+    // n = --fe--dc--ba--98--76--54--32--10 : After (3)
+    // n = -f-e-d-c-b-a-9-8-7-6-5-4-3-2-1-0 : After (4)
+    n = (n ^ (n <<  8)) & 0x00ff00ff; // (1)
+    n = (n ^ (n <<  4)) & 0x0f0f0f0f; // (2)
+    n = (n ^ (n <<  2)) & 0x33333333; // (3)
+    n = (n ^ (n <<  1)) & 0x55555555; // (4)
+    return n;
+}
+
+void sincos(float angle, float *sine, float *cosine)
+{
+	#if defined(_WIN32) && !defined(_WIN64)
+		// Procedurę mam od: Karol Kuczmarski "Xion"
+		__asm
+		{
+			mov eax, sine
+			mov edx, cosine
+			fld     angle
+			fsincos
+			fstp    dword ptr [edx]
+			fstp    dword ptr [eax]
+		}
+
+	#else
+		*sine = sinf(angle);
+		*cosine = cosf(angle);
+
+	#endif
+}
+
+bool is_prime(unsigned n)
+{
+	if (n == 1) return false;
+	if (n < 4) return true; // 2 and 3 are prime
+	if (n % 2 == 0) return false;
+	if (n < 9) return true; // we have already excluded 4, 6 and 8.
+	if (n % 3 == 0) return false;
+	unsigned r = (unsigned)sqrt((double)n);
+	unsigned f = 5;
+	while (f <= r) {
+		if (n % f == 0) return false;
+		if (n % (f+2) == 0) return false;
+		f += 6;
+	}
+	return true;
+}
+
+// Funkcje SmoothCD są napisane na podstawie książki:
+// "Game Programming Gems", tom 4, rozdz. 1.10, str. 95.
+
+void SmoothCD(float *InOutPos, float Dest, float *InOutVel, float SmoothTime, float TimeDelta)
+{
+	float Omega = 2.f / SmoothTime;
+	float x = Omega * TimeDelta;
+	// Przybliżenie funkcji 1 / exp(x) dość dokładne dla wartości 0..1
+	float Exp = 1.f / (1.f + x + 0.48f * x * x + 0.235f * x * x * x);
+	float Change = *InOutPos - Dest;
+	float Temp = (*InOutVel + Omega * Change) * TimeDelta;
+	*InOutVel = (*InOutVel - Omega * Temp) * Exp;
+	*InOutPos = Dest + (Change + Temp) * Exp;
+}
+
+void SmoothCD(float *InOutPos, float Dest, float *InOutVel, float SmoothTime, float TimeDelta, float MaxSpeed)
+{
+	float Omega = 2.f / SmoothTime;
+	float x = Omega * TimeDelta;
+	// Przybliżenie funkcji 1 / exp(x) dość dokładne dla wartości 0..1
+	float Exp = 1.f / (1.f + x + 0.48f * x * x + 0.235f * x * x * x);
+	float Change = *InOutPos - Dest;
+	float MaxChange = MaxSpeed*SmoothTime;
+	Change = minmax(-MaxChange, Change, MaxChange);
+	float Temp = (*InOutVel + Omega * Change) * TimeDelta;
+	*InOutVel = (*InOutVel - Omega * Temp) * Exp;
+	*InOutPos = Dest + (Change + Temp) * Exp;
+}
+
+int QuadraticEquation(float a, float b, float c, float *Out_x1, float *Out_x2)
+{
+	float delta = (b * b) - (4.0f * a * c);
+	if (delta < 0.f)
+		return 0;
+	else if (FLOAT_ALMOST_ZERO(delta))
+	{
+		*Out_x1 = *Out_x2 = - b / (2.0f * a);
+		return 1;
+	}
+	else
+	{
+		float denominator = 1.0f / (2.0f * a);
+		float delta_sqr = sqrtf(delta);
+		*Out_x1 = (- b - delta_sqr) * denominator;
+		*Out_x2 = (- b + delta_sqr) * denominator;
+		return 2;
+	}
+}
+
+void CalcMeanAndVariance(const float Numbers[], size_t NumberCount, float *OutMean, float *OutVariance, bool VarianceBiased)
+{
+	CalcMeanAndVariance(Numbers, NumberCount, sizeof(float), OutMean, OutVariance, VarianceBiased);
+}
+
+void CalcMeanAndVariance(const void *NumberData, size_t NumberCount, ptrdiff_t NumberStride, float *OutMean, float *OutVariance, bool VarianceBiased)
+{
+	assert(NumberCount > 0);
+	const char *NumberBytes = (const char*)NumberData;
+	*OutMean = *(const float*)NumberBytes;
+	NumberBytes += NumberStride;
+
+	for (size_t i = 1; i < NumberCount; i++)
+	{
+		*OutMean += *(const float*)NumberBytes;
+		NumberBytes += NumberStride;
+	}
+
+	float NumberCountRcp = 1.0f / (float)NumberCount;
+	*OutMean *= NumberCountRcp;
+
+	if (OutVariance)
+	{
+		NumberBytes = (const char*)NumberData;
+		*OutVariance = (*(const float*)NumberBytes - *OutMean) * (*(const float*)NumberBytes - *OutMean);
+		NumberBytes += NumberStride;
+		float Tmp;
+
+		for (size_t i = 1; i < NumberCount; i++)
+		{
+			Tmp = *(const float*)NumberBytes - *OutMean;
+			*OutVariance += Tmp * Tmp;
+			NumberBytes += NumberStride;
+		}
+
+		if (VarianceBiased)
+			*OutVariance /= (float)(NumberCount - 1);
+		else
+			*OutVariance *= NumberCountRcp;
+	}
+}
+
+uint MurmurHash(const void *Data, uint DataLen, uint Seed)
+{
+	// Autor: Austin Appleby, http://murmurhash.googlepages.com/
+
+	// 'm' and 'r' are mixing constants generated offline.
+	// They're not really 'magic', they just happen to work well.
+	const unsigned int m = 0x5bd1e995;
+	const int r = 24;
+
+	// Initialize the hash to a 'random' value
+	unsigned int h = Seed ^ DataLen;
+
+	// Mix 4 bytes at a time into the hash
+	const unsigned char * data = (const unsigned char *)Data;
+
+	while(DataLen >= 4)
+	{
+		unsigned int k = *(unsigned int *)data;
+		k *= m; 
+		k ^= k >> r; 
+		k *= m; 
+		h *= m; 
+		h ^= k;
+		data += 4;
+		DataLen -= 4;
+	}
+
+	// Handle the last few bytes of the input array
+	switch(DataLen)
+	{
+	case 3: h ^= data[2] << 16;
+	case 2: h ^= data[1] << 8;
+	case 1: h ^= data[0];
+	h *= m;
+	};
+
+	// Do a few final mixes of the hash to ensure the last few
+	// bytes are well-incorporated.
+	h ^= h >> 13;
+	h *= m;
+	h ^= h >> 15;
+
+	return h;
+}
+
+#define get16bits(d) ((((uint)(((const uint8 *)(d))[1])) << 8)\
+                       +(uint)(((const uint8 *)(d))[0]) )
+
+uint SuperFastHash(const void *DataBytes, size_t DataLen)
+{
+	const char *data = (const char *)DataBytes;
+    assert(DataLen <= (size_t)UINT32_MAX);
+	uint hash = (uint)DataLen, tmp;
+	int rem;
+
+	assert(data != NULL && DataLen > 0);
+
+    rem = DataLen & 3;
+    DataLen >>= 2;
+
+    // Main loop
+    for (;DataLen > 0; DataLen--) {
+        hash  += get16bits (data);
+        tmp    = (get16bits (data+2) << 11) ^ hash;
+        hash   = (hash << 16) ^ tmp;
+        data  += 2*sizeof (uint16);
+        hash  += hash >> 11;
+    }
+
+    // Handle end cases
+    switch (rem) {
+        case 3: hash += get16bits (data);
+                hash ^= hash << 16;
+                hash ^= data[sizeof (uint16)] << 18;
+                hash += hash >> 11;
+                break;
+        case 2: hash += get16bits (data);
+                hash ^= hash << 11;
+                hash += hash >> 17;
+                break;
+        case 1: hash += *data;
+                hash ^= hash << 10;
+                hash += hash >> 1;
+    }
+
+    // Force "avalanching" of final 127 bits
+    hash ^= hash << 3;
+    hash += hash >> 5;
+    hash ^= hash << 4;
+    hash += hash >> 17;
+    hash ^= hash << 25;
+    hash += hash >> 6;
+
+    return hash;
+}
+
+#undef get16bits
+
+/*
+Szum Perlina (Perlin Noise) - algorytm na podstawie implementacji referencyjnej
+w języku Java - "Improved Noise reference implementation", Ken Perlin, 2002,
+http://mrl.nyu.edu/~perlin/noise/
+*/
+
+inline float Perlin_Fade(float t)
+{
+	return t * t * t * (t * (t * 6 - 15) + 10);
+}
+
+inline float Perlin_Lerp(float t, float a, float b)
+{
+	return a + t * (b - a);
+}
+
+inline float Perlin_Grad1(int hash, float x)
+{
+	// Convert lo 4 bits of hash code into 12 gradient directions
+	int h = hash & 15;
+	float u = h<8 ? x : 0.f, v = h<4 ? 0.f : h==12||h==14 ? x : 0.f;
+	return ((h&1) == 0 ? u : -u) + ((h&2) == 0 ? v : -v);
+}
+
+inline float Perlin_Grad2(int hash, float x, float y)
+{
+	// Convert lo 4 bits of hash code into 12 gradient directions
+	int h = hash & 15;
+	float u = h<8 ? x : y, v = h<4 ? y : h==12||h==14 ? x : 0.f;
+	return ((h&1) == 0 ? u : -u) + ((h&2) == 0 ? v : -v);
+}
+
+inline float Perlin_Grad3(int hash, float x, float y, float z)
+{
+	// Convert lo 4 bits of hash code into 12 gradient directions
+	int h = hash & 15;
+	float u = h<8 ? x : y, v = h<4 ? y : h==12||h==14 ? x : z;
+	return ((h&1) == 0 ? u : -u) + ((h&2) == 0 ? v : -v);
+}
+
+int Perlin_P[] = {
+	151,160,137,91,90,15,
+	131,13,201,95,96,53,194,233,7,225,140,36,103,30,69,142,8,99,37,240,21,10,23,
+	190, 6,148,247,120,234,75,0,26,197,62,94,252,219,203,117,35,11,32,57,177,33,
+	88,237,149,56,87,174,20,125,136,171,168, 68,175,74,165,71,134,139,48,27,166,
+	77,146,158,231,83,111,229,122,60,211,133,230,220,105,92,41,55,46,245,40,244,
+	102,143,54, 65,25,63,161, 1,216,80,73,209,76,132,187,208, 89,18,169,200,196,
+	135,130,116,188,159,86,164,100,109,198,173,186, 3,64,52,217,226,250,124,123,
+	5,202,38,147,118,126,255,82,85,212,207,206,59,227,47,16,58,17,182,189,28,42,
+	223,183,170,213,119,248,152, 2,44,154,163, 70,221,153,101,155,167, 43,172,9,
+	129,22,39,253, 19,98,108,110,79,113,224,232,178,185, 112,104,218,246,97,228,
+	251,34,242,193,238,210,144,12,191,179,162,241, 81,51,145,235,249,14,239,107,
+	49,192,214, 31,181,199,106,157,184, 84,204,176,115,121,50,45,127, 4,150,254,
+	138,236,205,93,222,114,67,29,24,72,243,141,128,195,78,66,215,61,156,180
+	,
+	151,160,137,91,90,15,
+	131,13,201,95,96,53,194,233,7,225,140,36,103,30,69,142,8,99,37,240,21,10,23,
+	190, 6,148,247,120,234,75,0,26,197,62,94,252,219,203,117,35,11,32,57,177,33,
+	88,237,149,56,87,174,20,125,136,171,168, 68,175,74,165,71,134,139,48,27,166,
+	77,146,158,231,83,111,229,122,60,211,133,230,220,105,92,41,55,46,245,40,244,
+	102,143,54, 65,25,63,161, 1,216,80,73,209,76,132,187,208, 89,18,169,200,196,
+	135,130,116,188,159,86,164,100,109,198,173,186, 3,64,52,217,226,250,124,123,
+	5,202,38,147,118,126,255,82,85,212,207,206,59,227,47,16,58,17,182,189,28,42,
+	223,183,170,213,119,248,152, 2,44,154,163, 70,221,153,101,155,167, 43,172,9,
+	129,22,39,253, 19,98,108,110,79,113,224,232,178,185, 112,104,218,246,97,228,
+	251,34,242,193,238,210,144,12,191,179,162,241, 81,51,145,235,249,14,239,107,
+	49,192,214, 31,181,199,106,157,184, 84,204,176,115,121,50,45,127, 4,150,254,
+	138,236,205,93,222,114,67,29,24,72,243,141,128,195,78,66,215,61,156,180
+};
+
+float PerlinNoise1(float x)
+{
+	// Find unit cube that contains point
+	int X = (int)x & 255;
+	// Find relative x,y,z of point in cube
+	x -= floorf(x);
+	// Compute Perlin_Fade curves for each x,y,z
+	float u = Perlin_Fade(x);
+	// Hash coordinates of the 8 cube corners
+	int A = Perlin_P[X  ], AA = Perlin_P[A];
+	int B = Perlin_P[X+1], BA = Perlin_P[B];
+
+	// and add blended results from 8 curners of cube
+	return Perlin_Lerp(u,
+		Perlin_Grad1(Perlin_P[AA  ], x   ),
+		Perlin_Grad1(Perlin_P[BA  ], x-1 ));
+}
+
+float PerlinNoise2(float x, float y)
+{
+	// Find unit cube that contains point
+	int X = (int)x & 255;
+	int Y = (int)y & 255;
+	// Find relative x,y,z of point in cube
+	x -= floorf(x);
+	y -= floorf(y);
+	// Compute Perlin_Fade curves for each x,y,z
+	float u = Perlin_Fade(x);
+	float v = Perlin_Fade(y);
+	// Hash coordinates of the 8 cube corners
+	int A = Perlin_P[X  ]+Y, AA = Perlin_P[A], AB = Perlin_P[A+1];
+	int B = Perlin_P[X+1]+Y, BA = Perlin_P[B], BB = Perlin_P[B+1];
+
+	// and add blended results from 8 curners of cube
+	return Perlin_Lerp(v,
+		Perlin_Lerp(u,
+			Perlin_Grad2(Perlin_P[AA  ], x  , y   ),
+			Perlin_Grad2(Perlin_P[BA  ], x-1, y   )),
+		Perlin_Lerp(u,
+			Perlin_Grad2(Perlin_P[AB  ], x  , y-1 ),
+			Perlin_Grad2(Perlin_P[BB  ], x-1, y-1 )));
+}
+
+float PerlinNoise3(float x, float y, float z)
+{
+	// Find unit cube that contains point
+	int X = (int)x & 255;
+	int Y = (int)y & 255;
+	int Z = (int)z & 255;
+	// Find relative x,y,z of point in cube
+	x -= floorf(x);
+	y -= floorf(y);
+	z -= floorf(z);
+	// Compute Perlin_Fade curves for each x,y,z
+	float u = Perlin_Fade(x);
+	float v = Perlin_Fade(y);
+	float w = Perlin_Fade(z);
+	// Hash coordinates of the 8 cube corners
+	int A = Perlin_P[X  ]+Y, AA = Perlin_P[A]+Z, AB = Perlin_P[A+1]+Z;
+	int B = Perlin_P[X+1]+Y, BA = Perlin_P[B]+Z, BB = Perlin_P[B+1]+Z;
+
+	// and add blended results from 8 curners of cube
+	return Perlin_Lerp(w,
+		Perlin_Lerp(v,
+			Perlin_Lerp(u,
+				Perlin_Grad3(Perlin_P[AA  ], x  , y  , z   ),
+				Perlin_Grad3(Perlin_P[BA  ], x-1, y  , z   )),
+			Perlin_Lerp(u,
+				Perlin_Grad3(Perlin_P[AB  ], x  , y-1, z   ),
+				Perlin_Grad3(Perlin_P[BB  ], x-1, y-1, z   ))),
+		Perlin_Lerp(v,
+			Perlin_Lerp(u,
+				Perlin_Grad3(Perlin_P[AA+1], x  , y  , z-1 ),
+				Perlin_Grad3(Perlin_P[BA+1], x-1, y  , z-1 )),
+			Perlin_Lerp(u,
+				Perlin_Grad3(Perlin_P[AB+1], x  , y-1, z-1 ),
+				Perlin_Grad3(Perlin_P[BB+1], x-1, y-1, z-1 ))));
+}
+
+float BrownianNoise1(float x, uint i, float Persistence)
+{
+	float R = 0.f;
+	float Frequency = 1.f, Amplitude = 1.f;
+	for (uint j = 0; j < i; j++)
+	{
+		R += PerlinNoise1(x * Frequency) * Amplitude;
+		Frequency *= 2.f;
+		Amplitude *= Persistence;
+	}
+	return R;
+}
+
+float BrownianNoise2(float x, float y, uint i, float Persistence)
+{
+	float R = 0.f;
+	float Frequency = 1.f, Amplitude = 1.f;
+	for (uint j = 0; j < i; j++)
+	{
+		R += PerlinNoise2(x * Frequency, y * Frequency) * Amplitude;
+		Frequency *= 2.f;
+		Amplitude *= Persistence;
+	}
+	return R;
+}
+
+float BrownianNoise3(float x, float y, float z, uint i, float Persistence)
+{
+	float R = 0.f;
+	float Frequency = 1.f, Amplitude = 1.f;
+	for (uint j = 0; j < i; j++)
+	{
+		R += PerlinNoise3(x * Frequency, y * Frequency, z * Frequency) * Amplitude;
+		Frequency *= 2.f;
+		Amplitude *= Persistence;
+	}
+	return R;
+}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// GENERATOR LICZB PSEUDOLOSOWYCH
+
+RandomGenerator::RandomGenerator() :
+	m_HasNextNormalNumber(false)
+{
+	m_Seed = (uint32)time(0);
+}
+
+void RandomGenerator::RandData(void *OutData, size_t DataLength)
+{
+	size_t WordCount = DataLength >> 2;
+	size_t RemainingBytes = DataLength & 0x3;
+
+	uint *OutWords = (uint*)OutData;
+	while (WordCount > 0)
+	{
+		*OutWords = RandUint();
+		OutWords++;
+		WordCount--;
+	}
+
+	if (RemainingBytes > 0)
+	{
+		uint x = RandUint();
+		uint8 *OutBytes = (uint8*)OutWords;
+		switch (RemainingBytes)
+		{
+		case 3:
+			*OutBytes = (x >> 23) & 0xFF; // Te przesunięcia bitowe są przypadkowe
+			OutBytes++;
+		case 2:
+			*OutBytes = (x >> 9) & 0xFF;
+			OutBytes++;
+		case 1:
+			*OutBytes = x & 0xFF;
+		}
+	}
+}
+
+float RandomGenerator::RandNormal(float sigma)
+{
+	// Nowa implementacja
+	// The polar form of the Box-Muller transformation
+	// Źródło: http://www.taygeta.com/random/gaussian.html
+	// Ten algorytm generuje dwie liczby na raz, więc jedną zwraca od razu, a drugą
+	// zapamiętuje do następnego wywołania tej metody.
+	if (m_HasNextNormalNumber)
+	{
+		m_HasNextNormalNumber = false;
+		return m_NextNormalNumber * sigma;
+	}
+	else
+	{
+		float x1, x2, w;
+		do {
+			x1 = 2.0f * RandFloat() - 1.0f;
+			x2 = 2.0f * RandFloat() - 1.0f;
+			w = x1 * x1 + x2 * x2;
+		} while (w >= 1.0f);
+		w = sqrtf((-2.0f * logf(w)) / w);
+		m_NextNormalNumber = x2 * w; // Druga wygenerowana liczba
+		m_HasNextNormalNumber = true;
+		return x1 * w * sigma; // Pierwsza wygenerowana liczba
+	}
+
+	// Stara implementacja
+/*	float u1 = RandFloat(), u2 = RandFloat();
+	float z = sqrtf(-2.0f*log(u1)) * cosf(2*PI*u2);
+	if (RandBool())
+		return z * sigma;
+	else
+		return -z * sigma;*/
+}
+
+RandomGenerator g_Rand;
+
+
+#define MERSENNE_N 624
+#define MERSENNE_M 397
+#define MERSENNE_MATRIX_A 0x9908b0dfUL   /* constant vector a */
+#define MERSENNE_UMASK 0x80000000UL /* most significant w-r bits */
+#define MERSENNE_LMASK 0x7fffffffUL /* least significant r bits */
+#define MERSENNE_MIXBITS(u,v) ( ((u) & MERSENNE_UMASK) | ((v) & MERSENNE_LMASK) )
+#define MERSENNE_TWIST(u,v) ((MERSENNE_MIXBITS(u,v) >> 1) ^ ((v)&1U ? MERSENNE_MATRIX_A : 0U))
+
+MersenneTwister::MersenneTwister()
+{
+	Init((uint32)time(0));
+}
+
+MersenneTwister::MersenneTwister(uint Seed)
+{
+	Init(Seed);
+}
+
+MersenneTwister::MersenneTwister(uint InitKeys[], int KeyCount)
+{
+	int i, j, k;
+	Init(19650218U);
+	i=1; j=0;
+	k = (MERSENNE_N>KeyCount ? MERSENNE_N : KeyCount);
+	for (; k; k--)
+	{
+		m_State[i] = (m_State[i] ^ ((m_State[i-1] ^ (m_State[i-1] >> 30)) * 1664525U)) + InitKeys[j] + j;
+		m_State[i] &= 0xffffffffU;
+		i++; j++;
+		if (i>=MERSENNE_N) { m_State[0] = m_State[MERSENNE_N-1]; i=1; }
+		if (j>=KeyCount) j=0;
+	}
+	for (k=MERSENNE_N-1; k; k--)
+	{
+		m_State[i] = (m_State[i] ^ ((m_State[i-1] ^ (m_State[i-1] >> 30)) * 1566083941U)) - i;
+		//m_State[i] &= 0xffffffffU; /* for WORDSIZE > 32 machines */
+		i++;
+		if (i>=MERSENNE_N) { m_State[0] = m_State[MERSENNE_N-1]; i=1; }
+	}
+
+	m_State[0] = 0x80000000UL; /* MSB is 1; assuring non-zero initial array */ 
+	m_Left = 1;
+}
+
+void MersenneTwister::Init(uint Seed)
+{
+	int j;
+	m_State[0] = Seed & 0xffffffffU;
+	for (j=1; j<MERSENNE_N; j++)
+	{
+		m_State[j] = (1812433253U * (m_State[j-1] ^ (m_State[j-1] >> 30)) + j); 
+		m_State[j] &= 0xffffffffU;
+	}
+	m_Left = 1;
+}
+
+void MersenneTwister::NextState()
+{
+	unsigned *p=m_State;
+	int j;
+
+	m_Left = MERSENNE_N;
+	m_Next = m_State;
+
+	for (j=MERSENNE_N-MERSENNE_M+1; --j; p++) 
+		*p = p[MERSENNE_M] ^ MERSENNE_TWIST(p[0], p[1]);
+
+	for (j=MERSENNE_M; --j; p++) 
+		*p = p[MERSENNE_M-MERSENNE_N] ^ MERSENNE_TWIST(p[0], p[1]);
+
+	*p = p[MERSENNE_M-MERSENNE_N] ^ MERSENNE_TWIST(p[0], m_State[0]);
+}
+
+uint MersenneTwister::NextUint()
+{
+	unsigned y;
+
+	if (--m_Left == 0) NextState();
+	y = *m_Next++;
+
+	y ^= (y >> 11);
+	y ^= (y << 7) & 0x9d2c5680U;
+	y ^= (y << 15) & 0xefc60000U;
+	y ^= (y >> 18);
+
+	return y;
+}
+
+int MersenneTwister::NextInt31()
+{
+	unsigned y;
+
+	if (--m_Left == 0) NextState();
+	y = *m_Next++;
+
+	y ^= (y >> 11);
+	y ^= (y << 7) & 0x9d2c5680U;
+	y ^= (y << 15) & 0xefc60000U;
+	y ^= (y >> 18);
+
+	return (int)(y>>1);
+}
+
+double MersenneTwister::NextReal1()
+{
+	unsigned y;
+
+	if (--m_Left == 0) NextState();
+	y = *m_Next++;
+
+	y ^= (y >> 11);
+	y ^= (y << 7) & 0x9d2c5680U;
+	y ^= (y << 15) & 0xefc60000U;
+	y ^= (y >> 18);
+
+	return (double)y * (1.0/4294967295.0); 
+	// divided by 2^32-1
+}
+
+double MersenneTwister::NextReal2()
+{
+	unsigned y;
+
+	if (--m_Left == 0) NextState();
+	y = *m_Next++;
+
+	y ^= (y >> 11);
+	y ^= (y << 7) & 0x9d2c5680U;
+	y ^= (y << 15) & 0xefc60000U;
+	y ^= (y >> 18);
+
+	return (double)y * (1.0/4294967296.0); 
+	// divided by 2^32
+}
+
+double MersenneTwister::NextReal3()
+{
+	unsigned y;
+
+	if (--m_Left == 0) NextState();
+	y = *m_Next++;
+
+	y ^= (y >> 11);
+	y ^= (y << 7) & 0x9d2c5680U;
+	y ^= (y << 15) & 0xefc60000U;
+	y ^= (y >> 18);
+
+	return ((double)y + 0.5) * (1.0/4294967296.0); 
+	// divided by 2^32
+}
+
+double MersenneTwister::NextReal_Res53()
+{
+	unsigned a=NextUint()>>5, b=NextUint()>>6; 
+	return(a*67108864.0+b)*(1.0/9007199254740992.0); 
+}
+
+
+UniqueGenerator::UniqueGenerator() :
+	m_Next(1)
+{
+}
+
+UniqueGenerator::UniqueGenerator(uint32 First) :
+	m_Next(First)
+{
+}
+
+void UniqueGenerator::GetString(tstring *Out)
+{
+	UintToStr2(Out, m_Next, 8, 16);
+	m_Next++;
+}
+
+void UniqueGenerator::GetString(tstring *Out, const tstring &Prefix)
+{
+	tstring s;
+	UintToStr2(&s, m_Next, 8, 16);
+
+	*Out = Prefix;
+	*Out += s;
+
+	m_Next++;
+}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Parser wiersza poleceń
+
+class CmdLineParser_pimpl
+{
+private:
+	struct SHORT_OPT
+	{
+		uint Id;
+		tchar Opt;
+		bool Parameter;
+
+		SHORT_OPT(uint Id, tchar Opt, bool Parameter) : Id(Id), Opt(Opt), Parameter(Parameter) { }
+	};
+
+	struct LONG_OPT
+	{
+		uint Id;
+		tstring Opt;
+		bool Parameter;
+
+		LONG_OPT(uint Id, tstring Opt, bool Parameter) : Id(Id), Opt(Opt), Parameter(Parameter) { }
+	};
+
+	// ==== Warstwa I ====
+
+	// Zawsze niezerowe jest albo m_argv, albo m_CmdLine.
+	tchar **m_argv;
+	const tchar *m_CmdLine;
+	// Ważne tylko, jeśli m_argv != NULL
+	int m_argc;
+	// Ważne tylko jeśli m_CmdLine != NULL
+	size_t m_CmdLineLength;
+	// Jeśli m_argv != NULL, przechowuje indeks następnego argumentu w m_argv.
+	// Jeśli m_CmdLine != NULL, przechowuje indeks następnego znaku w m_CmdLine.
+	size_t m_ArgIndex;
+
+	// Zwraca następny argumet
+	// Zwraca false, jeśli nie odczytano następnego argumentu, bo już koniec.
+	bool ReadNextArg(tstring *OutArg);
+
+	// ==== Zarejestrowane argumenty ====
+
+	std::vector<SHORT_OPT> m_ShortOpts;
+	std::vector<LONG_OPT> m_LongOpts;
+
+	// Zwraca wskaźnk do struktury ze znalezioną opcją lub NULL jeśli nie znalazł
+	SHORT_OPT * FindShortOpt(tchar Opt);
+	LONG_OPT * FindLongOpt(const tstring &Opt);
+
+	// ==== Warstwa II ====
+
+	// Stan - czy jesteśmy wewnąrz parsowania ciągu połączonych opcji jednoznakowych
+	bool m_InsideMultioption;
+	// Zapamiętany ostatnio pobrany argument - tylko jeśli m_InsideMultioption == true
+	tstring m_LastArg;
+	// Indeks następnego znaku do sparsowania w tym argumencie - tylko jeśli m_InsideMultioption == true
+	size_t m_LastArgIndex;
+	// Dane do zwracania w związku z ostatnio odczytaną informacją
+	uint m_LastOptId;
+	tstring m_LastParameter;
+
+public:
+	CmdLineParser_pimpl(int argc, tchar **argv);
+	CmdLineParser_pimpl(const tchar *CmdLine);
+
+	void RegisterOpt(uint Id, tchar Opt, bool Parameter);
+	void RegisterOpt(uint Id, const tstring &Opt, bool Parameter);
+
+	CmdLineParser::RESULT ReadNext();
+	uint GetOptId();
+	const tstring & GetParameter();
+};
+
+bool CmdLineParser_pimpl::ReadNextArg(tstring *OutArg)
+{
+	if (m_argv != NULL)
+	{
+		if (m_ArgIndex >= (size_t)m_argc) return false;
+
+		*OutArg = m_argv[m_ArgIndex];
+		m_ArgIndex++;
+		return true;
+	}
+	else
+	{
+		if (m_ArgIndex >= m_CmdLineLength) return false;
+		
+		// Algorytm parsowania opracowany na podstawie dogłębnych badań zachowania wiersza poleceń Windows
+		// z różnymi dziwnymi kombinacjami znaków w parametrach i sposobu ich przetwarzania na argc i argv
+		// przekazywane przez system do main().
+		OutArg->clear();
+		bool InsideQuotes = false;
+		while (m_ArgIndex < m_CmdLineLength)
+		{
+			tchar Ch = m_CmdLine[m_ArgIndex];
+			if (Ch == _T('\\'))
+			{
+				// Analiza dalszego ciągu łańcucha
+				bool FollowedByQuote = false; // wynik analizy 1
+				size_t BackslashCount = 1; // wynik analizy 2
+				size_t TmpIndex = m_ArgIndex + 1;
+				while (TmpIndex < m_CmdLineLength)
+				{
+					tchar TmpCh = m_CmdLine[TmpIndex];
+					if (TmpCh == _T('\\'))
+					{
+						BackslashCount++;
+						TmpIndex++;
+					}
+					else if (TmpCh == _T('"'))
+					{
+						FollowedByQuote = true;
+						break;
+					}
+					else
+						break;
+				}
+
+				// Stosowne do wyników analizy dalsze postępowanie
+				if (FollowedByQuote)
+				{
+					// Parzysta liczba '\'
+					if (BackslashCount % 2 == 0)
+					{
+						for (size_t i = 0; i < BackslashCount / 2; i++)
+							*OutArg += _T('\\');
+						m_ArgIndex += BackslashCount + 1;
+						InsideQuotes = !InsideQuotes;
+					}
+					// Nieparzysta liczba '\'
+					else
+					{
+						for (size_t i = 0; i < BackslashCount / 2; i++)
+							*OutArg += _T('\\');
+						*OutArg += _T('"');
+						m_ArgIndex += BackslashCount + 1;
+					}
+				}
+				else
+				{
+					for (size_t i = 0; i < BackslashCount; i++)
+						*OutArg += _T('\\');
+					m_ArgIndex += BackslashCount;
+				}
+			}
+			else if (Ch == _T('"'))
+			{
+				InsideQuotes = !InsideQuotes;
+				m_ArgIndex++;
+			}
+			else if (CharIsWhitespace(Ch))
+			{
+				if (InsideQuotes)
+				{
+					*OutArg += Ch;
+					m_ArgIndex++;
+				}
+				else
+				{
+					m_ArgIndex++;
+					break;
+				}
+			}
+			else
+			{
+				*OutArg += Ch;
+				m_ArgIndex++;
+			}
+		}
+
+		// Pomiń dodatkowe odstępy
+		while (m_ArgIndex < m_CmdLineLength && CharIsWhitespace(m_CmdLine[m_ArgIndex]))
+			m_ArgIndex++;
+
+		return true;
+	}
+}
+
+CmdLineParser_pimpl::SHORT_OPT * CmdLineParser_pimpl::FindShortOpt(tchar Opt)
+{
+	for (size_t i = 0; i < m_ShortOpts.size(); i++)
+		if (m_ShortOpts[i].Opt == Opt)
+			return &m_ShortOpts[i];
+	return NULL;
+}
+
+CmdLineParser_pimpl::LONG_OPT * CmdLineParser_pimpl::FindLongOpt(const tstring &Opt)
+{
+	for (size_t i = 0; i < m_LongOpts.size(); i++)
+		if (m_LongOpts[i].Opt == Opt)
+			return &m_LongOpts[i];
+	return NULL;
+}
+
+CmdLineParser_pimpl::CmdLineParser_pimpl(int argc, tchar **argv) :
+	m_argv(argv),
+	m_CmdLine(NULL),
+	m_argc(argc),
+	m_CmdLineLength(0),
+	m_ArgIndex(1),
+	m_InsideMultioption(false),
+	m_LastArgIndex(0),
+	m_LastOptId(0)
+{
+	assert(argc > 0);
+	assert(argv != NULL);
+}
+
+CmdLineParser_pimpl::CmdLineParser_pimpl(const tchar *CmdLine) :
+	m_argv(NULL),
+	m_CmdLine(CmdLine),
+	m_argc(0),
+	m_ArgIndex(0),
+	m_InsideMultioption(false),
+	m_LastArgIndex(0),
+	m_LastOptId(0)
+{
+	assert(CmdLine != NULL);
+
+#ifdef _UNICODE
+	m_CmdLineLength = _tcslen(m_CmdLine);
+#else
+	m_CmdLineLength = strlen(m_CmdLine);
+#endif
+
+	// Pomiń początkowe odstępy
+	while (m_ArgIndex < m_CmdLineLength && CharIsWhitespace(m_CmdLine[m_ArgIndex]))
+		m_ArgIndex++;
+}
+
+void CmdLineParser_pimpl::RegisterOpt(uint Id, tchar Opt, bool Parameter)
+{
+	assert(Opt != _T('\0'));
+
+	m_ShortOpts.push_back(SHORT_OPT(Id, Opt, Parameter));
+}
+
+void CmdLineParser_pimpl::RegisterOpt(uint Id, const tstring &Opt, bool Parameter)
+{
+	assert(!Opt.empty());
+	
+	m_LongOpts.push_back(LONG_OPT(Id, Opt, Parameter));
+}
+
+CmdLineParser::RESULT CmdLineParser_pimpl::ReadNext()
+{
+	if (m_InsideMultioption)
+	{
+		// Łańcuch rozpoczynający się od m_LastArg[m_LastArgIndex] jest krótką opcją - jeden znak, dalej mogą być różne rzeczy.
+		assert(m_LastArgIndex < m_LastArg.length());
+		SHORT_OPT *so = FindShortOpt(m_LastArg[m_LastArgIndex]);
+		// Nie ma takiej opcji - błąd
+		if (so == NULL)
+		{
+			m_LastOptId = 0;
+			m_LastParameter.clear();
+			return CmdLineParser::RESULT_ERROR;
+		}
+		// Ta opcja powinna mieć parametr
+		if (so->Parameter)
+		{
+			// Co jest dalej?
+			// Dalej nie ma nic
+			if (m_LastArg.length() == m_LastArgIndex+1)
+			{
+				// Następny argument to parameter - wczytaj go prosto tam gdzie trzeba
+				if (!ReadNextArg(&m_LastParameter))
+				{
+					// Nie ma następnego argumentu, a oczekiwany jest parametr - błąd
+					m_LastOptId = 0;
+					m_LastParameter.clear();
+					return CmdLineParser::RESULT_ERROR;
+				}
+				m_InsideMultioption = false;
+				m_LastOptId = so->Id;
+				return CmdLineParser::RESULT_OPT;
+			}
+			// Dalej jest '='
+			else if (m_LastArg[m_LastArgIndex+1] == '=')
+			{
+				m_InsideMultioption = false;
+				m_LastParameter = m_LastArg.substr(m_LastArgIndex+2);
+				m_LastOptId = so->Id;
+				return CmdLineParser::RESULT_OPT;
+			}
+			// Dalej jest coś innego - to bezpośrednio parametr
+			else
+			{
+				m_InsideMultioption = false;
+				m_LastParameter = m_LastArg.substr(m_LastArgIndex+1);
+				m_LastOptId = so->Id;
+				return CmdLineParser::RESULT_OPT;
+			}
+		}
+		// Ta opcja nie powinna mieć parametru
+		else
+		{
+			// Koniec
+			if (m_LastArg.length() == m_LastArgIndex+1)
+			{
+				m_InsideMultioption = false;
+				m_LastParameter.clear();
+				m_LastOptId = so->Id;
+				return CmdLineParser::RESULT_OPT;
+			}
+			// Nie koniec - następne parametry w tej samej komendzie - dalej ten specjalny stan!
+			else
+			{
+				// m_InsideMultioption = true; - pozostaje
+				// m_LastArg pozostaje wypełniony
+				m_LastArgIndex++;
+
+				m_LastParameter.clear();
+				m_LastOptId = so->Id;
+				return CmdLineParser::RESULT_OPT;
+			}
+		}
+	}
+	else
+	{
+		// Pobierz następny argument
+		// Użyjemy tu sobie m_LastArg, bo i czemu nie - dopóki m_InsideMultioption == false, i tak jest nieistotny.
+		if (!ReadNextArg(&m_LastArg))
+		{
+			// Koniec
+			m_LastParameter.clear();
+			m_LastOptId = 0;
+			return CmdLineParser::RESULT_END;
+		}
+		
+		// Sprawdź pierwszy znak
+		// - Zaczyna się od '-'
+		if (!m_LastArg.empty() && m_LastArg[0] == _T('-'))
+		{
+			// Zaczyna się od '--'
+			if (m_LastArg.length() > 1 && m_LastArg[1] == _T('-'))
+			{
+				size_t EqualIndex = m_LastArg.find(_T('='), 2);
+				// Jest znak '='
+				if (EqualIndex != tstring::npos)
+				{
+					// To ma być długa opcja "--nazwa=param"
+					LONG_OPT *lo = FindLongOpt(m_LastArg.substr(2, EqualIndex-2));
+					// Jeśli nie ma takiej długiej opcji - błąd
+					// Ta opcja musi oczekiwać parametru skoro jest '=' - jeśli nie oczekuje, to błąd
+					if (lo == NULL || lo->Parameter == false)
+					{
+						m_LastOptId = 0;
+						m_LastParameter.clear();
+						return CmdLineParser::RESULT_ERROR;
+					}
+					m_LastParameter = m_LastArg.substr(EqualIndex+1);
+					m_LastOptId = lo->Id;
+					return CmdLineParser::RESULT_OPT;
+				}
+				// Nie ma znaku '='
+				else
+				{
+					// To ma być długa opcja "--nazwa" lub "--nazwa param"
+					LONG_OPT *lo = FindLongOpt(m_LastArg.substr(2));
+					// Jeśli nie ma takiej długiej opcji - błąd
+					if (lo == NULL)
+					{
+						m_LastOptId = 0;
+						m_LastParameter.clear();
+						return CmdLineParser::RESULT_ERROR;
+					}
+					// Jeśli ta opcja oczekuje parametru
+					if (lo->Parameter)
+					{
+						// Następny argument to parameter - wczytaj go prosto tam gdzie trzeba
+						if (!ReadNextArg(&m_LastParameter))
+						{
+							// Nie ma następnego argumentu, a oczekiwany jest parametr - błąd
+							m_LastOptId = 0;
+							m_LastParameter.clear();
+							return CmdLineParser::RESULT_ERROR;
+						}
+					}
+					// Nie oczekuje parametru
+					else
+						m_LastParameter.clear();
+					// Koniec - sukces
+					m_LastOptId = lo->Id;
+					return CmdLineParser::RESULT_OPT;
+				}
+			}
+			// Zaczyna się od samego '-'
+			else
+			{
+				// Krótka opcja
+				// To jest opcja jednoznakowa. Dalej mogą być różne rzeczy
+				// Samo '-' - błąd
+				if (m_LastArg.length() < 2)
+				{
+					m_LastOptId = 0;
+					m_LastParameter.clear();
+					return CmdLineParser::RESULT_ERROR;
+				}
+				SHORT_OPT *so = FindShortOpt(m_LastArg[1]);
+				// Nie ma takiej opcji - błąd
+				if (so == NULL)
+				{
+					m_LastOptId = 0;
+					m_LastParameter.clear();
+					return CmdLineParser::RESULT_ERROR;
+				}
+				// Ta opcja powinna mieć parametr
+				if (so->Parameter)
+				{
+					// Co jest dalej?
+					// Dalej nie ma nic
+					if (m_LastArg.length() == 2)
+					{
+						// Następny argument to parameter - wczytaj go prosto tam gdzie trzeba
+						if (!ReadNextArg(&m_LastParameter))
+						{
+							// Nie ma następnego argumentu, a oczekiwany jest parametr - błąd
+							m_LastOptId = 0;
+							m_LastParameter.clear();
+							return CmdLineParser::RESULT_ERROR;
+						}
+						m_LastOptId = so->Id;
+						return CmdLineParser::RESULT_OPT;
+					}
+					// Dalej jest '='
+					else if (m_LastArg[2] == _T('='))
+					{
+						m_LastParameter = m_LastArg.substr(3);
+						m_LastOptId = so->Id;
+						return CmdLineParser::RESULT_OPT;
+					}
+					// Dalej jest coś innego - to bezpośrednio parametr
+					else
+					{
+						m_LastParameter = m_LastArg.substr(2);
+						m_LastOptId = so->Id;
+						return CmdLineParser::RESULT_OPT;
+					}
+				}
+				// Ta opcja nie powinna mieć parametru
+				else
+				{
+					// Koniec
+					if (m_LastArg.length() == 2)
+					{
+						m_LastParameter.clear();
+						m_LastOptId = so->Id;
+						return CmdLineParser::RESULT_OPT;
+					}
+					// Nie koniec - następne parametry w tej samej komendzie - specjalny stan!
+					else
+					{
+						m_InsideMultioption = true;
+						// m_LastArg już wypełniony
+						m_LastArgIndex = 2;
+
+						m_LastParameter.clear();
+						m_LastOptId = so->Id;
+						return CmdLineParser::RESULT_OPT;
+					}
+				}
+			}
+		}
+		// - Zaczyna się od '/'
+		else if (!m_LastArg.empty() && m_LastArg[0] == _T('/'))
+		{
+			size_t EqualIndex = m_LastArg.find(_T('='), 1);
+			// Jest znak '='
+			if (EqualIndex != tstring::npos)
+			{
+				// To ma być krótka lub długa opcja "/nazwa=param"
+				// To może być krótka
+				if (EqualIndex == 2)
+				{
+					SHORT_OPT *so = FindShortOpt(m_LastArg[1]);
+					// Znaleziono krótką opcję
+					if (so != NULL)
+					{
+						// Ta opcja musi oczekiwać parametru skoro jest '=' - jeśli nie oczekuje, to błąd
+						if (so->Parameter == false)	
+						{
+							m_LastOptId = 0;
+							m_LastParameter.clear();
+							return CmdLineParser::RESULT_ERROR;
+						}
+						m_LastParameter = m_LastArg.substr(EqualIndex+1);
+						m_LastOptId = so->Id;
+						return CmdLineParser::RESULT_OPT;
+					}
+				}
+				// To nie jest krótka opcja bo nazwa za długa lub bo nie znaleziono takiej krótkiej - to musi być długa opcja
+				LONG_OPT *lo = FindLongOpt(m_LastArg.substr(1, EqualIndex-1));
+				// Jeśli nie ma takiej długiej opcji - błąd
+				// Ta opcja musi oczekiwać parametru skoro jest '=' - jeśli nie oczekuje, to błąd
+				if (lo == NULL || lo->Parameter == false)
+				{
+					m_LastOptId = 0;
+					m_LastParameter.clear();
+					return CmdLineParser::RESULT_ERROR;
+				}
+				m_LastParameter = m_LastArg.substr(EqualIndex+1);
+				m_LastOptId = lo->Id;
+				return CmdLineParser::RESULT_OPT;
+			}
+			// Nie ma znaku '='
+			else
+			{
+				// To ma być krótka lub długa opcja "/nazwa" lub "/nazwa param"
+				// To może być krótka opcja
+				if (m_LastArg.length() == 2)
+				{
+					SHORT_OPT *so = FindShortOpt(m_LastArg[1]);
+					// Znaleziono krótką opcję
+					if (so != NULL)
+					{
+						// Jeśli ta opcja oczekuje parametru
+						if (so->Parameter)
+						{
+							// Następny argument to parameter - wczytaj go prosto tam gdzie trzeba
+							if (!ReadNextArg(&m_LastParameter))
+							{
+								// Nie ma następnego argumentu, a oczekiwany jest parametr - błąd
+								m_LastOptId = 0;
+								m_LastParameter.clear();
+								return CmdLineParser::RESULT_ERROR;
+							}
+						}
+						// Nie ma parametru
+						else
+							m_LastParameter.clear();
+						// Koniec - sukces
+						m_LastOptId = so->Id;
+						return CmdLineParser::RESULT_OPT;
+					}
+				}
+				// To nie jest krótka opcja bo nazwa za długa lub bo nie znaleziono takiej krótkiej - to musi być długa opcja
+				LONG_OPT *lo = FindLongOpt(m_LastArg.substr(1));
+				// Jeśli nie ma takiej długiej opcji - błąd
+				if (lo == NULL)
+				{
+					m_LastOptId = 0;
+					m_LastParameter.clear();
+					return CmdLineParser::RESULT_ERROR;
+				}
+				// Jeśli ta opcja oczekuje parametru
+				if (lo->Parameter)
+				{
+					// Następny argument to parameter - wczytaj go prosto tam gdzie trzeba
+					if (!ReadNextArg(&m_LastParameter))
+					{
+						// Nie ma następnego argumentu, a oczekiwany jest parametr - błąd
+						m_LastOptId = 0;
+						m_LastParameter.clear();
+						return CmdLineParser::RESULT_ERROR;
+					}
+				}
+				// Nie ma parametru
+				else
+					m_LastParameter.clear();
+				// Koniec - sukces
+				m_LastOptId = lo->Id;
+				return CmdLineParser::RESULT_OPT;
+			}
+		}
+		// - Zaczyna się od innego znaku lub jest pusty
+		else
+		{
+			// To jest goły parametr bez opcji
+			m_LastOptId = 0;
+			m_LastParameter = m_LastArg;
+			return CmdLineParser::RESULT_PARAMETER;
+		}
+	}
+}
+
+uint CmdLineParser_pimpl::GetOptId()
+{
+	return m_LastOptId;
+}
+
+const tstring & CmdLineParser_pimpl::GetParameter()
+{
+	return m_LastParameter;
+}
+
+CmdLineParser::CmdLineParser(int argc, tchar **argv) :
+	pimpl(new CmdLineParser_pimpl(argc, argv))
+{
+}
+
+CmdLineParser::CmdLineParser(const tchar *CmdLine) :
+	pimpl(new CmdLineParser_pimpl(CmdLine))
+{
+}
+
+CmdLineParser::~CmdLineParser()
+{
+	pimpl.reset();
+}
+
+void CmdLineParser::RegisterOpt(uint Id, tchar Opt, bool Parameter)
+{
+	pimpl->RegisterOpt(Id, Opt, Parameter);
+}
+
+void CmdLineParser::RegisterOpt(uint Id, const tstring &Opt, bool Parameter)
+{
+	pimpl->RegisterOpt(Id, Opt, Parameter);
+}
+
+CmdLineParser::RESULT CmdLineParser::ReadNext()
+{
+	return pimpl->ReadNext();
+}
+
+uint CmdLineParser::GetOptId()
+{
+	return pimpl->GetOptId();
+}
+
+const tstring & CmdLineParser::GetParameter()
+{
+	return pimpl->GetParameter();
+}
+
+const CommonGUID CommonGUID::NIL = CommonGUID(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+
+int CommonGUID::Cmp(const CommonGUID &v1, const CommonGUID &v2)
+{
+	int v;
+	for (uint i = 16; i--; )
+	{
+		v = (int)v1.Data[i] - (int)v2.Data[i];
+		if (v != 0) return v;
+	}
+	return 0;
+}
+
+CommonGUID::CommonGUID(uint8 v0, uint8 v1, uint8 v2, uint8 v3, uint8 v4, uint8 v5, uint8 v6, uint8 v7, uint8 v8, uint8 v9, uint8 v10, uint8 v11, uint8 v12, uint8 v13, uint8 v14, uint8 v15)
+{
+	Data[ 0] = v0;  Data[ 1] = v1;  Data[ 2] =  v2; Data[ 3] = v3;
+	Data[ 4] = v4;  Data[ 5] = v5;  Data[ 6] =  v6; Data[ 7] = v7;
+	Data[ 8] = v8;  Data[ 9] = v9;  Data[10] = v10; Data[11] = v11;
+	Data[12] = v12; Data[13] = v13; Data[14] = v14; Data[15] = v15;
+}
+
+void CommonGUID::ToString(tchar *out) const
+{
+#ifdef _UNICODE
+	swprintf_s(out, 37, L"%02X%02X%02X%02X-%02X%02X-%02X%02X-%02X%02X-%02X%02X%02X%02X%02X%02X",
+		(int)Data[15], (int)Data[14], (int)Data[13], (int)Data[12],
+		(int)Data[11], (int)Data[10], (int)Data[ 9], (int)Data[ 8],
+		(int)Data[ 7], (int)Data[ 6], (int)Data[ 5], (int)Data[ 4],
+		(int)Data[ 3], (int)Data[ 2], (int)Data[ 1], (int)Data[ 0] );
+#elif defined(_MSC_VER)
+	sprintf_s(out, 37, "%02X%02X%02X%02X-%02X%02X-%02X%02X-%02X%02X-%02X%02X%02X%02X%02X%02X",
+		(int)Data[15], (int)Data[14], (int)Data[13], (int)Data[12],
+		(int)Data[11], (int)Data[10], (int)Data[ 9], (int)Data[ 8],
+		(int)Data[ 7], (int)Data[ 6], (int)Data[ 5], (int)Data[ 4],
+		(int)Data[ 3], (int)Data[ 2], (int)Data[ 1], (int)Data[ 0] );
+#else
+	sprintf(out, "%02X%02X%02X%02X-%02X%02X-%02X%02X-%02X%02X-%02X%02X%02X%02X%02X%02X",
+		(int)Data[15], (int)Data[14], (int)Data[13], (int)Data[12],
+		(int)Data[11], (int)Data[10], (int)Data[ 9], (int)Data[ 8],
+		(int)Data[ 7], (int)Data[ 6], (int)Data[ 5], (int)Data[ 4],
+		(int)Data[ 3], (int)Data[ 2], (int)Data[ 1], (int)Data[ 0] );
+#endif
+}
+
+void CommonGUID::ToString(tstring &out) const
+{
+	tchar buf[37];
+	ToString(buf);
+	out = buf;
+}
+
+void CommonGUID::GenerateVersion4()
+{
+	for (uint i = 0; i < 16; i++)
+		Data[i] = g_Rand.RandByte();
+
+	Data[7] = Data[7] & 0x3F | 0x80;
+	Data[9] = Data[9] & 0x0F | 0x40;
+}
+
+bool CommonGUID::FromString(const tchar *s)
+{
+	uint ints[16];
+#ifdef _UNICODE
+	int R = swscanf_s(s, L"%02X%02X%02X%02X-%02X%02X-%02X%02X-%02X%02X-%02X%02X%02X%02X%02X%02X",
+		&ints[15], &ints[14], &ints[13], &ints[12],
+		&ints[11], &ints[10], &ints[ 9], &ints[ 8],
+		&ints[ 7], &ints[ 6], &ints[ 5], &ints[ 4],
+		&ints[ 3], &ints[ 2], &ints[ 1], &ints[ 0] );
+#elif defined(_MSC_VER)
+	int R = sscanf_s(s, "%02X%02X%02X%02X-%02X%02X-%02X%02X-%02X%02X-%02X%02X%02X%02X%02X%02X",
+		&ints[15], &ints[14], &ints[13], &ints[12],
+		&ints[11], &ints[10], &ints[ 9], &ints[ 8],
+		&ints[ 7], &ints[ 6], &ints[ 5], &ints[ 4],
+		&ints[ 3], &ints[ 2], &ints[ 1], &ints[ 0] );
+#else
+	int R = sscanf(s, "%02X%02X%02X%02X-%02X%02X-%02X%02X-%02X%02X-%02X%02X%02X%02X%02X%02X",
+		&ints[15], &ints[14], &ints[13], &ints[12],
+		&ints[11], &ints[10], &ints[ 9], &ints[ 8],
+		&ints[ 7], &ints[ 6], &ints[ 5], &ints[ 4],
+		&ints[ 3], &ints[ 2], &ints[ 1], &ints[ 0] );
+#endif
+	if (R != 16) return false;
+	for (uint i = 0; i < 16; i++)
+		Data[i] = (uint8)ints[i];
+	return true;
+}
+
+bool CommonGUID::FromString(const tstring &s)
+{
+	return FromString(s.c_str());
+}
+
+Format::Format(const Format &f, const tstring &Element) :
+	pimpl(f.pimpl)
+{
+    tstring& str = pimpl->m_String;
+	size_t index = str.find(pimpl->m_Sep, pimpl->m_Index);
+
+	// nie ma już gdzie dodać - nie zmieniamy
+	if (index == tstring::npos) return;
+
+	str.replace(index, 1, Element);
+	pimpl->m_Index = index + Element.length();
+}
+
+Format::Format(const Format &f, const tchar *Element) :
+	pimpl(f.pimpl)
+{
+    tstring& str = pimpl->m_String;
+	size_t index = str.find(pimpl->m_Sep, pimpl->m_Index);
+
+	// nie ma już gdzie dodać - nie zmieniamy
+	if (index == tstring::npos) return;
+
+#ifdef _UNICODE
+	size_t Length = _tcslen(Element);
+#else
+	size_t Length = strlen(Element);
+#endif
+	str.replace(index, 1, Element, Length);
+	pimpl->m_Index = index + Length;
+}
+
+} // namespace common
@@ -1,3096 +1,3090 @@
-/** \file
-\brief Foundation module
-\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
-
-Part of CommonLib library. \n
-Encoding UTF-8, end of line CR+LF \n
-License: GNU LGPL. \n
-Documentation: \ref Module_Base \n
-Module components: \ref code_base
-*/
-#if defined(_MSC_VER) && (_MSC_VER >= 1200)
-#pragma once
-#endif
-#ifndef COMMON_BASE_H_
-#define COMMON_BASE_H_
-
-/** \addtogroup code_base Base Module
-Documentation: \ref Module_Base \n
-Header: Base.hpp */
-//@{
-
-// Main includes
-#include <cassert>
-#include <string>
-#include <vector>
-
-// Unwanted includes :(
-#include <algorithm>
-#include <limits>
-#include <cmath>
-#include <cstdint>
-
-#ifdef _WIN32
-	/// This is in case the user includes <Windows.h> somewhere below.
-	#define NOMINMAX
-#endif
-
-// I want to have string like a built-in type.
-using std::string;
-using std::wstring;
-
-// Regardless of compiler used, signaature of current function will be in
-// __FUNCSIG__ macro - conversion from GCC convention to Visual C++ convention.
-// __FUNCTION__ macro with function name only is the same in Visual C++ and GCC,
-// so I don't touch it.
-#ifndef _WIN32
-	#define __FUNCSIG__ __PRETTY_FUNCTION__
-#endif
-
-// Things regarding Unicode
-#ifdef _WIN32
-	#include <tchar.h>
-	#include <wchar.h>
-	/// Character type, depending on _UNICODE macro, is defined as char or wchar_t.
-	typedef TCHAR tchar;
-#else
-	#define _T(x) (x)
-	typedef char tchar;
-#endif
-
-#ifdef _UNICODE
-	/// String type, depending on _UNICODE macro, is defined as std::string or std::wstring.
-	typedef std::wstring tstring;
-	/// Converts character to natural number.
-	#define TCHAR_TO_INT(c) ( (int)(c) )
-	/// Converts 0..255 number to character.
-	#define INT_TO_TCHAR(i) ( (wchar_t)(i) )
-#else
-	typedef std::string tstring;
-	#define TCHAR_TO_INT(c) ( (int)(uint8)(c) )
-	#define INT_TO_TCHAR(i) ( (char)(uint8)(i) )
-#endif
-
-/// Name of current source file as string, in Unicode if _UNICODE macro is defined.
-#define __TFILE__ _T(__FILE__)
-/// Full signature of current function in code, in Unicode if _UNICODE macro is defined.
-#define __TFUNCSIG__ _T(__FUNCSIG__)
-/// Name of current function only, in Unicode if _UNICODE macro is defined.
-#define __TFUNCTION__ _T(__FUNCTION__)
-
-/** \addtogroup base_main_types Fundamental data types */
-//@{
-#ifdef _WIN32
-	/// Unsigned 32-bit numer
-	typedef unsigned __int32 uint;
-	/// Signed 8-bit number
-	typedef __int8 int8;
-	/// Unsigned 8-bit number
-	typedef unsigned __int8 uint8;
-	/// Signed 16-bit number
-	typedef __int16 int16;
-	/// Unsigned 16-bit number
-	typedef unsigned __int16 uint16;
-	/// Signed 32-bit number
-	typedef __int32 int32;
-	/// Unsigned 32-bit number
-	typedef unsigned __int32 uint32;
-	/// Signed 64-bit number
-	typedef __int64 int64;
-	/// Unsigned 64-bit number
-	typedef unsigned __int64 uint64;
-#else
-	typedef unsigned int uint;
-	typedef char int8;
-	typedef unsigned char uint8;
-	typedef short int16;
-	typedef unsigned short uint16;
-	typedef int int32;
-	typedef unsigned int uint32;
-	typedef long long int64;
-	typedef unsigned long long uint64;
-#endif
-//@}
-
-#ifdef _WIN32
-	#define common_memzero(buf,bufSize)   { ZeroMemory(buf,bufSize); }
-#else
-	#define common_memzero(buf,bufSize)   { memset(buf,0,bufSize); }
-#endif
-
-/* These macros define string functions from C standard library they way that
-under Visual C++ they resolve to safe _s versions and use Unicode if _UNICODE
-defined and under Linux they use standard C functions.
-
-There is a problem with variadic macros (macros with variable number of
-arguments) when no argument supplied to the macro. According to language
-standard, macro arguments would contain erroneus trailing comma. Visual C++
-automatically deals with this. GNU compiler requires using special syntax:
-##__VA_ARGS__. */
-#ifdef _MSC_VER
-	#define common_sprintf(buf,bufSize,fmt,...)   ( _stprintf_s(buf,bufSize,fmt,__VA_ARGS__) )
-	#define common_memcpy(dst,src,count)   { memcpy_s(dst,count,src,count); }
-	#define common_memmove(dst,src,count)   { memmove_s(dst,count,src,count); }
-	#define common_strcat(dst,dstSize,src)   { _tcscat_s(dst,dstSize,src); }
-	#define common_strncat(dst,dstSize,src,count)   { _tcsncat_s(dst,dstSize,src,count); }
-	#define common_strchr(str,c)   ( _tcschr(str,c) )
-	#define common_strrchr(str,c)   ( _tcsrchr(str,c) )
-	#define common_strcmp(s1,s2)   ( _tcscmp(s1,s2) )
-	#define common_strncmp(s1,s2,count)   ( _tcsncmp(s1,s2,count) )
-	#define common_stricmp(s1,s2)   ( _tcsicmp(s1,s2) )
-	#define common_strnicmp(s1,s2,count)   ( _tcsnicmp(s1,s2,count) )
-	#define common_strcoll(s1,s2)   ( _tcscoll(s) )
-	#define common_strcpy(dst,dstSize,src)   { _tcscpy_s(dst,dstSize,src); }
-	#define common_strncpy(dst,dstSize,src,count)   { _tcsncpy(dst,dstSize,src,count); }
-	#define common_strlen(str)   ( _tcslen(str) )
-	#define common_strspn(str,charset)   ( _tcsspn(str,charset) )
-	#define common_strcspn(str,charset)   ( _tcscspn(str,charset) )
-	#define common_strpbrk(str,charset)   ( _tcspbrk(str,charset) )
-	#define common_strstr(str,strSearch)   ( _tcsstr(str,strSearch) )
-	#define common_strxfrm(dst,str,count)   ( _tcsxfrm(dst,str,count) )
-
-#else
-	#define common_sprintf(buf,bufSize,fmt,...)   ( sprintf(buf,fmt,##__VA_ARGS__) )
-	#define common_memcpy(dst,src,count)   { memcpy(dst,src,count); }
-	#define common_memmove(dst,src,count)   { memmove(dst,src,count); }
-	#define common_strcat(dst,dstSize,src)   { strcat(dst,src); }
-	#define common_strncat(dst,dstSize,src,count)   { strncat(dst,src,count); }
-	#define common_strchr(str,c)   ( strchr(str,c) )
-	#define common_strrchr(str,c)   ( strrchr(str,c) )
-	#define common_strcmp(s1,s2)   ( strcmp(s1,s2) )
-	#define common_strncmp(s1,s2,count)   ( strncmp(s1,s2,count) )
-	#define common_stricmp(s1,s2)   ( stricmp(s1,s2) )
-	#define common_strnicmp(s1,s2,count)   ( strnicmp(s1,s2,count) )
-	#define common_strcoll(s1,s2)   ( strcoll(s) )
-	#define common_strcpy(dst,dstSize,src)   { strcpy(dst,src); }
-	#define common_strncpy(dst,dstSize,src,count)   { strncpy(dst,src,count); }
-	#define common_strlen(str)   ( strlen(str) )
-	#define common_strspn(str,charset)   ( strspn(str,charset) )
-	#define common_strcspn(str,charset)   ( strcspn(str,charset) )
-	#define common_strpbrk(str,charset)   ( strpbrk(str,charset) )
-	#define common_strstr(str,strSearch)   ( strstr(str,strSearch) )
-	#define common_strxfrm(dst,str,count)   ( strxfrm(dst,str,count) )
-
-#endif
-
-/// String vector
-typedef std::vector<tstring> STRING_VECTOR;
-
-/// If pointer is not null, frees and zeroes it
-#define SAFE_DELETE(x) do { delete (x); (x) = 0; } while(false)
-/// If pointer is not null, frees it as and array and zeroes it
-#define SAFE_DELARR(x) do { delete [] (x); (x) = 0; } while(false)
-/// If pointer is not null, calls Release() and zeroes it
-#define SAFE_RELEASE(x) do { if (x) { (x)->Release(); (x) = 0; } } while(false)
-
-#ifdef _WIN32
-    namespace common { namespace Internal {
-        void DebugBreak();
-    } }
-	/// Assert that ALWAYS breaks the program when false (in debugger - hits a breakpoint, without debugger - crashes the program).
-	#define	ASSERT_INT3(x) if ((x) == 0) { Internal::DebugBreak(); }
-	/// Assert that in Debug configuration breaks the program when false (in debugger - hits a breakpoint, without debugger - crashes the program).
-	#ifdef _DEBUG
-		#define	ASSERT_INT3_DEBUG(x) if ((x) == 0) { Internal::DebugBreak(); }
-	#else
-		#define ASSERT_INT3_DEBUG(x) { }
-	#endif
-#endif
-
-/// For making structures aligned to one byte - without paddings
-#ifdef _MSC_VER
-	#define PACKED __declspec(align(1))
-#else
-	#define PACKED __attribute__((packed))
-#endif
-
-/// Macro to be placed in classes so a class has no copy constructor and assignment operator.
-/* Use at the beginning of class definition.
-Based on wxWidgets library. */
-#define DECLARE_NO_COPY_CLASS(ClassName)        \
-	private:                                    \
-		ClassName(const ClassName&);            \
-		ClassName& operator=(const ClassName&);
-
-/// Compiler-time assertion.
-#define STATIC_ASSERT(x) { const char temp[ (((x) == 0) ? 0 : 1) ] = {'\0'}; }
-
-/// Operator of literal cast (bitwise reinterpretation) - missing in C++.
-template <typename destT, typename srcT>
-destT &absolute_cast(srcT &v)
-{
-	return reinterpret_cast<destT&>(v);
-}
-template <typename destT, typename srcT>
-const destT &absolute_cast(const srcT &v)
-{
-	return reinterpret_cast<const destT&>(v);
-}
-
-#define REF_COUNTED_FIELDS \
-	uint m_RefCount;
-#define REF_COUNTED_METHODS \
-	void AddRef() { m_RefCount++; } \
-	void Release() { assert(m_RefCount > 0); if (--m_RefCount == 0) delete this; }
-#define REF_COUNTED_CTOR \
-	{ m_RefCount = 1; }
-
-#ifdef _DEBUG
-	#define NODEFAULT   assert(0)
-#else
-	#define NODEFAULT   __assume(0)
-#endif
-
-//@}
-// code_base
-
-/// Main namespace of CommonLib library
-namespace common
-{
-
-/** \addtogroup code_base Base Module */
-//@{
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-/** \addtogroup base_general General */
-//@{
-
-#ifndef _countof
-	/// \internal
-	template <typename _CountofType, size_t _SizeOfArray>
-	char (*__countof_helper(_CountofType (&_Array)[_SizeOfArray]))[_SizeOfArray];
-	/// Macro for fetching number of elements of a static array in compile time.
-	/** Copied from stdlib.h in Visual C++. */
-	#define _countof(_Array) sizeof(*__countof_helper(_Array))
-#endif
-
-/// Orientation - vertical or horizontal
-enum ORIENTATION
-{
-	O_NONE,
-	O_VERT,
-	O_HORIZ,
-};
-
-/// Allocates new dynamic 2D array
-template <typename T>
-T **new_2d(size_t cx, size_t cy)
-{
-	T **a = new T*[cx];
-	for (size_t x = 0; x < cx; x++)
-		a[x] = new T[cy];
-	return a;
-}
-
-/// Frees dynamic 2D array
-template <typename T>
-void delete_2d(T **a, size_t cx)
-{
-	for (size_t x = 0; x < cx; x++)
-		delete[] a[x];
-	delete[] a;
-}
-
-/// Copies string to char* including '\0' characters (which is not ensured in strcpy)
-/**
-- Includes '\0' at the end.
-- Of course necessary capacity must be ensured. */
-inline void strcpy0(tchar* dest, const tstring &src)
-{
-	for (size_t i = 0; i < src.length(); i++)
-		dest[i] = src[i];
-	dest[src.length()] = '\0';
-}
-
-/// Singleton design pattern - base class
-/**
-Usage:
-\code
-class MyClass : public common::Singleton<MyClass>
-{
-public:
-  void Foo();
-};
-
-...
-MyClass::GetInstance().Foo();
-\endcode
-*/
-template <typename T>
-class Singleton
-{
-public:
-	/// Returns the single instance of this class. Creates it on first call.
-	static T & GetInstance()
-	{
-		static T Instance;
-		return Instance;
-	}
-};
-
-/// Algorithm like these from STL - insertion sort.
-template<class Iterator>
-void InsertionSort(Iterator b, Iterator e)
-{
-	if (b == e) return;
-	for (Iterator j = b + 1; j < e; j++)
-	{
-		typename std::iterator_traits<Iterator>::value_type key;
-		key = *j;
-		Iterator i = j;
-		while (i > b && key < *(i-1))
-		{
-			*i = *(i-1);
-			i--;
-		} 
-		*i = key;
-	}
-}
-
-/// Algorithm like these from STL - insertion sort, with custom comparator.
-template<class Iterator, typename Compare>
-void InsertionSort(Iterator b, Iterator e, Compare Comp)
-{
-	if (b == e) return;
-	for (Iterator j = b + 1; j < e; j++)
-	{
-		typename std::iterator_traits<Iterator>::value_type key;
-		key = *j;
-		Iterator i = j;
-		while (i > b && Comp(key, *(i-1)))
-		{
-			*i = *(i-1);
-			i--;
-		} 
-		*i = key;
-	}
-}
-
-template <typename IterT, typename KeyT, typename CmpT>
-IterT FirstNotLessIndex(IterT beg, IterT end, const KeyT &key, CmpT cmp)
-{
-	size_t down=0, up=(end-beg);
-	while(down<up)
-	{
-		size_t mid=(down+up)/2;
-		int res=cmp(key,*(beg+mid));
-		if(res>0)
-			down=mid+1;
-		else
-			up=mid;
-	}
-	return beg+down;
-}
-
-/// An STL-compatible algorithm that performs binary search in sorted container using random-access iterators. Returns iterator to found element.
-/** If key element not found, returns end. \n
-This function is useful because standard std::binary_search returns bool and not iterator (what a nonsense!). \n
-cmp must be a functor in form of: int cmp(const KeyT &key, const ValT &val), where ValT is the type of *beg and *end.
-*/
-template <typename IterT, typename KeyT, typename CmpT>
-IterT BinarySearch(IterT beg, IterT end, const KeyT &key, CmpT cmp)
-{
-	IterT it = FirstNotLessIndex<IterT, KeyT, CmpT>(beg, end, key, cmp);
-	if (it == end || cmp(key, *it) != 0)
-		return end;
-	return it;
-}
-
-/// Swaps endianess of a 2-byte value.
-inline void SwapEndian16(void *p)
-{
-	uint16 &u = *(uint16*)p;
-	u = (u << 8) | (u >> 8);
-}
-/// Swaps endianess of a 4-byte value.
-inline void SwapEndian32(void *p)
-{
-	uint32 &u = *(uint32*)p;
-	u = (u << 24) | ((u & 0x0000ff00u) << 8) | ((u & 0x00ff0000u) >> 8) | (u >> 24);
-}
-/// Swaps endianess of a 8-byte value.
-inline void SwapEndian64(void *p)
-{
-	uint64 &u = *(uint64*)p;
-	u = (u << 56) | (u >> 56) |
-		((u & 0x000000000000ff00ull) << 40) | ((u & 0x00ff000000000000ull) >> 40) |
-		((u & 0x0000000000ff0000ull) << 24) | ((u & 0x0000ff0000000000ull) >> 24) |
-		((u & 0x00000000ff000000ull) <<  8) | ((u & 0x000000ff00000000ull) >>  8);
-}
-
-void SwapEndian16_Array(void *p, size_t count);
-void SwapEndian32_Array(void *p, size_t count);
-void SwapEndian64_Array(void *p, size_t count);
-
-void SwapEndian16_Data(void *p, size_t count, ptrdiff_t stepBytes);
-void SwapEndian32_Data(void *p, size_t count, ptrdiff_t stepBytes);
-void SwapEndian64_Data(void *p, size_t count, ptrdiff_t stepBytes);
-
-inline void SwapEndian(bool   &v) { }
-inline void SwapEndian(uint8  &v) { }
-inline void SwapEndian(int8   &v) { }
-inline void SwapEndian(uint16  &v) { SwapEndian16(&v); }
-inline void SwapEndian(int16   &v) { SwapEndian16(&v); }
-inline void SwapEndian(uint32  &v) { SwapEndian32(&v); }
-inline void SwapEndian(int32   &v) { SwapEndian32(&v); }
-inline void SwapEndian(uint64  &v) { SwapEndian64(&v); }
-inline void SwapEndian(int64   &v) { SwapEndian64(&v); }
-inline void SwapEndian(float  &v) { SwapEndian32(&v); }
-inline void SwapEndian(double &v) { SwapEndian64(&v); }
-
-/// Stops current thread for given number of milliseconds
-/** Works with some accuracy - maybe not great, but surely better than whole
-second. */
-void Wait(uint32 Miliseconds);
-
-template <typename T>
-inline int UniversalCmp(const T &a, const T &b)
-{
-	if (a < b) return -1;
-	if (b < a) return  1;
-	return 0;
-}
-
-//@}
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-/** \addtogroup base_smartptr Smart pointers */
-//@{
-
-/// Policy of deleting smart pointers which does: <tt>delete p;</tt>
-class DeletePolicy
-{
-public:
-	template <typename T>
-	static void Destroy(T *p)
-	{
-		// Sztuczka inspirowana Boost (checked_delete.hpp)
-		typedef char type_must_be_complete[ sizeof(T)? 1: -1 ];
-		(void) sizeof(type_must_be_complete);
-		delete p;
-	}
-};
-/// Policy of deleting smart pointers which does: <tt>delete [] p;</tt>
-class DeleteArrayPolicy
-{
-public:
-	template <typename T>
-	static void Destroy(T *p)
-	{
-		// Sztuczka inspirowana Boost (checked_delete.hpp)
-		typedef char type_must_be_complete[ sizeof(T)? 1: -1 ];
-		(void) sizeof(type_must_be_complete);
-		delete [] p;
-	}
-};
-/// Policy of deleting smart pointers which does: <tt>p->Release();</tt>
-class ReleasePolicy
-{
-public:
-	template <typename T>
-	static void Destroy(T *p)
-	{
-		if (p) p->Release();
-	}
-};
-
-/// Smart pointers with exclusive ownership.
-/**
-- Noncopyable.
-- Frees in destructor. */
-template <typename T, typename PolicyT = DeletePolicy>
-class scoped_ptr
-{
-    template<typename Y, typename PolicyY> friend class scoped_ptr;
-
-private:
-	T *m_Ptr;
-
-	scoped_ptr(const scoped_ptr &);
-	scoped_ptr & operator = (const scoped_ptr &);
-
-public:
-	typedef T value_type;
-	typedef T *ptr_type;
-
-	explicit scoped_ptr(T *p = NULL) : m_Ptr(p) { }
-	~scoped_ptr() { PolicyT::template Destroy<T>(m_Ptr); }
-	
-	T & operator * () const { assert(m_Ptr != NULL); return *m_Ptr; }
-	T * operator -> () const { assert(m_Ptr != NULL); return m_Ptr; }
-	T & operator [] (size_t i) const { return m_Ptr[i]; }
-
-	inline friend bool operator == (const scoped_ptr &lhs, const T *rhs) { return lhs.m_Ptr == rhs; }
-	inline friend bool operator == (const T *lhs, const scoped_ptr &rhs) { return lhs == rhs.m_Ptr; }
-	inline friend bool operator != (const scoped_ptr &lhs, const T *rhs) { return lhs.m_Ptr != rhs; }
-	inline friend bool operator != (const T *lhs, const scoped_ptr &rhs) { return lhs != rhs.m_Ptr; }
-
-	T * get() const { return m_Ptr; }
-	void swap(scoped_ptr<T, PolicyT> &b) { T *tmp = b.m_Ptr; b.m_Ptr = m_Ptr; m_Ptr = tmp; }
-	void reset(T *p = NULL) { assert(p == NULL || p != m_Ptr); scoped_ptr<T, PolicyT>(p).swap(*this); }
-	bool is_null() const { return m_Ptr == NULL; }
-};
-
-/// Smart pointer with reference counting
-/**
-- Copyable.
-- Frees when last common::shared_ptr object pointing to it is destroyed. */
-template <typename T, typename PolicyT = DeletePolicy>
-class shared_ptr
-{
-    template<typename Y, typename PolicyY> friend class shared_ptr;
-
-private:
-	T *m_Ptr;
-	unsigned *m_Counter;
-
-public:
-	typedef T value_type;
-	typedef T *ptr_type;
-
-	explicit shared_ptr(T *p = NULL) : m_Ptr(p), m_Counter(p ? new unsigned(1) : NULL) { }
-	~shared_ptr() { if (m_Ptr && --(*m_Counter) == 0) { delete m_Counter; PolicyT::template Destroy<T>(m_Ptr); } }
-	
-	shared_ptr(const shared_ptr &p) : m_Ptr(p.m_Ptr), m_Counter(p.m_Counter) { if (m_Ptr) (*m_Counter)++; }
-	shared_ptr & operator = (const shared_ptr &p) { reset<T>(p); return *this; }
-	template <typename U, typename PolicyU> explicit shared_ptr(const shared_ptr<U, PolicyU> &p) : m_Ptr(p.m_Ptr), m_Counter(p.m_Counter) { if (m_Ptr) (*m_Counter)++; }
-	template <typename U, typename PolicyU> shared_ptr & operator = (const shared_ptr<U, PolicyU> &p) { reset<U, PolicyU>(p); return *this; }
-
-	T & operator * () const { assert(m_Ptr != NULL); return *m_Ptr; }
-	T * operator -> () const { assert(m_Ptr != NULL); return m_Ptr; }
-	T & operator [] (size_t i) const { return m_Ptr[i]; }
-
-	inline friend bool operator == (const shared_ptr &lhs, const T *rhs) { return lhs.m_Ptr == rhs; }
-	inline friend bool operator == (const T *lhs, const shared_ptr &rhs) { return lhs == rhs.m_Ptr; }
-	inline friend bool operator != (const shared_ptr &lhs, const T *rhs) { return lhs.m_Ptr != rhs; }
-	inline friend bool operator != (const T *lhs, const shared_ptr &rhs) { return lhs != rhs.m_Ptr; }
-	template <typename U, typename PolicyU> bool operator == (const shared_ptr<U, PolicyU> &rhs) const { return m_Ptr == rhs.m_Ptr; }
-	template <typename U, typename PolicyU> bool operator != (const shared_ptr<U, PolicyU> &rhs) const { return m_Ptr != rhs.m_Ptr; }
-
-	T * get() const { return m_Ptr; }
-	void swap(shared_ptr<T, PolicyT> &b) { T *tmp = b.m_Ptr; b.m_Ptr = m_Ptr; m_Ptr = tmp; unsigned *tmpc = b.m_Counter; b.m_Counter = m_Counter; m_Counter = tmpc; }
-	void reset(T *p = NULL) { if (p == m_Ptr) return; shared_ptr<T, PolicyT>(p).swap(*this); }
-	template <typename U, typename PolicyU> void reset(const shared_ptr<U, PolicyU> &p) { shared_ptr<U, PolicyU>(p).swap(*this); }
-	bool unique() const { return m_Counter == NULL || *m_Counter == 1; }
-	bool is_null() const { return m_Ptr == NULL; }
-};
-
-#ifdef _WIN32
-	/// Handle closing policy which does: <tt>CloseHandle(p);</tt>
-	class CloseHandlePolicy  { public: template <typename T> static void Destroy(T p) { if (p != NULL) CloseHandle(p); } };
-	/// Handle closing policy which does: <tt>DeleteObject(p);</tt>
-	class DeleteObjectPolicy { public: template <typename T> static void Destroy(T p) { if (p != NULL) DeleteObject(p); } };
-#endif
-
-/// Smart handle - exclusive ownership
-template <typename T, typename PolicyT>
-class scoped_handle
-{
-    template<typename Y, typename PolicyY> friend class scoped_handle;
-
-private:
-	T m_Ptr;
-
-	scoped_handle(const scoped_handle &);
-	scoped_handle & operator = (const scoped_handle &);
-
-public:
-	typedef T value_type;
-
-	explicit scoped_handle(T p) : m_Ptr(p) { }
-	~scoped_handle() { PolicyT::template Destroy<T>(m_Ptr); }
-	
-	inline friend bool operator == (const scoped_handle &lhs, const T &rhs) { return lhs.m_Ptr == rhs; }
-	inline friend bool operator == (const T &lhs, const scoped_handle &rhs) { return lhs == rhs.m_Ptr; }
-	inline friend bool operator != (const scoped_handle &lhs, const T &rhs) { return lhs.m_Ptr != rhs; }
-	inline friend bool operator != (const T &lhs, const scoped_handle &rhs) { return lhs != rhs.m_Ptr; }
-
-	const T & get() const { return m_Ptr; }
-	void swap(scoped_handle<T, PolicyT> &b) { T tmp = b.m_Ptr; b.m_Ptr = m_Ptr; m_Ptr = tmp; }
-	void reset(T p) { scoped_handle<T, PolicyT>(p).swap(*this); }
-};
-
-/// Smart handle with reference counting
-template <typename T, typename PolicyT>
-class shared_handle
-{
-    template<typename Y, typename PolicyY> friend class shared_handle;
-
-private:
-	T m_Ptr;
-	unsigned *m_Counter;
-
-public:
-	typedef T value_type;
-
-	explicit shared_handle(T p) : m_Ptr(p), m_Counter(new unsigned(1)) { }
-	~shared_handle() { if (--(*m_Counter) == 0) { delete m_Counter; PolicyT::template Destroy<T>(m_Ptr); } }
-	
-	shared_handle(const shared_handle &p) : m_Ptr(p.m_Ptr), m_Counter(p.m_Counter) { (*m_Counter)++; }
-	shared_handle & operator = (const shared_handle &p) { reset<T>(p); return *this; }
-	template <typename U, typename PolicyU> explicit shared_handle(const shared_handle<U, PolicyU> &p) : m_Ptr(p.m_Ptr), m_Counter(p.m_Counter) { (*m_Counter)++; }
-	template <typename U, typename PolicyU> shared_handle & operator = (const shared_handle<U, PolicyU> &p) { reset<U, PolicyU>(p); return *this; }
-
-	inline friend bool operator == (const shared_handle &lhs, const T &rhs) { return lhs.m_Ptr == rhs; }
-	inline friend bool operator == (const T &lhs, const shared_handle &rhs) { return lhs == rhs.m_Ptr; }
-	inline friend bool operator != (const shared_handle &lhs, const T &rhs) { return lhs.m_Ptr != rhs; }
-	inline friend bool operator != (const T &lhs, const shared_handle &rhs) { return lhs != rhs.m_Ptr; }
-	template <typename U, typename PolicyU> bool operator == (const shared_handle<U, PolicyU> &rhs) const { return m_Ptr == rhs.m_Ptr; }
-	template <typename U, typename PolicyU> bool operator != (const shared_handle<U, PolicyU> &rhs) const { return m_Ptr != rhs.m_Ptr; }
-
-	const T & get() const { return m_Ptr; }
-	void swap(shared_handle<T, PolicyT> &b) { T tmp = b.m_Ptr; b.m_Ptr = m_Ptr; m_Ptr = tmp; unsigned *tmpc = b.m_Counter; b.m_Counter = m_Counter; m_Counter = tmpc; }
-	void reset(T p) { if (p == m_Ptr) return; shared_handle<T, PolicyT>(p).swap(*this); }
-	template <typename U, typename PolicyU> void reset(const shared_handle<U, PolicyU> &p) { shared_handle<U, PolicyU>(p).swap(*this); }
-	bool unique() const { return *m_Counter == 1; }
-};
-
-template <typename T, typename PolicyT> void swap(scoped_ptr<T, PolicyT> &a, scoped_ptr<T, PolicyT> &b) { a.swap(b); }
-template <typename T, typename PolicyT> void swap(shared_ptr<T, PolicyT> &a, shared_ptr<T, PolicyT> &b) { a.swap(b); }
-template <typename T, typename PolicyT> void swap(scoped_handle<T, PolicyT> &a, scoped_handle<T, PolicyT> &b) { a.swap(b); }
-template <typename T, typename PolicyT> void swap(shared_handle<T, PolicyT> &a, shared_handle<T, PolicyT> &b) { a.swap(b); }
-
-//@}
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-/** \addtogroup base_math Basic math
-Bit tricks implemented based on:
-Bit Twiddling Hacks, Sean Eron Anderson, http://www-graphics.stanford.edu/~seander/bithacks.html
-*/
-//@{
-
-/** \addtogroup base_minmax Minimum and maximum values
-Minimum and maximum values of various types. */
-//@{
-const int8 MININT8 = std::numeric_limits<int8>::min();
-const int8 MAXINT8 = std::numeric_limits<int8>::max();
-const int16 MININT16 = std::numeric_limits<int16>::min();
-const int16 MAXINT16 = std::numeric_limits<int16>::max();
-const int32 MININT32 = std::numeric_limits<int32>::min();
-const int32 MAXINT32 = std::numeric_limits<int32>::max();
-const int64 MININT64 = std::numeric_limits<int64>::min();
-const int64 MAXINT64 = std::numeric_limits<int64>::max();
-const uint8 MAXUINT8 = std::numeric_limits<uint8>::max();
-const uint16 MAXUINT16 = std::numeric_limits<uint16>::max();
-const uint32 MAXUINT32 = std::numeric_limits<uint32>::max();
-const uint64 MAXUINT64 = std::numeric_limits<uint64>::max();
-const float MINFLOAT = std::numeric_limits<float>::min();
-const float MAXFLOAT = std::numeric_limits<float>::max();
-//@}
-
-/// Close to zero floating point number
-/** Suprisingly this macro converted to function works slower - never trust
-compiler optimiations! */
-#define FLOAT_ALMOST_ZERO(F) ((absolute_cast<uint32>(F) & 0x7f800000L) == 0)
-
-/** \addtogroup base_math_consts Math constants
-Because constants from cmath/math.h don't work despite defining USE_MATH_CONSTANTS :P */
-//@{
-const float E         = 2.71828182845904523536f;  ///< e
-const float LOG2E     = 1.44269504088896340736f;  ///< log2(e)
-const float LOG10E    = 0.434294481903251827651f; ///< log10(e)
-const float LN2       = 0.693147180559945309417f; ///< ln(2)
-const float LN10      = 2.30258509299404568402f;  ///< ln(10)
-const float PI        = 3.14159265358979323846264338327950288419716939937510582f;  ///< pi
-const float PI_2      = 1.57079632679489661923f;  ///< pi/2
-const float PI_4      = 0.785398163397448309616f; ///< pi/4
-const float PI_X_2    = 6.28318530717958647692f;  ///< 2*pi
-const float _1_PI     = 0.318309886183790671538f; ///< 1/pi
-const float _2_PI     = 0.636619772367581343076f; ///< 2/pi
-const float _2_SQRTPI = 1.12837916709551257390f;  ///< 2/sqrt(pi)
-const float SQRT2     = 1.41421356237309504880f;  ///< sqrt(2)
-const float SQRT3     = 1.7320508075688772935274463415059f; ///< sqrt(3)
-const float SQRT1_2   = 0.707106781186547524401f; ///< 1/sqrt(2)
-//@}
-
-// Windows - requires float.h
-#ifdef _WIN32
-	/// Returns true if number is not INF or NaN
-	bool is_finite(float x);
-	/// Returns true if number is not INF or NaN
-	bool is_finite(double x);
-	/// Returns true,if number is NaN
-	bool is_nan(float x);
-	/// Returns true,if number is NaN
-	bool is_nan(double x);
-// Linux - requires math.h
-#else
-	inline bool is_finite(float x)  { return (finitef(x) != 0); }
-	inline bool is_finite(double x) { return (finite(x)  != 0); }
-	inline bool is_nan(float x)  { return (isnanf(x) != 0); }
-	inline bool is_nan(double x) { return (isnan(x)  != 0); }
-#endif
-
-/// Adds two numbers with limit (saturation) instead of wrap-around on overflow
-/** As T use types: uint8, uint16, uint32, uint64
-(Author: Tarlandil) */
-template <typename T>
-T safe_add(T a, T b)
-{
-	T R = a + b;
-	if (R < std::max(a, b)) return std::numeric_limits<T>::max();
-	else return R;
-}
-
-/// Subtracts two numbers with limit (saturation) instead of wrap-around on overflow
-/** As T use types: uint8, uint16, uint32, uint64
-(Author: Tarlandil) */
-template <typename T>
-T safe_sub(T a, T b)
-{
-	if (b > a) return T();
-	else return a - b;
-}
-
-/// Multiplies two numbers with limit (saturation) instead of wrap-around on overflow
-/** As T use types: uint8, uint16, uint32, uint64
-(Author: Tarlandil) */
-template <typename T>
-T safe_mul(T a, T b)
-{
-	if (b == T()) return T();
-	T R = a * b;
-	if (R / b != a) return std::numeric_limits<T>::max();
-	else return R;
-}
-
-/// Safe arcus cosinus, limits input range to -1...+1 returning boundary values in case of exceeding this range.
-inline float safe_acos(float x)
-{
-	if (x <= -1.0f) return PI;
-	if (x >= 1.0f) return 0.0f;
-	return acosf(x);
-}
-
-/// Rounds number instead of truncating it.
-/** Mathematical way - rounding up or down depending on fractional part. */
-inline int round(float x)
-{
-	return static_cast<int>(floorf(x+0.5f));
-}
-inline int round(double x)
-{
-	return static_cast<int>(floor(x+0.5));
-}
-
-/// Divides two integer numbers rounding the result up
-/** As T use types: int, uint etc.
-Works for positive numbers only.
-Watch out for exceeding range of (x+y) value.
-(Author: Tarlandil) */
-template <typename T>
-inline T ceil_div(T x, T y)
-{
-	return (x+y-1) / y;
-}
-
-/// Aligns given value up to nearest multiply of align value. For example: AlignUp(11, 8) = 16. Use types like uint32, uint64 as T.
-template <typename T>
-inline T AlignUp(T val, T align)
-{
-	return (val + align - 1) / align * align;
-}
-/// Aligns given value down to nearest multiply of align value. For example: AlignUp(19, 8) = 16. Use types like uint32, uint64 as T.
-template <typename T>
-inline T AlignDown(T val, T align)
-{
-	return (val / align) * align;
-}
-
-/// Division with mathematical rounding to nearest number.
-template <typename T>
-inline T round_div(T x, T y)
-{
-	return (x + (y / 2)) / y;
-}
-
-/// Returns true if number lies within epsilon surrounding of zero
-inline bool around(float x, float epsilon)
-{
-	return (fabsf(x) <= epsilon);
-}
-inline bool around(double x, double epsilon)
-{
-	return (fabs(x) <= epsilon);
-}
-
-/// Returns true if number x lies within epsilon surrounding of numer y
-inline bool around(float x, float y, float epsilon)
-{
-	return (fabsf(x-y) <= epsilon);
-}
-inline bool around(double x, double y, double epsilon)
-{
-	return (fabs(x-y) <= epsilon);
-}
-
-/// Returns true if two floating-point numbers are almost equal.
-/** These functions are nice because you don't need to pass epsilon, but they
-require more computations.
-(Author: Tarlandil) */
-inline bool float_equal(float x, float y)
-{
-	float epsilon = (fabsf(x)+fabsf(y)) * 1e-4f;
-	//return around(x, y, epsilon);
-	return (fabsf(x-y) <= epsilon);
-}
-inline bool double_equal(double x, double y)
-{
-	double epsilon = (fabs(x)+fabs(y)) * 1e-13;
-	//return around(x, y, epsilon);
-	return (fabs(x-y) <= epsilon);
-}
-
-/// Calculates square of a number
-/** As T use any type that has operator *.
-This function is useful when you have an expression in parentheses and not just
-a Simple value. */
-template <typename T> inline T sqr(T v) { return v * v; }
-
-/// Returns sign of given integer number: -1, 0, or 1
-/** Use with signed integer numbers: int8, int16, int32, int64. */
-template <typename T> inline T sign(T v) { return (v > (T)0) - (v < (T)0); }
-
-/// Merges bits of two numbers according to mask, that is selects these bits from A that have 0 in mask and these bits from B that have 1 in mask.
-template <typename T> inline T MergeBits(T a, T b, T Mask) { return a ^ ((a ^ b) & Mask); }
-
-/// Returns number of bits set to 1 in given number.
-inline uint CountBitsSet(uint8 v)
-{
-    uint8 c = v - ((v >> 1) & 0x55);
-    c = ((c >> 2) & 0x33) + (c & 0x33);
-    c = ((c >> 4) + c) & 0x0F;
-    return c;
-}
-inline uint CountBitsSet(uint16 v)
-{
-    uint16 c = v - ((v >> 1) & 0x5555);
-    c = ((c >> 2) & 0x3333) + (c & 0x3333);
-    c = ((c >> 4) + c) & 0x0F0F;
-    c = ((c >> 8) + c) & 0x00FF;
-    return c;
-}
-inline uint CountBitsSet(uint32 v)
-{
-    uint32 c = v - ((v >> 1) & 0x55555555);
-    c = ((c >>  2) & 0x33333333) + (c & 0x33333333);
-    c = ((c >>  4) + c) & 0x0F0F0F0F;
-    c = ((c >>  8) + c) & 0x00FF00FF;
-    c = ((c >> 16) + c) & 0x0000FFFF;
-    return c;
-}
-inline uint CountBitsSet(uint64 v)
-{
-    uint64 c = v - ((v >> 1) & 0x5555555555555555ll);
-    c = ((c >>  2) & 0x3333333333333333ll) + (c & 0x3333333333333333ll);
-    c = ((c >>  4) + c) & 0x0F0F0F0F0F0F0F0Fll;
-    c = ((c >>  8) + c) & 0x00FF00FF00FF00FFll;
-    c = ((c >> 16) + c) & 0x0000FFFF0000FFFFll;
-    c = ((c >> 32) + c) & 0x00000000FFFFFFFFll;
-    return (uint)c;
-}
-
-/// Calculates parity bit of a number
-inline uint CalcParity(uint v) {
-	v ^= v >> 1; v ^= v >> 2; v = (v & 0x11111111U) * 0x11111111U; return (v >> 28) & 1;
-}
-/// Calculates parity bit of a number
-inline uint64 CalcParity(uint64 v) {
-	v ^= v >> 1; v ^= v >> 2; v = (v & 0x1111111111111111ULL) * 0x1111111111111111ULL; return (v >> 60) & 1;
-}
-
-/// Swaps bit sequence in a number
-template <typename T> inline T SwapBitSequences(T v, uint SrcBit, uint DstBit, uint NumBits)
-{
-	int x = ((v >> SrcBit) ^ (v >> DstBit)) & ((1 << NumBits) - 1);
-	return v ^ ((x << SrcBit) | (x << DstBit));
-}
-
-/// Returns true if given number is a power of two.
-/** T must be unsigned integer number - uint8, uint16, uint32, uint64, or signed integer but always nonnegative.
-For 0 returns true. */
-template <typename T> inline bool IsPow2(T x) { return (x & (x-1)) == 0; }
-
-/// Returns bit mask with n least significant bits set to 1.
-/** n must be in range 0..32. */
-uint32 GetBitMask(uint32 n);
-
-/// Returns 2-based logarithm of given unsigned integer number, that is the number of the most significant nonzero bit.
-/** In other words, how many bits you need to shift a 1 left to have the most
-significant 1 of the given number. Result 0 is returned for numbers 0 and 1. */
-uint log2u(uint v);
-/// Returns 10-based logarithm of given unsigned integer number, that is the number of most significant decimal digit.
-/** Undefined for zero. */
-uint log10u(uint v);
-
-/// Returns smallest power of two greater or equal than given number
-/** For v == 0 returns 0.
-For v > 0x80000000 result is undefined. */
-inline uint next_pow2(uint v) {
-	v--; v |= v >> 1; v |= v >> 2; v |= v >> 4; v |= v >> 8; v |= v >> 16; v++; return v;
-}
-
-/// Interleaves lower 16 bits of a (to even) and lower 16 bits of b (to odd) to resulting number
-uint InterleaveBits(uint a, uint b);
-// Splits lowest 10 bits inserting two zeros before each one, so:
-// Input:  ----------------------9876543210
-// Output: ----9--8--7--6--5--4--3--2--1--0
-uint Extend10BitsBy2Zeros(uint n);
-// Splits lowest 16 bits inserting one zero before each one, so:
-// Input:  ----------------fedcba9876543210
-// Output: -f-e-d-c-b-a-9-8-7-6-5-4-3-2-1-0
-uint Extend16BitsBy1Zero(uint n);
-
-/** As T use types: uint8, uint16, uint32, uint64. */
-template <typename T>
-inline T ReverseBits(T v)
-{
-    // Algorithm from: Bit Twiddling Hacks, Sean Eron Anderson,
-    // http://graphics.stanford.edu/~seander/bithacks.html#BitReverseObvious
-    
-    T r = v; // r will be reversed bits of v; first get LSB of v
-    int s = (int)sizeof(v) * 8 - 1; // extra shift needed at end
-
-    for (v >>= 1; v; v >>= 1)
-    {   
-      r <<= 1;
-      r |= v & 1;
-      s--;
-    }
-    r <<= s; // shift when v's highest bits are zero
-    
-    return r;
-}
-
-inline uint8 ReverseBits(uint8 v)
-{
-	return (uint8)( ((v * 0x0802LU & 0x22110LU) | (v * 0x8020LU & 0x88440LU)) * 0x10101LU >> 16 );
-}
-
-/// Returns (x + 1) % 3.
-/** T: use unsigned integer types.
-Source: "Modulo 3", http://www.codercorner.com/Modulo3.htm, algorithm by Christer Ericson. */
-template <typename T>
-inline T increment_modulo_3(T x)
-{
-	return ((T)1 << x) & (T)3;
-}
-
-/// Calculates power with integer exponent (very fast!)
-/** T can be any number - int, uint32, float etc.
-(Author: Tarlandil) */
-template <typename T>
-T powi(T a, uint32 b)
-{
-	T r = (T)1;
-	T p = a;
-	while (b)
-	{
-		if (b & 1)
-			r *= p;
-		p *= p;
-		b >>= 1;
-	}
-	return r;
-}
-
-/// Raises float number to integer exponent.
-/** Checked, works great even for negative exponents. */
-inline float powi(float x, int N)
-{
-    float y, w;
-    bool ns = false, xs = false;
-    // record signs
-    if(N < 0) ns = true, N = -N;
-    if(x < 0.0f) xs = true, x = -x;
-    // setup initial powers
-    if(N & 1) y = x;
-    else y = 1.0f, xs = false;
-    w = x; N >>= 1;
-    while(N)
-    {
-        w = w * w;
-        if(N & 1) y *= w;
-        N >>= 1;
-    }
-    // reinstate signs
-    if(xs) y = -y;
-    if(ns) y = 1.0f / y;
-    return y;
-}
-
-template <typename T, typename Predicate>
-void Sort2(T &v1, T &v2, Predicate comp)
-{
-	if (comp(v2, v1))
-	{
-		T tmp = v1;
-		v1 = v2;
-		v2 = tmp;
-	}
-}
-template <typename T>
-void Sort2(T &v1, T &v2)
-{
-	Sort2(v1, v2, std::less<T>());
-}
-
-template <typename T, typename Predicate>
-void Sort3(T &v1, T &v2, T &v3, Predicate comp)
-{
-	Sort2<T, Predicate>(v1, v3, comp);
-	Sort2<T, Predicate>(v1, v2, comp);
-	Sort2<T, Predicate>(v2, v3, comp);
-}
-template <typename T>
-void Sort3(T &v1, T &v2, T &v3)
-{
-	Sort2<T>(v1, v3);
-	Sort2<T>(v1, v2);
-	Sort2<T>(v2, v3);
-}
-
-/// Returns biggest of 3 numbers
-template <typename T>
-inline T max3(const T &a, const T &b, const T &c)
-{
-	return std::max(a, std::max(b, c));
-}
-
-/// Returns smallers of 3 numbers
-template <typename T>
-inline T min3(const T &a, const T &b, const T &c)
-{
-	return std::min(a, std::min(b, c));
-}
-
-/// Returns number x limited to given range from a to b
-template <typename T>
-inline T minmax(const T &a, const T &x, const T &b)
-{
-	if (x < a) return a; else if (x > b) return b; else return x;
-	//return std::min(b, std::max(a, x));
-}
-inline float saturate(float x) { return minmax<float>(0.f, x, 1.f); }
-inline double saturate(double x) { return minmax<double>(0., x, 1.); }
-
-/// Returns integral part of a number including sign
-/** (Author: Tarlandil) */
-inline float trunc(float x)
-{
-	return (x < 0.0f) ? ceilf(x) : floorf(x);
-}
-inline double trunc(double x)
-{
-	return (x < 0.0) ? ceil(x) : floor(x);
-}
-
-/// Returns fractional part of a number including sign
-/** (Author: Tarlandil) */
-inline float frac(float x)
-{
-	return x - floorf(x);
-}
-inline double frac(double x)
-{
-	return x - floor(x);
-}
-
-/// Calculates both sine and cosine of given number. May be faster than calculating them separately.
-void sincos(float angle, float *sine, float *cosine);
-
-/// 1D linear interpolation (t = 0..1)
-inline float Lerp(float x, float y, float t)
-{
-	return x + t*(y-x);
-}
-inline void Lerp(float *out, float x, float y, float t)
-{
-	*out = x + t*(y-x);
-}
-/// 1D linear interpolation (t is limited to 0..1)
-inline float SafeLerp(float x, float y, float t)
-{
-	return Lerp(x, y, minmax(0.0f, t, 1.0f));
-}
-
-/// 2D linear interpolation
-/** tx is for first index, ty is for second index. */
-inline float Lerp2D(float x11, float x21, float x12, float x22, float tx, float ty)
-{
-	return Lerp(Lerp(x11, x21, tx), Lerp(x12, x22, tx), ty);
-}
-
-/// Normalizes angle to range < 0..2PI )
-inline float NormalizeAngle(float angle)
-{
-	angle /= PI_X_2;
-	angle = frac(angle);
-	if (angle < 0.0f)
-		angle += 1.0f;
-	else if (angle >= 1.0f)
-		angle -= 1.0f;
-	return angle * PI_X_2;
-}
-
-/// Normalizes angle to range -PI..+PI
-inline float NormalizeAngle2(float Angle)
-{
-	Angle += PI;
-	Angle -= floorf(Angle * (1.0f/PI_X_2)) * PI_X_2;
-	Angle -= PI;
-	return Angle;
-}
-
-/// Converts angle from degrees to radians
-inline float DegToRad(float Angle)
-{
-	// Angle * PI / 180
-	return Angle * 0.017453292519943295769222222222222f;
-}
-/// Converts angle from radians to degrees
-inline float RadToDeg(float Angle)
-{
-	// Angle * 180 / PI
-	return Angle * 57.295779513082320876846364344191f;
-}
-
-/// Calculates difference of angles A-B, where A, B are in range: 0..2*PI
-/** Takes angle wrap-around into account, so it finds shortest path between
-them. */
-inline float AngleDiff(float A, float B)
-{
-	float R1 = B - A;
-	float R2 = B - PI_X_2 - A;
-	float R3 = B + PI_X_2 - A;
-
-	float R1a = fabsf(R1);
-	float R2a = fabsf(R2);
-	float R3a = fabsf(R3);
-
-	if (R1a < R2a && R1a < R3a)
-		return R1;
-	else if (R2a < R3a)
-		return R2;
-	else
-		return R3;
-}
-
-/// Smoothed curve 0..1 -> 0..1: e(x) = 3*x^2 - 2*x^3
-inline float EaseCurve(float x)
-{
-	return x * x * (3.0f - 2.0f * x);
-}
-/// Smoothed curve 0..1 -> 0..1: e(x) = 6*t^5 - 15*t^4 + 10*t^3
-/** Better than EaseCurve because it has zero second derivative for x=0 and x=1.
-*/
-inline float EaseCurve2(float x)
-{
-	return x * x * x * (x * (x * 6.0f - 15.0f) + 10.0f);
-}
-
-/// Returns 0.0 if x <= min and 1.0 if x >= max and performs smooth Hermite interpolation between 0 and 1 when min < x < max.
-/** This is useful in cases where you want a threshold function with a
-smooth transition. Results are undefined if min >= max. */
-inline float smoothstep(float min, float max, float x)
-{
-	if(x <= min) return 0.0f;
-	if(x >= max) return 1.0f;
-	x = (x - min) / (max - min);
-	return x * x * (3.0f - 2.0f * x);
-}
-
-/// More precise, but slower version of smoothstep function.
-inline float smoothstep2(float min, float max, float x)
-{
-	if(x <= min) return 0.f;
-	if(x >= max) return 1.f;
-	x = (x - min) / (max - min);
-	return 0.5f - cosf(PI * x) * 0.5f;
-}
-
-bool is_prime(unsigned n);
-
-/// Smoothing curve - Critically Damped Smoothing
-/** This is calculated based on a differential equation for some spring,
-precisely and analitically so TimeDelta can be any big you want.
-\param[in,out] InOutPos  Position before and after calculating this step
-\param[in,out] InOutVel  Velocity before and after calculating this step
-\param Dest              Target position
-\param SmoothTime        "Inertia" coefficient, expressed in units of time
-\param TimeDelta         Time of a step (eg. time from last frame)
-\param MaxSpeed          Maximum allowed speed (maximum distance that the position may not keep up?) */
-void SmoothCD(float *InOutPos, float Dest, float *InOutVel, float SmoothTime, float TimeDelta);
-void SmoothCD(float *InOutPos, float Dest, float *InOutVel, float SmoothTime, float TimeDelta, float MaxSpeed);
-
-/// Returns number in range 0..1 depending on value x relative to corners of a trapeze a, b, c, d.
-/**
-\verbatim
-    x < a => 0
-a < x < b => 0..1
-b < x < c => 1
-c < x < d => 1..0
-d < x     => 0
-\endverbatim
-*/
-inline float Trapezoidal(float x, float a, float b, float c, float d)
-{
-	if (x < a)
-		return 0.f;
-	else if (x < b)
-		return (x-a)/(b-a);
-	else if (x < c)
-		return 1.f;
-	else if (x < d)
-		return 1.f - (x-c)/(d-c);
-	else
-		return 0.f;
-}
-/// Like Trapezoidal(), but returns number in range min..max instead of 0..1.
-inline float Trapezoidal(float x, float a, float b, float c, float d, float min, float max)
-{
-	return Trapezoidal(x, a, b, c, d) * (max-min) + min;
-}
-
-/// Quadratic equation a*x^2 + b*x + c = 0
-/** Must be: a != 0.
-- No roots - returns 0, x1 and x2 are undefined.
-- One root - returns 1, x1 = x2 = this only solution.
-- Two roots - returns 2, x1 is first root and x2 is the second. */
-int QuadraticEquation(float a, float b, float c, float *Out_x1, float *Out_x2);
-
-/// Calculates average and optionally variance from a set of floating-point numbers.
-/** sqrt(Variance) is the standard deviation.
-\param Variance Can pass NULL if not needed. */
-void CalcMeanAndVariance(const float Numbers[], size_t NumberCount, float *OutMean, float *OutVariance = NULL, bool VarianceBiased = true);
-void CalcMeanAndVariance(const void *NumberData, size_t NumberCount, ptrdiff_t NumberStride, float *OutMean, float *OutVariance = NULL, bool VarianceBiased = true);
-
-/// MurmurHash 2.0 - declared as very fast hash function. Unfortunately not incremental.
-uint MurmurHash(const void *Data, uint DataLen, uint Seed);
-
-/// Very fast function for hashing data.
-/**
-Author: Paul Hsieh, http://www.azillionmonkeys.com/qed/hash.html
-Unfortunately not incremental.
-*/
-uint SuperFastHash(const void *DataBytes, size_t DataLen);
-
-/// Hash of 32-bit integer number (uint to uint).
-/**
-Source: "Integer Hash Function", Thomas Wang \n
-http://www.concentric.net/~Ttwang/tech/inthash.htm
-*/
-inline uint WangMix(uint key)
-{
-	key += ~(key << 15);
-	key ^= (key >> 10);
-	key += (key << 3);
-	key ^= (key >> 6);
-	key += ~(key << 11);
-	key ^= (key >> 16);
-	return key;
-}
-
-/// Interpolates given quantity between key values for parameter in range 0..1 with wrap-around.
-/**
-- Works with types T that have interpolation function defined for t = 0..1 in form of:
-  void Lerp(T *Out, const T &v1, const T &v2, float t);
-- As parameter t, in Items as well as for Calc method, pass number in range 0..1.
-- Values in Items can be changed freely.
-- For empty Items array always returns T().
-*/
-template <typename T>
-class RoundInterpolator
-{
-public:
-	struct ITEM
-	{
-		float t;
-		T Value;
-
-		ITEM() { }
-		ITEM(float t, const T &Value) : t(t), Value(Value) { }
-	};
-
-	std::vector<ITEM> Items;
-
-	RoundInterpolator() : m_LastUsedIndex(0) { }
-	void Calc(T *Out, float t) const;
-
-private:
-	mutable uint m_LastUsedIndex;
-};
-
-template <typename T>
-void RoundInterpolator<T>::Calc(T *Out, float t) const
-{
-	assert(t >= 0.0f && t <= 1.0f);
-
-	if (Items.empty())
-	{
-		*Out = T();
-		return;
-	}
-
-	// Find index of previous and next Item
-
-	// For the start take saved index and check if it's correct, if not return to zero.
-	uint Index = m_LastUsedIndex;
-	// - Index out of range
-	if (Index >= (uint)Items.size())
-		Index = 0;
-	// - Bad time on the left
-	if (Items[(size_t)Index].t > t)
-		Index = 0;
-
-	// Proceed further
-	while (Index < (uint)Items.size()-1 && Items[(size_t)Index+1].t < t)
-		Index++;
-
-	// Save the index
-	m_LastUsedIndex = Index;
-
-	if (Index < (uint)Items.size()-1)
-	{
-		float my_t = (t - Items[(size_t)Index].t) / (Items[(size_t)Index+1].t - Items[(size_t)Index].t);
-		RoundInterpolatorLerp(Out, Items[Index].Value, Items[Index+1].Value, my_t);
-	}
-	else
-	{
-		float my_t = (t - Items[(size_t)Index].t) / (Items[0].t + 1.0f - Items[(size_t)Index].t);
-		RoundInterpolatorLerp(Out, Items[(size_t)Index].Value, Items[0].Value, my_t);
-	}
-}
-
-/** \addtogroup base_perlin_noise Perlin noise
-Deterministic, pseudorandom function of 1, 2, 3 variables generating Perlin
-noise and often confused with it Fractional Brownian Motion (fBm). Perlin noise
-is a continuous pseudorandom function with amplitude -1..1 and frequency 1.
-In BrownianNoise functions:
-- i - number of octaves
-- Persistence - persistence of amplitude in subsequent octaves; recommended 0..1
-*/
-//@{
-float PerlinNoise1(float x);
-float PerlinNoise2(float x, float y);
-float PerlinNoise3(float x, float y, float z);
-float BrownianNoise1(float x,                   uint i, float Persistence);
-float BrownianNoise2(float x, float y,          uint i, float Persistence);
-float BrownianNoise3(float x, float y, float z, uint i, float Persistence);
-//@}
-
-/** \addtogroup base_math DEC3
-Format which encodes 4 components in 32-bit number as W2Z10Y10X10.
-Components x, y, z must be in range of 10 bits (0..0x03FF, means 0..1023),
-while component w in range of 2 bits (0..0x03, means 0..3).
-*/
-//@{
-
-inline uint MakeDEC3(uint x, uint y, uint z)
-{
-	return (x & 0x03FF) | ((y & 0x03FF) << 10) | ((z & 0x03FF) << 20);
-}
-inline uint MakeDEC3(uint x, uint y, uint z, uint w)
-{
-	return (x & 0x03FF) | ((y & 0x03FF) << 10) | ((z & 0x03FF) << 20) | ((w & 0x03) << 30);
-}
-inline uint GetXFromDEC3(uint dec3) { return (dec3      ) & 0x03FF; }
-inline uint GetYFromDEC3(uint dec3) { return (dec3 >> 10) & 0x03FF; }
-inline uint GetZFromDEC3(uint dec3) { return (dec3 >> 20) & 0x03FF; }
-inline uint GetWFromDEC3(uint dec3) { return (dec3 >> 30);          }
-
-//@}
-
-/// Calculates coefficients for linear equation y = A*x + B passing through given points (x1,y1), (x2,y2).
-/** \return false if calculation not possible because x1 is equal or too close to x2. */
-template <typename T>
-bool CalcLinearFactors(
-	T &outA, T &outB,
-	float x1, float x2,
-	const T &y1, const T &y2)
-{
-	float d = x2-x1;
-	if (FLOAT_ALMOST_ZERO(d))
-		return false;
-	outA = (y2 - y1) / d;
-	outB = (y1*x2 - y2*x1) / d;
-	return true;
-}
-
-/// Calculates coefficients for quadratic equation y = A*x^2 + B*x + C passing through given points (x1,y1), (x2,y2), (x3,y3).
-/** \return false if calculation not possible because some x arguments are equal or too close to each other. */
-template <typename T>
-bool CalcQuadraticFactors(
-	T &outA, T &outB, T &outC,
-	float x1, float x2, float x3,
-	const T &y1, const T &y2, const T &y3)
-{
-	float x1_sq = x1 * x1;
-	float x2_sq = x2 * x2;
-	float x3_sq = x3 * x3;
-	float w = x1_sq*(x2-x3) + x2_sq*(x3-x1) + x3_sq*(x1+x2);
-	if (FLOAT_ALMOST_ZERO(w))
-		return false;
-	outA = ( y1*(x2-x3) + y2*(x3-x1) + y3*(x1+x2) ) / w;
-	outB = ( y1*(x3_sq-x2_sq) + y2*(x1_sq-x3_sq) + y3*(x2_sq-x1_sq) ) / w;
-	outC = ( y1*(x2_sq*x3-x3_sq*x2) + y2*(x3_sq*x1-x1_sq*x3) + y3*(x1_sq*x2-x2_sq*x1) ) / w;
-	return true;
-}
-
-//@}
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-/** \addtogroup base_strings Strings */
-//@{
-
-/// Types of end-of-line characters
-enum EOLMODE
-{
-	EOL_NONE, ///< Leave as-is during conversion
-	EOL_CRLF, ///< 13 and 10 (Windows)
-	EOL_LF,   ///< 10 (Unix)
-	EOL_CR	  ///< 13 (Mac)
-};
-
-/// Empty string - to be used so you can take a reference to it etc.
-extern const tstring EMPTY_STRING;
-/// Standard end-of-line string depending on system
-extern const tchar * const EOL;
-
-/// Codepage for Polish diacritic characters
-enum CHARSET
-{
-	CHARSET_NONE = 0, ///< No Polish diacritics
-	CHARSET_WINDOWS,  ///< Windows-1250 codepage (used in Windows GUI)
-	CHARSET_ISO,      ///< ISO-8859-2 (Latin-2) codepage (used in Linuksie)
-	CHARSET_IBM,      ///< IBM (CP852) codepage (used in Windows console)
-	CHARSET_UTF8,     ///< UTF-8 codepage
-};
-
-/// Returns true if character is alphanumeric (letter or digit) according to system settings
-bool CharIsAlphaNumeric(tchar ch);
-/// Returns true if character is a letter
-bool CharIsAlpha(tchar ch);
-/// Returns true if character is a decimal digit
-inline bool CharIsDigit(tchar ch) { return (ch >= _T('0') && ch <= _T('9')); }
-/// Returns true if character is a hexadecimal digit
-/** Accepts lower and upper letters. */
-inline bool CharIsHexDigit(tchar ch) { return (ch >= _T('0') && ch <= _T('9')) || (ch >= _T('A') && ch <= _T('F')) || (ch >= _T('a') && ch <= _T('f')); }
-/// Returns true if character is a lower letter
-bool CharIsLower(tchar ch);
-/// Returns true if character is an upper letter
-bool CharIsUpper(tchar ch);
-/// Returns true if character is a whitespace according to the system
-/** Two versions of this function - ANSI and Unicode - are needed for Stream - HexDecoder. */
-bool CharIsWhitespace(char ch);
-#ifdef _WIN32
-bool CharIsWhitespace(wchar_t ch);
-#endif
-/// Returns true if character is a whitespace
-/** Which means one of characters:
-- <tt>0x09 (9)  "\\t"</tt> - tab
-- <tt>0x0A (10) "\\n"</tt> - end-of-line character
-- <tt>0x0D (13) "\\r"</tt> - end-of-line character
-- <tt>          "\\v"</tt> - vertical space
-- <tt>0x20 (32) " "</tt>  - space */
-inline bool CharIsWhitespace_f(tchar ch)
-{
-	return (ch == _T(' ') || ch == _T('\n') || ch == _T('\r') || ch == _T('\t') || ch == _T('\v'));
-}
-
-/// Szuka w acuchu Str podacucha SubStr, bez rozrniania wielkoci liter.
-/** Zwraca indeks/wskanik do pierwszego znaku pierwszego znalezionego wystpienia wewntrz str.
-Jesli nie znaleziono, zwraca SIZE_MAX. */
-size_t StrStrI(const tstring &Str, const tstring &SubStr, size_t Count = SIZE_MAX);
-const tchar * StrStrI(const tchar *Str, const tchar *SubStr, size_t Count = SIZE_MAX);
-/// Odwraca acuch w miejscu
-void ReverseString(tstring *s);
-/// Obcina biae znaki z pocztku i koca acucha w miejscu
-void Trim(tstring *s);
-/// Obcina biae znaki z pocztku i koca acucha
-void Trim(tstring *Out, const tstring &s);
-
-// UWAGA! Z nieznanych przyczyn UpperCase i LowerCase le konwertuje w stronie
-// kodowej IBM. Lepiej najpierw zmieni wielko liter w innej stronie a potem
-// przekonwertowa na IBM - wtedy dziaa. Kiedy moe naprawi ten bad :/
-
-/// Jeli to litera, konwertuje na ma
-/** - Nie obsuguje wielobajtowych stron kodowych (UTF-8). */
-tchar CharToLower(tchar ch);
-/// Jeli to litera, konwertuje na du
-/** - Nie obsuguje wielobajtowych stron kodowych (UTF-8). */
-tchar CharToUpper(tchar ch);
-/// Konwertuje acuch na mae litery
-/** - Nie obsuguje wielobajtowych stron kodowych (UTF-8). */
-void LowerCase(tstring *s);
-inline void LowerCase(tstring *Out, const tstring &s) { *Out = s; LowerCase(Out); }
-/// Konwertuje acuch na due
-/** - Nie obsuguje wielobajtowych stron kodowych (UTF-8). */
-void UpperCase(tstring *s);
-inline void UpperCase(tstring *Out, const tstring &s) { *Out = s; UpperCase(Out); }
-
-/// Zmienia znak specjalny kodowania Windows-1250 na odpowiednik normalny.
-/** Jesli podany znak jest jednym ze znakow specjalnych Windows-1250,
-zwraca przez a_s jego normalny odpowiednik (mona poda wskanik 0) i zwraca true.
-Jeli to nie jest taki znak, zwraca false. */
-bool Charset_WindowsSpecialChar(char a_c, string *a_s);
-/// Zmienia znak z jednej strony kodowej na druga lub pozostawia bez zmian.
-/** Nie obsluguje stron kodowych wielobajtowych, tzn. UTF-8
-(wynik jest wtedy niezdefiniowany). */
-char Charset_Convert_Char(char a_c, CHARSET a_Charset1, CHARSET a_Charset2);
-/// Konwertuje lancuch na podana strone kodowa
-/** \param[out] out nie moze byc tym samym lancuchem, co s. */
-void Charset_Convert(string *out, const string &s, CHARSET Charset1, CHARSET Charset2);
-
-/// Szyforowanie/deszyfrowanie algorytmem ROT13
-void Rot13(tstring *InOut);
-inline void Rot13(tstring *Out, const tstring &In) { *Out = In; Rot13(Out); }
-
-/// Rodzaj znaku koca wiersza na odpowiadajcy mu znak (lub znaki)
-void EolModeToStr(tstring *Out, EOLMODE EolMode);
-
-/// Zamienia w acuchu wszystkie wystpienia jedego podacucha na drugi
-/** Result musi by oczywicie, jak w kadej takiej funkcji, innym acuchem ni s. */
-void Replace(tstring *result, const tstring &s, const tstring &s1, const tstring &s2);
-/// Zmienia w acuchu wszystkie wystpienia znaku Ch1 na Ch2
-void Replace(tstring *Out, const tstring &s, tchar Ch1, tchar Ch2);
-/// Zmienia w acuchu wszystkie wystpienia znaku Ch1 na Ch2 w miejscu
-void Replace(tstring *InOut, tchar Ch1, tchar Ch2);
-
-/// Zmienia wszelkiego rodzaju znaki koca wiersza w poddanym tekcie na takie same - wg podanego trybu
-void ReplaceEOL(tstring *result, const tstring &s, EOLMODE EOLMode);
-
-/// Zamienia wszystkie odstpy na pojedyncze spacje
-void NormalizeWhitespace(tstring *result, const tstring &s);
-
-/// Zwraca acuch powtrzony podan liczb razy
-void DuplicateString(tstring *Out, const tstring &s, size_t count);
-
-/// Zwraca podacuch z prawej strony
-void RightStr(tstring *Out, const tstring &s, size_t Length);
-
-/// Zwraca liczb wystpie podacucha
-size_t SubstringCount(const tstring &str, const tstring &substr);
-
-/// Porwnuje dwa acuchy bez rozrniania wielkoci liter.
-/** Zwraca liczb ujemn, 0 lub dodatni zalenie od wyniku porwnania. */
-int StrCmpI(const tstring &s1, const tstring &s2, size_t Count = SIZE_MAX);
-int StrCmpI(const tchar *s1, const tchar *s2, size_t Count = SIZE_MAX);
-/// Zwraca true, jeli podfragmenty podanych acuchw s identyczne
-int SubStrCmp(const tstring &s1, size_t off1, const tstring &s2, size_t off2, size_t length);
-/// Zwraca true, jeli podfragmenty podanych acuchw s identyczne nie rozrniajc wielkoci liter
-int SubStrCmpI(const tstring &s1, size_t off1, const tstring &s2, size_t off2, size_t length);
-
-/// Czy acuch zawiera znaki koca wiersza?
-bool ContainsEOL(const tstring &s);
-
-/// Zwraca true, jesli podany lancuch zaczyna sie od podanego podlancucha
-bool StrBegins(const tstring &s, const tstring &sub, bool caseSensitive, size_t Begin = 0);
-/// Zwraca true, jeli podany acuch koczy si podanym podacuchem
-bool StrEnds(const tstring &s, const tstring &Sub, bool caseSensitive);
-
-/// Kolejne wywoania rozdzielaj acuch na kolejne elementy oddzielone w jego treci okrelonym podacuchem
-/** \param[out] out
-\param[in,out] index */
-bool Split(const tstring &s, const tstring &delimiter, tstring *out, size_t *index);
-/// Dziaa jak Split(), ale acuchem rozdzielajcym jest kady dowolny znak z delimiters
-bool SplitFirstOf(const tstring &s, const tstring &delimiters, tstring *out, size_t *index);
-/// Dzieli acuch na czci i zwraca je jako wektor
-void Split(STRING_VECTOR *Out, const tstring &s, const tstring &Delimiter);
-/// Kolejne wywoania rozdzielaj acuch na kolejne elementy oddzielone w jego treci ktr z sekwencji uznawan za koniec wiersza (czyli na kolejne wiersze)
-bool SplitEOL(const tstring &s, tstring *out, size_t *index);
-/// Kolejne wywoania rozdzielaj acuch na elementy oddzielone odstpami uwzgldniajc cigi obite w cudzysowy <tt>""</tt> jako cao
-bool SplitQuery(const tstring &s, tstring *out, size_t *index);
-/// Sprawdza, czy podany ancuch jest zgodny z podan mask mogc zawiera znaki wieloznaczne
-/** '?' zastpuje dowolny jeden znak, '*' zastpuje dowoln liczb (take 0) dowolnych znakw. */
-bool ValidateWildcard(const tstring &Mask, const tstring &S, bool CaseSensitive = true, size_t MaskOff = 0, size_t SOff = 0);
-/// Zwraca zmiennoprzecinkow trafno wyszukiwania stringa SubStr w stringu Str
-/** Zaawansowany algorytm, wymylony przeze mnie dawno temu. Bierze pod uwag
-rzeczy takie jak:
--# ile razy podacuch wystpuje
--# czy pasuje wielko liter
--# dugo acucha i podacucha
--# czy to cae sowo
--# czy to cay acuch. */
-float FineSearch(const tstring &SubStr, const tstring &Str);
-/// Odlego edycyjna midzy dwoma acuchami.
-/** Zoono: O( s1.length * s2.length ).
-Im mniejsza, tym acuchy bardziej podobne. Jeli identyczne, zwraca 0. */
-size_t LevenshteinDistance(const tstring &s1, const tstring &s2);
-/// Odlego edycyjna midzy dwoma acuchami bez uwzgldniania wielkoci liter.
-/** Zoono: O( s1.length * s2.length ).
-Im mniejsza, tym acuchy bardziej podobne. Jeli identyczne, zwraca 0. */
-size_t LevenshteinDistanceI(const tstring &s1, const tstring &s2);
-
-/** \addtogroup base_natural_sort Sortowanie naturalne
-Sortowanie naturalne, czyli takie, w ktrym np. "abc2" jest przed "abc120". */
-//@{
-
-/// Klasa do porwnywania w porzdku naturalnym.
-class StringNaturalCompare
-{
-private:
-	bool m_CaseInsensitive;
-
-	int CompareNumbers(const tstring &s1, size_t i1, const tstring &s2, size_t i2);
-
-public:
-	StringNaturalCompare(bool CaseInsensitive) : m_CaseInsensitive(CaseInsensitive) { }
-	int Compare(const tstring &s1, const tstring &s2);
-};
-
-/// Predykat do sortowania acuchw w porzdku naturalnym
-/** Przykad uycia:
-\code
-std::vector<string> v;
-std::sort(v.begin(), v.end(), common::StringNaturalLess());
-\endcode
-*/
-class StringNaturalLess : public StringNaturalCompare
-{
-public:
-	StringNaturalLess(bool CaseInsensitive = true) : StringNaturalCompare(CaseInsensitive) { }
-	bool operator () (const tstring &s1, const tstring &s2) { return (Compare(s1, s2) < 0); }
-};
-
-/// Predykat do sortowania acuchw w porzdku naturalnym
-class StringNaturalGreater : public StringNaturalCompare
-{
-public:
-	StringNaturalGreater(bool CaseInsensitive = true) : StringNaturalCompare(CaseInsensitive) { }
-	bool operator () (const tstring &s1, const tstring &s2) { return (Compare(s1, s2) > 0); }
-};
-
-//@}
-
-/// Predykat do porwnywania acuchw bez rozrniania wielkoci liter.
-class StrLessI
-{
-public:
-	bool operator () (const tstring &s1, const tstring &s2) { return StrCmpI(s1, s2) < 0; }
-};
-/// Predykat do porwnywania acuchw bez rozrniania wielkoci liter.
-class StrGreaterI
-{
-public:
-	bool operator () (const tstring &s1, const tstring &s2) { return StrCmpI(s1, s2) > 0; }
-};
-
-/** \addtogroup base_cstr C-style strings */
-//@{
-
-/// Zwraca true, jeli podany acuch jest NULL lub zawiera 0 znakw (od razu ma koczce '\0').
-inline bool StrIsEmpty(const char *s) { return s == NULL || *s == '\0'; }
-/// Czyci acuch wpisujc samo koczce '\0'.
-inline void ClearStr(char *s) { assert(s); *s = '\0'; }
-
-#ifdef _WIN32
-	inline bool StrIsEmpty(const wchar_t *s) { return s == NULL || *s == L'\0'; }
-	inline void ClearStr(wchar_t *s) { assert(s); *s = L'\0'; }
-#endif
-
-/// Szuka w acuchu str podacucha substr, bez rozrniania wielkoci liter.
-/** Zwraca wskanik do pierwszego znaku pierwszego znalezionego wystpienia wewntrz str.
-Jesli nie znaleziono, zwraca NULL. */
-const tchar * strnistr(const tchar *str, const tchar *substr, size_t count = SIZE_MAX);
-// Zwraca true, jeli acuch str zaczyna si od acucha substr
-bool StrBegins(const tchar *str, const tchar *substr, bool caseSensitive);
-/// Zwraca true, jeli acuch str koczy si na acuch substr
-bool StrEnds(const tchar *str, const tchar *substr, bool caseSensitive);
-/// Usuwa podany zakres znakw z acucha. Jest bezpieczny na przekroczenie zakresu.
-void StrErase(tchar *str, size_t off, size_t count = SIZE_MAX);
-/// Wstawia podany podacuch do acucha w podane miejsce.
-void StrInsert(tchar *str, size_t strCapacity, const tchar *newStr, size_t off, size_t count);
-void StrInsert(tchar *str, size_t strCapacity, const tchar *newStr, size_t off);
-/// Obcina z pocztku i koca stringa biae znaki (w miejscu)
-void Trim(tchar *s);
-/// Replaces in string src all "from" chars to "to" chars. Returns number of occurences.
-unsigned StrReplace(tchar *str, tchar from, tchar to);
-
-//@}
-// base_cstr
-
-
-/** \addtogroup base_unicode Obsuga Unicode
-Dostpne tylko w Windows. */
-//@{
-
-#ifdef _WIN32
-
-/** \addtogroup base_unicode_convs Konwersje acuchw Unicode
-
-Konwersje midzy acuchem Unicode (UTF-16) a acuchem w innym kodowaniu - Single Byte lub Multi Byte.
-
-CodePage to kodowanie znakw typu char. Przykadowe wartoci:
-  - Stae: CP_UTF8 (UTF-8), CP_ACP (natywna, 1-bajtowa strona kodowa systemu).
-  - Numery takie jak 1250 dla kodowania Windows-1250 (p. MSDN > "Code Page Identifiers").
-
-Funkcje zwracaj false w przypadku niepowodzenia konwersji. Wwczas Out jest pusty.
-*/
-//@{
-
-bool ConvertUnicodeToChars(string *Out, const wstring &S, unsigned CodePage);
-bool ConvertUnicodeToChars(string *Out, const wchar_t *S, size_t NumChars, unsigned CodePage);
-
-bool ConvertCharsToUnicode(wstring *Out, const string &S, unsigned CodePage);
-bool ConvertCharsToUnicode(wstring *Out, const char *S, size_t NumChars, unsigned CodePage);	
-
-/// Oblicza liczb znakw (nie bajtw!) potrzebn przy konwersji midzy Unicode i ANSI.
-/** Bd: Zwraca false, outLen ustawia na 0. */
-bool UnicodeToChars_CalcBufLen(size_t &outLen, const wchar_t *wcs, unsigned CodePage);
-bool UnicodeToChars_CalcBufLen(size_t &outLen, const wchar_t *wcs, size_t wcsLen, unsigned CodePage);
-bool CharsToUnicode_CalcBufLen(size_t &outLen, const char *str, unsigned CodePage);
-bool CharsToUnicode_CalcBufLen(size_t &outLen, const char *str, size_t strLen, unsigned CodePage);
-
-/// Konwertuje acuch midzy Unicode i ANSI. Nie docza koczcego zera.
-/** Bd: zwraca false, outBuf ustawia na acuch pusty. */
-bool ConvertUnicodeToChars(char *outBuf, size_t bufLen, const wchar_t *wcs, unsigned CodePage);
-bool ConvertUnicodeToChars(char *outBuf, size_t bufLen, const wchar_t *wcs, size_t wcsLen, unsigned CodePage);
-bool ConvertCharsToUnicode(wchar_t *outBuf, size_t bufLen, const char *str, unsigned CodePage);
-bool ConvertCharsToUnicode(wchar_t *outBuf, size_t bufLen, const char *str, size_t strLen, unsigned CodePage);
-
-//@}
-
-/** \addtogroup base_unicode_headers Nagwki Unicode
-acuchy zakoczone zerem - nagwki poszczeglnych formatw Unicode.
-(Standardowo uywany w Windows jest UTF-16 Little Endian.) */
-//@{
-extern const char * const BOM_UTF8;
-extern const char * const BOM_UTF16_LE;
-extern const char * const BOM_UTF16_BE;
-//@}
-
-#endif
-
-/** \addtogroup base_unicode_conv_functions Konwersje midzy tstring, string, wstring
-W przypadku niepowodzenia zwracaj false i Out jest wtedy pusty. */
-//@{
-#ifdef _UNICODE
-	bool TstringToString(string *Out, const tstring &S);
-	bool StringToTstring(tstring *Out, const string &S);
-	inline bool TstringToWstring(wstring *Out, const tstring &S) { *Out = S; return true; }
-	inline bool WstringToTstring(tstring *Out, const wstring &S) { *Out = S; return true; }
-
-	inline string TstringToStringR(const tstring &S) { string R;  if (!TstringToString(&R, S)) return string();  return R; }
-	inline tstring StringToTstringR(const string &S) { tstring R; if (!StringToTstring(&R, S)) return tstring(); return R; }
-	inline wstring TstringToWstring(const tstring &S) { return S; }
-	inline tstring WstringToTstring(const wstring &S) { return S; }
-#else
-	inline bool TstringToString(string *Out, const tstring &S) { *Out = S; return true; }
-	inline bool StringToTstring(tstring *Out, const string &S) { *Out = S; return true; }
-	inline string TstringToStringR(const tstring &S) { return S; }
-	inline tstring StringToTstringR(const string &S) { return S; }
-	#ifdef _WIN32
-		bool TstringToWstring(wstring *Out, const tstring &S);
-		bool WstringToTstring(tstring *Out, const wstring &S);
-		inline wstring TstringToWstringR(const tstring &S) { wstring R; if (!TstringToWstring(&R, S)) return wstring(); return R; }
-		inline tstring WstringToTstringR(const wstring &S) { tstring R; if (!WstringToTstring(&R, S)) return tstring(); return R; }
-	#endif
-#endif
-//@}
-// Konwersje midzy tstring, string, wstring
-
-//@}
-// Obsuga Unicode
-
-//@}
-// acuchy
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-/** \addtogroup base_paths cieki do plikw */
-//@{
-
-#ifdef _WIN32
-	/// Separator katalogw w ciece, zaleny od platformy.
-	const tchar DIR_SEP = _T('\\');
-#else
-	const tchar DIR_SEP = _T('/');
-#endif
-
-/// Zwraca true, jeli cieka jest bezwzgldna
-bool PathIsAbsolute(const tstring &s);
-/// Dodaje do sciezki konczacy '/' lub '\', jesli go nie ma - na miejscu
-void IncludeTrailingPathDelimiter(tstring *InOutPath);
-/// Dodaje do sciezki konczacy '/' lub '\', jesli go nie ma - do nowego stringa
-void IncludeTrailingPathDelimiter(tstring *OutPath, const tstring &InPath);
-/// Pozbawia sciezke konczacego '/' lub '\', jesli go ma - na miejscu
-void ExcludeTrailingPathDelimiter(tstring *InOutPath);
-/// Pozbawia sciezke konczacego '/' lub '\', jesli go ma - do nowego stringa
-void ExcludeTrailingPathDelimiter(tstring *OutPath, const tstring &InPath);
-/// Zwraca pocztek cieki, w postaci takiej jak "C:\", "\\komputer\udzia\" czy "/" albo "\"
-/** Jeli cieka jest wzgldna, zwraca acuch pusty. */
-void ExtractPathPrefix(tstring *OutPrefix, const tstring &s);
-/// Zwraca ciek do pliku bez nazwy pliku
-void ExtractFilePath(tstring *OutPath, const tstring &s);
-/// Zwraca sam nazw pliku bez cieki
-void ExtractFileName(tstring *OutFileName, const tstring &s);
-/// Zwraca rozszerzenie pliku wraz z kropk
-void ExtractFileExt(tstring *OutExt, const tstring &s);
-/// Zmienia w nazwie pliku rozszerzenie na nowe
-/** Jesli Ext = "", usuwa rozszerzenie.
-Nowe rozszerzenie musi zawiera rozpoczynajc kropk (tzn. nie musi, ale wypadaoby :) */
-void ChangeFileExt(tstring *Out, const tstring &FileName, const tstring &Ext);
-/// Pozbawia sciezke artefaktow typu ".\\" czy "..\\"
-/** Odpowiednio ja oczywiscie przetwarza tak, ze wyjscie jest logicznie rownowazne wejsciu. */
-void NormalizePath(tstring *OutPath, const tstring &s);
-/// Przetwarza sciezke wzgledna na bezwzgledna wzgledem okreslonej sciezki
-/** Na przykad Base="C:\\Kat", Path="PodKat\\Plik.txt", Wynik="C:\\Kat\\PodKat\\Plik.txt". */
-void RelativeToAbsolutePath(tstring *Out, const tstring &Base, const tstring &Path);
-/// Przetwarza sciezke bezwzgledna na wzgledna wzgledem okreslonej sciezki
-/** Jeli si nie da, wychodzi rwnie bezwzgldna, rwna Target.
-Na przykad Base="C:\\Kat", Tareget="C:\\Kat\\Podkat\\Plik.txt", Wynik="PodKat\\Plik.txt". */
-void AbsoluteToRelativePath(tstring *Out, const tstring &Base, const tstring &Target);
-
-//@}
-// cieki do plikw
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-/** \addtogroup base_conversions Konwersje midzy acuchem a rnymi typami */
-/**
-Staraem si zagwarantowa w Windows (w Linux jeszcze nie - moe kiedy...),
-eby konwersje zawsze dziaay tak samo niezalenie od locale ustawionego w
-bibliotece standardowej C (funkcja setlocale), C++ (klasa locale) czy WinAPI
-(funkcja SetThreadLocale). Szczeglnie konwersje midzy liczb
-zmiennoprzecinkow a acuchem zawsze uywaj kropki, a nie przecinka.
-*/
-//@{
-
-/** \internal */
-extern const tchar _DIGITS_L[];
-/** \internal */
-extern const tchar _DIGITS_U[];
-
-/// Zwraca liczbowy odpowiednik cyfry szesnastkowej.
-/** Jeli bd, zwraca 0xFF.
-Akceptuje zarwno mae, jak i due litery.
-(Dwie wersje tej funkcji - osobno dla ANSI i Unicode - s potrzebne w Stream - HexDecoder.) */
-inline int HexDigitToNumber(char Ch)
-{
-	if      (Ch >= '0' && Ch <= '9') return (int)(uint8)(Ch -  '0');
-	else if (Ch >= 'A' && Ch <= 'F') return (int)(uint8)(Ch - ('A' - 10));
-	else if (Ch >= 'a' && Ch <= 'f') return (int)(uint8)(Ch - ('a' - 10));
-	else return 0xFF;
-}
-#ifdef _WIN32
-inline int HexDigitToNumber(wchar_t Ch)
-{
-	if      (Ch >= L'0' && Ch <= L'9') return (int)(Ch -  L'0');
-	else if (Ch >= L'A' && Ch <= L'F') return (int)(Ch - (L'A' - 10));
-	else if (Ch >= L'a' && Ch <= L'f') return (int)(Ch - (L'a' - 10));
-	else return 0xFF;
-}
-#endif
-
-/// Konwersja liczby cakowitej na acuch
-/** \param Base musi by z zakresu 2..36 */
-template <typename T>
-void UintToStr(tstring *Out, T x, uint32 Base = 10, bool UpperCase = true)
-{
-	if (x == 0)
-	{
-		Out->assign(_T("0"));
-		return;
-	}
-
-	Out->clear();
-	Out->reserve(8);
-
-	// Podstawa to potga dwjki - bdzie prociej, bo przesuwanie bitowe zamiast dzielenia
-	if (IsPow2<uint32>(Base))
-	{
-		// O ile bitw przesuwa?
-		uint32 Bits = log2u(Base);
-		// Maska bitowa do &-owania
-		uint32 BitMask = GetBitMask(Bits);
-		// Jazda!
-		if (UpperCase)
-		{
-			while (x != 0)
-			{
-				*Out += _DIGITS_U[x & BitMask];
-				x = x >> Bits;
-			}
-		}
-		else
-		{
-			while (x != 0)
-			{
-				*Out += _DIGITS_L[x & BitMask];
-				x = x >> Bits;
-			}
-		}
-	}
-	// Podstawa to nie potga dwjki
-	else
-	{
-		if (UpperCase)
-		{
-			while (x != 0)
-			{
-				*Out += _DIGITS_U[x % Base];
-				x /= Base;
-			}
-		}
-		else
-		{
-			while (x != 0)
-			{
-				*Out += _DIGITS_L[x % Base];
-				x /= Base;
-			}
-		}
-	}
-
-	ReverseString(Out);
-}
-
-template <typename T>
-void IntToStr(tstring *Out, T x, uint32 Base = 10, bool UpperCase = true)
-{
-	if (x == 0)
-	{
-		Out->assign(_T("0"));
-		return;
-	}
-
-	Out->clear();
-	Out->reserve(8);
-
-	// Liczba dodatnia - identycznie jak w UintToStr
-	if (x > 0)
-	{
-		// Podstawa to potga dwjki - bdzie prociej, bo przesuwanie bitowe zamiast dzielenia
-		if (IsPow2<uint32>(Base))
-		{
-			// O ile bitw przesuwa?
-			uint32 Bits = log2u(Base);
-			// Maska bitowa do &-owania
-			uint32 BitMask = GetBitMask(Bits);
-			// Jazda!
-			if (UpperCase)
-			{
-				while (x != 0)
-				{
-					*Out += _DIGITS_U[x & BitMask];
-					x = x >> Bits;
-				}
-			}
-			else
-			{
-				while (x != 0)
-				{
-					*Out += _DIGITS_L[x & BitMask];
-					x = x >> Bits;
-				}
-			}
-		}
-		// Podstawa to nie potga dwjki
-		else
-		{
-			if (UpperCase)
-			{
-				while (x != 0)
-				{
-					*Out += _DIGITS_U[x % Base];
-					x /= Base;
-				}
-			}
-			else
-			{
-				while (x != 0)
-				{
-					*Out += _DIGITS_L[x % Base];
-					x /= Base;
-				}
-			}
-		}
-	}
-	// Liczba ujemna - tu bdzie musiao by inaczej
-	// Modulo jest UB, wic uyjemy obejcia.
-	else
-	{
-		T x_div_base;
-		if (UpperCase)
-		{
-			while (x != 0)
-			{
-				x_div_base = x/(T)Base;
-				*Out += _DIGITS_U[- (x - x_div_base*(T)Base)];
-				x = x_div_base;
-			}
-		}
-		else
-		{
-			while (x != 0)
-			{
-				x_div_base = x/(T)Base;
-				*Out += _DIGITS_L[- (x - x_div_base*(T)Base)];
-				x = x_div_base;
-			}
-		}
-		*Out += '-';
-	}
-
-	ReverseString(Out);
-}
-
-/// Konwertuje znak cyfry w dowolnym systemie ('0'..'9', 'A'..'Z', 'a'..'z') na liczb, zwraca false jeli bd.
-/** \internal */
-template <typename T>
-bool _CharToDigit(T *Digit, tchar ch)
-{
-	if (ch >= _T('0') && ch <= _T('9'))
-		*Digit = static_cast<T>(ch-_T('0'));
-	else if (ch >= _T('A') && ch <= _T('Z'))
-		*Digit = static_cast<T>(ch-_T('A')+10);
-	else if (ch >= _T('a') && ch <= _T('z'))
-		*Digit = static_cast<T>(ch-_T('a')+10);
-	else
-		return false;
-	return true;
-}
-
-/// Konwersja acucha na liczb cakowit
-/** \return Zwraca:
--  0 - sukces
-- -1 - bd skadni acucha
-- -2 - przekroczenie zakresu */
-template <typename T>
-int StrToUint(T *Number, const tstring &str, unsigned Base = 10)
-{
-	T BaseT = static_cast<T>(Base);
-	if (str.empty()) return -1;
-	*Number = 0;
-	T Digit, LastNumber = 0, Limit = std::numeric_limits<T>::max()/BaseT;
-	for (size_t i = 0; i < str.length(); ++i) {
-		if (!_CharToDigit(&Digit, str[i])) return -1;
-		if (Digit >= BaseT)  return -1;
-		if (*Number > Limit) return -2;
-		*Number = *Number * BaseT + Digit;
-		if (*Number < LastNumber) return -2;
-		LastNumber = *Number;
-	}
-	return 0;
-}
-
-template <typename T>
-int StrToInt(T *Number, const tstring &str, unsigned Base = 10)
-{
-	T BaseT = static_cast<T>(Base);
-	if (str.empty()) return -1;
-	*Number = 0;
-	size_t i = 0;
-	int Sign = +1;
-	if (str[0] == '+') i = 1;
-	else if (str[0] == '-') { Sign = -1; i = 1; }
-	T Digit, LastNumber = 0, Limit;
-	if (Sign > 0) Limit = std::numeric_limits<T>::max()/BaseT;
-	else          Limit = std::numeric_limits<T>::min()/BaseT;
-	for (; i < str.length(); ++i) {
-		if (!_CharToDigit(&Digit, str[i])) return -1;
-		if (Digit >= BaseT) return -1;
-		if (Sign > 0) { if (*Number > Limit) return -2; }
-		else          { if (*Number < Limit) return -2; }
-		*Number = *Number * BaseT + Digit * Sign;
-		if (Sign > 0) { if (*Number < LastNumber) return -2; }
-		else          { if (*Number > LastNumber) return -2; }
-		LastNumber = *Number;
-	}
-	return 0;
-}
-
-template <typename T> inline tstring IntToStrR (T x, int base = 10, bool UpperCase = true) { tstring r; IntToStr<T> (&r, x, base, UpperCase); return r; }
-template <typename T> inline tstring UintToStrR(T x, int base = 10, bool UpperCase = true) { tstring r; UintToStr<T>(&r, x, base, UpperCase); return r; }
-
-inline void Size_tToStr(tstring *Out, size_t x, uint Base = 10, bool UpperCase = true) { UintToStr<size_t>(Out, x, Base, UpperCase); }
-inline tstring Size_tToStrR(size_t x, uint Base = 10, bool UpperCase = true) { tstring R; Size_tToStr(&R, x, Base, UpperCase); return R; }
-
-/// Konwersja liczby na acuch o minimalnej podanej dugoci.
-/** Zostanie do tej dugoci uzupeniony zerami. */
-template <typename T>
-void UintToStr2(tstring *Out, T x, size_t Length, int base = 10)
-{
-	tstring Tmp;
-	UintToStr(&Tmp, x, base);
-	if (Tmp.length() >= Length)
-		*Out = Tmp;
-	else
-	{
-		Out->clear();
-		Out->reserve(std::max(Tmp.length(), Length));
-		for (size_t Left = Length - Tmp.length(); Left > 0; Left--)
-			*Out += _T('0');
-		*Out += Tmp;
-	}
-}
-template <typename T>
-void IntToStr2(tstring *Out, T x, size_t Length, int base = 10)
-{
-	tstring Tmp;
-	IntToStr<T>(&Tmp, x, base);
-	if (Tmp.length() >= Length)
-		*Out = Tmp;
-	else
-	{
-		Out->clear();
-		Out->reserve(std::max(Tmp.length(), Length));
-		assert(!Tmp.empty());
-		if (Tmp[0] == _T('-'))
-		{
-			*Out += _T('-');
-			for (size_t Left = Length - Tmp.length(); Left > 0; Left--)
-				*Out += _T('0');
-			Out->append(Tmp.begin()+1, Tmp.end());
-		}
-		else
-		{
-			for (size_t Left = Length - Tmp.length(); Left > 0; Left--)
-				*Out += _T('0');
-			*Out += Tmp;
-		}
-	}
-}
-
-template <typename T> tstring UintToStr2R(T x, size_t Length, int Base = 10) { tstring R; UintToStr2<T>(&R, x, Length, Base); return R; }
-template <typename T> tstring IntToStr2R (T x, size_t Length, int Base = 10) { tstring R; IntToStr2<T> (&R, x, Length, Base); return R; }
-
-/// Konwertuje znak na acuch, jako e automatycznie to si niestety nie odbywa
-inline void CharToStr(tstring *Out, tchar ch) { Out->clear(); *Out += ch; }
-inline tstring CharToStrR(tchar ch) { tstring s; s += ch; return s; }
-
-/// Konwersja liczb zmiennoprzecinkowych na acuch
-/** \param Mode:
-- 'e' : -0.12345e-001
-- 'E' : -0.12345E-001
-- 'f' : -0.12345
-- 'g' : optimum ('e', 'f')
-- 'G' : optimum ('E', 'f')
-\param Precision 0..20 */
-void DoubleToStr(tstring *Out, double x, char Mode = 'g', int Precision = 6);
-void FloatToStr(tstring *Out, float x, char Mode = 'g', int Precision = 6);
-
-inline tstring DoubleToStrR(double x, char Mode = 'g', int Precision = 6) { tstring R; DoubleToStr(&R, x, Mode, Precision); return R; }
-inline tstring FloatToStrR (float x, char Mode = 'g', int Precision = 6) { tstring R;  FloatToStr (&R, x, Mode, Precision); return R; }
-
-/// Konwersja acucha na liczb zmiennoprzecinkow.
-/**
-- W przypadku bdu skadni zwracaj warto != 0.
-- Bdy zakresu nie s sprawdzane - wynik niezdefiniowany. */
-int StrToDouble(double *out, const tstring &s);
-int StrToFloat (float *out,  const tstring &s);
-
-/// Konwertuje warto logiczn na acuch
-/** \param mode:
-- '0' : 0 / 1
-- 'f' : false / true
-- 'F' : False / True
-- 'U' : FALSE / TRUE
-- 'g' : f / t
-- 'G' : F / T */
-void BoolToStr(tstring *Out, bool x, char mode = 'f');
-inline tstring BoolToStrR(bool x, char mode = 'f') { tstring R; BoolToStr(&R, x, mode); return R; }
-/// Konwertuje acuch na warto logiczn
-/**
-- Dozwolone wszelkie wartoci jak w BoolToStr.
-- Bd: zwraca false. */
-bool StrToBool(bool *result, const tstring &s);
-
-/// Konwertuje wskanik na acuch 8 znakw zapisany szesnastkowo
-void PtrToStr(tstring *Out, const void* p);
-inline tstring PtrToStrR(const void *p) { tstring R; PtrToStr(&R, p); return R; }
-
-/// Liczba bajtw na acuch z rozmiarem np. "1 B", "10.5 kB"
-/** Jako T uzywac uint8, uint16, uint32, uint64 lub int ale na pewno wartoci dodaniej.
-\param Space czy midzy liczb a jednostk dawa spacj
-\param Precision ilo cyfr po przecinku (moe by te 0) */
-template <typename T>
-void SizeToStr(tstring *str, T size, bool Space, int Precision)
-{
-	double size2 = (double)size;
-	if (size2 >= 1024.0*1024.0*1024.0*1024.0)
-	{
-		DoubleToStr( str, size2/(1024.0*1024.0*1024.0*1024.0), 'f', Precision );
-		str->append(Space ? _T(" TB") : _T("TB"));
-	}
-	else if (size2 >= 1024.0*1024.0*1024.0)
-	{
-		DoubleToStr( str, size2/(1024.0*1024.0*1024.0), 'f', Precision );
-		str->append(Space ? _T(" GB") : _T("GB"));
-	}
-	else if (size2 >= 1024.0*1024.0)
-	{
-		DoubleToStr( str, size2/(1024.0*1024.0), 'f', Precision );
-		str->append(Space ? _T(" MB") : _T("MB"));
-	}
-	else if (size2 >= 1024.0)
-	{
-		DoubleToStr( str, size2/1024.0, 'f', Precision );
-		str->append(Space ? _T(" KB") : _T("KB"));
-	}
-	else
-	{
-		UintToStr( str, size );
-		str->append(Space ? _T(" B") : _T("B"));
-	}
-}
-template <typename T> tstring SizeToStrR(T Size, bool Space, int Precision) { tstring r; SizeToStr<T>(&r, Size, Space, Precision); return r; }
-
-//@}
-// Konwersje midzy acuchem a rnymi typami
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-/** \addtogroup base_periodic_funcs Funkcje okresowe */
-//@{
-
-/*
-Funkcje zwracajce rnego rodzaju przebiegi okresowe.
-Domylne (bez ustawianych wasnych parametrw) maj zakres wyjciowy 0..1,
-czstotliwo 1 i faz 0.
-- Base      - dolne ograniczenie
-- Amplitude - pena wysoko
-*/
-
-/// Standard sine wave which smoothly changes from low to high and back again.
-inline float WaveformSine(float x, float Base, float Amplitude, float Frequency, float Phase)
-{
-	return Base + (sinf((x + Phase) * Frequency * PI_X_2)+1.0f)*0.5f * Amplitude;
-}
-inline float WaveformSine(float x)
-{
-	return (sinf(x * PI_X_2)+1.0f)*0.5f;
-}
-
-/// An angular wave with a constant increase / decrease speed with pointed peaks.
-inline float WaveformTriangle(float x, float Base, float Amplitude, float Frequency, float Phase)
-{
-	float Input = frac((x + Phase) * Frequency);
-	float Output;
-	if (Input < 0.25f)
-		Output = Input * 4.0f;
-	else if (Input < 0.75f)
-		Output = 1.0f - ((Input - 0.25f) * 4.0f);
-	else
-		Output = ((Input - 0.75f) * 4.0f) - 1.0f;
-	return Base + (Output+1.0f)*0.5f * Amplitude;
-}
-inline float WaveformTriangle(float x)
-{
-	float Input = frac(x);
-	float Output;
-	if (Input < 0.25f)
-		Output = Input * 4.0f;
-	else if (Input < 0.75f)
-		Output = 1.0f - ((Input - 0.25f) * 4.0f);
-	else
-		Output = ((Input - 0.75f) * 4.0f) - 1.0f;
-	return (Output+1.0f)*0.5f;
-}
-
-/// Half of the time is spent at the min, half at the max with instant transition between.
-inline float WaveformSquare(float x, float Base, float Amplitude, float Frequency, float Phase)
-{
-	return Base + (frac((x + Phase) * Frequency) <= 0.5f ? 1.0f : 0.0f) * Amplitude;
-}
-inline float WaveformSquare(float x)
-{
-	return frac(x) <= 0.5f ? 1.0f : 0.0f;
-}
-
-/// Gradual steady increase from min to max over the period with an instant return to min at the end.
-inline float WaveformSawtooth(float x, float Base, float Amplitude, float Frequency, float Phase)
-{
-	return Base + frac((x + Phase) * Frequency) * Amplitude;
-}
-inline float WaveformSawtooth(float x)
-{
-	return frac(x);
-}
-
-/// Gradual steady decrease from max to min over the period, with an instant return to max at the end.
-inline float WaveformInvSawtooth(float x, float Base, float Amplitude, float Frequency, float Phase)
-{
-	return Base + (1.0f - frac((x + Phase) * Frequency)) * Amplitude;
-}
-inline float WaveformInvSawtooth(float x)
-{
-	return 1.0f - frac(x);
-}
-
-/// Pulse Width Modulation.
-/** Works like square, except the high to low transition is controlled by duty
-cycle. With a duty cycle of 50% (0.5) will give the same output as square. */
-inline float WaveformPWM(float x, float DutyCycle, float Base, float Amplitude, float Frequency, float Phase)
-{
-	return Base + (frac((x + Phase) * Frequency) <= DutyCycle ? 1.0f : 0.0f) * Amplitude;
-}
-inline float WaveformPWM(float x, float DutyCycle)
-{
-	return (frac(x) <= DutyCycle ? 1.0f : 0.0f);
-}
-
-//@}
-// Funkcje okresowe
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-/** \addtogroup base_random_gen Generator liczb pseudolosowych
-*/
-//@{
-
-/// Generator liczb pseudolosowych
-/** Jest przede wszystkim szybki. Nie jest bardzo dobrze losowy. Mona go uywa
-jako deterministycznego tworzc wasne obiekty tej klasy i rcznie je
-naziarniajc. */
-class RandomGenerator
-{
-private:
-	// Current seed
-	uint32 m_Seed;
-	float m_NextNormalNumber; bool m_HasNextNormalNumber;
-
-public:
-	/// Constructor - seed from the clock
-	RandomGenerator();
-	/// Constructor - seed with given seed
-	RandomGenerator(uint32 seed) : m_Seed(seed), m_HasNextNormalNumber(false) { }
-
-	/// Wpisuje nowe ziarno.
-	void Seed(uint32 a_Seed)
-	{
-		m_Seed = a_Seed;
-	}
-
-	/// Generuje liczb losow cakowit bez znaku, peny zakres
-	/** Na podstawie ksiki "Pereki programowania gier", tom III, Dante Treglia
-	Uwaga! Modsze bity s sabo losowe, powtarzaj si w bardzo krtkim okresie. */
-	uint32 RandUint_Fast()
-	{
-		return ( m_Seed = (m_Seed * 196314165 + 907633515) );
-	}
-	/// Generuje liczb losow, w ktrej wszystkie bity s do losowe
-	uint32 RandUint()
-	{
-		return
-			(RandUint_Fast() & 0xFF000000)       |
-			(RandUint_Fast() & 0xFF000000) >>  8 |
-			(RandUint_Fast() & 0xFF000000) >> 16 |
-			(RandUint_Fast() & 0xFF000000) >> 24;
-	}
-	/// Generuje liczb losow w zakresie 0 .. max-1
-	uint32 RandUint(uint32 max)
-	{
-		return RandUint() % max;
-	}
-	/// Generuje liczb losow w zakresie min .. max-1
-	uint32 RandUint(uint32 min, uint32 max)
-	{
-		return RandUint() % (max-min) + min;
-	}
-
-	/// Generuje losowy bajt
-	uint8 RandByte()
-	{
-		return (RandUint_Fast() & 0xFF000000) >> 24;
-	}
-
-	/// Generuje liczb losow rzeczywist z przedziau 0.0..1.0
-	/** Autor tego genialnego algorytmu: Mikael */
-	float RandFloat()
-	{
-		return absolute_cast<float>(RandUint() & 0x007FFFFF | 0x3F800000) - 1.0f;
-	}
-	/// Generuje liczb losow rzeczywist z przedziau 0.0..max
-	float RandFloat(float max)
-	{
-		return RandFloat() * max;
-	}
-	/// Generuje liczb losow rzeczywist z przedziau min..max
-	float RandFloat(float min, float max)
-	{
-		return RandFloat() * (max - min) + min;
-	}
-	/// Generates random real number in range -1..1. (not sure whether inclusive).
-	/** Author: iq/rgba, http://www.rgba.org/articles/sfrand/sfrand.htm */
-	float RandFloat2()
-	{
-		uint a = (RandUint() & 0x007fffff) | 0x40000000;
-		return( *((float*)&a) - 3.0f );
-	}
-
-	/// Generuje losowy stan logiczny
-	bool RandBool()
-	{
-		return (RandUint() >= 0x7FFFFFFFu);
-	}
-
-	/// Generuje liczb losow cakowit ze znakiem z zakresu Min .. Max-1
-	int RandInt(int Min, int Max)
-	{
-		if (Max > Min)
-			return static_cast<int>(RandUint(Max-Min)) + Min;
-		else
-			return static_cast<int>(RandUint(Min-Max)) + Max;
-	}
-
-	/// Wypenia podany bufor losowymi danymi binarnymi
-	/** \param DataLength w bajtach. */
-	void RandData(void *OutData, size_t DataLength);
-
-	/// Generuje liczb losow o rozkadzie normalnym (Gaussa)
-	/** Zgodnie z definicj, wylosowana liczba ley w zakresie z prawdopodobiestwem:
-	- -1 * sigma .. +1 * sigma : 68%
-	- -2 * sigma .. +2 * sigma : 95%
-	- -3 * sigma .. +3 * sigma : 99.73% */
-	float RandNormal(float sigma);
-};
-
-/// Domylny generator liczb losowych do uywania w wtku gwnym i kiedy nie musi by deterministyczny
-extern RandomGenerator g_Rand;
-
-/// Wolniejszy w inicjalizacji, generowaniu i wikszy, ale za to tuo lepszy generator liczb pseudolosowych.
-/** rdo:
-Mersenne Twister Home Page,
-http://www.math.sci.hiroshima-u.ac.jp/~m-mat/MT/emt.html
-*/
-class MersenneTwister
-{
-public:
-	/// Inicjalizuje biecym czasem systemowym
-	MersenneTwister();
-	/// Inicjalizuje podanym ziarnem
-	MersenneTwister(uint Seed);
-	/// Inicjalizuje ziarnem w postaci podanej tablicy
-	MersenneTwister(uint InitKeys[], int KeyCount);
-
-	/// Generuje liczb uint [0,0xffffffff]
-	uint NextUint();
-	/// Generuje liczb int [0,0x7fffffff]
-	int NextInt31();
-	/// Generuje liczb double [0,1]
-	double NextReal1();
-	/// Generuje liczb double [0,1)
-	double NextReal2();
-	/// Generuje liczb double (0,1)
-	double NextReal3();
-	/// Generuje liczb double [0,1) z rozdzielczoci 53 bitw
-	double NextReal_Res53();
-
-private:
-	uint m_State[624];
-	int m_Left;
-	uint *m_Next;
-
-	void Init(uint Seed);
-	void NextState();
-};
-
-/// Generator unikatowych identyfikatorw
-class UniqueGenerator
-{
-private:
-	uint32 m_Next;
-
-public:
-	/// Pierwszy bdzie mia nr 1.
-	UniqueGenerator();
-	/// Pierwszy bdzie mia podany tutaj numer
-	UniqueGenerator(uint32 First);
-
-	/// Zwraca unikatow liczb
-	uint32 GetUint() { return m_Next++; }
-	/// Zwraca unikatowy acuch w formacie "########", gdzie ######## to liczba szesnastkowa.
-	void GetString(tstring *Out);
-	tstring GetString() { tstring R; GetString(&R); return R; }
-	/// Zwraca unikatowy acuch w formacie "<prefix>########", gdzie ######## to liczba szesnastkowa.
-	void GetString(tstring *Out, const tstring &Prefix);
-	/// \copydoc GetString(tstring*,const tstring&)
-	tstring GetString(const tstring &Prefix) { tstring R; GetString(&R, Prefix); return R; }
-};
-
-//@}
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-// Parser wiersza polece
-
-/// \internal
-class CmdLineParser_pimpl;
-
-/// Parser wiersza polece
-class CmdLineParser
-{
-private:
-	scoped_ptr<CmdLineParser_pimpl> pimpl;
-
-public:
-	/// Rodzaj pobranej informacji
-	enum RESULT
-	{
-		RESULT_OPT,       ///< Opcja
-		RESULT_PARAMETER, ///< Goy parametr bez opcji
-		RESULT_END,       ///< Koniec parametrw
-		RESULT_ERROR,     ///< Bd skadni
-	};
-
-	/// Wersja dla main(int argc, char **argv)
-	CmdLineParser(int argc, tchar **argv);
-	/// Wersja dla WinMain(HINSTANCE Instance, HINSTANCE, char *CmdLine, int CmdShow)
-	CmdLineParser(const tchar *CmdLine);
-
-	~CmdLineParser();
-
-	/// Rejestruje opcj jednoznakow.
-	/** \param Id podawa liczby wiksze od 0. */
-	void RegisterOpt(uint Id, tchar Opt, bool Parameter);
-	/// Rejestruje opcj wieloznakow.
-	/** \param Id podawa liczby wiksze od 0. */
-	void RegisterOpt(uint Id, const tstring &Opt, bool Parameter);
-
-	/// Wczytuje nastpn informacj, zwraca jej rodzaj
-	RESULT ReadNext();
-
-	/// Zwraca dane na temat ostatnio wczytanej informacji - identyfikator opcji.
-	/** Jeli nie zostaa wczytana opcja, zwraca 0. */
-	uint GetOptId();
-	/// Zwraca dane na temat ostatnio wczytanej informacji - tre parametru.
-	/** Jeli nie ma, acuch pusty. */
-	const tstring & GetParameter();
-};
-
-/// Reprezentuje 128-bitowy globalnie unikatowy identyfikator, zgodnie z RFC 4122
-class CommonGUID
-{
-public:
-	static const CommonGUID NIL;
-
-	static int Cmp(const CommonGUID &v1, const CommonGUID &v2);
-
-	/// Tworzy niezainicjalizowany
-	CommonGUID() { }
-	CommonGUID(uint8 v0, uint8 v1, uint8 v2, uint8 v3, uint8 v4, uint8 v5, uint8 v6, uint8 v7, uint8 v8, uint8 v9, uint8 v10, uint8 v11, uint8 v12, uint8 v13, uint8 v14, uint8 v15);
-
-	const uint8 * AccessData() const { return Data; }
-	uint8 * AccessData() { return Data; }
-
-	const uint8 & operator [] (size_t i) const { return Data[i]; }
-	uint8 & operator [] (size_t i) { return Data[i]; }
-
-	bool operator == (const CommonGUID &v) const { return Cmp(*this, v) == 0; }
-	bool operator != (const CommonGUID &v) const { return Cmp(*this, v) != 0; }
-	bool operator <  (const CommonGUID &v) const { return Cmp(*this, v) <  0; }
-	bool operator >  (const CommonGUID &v) const { return Cmp(*this, v) >  0; }
-	bool operator <= (const CommonGUID &v) const { return Cmp(*this, v) <= 0; }
-	bool operator >= (const CommonGUID &v) const { return Cmp(*this, v) >= 0; }
-
-	void ToString(tchar *out) const; ///< Bufor musi miec dlugosc co najmniej 37 znakow.
-	void ToString(tstring &out) const;
-	bool FromString(const tchar *s);
-	bool FromString(const tstring &s);
-
-	/// Generuje nowy, losowy, unikatowy identyfikator na podstawie algorytmu w wersji 4.
-	void GenerateVersion4();
-
-private:
-	/// Od najmlodszych do najstarszych, tzn. Data[0] jest najmlodszy.
-	uint8 Data[16];
-};
-
-//@}
-// code_base
-
-} // namespace common
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-/** \addtogroup code_sthtostr Uniwersalne konwersje
-Uniwersalny i rozszerzalny mechanizm konwersji na i z acucha */
-//@{
-
-template <typename T>
-struct SthToStr_obj
-{
-	void operator () (tstring *Str, const T &Sth)
-	{
-		// Runtime error
-		assert(0 && "SthToStr: Unsupported type.");
-		// Compilation error
-		// Dziaa tylko w Visual C++, g++ pokazuje bd kompilacji nawet kiedy nieuyte
-#ifdef _WIN32
-		int y = UnsupportedTypeInSthToStr;
-#endif
-	}
-	static inline bool IsSupported() { return false; }
-};
-
-template <typename T>
-inline void SthToStr(tstring *Str, const T &Sth)
-{
-	SthToStr_obj<T>()(Str, Sth);
-}
-
-template <typename T>
-struct StrToSth_obj
-{
-	bool operator () (const tstring &Str, T *Sth)
-	{
-		// Runtime error
-		assert(0 && "StrToSth: Unsupported type.");
-		// Compilation error
-		// Dziaa tylko w Visual C++, g++ pokazuje bd kompilacji nawet kiedy nieuyte
-#ifdef _WIN32
-		int y = UnsupportedTypeInSthToStr;
-#endif
-		return false;
-	}
-	static inline bool IsSupported() { return false; }
-};
-
-template <typename T>
-inline bool StrToSth(T *Sth, const tstring &Str)
-{
-	return StrToSth_obj<T>()(Sth, Str);
-}
-
-//@}
-
-namespace common
-{
-
-/** \addtogroup code_sthtostr */
-//@{
-
-/// \internal
-class Format_pimpl
-{
-	friend class Format;
-
-private:
-	tstring m_String;
-	tchar m_Sep;
-	size_t m_Index;
-
-	Format_pimpl(const tstring &Fmt, tchar Sep) : m_String(Fmt), m_Sep(Sep), m_Index(0) { }
-};
-
-/// Klasa do wygodnego skadania stringw z rnych informacji
-/**
-Przykad uycia:
-\code
-int i = 10; float f = 3.14f; tstring s = _T("A");
-string MyString = Format("i=#, f=#, s=#") % i % f % s;
-\endcode
-*/
-class Format
-{
-private:
-	shared_ptr<Format_pimpl> pimpl;
-
-public:
-	Format(const tstring &Fmt, tchar Sep = _T('#')) : pimpl(new Format_pimpl(Fmt, Sep)) { }
-	/// Dodaje kolejn informacj do formatowanego acucha
-	/** \internal
-	- To taki jakby dziwny konstuktor kopiujcy.
-	- Uywam za kadym razem tworzenia osobnego obiektu, bo nie mona w g++
-	modyfikowa obiektu tymczasowego i nie daoby si tego tak wygodnie
-	uywa.
-	- Do uytku wewntrznego - nie uywa! */
-	Format(const Format &f, const tstring &Element);
-	/// \internal
-	Format(const Format &f, const tchar *Element);
-
-	operator tstring () const { return pimpl->m_String; }
-	/// Zwraca finalny string - stosowa tam, gdzie nie zadziaa automatyczne rzutowanie na string.
-	tstring str() const { return pimpl->m_String; }
-};
-
-template <typename T>
-const Format operator % (const Format &fmt, const T &x)
-{
-	tstring s;
-	SthToStr<T>(&s, x);
-	return Format(fmt, s);
-}
-
-inline const Format operator % (const Format &fmt, const tchar *x)
-{
-	return Format(fmt, x);
-}
-
-//@}
-
-} // namespace common
-
-
-/** \addtogroup code_sthtostr */
-//@{
-
-//------------------------------------------------------------------------------
-// SthToStr
-
-template <>
-struct SthToStr_obj<bool>
-{
-	void operator () (tstring *Str, const bool &Sth)
-	{
-		common::BoolToStr(Str, Sth, 'f');
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct SthToStr_obj<tchar>
-{
-	void operator () (tstring *Str, const tchar &Sth)
-	{
-		common::CharToStr(Str, Sth);
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct SthToStr_obj<int16>
-{
-	void operator () (tstring *Str, const int16 &Sth)
-	{
-		common::IntToStr<int16>(Str, Sth);
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct SthToStr_obj<int32>
-{
-	void operator () (tstring *Str, const int32 &Sth)
-	{
-		common::IntToStr<int32>(Str, Sth);
-	}
-	static inline bool IsSupported() { return true; }
-};
-template <>
-struct SthToStr_obj<long>
-{
-	void operator () (tstring *Str, const long &Sth)
-	{
-		common::IntToStr<int32>(Str, Sth);
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct SthToStr_obj<int64>
-{
-	void operator () (tstring *Str, const int64 &Sth)
-	{
-		common::IntToStr<int64>(Str, Sth);
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct SthToStr_obj<uint8>
-{
-	void operator () (tstring *Str, const uint8 &Sth)
-	{
-		common::UintToStr<uint8>(Str, Sth);
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct SthToStr_obj<uint16>
-{
-	void operator () (tstring *Str, const uint16 &Sth)
-	{
-		common::UintToStr<uint16>(Str, Sth);
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct SthToStr_obj<uint32>
-{
-	void operator () (tstring *Str, const uint32 &Sth)
-	{
-		common::UintToStr<uint32>(Str, Sth);
-	}
-	static inline bool IsSupported() { return true; }
-};
-template <>
-struct SthToStr_obj<unsigned long>
-{
-	void operator () (tstring *Str, const unsigned long &Sth)
-	{
-		common::UintToStr<uint32>(Str, (uint32)Sth);
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct SthToStr_obj<uint64>
-{
-	void operator () (tstring *Str, const uint64 &Sth)
-	{
-		common::UintToStr<uint64>(Str, Sth);
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct SthToStr_obj<float>
-{
-	void operator () (tstring *Str, const float &Sth)
-	{
-		common::FloatToStr(Str, Sth);
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct SthToStr_obj<double>
-{
-	void operator () (tstring *Str, const double &Sth)
-	{
-		common::DoubleToStr(Str, Sth);
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct SthToStr_obj<tstring>
-{
-	void operator () (tstring *Str, const tstring &Sth)
-	{
-		*Str = Sth;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <typename T>
-struct SthToStr_obj< std::vector<T> >
-{
-	void operator () (tstring *Str, const std::vector<T> &Sth)
-	{
-		Str->clear();
-		tstring Element;
-		for (typename std::vector<T>::const_iterator it = Sth.begin(); it != Sth.end(); ++it)
-		{
-			if (!Str->empty())
-				*Str += ',';
-			SthToStr<T>(&Element, *it);
-			*Str += Element;
-		}
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct SthToStr_obj<char *>
-{
-	void operator () (tstring *Str, tchar *Sth)
-	{
-		*Str = Sth;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct SthToStr_obj<const tchar *>
-{
-	void operator () (tstring *Str, const tchar *Sth)
-	{
-		*Str = Sth;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct SthToStr_obj<void *>
-{
-	void operator () (tstring *Str, void *Sth)
-	{
-		common::PtrToStr(Str, Sth);
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct SthToStr_obj<const void *>
-{
-	void operator () (tstring *Str, const void *Sth)
-	{
-		common::PtrToStr(Str, Sth);
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-//------------------------------------------------------------------------------
-// SthToStr
-
-template <>
-struct StrToSth_obj<bool>
-{
-	bool operator () (bool *Sth, const tstring &Str)
-	{
-		return common::StrToBool(Sth, Str);
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct StrToSth_obj<tchar>
-{
-	bool operator () (tchar *Sth, const tstring &Str)
-	{
-		if (Str.length() != 1) return false;
-		*Sth = Str[0];
-		return true;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct StrToSth_obj<int16>
-{
-	bool operator () (int16 *Sth, const tstring &Str)
-	{
-		return common::StrToInt<int16>(Sth, Str) == 0;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct StrToSth_obj<int32>
-{
-	bool operator () (int32 *Sth, const tstring &Str)
-	{
-		return common::StrToInt<int32>(Sth, Str) == 0;
-	}
-	static inline bool IsSupported() { return true; }
-};
-template <>
-struct StrToSth_obj<long>
-{
-	bool operator () (long *Sth, const tstring &Str)
-	{
-		return common::StrToInt<int32>((int32*)Sth, Str) == 0;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct StrToSth_obj<int64>
-{
-	bool operator () (int64 *Sth, const tstring &Str)
-	{
-		return common::StrToInt<int64>(Sth, Str) == 0;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct StrToSth_obj<uint8>
-{
-	bool operator () (uint8 *Sth, const tstring &Str)
-	{
-		return common::StrToUint<uint8>(Sth, Str) == 0;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct StrToSth_obj<uint16>
-{
-	bool operator () (uint16 *Sth, const tstring &Str)
-	{
-		return common::StrToUint<uint16>(Sth, Str) == 0;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct StrToSth_obj<uint32>
-{
-	bool operator () (uint32 *Sth, const tstring &Str)
-	{
-		return common::StrToUint<uint32>(Sth, Str) == 0;
-	}
-	static inline bool IsSupported() { return true; }
-};
-template <>
-struct StrToSth_obj<unsigned long>
-{
-	bool operator () (unsigned long *Sth, const tstring &Str)
-	{
-		return common::StrToUint<uint32>((uint32*)Sth, Str) == 0;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct StrToSth_obj<uint64>
-{
-	bool operator () (uint64 *Sth, const tstring &Str)
-	{
-		return common::StrToUint<uint64>(Sth, Str) == 0;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct StrToSth_obj<float>
-{
-	bool operator () (float *Sth, const tstring &Str)
-	{
-		return common::StrToFloat(Sth, Str) == 0;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct StrToSth_obj<double>
-{
-	bool operator () (double *Sth, const tstring &Str)
-	{
-		return common::StrToDouble(Sth, Str) == 0;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct StrToSth_obj<tstring>
-{
-	bool operator () (tstring *Sth, const tstring &Str)
-	{
-		*Sth = Str;
-		return true;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <typename T>
-struct StrToSth_obj< std::vector<T> >
-{
-	bool operator () (std::vector<T> *Sth, const tstring &Str)
-	{
-		Sth->clear();
-		size_t Index = 0;
-		tstring Element;
-		T Val;
-		while (common::Split(Str, _T(","), &Element, &Index))
-		{
-			if (!StrToSth<T>(&Val, Element)) return false;
-			Sth->push_back(Val);
-		}
-		return true;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-//@}
-// code_sthtostr
-
-#endif
+/** \file
+\brief Foundation module
+\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
+
+Part of CommonLib library. \n
+Encoding UTF-8, end of line CR+LF \n
+License: GNU LGPL. \n
+Documentation: \ref Module_Base \n
+Module components: \ref code_base
+*/
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+#pragma once
+#endif
+#ifndef COMMON_BASE_H_
+#define COMMON_BASE_H_
+
+/** \addtogroup code_base Base Module
+Documentation: \ref Module_Base \n
+Header: Base.hpp */
+//@{
+
+// Main includes
+#include <cassert>
+#include <string>
+#include <vector>
+
+// Unwanted includes :(
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <cstdint>
+
+#ifdef _WIN32
+	/// This is in case the user includes <Windows.h> somewhere below.
+	#define NOMINMAX
+#endif
+
+// I want to have string like a built-in type.
+using std::string;
+using std::wstring;
+
+// Regardless of compiler used, signaature of current function will be in
+// __FUNCSIG__ macro - conversion from GCC convention to Visual C++ convention.
+// __FUNCTION__ macro with function name only is the same in Visual C++ and GCC,
+// so I don't touch it.
+#ifndef _WIN32
+	#define __FUNCSIG__ __PRETTY_FUNCTION__
+#endif
+
+// Things regarding Unicode
+#ifdef _WIN32
+	#include <tchar.h>
+	#include <wchar.h>
+	/// Character type, depending on _UNICODE macro, is defined as char or wchar_t.
+	typedef TCHAR tchar;
+#else
+	#define _T(x) (x)
+	typedef char tchar;
+#endif
+
+#ifdef _UNICODE
+	/// String type, depending on _UNICODE macro, is defined as std::string or std::wstring.
+	typedef std::wstring tstring;
+	/// Converts character to natural number.
+	#define TCHAR_TO_INT(c) ( (int)(c) )
+	/// Converts 0..255 number to character.
+	#define INT_TO_TCHAR(i) ( (wchar_t)(i) )
+#else
+	typedef std::string tstring;
+	#define TCHAR_TO_INT(c) ( (int)(uint8)(c) )
+	#define INT_TO_TCHAR(i) ( (char)(uint8)(i) )
+#endif
+
+/// Name of current source file as string, in Unicode if _UNICODE macro is defined.
+#define __TFILE__ _T(__FILE__)
+/// Full signature of current function in code, in Unicode if _UNICODE macro is defined.
+#define __TFUNCSIG__ _T(__FUNCSIG__)
+/// Name of current function only, in Unicode if _UNICODE macro is defined.
+#define __TFUNCTION__ _T(__FUNCTION__)
+
+/** \addtogroup base_main_types Fundamental data types */
+//@{
+#ifdef _WIN32
+	/// Unsigned 32-bit numer
+	typedef unsigned __int32 uint;
+	/// Signed 8-bit number
+	typedef __int8 int8;
+	/// Unsigned 8-bit number
+	typedef unsigned __int8 uint8;
+	/// Signed 16-bit number
+	typedef __int16 int16;
+	/// Unsigned 16-bit number
+	typedef unsigned __int16 uint16;
+	/// Signed 32-bit number
+	typedef __int32 int32;
+	/// Unsigned 32-bit number
+	typedef unsigned __int32 uint32;
+	/// Signed 64-bit number
+	typedef __int64 int64;
+	/// Unsigned 64-bit number
+	typedef unsigned __int64 uint64;
+#else
+	typedef unsigned int uint;
+	typedef char int8;
+	typedef unsigned char uint8;
+	typedef short int16;
+	typedef unsigned short uint16;
+	typedef int int32;
+	typedef unsigned int uint32;
+	typedef long long int64;
+	typedef unsigned long long uint64;
+#endif
+//@}
+
+#ifdef _WIN32
+	#define common_memzero(buf,bufSize)   { ZeroMemory(buf,bufSize); }
+#else
+	#define common_memzero(buf,bufSize)   { memset(buf,0,bufSize); }
+#endif
+
+/* These macros define string functions from C standard library they way that
+under Visual C++ they resolve to safe _s versions and use Unicode if _UNICODE
+defined and under Linux they use standard C functions.
+
+There is a problem with variadic macros (macros with variable number of
+arguments) when no argument supplied to the macro. According to language
+standard, macro arguments would contain erroneus trailing comma. Visual C++
+automatically deals with this. GNU compiler requires using special syntax:
+##__VA_ARGS__. */
+#ifdef _MSC_VER
+	#define common_sprintf(buf,bufSize,fmt,...)   ( _stprintf_s(buf,bufSize,fmt,__VA_ARGS__) )
+	#define common_memcpy(dst,src,count)   { memcpy_s(dst,count,src,count); }
+	#define common_memmove(dst,src,count)   { memmove_s(dst,count,src,count); }
+	#define common_strcat(dst,dstSize,src)   { _tcscat_s(dst,dstSize,src); }
+	#define common_strncat(dst,dstSize,src,count)   { _tcsncat_s(dst,dstSize,src,count); }
+	#define common_strchr(str,c)   ( _tcschr(str,c) )
+	#define common_strrchr(str,c)   ( _tcsrchr(str,c) )
+	#define common_strcmp(s1,s2)   ( _tcscmp(s1,s2) )
+	#define common_strncmp(s1,s2,count)   ( _tcsncmp(s1,s2,count) )
+	#define common_stricmp(s1,s2)   ( _tcsicmp(s1,s2) )
+	#define common_strnicmp(s1,s2,count)   ( _tcsnicmp(s1,s2,count) )
+	#define common_strcoll(s1,s2)   ( _tcscoll(s) )
+	#define common_strcpy(dst,dstSize,src)   { _tcscpy_s(dst,dstSize,src); }
+	#define common_strncpy(dst,dstSize,src,count)   { _tcsncpy(dst,dstSize,src,count); }
+	#define common_strlen(str)   ( _tcslen(str) )
+	#define common_strspn(str,charset)   ( _tcsspn(str,charset) )
+	#define common_strcspn(str,charset)   ( _tcscspn(str,charset) )
+	#define common_strpbrk(str,charset)   ( _tcspbrk(str,charset) )
+	#define common_strstr(str,strSearch)   ( _tcsstr(str,strSearch) )
+	#define common_strxfrm(dst,str,count)   ( _tcsxfrm(dst,str,count) )
+
+#else
+	#define common_sprintf(buf,bufSize,fmt,...)   ( sprintf(buf,fmt,##__VA_ARGS__) )
+	#define common_memcpy(dst,src,count)   { memcpy(dst,src,count); }
+	#define common_memmove(dst,src,count)   { memmove(dst,src,count); }
+	#define common_strcat(dst,dstSize,src)   { strcat(dst,src); }
+	#define common_strncat(dst,dstSize,src,count)   { strncat(dst,src,count); }
+	#define common_strchr(str,c)   ( strchr(str,c) )
+	#define common_strrchr(str,c)   ( strrchr(str,c) )
+	#define common_strcmp(s1,s2)   ( strcmp(s1,s2) )
+	#define common_strncmp(s1,s2,count)   ( strncmp(s1,s2,count) )
+	#define common_stricmp(s1,s2)   ( stricmp(s1,s2) )
+	#define common_strnicmp(s1,s2,count)   ( strnicmp(s1,s2,count) )
+	#define common_strcoll(s1,s2)   ( strcoll(s) )
+	#define common_strcpy(dst,dstSize,src)   { strcpy(dst,src); }
+	#define common_strncpy(dst,dstSize,src,count)   { strncpy(dst,src,count); }
+	#define common_strlen(str)   ( strlen(str) )
+	#define common_strspn(str,charset)   ( strspn(str,charset) )
+	#define common_strcspn(str,charset)   ( strcspn(str,charset) )
+	#define common_strpbrk(str,charset)   ( strpbrk(str,charset) )
+	#define common_strstr(str,strSearch)   ( strstr(str,strSearch) )
+	#define common_strxfrm(dst,str,count)   ( strxfrm(dst,str,count) )
+
+#endif
+
+/// String vector
+typedef std::vector<tstring> STRING_VECTOR;
+
+/// If pointer is not null, frees and zeroes it
+#define SAFE_DELETE(x) do { delete (x); (x) = 0; } while(false)
+/// If pointer is not null, frees it as and array and zeroes it
+#define SAFE_DELARR(x) do { delete [] (x); (x) = 0; } while(false)
+/// If pointer is not null, calls Release() and zeroes it
+#define SAFE_RELEASE(x) do { if (x) { (x)->Release(); (x) = 0; } } while(false)
+
+#ifdef _WIN32
+    namespace common { namespace Internal {
+        void DebugBreak();
+    } }
+	/// Assert that ALWAYS breaks the program when false (in debugger - hits a breakpoint, without debugger - crashes the program).
+	#define	ASSERT_INT3(x) if ((x) == 0) { Internal::DebugBreak(); }
+	/// Assert that in Debug configuration breaks the program when false (in debugger - hits a breakpoint, without debugger - crashes the program).
+	#ifdef _DEBUG
+		#define	ASSERT_INT3_DEBUG(x) if ((x) == 0) { Internal::DebugBreak(); }
+	#else
+		#define ASSERT_INT3_DEBUG(x) { }
+	#endif
+#endif
+
+/// For making structures aligned to one byte - without paddings
+#ifdef _MSC_VER
+	#define PACKED __declspec(align(1))
+#else
+	#define PACKED __attribute__((packed))
+#endif
+
+/// Macro to be placed in classes so a class has no copy constructor and assignment operator.
+/* Use at the beginning of class definition.
+Based on wxWidgets library. */
+#define DECLARE_NO_COPY_CLASS(ClassName)        \
+	private:                                    \
+		ClassName(const ClassName&);            \
+		ClassName& operator=(const ClassName&);
+
+/// Compiler-time assertion.
+#define STATIC_ASSERT(x) { const char temp[ (((x) == 0) ? 0 : 1) ] = {'\0'}; }
+
+/// Operator of literal cast (bitwise reinterpretation) - missing in C++.
+template <typename destT, typename srcT>
+destT &absolute_cast(srcT &v)
+{
+	return reinterpret_cast<destT&>(v);
+}
+template <typename destT, typename srcT>
+const destT &absolute_cast(const srcT &v)
+{
+	return reinterpret_cast<const destT&>(v);
+}
+
+#define REF_COUNTED_FIELDS \
+	uint m_RefCount;
+#define REF_COUNTED_METHODS \
+	void AddRef() { m_RefCount++; } \
+	void Release() { assert(m_RefCount > 0); if (--m_RefCount == 0) delete this; }
+#define REF_COUNTED_CTOR \
+	{ m_RefCount = 1; }
+
+#ifdef _DEBUG
+	#define NODEFAULT   assert(0)
+#else
+	#define NODEFAULT   __assume(0)
+#endif
+
+//@}
+// code_base
+
+/// Main namespace of CommonLib library
+namespace common
+{
+
+/** \addtogroup code_base Base Module */
+//@{
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+/** \addtogroup base_general General */
+//@{
+
+#ifndef _countof
+	/// \internal
+	template <typename _CountofType, size_t _SizeOfArray>
+	char (*__countof_helper(_CountofType (&_Array)[_SizeOfArray]))[_SizeOfArray];
+	/// Macro for fetching number of elements of a static array in compile time.
+	/** Copied from stdlib.h in Visual C++. */
+	#define _countof(_Array) sizeof(*__countof_helper(_Array))
+#endif
+
+/// Orientation - vertical or horizontal
+enum ORIENTATION
+{
+	O_NONE,
+	O_VERT,
+	O_HORIZ,
+};
+
+/// Allocates new dynamic 2D array
+template <typename T>
+T **new_2d(size_t cx, size_t cy)
+{
+	T **a = new T*[cx];
+	for (size_t x = 0; x < cx; x++)
+		a[x] = new T[cy];
+	return a;
+}
+
+/// Frees dynamic 2D array
+template <typename T>
+void delete_2d(T **a, size_t cx)
+{
+	for (size_t x = 0; x < cx; x++)
+		delete[] a[x];
+	delete[] a;
+}
+
+/// Copies string to char* including '\0' characters (which is not ensured in strcpy)
+/**
+- Includes '\0' at the end.
+- Of course necessary capacity must be ensured. */
+inline void strcpy0(tchar* dest, const tstring &src)
+{
+	for (size_t i = 0; i < src.length(); i++)
+		dest[i] = src[i];
+	dest[src.length()] = '\0';
+}
+
+/// Singleton design pattern - base class
+/**
+Usage:
+\code
+class MyClass : public common::Singleton<MyClass>
+{
+public:
+  void Foo();
+};
+
+...
+MyClass::GetInstance().Foo();
+\endcode
+*/
+template <typename T>
+class Singleton
+{
+public:
+	/// Returns the single instance of this class. Creates it on first call.
+	static T & GetInstance()
+	{
+		static T Instance;
+		return Instance;
+	}
+};
+
+/// Algorithm like these from STL - insertion sort.
+template<class Iterator>
+void InsertionSort(Iterator b, Iterator e)
+{
+	if (b == e) return;
+	for (Iterator j = b + 1; j < e; j++)
+	{
+		typename std::iterator_traits<Iterator>::value_type key;
+		key = *j;
+		Iterator i = j;
+		while (i > b && key < *(i-1))
+		{
+			*i = *(i-1);
+			i--;
+		} 
+		*i = key;
+	}
+}
+
+/// Algorithm like these from STL - insertion sort, with custom comparator.
+template<class Iterator, typename Compare>
+void InsertionSort(Iterator b, Iterator e, Compare Comp)
+{
+	if (b == e) return;
+	for (Iterator j = b + 1; j < e; j++)
+	{
+		typename std::iterator_traits<Iterator>::value_type key;
+		key = *j;
+		Iterator i = j;
+		while (i > b && Comp(key, *(i-1)))
+		{
+			*i = *(i-1);
+			i--;
+		} 
+		*i = key;
+	}
+}
+
+template <typename IterT, typename KeyT, typename CmpT>
+IterT FirstNotLessIndex(IterT beg, IterT end, const KeyT &key, CmpT cmp)
+{
+	size_t down=0, up=(end-beg);
+	while(down<up)
+	{
+		size_t mid=(down+up)/2;
+		int res=cmp(key,*(beg+mid));
+		if(res>0)
+			down=mid+1;
+		else
+			up=mid;
+	}
+	return beg+down;
+}
+
+/// An STL-compatible algorithm that performs binary search in sorted container using random-access iterators. Returns iterator to found element.
+/** If key element not found, returns end. \n
+This function is useful because standard std::binary_search returns bool and not iterator (what a nonsense!). \n
+cmp must be a functor in form of: int cmp(const KeyT &key, const ValT &val), where ValT is the type of *beg and *end.
+*/
+template <typename IterT, typename KeyT, typename CmpT>
+IterT BinarySearch(IterT beg, IterT end, const KeyT &key, CmpT cmp)
+{
+	IterT it = FirstNotLessIndex<IterT, KeyT, CmpT>(beg, end, key, cmp);
+	if (it == end || cmp(key, *it) != 0)
+		return end;
+	return it;
+}
+
+/// Swaps endianess of a 2-byte value.
+inline void SwapEndian16(void *p)
+{
+	uint16 &u = *(uint16*)p;
+	u = (u << 8) | (u >> 8);
+}
+/// Swaps endianess of a 4-byte value.
+inline void SwapEndian32(void *p)
+{
+	uint32 &u = *(uint32*)p;
+	u = (u << 24) | ((u & 0x0000ff00u) << 8) | ((u & 0x00ff0000u) >> 8) | (u >> 24);
+}
+/// Swaps endianess of a 8-byte value.
+inline void SwapEndian64(void *p)
+{
+	uint64 &u = *(uint64*)p;
+	u = (u << 56) | (u >> 56) |
+		((u & 0x000000000000ff00ull) << 40) | ((u & 0x00ff000000000000ull) >> 40) |
+		((u & 0x0000000000ff0000ull) << 24) | ((u & 0x0000ff0000000000ull) >> 24) |
+		((u & 0x00000000ff000000ull) <<  8) | ((u & 0x000000ff00000000ull) >>  8);
+}
+
+void SwapEndian16_Array(void *p, size_t count);
+void SwapEndian32_Array(void *p, size_t count);
+void SwapEndian64_Array(void *p, size_t count);
+
+void SwapEndian16_Data(void *p, size_t count, ptrdiff_t stepBytes);
+void SwapEndian32_Data(void *p, size_t count, ptrdiff_t stepBytes);
+void SwapEndian64_Data(void *p, size_t count, ptrdiff_t stepBytes);
+
+inline void SwapEndian(bool   &v) { }
+inline void SwapEndian(uint8  &v) { }
+inline void SwapEndian(int8   &v) { }
+inline void SwapEndian(uint16  &v) { SwapEndian16(&v); }
+inline void SwapEndian(int16   &v) { SwapEndian16(&v); }
+inline void SwapEndian(uint32  &v) { SwapEndian32(&v); }
+inline void SwapEndian(int32   &v) { SwapEndian32(&v); }
+inline void SwapEndian(uint64  &v) { SwapEndian64(&v); }
+inline void SwapEndian(int64   &v) { SwapEndian64(&v); }
+inline void SwapEndian(float  &v) { SwapEndian32(&v); }
+inline void SwapEndian(double &v) { SwapEndian64(&v); }
+
+/// Stops current thread for given number of milliseconds
+/** Works with some accuracy - maybe not great, but surely better than whole
+second. */
+void Wait(uint32 Miliseconds);
+
+template <typename T>
+inline int UniversalCmp(const T &a, const T &b)
+{
+	if (a < b) return -1;
+	if (b < a) return  1;
+	return 0;
+}
+
+//@}
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+/** \addtogroup base_smartptr Smart pointers */
+//@{
+
+/// Policy of deleting smart pointers which does: <tt>delete p;</tt>
+class DeletePolicy
+{
+public:
+	template <typename T>
+	static void Destroy(T *p)
+	{
+		// Sztuczka inspirowana Boost (checked_delete.hpp)
+		typedef char type_must_be_complete[ sizeof(T)? 1: -1 ];
+		(void) sizeof(type_must_be_complete);
+		delete p;
+	}
+};
+/// Policy of deleting smart pointers which does: <tt>delete [] p;</tt>
+class DeleteArrayPolicy
+{
+public:
+	template <typename T>
+	static void Destroy(T *p)
+	{
+		// Sztuczka inspirowana Boost (checked_delete.hpp)
+		typedef char type_must_be_complete[ sizeof(T)? 1: -1 ];
+		(void) sizeof(type_must_be_complete);
+		delete [] p;
+	}
+};
+/// Policy of deleting smart pointers which does: <tt>p->Release();</tt>
+class ReleasePolicy
+{
+public:
+	template <typename T>
+	static void Destroy(T *p)
+	{
+		if (p) p->Release();
+	}
+};
+
+/// Smart pointers with exclusive ownership.
+/**
+- Noncopyable.
+- Frees in destructor. */
+template <typename T, typename PolicyT = DeletePolicy>
+class scoped_ptr
+{
+    template<typename Y, typename PolicyY> friend class scoped_ptr;
+
+private:
+	T *m_Ptr;
+
+	scoped_ptr(const scoped_ptr &);
+	scoped_ptr & operator = (const scoped_ptr &);
+
+public:
+	typedef T value_type;
+	typedef T *ptr_type;
+
+	explicit scoped_ptr(T *p = NULL) : m_Ptr(p) { }
+	~scoped_ptr() { PolicyT::template Destroy<T>(m_Ptr); }
+	
+	T & operator * () const { assert(m_Ptr != NULL); return *m_Ptr; }
+	T * operator -> () const { assert(m_Ptr != NULL); return m_Ptr; }
+	T & operator [] (size_t i) const { return m_Ptr[i]; }
+
+	inline friend bool operator == (const scoped_ptr &lhs, const T *rhs) { return lhs.m_Ptr == rhs; }
+	inline friend bool operator == (const T *lhs, const scoped_ptr &rhs) { return lhs == rhs.m_Ptr; }
+	inline friend bool operator != (const scoped_ptr &lhs, const T *rhs) { return lhs.m_Ptr != rhs; }
+	inline friend bool operator != (const T *lhs, const scoped_ptr &rhs) { return lhs != rhs.m_Ptr; }
+
+	T * get() const { return m_Ptr; }
+	void swap(scoped_ptr<T, PolicyT> &b) { T *tmp = b.m_Ptr; b.m_Ptr = m_Ptr; m_Ptr = tmp; }
+	void reset(T *p = NULL) { assert(p == NULL || p != m_Ptr); scoped_ptr<T, PolicyT>(p).swap(*this); }
+	bool is_null() const { return m_Ptr == NULL; }
+};
+
+/// Smart pointer with reference counting
+/**
+- Copyable.
+- Frees when last common::shared_ptr object pointing to it is destroyed. */
+template <typename T, typename PolicyT = DeletePolicy>
+class shared_ptr
+{
+    template<typename Y, typename PolicyY> friend class shared_ptr;
+
+private:
+	T *m_Ptr;
+	unsigned *m_Counter;
+
+public:
+	typedef T value_type;
+	typedef T *ptr_type;
+
+	explicit shared_ptr(T *p = NULL) : m_Ptr(p), m_Counter(p ? new unsigned(1) : NULL) { }
+	~shared_ptr() { if (m_Ptr && --(*m_Counter) == 0) { delete m_Counter; PolicyT::template Destroy<T>(m_Ptr); } }
+	
+	shared_ptr(const shared_ptr &p) : m_Ptr(p.m_Ptr), m_Counter(p.m_Counter) { if (m_Ptr) (*m_Counter)++; }
+	shared_ptr & operator = (const shared_ptr &p) { reset<T>(p); return *this; }
+	template <typename U, typename PolicyU> explicit shared_ptr(const shared_ptr<U, PolicyU> &p) : m_Ptr(p.m_Ptr), m_Counter(p.m_Counter) { if (m_Ptr) (*m_Counter)++; }
+	template <typename U, typename PolicyU> shared_ptr & operator = (const shared_ptr<U, PolicyU> &p) { reset<U, PolicyU>(p); return *this; }
+
+	T & operator * () const { assert(m_Ptr != NULL); return *m_Ptr; }
+	T * operator -> () const { assert(m_Ptr != NULL); return m_Ptr; }
+	T & operator [] (size_t i) const { return m_Ptr[i]; }
+
+	inline friend bool operator == (const shared_ptr &lhs, const T *rhs) { return lhs.m_Ptr == rhs; }
+	inline friend bool operator == (const T *lhs, const shared_ptr &rhs) { return lhs == rhs.m_Ptr; }
+	inline friend bool operator != (const shared_ptr &lhs, const T *rhs) { return lhs.m_Ptr != rhs; }
+	inline friend bool operator != (const T *lhs, const shared_ptr &rhs) { return lhs != rhs.m_Ptr; }
+	template <typename U, typename PolicyU> bool operator == (const shared_ptr<U, PolicyU> &rhs) const { return m_Ptr == rhs.m_Ptr; }
+	template <typename U, typename PolicyU> bool operator != (const shared_ptr<U, PolicyU> &rhs) const { return m_Ptr != rhs.m_Ptr; }
+
+	T * get() const { return m_Ptr; }
+	void swap(shared_ptr<T, PolicyT> &b) { T *tmp = b.m_Ptr; b.m_Ptr = m_Ptr; m_Ptr = tmp; unsigned *tmpc = b.m_Counter; b.m_Counter = m_Counter; m_Counter = tmpc; }
+	void reset(T *p = NULL) { if (p == m_Ptr) return; shared_ptr<T, PolicyT>(p).swap(*this); }
+	template <typename U, typename PolicyU> void reset(const shared_ptr<U, PolicyU> &p) { shared_ptr<U, PolicyU>(p).swap(*this); }
+	bool unique() const { return m_Counter == NULL || *m_Counter == 1; }
+	bool is_null() const { return m_Ptr == NULL; }
+};
+
+#ifdef _WIN32
+	/// Handle closing policy which does: <tt>CloseHandle(p);</tt>
+	class CloseHandlePolicy  { public: template <typename T> static void Destroy(T p) { if (p != NULL) CloseHandle(p); } };
+	/// Handle closing policy which does: <tt>DeleteObject(p);</tt>
+	class DeleteObjectPolicy { public: template <typename T> static void Destroy(T p) { if (p != NULL) DeleteObject(p); } };
+#endif
+
+/// Smart handle - exclusive ownership
+template <typename T, typename PolicyT>
+class scoped_handle
+{
+    template<typename Y, typename PolicyY> friend class scoped_handle;
+
+private:
+	T m_Ptr;
+
+	scoped_handle(const scoped_handle &);
+	scoped_handle & operator = (const scoped_handle &);
+
+public:
+	typedef T value_type;
+
+	explicit scoped_handle(T p) : m_Ptr(p) { }
+	~scoped_handle() { PolicyT::template Destroy<T>(m_Ptr); }
+	
+	inline friend bool operator == (const scoped_handle &lhs, const T &rhs) { return lhs.m_Ptr == rhs; }
+	inline friend bool operator == (const T &lhs, const scoped_handle &rhs) { return lhs == rhs.m_Ptr; }
+	inline friend bool operator != (const scoped_handle &lhs, const T &rhs) { return lhs.m_Ptr != rhs; }
+	inline friend bool operator != (const T &lhs, const scoped_handle &rhs) { return lhs != rhs.m_Ptr; }
+
+	const T & get() const { return m_Ptr; }
+	void swap(scoped_handle<T, PolicyT> &b) { T tmp = b.m_Ptr; b.m_Ptr = m_Ptr; m_Ptr = tmp; }
+	void reset(T p) { scoped_handle<T, PolicyT>(p).swap(*this); }
+};
+
+/// Smart handle with reference counting
+template <typename T, typename PolicyT>
+class shared_handle
+{
+    template<typename Y, typename PolicyY> friend class shared_handle;
+
+private:
+	T m_Ptr;
+	unsigned *m_Counter;
+
+public:
+	typedef T value_type;
+
+	explicit shared_handle(T p) : m_Ptr(p), m_Counter(new unsigned(1)) { }
+	~shared_handle() { if (--(*m_Counter) == 0) { delete m_Counter; PolicyT::template Destroy<T>(m_Ptr); } }
+	
+	shared_handle(const shared_handle &p) : m_Ptr(p.m_Ptr), m_Counter(p.m_Counter) { (*m_Counter)++; }
+	shared_handle & operator = (const shared_handle &p) { reset<T>(p); return *this; }
+	template <typename U, typename PolicyU> explicit shared_handle(const shared_handle<U, PolicyU> &p) : m_Ptr(p.m_Ptr), m_Counter(p.m_Counter) { (*m_Counter)++; }
+	template <typename U, typename PolicyU> shared_handle & operator = (const shared_handle<U, PolicyU> &p) { reset<U, PolicyU>(p); return *this; }
+
+	inline friend bool operator == (const shared_handle &lhs, const T &rhs) { return lhs.m_Ptr == rhs; }
+	inline friend bool operator == (const T &lhs, const shared_handle &rhs) { return lhs == rhs.m_Ptr; }
+	inline friend bool operator != (const shared_handle &lhs, const T &rhs) { return lhs.m_Ptr != rhs; }
+	inline friend bool operator != (const T &lhs, const shared_handle &rhs) { return lhs != rhs.m_Ptr; }
+	template <typename U, typename PolicyU> bool operator == (const shared_handle<U, PolicyU> &rhs) const { return m_Ptr == rhs.m_Ptr; }
+	template <typename U, typename PolicyU> bool operator != (const shared_handle<U, PolicyU> &rhs) const { return m_Ptr != rhs.m_Ptr; }
+
+	const T & get() const { return m_Ptr; }
+	void swap(shared_handle<T, PolicyT> &b) { T tmp = b.m_Ptr; b.m_Ptr = m_Ptr; m_Ptr = tmp; unsigned *tmpc = b.m_Counter; b.m_Counter = m_Counter; m_Counter = tmpc; }
+	void reset(T p) { if (p == m_Ptr) return; shared_handle<T, PolicyT>(p).swap(*this); }
+	template <typename U, typename PolicyU> void reset(const shared_handle<U, PolicyU> &p) { shared_handle<U, PolicyU>(p).swap(*this); }
+	bool unique() const { return *m_Counter == 1; }
+};
+
+template <typename T, typename PolicyT> void swap(scoped_ptr<T, PolicyT> &a, scoped_ptr<T, PolicyT> &b) { a.swap(b); }
+template <typename T, typename PolicyT> void swap(shared_ptr<T, PolicyT> &a, shared_ptr<T, PolicyT> &b) { a.swap(b); }
+template <typename T, typename PolicyT> void swap(scoped_handle<T, PolicyT> &a, scoped_handle<T, PolicyT> &b) { a.swap(b); }
+template <typename T, typename PolicyT> void swap(shared_handle<T, PolicyT> &a, shared_handle<T, PolicyT> &b) { a.swap(b); }
+
+//@}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+/** \addtogroup base_math Basic math
+Bit tricks implemented based on:
+Bit Twiddling Hacks, Sean Eron Anderson, http://www-graphics.stanford.edu/~seander/bithacks.html
+*/
+//@{
+
+/** \addtogroup base_minmax Minimum and maximum values
+Minimum and maximum values of various types. */
+//@{
+const int8 MININT8 = std::numeric_limits<int8>::min();
+const int8 MAXINT8 = std::numeric_limits<int8>::max();
+const int16 MININT16 = std::numeric_limits<int16>::min();
+const int16 MAXINT16 = std::numeric_limits<int16>::max();
+const int32 MININT32 = std::numeric_limits<int32>::min();
+const int32 MAXINT32 = std::numeric_limits<int32>::max();
+const int64 MININT64 = std::numeric_limits<int64>::min();
+const int64 MAXINT64 = std::numeric_limits<int64>::max();
+const uint8 MAXUINT8 = std::numeric_limits<uint8>::max();
+const uint16 MAXUINT16 = std::numeric_limits<uint16>::max();
+const uint32 MAXUINT32 = std::numeric_limits<uint32>::max();
+const uint64 MAXUINT64 = std::numeric_limits<uint64>::max();
+const float MINFLOAT = std::numeric_limits<float>::min();
+const float MAXFLOAT = std::numeric_limits<float>::max();
+//@}
+
+/// Close to zero floating point number
+/** Suprisingly this macro converted to function works slower - never trust
+compiler optimiations! */
+#define FLOAT_ALMOST_ZERO(F) ((absolute_cast<uint32>(F) & 0x7f800000L) == 0)
+
+/** \addtogroup base_math_consts Math constants
+Because constants from cmath/math.h don't work despite defining USE_MATH_CONSTANTS :P */
+//@{
+const float E         = 2.71828182845904523536f;  ///< e
+const float LOG2E     = 1.44269504088896340736f;  ///< log2(e)
+const float LOG10E    = 0.434294481903251827651f; ///< log10(e)
+const float LN2       = 0.693147180559945309417f; ///< ln(2)
+const float LN10      = 2.30258509299404568402f;  ///< ln(10)
+const float PI        = 3.14159265358979323846264338327950288419716939937510582f;  ///< pi
+const float PI_2      = 1.57079632679489661923f;  ///< pi/2
+const float PI_4      = 0.785398163397448309616f; ///< pi/4
+const float PI_X_2    = 6.28318530717958647692f;  ///< 2*pi
+const float _1_PI     = 0.318309886183790671538f; ///< 1/pi
+const float _2_PI     = 0.636619772367581343076f; ///< 2/pi
+const float _2_SQRTPI = 1.12837916709551257390f;  ///< 2/sqrt(pi)
+const float SQRT2     = 1.41421356237309504880f;  ///< sqrt(2)
+const float SQRT3     = 1.7320508075688772935274463415059f; ///< sqrt(3)
+const float SQRT1_2   = 0.707106781186547524401f; ///< 1/sqrt(2)
+//@}
+
+// Windows - requires float.h
+#ifdef _WIN32
+	/// Returns true if number is not INF or NaN
+	bool is_finite(float x);
+	/// Returns true if number is not INF or NaN
+	bool is_finite(double x);
+	/// Returns true,if number is NaN
+	bool is_nan(float x);
+	/// Returns true,if number is NaN
+	bool is_nan(double x);
+// Linux - requires math.h
+#else
+	inline bool is_finite(float x)  { return (finitef(x) != 0); }
+	inline bool is_finite(double x) { return (finite(x)  != 0); }
+	inline bool is_nan(float x)  { return (isnanf(x) != 0); }
+	inline bool is_nan(double x) { return (isnan(x)  != 0); }
+#endif
+
+/// Adds two numbers with limit (saturation) instead of wrap-around on overflow
+/** As T use types: uint8, uint16, uint32, uint64
+(Author: Tarlandil) */
+template <typename T>
+T safe_add(T a, T b)
+{
+	T R = a + b;
+	if (R < std::max(a, b)) return std::numeric_limits<T>::max();
+	else return R;
+}
+
+/// Subtracts two numbers with limit (saturation) instead of wrap-around on overflow
+/** As T use types: uint8, uint16, uint32, uint64
+(Author: Tarlandil) */
+template <typename T>
+T safe_sub(T a, T b)
+{
+	if (b > a) return T();
+	else return a - b;
+}
+
+/// Multiplies two numbers with limit (saturation) instead of wrap-around on overflow
+/** As T use types: uint8, uint16, uint32, uint64
+(Author: Tarlandil) */
+template <typename T>
+T safe_mul(T a, T b)
+{
+	if (b == T()) return T();
+	T R = a * b;
+	if (R / b != a) return std::numeric_limits<T>::max();
+	else return R;
+}
+
+/// Safe arcus cosinus, limits input range to -1...+1 returning boundary values in case of exceeding this range.
+inline float safe_acos(float x)
+{
+	if (x <= -1.0f) return PI;
+	if (x >= 1.0f) return 0.0f;
+	return acosf(x);
+}
+
+/// Rounds number instead of truncating it.
+/** Mathematical way - rounding up or down depending on fractional part. */
+inline int round(float x)
+{
+	return static_cast<int>(floorf(x+0.5f));
+}
+inline int round(double x)
+{
+	return static_cast<int>(floor(x+0.5));
+}
+
+/// Divides two integer numbers rounding the result up
+/** As T use types: int, uint etc.
+Works for positive numbers only.
+Watch out for exceeding range of (x+y) value.
+(Author: Tarlandil) */
+template <typename T>
+inline T ceil_div(T x, T y)
+{
+	return (x+y-1) / y;
+}
+
+/// Aligns given value up to nearest multiply of align value. For example: AlignUp(11, 8) = 16. Use types like uint32, uint64 as T.
+template <typename T>
+inline T AlignUp(T val, T align)
+{
+	return (val + align - 1) / align * align;
+}
+/// Aligns given value down to nearest multiply of align value. For example: AlignUp(19, 8) = 16. Use types like uint32, uint64 as T.
+template <typename T>
+inline T AlignDown(T val, T align)
+{
+	return (val / align) * align;
+}
+
+/// Division with mathematical rounding to nearest number.
+template <typename T>
+inline T round_div(T x, T y)
+{
+	return (x + (y / 2)) / y;
+}
+
+/// Returns true if number lies within epsilon surrounding of zero
+inline bool around(float x, float epsilon)
+{
+	return (fabsf(x) <= epsilon);
+}
+inline bool around(double x, double epsilon)
+{
+	return (fabs(x) <= epsilon);
+}
+
+/// Returns true if number x lies within epsilon surrounding of numer y
+inline bool around(float x, float y, float epsilon)
+{
+	return (fabsf(x-y) <= epsilon);
+}
+inline bool around(double x, double y, double epsilon)
+{
+	return (fabs(x-y) <= epsilon);
+}
+
+/// Returns true if two floating-point numbers are almost equal.
+/** These functions are nice because you don't need to pass epsilon, but they
+require more computations.
+(Author: Tarlandil) */
+inline bool float_equal(float x, float y)
+{
+	float epsilon = (fabsf(x)+fabsf(y)) * 1e-4f;
+	//return around(x, y, epsilon);
+	return (fabsf(x-y) <= epsilon);
+}
+inline bool double_equal(double x, double y)
+{
+	double epsilon = (fabs(x)+fabs(y)) * 1e-13;
+	//return around(x, y, epsilon);
+	return (fabs(x-y) <= epsilon);
+}
+
+/// Calculates square of a number
+/** As T use any type that has operator *.
+This function is useful when you have an expression in parentheses and not just
+a Simple value. */
+template <typename T> inline T sqr(T v) { return v * v; }
+
+/// Returns sign of given integer number: -1, 0, or 1
+/** Use with signed integer numbers: int8, int16, int32, int64. */
+template <typename T> inline T sign(T v) { return (v > (T)0) - (v < (T)0); }
+
+/// Merges bits of two numbers according to mask, that is selects these bits from A that have 0 in mask and these bits from B that have 1 in mask.
+template <typename T> inline T MergeBits(T a, T b, T Mask) { return a ^ ((a ^ b) & Mask); }
+
+/// Returns number of bits set to 1 in given number.
+inline uint CountBitsSet(uint8 v)
+{
+    uint8 c = v - ((v >> 1) & 0x55);
+    c = ((c >> 2) & 0x33) + (c & 0x33);
+    c = ((c >> 4) + c) & 0x0F;
+    return c;
+}
+inline uint CountBitsSet(uint16 v)
+{
+    uint16 c = v - ((v >> 1) & 0x5555);
+    c = ((c >> 2) & 0x3333) + (c & 0x3333);
+    c = ((c >> 4) + c) & 0x0F0F;
+    c = ((c >> 8) + c) & 0x00FF;
+    return c;
+}
+inline uint CountBitsSet(uint32 v)
+{
+    uint32 c = v - ((v >> 1) & 0x55555555);
+    c = ((c >>  2) & 0x33333333) + (c & 0x33333333);
+    c = ((c >>  4) + c) & 0x0F0F0F0F;
+    c = ((c >>  8) + c) & 0x00FF00FF;
+    c = ((c >> 16) + c) & 0x0000FFFF;
+    return c;
+}
+inline uint CountBitsSet(uint64 v)
+{
+    uint64 c = v - ((v >> 1) & 0x5555555555555555ll);
+    c = ((c >>  2) & 0x3333333333333333ll) + (c & 0x3333333333333333ll);
+    c = ((c >>  4) + c) & 0x0F0F0F0F0F0F0F0Fll;
+    c = ((c >>  8) + c) & 0x00FF00FF00FF00FFll;
+    c = ((c >> 16) + c) & 0x0000FFFF0000FFFFll;
+    c = ((c >> 32) + c) & 0x00000000FFFFFFFFll;
+    return (uint)c;
+}
+
+/// Calculates parity bit of a number
+inline uint CalcParity(uint v) {
+	v ^= v >> 1; v ^= v >> 2; v = (v & 0x11111111U) * 0x11111111U; return (v >> 28) & 1;
+}
+/// Calculates parity bit of a number
+inline uint64 CalcParity(uint64 v) {
+	v ^= v >> 1; v ^= v >> 2; v = (v & 0x1111111111111111ULL) * 0x1111111111111111ULL; return (v >> 60) & 1;
+}
+
+/// Swaps bit sequence in a number
+template <typename T> inline T SwapBitSequences(T v, uint SrcBit, uint DstBit, uint NumBits)
+{
+	int x = ((v >> SrcBit) ^ (v >> DstBit)) & ((1 << NumBits) - 1);
+	return v ^ ((x << SrcBit) | (x << DstBit));
+}
+
+/// Returns true if given number is a power of two.
+/** T must be unsigned integer number - uint8, uint16, uint32, uint64, or signed integer but always nonnegative.
+For 0 returns true. */
+template <typename T> inline bool IsPow2(T x) { return (x & (x-1)) == 0; }
+
+/// Returns bit mask with n least significant bits set to 1.
+/** n must be in range 0..32. */
+uint32 GetBitMask(uint32 n);
+
+/// Returns 2-based logarithm of given unsigned integer number, that is the number of the most significant nonzero bit.
+/** In other words, how many bits you need to shift a 1 left to have the most
+significant 1 of the given number. Result 0 is returned for numbers 0 and 1. */
+uint log2u(uint v);
+/// Returns 10-based logarithm of given unsigned integer number, that is the number of most significant decimal digit.
+/** Undefined for zero. */
+uint log10u(uint v);
+
+/// Returns smallest power of two greater or equal than given number
+/** For v == 0 returns 0.
+For v > 0x80000000 result is undefined. */
+inline uint next_pow2(uint v) {
+	v--; v |= v >> 1; v |= v >> 2; v |= v >> 4; v |= v >> 8; v |= v >> 16; v++; return v;
+}
+
+/// Interleaves lower 16 bits of a (to even) and lower 16 bits of b (to odd) to resulting number
+uint InterleaveBits(uint a, uint b);
+// Splits lowest 10 bits inserting two zeros before each one, so:
+// Input:  ----------------------9876543210
+// Output: ----9--8--7--6--5--4--3--2--1--0
+uint Extend10BitsBy2Zeros(uint n);
+// Splits lowest 16 bits inserting one zero before each one, so:
+// Input:  ----------------fedcba9876543210
+// Output: -f-e-d-c-b-a-9-8-7-6-5-4-3-2-1-0
+uint Extend16BitsBy1Zero(uint n);
+
+/** As T use types: uint8, uint16, uint32, uint64. */
+template <typename T>
+inline T ReverseBits(T v)
+{
+    // Algorithm from: Bit Twiddling Hacks, Sean Eron Anderson,
+    // http://graphics.stanford.edu/~seander/bithacks.html#BitReverseObvious
+    
+    T r = v; // r will be reversed bits of v; first get LSB of v
+    int s = (int)sizeof(v) * 8 - 1; // extra shift needed at end
+
+    for (v >>= 1; v; v >>= 1)
+    {   
+      r <<= 1;
+      r |= v & 1;
+      s--;
+    }
+    r <<= s; // shift when v's highest bits are zero
+    
+    return r;
+}
+
+inline uint8 ReverseBits(uint8 v)
+{
+	return (uint8)( ((v * 0x0802LU & 0x22110LU) | (v * 0x8020LU & 0x88440LU)) * 0x10101LU >> 16 );
+}
+
+/// Returns (x + 1) % 3.
+/** T: use unsigned integer types.
+Source: "Modulo 3", http://www.codercorner.com/Modulo3.htm, algorithm by Christer Ericson. */
+template <typename T>
+inline T increment_modulo_3(T x)
+{
+	return ((T)1 << x) & (T)3;
+}
+
+/// Calculates power with integer exponent (very fast!)
+/** T can be any number - int, uint32, float etc.
+(Author: Tarlandil) */
+template <typename T>
+T powi(T a, uint32 b)
+{
+	T r = (T)1;
+	T p = a;
+	while (b)
+	{
+		if (b & 1)
+			r *= p;
+		p *= p;
+		b >>= 1;
+	}
+	return r;
+}
+
+/// Raises float number to integer exponent.
+/** Checked, works great even for negative exponents. */
+inline float powi(float x, int N)
+{
+    float y, w;
+    bool ns = false, xs = false;
+    // record signs
+    if(N < 0) ns = true, N = -N;
+    if(x < 0.0f) xs = true, x = -x;
+    // setup initial powers
+    if(N & 1) y = x;
+    else y = 1.0f, xs = false;
+    w = x; N >>= 1;
+    while(N)
+    {
+        w = w * w;
+        if(N & 1) y *= w;
+        N >>= 1;
+    }
+    // reinstate signs
+    if(xs) y = -y;
+    if(ns) y = 1.0f / y;
+    return y;
+}
+
+template <typename T, typename Predicate>
+void Sort2(T &v1, T &v2, Predicate comp)
+{
+	if (comp(v2, v1))
+	{
+		T tmp = v1;
+		v1 = v2;
+		v2 = tmp;
+	}
+}
+template <typename T>
+void Sort2(T &v1, T &v2)
+{
+	Sort2(v1, v2, std::less<T>());
+}
+
+template <typename T, typename Predicate>
+void Sort3(T &v1, T &v2, T &v3, Predicate comp)
+{
+	Sort2<T, Predicate>(v1, v3, comp);
+	Sort2<T, Predicate>(v1, v2, comp);
+	Sort2<T, Predicate>(v2, v3, comp);
+}
+template <typename T>
+void Sort3(T &v1, T &v2, T &v3)
+{
+	Sort2<T>(v1, v3);
+	Sort2<T>(v1, v2);
+	Sort2<T>(v2, v3);
+}
+
+/// Returns biggest of 3 numbers
+template <typename T>
+inline T max3(const T &a, const T &b, const T &c)
+{
+	return std::max(a, std::max(b, c));
+}
+
+/// Returns smallers of 3 numbers
+template <typename T>
+inline T min3(const T &a, const T &b, const T &c)
+{
+	return std::min(a, std::min(b, c));
+}
+
+/// Returns number x limited to given range from a to b
+template <typename T>
+inline T minmax(const T &a, const T &x, const T &b)
+{
+	if (x < a) return a; else if (x > b) return b; else return x;
+	//return std::min(b, std::max(a, x));
+}
+inline float saturate(float x) { return minmax<float>(0.f, x, 1.f); }
+inline double saturate(double x) { return minmax<double>(0., x, 1.); }
+
+/// Returns integral part of a number including sign
+/** (Author: Tarlandil) */
+inline float trunc(float x)
+{
+	return (x < 0.0f) ? ceilf(x) : floorf(x);
+}
+inline double trunc(double x)
+{
+	return (x < 0.0) ? ceil(x) : floor(x);
+}
+
+/// Returns fractional part of a number including sign
+/** (Author: Tarlandil) */
+inline float frac(float x)
+{
+	return x - floorf(x);
+}
+inline double frac(double x)
+{
+	return x - floor(x);
+}
+
+/// Calculates both sine and cosine of given number. May be faster than calculating them separately.
+void sincos(float angle, float *sine, float *cosine);
+
+/// 1D linear interpolation (t = 0..1)
+inline float Lerp(float x, float y, float t)
+{
+	return x + t*(y-x);
+}
+inline void Lerp(float *out, float x, float y, float t)
+{
+	*out = x + t*(y-x);
+}
+/// 1D linear interpolation (t is limited to 0..1)
+inline float SafeLerp(float x, float y, float t)
+{
+	return Lerp(x, y, minmax(0.0f, t, 1.0f));
+}
+
+/// 2D linear interpolation
+/** tx is for first index, ty is for second index. */
+inline float Lerp2D(float x11, float x21, float x12, float x22, float tx, float ty)
+{
+	return Lerp(Lerp(x11, x21, tx), Lerp(x12, x22, tx), ty);
+}
+
+/// Normalizes angle to range < 0..2PI )
+inline float NormalizeAngle(float angle)
+{
+	angle /= PI_X_2;
+	angle = frac(angle);
+	if (angle < 0.0f)
+		angle += 1.0f;
+	else if (angle >= 1.0f)
+		angle -= 1.0f;
+	return angle * PI_X_2;
+}
+
+/// Normalizes angle to range -PI..+PI
+inline float NormalizeAngle2(float Angle)
+{
+	Angle += PI;
+	Angle -= floorf(Angle * (1.0f/PI_X_2)) * PI_X_2;
+	Angle -= PI;
+	return Angle;
+}
+
+/// Converts angle from degrees to radians
+inline float DegToRad(float Angle)
+{
+	// Angle * PI / 180
+	return Angle * 0.017453292519943295769222222222222f;
+}
+/// Converts angle from radians to degrees
+inline float RadToDeg(float Angle)
+{
+	// Angle * 180 / PI
+	return Angle * 57.295779513082320876846364344191f;
+}
+
+/// Calculates difference of angles A-B, where A, B are in range: 0..2*PI
+/** Takes angle wrap-around into account, so it finds shortest path between
+them. */
+inline float AngleDiff(float A, float B)
+{
+	float R1 = B - A;
+	float R2 = B - PI_X_2 - A;
+	float R3 = B + PI_X_2 - A;
+
+	float R1a = fabsf(R1);
+	float R2a = fabsf(R2);
+	float R3a = fabsf(R3);
+
+	if (R1a < R2a && R1a < R3a)
+		return R1;
+	else if (R2a < R3a)
+		return R2;
+	else
+		return R3;
+}
+
+/// Smoothed curve 0..1 -> 0..1: e(x) = 3*x^2 - 2*x^3
+inline float EaseCurve(float x)
+{
+	return x * x * (3.0f - 2.0f * x);
+}
+/// Smoothed curve 0..1 -> 0..1: e(x) = 6*t^5 - 15*t^4 + 10*t^3
+/** Better than EaseCurve because it has zero second derivative for x=0 and x=1.
+*/
+inline float EaseCurve2(float x)
+{
+	return x * x * x * (x * (x * 6.0f - 15.0f) + 10.0f);
+}
+
+/// Returns 0.0 if x <= min and 1.0 if x >= max and performs smooth Hermite interpolation between 0 and 1 when min < x < max.
+/** This is useful in cases where you want a threshold function with a
+smooth transition. Results are undefined if min >= max. */
+inline float smoothstep(float min, float max, float x)
+{
+	if(x <= min) return 0.0f;
+	if(x >= max) return 1.0f;
+	x = (x - min) / (max - min);
+	return x * x * (3.0f - 2.0f * x);
+}
+
+/// More precise, but slower version of smoothstep function.
+inline float smoothstep2(float min, float max, float x)
+{
+	if(x <= min) return 0.f;
+	if(x >= max) return 1.f;
+	x = (x - min) / (max - min);
+	return 0.5f - cosf(PI * x) * 0.5f;
+}
+
+bool is_prime(unsigned n);
+
+/// Smoothing curve - Critically Damped Smoothing
+/** This is calculated based on a differential equation for some spring,
+precisely and analitically so TimeDelta can be any big you want.
+\param[in,out] InOutPos  Position before and after calculating this step
+\param[in,out] InOutVel  Velocity before and after calculating this step
+\param Dest              Target position
+\param SmoothTime        "Inertia" coefficient, expressed in units of time
+\param TimeDelta         Time of a step (eg. time from last frame)
+\param MaxSpeed          Maximum allowed speed (maximum distance that the position may not keep up?) */
+void SmoothCD(float *InOutPos, float Dest, float *InOutVel, float SmoothTime, float TimeDelta);
+void SmoothCD(float *InOutPos, float Dest, float *InOutVel, float SmoothTime, float TimeDelta, float MaxSpeed);
+
+/// Returns number in range 0..1 depending on value x relative to corners of a trapeze a, b, c, d.
+/**
+\verbatim
+    x < a => 0
+a < x < b => 0..1
+b < x < c => 1
+c < x < d => 1..0
+d < x     => 0
+\endverbatim
+*/
+inline float Trapezoidal(float x, float a, float b, float c, float d)
+{
+	if (x < a)
+		return 0.f;
+	else if (x < b)
+		return (x-a)/(b-a);
+	else if (x < c)
+		return 1.f;
+	else if (x < d)
+		return 1.f - (x-c)/(d-c);
+	else
+		return 0.f;
+}
+/// Like Trapezoidal(), but returns number in range min..max instead of 0..1.
+inline float Trapezoidal(float x, float a, float b, float c, float d, float min, float max)
+{
+	return Trapezoidal(x, a, b, c, d) * (max-min) + min;
+}
+
+/// Quadratic equation a*x^2 + b*x + c = 0
+/** Must be: a != 0.
+- No roots - returns 0, x1 and x2 are undefined.
+- One root - returns 1, x1 = x2 = this only solution.
+- Two roots - returns 2, x1 is first root and x2 is the second. */
+int QuadraticEquation(float a, float b, float c, float *Out_x1, float *Out_x2);
+
+/// Calculates average and optionally variance from a set of floating-point numbers.
+/** sqrt(Variance) is the standard deviation.
+\param Variance Can pass NULL if not needed. */
+void CalcMeanAndVariance(const float Numbers[], size_t NumberCount, float *OutMean, float *OutVariance = NULL, bool VarianceBiased = true);
+void CalcMeanAndVariance(const void *NumberData, size_t NumberCount, ptrdiff_t NumberStride, float *OutMean, float *OutVariance = NULL, bool VarianceBiased = true);
+
+/// MurmurHash 2.0 - declared as very fast hash function. Unfortunately not incremental.
+uint MurmurHash(const void *Data, uint DataLen, uint Seed);
+
+/// Very fast function for hashing data.
+/**
+Author: Paul Hsieh, http://www.azillionmonkeys.com/qed/hash.html
+Unfortunately not incremental.
+*/
+uint SuperFastHash(const void *DataBytes, size_t DataLen);
+
+/// Hash of 32-bit integer number (uint to uint).
+/**
+Source: "Integer Hash Function", Thomas Wang \n
+http://www.concentric.net/~Ttwang/tech/inthash.htm
+*/
+inline uint WangMix(uint key)
+{
+	key += ~(key << 15);
+	key ^= (key >> 10);
+	key += (key << 3);
+	key ^= (key >> 6);
+	key += ~(key << 11);
+	key ^= (key >> 16);
+	return key;
+}
+
+/// Interpolates given quantity between key values for parameter in range 0..1 with wrap-around.
+/**
+- Works with types T that have interpolation function defined for t = 0..1 in form of:
+  void Lerp(T *Out, const T &v1, const T &v2, float t);
+- As parameter t, in Items as well as for Calc method, pass number in range 0..1.
+- Values in Items can be changed freely.
+- For empty Items array always returns T().
+*/
+template <typename T>
+class RoundInterpolator
+{
+public:
+	struct ITEM
+	{
+		float t;
+		T Value;
+
+		ITEM() { }
+		ITEM(float t, const T &Value) : t(t), Value(Value) { }
+	};
+
+	std::vector<ITEM> Items;
+
+	RoundInterpolator() : m_LastUsedIndex(0) { }
+	void Calc(T *Out, float t) const;
+
+private:
+	mutable uint m_LastUsedIndex;
+};
+
+template <typename T>
+void RoundInterpolator<T>::Calc(T *Out, float t) const
+{
+	assert(t >= 0.0f && t <= 1.0f);
+
+	if (Items.empty())
+	{
+		*Out = T();
+		return;
+	}
+
+	// Find index of previous and next Item
+
+	// For the start take saved index and check if it's correct, if not return to zero.
+	uint Index = m_LastUsedIndex;
+	// - Index out of range
+	if (Index >= (uint)Items.size())
+		Index = 0;
+	// - Bad time on the left
+	if (Items[(size_t)Index].t > t)
+		Index = 0;
+
+	// Proceed further
+	while (Index < (uint)Items.size()-1 && Items[(size_t)Index+1].t < t)
+		Index++;
+
+	// Save the index
+	m_LastUsedIndex = Index;
+
+	if (Index < (uint)Items.size()-1)
+	{
+		float my_t = (t - Items[(size_t)Index].t) / (Items[(size_t)Index+1].t - Items[(size_t)Index].t);
+		RoundInterpolatorLerp(Out, Items[Index].Value, Items[Index+1].Value, my_t);
+	}
+	else
+	{
+		float my_t = (t - Items[(size_t)Index].t) / (Items[0].t + 1.0f - Items[(size_t)Index].t);
+		RoundInterpolatorLerp(Out, Items[(size_t)Index].Value, Items[0].Value, my_t);
+	}
+}
+
+/** \addtogroup base_perlin_noise Perlin noise
+Deterministic, pseudorandom function of 1, 2, 3 variables generating Perlin
+noise and often confused with it Fractional Brownian Motion (fBm). Perlin noise
+is a continuous pseudorandom function with amplitude -1..1 and frequency 1.
+In BrownianNoise functions:
+- i - number of octaves
+- Persistence - persistence of amplitude in subsequent octaves; recommended 0..1
+*/
+//@{
+float PerlinNoise1(float x);
+float PerlinNoise2(float x, float y);
+float PerlinNoise3(float x, float y, float z);
+float BrownianNoise1(float x,                   uint i, float Persistence);
+float BrownianNoise2(float x, float y,          uint i, float Persistence);
+float BrownianNoise3(float x, float y, float z, uint i, float Persistence);
+//@}
+
+/** \addtogroup base_math DEC3
+Format which encodes 4 components in 32-bit number as W2Z10Y10X10.
+Components x, y, z must be in range of 10 bits (0..0x03FF, means 0..1023),
+while component w in range of 2 bits (0..0x03, means 0..3).
+*/
+//@{
+
+inline uint MakeDEC3(uint x, uint y, uint z)
+{
+	return (x & 0x03FF) | ((y & 0x03FF) << 10) | ((z & 0x03FF) << 20);
+}
+inline uint MakeDEC3(uint x, uint y, uint z, uint w)
+{
+	return (x & 0x03FF) | ((y & 0x03FF) << 10) | ((z & 0x03FF) << 20) | ((w & 0x03) << 30);
+}
+inline uint GetXFromDEC3(uint dec3) { return (dec3      ) & 0x03FF; }
+inline uint GetYFromDEC3(uint dec3) { return (dec3 >> 10) & 0x03FF; }
+inline uint GetZFromDEC3(uint dec3) { return (dec3 >> 20) & 0x03FF; }
+inline uint GetWFromDEC3(uint dec3) { return (dec3 >> 30);          }
+
+//@}
+
+/// Calculates coefficients for linear equation y = A*x + B passing through given points (x1,y1), (x2,y2).
+/** \return false if calculation not possible because x1 is equal or too close to x2. */
+template <typename T>
+bool CalcLinearFactors(
+	T &outA, T &outB,
+	float x1, float x2,
+	const T &y1, const T &y2)
+{
+	float d = x2-x1;
+	if (FLOAT_ALMOST_ZERO(d))
+		return false;
+	outA = (y2 - y1) / d;
+	outB = (y1*x2 - y2*x1) / d;
+	return true;
+}
+
+/// Calculates coefficients for quadratic equation y = A*x^2 + B*x + C passing through given points (x1,y1), (x2,y2), (x3,y3).
+/** \return false if calculation not possible because some x arguments are equal or too close to each other. */
+template <typename T>
+bool CalcQuadraticFactors(
+	T &outA, T &outB, T &outC,
+	float x1, float x2, float x3,
+	const T &y1, const T &y2, const T &y3)
+{
+	float x1_sq = x1 * x1;
+	float x2_sq = x2 * x2;
+	float x3_sq = x3 * x3;
+	float w = x1_sq*(x2-x3) + x2_sq*(x3-x1) + x3_sq*(x1+x2);
+	if (FLOAT_ALMOST_ZERO(w))
+		return false;
+	outA = ( y1*(x2-x3) + y2*(x3-x1) + y3*(x1+x2) ) / w;
+	outB = ( y1*(x3_sq-x2_sq) + y2*(x1_sq-x3_sq) + y3*(x2_sq-x1_sq) ) / w;
+	outC = ( y1*(x2_sq*x3-x3_sq*x2) + y2*(x3_sq*x1-x1_sq*x3) + y3*(x1_sq*x2-x2_sq*x1) ) / w;
+	return true;
+}
+
+//@}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+/** \addtogroup base_strings Strings */
+//@{
+
+/// Types of end-of-line characters
+enum EOLMODE
+{
+	EOL_NONE, ///< Leave as-is during conversion
+	EOL_CRLF, ///< 13 and 10 (Windows)
+	EOL_LF,   ///< 10 (Unix)
+	EOL_CR	  ///< 13 (Mac)
+};
+
+/// Empty string - to be used so you can take a reference to it etc.
+extern const tstring EMPTY_STRING;
+/// Standard end-of-line string depending on system
+extern const tchar * const EOL;
+
+/// Codepage for Polish diacritic characters
+enum CHARSET
+{
+	CHARSET_NONE = 0, ///< No Polish diacritics
+	CHARSET_WINDOWS,  ///< Windows-1250 codepage (used in Windows GUI)
+	CHARSET_ISO,      ///< ISO-8859-2 (Latin-2) codepage (used in Linuksie)
+	CHARSET_IBM,      ///< IBM (CP852) codepage (used in Windows console)
+	CHARSET_UTF8,     ///< UTF-8 codepage
+};
+
+/// Returns true if character is alphanumeric (letter or digit) according to system settings
+bool CharIsAlphaNumeric(tchar ch);
+/// Returns true if character is a letter
+bool CharIsAlpha(tchar ch);
+/// Returns true if character is a decimal digit
+inline bool CharIsDigit(tchar ch) { return (ch >= _T('0') && ch <= _T('9')); }
+/// Returns true if character is a hexadecimal digit
+/** Accepts lower and upper letters. */
+inline bool CharIsHexDigit(tchar ch) { return (ch >= _T('0') && ch <= _T('9')) || (ch >= _T('A') && ch <= _T('F')) || (ch >= _T('a') && ch <= _T('f')); }
+/// Returns true if character is a lower letter
+bool CharIsLower(tchar ch);
+/// Returns true if character is an upper letter
+bool CharIsUpper(tchar ch);
+/// Returns true if character is a whitespace according to the system
+/** Two versions of this function - ANSI and Unicode - are needed for Stream - HexDecoder. */
+bool CharIsWhitespace(char ch);
+#ifdef _WIN32
+bool CharIsWhitespace(wchar_t ch);
+#endif
+/// Returns true if character is a whitespace
+/** Which means one of characters:
+- <tt>0x09 (9)  "\\t"</tt> - tab
+- <tt>0x0A (10) "\\n"</tt> - end-of-line character
+- <tt>0x0D (13) "\\r"</tt> - end-of-line character
+- <tt>          "\\v"</tt> - vertical space
+- <tt>0x20 (32) " "</tt>  - space */
+inline bool CharIsWhitespace_f(tchar ch)
+{
+	return (ch == _T(' ') || ch == _T('\n') || ch == _T('\r') || ch == _T('\t') || ch == _T('\v'));
+}
+
+/// Szuka w łańcuchu Str podłańcucha SubStr, bez rozróżniania wielkości liter.
+/** Zwraca indeks/wskaźnik do pierwszego znaku pierwszego znalezionego wystąpienia wewnątrz str.
+Jesli nie znaleziono, zwraca SIZE_MAX. */
+size_t StrStrI(const tstring &Str, const tstring &SubStr, size_t Count = SIZE_MAX);
+const tchar * StrStrI(const tchar *Str, const tchar *SubStr, size_t Count = SIZE_MAX);
+/// Odwraca łańcuch w miejscu
+void ReverseString(tstring *s);
+/// Obcina białe znaki z początku i końca łańcucha w miejscu
+void Trim(tstring *s);
+/// Obcina białe znaki z początku i końca łańcucha
+void Trim(tstring *Out, const tstring &s);
+
+// UWAGA! Z nieznanych przyczyn UpperCase i LowerCase źle konwertuje w stronie
+// kodowej IBM. Lepiej najpierw zmienić wielkość liter w innej stronie a potem
+// przekonwertować na IBM - wtedy działa. Kiedyś może naprawię ten bład :/
+
+/// Jeśli to litera, konwertuje na małą
+/** - Nie obsługuje wielobajtowych stron kodowych (UTF-8). */
+tchar CharToLower(tchar ch);
+/// Jeśli to litera, konwertuje na dużą
+/** - Nie obsługuje wielobajtowych stron kodowych (UTF-8). */
+tchar CharToUpper(tchar ch);
+/// Konwertuje łańcuch na małe litery
+/** - Nie obsługuje wielobajtowych stron kodowych (UTF-8). */
+void LowerCase(tstring *s);
+inline void LowerCase(tstring *Out, const tstring &s) { *Out = s; LowerCase(Out); }
+/// Konwertuje łańcuch na duże
+/** - Nie obsługuje wielobajtowych stron kodowych (UTF-8). */
+void UpperCase(tstring *s);
+inline void UpperCase(tstring *Out, const tstring &s) { *Out = s; UpperCase(Out); }
+
+/// Zmienia znak specjalny kodowania Windows-1250 na odpowiednik normalny.
+/** Jesli podany znak jest jednym ze znakow specjalnych Windows-1250,
+zwraca przez a_s jego normalny odpowiednik (można podać wskaźnik 0) i zwraca true.
+Jeśli to nie jest taki znak, zwraca false. */
+bool Charset_WindowsSpecialChar(char a_c, string *a_s);
+/// Zmienia znak z jednej strony kodowej na druga lub pozostawia bez zmian.
+/** Nie obsluguje stron kodowych wielobajtowych, tzn. UTF-8
+(wynik jest wtedy niezdefiniowany). */
+char Charset_Convert_Char(char a_c, CHARSET a_Charset1, CHARSET a_Charset2);
+/// Konwertuje lancuch na podana strone kodowa
+/** \param[out] out nie moze byc tym samym lancuchem, co s. */
+void Charset_Convert(string *out, const string &s, CHARSET Charset1, CHARSET Charset2);
+
+/// Szyforowanie/deszyfrowanie algorytmem ROT13
+void Rot13(tstring *InOut);
+inline void Rot13(tstring *Out, const tstring &In) { *Out = In; Rot13(Out); }
+
+/// Rodzaj znaku końca wiersza na odpowiadający mu znak (lub znaki)
+void EolModeToStr(tstring *Out, EOLMODE EolMode);
+
+/// Zamienia w łańcuchu wszystkie wystąpienia jedego podłańcucha na drugi
+/** Result musi być oczywiście, jak w każdej takiej funkcji, innym łańcuchem niż s. */
+void Replace(tstring *result, const tstring &s, const tstring &s1, const tstring &s2);
+/// Zmienia w łańcuchu wszystkie wystąpienia znaku Ch1 na Ch2
+void Replace(tstring *Out, const tstring &s, tchar Ch1, tchar Ch2);
+/// Zmienia w łańcuchu wszystkie wystąpienia znaku Ch1 na Ch2 w miejscu
+void Replace(tstring *InOut, tchar Ch1, tchar Ch2);
+
+/// Zmienia wszelkiego rodzaju znaki końca wiersza w poddanym tekście na takie same - wg podanego trybu
+void ReplaceEOL(tstring *result, const tstring &s, EOLMODE EOLMode);
+
+/// Zamienia wszystkie odstępy na pojedyncze spacje
+void NormalizeWhitespace(tstring *result, const tstring &s);
+
+/// Zwraca łańcuch powtórzony podaną liczbę razy
+void DuplicateString(tstring *Out, const tstring &s, size_t count);
+
+/// Zwraca podłańcuch z prawej strony
+void RightStr(tstring *Out, const tstring &s, size_t Length);
+
+/// Zwraca liczbę wystąpień podłańcucha
+size_t SubstringCount(const tstring &str, const tstring &substr);
+
+/// Porównuje dwa łańcuchy bez rozróżniania wielkości liter.
+/** Zwraca liczbę ujemną, 0 lub dodatnią zależnie od wyniku porównania. */
+int StrCmpI(const tstring &s1, const tstring &s2, size_t Count = SIZE_MAX);
+int StrCmpI(const tchar *s1, const tchar *s2, size_t Count = SIZE_MAX);
+/// Zwraca true, jeśli podfragmenty podanych łańcuchów są identyczne
+int SubStrCmp(const tstring &s1, size_t off1, const tstring &s2, size_t off2, size_t length);
+/// Zwraca true, jeśli podfragmenty podanych łańcuchów są identyczne nie rozróżniając wielkości liter
+int SubStrCmpI(const tstring &s1, size_t off1, const tstring &s2, size_t off2, size_t length);
+
+/// Czy łańcuch zawiera znaki końca wiersza?
+bool ContainsEOL(const tstring &s);
+
+/// Zwraca true, jesli podany lancuch zaczyna sie od podanego podlancucha
+bool StrBegins(const tstring &s, const tstring &sub, bool caseSensitive, size_t Begin = 0);
+/// Zwraca true, jeśli podany łańcuch kończy się podanym podłańcuchem
+bool StrEnds(const tstring &s, const tstring &Sub, bool caseSensitive);
+
+/// Kolejne wywołania rozdzielają łańcuch na kolejne elementy oddzielone w jego treści określonym podłańcuchem
+/** \param[out] out
+\param[in,out] index */
+bool Split(const tstring &s, const tstring &delimiter, tstring *out, size_t *index);
+/// Działa jak Split(), ale łańcuchem rozdzielającym jest każdy dowolny znak z delimiters
+bool SplitFirstOf(const tstring &s, const tstring &delimiters, tstring *out, size_t *index);
+/// Dzieli łańcuch na części i zwraca je jako wektor
+void Split(STRING_VECTOR *Out, const tstring &s, const tstring &Delimiter);
+/// Kolejne wywołania rozdzielają łańcuch na kolejne elementy oddzielone w jego treści którąś z sekwencji uznawaną za koniec wiersza (czyli na kolejne wiersze)
+bool SplitEOL(const tstring &s, tstring *out, size_t *index);
+/// Kolejne wywołania rozdzielają łańcuch na elementy oddzielone odstępami uwzględniając ciągi obięte w cudzysłowy <tt>""</tt> jako całość
+bool SplitQuery(const tstring &s, tstring *out, size_t *index);
+/// Sprawdza, czy podany łancuch jest zgodny z podaną maską mogącą zawierać znaki wieloznaczne
+/** '?' zastępuje dowolny jeden znak, '*' zastępuje dowolną liczbę (także 0) dowolnych znaków. */
+bool ValidateWildcard(const tstring &Mask, const tstring &S, bool CaseSensitive = true, size_t MaskOff = 0, size_t SOff = 0);
+/// Zwraca zmiennoprzecinkową trafność wyszukiwania stringa SubStr w stringu Str
+/** Zaawansowany algorytm, wymyślony przeze mnie dawno temu. Bierze pod uwagę
+rzeczy takie jak:
+-# ile razy podłańcuch występuje
+-# czy pasuje wielkość liter
+-# długość łańcucha i podłańcucha
+-# czy to całe słowo
+-# czy to cały łańcuch. */
+float FineSearch(const tstring &SubStr, const tstring &Str);
+/// Odległość edycyjna między dwoma łańcuchami.
+/** Złożoność: O( s1.length * s2.length ).
+Im mniejsza, tym łańcuchy bardziej podobne. Jeśli identyczne, zwraca 0. */
+size_t LevenshteinDistance(const tstring &s1, const tstring &s2);
+/// Odległość edycyjna między dwoma łańcuchami bez uwzględniania wielkości liter.
+/** Złożoność: O( s1.length * s2.length ).
+Im mniejsza, tym łańcuchy bardziej podobne. Jeśli identyczne, zwraca 0. */
+size_t LevenshteinDistanceI(const tstring &s1, const tstring &s2);
+
+/** \addtogroup base_natural_sort Sortowanie naturalne
+Sortowanie naturalne, czyli takie, w którym np. "abc2" jest przed "abc120". */
+//@{
+
+/// Klasa do porównywania w porządku naturalnym.
+class StringNaturalCompare
+{
+private:
+	bool m_CaseInsensitive;
+
+	int CompareNumbers(const tstring &s1, size_t i1, const tstring &s2, size_t i2);
+
+public:
+	StringNaturalCompare(bool CaseInsensitive) : m_CaseInsensitive(CaseInsensitive) { }
+	int Compare(const tstring &s1, const tstring &s2);
+};
+
+/// Predykat do sortowania łańcuchów w porządku naturalnym
+/** Przykład użycia:
+\code
+std::vector<string> v;
+std::sort(v.begin(), v.end(), common::StringNaturalLess());
+\endcode
+*/
+class StringNaturalLess : public StringNaturalCompare
+{
+public:
+	StringNaturalLess(bool CaseInsensitive = true) : StringNaturalCompare(CaseInsensitive) { }
+	bool operator () (const tstring &s1, const tstring &s2) { return (Compare(s1, s2) < 0); }
+};
+
+/// Predykat do sortowania łańcuchów w porządku naturalnym
+class StringNaturalGreater : public StringNaturalCompare
+{
+public:
+	StringNaturalGreater(bool CaseInsensitive = true) : StringNaturalCompare(CaseInsensitive) { }
+	bool operator () (const tstring &s1, const tstring &s2) { return (Compare(s1, s2) > 0); }
+};
+
+//@}
+
+/// Predykat do porównywania łańcuchów bez rozróżniania wielkości liter.
+class StrLessI
+{
+public:
+	bool operator () (const tstring &s1, const tstring &s2) { return StrCmpI(s1, s2) < 0; }
+};
+/// Predykat do porównywania łańcuchów bez rozróżniania wielkości liter.
+class StrGreaterI
+{
+public:
+	bool operator () (const tstring &s1, const tstring &s2) { return StrCmpI(s1, s2) > 0; }
+};
+
+/** \addtogroup base_cstr C-style strings */
+//@{
+
+/// Zwraca true, jeśli podany łańcuch jest NULL lub zawiera 0 znaków (od razu ma kończące '\0').
+inline bool StrIsEmpty(const char *s) { return s == NULL || *s == '\0'; }
+/// Czyści łańcuch wpisując samo kończące '\0'.
+inline void ClearStr(char *s) { assert(s); *s = '\0'; }
+
+#ifdef _WIN32
+	inline bool StrIsEmpty(const wchar_t *s) { return s == NULL || *s == L'\0'; }
+	inline void ClearStr(wchar_t *s) { assert(s); *s = L'\0'; }
+#endif
+
+/// Szuka w łańcuchu str podłańcucha substr, bez rozróżniania wielkości liter.
+/** Zwraca wskaźnik do pierwszego znaku pierwszego znalezionego wystąpienia wewnątrz str.
+Jesli nie znaleziono, zwraca NULL. */
+const tchar * strnistr(const tchar *str, const tchar *substr, size_t count = SIZE_MAX);
+// Zwraca true, jeśli łańcuch str zaczyna się od łańcucha substr
+bool StrBegins(const tchar *str, const tchar *substr, bool caseSensitive);
+/// Zwraca true, jeśli łańcuch str kończy się na łańcuch substr
+bool StrEnds(const tchar *str, const tchar *substr, bool caseSensitive);
+/// Usuwa podany zakres znaków z łańcucha. Jest bezpieczny na przekroczenie zakresu.
+void StrErase(tchar *str, size_t off, size_t count = SIZE_MAX);
+/// Wstawia podany podłańcuch do łańcucha w podane miejsce.
+void StrInsert(tchar *str, size_t strCapacity, const tchar *newStr, size_t off, size_t count);
+void StrInsert(tchar *str, size_t strCapacity, const tchar *newStr, size_t off);
+/// Obcina z początku i końca stringa białe znaki (w miejscu)
+void Trim(tchar *s);
+/// Replaces in string src all "from" chars to "to" chars. Returns number of occurences.
+unsigned StrReplace(tchar *str, tchar from, tchar to);
+
+//@}
+// base_cstr
+
+
+/** \addtogroup base_unicode Obsługa Unicode
+Dostępne tylko w Windows. */
+//@{
+
+#ifdef _WIN32
+
+/** \addtogroup base_unicode_convs Konwersje łańcuchów Unicode
+
+Konwersje między łańcuchem Unicode (UTF-16) a łańcuchem w innym kodowaniu - Single Byte lub Multi Byte.
+
+CodePage to kodowanie znaków typu char. Przykładowe wartości:
+  - Stałe: CP_UTF8 (UTF-8), CP_ACP (natywna, 1-bajtowa strona kodowa systemu).
+  - Numery takie jak 1250 dla kodowania Windows-1250 (p. MSDN > "Code Page Identifiers").
+
+Funkcje zwracają false w przypadku niepowodzenia konwersji. Wówczas Out jest pusty.
+*/
+//@{
+
+bool ConvertUnicodeToChars(string *Out, const wstring &S, unsigned CodePage);
+bool ConvertUnicodeToChars(string *Out, const wchar_t *S, size_t NumChars, unsigned CodePage);
+
+bool ConvertCharsToUnicode(wstring *Out, const string &S, unsigned CodePage);
+bool ConvertCharsToUnicode(wstring *Out, const char *S, size_t NumChars, unsigned CodePage);	
+
+/// Oblicza liczbę znaków (nie bajtów!) potrzebną przy konwersji między Unicode i ANSI.
+/** Błąd: Zwraca false, outLen ustawia na 0. */
+bool UnicodeToChars_CalcBufLen(size_t &outLen, const wchar_t *wcs, unsigned CodePage);
+bool UnicodeToChars_CalcBufLen(size_t &outLen, const wchar_t *wcs, size_t wcsLen, unsigned CodePage);
+bool CharsToUnicode_CalcBufLen(size_t &outLen, const char *str, unsigned CodePage);
+bool CharsToUnicode_CalcBufLen(size_t &outLen, const char *str, size_t strLen, unsigned CodePage);
+
+/// Konwertuje łańcuch między Unicode i ANSI. Nie dołącza kończącego zera.
+/** Błąd: zwraca false, outBuf ustawia na łańcuch pusty. */
+bool ConvertUnicodeToChars(char *outBuf, size_t bufLen, const wchar_t *wcs, unsigned CodePage);
+bool ConvertUnicodeToChars(char *outBuf, size_t bufLen, const wchar_t *wcs, size_t wcsLen, unsigned CodePage);
+bool ConvertCharsToUnicode(wchar_t *outBuf, size_t bufLen, const char *str, unsigned CodePage);
+bool ConvertCharsToUnicode(wchar_t *outBuf, size_t bufLen, const char *str, size_t strLen, unsigned CodePage);
+
+//@}
+
+/** \addtogroup base_unicode_headers Nagłówki Unicode
+Łańcuchy zakończone zerem - nagłówki poszczególnych formatów Unicode.
+(Standardowo używany w Windows jest UTF-16 Little Endian.) */
+//@{
+extern const char * const BOM_UTF8;
+extern const char * const BOM_UTF16_LE;
+extern const char * const BOM_UTF16_BE;
+//@}
+
+#endif
+
+/** \addtogroup base_unicode_conv_functions Konwersje między tstring, string, wstring
+W przypadku niepowodzenia zwracają false i Out jest wtedy pusty. */
+//@{
+#ifdef _UNICODE
+	bool TstringToString(string *Out, const tstring &S);
+	bool StringToTstring(tstring *Out, const string &S);
+	inline bool TstringToWstring(wstring *Out, const tstring &S) { *Out = S; return true; }
+	inline bool WstringToTstring(tstring *Out, const wstring &S) { *Out = S; return true; }
+
+	inline string TstringToStringR(const tstring &S) { string R;  if (!TstringToString(&R, S)) return string();  return R; }
+	inline tstring StringToTstringR(const string &S) { tstring R; if (!StringToTstring(&R, S)) return tstring(); return R; }
+	inline wstring TstringToWstring(const tstring &S) { return S; }
+	inline tstring WstringToTstring(const wstring &S) { return S; }
+#else
+	inline bool TstringToString(string *Out, const tstring &S) { *Out = S; return true; }
+	inline bool StringToTstring(tstring *Out, const string &S) { *Out = S; return true; }
+	inline string TstringToStringR(const tstring &S) { return S; }
+	inline tstring StringToTstringR(const string &S) { return S; }
+	#ifdef _WIN32
+		bool TstringToWstring(wstring *Out, const tstring &S);
+		bool WstringToTstring(tstring *Out, const wstring &S);
+		inline wstring TstringToWstringR(const tstring &S) { wstring R; if (!TstringToWstring(&R, S)) return wstring(); return R; }
+		inline tstring WstringToTstringR(const wstring &S) { tstring R; if (!WstringToTstring(&R, S)) return tstring(); return R; }
+	#endif
+#endif
+//@}
+// Konwersje między tstring, string, wstring
+
+//@}
+// Obsługa Unicode
+
+/** \addtogroup base_utf Konwersje między kodowaniami UTF
+Przenośne, nie korzystają z WinAPI. Dane wejściowe są zawsze sprawdzane - błędna sekwencja UTF-8
+(także zbyt długa lub zakodowany surogat), niesparowany surogat UTF-16, kod powyżej U+10FFFF
+lub długość niebędąca wielokrotnością rozmiaru jednostki powodują zwrócenie false. */
+//@{
+
+/// Kodowanie UTF
+enum UTF_FORMAT
+{
+	UTF_8,
+	UTF_16_LE,
+	UTF_16_BE,
+	UTF_32_LE,
+	UTF_32_BE,
+};
+
+/// Zwraca rozmiar jednej jednostki kodu w bajtach: 1, 2 lub 4
+inline size_t GetUtfUnitSize(UTF_FORMAT Format) { return Format == UTF_8 ? 1 : (Format <= UTF_16_BE ? 2 : 4); }
+/// Zwraca format łańcuchów wchar_t - UTF-16 pod Windows, UTF-32 w innych systemach, w natywnej kolejności bajtów
+inline UTF_FORMAT GetWcharUtfFormat()
+{
+	const uint16 Test = 1;
+	bool LittleEndian = *(const uint8*)&Test == 1;
+	if (sizeof(wchar_t) == 2)
+		return LittleEndian ? UTF_16_LE : UTF_16_BE;
+	return LittleEndian ? UTF_32_LE : UTF_32_BE;
+}
+
+/// Zwraca maksymalną liczbę bajtów, jaką ConvertUtf może zapisać dla wejścia podanego rozmiaru
+size_t ConvertUtf_MaxLength(UTF_FORMAT OutFormat, size_t InBytes, UTF_FORMAT InFormat);
+/// Konwertuje tekst między kodowaniami UTF
+/** Ciągi znaków ASCII są konwertowane za pomocą SSE2, jeśli jest dostępne.
+\param OutBuf Musi mieć co najmniej ConvertUtf_MaxLength bajtów.
+\param[out] OutBytes Liczba zapisanych bajtów.
+\param OutErrorOffset Może być NULL. W razie błędu otrzymuje przesunięcie w bajtach pierwszej błędnej sekwencji na wejściu.
+\return false, jeśli dane wejściowe są błędne. */
+bool ConvertUtf(void *OutBuf, size_t *OutBytes, UTF_FORMAT OutFormat, const void *In, size_t InBytes, UTF_FORMAT InFormat, size_t *OutErrorOffset = NULL);
+/// Konwertuje tekst między kodowaniami UTF do łańcucha bajtów. W razie błędu Out jest pusty.
+bool ConvertUtf(string *Out, UTF_FORMAT OutFormat, const void *In, size_t InBytes, UTF_FORMAT InFormat, size_t *OutErrorOffset = NULL);
+
+/// Konwertuje UTF-8 na łańcuch wchar_t (patrz GetWcharUtfFormat). W razie błędu Out jest pusty.
+bool Utf8ToWstring(wstring *Out, const char *S, size_t NumBytes, size_t *OutErrorOffset = NULL);
+/// Konwertuje łańcuch wchar_t (patrz GetWcharUtfFormat) na UTF-8. W razie błędu Out jest pusty.
+/** OutErrorOffset otrzymuje indeks błędnego znaku, a nie bajtu. */
+bool WstringToUtf8(string *Out, const wchar_t *S, size_t NumChars, size_t *OutErrorOffset = NULL);
+
+/// Rozpoznaje znacznik kolejności bajtów UTF (BOM) na początku danych
+/** Zwraca jego długość w bajtach lub 0, jeśli BOM-u nie ma. UTF-32 LE jest sprawdzany przed UTF-16 LE. */
+size_t DetectUtfBom(UTF_FORMAT *OutFormat, const void *Data, size_t NumBytes);
+
+//@}
+// Konwersje między kodowaniami UTF
+
+//@}
+// Łańcuchy
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+/** \addtogroup base_paths Ścieżki do plików */
+//@{
+
+#ifdef _WIN32
+	/// Separator katalogów w ścieżce, zależny od platformy.
+	const tchar DIR_SEP = _T('\\');
+#else
+	const tchar DIR_SEP = _T('/');
+#endif
+
+/// Zwraca true, jeśli ścieżka jest bezwzględna
+bool PathIsAbsolute(const tstring &s);
+/// Dodaje do sciezki konczacy '/' lub '\', jesli go nie ma - na miejscu
+void IncludeTrailingPathDelimiter(tstring *InOutPath);
+/// Dodaje do sciezki konczacy '/' lub '\', jesli go nie ma - do nowego stringa
+void IncludeTrailingPathDelimiter(tstring *OutPath, const tstring &InPath);
+/// Pozbawia sciezke konczacego '/' lub '\', jesli go ma - na miejscu
+void ExcludeTrailingPathDelimiter(tstring *InOutPath);
+/// Pozbawia sciezke konczacego '/' lub '\', jesli go ma - do nowego stringa
+void ExcludeTrailingPathDelimiter(tstring *OutPath, const tstring &InPath);
+/// Zwraca początek ścieżki, w postaci takiej jak "C:\", "\\komputer\udział\" czy "/" albo "\"
+/** Jeśli ścieżka jest względna, zwraca łańcuch pusty. */
+void ExtractPathPrefix(tstring *OutPrefix, const tstring &s);
+/// Zwraca ścieżkę do pliku bez nazwy pliku
+void ExtractFilePath(tstring *OutPath, const tstring &s);
+/// Zwraca samą nazwę pliku bez ścieżki
+void ExtractFileName(tstring *OutFileName, const tstring &s);
+/// Zwraca rozszerzenie pliku wraz z kropką
+void ExtractFileExt(tstring *OutExt, const tstring &s);
+/// Zmienia w nazwie pliku rozszerzenie na nowe
+/** Jesli Ext = "", usuwa rozszerzenie.
+Nowe rozszerzenie musi zawierać rozpoczynającą kropkę (tzn. nie musi, ale wypadałoby :) */
+void ChangeFileExt(tstring *Out, const tstring &FileName, const tstring &Ext);
+/// Pozbawia sciezke artefaktow typu ".\\" czy "..\\"
+/** Odpowiednio ja oczywiscie przetwarza tak, ze wyjscie jest logicznie rownowazne wejsciu. */
+void NormalizePath(tstring *OutPath, const tstring &s);
+/// Przetwarza sciezke wzgledna na bezwzgledna wzgledem okreslonej sciezki
+/** Na przykład Base="C:\\Kat", Path="PodKat\\Plik.txt", Wynik="C:\\Kat\\PodKat\\Plik.txt". */
+void RelativeToAbsolutePath(tstring *Out, const tstring &Base, const tstring &Path);
+/// Przetwarza sciezke bezwzgledna na wzgledna wzgledem okreslonej sciezki
+/** Jeśli się nie da, wychodzi również bezwzględna, równa Target.
+Na przykład Base="C:\\Kat", Tareget="C:\\Kat\\Podkat\\Plik.txt", Wynik="PodKat\\Plik.txt". */
+void AbsoluteToRelativePath(tstring *Out, const tstring &Base, const tstring &Target);
+
+//@}
+// Ścieżki do plików
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+/** \addtogroup base_conversions Konwersje między łańcuchem a różnymi typami */
+/**
+Starałem się zagwarantować w Windows (w Linux jeszcze nie - może kiedyś...),
+żeby konwersje zawsze działały tak samo niezależnie od locale ustawionego w
+bibliotece standardowej C (funkcja setlocale), C++ (klasa locale) czy WinAPI
+(funkcja SetThreadLocale). Szczególnie konwersje między liczbą
+zmiennoprzecinkową a łańcuchem zawsze używają kropki, a nie przecinka.
+*/
+//@{
+
+/// Zwraca liczbowy odpowiednik cyfry szesnastkowej.
+/** Jeśli błąd, zwraca 0xFF.
+Akceptuje zarówno małe, jak i duże litery.
+(Dwie wersje tej funkcji - osobno dla ANSI i Unicode - są potrzebne w Stream - HexDecoder.) */
+inline int HexDigitToNumber(char Ch)
+{
+	if      (Ch >= '0' && Ch <= '9') return (int)(uint8)(Ch -  '0');
+	else if (Ch >= 'A' && Ch <= 'F') return (int)(uint8)(Ch - ('A' - 10));
+	else if (Ch >= 'a' && Ch <= 'f') return (int)(uint8)(Ch - ('a' - 10));
+	else return 0xFF;
+}
+#ifdef _WIN32
+inline int HexDigitToNumber(wchar_t Ch)
+{
+	if      (Ch >= L'0' && Ch <= L'9') return (int)(Ch -  L'0');
+	else if (Ch >= L'A' && Ch <= L'F') return (int)(Ch - (L'A' - 10));
+	else if (Ch >= L'a' && Ch <= L'f') return (int)(Ch - (L'a' - 10));
+	else return 0xFF;
+}
+#endif
+
+/// Rozmiar bufora wystarczający dla UintToStr / IntToStr zapisujących do tablicy znaków
+/** 64 cyfry dwójkowe, minus i zero na końcu. */
+const size_t INT_TO_STR_BUFFER_SIZE = 66;
+
+/// \internal Zapis dziesiętny - po dwie cyfry naraz z tablicy par. Zwraca liczbę znaków, dopisuje zero na końcu.
+size_t _UintToDecimal32(tchar *Out, uint32 x);
+/// \internal
+size_t _UintToDecimal64(tchar *Out, uint64 x);
+/// \internal Zapis w dowolnym systemie 2..36
+size_t _UintToStrBase(tchar *Out, uint64 x, uint32 Base, bool UpperCase);
+
+/// Konwersja liczby całkowitej na łańcuch
+/** Wersja zapisująca do bufora o rozmiarze co najmniej INT_TO_STR_BUFFER_SIZE - nie alokuje pamięci.
+Dopisuje zero na końcu, zwraca liczbę znaków bez niego.
+\param Base musi być z zakresu 2..36 */
+template <typename T>
+size_t UintToStr(tchar *Out, T x, uint32 Base = 10, bool UpperCase = true)
+{
+	if (Base == 10)
+	{
+		if (sizeof(T) <= sizeof(uint32))
+			return _UintToDecimal32(Out, static_cast<uint32>(x));
+		return _UintToDecimal64(Out, static_cast<uint64>(x));
+	}
+	return _UintToStrBase(Out, static_cast<uint64>(x), Base, UpperCase);
+}
+
+template <typename T>
+size_t IntToStr(tchar *Out, T x, uint32 Base = 10, bool UpperCase = true)
+{
+	if (!(x < 0))
+		return UintToStr<T>(Out, x, Base, UpperCase);
+	// Moduł na typie bez znaku, bo -x dla najmniejszej wartości T jest UB
+	uint64 Magnitude = 0 - static_cast<uint64>(static_cast<int64>(x));
+	*Out = _T('-');
+	if (sizeof(T) <= sizeof(uint32))
+		return 1 + UintToStr<uint32>(Out + 1, static_cast<uint32>(Magnitude), Base, UpperCase);
+	return 1 + UintToStr<uint64>(Out + 1, Magnitude, Base, UpperCase);
+}
+
+/// Konwersja liczby całkowitej na łańcuch
+/** \param Base musi być z zakresu 2..36 */
+template <typename T>
+void UintToStr(tstring *Out, T x, uint32 Base = 10, bool UpperCase = true)
+{
+	tchar Buf[INT_TO_STR_BUFFER_SIZE];
+	size_t Length = UintToStr<T>(Buf, x, Base, UpperCase);
+	Out->assign(Buf, Length);
+}
+
+template <typename T>
+void IntToStr(tstring *Out, T x, uint32 Base = 10, bool UpperCase = true)
+{
+	tchar Buf[INT_TO_STR_BUFFER_SIZE];
+	size_t Length = IntToStr<T>(Buf, x, Base, UpperCase);
+	Out->assign(Buf, Length);
+}
+
+/// Konwertuje znak cyfry w dowolnym systemie ('0'..'9', 'A'..'Z', 'a'..'z') na liczbę, zwraca false jeśli błąd.
+/** \internal */
+template <typename T>
+bool _CharToDigit(T *Digit, tchar ch)
+{
+	if (ch >= _T('0') && ch <= _T('9'))
+		*Digit = static_cast<T>(ch-_T('0'));
+	else if (ch >= _T('A') && ch <= _T('Z'))
+		*Digit = static_cast<T>(ch-_T('A')+10);
+	else if (ch >= _T('a') && ch <= _T('z'))
+		*Digit = static_cast<T>(ch-_T('a')+10);
+	else
+		return false;
+	return true;
+}
+
+/// \internal Czyta cyfry dziesiętne od p aż do pierwszego znaku, który nie jest cyfrą i zwraca wskaźnik na niego.
+/** Dla char po 8 cyfr naraz (SWAR). Jeśli wartość nie mieści się w uint64, ustawia *Overflow. */
+const tchar * _ParseDecimalDigits(uint64 *Value, bool *Overflow, const tchar *p, const tchar *End);
+
+/// \internal Konwersja liczby bez znaku na T, zanegowanej jeśli Negative. Pusty łańcuch daje 0.
+/** Pierwszy błąd od lewej decyduje o wyniku, jak w StrToUint. */
+template <typename T>
+int _StrToIntMagnitude(T *Number, bool Negative, const tchar *Str, size_t Length, unsigned Base)
+{
+	const tchar *End = Str + Length;
+	uint64 Max = (uint64)std::numeric_limits<T>::max();
+	if (Negative)
+		Max = std::numeric_limits<T>::is_signed ? Max + 1 : 0;
+	uint64 Value = 0;
+	*Number = 0;
+	if (Base == 10)
+	{
+		bool Overflow;
+		const tchar *p = _ParseDecimalDigits(&Value, &Overflow, Str, End);
+		if (Overflow || Value > Max) return -2;
+		if (p != End) return -1;
+	}
+	else
+	{
+		uint64 Digit;
+		for (const tchar *p = Str; p != End; ++p) {
+			if (!_CharToDigit(&Digit, *p)) return -1;
+			if (Digit >= Base) return -1;
+			if (Value > (Max - Digit) / Base) return -2;
+			Value = Value * Base + Digit;
+		}
+	}
+	*Number = Negative ? static_cast<T>(0 - Value) : static_cast<T>(Value);
+	return 0;
+}
+
+/// Konwersja łańcucha na liczbę całkowitą
+/** Wersja na fragmencie pamięci - nie alokuje, nie zależy od locale.
+\return Zwraca:
+-  0 - sukces
+- -1 - błąd składni łańcucha
+- -2 - przekroczenie zakresu */
+template <typename T>
+int StrToUint(T *Number, const tchar *Str, size_t Length, unsigned Base)
+{
+	if (Length == 0) return -1;
+	return _StrToIntMagnitude<T>(Number, false, Str, Length, Base);
+}
+
+template <typename T>
+int StrToInt(T *Number, const tchar *Str, size_t Length, unsigned Base)
+{
+	if (Length == 0) return -1;
+	bool Negative = false;
+	if (Str[0] == _T('+')) { Str++; Length--; }
+	else if (Str[0] == _T('-')) { Negative = true; Str++; Length--; }
+	return _StrToIntMagnitude<T>(Number, Negative, Str, Length, Base);
+}
+
+template <typename T>
+inline int StrToUint(T *Number, const tstring &str, unsigned Base = 10) { return StrToUint<T>(Number, str.data(), str.length(), Base); }
+template <typename T>
+inline int StrToInt (T *Number, const tstring &str, unsigned Base = 10) { return StrToInt<T> (Number, str.data(), str.length(), Base); }
+
+template <typename T> inline tstring IntToStrR (T x, int base = 10, bool UpperCase = true) { tstring r; IntToStr<T> (&r, x, base, UpperCase); return r; }
+template <typename T> inline tstring UintToStrR(T x, int base = 10, bool UpperCase = true) { tstring r; UintToStr<T>(&r, x, base, UpperCase); return r; }
+
+inline void Size_tToStr(tstring *Out, size_t x, uint Base = 10, bool UpperCase = true) { UintToStr<size_t>(Out, x, Base, UpperCase); }
+inline tstring Size_tToStrR(size_t x, uint Base = 10, bool UpperCase = true) { tstring R; Size_tToStr(&R, x, Base, UpperCase); return R; }
+
+/// Konwersja liczby na łańcuch o minimalnej podanej długości.
+/** Zostanie do tej długości uzupełniony zerami.
+Wersja do bufora musi mieć miejsce na max(Length, INT_TO_STR_BUFFER_SIZE) znaków. */
+template <typename T>
+size_t UintToStr2(tchar *Out, T x, size_t Length, int base = 10)
+{
+	tchar Buf[INT_TO_STR_BUFFER_SIZE];
+	size_t DigitCount = UintToStr<T>(Buf, x, base);
+	size_t Padding = DigitCount < Length ? Length - DigitCount : 0;
+	for (size_t i = 0; i < Padding; i++)
+		Out[i] = _T('0');
+	std::copy(Buf, Buf + DigitCount + 1, Out + Padding);
+	return Padding + DigitCount;
+}
+/// Zera wstawia po minusie, długość obejmuje minus.
+template <typename T>
+size_t IntToStr2(tchar *Out, T x, size_t Length, int base = 10)
+{
+	tchar Buf[INT_TO_STR_BUFFER_SIZE];
+	size_t BufLength = IntToStr<T>(Buf, x, base);
+	size_t Padding = BufLength < Length ? Length - BufLength : 0;
+	size_t Sign = Buf[0] == _T('-') ? 1 : 0;
+	if (Sign)
+		Out[0] = _T('-');
+	for (size_t i = 0; i < Padding; i++)
+		Out[Sign + i] = _T('0');
+	std::copy(Buf + Sign, Buf + BufLength + 1, Out + Sign + Padding);
+	return Padding + BufLength;
+}
+
+template <typename T>
+void UintToStr2(tstring *Out, T x, size_t Length, int base = 10)
+{
+	tchar Buf[INT_TO_STR_BUFFER_SIZE];
+	size_t DigitCount = UintToStr<T>(Buf, x, base);
+	Out->clear();
+	if (DigitCount < Length)
+		Out->append(Length - DigitCount, _T('0'));
+	Out->append(Buf, DigitCount);
+}
+template <typename T>
+void IntToStr2(tstring *Out, T x, size_t Length, int base = 10)
+{
+	tchar Buf[INT_TO_STR_BUFFER_SIZE];
+	size_t BufLength = IntToStr<T>(Buf, x, base);
+	size_t Sign = Buf[0] == _T('-') ? 1 : 0;
+	Out->assign(Buf, Sign);
+	if (BufLength < Length)
+		Out->append(Length - BufLength, _T('0'));
+	Out->append(Buf + Sign, BufLength - Sign);
+}
+
+template <typename T> tstring UintToStr2R(T x, size_t Length, int Base = 10) { tstring R; UintToStr2<T>(&R, x, Length, Base); return R; }
+template <typename T> tstring IntToStr2R (T x, size_t Length, int Base = 10) { tstring R; IntToStr2<T> (&R, x, Length, Base); return R; }
+
+/// Konwertuje znak na łańcuch, jako że automatycznie to się niestety nie odbywa
+inline void CharToStr(tstring *Out, tchar ch) { Out->clear(); *Out += ch; }
+inline tstring CharToStrR(tchar ch) { tstring s; s += ch; return s; }
+
+/// Rozmiar bufora wystarczający dla DoubleToStr i FloatToStr do bufora w każdym trybie, z zerem na końcu.
+const size_t DOUBLE_TO_STR_BUFFER_SIZE = 352;
+
+/// Konwersja liczb zmiennoprzecinkowych na łańcuch
+/** Nie używa sprintf ani locale - zawsze kropka dziesiętna. Wynik jest poprawnie zaokrąglony.
+\param Mode:
+- 'e' : -1.234500e-01
+- 'E' : -1.234500E-01
+- 'f' : -0.123450
+- 'g' : optimum ('e', 'f')
+- 'G' : optimum ('E', 'f')
+- 'r' : najkrótsza postać, która wczytana przez StrToDouble (StrToFloat dla float) da dokładnie tę samą
+  liczbę, np. -0.12345 - Precision jest ignorowane
+\param Precision 0..20 */
+void DoubleToStr(tstring *Out, double x, char Mode = 'g', int Precision = 6);
+void FloatToStr(tstring *Out, float x, char Mode = 'g', int Precision = 6);
+/// Wersje zapisujące do bufora o rozmiarze co najmniej DOUBLE_TO_STR_BUFFER_SIZE.
+/** Zwracają liczbę zapisanych znaków, nie licząc zera na końcu. */
+size_t DoubleToStr(tchar *Out, double x, char Mode = 'g', int Precision = 6);
+size_t FloatToStr(tchar *Out, float x, char Mode = 'g', int Precision = 6);
+
+inline tstring DoubleToStrR(double x, char Mode = 'g', int Precision = 6) { tstring R; DoubleToStr(&R, x, Mode, Precision); return R; }
+inline tstring FloatToStrR (float x, char Mode = 'g', int Precision = 6) { tstring R;  FloatToStr (&R, x, Mode, Precision); return R; }
+
+/// Konwersja łańcucha na liczbę zmiennoprzecinkową.
+/**
+- Składnia: [spacje][+-]cyfry[.cyfry][{DdEe}[+-]cyfry]
+- W przypadku błędu składni zwracają wartość != 0.
+- Wynik jest poprawnie zaokrąglony do najbliższej wartości float/double, niezależnie od locale.
+- Liczba poza zakresem daje nieskończoność lub 0. */
+int StrToDouble(double *out, const tchar *s, size_t Length);
+int StrToFloat (float *out,  const tchar *s, size_t Length);
+inline int StrToDouble(double *out, const tstring &s) { return StrToDouble(out, s.data(), s.length()); }
+inline int StrToFloat (float *out,  const tstring &s) { return StrToFloat (out, s.data(), s.length()); }
+
+/// Konwertuje wartość logiczną na łańcuch
+/** \param mode:
+- '0' : 0 / 1
+- 'f' : false / true
+- 'F' : False / True
+- 'U' : FALSE / TRUE
+- 'g' : f / t
+- 'G' : F / T */
+void BoolToStr(tstring *Out, bool x, char mode = 'f');
+inline tstring BoolToStrR(bool x, char mode = 'f') { tstring R; BoolToStr(&R, x, mode); return R; }
+/// Konwertuje łańcuch na wartość logiczną
+/**
+- Dozwolone wszelkie wartości jak w BoolToStr.
+- Błąd: zwraca false. */
+bool StrToBool(bool *result, const tstring &s);
+
+/// Konwertuje wskaźnik na łańcuch 8 znaków zapisany szesnastkowo
+void PtrToStr(tstring *Out, const void* p);
+inline tstring PtrToStrR(const void *p) { tstring R; PtrToStr(&R, p); return R; }
+
+/// Liczba bajtów na łańcuch z rozmiarem np. "1 B", "10.5 kB"
+/** Jako T uzywac uint8, uint16, uint32, uint64 lub int ale na pewno wartości dodaniej.
+\param Space czy między liczbę a jednostkę dawać spację
+\param Precision ilość cyfr po przecinku (może być też 0) */
+template <typename T>
+void SizeToStr(tstring *str, T size, bool Space, int Precision)
+{
+	double size2 = (double)size;
+	if (size2 >= 1024.0*1024.0*1024.0*1024.0)
+	{
+		DoubleToStr( str, size2/(1024.0*1024.0*1024.0*1024.0), 'f', Precision );
+		str->append(Space ? _T(" TB") : _T("TB"));
+	}
+	else if (size2 >= 1024.0*1024.0*1024.0)
+	{
+		DoubleToStr( str, size2/(1024.0*1024.0*1024.0), 'f', Precision );
+		str->append(Space ? _T(" GB") : _T("GB"));
+	}
+	else if (size2 >= 1024.0*1024.0)
+	{
+		DoubleToStr( str, size2/(1024.0*1024.0), 'f', Precision );
+		str->append(Space ? _T(" MB") : _T("MB"));
+	}
+	else if (size2 >= 1024.0)
+	{
+		DoubleToStr( str, size2/1024.0, 'f', Precision );
+		str->append(Space ? _T(" KB") : _T("KB"));
+	}
+	else
+	{
+		UintToStr( str, size );
+		str->append(Space ? _T(" B") : _T("B"));
+	}
+}
+template <typename T> tstring SizeToStrR(T Size, bool Space, int Precision) { tstring r; SizeToStr<T>(&r, Size, Space, Precision); return r; }
+
+//@}
+// Konwersje między łańcuchem a różnymi typami
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+/** \addtogroup base_periodic_funcs Funkcje okresowe */
+//@{
+
+/*
+Funkcje zwracające różnego rodzaju przebiegi okresowe.
+Domyślne (bez ustawianych własnych parametrów) mają zakres wyjściowy 0..1,
+częstotliwość 1 i fazę 0.
+- Base      - dolne ograniczenie
+- Amplitude - pełna wysokość
+*/
+
+/// Standard sine wave which smoothly changes from low to high and back again.
+inline float WaveformSine(float x, float Base, float Amplitude, float Frequency, float Phase)
+{
+	return Base + (sinf((x + Phase) * Frequency * PI_X_2)+1.0f)*0.5f * Amplitude;
+}
+inline float WaveformSine(float x)
+{
+	return (sinf(x * PI_X_2)+1.0f)*0.5f;
+}
+
+/// An angular wave with a constant increase / decrease speed with pointed peaks.
+inline float WaveformTriangle(float x, float Base, float Amplitude, float Frequency, float Phase)
+{
+	float Input = frac((x + Phase) * Frequency);
+	float Output;
+	if (Input < 0.25f)
+		Output = Input * 4.0f;
+	else if (Input < 0.75f)
+		Output = 1.0f - ((Input - 0.25f) * 4.0f);
+	else
+		Output = ((Input - 0.75f) * 4.0f) - 1.0f;
+	return Base + (Output+1.0f)*0.5f * Amplitude;
+}
+inline float WaveformTriangle(float x)
+{
+	float Input = frac(x);
+	float Output;
+	if (Input < 0.25f)
+		Output = Input * 4.0f;
+	else if (Input < 0.75f)
+		Output = 1.0f - ((Input - 0.25f) * 4.0f);
+	else
+		Output = ((Input - 0.75f) * 4.0f) - 1.0f;
+	return (Output+1.0f)*0.5f;
+}
+
+/// Half of the time is spent at the min, half at the max with instant transition between.
+inline float WaveformSquare(float x, float Base, float Amplitude, float Frequency, float Phase)
+{
+	return Base + (frac((x + Phase) * Frequency) <= 0.5f ? 1.0f : 0.0f) * Amplitude;
+}
+inline float WaveformSquare(float x)
+{
+	return frac(x) <= 0.5f ? 1.0f : 0.0f;
+}
+
+/// Gradual steady increase from min to max over the period with an instant return to min at the end.
+inline float WaveformSawtooth(float x, float Base, float Amplitude, float Frequency, float Phase)
+{
+	return Base + frac((x + Phase) * Frequency) * Amplitude;
+}
+inline float WaveformSawtooth(float x)
+{
+	return frac(x);
+}
+
+/// Gradual steady decrease from max to min over the period, with an instant return to max at the end.
+inline float WaveformInvSawtooth(float x, float Base, float Amplitude, float Frequency, float Phase)
+{
+	return Base + (1.0f - frac((x + Phase) * Frequency)) * Amplitude;
+}
+inline float WaveformInvSawtooth(float x)
+{
+	return 1.0f - frac(x);
+}
+
+/// Pulse Width Modulation.
+/** Works like square, except the high to low transition is controlled by duty
+cycle. With a duty cycle of 50% (0.5) will give the same output as square. */
+inline float WaveformPWM(float x, float DutyCycle, float Base, float Amplitude, float Frequency, float Phase)
+{
+	return Base + (frac((x + Phase) * Frequency) <= DutyCycle ? 1.0f : 0.0f) * Amplitude;
+}
+inline float WaveformPWM(float x, float DutyCycle)
+{
+	return (frac(x) <= DutyCycle ? 1.0f : 0.0f);
+}
+
+//@}
+// Funkcje okresowe
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+/** \addtogroup base_random_gen Generator liczb pseudolosowych
+*/
+//@{
+
+/// Generator liczb pseudolosowych
+/** Jest przede wszystkim szybki. Nie jest bardzo dobrze losowy. Można go używać
+jako deterministycznego tworząc własne obiekty tej klasy i ręcznie je
+naziarniając. */
+class RandomGenerator
+{
+private:
+	// Current seed
+	uint32 m_Seed;
+	float m_NextNormalNumber; bool m_HasNextNormalNumber;
+
+public:
+	/// Constructor - seed from the clock
+	RandomGenerator();
+	/// Constructor - seed with given seed
+	RandomGenerator(uint32 seed) : m_Seed(seed), m_HasNextNormalNumber(false) { }
+
+	/// Wpisuje nowe ziarno.
+	void Seed(uint32 a_Seed)
+	{
+		m_Seed = a_Seed;
+	}
+
+	/// Generuje liczbę losową całkowitą bez znaku, pełny zakres
+	/** Na podstawie książki "Perełki programowania gier", tom III, Dante Treglia
+	Uwaga! Młodsze bity są słabo losowe, powtarzają się w bardzo krótkim okresie. */
+	uint32 RandUint_Fast()
+	{
+		return ( m_Seed = (m_Seed * 196314165 + 907633515) );
+	}
+	/// Generuje liczbę losową, w której wszystkie bity są dość losowe
+	uint32 RandUint()
+	{
+		return
+			(RandUint_Fast() & 0xFF000000)       |
+			(RandUint_Fast() & 0xFF000000) >>  8 |
+			(RandUint_Fast() & 0xFF000000) >> 16 |
+			(RandUint_Fast() & 0xFF000000) >> 24;
+	}
+	/// Generuje liczbę losową w zakresie 0 .. max-1
+	uint32 RandUint(uint32 max)
+	{
+		return RandUint() % max;
+	}
+	/// Generuje liczbę losową w zakresie min .. max-1
+	uint32 RandUint(uint32 min, uint32 max)
+	{
+		return RandUint() % (max-min) + min;
+	}
+
+	/// Generuje losowy bajt
+	uint8 RandByte()
+	{
+		return (RandUint_Fast() & 0xFF000000) >> 24;
+	}
+
+	/// Generuje liczbę losową rzeczywistą z przedziału 0.0..1.0
+	/** Autor tego genialnego algorytmu: Mikael */
+	float RandFloat()
+	{
+		return absolute_cast<float>(RandUint() & 0x007FFFFF | 0x3F800000) - 1.0f;
+	}
+	/// Generuje liczbę losową rzeczywistą z przedziału 0.0..max
+	float RandFloat(float max)
+	{
+		return RandFloat() * max;
+	}
+	/// Generuje liczbę losową rzeczywistą z przedziału min..max
+	float RandFloat(float min, float max)
+	{
+		return RandFloat() * (max - min) + min;
+	}
+	/// Generates random real number in range -1..1. (not sure whether inclusive).
+	/** Author: iq/rgba, http://www.rgba.org/articles/sfrand/sfrand.htm */
+	float RandFloat2()
+	{
+		uint a = (RandUint() & 0x007fffff) | 0x40000000;
+		return( *((float*)&a) - 3.0f );
+	}
+
+	/// Generuje losowy stan logiczny
+	bool RandBool()
+	{
+		return (RandUint() >= 0x7FFFFFFFu);
+	}
+
+	/// Generuje liczbę losową całkowitą ze znakiem z zakresu Min .. Max-1
+	int RandInt(int Min, int Max)
+	{
+		if (Max > Min)
+			return static_cast<int>(RandUint(Max-Min)) + Min;
+		else
+			return static_cast<int>(RandUint(Min-Max)) + Max;
+	}
+
+	/// Wypełnia podany bufor losowymi danymi binarnymi
+	/** \param DataLength w bajtach. */
+	void RandData(void *OutData, size_t DataLength);
+
+	/// Generuje liczbę losową o rozkładzie normalnym (Gaussa)
+	/** Zgodnie z definicją, wylosowana liczba leży w zakresie z prawdopodobieństwem:
+	- -1 * sigma .. +1 * sigma : 68%
+	- -2 * sigma .. +2 * sigma : 95%
+	- -3 * sigma .. +3 * sigma : 99.73% */
+	float RandNormal(float sigma);
+};
+
+/// Domyślny generator liczb losowych do używania w wątku głównym i kiedy nie musi być deterministyczny
+extern RandomGenerator g_Rand;
+
+/// Wolniejszy w inicjalizacji, generowaniu i większy, ale za to tużo lepszy generator liczb pseudolosowych.
+/** Źródło:
+Mersenne Twister Home Page,
+http://www.math.sci.hiroshima-u.ac.jp/~m-mat/MT/emt.html
+*/
+class MersenneTwister
+{
+public:
+	/// Inicjalizuje bieżącym czasem systemowym
+	MersenneTwister();
+	/// Inicjalizuje podanym ziarnem
+	MersenneTwister(uint Seed);
+	/// Inicjalizuje ziarnem w postaci podanej tablicy
+	MersenneTwister(uint InitKeys[], int KeyCount);
+
+	/// Generuje liczbę uint [0,0xffffffff]
+	uint NextUint();
+	/// Generuje liczbę int [0,0x7fffffff]
+	int NextInt31();
+	/// Generuje liczbę double [0,1]
+	double NextReal1();
+	/// Generuje liczbę double [0,1)
+	double NextReal2();
+	/// Generuje liczbę double (0,1)
+	double NextReal3();
+	/// Generuje liczbę double [0,1) z rozdzielczością 53 bitów
+	double NextReal_Res53();
+
+private:
+	uint m_State[624];
+	int m_Left;
+	uint *m_Next;
+
+	void Init(uint Seed);
+	void NextState();
+};
+
+/// Generator unikatowych identyfikatorów
+class UniqueGenerator
+{
+private:
+	uint32 m_Next;
+
+public:
+	/// Pierwszy będzie miał nr 1.
+	UniqueGenerator();
+	/// Pierwszy będzie miał podany tutaj numer
+	UniqueGenerator(uint32 First);
+
+	/// Zwraca unikatową liczbę
+	uint32 GetUint() { return m_Next++; }
+	/// Zwraca unikatowy łańcuch w formacie "########", gdzie ######## to liczba szesnastkowa.
+	void GetString(tstring *Out);
+	tstring GetString() { tstring R; GetString(&R); return R; }
+	/// Zwraca unikatowy łańcuch w formacie "<prefix>########", gdzie ######## to liczba szesnastkowa.
+	void GetString(tstring *Out, const tstring &Prefix);
+	/// \copydoc GetString(tstring*,const tstring&)
+	tstring GetString(const tstring &Prefix) { tstring R; GetString(&R, Prefix); return R; }
+};
+
+//@}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Parser wiersza poleceń
+
+/// \internal
+class CmdLineParser_pimpl;
+
+/// Parser wiersza poleceń
+class CmdLineParser
+{
+private:
+	scoped_ptr<CmdLineParser_pimpl> pimpl;
+
+public:
+	/// Rodzaj pobranej informacji
+	enum RESULT
+	{
+		RESULT_OPT,       ///< Opcja
+		RESULT_PARAMETER, ///< Goły parametr bez opcji
+		RESULT_END,       ///< Koniec parametrów
+		RESULT_ERROR,     ///< Błąd składni
+	};
+
+	/// Wersja dla main(int argc, char **argv)
+	CmdLineParser(int argc, tchar **argv);
+	/// Wersja dla WinMain(HINSTANCE Instance, HINSTANCE, char *CmdLine, int CmdShow)
+	CmdLineParser(const tchar *CmdLine);
+
+	~CmdLineParser();
+
+	/// Rejestruje opcję jednoznakową.
+	/** \param Id podawać liczby większe od 0. */
+	void RegisterOpt(uint Id, tchar Opt, bool Parameter);
+	/// Rejestruje opcję wieloznakową.
+	/** \param Id podawać liczby większe od 0. */
+	void RegisterOpt(uint Id, const tstring &Opt, bool Parameter);
+
+	/// Wczytuje następną informację, zwraca jej rodzaj
+	RESULT ReadNext();
+
+	/// Zwraca dane na temat ostatnio wczytanej informacji - identyfikator opcji.
+	/** Jeśli nie została wczytana opcja, zwraca 0. */
+	uint GetOptId();
+	/// Zwraca dane na temat ostatnio wczytanej informacji - treść parametru.
+	/** Jeśli nie ma, łańcuch pusty. */
+	const tstring & GetParameter();
+};
+
+/// Reprezentuje 128-bitowy globalnie unikatowy identyfikator, zgodnie z RFC 4122
+class CommonGUID
+{
+public:
+	static const CommonGUID NIL;
+
+	static int Cmp(const CommonGUID &v1, const CommonGUID &v2);
+
+	/// Tworzy niezainicjalizowany
+	CommonGUID() { }
+	CommonGUID(uint8 v0, uint8 v1, uint8 v2, uint8 v3, uint8 v4, uint8 v5, uint8 v6, uint8 v7, uint8 v8, uint8 v9, uint8 v10, uint8 v11, uint8 v12, uint8 v13, uint8 v14, uint8 v15);
+
+	const uint8 * AccessData() const { return Data; }
+	uint8 * AccessData() { return Data; }
+
+	const uint8 & operator [] (size_t i) const { return Data[i]; }
+	uint8 & operator [] (size_t i) { return Data[i]; }
+
+	bool operator == (const CommonGUID &v) const { return Cmp(*this, v) == 0; }
+	bool operator != (const CommonGUID &v) const { return Cmp(*this, v) != 0; }
+	bool operator <  (const CommonGUID &v) const { return Cmp(*this, v) <  0; }
+	bool operator >  (const CommonGUID &v) const { return Cmp(*this, v) >  0; }
+	bool operator <= (const CommonGUID &v) const { return Cmp(*this, v) <= 0; }
+	bool operator >= (const CommonGUID &v) const { return Cmp(*this, v) >= 0; }
+
+	void ToString(tchar *out) const; ///< Bufor musi miec dlugosc co najmniej 37 znakow.
+	void ToString(tstring &out) const;
+	bool FromString(const tchar *s);
+	bool FromString(const tstring &s);
+
+	/// Generuje nowy, losowy, unikatowy identyfikator na podstawie algorytmu w wersji 4.
+	void GenerateVersion4();
+
+private:
+	/// Od najmlodszych do najstarszych, tzn. Data[0] jest najmlodszy.
+	uint8 Data[16];
+};
+
+//@}
+// code_base
+
+} // namespace common
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+/** \addtogroup code_sthtostr Uniwersalne konwersje
+Uniwersalny i rozszerzalny mechanizm konwersji na i z łańcucha */
+//@{
+
+template <typename T>
+struct SthToStr_obj
+{
+	void operator () (tstring *Str, const T &Sth)
+	{
+		// Runtime error
+		assert(0 && "SthToStr: Unsupported type.");
+		// Compilation error
+		// Działa tylko w Visual C++, g++ pokazuje błąd kompilacji nawet kiedy nieużyte
+#ifdef _WIN32
+		int y = UnsupportedTypeInSthToStr;
+#endif
+	}
+	static inline bool IsSupported() { return false; }
+};
+
+template <typename T>
+inline void SthToStr(tstring *Str, const T &Sth)
+{
+	SthToStr_obj<T>()(Str, Sth);
+}
+
+template <typename T>
+struct StrToSth_obj
+{
+	bool operator () (const tstring &Str, T *Sth)
+	{
+		// Runtime error
+		assert(0 && "StrToSth: Unsupported type.");
+		// Compilation error
+		// Działa tylko w Visual C++, g++ pokazuje błąd kompilacji nawet kiedy nieużyte
+#ifdef _WIN32
+		int y = UnsupportedTypeInSthToStr;
+#endif
+		return false;
+	}
+	static inline bool IsSupported() { return false; }
+};
+
+template <typename T>
+inline bool StrToSth(T *Sth, const tstring &Str)
+{
+	return StrToSth_obj<T>()(Sth, Str);
+}
+
+//@}
+
+namespace common
+{
+
+/** \addtogroup code_sthtostr */
+//@{
+
+/// \internal
+class Format_pimpl
+{
+	friend class Format;
+
+private:
+	tstring m_String;
+	tchar m_Sep;
+	size_t m_Index;
+
+	Format_pimpl(const tstring &Fmt, tchar Sep) : m_String(Fmt), m_Sep(Sep), m_Index(0) { }
+};
+
+/// Klasa do wygodnego składania stringów z różnych informacji
+/**
+Przykład użycia:
+\code
+int i = 10; float f = 3.14f; tstring s = _T("A");
+string MyString = Format("i=#, f=#, s=#") % i % f % s;
+\endcode
+*/
+class Format
+{
+private:
+	shared_ptr<Format_pimpl> pimpl;
+
+public:
+	Format(const tstring &Fmt, tchar Sep = _T('#')) : pimpl(new Format_pimpl(Fmt, Sep)) { }
+	/// Dodaje kolejną informację do formatowanego łańcucha
+	/** \internal
+	- To taki jakby dziwny konstuktor kopiujący.
+	- Używam za każdym razem tworzenia osobnego obiektu, bo nie można w g++
+	modyfikować obiektu tymczasowego i nie dałoby się tego tak wygodnie
+	używać.
+	- Do użytku wewnętrznego - nie używać! */
+	Format(const Format &f, const tstring &Element);
+	/// \internal
+	Format(const Format &f, const tchar *Element);
+
+	operator tstring () const { return pimpl->m_String; }
+	/// Zwraca finalny string - stosować tam, gdzie nie zadziała automatyczne rzutowanie na string.
+	tstring str() const { return pimpl->m_String; }
+};
+
+template <typename T>
+const Format operator % (const Format &fmt, const T &x)
+{
+	tstring s;
+	SthToStr<T>(&s, x);
+	return Format(fmt, s);
+}
+
+inline const Format operator % (const Format &fmt, const tchar *x)
+{
+	return Format(fmt, x);
+}
+
+// Liczby całkowite bez pośredniego tstring
+inline const Format operator % (const Format &fmt, int32 x)  { tchar Buf[INT_TO_STR_BUFFER_SIZE]; IntToStr<int32>(Buf, x);   return Format(fmt, Buf); }
+inline const Format operator % (const Format &fmt, uint32 x) { tchar Buf[INT_TO_STR_BUFFER_SIZE]; UintToStr<uint32>(Buf, x); return Format(fmt, Buf); }
+inline const Format operator % (const Format &fmt, int64 x)  { tchar Buf[INT_TO_STR_BUFFER_SIZE]; IntToStr<int64>(Buf, x);   return Format(fmt, Buf); }
+inline const Format operator % (const Format &fmt, uint64 x) { tchar Buf[INT_TO_STR_BUFFER_SIZE]; UintToStr<uint64>(Buf, x); return Format(fmt, Buf); }
+
+//@}
+
+} // namespace common
+
+
+/** \addtogroup code_sthtostr */
+//@{
+
+//------------------------------------------------------------------------------
+// SthToStr
+
+template <>
+struct SthToStr_obj<bool>
+{
+	void operator () (tstring *Str, const bool &Sth)
+	{
+		common::BoolToStr(Str, Sth, 'f');
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct SthToStr_obj<tchar>
+{
+	void operator () (tstring *Str, const tchar &Sth)
+	{
+		common::CharToStr(Str, Sth);
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct SthToStr_obj<int16>
+{
+	void operator () (tstring *Str, const int16 &Sth)
+	{
+		common::IntToStr<int16>(Str, Sth);
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct SthToStr_obj<int32>
+{
+	void operator () (tstring *Str, const int32 &Sth)
+	{
+		common::IntToStr<int32>(Str, Sth);
+	}
+	static inline bool IsSupported() { return true; }
+};
+template <>
+struct SthToStr_obj<long>
+{
+	void operator () (tstring *Str, const long &Sth)
+	{
+		common::IntToStr<long>(Str, Sth);
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct SthToStr_obj<int64>
+{
+	void operator () (tstring *Str, const int64 &Sth)
+	{
+		common::IntToStr<int64>(Str, Sth);
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct SthToStr_obj<uint8>
+{
+	void operator () (tstring *Str, const uint8 &Sth)
+	{
+		common::UintToStr<uint8>(Str, Sth);
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct SthToStr_obj<uint16>
+{
+	void operator () (tstring *Str, const uint16 &Sth)
+	{
+		common::UintToStr<uint16>(Str, Sth);
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct SthToStr_obj<uint32>
+{
+	void operator () (tstring *Str, const uint32 &Sth)
+	{
+		common::UintToStr<uint32>(Str, Sth);
+	}
+	static inline bool IsSupported() { return true; }
+};
+template <>
+struct SthToStr_obj<unsigned long>
+{
+	void operator () (tstring *Str, const unsigned long &Sth)
+	{
+		common::UintToStr<unsigned long>(Str, Sth);
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct SthToStr_obj<uint64>
+{
+	void operator () (tstring *Str, const uint64 &Sth)
+	{
+		common::UintToStr<uint64>(Str, Sth);
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct SthToStr_obj<float>
+{
+	void operator () (tstring *Str, const float &Sth)
+	{
+		common::FloatToStr(Str, Sth, 'r');
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct SthToStr_obj<double>
+{
+	void operator () (tstring *Str, const double &Sth)
+	{
+		common::DoubleToStr(Str, Sth, 'r');
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct SthToStr_obj<tstring>
+{
+	void operator () (tstring *Str, const tstring &Sth)
+	{
+		*Str = Sth;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <typename T>
+struct SthToStr_obj< std::vector<T> >
+{
+	void operator () (tstring *Str, const std::vector<T> &Sth)
+	{
+		Str->clear();
+		tstring Element;
+		for (typename std::vector<T>::const_iterator it = Sth.begin(); it != Sth.end(); ++it)
+		{
+			if (!Str->empty())
+				*Str += ',';
+			SthToStr<T>(&Element, *it);
+			*Str += Element;
+		}
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct SthToStr_obj<char *>
+{
+	void operator () (tstring *Str, tchar *Sth)
+	{
+		*Str = Sth;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct SthToStr_obj<const tchar *>
+{
+	void operator () (tstring *Str, const tchar *Sth)
+	{
+		*Str = Sth;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct SthToStr_obj<void *>
+{
+	void operator () (tstring *Str, void *Sth)
+	{
+		common::PtrToStr(Str, Sth);
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct SthToStr_obj<const void *>
+{
+	void operator () (tstring *Str, const void *Sth)
+	{
+		common::PtrToStr(Str, Sth);
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+//------------------------------------------------------------------------------
+// SthToStr
+
+template <>
+struct StrToSth_obj<bool>
+{
+	bool operator () (bool *Sth, const tstring &Str)
+	{
+		return common::StrToBool(Sth, Str);
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct StrToSth_obj<tchar>
+{
+	bool operator () (tchar *Sth, const tstring &Str)
+	{
+		if (Str.length() != 1) return false;
+		*Sth = Str[0];
+		return true;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct StrToSth_obj<int16>
+{
+	bool operator () (int16 *Sth, const tstring &Str)
+	{
+		return common::StrToInt<int16>(Sth, Str.data(), Str.length(), 10) == 0;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct StrToSth_obj<int32>
+{
+	bool operator () (int32 *Sth, const tstring &Str)
+	{
+		return common::StrToInt<int32>(Sth, Str.data(), Str.length(), 10) == 0;
+	}
+	static inline bool IsSupported() { return true; }
+};
+template <>
+struct StrToSth_obj<long>
+{
+	bool operator () (long *Sth, const tstring &Str)
+	{
+		return common::StrToInt<long>(Sth, Str.data(), Str.length(), 10) == 0;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct StrToSth_obj<int64>
+{
+	bool operator () (int64 *Sth, const tstring &Str)
+	{
+		return common::StrToInt<int64>(Sth, Str.data(), Str.length(), 10) == 0;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct StrToSth_obj<uint8>
+{
+	bool operator () (uint8 *Sth, const tstring &Str)
+	{
+		return common::StrToUint<uint8>(Sth, Str.data(), Str.length(), 10) == 0;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct StrToSth_obj<uint16>
+{
+	bool operator () (uint16 *Sth, const tstring &Str)
+	{
+		return common::StrToUint<uint16>(Sth, Str.data(), Str.length(), 10) == 0;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct StrToSth_obj<uint32>
+{
+	bool operator () (uint32 *Sth, const tstring &Str)
+	{
+		return common::StrToUint<uint32>(Sth, Str.data(), Str.length(), 10) == 0;
+	}
+	static inline bool IsSupported() { return true; }
+};
+template <>
+struct StrToSth_obj<unsigned long>
+{
+	bool operator () (unsigned long *Sth, const tstring &Str)
+	{
+		return common::StrToUint<unsigned long>(Sth, Str.data(), Str.length(), 10) == 0;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct StrToSth_obj<uint64>
+{
+	bool operator () (uint64 *Sth, const tstring &Str)
+	{
+		return common::StrToUint<uint64>(Sth, Str.data(), Str.length(), 10) == 0;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct StrToSth_obj<float>
+{
+	bool operator () (float *Sth, const tstring &Str)
+	{
+		return common::StrToFloat(Sth, Str.data(), Str.length()) == 0;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct StrToSth_obj<double>
+{
+	bool operator () (double *Sth, const tstring &Str)
+	{
+		return common::StrToDouble(Sth, Str.data(), Str.length()) == 0;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct StrToSth_obj<tstring>
+{
+	bool operator () (tstring *Sth, const tstring &Str)
+	{
+		*Sth = Str;
+		return true;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <typename T>
+struct StrToSth_obj< std::vector<T> >
+{
+	bool operator () (std::vector<T> *Sth, const tstring &Str)
+	{
+		Sth->clear();
+		size_t Index = 0;
+		tstring Element;
+		T Val;
+		while (common::Split(Str, _T(","), &Element, &Index))
+		{
+			if (!StrToSth<T>(&Val, Element)) return false;
+			Sth->push_back(Val);
+		}
+		return true;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+//@}
+// code_sthtostr
+
+#endif
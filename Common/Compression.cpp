@@ -0,0 +1,725 @@
+/** \file
+\brief Generic compression codec interface and built-in fast LZ codec
+\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
+
+Part of CommonLib library. \n
+Encoding UTF-8, end of line CR+LF \n
+License: GNU LGPL. \n
+Documentation: \ref Module_Compression \n
+Module components: \ref code_compression
+*/
+#include "Base.hpp"
+#include <cstring> // for memcpy
+#include "Error.hpp"
+#include "Compression.hpp"
+
+
+namespace common
+{
+
+// Minimum match length, encoded in token as 0
+static const size_t LZ_MIN_MATCH = 4;
+// Last bytes of a block are always literals
+static const size_t LZ_LAST_LITERALS = 5;
+// Last match must start at least this many bytes before end of a block
+static const size_t LZ_MF_LIMIT = 12;
+static const size_t LZ_MAX_OFFSET = 65535;
+static const uint LZ_MAX_HASH_LOG = 16;
+static const uint LZ_MIN_HASH_LOG = 10;
+static const uint32 LZ_NO_POS = 0xFFFFFFFFu;
+
+static const char LZ_STREAM_MAGIC[4] = { 'C', 'L', 'Z', '1' };
+// Flag in compressed size of a stream block meaning the block is stored uncompressed
+static const uint32 LZ_STORED_FLAG = 0x80000000u;
+// Limit of block size, protects decoder from allocating huge buffers for corrupted headers
+static const size_t LZ_MAX_BLOCK_SIZE = 64 * 1024 * 1024;
+
+inline uint32 LzRead32(const uint8 *p)
+{
+	uint32 R;
+	memcpy(&R, p, sizeof(R));
+	return R;
+}
+
+inline uint64 LzRead64(const uint8 *p)
+{
+	uint64 R;
+	memcpy(&R, p, sizeof(R));
+	return R;
+}
+
+inline uint LzHash(uint32 Value, uint HashLog)
+{
+	return (Value * 2654435761u) >> (32 - HashLog);
+}
+
+// Returns number of equal bytes at a and b, comparing not further than a reaches Limit.
+inline size_t LzCountEqual(const uint8 *a, const uint8 *b, const uint8 *Limit)
+{
+	const uint8 *Beg = a;
+	while (a + 8 <= Limit && LzRead64(a) == LzRead64(b))
+	{
+		a += 8;
+		b += 8;
+	}
+	while (a < Limit && *a == *b)
+	{
+		a++;
+		b++;
+	}
+	return a - Beg;
+}
+
+// Writes length continuation bytes of value already reduced by 15
+inline uint8 * LzWriteLength(uint8 *Out, size_t Length)
+{
+	while (Length >= 255)
+	{
+		*Out++ = 255;
+		Length -= 255;
+	}
+	*Out++ = (uint8)Length;
+	return Out;
+}
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Klasa LzMatchFinder
+
+// Hash table of 4-byte sequences with chains of previous positions having the same hash
+class LzMatchFinder
+{
+public:
+	LzMatchFinder(const uint8 *Data, size_t DataLength, int Level);
+
+	// Adds position to the hash table and chains. Pos + 4 must not exceed data.
+	void Insert(size_t Pos);
+	// Inserts Pos and returns the longest match found, not reaching beyond Limit.
+	// Returns 0 if no match of at least LZ_MIN_MATCH bytes was found.
+	size_t InsertAndFind(size_t Pos, const uint8 *Limit, size_t *OutMatchPos);
+
+private:
+	const uint8 *m_Data;
+	uint m_HashLog;
+	size_t m_ChainMask;
+	uint m_MaxAttempts;
+	std::vector<uint32> m_HashTable;
+	// Distance to previous position with the same hash, 0 if none
+	std::vector<uint16> m_Chain;
+};
+
+LzMatchFinder::LzMatchFinder(const uint8 *Data, size_t DataLength, int Level) :
+	m_Data(Data),
+	m_HashLog(LZ_MIN_HASH_LOG)
+{
+	// Small blocks don't need to pay for clearing big tables
+	while (m_HashLog < LZ_MAX_HASH_LOG && ((size_t)1 << m_HashLog) < DataLength)
+		m_HashLog++;
+	m_HashTable.resize((size_t)1 << m_HashLog, LZ_NO_POS);
+	m_Chain.resize((size_t)1 << m_HashLog, 0);
+	m_ChainMask = m_Chain.size() - 1;
+
+	Level = minmax(LZ_FASTEST_LEVEL, Level, LZ_BEST_LEVEL);
+	m_MaxAttempts = 1u << (Level - 1);
+}
+
+void LzMatchFinder::Insert(size_t Pos)
+{
+	uint h = LzHash(LzRead32(m_Data + Pos), m_HashLog);
+	uint32 Prev = m_HashTable[h];
+	size_t Delta = Pos - Prev;
+	m_Chain[Pos & m_ChainMask] = (Prev != LZ_NO_POS && Delta <= LZ_MAX_OFFSET && Delta <= m_ChainMask) ? (uint16)Delta : 0;
+	m_HashTable[h] = (uint32)Pos;
+}
+
+size_t LzMatchFinder::InsertAndFind(size_t Pos, const uint8 *Limit, size_t *OutMatchPos)
+{
+	const uint8 *Cur = m_Data + Pos;
+	uint32 CurValue = LzRead32(Cur);
+	uint h = LzHash(CurValue, m_HashLog);
+	uint32 Cand = m_HashTable[h];
+
+	size_t Delta = Pos - Cand;
+	m_Chain[Pos & m_ChainMask] = (Cand != LZ_NO_POS && Delta <= LZ_MAX_OFFSET && Delta <= m_ChainMask) ? (uint16)Delta : 0;
+	m_HashTable[h] = (uint32)Pos;
+
+	size_t BestLength = 0;
+	for (uint Attempt = 0; Attempt < m_MaxAttempts; Attempt++)
+	{
+		if (Cand == LZ_NO_POS || Pos - Cand > LZ_MAX_OFFSET)
+			break;
+		const uint8 *Match = m_Data + Cand;
+		// Checking byte at current best length first rejects most candidates quickly
+		if (Cur + BestLength < Limit && Match[BestLength] == Cur[BestLength] && LzRead32(Match) == CurValue)
+		{
+			size_t Length = LZ_MIN_MATCH + LzCountEqual(Cur + LZ_MIN_MATCH, Match + LZ_MIN_MATCH, Limit);
+			if (Length > BestLength)
+			{
+				BestLength = Length;
+				*OutMatchPos = Cand;
+				if (Cur + Length >= Limit)
+					break;
+			}
+		}
+		// Entries of positions skipped at fastest level may be stale - they only cost a failed comparison
+		uint16 ChainDelta = m_Chain[Cand & m_ChainMask];
+		if (ChainDelta == 0 || ChainDelta > Cand)
+			break;
+		Cand -= ChainDelta;
+	}
+	return BestLength >= LZ_MIN_MATCH ? BestLength : 0;
+}
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Klasa LzCompressor
+
+size_t LzCompressor::CompressLength(size_t DataLength)
+{
+	return DataLength + DataLength / 255 + 16;
+}
+
+size_t LzCompressor::Compress(void *OutData, size_t BufLength, const void *Data, size_t DataLength, int Level)
+{
+	if (DataLength >= 0xFFFFFFFFu)
+		throw Error(_T("Data too long for LZ compression."), __TFILE__, __LINE__);
+
+	const uint8 *Src = (const uint8*)Data;
+	uint8 *Out = (uint8*)OutData;
+	uint8 *OutEnd = Out + BufLength;
+
+	size_t Anchor = 0;
+	if (DataLength > LZ_MF_LIMIT)
+	{
+		LzMatchFinder Finder(Src, DataLength, Level);
+		bool InsertAll = (Level > LZ_FASTEST_LEVEL);
+		size_t MatchFindLimit = DataLength - LZ_MF_LIMIT;
+		const uint8 *MatchLimit = Src + DataLength - LZ_LAST_LITERALS;
+		size_t Pos = 0;
+		uint Misses = 0;
+
+		while (Pos < MatchFindLimit)
+		{
+			size_t MatchPos;
+			size_t MatchLength = Finder.InsertAndFind(Pos, MatchLimit, &MatchPos);
+			if (MatchLength == 0)
+			{
+				// Skip faster through data which doesn't compress
+				Pos += 1 + (InsertAll ? 0 : (Misses++ >> 6));
+				continue;
+			}
+			Misses = 0;
+
+			// Extend match backwards
+			while (Pos > Anchor && MatchPos > 0 && Src[Pos-1] == Src[MatchPos-1])
+			{
+				Pos--;
+				MatchPos--;
+				MatchLength++;
+			}
+
+			size_t LiteralLength = Pos - Anchor;
+			size_t Required = 1 + LiteralLength/255 + 1 + LiteralLength + 2 + MatchLength/255 + 1;
+			if ((size_t)(OutEnd - Out) < Required)
+				throw Error(_T("LZ compression buffer too small."), __TFILE__, __LINE__);
+
+			uint8 *Token = Out++;
+			if (LiteralLength >= 15)
+			{
+				*Token = 15 << 4;
+				Out = LzWriteLength(Out, LiteralLength - 15);
+			}
+			else
+				*Token = (uint8)(LiteralLength << 4);
+			memcpy(Out, Src + Anchor, LiteralLength);
+			Out += LiteralLength;
+
+			size_t Offset = Pos - MatchPos;
+			*Out++ = (uint8)(Offset & 0xFF);
+			*Out++ = (uint8)(Offset >> 8);
+
+			size_t EncodedLength = MatchLength - LZ_MIN_MATCH;
+			if (EncodedLength >= 15)
+			{
+				*Token |= 15;
+				Out = LzWriteLength(Out, EncodedLength - 15);
+			}
+			else
+				*Token |= (uint8)EncodedLength;
+
+			size_t MatchEnd = Pos + MatchLength;
+			if (InsertAll)
+			{
+				size_t InsertEnd = std::min(MatchEnd, MatchFindLimit);
+				for (size_t i = Pos + 1; i < InsertEnd; i++)
+					Finder.Insert(i);
+			}
+			else if (MatchEnd - 2 < MatchFindLimit)
+				Finder.Insert(MatchEnd - 2);
+			Pos = Anchor = MatchEnd;
+		}
+	}
+
+	// Last literals
+	size_t LiteralLength = DataLength - Anchor;
+	if ((size_t)(OutEnd - Out) < 1 + LiteralLength/255 + 1 + LiteralLength)
+		throw Error(_T("LZ compression buffer too small."), __TFILE__, __LINE__);
+	if (LiteralLength >= 15)
+	{
+		*Out++ = 15 << 4;
+		Out = LzWriteLength(Out, LiteralLength - 15);
+	}
+	else
+		*Out++ = (uint8)(LiteralLength << 4);
+	if (LiteralLength > 0)
+	{
+		memcpy(Out, Src + Anchor, LiteralLength);
+		Out += LiteralLength;
+	}
+
+	return Out - (uint8*)OutData;
+}
+
+size_t LzCompressor::Decompress(void *OutData, size_t BufLength, const void *Data, size_t DataLength)
+{
+	const uint8 *In = (const uint8*)Data;
+	const uint8 *InEnd = In + DataLength;
+	uint8 *Out = (uint8*)OutData;
+	uint8 *OutEnd = Out + BufLength;
+
+	for (;;)
+	{
+		if (In == InEnd)
+			throw Error(_T("LZ data truncated."), __TFILE__, __LINE__);
+		uint Token = *In++;
+
+		// Literals
+		size_t Length = Token >> 4;
+		if (Length == 15)
+		{
+			uint b;
+			do
+			{
+				if (In == InEnd)
+					throw Error(_T("LZ data truncated."), __TFILE__, __LINE__);
+				b = *In++;
+				Length += b;
+			}
+			while (b == 255);
+		}
+		if (Length > (size_t)(InEnd - In) || Length > (size_t)(OutEnd - Out))
+			throw Error(_T("LZ data corrupted - literals out of bounds."), __TFILE__, __LINE__);
+		// Short literals are copied with one fixed-size move when buffers have room for it
+		if (Length <= 16 && InEnd - In >= 16 && OutEnd - Out >= 16)
+			memcpy(Out, In, 16);
+		else if (Length > 0)
+			memcpy(Out, In, Length);
+		In += Length;
+		Out += Length;
+
+		// Last sequence has no match
+		if (In == InEnd)
+			break;
+
+		// Match
+		if (InEnd - In < 2)
+			throw Error(_T("LZ data truncated."), __TFILE__, __LINE__);
+		size_t Offset = In[0] | ((size_t)In[1] << 8);
+		In += 2;
+		if (Offset == 0 || Offset > (size_t)(Out - (uint8*)OutData))
+			throw Error(_T("LZ data corrupted - invalid match offset."), __TFILE__, __LINE__);
+
+		Length = Token & 15;
+		if (Length == 15)
+		{
+			uint b;
+			do
+			{
+				if (In == InEnd)
+					throw Error(_T("LZ data truncated."), __TFILE__, __LINE__);
+				b = *In++;
+				Length += b;
+			}
+			while (b == 255);
+		}
+		Length += LZ_MIN_MATCH;
+		if (Length > (size_t)(OutEnd - Out))
+			throw Error(_T("LZ data corrupted - match out of bounds."), __TFILE__, __LINE__);
+
+		const uint8 *Match = Out - Offset;
+		if (Offset >= 8 && (size_t)(OutEnd - Out) >= Length + 8)
+		{
+			// Source is always at least 8 bytes behind, so 8-byte moves see already written data
+			uint8 *CopyEnd = Out + Length;
+			do
+			{
+				memcpy(Out, Match, 8);
+				Out += 8;
+				Match += 8;
+			}
+			while (Out < CopyEnd);
+			Out = CopyEnd;
+		}
+		else if (Offset == 1)
+		{
+			memset(Out, *Match, Length);
+			Out += Length;
+		}
+		else
+		{
+			for (size_t i = 0; i < Length; i++)
+				Out[i] = Match[i];
+			Out += Length;
+		}
+	}
+
+	return Out - (uint8*)OutData;
+}
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Klasa LzCompressionStream_pimpl
+
+class LzCompressionStream_pimpl
+{
+public:
+	Stream *m_Stream;
+	int m_Level;
+	size_t m_BlockSize;
+	std::vector<uint8> m_In;
+	size_t m_InLength;
+	std::vector<uint8> m_Out;
+	bool m_HeaderWritten;
+	bool m_Finished;
+
+	LzCompressionStream_pimpl(Stream *a_Stream, int Level, size_t BlockSize);
+
+	void Write(const void *Data, size_t Size);
+	void Flush();
+	void Finish();
+
+private:
+	void WriteBlock(const uint8 *Data, size_t Length);
+};
+
+LzCompressionStream_pimpl::LzCompressionStream_pimpl(Stream *a_Stream, int Level, size_t BlockSize) :
+	m_Stream(a_Stream),
+	m_Level(Level),
+	m_BlockSize(BlockSize),
+	m_InLength(0),
+	m_HeaderWritten(false),
+	m_Finished(false)
+{
+	if (BlockSize == 0 || BlockSize > LZ_MAX_BLOCK_SIZE)
+		throw Error(Format(_T("Invalid LZ block size: #.")) % BlockSize, __TFILE__, __LINE__);
+}
+
+void LzCompressionStream_pimpl::WriteBlock(const uint8 *Data, size_t Length)
+{
+	if (!m_HeaderWritten)
+	{
+		m_Stream->Write(LZ_STREAM_MAGIC, sizeof(LZ_STREAM_MAGIC));
+		m_HeaderWritten = true;
+	}
+	if (Length == 0)
+		return;
+
+	m_Out.resize(LzCompressor::CompressLength(m_BlockSize));
+	size_t CompressedLength = LzCompressor::Compress(&m_Out[0], m_Out.size(), Data, Length, m_Level);
+
+	uint32 Header[2];
+	Header[0] = (uint32)Length;
+	if (CompressedLength < Length)
+	{
+		Header[1] = (uint32)CompressedLength;
+		m_Stream->Write(Header, sizeof(Header));
+		m_Stream->Write(&m_Out[0], CompressedLength);
+	}
+	else
+	{
+		Header[1] = (uint32)Length | LZ_STORED_FLAG;
+		m_Stream->Write(Header, sizeof(Header));
+		m_Stream->Write(Data, Length);
+	}
+}
+
+void LzCompressionStream_pimpl::Write(const void *Data, size_t Size)
+{
+	if (m_Finished)
+		throw Error(_T("Cannot write to finished LzCompressionStream."), __TFILE__, __LINE__);
+
+	const uint8 *Src = (const uint8*)Data;
+	// Whole blocks are compressed straight from caller's data
+	if (m_InLength == 0)
+	{
+		while (Size >= m_BlockSize)
+		{
+			WriteBlock(Src, m_BlockSize);
+			Src += m_BlockSize;
+			Size -= m_BlockSize;
+		}
+	}
+	while (Size > 0)
+	{
+		if (m_In.empty())
+			m_In.resize(m_BlockSize);
+		size_t ToCopy = std::min(Size, m_BlockSize - m_InLength);
+		memcpy(&m_In[m_InLength], Src, ToCopy);
+		m_InLength += ToCopy;
+		Src += ToCopy;
+		Size -= ToCopy;
+		if (m_InLength == m_BlockSize)
+		{
+			WriteBlock(&m_In[0], m_InLength);
+			m_InLength = 0;
+		}
+	}
+}
+
+void LzCompressionStream_pimpl::Flush()
+{
+	if (m_Finished)
+		return;
+	if (m_InLength > 0)
+	{
+		WriteBlock(&m_In[0], m_InLength);
+		m_InLength = 0;
+	}
+	m_Stream->Flush();
+}
+
+void LzCompressionStream_pimpl::Finish()
+{
+	if (m_Finished)
+		return;
+	if (m_InLength > 0)
+		WriteBlock(&m_In[0], m_InLength);
+	else
+		WriteBlock(NULL, 0);
+	m_InLength = 0;
+	uint32 EndMarker = 0;
+	m_Stream->WriteEx(EndMarker);
+	m_Finished = true;
+}
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Klasa LzCompressionStream
+
+LzCompressionStream::LzCompressionStream(Stream *a_Stream, int Level, size_t BlockSize) :
+	OverlayStream(a_Stream),
+	pimpl(new LzCompressionStream_pimpl(a_Stream, Level, BlockSize))
+{
+}
+
+LzCompressionStream::~LzCompressionStream()
+{
+	try
+	{
+		pimpl->Finish();
+	}
+	catch (...)
+	{
+		assert(0 && "LzCompressionStream.dtor - exception.");
+	}
+}
+
+void LzCompressionStream::Write(const void *Data, size_t Size)
+{
+	pimpl->Write(Data, Size);
+}
+
+void LzCompressionStream::Flush()
+{
+	pimpl->Flush();
+}
+
+void LzCompressionStream::Finish()
+{
+	pimpl->Finish();
+}
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Klasa LzDecompressionStream_pimpl
+
+class LzDecompressionStream_pimpl
+{
+public:
+	Stream *m_Stream;
+	bool m_HeaderRead;
+	bool m_End;
+	std::vector<uint8> m_In;
+	std::vector<uint8> m_Out;
+	size_t m_OutBeg;
+	size_t m_OutEnd;
+
+	LzDecompressionStream_pimpl(Stream *a_Stream);
+
+	size_t Read(void *Out, size_t MaxLength);
+	bool End();
+
+private:
+	// Reads header of the next block. Returns its uncompressed length or 0 at the end.
+	size_t ReadBlockHeader(uint32 *OutCompressedLength);
+	// Reads and decompresses block data to Out
+	void ReadBlockData(void *Out, size_t Length, uint32 CompressedLength);
+};
+
+LzDecompressionStream_pimpl::LzDecompressionStream_pimpl(Stream *a_Stream) :
+	m_Stream(a_Stream),
+	m_HeaderRead(false),
+	m_End(false),
+	m_OutBeg(0),
+	m_OutEnd(0)
+{
+}
+
+size_t LzDecompressionStream_pimpl::ReadBlockHeader(uint32 *OutCompressedLength)
+{
+	if (!m_HeaderRead)
+	{
+		char Magic[4];
+		m_Stream->MustRead(Magic, sizeof(Magic));
+		if (memcmp(Magic, LZ_STREAM_MAGIC, sizeof(Magic)) != 0)
+			throw Error(_T("Invalid LZ stream header."), __TFILE__, __LINE__);
+		m_HeaderRead = true;
+	}
+
+	uint32 Length;
+	m_Stream->ReadEx(&Length);
+	if (Length == 0)
+	{
+		m_End = true;
+		return 0;
+	}
+	m_Stream->ReadEx(OutCompressedLength);
+
+	uint32 CompressedLength = *OutCompressedLength & ~LZ_STORED_FLAG;
+	if (Length > LZ_MAX_BLOCK_SIZE ||
+		((*OutCompressedLength & LZ_STORED_FLAG) ? CompressedLength != Length : CompressedLength >= Length))
+	{
+		throw Error(_T("LZ stream corrupted - invalid block header."), __TFILE__, __LINE__);
+	}
+	return Length;
+}
+
+void LzDecompressionStream_pimpl::ReadBlockData(void *Out, size_t Length, uint32 CompressedLength)
+{
+	if (CompressedLength & LZ_STORED_FLAG)
+	{
+		m_Stream->MustRead(Out, Length);
+		return;
+	}
+
+	m_In.resize(CompressedLength);
+	m_Stream->MustRead(&m_In[0], CompressedLength);
+	if (LzCompressor::Decompress(Out, Length, &m_In[0], CompressedLength) != Length)
+		throw Error(_T("LZ stream corrupted - invalid block length."), __TFILE__, __LINE__);
+}
+
+size_t LzDecompressionStream_pimpl::Read(void *Out, size_t MaxLength)
+{
+	uint8 *Dst = (uint8*)Out;
+	size_t Sum = 0;
+	while (Sum < MaxLength)
+	{
+		if (m_OutBeg < m_OutEnd)
+		{
+			size_t ToCopy = std::min(MaxLength - Sum, m_OutEnd - m_OutBeg);
+			memcpy(Dst + Sum, &m_Out[m_OutBeg], ToCopy);
+			m_OutBeg += ToCopy;
+			Sum += ToCopy;
+			continue;
+		}
+		if (m_End)
+			break;
+
+		uint32 CompressedLength;
+		size_t Length = ReadBlockHeader(&CompressedLength);
+		if (Length == 0)
+			break;
+		// Whole block fits - decompress straight to caller's buffer
+		if (Length <= MaxLength - Sum)
+		{
+			ReadBlockData(Dst + Sum, Length, CompressedLength);
+			Sum += Length;
+		}
+		else
+		{
+			if (m_Out.size() < Length)
+				m_Out.resize(Length);
+			ReadBlockData(&m_Out[0], Length, CompressedLength);
+			m_OutBeg = 0;
+			m_OutEnd = Length;
+		}
+	}
+	return Sum;
+}
+
+bool LzDecompressionStream_pimpl::End()
+{
+	if (m_OutBeg < m_OutEnd)
+		return false;
+	if (m_End)
+		return true;
+	uint32 CompressedLength;
+	size_t Length = ReadBlockHeader(&CompressedLength);
+	if (Length == 0)
+		return true;
+	if (m_Out.size() < Length)
+		m_Out.resize(Length);
+	ReadBlockData(&m_Out[0], Length, CompressedLength);
+	m_OutBeg = 0;
+	m_OutEnd = Length;
+	return false;
+}
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Klasa LzDecompressionStream
+
+LzDecompressionStream::LzDecompressionStream(Stream *a_Stream) :
+	OverlayStream(a_Stream),
+	pimpl(new LzDecompressionStream_pimpl(a_Stream))
+{
+}
+
+LzDecompressionStream::~LzDecompressionStream()
+{
+	pimpl.reset();
+}
+
+size_t LzDecompressionStream::Read(void *Out, size_t MaxLength)
+{
+	return pimpl->Read(Out, MaxLength);
+}
+
+bool LzDecompressionStream::End()
+{
+	return pimpl->End();
+}
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Klasa LzCodec
+
+OverlayStream * LzCodec::CreateEncoder(Stream *a_Stream)
+{
+	return new LzCompressionStream(a_Stream, m_Level, m_BlockSize);
+}
+
+OverlayStream * LzCodec::CreateDecoder(Stream *a_Stream)
+{
+	return new LzDecompressionStream(a_Stream);
+}
+
+size_t LzCodec::CompressLength(size_t DataLength)
+{
+	return LzCompressor::CompressLength(DataLength);
+}
+
+size_t LzCodec::Compress(void *OutData, size_t BufLength, const void *Data, size_t DataLength)
+{
+	return LzCompressor::Compress(OutData, BufLength, Data, DataLength, m_Level);
+}
+
+size_t LzCodec::Decompress(void *OutData, size_t BufLength, const void *Data, size_t DataLength)
+{
+	return LzCompressor::Decompress(OutData, BufLength, Data, DataLength);
+}
+
+} // namespace common
@@ -0,0 +1,180 @@
+/** \file
+\brief Generic compression codec interface and built-in fast LZ codec
+\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
+
+Part of CommonLib library. \n
+Encoding UTF-8, end of line CR+LF \n
+License: GNU LGPL. \n
+Documentation: \ref Module_Compression \n
+Module components: \ref code_compression
+*/
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+#pragma once
+#endif
+#ifndef COMMON_COMPRESSION_H_
+#define COMMON_COMPRESSION_H_
+
+#include "Stream.hpp"
+
+namespace common
+{
+
+/** \addtogroup code_compression Compression Module
+Dokumentacja: \ref Module_Compression \n
+Nagłówek: Compression.hpp */
+//@{
+
+/// Abstract compression algorithm, usable through streams or on whole memory blocks.
+/**
+Code which only stores and loads data can take CompressionCodec * and stay independent
+of the actual algorithm. Implemented by LzCodec (this module) and ZlibCodec (ZlibUtils module).
+
+Streams returned by CreateEncoder and CreateDecoder must be deleted by the caller.
+Encoder writes its final data in the destructor. Block functions may use internal state
+of the codec object, so one object shouldn't be used for them on many threads at once.
+*/
+class CompressionCodec
+{
+public:
+	virtual ~CompressionCodec() { }
+
+	/// Returns short name of the algorithm, like "lz" or "zlib".
+	virtual const tchar * GetName() = 0;
+
+	/// Creates write-only stream compressing data into a_Stream.
+	virtual OverlayStream * CreateEncoder(Stream *a_Stream) = 0;
+	/// Creates read-only stream decompressing data read from a_Stream.
+	virtual OverlayStream * CreateDecoder(Stream *a_Stream) = 0;
+
+	/// Returns maximum compressed size of a block of given length.
+	virtual size_t CompressLength(size_t DataLength) = 0;
+	/// Compresses a block of data.
+	/**
+	\return Length of compressed data.
+	\param BufLength Size of OutData. If too small, Error is thrown - use CompressLength to be sure.
+	*/
+	virtual size_t Compress(void *OutData, size_t BufLength, const void *Data, size_t DataLength) = 0;
+	/// Decompresses a block of data compressed with Compress.
+	/**
+	Uncompressed size must be stored somewhere by the caller.
+	\return Length of decompressed data.
+	\param BufLength Size of OutData. If decompressed data doesn't fit or input is corrupted, Error is thrown.
+	*/
+	virtual size_t Decompress(void *OutData, size_t BufLength, const void *Data, size_t DataLength) = 0;
+};
+
+/** \name Poziomy kompresji LZ. */
+//@{
+/// Only one match candidate is checked - fastest compression.
+const int LZ_FASTEST_LEVEL = 1;
+/// Default compression level.
+const int LZ_DEFAULT_LEVEL = 4;
+/// Longest hash chains searched - best ratio, still decompressed at the same speed.
+const int LZ_BEST_LEVEL    = 9;
+//@}
+
+/// Fast LZ77 compression of memory blocks.
+/**
+Byte-aligned format of the LZ4 block kind: a sequence consists of a token byte
+(literal count and match length, 4 bits each, extended by following 255-bytes),
+literals copied verbatim and 2-byte little-endian match offset. Window is 64 KB.
+Decompression is just copying memory, so it is many times faster than inflate,
+at the cost of worse compression ratio.
+
+Matches are found in a hash table of 4-byte sequences with chains of previous
+positions. Level says how many chain entries are checked.
+Decompression validates all offsets and lengths, so corrupted data causes Error,
+never a read or write outside the buffers.
+*/
+class LzCompressor
+{
+public:
+	/// Returns maximum compressed size of a block of given length.
+	static size_t CompressLength(size_t DataLength);
+	/// Compresses a block.
+	/**
+	\return Length of compressed data.
+	\param BufLength Size of OutData. If too small, Error is thrown - use CompressLength to be sure.
+	*/
+	static size_t Compress(void *OutData, size_t BufLength, const void *Data, size_t DataLength, int Level = LZ_DEFAULT_LEVEL);
+	/// Decompresses a block.
+	/**
+	\return Length of decompressed data.
+	\param BufLength Size of OutData. If decompressed data doesn't fit or input is corrupted, Error is thrown.
+	*/
+	static size_t Decompress(void *OutData, size_t BufLength, const void *Data, size_t DataLength);
+};
+
+/// \internal
+class LzCompressionStream_pimpl;
+/// \internal
+class LzDecompressionStream_pimpl;
+
+/// Write-only stream compressing data with LzCompressor.
+/**
+Data is buffered and compressed in independent blocks, each preceded by a header with
+compressed and uncompressed size. Block that doesn't compress is stored as is.
+End marker is written by Finish(), or by the destructor if Finish() was not called.
+*/
+class LzCompressionStream : public OverlayStream
+{
+private:
+	scoped_ptr<LzCompressionStream_pimpl> pimpl;
+
+public:
+	/// Default uncompressed size of a single block - 256 KB.
+	static const size_t DEFAULT_BLOCK_SIZE = 256 * 1024;
+
+	LzCompressionStream(Stream *a_Stream, int Level = LZ_DEFAULT_LEVEL, size_t BlockSize = DEFAULT_BLOCK_SIZE);
+	virtual ~LzCompressionStream();
+
+	// ======== Implementacja Stream ========
+
+	virtual void Write(const void *Data, size_t Size);
+	/** Compresses pending data as a shorter block. */
+	virtual void Flush();
+
+	/// Writes pending data and end marker. Nothing can be written after that.
+	void Finish();
+};
+
+/// Read-only stream decompressing data written by LzCompressionStream.
+class LzDecompressionStream : public OverlayStream
+{
+private:
+	scoped_ptr<LzDecompressionStream_pimpl> pimpl;
+
+public:
+	LzDecompressionStream(Stream *a_Stream);
+	virtual ~LzDecompressionStream();
+
+	// ======== Implementacja Stream ========
+
+	virtual size_t Read(void *Out, size_t MaxLength);
+	virtual bool End();
+};
+
+/// CompressionCodec using LzCompressor, LzCompressionStream and LzDecompressionStream.
+class LzCodec : public CompressionCodec
+{
+private:
+	int m_Level;
+	size_t m_BlockSize;
+
+public:
+	LzCodec(int Level = LZ_DEFAULT_LEVEL, size_t BlockSize = LzCompressionStream::DEFAULT_BLOCK_SIZE) : m_Level(Level), m_BlockSize(BlockSize) { }
+
+	virtual const tchar * GetName() { return _T("lz"); }
+	virtual OverlayStream * CreateEncoder(Stream *a_Stream);
+	virtual OverlayStream * CreateDecoder(Stream *a_Stream);
+	virtual size_t CompressLength(size_t DataLength);
+	virtual size_t Compress(void *OutData, size_t BufLength, const void *Data, size_t DataLength);
+	virtual size_t Decompress(void *OutData, size_t BufLength, const void *Data, size_t DataLength);
+};
+
+//@}
+// code_compression
+
+} // namespace common
+
+#endif
@@ -1,217 +1,217 @@
-/** \file
-\brief Exception classes for error handling
-\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
-
-Part of CommonLib library. \n
-Encoding UTF-8, end of line CR+LF \n
-License: GNU LGPL. \n
-Documentation: \ref Module_Error \n
-Module components: \ref code_error
-*/
-#if defined(_MSC_VER) && (_MSC_VER >= 1200)
-#pragma once
-#endif
-#ifndef COMMON_ERROR_H_
-#define COMMON_ERROR_H_
-
-#ifdef _WIN32
-	#include <windows.h>
-#endif
-#ifdef USE_DIRECTX
-	struct ID3DXBuffer;
-#endif
-
-namespace common
-{
-
-/** \addtogroup code_error Error Module
-Dokumentacja: \ref Module_Error \n
-Nagwek: Error.hpp */
-//@{
-
-/// Klasa bazowa bdw
-class Error
-{
-private:
-	std::vector<tstring> m_Msgs;
-
-protected:
-	/// Uyj tego konstruktora, jeli musisz najpierw co policzy, a dopiero potem utworzy komunikat o bdzie.
-	Error() { }
-
-public:
-	/// Dodaje komunikat na stos.
-	/** \param file uyj __TFILE__
-	\param line uyj __LINE__ */
-	void Push(const tstring &msg, const tstring &file = _T(""), int line = 0);
-	/// Zwraca peny opis bdu w jednym acuchu
-	/** \param Indent acuch od ktrego ma si zaczyna kady komunikat (wcicie).
-	\param EOL acuch oddzielajcy komunikaty (koniec wiersza). Nie doczany na kocu. */
-	void GetMessage_(tstring *Msg, const tstring &Indent = _T(""), const tstring &eol = EOL) const;
-
-	/// Utworzenie oglnego bdu
-	Error(const tstring &msg, const tstring &file = _T(""), int line = 0)
-	{
-		Push(msg, file, line);
-	}
-};
-
-/// Wyjtek utworzony z systemowego bdu errno
-class ErrnoError : public Error
-{
-public:
-	/// Tworzy bd z podanym kodem.
-	ErrnoError(int err_code, const tstring &msg, const tstring &file = _T(""), int line = 0);
-	/// Tworzy bd z kodem pobieranym ze zmiennej errno.
-	ErrnoError(const tstring &msg, const tstring &file = _T(""), int line = 0);
-};
-
-#ifdef USE_SDL
-	/// Wyjtek z bdem pobranym z biblioteki SDL za pomoc SDLError
-	class SDLError : public Error
-	{
-	public:
-		SDLError(const tstring &msg, const tstring &file = _T(""), int line = 0);
-	};
-#endif
-
-#ifdef USE_OPENGL
-	/// Wyjtek z bdem pobranym z biblioteki OpenGL za pomoc OpenGLError
-	class OpenGLError : public Error
-	{
-	public:
-		OpenGLError(const tstring &msg, const tstring &file = _T(""), int line = 0);
-	};
-#endif
-
-#ifdef USE_FMOD
-	/// Wyjtek z bdem pobranym z biblioteki dwikowej FMOD
-	class FmodError : public Error
-	{
-	private:
-		/** \param[out] Enum Moe by NULL.
-		\param[out] Message Moe by NULL. */
-		void CodeToMessage(FMOD_RESULT code, tstring *Enum, tstring *Message);
-
-	public:
-		FmodError(FMOD_RESULT code, const tstring &msg, const tstring &file = _T(""), int line = 0);
-	};
-#endif
-
-#ifdef _WIN32
-	/// Tworzy wyjtek na podstawie bdu WinAPI pobieranego za pomoc GetLastError
-	class Win32Error : public Error
-	{
-	public:
-		Win32Error(const tstring &msg = _T(""), const tstring &file = _T(""), int line = 0);
-	};
-#endif
-
-#ifdef USE_DIRECTX
-	/// Tworzy wyjtek na podstawie bdu biblioteki Direct3D.
-	class DirectXError : public Error
-	{
-	public:
-		DirectXError(HRESULT hr, const tstring &Msg = _T(""), const tstring &file = _T(""), int Line = 0);
-		/// Uyj tej wersji jeli funkcja DX ktr kontroluje zwraca te w przypadku bdu bufor z komunikatem
-		/** Bufor zostanie przez konstruktor tego wyjtku sam zwolniony, jeli istnia. Moe nie istnie. */
-		DirectXError(HRESULT hr, ID3DXBuffer *Buf, const tstring &Msg = _T(""), const tstring &file = _T(""), int Line = 0);
-	};
-#endif
-
-#ifdef USE_WINSOCK
-	/// Tworzy wyjtek na podstawie bdu biblioteki WinSock.
-	class WinSockError : public Error
-	{
-	private:
-		void CodeToStr(int Code, tstring *Name, tstring *Message);
-
-	public:
-		/// Tworzy komunikat bdu WinSockError
-		int WinSockError(int Code, const tstring &Msg = "", const tstring &file = _T(""), int Line = 0);
-		/// Tworzy komunikat bdu WinSockError, pobiera kod sam z WSAGetLastError()
-		int WinSockError(const tstring &Msg = "", const tstring &file = _T(""), int Line = 0);
-	};
-#endif
-
-#ifdef USE_DEVIL
-	/// Tworzy wyjtek na podstawie bdu biblioteki graficznej DevIL
-	/* Poniewa nie sposb niestety w DevIL sprawdzi czy jest bd bez zdjcia jednego
-	kodu bdu ze szczytu stosu, naley wywoa ILenum code = ilGetError() i jeli
-	code != IL_NO_ERROR, to wtedy rzuci ten wyjtek podajc jako pierwszy parametr code.
-	*/
-	class DevILError : public Error
-	{
-	public:
-		DevILError(unsigned FirstCode, const tstring &Msg = "", const tstring &File = _T(""), int Line = 0);
-	};
-#endif
-
-#ifdef USE_AVI_FILE
-	/// Tworzy wyjtek na podstawie bdu biblioteki AviFile (cz WinAPI)
-	class AVIFileError : public Error
-	{
-	public:
-		AVIFileError(HRESULT hr, const tstring &Msg = "", const tstring &file = _T(""), int a_Line = 0);
-	};
-#endif
-
-//@}
-// code_error
-
-} // namespace common
-
-/** \addtogroup code_error */
-//@{
-
-/// Uyj aby doda komunikat do stosu wyjtku
-#define ERR_ADD_FUNC(exception) { (exception).Push(__TFUNCSIG__, __TFILE__, __LINE__); }
-#define ERR_TRY        { try {
-#define ERR_CATCH(msg) } catch(common::Error &e) { e.Push((msg), __TFILE__, __LINE__); throw; } }
-#define ERR_CATCH_FUNC } catch(common::Error &e) { ERR_ADD_FUNC(e); throw; } }
-
-#define ERR_GUARD_BOOL(Expr) { if ((Expr) == false) throw common::Error(_T(#Expr), __TFILE__, __LINE__); }
-#define ERR_GUARD_DIRECTX(Expr) { HRESULT hr; if (FAILED(hr = (Expr))) throw common::DirectXError(hr, _T(#Expr), __TFILE__, __LINE__); }
-#define ERR_GUARD_DEVIL(Code) { { Code ; } ILenum c = ilGetError(); if (c != IL_NO_ERROR) throw common::DevILError(c, _T(#Code), __TFILE__, __LINE__); }
-
-#ifdef _DEBUG
-	#define ERR_GUARD_BOOL_D(Expr) ERR_GUARD_BOOL(Expr)
-	#define ERR_GUARD_DIRECTX_D(Expr) ERR_GUARD_DIRECTX(Expr)
-#else
-	#define ERR_GUARD_BOOL_D(Expr) (Expr);
-	#define ERR_GUARD_DIRECTX_D(Expr) (Expr);
-#endif
-
-/// Makra, ktre przerabiaj kady rodzaj wyjtku na wyjtek common::Error
-#define ALL_EXCEPTIONS_TRY   try {
-/// Makra, ktre przerabiaj kady rodzaj wyjtku na wyjtek common::Error
-#define ALL_EXCEPTIONS_CATCH   \
-	} \
-	catch (const common::Error&) \
-	{ \
-		throw; \
-	} \
-	catch (const std::exception &stde) \
-	{ \
-		throw common::Error(tstring(_T("std::exception: ")) + common::StringToTstringR(stde.what()), __TFILE__, __LINE__); \
-	} \
-	catch (...) \
-	{ \
-		throw common::Error(_T("Unknown exception."), __TFILE__, __LINE__); \
-	}
-
-//@}
-// code_error
-
-/// Rozszerzenie moduu bazowego o wsparcie dla bdw
-/**
-\ingroup code_sthtostr
-\ingroup code_error */
-template <typename T>
-inline void MustStrToSth(T *Sth, const tstring &Str)
-{
-	if (!StrToSth<T>(Sth, Str))
-		throw common::Error(_T("String conversion error: ") + Str);
-}
-
-#endif
+/** \file
+\brief Exception classes for error handling
+\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
+
+Part of CommonLib library. \n
+Encoding UTF-8, end of line CR+LF \n
+License: GNU LGPL. \n
+Documentation: \ref Module_Error \n
+Module components: \ref code_error
+*/
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+#pragma once
+#endif
+#ifndef COMMON_ERROR_H_
+#define COMMON_ERROR_H_
+
+#ifdef _WIN32
+	#include <windows.h>
+#endif
+#ifdef USE_DIRECTX
+	struct ID3DXBuffer;
+#endif
+
+namespace common
+{
+
+/** \addtogroup code_error Error Module
+Dokumentacja: \ref Module_Error \n
+Nagłówek: Error.hpp */
+//@{
+
+/// Klasa bazowa błędów
+class Error
+{
+private:
+	std::vector<tstring> m_Msgs;
+
+protected:
+	/// Użyj tego konstruktora, jeśli musisz najpierw coś policzyć, a dopiero potem utworzyć komunikat o błędzie.
+	Error() { }
+
+public:
+	/// Dodaje komunikat na stos.
+	/** \param file użyj __TFILE__
+	\param line użyj __LINE__ */
+	void Push(const tstring &msg, const tstring &file = _T(""), int line = 0);
+	/// Zwraca pełny opis błędu w jednym łańcuchu
+	/** \param Indent Łańcuch od którego ma się zaczynać każdy komunikat (wcięcie).
+	\param EOL Łańcuch oddzielający komunikaty (koniec wiersza). Nie dołączany na końcu. */
+	void GetMessage_(tstring *Msg, const tstring &Indent = _T(""), const tstring &eol = EOL) const;
+
+	/// Utworzenie ogólnego błędu
+	Error(const tstring &msg, const tstring &file = _T(""), int line = 0)
+	{
+		Push(msg, file, line);
+	}
+};
+
+/// Wyjątek utworzony z systemowego błędu errno
+class ErrnoError : public Error
+{
+public:
+	/// Tworzy błąd z podanym kodem.
+	ErrnoError(int err_code, const tstring &msg, const tstring &file = _T(""), int line = 0);
+	/// Tworzy błąd z kodem pobieranym ze zmiennej errno.
+	ErrnoError(const tstring &msg, const tstring &file = _T(""), int line = 0);
+};
+
+#ifdef USE_SDL
+	/// Wyjątek z błędem pobranym z biblioteki SDL za pomocą SDLError
+	class SDLError : public Error
+	{
+	public:
+		SDLError(const tstring &msg, const tstring &file = _T(""), int line = 0);
+	};
+#endif
+
+#ifdef USE_OPENGL
+	/// Wyjątek z błędem pobranym z biblioteki OpenGL za pomocą OpenGLError
+	class OpenGLError : public Error
+	{
+	public:
+		OpenGLError(const tstring &msg, const tstring &file = _T(""), int line = 0);
+	};
+#endif
+
+#ifdef USE_FMOD
+	/// Wyjątek z błędem pobranym z biblioteki dźwiękowej FMOD
+	class FmodError : public Error
+	{
+	private:
+		/** \param[out] Enum Może być NULL.
+		\param[out] Message Może być NULL. */
+		void CodeToMessage(FMOD_RESULT code, tstring *Enum, tstring *Message);
+
+	public:
+		FmodError(FMOD_RESULT code, const tstring &msg, const tstring &file = _T(""), int line = 0);
+	};
+#endif
+
+#ifdef _WIN32
+	/// Tworzy wyjątek na podstawie błędu WinAPI pobieranego za pomocą GetLastError
+	class Win32Error : public Error
+	{
+	public:
+		Win32Error(const tstring &msg = _T(""), const tstring &file = _T(""), int line = 0);
+	};
+#endif
+
+#ifdef USE_DIRECTX
+	/// Tworzy wyjątek na podstawie błędu biblioteki Direct3D.
+	class DirectXError : public Error
+	{
+	public:
+		DirectXError(HRESULT hr, const tstring &Msg = _T(""), const tstring &file = _T(""), int Line = 0);
+		/// Użyj tej wersji jeśli funkcja DX którą kontroluje zwraca też w przypadku błędu bufor z komunikatem
+		/** Bufor zostanie przez konstruktor tego wyjątku sam zwolniony, jeśli istniał. Może nie istnieć. */
+		DirectXError(HRESULT hr, ID3DXBuffer *Buf, const tstring &Msg = _T(""), const tstring &file = _T(""), int Line = 0);
+	};
+#endif
+
+#ifdef USE_WINSOCK
+	/// Tworzy wyjątek na podstawie błędu biblioteki WinSock.
+	class WinSockError : public Error
+	{
+	private:
+		void CodeToStr(int Code, tstring *Name, tstring *Message);
+
+	public:
+		/// Tworzy komunikat błędu WinSockError
+		int WinSockError(int Code, const tstring &Msg = "", const tstring &file = _T(""), int Line = 0);
+		/// Tworzy komunikat błędu WinSockError, pobiera kod sam z WSAGetLastError()
+		int WinSockError(const tstring &Msg = "", const tstring &file = _T(""), int Line = 0);
+	};
+#endif
+
+#ifdef USE_DEVIL
+	/// Tworzy wyjątek na podstawie błędu biblioteki graficznej DevIL
+	/* Ponieważ nie sposób niestety w DevIL sprawdzić czy jest błąd bez zdjęcia jednego
+	kodu błędu ze szczytu stosu, należy wywołać ILenum code = ilGetError() i jeśli
+	code != IL_NO_ERROR, to wtedy rzucić ten wyjątek podając jako pierwszy parametr code.
+	*/
+	class DevILError : public Error
+	{
+	public:
+		DevILError(unsigned FirstCode, const tstring &Msg = "", const tstring &File = _T(""), int Line = 0);
+	};
+#endif
+
+#ifdef USE_AVI_FILE
+	/// Tworzy wyjątek na podstawie błędu biblioteki AviFile (część WinAPI)
+	class AVIFileError : public Error
+	{
+	public:
+		AVIFileError(HRESULT hr, const tstring &Msg = "", const tstring &file = _T(""), int a_Line = 0);
+	};
+#endif
+
+//@}
+// code_error
+
+} // namespace common
+
+/** \addtogroup code_error */
+//@{
+
+/// Użyj aby dodać komunikat do stosu wyjątku
+#define ERR_ADD_FUNC(exception) { (exception).Push(__TFUNCSIG__, __TFILE__, __LINE__); }
+#define ERR_TRY        { try {
+#define ERR_CATCH(msg) } catch(common::Error &e) { e.Push((msg), __TFILE__, __LINE__); throw; } }
+#define ERR_CATCH_FUNC } catch(common::Error &e) { ERR_ADD_FUNC(e); throw; } }
+
+#define ERR_GUARD_BOOL(Expr) { if ((Expr) == false) throw common::Error(_T(#Expr), __TFILE__, __LINE__); }
+#define ERR_GUARD_DIRECTX(Expr) { HRESULT hr; if (FAILED(hr = (Expr))) throw common::DirectXError(hr, _T(#Expr), __TFILE__, __LINE__); }
+#define ERR_GUARD_DEVIL(Code) { { Code ; } ILenum c = ilGetError(); if (c != IL_NO_ERROR) throw common::DevILError(c, _T(#Code), __TFILE__, __LINE__); }
+
+#ifdef _DEBUG
+	#define ERR_GUARD_BOOL_D(Expr) ERR_GUARD_BOOL(Expr)
+	#define ERR_GUARD_DIRECTX_D(Expr) ERR_GUARD_DIRECTX(Expr)
+#else
+	#define ERR_GUARD_BOOL_D(Expr) (Expr);
+	#define ERR_GUARD_DIRECTX_D(Expr) (Expr);
+#endif
+
+/// Makra, które przerabiają każdy rodzaj wyjątku na wyjątek common::Error
+#define ALL_EXCEPTIONS_TRY   try {
+/// Makra, które przerabiają każdy rodzaj wyjątku na wyjątek common::Error
+#define ALL_EXCEPTIONS_CATCH   \
+	} \
+	catch (const common::Error&) \
+	{ \
+		throw; \
+	} \
+	catch (const std::exception &stde) \
+	{ \
+		throw common::Error(tstring(_T("std::exception: ")) + common::StringToTstringR(stde.what()), __TFILE__, __LINE__); \
+	} \
+	catch (...) \
+	{ \
+		throw common::Error(_T("Unknown exception."), __TFILE__, __LINE__); \
+	}
+
+//@}
+// code_error
+
+/// Rozszerzenie modułu bazowego o wsparcie dla błędów
+/**
+\ingroup code_sthtostr
+\ingroup code_error */
+template <typename T>
+inline void MustStrToSth(T *Sth, const tstring &Str)
+{
+	if (!StrToSth<T>(Sth, Str))
+		throw common::Error(_T("String conversion error: ") + Str);
+}
+
+#endif
@@ -1,1215 +1,3741 @@
-/** \file
-\brief Files and file system handling
-\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
-
-Part of CommonLib library. \n
-Encoding UTF-8, end of line CR+LF \n
-License: GNU LGPL. \n
-Documentation: \ref Module_Files \n
-Module components: \ref code_files
-*/
-#include "Base.hpp"
-
-#include <sys/types.h>
-#include <sys/stat.h>
-#include <stdio.h> // dla unlink [Win, Linux ma go w unistd.h], rename [obydwa]
-#ifdef _WIN32
-	extern "C" {
-		#include <sys/utime.h> // dla utime
-		#include <direct.h> // dla mkdir (Linux ma go w sys/stat.h + sys/types.h)
-	}
-	#include <windows.h>
-#else
-	extern "C" {
-		#include <sys/time.h> // dla utime
-		#include <sys/file.h> // dla flock
-		#include <dirent.h>
-		#include <utime.h> // dla utime
-	}
-#endif
-#include <stack>
-
-#include "Error.hpp"
-#include "Files.hpp"
-#include "DateTime.hpp"
-
-
-namespace common
-{
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-// Klasa FileStream
-
-#ifdef _WIN32
-
-	class File_pimpl
-	{
-	public:
-		HANDLE m_File;
-	};
-
-	FileStream::FileStream(const tstring &FileName, FILE_MODE FileMode, bool Lock) :
-		pimpl(new File_pimpl)
-	{
-		uint32 DesiredAccess, ShareMode, CreationDisposition;
-		switch (FileMode)
-		{
-		case FM_WRITE:
-			DesiredAccess = GENERIC_WRITE;
-			ShareMode = 0;
-			CreationDisposition = CREATE_ALWAYS;
-			break;
-		case FM_WRITE_PLUS:
-			DesiredAccess = GENERIC_WRITE | GENERIC_READ;
-			ShareMode = 0;
-			CreationDisposition = CREATE_ALWAYS;
-			break;
-		case FM_READ:
-			DesiredAccess = GENERIC_READ;
-			ShareMode = FILE_SHARE_READ;
-			CreationDisposition = OPEN_EXISTING;
-			break;
-		case FM_READ_PLUS:
-			DesiredAccess = GENERIC_WRITE | GENERIC_READ;
-			ShareMode = 0;
-			CreationDisposition = OPEN_EXISTING;
-			break;
-		case FM_APPEND:
-			DesiredAccess = GENERIC_WRITE;
-			ShareMode = 0;
-			CreationDisposition = OPEN_ALWAYS;
-			break;
-		case FM_APPEND_PLUS:
-			DesiredAccess = GENERIC_WRITE | GENERIC_READ;
-			ShareMode = 0;
-			CreationDisposition = OPEN_ALWAYS;
-			break;
-		}
-		if (!Lock)
-			ShareMode = FILE_SHARE_READ | FILE_SHARE_WRITE;
-
-		pimpl->m_File = CreateFile(FileName.c_str(), DesiredAccess, ShareMode, 0, CreationDisposition, FILE_ATTRIBUTE_NORMAL, 0);
-		if (pimpl->m_File == INVALID_HANDLE_VALUE)
-			throw Win32Error(_T("Cannot open file: ") + FileName, __TFILE__, __LINE__);
-
-		if (FileMode == FM_APPEND || FileMode == FM_APPEND_PLUS)
-			SetPosFromEnd(0);
-	}
-
-	FileStream::~FileStream()
-	{
-		CloseHandle(pimpl->m_File);
-	}
-
-	void FileStream::Write(const void *Data, size_t Size)
-	{
-		uint32 WrittenSize;
-        assert(Size <= (size_t)UINT_MAX);
-		if (WriteFile(pimpl->m_File, Data, (DWORD)Size, (LPDWORD)&WrittenSize, 0) == 0)
-			throw Win32Error(Format(_T("Cannot write # bytes to file.")) % Size, __TFILE__, __LINE__);
-		if ((size_t)WrittenSize != Size)
-			throw Error(Format(_T("Cannot write to file. #/# bytes written.")) % WrittenSize % Size, __TFILE__, __LINE__);
-	}
-
-	size_t FileStream::Read(void *Data, size_t Size)
-	{
-		uint32 ReadSize;
-        assert(Size <= (size_t)UINT_MAX);
-		if (ReadFile(pimpl->m_File, Data, (DWORD)Size, (LPDWORD)&ReadSize, 0) == 0)
-			throw Win32Error(Format(_T("Cannot read # bytes from file.")) % Size, __TFILE__, __LINE__);
-		return (size_t)ReadSize;
-	}
-
-	void FileStream::Flush()
-	{
-		FlushFileBuffers(pimpl->m_File);
-	}
-
-	uint64 FileStream::GetSize()
-	{
-        LARGE_INTEGER i;
-        if(!GetFileSizeEx(pimpl->m_File, &i))
-            throw Win32Error(_T("Cannot get file size."), __TFILE__, __LINE__);
-		return (uint64)i.QuadPart;
-	}
-
-	int64 FileStream::GetPos()
-	{
-        LARGE_INTEGER distanceToMove, newFilePointer;
-        distanceToMove.QuadPart = 0;
-        if(!SetFilePointerEx(pimpl->m_File, distanceToMove, &newFilePointer, FILE_CURRENT))
-			throw Win32Error(_T("Cannot read position from file stream."), __TFILE__, __LINE__);
-        return newFilePointer.QuadPart;
-	}
-
-	void FileStream::SetPos(int64 pos)
-	{
-        LARGE_INTEGER distanceToMove;
-        distanceToMove.QuadPart = pos;
-		if (!SetFilePointerEx(pimpl->m_File, distanceToMove, nullptr, FILE_BEGIN))
-			throw Win32Error(Format(_T("Cannot set position in file stream to # from the beginning.")) % pos, __TFILE__, __LINE__);
-	}
-
-	void FileStream::SetPosFromCurrent(int64 pos)
-	{
-        LARGE_INTEGER distanceToMove;
-        distanceToMove.QuadPart = pos;
-		if (!SetFilePointerEx(pimpl->m_File, distanceToMove, nullptr, FILE_CURRENT))
-			throw Win32Error(Format(_T("Cannot set position in file stream to # from current.")) % pos, __TFILE__, __LINE__);
-	}
-
-	void FileStream::SetPosFromEnd(int64 pos)
-	{
-        LARGE_INTEGER distanceToMove;
-        distanceToMove.QuadPart = pos;
-		if (!SetFilePointerEx(pimpl->m_File, distanceToMove, nullptr, FILE_END))
-			throw Win32Error(Format(_T("Cannot set position in file stream to # from the end.")) % pos, __TFILE__, __LINE__);
-	}
-
-	void FileStream::SetSize(uint64 Size)
-	{
-		int64 SavedPos = GetPos();
-		
-		SetPos((int64)Size);
-		Truncate();
-
-		SetPos(SavedPos);
-	}
-
-	void FileStream::Truncate()
-	{
-		if (SetEndOfFile(pimpl->m_File) == 0)
-			throw Win32Error(_T("Cannot truncate file."), __TFILE__, __LINE__);
-	}
-
-	bool FileStream::End()
-	{
-		// Fuj! Ale to nieeleganckie. Szkoda, e nie ma lepszego sposobu.
-		return GetSize() == (uint64)GetPos();
-	}
-
-	HANDLE FileStream::GetNativeHandle()
-	{
-		return pimpl->m_File;
-	}
-
-#else
-
-	class File_pimpl
-	{
-	public:
-		FILE *m_File;
-		bool m_Lock;
-	};
-
-	FileStream::FileStream(const tstring &FileName, FILE_MODE FileMode, bool Lock) :
-		pimpl(new File_pimpl)
-	{
-		pimpl->m_Lock = Lock;
-
-		const char *m = 0;
-
-		switch (FileMode)
-		{
-		case FM_WRITE:
-			m = "wb";
-			break;
-		case FM_WRITE_PLUS:
-			m = "w+b";
-			break;
-		case FM_READ:
-			m = "rb";
-			break;
-		case FM_READ_PLUS:
-			m = "r+b";
-			break;
-		case FM_APPEND:
-			m = "ab";
-			break;
-		case FM_APPEND_PLUS:
-			m = "a+b";
-			break;
-		}
-
-		pimpl->m_File = fopen(FileName.c_str(), m);
-		if (pimpl->m_File == 0)
-			throw ErrnoError(Format(_T("Cannot open file \"#\" in mode \"#\".")) % FileName % m, __TFILE__, __LINE__);
-		if (Lock)
-		{
-			if (flock(fileno(pimpl->m_File), LOCK_EX | LOCK_NB) != 0)
-				throw ErrnoError(Format(_T("Cannot open file \"#\" in mode \"#\" - error while locking.")) % FileName % m, __TFILE__, __LINE__);
-		}
-	}
-
-	FileStream::~FileStream()
-	{
-		if (pimpl->m_File != 0)
-		{
-			// Kiedy deskryptor int zostaje zamknity, podobno blokada sama si zwalania. Ale kto tam tego Linuksa wie... :)
-			if (pimpl->m_Lock)
-				flock(fileno(pimpl->m_File), LOCK_UN);
-			fclose(pimpl->m_File);
-		}
-	}
-
-	void FileStream::Write(const void *Data, size_t Size)
-	{
-		size_t Written = fwrite(Data, 1, Size, pimpl->m_File);
-		if (Written != Size || ferror(pimpl->m_File) != 0)
-			throw Error(Format(_T("Cannot write to file. #/# bytes written.")) % Written % Size, __TFILE__, __LINE__);
-	}
-
-	size_t FileStream::Read(void *Data, size_t Size)
-	{
-		size_t BytesRead = fread(Data, 1, Size, pimpl->m_File);
-		if (ferror(pimpl->m_File) != 0)
-			throw Error(Format(_T("Cannot read from file. #/# bytes read.")) % BytesRead % Size, __TFILE__, __LINE__);
-		return BytesRead;
-	}
-
-	void FileStream::Flush()
-	{
-		fflush(pimpl->m_File);
-	}
-
-	uint64 FileStream::GetSize()
-	{
-		// Wersja 1
-		int64 SavedPos = GetPos();
-		SetPosFromEnd(0);
-		int64 EndPos = GetPos();
-		SetPos(SavedPos);
-		return (uint64)EndPos;
-
-		// Ta wersja jest za bo moe nie pokazywa aktualnego rozmiaru, bo jest bufor
-/*		// Wersja 2
-		struct stat s;
-		fstat(fileno(pimpl->m_File), &s);
-		return s.st_size;*/
-	}
-
-	int64 FileStream::GetPos()
-	{
-		int r = ftell(pimpl->m_File);
-		if (r < 0)
-			throw ErrnoError(_T("Cannot get current position in file."), __TFILE__, __LINE__);
-		return r;
-	}
-
-	void FileStream::SetPos(int64 pos)
-	{
-		int r = fseek(pimpl->m_File, (long)pos, SEEK_SET);
-		if (r < 0)
-			throw ErrnoError(Format(_T("Cannot set position in file stream to # from the beginning.")) % pos, __TFILE__, __LINE__);
-	}
-
-	void FileStream::SetPosFromCurrent(int64 pos)
-	{
-		int r = fseek(pimpl->m_File, (long)pos, SEEK_CUR);
-		if (r < 0)
-			throw ErrnoError(Format(_T("Cannot set position in file stream to # from current.")) % pos, __TFILE__, __LINE__);
-	}
-
-	void FileStream::SetPosFromEnd(int pos)
-	{
-		int r = fseek(pimpl->m_File, (long)pos, SEEK_END);
-		if (r < 0)
-			throw ErrnoError(Format(_T("Cannot set position in file stream to # from the end.")) % pos, __TFILE__, __LINE__);
-	}
-
-	void FileStream::SetSize(uint64 Size)
-	{
-		ftruncate(fileno(pimpl->m_File), (off_t)Size);
-	}
-
-	void FileStream::Truncate()
-	{
-		SeekableStream::Truncate();
-	}
-
-	bool FileStream::End()
-	{
-		// Fuj! Ale to nieeleganckie. Szkoda, e nie ma lepszego sposobu.
-		// UWAGA! Jak byo zamienione miejscami, najpierw wyliczane GetSize
-		// a potem GetPos to za pierwszym wyliczaniem wychodzio false a dopiero
-		// za drugim true - LOL!
-		return (uint64)GetPos() == GetSize();
-	}
-
-#endif
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-// Klasa DirLister
-
-class DirLister_pimpl
-{
-private:
-	tstring m_Dir;
-
-	#ifdef _WIN32
-		WIN32_FIND_DATA m_FindData;
-		HANDLE m_Handle;
-		bool m_ReachedEnd;
-
-		void GetFirst();
-		void GetNext();
-
-	#else
-		DIR *m_DirHandle;
-
-	#endif
-
-public:
-	DirLister_pimpl(const tstring &Dir);
-	~DirLister_pimpl();
-
-	bool ReadNext(tstring *OutName, FILE_ITEM_TYPE *OutType);
-};
-
-#ifdef _WIN32
-	void DirLister_pimpl::GetFirst()
-	{
-		tstring Path;
-		IncludeTrailingPathDelimiter(&Path, m_Dir);
-		Path += _T('*');
-		m_Handle = FindFirstFile(Path.c_str(), &m_FindData);
-
-		if (m_Handle == INVALID_HANDLE_VALUE)
-		{
-			if (GetLastError() == ERROR_NO_MORE_FILES)
-				m_ReachedEnd = true;
-			else
-				throw Win32Error(_T("Cannot start directory listing: ") + m_Dir, __TFILE__, __LINE__);
-		}
-		else
-			m_ReachedEnd = false;
-
-		while (!m_ReachedEnd && (m_FindData.cFileName == tstring(_T(".")) || m_FindData.cFileName == tstring(_T(".."))))
-			GetNext();
-	}
-
-	void DirLister_pimpl::GetNext()
-	{
-		if (FindNextFile(m_Handle, &m_FindData) == 0)
-		{
-			if (GetLastError() == ERROR_NO_MORE_FILES)
-				m_ReachedEnd = true;
-			else
-				throw Win32Error(_T("Cannot continue directory listing: ") + m_Dir, __TFILE__, __LINE__);
-		}
-
-		while (!m_ReachedEnd && (m_FindData.cFileName == tstring(_T(".")) || m_FindData.cFileName == tstring(_T(".."))))
-			GetNext();
-	}
-
-	DirLister_pimpl::DirLister_pimpl(const tstring &Dir) :
-		m_Dir(Dir)
-	{
-		GetFirst();
-	}
-
-	DirLister_pimpl::~DirLister_pimpl()
-	{
-		if (m_Handle != INVALID_HANDLE_VALUE)
-			FindClose(m_Handle);
-	}
-
-	bool DirLister_pimpl::ReadNext(tstring *OutName, FILE_ITEM_TYPE *OutType)
-	{
-		if (m_ReachedEnd)
-			return false;
-
-		*OutName = m_FindData.cFileName;
-		*OutType = ( ((m_FindData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0) ? IT_DIR : IT_FILE );
-
-		GetNext();
-
-		return true;
-	}
-
-#else
-	DirLister_pimpl::DirLister_pimpl(const tstring &Dir) :
-		m_Dir(Dir)
-	{
-		m_DirHandle = opendir(Dir.c_str());
-		if (m_DirHandle == NULL)
-			throw ErrnoError(_T("Cannot start directory listing: ") + m_Dir, __TFILE__, __LINE__);
-	}
-
-	DirLister_pimpl::~DirLister_pimpl()
-	{
-		if (m_DirHandle != NULL)
-			closedir(m_DirHandle);
-	}
-
-	bool DirLister_pimpl::ReadNext(tstring *OutName, FILE_ITEM_TYPE *OutType)
-	{
-		dirent DirEnt, *DirEntPtr;
-		if ( readdir_r(m_DirHandle, &DirEnt, &DirEntPtr) != 0 )
-			throw ErrnoError(_T("Cannot continue directory listing: ") + m_Dir, __TFILE__, __LINE__);
-		if (DirEntPtr == NULL)
-			return false;
-		if (strcmp(DirEnt.d_name, _T(".")) == 0 || strcmp(DirEnt.d_name, _T("..")) == 0)
-			return ReadNext(OutName, OutType);
-		*OutName = DirEnt.d_name;
-		*OutType = ( (DirEnt.d_type == DT_DIR) ? IT_DIR : IT_FILE );
-		return true;
-	}
-
-#endif
-
-DirLister::DirLister(const tstring &Dir) :
-	pimpl(new DirLister_pimpl(Dir))
-{
-}
-
-DirLister::~DirLister()
-{
-}
-
-bool DirLister::ReadNext(tstring *OutName, FILE_ITEM_TYPE *OutType)
-{
-	return pimpl->ReadNext(OutName, OutType);
-}
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-// Funkcje globalne
-
-void SaveStringToFile(const tstring &FileName, const string &Data)
-{
-	try
-	{
-		FileStream f(FileName, FM_WRITE);
-		f.WriteStringF(Data);
-	}
-	catch (Error &e)
-	{
-		e.Push(Format(_T("Cannot write string to file: \"#\"")) % FileName, __TFILE__, __LINE__);
-		throw;
-	}
-}
-
-void SaveDataToFile(const tstring &FileName, const void *Data, size_t NumBytes)
-{
-	try
-	{
-		FileStream f(FileName, FM_WRITE);
-		f.Write(Data, NumBytes);
-	}
-	catch (Error &e)
-	{
-		e.Push(Format(_T("Cannot write binary data to file: \"#\"")) % FileName, __TFILE__, __LINE__);
-		throw;
-	}
-}
-
-void LoadStringFromFile(const tstring &FileName, string *Data)
-{
-	try
-	{
-		FileStream f(FileName, FM_READ);
-		f.ReadStringToEnd(Data);
-	}
-	catch (Error &e)
-	{
-		e.Push(Format(_T("Cannot read string from file: \"#\"")) % FileName, __TFILE__, __LINE__);
-		throw;
-	}
-}
-
-#ifdef _WIN32
-
-void SaveStringToFile(const tstring &FileName, const wstring &Data)
-{
-	try
-	{
-		FileStream f(FileName, FM_WRITE);
-		f.WriteStringF(Data);
-	}
-	catch (Error &e)
-	{
-		e.Push(Format(_T("Cannot write string to file: \"#\"")) % FileName, __TFILE__, __LINE__);
-		throw;
-	}
-}
-
-void LoadStringFromFile(const tstring &FileName, wstring *Data)
-{
-	try
-	{
-		FileStream f(FileName, FM_READ);
-		f.ReadStringToEnd(Data);
-	}
-	catch (Error &e)
-	{
-		e.Push(Format(_T("Cannot read string from file: \"#\"")) % FileName, __TFILE__, __LINE__);
-		throw;
-	}
-}
-
-#endif
-
-bool GetFileItemInfo(const tstring &Path, FILE_ITEM_TYPE *OutType, uint64 *OutSize, DATETIME *OutModificationTime, DATETIME *OutCreationTime, DATETIME *OutAccessTime)
-{
-#ifdef _WIN32
-	struct _stat32i64 S;
-	if ( _tstat32i64(Path.c_str(), &S) != 0 )
-		return false;
-
-	if (OutType != NULL)
-		*OutType = ( ((S.st_mode & S_IFDIR) != 0) ? IT_DIR : IT_FILE );
-#else
-	struct stat S;
-	if ( stat(Path.c_str(), &S) != 0 )
-		return false;
-
-	if (OutType != NULL)
-		*OutType = ( S_ISDIR(S.st_mode) ? IT_DIR : IT_FILE );
-#endif
-
-	if (OutSize != NULL)
-		*OutSize = (uint64)S.st_size;
-	if (OutModificationTime != NULL)
-		*OutModificationTime = DATETIME(S.st_mtime);
-	if (OutCreationTime != NULL)
-		*OutCreationTime = DATETIME(S.st_ctime);
-	if (OutAccessTime != NULL)
-		*OutAccessTime = DATETIME(S.st_atime);
-
-	return true;
-}
-
-void MustGetFileItemInfo(const tstring &Path, FILE_ITEM_TYPE *OutType, uint64 *OutSize, DATETIME *OutModificationTime, DATETIME *OutCreationTime, DATETIME *OutAccessTime)
-{
-	if (!GetFileItemInfo(Path, OutType, OutSize, OutModificationTime, OutCreationTime, OutAccessTime))
-		throw ErrnoError(_T("Cannot obtain information about: ") + Path, __TFILE__, __LINE__);
-}
-
-FILE_ITEM_TYPE GetFileItemType(const tstring &Path)
-{
-#ifdef _WIN32
-	// szukanie pliku
-	DWORD Attr = GetFileAttributes(Path.c_str());
-	// pliku nie ma
-	if (Attr == INVALID_FILE_ATTRIBUTES)
-		return IT_NONE;
-	// to jest katalog
-	if ((Attr & FILE_ATTRIBUTE_DIRECTORY) != 0)
-		return IT_DIR;
-	// nie - to jest plik
-	else
-		return IT_FILE;
-
-#else
-	struct stat s;
-	if ( stat(Path.c_str(), &s) != 0 )
-		return IT_NONE;
-	if (S_ISDIR(s.st_mode))
-		return IT_DIR;
-	if (S_ISREG(s.st_mode))
-		return IT_FILE;
-	return IT_NONE;
-
-#endif
-}
-
-bool UpdateFileTimeToNow(const tstring &FileName)
-{
-#ifdef _WIN32
-	return ( _tutime(FileName.c_str(), NULL) == 0 );
-#else
-	return ( utime(FileName.c_str(), NULL) == 0 );
-#endif
-}
-
-void MustUpdateFileTimeToNow(const tstring &FileName)
-{
-	if (!UpdateFileTimeToNow(FileName))
-		throw ErrnoError(_T("Cannot write file time to current for: ") + FileName, __TFILE__, __LINE__);
-}
-
-bool UpdateFileTime(const tstring &FileName, const DATETIME &ModificationTime, const DATETIME &AccessTime)
-{
-#ifdef _WIN32
-	_utimbuf B;
-	B.modtime = ModificationTime.GetTicks();
-	B.actime = AccessTime.GetTicks();
-	return ( _tutime(FileName.c_str(), &B) == 0 );
-
-#else
-	utimbuf B;
-	B.modtime = ModificationTime.GetTicks();
-	B.actime = AccessTime.GetTicks();
-	return ( utime(FileName.c_str(), &B) == 0 );
-
-#endif
-}
-
-void MustUpdateFileTime(const tstring &FileName, const DATETIME &ModificationTime, const DATETIME &AccessTime)
-{
-	if (!UpdateFileTime(FileName, ModificationTime, AccessTime))
-		throw ErrnoError(_T("Cannot write file time for: ") + FileName, __TFILE__, __LINE__);
-}
-
-bool CreateDirectory(const tstring &Path)
-{
-#ifdef _WIN32
-	return ( _tmkdir(Path.c_str()) == 0 );
-#else
-	return ( mkdir(Path.c_str(), 0777) == 0 );
-#endif
-}
-
-void MustCreateDirectory(const tstring &Path)
-{
-	if (!CreateDirectory(Path))
-		throw ErrnoError(_T("Cannot create directory: ") + Path, __TFILE__, __LINE__);
-}
-
-bool DeleteDirectory(const tstring &Path)
-{
-#ifdef _WIN32
-	return ( _trmdir(Path.c_str()) == 0 );
-#else
-	return ( rmdir(Path.c_str()) == 0 );
-#endif
-}
-
-void MustDeleteDirectory(const tstring &Path)
-{
-	if (!DeleteDirectory(Path))
-		throw ErrnoError(_T("Cannot delete directory: ") + Path, __TFILE__, __LINE__);
-}
-
-bool CreateDirectoryChain(const tstring &Path)
-{
-	if (GetFileItemType(Path) == IT_DIR)
-		return true;
-
-	size_t i2, i = Path.length()-1;
-	std::stack<size_t> DirSepStack;
-	for (;;)
-	{
-		i2 = Path.find_last_of(DIR_SEP, i-1);
-		if (i2 == tstring::npos)
-			break;
-		if (GetFileItemType(Path.substr(0, i2)) == IT_DIR)
-			break;
-		DirSepStack.push(i2);
-		i = i2;
-	}
-
-	while (!DirSepStack.empty())
-	{
-		if ( !CreateDirectory(Path.substr(0, DirSepStack.top())) )
-			return false;
-		DirSepStack.pop();
-	}
-	if ( !CreateDirectory(Path) )
-		return false;
-	return true;
-}
-
-void MustCreateDirectoryChain(const tstring &Path)
-{
-	if (GetFileItemType(Path) == IT_DIR)
-		return;
-
-	size_t i2, i = Path.length()-1;
-	std::stack<size_t> DirSepStack;
-	for (;;)
-	{
-		i2 = Path.find_last_of(DIR_SEP, i-1);
-		if (i2 == tstring::npos)
-			break;
-		if (GetFileItemType(Path.substr(0, i2)) == IT_DIR)
-			break;
-		DirSepStack.push(i2);
-		i = i2;
-	}
-
-	while (!DirSepStack.empty())
-	{
-		MustCreateDirectory(Path.substr(0, DirSepStack.top()));
-		DirSepStack.pop();
-	}
-	MustCreateDirectory(Path);
-}
-
-bool DeleteFile(const tstring &FileName)
-{
-#ifdef _WIN32
-	return ( _tunlink(FileName.c_str()) == 0 );
-#else
-	return ( unlink(FileName.c_str()) == 0 );
-#endif
-}
-
-void MustDeleteFile(const tstring &FileName)
-{
-	if (!DeleteFile(FileName))
-		throw ErrnoError(_T("Cannot delete file: ") + FileName, __TFILE__, __LINE__);
-}
-
-bool MoveItem(const tstring &OldPath, const tstring &NewPath)
-{
-#ifdef _WIN32
-	return ( _trename(OldPath.c_str(), NewPath.c_str()) == 0 );
-#else
-	return ( rename(OldPath.c_str(), NewPath.c_str()) == 0 );
-#endif
-}
-
-void MustMoveItem(const tstring &OldPath, const tstring &NewPath)
-{
-	if (!MoveItem(OldPath, NewPath))
-		throw ErrnoError(_T("Cannot move element from \"") + OldPath + _T("\" to \"") + NewPath + _T("\""), __TFILE__, __LINE__);
-}
-
-#ifdef _WIN32
-
-void SaveUnicodeToFile(const tstring &FileName, const wstring &Data, unsigned Encoding)
-{
-	ERR_TRY;
-
-	FileStream F(FileName, FM_WRITE);
-	SaveUnicodeToStream(&F, Data, Encoding);
-
-	ERR_CATCH(_T("Cannot save Unicode string to file: ") + FileName);
-}
-
-void SaveUnicodeToFile(const tstring &FileName, const wchar_t *Data, size_t NumChars, unsigned Encoding)
-{
-	ERR_TRY;
-
-	FileStream F(FileName, FM_WRITE);
-	SaveUnicodeToStream(&F, Data, NumChars, Encoding);
-
-	ERR_CATCH(_T("Cannot save Unicode characters to file: ") + FileName);
-}
-
-void SaveUnicodeToStream(Stream *Dest, const wstring &Data, unsigned Encoding)
-{
-	ERR_TRY;
-
-	switch (Encoding & 0xFFFF)
-	{
-	case FILE_ENCODING_UTF16_LE:
-		{
-			// Docz nagwek, o ile nie wymuszono braku
-			if ((Encoding & FILE_ENCODING_NO_BOM) == 0)
-				Dest->Write(BOM_UTF16_LE, strlen(BOM_UTF16_LE));
-			// Zapisz dane bezporednio tak jak s w pamici
-			Dest->WriteStringF(Data);
-		}
-		break;
-	case FILE_ENCODING_UTF8:
-		{
-			// Docz nagwek, jeli wymuszono e ma by
-			if ((Encoding & FILE_ENCODING_FORCE_BOM) != 0)
-				Dest->Write(BOM_UTF8, strlen(BOM_UTF8));
-			// Skonwertuj Unicode na UTF8
-			string utf8_string;
-			if (!ConvertUnicodeToChars(&utf8_string, Data, CP_UTF8))
-				throw Error(_T("Cannot convert Unicode to UTF-8."), __TFILE__, __LINE__);
-			// Zapisz acuch UTF-8
-			Dest->WriteStringF(utf8_string);
-		}
-		break;
-	case FILE_ENCODING_ANSI:
-		{
-			// Skonwertuj Unicode na ANSI
-			string ansi_string;
-			if (!ConvertUnicodeToChars(&ansi_string, Data, CP_ACP))
-				throw Error(_T("Cannot convert Unicode to ANSI."), __TFILE__, __LINE__);
-			// Zapisz acuch ANSI
-			Dest->WriteStringF(ansi_string);
-		}
-		break;
-	default:
-		assert(0 && "SaveUnicodeToStream: No encoding specified.");
-	}
-
-	ERR_CATCH(_T("Cannot save Unicode string to stream."));
-}
-
-void SaveUnicodeToStream(Stream *Dest, const wchar_t *Data, size_t NumChars, unsigned Encoding)
-{
-	ERR_TRY;
-
-	switch (Encoding & 0xFFFF)
-	{
-	case FILE_ENCODING_UTF16_LE:
-		{
-			// Docz nagwek, o ile nie wymuszono braku
-			if ((Encoding & FILE_ENCODING_NO_BOM) == 0)
-				Dest->Write(BOM_UTF16_LE, strlen(BOM_UTF16_LE));
-			// Zapisz dane bezporednio tak jak s w pamici
-			Dest->Write(Data, NumChars * sizeof(wchar_t));
-		}
-		break;
-	case FILE_ENCODING_UTF8:
-		{
-			// Docz nagwek, jeli wymuszono e ma by
-			if ((Encoding & FILE_ENCODING_FORCE_BOM) != 0)
-				Dest->Write(BOM_UTF8, strlen(BOM_UTF8));
-			// Skonwertuj Unicode na UTF8
-			string utf8_string;
-			if (!ConvertUnicodeToChars(&utf8_string, Data, NumChars, CP_UTF8))
-				throw Error(_T("Cannot convert Unicode to UTF-8."), __TFILE__, __LINE__);
-			// Zapisz acuch UTF-8
-			Dest->WriteStringF(utf8_string);
-		}
-		break;
-	case FILE_ENCODING_ANSI:
-		{
-			// Skonwertuj Unicode na ANSI
-			string ansi_string;
-			if (!ConvertUnicodeToChars(&ansi_string, Data, NumChars, CP_ACP))
-				throw Error(_T("Cannot convert Unicode to ANSI."), __TFILE__, __LINE__);
-			// Zapisz acuch ANSI
-			Dest->WriteStringF(ansi_string);
-		}
-		break;
-	default:
-		assert(0 && "SaveUnicodeToStream: No encoding specified.");
-	}
-
-	ERR_CATCH(_T("Cannot save Unicode characters to stream."));
-}
-
-// Funkcja wewntrzna do testowania czy dane zaczynaj si od danego nagwka Unicode
-bool HasBOM(const char *Data, size_t NumBytes, const char *BOM, size_t BOMNumBytes)
-{
-	if (NumBytes < BOMNumBytes)
-		return false;
-	
-	for (size_t i = 0; i < BOMNumBytes; i++)
-	{
-		if (Data[i] != BOM[i])
-			return false;
-	}
-
-	return true;
-}
-
-// Funkcja wewntrzna - wykrywa w jakim kodowaniu s dane
-// SuggestedEncoding ma by typu FILE_ENCODING (flagi z modszych 2 bajtw).
-// Przez OutBomSize zwraca take rozmiar nagwka BOM w bajtach, jeli taki jest (jeli nie to zwraca 0).
-enum ENC {
-	ENC_UTF32_LE = 1, ENC_UTF32_BE,
-	ENC_UTF16_LE, ENC_UTF16_BE,
-	ENC_UTF8, ENC_ANSI,
-};
-ENC DetectEncoding(const char *Data, size_t NumBytes, unsigned SuggestedEncoding, size_t *OutBomSize)
-{
-	ENC Enc = (ENC)0;
-	*OutBomSize = 0;
-
-	// Nagwek UTF-32 LE
-	if (HasBOM(Data, NumBytes, "\xFF\xFE\x00\x00", 4))
-		Enc = ENC_UTF32_LE, *OutBomSize = 4;
-	// Nagwek UTF-32 BE
-	else if (HasBOM(Data, NumBytes, "\x00\x00\xFE\xFF", 4))
-		Enc = ENC_UTF32_BE, *OutBomSize = 4;
-	// Nagwek UTF-8
-	else if (HasBOM(Data, NumBytes, BOM_UTF8, strlen(BOM_UTF8)))
-		Enc = ENC_UTF8, *OutBomSize = strlen(BOM_UTF8);
-	// Trzeba odpali analiz
-	else
-	{
-		int AnalysisFlags = IS_TEXT_UNICODE_SIGNATURE | IS_TEXT_UNICODE_REVERSE_SIGNATURE |
-			IS_TEXT_UNICODE_ASCII16 | IS_TEXT_UNICODE_REVERSE_ASCII16 |
-			IS_TEXT_UNICODE_ILLEGAL_CHARS | IS_TEXT_UNICODE_ODD_LENGTH | IS_TEXT_UNICODE_NULL_BYTES |
-			IS_TEXT_UNICODE_STATISTICS | IS_TEXT_UNICODE_REVERSE_STATISTICS |
-			IS_TEXT_UNICODE_CONTROLS | IS_TEXT_UNICODE_REVERSE_CONTROLS;
-		IsTextUnicode(Data, (int)NumBytes, &AnalysisFlags);
-
-		// Nagwek UTF-16 LE
-		if ((AnalysisFlags & IS_TEXT_UNICODE_SIGNATURE) != 0)
-			Enc = ENC_UTF16_LE, *OutBomSize = 2;
-		// Nagwek UTF-16 BE
-		else if ((AnalysisFlags & IS_TEXT_UNICODE_REVERSE_SIGNATURE) != 0)
-			Enc = ENC_UTF16_BE, *OutBomSize = 2;
-		// To jest na pewno UTF-16 LE
-		else if ((AnalysisFlags & IS_TEXT_UNICODE_ASCII16) != 0)
-			Enc = ENC_UTF16_LE;
-		// To jest na pewno UTF-16 BE
-		else if ((AnalysisFlags & IS_TEXT_UNICODE_REVERSE_ASCII16) != 0)
-			Enc = ENC_UTF16_BE;
-		// Nadal nie wiadomo...
-		else
-		{
-			// Liczymy argumenty za UTF-16 LE i BE
-			int UTF16LE_Args = 0, UTF16BE_Args = 0;
-
-			if ((AnalysisFlags & IS_TEXT_UNICODE_NULL_BYTES) != 0)
-				UTF16LE_Args++, UTF16BE_Args++;
-
-			if ((AnalysisFlags & IS_TEXT_UNICODE_STATISTICS) != 0)
-				UTF16LE_Args++;
-			if ((AnalysisFlags & IS_TEXT_UNICODE_REVERSE_STATISTICS) != 0)
-				UTF16BE_Args++;
-
-			if ((AnalysisFlags & IS_TEXT_UNICODE_CONTROLS) != 0)
-				UTF16LE_Args++;
-			if ((AnalysisFlags & IS_TEXT_UNICODE_REVERSE_CONTROLS) != 0)
-				UTF16BE_Args++;
-
-			// To jednak na pewno nie jest UTF-16
-			if ((AnalysisFlags & IS_TEXT_UNICODE_ILLEGAL_CHARS) != 0 || (AnalysisFlags & IS_TEXT_UNICODE_ODD_LENGTH) != 0)
-				UTF16LE_Args = 0, UTF16BE_Args = 0;
-
-			if (UTF16LE_Args > 0 && UTF16LE_Args >= UTF16BE_Args)
-				Enc = ENC_UTF16_LE;
-			else if (UTF16BE_Args > 0)
-				Enc = ENC_UTF16_BE;
-			// To nie jest UTF-16 - jest UTF-8 lub ANSI
-			else
-			{
-				if (SuggestedEncoding == FILE_ENCODING_UTF8)
-					Enc = ENC_UTF8;
-				else if (SuggestedEncoding == FILE_ENCODING_ANSI)
-					Enc = ENC_ANSI;
-				// Preferowane kodowanie nie podane lub podane UTF16 - wybierz domylne
-				else
-					Enc = ENC_UTF8;
-			}
-		}
-	}
-
-	return Enc;
-}
-
-
-void LoadUnicodeFromFile(const tstring &FileName, wstring *Out, unsigned Encoding, FILE_ENCODING *OutEncoding)
-{
-	ERR_TRY;
-
-	FileStream F(FileName, FM_READ);
-	LoadUnicodeFromStream(&F, Out, Encoding, OutEncoding);
-
-	ERR_CATCH(_T("Cannot load Unicode characters from file: ") + FileName);
-}
-
-void LoadUnicodeFromFile(const tstring &FileName, string *Out, unsigned Encoding, FILE_ENCODING *OutEncoding)
-{
-	ERR_TRY;
-
-	FileStream F(FileName, FM_READ);
-	LoadUnicodeFromStream(&F, Out, Encoding, OutEncoding);
-
-	ERR_CATCH(_T("Cannot load Unicode characters from file: ") + FileName);
-}
-
-void LoadUnicodeFromStream(SeekableStream *Src, wstring *Out, unsigned Encoding, FILE_ENCODING *OutEncoding)
-{
-	ERR_TRY;
-
-	// Wczytaj cay plik do pamici
-	VectorStream VS;
-	{
-        uint64 size = Src->GetSize();
-        if(size > SIZE_MAX)
-            throw Error(_T("Stream too long."), __TFILE__, __LINE__);
-		VS.SetCapacity((size_t)size);
-		CopyToEnd(&VS, Src);
-		VS.Rewind();
-	}
-
-	// Nie ma automatycznego wykrywania - koniecznie podane kodowanie
-	if ((Encoding & FILE_ENCODING_AUTODETECT) == 0)
-	{
-		switch (Encoding & 0xFFFF)
-		{
-		case FILE_ENCODING_UTF16_LE:
-			{
-				// Jeli jest nagwek, pomi go
-				size_t BOMSize = strlen(BOM_UTF16_LE);
-				if (HasBOM(VS.Data(), (size_t)VS.GetSize(), BOM_UTF16_LE, BOMSize))
-					VS.SetPosFromCurrent(BOMSize);
-				// Wczytaj dane
-				VS.ReadStringToEnd(Out);
-			}
-			break;
-		case FILE_ENCODING_UTF8:
-			{
-				// Jeli jest nagwek, pomi go
-				size_t BOMSize = strlen(BOM_UTF8);
-				size_t Index = 0;
-				if (HasBOM(VS.Data(), (size_t)VS.GetSize(), BOM_UTF8, BOMSize))
-					Index += BOMSize;
-				// Wczytaj dane - skonwertuj z UTF-8 do Unicode
-				if (!ConvertCharsToUnicode(Out, &VS.Data()[Index], (size_t)VS.GetSize() - Index, CP_UTF8))
-					throw Error(_T("Cannot convert UTF-8 to Unicode."), __TFILE__, __LINE__);
-			}
-			break;
-		case FILE_ENCODING_ANSI:
-			{
-				// Wczytaj dane - skonwertuj z ANSI do Unicode
-				if (!ConvertCharsToUnicode(Out, VS.Data(), (size_t)VS.GetSize(), CP_ACP))
-					throw Error(_T("Cannot convert ANSI to Unicode."), __TFILE__, __LINE__);
-			}
-			break;
-		default:
-			assert(0 && "LoadUnicodeFromStream: No encoding and no AUTODETECT specified.");
-		}
-	}
-	// Jest automatyczne wykrywanie
-	else
-	{
-		// Wykryj kodowanie
-		size_t BomSize;
-		ENC Enc = DetectEncoding(VS.Data(), (size_t)VS.GetSize(), Encoding & 0xFFFF, &BomSize);
-
-		// Rzu wyjtek, jeli to nieobsugiwane kodowanie
-		if (Enc == ENC_UTF32_LE)
-			throw Error(_T("LoadUnicodeFromStream: UTF-32 LE encoding not supported."), __TFILE__, __LINE__);
-		else if (Enc == ENC_UTF32_BE)
-			throw Error(_T("LoadUnicodeFromStream: UTF-32 BE encoding not supported."), __TFILE__, __LINE__);
-		else if (Enc == ENC_UTF16_BE)
-			throw Error(_T("LoadUnicodeFromStream: UTF-16 BE encoding not supported."), __TFILE__, __LINE__);
-		// Wczytaj dane w znanym kodowaniu
-		else if (Enc == ENC_UTF16_LE)
-		{
-			if (OutEncoding != NULL) *OutEncoding = FILE_ENCODING_UTF16_LE;
-			// Pomi nagwek
-			VS.SetPos(BomSize);
-			// Wczytaj dane
-			VS.ReadStringToEnd(Out);
-		}
-		else if (Enc == ENC_UTF8)
-		{
-			if (OutEncoding != NULL) *OutEncoding = FILE_ENCODING_UTF8;
-			// Wczytaj dane - skonwertuj z UTF-8 do Unicode
-			if (!ConvertCharsToUnicode(Out, &VS.Data()[BomSize], (size_t)VS.GetSize() - BomSize, CP_UTF8))
-			{
-				// Jeli nie udao si jako UTF-8, skonwertuj do ANSI
-				if (OutEncoding != NULL) *OutEncoding = FILE_ENCODING_ANSI;
-				if (!ConvertCharsToUnicode(Out, VS.Data(), (size_t)VS.GetSize(), CP_ACP))
-					throw Error(_T("Cannot convert UTF-8 or ANSI to Unicode."), __TFILE__, __LINE__);
-			}
-		}
-		else // if (Enc == ENC_UTF8)
-		{
-			if (OutEncoding != NULL) *OutEncoding = FILE_ENCODING_ANSI;
-			// Wczytaj dane - skonwertuj z ANSI do Unicode
-			if (!ConvertCharsToUnicode(Out, VS.Data(), (size_t)VS.GetSize(), CP_ACP))
-				throw Error(_T("Cannot convert ANSI to Unicode."), __TFILE__, __LINE__);
-		}
-	}
-
-	ERR_CATCH(_T("Cannot load Unicode characters from stream."));
-}
-
-void LoadUnicodeFromStream(SeekableStream *Src, string *Out, unsigned Encoding, FILE_ENCODING *OutEncoding)
-{
-	ERR_TRY;
-
-	// Wczytaj cay plik do pamici
-	VectorStream VS;
-	{
-        uint64 size = Src->GetSize();
-        if(size > SIZE_MAX)
-            throw Error(_T("Stream too long."), __TFILE__, __LINE__);
-		VS.SetCapacity((size_t)size);
-		CopyToEnd(&VS, Src);
-		VS.Rewind();
-	}
-
-	// Nie ma automatycznego wykrywania - koniecznie podane kodowanie
-	if ((Encoding & FILE_ENCODING_AUTODETECT) == 0)
-	{
-		switch (Encoding & 0xFFFF)
-		{
-		case FILE_ENCODING_UTF16_LE:
-			{
-				// Jeli jest nagwek, pomi go
-				size_t BOMSize = strlen(BOM_UTF16_LE);
-				size_t Index = 0;
-				if (HasBOM(VS.Data(), (size_t)VS.GetSize(), BOM_UTF16_LE, BOMSize))
-					Index = BOMSize;
-				// Skonwertuj Unicode na ANSI
-				if (!ConvertUnicodeToChars(Out, (const wchar_t*)&VS.Data()[Index], ((size_t)VS.GetSize() / Index) / sizeof(wchar_t), CP_ACP))
-					throw Error(_T("Cannot convert Unicode to ANSI."), __TFILE__, __LINE__);
-			}
-			break;
-		case FILE_ENCODING_UTF8:
-			{
-				// Jeli jest nagwek, pomi go
-				size_t BOMSize = strlen(BOM_UTF8);
-				size_t Index = 0;
-				if (HasBOM(VS.Data(), (size_t)VS.GetSize(), BOM_UTF8, BOMSize))
-					Index += BOMSize;
-				// Wczytaj dane - skonwertuj z UTF-8 do Unicode
-				wstring TmpWstr;
-				if (!ConvertCharsToUnicode(&TmpWstr, &VS.Data()[Index], (size_t)VS.GetSize() - Index, CP_UTF8))
-					throw Error(_T("Cannot convert UTF-8 to Unicode."), __TFILE__, __LINE__);
-				// Skonwertuj Unicode do ANSI
-				if (!ConvertUnicodeToChars(Out, TmpWstr, CP_ACP))
-					throw Error(_T("Cannot convert Unicode to ANSI."), __TFILE__, __LINE__);
-				// Niestaty musiaem to zrobi tak na dwa razy, nie ma w WinAPI funkcji UTF8 -> ANSI :(
-			}
-			break;
-		case FILE_ENCODING_ANSI:
-			{
-				// Wczytaj dane - tak jak s
-				VS.ReadStringToEnd(Out);
-			}
-			break;
-		default:
-			assert(0 && "LoadUnicodeFromStream: No encoding and no AUTODETECT specified.");
-		}
-	}
-	// Jest automatyczne wykrywanie
-	else
-	{
-		// Wykryj kodowanie
-		size_t BomSize;
-		ENC Enc = DetectEncoding(VS.Data(), (size_t)VS.GetSize(), Encoding & 0xFFFF, &BomSize);
-
-		// Rzu wyjtek, jeli to nieobsugiwane kodowanie
-		if (Enc == ENC_UTF32_LE)
-			throw Error(_T("LoadUnicodeFromStream: UTF-32 LE encoding not supported."), __TFILE__, __LINE__);
-		else if (Enc == ENC_UTF32_BE)
-			throw Error(_T("LoadUnicodeFromStream: UTF-32 BE encoding not supported."), __TFILE__, __LINE__);
-		else if (Enc == ENC_UTF16_BE)
-			throw Error(_T("LoadUnicodeFromStream: UTF-16 BE encoding not supported."), __TFILE__, __LINE__);
-		// Wczytaj dane w znanym kodowaniu
-		else if (Enc == ENC_UTF16_LE)
-		{
-			if (OutEncoding != NULL) *OutEncoding = FILE_ENCODING_UTF16_LE;
-			// Skonwertuj UTF-16 na ANSI
-			if (!ConvertUnicodeToChars(Out, (const wchar_t*)&VS.Data()[BomSize], ((size_t)VS.GetSize() - BomSize) / sizeof(wchar_t), CP_ACP))
-				throw Error(_T("Cannot convert Unicode to ANSI."), __TFILE__, __LINE__);
-		}
-		else if (Enc == ENC_UTF8)
-		{
-			if (OutEncoding != NULL) *OutEncoding = FILE_ENCODING_UTF8;
-			// Wczytaj dane - skonwertuj z UTF-8 do Unicode, potem Unicode do ANSI
-			wstring TmpWstr;
-			if (!ConvertCharsToUnicode(&TmpWstr, &VS.Data()[BomSize], (size_t)VS.GetSize() - BomSize, CP_UTF8) ||
-				!ConvertUnicodeToChars(Out, TmpWstr, CP_ACP))
-			{
-				// Jeli nie udao si jako UTF-8, wczytaj jako ANSI
-				if (OutEncoding != NULL) *OutEncoding = FILE_ENCODING_ANSI;
-				VS.ReadStringToEnd(Out);
-			}
-		}
-		else // if (Enc == ENC_UTF8)
-		{
-			if (OutEncoding != NULL) *OutEncoding = FILE_ENCODING_ANSI;
-			// Wczytaj dane jako ANSI
-			VS.ReadStringToEnd(Out);
-		}
-	}
-
-	ERR_CATCH(_T("Cannot load Unicode characters from stream."));
-}
-
-#endif
-
-
-} // namespace common
+/** \file
+\brief Files and file system handling
+\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
+
+Part of CommonLib library. \n
+Encoding UTF-8, end of line CR+LF \n
+License: GNU LGPL. \n
+Documentation: \ref Module_Files \n
+Module components: \ref code_files
+*/
+#include "Base.hpp"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <stdio.h> // dla unlink [Win, Linux ma go w unistd.h], rename [obydwa]
+#ifdef _WIN32
+	extern "C" {
+		#include <sys/utime.h> // dla utime
+		#include <direct.h> // dla mkdir (Linux ma go w sys/stat.h + sys/types.h)
+	}
+	#include <windows.h>
+#else
+	extern "C" {
+		#include <sys/time.h> // dla utime
+		#include <sys/file.h> // dla flock
+		#include <dirent.h>
+		#include <utime.h> // dla utime
+		#include <fcntl.h> // for openat
+		#include <unistd.h> // for close, syscall
+		#include <sys/syscall.h> // for SYS_getdents64
+		#include <sys/inotify.h>
+		#include <poll.h>
+		#include <time.h> // for clock_gettime
+		#include <sys/mman.h> // for mmap
+	}
+#endif
+#include <stack>
+#include <deque>
+#include <map>
+#include <set>
+#include <list>
+
+#include "Error.hpp"
+#include "Files.hpp"
+#include "DateTime.hpp"
+#include "Threads.hpp"
+
+
+namespace common
+{
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Klasa FileStream
+
+#ifdef _WIN32
+
+	class File_pimpl
+	{
+	public:
+		HANDLE m_File;
+	};
+
+	FileStream::FileStream(const tstring &FileName, FILE_MODE FileMode, bool Lock) :
+		pimpl(new File_pimpl)
+	{
+		uint32 DesiredAccess, ShareMode, CreationDisposition;
+		switch (FileMode)
+		{
+		case FM_WRITE:
+			DesiredAccess = GENERIC_WRITE;
+			ShareMode = 0;
+			CreationDisposition = CREATE_ALWAYS;
+			break;
+		case FM_WRITE_PLUS:
+			DesiredAccess = GENERIC_WRITE | GENERIC_READ;
+			ShareMode = 0;
+			CreationDisposition = CREATE_ALWAYS;
+			break;
+		case FM_READ:
+			DesiredAccess = GENERIC_READ;
+			ShareMode = FILE_SHARE_READ;
+			CreationDisposition = OPEN_EXISTING;
+			break;
+		case FM_READ_PLUS:
+			DesiredAccess = GENERIC_WRITE | GENERIC_READ;
+			ShareMode = 0;
+			CreationDisposition = OPEN_EXISTING;
+			break;
+		case FM_APPEND:
+			DesiredAccess = GENERIC_WRITE;
+			ShareMode = 0;
+			CreationDisposition = OPEN_ALWAYS;
+			break;
+		case FM_APPEND_PLUS:
+			DesiredAccess = GENERIC_WRITE | GENERIC_READ;
+			ShareMode = 0;
+			CreationDisposition = OPEN_ALWAYS;
+			break;
+		}
+		if (!Lock)
+			ShareMode = FILE_SHARE_READ | FILE_SHARE_WRITE;
+
+		pimpl->m_File = CreateFile(FileName.c_str(), DesiredAccess, ShareMode, 0, CreationDisposition, FILE_ATTRIBUTE_NORMAL, 0);
+		if (pimpl->m_File == INVALID_HANDLE_VALUE)
+			throw Win32Error(_T("Cannot open file: ") + FileName, __TFILE__, __LINE__);
+
+		if (FileMode == FM_APPEND || FileMode == FM_APPEND_PLUS)
+			SetPosFromEnd(0);
+	}
+
+	FileStream::~FileStream()
+	{
+		CloseHandle(pimpl->m_File);
+	}
+
+	void FileStream::Write(const void *Data, size_t Size)
+	{
+		uint32 WrittenSize;
+        assert(Size <= (size_t)UINT_MAX);
+		if (WriteFile(pimpl->m_File, Data, (DWORD)Size, (LPDWORD)&WrittenSize, 0) == 0)
+			throw Win32Error(Format(_T("Cannot write # bytes to file.")) % Size, __TFILE__, __LINE__);
+		if ((size_t)WrittenSize != Size)
+			throw Error(Format(_T("Cannot write to file. #/# bytes written.")) % WrittenSize % Size, __TFILE__, __LINE__);
+	}
+
+	size_t FileStream::Read(void *Data, size_t Size)
+	{
+		uint32 ReadSize;
+        assert(Size <= (size_t)UINT_MAX);
+		if (ReadFile(pimpl->m_File, Data, (DWORD)Size, (LPDWORD)&ReadSize, 0) == 0)
+			throw Win32Error(Format(_T("Cannot read # bytes from file.")) % Size, __TFILE__, __LINE__);
+		return (size_t)ReadSize;
+	}
+
+	void FileStream::Flush()
+	{
+		FlushFileBuffers(pimpl->m_File);
+	}
+
+	uint64 FileStream::GetSize()
+	{
+        LARGE_INTEGER i;
+        if(!GetFileSizeEx(pimpl->m_File, &i))
+            throw Win32Error(_T("Cannot get file size."), __TFILE__, __LINE__);
+		return (uint64)i.QuadPart;
+	}
+
+	int64 FileStream::GetPos()
+	{
+        LARGE_INTEGER distanceToMove, newFilePointer;
+        distanceToMove.QuadPart = 0;
+        if(!SetFilePointerEx(pimpl->m_File, distanceToMove, &newFilePointer, FILE_CURRENT))
+			throw Win32Error(_T("Cannot read position from file stream."), __TFILE__, __LINE__);
+        return newFilePointer.QuadPart;
+	}
+
+	void FileStream::SetPos(int64 pos)
+	{
+        LARGE_INTEGER distanceToMove;
+        distanceToMove.QuadPart = pos;
+		if (!SetFilePointerEx(pimpl->m_File, distanceToMove, nullptr, FILE_BEGIN))
+			throw Win32Error(Format(_T("Cannot set position in file stream to # from the beginning.")) % pos, __TFILE__, __LINE__);
+	}
+
+	void FileStream::SetPosFromCurrent(int64 pos)
+	{
+        LARGE_INTEGER distanceToMove;
+        distanceToMove.QuadPart = pos;
+		if (!SetFilePointerEx(pimpl->m_File, distanceToMove, nullptr, FILE_CURRENT))
+			throw Win32Error(Format(_T("Cannot set position in file stream to # from current.")) % pos, __TFILE__, __LINE__);
+	}
+
+	void FileStream::SetPosFromEnd(int64 pos)
+	{
+        LARGE_INTEGER distanceToMove;
+        distanceToMove.QuadPart = pos;
+		if (!SetFilePointerEx(pimpl->m_File, distanceToMove, nullptr, FILE_END))
+			throw Win32Error(Format(_T("Cannot set position in file stream to # from the end.")) % pos, __TFILE__, __LINE__);
+	}
+
+	void FileStream::SetSize(uint64 Size)
+	{
+		int64 SavedPos = GetPos();
+		
+		SetPos((int64)Size);
+		Truncate();
+
+		SetPos(SavedPos);
+	}
+
+	void FileStream::Truncate()
+	{
+		if (SetEndOfFile(pimpl->m_File) == 0)
+			throw Win32Error(_T("Cannot truncate file."), __TFILE__, __LINE__);
+	}
+
+	bool FileStream::End()
+	{
+		// Fuj! Ale to nieeleganckie. Szkoda, że nie ma lepszego sposobu.
+		return GetSize() == (uint64)GetPos();
+	}
+
+	HANDLE FileStream::GetNativeHandle()
+	{
+		return pimpl->m_File;
+	}
+
+#else
+
+	class File_pimpl
+	{
+	public:
+		FILE *m_File;
+		bool m_Lock;
+	};
+
+	FileStream::FileStream(const tstring &FileName, FILE_MODE FileMode, bool Lock) :
+		pimpl(new File_pimpl)
+	{
+		pimpl->m_Lock = Lock;
+
+		const char *m = 0;
+
+		switch (FileMode)
+		{
+		case FM_WRITE:
+			m = "wb";
+			break;
+		case FM_WRITE_PLUS:
+			m = "w+b";
+			break;
+		case FM_READ:
+			m = "rb";
+			break;
+		case FM_READ_PLUS:
+			m = "r+b";
+			break;
+		case FM_APPEND:
+			m = "ab";
+			break;
+		case FM_APPEND_PLUS:
+			m = "a+b";
+			break;
+		}
+
+		pimpl->m_File = fopen(FileName.c_str(), m);
+		if (pimpl->m_File == 0)
+			throw ErrnoError(Format(_T("Cannot open file \"#\" in mode \"#\".")) % FileName % m, __TFILE__, __LINE__);
+		if (Lock)
+		{
+			if (flock(fileno(pimpl->m_File), LOCK_EX | LOCK_NB) != 0)
+				throw ErrnoError(Format(_T("Cannot open file \"#\" in mode \"#\" - error while locking.")) % FileName % m, __TFILE__, __LINE__);
+		}
+	}
+
+	FileStream::~FileStream()
+	{
+		if (pimpl->m_File != 0)
+		{
+			// Kiedy deskryptor int zostaje zamknięty, podobno blokada sama się zwalania. Ale kto tam tego Linuksa wie... :)
+			if (pimpl->m_Lock)
+				flock(fileno(pimpl->m_File), LOCK_UN);
+			fclose(pimpl->m_File);
+		}
+	}
+
+	void FileStream::Write(const void *Data, size_t Size)
+	{
+		size_t Written = fwrite(Data, 1, Size, pimpl->m_File);
+		if (Written != Size || ferror(pimpl->m_File) != 0)
+			throw Error(Format(_T("Cannot write to file. #/# bytes written.")) % Written % Size, __TFILE__, __LINE__);
+	}
+
+	size_t FileStream::Read(void *Data, size_t Size)
+	{
+		size_t BytesRead = fread(Data, 1, Size, pimpl->m_File);
+		if (ferror(pimpl->m_File) != 0)
+			throw Error(Format(_T("Cannot read from file. #/# bytes read.")) % BytesRead % Size, __TFILE__, __LINE__);
+		return BytesRead;
+	}
+
+	void FileStream::Flush()
+	{
+		fflush(pimpl->m_File);
+	}
+
+	uint64 FileStream::GetSize()
+	{
+		// Wersja 1
+		int64 SavedPos = GetPos();
+		SetPosFromEnd(0);
+		int64 EndPos = GetPos();
+		SetPos(SavedPos);
+		return (uint64)EndPos;
+
+		// Ta wersja jest zła bo może nie pokazywać aktualnego rozmiaru, bo jest bufor
+/*		// Wersja 2
+		struct stat s;
+		fstat(fileno(pimpl->m_File), &s);
+		return s.st_size;*/
+	}
+
+	int64 FileStream::GetPos()
+	{
+		int r = ftell(pimpl->m_File);
+		if (r < 0)
+			throw ErrnoError(_T("Cannot get current position in file."), __TFILE__, __LINE__);
+		return r;
+	}
+
+	void FileStream::SetPos(int64 pos)
+	{
+		int r = fseek(pimpl->m_File, (long)pos, SEEK_SET);
+		if (r < 0)
+			throw ErrnoError(Format(_T("Cannot set position in file stream to # from the beginning.")) % pos, __TFILE__, __LINE__);
+	}
+
+	void FileStream::SetPosFromCurrent(int64 pos)
+	{
+		int r = fseek(pimpl->m_File, (long)pos, SEEK_CUR);
+		if (r < 0)
+			throw ErrnoError(Format(_T("Cannot set position in file stream to # from current.")) % pos, __TFILE__, __LINE__);
+	}
+
+	void FileStream::SetPosFromEnd(int pos)
+	{
+		int r = fseek(pimpl->m_File, (long)pos, SEEK_END);
+		if (r < 0)
+			throw ErrnoError(Format(_T("Cannot set position in file stream to # from the end.")) % pos, __TFILE__, __LINE__);
+	}
+
+	void FileStream::SetSize(uint64 Size)
+	{
+		ftruncate(fileno(pimpl->m_File), (off_t)Size);
+	}
+
+	void FileStream::Truncate()
+	{
+		SeekableStream::Truncate();
+	}
+
+	bool FileStream::End()
+	{
+		// Fuj! Ale to nieeleganckie. Szkoda, że nie ma lepszego sposobu.
+		// UWAGA! Jak było zamienione miejscami, najpierw wyliczane GetSize
+		// a potem GetPos to za pierwszym wyliczaniem wychodziło false a dopiero
+		// za drugim true - LOL!
+		return (uint64)GetPos() == GetSize();
+	}
+
+#endif
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Klasa DirLister
+
+class DirLister_pimpl
+{
+private:
+	tstring m_Dir;
+
+	#ifdef _WIN32
+		WIN32_FIND_DATA m_FindData;
+		HANDLE m_Handle;
+		bool m_ReachedEnd;
+
+		void GetFirst();
+		void GetNext();
+
+	#else
+		DIR *m_DirHandle;
+
+	#endif
+
+public:
+	DirLister_pimpl(const tstring &Dir);
+	~DirLister_pimpl();
+
+	bool ReadNext(tstring *OutName, FILE_ITEM_TYPE *OutType);
+};
+
+#ifdef _WIN32
+	void DirLister_pimpl::GetFirst()
+	{
+		tstring Path;
+		IncludeTrailingPathDelimiter(&Path, m_Dir);
+		Path += _T('*');
+		m_Handle = FindFirstFile(Path.c_str(), &m_FindData);
+
+		if (m_Handle == INVALID_HANDLE_VALUE)
+		{
+			if (GetLastError() == ERROR_NO_MORE_FILES)
+				m_ReachedEnd = true;
+			else
+				throw Win32Error(_T("Cannot start directory listing: ") + m_Dir, __TFILE__, __LINE__);
+		}
+		else
+			m_ReachedEnd = false;
+
+		while (!m_ReachedEnd && (m_FindData.cFileName == tstring(_T(".")) || m_FindData.cFileName == tstring(_T(".."))))
+			GetNext();
+	}
+
+	void DirLister_pimpl::GetNext()
+	{
+		if (FindNextFile(m_Handle, &m_FindData) == 0)
+		{
+			if (GetLastError() == ERROR_NO_MORE_FILES)
+				m_ReachedEnd = true;
+			else
+				throw Win32Error(_T("Cannot continue directory listing: ") + m_Dir, __TFILE__, __LINE__);
+		}
+
+		while (!m_ReachedEnd && (m_FindData.cFileName == tstring(_T(".")) || m_FindData.cFileName == tstring(_T(".."))))
+			GetNext();
+	}
+
+	DirLister_pimpl::DirLister_pimpl(const tstring &Dir) :
+		m_Dir(Dir)
+	{
+		GetFirst();
+	}
+
+	DirLister_pimpl::~DirLister_pimpl()
+	{
+		if (m_Handle != INVALID_HANDLE_VALUE)
+			FindClose(m_Handle);
+	}
+
+	bool DirLister_pimpl::ReadNext(tstring *OutName, FILE_ITEM_TYPE *OutType)
+	{
+		if (m_ReachedEnd)
+			return false;
+
+		*OutName = m_FindData.cFileName;
+		*OutType = ( ((m_FindData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0) ? IT_DIR : IT_FILE );
+
+		GetNext();
+
+		return true;
+	}
+
+#else
+	DirLister_pimpl::DirLister_pimpl(const tstring &Dir) :
+		m_Dir(Dir)
+	{
+		m_DirHandle = opendir(Dir.c_str());
+		if (m_DirHandle == NULL)
+			throw ErrnoError(_T("Cannot start directory listing: ") + m_Dir, __TFILE__, __LINE__);
+	}
+
+	DirLister_pimpl::~DirLister_pimpl()
+	{
+		if (m_DirHandle != NULL)
+			closedir(m_DirHandle);
+	}
+
+	bool DirLister_pimpl::ReadNext(tstring *OutName, FILE_ITEM_TYPE *OutType)
+	{
+		dirent DirEnt, *DirEntPtr;
+		if ( readdir_r(m_DirHandle, &DirEnt, &DirEntPtr) != 0 )
+			throw ErrnoError(_T("Cannot continue directory listing: ") + m_Dir, __TFILE__, __LINE__);
+		if (DirEntPtr == NULL)
+			return false;
+		if (strcmp(DirEnt.d_name, _T(".")) == 0 || strcmp(DirEnt.d_name, _T("..")) == 0)
+			return ReadNext(OutName, OutType);
+		*OutName = DirEnt.d_name;
+		*OutType = ( (DirEnt.d_type == DT_DIR) ? IT_DIR : IT_FILE );
+		return true;
+	}
+
+#endif
+
+DirLister::DirLister(const tstring &Dir) :
+	pimpl(new DirLister_pimpl(Dir))
+{
+}
+
+DirLister::~DirLister()
+{
+}
+
+bool DirLister::ReadNext(tstring *OutName, FILE_ITEM_TYPE *OutType)
+{
+	return pimpl->ReadNext(OutName, OutType);
+}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Klasa DirWalker
+
+// Maximum number of full batches waiting for ReadBatch - then scanning tasks wait
+static const size_t DIR_WALKER_MAX_QUEUED_BATCHES = 16;
+
+#ifndef _WIN32
+	// Size of buffer for one getdents64 call
+	static const size_t DIR_WALKER_DIRENTS_BUFFER_SIZE = 64 * 1024;
+	// Maximum number of subdirectories opened by parent task in advance. The rest is opened by path.
+	static const size_t DIR_WALKER_MAX_OPEN_DIRS = 256;
+
+	// Record returned by getdents64. Not declared in system headers.
+	struct LINUX_DIRENT64
+	{
+		uint64 d_ino;
+		int64 d_off;
+		unsigned short d_reclen;
+		unsigned char d_type;
+		char d_name[1];
+	};
+
+	// Closes descriptor on scope exit
+	struct DIR_FD_GUARD
+	{
+		int Fd;
+		DIR_FD_GUARD(int a_Fd) : Fd(a_Fd) { }
+		~DIR_FD_GUARD() { if (Fd >= 0) close(Fd); }
+	};
+#endif
+
+// Directory waiting to be scanned
+struct DIR_WALKER_ITEM
+{
+	// Relative to root, empty for root itself
+	tstring RelPath;
+	#ifndef _WIN32
+		// Directory already opened by parent task or -1
+		int Fd;
+	#endif
+};
+
+class DirWalker_pimpl
+{
+public:
+	tstring m_Root;
+	uint m_Flags;
+	DirWalkerFilter *m_Filter;
+	size_t m_BatchSize;
+	#ifndef _WIN32
+		int m_RootFd;
+	#endif
+
+	Mutex m_Mutex;
+	// Signalled when batch was queued, walk ended or error occurred. ReadBatch waits.
+	Cond m_BatchReadyOrEnd;
+	// Signalled when ReadBatch took a batch or the walk was cancelled. Scanning tasks wait.
+	Cond m_QueueNotFull;
+	std::deque< std::vector<DIR_WALKER_ENTRY> > m_Batches;
+	// Collects small remainders of many directories into one batch
+	std::vector<DIR_WALKER_ENTRY> m_Partial;
+	// Directories queued or being scanned - walk ends when it drops to 0
+	size_t m_PendingDirs;
+	size_t m_OpenDirCount;
+	bool m_Cancel;
+	bool m_HasError;
+	tstring m_ErrorMsg;
+	// Last, so it is destroyed first - waits for tasks which use the members above
+	scoped_ptr<ThreadPool> m_Pool;
+
+	DirWalker_pimpl() : m_Mutex(0), m_PendingDirs(0), m_OpenDirCount(0), m_Cancel(false), m_HasError(false) { }
+
+	void QueueDir(const DIR_WALKER_ITEM &Item);
+	// Called by task. Never throws.
+	void ProcessDir(DIR_WALKER_ITEM &Item);
+
+private:
+	void ScanDir(DIR_WALKER_ITEM &Item, std::vector<DIR_WALKER_ENTRY> *Entries);
+	bool ShouldEnter(const DIR_WALKER_ENTRY &Entry) { return Entry.Type == IT_DIR && (m_Filter == NULL || m_Filter->EnterDir(Entry)); }
+	// Removes last entry of Entries if not accepted by filter, delivers Entries if they make full batch
+	void CommitEntry(std::vector<DIR_WALKER_ENTRY> *Entries);
+	// Moves full batch to the queue, waiting for space
+	void DeliverBatch(std::vector<DIR_WALKER_ENTRY> *Entries);
+	bool IsCancelled() { MUTEX_LOCK(m_Mutex); return m_Cancel; }
+};
+
+// Scans one directory. Created by DirWalker_pimpl::QueueDir, deletes itself at the end of Run, as ThreadPool allows.
+class DirWalkerTask : public ThreadTask
+{
+public:
+	DirWalkerTask(DirWalker_pimpl *Walker, const DIR_WALKER_ITEM &Item) : m_Walker(Walker), m_Item(Item) { }
+
+	virtual void Run()
+	{
+		m_Walker->ProcessDir(m_Item);
+		delete this;
+	}
+
+private:
+	DirWalker_pimpl *m_Walker;
+	DIR_WALKER_ITEM m_Item;
+};
+
+void DirWalker_pimpl::QueueDir(const DIR_WALKER_ITEM &Item)
+{
+	// Under the lock, so that no task is added after the destructor set m_Cancel and started destroying m_Pool
+	MUTEX_LOCK(m_Mutex);
+	if (m_Cancel)
+	{
+	#ifndef _WIN32
+		if (Item.Fd >= 0)
+		{
+			close(Item.Fd);
+			m_OpenDirCount--;
+		}
+	#endif
+		return;
+	}
+	m_PendingDirs++;
+	m_Pool->AddTask(new DirWalkerTask(this, Item));
+}
+
+void DirWalker_pimpl::ProcessDir(DIR_WALKER_ITEM &Item)
+{
+	std::vector<DIR_WALKER_ENTRY> Entries;
+	tstring ErrorMsg;
+	bool Failed = false;
+	try
+	{
+		ScanDir(Item, &Entries);
+	}
+	catch (const Error &e)
+	{
+		e.GetMessage_(&ErrorMsg);
+		Failed = true;
+	}
+	catch (...)
+	{
+		ErrorMsg = _T("Unknown exception in DirWalker.");
+		Failed = true;
+	}
+
+	MUTEX_LOCK(m_Mutex);
+	if (Failed && !m_HasError)
+	{
+		m_HasError = true;
+		m_ErrorMsg = ErrorMsg;
+		m_Cancel = true;
+		m_QueueNotFull.Broadcast();
+	}
+	// Entries and m_Partial are both smaller than a batch, so at most one batch is queued below
+	while (m_Batches.size() >= DIR_WALKER_MAX_QUEUED_BATCHES && !m_Cancel)
+		m_QueueNotFull.Wait(&m_Mutex);
+	if (!m_Cancel)
+	{
+		for (size_t i = 0; i < Entries.size(); i++)
+		{
+			m_Partial.push_back(DIR_WALKER_ENTRY());
+			DIR_WALKER_ENTRY &Entry = m_Partial.back();
+			Entry.Path.swap(Entries[i].Path);
+			Entry.Type = Entries[i].Type;
+			Entry.Size = Entries[i].Size;
+			Entry.ModificationTime = Entries[i].ModificationTime;
+			if (m_Partial.size() == m_BatchSize)
+			{
+				m_Batches.push_back(std::vector<DIR_WALKER_ENTRY>());
+				m_Batches.back().swap(m_Partial);
+			}
+		}
+	}
+	if (--m_PendingDirs == 0 || !m_Batches.empty() || m_HasError)
+		m_BatchReadyOrEnd.Broadcast();
+}
+
+void DirWalker_pimpl::DeliverBatch(std::vector<DIR_WALKER_ENTRY> *Entries)
+{
+	MUTEX_LOCK(m_Mutex);
+	while (m_Batches.size() >= DIR_WALKER_MAX_QUEUED_BATCHES && !m_Cancel)
+		m_QueueNotFull.Wait(&m_Mutex);
+	if (!m_Cancel)
+	{
+		m_Batches.push_back(std::vector<DIR_WALKER_ENTRY>());
+		m_Batches.back().swap(*Entries);
+		m_BatchReadyOrEnd.Broadcast();
+	}
+	Entries->clear();
+}
+
+void DirWalker_pimpl::CommitEntry(std::vector<DIR_WALKER_ENTRY> *Entries)
+{
+	if (m_Filter != NULL && !m_Filter->Accept(Entries->back()))
+		Entries->pop_back();
+	else if (Entries->size() >= m_BatchSize)
+		DeliverBatch(Entries);
+}
+
+#ifdef _WIN32
+
+	void DirWalker_pimpl::ScanDir(DIR_WALKER_ITEM &Item, std::vector<DIR_WALKER_ENTRY> *Entries)
+	{
+		if (IsCancelled())
+			return;
+
+		tstring Prefix;
+		if (!Item.RelPath.empty())
+		{
+			Prefix = Item.RelPath;
+			Prefix += DIR_SEP;
+		}
+		tstring Pattern;
+		IncludeTrailingPathDelimiter(&Pattern, m_Root);
+		Pattern += Prefix;
+		Pattern += _T('*');
+
+		WIN32_FIND_DATA FindData;
+	#ifdef FIND_FIRST_EX_LARGE_FETCH
+		// Short names are not needed and bigger buffer means fewer calls to the file system
+		HANDLE Handle = FindFirstFileEx(Pattern.c_str(), FindExInfoBasic, &FindData, FindExSearchNameMatch, NULL, FIND_FIRST_EX_LARGE_FETCH);
+	#else
+		HANDLE Handle = FindFirstFileEx(Pattern.c_str(), FindExInfoStandard, &FindData, FindExSearchNameMatch, NULL, 0);
+	#endif
+		if (Handle == INVALID_HANDLE_VALUE)
+		{
+			DWORD Err = GetLastError();
+			// Directory deleted during the walk is not an error
+			if (Err == ERROR_FILE_NOT_FOUND || Err == ERROR_PATH_NOT_FOUND || Err == ERROR_NO_MORE_FILES || (m_Flags & DirWalker::FLAG_IGNORE_ERRORS) != 0)
+				return;
+			throw Win32Error(_T("Cannot start directory listing: ") + Pattern, __TFILE__, __LINE__);
+		}
+
+		try
+		{
+			do
+			{
+				if (_tcscmp(FindData.cFileName, _T(".")) == 0 || _tcscmp(FindData.cFileName, _T("..")) == 0)
+					continue;
+
+				Entries->push_back(DIR_WALKER_ENTRY());
+				DIR_WALKER_ENTRY &Entry = Entries->back();
+				Entry.Path = Prefix;
+				Entry.Path += FindData.cFileName;
+				// Junctions and symbolic links to directories are not followed, like on Linux
+				Entry.Type = ( ((FindData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0 && (FindData.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) == 0) ? IT_DIR : IT_FILE );
+				Entry.Size = 0;
+				Entry.ModificationTime.SetValue(0);
+				if (m_Flags & DirWalker::FLAG_STAT)
+				{
+					Entry.Size = ((uint64)FindData.nFileSizeHigh << 32) | FindData.nFileSizeLow;
+					// FILETIME counts 100 ns intervals since 1601
+					uint64 FileTime = ((uint64)FindData.ftLastWriteTime.dwHighDateTime << 32) | FindData.ftLastWriteTime.dwLowDateTime;
+					Entry.ModificationTime.SetValue((int64)(FileTime / 10000) - 11644473600000LL);
+				}
+
+				if (ShouldEnter(Entry))
+				{
+					DIR_WALKER_ITEM SubDir;
+					SubDir.RelPath = Entry.Path;
+					QueueDir(SubDir);
+				}
+				CommitEntry(Entries);
+			}
+			while (!IsCancelled() && FindNextFile(Handle, &FindData) != 0);
+
+			if (!IsCancelled() && GetLastError() != ERROR_NO_MORE_FILES && (m_Flags & DirWalker::FLAG_IGNORE_ERRORS) == 0)
+				throw Win32Error(_T("Cannot continue directory listing: ") + Pattern, __TFILE__, __LINE__);
+		}
+		catch (...)
+		{
+			FindClose(Handle);
+			throw;
+		}
+		FindClose(Handle);
+	}
+
+#else
+
+	// Fills Type, Size and ModificationTime. Returns false if entry doesn't exist any more.
+	static bool DirWalkerStat(int DirFd, const char *Name, DIR_WALKER_ENTRY *Entry, bool IgnoreErrors)
+	{
+		mode_t Mode;
+	#ifdef STATX_TYPE
+		// Only needed fields are requested and file system doesn't have to synchronize them
+		struct statx S;
+		if (statx(DirFd, Name, AT_SYMLINK_NOFOLLOW | AT_NO_AUTOMOUNT | AT_STATX_DONT_SYNC, STATX_TYPE | STATX_SIZE | STATX_MTIME, &S) != 0)
+	#else
+		struct stat S;
+		if (fstatat(DirFd, Name, &S, AT_SYMLINK_NOFOLLOW) != 0)
+	#endif
+		{
+			if (errno == ENOENT || IgnoreErrors)
+				return false;
+			throw ErrnoError(_T("Cannot obtain information about: ") + Entry->Path, __TFILE__, __LINE__);
+		}
+	#ifdef STATX_TYPE
+		Mode = S.stx_mode;
+		Entry->Size = S.stx_size;
+		Entry->ModificationTime.SetValue((int64)S.stx_mtime.tv_sec * 1000 + S.stx_mtime.tv_nsec / 1000000);
+	#else
+		Mode = S.st_mode;
+		Entry->Size = (uint64)S.st_size;
+		Entry->ModificationTime.SetValue((int64)S.st_mtim.tv_sec * 1000 + S.st_mtim.tv_nsec / 1000000);
+	#endif
+		Entry->Type = ( S_ISDIR(Mode) ? IT_DIR : IT_FILE );
+		return true;
+	}
+
+	void DirWalker_pimpl::ScanDir(DIR_WALKER_ITEM &Item, std::vector<DIR_WALKER_ENTRY> *Entries)
+	{
+		if (Item.Fd >= 0)
+		{
+			MUTEX_LOCK(m_Mutex);
+			m_OpenDirCount--;
+		}
+		DIR_FD_GUARD Dir(Item.Fd);
+		if (IsCancelled())
+			return;
+
+		bool IgnoreErrors = (m_Flags & DirWalker::FLAG_IGNORE_ERRORS) != 0;
+		if (Dir.Fd < 0)
+		{
+			Dir.Fd = openat(m_RootFd, Item.RelPath.empty() ? "." : Item.RelPath.c_str(), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+			if (Dir.Fd < 0)
+			{
+				// Directory deleted during the walk is not an error
+				if (errno == ENOENT || IgnoreErrors)
+					return;
+				throw ErrnoError(_T("Cannot start directory listing: ") + Item.RelPath, __TFILE__, __LINE__);
+			}
+		}
+
+		tstring Prefix;
+		if (!Item.RelPath.empty())
+		{
+			Prefix = Item.RelPath;
+			Prefix += DIR_SEP;
+		}
+
+		std::vector<char> Buf(DIR_WALKER_DIRENTS_BUFFER_SIZE);
+		while (!IsCancelled())
+		{
+			long Length = syscall(SYS_getdents64, Dir.Fd, &Buf[0], Buf.size());
+			if (Length == 0)
+				break;
+			if (Length < 0)
+			{
+				if (IgnoreErrors)
+					break;
+				throw ErrnoError(_T("Cannot continue directory listing: ") + Item.RelPath, __TFILE__, __LINE__);
+			}
+
+			for (long Offset = 0; Offset < Length; )
+			{
+				const LINUX_DIRENT64 *DirEnt = (const LINUX_DIRENT64*)&Buf[Offset];
+				Offset += DirEnt->d_reclen;
+				const char *Name = DirEnt->d_name;
+				if (Name[0] == '.' && (Name[1] == '\0' || (Name[1] == '.' && Name[2] == '\0')))
+					continue;
+
+				Entries->push_back(DIR_WALKER_ENTRY());
+				DIR_WALKER_ENTRY &Entry = Entries->back();
+				Entry.Path = Prefix;
+				Entry.Path += Name;
+				Entry.Type = ( (DirEnt->d_type == DT_DIR) ? IT_DIR : IT_FILE );
+				Entry.Size = 0;
+				Entry.ModificationTime.SetValue(0);
+				// Some file systems don't fill d_type
+				if ((m_Flags & DirWalker::FLAG_STAT) != 0 || DirEnt->d_type == DT_UNKNOWN)
+				{
+					if (!DirWalkerStat(Dir.Fd, Name, &Entry, IgnoreErrors))
+					{
+						Entries->pop_back();
+						continue;
+					}
+				}
+
+				if (ShouldEnter(Entry))
+				{
+					DIR_WALKER_ITEM SubDir;
+					SubDir.RelPath = Entry.Path;
+					SubDir.Fd = -1;
+					// Opening relative to this directory saves resolving the whole path again
+					bool CanOpen;
+					{
+						MUTEX_LOCK(m_Mutex);
+						CanOpen = (m_OpenDirCount < DIR_WALKER_MAX_OPEN_DIRS);
+						if (CanOpen)
+							m_OpenDirCount++;
+					}
+					if (CanOpen)
+					{
+						SubDir.Fd = openat(Dir.Fd, Name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+						if (SubDir.Fd < 0)
+						{
+							// Task will try again by path and report the error
+							MUTEX_LOCK(m_Mutex);
+							m_OpenDirCount--;
+						}
+					}
+					QueueDir(SubDir);
+				}
+				CommitEntry(Entries);
+			}
+		}
+	}
+
+#endif
+
+DirWalker::DirWalker(const tstring &Root, uint Flags, DirWalkerFilter *Filter, uint ThreadCount, size_t BatchSize) :
+	pimpl(new DirWalker_pimpl)
+{
+	if (BatchSize == 0)
+		throw Error(_T("DirWalker batch size cannot be 0."), __TFILE__, __LINE__);
+
+	pimpl->m_Root = Root;
+	pimpl->m_Flags = Flags;
+	pimpl->m_Filter = Filter;
+	pimpl->m_BatchSize = BatchSize;
+
+#ifdef _WIN32
+	if (GetFileItemType(Root) != IT_DIR)
+		throw Error(_T("Cannot start directory walk: ") + Root, __TFILE__, __LINE__);
+#else
+	pimpl->m_RootFd = open(Root.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+	if (pimpl->m_RootFd < 0)
+		throw ErrnoError(_T("Cannot start directory walk: ") + Root, __TFILE__, __LINE__);
+#endif
+
+	pimpl->m_Pool.reset(new ThreadPool(ThreadCount));
+
+	DIR_WALKER_ITEM RootItem;
+#ifndef _WIN32
+	RootItem.Fd = -1;
+#endif
+	pimpl->QueueDir(RootItem);
+}
+
+DirWalker::~DirWalker()
+{
+	{
+		MUTEX_LOCK(pimpl->m_Mutex);
+		pimpl->m_Cancel = true;
+		pimpl->m_QueueNotFull.Broadcast();
+	}
+	// Remaining tasks see m_Cancel and only release their directories
+	pimpl->m_Pool.reset();
+#ifndef _WIN32
+	close(pimpl->m_RootFd);
+#endif
+}
+
+bool DirWalker::ReadBatch(std::vector<DIR_WALKER_ENTRY> *OutEntries)
+{
+	MUTEX_LOCK(pimpl->m_Mutex);
+	while (pimpl->m_Batches.empty() && pimpl->m_PendingDirs > 0 && !pimpl->m_HasError)
+		pimpl->m_BatchReadyOrEnd.Wait(&pimpl->m_Mutex);
+
+	if (pimpl->m_HasError)
+		throw Error(pimpl->m_ErrorMsg, __TFILE__, __LINE__);
+
+	OutEntries->clear();
+	if (!pimpl->m_Batches.empty())
+	{
+		OutEntries->swap(pimpl->m_Batches.front());
+		pimpl->m_Batches.pop_front();
+		pimpl->m_QueueNotFull.Signal();
+		return true;
+	}
+	// All directories done - the last incomplete batch
+	if (pimpl->m_Partial.empty())
+		return false;
+	OutEntries->swap(pimpl->m_Partial);
+	return true;
+}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Klasa FileWatcher
+
+// Collected events are delivered at the latest after this many coalesce times since the first one
+static const uint FILE_WATCHER_MAX_DELAY_FACTOR = 10;
+
+static void FileWatcherJoinPath(tstring *Out, const tstring &Dir, const tstring &Name)
+{
+	*Out = Dir;
+	if (!Dir.empty())
+		*Out += DIR_SEP;
+	*Out += Name;
+}
+
+// Merges events about the same path, keeping their order
+class FileWatcherCoalescer
+{
+public:
+	FileWatcherCoalescer() : m_LiveCount(0) { }
+
+	bool IsEmpty() const { return m_LiveCount == 0; }
+	void Add(const FILE_WATCHER_EVENT &Event);
+	// Appends all events to Out and clears
+	void Take(std::vector<FILE_WATCHER_EVENT> *Out);
+
+private:
+	struct ITEM
+	{
+		FILE_WATCHER_EVENT Event;
+		bool Removed;
+	};
+	typedef std::map<tstring, size_t> INDEX_MAP;
+
+	std::vector<ITEM> m_Items;
+	// Path -> index of the latest item about this path, which later events can be merged into
+	INDEX_MAP m_Index;
+	size_t m_LiveCount;
+
+	void Append(const FILE_WATCHER_EVENT &Event, bool Indexed);
+	void Remove(INDEX_MAP::iterator It);
+};
+
+void FileWatcherCoalescer::Append(const FILE_WATCHER_EVENT &Event, bool Indexed)
+{
+	m_Items.push_back(ITEM());
+	m_Items.back().Event = Event;
+	m_Items.back().Removed = false;
+	m_LiveCount++;
+	if (Indexed)
+		m_Index[Event.Path] = m_Items.size() - 1;
+}
+
+void FileWatcherCoalescer::Remove(INDEX_MAP::iterator It)
+{
+	m_Items[It->second].Removed = true;
+	m_LiveCount--;
+	m_Index.erase(It);
+}
+
+void FileWatcherCoalescer::Add(const FILE_WATCHER_EVENT &Event)
+{
+	if (Event.Action == FWA_OVERFLOW)
+	{
+		Append(Event, false);
+		return;
+	}
+
+	if (Event.Action == FWA_MOVED)
+	{
+		INDEX_MAP::iterator OldIt = m_Index.find(Event.OldPath);
+		if (OldIt != m_Index.end())
+		{
+			// File created and then renamed - just created under the new name.
+			// Not for directories, because events about their contents use the old path.
+			if (m_Items[OldIt->second].Event.Action == FWA_CREATED && Event.Type == IT_FILE)
+			{
+				Remove(OldIt);
+				FILE_WATCHER_EVENT Created = Event;
+				Created.Action = FWA_CREATED;
+				Created.OldPath.clear();
+				Add(Created);
+				return;
+			}
+			// Old path doesn't exist any more - nothing can be merged with its events
+			m_Index.erase(OldIt);
+		}
+		Append(Event, true);
+		return;
+	}
+
+	INDEX_MAP::iterator It = m_Index.find(Event.Path);
+	if (It != m_Index.end())
+	{
+		FILE_WATCHER_EVENT &Prev = m_Items[It->second].Event;
+		if (Prev.Type == Event.Type)
+		{
+			switch (Prev.Action)
+			{
+			case FWA_CREATED:
+				// Created and deleted in the meantime - nothing to report
+				if (Event.Action == FWA_DELETED)
+					Remove(It);
+				// Modified after creation - still just created
+				return;
+			case FWA_MODIFIED:
+				if (Event.Action == FWA_DELETED)
+				{
+					Prev.Action = FWA_DELETED;
+					return;
+				}
+				if (Event.Action == FWA_MODIFIED)
+					return;
+				break;
+			case FWA_DELETED:
+				// File replaced with a new one, e.g. saved by writing new file and renaming it
+				if (Event.Action == FWA_CREATED && Event.Type == IT_FILE)
+				{
+					Prev.Action = FWA_MODIFIED;
+					return;
+				}
+				break;
+			default:
+				break;
+			}
+		}
+	}
+	Append(Event, true);
+}
+
+void FileWatcherCoalescer::Take(std::vector<FILE_WATCHER_EVENT> *Out)
+{
+	Out->reserve(Out->size() + m_LiveCount);
+	for (size_t i = 0; i < m_Items.size(); i++)
+	{
+		if (!m_Items[i].Removed)
+		{
+			Out->push_back(FILE_WATCHER_EVENT());
+			FILE_WATCHER_EVENT &Dst = Out->back();
+			Dst.Action = m_Items[i].Event.Action;
+			Dst.Type = m_Items[i].Event.Type;
+			Dst.Path.swap(m_Items[i].Event.Path);
+			Dst.OldPath.swap(m_Items[i].Event.OldPath);
+		}
+	}
+	m_Items.clear();
+	m_Index.clear();
+	m_LiveCount = 0;
+}
+
+// State of a single item in polling mode
+struct FILE_WATCHER_POLL_ITEM
+{
+	FILE_ITEM_TYPE Type;
+	uint64 Size;
+	DATETIME ModificationTime;
+};
+
+class FileWatcherThread;
+
+class FileWatcher_pimpl
+{
+public:
+	typedef std::map<tstring, FILE_WATCHER_POLL_ITEM> SNAPSHOT;
+
+	tstring m_Root;
+	FileWatcherCallback *m_Callback;
+	uint m_CoalesceTime;
+	uint m_PollInterval;
+
+	Mutex m_Mutex;
+	// Signalled when events were queued, error occurred or the thread should end
+	Cond m_Cond;
+	// Changed by the thread when it falls back to polling
+	bool m_Polling;
+	bool m_Exit;
+	bool m_HasError;
+	tstring m_ErrorMsg;
+	// Events waiting for GetEvents, only without callback
+	FileWatcherCoalescer m_Queue;
+
+	// ----- Used only by the thread after the constructor -----
+	// Events not delivered yet
+	FileWatcherCoalescer m_Pending;
+	// Polling mode only
+	SNAPSHOT m_Snapshot;
+
+#ifndef _WIN32
+	int m_InotifyFd;
+	// Writing to it wakes the thread blocked in poll
+	int m_WakePipe[2];
+	// Guards m_WatchPaths and m_WatchLimitReached - filled also from DirWalker threads
+	Mutex m_WatchMutex;
+	// Watch descriptor -> path of the directory relative to root
+	std::map<int, tstring> m_WatchPaths;
+	bool m_WatchLimitReached;
+#endif
+
+	scoped_ptr<FileWatcherThread> m_Thread;
+
+	FileWatcher_pimpl();
+	~FileWatcher_pimpl();
+
+	void TakeSnapshot(SNAPSHOT *Out);
+	void ThreadFunc();
+
+#ifndef _WIN32
+	// Adds watch to a directory. Returns false if it cannot be watched.
+	bool AddWatch(const tstring &RelPath);
+	// Adds watches to RelDir and all its subdirectories. With ReportContents, items inside are reported as created.
+	void WatchTree(const tstring &RelDir, bool ReportContents);
+	void UnwatchTree(const tstring &RelDir);
+	void RenameWatchedTree(const tstring &OldRelDir, const tstring &NewRelDir);
+	bool IsWatchLimitReached() { MUTEX_LOCK(m_WatchMutex); return m_WatchLimitReached; }
+#endif
+
+private:
+	void PollLoop();
+	// Sends events from m_Pending to the callback or the queue
+	void Flush();
+#ifndef _WIN32
+	// Returns false when the thread should switch to polling
+	bool InotifyLoop();
+	void ProcessInotifyEvents(char *Buf, size_t Size, std::map<uint32, FILE_WATCHER_EVENT> *MovesFrom);
+#endif
+};
+
+class FileWatcherThread : public Thread
+{
+private:
+	FileWatcher_pimpl *m_Pimpl;
+
+protected:
+	virtual void Run() { m_Pimpl->ThreadFunc(); }
+
+public:
+	FileWatcherThread(FileWatcher_pimpl *Pimpl) : m_Pimpl(Pimpl) { }
+};
+
+FileWatcher_pimpl::FileWatcher_pimpl() :
+	m_Mutex(0),
+	m_Polling(false),
+	m_Exit(false),
+	m_HasError(false)
+#ifndef _WIN32
+	, m_InotifyFd(-1)
+	, m_WatchMutex(0)
+	, m_WatchLimitReached(false)
+#endif
+{
+#ifndef _WIN32
+	m_WakePipe[0] = m_WakePipe[1] = -1;
+#endif
+}
+
+FileWatcher_pimpl::~FileWatcher_pimpl()
+{
+#ifndef _WIN32
+	if (m_InotifyFd >= 0)
+		close(m_InotifyFd);
+	if (m_WakePipe[0] >= 0)
+		close(m_WakePipe[0]);
+	if (m_WakePipe[1] >= 0)
+		close(m_WakePipe[1]);
+#endif
+}
+
+void FileWatcher_pimpl::TakeSnapshot(SNAPSHOT *Out)
+{
+	Out->clear();
+	DirWalker Walker(m_Root, DirWalker::FLAG_STAT | DirWalker::FLAG_IGNORE_ERRORS);
+	std::vector<DIR_WALKER_ENTRY> Batch;
+	while (Walker.ReadBatch(&Batch))
+	{
+		for (size_t i = 0; i < Batch.size(); i++)
+		{
+			FILE_WATCHER_POLL_ITEM &Item = (*Out)[Batch[i].Path];
+			Item.Type = Batch[i].Type;
+			Item.Size = Batch[i].Size;
+			Item.ModificationTime = Batch[i].ModificationTime;
+		}
+	}
+}
+
+void FileWatcher_pimpl::Flush()
+{
+	if (m_Pending.IsEmpty())
+		return;
+
+	if (m_Callback != NULL)
+	{
+		std::vector<FILE_WATCHER_EVENT> Events;
+		m_Pending.Take(&Events);
+		m_Callback->OnFileEvents(Events);
+	}
+	else
+	{
+		std::vector<FILE_WATCHER_EVENT> Events;
+		m_Pending.Take(&Events);
+		MUTEX_LOCK(m_Mutex);
+		// Merged also with events still waiting for GetEvents
+		for (size_t i = 0; i < Events.size(); i++)
+			m_Queue.Add(Events[i]);
+		m_Cond.Broadcast();
+	}
+}
+
+void FileWatcher_pimpl::PollLoop()
+{
+	SNAPSHOT NewSnapshot;
+	for (;;)
+	{
+		{
+			MUTEX_LOCK(m_Mutex);
+			if (!m_Exit)
+				m_Cond.TimeoutWait(&m_Mutex, m_PollInterval);
+			if (m_Exit)
+				return;
+		}
+
+		TakeSnapshot(&NewSnapshot);
+
+		FILE_WATCHER_EVENT Event;
+		// Deletions first, in reverse order, so contents go before their directory
+		for (SNAPSHOT::reverse_iterator OldIt = m_Snapshot.rbegin(); OldIt != m_Snapshot.rend(); ++OldIt)
+		{
+			SNAPSHOT::iterator NewIt = NewSnapshot.find(OldIt->first);
+			if (NewIt == NewSnapshot.end() || NewIt->second.Type != OldIt->second.Type)
+			{
+				Event.Action = FWA_DELETED;
+				Event.Path = OldIt->first;
+				Event.Type = OldIt->second.Type;
+				m_Pending.Add(Event);
+			}
+		}
+		for (SNAPSHOT::iterator NewIt = NewSnapshot.begin(); NewIt != NewSnapshot.end(); ++NewIt)
+		{
+			SNAPSHOT::iterator OldIt = m_Snapshot.find(NewIt->first);
+			if (OldIt == m_Snapshot.end() || OldIt->second.Type != NewIt->second.Type)
+				Event.Action = FWA_CREATED;
+			else if (NewIt->second.Type == IT_FILE &&
+				(OldIt->second.Size != NewIt->second.Size || OldIt->second.ModificationTime != NewIt->second.ModificationTime))
+				Event.Action = FWA_MODIFIED;
+			else
+				continue;
+			Event.Path = NewIt->first;
+			Event.Type = NewIt->second.Type;
+			m_Pending.Add(Event);
+		}
+		m_Snapshot.swap(NewSnapshot);
+
+		Flush();
+	}
+}
+
+void FileWatcher_pimpl::ThreadFunc()
+{
+	try
+	{
+	#ifndef _WIN32
+		if (!m_Polling)
+		{
+			if (InotifyLoop())
+				return;
+			// Watch limit reached - some directories are not watched, so all changes must be found by polling
+			{
+				MUTEX_LOCK(m_Mutex);
+				m_Polling = true;
+			}
+			close(m_InotifyFd);
+			m_InotifyFd = -1;
+			TakeSnapshot(&m_Snapshot);
+			FILE_WATCHER_EVENT Event;
+			Event.Action = FWA_OVERFLOW;
+			Event.Type = IT_NONE;
+			m_Pending.Add(Event);
+			Flush();
+		}
+	#endif
+		PollLoop();
+	}
+	catch (const Error &e)
+	{
+		MUTEX_LOCK(m_Mutex);
+		m_HasError = true;
+		e.GetMessage_(&m_ErrorMsg);
+		m_Cond.Broadcast();
+	}
+	catch (...)
+	{
+		MUTEX_LOCK(m_Mutex);
+		m_HasError = true;
+		m_ErrorMsg = _T("Unknown exception in FileWatcher.");
+		m_Cond.Broadcast();
+	}
+}
+
+#ifndef _WIN32
+
+	static const uint32 FILE_WATCHER_INOTIFY_MASK =
+		IN_CREATE | IN_DELETE | IN_MODIFY | IN_ATTRIB | IN_MOVED_FROM | IN_MOVED_TO |
+		IN_ONLYDIR | IN_DONT_FOLLOW | IN_EXCL_UNLINK;
+
+	// Milliseconds from unspecified moment
+	static uint64 FileWatcherTicks()
+	{
+		struct timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return (uint64)ts.tv_sec * 1000 + (uint64)ts.tv_nsec / 1000000;
+	}
+
+	// Adds inotify watches to directories before DirWalker scans them,
+	// so items created in the meantime are either listed or reported by inotify.
+	class FileWatcherDirFilter : public DirWalkerFilter
+	{
+	public:
+		FileWatcherDirFilter(FileWatcher_pimpl *Watcher, const tstring &RelDir, bool ReportContents) :
+			m_Watcher(Watcher), m_RelDir(RelDir), m_ReportContents(ReportContents) { }
+
+		virtual bool Accept(const DIR_WALKER_ENTRY &Entry) { return m_ReportContents; }
+		virtual bool EnterDir(const DIR_WALKER_ENTRY &Entry)
+		{
+			tstring RelPath;
+			FileWatcherJoinPath(&RelPath, m_RelDir, Entry.Path);
+			return m_Watcher->AddWatch(RelPath);
+		}
+
+	private:
+		FileWatcher_pimpl *m_Watcher;
+		const tstring &m_RelDir;
+		bool m_ReportContents;
+	};
+
+	bool FileWatcher_pimpl::AddWatch(const tstring &RelPath)
+	{
+		tstring FullPath;
+		FileWatcherJoinPath(&FullPath, m_Root, RelPath);
+		int Wd = inotify_add_watch(m_InotifyFd, FullPath.c_str(), FILE_WATCHER_INOTIFY_MASK);
+		if (Wd < 0)
+		{
+			if (errno == ENOSPC)
+			{
+				MUTEX_LOCK(m_WatchMutex);
+				m_WatchLimitReached = true;
+			}
+			// Other errors mean directory was deleted or is not accessible - it cannot change anyway
+			return false;
+		}
+		MUTEX_LOCK(m_WatchMutex);
+		m_WatchPaths[Wd] = RelPath;
+		return true;
+	}
+
+	void FileWatcher_pimpl::WatchTree(const tstring &RelDir, bool ReportContents)
+	{
+		if (!AddWatch(RelDir))
+			return;
+		tstring FullPath;
+		FileWatcherJoinPath(&FullPath, m_Root, RelDir);
+		FileWatcherDirFilter Filter(this, RelDir, ReportContents);
+		std::vector<DIR_WALKER_ENTRY> Batch;
+		try
+		{
+			DirWalker Walker(FullPath, DirWalker::FLAG_IGNORE_ERRORS, &Filter);
+			FILE_WATCHER_EVENT Event;
+			Event.Action = FWA_CREATED;
+			while (Walker.ReadBatch(&Batch))
+			{
+				for (size_t i = 0; i < Batch.size(); i++)
+				{
+					FileWatcherJoinPath(&Event.Path, RelDir, Batch[i].Path);
+					Event.Type = Batch[i].Type;
+					m_Pending.Add(Event);
+				}
+			}
+		}
+		catch (const Error &)
+		{
+			// Directory disappeared in the meantime - its deletion will be reported by inotify
+			if (GetFileItemType(FullPath) == IT_DIR)
+				throw;
+		}
+	}
+
+	void FileWatcher_pimpl::UnwatchTree(const tstring &RelDir)
+	{
+		tstring Prefix = RelDir;
+		Prefix += DIR_SEP;
+		MUTEX_LOCK(m_WatchMutex);
+		std::map<int, tstring>::iterator It = m_WatchPaths.begin();
+		while (It != m_WatchPaths.end())
+		{
+			if (It->second == RelDir || StrBegins(It->second, Prefix, true))
+			{
+				// Watch stays on the directory moved outside, so it must be removed explicitly
+				inotify_rm_watch(m_InotifyFd, It->first);
+				m_WatchPaths.erase(It++);
+			}
+			else
+				++It;
+		}
+	}
+
+	void FileWatcher_pimpl::RenameWatchedTree(const tstring &OldRelDir, const tstring &NewRelDir)
+	{
+		tstring Prefix = OldRelDir;
+		Prefix += DIR_SEP;
+		MUTEX_LOCK(m_WatchMutex);
+		for (std::map<int, tstring>::iterator It = m_WatchPaths.begin(); It != m_WatchPaths.end(); ++It)
+		{
+			if (It->second == OldRelDir)
+				It->second = NewRelDir;
+			else if (StrBegins(It->second, Prefix, true))
+				It->second = NewRelDir + It->second.substr(OldRelDir.length());
+		}
+	}
+
+	void FileWatcher_pimpl::ProcessInotifyEvents(char *Buf, size_t Size, std::map<uint32, FILE_WATCHER_EVENT> *MovesFrom)
+	{
+		FILE_WATCHER_EVENT Event;
+		tstring DirPath;
+		for (size_t Offset = 0; Offset < Size; )
+		{
+			const struct inotify_event *InEvent = (const struct inotify_event*)(Buf + Offset);
+			Offset += sizeof(struct inotify_event) + InEvent->len;
+
+			if (InEvent->mask & IN_Q_OVERFLOW)
+			{
+				Event.Action = FWA_OVERFLOW;
+				Event.Path.clear();
+				Event.Type = IT_NONE;
+				m_Pending.Add(Event);
+				// Directories created meanwhile may be missing watches
+				WatchTree(tstring(), false);
+				continue;
+			}
+			if (InEvent->mask & IN_IGNORED)
+			{
+				MUTEX_LOCK(m_WatchMutex);
+				m_WatchPaths.erase(InEvent->wd);
+				continue;
+			}
+			if (InEvent->len == 0)
+				// Event about the watched directory itself - reported by its parent
+				continue;
+
+			{
+				MUTEX_LOCK(m_WatchMutex);
+				std::map<int, tstring>::iterator It = m_WatchPaths.find(InEvent->wd);
+				if (It == m_WatchPaths.end())
+					// Already removed watch
+					continue;
+				DirPath = It->second;
+			}
+			FileWatcherJoinPath(&Event.Path, DirPath, tstring(InEvent->name));
+			Event.OldPath.clear();
+			Event.Type = (InEvent->mask & IN_ISDIR) ? IT_DIR : IT_FILE;
+
+			if (InEvent->mask & IN_CREATE)
+			{
+				Event.Action = FWA_CREATED;
+				m_Pending.Add(Event);
+				if (Event.Type == IT_DIR)
+					WatchTree(Event.Path, true);
+			}
+			else if (InEvent->mask & IN_DELETE)
+			{
+				Event.Action = FWA_DELETED;
+				m_Pending.Add(Event);
+			}
+			else if (InEvent->mask & (IN_MODIFY | IN_ATTRIB))
+			{
+				if (Event.Type == IT_FILE)
+				{
+					Event.Action = FWA_MODIFIED;
+					m_Pending.Add(Event);
+				}
+			}
+			else if (InEvent->mask & IN_MOVED_FROM)
+			{
+				Event.Action = FWA_DELETED;
+				(*MovesFrom)[InEvent->cookie] = Event;
+			}
+			else if (InEvent->mask & IN_MOVED_TO)
+			{
+				std::map<uint32, FILE_WATCHER_EVENT>::iterator FromIt = MovesFrom->find(InEvent->cookie);
+				if (FromIt != MovesFrom->end())
+				{
+					Event.Action = FWA_MOVED;
+					Event.OldPath = FromIt->second.Path;
+					MovesFrom->erase(FromIt);
+					m_Pending.Add(Event);
+					if (Event.Type == IT_DIR)
+						RenameWatchedTree(Event.OldPath, Event.Path);
+				}
+				else
+				{
+					// Moved in from outside of the tree
+					Event.Action = FWA_CREATED;
+					m_Pending.Add(Event);
+					if (Event.Type == IT_DIR)
+						WatchTree(Event.Path, true);
+				}
+			}
+		}
+	}
+
+	bool FileWatcher_pimpl::InotifyLoop()
+	{
+		// Aligned for struct inotify_event
+		std::vector<uint64> BufVec(64 * 1024 / sizeof(uint64));
+		char *Buf = (char*)&BufVec[0];
+		size_t BufSize = BufVec.size() * sizeof(uint64);
+		// Cookie -> item moved out of its directory, waiting for its IN_MOVED_TO pair
+		std::map<uint32, FILE_WATCHER_EVENT> MovesFrom;
+		uint64 FirstEventTime = 0, LastEventTime = 0;
+
+		for (;;)
+		{
+			int Timeout = -1;
+			if (!m_Pending.IsEmpty())
+			{
+				uint64 Now = FileWatcherTicks();
+				uint64 Deadline = std::min(LastEventTime + m_CoalesceTime, FirstEventTime + m_CoalesceTime * FILE_WATCHER_MAX_DELAY_FACTOR);
+				Timeout = (Deadline > Now ? (int)(Deadline - Now) : 0);
+			}
+
+			struct pollfd Fds[2];
+			Fds[0].fd = m_InotifyFd;
+			Fds[0].events = POLLIN;
+			Fds[0].revents = 0;
+			Fds[1].fd = m_WakePipe[0];
+			Fds[1].events = POLLIN;
+			Fds[1].revents = 0;
+			if (poll(Fds, 2, Timeout) < 0)
+			{
+				if (errno == EINTR)
+					continue;
+				throw ErrnoError(_T("FileWatcher: poll failed."), __TFILE__, __LINE__);
+			}
+			if (Fds[1].revents != 0)
+				return true;
+
+			if (Fds[0].revents != 0)
+			{
+				bool WasEmpty = m_Pending.IsEmpty();
+				// Read everything available, so both halves of a rename are seen together
+				for (;;)
+				{
+					ssize_t Size = read(m_InotifyFd, Buf, BufSize);
+					if (Size < 0)
+					{
+						if (errno == EINTR)
+							continue;
+						if (errno == EAGAIN || errno == EWOULDBLOCK)
+							break;
+						throw ErrnoError(_T("FileWatcher: Cannot read inotify events."), __TFILE__, __LINE__);
+					}
+					ProcessInotifyEvents(Buf, (size_t)Size, &MovesFrom);
+				}
+				// Moved outside of the tree
+				for (std::map<uint32, FILE_WATCHER_EVENT>::iterator It = MovesFrom.begin(); It != MovesFrom.end(); ++It)
+				{
+					m_Pending.Add(It->second);
+					if (It->second.Type == IT_DIR)
+						UnwatchTree(It->second.Path);
+				}
+				MovesFrom.clear();
+
+				if (IsWatchLimitReached())
+					return false;
+
+				LastEventTime = FileWatcherTicks();
+				if (WasEmpty)
+					FirstEventTime = LastEventTime;
+			}
+
+			if (!m_Pending.IsEmpty())
+			{
+				uint64 Now = FileWatcherTicks();
+				if (Now >= LastEventTime + m_CoalesceTime || Now >= FirstEventTime + m_CoalesceTime * FILE_WATCHER_MAX_DELAY_FACTOR)
+					Flush();
+			}
+		}
+	}
+
+#endif
+
+FileWatcher::FileWatcher(const tstring &Root, uint Flags, FileWatcherCallback *Callback, uint CoalesceTime, uint PollInterval) :
+	pimpl(new FileWatcher_pimpl)
+{
+	pimpl->m_Root = Root;
+	pimpl->m_Callback = Callback;
+	pimpl->m_CoalesceTime = CoalesceTime;
+	pimpl->m_PollInterval = PollInterval;
+
+	if (GetFileItemType(Root) != IT_DIR)
+		throw Error(_T("FileWatcher: Directory not found: ") + Root, __TFILE__, __LINE__);
+
+#ifdef _WIN32
+	pimpl->m_Polling = true;
+#else
+	pimpl->m_Polling = (Flags & FLAG_POLLING) != 0;
+	if (!pimpl->m_Polling)
+	{
+		pimpl->m_InotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (pimpl->m_InotifyFd < 0)
+			pimpl->m_Polling = true;
+	}
+	if (!pimpl->m_Polling)
+	{
+		if (pipe(pimpl->m_WakePipe) != 0)
+			throw ErrnoError(_T("FileWatcher: Cannot create pipe."), __TFILE__, __LINE__);
+		pimpl->WatchTree(tstring(), false);
+		// Limit reached already - no events are reported yet, so just start polling
+		if (pimpl->IsWatchLimitReached())
+		{
+			pimpl->m_Polling = true;
+			close(pimpl->m_InotifyFd);
+			pimpl->m_InotifyFd = -1;
+		}
+	}
+#endif
+
+	if (pimpl->m_Polling)
+		pimpl->TakeSnapshot(&pimpl->m_Snapshot);
+
+	pimpl->m_Thread.reset(new FileWatcherThread(pimpl.get()));
+	pimpl->m_Thread->Start();
+}
+
+FileWatcher::~FileWatcher()
+{
+	{
+		MUTEX_LOCK(pimpl->m_Mutex);
+		pimpl->m_Exit = true;
+		pimpl->m_Cond.Broadcast();
+	}
+#ifndef _WIN32
+	if (pimpl->m_WakePipe[1] >= 0)
+	{
+		// Wakes the thread blocked in poll. Pipe is empty, so it cannot block.
+		char c = 0;
+		ssize_t WriteResult = write(pimpl->m_WakePipe[1], &c, 1);
+		(void)WriteResult;
+	}
+#endif
+	pimpl->m_Thread->Join();
+}
+
+bool FileWatcher::IsPolling()
+{
+	MUTEX_LOCK(pimpl->m_Mutex);
+	return pimpl->m_Polling;
+}
+
+bool FileWatcher::GetEvents(std::vector<FILE_WATCHER_EVENT> *OutEvents, uint Timeout)
+{
+	OutEvents->clear();
+	MUTEX_LOCK(pimpl->m_Mutex);
+	if (pimpl->m_Queue.IsEmpty() && !pimpl->m_HasError && Timeout > 0)
+		pimpl->m_Cond.TimeoutWait(&pimpl->m_Mutex, Timeout);
+	if (pimpl->m_HasError)
+		throw Error(pimpl->m_ErrorMsg, __TFILE__, __LINE__);
+	if (pimpl->m_Queue.IsEmpty())
+		return false;
+	pimpl->m_Queue.Take(OutEvents);
+	return true;
+}
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Klasa FileHashCache
+
+static const char FILE_HASH_CACHE_HEADER[] = "FHC1";
+// Size of buffer for reading hashed files
+static const size_t FILE_HASH_CACHE_BUFFER_SIZE = 64 * 1024;
+// Number of paths handled by one task in GetHashes
+static const size_t FILE_HASH_CACHE_TASK_SIZE = 16;
+
+struct FILE_HASH_CACHE_ENTRY
+{
+	uint64 Size;
+	DATETIME ModificationTime;
+	MD5_SUM Hash;
+	// Requested since loading
+	bool Used;
+};
+
+class FileHashCache_pimpl
+{
+public:
+	typedef std::map<tstring, FILE_HASH_CACHE_ENTRY> ENTRY_MAP;
+
+	Mutex m_Mutex;
+	ENTRY_MAP m_Entries;
+	uint64 m_HitCount;
+	uint64 m_MissCount;
+
+	FileHashCache_pimpl() : m_Mutex(0), m_HitCount(0), m_MissCount(0) { }
+
+	// Hashing is done outside of the lock, so it can be called by many threads at once.
+	void GetHash(MD5_SUM *Out, const tstring &Path, std::vector<char> *Buf);
+	void Load(const char *Data, size_t Size);
+};
+
+void FileHashCache_pimpl::GetHash(MD5_SUM *Out, const tstring &Path, std::vector<char> *Buf)
+{
+	FILE_ITEM_TYPE Type;
+	uint64 Size;
+	DATETIME ModificationTime;
+	MustGetFileItemInfo(Path, &Type, &Size, &ModificationTime);
+	if (Type != IT_FILE)
+		throw Error(_T("Cannot calculate hash of directory: ") + Path, __TFILE__, __LINE__);
+
+	{
+		MUTEX_LOCK(m_Mutex);
+		ENTRY_MAP::iterator It = m_Entries.find(Path);
+		if (It != m_Entries.end() && It->second.Size == Size && It->second.ModificationTime == ModificationTime)
+		{
+			It->second.Used = true;
+			*Out = It->second.Hash;
+			m_HitCount++;
+			return;
+		}
+	}
+
+	DATETIME HashTime = UNow();
+	if (Buf->empty())
+		Buf->resize(FILE_HASH_CACHE_BUFFER_SIZE);
+	FileStream File(Path, FM_READ);
+	MD5_Calc Calc;
+	for (;;)
+	{
+		size_t ReadSize = File.Read(&(*Buf)[0], Buf->size());
+		if (ReadSize == 0)
+			break;
+		Calc.Write(&(*Buf)[0], ReadSize);
+	}
+	Calc.Finish(Out);
+
+	MUTEX_LOCK(m_Mutex);
+	m_MissCount++;
+	// Modified just before hashing - next modification could leave the same time
+	if (ModificationTime.m_Time + FileHashCache::RACY_TIME > HashTime.m_Time)
+	{
+		m_Entries.erase(Path);
+		return;
+	}
+	FILE_HASH_CACHE_ENTRY &Entry = m_Entries[Path];
+	Entry.Size = Size;
+	Entry.ModificationTime = ModificationTime;
+	Entry.Hash = *Out;
+	Entry.Used = true;
+}
+
+void FileHashCache_pimpl::Load(const char *Data, size_t Size)
+{
+	MemoryStream Mem(Size, const_cast<char*>(Data));
+	Mem.MustSkip(4);
+	uint8 CharSize;
+	Mem.ReadEx(&CharSize);
+	if (CharSize != sizeof(tchar))
+		throw Error(_T("FileHashCache: Data saved with different character type."), __TFILE__, __LINE__);
+	uint32 Count;
+	Mem.ReadEx(&Count);
+
+	tstring Path, Suffix;
+	for (uint32 i = 0; i < Count; i++)
+	{
+		uint16 PrefixLength;
+		Mem.ReadEx(&PrefixLength);
+		if (PrefixLength > Path.length())
+			throw Error(_T("FileHashCache: Invalid data."), __TFILE__, __LINE__);
+		Mem.ReadString2(&Suffix);
+		Path.erase(PrefixLength);
+		Path += Suffix;
+
+		FILE_HASH_CACHE_ENTRY Entry;
+		Mem.ReadEx(&Entry.Size);
+		Mem.ReadEx(&Entry.ModificationTime.m_Time);
+		Mem.MustRead(Entry.Hash.Data, sizeof(Entry.Hash.Data));
+		Entry.Used = false;
+		// Saved in order, so every entry goes to the end
+		m_Entries.insert(m_Entries.end(), ENTRY_MAP::value_type(Path, Entry));
+	}
+	if (Mem.GetPos() != (int64)Size)
+		throw Error(_T("FileHashCache: Invalid data."), __TFILE__, __LINE__);
+}
+
+// Hashes a range of paths for FileHashCache::GetHashes
+class FileHashTask : public ThreadTask
+{
+public:
+	FileHashTask(FileHashCache_pimpl *Cache, MD5_SUM *Out, const tstring *Paths, size_t Count) :
+		m_Cache(Cache), m_Out(Out), m_Paths(Paths), m_Count(Count) { }
+
+	virtual void Run()
+	{
+		std::vector<char> Buf;
+		for (size_t i = 0; i < m_Count; i++)
+			m_Cache->GetHash(&m_Out[i], m_Paths[i], &Buf);
+	}
+
+private:
+	FileHashCache_pimpl *m_Cache;
+	MD5_SUM *m_Out;
+	const tstring *m_Paths;
+	size_t m_Count;
+};
+
+FileHashCache::FileHashCache() :
+	pimpl(new FileHashCache_pimpl)
+{
+}
+
+FileHashCache::~FileHashCache()
+{
+}
+
+void FileHashCache::GetHash(MD5_SUM *Out, const tstring &Path)
+{
+	std::vector<char> Buf;
+	pimpl->GetHash(Out, Path, &Buf);
+}
+
+void FileHashCache::GetHashes(std::vector<MD5_SUM> *Out, const std::vector<tstring> &Paths, uint ThreadCount)
+{
+	Out->resize(Paths.size());
+	if (Paths.empty())
+		return;
+
+	std::vector<FileHashTask> Tasks;
+	Tasks.reserve((Paths.size() + FILE_HASH_CACHE_TASK_SIZE - 1) / FILE_HASH_CACHE_TASK_SIZE);
+	for (size_t i = 0; i < Paths.size(); i += FILE_HASH_CACHE_TASK_SIZE)
+		Tasks.push_back(FileHashTask(pimpl.get(), &(*Out)[i], &Paths[i], std::min(FILE_HASH_CACHE_TASK_SIZE, Paths.size() - i)));
+
+	ThreadPool Pool(ThreadCount);
+	for (size_t i = 0; i < Tasks.size(); i++)
+		Pool.AddTask(&Tasks[i]);
+	Pool.WaitAll();
+}
+
+size_t FileHashCache::GetCount()
+{
+	MUTEX_LOCK(pimpl->m_Mutex);
+	return pimpl->m_Entries.size();
+}
+
+void FileHashCache::GetStats(uint64 *OutHitCount, uint64 *OutMissCount)
+{
+	MUTEX_LOCK(pimpl->m_Mutex);
+	if (OutHitCount != NULL)
+		*OutHitCount = pimpl->m_HitCount;
+	if (OutMissCount != NULL)
+		*OutMissCount = pimpl->m_MissCount;
+}
+
+void FileHashCache::RemoveUnused()
+{
+	MUTEX_LOCK(pimpl->m_Mutex);
+	FileHashCache_pimpl::ENTRY_MAP::iterator It = pimpl->m_Entries.begin();
+	while (It != pimpl->m_Entries.end())
+	{
+		if (It->second.Used)
+			++It;
+		else
+			pimpl->m_Entries.erase(It++);
+	}
+}
+
+void FileHashCache::Clear()
+{
+	MUTEX_LOCK(pimpl->m_Mutex);
+	pimpl->m_Entries.clear();
+}
+
+void FileHashCache::SaveToStream(Stream *s)
+{
+	VectorStream Data;
+	Data.Write(FILE_HASH_CACHE_HEADER, 4);
+	Data.WriteEx((uint8)sizeof(tchar));
+	{
+		MUTEX_LOCK(pimpl->m_Mutex);
+		Data.WriteEx((uint32)pimpl->m_Entries.size());
+		const tstring *PrevPath = NULL;
+		for (FileHashCache_pimpl::ENTRY_MAP::const_iterator It = pimpl->m_Entries.begin(); It != pimpl->m_Entries.end(); ++It)
+		{
+			const tstring &Path = It->first;
+			size_t PrefixLength = 0;
+			if (PrevPath != NULL)
+			{
+				size_t MaxLength = std::min(std::min(Path.length(), PrevPath->length()), (size_t)MAXUINT16);
+				while (PrefixLength < MaxLength && Path[PrefixLength] == (*PrevPath)[PrefixLength])
+					PrefixLength++;
+			}
+			Data.WriteEx((uint16)PrefixLength);
+			Data.WriteString2(Path.c_str() + PrefixLength, Path.length() - PrefixLength);
+			Data.WriteEx(It->second.Size);
+			Data.WriteEx(It->second.ModificationTime.m_Time);
+			Data.Write(It->second.Hash.Data, sizeof(It->second.Hash.Data));
+			PrevPath = &Path;
+		}
+	}
+	Data.WriteEx((uint32)CRC32_Calc::Calc(Data.Data(), (size_t)Data.GetSize()));
+	s->Write(Data.Data(), (size_t)Data.GetSize());
+}
+
+bool FileHashCache::LoadFromStream(Stream *s)
+{
+	VectorStream Data;
+	Data.CopyFromToEnd(s);
+	size_t Size = (size_t)Data.GetSize();
+
+	MUTEX_LOCK(pimpl->m_Mutex);
+	pimpl->m_Entries.clear();
+
+	// Header, character size, count, CRC
+	if (Size < 4 + 1 + 4 + 4 || memcmp(Data.Data(), FILE_HASH_CACHE_HEADER, 4) != 0)
+		return false;
+	uint32 Crc;
+	memcpy(&Crc, Data.Data() + Size - 4, 4);
+	if (Crc != (uint32)CRC32_Calc::Calc(Data.Data(), Size - 4))
+		return false;
+
+	try
+	{
+		pimpl->Load(Data.Data(), Size - 4);
+	}
+	catch (const Error &)
+	{
+		pimpl->m_Entries.clear();
+		return false;
+	}
+	return true;
+}
+
+void FileHashCache::SaveToFile(const tstring &FileName)
+{
+	// Readers never see a partial file. After a system crash it may be damaged, but then
+	// it fails the CRC check and the cache is just rebuilt, so flushing is not worth its cost.
+	AtomicFileStream File(FileName, FILE_DURABILITY_NONE);
+	SaveToStream(&File);
+	File.Commit();
+}
+
+bool FileHashCache::LoadFromFile(const tstring &FileName)
+{
+	if (GetFileItemType(FileName) != IT_FILE)
+	{
+		Clear();
+		return false;
+	}
+	FileStream File(FileName, FM_READ);
+	return LoadFromStream(&File);
+}
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Klasy AtomicFileStream i AtomicFileBatch
+
+// Data written by AtomicFileStream is collected up to this size before going to the system.
+static const size_t ATOMIC_FILE_BUFFER_SIZE = 64 * 1024;
+
+// Directory to flush after a file in it was renamed.
+static tstring GetSyncDir(const tstring &FileName)
+{
+	tstring Dir;
+	ExtractFilePath(&Dir, FileName);
+	return Dir.empty() ? tstring(_T(".")) : Dir;
+}
+
+static void SyncDir(const tstring &Dir)
+{
+#ifndef _WIN32
+	int Fd = open(Dir.c_str(), O_RDONLY | O_DIRECTORY);
+	if (Fd == -1)
+		throw ErrnoError(_T("Cannot open directory to flush: ") + Dir, __TFILE__, __LINE__);
+	int R = fsync(Fd);
+	int Err = errno;
+	close(Fd);
+	if (R != 0)
+		throw ErrnoError(Err, _T("Cannot flush directory: ") + Dir, __TFILE__, __LINE__);
+#endif
+	// Windows: directories cannot be flushed, MOVEFILE_WRITE_THROUGH is used instead.
+}
+
+// Temporary file next to the destination file, shared by AtomicFileStream and AtomicFileBatch.
+// Deleted in destructor unless Publish succeeded.
+class AtomicTempFile
+{
+public:
+	tstring m_FileName;
+	tstring m_TempFileName;
+
+	AtomicTempFile(const tstring &FileName);
+	~AtomicTempFile();
+
+	void Write(const void *Data, size_t Size);
+	// Starts writing data to disk in the background, doesn't wait.
+	void StartWriteback();
+	// Waits until data is on disk. Works also after Close.
+	void SyncData();
+	void Close();
+	// Renames temporary file over the destination file.
+	void Publish(bool WriteThrough);
+
+private:
+#ifdef _WIN32
+	HANDLE m_File;
+#else
+	int m_File;
+#endif
+	bool m_Published;
+};
+
+AtomicTempFile::AtomicTempFile(const tstring &FileName) :
+	m_FileName(FileName),
+	m_Published(false)
+{
+	// Unique among objects of this process. Leftovers of a crashed process are skipped.
+	for (uint Try = 0; ; Try++)
+	{
+#ifdef _WIN32
+		m_TempFileName = Format(_T("#.#.#.#.tmp")) % FileName % GetCurrentProcessId() % (uint64)(size_t)this % Try;
+		m_File = CreateFile(m_TempFileName.c_str(), GENERIC_WRITE, 0, NULL, CREATE_NEW, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (m_File != INVALID_HANDLE_VALUE)
+			break;
+		if (GetLastError() != ERROR_FILE_EXISTS || Try == 100)
+			throw Win32Error(_T("Cannot create temporary file: ") + m_TempFileName, __TFILE__, __LINE__);
+#else
+		m_TempFileName = Format(_T("#.#.#.#.tmp")) % FileName % getpid() % (uint64)(size_t)this % Try;
+		m_File = open(m_TempFileName.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0666);
+		if (m_File != -1)
+			break;
+		if (errno != EEXIST || Try == 100)
+			throw ErrnoError(_T("Cannot create temporary file: ") + m_TempFileName, __TFILE__, __LINE__);
+#endif
+	}
+
+#ifndef _WIN32
+	// Preserve access rights of the file being replaced
+	struct stat S;
+	if (stat(FileName.c_str(), &S) == 0)
+		fchmod(m_File, S.st_mode & 07777);
+#endif
+}
+
+AtomicTempFile::~AtomicTempFile()
+{
+	Close();
+	if (!m_Published)
+	{
+#ifdef _WIN32
+		DeleteFile(m_TempFileName.c_str());
+#else
+		unlink(m_TempFileName.c_str());
+#endif
+	}
+}
+
+void AtomicTempFile::Write(const void *Data, size_t Size)
+{
+	const char *Ptr = (const char*)Data;
+	while (Size > 0)
+	{
+#ifdef _WIN32
+		DWORD Written;
+		DWORD Part = (DWORD)std::min(Size, (size_t)0x40000000);
+		if (WriteFile(m_File, Ptr, Part, &Written, NULL) == 0)
+			throw Win32Error(_T("Cannot write to file: ") + m_TempFileName, __TFILE__, __LINE__);
+#else
+		ssize_t Written = write(m_File, Ptr, Size);
+		if (Written < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			throw ErrnoError(_T("Cannot write to file: ") + m_TempFileName, __TFILE__, __LINE__);
+		}
+#endif
+		Ptr += Written;
+		Size -= (size_t)Written;
+	}
+}
+
+void AtomicTempFile::StartWriteback()
+{
+#ifdef __linux__
+	sync_file_range(m_File, 0, 0, SYNC_FILE_RANGE_WRITE);
+#endif
+}
+
+void AtomicTempFile::SyncData()
+{
+#ifdef _WIN32
+	HANDLE File = m_File;
+	if (File == INVALID_HANDLE_VALUE)
+	{
+		File = CreateFile(m_TempFileName.c_str(), GENERIC_WRITE, 0, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (File == INVALID_HANDLE_VALUE)
+			throw Win32Error(_T("Cannot open file to flush: ") + m_TempFileName, __TFILE__, __LINE__);
+	}
+	BOOL R = FlushFileBuffers(File);
+	DWORD Err = GetLastError();
+	if (File != m_File)
+		CloseHandle(File);
+	if (R == 0)
+	{
+		SetLastError(Err);
+		throw Win32Error(_T("Cannot flush file: ") + m_TempFileName, __TFILE__, __LINE__);
+	}
+#else
+	int File = m_File;
+	if (File == -1)
+	{
+		File = open(m_TempFileName.c_str(), O_RDONLY);
+		if (File == -1)
+			throw ErrnoError(_T("Cannot open file to flush: ") + m_TempFileName, __TFILE__, __LINE__);
+	}
+	int R = fdatasync(File);
+	int Err = errno;
+	if (File != m_File)
+		close(File);
+	if (R != 0)
+		throw ErrnoError(Err, _T("Cannot flush file: ") + m_TempFileName, __TFILE__, __LINE__);
+#endif
+}
+
+void AtomicTempFile::Close()
+{
+#ifdef _WIN32
+	if (m_File != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(m_File);
+		m_File = INVALID_HANDLE_VALUE;
+	}
+#else
+	if (m_File != -1)
+	{
+		close(m_File);
+		m_File = -1;
+	}
+#endif
+}
+
+void AtomicTempFile::Publish(bool WriteThrough)
+{
+	Close();
+#ifdef _WIN32
+	DWORD Flags = MOVEFILE_REPLACE_EXISTING | (WriteThrough ? MOVEFILE_WRITE_THROUGH : 0);
+	if (MoveFileEx(m_TempFileName.c_str(), m_FileName.c_str(), Flags) == 0)
+		throw Win32Error(_T("Cannot replace file: ") + m_FileName, __TFILE__, __LINE__);
+#else
+	if (rename(m_TempFileName.c_str(), m_FileName.c_str()) != 0)
+		throw ErrnoError(_T("Cannot replace file: ") + m_FileName, __TFILE__, __LINE__);
+#endif
+	m_Published = true;
+}
+
+class AtomicFileStream_pimpl
+{
+public:
+	FILE_DURABILITY m_Durability;
+	AtomicTempFile m_File;
+	std::vector<char> m_Buf;
+	bool m_Committed;
+
+	AtomicFileStream_pimpl(const tstring &FileName, FILE_DURABILITY Durability) :
+		m_Durability(Durability), m_File(FileName), m_Committed(false) { }
+};
+
+AtomicFileStream::AtomicFileStream(const tstring &FileName, FILE_DURABILITY Durability)
+{
+	ERR_TRY;
+
+	pimpl.reset(new AtomicFileStream_pimpl(FileName, Durability));
+
+	ERR_CATCH(_T("Cannot open file for atomic save: ") + FileName);
+}
+
+AtomicFileStream::~AtomicFileStream()
+{
+}
+
+const tstring & AtomicFileStream::GetFileName()
+{
+	return pimpl->m_File.m_FileName;
+}
+
+const tstring & AtomicFileStream::GetTempFileName()
+{
+	return pimpl->m_File.m_TempFileName;
+}
+
+void AtomicFileStream::Write(const void *Data, size_t Size)
+{
+	assert(!pimpl->m_Committed);
+	if (pimpl->m_Buf.size() + Size > ATOMIC_FILE_BUFFER_SIZE)
+	{
+		Flush();
+		if (Size >= ATOMIC_FILE_BUFFER_SIZE)
+		{
+			pimpl->m_File.Write(Data, Size);
+			return;
+		}
+	}
+	pimpl->m_Buf.insert(pimpl->m_Buf.end(), (const char*)Data, (const char*)Data + Size);
+}
+
+void AtomicFileStream::Flush()
+{
+	if (!pimpl->m_Buf.empty())
+	{
+		pimpl->m_File.Write(&pimpl->m_Buf[0], pimpl->m_Buf.size());
+		pimpl->m_Buf.clear();
+	}
+}
+
+void AtomicFileStream::Commit()
+{
+	ERR_TRY;
+
+	assert(!pimpl->m_Committed);
+	Flush();
+	if (pimpl->m_Durability >= FILE_DURABILITY_DATA)
+		pimpl->m_File.SyncData();
+	pimpl->m_File.Publish(pimpl->m_Durability == FILE_DURABILITY_FULL);
+	pimpl->m_Committed = true;
+	if (pimpl->m_Durability == FILE_DURABILITY_FULL)
+		SyncDir(GetSyncDir(pimpl->m_File.m_FileName));
+
+	ERR_CATCH(_T("Cannot save file atomically: ") + pimpl->m_File.m_FileName);
+}
+
+class AtomicFileBatch_pimpl
+{
+public:
+	FILE_DURABILITY m_Durability;
+	uint m_Flags;
+	std::vector<AtomicTempFile*> m_Files;
+
+	AtomicFileBatch_pimpl(FILE_DURABILITY Durability, uint Flags) : m_Durability(Durability), m_Flags(Flags) { }
+	~AtomicFileBatch_pimpl() { Clear(); }
+
+	void Clear()
+	{
+		for (size_t i = 0; i < m_Files.size(); i++)
+			delete m_Files[i];
+		m_Files.clear();
+	}
+
+	void SyncData();
+};
+
+void AtomicFileBatch_pimpl::SyncData()
+{
+#ifdef __linux__
+	if ((m_Flags & AtomicFileBatch::FLAG_SYNCFS) != 0)
+	{
+		// One syncfs for each file system, found through directories of the files
+		std::set<tstring> Dirs;
+		std::set<dev_t> Devices;
+		for (size_t i = 0; i < m_Files.size(); i++)
+		{
+			tstring Dir = GetSyncDir(m_Files[i]->m_FileName);
+			if (!Dirs.insert(Dir).second)
+				continue;
+			int Fd = open(Dir.c_str(), O_RDONLY | O_DIRECTORY);
+			if (Fd == -1)
+				throw ErrnoError(_T("Cannot open directory to flush: ") + Dir, __TFILE__, __LINE__);
+			struct stat S;
+			int R = 0;
+			if (fstat(Fd, &S) != 0 || Devices.insert(S.st_dev).second)
+				R = syncfs(Fd);
+			int Err = errno;
+			close(Fd);
+			if (R != 0)
+				throw ErrnoError(Err, _T("Cannot flush file system of directory: ") + Dir, __TFILE__, __LINE__);
+		}
+		return;
+	}
+#endif
+	// Writeback was already started for all files, so these mostly wait for the same disk flush.
+	for (size_t i = 0; i < m_Files.size(); i++)
+		m_Files[i]->SyncData();
+}
+
+AtomicFileBatch::AtomicFileBatch(FILE_DURABILITY Durability, uint Flags) :
+	pimpl(new AtomicFileBatch_pimpl(Durability, Flags))
+{
+}
+
+AtomicFileBatch::~AtomicFileBatch()
+{
+}
+
+void AtomicFileBatch::SaveData(const tstring &FileName, const void *Data, size_t NumBytes)
+{
+	ERR_TRY;
+
+	pimpl->m_Files.reserve(pimpl->m_Files.size() + 1);
+	AtomicTempFile *File = new AtomicTempFile(FileName);
+	pimpl->m_Files.push_back(File);
+	try
+	{
+		File->Write(Data, NumBytes);
+		if (pimpl->m_Durability >= FILE_DURABILITY_DATA && (pimpl->m_Flags & FLAG_SYNCFS) == 0)
+			File->StartWriteback();
+		// Closed so that thousands of files don't exhaust file descriptors
+		File->Close();
+	}
+	catch (...)
+	{
+		pimpl->m_Files.pop_back();
+		delete File;
+		throw;
+	}
+
+	ERR_CATCH(_T("Cannot save file in batch: ") + FileName);
+}
+
+void AtomicFileBatch::SaveString(const tstring &FileName, const string &Data)
+{
+	SaveData(FileName, Data.data(), Data.length());
+}
+
+size_t AtomicFileBatch::GetCount()
+{
+	return pimpl->m_Files.size();
+}
+
+void AtomicFileBatch::Commit()
+{
+	ERR_TRY;
+
+	std::vector<AtomicTempFile*> &Files = pimpl->m_Files;
+	bool Full = pimpl->m_Durability == FILE_DURABILITY_FULL;
+	if (pimpl->m_Durability >= FILE_DURABILITY_DATA)
+		pimpl->SyncData();
+
+	std::set<tstring> Dirs;
+	for (size_t i = 0; i < Files.size(); i++)
+	{
+		Files[i]->Publish(Full);
+		if (Full)
+			Dirs.insert(GetSyncDir(Files[i]->m_FileName));
+	}
+	pimpl->Clear();
+
+	for (std::set<tstring>::iterator It = Dirs.begin(); It != Dirs.end(); ++It)
+		SyncDir(*It);
+
+	ERR_CATCH(_T("Cannot commit batch of atomically saved files."));
+}
+
+void AtomicFileBatch::Rollback()
+{
+	pimpl->Clear();
+}
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Klasy FileContent i FileCache
+
+static void QueryFileItemInfo(FILE_ITEM_INFO *Out, const tstring &Path, uint Fields);
+
+#ifdef _WIN32
+	static FILE_TIME_RAW FiletimeToRaw(const FILETIME &Time);
+
+	static long AtomicIncrement(volatile long *Value) { return InterlockedIncrement(Value); }
+	static long AtomicDecrement(volatile long *Value) { return InterlockedDecrement(Value); }
+#else
+	static long AtomicIncrement(volatile long *Value) { return __sync_add_and_fetch(Value, 1); }
+	static long AtomicDecrement(volatile long *Value) { return __sync_sub_and_fetch(Value, 1); }
+#endif
+
+class FileContent_pimpl
+{
+public:
+	volatile long m_RefCount;
+	const char *m_Data;
+	size_t m_Size;
+	std::vector<char> m_Buf;
+#ifdef _WIN32
+	HANDLE m_Mapping;
+#else
+	bool m_Mapped;
+#endif
+
+	FileContent_pimpl();
+	~FileContent_pimpl();
+	bool IsMapped() const;
+	// Loads or maps opened file and returns its size and modification time.
+	void Load(const tstring &Path, uint64 MapThreshold, uint64 *OutSize, FILE_TIME_RAW *OutModificationTime);
+};
+
+#ifdef _WIN32
+
+FileContent_pimpl::FileContent_pimpl() : m_RefCount(1), m_Data(NULL), m_Size(0), m_Mapping(NULL) { }
+
+FileContent_pimpl::~FileContent_pimpl()
+{
+	if (m_Mapping != NULL)
+	{
+		UnmapViewOfFile(m_Data);
+		CloseHandle(m_Mapping);
+	}
+}
+
+bool FileContent_pimpl::IsMapped() const
+{
+	return m_Mapping != NULL;
+}
+
+void FileContent_pimpl::Load(const tstring &Path, uint64 MapThreshold, uint64 *OutSize, FILE_TIME_RAW *OutModificationTime)
+{
+	HANDLE File = CreateFile(Path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (File == INVALID_HANDLE_VALUE)
+		throw Win32Error(_T("Cannot open file: ") + Path, __TFILE__, __LINE__);
+	try
+	{
+		BY_HANDLE_FILE_INFORMATION Info;
+		if (GetFileInformationByHandle(File, &Info) == 0)
+			throw Win32Error(_T("Cannot get file information: ") + Path, __TFILE__, __LINE__);
+		*OutSize = ((uint64)Info.nFileSizeHigh << 32) | Info.nFileSizeLow;
+		*OutModificationTime = FiletimeToRaw(Info.ftLastWriteTime);
+		if (*OutSize > SIZE_MAX)
+			throw Error(_T("File too large: ") + Path, __TFILE__, __LINE__);
+		m_Size = (size_t)*OutSize;
+
+		if (*OutSize >= MapThreshold && *OutSize > 0)
+		{
+			m_Mapping = CreateFileMapping(File, NULL, PAGE_READONLY, 0, 0, NULL);
+			if (m_Mapping == NULL)
+				throw Win32Error(_T("Cannot map file: ") + Path, __TFILE__, __LINE__);
+			m_Data = (const char*)MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, m_Size);
+			if (m_Data == NULL)
+			{
+				CloseHandle(m_Mapping);
+				m_Mapping = NULL;
+				throw Win32Error(_T("Cannot map file: ") + Path, __TFILE__, __LINE__);
+			}
+		}
+		else
+		{
+			m_Buf.resize(m_Size);
+			DWORD Read = 0;
+			if (m_Size > 0 && (ReadFile(File, &m_Buf[0], (DWORD)m_Size, &Read, NULL) == 0 || Read != m_Size))
+				throw Win32Error(_T("Cannot read file: ") + Path, __TFILE__, __LINE__);
+			m_Data = m_Buf.empty() ? NULL : &m_Buf[0];
+		}
+	}
+	catch (...)
+	{
+		CloseHandle(File);
+		throw;
+	}
+	CloseHandle(File);
+}
+
+#else
+
+FileContent_pimpl::FileContent_pimpl() : m_RefCount(1), m_Data(NULL), m_Size(0), m_Mapped(false) { }
+
+FileContent_pimpl::~FileContent_pimpl()
+{
+	if (m_Mapped)
+		munmap((void*)m_Data, m_Size);
+}
+
+bool FileContent_pimpl::IsMapped() const
+{
+	return m_Mapped;
+}
+
+void FileContent_pimpl::Load(const tstring &Path, uint64 MapThreshold, uint64 *OutSize, FILE_TIME_RAW *OutModificationTime)
+{
+	int Fd = open(Path.c_str(), O_RDONLY);
+	if (Fd == -1)
+		throw ErrnoError(_T("Cannot open file: ") + Path, __TFILE__, __LINE__);
+	try
+	{
+		struct stat S;
+		if (fstat(Fd, &S) != 0)
+			throw ErrnoError(_T("Cannot get file information: ") + Path, __TFILE__, __LINE__);
+		if (S_ISDIR(S.st_mode))
+			throw Error(_T("Cannot load directory: ") + Path, __TFILE__, __LINE__);
+		*OutSize = (uint64)S.st_size;
+		OutModificationTime->Seconds = S.st_mtim.tv_sec;
+		OutModificationTime->Nanoseconds = (uint32)S.st_mtim.tv_nsec;
+		if (*OutSize > SIZE_MAX)
+			throw Error(_T("File too large: ") + Path, __TFILE__, __LINE__);
+		m_Size = (size_t)*OutSize;
+
+		if (*OutSize >= MapThreshold && *OutSize > 0)
+		{
+			void *Map = mmap(NULL, m_Size, PROT_READ, MAP_PRIVATE, Fd, 0);
+			if (Map == MAP_FAILED)
+				throw ErrnoError(_T("Cannot map file: ") + Path, __TFILE__, __LINE__);
+			m_Data = (const char*)Map;
+			m_Mapped = true;
+		}
+		else
+		{
+			m_Buf.resize(m_Size);
+			size_t Pos = 0;
+			while (Pos < m_Size)
+			{
+				ssize_t Read = read(Fd, &m_Buf[Pos], m_Size - Pos);
+				if (Read < 0 && errno == EINTR)
+					continue;
+				if (Read < 0)
+					throw ErrnoError(_T("Cannot read file: ") + Path, __TFILE__, __LINE__);
+				// Truncated in the meantime
+				if (Read == 0)
+					break;
+				Pos += (size_t)Read;
+			}
+			m_Buf.resize(Pos);
+			m_Size = Pos;
+			m_Data = m_Buf.empty() ? NULL : &m_Buf[0];
+		}
+	}
+	catch (...)
+	{
+		close(Fd);
+		throw;
+	}
+	close(Fd);
+}
+
+#endif
+
+FileContent::FileContent() :
+	pimpl(NULL)
+{
+}
+
+FileContent::FileContent(FileContent_pimpl *p) :
+	pimpl(p)
+{
+}
+
+FileContent::FileContent(const FileContent &Src) :
+	pimpl(Src.pimpl)
+{
+	if (pimpl != NULL)
+		AtomicIncrement(&pimpl->m_RefCount);
+}
+
+FileContent::~FileContent()
+{
+	if (pimpl != NULL && AtomicDecrement(&pimpl->m_RefCount) == 0)
+		delete pimpl;
+}
+
+FileContent & FileContent::operator = (const FileContent &Src)
+{
+	if (Src.pimpl != NULL)
+		AtomicIncrement(&Src.pimpl->m_RefCount);
+	if (pimpl != NULL && AtomicDecrement(&pimpl->m_RefCount) == 0)
+		delete pimpl;
+	pimpl = Src.pimpl;
+	return *this;
+}
+
+const char * FileContent::GetData() const
+{
+	return pimpl != NULL ? pimpl->m_Data : NULL;
+}
+
+size_t FileContent::GetSize() const
+{
+	return pimpl != NULL ? pimpl->m_Size : 0;
+}
+
+bool FileContent::IsMapped() const
+{
+	return pimpl != NULL && pimpl->IsMapped();
+}
+
+struct FILE_CACHE_ENTRY
+{
+	tstring Path;
+	uint64 Size;
+	FILE_TIME_RAW ModificationTime;
+	FileContent Content;
+};
+
+class FileCache_pimpl
+{
+public:
+	typedef std::list<FILE_CACHE_ENTRY> ENTRY_LIST;
+	typedef std::map<tstring, ENTRY_LIST::iterator> ENTRY_MAP;
+
+	Mutex m_Mutex;
+	uint64 m_Budget;
+	uint64 m_MapThreshold;
+	// Most recently used at the beginning
+	ENTRY_LIST m_List;
+	ENTRY_MAP m_Map;
+	uint64 m_UsedBytes;
+	uint64 m_HitCount;
+	uint64 m_MissCount;
+
+	FileCache_pimpl(uint64 Budget, uint64 MapThreshold) :
+		m_Mutex(0), m_Budget(Budget), m_MapThreshold(MapThreshold), m_UsedBytes(0), m_HitCount(0), m_MissCount(0) { }
+
+	void Get(FileContent *Out, const tstring &Path);
+	// Must be called with m_Mutex locked
+	void Remove(ENTRY_MAP::iterator It);
+	void Evict();
+};
+
+void FileCache_pimpl::Get(FileContent *Out, const tstring &Path)
+{
+	FILE_ITEM_INFO Info;
+	QueryFileItemInfo(&Info, Path, FILE_INFO_SIZE | FILE_INFO_MODIFICATION_TIME);
+	{
+		MUTEX_LOCK(m_Mutex);
+		ENTRY_MAP::iterator It = m_Map.find(Path);
+		if (It != m_Map.end())
+		{
+			FILE_CACHE_ENTRY &Entry = *It->second;
+			if (Info.Type == IT_FILE && Entry.Size == Info.Size && Entry.ModificationTime == Info.ModificationTime)
+			{
+				m_List.splice(m_List.begin(), m_List, It->second);
+				*Out = Entry.Content;
+				m_HitCount++;
+				return;
+			}
+			Remove(It);
+		}
+	}
+
+	// Loading is done outside of the lock, so other files can be taken from the cache meanwhile.
+	FileContent_pimpl *NewContent = new FileContent_pimpl;
+	FileContent Content(NewContent);
+	uint64 Size;
+	FILE_TIME_RAW ModificationTime;
+	NewContent->Load(Path, m_MapThreshold, &Size, &ModificationTime);
+	*Out = Content;
+
+	bool Racy = ModificationTime.ToDatetime().m_Time + FileCache::RACY_TIME > UNow().m_Time;
+
+	MUTEX_LOCK(m_Mutex);
+	m_MissCount++;
+	if (Racy || Size > m_Budget)
+		return;
+	// Other thread could load it in the meantime
+	ENTRY_MAP::iterator It = m_Map.find(Path);
+	if (It != m_Map.end())
+		Remove(It);
+	FILE_CACHE_ENTRY Entry;
+	Entry.Path = Path;
+	Entry.Size = Size;
+	Entry.ModificationTime = ModificationTime;
+	Entry.Content = Content;
+	m_List.push_front(Entry);
+	m_Map.insert(ENTRY_MAP::value_type(Path, m_List.begin()));
+	m_UsedBytes += Size;
+	Evict();
+}
+
+void FileCache_pimpl::Remove(ENTRY_MAP::iterator It)
+{
+	m_UsedBytes -= It->second->Size;
+	m_List.erase(It->second);
+	m_Map.erase(It);
+}
+
+void FileCache_pimpl::Evict()
+{
+	while (m_UsedBytes > m_Budget)
+		Remove(m_Map.find(m_List.back().Path));
+}
+
+FileCache::FileCache(uint64 Budget, uint64 MapThreshold) :
+	pimpl(new FileCache_pimpl(Budget, MapThreshold))
+{
+}
+
+FileCache::~FileCache()
+{
+}
+
+void FileCache::Get(FileContent *Out, const tstring &Path)
+{
+	ERR_TRY;
+
+	pimpl->Get(Out, Path);
+
+	ERR_CATCH(_T("Cannot get file from cache: ") + Path);
+}
+
+void FileCache::GetString(string *Out, const tstring &Path)
+{
+	FileContent Content;
+	Get(&Content, Path);
+	Out->assign(Content.GetData(), Content.GetSize());
+}
+
+void FileCache::GetUnicode(wstring *Out, const tstring &Path, unsigned Encoding, FILE_ENCODING *OutEncoding)
+{
+	FileContent Content;
+	Get(&Content, Path);
+
+	ERR_TRY;
+
+	MemoryStream Stream(Content.GetSize(), (void*)Content.GetData());
+	LoadUnicodeFromStream(&Stream, Out, Encoding, OutEncoding);
+
+	ERR_CATCH(_T("Cannot load Unicode characters from file: ") + Path);
+}
+
+void FileCache::Remove(const tstring &Path)
+{
+	MUTEX_LOCK(pimpl->m_Mutex);
+	FileCache_pimpl::ENTRY_MAP::iterator It = pimpl->m_Map.find(Path);
+	if (It != pimpl->m_Map.end())
+		pimpl->Remove(It);
+}
+
+void FileCache::Clear()
+{
+	MUTEX_LOCK(pimpl->m_Mutex);
+	pimpl->m_Map.clear();
+	pimpl->m_List.clear();
+	pimpl->m_UsedBytes = 0;
+}
+
+uint64 FileCache::GetBudget()
+{
+	MUTEX_LOCK(pimpl->m_Mutex);
+	return pimpl->m_Budget;
+}
+
+void FileCache::SetBudget(uint64 Budget)
+{
+	MUTEX_LOCK(pimpl->m_Mutex);
+	pimpl->m_Budget = Budget;
+	pimpl->Evict();
+}
+
+uint64 FileCache::GetUsedBytes()
+{
+	MUTEX_LOCK(pimpl->m_Mutex);
+	return pimpl->m_UsedBytes;
+}
+
+size_t FileCache::GetCount()
+{
+	MUTEX_LOCK(pimpl->m_Mutex);
+	return pimpl->m_Map.size();
+}
+
+void FileCache::GetStats(uint64 *OutHitCount, uint64 *OutMissCount)
+{
+	MUTEX_LOCK(pimpl->m_Mutex);
+	if (OutHitCount != NULL)
+		*OutHitCount = pimpl->m_HitCount;
+	if (OutMissCount != NULL)
+		*OutMissCount = pimpl->m_MissCount;
+}
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Funkcje globalne
+
+void SaveStringToFile(const tstring &FileName, const string &Data)
+{
+	try
+	{
+		FileStream f(FileName, FM_WRITE);
+		f.WriteStringF(Data);
+	}
+	catch (Error &e)
+	{
+		e.Push(Format(_T("Cannot write string to file: \"#\"")) % FileName, __TFILE__, __LINE__);
+		throw;
+	}
+}
+
+void SaveDataToFile(const tstring &FileName, const void *Data, size_t NumBytes)
+{
+	try
+	{
+		FileStream f(FileName, FM_WRITE);
+		f.Write(Data, NumBytes);
+	}
+	catch (Error &e)
+	{
+		e.Push(Format(_T("Cannot write binary data to file: \"#\"")) % FileName, __TFILE__, __LINE__);
+		throw;
+	}
+}
+
+void SaveStringToFileAtomic(const tstring &FileName, const string &Data, FILE_DURABILITY Durability)
+{
+	SaveDataToFileAtomic(FileName, Data.data(), Data.length(), Durability);
+}
+
+void SaveDataToFileAtomic(const tstring &FileName, const void *Data, size_t NumBytes, FILE_DURABILITY Durability)
+{
+	AtomicFileStream f(FileName, Durability);
+	f.Write(Data, NumBytes);
+	f.Commit();
+}
+
+void LoadStringFromFile(const tstring &FileName, string *Data)
+{
+	try
+	{
+		FileStream f(FileName, FM_READ);
+		f.ReadStringToEnd(Data);
+	}
+	catch (Error &e)
+	{
+		e.Push(Format(_T("Cannot read string from file: \"#\"")) % FileName, __TFILE__, __LINE__);
+		throw;
+	}
+}
+
+#ifdef _WIN32
+
+void SaveStringToFile(const tstring &FileName, const wstring &Data)
+{
+	try
+	{
+		FileStream f(FileName, FM_WRITE);
+		f.WriteStringF(Data);
+	}
+	catch (Error &e)
+	{
+		e.Push(Format(_T("Cannot write string to file: \"#\"")) % FileName, __TFILE__, __LINE__);
+		throw;
+	}
+}
+
+void LoadStringFromFile(const tstring &FileName, wstring *Data)
+{
+	try
+	{
+		FileStream f(FileName, FM_READ);
+		f.ReadStringToEnd(Data);
+	}
+	catch (Error &e)
+	{
+		e.Push(Format(_T("Cannot read string from file: \"#\"")) % FileName, __TFILE__, __LINE__);
+		throw;
+	}
+}
+
+#endif
+
+bool GetFileItemInfo(const tstring &Path, FILE_ITEM_TYPE *OutType, uint64 *OutSize, DATETIME *OutModificationTime, DATETIME *OutCreationTime, DATETIME *OutAccessTime)
+{
+#ifdef _WIN32
+	struct _stat32i64 S;
+	if ( _tstat32i64(Path.c_str(), &S) != 0 )
+		return false;
+
+	if (OutType != NULL)
+		*OutType = ( ((S.st_mode & S_IFDIR) != 0) ? IT_DIR : IT_FILE );
+#else
+	struct stat S;
+	if ( stat(Path.c_str(), &S) != 0 )
+		return false;
+
+	if (OutType != NULL)
+		*OutType = ( S_ISDIR(S.st_mode) ? IT_DIR : IT_FILE );
+#endif
+
+	if (OutSize != NULL)
+		*OutSize = (uint64)S.st_size;
+	if (OutModificationTime != NULL)
+		*OutModificationTime = DATETIME(S.st_mtime);
+	if (OutCreationTime != NULL)
+		*OutCreationTime = DATETIME(S.st_ctime);
+	if (OutAccessTime != NULL)
+		*OutAccessTime = DATETIME(S.st_atime);
+
+	return true;
+}
+
+void MustGetFileItemInfo(const tstring &Path, FILE_ITEM_TYPE *OutType, uint64 *OutSize, DATETIME *OutModificationTime, DATETIME *OutCreationTime, DATETIME *OutAccessTime)
+{
+	if (!GetFileItemInfo(Path, OutType, OutSize, OutModificationTime, OutCreationTime, OutAccessTime))
+		throw ErrnoError(_T("Cannot obtain information about: ") + Path, __TFILE__, __LINE__);
+}
+
+FILE_ITEM_TYPE GetFileItemType(const tstring &Path)
+{
+#ifdef _WIN32
+	// szukanie pliku
+	DWORD Attr = GetFileAttributes(Path.c_str());
+	// pliku nie ma
+	if (Attr == INVALID_FILE_ATTRIBUTES)
+		return IT_NONE;
+	// to jest katalog
+	if ((Attr & FILE_ATTRIBUTE_DIRECTORY) != 0)
+		return IT_DIR;
+	// nie - to jest plik
+	else
+		return IT_FILE;
+
+#else
+	struct stat s;
+	if ( stat(Path.c_str(), &s) != 0 )
+		return IT_NONE;
+	if (S_ISDIR(s.st_mode))
+		return IT_DIR;
+	if (S_ISREG(s.st_mode))
+		return IT_FILE;
+	return IT_NONE;
+
+#endif
+}
+
+// Number of paths queried by one task of GetFileItemInfos
+static const size_t FILE_INFO_TASK_SIZE = 256;
+
+#ifdef _WIN32
+
+// FILETIME counts 100 ns intervals since 1 January 1601
+static FILE_TIME_RAW FiletimeToRaw(const FILETIME &Time)
+{
+	const int64 EPOCH_DIFF = 116444736000000000LL;
+	int64 T = (int64)(((uint64)Time.dwHighDateTime << 32) | Time.dwLowDateTime) - EPOCH_DIFF;
+	FILE_TIME_RAW R;
+	R.Seconds = T / 10000000;
+	int64 Rest = T % 10000000;
+	if (Rest < 0)
+	{
+		R.Seconds--;
+		Rest += 10000000;
+	}
+	R.Nanoseconds = (uint32)Rest * 100;
+	return R;
+}
+
+static void QueryFileItemInfo(FILE_ITEM_INFO *Out, const tstring &Path, uint Fields)
+{
+	WIN32_FILE_ATTRIBUTE_DATA Data;
+	if (GetFileAttributesEx(Path.c_str(), GetFileExInfoStandard, &Data) == 0)
+	{
+		Out->Type = IT_NONE;
+		return;
+	}
+	Out->Type = (Data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0 ? IT_DIR : IT_FILE;
+	Out->Size = ((uint64)Data.nFileSizeHigh << 32) | Data.nFileSizeLow;
+	if (Fields & FILE_INFO_MODIFICATION_TIME)
+		Out->ModificationTime = FiletimeToRaw(Data.ftLastWriteTime);
+	if (Fields & FILE_INFO_CREATION_TIME)
+		Out->CreationTime = FiletimeToRaw(Data.ftCreationTime);
+	if (Fields & FILE_INFO_ACCESS_TIME)
+		Out->AccessTime = FiletimeToRaw(Data.ftLastAccessTime);
+}
+
+#else
+
+static void StatToFileItemInfo(FILE_ITEM_INFO *Out, const struct stat &S)
+{
+	Out->Type = S_ISDIR(S.st_mode) ? IT_DIR : IT_FILE;
+	Out->Size = (uint64)S.st_size;
+	Out->ModificationTime.Seconds = S.st_mtim.tv_sec;
+	Out->ModificationTime.Nanoseconds = (uint32)S.st_mtim.tv_nsec;
+	Out->CreationTime.Seconds = S.st_ctim.tv_sec;
+	Out->CreationTime.Nanoseconds = (uint32)S.st_ctim.tv_nsec;
+	Out->AccessTime.Seconds = S.st_atim.tv_sec;
+	Out->AccessTime.Nanoseconds = (uint32)S.st_atim.tv_nsec;
+}
+
+#if defined(__linux__) && defined(STATX_BASIC_STATS)
+
+static void StatxTimeToRaw(FILE_TIME_RAW *Out, const struct statx_timestamp &Time)
+{
+	Out->Seconds = Time.tv_sec;
+	Out->Nanoseconds = Time.tv_nsec;
+}
+
+static void QueryFileItemInfo(FILE_ITEM_INFO *Out, const tstring &Path, uint Fields)
+{
+	unsigned Mask = STATX_TYPE;
+	if (Fields & FILE_INFO_SIZE)
+		Mask |= STATX_SIZE;
+	if (Fields & FILE_INFO_MODIFICATION_TIME)
+		Mask |= STATX_MTIME;
+	if (Fields & FILE_INFO_CREATION_TIME)
+		Mask |= STATX_BTIME | STATX_CTIME;
+	if (Fields & FILE_INFO_ACCESS_TIME)
+		Mask |= STATX_ATIME;
+
+	struct statx S;
+	if (statx(AT_FDCWD, Path.c_str(), AT_STATX_SYNC_AS_STAT, Mask, &S) != 0)
+	{
+		// Kernel older than 4.11
+		struct stat S2;
+		if (errno == ENOSYS && stat(Path.c_str(), &S2) == 0)
+			StatToFileItemInfo(Out, S2);
+		else
+			Out->Type = IT_NONE;
+		return;
+	}
+
+	Out->Type = S_ISDIR(S.stx_mode) ? IT_DIR : IT_FILE;
+	Out->Size = S.stx_size;
+	StatxTimeToRaw(&Out->ModificationTime, S.stx_mtime);
+	StatxTimeToRaw(&Out->CreationTime, (S.stx_mask & STATX_BTIME) != 0 ? S.stx_btime : S.stx_ctime);
+	StatxTimeToRaw(&Out->AccessTime, S.stx_atime);
+}
+
+#else
+
+static void QueryFileItemInfo(FILE_ITEM_INFO *Out, const tstring &Path, uint Fields)
+{
+	struct stat S;
+	if (stat(Path.c_str(), &S) == 0)
+		StatToFileItemInfo(Out, S);
+	else
+		Out->Type = IT_NONE;
+}
+
+#endif
+
+#endif
+
+class FileInfoTask : public ThreadTask
+{
+public:
+	FileInfoTask(FILE_ITEM_INFO *Out, const tstring *Paths, size_t Count, uint Fields) :
+		m_Out(Out), m_Paths(Paths), m_Count(Count), m_Fields(Fields) { }
+
+	virtual void Run()
+	{
+		for (size_t i = 0; i < m_Count; i++)
+			QueryFileItemInfo(&m_Out[i], m_Paths[i], m_Fields);
+	}
+
+private:
+	FILE_ITEM_INFO *m_Out;
+	const tstring *m_Paths;
+	size_t m_Count;
+	uint m_Fields;
+};
+
+void GetFileItemInfos(std::vector<FILE_ITEM_INFO> *Out, const std::vector<tstring> &Paths, uint Fields, uint ThreadCount)
+{
+	Out->resize(Paths.size());
+	if (Paths.empty())
+		return;
+
+	if (ThreadCount == 0)
+		ThreadCount = ThreadPool::GetHardwareThreadCount();
+	if (ThreadCount == 1 || Paths.size() <= FILE_INFO_TASK_SIZE)
+	{
+		FileInfoTask(&(*Out)[0], &Paths[0], Paths.size(), Fields).Run();
+		return;
+	}
+
+	std::vector<FileInfoTask> Tasks;
+	Tasks.reserve((Paths.size() + FILE_INFO_TASK_SIZE - 1) / FILE_INFO_TASK_SIZE);
+	for (size_t i = 0; i < Paths.size(); i += FILE_INFO_TASK_SIZE)
+		Tasks.push_back(FileInfoTask(&(*Out)[i], &Paths[i], std::min(FILE_INFO_TASK_SIZE, Paths.size() - i), Fields));
+
+	ThreadPool Pool(std::min(ThreadCount, (uint)Tasks.size()));
+	for (size_t i = 0; i < Tasks.size(); i++)
+		Pool.AddTask(&Tasks[i]);
+	Pool.WaitAll();
+}
+
+bool UpdateFileTimeToNow(const tstring &FileName)
+{
+#ifdef _WIN32
+	return ( _tutime(FileName.c_str(), NULL) == 0 );
+#else
+	return ( utime(FileName.c_str(), NULL) == 0 );
+#endif
+}
+
+void MustUpdateFileTimeToNow(const tstring &FileName)
+{
+	if (!UpdateFileTimeToNow(FileName))
+		throw ErrnoError(_T("Cannot write file time to current for: ") + FileName, __TFILE__, __LINE__);
+}
+
+bool UpdateFileTime(const tstring &FileName, const DATETIME &ModificationTime, const DATETIME &AccessTime)
+{
+#ifdef _WIN32
+	_utimbuf B;
+	B.modtime = ModificationTime.GetTicks();
+	B.actime = AccessTime.GetTicks();
+	return ( _tutime(FileName.c_str(), &B) == 0 );
+
+#else
+	utimbuf B;
+	B.modtime = ModificationTime.GetTicks();
+	B.actime = AccessTime.GetTicks();
+	return ( utime(FileName.c_str(), &B) == 0 );
+
+#endif
+}
+
+void MustUpdateFileTime(const tstring &FileName, const DATETIME &ModificationTime, const DATETIME &AccessTime)
+{
+	if (!UpdateFileTime(FileName, ModificationTime, AccessTime))
+		throw ErrnoError(_T("Cannot write file time for: ") + FileName, __TFILE__, __LINE__);
+}
+
+bool CreateDirectory(const tstring &Path)
+{
+#ifdef _WIN32
+	return ( _tmkdir(Path.c_str()) == 0 );
+#else
+	return ( mkdir(Path.c_str(), 0777) == 0 );
+#endif
+}
+
+void MustCreateDirectory(const tstring &Path)
+{
+	if (!CreateDirectory(Path))
+		throw ErrnoError(_T("Cannot create directory: ") + Path, __TFILE__, __LINE__);
+}
+
+bool DeleteDirectory(const tstring &Path)
+{
+#ifdef _WIN32
+	return ( _trmdir(Path.c_str()) == 0 );
+#else
+	return ( rmdir(Path.c_str()) == 0 );
+#endif
+}
+
+void MustDeleteDirectory(const tstring &Path)
+{
+	if (!DeleteDirectory(Path))
+		throw ErrnoError(_T("Cannot delete directory: ") + Path, __TFILE__, __LINE__);
+}
+
+bool CreateDirectoryChain(const tstring &Path)
+{
+	if (GetFileItemType(Path) == IT_DIR)
+		return true;
+
+	size_t i2, i = Path.length()-1;
+	std::stack<size_t> DirSepStack;
+	for (;;)
+	{
+		i2 = Path.find_last_of(DIR_SEP, i-1);
+		if (i2 == tstring::npos)
+			break;
+		if (GetFileItemType(Path.substr(0, i2)) == IT_DIR)
+			break;
+		DirSepStack.push(i2);
+		i = i2;
+	}
+
+	while (!DirSepStack.empty())
+	{
+		if ( !CreateDirectory(Path.substr(0, DirSepStack.top())) )
+			return false;
+		DirSepStack.pop();
+	}
+	if ( !CreateDirectory(Path) )
+		return false;
+	return true;
+}
+
+void MustCreateDirectoryChain(const tstring &Path)
+{
+	if (GetFileItemType(Path) == IT_DIR)
+		return;
+
+	size_t i2, i = Path.length()-1;
+	std::stack<size_t> DirSepStack;
+	for (;;)
+	{
+		i2 = Path.find_last_of(DIR_SEP, i-1);
+		if (i2 == tstring::npos)
+			break;
+		if (GetFileItemType(Path.substr(0, i2)) == IT_DIR)
+			break;
+		DirSepStack.push(i2);
+		i = i2;
+	}
+
+	while (!DirSepStack.empty())
+	{
+		MustCreateDirectory(Path.substr(0, DirSepStack.top()));
+		DirSepStack.pop();
+	}
+	MustCreateDirectory(Path);
+}
+
+bool DeleteFile(const tstring &FileName)
+{
+#ifdef _WIN32
+	return ( _tunlink(FileName.c_str()) == 0 );
+#else
+	return ( unlink(FileName.c_str()) == 0 );
+#endif
+}
+
+void MustDeleteFile(const tstring &FileName)
+{
+	if (!DeleteFile(FileName))
+		throw ErrnoError(_T("Cannot delete file: ") + FileName, __TFILE__, __LINE__);
+}
+
+bool MoveItem(const tstring &OldPath, const tstring &NewPath)
+{
+#ifdef _WIN32
+	return ( _trename(OldPath.c_str(), NewPath.c_str()) == 0 );
+#else
+	return ( rename(OldPath.c_str(), NewPath.c_str()) == 0 );
+#endif
+}
+
+void MustMoveItem(const tstring &OldPath, const tstring &NewPath)
+{
+	if (!MoveItem(OldPath, NewPath))
+		throw ErrnoError(_T("Cannot move element from \"") + OldPath + _T("\" to \"") + NewPath + _T("\""), __TFILE__, __LINE__);
+}
+
+// Funkcje wewnętrzne plików tekstowych Unicode
+
+// Tekst dłuższy niż tyle bajtów na każdy wątek jest konwertowany na wielu wątkach
+static const size_t UNICODE_PARALLEL_PART_SIZE = 1024 * 1024;
+
+// Zwraca false dla kodowania ANSI i nieznanego.
+static bool FileEncodingToUtf(UTF_FORMAT *Out, unsigned Encoding)
+{
+	switch (Encoding)
+	{
+	case FILE_ENCODING_UTF8:     *Out = UTF_8;     return true;
+	case FILE_ENCODING_UTF16_LE: *Out = UTF_16_LE; return true;
+	case FILE_ENCODING_UTF16_BE: *Out = UTF_16_BE; return true;
+	case FILE_ENCODING_UTF32_LE: *Out = UTF_32_LE; return true;
+	case FILE_ENCODING_UTF32_BE: *Out = UTF_32_BE; return true;
+	default: return false;
+	}
+}
+
+static FILE_ENCODING UtfToFileEncoding(UTF_FORMAT Format)
+{
+	switch (Format)
+	{
+	case UTF_16_LE: return FILE_ENCODING_UTF16_LE;
+	case UTF_16_BE: return FILE_ENCODING_UTF16_BE;
+	case UTF_32_LE: return FILE_ENCODING_UTF32_LE;
+	case UTF_32_BE: return FILE_ENCODING_UTF32_BE;
+	default: return FILE_ENCODING_UTF8;
+	}
+}
+
+static const tchar * GetUtfFormatName(UTF_FORMAT Format)
+{
+	switch (Format)
+	{
+	case UTF_16_LE: return _T("UTF-16 LE");
+	case UTF_16_BE: return _T("UTF-16 BE");
+	case UTF_32_LE: return _T("UTF-32 LE");
+	case UTF_32_BE: return _T("UTF-32 BE");
+	default: return _T("UTF-8");
+	}
+}
+
+// Zwraca rozmiar nagłówka BOM danego kodowania na początku danych lub 0, jeśli go nie ma.
+static size_t GetBomSize(const char *Data, size_t NumBytes, UTF_FORMAT Format)
+{
+	UTF_FORMAT BomFormat;
+	size_t BomSize = DetectUtfBom(&BomFormat, Data, NumBytes);
+	if (BomSize == 0)
+		return 0;
+	if (BomFormat == Format)
+		return BomSize;
+	// FF FE 00 00 to także BOM UTF-16 LE, po którym jest znak U+0000
+	if (BomFormat == UTF_32_LE && Format == UTF_16_LE)
+		return 2;
+	return 0;
+}
+
+static void WriteBom(Stream *Dest, UTF_FORMAT Format)
+{
+	char Bom[4];
+	size_t BomSize;
+	ConvertUtf(Bom, &BomSize, Format, "\xEF\xBB\xBF", 3, UTF_8);
+	Dest->Write(Bom, BomSize);
+}
+
+// Konwertuje część danych na jednym z wątków ThreadPool.
+class UtfConvertTask : public ThreadTask
+{
+public:
+	UtfConvertTask(char *Out, UTF_FORMAT OutFormat, const char *In, size_t InBytes, UTF_FORMAT InFormat) :
+		m_Out(Out), m_OutFormat(OutFormat), m_In(In), m_InBytes(InBytes), m_InFormat(InFormat),
+		m_OutBytes(0), m_Ok(false), m_ErrorOffset(0) { }
+
+	virtual void Run()
+	{
+		m_Ok = ConvertUtf(m_Out, &m_OutBytes, m_OutFormat, m_In, m_InBytes, m_InFormat, &m_ErrorOffset);
+	}
+
+	char *m_Out;
+	UTF_FORMAT m_OutFormat;
+	const char *m_In;
+	size_t m_InBytes;
+	UTF_FORMAT m_InFormat;
+	size_t m_OutBytes;
+	bool m_Ok;
+	size_t m_ErrorOffset;
+};
+
+// Przesuwa Pos (liczone od In) do najbliższego dalszego początku znaku, żeby nie rozdzielić
+// sekwencji UTF-8 ani pary surogatów UTF-16.
+static size_t FindUtfSplit(const char *In, size_t InBytes, size_t Pos, UTF_FORMAT Format)
+{
+	size_t UnitSize = GetUtfUnitSize(Format);
+	Pos -= Pos % UnitSize;
+	if (Format == UTF_8)
+	{
+		// Poprawna sekwencja ma najwyżej 3 bajty kontynuacji
+		for (size_t i = 0; i < 3 && Pos < InBytes && ((uint8)In[Pos] & 0xC0) == 0x80; i++)
+			Pos++;
+	}
+	else if (UnitSize == 2 && Pos + 2 <= InBytes)
+	{
+		uint8 HighByte = (uint8)In[Format == UTF_16_LE ? Pos + 1 : Pos];
+		if (HighByte >= 0xDC && HighByte <= 0xDF)
+			Pos += 2;
+	}
+	return Pos;
+}
+
+// Konwertuje tekst między kodowaniami UTF do łańcucha, którego znaki mają rozmiar jednostki OutFormat
+// lub są bajtami. Dane o rozmiarze powyżej UNICODE_PARALLEL_PART_SIZE na wątek są dzielone na części
+// konwertowane równolegle. Przy błędzie zwraca false, a OutErrorOffset to pozycja w bajtach.
+template <typename StrT>
+static bool ConvertUtfText(StrT *Out, UTF_FORMAT OutFormat, const char *In, size_t InBytes, UTF_FORMAT InFormat, size_t *OutErrorOffset)
+{
+	typedef typename StrT::value_type CharT;
+	size_t MaxLength = ConvertUtf_MaxLength(OutFormat, InBytes, InFormat);
+	if (MaxLength == 0)
+	{
+		Out->clear();
+		// Nadal mogą być niepoprawne, np. 1 bajt UTF-16
+		size_t Dummy;
+		return ConvertUtf(NULL, &Dummy, OutFormat, In, InBytes, InFormat, OutErrorOffset);
+	}
+	Out->resize(MaxLength / sizeof(CharT));
+	char *OutBuf = (char*)&(*Out)[0];
+
+	size_t PartCount = std::min((size_t)ThreadPool::GetHardwareThreadCount(), InBytes / UNICODE_PARALLEL_PART_SIZE);
+	if (PartCount < 2)
+	{
+		size_t OutBytes;
+		if (!ConvertUtf(OutBuf, &OutBytes, OutFormat, In, InBytes, InFormat, OutErrorOffset))
+		{
+			Out->clear();
+			return false;
+		}
+		Out->resize(OutBytes / sizeof(CharT));
+		return true;
+	}
+
+	// Każda część pisze do własnego fragmentu bufora o maksymalnej długości,
+	// potem fragmenty są zsuwane.
+	std::vector<UtfConvertTask> Tasks;
+	Tasks.reserve(PartCount);
+	size_t Beg = 0, OutPos = 0;
+	for (size_t i = 0; i < PartCount; i++)
+	{
+		size_t End = (i == PartCount - 1) ? InBytes : FindUtfSplit(In, InBytes, InBytes / PartCount * (i + 1), InFormat);
+		if (End < Beg)
+			End = Beg;
+		Tasks.push_back(UtfConvertTask(OutBuf + OutPos, OutFormat, In + Beg, End - Beg, InFormat));
+		OutPos += ConvertUtf_MaxLength(OutFormat, End - Beg, InFormat);
+		Beg = End;
+	}
+	{
+		ThreadPool Pool((uint)PartCount);
+		for (size_t i = 0; i < PartCount; i++)
+			Pool.AddTask(&Tasks[i]);
+		Pool.WaitAll();
+	}
+
+	OutPos = 0;
+	size_t InPos = 0;
+	for (size_t i = 0; i < PartCount; i++)
+	{
+		if (!Tasks[i].m_Ok)
+		{
+			if (OutErrorOffset != NULL)
+				*OutErrorOffset = InPos + Tasks[i].m_ErrorOffset;
+			Out->clear();
+			return false;
+		}
+		memmove(OutBuf + OutPos, Tasks[i].m_Out, Tasks[i].m_OutBytes);
+		OutPos += Tasks[i].m_OutBytes;
+		InPos += Tasks[i].m_InBytes;
+	}
+	Out->resize(OutPos / sizeof(CharT));
+	return true;
+}
+
+static void ThrowUtfError(UTF_FORMAT UtfFormat, size_t Offset)
+{
+	throw Error(Format(_T("Invalid # data at byte #.")) % GetUtfFormatName(UtfFormat) % Offset, __TFILE__, __LINE__);
+}
+
+// Kodowanie ANSI - w Windows natywna strona kodowa systemu, w innych systemach ISO-8859-1.
+static void AnsiToUnicode(wstring *Out, const char *Data, size_t NumBytes)
+{
+#ifdef _WIN32
+	if (!ConvertCharsToUnicode(Out, Data, NumBytes, CP_ACP))
+		throw Error(_T("Cannot convert ANSI to Unicode."), __TFILE__, __LINE__);
+#else
+	Out->resize(NumBytes);
+	for (size_t i = 0; i < NumBytes; i++)
+		(*Out)[i] = (wchar_t)(uint8)Data[i];
+#endif
+}
+
+static void UnicodeToAnsi(string *Out, const wchar_t *Data, size_t NumChars)
+{
+#ifdef _WIN32
+	if (!ConvertUnicodeToChars(Out, Data, NumChars, CP_ACP))
+		throw Error(_T("Cannot convert Unicode to ANSI."), __TFILE__, __LINE__);
+#else
+	Out->resize(NumChars);
+	for (size_t i = 0; i < NumChars; i++)
+	{
+		if ((uint32)Data[i] > 0xFF)
+			throw Error(Format(_T("Character at index # cannot be converted to ANSI.")) % i, __TFILE__, __LINE__);
+		(*Out)[i] = (char)(uint8)Data[i];
+	}
+#endif
+}
+
+// Funkcja wewnętrzna - wykrywa w jakim kodowaniu są dane.
+// SuggestedEncoding ma być typu FILE_ENCODING (flagi z młodszych 2 bajtów).
+// Przez OutBomSize zwraca także rozmiar nagłówka BOM w bajtach, jeśli taki jest (jeśli nie to zwraca 0).
+static FILE_ENCODING DetectEncoding(const char *Data, size_t NumBytes, unsigned SuggestedEncoding, size_t *OutBomSize)
+{
+	UTF_FORMAT BomFormat;
+	*OutBomSize = DetectUtfBom(&BomFormat, Data, NumBytes);
+	if (*OutBomSize > 0)
+		return UtfToFileEncoding(BomFormat);
+
+	// Bez nagłówka UTF-16 i UTF-32 rozpoznawane są po zerowych bajtach na pozycjach
+	// modulo 4 w próbce z początku danych. Zwykły tekst zawiera głównie znaki < U+0100.
+	size_t SampleSize = std::min(NumBytes, (size_t)65536) & ~(size_t)3;
+	size_t ZeroCount[4] = { 0, 0, 0, 0 };
+	for (size_t i = 0; i < SampleSize; i++)
+	{
+		if (Data[i] == 0)
+			ZeroCount[i & 3]++;
+	}
+	size_t UnitCount = SampleSize / 4;
+	if (UnitCount > 0)
+	{
+		bool Many[4], Few[4];
+		for (size_t i = 0; i < 4; i++)
+		{
+			Many[i] = ZeroCount[i] * 4 >= UnitCount;
+			Few[i] = ZeroCount[i] * 8 <= UnitCount;
+		}
+		if (NumBytes % 4 == 0 && Many[2] && Many[3] && Few[0])
+			return FILE_ENCODING_UTF32_LE;
+		if (NumBytes % 4 == 0 && Many[0] && Many[1] && Few[3])
+			return FILE_ENCODING_UTF32_BE;
+		if (NumBytes % 2 == 0 && Many[1] && Many[3] && Few[0] && Few[2])
+			return FILE_ENCODING_UTF16_LE;
+		if (NumBytes % 2 == 0 && Many[0] && Many[2] && Few[1] && Few[3])
+			return FILE_ENCODING_UTF16_BE;
+	}
+
+	// To nie jest UTF-16 ani UTF-32 - jest UTF-8 lub ANSI
+	if (SuggestedEncoding == FILE_ENCODING_ANSI)
+		return FILE_ENCODING_ANSI;
+	// Preferowane kodowanie nie podane lub podane inne - wybierz domyślne
+	return FILE_ENCODING_UTF8;
+}
+
+// Ustala kodowanie wczytywanych danych. Przez OutGuessed zwraca true, jeśli zostało
+// wykryte automatycznie bez nagłówka BOM - wtedy przy błędzie konwersji dane wczytuje się jako ANSI.
+static FILE_ENCODING ResolveEncoding(const char *Data, size_t NumBytes, unsigned Encoding, size_t *OutBomSize, bool *OutGuessed)
+{
+	*OutGuessed = false;
+	// Jest automatyczne wykrywanie
+	if ((Encoding & FILE_ENCODING_AUTODETECT) != 0)
+	{
+		FILE_ENCODING Enc = DetectEncoding(Data, NumBytes, Encoding & 0xFFFF, OutBomSize);
+		*OutGuessed = *OutBomSize == 0;
+		return Enc;
+	}
+
+	// Nie ma automatycznego wykrywania - koniecznie podane kodowanie. Jeśli jest nagłówek, pomiń go.
+	*OutBomSize = 0;
+	UTF_FORMAT UtfFormat;
+	if (FileEncodingToUtf(&UtfFormat, Encoding & 0xFFFF))
+		*OutBomSize = GetBomSize(Data, NumBytes, UtfFormat);
+	else
+		assert((Encoding & 0xFFFF) == FILE_ENCODING_ANSI && "LoadUnicodeFromStream: No encoding and no AUTODETECT specified.");
+	return (FILE_ENCODING)(Encoding & 0xFFFF);
+}
+
+static void LoadWholeStream(VectorStream *Out, SeekableStream *Src)
+{
+	uint64 size = Src->GetSize();
+	if(size > SIZE_MAX)
+		throw Error(_T("Stream too long."), __TFILE__, __LINE__);
+	Out->SetCapacity((size_t)size);
+	CopyToEnd(Out, Src);
+}
+
+
+void SaveUnicodeToFile(const tstring &FileName, const wstring &Data, unsigned Encoding)
+{
+	ERR_TRY;
+
+	FileStream F(FileName, FM_WRITE);
+	SaveUnicodeToStream(&F, Data, Encoding);
+
+	ERR_CATCH(_T("Cannot save Unicode string to file: ") + FileName);
+}
+
+void SaveUnicodeToFile(const tstring &FileName, const wchar_t *Data, size_t NumChars, unsigned Encoding)
+{
+	ERR_TRY;
+
+	FileStream F(FileName, FM_WRITE);
+	SaveUnicodeToStream(&F, Data, NumChars, Encoding);
+
+	ERR_CATCH(_T("Cannot save Unicode characters to file: ") + FileName);
+}
+
+void SaveUnicodeToStream(Stream *Dest, const wstring &Data, unsigned Encoding)
+{
+	ERR_TRY;
+
+	SaveUnicodeToStream(Dest, Data.data(), Data.length(), Encoding);
+
+	ERR_CATCH(_T("Cannot save Unicode string to stream."));
+}
+
+void SaveUnicodeToStream(Stream *Dest, const wchar_t *Data, size_t NumChars, unsigned Encoding)
+{
+	ERR_TRY;
+
+	UTF_FORMAT UtfFormat;
+	if (FileEncodingToUtf(&UtfFormat, Encoding & 0xFFFF))
+	{
+		// Skonwertuj Unicode na podane kodowanie UTF
+		string Bytes;
+		size_t ErrorOffset;
+		if (!ConvertUtfText(&Bytes, UtfFormat, (const char*)Data, NumChars * sizeof(wchar_t), GetWcharUtfFormat(), &ErrorOffset))
+			throw Error(Format(_T("Invalid Unicode character at index #.")) % (ErrorOffset / sizeof(wchar_t)), __TFILE__, __LINE__);
+		// UTF-8 domyślnie bez nagłówka, pozostałe z nagłówkiem
+		bool Bom = (UtfFormat == UTF_8) ?
+			(Encoding & FILE_ENCODING_FORCE_BOM) != 0 :
+			(Encoding & FILE_ENCODING_NO_BOM) == 0;
+		if (Bom)
+			WriteBom(Dest, UtfFormat);
+		Dest->WriteStringF(Bytes);
+	}
+	else if ((Encoding & 0xFFFF) == FILE_ENCODING_ANSI)
+	{
+		// Skonwertuj Unicode na ANSI
+		string ansi_string;
+		UnicodeToAnsi(&ansi_string, Data, NumChars);
+		// Zapisz łańcuch ANSI
+		Dest->WriteStringF(ansi_string);
+	}
+	else
+		assert(0 && "SaveUnicodeToStream: No encoding specified.");
+
+	ERR_CATCH(_T("Cannot save Unicode characters to stream."));
+}
+
+void LoadUnicodeFromFile(const tstring &FileName, wstring *Out, unsigned Encoding, FILE_ENCODING *OutEncoding)
+{
+	ERR_TRY;
+
+	FileStream F(FileName, FM_READ);
+	LoadUnicodeFromStream(&F, Out, Encoding, OutEncoding);
+
+	ERR_CATCH(_T("Cannot load Unicode characters from file: ") + FileName);
+}
+
+void LoadUnicodeFromFile(const tstring &FileName, string *Out, unsigned Encoding, FILE_ENCODING *OutEncoding)
+{
+	ERR_TRY;
+
+	FileStream F(FileName, FM_READ);
+	LoadUnicodeFromStream(&F, Out, Encoding, OutEncoding);
+
+	ERR_CATCH(_T("Cannot load Unicode characters from file: ") + FileName);
+}
+
+void LoadUnicodeFromStream(SeekableStream *Src, wstring *Out, unsigned Encoding, FILE_ENCODING *OutEncoding)
+{
+	ERR_TRY;
+
+	// Wczytaj cały plik do pamięci
+	VectorStream VS;
+	LoadWholeStream(&VS, Src);
+	const char *Data = VS.Data();
+	size_t NumBytes = (size_t)VS.GetSize();
+
+	size_t BomSize;
+	bool Guessed;
+	FILE_ENCODING Enc = ResolveEncoding(Data, NumBytes, Encoding, &BomSize, &Guessed);
+
+	UTF_FORMAT UtfFormat;
+	if (FileEncodingToUtf(&UtfFormat, Enc))
+	{
+		size_t ErrorOffset;
+		if (!ConvertUtfText(Out, GetWcharUtfFormat(), Data + BomSize, NumBytes - BomSize, UtfFormat, &ErrorOffset))
+		{
+			if (!Guessed)
+				ThrowUtfError(UtfFormat, BomSize + ErrorOffset);
+			// Jeśli nie udało się w wykrytym kodowaniu, wczytaj jako ANSI
+			Enc = FILE_ENCODING_ANSI;
+		}
+	}
+	if (Enc == FILE_ENCODING_ANSI)
+		AnsiToUnicode(Out, Data, NumBytes);
+
+	if (OutEncoding != NULL) *OutEncoding = Enc;
+
+	ERR_CATCH(_T("Cannot load Unicode characters from stream."));
+}
+
+void LoadUnicodeFromStream(SeekableStream *Src, string *Out, unsigned Encoding, FILE_ENCODING *OutEncoding)
+{
+	ERR_TRY;
+
+	// Wczytaj cały plik do pamięci
+	VectorStream VS;
+	LoadWholeStream(&VS, Src);
+	const char *Data = VS.Data();
+	size_t NumBytes = (size_t)VS.GetSize();
+
+	size_t BomSize;
+	bool Guessed;
+	FILE_ENCODING Enc = ResolveEncoding(Data, NumBytes, Encoding, &BomSize, &Guessed);
+
+	UTF_FORMAT UtfFormat;
+	if (FileEncodingToUtf(&UtfFormat, Enc))
+	{
+		size_t ErrorOffset;
+#ifdef _WIN32
+		// Przez Unicode, bo w WinAPI nie ma konwersji UTF -> ANSI
+		wstring TmpWstr;
+		bool Ok = ConvertUtfText(&TmpWstr, GetWcharUtfFormat(), Data + BomSize, NumBytes - BomSize, UtfFormat, &ErrorOffset);
+		if (Ok && !ConvertUnicodeToChars(Out, TmpWstr, CP_ACP))
+			throw Error(_T("Cannot convert Unicode to ANSI."), __TFILE__, __LINE__);
+#else
+		// Łańcuchy char są w UTF-8
+		bool Ok = ConvertUtfText(Out, UTF_8, Data + BomSize, NumBytes - BomSize, UtfFormat, &ErrorOffset);
+#endif
+		if (!Ok)
+		{
+			if (!Guessed)
+				ThrowUtfError(UtfFormat, BomSize + ErrorOffset);
+			// Jeśli nie udało się w wykrytym kodowaniu, wczytaj jako ANSI
+			Enc = FILE_ENCODING_ANSI;
+		}
+	}
+	if (Enc == FILE_ENCODING_ANSI)
+	{
+		// Wczytaj dane - tak jak są
+		Out->assign(Data, NumBytes);
+	}
+
+	if (OutEncoding != NULL) *OutEncoding = Enc;
+
+	ERR_CATCH(_T("Cannot load Unicode characters from stream."));
+}
+
+
+} // namespace common
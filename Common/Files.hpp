@@ -1,229 +1,695 @@
-/** \file
-\brief Files and file system handling
-\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
-
-Part of CommonLib library. \n
-Encoding UTF-8, end of line CR+LF \n
-License: GNU LGPL. \n
-Documentation: \ref Module_Files \n
-Module components: \ref code_files
-*/
-#if defined(_MSC_VER) && (_MSC_VER >= 1200)
-#pragma once
-#endif
-#ifndef COMMON_FILES_H_
-#define COMMON_FILES_H_
-
-#include "Stream.hpp"
-
-
-namespace common
-{
-
-struct DATETIME;
-
-/** \addtogroup code_files Files Module
-Dokumentacja: \ref Module_Files \n
-Nagwek: Files.hpp */
-//@{
-
-/// Rodzaj elementu systemu plikw
-enum FILE_ITEM_TYPE
-{
-	IT_NONE, ///< Bd, brak, koniec itp.
-	IT_DIR,  ///< Katalog
-	IT_FILE, ///< Plik
-};
-
-/// Tryb otwarcia pliku
-enum FILE_MODE
-{
-	/** zapis: tak, odczyt: nie \n
-	pozycja: 0 \n
-	nie istnieje: tworzy, istnieje: oprnia \n
-	SetPos: dziaa */
-	FM_WRITE,
-	/** zapis: tak, odczyt: tak \n
-	pozycja: 0 \n
-	nie istnieje: tworzy, istnieje: oprnia \n
-	SetPos: dziaa */
-	FM_WRITE_PLUS,
-	/** zapis: nie, odczyt: tak \n
-	pozycja: 0 \n
-	nie istnieje: bd, istnieje: otwiera \n
-	SetPos: dziaa */
-	FM_READ,
-	/** zapis: tak, odczyt: tak \n
-	pozycja: 0 \n
-	nie istnieje: bd, istnieje: otwiera \n
-	SetPos: dziaa */
-	FM_READ_PLUS,
-	/** zapis: tak, odczyt: nie \n
-	pozycja: koniec \n
-	nie istnieje: tworzy, istnieje: otwiera \n
-	SetPos: w Linuksie nie dziaa! */
-	FM_APPEND,
-	/** zapis: tak, odczyt: tak \n
-	pozycja: koniec \n
-	nie istnieje: tworzy, istnieje: otwiera \n
-	SetPos: w Linuksie nie dziaa! */
-	FM_APPEND_PLUS,
-};
-
-/// \internal
-class File_pimpl;
-
-/// Strumie plikowy
-class FileStream : public SeekableStream
-{
-private:
-	scoped_ptr<File_pimpl> pimpl;
-
-public:
-	FileStream(const tstring &FileName, FILE_MODE FileMode, bool Lock = true);
-	virtual ~FileStream();
-
-	virtual void Write(const void *Data, size_t Size);
-	virtual size_t Read(void *Data, size_t Size);
-	virtual void Flush();
-	virtual uint64 GetSize();
-	virtual int64 GetPos();
-	virtual void SetPos(int64 pos);
-	virtual void SetPosFromCurrent(int64 pos);
-	virtual void SetPosFromEnd(int64 pos);
-	virtual void SetSize(uint64 Size);
-	virtual void Truncate();
-	virtual bool End();
-
-#ifdef _WIN32
-	HANDLE GetNativeHandle();
-#endif
-};
-
-/// \internal
-class DirLister_pimpl;
-
-/// Klasa do listowania zawartoci katalogu.
-/** W przypadku bdw rzuca wyjtki.
-Nie listuje <tt>"."</tt> ani <tt>".."</tt>. */
-class DirLister
-{
-private:
-	scoped_ptr<DirLister_pimpl> pimpl;
-
-public:
-	DirLister(const tstring &Dir);
-	~DirLister();
-
-	/// Pobiera pierwszy/nastpny element (plik lub katalog) i zwraca go przez parametry.
-	/** Jeli nie udao si, bo ju koniec, zawraca false.
-	\param[out] OutName to sama nazwa, nie pena cieka.
-	\param[out] OutType to DIR lub FILE. */
-	bool ReadNext(tstring *OutName, FILE_ITEM_TYPE *OutType);
-};
-
-
-/// Zapisuje podany acuch jako tre pliku
-void SaveStringToFile(const tstring &FileName, const string &Data);
-/// Zapisuje podany acuch jako tre pliku
-void SaveDataToFile(const tstring &FileName, const void *Data, size_t NumBytes);
-/// Wczytuje ca zawarto pliku do acucha
-void LoadStringFromFile(const tstring &FileName, string *Data);
-/// Wersje Unicode
-#ifdef _WIN32
-void SaveStringToFile(const tstring &FileName, const wstring &Data);
-void LoadStringFromFile(const tstring &FileName, wstring *Data);
-#endif
-
-/// Zwraca wybrane informacje na temat pliku/katalogu
-/** Jako parametry wyjciowe mona podawa NULL.
-Jeli to katalog, zwrcony rozmiar jest niezdefiniowany. */
-bool GetFileItemInfo(const tstring &Path, FILE_ITEM_TYPE *OutType, uint64 *OutSize, DATETIME *OutModificationTime, DATETIME *OutCreationTime = NULL, DATETIME *OutAccessTime = NULL);
-void MustGetFileItemInfo(const tstring &Path, FILE_ITEM_TYPE *OutType, uint64 *OutSize, DATETIME *OutModificationTime, DATETIME *OutCreationTime = NULL, DATETIME *OutAccessTime = NULL);
-/// Zwraca typ - czy to jest plik, katalog czy bd/nie-istnieje.
-/** Jeli bd lub nie istnieje, zwraca common::IT_NONE. */
-FILE_ITEM_TYPE GetFileItemType(const tstring &Path);
-
-/// Ustawia czas dostpu i modyfikacji podanego pliku na biecy
-bool UpdateFileTimeToNow(const tstring &FileName);
-void MustUpdateFileTimeToNow(const tstring &FileName);
-/// Ustawia czas dostpu i modyfikacji podanego pliku na podane
-bool UpdateFileTime(const tstring &FileName, const DATETIME &ModificationTime, const DATETIME &AccessTime);
-void MustUpdateFileTime(const tstring &FileName, const DATETIME &ModificationTime, const DATETIME &AccessTime);
-
-/// Tworzy katalog
-bool CreateDirectory(const tstring &Path);
-void MustCreateDirectory(const tstring &Path);
-/// Usuwa katalog
-/** Katalog musi by pusty. */
-bool DeleteDirectory(const tstring &Path);
-void MustDeleteDirectory(const tstring &Path);
-/// Tworzy ca ciek katalogw a po podanego, np. <tt>"C:\A\B\C"</tt> nawet jeli nie istnia nawet <tt>"C:\A"</tt>
-bool CreateDirectoryChain(const tstring &Path);
-void MustCreateDirectoryChain(const tstring &Path);
-
-/// Usuwa plik
-bool DeleteFile(const tstring &FileName);
-void MustDeleteFile(const tstring &FileName);
-/// Przenosi lub zmienia nazw pliku lub katalogu
-/** Katalogi mona przenosi tylko w ramach jednej partycji. Pliki niekoniecznie. */
-bool MoveItem(const tstring &OldPath, const tstring &NewPath);
-void MustMoveItem(const tstring &OldPath, const tstring &NewPath);
-
-// Pliki tekstowe z uyciem Unicode
-#ifdef _WIN32
-
-/// Kodowanie pliku tekstowego
-enum FILE_ENCODING
-{
-	/** \name Modsze 16 bitw - kodowanie */
-	//@{
-	FILE_ENCODING_UTF16_LE = 1, ///< Zwyky UTF-16 stosowany w Windows (domylnie dodaje BOM)
-	FILE_ENCODING_UTF8     = 2, ///< UTF-8 (domylnie nie dodaje BOM)
-	FILE_ENCODING_ANSI     = 3, ///< Natywne kodowanie systemu
-	//@}
-
-	/** \name Starsze 16 bitw - flagi dodatkowe */
-	//@{
-	/// Docz t flag dodatkowo | podczas zapisywania, aby wymusi nagwek BOM.
-	FILE_ENCODING_FORCE_BOM  = 0x00010000,
-	/// Docz t flag dodatkowo | podczas zapisywania, aby wymusi brak nagwka BOM.
-	FILE_ENCODING_NO_BOM     = 0x00020000,
-	/// Docz t flag dodatkowo podczas odczytywania, aby automatycznie wykry kodowanie.
-	FILE_ENCODING_AUTODETECT = 0x00040000,
-	//@}
-};
-
-/// Zapisuje tekst Unicode do pliku w podanym kodowaniu
-/** Musisz poda jedn flag common::FILE_ENCODING z kodowaniem.
-Moesz doda jedn z flag wymuszajc nagwek BOM lub jego brak. */
-void SaveUnicodeToFile(const tstring &FileName, const wstring &Data, unsigned Encoding);
-void SaveUnicodeToFile(const tstring &FileName, const wchar_t *Data, size_t NumChars, unsigned Encoding);
-
-void SaveUnicodeToStream(Stream *Dest, const wstring &Data, unsigned Encoding);
-void SaveUnicodeToStream(Stream *Dest, const wchar_t *Data, size_t NumChars, unsigned Encoding);
-
-/// Wczytuje plik tekstowy do acucha Unicode
-/** \param Encoding:
-- Moesz poda samo kodowanie, aby wczyta w z gry zaoonym kodowaniu (duo szybsze!)
-- Moesz poda samo common::FILE_ENCODING_AUTODETECT, aby automatycznie wykry kodowanie.
-- Moesz poda common::FILE_ENCODING_AUTODETECT i doda jedno z kodowa, aby automatycznie wykry,
-  a w przypadku wtpliwoci wybra podane.
-\param OutEncoding - zwraca wykryte kodowanie. Jeli ci nie interesuj, moesz poda NULL.
-*/
-void LoadUnicodeFromFile(const tstring &FileName, wstring *Out, unsigned Encoding, FILE_ENCODING *OutEncoding = NULL);
-/// Wczytuje plik tekstowy do acucha ANSI.
-/** Wspiera te same kodowania co common::OutEncoding. */
-void LoadUnicodeFromFile(const tstring &FileName, string *Out, unsigned Encoding, FILE_ENCODING *OutEncoding = NULL);
-
-void LoadUnicodeFromStream(SeekableStream *Src, wstring *Out, unsigned Encoding, FILE_ENCODING *OutEncoding = NULL);
-void LoadUnicodeFromStream(SeekableStream *Src, string *Out, unsigned Encoding, FILE_ENCODING *OutEncoding = NULL);
-
-#endif
-
-//@}
-// code_files
-
-} // namespace common
-
-#endif
+/** \file
+\brief Files and file system handling
+\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
+
+Part of CommonLib library. \n
+Encoding UTF-8, end of line CR+LF \n
+License: GNU LGPL. \n
+Documentation: \ref Module_Files \n
+Module components: \ref code_files
+*/
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+#pragma once
+#endif
+#ifndef COMMON_FILES_H_
+#define COMMON_FILES_H_
+
+#include "Stream.hpp"
+#include "DateTime.hpp"
+
+
+namespace common
+{
+
+/** \addtogroup code_files Files Module
+Dokumentacja: \ref Module_Files \n
+Nagłówek: Files.hpp */
+//@{
+
+/// Rodzaj elementu systemu plików
+enum FILE_ITEM_TYPE
+{
+	IT_NONE, ///< Błąd, brak, koniec itp.
+	IT_DIR,  ///< Katalog
+	IT_FILE, ///< Plik
+};
+
+/// Tryb otwarcia pliku
+enum FILE_MODE
+{
+	/** zapis: tak, odczyt: nie \n
+	pozycja: 0 \n
+	nie istnieje: tworzy, istnieje: opróżnia \n
+	SetPos: działa */
+	FM_WRITE,
+	/** zapis: tak, odczyt: tak \n
+	pozycja: 0 \n
+	nie istnieje: tworzy, istnieje: opróżnia \n
+	SetPos: działa */
+	FM_WRITE_PLUS,
+	/** zapis: nie, odczyt: tak \n
+	pozycja: 0 \n
+	nie istnieje: błąd, istnieje: otwiera \n
+	SetPos: działa */
+	FM_READ,
+	/** zapis: tak, odczyt: tak \n
+	pozycja: 0 \n
+	nie istnieje: błąd, istnieje: otwiera \n
+	SetPos: działa */
+	FM_READ_PLUS,
+	/** zapis: tak, odczyt: nie \n
+	pozycja: koniec \n
+	nie istnieje: tworzy, istnieje: otwiera \n
+	SetPos: w Linuksie nie działa! */
+	FM_APPEND,
+	/** zapis: tak, odczyt: tak \n
+	pozycja: koniec \n
+	nie istnieje: tworzy, istnieje: otwiera \n
+	SetPos: w Linuksie nie działa! */
+	FM_APPEND_PLUS,
+};
+
+/// \internal
+class File_pimpl;
+
+/// Strumień plikowy
+class FileStream : public SeekableStream
+{
+private:
+	scoped_ptr<File_pimpl> pimpl;
+
+public:
+	FileStream(const tstring &FileName, FILE_MODE FileMode, bool Lock = true);
+	virtual ~FileStream();
+
+	virtual void Write(const void *Data, size_t Size);
+	virtual size_t Read(void *Data, size_t Size);
+	virtual void Flush();
+	virtual uint64 GetSize();
+	virtual int64 GetPos();
+	virtual void SetPos(int64 pos);
+	virtual void SetPosFromCurrent(int64 pos);
+	virtual void SetPosFromEnd(int64 pos);
+	virtual void SetSize(uint64 Size);
+	virtual void Truncate();
+	virtual bool End();
+
+#ifdef _WIN32
+	HANDLE GetNativeHandle();
+#endif
+};
+
+/// \internal
+class DirLister_pimpl;
+
+/// Klasa do listowania zawartości katalogu.
+/** W przypadku błędów rzuca wyjątki.
+Nie listuje <tt>"."</tt> ani <tt>".."</tt>. */
+class DirLister
+{
+private:
+	scoped_ptr<DirLister_pimpl> pimpl;
+
+public:
+	DirLister(const tstring &Dir);
+	~DirLister();
+
+	/// Pobiera pierwszy/następny element (plik lub katalog) i zwraca go przez parametry.
+	/** Jeśli nie udało się, bo już koniec, zawraca false.
+	\param[out] OutName to sama nazwa, nie pełna ścieżka.
+	\param[out] OutType to DIR lub FILE. */
+	bool ReadNext(tstring *OutName, FILE_ITEM_TYPE *OutType);
+};
+
+
+/// Entry found by DirWalker
+struct DIR_WALKER_ENTRY
+{
+	/// Path relative to the root directory passed to DirWalker, with DIR_SEP separators.
+	tstring Path;
+	/// IT_DIR or IT_FILE. Symbolic links are not followed and are reported as IT_FILE.
+	FILE_ITEM_TYPE Type;
+	/// Filled only with DirWalker::FLAG_STAT, otherwise 0. Undefined for directories.
+	uint64 Size;
+	/// Filled only with DirWalker::FLAG_STAT.
+	DATETIME ModificationTime;
+};
+
+/// Interface for deciding what DirWalker delivers and where it descends.
+/** Methods are called from many threads at once, so they must be thread-safe. */
+class DirWalkerFilter
+{
+public:
+	virtual ~DirWalkerFilter() { }
+
+	/// Return false to not deliver the entry. Does not influence descending into directory.
+	virtual bool Accept(const DIR_WALKER_ENTRY &Entry) { return true; }
+	/// Called for every subdirectory. Return false to skip whole its subtree.
+	virtual bool EnterDir(const DIR_WALKER_ENTRY &Entry) { return true; }
+};
+
+/// \internal
+class DirWalker_pimpl;
+
+/// Recursive listing of whole directory tree, with directories scanned in parallel.
+/**
+Every directory is scanned by a task on a ThreadPool, which queues tasks for its subdirectories.
+Results are delivered as batches of entries in unspecified order - only entries of one
+directory come in their listing order. Use ReadBatch until it returns false.
+
+On Linux directories are read with getdents64 in big portions, type comes from d_type
+and with FLAG_STAT information is obtained with statx/fstatat relative to already open
+directory, so paths are never resolved from the beginning.
+On Windows FindFirstFileEx is used, which returns size and time together with name.
+
+Does not list <tt>"."</tt> or <tt>".."</tt>. Root directory itself is not listed.
+Destroying the object before the end stops the walk.
+*/
+class DirWalker
+{
+	DECLARE_NO_COPY_CLASS(DirWalker)
+
+private:
+	scoped_ptr<DirWalker_pimpl> pimpl;
+
+public:
+	/// Flags for constructor
+	enum FLAGS
+	{
+		/// Fill DIR_WALKER_ENTRY::Size and DIR_WALKER_ENTRY::ModificationTime.
+		FLAG_STAT          = 0x01,
+		/// Silently skip subdirectories which cannot be read, e.g. because of access rights.
+		FLAG_IGNORE_ERRORS = 0x02,
+	};
+
+	/// Default maximum number of entries in a batch.
+	static const size_t DEFAULT_BATCH_SIZE = 1024;
+
+	/**
+	\param Flags Combination of FLAGS.
+	\param Filter Can be NULL. Must stay alive as long as this object.
+	\param ThreadCount 0 means number of logical processors.
+	*/
+	DirWalker(const tstring &Root, uint Flags = 0, DirWalkerFilter *Filter = NULL, uint ThreadCount = 0, size_t BatchSize = DEFAULT_BATCH_SIZE);
+	~DirWalker();
+
+	/// Returns next batch of entries, never empty. Returns false at the end.
+	/** Error encountered during the walk is thrown from here. */
+	bool ReadBatch(std::vector<DIR_WALKER_ENTRY> *OutEntries);
+};
+
+/// Kind of change reported by FileWatcher
+enum FILE_WATCHER_ACTION
+{
+	/// File or directory appeared.
+	FWA_CREATED,
+	/// Contents, size or modification time of a file changed.
+	FWA_MODIFIED,
+	/// File or directory disappeared.
+	FWA_DELETED,
+	/// File or directory was renamed inside watched tree. Previous path is in FILE_WATCHER_EVENT::OldPath.
+	FWA_MOVED,
+	/// Some events were lost, e.g. because of kernel queue overflow. Path is empty. Whole tree should be rescanned.
+	FWA_OVERFLOW,
+};
+
+/// Single change reported by FileWatcher
+struct FILE_WATCHER_EVENT
+{
+	FILE_WATCHER_ACTION Action;
+	/// Path relative to the watched root directory, with DIR_SEP separators.
+	tstring Path;
+	/// Only for FWA_MOVED - path before the move.
+	tstring OldPath;
+	/// IT_FILE or IT_DIR, IT_NONE for FWA_OVERFLOW.
+	FILE_ITEM_TYPE Type;
+};
+
+/// Interface for receiving events from FileWatcher on its own thread
+class FileWatcherCallback
+{
+public:
+	virtual ~FileWatcherCallback() { }
+	/// Called on the watcher thread with coalesced events, never with empty vector.
+	/** Exception thrown from here stops the watcher - it is rethrown by FileWatcher::GetEvents. */
+	virtual void OnFileEvents(const std::vector<FILE_WATCHER_EVENT> &Events) = 0;
+};
+
+/// \internal
+class FileWatcher_pimpl;
+
+/// Reports changes in a directory tree, so it doesn't have to be rescanned periodically.
+/**
+On Linux inotify is used - watch is added to every directory of the tree (in parallel, with DirWalker),
+directories created or moved into the tree later are added automatically and their contents are
+reported as created. Renames inside the tree are reported as single FWA_MOVED event.
+
+Events are collected on a background thread and coalesced: they are delivered after CoalesceTime
+passed without new events (or 10 times that since the first one) and repeated changes of one
+path are merged, e.g. many writes to a file give one FWA_MODIFIED, file created and deleted in
+the meantime gives nothing.
+
+Polling mode takes a snapshot of the tree (type, size and modification time of every item)
+every PollInterval and reports differences between snapshots. It is used with FLAG_POLLING,
+on Windows, when inotify cannot be initialized or when system limit of watches is reached
+(then FWA_OVERFLOW is reported once). Polling never reports FWA_MOVED - only deletion and creation.
+
+Events are delivered to the Callback, or when it is NULL, queued until GetEvents is called.
+Changes made after the constructor returned are reported.
+*/
+class FileWatcher
+{
+	DECLARE_NO_COPY_CLASS(FileWatcher)
+
+private:
+	scoped_ptr<FileWatcher_pimpl> pimpl;
+
+public:
+	/// Flags for constructor
+	enum FLAGS
+	{
+		/// Always use polling mode.
+		FLAG_POLLING = 0x01,
+	};
+
+	/// Default time without new events after which collected events are delivered, in milliseconds.
+	static const uint DEFAULT_COALESCE_TIME = 100;
+	/// Default time between snapshots in polling mode, in milliseconds.
+	static const uint DEFAULT_POLL_INTERVAL = 2000;
+
+	/**
+	\param Flags Combination of FLAGS.
+	\param Callback Can be NULL - then use GetEvents. Must stay alive as long as this object.
+	*/
+	FileWatcher(const tstring &Root, uint Flags = 0, FileWatcherCallback *Callback = NULL,
+		uint CoalesceTime = DEFAULT_COALESCE_TIME, uint PollInterval = DEFAULT_POLL_INTERVAL);
+	~FileWatcher();
+
+	/// Returns true if polling mode is used, either requested or as a fallback.
+	bool IsPolling();
+
+	/// Takes all queued events, waiting up to Timeout milliseconds for them to appear.
+	/** Returns false if there are no events. Error which stopped the watcher thread is thrown
+	from here, also when events go to the callback. */
+	bool GetEvents(std::vector<FILE_WATCHER_EVENT> *OutEvents, uint Timeout = 0);
+};
+
+/// \internal
+class FileHashCache_pimpl;
+
+/// Persistent cache of MD5 sums of file contents, so that unchanged files are not hashed again.
+/**
+Entry is keyed by path and validated with size and modification time returned by GetFileItemInfo.
+If they changed, the file is hashed again with MD5_Calc. Files modified less than RACY_TIME
+before hashing are not cached, because another change in the same second would go unnoticed.
+Paths are compared as given, so always use the same form of path for the same file.
+
+Saved data is compact: entries are sorted by path and each path stores only the part which differs
+from the previous one. CRC32 of the whole is checked while loading - damaged data or data
+saved by a build with different character type is ignored.
+
+All methods can be called from many threads.
+*/
+class FileHashCache
+{
+	DECLARE_NO_COPY_CLASS(FileHashCache)
+
+private:
+	scoped_ptr<FileHashCache_pimpl> pimpl;
+
+public:
+	/// Files modified less than this many milliseconds before hashing are not cached.
+	static const int64 RACY_TIME = 2000;
+
+	FileHashCache();
+	~FileHashCache();
+
+	/// Returns MD5 of contents of a file, from the cache or calculated.
+	/** Error is thrown if the file doesn't exist or cannot be read. */
+	void GetHash(MD5_SUM *Out, const tstring &Path);
+	/// Returns MD5 of contents of many files. Files missing in the cache are hashed in parallel.
+	/** \param ThreadCount 0 means number of logical processors. */
+	void GetHashes(std::vector<MD5_SUM> *Out, const std::vector<tstring> &Paths, uint ThreadCount = 0);
+
+	/// Returns number of entries.
+	size_t GetCount();
+	/// Returns number of requests answered from the cache and requests which needed hashing.
+	/** Parameters can be NULL. */
+	void GetStats(uint64 *OutHitCount, uint64 *OutMissCount);
+	/// Removes entries not requested since loading, e.g. of deleted files.
+	void RemoveUnused();
+	void Clear();
+
+	void SaveToStream(Stream *s);
+	/// Replaces contents of the cache with data from the stream.
+	/** Returns false and leaves the cache empty if the data is damaged or incompatible. */
+	bool LoadFromStream(Stream *s);
+	/// Replaces the file atomically, without flushing it to disk (see AtomicFileStream).
+	void SaveToFile(const tstring &FileName);
+	/// Returns false and leaves the cache empty if the file doesn't exist or cannot be used.
+	bool LoadFromFile(const tstring &FileName);
+};
+
+/// Zapisuje podany łańcuch jako treść pliku
+void SaveStringToFile(const tstring &FileName, const string &Data);
+/// Zapisuje podany łańcuch jako treść pliku
+void SaveDataToFile(const tstring &FileName, const void *Data, size_t NumBytes);
+/// Wczytuje całą zawartość pliku do łańcucha
+void LoadStringFromFile(const tstring &FileName, string *Data);
+/// Wersje Unicode
+#ifdef _WIN32
+void SaveStringToFile(const tstring &FileName, const wstring &Data);
+void LoadStringFromFile(const tstring &FileName, wstring *Data);
+#endif
+
+/// How much AtomicFileStream, AtomicFileBatch and Save*ToFileAtomic care about surviving a system crash
+enum FILE_DURABILITY
+{
+	/// File is only replaced atomically - other processes see old or new content, never partial.
+	/** After a system crash the file may be empty or have old content. */
+	FILE_DURABILITY_NONE,
+	/// Data is flushed to disk before the file is replaced.
+	/** After a crash the file has old or new content, never torn. New content may still be lost. */
+	FILE_DURABILITY_DATA,
+	/// Also the directory is flushed after replacing, so new content survives a crash once saving returned.
+	FILE_DURABILITY_FULL,
+};
+
+/// \internal
+class AtomicFileStream_pimpl;
+
+/// Write-only stream replacing a file atomically.
+/**
+Data goes to a temporary file in the same directory. Commit flushes it according to the durability
+level and renames it over the destination file. If the object is destroyed without Commit,
+the temporary file is deleted and the destination file stays untouched.
+Access rights of the existing destination file are preserved.
+*/
+class AtomicFileStream : public Stream
+{
+	DECLARE_NO_COPY_CLASS(AtomicFileStream)
+
+private:
+	scoped_ptr<AtomicFileStream_pimpl> pimpl;
+
+public:
+	AtomicFileStream(const tstring &FileName, FILE_DURABILITY Durability = FILE_DURABILITY_FULL);
+	virtual ~AtomicFileStream();
+
+	const tstring & GetFileName();
+	const tstring & GetTempFileName();
+
+	/// Makes written data the new content of the file. Nothing can be written after that.
+	void Commit();
+
+	// ======== Implementacja Stream ========
+
+	virtual void Write(const void *Data, size_t Size);
+	virtual void Flush();
+};
+
+/// \internal
+class AtomicFileBatch_pimpl;
+
+/// Saves many files atomically with one flush for all of them instead of one per file.
+/**
+Files are written to temporary files immediately and (on Linux) their writeback is started.
+Commit waits until all of them are on disk, renames them over destination files and then
+flushes each directory once. Flushing thousands of files one after another is many times slower.
+
+Each file is replaced atomically, but the batch as a whole is not - if Commit fails or the system
+crashes in the middle of renaming, some of the files have new content and others old.
+A file can be saved many times in one batch - the last content wins.
+Object not committed deletes its temporary files in the destructor.
+*/
+class AtomicFileBatch
+{
+	DECLARE_NO_COPY_CLASS(AtomicFileBatch)
+
+private:
+	scoped_ptr<AtomicFileBatch_pimpl> pimpl;
+
+public:
+	/// Flush whole file systems with syncfs instead of every file separately (Linux only, ignored elsewhere).
+	/** Faster for large batches, but also flushes unrelated data written by other processes. */
+	static const uint FLAG_SYNCFS = 0x01;
+
+	AtomicFileBatch(FILE_DURABILITY Durability = FILE_DURABILITY_FULL, uint Flags = 0);
+	~AtomicFileBatch();
+
+	void SaveData(const tstring &FileName, const void *Data, size_t NumBytes);
+	void SaveString(const tstring &FileName, const string &Data);
+	/// Returns number of files waiting for Commit.
+	size_t GetCount();
+
+	/// Replaces all saved files. The batch is empty after that and can be used again.
+	void Commit();
+	/// Deletes all temporary files without touching destination files.
+	void Rollback();
+};
+
+/// Zapisuje podany łańcuch jako treść pliku, podmieniając plik atomowo (p. AtomicFileStream)
+void SaveStringToFileAtomic(const tstring &FileName, const string &Data, FILE_DURABILITY Durability = FILE_DURABILITY_FULL);
+/// Zapisuje podane dane jako treść pliku, podmieniając plik atomowo (p. AtomicFileStream)
+void SaveDataToFileAtomic(const tstring &FileName, const void *Data, size_t NumBytes, FILE_DURABILITY Durability = FILE_DURABILITY_FULL);
+
+/// Zwraca wybrane informacje na temat pliku/katalogu
+/** Jako parametry wyjściowe można podawać NULL.
+Jeśli to katalog, zwrócony rozmiar jest niezdefiniowany. */
+bool GetFileItemInfo(const tstring &Path, FILE_ITEM_TYPE *OutType, uint64 *OutSize, DATETIME *OutModificationTime, DATETIME *OutCreationTime = NULL, DATETIME *OutAccessTime = NULL);
+void MustGetFileItemInfo(const tstring &Path, FILE_ITEM_TYPE *OutType, uint64 *OutSize, DATETIME *OutModificationTime, DATETIME *OutCreationTime = NULL, DATETIME *OutAccessTime = NULL);
+/// Zwraca typ - czy to jest plik, katalog czy błąd/nie-istnieje.
+/** Jeśli błąd lub nie istnieje, zwraca common::IT_NONE. */
+FILE_ITEM_TYPE GetFileItemType(const tstring &Path);
+
+/// File time as returned by the system, without conversion to DATETIME.
+struct FILE_TIME_RAW
+{
+	/// Seconds since Unix epoch, 1 January 1970 UTC
+	int64 Seconds;
+	/// 0..999999999. Resolution depends on the file system.
+	uint32 Nanoseconds;
+
+	bool operator == (const FILE_TIME_RAW &t) const { return Seconds == t.Seconds && Nanoseconds == t.Nanoseconds; }
+	bool operator != (const FILE_TIME_RAW &t) const { return !operator==(t); }
+	bool operator <  (const FILE_TIME_RAW &t) const { return Seconds < t.Seconds || (Seconds == t.Seconds && Nanoseconds < t.Nanoseconds); }
+
+	DATETIME ToDatetime() const { DATETIME R; R.m_Time = Seconds * 1000 + Nanoseconds / 1000000; return R; }
+};
+
+/// Fields of FILE_ITEM_INFO to fill by GetFileItemInfos. Type is always filled.
+enum FILE_INFO_FIELDS
+{
+	FILE_INFO_SIZE              = 0x01,
+	FILE_INFO_MODIFICATION_TIME = 0x02,
+	FILE_INFO_CREATION_TIME     = 0x04,
+	FILE_INFO_ACCESS_TIME       = 0x08,
+	FILE_INFO_ALL               = 0x0F,
+};
+
+/// Information about one path returned by GetFileItemInfos
+/** Fields not requested are undefined. */
+struct FILE_ITEM_INFO
+{
+	/// IT_FILE or IT_DIR, like in GetFileItemInfo. IT_NONE if the path doesn't exist or cannot be queried.
+	FILE_ITEM_TYPE Type;
+	/// Undefined for directories.
+	uint64 Size;
+	FILE_TIME_RAW ModificationTime;
+	/// On Linux this is birth time if the file system provides it, otherwise status change time like in GetFileItemInfo.
+	FILE_TIME_RAW CreationTime;
+	FILE_TIME_RAW AccessTime;
+};
+
+/// Returns information about many paths at once.
+/**
+Out receives one entry for each path, in the same order. Missing paths are not errors - they have Type = IT_NONE.
+On Linux statx is used, asking only for requested fields, so the file system may skip the rest.
+On Windows GetFileAttributesEx is used. Large batches are split between threads, which helps
+a lot when metadata is not cached yet and has to be read from disk or network.
+\param Fields Combination of FILE_INFO_FIELDS.
+\param ThreadCount 0 means ThreadPool::GetHardwareThreadCount(), 1 means current thread only.
+*/
+void GetFileItemInfos(std::vector<FILE_ITEM_INFO> *Out, const std::vector<tstring> &Paths, uint Fields = FILE_INFO_ALL, uint ThreadCount = 0);
+
+/// Ustawia czas dostępu i modyfikacji podanego pliku na bieżący
+bool UpdateFileTimeToNow(const tstring &FileName);
+void MustUpdateFileTimeToNow(const tstring &FileName);
+/// Ustawia czas dostępu i modyfikacji podanego pliku na podane
+bool UpdateFileTime(const tstring &FileName, const DATETIME &ModificationTime, const DATETIME &AccessTime);
+void MustUpdateFileTime(const tstring &FileName, const DATETIME &ModificationTime, const DATETIME &AccessTime);
+
+/// Tworzy katalog
+bool CreateDirectory(const tstring &Path);
+void MustCreateDirectory(const tstring &Path);
+/// Usuwa katalog
+/** Katalog musi być pusty. */
+bool DeleteDirectory(const tstring &Path);
+void MustDeleteDirectory(const tstring &Path);
+/// Tworzy całą ścieżkę katalogów aż po podanego, np. <tt>"C:\A\B\C"</tt> nawet jeśli nie istniał nawet <tt>"C:\A"</tt>
+bool CreateDirectoryChain(const tstring &Path);
+void MustCreateDirectoryChain(const tstring &Path);
+
+/// Usuwa plik
+bool DeleteFile(const tstring &FileName);
+void MustDeleteFile(const tstring &FileName);
+/// Przenosi lub zmienia nazwę pliku lub katalogu
+/** Katalogi można przenosić tylko w ramach jednej partycji. Pliki niekoniecznie. */
+bool MoveItem(const tstring &OldPath, const tstring &NewPath);
+void MustMoveItem(const tstring &OldPath, const tstring &NewPath);
+
+// Pliki tekstowe z użyciem Unicode
+
+/// Kodowanie pliku tekstowego
+enum FILE_ENCODING
+{
+	/** \name Młodsze 16 bitów - kodowanie */
+	//@{
+	FILE_ENCODING_UTF16_LE = 1, ///< Zwykły UTF-16 stosowany w Windows (domyślnie dodaje BOM)
+	FILE_ENCODING_UTF8     = 2, ///< UTF-8 (domyślnie nie dodaje BOM)
+	FILE_ENCODING_ANSI     = 3, ///< Natywne kodowanie systemu. Poza Windows bajty to znaki ISO-8859-1.
+	FILE_ENCODING_UTF16_BE = 4, ///< UTF-16 Big Endian (domyślnie dodaje BOM)
+	FILE_ENCODING_UTF32_LE = 5, ///< UTF-32 Little Endian (domyślnie dodaje BOM)
+	FILE_ENCODING_UTF32_BE = 6, ///< UTF-32 Big Endian (domyślnie dodaje BOM)
+	//@}
+
+	/** \name Starsze 16 bitów - flagi dodatkowe */
+	//@{
+	/// Dołącz tą flagę dodatkowo | podczas zapisywania, aby wymusić nagłówek BOM.
+	FILE_ENCODING_FORCE_BOM  = 0x00010000,
+	/// Dołącz tą flagę dodatkowo | podczas zapisywania, aby wymusić brak nagłówka BOM.
+	FILE_ENCODING_NO_BOM     = 0x00020000,
+	/// Dołącz tą flagę dodatkowo podczas odczytywania, aby automatycznie wykryć kodowanie.
+	FILE_ENCODING_AUTODETECT = 0x00040000,
+	//@}
+};
+
+/// Zapisuje tekst Unicode do pliku w podanym kodowaniu
+/** Musisz podać jedną flagę common::FILE_ENCODING z kodowaniem.
+Możesz dodać jedną z flag wymuszając nagłówek BOM lub jego brak.
+Konwersja kodowań UTF jest ściśle sprawdzana (p. \ref base_utf), a duże teksty są
+konwertowane na wielu wątkach. Błąd powoduje wyjątek z pozycją błędnego znaku. */
+void SaveUnicodeToFile(const tstring &FileName, const wstring &Data, unsigned Encoding);
+void SaveUnicodeToFile(const tstring &FileName, const wchar_t *Data, size_t NumChars, unsigned Encoding);
+
+void SaveUnicodeToStream(Stream *Dest, const wstring &Data, unsigned Encoding);
+void SaveUnicodeToStream(Stream *Dest, const wchar_t *Data, size_t NumChars, unsigned Encoding);
+
+/// Wczytuje plik tekstowy do łańcucha Unicode
+/** \param Encoding:
+- Możesz podać samo kodowanie, aby wczytać w z góry założonym kodowaniu (dużo szybsze!)
+- Możesz podać samo common::FILE_ENCODING_AUTODETECT, aby automatycznie wykryć kodowanie.
+- Możesz podać common::FILE_ENCODING_AUTODETECT i dodać jedno z kodowań, aby automatycznie wykryć,
+  a w przypadku wątpliwości wybrać podane.
+\param OutEncoding - zwraca wykryte kodowanie. Jeśli cię nie interesuję, możesz podać NULL.
+
+Nagłówek BOM jest zawsze rozpoznawany. Niepoprawne dane w podanym kodowaniu UTF powodują wyjątek
+z pozycją błędu w bajtach. Jeśli dane nie są poprawne w kodowaniu wykrytym bez nagłówka BOM,
+są wczytywane jako ANSI.
+*/
+void LoadUnicodeFromFile(const tstring &FileName, wstring *Out, unsigned Encoding, FILE_ENCODING *OutEncoding = NULL);
+/// Wczytuje plik tekstowy do łańcucha ANSI.
+/** Wspiera te same kodowania co common::OutEncoding.
+Poza Windows łańcuch wynikowy jest w UTF-8, a kodowanie ANSI jest wczytywane bez zmian. */
+void LoadUnicodeFromFile(const tstring &FileName, string *Out, unsigned Encoding, FILE_ENCODING *OutEncoding = NULL);
+
+void LoadUnicodeFromStream(SeekableStream *Src, wstring *Out, unsigned Encoding, FILE_ENCODING *OutEncoding = NULL);
+void LoadUnicodeFromStream(SeekableStream *Src, string *Out, unsigned Encoding, FILE_ENCODING *OutEncoding = NULL);
+
+/// \internal
+class FileContent_pimpl;
+
+/// Immutable contents of a file returned by FileCache.
+/**
+Copying is cheap and thread-safe - only a reference count changes. Data stays valid as long as any
+copy exists, even when the file was evicted from the cache or changed on disk.
+Default constructed object is null - has no data.
+
+Data can be read without copying, e.g. with <tt>MemoryStream(C.GetSize(), (void*)C.GetData())</tt>
+or <tt>Tokenizer(C.GetData(), C.GetSize() / sizeof(tchar), 0)</tt>. It must not be modified.
+*/
+class FileContent
+{
+private:
+	FileContent_pimpl *pimpl;
+
+	friend class FileCache_pimpl;
+	explicit FileContent(FileContent_pimpl *p);
+
+public:
+	FileContent();
+	FileContent(const FileContent &Src);
+	~FileContent();
+	FileContent & operator = (const FileContent &Src);
+
+	bool IsNull() const { return pimpl == NULL; }
+	/// Not null-terminated.
+	const char * GetData() const;
+	size_t GetSize() const;
+	/// Returns true if data is a memory-mapped view of the file rather than a copy loaded into memory.
+	bool IsMapped() const;
+};
+
+/// \internal
+class FileCache_pimpl;
+
+/// Thread-safe cache of file contents with memory budget and LRU eviction.
+/**
+Every Get checks size and modification time of the file (one system call, see GetFileItemInfos)
+and loads it again if they changed. Files modified less than RACY_TIME before loading are returned,
+but not cached, because another change with the same time could go unnoticed.
+
+Files of size at least MapThreshold are memory-mapped instead of loaded. Don't use mapping for files
+that are modified in place - truncating a mapped file crashes the program on access. Files replaced
+atomically (see AtomicFileStream) are safe, because the old content stays mapped.
+
+Entries are counted in the budget by their size. When the total exceeds the budget, least recently
+used entries are removed. Entry larger than the whole budget is returned, but not cached.
+All methods can be called from many threads.
+*/
+class FileCache
+{
+	DECLARE_NO_COPY_CLASS(FileCache)
+
+private:
+	scoped_ptr<FileCache_pimpl> pimpl;
+
+public:
+	/// Default memory budget - 64 MB.
+	static const uint64 DEFAULT_BUDGET = 64 * 1024 * 1024;
+	/// Default size starting from which files are memory-mapped - 1 MB.
+	static const uint64 DEFAULT_MAP_THRESHOLD = 1024 * 1024;
+	/// Use as MapThreshold to never memory-map files.
+	static const uint64 NO_MAPPING = 0xFFFFFFFFFFFFFFFFull;
+	/// Time in milliseconds.
+	static const int64 RACY_TIME = 2000;
+
+	FileCache(uint64 Budget = DEFAULT_BUDGET, uint64 MapThreshold = DEFAULT_MAP_THRESHOLD);
+	~FileCache();
+
+	/// Returns contents of the file, from the cache if it didn't change. Throws Error if it cannot be read.
+	void Get(FileContent *Out, const tstring &Path);
+	/// Like LoadStringFromFile, but through the cache. Copies the data.
+	void GetString(string *Out, const tstring &Path);
+	/// Like LoadUnicodeFromFile, but through the cache. Only the conversion is done every time.
+	void GetUnicode(wstring *Out, const tstring &Path, unsigned Encoding, FILE_ENCODING *OutEncoding = NULL);
+
+	/// Removes the file from the cache. Copies of FileContent given out stay valid.
+	void Remove(const tstring &Path);
+	void Clear();
+
+	uint64 GetBudget();
+	/// Evicts entries if needed to fit in the new budget.
+	void SetBudget(uint64 Budget);
+	/// Returns sum of sizes of cached entries.
+	uint64 GetUsedBytes();
+	size_t GetCount();
+	void GetStats(uint64 *OutHitCount, uint64 *OutMissCount);
+};
+
+//@}
+// code_files
+
+} // namespace common
+
+#endif
@@ -1,13 +1,13 @@
-/** \file
-\brief Very fast memory allocator
-\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
-
-Part of CommonLib library. \n
-Encoding UTF-8, end of line CR+LF \n
-License: GNU LGPL. \n
-Documentation: \ref FreeList
-*/
-//#include "Base.hpp"
-//#include "FreeList.hpp"
-
-// Totally empty.
+/** \file
+\brief Very fast memory allocator
+\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
+
+Part of CommonLib library. \n
+Encoding UTF-8, end of line CR+LF \n
+License: GNU LGPL. \n
+Documentation: \ref FreeList
+*/
+//#include "Base.hpp"
+//#include "FreeList.hpp"
+
+// Totally empty.
@@ -1,4556 +1,4556 @@
-/** \file
-\brief Mathematical module
-\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
-
-Part of CommonLib library. \n
-Encoding UTF-8, end of line CR+LF \n
-License: GNU LGPL. \n
-Documentation: \ref Module_Math \n
-Module components: \ref code_math
-*/
-#if defined(_MSC_VER) && (_MSC_VER >= 1200)
-#pragma once
-#endif
-#ifndef COMMON_MATH_H_
-#define COMMON_MATH_H_
-
-#ifdef _WIN32
-	#include <windows.h> // bo bez tego w d3d9types.h s bdy bo nie zna DWORD itp., poza tym potrzebny jest Point itd.
-#endif
-
-#ifdef USE_DIRECTX
-	#include <d3dx9.h>
-#endif
-
-#include <functional>
-
-namespace common
-{
-
-/** \addtogroup code_math Math Module
-Dokumentacja: \ref Module_Math \n
-Nagwek: Math.hpp */
-//@{
-
-/// Szablon bazowy do konwersji midzy typami matematycznymi
-/** Ta wersja nie dziaa, specjalizacje bd dziaa. */
-template <typename DestT, typename SrcT>
-DestT & math_cast(const SrcT &x)
-{
-	assert(0 && "Unsupported type in math_cast.");
-}
-
-/// Maa staa
-const float FLOAT_EPSILON = 1e-6f;
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-/** \addtogroup math_point Punkt 2D z liczb cakowitych */
-//@{
-
-/// Punkt 2D z liczb cakowitych
-/**
-Kompatybilny ze struktur POINT z Win32API.
-Nazywa si tak dziwnie, bo POINT to w Windows API marko i robi problem z nazw.
-Konwersja do i ze stringa: "x,y", np. "10,1".
-*/
-struct POINT_
-{
-	union
-	{
-		struct
-		{
-			int x, y;
-		};
-		int v[2];
-	};
-
-	static const POINT_ ZERO;
-
-	POINT_() { }
-	POINT_(int x, int y) : x(x), y(y) { }
-
-	bool operator == (const POINT_ &v) const { return x == v.x && y == v.y; }
-	bool operator != (const POINT_ &v) const { return x != v.x || y != v.y; }
-
-	POINT_ operator - () const { return POINT_(-x, -y); }
-	POINT_ operator + (const POINT_ &v) const { return POINT_(x+v.x, y+v.y); }
-	POINT_ operator - (const POINT_ &v) const { return POINT_(x-v.x, y-v.y); }
-	POINT_ & operator += (const POINT_ &v) { x += v.x; y += v.y; return *this; }
-	POINT_ & operator -= (const POINT_ &v) { x -= v.x; y -= v.y; return *this; }
-	POINT_ & operator *= (int v) { x *= v; y *= v; return *this; }
-	POINT_ & operator /= (int v) { x /= v; y /= v; return *this; }
-
-	int & operator [] (size_t Index) { return v[Index]; }
-	const int & operator [] (size_t Index) const { return v[Index]; }
-
-	int * GetArray() { return &x; }
-	const int * GetArray() const { return &x; }
-};
-
-inline POINT_ operator * (const POINT_ &pt, int v) { return POINT_(pt.x*v, pt.y*v); }
-inline POINT_ operator / (const POINT_ &pt, int v) { return POINT_(pt.x/v, pt.y/v); }
-inline POINT_ operator * (int v, const POINT_ &pt) { return POINT_(pt.x*v, pt.y*v); }
-inline POINT_ operator / (int v, const POINT_ &pt) { return POINT_(pt.x/v, pt.y/v); }
-
-#ifdef _WIN32
-	/// Konwersja z common::POINT_ do POINT
-	template <> inline ::POINT & math_cast<::POINT, POINT_>(const POINT_ &x) { return (::POINT&)(x); }
-	/// Konwersja z POINT do common::POINT_
-	template <> inline POINT_ & math_cast<POINT_, ::POINT>(const ::POINT &x) { return (POINT_&)(x); }
-#endif
-
-extern const common::POINT_ POINT_ZERO;
-extern const common::POINT_ POINT_ONE;
-extern const common::POINT_ POINT_NEGATIVE_X;
-extern const common::POINT_ POINT_NEGATIVE_Y;
-extern const common::POINT_ POINT_POSITIVE_X;
-extern const common::POINT_ POINT_POSITIVE_Y;
-
-inline void swap(POINT_ &v1, POINT_ &v2)
-{
-	std::swap(v1.x, v2.x);
-	std::swap(v1.y, v2.y);
-}
-
-inline void Mul(POINT_ *out, const POINT_ &p1, const POINT_ &p2)
-{
-	out->x = p1.x * p2.x;
-	out->y = p1.y * p2.y;
-}
-inline void Div(POINT_ *out, const POINT_ &p1, const POINT_ &p2)
-{
-	out->x = p1.x / p2.x;
-	out->y = p1.y / p2.y;
-}
-
-inline void Mul(POINT_ *inout, const POINT_ &v)
-{
-	inout->x *= v.x;
-	inout->y *= v.y;
-}
-inline void Div(POINT_ *inout, const POINT_ &v)
-{
-	inout->x /= v.x;
-	inout->y /= v.y;
-}
-
-inline void Min(common::POINT_ *out, const common::POINT_ &a, const common::POINT_ &b)
-{
-	out->x = std::min(a.x, b.x);
-	out->y = std::min(a.y, b.y);
-}
-
-inline void Max(common::POINT_ *out, const common::POINT_ &a, const common::POINT_ &b)
-{
-	out->x = std::max(a.x, b.x);
-	out->y = std::max(a.y, b.y);
-}
-
-//@}
-// math_point
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-/** \addtogroup math_vec Wektor floatw 2D, 3D, 4D */
-//@{
-
-#if defined(USE_DIRECTX) && !defined(DOXYGEN)
-	typedef D3DXVECTOR2 VEC2;
-#else
-	/// Wektor floatw 2D
-	struct VEC2
-	{
-		float x, y;
-
-		VEC2() { }
-		VEC2(float x, float y) : x(x), y(y) { }
-		VEC2(const float *Array) : x(Array[0]), y(Array[1]) { }
-
-		operator float * () { return &x; }
-		operator const float * () const { return &x; }
-
-		bool operator == (const VEC2 &v) const { return x == v.x && y == v.y; }
-		bool operator != (const VEC2 &v) const { return x != v.x || y != v.y; }
-
-		VEC2 operator + () const { return *this; }
-		VEC2 operator - () const { return VEC2(-x, -y); }
-		VEC2 operator + (const VEC2 &v) const { return VEC2(x+v.x, y+v.y); }
-		VEC2 operator - (const VEC2 &v) const { return VEC2(x-v.x, y-v.y); }
-		VEC2 & operator += (const VEC2 &v) { x += v.x; y += v.y; return *this; }
-		VEC2 & operator -= (const VEC2 &v) { x -= v.x; y -= v.y; return *this; }
-		VEC2 & operator *= (float v) { x *= v; y *= v; return *this; }
-		VEC2 & operator /= (float v) { float vInv = 1.0f/v; x *= vInv; y *= vInv; return *this; }
-	};
-	inline VEC2 operator * (const VEC2 &pt, float v) { return VEC2(pt.x*v, pt.y*v); }
-	inline VEC2 operator / (const VEC2 &pt, float v) { float vInv = 1.0f/v; return VEC2(pt.x*vInv, pt.y*vInv); }
-	inline VEC2 operator * (float v, const VEC2 &pt) { return VEC2(pt.x*v, pt.y*v); }
-#endif
-
-inline void swap(VEC2 &v1, VEC2 &v2)
-{
-	std::swap(v1.x, v2.x);
-	std::swap(v1.y, v2.y);
-}
-
-#if defined(USE_DIRECTX) && !defined(DOXYGEN)
-	typedef D3DXVECTOR3 VEC3;
-#else
-	/// Wektor floatw 3D
-	struct VEC3
-	{
-		float x, y, z;
-
-		VEC3() { }
-		VEC3(float x, float y, float z) : x(x), y(y), z(z) { }
-		VEC3(const float *Array) : x(Array[0]), y(Array[1]), z(Array[2]) { }
-
-		operator float * () { return &x; }
-		operator const float * () const { return &x; }
-
-		bool operator == (const VEC3 &v) const { return x == v.x && y == v.y && z == v.z; }
-		bool operator != (const VEC3 &v) const { return x != v.x || y != v.y || z != v.z; }
-
-		VEC3 operator + () const { return *this; }
-		VEC3 operator - () const { return VEC3(-x, -y, -z); }
-		VEC3 operator + (const VEC3 &v) const { return VEC3(x+v.x, y+v.y, z+v.z); }
-		VEC3 operator - (const VEC3 &v) const { return VEC3(x-v.x, y-v.y, z-v.z); }
-		VEC3 & operator += (const VEC3 &v) { x += v.x; y += v.y; z += v.z; return *this; }
-		VEC3 & operator -= (const VEC3 &v) { x -= v.x; y -= v.y; z -= v.z; return *this; }
-		VEC3 & operator *= (float v) { x *= v; y *= v; z *= v; return *this; }
-		VEC3 & operator /= (float v) { float vInv = 1.0f/v; x *= vInv; y *= vInv; z *= vInv; return *this; }
-	};
-	inline VEC3 operator * (const VEC3 &pt, float v) { return VEC3(pt.x*v, pt.y*v, pt.z*v); }
-	inline VEC3 operator / (const VEC3 &pt, float v) { float vInv = 1.0f/v; return VEC3(pt.x*vInv, pt.y*vInv, pt.z*vInv); }
-	inline VEC3 operator * (float v, const VEC3 &pt) { return VEC3(pt.x*v, pt.y*v, pt.z*v); }
-#endif
-
-inline void swap(VEC3 &v1, VEC3 &v2)
-{
-	std::swap(v1.x, v2.x);
-	std::swap(v1.y, v2.y);
-	std::swap(v1.z, v2.z);
-}
-
-#if defined(USE_DIRECTX) && !defined(DOXYGEN)
-	typedef D3DXVECTOR4 VEC4;
-#else
-	/// Wektor floatw 4D
-	struct VEC4
-	{
-		float x, y, z, w;
-
-		VEC4() { }
-		VEC4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) { }
-		VEC4(const float *Array) : x(Array[0]), y(Array[1]), z(Array[2]), w(Array[3]) { }
-
-		operator float * () { return &x; }
-		operator const float * () const { return &x; }
-
-		bool operator == (const VEC4 &v) const { return x == v.x && y == v.y && z == v.z && w == v.w; }
-		bool operator != (const VEC4 &v) const { return x != v.x || y != v.y || z != v.z || w != v.w; }
-
-		VEC4 operator + () const { return *this; }
-		VEC4 operator - () const { return VEC4(-x, -y, -z, -w); }
-		VEC4 operator + (const VEC4 &v) const { return VEC4(x+v.x, y+v.y, z+v.z, w+v.w); }
-		VEC4 operator - (const VEC4 &v) const { return VEC4(x-v.x, y-v.y, z-v.z, w-v.w); }
-		VEC4 & operator += (const VEC4 &v) { x += v.x; y += v.y; z += v.z; w += v.w; return *this; }
-		VEC4 & operator -= (const VEC4 &v) { x -= v.x; y -= v.y; z -= v.z; w -= v.w; return *this; }
-		VEC4 & operator *= (float v) { x *= v; y *= v; z *= v; w *= v; return *this; }
-		VEC4 & operator /= (float v) { float vInv = 1.0f/v; x *= vInv; y *= vInv; z *= vInv; w *= vInv; return *this; }
-	};
-	inline VEC4 operator * (const VEC4 &pt, float v) { return VEC4(pt.x*v, pt.y*v, pt.z*v, pt.w*v); }
-	inline VEC4 operator / (const VEC4 &pt, float v) { float vInv = 1.0f/v; return VEC4(pt.x*vInv, pt.y*vInv, pt.z*vInv, pt.w*vInv); }
-	inline VEC4 operator * (float v, const VEC4 &pt) { return VEC4(pt.x*v, pt.y*v, pt.z*v, pt.w*v); }
-#endif
-
-inline void swap(VEC4 &v1, VEC4 &v2)
-{
-	std::swap(v1.x, v2.x);
-	std::swap(v1.y, v2.y);
-	std::swap(v1.z, v2.z);
-	std::swap(v1.w, v2.w);
-}
-
-extern const VEC2 VEC2_ZERO;
-extern const VEC2 VEC2_ONE;
-extern const VEC2 VEC2_POSITIVE_X;
-extern const VEC2 VEC2_POSITIVE_Y;
-extern const VEC2 VEC2_NEGATIVE_X;
-extern const VEC2 VEC2_NEGATIVE_Y;
-
-extern const VEC3 VEC3_ZERO;
-extern const VEC3 VEC3_ONE;
-extern const VEC3 VEC3_POSITIVE_X;
-extern const VEC3 VEC3_POSITIVE_Y;
-extern const VEC3 VEC3_POSITIVE_Z;
-extern const VEC3 VEC3_NEGATIVE_X;
-extern const VEC3 VEC3_NEGATIVE_Y;
-extern const VEC3 VEC3_NEGATIVE_Z;
-
-extern const VEC4 VEC4_ZERO;
-extern const VEC4 VEC4_ONE;
-extern const VEC4 VEC4_POSITIVE_X;
-extern const VEC4 VEC4_POSITIVE_Y;
-extern const VEC4 VEC4_POSITIVE_Z;
-extern const VEC4 VEC4_POSITIVE_W;
-extern const VEC4 VEC4_NEGATIVE_X;
-extern const VEC4 VEC4_NEGATIVE_Y;
-extern const VEC4 VEC4_NEGATIVE_Z;
-extern const VEC4 VEC4_NEGATIVE_W;
-
-/// Zwraca kwadrat dugoci wektora
-inline float LengthSq(const VEC2 &v)
-{
-	return v.x*v.x + v.y*v.y;
-}
-/// \copydoc LengthSq(const VEC2&)
-inline float LengthSq(const VEC3 &v)
-{
-	return v.x*v.x + v.y*v.y + v.z*v.z;
-}
-/// \copydoc LengthSq(const VEC2&)
-inline float LengthSq(const VEC4 &v)
-{
-	return v.x*v.x + v.y*v.y + v.z*v.z + v.w*v.w;
-}
-
-/// Zwraca dugo wektora
-inline float Length(const VEC2 &v)
-{
-	return sqrtf(LengthSq(v));
-}
-/// \copydoc Length(const VEC2&)
-inline float Length(const VEC3 &v)
-{
-	return sqrtf(LengthSq(v));
-}
-/// \copydoc Length(const VEC2&)
-inline float Length(const VEC4 &v)
-{
-	return sqrtf(LengthSq(v));
-}
-
-inline float ManhattanLength(const VEC2 &v)
-{
-	return fabsf(v.x) + fabsf(v.y);
-}
-inline float ManhattanLength(const VEC3 &v)
-{
-	return fabsf(v.x) + fabsf(v.y) + fabsf(v.z);
-}
-inline float ManhattanLength(const VEC4 &v)
-{
-	return fabsf(v.x) + fabsf(v.y) + fabsf(v.z) + fabsf(v.z);
-}
-
-inline float MaxLength(const VEC2 &v)
-{
-	return std::max(fabsf(v.x), fabsf(v.y));
-}
-inline float MaxLength(const VEC3 &v)
-{
-	return max3(fabsf(v.x), fabsf(v.y), fabsf(v.z));
-}
-inline float MaxLength(const VEC4 &v)
-{
-	return std::max(
-		std::max(fabsf(v.x), fabsf(v.y)),
-		std::max(fabsf(v.z), fabsf(v.z)) );
-}
-
-/// Zwraca wektor zoony z mniejszych skadowych podanych wektorw
-inline void Min(VEC2 *Out, const VEC2 &v1, const VEC2 &v2)
-{
-	Out->x = std::min(v1.x, v2.x);
-	Out->y = std::min(v1.y, v2.y);
-}
-inline void Min(VEC3 *Out, const VEC3 &v1, const VEC3 &v2)
-{
-	Out->x = std::min(v1.x, v2.x);
-	Out->y = std::min(v1.y, v2.y);
-	Out->z = std::min(v1.z, v2.z);
-}
-inline void Min(VEC4 *Out, const VEC4 &v1, const VEC4 &v2)
-{
-	Out->x = std::min(v1.x, v2.x);
-	Out->y = std::min(v1.y, v2.y);
-	Out->z = std::min(v1.z, v2.z);
-	Out->w = std::min(v1.w, v2.w);
-}
-
-/// Zwraca wektor zoony z wikszych skadowych podanych wektorw
-inline void Max(VEC2 *Out, const VEC2 &v1, const VEC2 &v2)
-{
-	Out->x = std::max(v1.x, v2.x);
-	Out->y = std::max(v1.y, v2.y);
-}
-inline void Max(VEC3 *Out, const VEC3 &v1, const VEC3 &v2)
-{
-	Out->x = std::max(v1.x, v2.x);
-	Out->y = std::max(v1.y, v2.y);
-	Out->z = std::max(v1.z, v2.z);
-}
-inline void Max(VEC4 *Out, const VEC4 &v1, const VEC4 &v2)
-{
-	Out->x = std::max(v1.x, v2.x);
-	Out->y = std::max(v1.y, v2.y);
-	Out->z = std::max(v1.z, v2.z);
-	Out->w = std::max(v1.w, v2.w);
-}
-
-inline void saturate(VEC2 &v)
-{
-	v.x = saturate(v.x); v.y = saturate(v.y);
-}
-inline void saturate(VEC3 &v)
-{
-	v.x = saturate(v.x); v.y = saturate(v.y); v.z = saturate(v.z);
-}
-inline void saturate(VEC4 &v)
-{
-	v.x = saturate(v.x); v.y = saturate(v.y); v.z = saturate(v.z); v.w = saturate(v.w);
-}
-
-/** \addtogroup math_vec_componentop Operacje na poszczeglnych skadowych wektorw */
-//@{
-
-inline void Mul(VEC2 *Out, const VEC2 &v, float f)
-{
-	Out->x = v.x * f;
-	Out->y = v.y * f;
-}
-inline void Mul(VEC3 *Out, const VEC3 &v, float f)
-{
-	Out->x = v.x * f;
-	Out->y = v.y * f;
-	Out->z = v.z * f;
-}
-inline void Mul(VEC4 *Out, const VEC4 &v, float f)
-{
-	Out->x = v.x * f;
-	Out->y = v.y * f;
-	Out->z = v.z * f;
-	Out->w = v.w * f;
-}
-
-inline void Add(VEC2 *Out, const VEC2 &v1, const VEC2 &v2)
-{
-	Out->x = v1.x + v2.x;
-	Out->y = v1.y + v2.y;
-}
-inline void Add(VEC3 *Out, const VEC3 &v1, const VEC3 &v2)
-{
-	Out->x = v1.x + v2.x;
-	Out->y = v1.y + v2.y;
-	Out->z = v1.z + v2.z;
-}
-inline void Add(VEC4 *Out, const VEC4 &v1, const VEC4 &v2)
-{
-	Out->x = v1.x + v2.x;
-	Out->y = v1.y + v2.y;
-	Out->z = v1.z + v2.z;
-	Out->w = v1.w + v2.w;
-}
-
-inline void Sub(VEC2 *Out, const VEC2 &v1, const VEC2 &v2)
-{
-	Out->x = v1.x - v2.x;
-	Out->y = v1.y - v2.y;
-}
-inline void Sub(VEC3 *Out, const VEC3 &v1, const VEC3 &v2)
-{
-	Out->x = v1.x - v2.x;
-	Out->y = v1.y - v2.y;
-	Out->z = v1.z - v2.z;
-}
-inline void Sub(VEC4 *Out, const VEC4 &v1, const VEC4 &v2)
-{
-	Out->x = v1.x - v2.x;
-	Out->y = v1.y - v2.y;
-	Out->z = v1.z - v2.z;
-	Out->w = v1.w - v2.w;
-}
-
-inline void Mul(VEC2 *Out, const VEC2 &v1, const VEC2 &v2)
-{
-	Out->x = v1.x * v2.x;
-	Out->y = v1.y * v2.y;
-}
-inline void Mul(VEC3 *Out, const VEC3 &v1, const VEC3 &v2)
-{
-	Out->x = v1.x * v2.x;
-	Out->y = v1.y * v2.y;
-	Out->z = v1.z * v2.z;
-}
-inline void Mul(VEC4 *Out, const VEC4 &v1, const VEC4 &v2)
-{
-	Out->x = v1.x * v2.x;
-	Out->y = v1.y * v2.y;
-	Out->z = v1.z * v2.z;
-	Out->w = v1.w * v2.w;
-}
-
-inline void Div(VEC2 *Out, const VEC2 &v1, const VEC2 &v2)
-{
-	Out->x = v1.x / v2.x;
-	Out->y = v1.y / v2.y;
-}
-inline void Div(VEC3 *Out, const VEC3 &v1, const VEC3 &v2)
-{
-	Out->x = v1.x / v2.x;
-	Out->y = v1.y / v2.y;
-	Out->z = v1.z / v2.z;
-}
-inline void Div(VEC4 *Out, const VEC4 &v1, const VEC4 &v2)
-{
-	Out->x = v1.x / v2.x;
-	Out->y = v1.y / v2.y;
-	Out->z = v1.z / v2.z;
-	Out->w = v1.w / v2.w;
-}
-
-inline void Mul(VEC2 *inout, const VEC2 &v)
-{
-	inout->x *= v.x;
-	inout->y *= v.y;
-}
-inline void Mul(VEC3 *inout, const VEC3 &v)
-{
-	inout->x *= v.x;
-	inout->y *= v.y;
-	inout->z *= v.z;
-}
-inline void Mul(VEC4 *inout, const VEC4 &v)
-{
-	inout->x *= v.x;
-	inout->y *= v.y;
-	inout->z *= v.z;
-	inout->w *= v.w;
-}
-
-inline void Div(VEC2 *inout, const VEC2 &v)
-{
-	inout->x /= v.x;
-	inout->y /= v.y;
-}
-inline void Div(VEC3 *inout, const VEC3 &v)
-{
-	inout->x /= v.x;
-	inout->y /= v.y;
-	inout->z /= v.z;
-}
-inline void Div(VEC4 *inout, const VEC4 &v)
-{
-	inout->x /= v.x;
-	inout->y /= v.y;
-	inout->z /= v.z;
-	inout->w /= v.w;
-}
-
-inline void Abs(VEC2 *v) { v->x = fabsf(v->x); v->y = fabsf(v->y); }
-inline void Abs(VEC3 *v) { v->x = fabsf(v->x); v->y = fabsf(v->y); v->z = fabsf(v->z); }
-inline void Abs(VEC4 *v) { v->x = fabsf(v->x); v->y = fabsf(v->y); v->z = fabsf(v->z); v->w = fabsf(v->w); }
-
-//@}
-// math_vec_componentop
-
-/// Iloczyn skalarny wektorw
-inline float Dot(const VEC2 &v1, const VEC2 &v2)
-{
-	return v1.x*v2.x + v1.y*v2.y;
-}
-inline float Dot(const VEC3 &v1, const VEC3 &v2)
-{
-	return v1.x*v2.x + v1.y*v2.y + v1.z*v2.z;
-}
-inline float Dot(const VEC4 &v1, const VEC4 &v2)
-{
-	return v1.x*v2.x + v1.y*v2.y + v1.z*v2.z + v1.w*v2.w;
-}
-
-/// Odwraca znak skadowych wektora
-inline void Minus(VEC2 *Out, VEC2 &v) { Out->x = -v.x; Out->y = -v.y; }
-inline void Minus(VEC3 *Out, VEC3 &v) { Out->x = -v.x; Out->y = -v.y; Out->z = -v.z; }
-inline void Minus(VEC4 *Out, VEC4 &v) { Out->x = -v.x; Out->y = -v.y; Out->z = -v.z; Out->w = -v.w; }
-inline void Minus(VEC2 *InOut) { InOut->x = -InOut->x; InOut->y = -InOut->y; }
-inline void Minus(VEC3 *InOut) { InOut->x = -InOut->x; InOut->y = -InOut->y; InOut->z = -InOut->z; }
-inline void Minus(VEC4 *InOut) { InOut->x = -InOut->x; InOut->y = -InOut->y; InOut->z = -InOut->z; InOut->w = -InOut->w; }
-
-/// Iloczyn wektorowy dwch wektorw dajcy liczb mwic czy drugi wskazuje na lewo, czy na prawo wzgldem pierwszego
-/** W ukadzie gdzie X jest w prawo a Y do gry, > 0 znaczy na lewo \n
-W ukadzie gdzie X jest w prawo a Y w d, > 0 znaczy na prawo */
-inline float Cross(const VEC2 &v1, const VEC2 &v2)
-{
-	return v1.x*v2.y - v1.y*v2.x;
-}
-
-/// Iloczyn wektorowy dwch wektorw 3D
-inline void Cross(VEC3 *Out, const VEC3 &v1, const VEC3 &v2)
-{
-	Out->x = v1.y * v2.z - v1.z * v2.y;
-	Out->y = v1.z * v2.x - v1.x * v2.z;
-	Out->z = v1.x * v2.y - v1.y * v2.x;
-}
-
-/// Kwadrat odlegoci midzy dwoma punktami
-inline float DistanceSq(const VEC2 &p1, const VEC2 &p2)
-{
-	return LengthSq(p2-p1);
-}
-inline float DistanceSq(const VEC3 &p1, const VEC3 &p2)
-{
-	return LengthSq(p2-p1);
-}
-inline float DistanceSq(const VEC4 &p1, const VEC4 &p2)
-{
-	return LengthSq(p2-p1);
-}
-
-/// Odlego midzy dwoma punktami
-inline float Distance(const VEC2 &p1, const VEC2 &p2)
-{
-	return Length(p2-p1);
-}
-inline float Distance(const VEC3 &p1, const VEC3 &p2)
-{
-	return Length(p2-p1);
-}
-inline float Distance(const VEC4 &p1, const VEC4 &p2)
-{
-	return Length(p2-p1);
-}
-
-inline float ManhattanDistance(const VEC2 &p1, const VEC2 &p2)
-{
-	return fabsf(p2.x-p1.x) + fabsf(p2.y-p1.y);
-}
-inline float ManhattanDistance(const VEC3 &p1, const VEC3 &p2)
-{
-	return fabsf(p2.x-p1.x) + fabsf(p2.y-p1.y) + fabsf(p2.z-p1.z);
-}
-inline float ManhattanDistance(const VEC4 &p1, const VEC4 &p2)
-{
-	return fabsf(p2.x-p1.x) + fabsf(p2.y-p1.y) + fabsf(p2.z-p1.z) + fabsf(p2.w-p1.w);
-}
-
-inline float MaxDistance(const VEC2 &p1, const VEC2 &p2)
-{
-	return std::max( fabsf(p2.x-p1.x), fabsf(p2.y-p1.y) );
-}
-inline float MaxDistance(const VEC3 &p1, const VEC3 &p2)
-{
-	return max3( fabsf(p2.x-p1.x), fabsf(p2.y-p1.y), fabsf(p2.z-p1.z) );
-}
-inline float MaxDistance(const VEC4 &p1, const VEC4 &p2)
-{
-	return std::max(
-		std::max( fabsf(p2.x-p1.x), fabsf(p2.y-p1.y) ),
-		std::max( fabsf(p2.z-p1.z), fabsf(p2.w-p1.w) ) );
-}
-
-/// Liniowa interpolacja wektorw
-inline void Lerp(VEC2 *Out, const VEC2 &v1, const VEC2 &v2, float t)
-{
-	Out->x = v1.x + t*(v2.x-v1.x);
-	Out->y = v1.y + t*(v2.y-v1.y);
-}
-inline void Lerp(VEC3 *Out, const VEC3 &v1, const VEC3 &v2, float t)
-{
-	Out->x = v1.x + t*(v2.x-v1.x);
-	Out->y = v1.y + t*(v2.y-v1.y);
-	Out->z = v1.z + t*(v2.z-v1.z);
-}
-inline void Lerp(VEC4 *Out, const VEC4 &v1, const VEC4 &v2, float t)
-{
-	Out->x = v1.x + t*(v2.x-v1.x);
-	Out->y = v1.y + t*(v2.y-v1.y);
-	Out->z = v1.z + t*(v2.z-v1.z);
-	Out->w = v1.w + t*(v2.w-v1.w);
-}
-
-/// Normalizuje wektor, czyli zmienia mu dugo na 1
-inline void Normalize(VEC2 *Out, const VEC2 &v)
-{
-	float l = 1.0f / Length(v);
-	Out->x = v.x * l;
-	Out->y = v.y * l;
-}
-inline void Normalize(VEC3 *Out, const VEC3 &v)
-{
-	float l = 1.0f / Length(v);
-	Out->x = v.x * l;
-	Out->y = v.y * l;
-	Out->z = v.z * l;
-}
-inline void Normalize(VEC4 *Out, const VEC4 &v)
-{
-	float l = 1.0f / Length(v);
-	Out->x = v.x * l;
-	Out->y = v.y * l;
-	Out->z = v.z * l;
-	Out->w = v.w * l;
-}
-
-/// Normalizuje wektor w miejscu
-inline void Normalize(VEC2 *v)
-{
-	float rcl = 1.0f / Length(*v);
-	v->x *= rcl;
-	v->y *= rcl;
-}
-inline void Normalize(VEC3 *v)
-{
-	float rcl = 1.0f / Length(*v);
-	v->x *= rcl;
-	v->y *= rcl;
-	v->z *= rcl;
-}
-inline void Normalize(VEC4 *v)
-{
-	float rcl = 1.0f / Length(*v);
-	v->x *= rcl;
-	v->y *= rcl;
-	v->z *= rcl;
-	v->w *= rcl;
-}
-
-/// Bezpieczna normalizacja wektora w miejscu. W przypadku wektora zerowego zwraca false.
-inline bool SafeNormalize(VEC2 *v)
-{
-	float lenSq = LengthSq(*v);
-	if (lenSq < FLOAT_EPSILON) return false;
-	float f = 1.f / sqrtf(lenSq);
-	v->x *= f; v->y *= f;
-	return true;
-}
-inline bool SafeNormalize(VEC3 *v)
-{
-	float lenSq = LengthSq(*v);
-	if (lenSq < FLOAT_EPSILON) return false;
-	float f = 1.f / sqrtf(lenSq);
-	v->x *= f; v->y *= f; v->z *= f;
-	return true;
-}
-inline bool SafeNormalize(VEC4 *v)
-{
-	float lenSq = LengthSq(*v);
-	if (lenSq < FLOAT_EPSILON) return false;
-	float f = 1.f / sqrtf(lenSq);
-	v->x *= f; v->y *= f; v->z *= f; v->w *= f;
-	return true;
-}
-
-/// Konwersja z wektora 3D na 4D dopisujca W=1
-inline void Vec3ToVec4(VEC4 *Out, const VEC3 &v)
-{
-	Out->x = v.x;
-	Out->y = v.y;
-	Out->z = v.z;
-	Out->w = 1.0f;
-}
-
-/// Konwersja z wektora 4D na 3D ze zignorowaniem skadowej W
-inline void Vec4ToVec3_Ignore(VEC3 *Out, const VEC4 &v)
-{
-	Out->x = v.x;
-	Out->y = v.y;
-	Out->z = v.z;
-}
-/// Konwersja z wektora 4D na 3D ze podzieleniem skadowych przez W
-inline void Vec4ToVec3_Div(VEC3 *Out, const VEC4 &v)
-{
-	float rcw = 1.0f / v.w;
-	Out->x = v.x * rcw;
-	Out->y = v.y * rcw;
-	Out->z = v.z * rcw;
-}
-
-/// Zwraca punkt w poowie drogi midzy podanymi punktami
-inline void MidPoint(VEC2 *Out, const VEC2 &p1, const VEC2 &p2)
-{
-	Out->x = (p1.x+p2.x) * 0.5f;
-	Out->y = (p1.y+p2.y) * 0.5f;
-}
-inline void MidPoint(VEC3 *Out, const VEC3 &p1, const VEC3 &p2)
-{
-	Out->x = (p1.x+p2.x) * 0.5f;
-	Out->y = (p1.y+p2.y) * 0.5f;
-	Out->z = (p1.z+p2.z) * 0.5f;
-}
-inline void MidPoint(VEC4 *Out, const VEC4 &p1, const VEC4 &p2)
-{
-	Out->x = (p1.x+p2.x) * 0.5f;
-	Out->y = (p1.y+p2.y) * 0.5f;
-	Out->z = (p1.z+p2.z) * 0.5f;
-	Out->w = (p1.w+p2.w) * 0.5f;
-}
-
-/// Zwraca true, jeli podane wektory/punkty s sobie mniej wicej rwne
-inline bool VecEqual(const VEC2 &v1, const VEC2 &v2) {
-	return float_equal(v1.x, v2.x) && float_equal(v1.y, v2.y);
-}
-inline bool VecEqual(const VEC3 &v1, const VEC3 &v2) {
-	return float_equal(v1.x, v2.x) && float_equal(v1.y, v2.y) && float_equal(v1.z, v2.z);
-}
-inline bool VecEqual(const VEC4 &v1, const VEC4 &v2) {
-	return float_equal(v1.x, v2.x) && float_equal(v1.y, v2.y) && float_equal(v1.z, v2.z) && float_equal(v1.w, v2.w);
-}
-
-inline bool around(const VEC2 &v1, const VEC2 &v2, float Epsilon) {
-	return around(v1.x, v2.x, Epsilon) && around(v1.y, v2.y, Epsilon);
-}
-inline bool around(const VEC3 &v1, const VEC3 &v2, float Epsilon) {
-	return around(v1.x, v2.x, Epsilon) && around(v1.y, v2.y, Epsilon) && around(v1.z, v2.z, Epsilon);
-}
-inline bool around(const VEC4 &v1, const VEC4 &v2, float Epsilon) {
-	return around(v1.x, v2.x, Epsilon) && around(v1.y, v2.y, Epsilon) && around(v1.z, v2.z, Epsilon) && around(v1.w, v2.w, Epsilon);
-}
-
-/// Zwraca wektor prostopady do podanego wektora 2D
-/** W ukadzie w ktrym X jest w prawo a Y do gry wektor ley na lewo od danego.
-W ukadzie w ktrym X jest w prawo a Y w d, ley na prawo. */
-inline void Perpedicular(VEC2 *Out, const VEC2 &v)
-{
-	Out->x = -v.y;
-	Out->y = v.x;
-}
-
-/// Oblicza wektor kierunku odbicia od paszczyzny o podanej normalnej
-/**
-\param v wskazuje na kierunek *do* tej paszczyzny.
-\param PlaneNormal musi by znormalizowany.
-*/
-inline void Reflect(VEC2 *Out, const VEC2 &v, const VEC2 &PlaneNormal)
-{
-	*Out = v - (2.0f * Dot(v, PlaneNormal)) * PlaneNormal;
-}
-inline void Reflect(VEC3 *Out, const VEC3 &v, const VEC3 &PlaneNormal)
-{
-	*Out = v - (2.0f * Dot(v, PlaneNormal)) * PlaneNormal;
-}
-
-/// For the incident vector I and surface normal N, and the ratio of indices of refraction eta, return the refraction vector.
-/** The input parameters for the incident vector I and the surface normal N must
-already be normalized to get the desired results.
-*/
-inline void Refract(VEC2 *out, const VEC2 &I, const VEC2 &N, float eta)
-{
-	float N_dot_I = Dot(N, I);
-	float k = 1.f - eta * eta * (1.f - N_dot_I * N_dot_I);
-	if (k < 0.f)
-		*out = VEC2_ZERO;
-	else
-		*out = eta * I - (eta * N_dot_I + sqrtf(k)) * N;
-}
-/// \copydoc Refract(VEC2, const VEC2&, const VEC2&, float)
-inline void Refract(VEC3 *out, const VEC3 &I, const VEC3 &N, float eta)
-{
-	float N_dot_I = Dot(N, I);
-	float k = 1.f - eta * eta * (1.f - N_dot_I * N_dot_I);
-	if (k < 0.f)
-		*out = VEC3_ZERO;
-	else
-		*out = eta * I - (eta * N_dot_I + sqrtf(k)) * N;
-}
-
-/// Rzutowanie wektora V na wektor N
-/** Jeli chcemy rozoy wektor V na wektor prostopady i rwnolegy do N,
-to wektorem rwnolegym jest Out, a prostopady obliczamy jako V - Out.
-\param[out] Out Bdzie rwnolegy do N. */
-inline void Project(VEC2 *Out, const VEC2 &V, const VEC2 &N)
-{
-	// Oryginalnie:
-	// *Out = N * ( Dot(V, N) / LengthSq(N) );
-	// Wersja szybsza:
-	float T = (V.x*N.x + V.y*N.y) / (N.x*N.x + N.y*N.y);
-	Out->x = N.x * T;
-	Out->y = N.y * T;
-}
-inline void Project(VEC3 *Out, const VEC3 &V, const VEC3 &N)
-{
-	float T = (V.x*N.x + V.y*N.y + V.z*N.z) / (N.x*N.x + N.y*N.y + N.z*N.z);
-	Out->x = N.x * T;
-	Out->y = N.y * T;
-	Out->z = N.z * T;
-}
-/// Wersja common::Project, kiedy wektor N jest ju na pewno znormalizowany.
-inline void Project_N(VEC2 *Out, const VEC2 &V, const VEC2 &N)
-{
-	// Oryginalnie:
-	// *Out = N * Dot(V, N);
-	// Wersja szybsza:
-	float T = V.x*N.x + V.y*N.y;
-	Out->x = N.x * T;
-	Out->y = N.y * T;
-}
-inline void Project_N(VEC3 *Out, const VEC3 &V, const VEC3 &N)
-{
-	float T = V.x*N.x + V.y*N.y + V.z*N.z;
-	Out->x = N.x * T;
-	Out->y = N.y * T;
-	Out->z = N.z * T;
-}
-
-/// Oblicza: u cross v dot w
-inline float ScalarTripleProduct(const VEC3 &u, const VEC3 &v, const VEC3 &w)
-{
-	return u.x * (v.y * w.z - v.z * w.y) - u.y * (v.x * w.z - v.z * w.x) + u.z * (v.x * w.y - v.y * w.x);
-}
-
-/** \addtogroup math_vec_orthogonalisation Ortogonalizacja trzech wektorw
-- Po tym przeksztaceniu bd do siebie prostopade.
-- Wektory wejciowe nie musz by znormalizowane.
-- Wektory wyjciowe niekoniecznie bd znormalizowane (nawet jeli wejciowe byy).
-*/
-//@{
-/// Ortogonalizacja trzech wektorw - Metoda szybka
-void Orthogonalize_Fast(VEC3 *OutR1, VEC3 *OutR2, VEC3 *OutR3, const VEC3 &R1, const VEC3 &R2, const VEC3 &R3);
-/// Ortogonalizacja trzech wektorw - Metoda dokadna
-void Orthogonalize(VEC3 *OutR1, VEC3 *OutR2, VEC3 *OutR3, const VEC3 &R1, const VEC3 &R2, const VEC3 &R3);
-//@}
-
-/// Wyznacza dwa dowolne wektory prostopade do podanego
-/** Zwrcone wektory nie s znormalizowane.
-\param v nie musi by znormalizowany. */
-void PerpedicularVectors(VEC3 *Out1, VEC3 *Out2, const VEC3 &v);
-
-//@}
-// math_vec
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-/** \addtogroup math_triangle Trjkt */
-//@{
-
-/// Oblicza signed pole powierzchni trjkta
-/** Wychodzi dodanie, kiedy wierzchoki s CW. */
-float TriangleArea(const VEC2 &p1, const VEC2 &p2, const VEC2 &p3);
-float TriangleArea(const VEC3 &p1, const VEC3 &p2, const VEC3 &p3);
-
-/// Zwraca true, jeli wierzchoki trjkta s CW.
-bool TriangleIsCW(const VEC2 &p1, const VEC2 &p2, const VEC2 &p3);
-
-/// Znajduje obwd trjkta
-float TrianglePerimeter(const VEC2 &p1, const VEC2 &p2, const VEC2 &p3);
-float TrianglePerimeter(const VEC3 &p1, const VEC3 &p2, const VEC3 &p3);
-
-/// Oblicza punkt na powierzhchni trjkta we wsp. barycentrycznych
-/** f to waga punktu p2, g to waga punktu p3. \n
-Wzr: *Out = p1 + f*(p2-p1) + g*(p3-p1) \n
-Inny wzr: *Out = p1*(1-f-g) + p2*f + p3*g */
-inline void Barycentric(VEC2 *Out, const VEC2 &p1, const VEC2 &p2, const VEC2 &p3, float f, float g)
-{
-	float e = 1.0f-f-g;
-	Out->x = e*p1.x + f*p2.x + g*p3.x;
-	Out->y = e*p1.y + f*p2.y + g*p3.y;
-}
-inline void Barycentric(VEC3 *Out, const VEC3 &p1, const VEC3 &p2, const VEC3 &p3, float f, float g)
-{
-	// Stara wersja, na podstawie DX SDK, duo wolniejsza:
-	//VEC3 Diff2 = p2-p1;
-	//VEC3 Diff3 = p3-p1;
-	//Out->x = p1.x + f*Diff2.x + g*Diff3.x;
-	//Out->y = p1.y + f*Diff2.y + g*Diff3.y;
-	//Out->z = p1.z + f*Diff2.z + g*Diff3.z;
-
-	float e = 1.0f-f-g;
-	Out->x = e*p1.x + f*p2.x + g*p3.x;
-	Out->y = e*p1.y + f*p2.y + g*p3.y;
-	Out->z = e*p1.z + f*p2.z + g*p3.z;
-}
-inline void Barycentric(VEC4 *Out, const VEC4 &p1, const VEC4 &p2, const VEC4 &p3, float f, float g)
-{
-	float e = 1.0f-f-g;
-	Out->x = e*p1.x + f*p2.x + g*p3.x;
-	Out->y = e*p1.y + f*p2.y + g*p3.y;
-	Out->z = e*p1.z + f*p2.z + g*p3.z;
-	Out->w = e*p1.w + f*p2.w + g*p3.w;
-}
-
-/// Wsprzdne barycentryczne punktu p wzgldem trjkta p1-p2-p3.
-/** Wspczynniki e, f, g to wagi wierzchokw p1, p2, p3. \n
-\param out_e [out] Mona poda NULL. */
-void CalcBarycentric(const VEC2 &p, const VEC2 &p1, const VEC2 &p2, const VEC2 &p3, float *out_e, float *out_f, float *out_g);
-/// Wsprzdne barycentryczne punktu p wzgldem trjkta p1-p2-p3.
-/** Wspczynniki e, f, g to wagi wierzchokw p1, p2, p3. \n
-Punkt p musi lee na jednej paszczynie z trjktem p1-p2-p3. \n
-Normal to wektor normalny trjkta p1-p2-p3. Mona go poda jeli jest ju wyliczony albo poda NULL. */
-void CalcBarycentric(const VEC3 &p, const VEC3 &p1, const VEC3 &p2, const VEC3 &p3, const VEC3 *Normal, float *out_e, float *out_f, float *out_g);
-
-/// Znajduje okrg wpisany w trjkt
-void TriangleInscribedCircle(VEC2 *OutCenter, float *OutRadius, const VEC2 &v1, const VEC2 &v2, const VEC2 &v3);
-void TriangleInscribedCircle(VEC3 *OutCenter, float *OutRadius, const VEC3 &v1, const VEC3 &v2, const VEC3 &v3);
-/// Znajduje okrg opisany na trjkcie
-void TriangleCircumscribedCircle(VEC2 *OutCenter, float *OutRadius, const VEC2 &v1, const VEC2 &v2, const VEC2 &v3);
-void TriangleCircumscribedCircle(VEC3 *OutCenter, float *OutRadius, const VEC3 &v1, const VEC3 &v2, const VEC3 &v3);
-
-//@}
-// math_triangle
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-/** \addtogroup math_ray Promie */
-//@{
-
-/// Zwraca punkt na promieniu
-inline void PointOnRay(VEC2 *Out, const VEC2 &Origin, const VEC2 &Direction, float t)
-{
-	Out->x = Origin.x + t * Direction.x;
-	Out->y = Origin.y + t * Direction.y;
-}
-inline void PointOnRay(VEC3 *Out, const VEC3 &Origin, const VEC3 &Direction, float t)
-{
-	Out->x = Origin.x + t * Direction.x;
-	Out->y = Origin.y + t * Direction.y;
-	Out->z = Origin.z + t * Direction.z;
-}
-
-//@}
-// math_ray
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-/** \addtogroup math_rect Prostokt */
-//@{
-
-/// Prostokt z liczb cakowitych
-/**
-RECTI jest kompatybilny ze struktur RECT z Win32API.
-Konwersja do i ze stringa: "left,top,right,bottom", np. "1,2,3,4".
-Niezalenie od ukadu wsprzdnych, prawidowy prostokt jest wtedy, kiedy top
-jest mniejsze co do wartoci od bottom, a left od right.
-*/
-struct RECTI
-{
-	POINT_ Min, Max;
-
-	RECTI() { }
-	RECTI(const POINT_ &min_, const POINT_ &max_) : Min(min_), Max(max_) { }
-	RECTI(int minX, int minY, int maxX, int maxY) : Min(minX, minY), Max(maxX, maxY) { }
-	RECTI(const int *Arr) : Min(Arr[0], Arr[1]), Max(Arr[2], Arr[3]) { }
-
-	operator int * () { return &Min.x; }
-	operator const int * () const { return &Min.x; }
-
-	bool operator == (const RECTI &r) const { return Min == r.Min && Max == r.Max; }
-	bool operator != (const RECTI &r) const { return Min != r.Min || Max != r.Max; }
-
-	RECTI operator + () const { return *this; }
-	RECTI operator - () const { return RECTI(-Max, -Min); }
-	RECTI operator + (const POINT_ &p) const { return RECTI(Min+p, Max+p); }
-	RECTI operator - (const POINT_ &p) const { return RECTI(Min-p, Max-p); }
-	RECTI operator * (int s) const { return RECTI(Min*s, Max*s); }
-	RECTI & operator += (const POINT_ &p) { Min += p; Max += p; return *this; }
-	RECTI & operator -= (const POINT_ &p) { Min -= p; Max -= p; return *this; }
-	RECTI & operator *= (int s) { Min *= s; Max *= s; return *this; }
-
-	int & left()   { return Min.x; }
-	int & top()    { return Min.y; }
-	int & right()  { return Max.x; }
-	int & bottom() { return Max.y; }
-	int left()   const { return Min.x; }
-	int top()    const { return Min.y; }
-	int right()  const { return Max.x; }
-	int bottom() const { return Max.y; }
-
-	bool IsValid() const { return Min.x < Max.x && Min.y < Max.y; }
-	void Repair()
-	{
-		if (Max.x < Min.x) std::swap(Min.x, Max.x);
-		if (Max.y < Min.y) std::swap(Min.y, Max.y);
-	}
-
-	/// Powiksza prostokt z kadej strony o podan warto
-	void Extend(int d) { Min.x -= d; Min.y -= d; Max.x += d; Max.y += d; }
-	/// Oblicza i zwraca dugo przektnej
-	float Diagonal() const { return sqrtf( (float)((Max.x-Min.x)*(Max.x-Min.x)) + (float)((Max.y-Min.y)*(Max.y-Min.y)) ); }
-	/// Oblicza i zwraca pole powierzchni
-	int Field() const { return (Max.x-Min.x)*(Max.y-Min.y); }
-
-	void GetSize(POINT_ *out) const { *out = Max - Min; }
-	int GetSizeDim(uint dim) const { return Max[dim] - Min[dim]; }
-
-	void GetHalfSize(POINT_ *out) { *out = (Max - Min) / 2; }
-	int GetHalfSizeDim(uint dim) const { return (Max[dim] - Min[dim]) / 2; }
-
-	void SetSize(const POINT_ &newSize) { Max = Min + newSize; }
-	void SetSizeDim(uint dim, int newSize) { Max[dim] = Min[dim] + newSize; }
-
-	void GetCenter(POINT_ *Out) const { *Out = (Min+Max)/2; }
-	int GetCenterDim(uint dim) const { return (Min[dim]+Max[dim])/2; }
-
-	void GetCorner(POINT_ *out, uint i) const
-	{
-		out->x = (i & 1) ? Max.x : Min.x;
-		out->y = (i & 2) ? Max.y : Min.y;
-	}
-	/// Returns begin point and end point of one of rectangle edges. index must be 0..3.
-	void GetEdge(POINT_ *outP1, POINT_ *outP2, uint index) const;
-
-	void AddInternalPoint(const POINT_ &p)
-	{
-		if (p.x < Min.x) Min.x = p.x;
-		if (p.y < Min.y) Min.y = p.y;
-		if (p.x > Max.x) Max.x = p.x;
-		if (p.y > Max.y) Max.y = p.y;
-	}
-
-	void AddInternalRect(const RECTI &rect)
-	{
-		if (rect.Min.x < Min.x) Min.x = rect.Min.x;
-		if (rect.Min.y < Min.y) Min.y = rect.Min.y;
-		if (rect.Max.x > Max.x) Max.x = rect.Max.x;
-		if (rect.Max.y > Max.y) Max.y = rect.Max.y;
-	}
-};
-
-extern const RECTI RECTI_ZERO;
-extern const RECTI RECTI_ZERO_ONE;
-extern const RECTI RECTI_MINUS_ONE_ONE;
-extern const RECTI RECTI_MAX;
-extern const RECTI RECTI_INV_MAX;
-
-/// Prostokt z 4 floatw.
-struct RECTF
-{
-	VEC2 Min, Max;
-
-	RECTF() { }
-	RECTF(const VEC2 &min_, const VEC2 &max_) : Min(min_), Max(max_) { }
-	RECTF(float minX, float minY, float maxX, float maxY) : Min(minX, minY), Max(maxX, maxY) { }
-	RECTF(const float *Arr) : Min(Arr[0], Arr[1]), Max(Arr[2], Arr[3]) { }
-
-	operator float * () { return &Min.x; }
-	operator const float * () const { return &Min.x; }
-
-	bool operator == (const RECTF &r) const { return Min == r.Min && Max == r.Max; }
-	bool operator != (const RECTF &r) const { return Min != r.Min || Max != r.Max; }
-
-	RECTF operator + () const { return *this; }
-	RECTF operator - () const { return RECTF(-Max, -Min); }
-	RECTF operator + (const VEC2 &p) const { return RECTF(Min+p, Max+p); }
-	RECTF operator - (const VEC2 &p) const { return RECTF(Min-p, Max-p); }
-	RECTF operator * (float s) const { return RECTF(Min*s, Max*s); }
-	RECTF operator / (float s) const { float sInv = 1.f/s; return RECTF(Min*sInv, Max*sInv); }
-	RECTF & operator += (const VEC2 &p) { Min += p; Max += p; return *this; }
-	RECTF & operator -= (const VEC2 &p) { Min -= p; Max -= p; return *this; }
-	RECTF & operator *= (float s) { Min *= s; Max *= s; return *this; }
-	RECTF & operator /= (float s) { float sInv = 1.f/s; Min *= sInv; Max *= sInv; return *this; }
-
-	float & left()   { return Min.x; }
-	float & top()    { return Min.y; }
-	float & right()  { return Max.x; }
-	float & bottom() { return Max.y; }
-	float left()   const { return Min.x; }
-	float top()    const { return Min.y; }
-	float right()  const { return Max.x; }
-	float bottom() const { return Max.y; }
-
-	bool IsValid() const { return Min.x < Max.x && Min.y < Max.y; }
-	void Repair()
-	{
-		if (Max.x < Min.x) std::swap(Min.x, Max.x);
-		if (Max.y < Min.y) std::swap(Min.y, Max.y);
-	}
-
-	/// Powiksza prostokt z kadej strony o podan warto
-	void Extend(float d) { Min.x -= d; Min.y -= d; Max.x += d; Max.y += d; }
-	/// Oblicza i zwraca dugo przektnej
-	float Diagonal() const { return sqrtf( sqr(Max.x-Min.x) + sqr(Max.y-Min.y) ); }
-	/// Oblicza i zwraca pole powierzchni
-	float Field() const { return (Max.x-Min.x)*(Max.y-Min.y); }
-	
-	void GetSize(VEC2 *out) const { *out = Max - Min; }
-	float GetSizeDim(size_t dim) const { return Max[dim] - Min[dim]; }
-	
-	void GetHalfSize(VEC2 *out) { *out = (Max - Min) * 0.5f; }
-	float GetHalfSizeDim(size_t dim) const { return (Max[dim] - Min[dim]) * 0.5f; }
-
-	/// Zmienia szeroko i wysoko na podan
-	void SetSize(const VEC2 &newSize) { Max = Min + newSize; }
-	void SetSizeDim(size_t dim, float newSize) { Max[dim] = Min[dim] + newSize; }
-	/// Oblicza i zwraca pozycj rodka
-	void GetCenter(VEC2 *Out) const { *Out = (Min+Max)*0.5f; }
-	float GetCenterDim(size_t dim) const { return (Min[dim]+Max[dim])*0.5f; }
-
-	void GetCorner(VEC2 *out, uint i) const
-	{
-		out->x = (i & 1) ? Max.x : Min.x;
-		out->y = (i & 2) ? Max.y : Min.y;
-	}
-	/// Returns begin point and end point of one of rectangle edges. index must be 0..3.
-	void GetEdge(VEC2 *outP1, VEC2 *outP2, uint index) const;
-	/// Returns one of 4 possible quarters of this rect.
-	void GetQuad(RECTF *out, uint index) const;
-
-	void AddInternalPoint(const VEC2 &p)
-	{
-		if (p.x < Min.x) Min.x = p.x;
-		if (p.y < Min.y) Min.y = p.y;
-		if (p.x > Max.x) Max.x = p.x;
-		if (p.y > Max.y) Max.y = p.y;
-	}
-
-	void AddInternalRect(const RECTF &rect)
-	{
-		if (rect.Min.x < Min.x) Min.x = rect.Min.x;
-		if (rect.Min.y < Min.y) Min.y = rect.Min.y;
-		if (rect.Max.x > Max.x) Max.x = rect.Max.x;
-		if (rect.Max.y > Max.y) Max.y = rect.Max.y;
-	}
-};
-
-extern const RECTF RECTF_ZERO;
-extern const RECTF RECTF_ZERO_ONE;
-extern const RECTF RECTF_MINUS_ONE_ONE;
-extern const RECTF RECTF_MAX; ///< Maximal possible rectangle: -FLT_MAX..FLT_MAX
-extern const RECTF RECTF_INV_MAX; ///< Inverted maximal rectangle: FLT_MAX..-FLT_MAX. It's invalid. Use it to initialize rectangle for finding min-max.
-
-#ifdef _WIN32
-	/// Konwersja z common::RECTI do RECT z WinAPI
-	template <> inline ::RECT & math_cast<::RECT, RECTI>(const RECTI &x) { return (::RECT&)(x); }
-	/// Konwersja z RECT z WinAPI do common::RECTI
-	template <> inline RECTI & math_cast<RECTI, ::RECT>(const ::RECT &x) { return (RECTI&)(x); }
-#endif
-
-inline void swap(RECTI &r1, RECTI &r2)
-{
-	std::swap(r1.Min.x, r2.Min.x); std::swap(r1.Min.y, r2.Min.y);
-	std::swap(r1.Max.x, r2.Max.x); std::swap(r1.Max.y, r2.Max.y);
-}
-
-inline void swap(RECTF &r1, RECTF &r2)
-{
-	std::swap(r1.Min, r2.Min);
-	std::swap(r1.Max, r2.Max);
-}
-
-inline void Mul(RECTI *out, const RECTI &rect, const POINT_ &v)
-{
-	Mul(&out->Min, rect.Min, v);
-	Mul(&out->Max, rect.Max, v);
-}
-inline void Mul(RECTF *out, const RECTF &rect, const VEC2 &v)
-{
-	Mul(&out->Min, rect.Min, v);
-	Mul(&out->Max, rect.Max, v);
-}
-inline void Div(RECTI *out, const RECTI &rect, const POINT_ &v)
-{
-	Div(&out->Min, rect.Min, v);
-	Div(&out->Max, rect.Max, v);
-}
-inline void Div(RECTF *out, const RECTF &rect, const VEC2 &v)
-{
-	Div(&out->Min, rect.Min, v);
-	Div(&out->Max, rect.Max, v);
-}
-
-inline void Mul(RECTI *inout, const POINT_ &v)
-{
-	Mul(&inout->Min, v);
-	Mul(&inout->Max, v);
-}
-inline void Mul(RECTF *inout, const VEC2 &v)
-{
-	Mul(&inout->Min, v);
-	Mul(&inout->Max, v);
-}
-inline void Div(RECTI *inout, const POINT_ &v)
-{
-	Div(&inout->Min, v);
-	Div(&inout->Max, v);
-}
-inline void Div(RECTF *inout, const VEC2 &v)
-{
-	Div(&inout->Min, v);
-	Div(&inout->Max, v);
-}
-
-/// Zwraca true, jeli punkt naley do prostokta
-inline bool PointInRect(const POINT_ &p, const RECTI &r)
-{
-	return
-		(p.x >= r.Min.x) &&
-		(p.x <= r.Max.x) &&
-		(p.y >= r.Min.y) &&
-		(p.y <= r.Max.y);
-}
-inline bool PointInRect(const VEC2 &p, const RECTF &r)
-{
-	return
-		(p.x >= r.Min.x) &&
-		(p.x <= r.Max.x) &&
-		(p.y >= r.Min.y) &&
-		(p.y <= r.Max.y);
-}
-
-/// Zwraca true, jeli prostokt sr zawiera si w caoci wewntrz r
-inline bool RectInRect(const RECTI &sr, const RECTI &r)
-{
-	return
-		(sr.Min.x >= r.Min.x) &&
-		(sr.Max.x <= r.Max.x) &&
-		(sr.Min.y >= r.Min.y) &&
-		(sr.Max.y <= r.Max.y);
-}
-inline bool RectInRect(const RECTF &sr, const RECTF &r)
-{
-	return
-		(sr.Min.x >= r.Min.x) &&
-		(sr.Max.x <= r.Max.x) &&
-		(sr.Min.y >= r.Min.y) &&
-		(sr.Max.y <= r.Max.y);
-}
-
-/// Zwraca true, jeli podane prostokty zachodz na siebie
-inline bool RectToRect(const RECTI &r1, const RECTI &r2)
-{
-	return
-		(r1.Min.x <= r2.Max.x) &&
-		(r1.Max.x >= r2.Min.x) &&
-		(r1.Min.y <= r2.Max.y) &&
-		(r1.Max.y >= r2.Min.y);
-}
-inline bool RectToRect(const RECTF &r1, const RECTF &r2)
-{
-	return
-		(r1.Min.x <= r2.Max.x) &&
-		(r1.Max.x >= r2.Min.x) &&
-		(r1.Min.y <= r2.Max.y) &&
-		(r1.Max.y >= r2.Min.y);
-}
-
-/// Jeli prostokty posiadaj cz wspln, zwraca j przez Out i zwraca true
-inline bool Intersection(RECTI *Out, const RECTI &r1, const RECTI &r2)
-{
-	*Out = RECTI(
-		std::max(r1.Min.x, r2.Min.x),
-		std::max(r1.Min.y, r2.Min.y),
-		std::min(r1.Max.x, r2.Max.x),
-		std::min(r1.Max.y, r2.Max.y));
-	return Out->IsValid();
-}
-inline bool Intersection(RECTF *Out, const RECTF &r1, const RECTF &r2)
-{
-	*Out = RECTF(
-		std::max(r1.Min.x, r2.Min.x),
-		std::max(r1.Min.y, r2.Min.y),
-		std::min(r1.Max.x, r2.Max.x),
-		std::min(r1.Max.y, r2.Max.y));
-	return Out->IsValid();
-}
-
-/// Zwraca prostokt opisany na podanych dwch prostoktach
-inline void Union(RECTI *Out, const RECTI &r1, const RECTI &r2)
-{
-	Out->Min.x = std::min(r1.Min.x, r2.Min.x);
-	Out->Min.y = std::min(r1.Min.y, r2.Min.y);
-	Out->Max.x = std::max(r1.Max.x, r2.Max.x);
-	Out->Max.y = std::max(r1.Max.y, r2.Max.y);
-}
-inline void Union(RECTF *Out, const RECTF &r1, const RECTF &r2)
-{
-	Out->Min.x = std::min(r1.Min.x, r2.Min.x);
-	Out->Min.y = std::min(r1.Min.y, r2.Min.y);
-	Out->Max.x = std::max(r1.Max.x, r2.Max.x);
-	Out->Max.y = std::max(r1.Max.y, r2.Max.y);
-}
-
-inline void Lerp(RECTF *out, const RECTF &v1, const RECTF &v2, float t)
-{
-	out->Min.x = Lerp(v1.Min.x, v2.Min.x, t);
-	out->Min.y = Lerp(v1.Min.y, v2.Min.y, t);
-	out->Max.x = Lerp(v1.Max.x, v2.Max.x, t);
-	out->Max.y = Lerp(v1.Max.y, v2.Max.y, t);
-}
-
-/// Wyznacza najbliszy punkt wewntrz prostokta wzgldem punktu p.
-/** Jeli p ley wewntrz tego prostokta, zwrcone zostaje dokadnie p. */
-void ClosestPointInRect(POINT_ *Out, const RECTI &Rect, const POINT_ &p);
-/// Wyznacza najbliszy punkt wewntrz prostokta wzgldem punktu p.
-/** Jeli p ley wewntrz tego prostokta, zwrcone zostaje dokadnie p. */
-void ClosestPointInRect(VEC2 *Out, const RECTF &Rect, const VEC2 &p);
-
-//@}
-// math_rect
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-/** \addtogroup math_aabb AABB
-Prostopadocian AABB - Axis Aligned Bounding Box */
-//@{
-
-/// AABB z 2 punktw 3D
-/**
-Skadnia do konwersji na i z acuch: p1x,p1y,p1z;p2x,p2y,p2z, np.:
-"1,2,3;4,5,6"
-*/
-struct BOX
-{
-	VEC3 Min, Max;
-
-	BOX() { }
-	BOX(const VEC3 &Min, const VEC3 &Max) : Min(Min), Max(Max) { }
-	BOX(float p1x, float p1y, float p1z, float p2x, float p2y, float p2z) : Min(p1x, p1y, p1z), Max(p2x, p2y, p2z) { }
-	BOX(const float *Arr) : Min(&Arr[0]), Max(&Arr[3]) { }
-
-	operator float * () { return &Min.x; }
-	operator const float * () const { return &Min.x; }
-
-	bool operator == (const BOX &p) const { return Min == p.Min && Max == p.Max; }
-	bool operator != (const BOX &p) const { return Min != p.Min || Max != p.Max; }
-
-	BOX operator + () const { return *this; }
-	BOX operator - () const { return BOX(-Max, -Min); }
-	BOX operator + (const VEC3 &v) const { return BOX(Min+v, Max+v); }
-	BOX operator - (const VEC3 &v) const { return BOX(Min-v, Max-v); }
-	BOX operator * (float f) const { return BOX(Min*f, Max*f); }
-	BOX operator / (float f) const { float fInv = 1.f/f; return BOX(Min*fInv, Max*fInv); }
-	BOX & operator += (const VEC3 &v) { Min += v; Max += v; return *this; }
-	BOX & operator -= (const VEC3 &v) { Min -= v; Max -= v; return *this; }
-	BOX & operator *= (float f) { Min *= f; Max *= f; return *this; }
-	BOX & operator /= (float f) { float fInv = 1.f/f; Min *= fInv; Max *= fInv; return *this; }
-
-	bool IsValid() { return Min.x < Max.x && Min.y < Max.y && Min.z < Max.z; }
-	void Repair()
-	{
-		if (Max.x < Min.x) std::swap(Min.x, Max.x);
-		if (Max.y < Min.y) std::swap(Min.y, Max.y);
-		if (Max.z < Min.z) std::swap(Min.z, Max.z);
-	}
-
-	/// Powiksza boks z kadej strony o podan warto
-	void Extend(float d) { Min.x -= d; Min.y -= d; Min.z -= d; Max.x += d; Max.y += d; Max.z += d; }
-	/// Oblicza i zwraca rozmiary boksa w trzech wymiarach
-	void GetSize(VEC3 *Out) const { Out->x = Max.x-Min.x; Out->y = Max.y-Min.y; Out->z = Max.z-Min.z; }
-	float GetSizeDim(size_t dim) const { return Max[dim]-Min[dim]; }
-	/// Zmienia wielko na podan
-	void SetSize(const VEC3 &NewSize) { Max.x = Min.x + NewSize.x; Max.y = Min.y + NewSize.y; Max.z = Min.z + NewSize.z; }
-	void SetSizeDim(size_t dim, float newSize) { Max[dim] = Min[dim] + newSize; }
-	/// Oblicza i zwraca dugo przektnej
-	float Diagonal() const { return sqrtf( (Max.x-Min.x)*(Max.x-Min.x) + (Max.y-Min.y)*(Max.y-Min.y) + (Max.z-Min.z)*(Max.z-Min.z) ); }
-	/// Oblicza i zwraca objto
-	float Volume() const { return (Max.x-Min.x)*(Max.y-Min.y)*(Max.z-Min.z); }
-	/// Oblicza i zwraca pozycj rodka
-	void GetCenter(VEC3 *Out) const { Out->x = (Min.x+Max.x)*0.5f; Out->y = (Min.y+Max.y)*0.5f; Out->z = (Min.z+Max.z)*0.5f; }
-	float GetCenterDim(size_t dim) const { return (Min[dim]+Max[dim])*0.5f; }
-	/// Oblicza i zwraca poowy rozmiarw
-	void GetHalfSize(VEC3 *OutHalfSize) const {
-		OutHalfSize->x = (Max.x-Min.x)*0.5f;
-		OutHalfSize->y = (Max.y-Min.y)*0.5f;
-		OutHalfSize->z = (Max.z-Min.z)*0.5f;
-	}
-	float GetHalfSizeDim(size_t dim) { return (Max[dim]-Min[dim])*0.5f; }
-	/// Zwraca wybrany wierzchoek
-	void GetCorner(VEC3 *Out, uint i) const
-	{
-		Out->x = (i & 1) ? Max.x : Min.x;
-		Out->y = (i & 2) ? Max.y : Min.y;
-		Out->z = (i & 4) ? Max.z : Min.z;
-	}
-	/// Zwraca wszystkie 6 wierzchokw w kolejnoci
-	/**
-	Trzeba poda wskanik do tablicy. Kolejno:
-	\verbatim
-	p1x, p1y, p1z; p2x, p1y, p1z; p1x, p2y, p1z; p2x, p2y, p1z
-	p1x, p1y, p2z; p2x, p1y, p2z; p1x, p2y, p2z; p2x, p2y, p2z
-	\endverbatim
-	*/
-	void GetAllCorners(VEC3 *Out) const
-	{
-		Out[0] = VEC3(Min.x, Min.y, Min.z); Out[1] = VEC3(Max.x, Min.y, Min.z); Out[2] = VEC3(Min.x, Max.y, Min.z); Out[3] = VEC3(Max.x, Max.y, Min.z);
-		Out[4] = VEC3(Min.x, Min.y, Max.z); Out[5] = VEC3(Max.x, Min.y, Max.z); Out[6] = VEC3(Min.x, Max.y, Max.z); Out[7] = VEC3(Max.x, Max.y, Max.z);
-	}
-	/// Returns begin point and end point of selected edge. index must be 0..11.
-	void GetEdge(VEC3 *outP1, VEC3 *outP2, uint index) const;
-	/// Returns one of 8 possible octants of this box.
-	void GetOct(BOX *out, uint index) const;
-
-	/// Powiksza tak eby na pewno zawiera podany punkt
-	void AddInternalPoint(const VEC3 &p)
-	{
-		Min.x = std::min(Min.x, p.x); Min.y = std::min(Min.y, p.y); Min.z = std::min(Min.z, p.z);
-		Max.x = std::max(Max.x, p.x); Max.y = std::max(Max.y, p.y); Max.z = std::max(Max.z, p.z);
-	}
-	/// Powiksza tak eby na pewno zawiera podany boks
-	/** Podany boks musi by prawidowy. */
-	void AddInternalBox(const BOX &b)
-	{
-		Min.x = std::min(Min.x, b.Min.x); Min.y = std::min(Min.y, b.Min.y); Min.z = std::min(Min.z, b.Min.z);
-		Max.x = std::max(Max.x, b.Max.x); Max.y = std::max(Max.y, b.Max.y); Max.z = std::max(Max.z, b.Max.z);
-	}
-};
-
-extern const BOX BOX_ZERO;
-extern const BOX BOX_ZERO_ONE;
-extern const BOX BOX_MINUS_ONE_ONE;
-extern const BOX BOX_MAX; ///< Maximal possible box: -FLT_MAX..FLT_MAX
-extern const BOX BOX_INV_MAX; ///< Inverted maximal box: FLT_MAX..-FLT_MAX. It's invalid. Use it to initialize box for finding min-max.
-
-
-inline void swap(BOX &b1, BOX &b2)
-{
-	std::swap(b1.Min, b2.Min);
-	std::swap(b1.Max, b2.Max);
-}
-
-inline void Mul(BOX *Out, const BOX &b, const VEC3 &v)
-{
-	Mul(&Out->Max, b.Max, v);
-	Mul(&Out->Max, b.Max, v);
-}
-inline void Div(BOX *Out, const BOX &b, const VEC3 &v)
-{
-	Div(&Out->Max, b.Max, v);
-	Div(&Out->Max, b.Max, v);
-}
-
-inline void Mul(BOX *inout, const VEC3 &v)
-{
-	Mul(&inout->Max, v);
-	Mul(&inout->Max, v);
-}
-inline void Div(BOX *inout, const VEC3 &v)
-{
-	Div(&inout->Max, v);
-	Div(&inout->Max, v);
-}
-
-/// Zwraca true, jeli punkt naley do boksa
-inline bool PointInBox(const VEC3 &p, const BOX &b)
-{
-	return
-		(p.x >= b.Min.x) && (p.x <= b.Max.x) &&
-		(p.y >= b.Min.y) && (p.y <= b.Max.y) &&
-		(p.z >= b.Min.z) && (p.z <= b.Max.z);
-}
-
-/// Zwraca true, jeli boks sb zawiera si w caoci wewntrz b
-inline bool BoxInBox(const BOX &sb, const BOX &b)
-{
-	return
-		(sb.Min.x >= b.Min.x) && (sb.Max.x <= b.Max.x) &&
-		(sb.Min.y >= b.Min.y) && (sb.Max.y <= b.Max.y) &&
-		(sb.Min.z >= b.Min.z) && (sb.Max.z <= b.Max.z);
-}
-
-/// Zwraca true, jeli podane boksy zachodz na siebie
-inline bool BoxToBox(const BOX &b1, const BOX &b2)
-{
-	return
-		(b1.Min.x <= b2.Max.x) && (b1.Max.x >= b2.Min.x) &&
-		(b1.Min.y <= b2.Max.y) && (b1.Max.y >= b2.Min.y) &&
-		(b1.Min.z <= b2.Max.z) && (b1.Max.z >= b2.Min.z);
-}
-
-/// Jeli boksy posiadaj cz wspln, zwraca j przez Out i zwraca true
-inline bool Intersection(BOX *Out, const BOX &b1, const BOX &b2)
-{
-	*Out = BOX(
-		VEC3(
-			std::max(b1.Min.x, b2.Min.x),
-			std::max(b1.Min.y, b2.Min.y),
-			std::max(b1.Min.z, b2.Min.z)),
-		VEC3(
-			std::min(b1.Max.x, b2.Max.x),
-			std::min(b1.Max.y, b2.Max.y),
-			std::min(b1.Max.z, b2.Max.z)));
-	return Out->IsValid();
-}
-
-/// Zwraca boks opisany na podanych dwch boksach
-inline void Union(BOX *Out, const BOX &b1, const BOX &b2)
-{
-	*Out = BOX(
-		VEC3(
-			std::min(b1.Min.x, b2.Min.x),
-			std::min(b1.Min.y, b2.Min.y),
-			std::min(b1.Min.z, b2.Min.z)),
-		VEC3(
-			std::max(b1.Max.x, b2.Max.x),
-			std::max(b1.Max.y, b2.Max.y),
-			std::max(b1.Max.z, b2.Max.z)));
-}
-inline void Lerp(BOX *out, const BOX &v1, const BOX &v2, float t)
-{
-	Lerp(&out->Min, v1.Min, v2.Min, t);
-	Lerp(&out->Max, v1.Max, v2.Max, t);
-}
-
-//@}
-// math_aabb
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-/** \addtogroup math_aabb OBB
-Prostopadocian o dowolnej orientacji OBB - Oriented Bounding Box */
-//@{
-
-/// OBB - Oriented Bounding Box - prostopadocian o dowolnej orientacji
-struct OBB
-{
-	/// Pozycja rodka
-	VEC3 Center;
-	/// Poowa szerokoci, wysokoci, gbokoci
-	VEC3 HalfSize;
-	/// Osie wskazujce lokalne kierunki X, Y, Z.
-	/** Musz by jednostkowe i wzajemnie prostopade. */
-	VEC3 Axes[3];
-};
-
-/// Zwraca true, jeli dwa prostopadociany OBB nachodz na siebie.
-bool ObbToObb(const OBB &a, const OBB &b);
-
-//@}
-// math_obb
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-/** \addtogroup math_rect3d Rect 3D
-Dowolnie zorientowany prostokt w przestrzeni 3D - tak jakby paski OBB. */
-//@{
-
-/// Paski prostokt, dowolnie zorientowany w przestrzeni 3D.
-struct RECT3D
-{
-	/// Pozycja rodka
-	VEC3 Center;
-	/// Poowa szerokoci, wysokoci
-	VEC2 HalfSize;
-	/// Osie wskazujce lokalne kierunki X, Y.
-	/** Musz by jednostkowe i wzajemnie prostopade. */
-	VEC3 Axes[2];
-};
-
-//@}
-// math_rect3d
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-/** \addtogroup math_colors Kolory
-Stae z kolorami, operacje generujce kolory itp. wypeniaj kana alfa jedynk.
-*/
-//@{
-
-/// Kolor w formacie A8R8G8B8.
-/**
-Operacje dodawania i odejmowania kolorw, a take dodawania, odejmowania,
-mnoenia i dzielenia przez liczb pilnuj zakresu i w razie czego obcinaj,
-nie zawijaj.
-*/
-struct COLOR
-{
-	union
-	{
-		/// Cay kolor razem
-		uint32 ARGB;
-		/// Osobno poszczeglne skadowe
-		PACKED struct
-		{
-			uint8 B, G, R, A;
-		};
-	};
-
-	COLOR() { }
-	COLOR(uint32 c) : ARGB(c) { }
-	COLOR(unsigned long c) : ARGB((uint32)c) { }
-	COLOR(uint8 R, uint8 G, uint8 B) : B(B), G(G), R(R), A(0xFF) { }
-	COLOR(uint8 A, uint8 R, uint8 G, uint8 B) : B(B), G(G), R(R), A(A) { }
-
-	bool operator == (COLOR c) const { return ARGB == c.ARGB; }
-	bool operator != (COLOR c) const { return ARGB != c.ARGB; }
-
-	// Operatory unarne - dany kolor i negatyw koloru
-	COLOR operator + () const { return *this; }
-	COLOR operator - () const { return COLOR(~ARGB); }
-	// Dodawanie i odejmowanie kolorw
-	COLOR operator + (const COLOR &c) const { return COLOR(safe_add(A, c.A), safe_add(R, c.R), safe_add(G, c.G), safe_add(B, c.B)); }
-	COLOR operator - (const COLOR &c) const { return COLOR(safe_sub(A, c.A), safe_sub(R, c.R), safe_sub(G, c.G), safe_sub(B, c.B)); }
-	COLOR & operator += (const COLOR &c) { A = safe_add(A, c.A); R = safe_add(R, c.R); G = safe_add(G, c.G); B = safe_add(B, c.B); return *this; }
-	COLOR & operator -= (const COLOR &c) { A = safe_sub(A, c.A); R = safe_sub(R, c.R); G = safe_sub(G, c.G); B = safe_sub(B, c.B); return *this; }
-	// Mnoenie i dzielenie koloru przez liczb
-	// Autor: Tarlandil
-	COLOR operator * (float s) const { return COLOR( (uint8)(minmax(0, (int)(A*s), 255)), (uint8)(minmax(0, (int)(R*s), 255)), (uint8)(minmax(0, (int)(G*s), 255)), (uint8)(minmax(0, (int)(B*s), 255)) ); }
-	COLOR operator / (float s) const { float sInv = 1.0f/s; return COLOR( (uint8)(minmax(0, (int)(A*sInv), 255)), (uint8)(minmax(0, (int)(R*sInv), 255)), (uint8)(minmax(0, (int)(G*sInv), 255)), (uint8)(minmax(0, (int)(B*sInv), 255)) ); }
-	COLOR & operator *= (float s) { A = (uint8)(minmax(0, (int)(A*s), 255)); R = (uint8)(minmax(0, (int)(R*s), 255)); G = (uint8)(minmax(0, (int)(G*s), 255)); B = (uint8)(minmax(0, (int)(B*s), 255)); return *this; }
-	COLOR & operator /= (float s) { float sInv = 1.0f/s; A = (uint8)(minmax(0, (int)(A*sInv), 255)); R = (uint8)(minmax(0, (int)(R*sInv), 255)); G = (uint8)(minmax(0, (int)(G*sInv), 255)); B = (uint8)(minmax(0, (int)(B*sInv), 255));  return *this; }
-	// Mnoenie dwch kolorw, czyli modulacja
-	COLOR operator * (const COLOR &c) const { return COLOR( (uint8)(((int)A*(int)c.A)/255), (uint8)(((int)R*(int)c.R)/255), (uint8)(((int)G*(int)c.G)/255), (uint8)(((int)B*(int)c.B)/255) ); }
-	COLOR & operator *= (const COLOR &c) { A = (uint8)(((int)A*(int)c.A)/255); R = (uint8)(((int)R*(int)c.R)/255); G = (uint8)(((int)G*(int)c.G)/255); B = (uint8)(((int)B*(int)c.B)/255); return *this; }
-};
-
-extern const COLOR COLOR_TRANSPARENT_;
-extern const COLOR COLOR_BLACK;
-extern const COLOR COLOR_GRAY;
-extern const COLOR COLOR_SILVER;
-extern const COLOR COLOR_WHITE;
-extern const COLOR COLOR_FUCHSIA;
-extern const COLOR COLOR_RED;
-extern const COLOR COLOR_ORANGE;
-extern const COLOR COLOR_YELLOW;
-extern const COLOR COLOR_LIME;
-extern const COLOR COLOR_AQUA;
-extern const COLOR COLOR_BLUE;
-extern const COLOR COLOR_PURPLE;
-extern const COLOR COLOR_MAROON;
-extern const COLOR COLOR_OLIVE;
-extern const COLOR COLOR_GREEN;
-extern const COLOR COLOR_TEAL;
-
-/// Kolor z 4 liczb typu float - R, G, B, A.
-/**
-Operacje dodawania i odejmowania kolorw, a take dodawania, odejmowania,
-mnoenia i dzielenia przez liczb nie pilnuj zakresu i wartoci skadowych
-mog urosn powyej 1.0 albo zmale poniej 0.0.
-*/
-struct COLORF
-{
-	float R, G, B, A;
-
-	COLORF() { }
-	COLORF(float R, float G, float B) : R(R), G(G), B(B), A(1.0f) { }
-	COLORF(float A, float R, float G, float B) : R(R), G(G), B(B), A(A) { }
-	COLORF(const float *Arr) : R(Arr[0]), G(Arr[1]), B(Arr[2]), A(Arr[3]) { }
-
-	operator float * () { return &R; }
-	operator const float * () const { return &R; }
-
-	bool operator == (const COLORF &c) const { return A == c.A && R == c.R && G == c.G && B == c.B; }
-	bool operator != (const COLORF &c) const { return A != c.A || R != c.R || G != c.G || B != c.B; }
-
-	// Operatory unarne - dany kolor i negatyw koloru
-	COLORF operator + () const { return *this; }
-	COLORF operator - () const { return COLORF(1.0f-A, 1.0f-R, 1.0f-G, 1.0f-B); }
-	// Dodawanie i odejmowanie kolorw
-	COLORF operator + (const COLORF &c) const { return COLORF(A+c.A, R+c.R, G+c.G, B+c.B); }
-	COLORF operator - (const COLORF &c) const { return COLORF(A-c.A, R-c.R, G-c.G, B-c.B); }
-	COLORF & operator += (const COLORF &c) { A += c.A; R += c.R; G += c.G; B += c.B; return *this; }
-	COLORF & operator -= (const COLORF &c) { A -= c.A; R -= c.R; G -= c.G; B -= c.B; return *this; }
-	// Mnoenie i dzielenie koloru przez liczb
-	COLORF operator * (float s) const { return COLORF(A*s, R*s, G*s, B*s); }
-	COLORF operator / (float s) const { float sInv = 1.0f/s; return COLORF(A*sInv, R*sInv, G*sInv, B*sInv); }
-	COLORF & operator *= (float s) { A *= s; R *= s; G *= s; B *= s; return *this; }
-	COLORF & operator /= (float s) { float sInv = 1.0f/s; A *= sInv; R *= sInv; G *= sInv; B *= sInv; return *this; }
-	// Mnoenie dwch kolorw, czyli modulacja
-	COLORF operator * (const COLORF &c) const { return COLORF(A*c.A, R*c.R, G*c.G, B*c.B); }
-	COLORF & operator *= (const COLORF &c) { A *= c.A; R *= c.R; G *= c.G; B *= c.B; return *this; }
-
-	/// Sprawdza, czy skadowe mieszcz si w zakresie 0.0 .. 1.0
-	bool IsValid() const { return (A >= 0.0f && A <= 1.0f) && (R >= 0.0f && R <= 1.0f) && (G >= 0.0f && G <= 1.0f) && (B >= 0.0f && B <= 1.0f); }
-	/// Sprowadza skadowe do zakresu 0.0 .. 1.0
-	void Repair()
-	{
-		A = minmax(0.0f, A, 1.0f); R = minmax(0.0f, R, 1.0f);
-		G = minmax(0.0f, G, 1.0f); B = minmax(0.0f, B, 1.0f);
-	}
-};
-
-inline void swap(COLORF &c1, COLORF &c2)
-{
-	std::swap(c1.A, c2.A); std::swap(c1.R, c2.R);
-	std::swap(c1.G, c2.G); std::swap(c1.B, c2.B);
-}
-
-extern const COLORF COLORF_TRANSPARENT_;
-extern const COLORF COLORF_BLACK;
-extern const COLORF COLORF_GRAY;
-extern const COLORF COLORF_SILVER;
-extern const COLORF COLORF_WHITE;
-extern const COLORF COLORF_FUCHSIA;
-extern const COLORF COLORF_RED;
-extern const COLORF COLORF_ORANGE;
-extern const COLORF COLORF_YELLOW;
-extern const COLORF COLORF_LIME;
-extern const COLORF COLORF_AQUA;
-extern const COLORF COLORF_BLUE;
-extern const COLORF COLORF_PURPLE;
-extern const COLORF COLORF_MAROON;
-extern const COLORF COLORF_OLIVE;
-extern const COLORF COLORF_GREEN;
-extern const COLORF COLORF_TEAL;
-
-inline COLORF operator * (float s, const COLORF &c) { return COLORF(c.A*s, c.R*s, c.G*s, c.B*s); }
-inline COLORF operator / (float s, const COLORF &c) { float sInv = 1.0f/s; return COLORF(c.A*sInv, c.R*sInv, c.G*sInv, c.B*sInv); }
-
-inline COLOR operator * (float s, const COLOR &c) { return COLOR( (uint8)(minmax(0, (int)(c.A*s), 255)), (uint8)(minmax(0, (int)(c.R*s), 255)), (uint8)(minmax(0, (int)(c.G*s), 255)), (uint8)(minmax(0, (int)(c.B*s), 255)) ); }
-inline COLOR operator / (float s, const COLOR &c) { float sInv = 1.0f/s; return COLOR( (uint8)(minmax(0, (int)(c.A*sInv), 255)), (uint8)(minmax(0, (int)(c.R*sInv), 255)), (uint8)(minmax(0, (int)(c.G*sInv), 255)), (uint8)(minmax(0, (int)(c.B*sInv), 255)) ); }
-
-template <> inline uint32 & math_cast<uint32, COLOR>(const COLOR &x) { return (uint32&)(x); }
-template <> inline unsigned long & math_cast<unsigned long, COLOR>(const COLOR &x) { return (unsigned long&)(x); }
-template <> inline COLOR & math_cast<COLOR, uint32>(const uint32 &x) { return (COLOR&)(x); }
-template <> inline COLOR & math_cast<COLOR, unsigned long>(const unsigned long &x) { return (COLOR&)(x); }
-
-#ifdef USE_DIRECTX
-	template <> inline D3DXCOLOR & math_cast<D3DXCOLOR, COLORF>(const COLORF &x) { return (D3DXCOLOR&)(x); }
-	template <> inline COLORF & math_cast<COLORF, D3DXCOLOR>(const D3DXCOLOR &x) { return (COLORF&)(x); }
-#endif
-
-/// Konwersje midzy tymi dwoma reprezentacjami kolorw
-inline void ColorToColorf(COLORF *Out, COLOR c)
-{
-	Out->R = c.R / 255.0f;
-	Out->G = c.G / 255.0f;
-	Out->B = c.B / 255.0f;
-	Out->A = c.A / 255.0f;
-}
-/** Tu musi by valid, inaczej wyjdzie zawinite. */
-inline COLOR ColorfToColor(const COLORF &c)
-{
-	return COLOR(
-		(uint8)(minmax(0.0f, c.A, 1.0f)*255.0f+0.5f),
-		(uint8)(minmax(0.0f, c.R, 1.0f)*255.0f+0.5f),
-		(uint8)(minmax(0.0f, c.G, 1.0f)*255.0f+0.5f),
-		(uint8)(minmax(0.0f, c.B, 1.0f)*255.0f+0.5f));
-}
-
-/// Konwersja koloru na acuch
-/** Formatem moe by:
-- 'x' = RRGGBB szesnastkowo
-- 'X' = AARRGGBB szesnastkowo
-- 'f' = R,G,B floaty
-- 'F' = A,R,G,B floaty
-*/
-void ColorToStr(tstring *Out, COLOR Color, char Format = 'X');
-void ColorToStr(tstring *Out, const COLORF &Color, char Format = 'F');
-/// Konwersja acucha na kolor
-/** Jeli kana alfa nie podany, zostaje wypeniony wartoci maksymaln.
-acuchem moe by:
-- jedna z 16 nazw standardowych kolorw (wielko liter dowolna)
-- warto szesnastkowa RRGGBB
-- warto szesnastkowa AARRGGBB
-- liczby float R,G,B
-- liczby float A,R,G,B
-*/
-bool StrToColor(COLOR *Out, const tstring &Str);
-bool StrToColor(COLORF *Out, const tstring &Str);
-
-inline void Add(COLORF *Out, const COLORF &c1, const COLORF &c2)
-{
-	Out->A = c1.A + c2.A; Out->R = c1.R + c2.R;
-	Out->G = c1.G + c2.G; Out->B = c1.B + c2.B;
-}
-inline void Sub(COLORF *Out, const COLORF &c1, const COLORF &c2)
-{
-	Out->A = c1.A - c2.A; Out->R = c1.R - c2.R;
-	Out->G = c1.G - c2.G; Out->B = c1.B - c2.B;
-}
-inline void Mul(COLORF *Out, const COLORF &c1, const COLORF &c2)
-{
-	Out->A = c1.A * c2.A; Out->R = c1.R * c2.R;
-	Out->G = c1.G * c2.G; Out->B = c1.B * c2.B;
-}
-inline void Mul(COLORF *inout, const COLORF &c)
-{
-	inout->A *= c.A; inout->R *= c.R;
-	inout->G *= c.G; inout->B *= c.B;
-}
-inline void Mul(COLORF *Out, const COLORF &c, float s)
-{
-	Out->A = c.A * s; Out->R = c.R * s;
-	Out->G = c.G * s; Out->B = c.B * s;
-}
-inline void Div(COLORF *Out, const COLORF &c, float s)
-{
-	Out->A = c.A / s; Out->R = c.R / s;
-	Out->G = c.G / s; Out->B = c.B / s;
-}
-inline void Negative(COLORF *Out, const COLORF &c)
-{
-	Out->A = 1.0f - c.A; Out->R = 1.0f - c.R;
-	Out->G = 1.0f - c.G; Out->B = 1.0f - c.B;
-}
-
-/// Konwertuje kolor midzy systemami ARGB i ABGR
-inline COLOR ARGB_ABGR(COLOR color)
-{
-	return COLOR(
-		(color.ARGB & 0xFF00FF00) |
-		((color.ARGB >> 16) & 0x000000FF) |
-		((color.ARGB & 0x000000FF) << 16)
-		);
-}
-
-/// Konwertuje zwyky kolor COLOR (A8R8G8B8) na R5G6B5
-inline uint16 ColorToR5G6B5(COLOR color)
-{
-	return
-		((unsigned short)(color.R >> 3) << 11) |
-		((unsigned short)(color.G >> 2) <<  5) |
-		((unsigned short)(color.B >> 3));
-}
-
-/// Konwertuje kolor R5G6B5 na zwyky kolor COLOR (A8R8G8B8)
-inline COLOR R5G6B5ToColor(uint16 color)
-{
-	return COLOR(
-		255,
-		(uint8)(color >> 11 << 3),
-		(uint8)(color >>  5 << 2),
-		(uint8)(color <<  3));
-}
-
-inline void Lerp(COLORF *Out, const COLORF &c1, const COLORF &c2, float t)
-{
-	Out->A = Lerp(c1.A, c2.A, t);
-	Out->R = Lerp(c1.R, c2.R, t);
-	Out->G = Lerp(c1.G, c2.G, t);
-	Out->B = Lerp(c1.B, c2.B, t);
-}
-inline COLOR Lerp(COLOR c1, COLOR c2, float t)
-{
-	return COLOR(
-		(uint8)(minmax(0, (int)(c1.A + t*((float)c2.A-(float)c1.A)), 255)),
-		(uint8)(minmax(0, (int)(c1.R + t*((float)c2.R-(float)c1.R)), 255)),
-		(uint8)(minmax(0, (int)(c1.G + t*((float)c2.G-(float)c1.G)), 255)),
-		(uint8)(minmax(0, (int)(c1.B + t*((float)c2.B-(float)c1.B)), 255)) );
-}
-inline void saturate(COLORF &v)
-{
-	v.R = saturate(v.R); v.G = saturate(v.G); v.B = saturate(v.B); v.A = saturate(v.A);
-}
-
-/// Konwertuje kolor midzy HSB a RGB
-/**
-- Hue, Saturation, Brightness = 0..1
-- Kana alfa zwraca 1.
-*/
-void HsbToRgb(COLORF *Out, float hue, float saturation, float brightness);
-/// Konwertuje kolor RGB na HSB
-void RgbToHsb(float *OutHue, float *OutSaturation, float *OutBrightness, const COLORF &Color);
-
-/// Zwraca kolor tczy od czerwonego (odpowiada mu t = 0) do niebieskiego (t = 1)
-/** Kana alfa zwraca 0. */
-inline void ColorRainbow(COLORF *Out, float t)
-{
-	HsbToRgb(Out, t*0.75f, 1.0f, 1.0f);
-}
-
-/// Zwraca jasno podanego koloru (odcie szaroci) z zakresu 0..1
-inline float ColorToGrayscale(const COLORF &c)
-{
-	return 0.299f * c.R + 0.587f * c.G + 0.114f * c.B;
-}
-inline float ColorToGrayscale(COLOR &c)
-{
-	return 0.299f * (c.R/255.0f) + 0.587f * (c.G/255.0f) + 0.114f * (c.B/255.0f);
-}
-
-/// Zwraca kolor szary o podanej jasnoci t = 0..1
-inline void GrayscaleToColor(COLORF *Out, float t)
-{
-	Out->A = 1.0f;
-	Out->R = Out->G = Out->B = t;
-}
-inline void GrayscaleToColor(COLOR *Out, float t)
-{
-	Out->A = 255;
-	Out->R = Out->G = Out->B = (uint8)(t*255.0f);
-}
-
-/// Zmienia kolorowi kontrast na miejscu
-/** Dla t = 0 wychodzi idealnie powkowy szary. \n
-Dla t = 1 wychodzi kolor oryginalny. \n
-t moe te by wiksze ni 1. \n
-Alfa zostaje bez zmian. */
-inline void AdjustContrast(COLORF *Color, float t)
-{
-	Color->R = 0.5f + t * (Color->R - 0.5f);
-	Color->G = 0.5f + t * (Color->G - 0.5f);
-	Color->B = 0.5f + t * (Color->B - 0.5f);
-}
-
-/// Zmienia kolorowi nasycenie na miejscu
-/** Dla t = 0 wychodzi dany kolor skonwertowany do odcienia szaroci. \n
-Dla t = 1 wychodzi kolor oryginalny. \n
-t < 0 zmniejsza nasycenie, t > 0 zwiksza nasycenie \n
-Alfa zostaje bez zmian. */
-inline void AdjustSaturation(COLORF *Color, float t)
-{
-	float gray = ColorToGrayscale(*Color);
-	Color->R = gray + t * (Color->R - gray);
-	Color->G = gray + t * (Color->G - gray);
-	Color->B = gray + t * (Color->B - gray);
-}
-
-/// Przetwarza znormalizowany wektor na kolor XRGB. A zwraca 0.
-inline COLOR VectorToColor(const VEC3 &v)
-{
-	int R = minmax(0, (int)(127.0f * v.x + 128.0f), 255);
-	int G = minmax(0, (int)(127.0f * v.y + 128.0f), 255);
-	int B = minmax(0, (int)(127.0f * v.z + 128.0f), 255);
-	return COLOR((uint32)((R << 16) | (G << 8) | B));
-}
-
-/// Przetwarza kolor na wektor
-inline void ColorToVector(VEC3 *Out, COLOR color)
-{
-	const float o = 1.0f / 127.0f;
-	Out->x = (((color.ARGB >> 16) & 0xFF) - 128.0f) * o;
-	Out->y = (((color.ARGB >>  8) & 0xFF) - 128.0f) * o;
-	Out->z = (((color.ARGB      ) & 0xFF) - 128.0f) * o;
-}
-
-/// Zwraca "odlego" dwch kolorw wg jakiejtam byle jakiej metryki. Uwzgldnia skadowe R, G, B.
-inline uint ColorDistance(COLOR Color1, COLOR Color2)
-{
-	int rd = (int)Color1.R - (int)Color2.R;
-	int gd = (int)Color1.G - (int)Color2.G;
-	int bd = (int)Color1.B - (int)Color2.B;
-	return (uint)(rd*rd + gd*gd + bd*bd);
-}
-
-/// Converts between COLORF and VEC4, where (x,y,z,w) = (R,G,B,A)
-inline VEC4 ColorfToVec4(const COLORF &c) { return VEC4(c.R, c.G, c.B, c.A); }
-/// \copydoc ColorfToVec4
-inline COLORF Vec4ToColorf(const VEC4 &v) { return COLORF(v.w, v.x, v.y, v.z); }
-
-//@}
-// math_colors
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-/** \addtogroup math_plane Paszczyzna */
-//@{
-
-#if defined(USE_DIRECTX) && !defined(DOXYGEN)
-	typedef D3DXPLANE PLANE;
-#else
-	/// Paszczyzna
-	/**
-	Reprezentuje paszczyzn w przestrzeni 3D z jedn stron dodatni, a drug
-	ujemn. Opisana jest rwnaniem A x + B y + C z + D = 0. Wektor [A,B,C] to wektor
-	normalny wskazujcy w kierunku dodatniej pprzestrzeni. Jeli paszczyzna jest
-	znormalizowana, wektor normalny jest znormalizowany, a D to odlego
-	paszczyzny od rodka ukadu wsprzdnych.
-	Reprezentacja jako string to A,R,G,B np. "1,2,3,0.2".
-	Paszczyzna majca a=b=c=0 (czyli staa ZERO) jest niepoprawna, zdegenerowana.
-	*/
-	struct PLANE
-	{
-		float a, b, c, d;
-
-		PLANE() { }
-		PLANE(float a, float b, float c, float d) : a(a), b(b), c(c), d(d) { }
-		PLANE(const float *Arr) : a(Arr[0]), b(Arr[1]), c(Arr[2]), d(Arr[3]) { }
-
-		operator float * () { return &a; }
-		operator const float * () const { return &a; }
-
-		bool operator == (const PLANE &p) const { return a == p.a && b == p.b && c == p.c && d == p.d; }
-		bool operator != (const PLANE &p) const { return a != p.a || b != p.b || c != p.c || d != p.d; }
-
-		PLANE operator + () const { return *this; }
-		/// Zwraca paszczyzn zwrcon w przeciwn stron
-		PLANE operator - () const { return PLANE(-a, -b, -c, -d); }
-
-		PLANE operator * (float s) const { return PLANE(a*s, b*s, c*s, d*s); }
-		PLANE operator / (float s) const { float sInv = 1.0f/s; return PLANE(a*sInv, b*sInv, c*sInv, d*sInv); }
-		PLANE & operator *= (float s) { a *= s; b *= s; c *= s; d *= s; return *this; }
-		PLANE & operator /= (float s) { float sInv = 1.0f/s; a *= sInv; b *= sInv; c *= sInv; d *= sInv; return *this; }
-	};
-	inline PLANE operator * (float s, const PLANE &p) { return PLANE(p.a*s, p.b*s, p.c*s, p.d*s); }
-#endif
-
-extern const PLANE PLANE_ZERO;
-extern const PLANE PLANE_POSITIVE_X; ///< Paszczyzna pionowa, rwnolega do Y i Z, wskazujca na prawo na X
-extern const PLANE PLANE_POSITIVE_Y; ///< Paszczyzna pozioma, rwnolega do X i Z, wskazujca do gry na Y
-extern const PLANE PLANE_POSITIVE_Z; ///< Paszczyzna pionowa, rwnolega do X i Y, wskazujca w gb na Z
-extern const PLANE PLANE_NEGATIVE_X; ///< Paszczyzna pionowa, rwnolega do Y i Z, wskazujca na lewo na X
-extern const PLANE PLANE_NEGATIVE_Y; ///< Paszczyzna pozioma, rwnolega do X i Z, wskazujca w d na Y
-extern const PLANE PLANE_NEGATIVE_Z; ///< Paszczyzna pionowa, rwnolega do X i Y, wskazujca do gracza na Z
-
-inline void swap(PLANE &p1, PLANE &p2)
-{
-	std::swap(p1.a, p2.a); std::swap(p1.b, p2.b);
-	std::swap(p1.c, p2.c); std::swap(p1.d, p2.d);
-}
-
-/// Daje dostp do wektora normalnego podanej paszczyzny, czyli jej skadowych a, b, c zrzutowanych jako VEC3.
-inline VEC3 & GetPlaneNormal(PLANE &Plane) { return (VEC3&)Plane.a; }
-/// Zwraca wektor normalny paszczyzny, czyli jej skadowe a, b, c zrzutowane jako VEC3.
-inline const VEC3 & GetPlaneNormal(const PLANE &Plane) { return (const VEC3&)Plane.a; }
-
-/// Zwraca jaki punkt lecy na tej paszczynie
-/** \param Plane Musi by znormalizowana. */
-inline void GetPlaneMemberPoint(VEC3 *Out, const PLANE &Plane)
-{
-	*Out = GetPlaneNormal(Plane) * -Plane.d;
-}
-
-/// Zmienia odlego od pocztku ukadu wsprzdnych.
-/** Paszczyzna pozostajc tak samo zorientowana zostaa przesunita tak, eby
-zawiera w sobie podany punkt.
-\param[in,out] Plane Musi by znormalizowana.
-*/
-inline void RecalcPlaneD(PLANE *Plane, const VEC3 &p)
-{
-	Plane->d = -Dot(GetPlaneNormal(*Plane), p);
-}
-
-/// Zwraca true, jeli podane paszczyzny s sobie mniej wicej rwne
-inline bool PlaneEqual(const PLANE &p1, const PLANE &p2) {
-	return float_equal(p1.a, p2.a) && float_equal(p1.b, p2.b) && float_equal(p1.c, p2.c) && float_equal(p1.d, p2.d);
-}
-
-/// Tworzy paszczyzn na podstawie trzech punktw
-/** Paszczyzna bdzie zorientowana dodatnio w kierunku tej pprzestrzeni,
-z ktrej wierzchoki trjkta s widoczne jako zorientowane zgodnie z ruchem
-wskazwek zegara w ukadzie LH. */
-inline void PointsToPlane(PLANE *Out, const VEC3 &p1, const VEC3 &p2, const VEC3 &p3) {
-	Cross(&GetPlaneNormal(*Out), p2-p1, p3-p1);
-	Normalize(&GetPlaneNormal(*Out));
-	Out->d = -Dot(p1, GetPlaneNormal(*Out));
-}
-/// Tworzy paszczyzn z wektora normalnego i punktu lecego na tej paszczynie
-/** Czy Normal musi by znormalizowany? Nie wiem. */
-inline void PointNormalToPlane(PLANE *Out, const VEC3 &Point, const VEC3 &Normal) {
-	Out->a = Normal.x; Out->b = Normal.y; Out->c = Normal.z;
-	Out->d = -Dot(Normal, Point);
-}
-
-/// Skalowanie paszczyzny
-inline void Mul(PLANE *Out, const PLANE &p, float s)
-{
-	Out->a = p.a * s; Out->b = p.b * s;
-	Out->c = p.c * s; Out->d = p.d * s;
-}
-inline void Div(PLANE *Out, const PLANE &p, float s)
-{
-	Out->a = p.a / s; Out->b = p.b / s;
-	Out->c = p.c / s; Out->d = p.d / s;
-}
-
-/// Iloczyn skalarny paszczyzny i punktu we wsprzdnych jednorodnych
-/** Mona uy do wyznaczenia czy tak zapisany punkt ley na paszczynie,
-po ktrej stronie i jak daleko. */
-inline float Dot(const PLANE &p, const VEC4 &pt)
-{
-	return p.a*pt.x + p.b*pt.y + p.c*pt.z + p.d*pt.w;
-}
-
-/// Iloczyn skalarny paszczyzny z punktem 3D: a*x+b*y+c*z+d*1
-/** Mona uy do wyznaczenia czy punkt ley na paszczynie, po ktrej stronie
-i jak daleko. */
-inline float DotCoord(const PLANE &p, const VEC3 &pt)
-{
-	return p.a*pt.x + p.b*pt.y + p.c*pt.z + p.d;
-}
-
-/// Iloczyn skalarny paszczyzny z wektorem 3D: a*x+b*y+c*z+d*0
-/** Przydatny do wyznaczania kta midzy paszczyzn (jej normaln) a wektorem. */
-inline float DotNormal(const PLANE &p, const VEC3 &v)
-{
-	return p.a*v.x + p.b*v.y + p.c*v.z;
-}
-
-/// Normalizacja paszczyzny
-/** Po tej operacji wektor normalny paszczyzny jest znormalizowany.
-Paszczyzna pozostaje pooona i zorientowana tam gdzie bya. */
-inline void Normalize(PLANE *Out, const PLANE &p)
-{
-	float nlsq = 1.0f / Length(GetPlaneNormal(p));
-	Out->a = p.a * nlsq; Out->b = p.b * nlsq;
-	Out->c = p.c * nlsq; Out->d = p.d * nlsq;
-}
-/// Normalizacja paszczyzny w miejscu
-inline void Normalize(PLANE *p)
-{
-	float nlsq = 1.0f / Length(GetPlaneNormal(*p));
-	p->a *= nlsq; p->b *= nlsq;
-	p->c *= nlsq; p->d *= nlsq;
-}
-
-/// Returns plane of one of 6 possible box faces.
-/** Face order is: -X, +X, -Y, +Y, -Z, +Z.
-Returned plane is normalized and points to the outside.
-*/
-void GetBoxPlane(PLANE *out, const BOX &box, uint index);
-
-//@}
-// math_plane
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-/** \addtogroup math_line2d Prosta 2D */
-//@{
-
-/// Prosta 2D
-/**
-Reprezentuje prost w przestrzeni 2D z jedn stron dodatni, a drug
-ujemn. Opisana jest rwnaniem A x + B y + C = 0. Wektor [A,B] to wektor
-normalny wskazujcy w kierunku dodatniej ppaszczyzny. Jeli prosta jest
-znormalizowana, wektor normalny jest znormalizowany, a C to odlego prostej
-od rodka ukadu wsprzdnych.
-Reprezentacja jako string to A,B,C, np. "2,0,2.1"
-Prosta majca a = b = 0 (czyli np. staa ZERO) jest niepoprawna, zdegenerowana.
-*/
-struct LINE2D
-{
-	float a, b, c;
-
-	LINE2D() { }
-	LINE2D(float a, float b, float c) : a(a), b(b), c(c) { }
-	LINE2D(const VEC2 &Normal, float c) : a(Normal.x), b(Normal.y), c(c) { }
-	LINE2D(const float *Arr) : a(Arr[0]), b(Arr[1]), c(Arr[2]) { }
-
-	operator float * () { return &a; }
-	operator const float * () const { return &a; }
-
-	VEC2 & GetNormal() { return (VEC2&)a; }
-	const VEC2 & GetNormal() const { return (VEC2&)a; }
-
-	bool operator == (const LINE2D &L) const { return a == L.a && b == L.b && c == L.c; }
-	bool operator != (const LINE2D &L) const { return a != L.a || b != L.b || c != L.c; }
-
-	LINE2D operator + () const { return *this; }
-	/// Zwraca prost zwrcon w przeciwn stron
-	LINE2D operator - () const { return LINE2D(-a, -b, -c); }
-
-	// Skalowanie
-	LINE2D operator * (float s) const { return LINE2D(a*s, b*s, c*s); }
-	LINE2D operator / (float s) const { float sInv = 1.0f/s; return LINE2D(a*sInv, b*sInv, c*sInv); }
-	LINE2D & operator *= (float s) { a *= s; b *= s; c *= s; return *this; }
-	LINE2D & operator /= (float s) { float sInv = 1.0f/s; a *= sInv; b *= sInv; c *= sInv; return *this; }
-
-	/// Zwraca wektor wskazujcy w kierunku prostej
-	void GetTangent(VEC2 *Out) { Out->x = b; Out->y = -a; }
-
-	/// Zwraca jaki punkt lecy na tej prostej
-	/** Musi by znormalizowana. */
-	void GetMemberPoint(VEC2 *Out)
-	{
-		*Out = GetNormal() * -c;
-	}
-
-	/// Zmienia odlego od pocztku ukadu wsprzdnych
-	/** Prosta pozostajc tak samo
-	zorientowana zostaje przesunita tak, eby zawiera w sobie podany punkt.
-	Musi by znormalizowana. */
-	void RecalcD(const VEC2 &p)
-	{
-		c = -Dot(GetNormal(), p);
-	}
-};
-inline LINE2D operator * (float s, const LINE2D &p) { return LINE2D(p.a*s, p.b*s, p.c*s); }
-inline LINE2D operator / (float s, const LINE2D &p) { float sInv = 1.0f/s; return LINE2D(p.a*sInv, p.b*sInv, p.c*sInv); }
-
-extern const LINE2D LINE2D_ZERO;
-extern const LINE2D LINE2D_POSITIVE_X;
-extern const LINE2D LINE2D_NEGATIVE_X;
-extern const LINE2D LINE2D_POSITIVE_Y;
-extern const LINE2D LINE2D_NEGATIVE_Y;
-
-/// Daje dostp do wektora normalnego podanej prostej, czyli jej skadowych a, b zrzutowanych na VEC2.
-inline VEC2 & GetLineNormal(LINE2D &line) { return (VEC2&)line.a; }
-/// Zwraca wektor normalny prostej, czyli jej skadowe a, b zrzutowane na VEC2.
-inline const VEC2 & GetLineNormal(const LINE2D &line) { return (const VEC2&)line.a; }
-
-/// Zwraca true, jeli podane proste s sobie mniej wicej rwne
-inline bool LineEqual(const LINE2D &p1, const LINE2D &p2) {
-	return float_equal(p1.a, p2.a) && float_equal(p1.b, p2.b) && float_equal(p1.c, p2.c);
-}
-
-inline void swap(LINE2D &p1, LINE2D &p2)
-{
-	std::swap(p1.a, p2.a); std::swap(p1.b, p2.b); std::swap(p1.c, p2.c);
-}
-
-/// Tworzy prost na podstwie dwch punktw
-/** Wynikowa prosta nie jest znormalizowana. */
-inline void PointsToLine(LINE2D *Out, const VEC2 &p1, const VEC2 &p2) {
-	Out->a = p1.y - p2.y;
-	Out->b = p2.x - p1.x;
-	Out->c = - Out->a * p1.x - Out->b * p1.y;
-}
-
-/// Tworzy prost z wektora normalnego i punktu lecego na tej prostej
-inline void PointNormalToLine(LINE2D *Out, const VEC2 &Point, const VEC2 &Normal) {
-	Out->a = Normal.x; Out->b = Normal.y;
-	Out->c = -Dot(Normal, Point);
-}
-
-/// Zwraca true, jeli podane proste s rwnolege
-inline bool LinesParallel(const LINE2D &L1, const LINE2D &L2) {
-	return FLOAT_ALMOST_ZERO(L1.a*L2.b - L2.a*L1.b);
-}
-
-/// Zwraca true, jeli podane proste s prostopade
-inline bool LinesPerpedicular(const LINE2D &L1, const LINE2D &L2) {
-	return FLOAT_ALMOST_ZERO(L1.a*L2.a + L1.b*L2.b);
-}
-
-/// Zwraca dot z wektorw normalnych dwch prostych
-/** Jeli te proste s znormalizowane, wynikiem jest cos kta midzy tymi prostymi. */
-inline float Dot(const LINE2D &L1, const LINE2D &L2) {
-	return L1.a*L2.a + L1.b*L2.b;
-}
-
-/// Zwraca signed odlego dwch prostych na paszczynie
-/** Proste musz by znormalizowane. */
-inline float LineDistance(const LINE2D &L1, const LINE2D &L2) {
-	return L1.c - L2.c;
-}
-
-/// Oblicza punkt przeciecia dwch prostych
-/** Jeli proste nie przecinaj si, tylko s rwnolege lub si pokrywan, to nie oblicza tylko zwraca false. */
-bool LinesIntersection(VEC2 *Out, const LINE2D &L1, const LINE2D &L2);
-
-/// Skalowanie prostej
-inline void Mul(LINE2D *Out, const LINE2D &p, float s) {
-	Out->a = p.a * s; Out->b = p.b * s; Out->c = p.c * s;
-}
-inline void Div(LINE2D *Out, const LINE2D &p, float s) {
-	Out->a = p.a / s; Out->b = p.b / s; Out->c = p.c / s;
-}
-
-/// Iloczyn skalarny paszczyzny i punktu we wsprzdnych jednorodnych 2D
-/** Mona uy do wyznaczenia czy tak zapisany punkt ley na paszczynie,
-po ktrej stronie i jak daleko. */
-inline float Dot(const LINE2D &p, const VEC3 &pt) {
-	return p.a*pt.x + p.b*pt.y + p.c*pt.z;
-}
-
-/// Iloczyn skalarny prostej 2D z punktem 2D: a*x + b*y + c*1
-/** Mona uy do wyznaczenia czy punkt ley na prostej 2D, po ktrej stronie i jak daleko. */
-inline float DotCoord(const LINE2D &p, const VEC2 &pt) {
-	return p.a*pt.x + p.b*pt.y + p.c;
-}
-
-/// Iloczyn skalarny prostej 2D z wektorem 2D: a*x + b*y + c*z + d*0
-/** Przydatny do wyznaczania kta midzy prost 2D (jej normaln) a wektorem. */
-inline float DotNormal(const LINE2D &p, const VEC2 &v) {
-	return p.a*v.x + p.b*v.y;
-}
-
-/// Normalizacja prostej 2D
-/** Po tej operacji wektor normalny prostej jest znormalizowany.
-Prosta pozostaje pooona i zorientowana tam gdzie bya. */
-inline void Normalize(LINE2D *Out, const LINE2D &p) {
-	float nlsq = 1.f / Length(p.GetNormal());
-	Out->a = p.a * nlsq; Out->b = p.b * nlsq; Out->c = p.c * nlsq;
-}
-/// Normalizacja prostej w miejscu
-inline void Normalize(LINE2D *p) {
-	float nlsq = 1.f / Length(p->GetNormal());
-	p->a *= nlsq; p->b *= nlsq; p->c *= nlsq;
-}
-
-/// Returns line of one of 4 possible box edges.
-/** Face order is: -X, +X, -Y, +Y.
-Returned line is normalized and points to the outside.
-*/
-void GetRectLine(LINE2D *out, const RECTF &rect, uint index);
-
-//@}
-// math_line3d
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-/** \addtogroup math_matrix Macierz */
-//@{
-
-#if defined(USE_DIRECTX) && !defined(DOXYGEN)
-	typedef D3DXMATRIX MATRIX;
-#else
-	/// Macierz 4 x 4
-	/**
-	Elementy s indeksowane [wiersz,kolumna].
-	Reprezentacja tekstowa to:
-		a11,a12,a13,a14;a21,a22,a23,a24;a31,a32,a33,a34;a41,a42,a43,a44
-	*/
-	struct MATRIX
-	{
-		union
-		{
-			struct
-			{
-				float _11, _12, _13, _14;
-				float _21, _22, _23, _24;
-				float _31, _32, _33, _34;
-				float _41, _42, _43, _44;
-			};
-			float m[4][4]; // [wiersz][kolumna]
-		};
-
-		MATRIX() { }
-		MATRIX(float _11, float _12, float _13, float _14, float _21, float _22, float _23, float _24, float _31, float _32, float _33, float _34, float _41, float _42, float _43, float _44) : _11(_11), _12(_12), _13(_13), _14(_14), _21(_21), _22(_22), _23(_23), _24(_24), _31(_31), _32(_32), _33(_33), _34(_34), _41(_41), _42(_42), _43(_43), _44(_44) { }
-		MATRIX(const float *Array) : _11(Array[0]), _12(Array[1]), _13(Array[2]), _14(Array[3]), _21(Array[4]), _22(Array[5]), _23(Array[6]), _24(Array[7]), _31(Array[8]), _32(Array[9]), _33(Array[10]), _34(Array[11]), _41(Array[12]), _42(Array[13]), _43(Array[14]), _44(Array[15]) { }
-
-		operator float * () { return &_11; }
-		operator const float * () const { return &_11; }
-
-		bool operator == (const MATRIX &m) const { return _11 == m._11 && _12 == m._12 && _13 == m._13 && _14 == m._14 && _21 == m._21 && _22 == m._22 && _23 == m._23 && _24 == m._24 && _31 == m._31 && _32 == m._32 && _33 == m._33 && _34 == m._34 && _41 == m._41 && _42 == m._42 && _43 == m._43 && _44 == m._44; }
-		bool operator != (const MATRIX &m) const { return _11 != m._11 || _12 != m._12 || _13 != m._13 || _14 != m._14 || _21 != m._21 || _22 != m._22 || _23 != m._23 || _24 != m._24 || _31 != m._31 || _32 != m._32 || _33 != m._33 || _34 != m._34 || _41 != m._41 || _42 != m._42 || _43 != m._43 || _44 != m._44; }
-
-		float & operator () (unsigned Row, unsigned Col) { return m[Row][Col]; }
-		float operator () (unsigned Row, unsigned Col) const { return m[Row][Col]; }
-
-		MATRIX operator + () const { return *this; }
-		MATRIX operator - () const;
-		MATRIX operator + (const MATRIX &m) const;
-		MATRIX operator - (const MATRIX &m) const;
-		MATRIX operator * (const MATRIX &m) const
-		{
-			return MATRIX(
-				_11 * m._11 + _12 * m._21 + _13 * m._31 + _14 * m._41,
-				_11 * m._12 + _12 * m._22 + _13 * m._32 + _14 * m._42,
-				_11 * m._13 + _12 * m._23 + _13 * m._33 + _14 * m._43,
-				_11 * m._14 + _12 * m._24 + _13 * m._34 + _14 * m._44,
-
-				_21 * m._11 + _22 * m._21 + _23 * m._31 + _24 * m._41,
-				_21 * m._12 + _22 * m._22 + _23 * m._32 + _24 * m._42,
-				_21 * m._13 + _22 * m._23 + _23 * m._33 + _24 * m._43,
-				_21 * m._14 + _22 * m._24 + _23 * m._34 + _24 * m._44,
-
-				_31 * m._11 + _32 * m._21 + _33 * m._31 + _34 * m._41,
-				_31 * m._12 + _32 * m._22 + _33 * m._32 + _34 * m._42,
-				_31 * m._13 + _32 * m._23 + _33 * m._33 + _34 * m._43,
-				_31 * m._14 + _32 * m._24 + _33 * m._34 + _34 * m._44,
-
-				_41 * m._11 + _42 * m._21 + _43 * m._31 + _44 * m._41,
-				_41 * m._12 + _42 * m._22 + _43 * m._32 + _44 * m._42,
-				_41 * m._13 + _42 * m._23 + _43 * m._33 + _44 * m._43,
-				_41 * m._14 + _42 * m._24 + _43 * m._34 + _44 * m._44);
-		}
-		MATRIX & operator += (const MATRIX &m);
-		MATRIX & operator -= (const MATRIX &m);
-		MATRIX & operator *= (const MATRIX &m);
-
-		MATRIX operator * (float s) const;
-		MATRIX operator / (float s) const;
-		MATRIX & operator *= (float s);
-		MATRIX & operator /= (float s);
-	};
-#endif
-
-extern const MATRIX MATRIX_ZERO;
-extern const MATRIX MATRIX_IDENTITY;
-
-void MatrixToStr(tstring *Out, const MATRIX &m);
-bool StrToMatrix(MATRIX *Out, const tstring &Str);
-
-inline void swap(MATRIX &m1, MATRIX &m2)
-{
-	std::swap(m1._11, m2._11); std::swap(m1._12, m2._12); std::swap(m1._13, m2._13); std::swap(m1._14, m2._14);
-	std::swap(m1._21, m2._21); std::swap(m1._22, m2._22); std::swap(m1._23, m2._23); std::swap(m1._24, m2._24);
-	std::swap(m1._31, m2._31); std::swap(m1._32, m2._32); std::swap(m1._33, m2._33); std::swap(m1._34, m2._34);
-	std::swap(m1._41, m2._41); std::swap(m1._42, m2._42); std::swap(m1._43, m2._43); std::swap(m1._44, m2._44);
-}
-
-/// Zwraca true, jeli podane macierze s sobie mniej wicej rwne
-bool MatrixEqual(const MATRIX &m1, const MATRIX &m2);
-/// Negacja macierzy w miejscu
-void Minus(MATRIX *m);
-/// Dodawanie macierzy
-void Add(MATRIX *Out, const MATRIX &m1, const MATRIX &m2);
-/// Odejmowanie macierzy
-void Sub(MATRIX *Out, const MATRIX &m1, const MATRIX &m2);
-/// Mnoenie macierzy
-void Mul(MATRIX *Out, const MATRIX &m1, const MATRIX &m2);
-/// Mnoenie macierzy przez skalar w miejscu
-void Mul(MATRIX *m, float s);
-/// Dzielenie macierzy przez skalar w miejscu
-void Div(MATRIX *m, float s);
-
-/// Multiplication of 3x3 submatrices
-/** m1 and m2 are assumed to be in form of linear transforms like this
-(4th rows and columns are ignored):
-\verbatim
-_11 _12 _13  0
-_21 _22 _23  0
-_31 _32 _33  0
- 0   0   0   1
-\endverbatim
-Output matrix has only 3x3 submatrix modified.
-4th row and column stay untouched. \n
-Use this method for better efficiency whenever you deal with transforms that have no translation or perspective projection.
-*/
-void Mul3x3(MATRIX &out, const MATRIX &m1, const MATRIX &m2);
-/// Multiplication of 4x3 submatrices
-/** m1 and m2 are assumed to be in form of affine transforms like this
-(4th columns are ignored):
-\verbatim
-_11 _12 _13  0
-_21 _22 _23  0
-_31 _32 _33  0
-_41 _42 _43  1
-\endverbatim
-Output matrix has only 4x3 submatrix modified.
-4th column stays untouched.
-Use this method for better efficiency whenever you deal with transforms that have no perspective projection.
-*/
-void Mul4x3(MATRIX &out, const MATRIX &m1, const MATRIX &m2);
-
-/// Mnoenie wektora 2D jako [x,y,0,1] przez macierz, wychodzi wektor 4D
-void Transform(VEC4 *Out, const VEC2 &v, const MATRIX &m);
-/// Mnoenie wektora 2D jako [x,y,0,1] przez macierz z olaniem wyjciowego W
-void Transform(VEC2 *Out, const VEC2 &v, const MATRIX &m);
-/// Mnoenie wektora 2D jako [x,y,0,1] przez macierz i sprowadzenie z powrotem do 2D przez podzielenie przez W
-void TransformCoord(VEC2 *Out, const VEC2 &v, const MATRIX &m);
-/// Mnoenie wektora 2D jako [x,y,0,0] przez macierz
-void TransformNormal(VEC2 *Out, const VEC2 &v, const MATRIX &m);
-
-/// Mnoenie wektora 3D jako [X,Y,Z,1] przez macierz, wychodzi wektor 4D
-void Transform(VEC4 *Out, const VEC3 &v, const MATRIX &m);
-/// Mnoenie wektora 3D jako [X,Y,Z,1] przez macierz z olaniem wyjciowego W
-/** Dobre do przeksztacania wektorw 3D jeli macierz reprezentuje przeksztacenie liniowe. */
-void Transform(VEC3 *Out, const VEC3 &v, const MATRIX &m);
-/// Mnoenie wektora 3D jako [X,Y,Z,1] przez macierz i sprowadzenie z powrotem do 3D przez podzielenie przez W
-/** Dobre do niezawodnego przeksztacania wektorw 3D przez dowoln macierz np. rzutowania. */
-void TransformCoord(VEC3 *Out, const VEC3 &v, const MATRIX &m);
-/// Mnoenie wektora 3D jako [X,Y,Z,0] przez macierz
-/** Dobre do przeksztacania wektorw (np. normalnych), nie punktw, bo nie robi translacji. */
-void TransformNormal(VEC3 *Out, const VEC3 &v, const MATRIX &m);
-
-/// Przeksztaca na raz ca tablic wektorw - w miejscu lub z tablicy wejciowej do wyjciowej
-void TransformArray(VEC3 OutPoints[], const VEC3 InPoints[], size_t PointCount, const MATRIX &M);
-void TransformArray(VEC3 InOutPoints[], size_t PointCount, const MATRIX &M);
-void TransformNormalArray(VEC3 OutPoints[], const VEC3 InPoints[], size_t PointCount, const MATRIX &M);
-void TransformNormalArray(VEC3 InOutPoints[], size_t PointCount, const MATRIX &M);
-void TransformCoordArray(VEC3 OutPoints[], const VEC3 InPoints[], size_t PointCount, const MATRIX &M);
-void TransformCoordArray(VEC3 InOutPoints[], size_t PointCount, const MATRIX &M);
-
-/// Mnoenie wektora 4D przez macierz
-/** Czyli przeksztacenie wektora we wsprzdnych jednorodnych przez t macierz. */
-void Transform(VEC4 *Out, const VEC4 &v, const MATRIX &m);
-
-/// Mnoy wektor przez transpozycj podanej macierzy m (jej podmacierzy 3x3)
-void TransformNormalByTranspose(VEC3 *Out, const VEC3 &v, const MATRIX &m);
-/// Mnoy punkt przez odwrotnos podanej macierzy m (jej podmacierzy 4x3), ale bez odwracania.
-/** Czyli jeli macierz zawiera rotacj i translacj, to wykonuje na punkcie
-przeksztacenie odwrotne do tego ktre jest w tej macierzy. \n
-Pomysodawca: Krzysiek K. */
-void Untransform(VEC3 *Out, const VEC3 &v, const MATRIX &m);
-/// Mnoy wektor przez odwrotnos podanej macierzy m (jej podmacierzy 3x3), ale bez odwracania.
-/** Czyli jeli macierz zawiera rotacj i translacj, to wykonuje na punkcie
-przeksztacenie odwrotne do rotacji, ktra jest w tej macierzy. */
-void UntransformNormal(VEC3 *Out, const VEC3 &v, const MATRIX &m);
-
-/// Przeksztaca paszczyzn przez macierz
-/** \param p Paszczyzna ma by znormalizowana.
-\param m Macierz ma by odwrotna i transponowana wzgldem normalnej macierzy. */
-void Transform(PLANE *Out, const PLANE &p, const MATRIX &m);
-/// Przeksztaca promie przez macierz
-void TransformRay(VEC3 *OutOrigin, VEC3 *OutDir, const VEC3 &RayOrigin, const VEC3 &RayDir, const MATRIX &m);
-
-/// Przeksztaca AABB przez podan macierz i wylicza AABB tego co wyszo po przeksztaceniu
-void TransformBox(BOX *Out, const BOX &In, const MATRIX &M);
-/// Przeksztaca AABB przez podan macierz i wylicza AABB tego co wyszo po przeksztaceniu
-/** Wersja dzielca przez W - mona stosowa te do macierzy projekcji. */
-void TransformBoxCoord(BOX *Out, const BOX &In, const MATRIX &M);
-
-/// Ustawia translacj w macierzy
-void MatrixSetTranslation(MATRIX *InOut, float TranslationX, float TranslationY, float TranslationZ);
-/// Ustawia translacj w macierzy
-void MatrixSetTranslation(MATRIX *InOut, const VEC3 &Translation);
-/// Pobiera translacj z macierzy
-void MatrixGetTranslation(float *OutTranslationX, float *OutTranslationY, float *OutTranslationZ, const MATRIX &m);
-/// Pobiera translacj z macierzy
-void MatrixGetTranslation(VEC3 *OutTranslation, const MATRIX &m);
-
-/// Tworzy macierz przeksztacajc do lokalnego ukadu wsprzdnych wyznaczonego przez podane 3 osie
-/** Nastpi obrt, a jeli nie s znormalizowane to i skalowanie. */
-void AxesToMatrix(MATRIX *Out, const VEC3 &AxisX, const VEC3 &AxisY, const VEC3 &AxisZ);
-/// Tworzy macierz przeksztacajc do lokalnego ukadu wsprzdnych wyznaczonego przez podane 3 osie i pozycj pocztku tego ukadu.
-/** Nastpi obrt, a jeli osie s znormalizowane to i skalowanie. */
-void AxesToMatrixTranslation(MATRIX *Out, const VEC3 &Origin, const VEC3 &AxisX, const VEC3 &AxisY, const VEC3 &AxisZ);
-
-/// Macierz kamery
-/** Eye to punkt, Forward i Up to wektory. */
-void LookAtLH(MATRIX *Out, const VEC3 &Eye, const VEC3 &Forward, const VEC3 &Up);
-void LookAtRH(MATRIX *Out, const VEC3 &Eye, const VEC3 &Forward, const VEC3 &Up);
-
-/// Tworzy macierz identycznociow
-void Identity(MATRIX *Out);
-/// Tworzy macierz translacji (przesuwania)
-void Translation(MATRIX *Out, float x, float y, float z);
-void Translation(MATRIX *Out, const VEC3 &v);
-/// Tworzy macierz skalowania (powikszania, pomniejszania, rozcigania)
-void Scaling(MATRIX *Out, float sx, float sy, float sz);
-void Scaling(MATRIX *Out, const VEC3 &sv);
-void Scaling(MATRIX *Out, float s);
-/// Tworzy macierz skalowania wzdu podanego kierunku
-/** \param k   wspczynnik skalowania
-\param n   wektor kierunku, musi by znormalizowany */
-void ScalingAxis(MATRIX *Out, const VEC3 &n, float k);
-
-/// Macierz obrotu 2D
-void Rotation2D(MATRIX *Out, float Angle);
-/// Macierz obrotu wok osi X
-void RotationX(MATRIX *Out, float Angle);
-/// Macierz obrotu wok osi Y
-void RotationY(MATRIX *Out, float Angle);
-/// Macierz obrotu wok osi Z
-void RotationZ(MATRIX *Out, float Angle);
-/** Axis musi by znormalizowany. */
-void RotationAxisLH(MATRIX *Out, const VEC3 &Axis, float Angle);
-inline void RotationAxisRH(MATRIX *Out, const VEC3 &Axis, float Angle) { RotationAxisLH(Out, Axis, -Angle); }
-
-/// Macierz obrotu wok trzech osi w kolejnoci Yaw-Pitch-Roll (ZXY) - tzw. kty Eulera
-/** W przypadku wektora skadowe odpowiadaj obrotom wok poszczeglnych osi, czyli:
-  X = Pitch, Y = Yaw, Z = Roll
-Przeksztaca ze wsp. obiektu do wiata (object -> interial space).
-Czyli tak naprawd robi ZXY.
-\param Yaw jest wok osi Y.
-\param Pitch jest wok osi X.
-\param Roll jest wok osi Z. */
-void RotationYawPitchRoll(MATRIX *Out, float Yaw, float Pitch, float Roll);
-void RotationYawPitchRoll(MATRIX *Out, const VEC3 &EulerAngles);
-/// Przeksztaca ze wsp. wiata do obiektu (interial -> object space).
-/** Czyli tworzy macierz dokadnie odwrotn do tej z RotationYawPitchRoll. */
-void RotationYawPitchRollInv(MATRIX *Out, float Yaw, float Pitch, float Roll);
-void RotationYawPitchRollInv(MATRIX *Out, const VEC3 &EulerAngles);
-
-/*/// Przetwarza macierz obrotu (to musi by czysta macierz obrotu) na kty Eulera
-void RotationMatrixToEulerAngles(const MATRIX &m, float *Yaw, float *Pitch, float *Roll);*/
-
-/// Tworzy macierz rzutowania ortogonalnego
-/** Dane s w ukadzie kamery. */
-void OrthoLH(MATRIX *Out, float Width, float Height, float ZNear, float ZFar);
-void OrthoRH(MATRIX *Out, float Width, float Height, float ZNear, float ZFar);
-void OrthoOffCenterLH(MATRIX *Out, float Left, float Right, float Bottom, float Top, float ZNear, float ZFar);
-void OrthoOffCenterRH(MATRIX *Out, float Left, float Right, float Bottom, float Top, float ZNear, float ZFar);
-/// Tworzy macierz rzutowania perspektywicznego
-/** Width i Height s wymiarami na paszczynie bliskiej (near).
-Left, Top, Right, Bottom prawdopodobnie te.
-Tworzone macierze s "W-Friendly" - wektor przemnoony przez tak macierz ma w skadowej W komponent Z.
-*/
-void PerspectiveLH(MATRIX *Out, float Width, float Height, float ZNear, float ZFar);
-void PerspectiveRH(MATRIX *Out, float Width, float Height, float ZNear, float ZFar);
-void PerspectiveFovLH(MATRIX *Out, float FovY, float Aspect, float ZNear, float ZFar);
-void PerspectiveFovRH(MATRIX *Out, float FovY, float Aspect, float ZNear, float ZFar);
-void PerspectiveOffCenterLH(MATRIX *Out, float Left, float Right, float Bottom, float Top, float ZNear, float ZFar);
-void PerspectiveOffCenterRH(MATRIX *Out, float Left, float Right, float Bottom, float Top, float ZNear, float ZFar);
-/// Wersja tworzca macierz z Z-Far = INFINITY
-void PerspectiveFovLH_Inf(MATRIX *Out, float FovY, float Aspect, float ZNear);
-/// Tworzy macierz spaszczajc geometri na podan paszczyzn w podanym kierunku padania wiata
-/** Paszczyzna musi by znormalizowana. */
-void MatrixShadow(MATRIX *Out, const VEC4 &Light, const PLANE &Plane);
-/// Tworzy macierz odbijajc geometri wzgldem podanej paszczyzny
-/** Paszczyzna musi by znormalizowana. */
-void MatrixReflect(MATRIX *Out, const PLANE &p);
-
-/// Transpozycja macierzy na miejscu
-void Transpose(MATRIX *m);
-/// Transpozycja macierzy
-void Transpose(MATRIX *Out, const MATRIX &m);
-/// Interpolacja liniowa macierzy
-void Lerp(MATRIX *Out, const MATRIX &m1, const MATRIX &m2, float t);
-/// Wyznacznik macierzy
-float Det(const MATRIX &m);
-/// Odwrotno macierzy
-bool Inverse(MATRIX *Out, const MATRIX &m);
-
-
-/// Macierz 3 x 3
-/**
-Elementy s indeksowane [wiersz,kolumna].
-Reprezentacja tekstowa to:
-	a11,a12,a13,a21,a22,a23,a31,a32,a33
-*/
-struct MATRIX33
-{
-	union
-	{
-		struct
-		{
-			float _11, _12, _13;
-			float _21, _22, _23;
-			float _31, _32, _33;
-		};
-		float m[3][3]; // [wiersz][kolumna]
-	};
-
-	MATRIX33() { }
-	MATRIX33(float _11, float _12, float _13, float _21, float _22, float _23, float _31, float _32, float _33) : _11(_11), _12(_12), _13(_13), _21(_21), _22(_22), _23(_23), _31(_31), _32(_32), _33(_33) { }
-	MATRIX33(const float *Array) : _11(Array[0]), _12(Array[1]), _13(Array[2]), _21(Array[4]), _22(Array[5]), _23(Array[6]), _31(Array[8]), _32(Array[9]), _33(Array[10]) { }
-
-	operator float * () { return &_11; }
-	operator const float * () const { return &_11; }
-
-	bool operator == (const MATRIX33 &m) const { return _11 == m._11 && _12 == m._12 && _13 == m._13 && _21 == m._21 && _22 == m._22 && _23 == m._23 && _31 == m._31 && _32 == m._32 && _33 == m._33; }
-	bool operator != (const MATRIX33 &m) const { return _11 != m._11 || _12 != m._12 || _13 != m._13 || _21 != m._21 || _22 != m._22 || _23 != m._23 || _31 != m._31 || _32 != m._32 || _33 != m._33; }
-
-	float & operator () (unsigned Row, unsigned Col) { return m[Row][Col]; }
-	float operator () (unsigned Row, unsigned Col) const { return m[Row][Col]; }
-
-	MATRIX33 operator + () const { return *this; }
-	MATRIX33 operator - () const;
-	MATRIX33 operator + (const MATRIX33 &m) const;
-	MATRIX33 operator - (const MATRIX33 &m) const;
-	MATRIX33 operator * (const MATRIX33 &m) const
-	{
-		return MATRIX33(
-			_11 * m._11 + _12 * m._21 + _13 * m._31,
-			_11 * m._12 + _12 * m._22 + _13 * m._32,
-			_11 * m._13 + _12 * m._23 + _13 * m._33,
-
-			_21 * m._11 + _22 * m._21 + _23 * m._31,
-			_21 * m._12 + _22 * m._22 + _23 * m._32,
-			_21 * m._13 + _22 * m._23 + _23 * m._33,
-
-			_31 * m._11 + _32 * m._21 + _33 * m._31,
-			_31 * m._12 + _32 * m._22 + _33 * m._32,
-			_31 * m._13 + _32 * m._23 + _33 * m._33);
-	}
-	MATRIX33 & operator += (const MATRIX33 &m);
-	MATRIX33 & operator -= (const MATRIX33 &m);
-	MATRIX33 & operator *= (const MATRIX33 &m);
-
-	MATRIX33 operator * (float s) const;
-	MATRIX33 operator / (float s) const;
-	MATRIX33 & operator *= (float s);
-	MATRIX33 & operator /= (float s);
-};
-
-extern const MATRIX33 MATRIX33_ZERO;
-extern const MATRIX33 MATRIX33_IDENTITY;
-
-/// Konwertuje macierz 3x3 na macierz 4x4
-void Matrix33ToMatrix(MATRIX *Out, const MATRIX33 &m);
-/// Wyciga podmacierz 3x3 z macierzy 4x4
-void MatrixToMatrix33(MATRIX33 *Out, const MATRIX &m);
-
-/// Tworzy macierz identycznociow
-void Identity(MATRIX33 *Out);
-
-/// Transpozycja macierzy na miejscu
-void Transpose(MATRIX33 *m);
-/// Transpozycja macierzy
-void Transpose(MATRIX33 *Out, const MATRIX33 &m);
-
-//@}
-// math_matrix
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-/** \addtogroup math_quaternion Kwaternion */
-//@{
-
-#if defined(USE_DIRECTX) && !defined(DOXYGEN)
-	typedef D3DXQUATERNION QUATERNION;
-#else
-	/// Kwaternion
-	/**
-	Reprezentacja jako acuch to: "x,y,z,w", np.: "1,2,3.5,-10".
-	Kwaterniony s mnoone od drugiej strony ni matematycznie, dziki czemu mona
-	czy obroty ktre reprezentuj w porzdku naturalnym, tak jak macierze.
-	*/
-	struct QUATERNION
-	{
-		float x, y, z, w;
-
-		QUATERNION() { }
-		QUATERNION(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) { }
-		QUATERNION(const float *Array) : x(Array[0]), y(Array[1]), z(Array[2]), w(Array[3]) { }
-
-		operator float * () { return &x; }
-		operator const float * () const { return &x; }
-
-		bool operator == (const QUATERNION &v) const { return x == v.x && y == v.y && z == v.z && w == v.w; }
-		bool operator != (const QUATERNION &v) const { return x != v.x || y != v.y || z != v.z || w != v.w; }
-
-		QUATERNION operator + () const { return *this; }
-		QUATERNION operator - () const { return QUATERNION(-x, -y, -z, -w); }
-		QUATERNION operator + (const QUATERNION &q) const { return QUATERNION(x+q.x, y+q.y, z+q.z, w+q.w); }
-		QUATERNION operator - (const QUATERNION &q) const { return QUATERNION(x-q.x, y-q.y, z-q.z, w-q.w); }
-		QUATERNION operator * (const QUATERNION &q) const { return QUATERNION(w*q.x + x*q.w + y*q.z - z*q.y, w*q.y + y*q.w + z*q.x - x*q.z, w*q.z + z*q.w + x*q.y - y*q.x, w*q.w - x*q.x - y*q.y - z*q.z); }
-		QUATERNION & operator += (const QUATERNION &q) { x += q.x; y += q.y; z += q.z; w += q.w; return *this; }
-		QUATERNION & operator -= (const QUATERNION &q) { x -= q.x; y -= q.y; z -= q.z; w -= q.w; return *this; }
-		QUATERNION & operator *= (const QUATERNION &q) { QUATERNION R; R.x = w*q.x + x*q.w + y*q.z - z*q.y; R.y = w*q.y + y*q.w + z*q.x - x*q.z; R.z = w*q.z + z*q.w + x*q.y - y*q.x; R.w = w*q.w - x*q.x - y*q.y - z*q.z; *this = R; return *this; }
-		QUATERNION & operator *= (float v) { x *= v; y *= v; z *= v; w *= v; return *this; }
-		QUATERNION & operator /= (float v) { float vInv = 1.0f/v; x *= vInv; y *= vInv; z *= vInv; w *= vInv; return *this; }
-	};
-	inline QUATERNION operator * (const QUATERNION &pt, float v) { return QUATERNION(pt.x*v, pt.y*v, pt.z*v, pt.w*v); }
-	inline QUATERNION operator / (const QUATERNION &pt, float v) { float vInv = 1.0f/v; return QUATERNION(pt.x*vInv, pt.y*vInv, pt.z*vInv, pt.w*vInv); }
-	inline QUATERNION operator * (float v, const QUATERNION &pt) { return QUATERNION(pt.x*v, pt.y*v, pt.z*v, pt.w*v); }
-	inline QUATERNION operator / (float v, const QUATERNION &pt) { float vInv = 1.0f/v; return QUATERNION(pt.x*vInv, pt.y*vInv, pt.z*vInv, pt.w*vInv); }
-#endif
-
-extern const QUATERNION QUATERNION_ZERO;
-extern const QUATERNION QUATERNION_IDENTITY;
-
-inline void swap(QUATERNION &v1, QUATERNION &v2)
-{
-	std::swap(v1.x, v2.x);
-	std::swap(v1.y, v2.y);
-	std::swap(v1.z, v2.z);
-	std::swap(v1.w, v2.w);
-}
-
-/// Zwraca kt obrotu jaki reprezentuje ten kwaternion
-inline float CalcQuaternionAngle(const QUATERNION &Q) { return safe_acos(Q.w) * 2.0f; }
-/// Zwraca o obrotu jak reprezentuje ten kwaternion
-void CalcQuaternionAxis(VEC3 *Out, const QUATERNION &Q);
-
-/// Zwraca true, jeli podane kwaterniony s sobie mniej wicej rwne
-inline bool QuaternionEqual(const QUATERNION &q1, const QUATERNION &q2) {
-	return float_equal(q1.x, q2.x) && float_equal(q1.y, q2.y) && float_equal(q1.z, q2.z) && float_equal(q1.w, q2.w);
-}
-
-/// Ujemny kwaternion
-void Minus(QUATERNION *q);
-inline void Minus(QUATERNION *Out, const QUATERNION &q) { *Out = q; Minus(Out); }
-/// Dodawanie, odejmowanie, mnoenie kwaternionw
-void Add(QUATERNION *Out, const QUATERNION &q1, const QUATERNION &q2);
-void Sub(QUATERNION *Out, const QUATERNION &q1, const QUATERNION &q2);
-void Mul(QUATERNION *Out, const QUATERNION &q1, const QUATERNION &q2);
-/// Mnoenie i dzielenie kwaterniona przez skalar
-void Mul(QUATERNION *q, float v);
-void Div(QUATERNION *q, float v);
-inline void Mul(QUATERNION *Out, const QUATERNION &q, float v) { *Out = q; Mul(Out, v); }
-inline void Div(QUATERNION *Out, const QUATERNION &q, float v) { *Out = q; Div(Out, v); }
-
-/// Tworzy kwaternion na podstawie macierzy obrotu
-void RotationMatrixToQuaternion(QUATERNION *Out, const MATRIX &RotationMatrix);
-/// Przeksztaca kwaternion w macierz obrotu
-void QuaternionToRotationMatrix(MATRIX *Out, const QUATERNION &q);
-/// Przeksztaca punkt/wektor przez kwaternion obracajc go o ten kwaternion
-/**
-- To nie jest wcale super szybkie i nie przydaje si a tak czsto.
-  Lepiej sobie przeksztaci kwaternion na macierz.
-- Out = q * p * q^-1
-*/
-void QuaternionTransform(VEC3 *Out, const VEC3 &p, const QUATERNION &q);
-/// Konwersja ktw Eulera na kwaternion (ktry obraca ze wsp. obiektu do wiata, czyli object -> interial space) [a moe odwrotnie?]
-/** Ta funkcja dziaa identycznie z D3DXQuaternionRotationYawPitchRoll. */
-void EulerAnglesToQuaternionO2I(QUATERNION *Out, float Yaw, float Pitch, float Roll);
-/// Konwersja ktw Eulera na kwaternion (ktry obraca ze wsp. wiata do obiektu, czyli interial -> object space) [a moe odwrotnie?]
-void EulerAnglesToQuaternionI2O(QUATERNION *Out, float Yaw, float Pitch, float Roll);
-/// Konwersja kwaterniona ktry obraca ze wsp. obiektu do wiata, czyli object -> interial space, na kty Eulera
-void QuaternionO2IToEulerAngles(float *Yaw, float *Pitch, float *Roll, const QUATERNION &q);
-/// Konwersja kwaterniona ktry obraca ze wsp. wiata do obiektu, czyli interial -> object space, na kty Eulera
-void QuaternionI2OToEulerAngles(float *Yaw, float *Pitch, float *Roll, const QUATERNION &q);
-
-/// Tworzy kwaternion obracajcy wok osi X
-void QuaternionRotationX(QUATERNION *Out, float a);
-/// Tworzy kwaternion obracajcy wok osi Y
-void QuaternionRotationY(QUATERNION *Out, float a);
-/// Tworzy kwaternion obracajcy wok osi Z
-void QuaternionRotationZ(QUATERNION *Out, float a);
-/// Tworzy kwaternion na podstawie osi obrotu i kta
-void AxisToQuaternion(QUATERNION *Out, const VEC3 &Axis, float Angle);
-
-/// Oblica "rnic" dwch kwaternionw reprezentujc taki obrt e a*Out = b
-/** To jest obliczane tak: Out = a^-1 * b, wic jeli masz ju a^-1 to nie uywaj. */
-void QuaternionDiff(QUATERNION *Out, const QUATERNION &a, const QUATERNION &b);
-/// Kwaternion sprzony do danego
-void Conjugate(QUATERNION *q);
-inline void Conjugate(QUATERNION *Out, const QUATERNION &q) { *Out = q; Conjugate(Out); }
-/// Odwrotno kwaterniona
-void Inverse(QUATERNION *Out, const QUATERNION &q);
-/// Normalizacja kwaternion
-void Normalize(QUATERNION *Out, const QUATERNION &q);
-void Normalize(QUATERNION *InOut);
-/// Iloczyn skalarny dwch kwaternionw
-float Dot(const QUATERNION &q1, const QUATERNION &q2);
-/// Kwadrat dugoci kwaterniona
-float LengthSq(const QUATERNION &q);
-/// Dugo kwaterniona
-float Length(const QUATERNION &q);
-void Log(QUATERNION *Out, const QUATERNION &q);
-void Exp(QUATERNION *Out, const QUATERNION &q);
-/// Podnie kwaternion do potgi.
-/** Wykadnik 0..1 daje interpolacje kwaterniona od identycznociowego do q. */
-void Pow(QUATERNION *InOut, float t);
-inline void Pow(QUATERNION *Out, const QUATERNION &q, float t) { *Out = q; Pow(Out, t); }
-/// Interpolacja normalna kwaternionw
-void Lerp(QUATERNION *Out, const QUATERNION &q1, const QUATERNION &q2, float t);
-/// Interpolacja sferyczna kwaternionw
-/** Sprawdzona, daje wyniki dokadnie tekie same jak D3DXQuaternionSlerp. */
-void Slerp(QUATERNION *Out, const QUATERNION &q0, const QUATERNION &q1, float t);
-/** NIE TESTOWANA */
-void Squad(QUATERNION *Out, const QUATERNION &Q1, const QUATERNION &A, const QUATERNION &B, const QUATERNION &C, float t);
-/** NIE TESTOWANA */
-void SquadSetup(QUATERNION *OutA, QUATERNION *OutB, QUATERNION *OutC, const QUATERNION &Q0, const QUATERNION &Q1, const QUATERNION &Q2, const QUATERNION &Q3);
-
-//@}
-// math_quaternion
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-/** \addtogroup math_affine2d Affine 2D transform */
-//@{
-
-/// Affine transform of 2D point/vector
-/**
-\verbatim
-(xOut, yOut) = | a b |  | x | + | c |
-               | d e |  | y |   | f |
-\endverbatim
-It means that:
-\verbatim
-(xOut, yOut) = (a*x + b*y + c, d*x + e*y + f)
-\endverbatim
-Multiplication order is OpenGL-like, opposite to what MATRIX represents. \n
-Elements are indexed as [row, column]. \n
-Text representation is: a,b,c;d,e,f
-*/
-struct AFFINE2D
-{
-	union {
-		struct {
-			float a, b, c, d, e, f;
-		};
-		float m[2][3];
-	};
-
-	AFFINE2D() { }
-	AFFINE2D(float a, float b, float c, float d, float e, float f) : a(a), b(b), c(c), d(d), e(e), f(f) { }
-	AFFINE2D(const float *arr) : a(arr[0]), b(arr[1]), c(arr[2]), d(arr[3]), e(arr[4]), f(arr[5]) { }
-
-	operator float * () { return &a; }
-	operator const float * () const { return &a; }
-
-	float & operator [] (size_t index) { return (&a)[index]; }
-	float operator [] (size_t index) const { return (&a)[index]; }
-
-	bool operator == (const AFFINE2D &rhs) const { return a == rhs.a && b == rhs.b && c == rhs.c && d == rhs.d && e == rhs.e && f == rhs.f; }
-	bool operator != (const AFFINE2D &rhs) const { return a != rhs.a || b != rhs.b || c != rhs.c || d != rhs.d || e != rhs.e || f != rhs.f; }
-
-	float & operator () (uint row, uint col) { return m[row][col]; }
-	float operator () (uint row, uint col) const { return m[row][col]; }
-
-	AFFINE2D operator + () const { return *this; }
-	AFFINE2D operator - () const { return AFFINE2D(-a, -b, -c, -d, -e, -f); }
-
-	AFFINE2D operator + (const AFFINE2D &rhs) const { return AFFINE2D(a + rhs.a, b + rhs.b, c + rhs.c, d + rhs.d, e + rhs.e, f + rhs.f); }
-	AFFINE2D operator - (const AFFINE2D &rhs) const { return AFFINE2D(a - rhs.a, b - rhs.b, c - rhs.c, d - rhs.d, e - rhs.e, f - rhs.f); }
-	AFFINE2D operator * (const AFFINE2D &rhs) const
-	{
-		return AFFINE2D(
-			a*rhs.a + b*rhs.d, a*rhs.b + b*rhs.e, a*rhs.c + b*rhs.f + c,
-			d*rhs.a + e*rhs.d, d*rhs.b + e*rhs.e, d*rhs.c + e*rhs.f + f);
-	}
-
-	AFFINE2D & operator += (const AFFINE2D &rhs) { a += rhs.a; b += rhs.b; c += rhs.c; d += rhs.d; e += rhs.e; f += rhs.f; return *this; }
-	AFFINE2D & operator -= (const AFFINE2D &rhs) { a -= rhs.a; b -= rhs.b; c -= rhs.c; d -= rhs.d; e -= rhs.e; f -= rhs.f; return *this; }
-	AFFINE2D & operator *= (const AFFINE2D &rhs) { return *this = *this * rhs; }
-
-	AFFINE2D operator * (float s) const { return AFFINE2D(a*s, b*s, c*s, d*s, e*s, f*s); }
-	AFFINE2D operator / (float s) const { s = 1.f/s; return AFFINE2D(a*s, b*s, c*s, d*s, e*s, f*s); }
-	AFFINE2D & operator *= (float s) { a*=s; b*=s; c*=s; d*=s; e*=s; f*=s; return *this; }
-	AFFINE2D & operator /= (float s) { s = 1.f/s; a*=s; b*=s; c*=s; d*=s; e*=s; f*=s; return *this; }
-};
-
-extern const AFFINE2D AFFINE2D_ZERO;
-extern const AFFINE2D AFFINE2D_IDENTITY;
-
-void Affine2dToStr(tstring *Out, const AFFINE2D &aff);
-bool StrToAffine2d(AFFINE2D *Out, const tstring &Str);
-
-inline void swap(AFFINE2D &aff1, AFFINE2D &aff2)
-{
-	std::swap(aff1.a, aff2.a); std::swap(aff1.b, aff2.b); std::swap(aff1.c, aff2.c);
-	std::swap(aff1.d, aff2.d); std::swap(aff1.e, aff2.e); std::swap(aff1.f, aff2.f);
-}
-
-/// Per component multiplication.
-inline void Mul(AFFINE2D &out, const AFFINE2D &lhs, const AFFINE2D &rhs)
-{
-	out.a = lhs.a*rhs.a; out.b = lhs.b*rhs.b; out.c = lhs.c*rhs.c;
-	out.d = lhs.d*rhs.d; out.e = lhs.e*rhs.e; out.f = lhs.f*rhs.f;
-}
-/// Per component division.
-inline void Div(AFFINE2D &out, const AFFINE2D &lhs, const AFFINE2D &rhs)
-{
-	out.a = lhs.a/rhs.a; out.b = lhs.b/rhs.b; out.c = lhs.c/rhs.c;
-	out.d = lhs.d/rhs.d; out.e = lhs.e/rhs.e; out.f = lhs.f/rhs.f;
-}
-
-/// 2D point transformation, including translation.
-inline void Transform(VEC2 &out, const VEC2 &v, const AFFINE2D &aff)
-{
-	out.x = aff.a*v.x + aff.b*v.y + aff.c;
-	out.y = aff.d*v.x + aff.e*v.y + aff.f;
-}
-/// 2D vector transformation by 2x2 submatrix, with no translation.
-inline void TransformNormal(VEC2 &out, const VEC2 &v, const AFFINE2D &aff)
-{
-	out.x = aff.a*v.x + aff.b*v.y;
-	out.y = aff.d*v.x + aff.e*v.y;
-}
-
-inline void Translation(AFFINE2D &out, const VEC2 &v)
-{
-	out = AFFINE2D(
-		1.f, 0.f, v.x,
-		0.f, 1.f, v.y);
-}
-inline void Translation(AFFINE2D &out, float x, float y)
-{
-	out = AFFINE2D(
-		1.f, 0.f, x,
-		0.f, 1.f, y);
-}
-
-inline void Scaling(AFFINE2D &out, float s)
-{
-	out = AFFINE2D(
-		s,   0.f, 0.f,
-		0.f, s,   0.f);
-}
-inline void Scaling(AFFINE2D &out, const VEC2 &v)
-{
-	out = AFFINE2D(
-		v.x, 0.f, 0.f,
-		0.f, v.y, 0.f);
-}
-inline void Scaling(AFFINE2D &out, float x, float y)
-{
-	out = AFFINE2D(
-		x,   0.f, 0.f,
-		0.f, y,   0.f);
-}
-
-inline void Rotation(AFFINE2D &out, float angle)
-{
-	float angleSin, angleCos;
-	sincos(angle, &angleSin, &angleCos);
-	out = AFFINE2D(
-		angleCos, -angleSin, 0.f,
-		angleSin,  angleCos, 0.f);
-}
-
-/// Transposes the 2x2 submatrix.
-inline void Transpose(AFFINE2D &inout)
-{
-	std::swap(inout.b, inout.d);
-}
-
-void Lerp(AFFINE2D &out, const AFFINE2D &lhs, const AFFINE2D &rhs, float t);
-void Inverse(AFFINE2D &out, const AFFINE2D &aff);
-
-/** Transforms between AFFINE2D and MATRIX, where MATRIX looks like this:
-\verbatim
-| a d 0 0 |
-| b e 0 0 |
-| 0 0 1 0 |
-| c f 0 1 |
-\endverbatim
-*/
-void Affine2dToMatrix(MATRIX &out, const AFFINE2D &aff);
-/// \copydoc common::Affine2dToMatrix
-void MatrixToAffine2d(AFFINE2D &out, const MATRIX &m);
-
-//@}
-// math_affine2d
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-/** \addtogroup math_frustum Frustum */
-//@{
-
-struct FRUSTUM_PLANES;
-struct FRUSTUM_POINTS;
-
-/// Frustum opisany 6 paszczyznami z wektorami normalnymi zwrconymi do wewntrz.
-/**
-Podczas tworzenia:
-- Jeli WorldViewProj jest macierz Proj, otrzymane paszczyzny s we wsp. widoku.
-- Jeli WorldViewProj jest macierz View*Proj, otrzymane paszczyzny s we wsp. wiata.
-- Jeli WorldViewProj jest macierz World*View*Proj, otrzymane paszczyzny s we wsp. lokalnych obiektu.
-*/
-struct FRUSTUM_PLANES
-{
-	/** \name Indeksy do tablicy paszczyzn
-	Przedrostek PLANE_ jest, bo NEAR zostao gdzie zdefiniowane jako makro - grrrrr!
-	*/
-	//@{
-	static const size_t PLANE_LEFT   = 0;
-	static const size_t PLANE_RIGHT  = 1;
-	static const size_t PLANE_TOP    = 2;
-	static const size_t PLANE_BOTTOM = 3;
-	static const size_t PLANE_NEAR   = 4;
-	static const size_t PLANE_FAR    = 5;
-	//@}
-
-	PLANE Planes[6];
-
-	/// Tworzy niezainicjalizowany
-	FRUSTUM_PLANES() { }
-	/// Inicjalizuje na podstawie macierzy
-	FRUSTUM_PLANES(const MATRIX &WorldViewProj) { Set(WorldViewProj); }
-	/// Inicjalizuje na podstawie reprezentacji punktowej
-	FRUSTUM_PLANES(const FRUSTUM_POINTS &FrustumPoints) { Set(FrustumPoints); }
-	/// Wypenia
-	void Set(const MATRIX &WorldViewProj);
-	void Set(const FRUSTUM_POINTS &FrustumPoints);
-	/// Normalizuje paszczyzny
-	void Normalize();
-
-	PLANE & operator [] (size_t Index) { return Planes[Index]; }
-	const PLANE & operator [] (size_t Index) const { return Planes[Index]; }
-};
-
-/// Frustum zapisany jako 8 wierzchokw
-/**
-Uzyskiwanie przez konwersj macierzy ViewProj do FRUSTUM_PLANES i z niego
-do FRUSTUM_POINTS jest duo szybsze ni budowanie FRUSTUM_POINTS z macierzy
-ViewProjInv - 2 (Release) - 8 (Debug) razy szybsze!
-*/
-struct FRUSTUM_POINTS
-{
-	/** \name indeksy do tablicy punktw
-	Kolejno na przeciciu paszczyzn. */
-	//@{
-	static const size_t NEAR_LEFT_BOTTOM  = 0;
-	static const size_t NEAR_RIGHT_BOTTOM = 1;
-	static const size_t NEAR_LEFT_TOP     = 2;
-	static const size_t NEAR_RIGHT_TOP    = 3;
-	static const size_t FAR_LEFT_BOTTOM   = 4;
-	static const size_t FAR_RIGHT_BOTTOM  = 5;
-	static const size_t FAR_LEFT_TOP      = 6;
-	static const size_t FAR_RIGHT_TOP     = 7;
-	//@}
-
-	VEC3 Points[8];
-
-	/// Tworzy niezainicjalizowany
-	FRUSTUM_POINTS() { }
-	/// Inicjalizuje na podstawie paszczyzn
-	FRUSTUM_POINTS(const FRUSTUM_PLANES &FrustumPlanes) { Set(FrustumPlanes); }
-	/// Inicjalizuje na podstawie ODWROTNOCI macierzy View*Projection
-	FRUSTUM_POINTS(const MATRIX &WorldViewProjInv) { Set(WorldViewProjInv); }
-	/// Wypenia
-	void Set(const FRUSTUM_PLANES &FrustumPlanes);
-	void Set(const MATRIX &WorldViewProjInv);
-
-	VEC3 & operator [] (size_t Index) { return Points[Index]; }
-	const VEC3 & operator [] (size_t Index) const { return Points[Index]; }
-
-	/// Wylicza i zwraca rodek frustuma
-	void CalcCenter(VEC3 *Out) const;
-	/// Oblicza najmniejszy AABB otaczajcy frustum dany tymi punktami
-	void CalcBoundingBox(BOX *Box) const;
-	/// Oblicza sfer otaczajc frustum
-	/** Moe nie najlepsz, ale jaktam... (a moe to jest najlepsza? nie wiem :P) */
-	void CalcBoundingSphere(VEC3 *SphereCenter, float *SphereRadius) const;
-};
-
-/// Frustum - reprezentacja radarowa.
-/**
-- Bardzo szybki jest test kolizji z punktem i ze sfer (common::PointInFrustum,
-  common::SphereToFrustum).
-- UWAGA! Jako wektor Up podawa prawdziwy wektor kamery do gry, tzw. RealUp,
-  ktry jest naprawd wzajemnie prostopady do Forward i Right, a nie ten ktry
-  zawsze wynosi (0,1,0) - to by bd ktrego si naszukaem.
-*/
-class FRUSTUM_RADAR
-{
-private:
-	VEC3 m_Eye;
-	VEC3 m_Forward;
-	VEC3 m_Up;
-	VEC3 m_Right;
-	float m_RFactor;
-	float m_UFactor;
-	float m_RSphereFactor;
-	float m_USphereFactor;
-	float m_ZNear;
-	float m_ZFar;
-
-public:
-	/// Tworzy niezainicjalizowany
-	FRUSTUM_RADAR() { }
-	/// Tworzy w peni zainicjalizowany
-	FRUSTUM_RADAR(const VEC3 &Eye, const VEC3 &Forward, const VEC3 &Up, const VEC3 &Right, float FovY, float Aspect, float ZNear, float ZFar) { Set(Eye, Forward, Up, Right, FovY, Aspect, ZNear, ZFar); }
-
-	/** \name Pamitane pola
-	Zwraca poszczeglne pamitane pola (FovY i Aspect nie pamita bezporednio)
-	*/
-	//@{
-	const VEC3 & GetEye() const     { return m_Eye; }
-	const VEC3 & GetForward() const { return m_Forward; }
-	const VEC3 & GetUp() const      { return m_Up; }
-	const VEC3 & GetRight() const   { return m_Right; }
-	float GetZNear() const   { return m_ZNear; }
-	float GetZFar() const    { return m_ZFar; }
-	//@}
-
-	/** \name Dane pomocnicze
-	Zwraca dane pomocnicze
-	*/
-	//@{
-	float GetRFactor() const { return m_RFactor; }
-	float GetUFactor() const { return m_UFactor; }
-	float GetRSphereFactor() const { return m_RSphereFactor; }
-	float GetUSphereFactor() const { return m_USphereFactor; }
-	//@}
-
-	/** \name Ustawianie poszczeglnych pl */
-	//@{
-	void SetEye    (const VEC3 &Eye)     { m_Eye = Eye; }
-	void SetForward(const VEC3 &Forward) { m_Forward = Forward; }
-	void SetUp     (const VEC3 &Up)      { m_Up = Up; }
-	void SetRight  (const VEC3 &Right)   { m_Right = Right; }
-	void SetZNear(float ZNear) { m_ZNear = ZNear; }
-	void SetZFor (float ZFar)  { m_ZFar = ZFar; }
-	void SetFovAndAspect(float FovY, float Aspect);
-	//@}
-	
-	/// Kompletnie wypenia
-	void Set(const VEC3 &Eye, const VEC3 &Forward, const VEC3 &Up, const VEC3 &Right, float FovY, float Aspect, float ZNear, float ZFar) { SetProjection(FovY, Aspect, ZNear, ZFar); SetView(Eye, Forward, Up, Right); }
-	/// Wypenia jedn powk danych
-	void SetProjection(float FovY, float Aspect, float ZNear, float ZFar);
-	/// Wypenia drug powk danych
-	void SetView(const VEC3 &Eye, const VEC3 &Forward, const VEC3 &Up, const VEC3 &Right);
-};
-
-//@}
-// math_frustum
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-/** \addtogroup mathcapsule Kapsua */
-//@{
-
-/// Objto kapsuy
-float CapsuleVolume(const VEC3 &p1, const VEC3 &p2, float R);
-/// Losuje punkt z wntrza kapsuy. Rozkad rwnomierny.
-void RandomPointInCapsule(VEC3 *Out, const VEC3 &p1, const VEC3 &p2, float R, RandomGenerator &Rand);
-void RandomPointInCapsule(VEC3 *Out, const VEC3 &p1, const VEC3 &p2, float R);
-
-//@}
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-// INNE
-
-/** \addtogroup math_smoothcd Wygadzanie zmiennej
-Funkcja wygadzajca zmian zmiennej w czasie - SmoothCD.
-Nakadki na t funkcj - szablon specjalizowany dla: float, common::VEC2, common::VEC3.
-Klasa szablonowa enkapsulujca pamitanie parametrw wygadzania. */
-//@{
-
-template <typename T>
-inline void SmoothCD_T(T *InOutPos, const T &Dest, T *InOutVel, float SmoothTime, float TimeDelta)
-{
-	assert(0 && "SmoothCD_T for invalid template type.");
-}
-
-template <>
-inline void SmoothCD_T<float>(float *InOutPos, const float &Dest, float *InOutVel, float SmoothTime, float TimeDelta)
-{
-	SmoothCD(InOutPos, Dest, InOutVel, SmoothTime, TimeDelta);
-}
-
-template <>
-inline void SmoothCD_T<VEC2>(VEC2 *InOutPos, const VEC2 &Dest, VEC2 *InOutVel, float SmoothTime, float TimeDelta)
-{
-	SmoothCD(&InOutPos->x, Dest.x, &InOutVel->x, SmoothTime, TimeDelta);
-	SmoothCD(&InOutPos->y, Dest.y, &InOutVel->y, SmoothTime, TimeDelta);
-}
-
-template <>
-inline void SmoothCD_T<VEC3>(VEC3 *InOutPos, const VEC3 &Dest, VEC3 *InOutVel, float SmoothTime, float TimeDelta)
-{
-	SmoothCD(&InOutPos->x, Dest.x, &InOutVel->x, SmoothTime, TimeDelta);
-	SmoothCD(&InOutPos->y, Dest.y, &InOutVel->y, SmoothTime, TimeDelta);
-	SmoothCD(&InOutPos->z, Dest.z, &InOutVel->z, SmoothTime, TimeDelta);
-}
-
-template <typename T>
-class SmoothCD_obj
-{
-public:
-	T Pos;
-	T Dest; ///< Zapamitana ostatnia warto docelowa - moe si przyda.
-	T Vel;
-	float SmoothTime;
-
-	/// Tworzy niezainicjalizowany
-	SmoothCD_obj() { }
-	/// Tworzy zainicjalizowany
-	SmoothCD_obj(const T &Pos, float SmoothTime, const T &Vel) : Pos(Pos), Dest(Pos), Vel(Vel), SmoothTime(SmoothTime) { }
-	/// Ustawia parametry
-	void Set(const T &pos, const T &vel) { this->Pos = pos; this->Dest = pos; this->Vel = vel; }
-
-	/// Wykonuje krok czasowy
-	void Update(const T &dest, float timeDelta) {
-		this->Dest = dest;
-		SmoothCD_T<T>(&Pos, dest, &Vel, SmoothTime, timeDelta);
-	}
-};
-
-//@}
-// math_smoothcd
-
-
-/** \addtogroup math_spherical Wsprzdne sferyczne
-- Ukad kartezjaski: DirectX: X w prawo, Y w gr, Z w gb
-- Ukad sferyczny: Yaw to dugo geograficzna, Pitch to szeroko geograficzna, R to promie wodzcy
-*/
-//@{
-
-/// Tu mona podawa co si chce.
-void SphericalToCartesian(VEC3 *Out, float Yaw, float Pitch, float R);
-
-/**
-\param[out] Yaw
-  Wychodzi -PI..PI.
-  Mona poda NULL, jeli akurat nas nie interesuje - wtedy liczy szybciej.
-\param[out] Pitch
-  Wychodzi -PI/2..PI/2.
-  Mona poda NULL, jeli akurat nas nie interesuje - wtedy liczy szybciej.
-\param[out] R
-  Wychodzi > 0.
-  Mona poda NULL, jeli akurat nas nie interesuje - wtedy liczy szybciej.
-\param Pos
-  Nie podawa wektora zerowego bo wyjd buraki.
-*/
-void CartesianToSpherical(float *OutYaw, float *OutPitch, float *OutR, const VEC3 &Pos);
-
-//@}
-// math_spherical
-
-/// Zwraca wypuk otoczk zbioru punktw 2D.
-/**
-- Na wejciu musi by co najmniej jeden punkt.
-- Punkty bd uoone zgodnie z ruchem wskazwek zegara, jeli ukad jest X w prawo a Y w d.
-- Punkty powtarzajce si s chyba usuwane, tzn. wynik jest bez powtrze.
-- Punkty lece na prostej krawdzi raz pojawiaj si w wyniku a raz nie - niezdefiniowane.
-*/
-void ConvexHull2D(std::vector<VEC2> *OutPoints, const VEC2 InPoints[], size_t InPointCount);
-
-/**
-Macierz rotacji przeksztacajca wektory z przestrzeni Half-Life 2 do
-przestrzeni stycznej Tangent Space i jej transpozycja przeksztacajca
-z powrotem. To s macierz ortogonalne.
-\verbatim
-b0 = ( -1/sqrt(6), -1/sqrt(2), 1/sqrt(3) )
-b1 = ( -1/sqrt(6),  1/sqrt(2), 1/sqrt(3) )
-b2 = ( sqrt(2/3),   0,         1/sqrt(3) )
-\endverbatim
-*/
-extern const MATRIX HL2_TO_TANGENT_MATRIX;
-extern const MATRIX TANGENT_TO_HL2_MATRIX;
-/// Wektory bazowe HL2 Space wyraone w Tangent Space
-extern const VEC3 HL2_BASIS_VECTORS[3];
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-/** \addtogroup math_curves Curves */
-//@{
-
-/// Calculates value of Catmull-Rom curve at given point t = 0..1 between points b and c.
-/** Params a, b, c, d are four control points. \n
-Use types like float, VEC2, VEC3, VEC4 as T. */
-template <typename T>
-inline void EvalCatmullRomCurve(T *out, const T &a, const T &b, const T &c, const T &d, float t)
-{
-	float t2 = t * t;
-	float t3 = t2 * t;
-	*out = 0.5f * ( (2.f *b) + (c-a)*t + (2*a - 5*b + 4*c - d)*t2 + (3*b - 3*c + d - a)*t3 );
-}
-
-/// Evaluates tangent (not normalized) of Catmull-Rom curve at given point t = 0..1 between points b and c.
-/** Params a, b, c, d are four control points. \n
-Use types like float, VEC2, VEC3, VEC4 as T. */
-template <typename T>
-inline void EvalCatmullRomCurveDiff(T *out, const T &a, const T &b, const T &c, const T &d, float t)
-{
-	float t2 = t * t;
-	*out = 0.5f * ( (c - a) + 2.f*(a*2.f - b*5.f + c* 4.f - d)*t + 3.f*(a*-1.f + b*3.f -c*3.f + d)*t2 );
-}
-
-/// Calculates value of quadratic Bezier curve at given point t = 0..1 between points a and c.
-/** Param b is a control points of the curve. \n
-Use types like float, VEC2, VEC3, VEC4 as T. */
-template <typename T>
-inline void EvalQuadraticBezierCurve(T *out, const T &a, const T &b, const T &c, float t)
-{
-	float t_inv = 1.f - t;
-	*out = t_inv*t_inv*a + 2.f*t*t_inv*b + t*t*c;
-}
-
-/// Calculates value of cubic Bezier curve at given point t = 0..1 between points a and d.
-/** Params b, c are control points of the curve. \n
-Use types like float, VEC2, VEC3, VEC4 as T. */
-template <typename T>
-inline void EvalCubicBezierCurve(T *out, const T &a, const T &b, const T &c, const T &d, float t)
-{
-	float t2=t*t;
-	float t3=t2*t;
-	float v=1-t;
-	float v2=v*v;
-	float v3=v2*v;
-	*out = a*v3 + b*3.f*v2*t + c*3.f*v*t2 + d*t3; 
-}
-
-/// Evaluates tangent (not normalized) of cubic Bezier curve at given point t = 0..1 between points a and d.
-/** Params b, c are control points of the curve. \n
-Use types like float, VEC2, VEC3, VEC4 as T. */
-template <typename T>
-inline void EvalCubicBezierCurveDiff(T *out, const T &a, const T &b, const T &c, const T &d, float t)
-{
-	float tinv = 1.f - t;
-	float tinvpow2 = tinv * tinv;
-	float upow2 = t * t;
-	float ta = 3.f * tinvpow2;
-	float tb = 6.f * tinv * t;
-	float tc = 3.f * upow2;
-	/*float c0 = -ta;
-	float c1 = ta - tb;
-	float c2 = tb - tc;
-	float c3 = tc;*/ // WTF?! These values never used. Wai it supposed to be this way?
-	*out = b*(ta-tb) + c*(tb-tc) + d*tc - a*ta;
-}
-
-/// Splits cubic Bezier curve in the middle (at t=0.5) into two cubic Bezier curves.
-/** a, b, c, d are points of the input curve. \n
-out1[0], out1[1], out1[2], out1[3] will be points of the first output curve. \n
-out2[0], out2[1], out2[2], out2[3] will be points of the second output curve.
-Use types like float, VEC2, VEC3, VEC4 as T. */
-template <typename T>
-inline void SplitCubicBezierCurve(T out1[4], T out2[4], const T &a, const T &b, const T &c, const T &d)
-{
-	out1[0] = a;
-	out1[1] = a*0.5f   + b*0.5f;
-	out1[2] = a*0.25f  + b*0.5f   + c*0.25f;
-	out1[3] = a*0.125f + b*0.375f + c*0.375f + d*0.125f;
-	out2[3] = d;
-	out2[2] = d*0.5f   + c*0.5f;
-	out2[1] = d*0.25f  + c*0.5f   + b*0.25f;
-	out2[0] = d*0.125f + c*0.375f + b*0.375f + a*0.125f;
-}
-
-/// Splits cubic Bezier curve in the given point (at parameter t) into two cubic Bezier curves.
-/** a, b, c, d are points of the input curve. \n
-out1[0], out1[1], out1[2], out1[3] will be points of the first output curve. \n
-out2[0], out2[1], out2[2], out2[3] will be points of the second output curve.
-Use types like float, VEC2, VEC3, VEC4 as T. */
-template <typename T>
-inline void SplitCubicBezierCurve(T out1[4], T out2[4], const T &a, const T &b, const T &c, const T &d, float t)
-{
-	T p01 = a + (b - a) * t;
-	T p12 = b + (c - b) * t;
-	T p23 = c + (d - c) * t;
-	T pa = p01 + (p12 - p01) * t;
-	T pb = p12 + (p23 - p12) * t;
-	T pc = pa + (pb - pa) * t;
-	out1[0] = a;  out1[1] = p01; out1[2] = pa;  out1[3] = pc;
-	out2[0] = pc; out2[1] = pb;  out2[2] = p23; out2[3] = d;
-}
-
-template <typename T>
-class CubicBezierCurveIntegral
-{
-public:
-	void Setup(const T &a, const T &b, const T &c, const T &d, const T &zero)
-	{
-		m_Data[0] = zero;
-		m_Data[1] = a * 0.25f;
-		m_Data[2] = (a + b) * 0.25f;
-		m_Data[3] = (a + b + c) * 0.25f;
-		m_Data[4] = (a + b + c + d) * 0.25f;
-	}
-
-	void Calc(T *out, float t)
-	{
-		float t2 = t * t;
-		float t3 = t2 * t;
-		float t4 = t3 * t;
-
-		float inv_t = 1.0f - t;
-		float inv_t2 = inv_t * inv_t;
-		float inv_t3 = inv_t2 * inv_t;
-		float inv_t4 = inv_t3 * inv_t;
-
-		*out = m_Data[0]*inv_t4 + m_Data[1]*4*inv_t3*t + m_Data[2]*6*inv_t2*t2 + m_Data[3]*4*inv_t*t3 + m_Data[4]*t4;
-	}
-
-private:
-	T m_Data[5];
-};
-
-float CalcCubicBezierCurveLength(const VEC3 &a, const VEC3 &b, const VEC3 &c, const VEC3 &d, float t1, float t2);
-float GetCubicBezierCurveArcLengthParam(const VEC3 &a, const VEC3 &b, const VEC3 &c, const VEC3 &d, float len, float epsilon);
-/// Calculates Y value and T parameter of cubic Bezier curve intersected with axis-aligned line x.
-bool IntersectCubicBezierCurve2DWithX(const VEC2 curve[4], float x, float eps, float *outY, float *outT, float t0 = 0.f, float t1 = 1.f);
-
-//@}
-// math_curves
-
-
-/** \addtogroup math_comp Comparisons
-*/
-//@{
-
-template <typename Comp> inline bool PointAllCmp(const POINT_ &lhs, const POINT_ &rhs) { Comp compObj; return compObj(lhs.x, rhs.x) && compObj(lhs.y, rhs.y); }
-template <typename Comp> inline bool Vec2AllCmp(const VEC2 &lhs, const VEC2 &rhs) { Comp compObj; return compObj(lhs.x, rhs.x) && compObj(lhs.y, rhs.y); }
-template <typename Comp> inline bool Vec3AllCmp(const VEC3 &lhs, const VEC3 &rhs) { Comp compObj; return compObj(lhs.x, rhs.x) && compObj(lhs.y, rhs.y) && compObj(lhs.z, rhs.z); }
-template <typename Comp> inline bool Vec4AllCmp(const VEC4 &lhs, const VEC4 &rhs) { Comp compObj; return compObj(lhs.x, rhs.x) && compObj(lhs.y, rhs.y) && compObj(lhs.z, rhs.z) && compObj(lhs.w, rhs.w); }
-template <typename Comp> inline bool ColorfAllCmp(const COLORF &lhs, const COLORF &rhs) { Comp compObj; return compObj(lhs.R, rhs.R) && compObj(lhs.G, rhs.G) && compObj(lhs.B, rhs.B) && compObj(lhs.A, rhs.A); }
-template <typename Comp> inline bool ColorAllCmp(COLOR lhs, COLOR rhs) { Comp compObj; return compObj(lhs.R, rhs.R) && compObj(lhs.G, rhs.G) && compObj(lhs.B, rhs.B) && compObj(lhs.A, rhs.A); }
-template <typename Comp> inline bool MatrixAllCmp(const MATRIX &lhs, const MATRIX &rhs)
-{
-	Comp compObj;
-	return compObj(lhs._11, rhs._11) && compObj(lhs._12, rhs._12) && compObj(lhs._13, rhs._13) && compObj(lhs._14, rhs._14)
-		&& compObj(lhs._21, rhs._21) && compObj(lhs._22, rhs._22) && compObj(lhs._23, rhs._23) && compObj(lhs._24, rhs._24)
-		&& compObj(lhs._31, rhs._31) && compObj(lhs._32, rhs._32) && compObj(lhs._33, rhs._33) && compObj(lhs._34, rhs._34)
-		&& compObj(lhs._41, rhs._41) && compObj(lhs._42, rhs._42) && compObj(lhs._43, rhs._43) && compObj(lhs._44, rhs._44);
-}
-
-template <typename Comp> inline bool PointAnyCmp(const POINT_ &lhs, const POINT_ &rhs) { Comp compObj; return compObj(lhs.x, rhs.x) || compObj(lhs.y, rhs.y); }
-template <typename Comp> inline bool Vec2AnyCmp(const VEC2 &lhs, const VEC2 &rhs) { Comp compObj; return compObj(lhs.x, rhs.x) || compObj(lhs.y, rhs.y); }
-template <typename Comp> inline bool Vec3AnyCmp(const VEC3 &lhs, const VEC3 &rhs) { Comp compObj; return compObj(lhs.x, rhs.x) || compObj(lhs.y, rhs.y) || compObj(lhs.z, rhs.z); }
-template <typename Comp> inline bool Vec4AnyCmp(const VEC4 &lhs, const VEC4 &rhs) { Comp compObj; return compObj(lhs.x, rhs.x) || compObj(lhs.y, rhs.y) || compObj(lhs.z, rhs.z) || compObj(lhs.w, rhs.w); }
-template <typename Comp> inline bool ColorfAnyCmp(const COLORF &lhs, const COLORF &rhs) { Comp compObj; return compObj(lhs.R, rhs.R) || compObj(lhs.G, rhs.G) || compObj(lhs.B, rhs.B) || compObj(lhs.A, rhs.A); }
-template <typename Comp> inline bool ColorAnyCmp(COLOR lhs, COLOR rhs) { Comp compObj; return compObj(lhs.R, rhs.R) || compObj(lhs.G, rhs.G) || compObj(lhs.B, rhs.B) || compObj(lhs.A, rhs.A); }
-template <typename Comp> inline bool MatrixAnyCmp(const MATRIX &lhs, const MATRIX &rhs)
-{
-	Comp compObj;
-	return compObj(lhs._11, rhs._11) || compObj(lhs._12, rhs._12) || compObj(lhs._13, rhs._13) || compObj(lhs._14, rhs._14)
-		|| compObj(lhs._21, rhs._21) || compObj(lhs._22, rhs._22) || compObj(lhs._23, rhs._23) || compObj(lhs._24, rhs._24)
-		|| compObj(lhs._31, rhs._31) || compObj(lhs._32, rhs._32) || compObj(lhs._33, rhs._33) || compObj(lhs._34, rhs._34)
-		|| compObj(lhs._41, rhs._41) || compObj(lhs._42, rhs._42) || compObj(lhs._43, rhs._43) || compObj(lhs._44, rhs._44);
-}
-
-inline bool AllGreater(const POINT_ &lhs, const POINT_ &rhs) { return PointAllCmp< std::greater<int> >(lhs, rhs); }
-inline bool AllGreater(const VEC2 &lhs, const VEC2 &rhs) { return Vec2AllCmp< std::greater<float> >(lhs, rhs); }
-inline bool AllGreater(const VEC3 &lhs, const VEC3 &rhs) { return Vec3AllCmp< std::greater<float> >(lhs, rhs); }
-inline bool AllGreater(const VEC4 &lhs, const VEC4 &rhs) { return Vec4AllCmp< std::greater<float> >(lhs, rhs); }
-inline bool AllGreater(const COLORF &lhs, const COLORF &rhs) { return ColorfAllCmp< std::greater<float> >(lhs, rhs); }
-inline bool AllGreater(COLOR lhs, COLOR rhs) { return ColorAllCmp< std::greater<uint8> >(lhs, rhs); }
-inline bool AllGreater(const MATRIX &lhs, const MATRIX &rhs) { return MatrixAllCmp< std::greater<float> >(lhs, rhs); }
-
-inline bool AllGreaterEqual(const POINT_ &lhs, const POINT_ &rhs) { return PointAllCmp< std::greater_equal<int> >(lhs, rhs); }
-inline bool AllGreaterEqual(const VEC2 &lhs, const VEC2 &rhs) { return Vec2AllCmp< std::greater_equal<float> >(lhs, rhs); }
-inline bool AllGreaterEqual(const VEC3 &lhs, const VEC3 &rhs) { return Vec3AllCmp< std::greater_equal<float> >(lhs, rhs); }
-inline bool AllGreaterEqual(const VEC4 &lhs, const VEC4 &rhs) { return Vec4AllCmp< std::greater_equal<float> >(lhs, rhs); }
-inline bool AllGreaterEqual(const COLORF &lhs, const COLORF &rhs) { return ColorfAllCmp< std::greater_equal<float> >(lhs, rhs); }
-inline bool AllGreaterEqual(COLOR lhs, COLOR rhs) { return ColorAllCmp< std::greater_equal<uint8> >(lhs, rhs); }
-inline bool AllGreaterEqual(const MATRIX &lhs, const MATRIX &rhs) { return MatrixAllCmp< std::greater_equal<float> >(lhs, rhs); }
-
-inline bool AllLess(const POINT_ &lhs, const POINT_ &rhs) { return PointAllCmp< std::less<int> >(lhs, rhs); }
-inline bool AllLess(const VEC2 &lhs, const VEC2 &rhs) { return Vec2AllCmp< std::less<float> >(lhs, rhs); }
-inline bool AllLess(const VEC3 &lhs, const VEC3 &rhs) { return Vec3AllCmp< std::less<float> >(lhs, rhs); }
-inline bool AllLess(const VEC4 &lhs, const VEC4 &rhs) { return Vec4AllCmp< std::less<float> >(lhs, rhs); }
-inline bool AllLess(const COLORF &lhs, const COLORF &rhs) { return ColorfAllCmp< std::less<float> >(lhs, rhs); }
-inline bool AllLess(COLOR lhs, COLOR rhs) { return ColorAllCmp< std::less<uint8> >(lhs, rhs); }
-inline bool AllLess(const MATRIX &lhs, const MATRIX &rhs) { return MatrixAllCmp< std::less<float> >(lhs, rhs); }
-
-inline bool AllLessEqual(const POINT_ &lhs, const POINT_ &rhs) { return PointAllCmp< std::less_equal<int> >(lhs, rhs); }
-inline bool AllLessEqual(const VEC2 &lhs, const VEC2 &rhs) { return Vec2AllCmp< std::less_equal<float> >(lhs, rhs); }
-inline bool AllLessEqual(const VEC3 &lhs, const VEC3 &rhs) { return Vec3AllCmp< std::less_equal<float> >(lhs, rhs); }
-inline bool AllLessEqual(const VEC4 &lhs, const VEC4 &rhs) { return Vec4AllCmp< std::less_equal<float> >(lhs, rhs); }
-inline bool AllLessEqual(const COLORF &lhs, const COLORF &rhs) { return ColorfAllCmp< std::less_equal<float> >(lhs, rhs); }
-inline bool AllLessEqual(COLOR lhs, COLOR rhs) { return ColorAllCmp< std::less_equal<uint8> >(lhs, rhs); }
-inline bool AllLessEqual(const MATRIX &lhs, const MATRIX &rhs) { return MatrixAllCmp< std::less_equal<float> >(lhs, rhs); }
-
-inline bool AllEqual(const POINT_ &lhs, const POINT_ &rhs) { return PointAllCmp< std::equal_to<int> >(lhs, rhs); }
-inline bool AllEqual(const VEC2 &lhs, const VEC2 &rhs) { return Vec2AllCmp< std::equal_to<float> >(lhs, rhs); }
-inline bool AllEqual(const VEC3 &lhs, const VEC3 &rhs) { return Vec3AllCmp< std::equal_to<float> >(lhs, rhs); }
-inline bool AllEqual(const VEC4 &lhs, const VEC4 &rhs) { return Vec4AllCmp< std::equal_to<float> >(lhs, rhs); }
-inline bool AllEqual(const COLORF &lhs, const COLORF &rhs) { return ColorfAllCmp< std::equal_to<float> >(lhs, rhs); }
-inline bool AllEqual(COLOR lhs, COLOR rhs) { return ColorAllCmp< std::equal_to<uint8> >(lhs, rhs); }
-inline bool AllEqual(const MATRIX &lhs, const MATRIX &rhs) { return MatrixAllCmp< std::equal_to<float> >(lhs, rhs); }
-
-inline bool AllNotEqual(const POINT_ &lhs, const POINT_ &rhs) { return PointAllCmp< std::not_equal_to<int> >(lhs, rhs); }
-inline bool AllNotEqual(const VEC2 &lhs, const VEC2 &rhs) { return Vec2AllCmp< std::not_equal_to<float> >(lhs, rhs); }
-inline bool AllNotEqual(const VEC3 &lhs, const VEC3 &rhs) { return Vec3AllCmp< std::not_equal_to<float> >(lhs, rhs); }
-inline bool AllNotEqual(const VEC4 &lhs, const VEC4 &rhs) { return Vec4AllCmp< std::not_equal_to<float> >(lhs, rhs); }
-inline bool AllNotEqual(const COLORF &lhs, const COLORF &rhs) { return ColorfAllCmp< std::not_equal_to<float> >(lhs, rhs); }
-inline bool AllNotEqual(COLOR lhs, COLOR rhs) { return ColorAllCmp< std::not_equal_to<uint8> >(lhs, rhs); }
-inline bool AllNotEqual(const MATRIX &lhs, const MATRIX &rhs) { return MatrixAllCmp< std::not_equal_to<float> >(lhs, rhs); }
-
-inline bool AnyGreater(const POINT_ &lhs, const POINT_ &rhs) { return PointAnyCmp< std::greater<int> >(lhs, rhs); }
-inline bool AnyGreater(const VEC2 &lhs, const VEC2 &rhs) { return Vec2AnyCmp< std::greater<float> >(lhs, rhs); }
-inline bool AnyGreater(const VEC3 &lhs, const VEC3 &rhs) { return Vec3AnyCmp< std::greater<float> >(lhs, rhs); }
-inline bool AnyGreater(const VEC4 &lhs, const VEC4 &rhs) { return Vec4AnyCmp< std::greater<float> >(lhs, rhs); }
-inline bool AnyGreater(const COLORF &lhs, const COLORF &rhs) { return ColorfAnyCmp< std::greater<float> >(lhs, rhs); }
-inline bool AnyGreater(COLOR lhs, COLOR rhs) { return ColorAnyCmp< std::greater<uint8> >(lhs, rhs); }
-inline bool AnyGreater(const MATRIX &lhs, const MATRIX &rhs) { return MatrixAnyCmp< std::greater<float> >(lhs, rhs); }
-
-inline bool AnyGreaterEqual(const POINT_ &lhs, const POINT_ &rhs) { return PointAnyCmp< std::greater_equal<int> >(lhs, rhs); }
-inline bool AnyGreaterEqual(const VEC2 &lhs, const VEC2 &rhs) { return Vec2AnyCmp< std::greater_equal<float> >(lhs, rhs); }
-inline bool AnyGreaterEqual(const VEC3 &lhs, const VEC3 &rhs) { return Vec3AnyCmp< std::greater_equal<float> >(lhs, rhs); }
-inline bool AnyGreaterEqual(const VEC4 &lhs, const VEC4 &rhs) { return Vec4AnyCmp< std::greater_equal<float> >(lhs, rhs); }
-inline bool AnyGreaterEqual(const COLORF &lhs, const COLORF &rhs) { return ColorfAnyCmp< std::greater_equal<float> >(lhs, rhs); }
-inline bool AnyGreaterEqual(COLOR lhs, COLOR rhs) { return ColorAnyCmp< std::greater_equal<uint8> >(lhs, rhs); }
-inline bool AnyGreaterEqual(const MATRIX &lhs, const MATRIX &rhs) { return MatrixAnyCmp< std::greater_equal<float> >(lhs, rhs); }
-
-inline bool AnyLess(const POINT_ &lhs, const POINT_ &rhs) { return PointAnyCmp< std::less<int> >(lhs, rhs); }
-inline bool AnyLess(const VEC2 &lhs, const VEC2 &rhs) { return Vec2AnyCmp< std::less<float> >(lhs, rhs); }
-inline bool AnyLess(const VEC3 &lhs, const VEC3 &rhs) { return Vec3AnyCmp< std::less<float> >(lhs, rhs); }
-inline bool AnyLess(const VEC4 &lhs, const VEC4 &rhs) { return Vec4AnyCmp< std::less<float> >(lhs, rhs); }
-inline bool AnyLess(const COLORF &lhs, const COLORF &rhs) { return ColorfAnyCmp< std::less<float> >(lhs, rhs); }
-inline bool AnyLess(COLOR lhs, COLOR rhs) { return ColorAnyCmp< std::less<uint8> >(lhs, rhs); }
-inline bool AnyLess(const MATRIX &lhs, const MATRIX &rhs) { return MatrixAnyCmp< std::less<float> >(lhs, rhs); }
-
-inline bool AnyLessEqual(const POINT_ &lhs, const POINT_ &rhs) { return PointAnyCmp< std::less_equal<int> >(lhs, rhs); }
-inline bool AnyLessEqual(const VEC2 &lhs, const VEC2 &rhs) { return Vec2AnyCmp< std::less_equal<float> >(lhs, rhs); }
-inline bool AnyLessEqual(const VEC3 &lhs, const VEC3 &rhs) { return Vec3AnyCmp< std::less_equal<float> >(lhs, rhs); }
-inline bool AnyLessEqual(const VEC4 &lhs, const VEC4 &rhs) { return Vec4AnyCmp< std::less_equal<float> >(lhs, rhs); }
-inline bool AnyLessEqual(const COLORF &lhs, const COLORF &rhs) { return ColorfAnyCmp< std::less_equal<float> >(lhs, rhs); }
-inline bool AnyLessEqual(COLOR lhs, COLOR rhs) { return ColorAnyCmp< std::less_equal<uint8> >(lhs, rhs); }
-inline bool AnyLessEqual(const MATRIX &lhs, const MATRIX &rhs) { return MatrixAnyCmp< std::less_equal<float> >(lhs, rhs); }
-
-inline bool AnyEqual(const POINT_ &lhs, const POINT_ &rhs) { return PointAnyCmp< std::equal_to<int> >(lhs, rhs); }
-inline bool AnyEqual(const VEC2 &lhs, const VEC2 &rhs) { return Vec2AnyCmp< std::equal_to<float> >(lhs, rhs); }
-inline bool AnyEqual(const VEC3 &lhs, const VEC3 &rhs) { return Vec3AnyCmp< std::equal_to<float> >(lhs, rhs); }
-inline bool AnyEqual(const VEC4 &lhs, const VEC4 &rhs) { return Vec4AnyCmp< std::equal_to<float> >(lhs, rhs); }
-inline bool AnyEqual(const COLORF &lhs, const COLORF &rhs) { return ColorfAnyCmp< std::equal_to<float> >(lhs, rhs); }
-inline bool AnyEqual(COLOR lhs, COLOR rhs) { return ColorAnyCmp< std::equal_to<uint8> >(lhs, rhs); }
-inline bool AnyEqual(const MATRIX &lhs, const MATRIX &rhs) { return MatrixAnyCmp< std::equal_to<float> >(lhs, rhs); }
-
-inline bool AnyNotEqual(const POINT_ &lhs, const POINT_ &rhs) { return PointAnyCmp< std::not_equal_to<int> >(lhs, rhs); }
-inline bool AnyNotEqual(const VEC2 &lhs, const VEC2 &rhs) { return Vec2AnyCmp< std::not_equal_to<float> >(lhs, rhs); }
-inline bool AnyNotEqual(const VEC3 &lhs, const VEC3 &rhs) { return Vec3AnyCmp< std::not_equal_to<float> >(lhs, rhs); }
-inline bool AnyNotEqual(const VEC4 &lhs, const VEC4 &rhs) { return Vec4AnyCmp< std::not_equal_to<float> >(lhs, rhs); }
-inline bool AnyNotEqual(const COLORF &lhs, const COLORF &rhs) { return ColorfAnyCmp< std::not_equal_to<float> >(lhs, rhs); }
-inline bool AnyNotEqual(COLOR lhs, COLOR rhs) { return ColorAnyCmp< std::not_equal_to<uint8> >(lhs, rhs); }
-inline bool AnyNotEqual(const MATRIX &lhs, const MATRIX &rhs) { return MatrixAnyCmp< std::not_equal_to<float> >(lhs, rhs); }
-
-//@}
-// math_vec_comp
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-/** \addtogroup math_collisions Kolizje */
-//@{
-
-/// Funkcja wielofunkcyjna
-/**
-- Wynik > 0 - punkt c ley na lewo od skierowanego odcinka a-b.
-  Trjkt abc jest skierowany przeciwnie do ruchu wskazwek zegara.
-- Wynik < 0 - punkt c ley na prawo od skierowanego odcinka a-b.
-  Trjkt abc jest skierowany zgodnie z ruchem wskazwek zegara.
-- Wynik = 0 - podane trzy punkty le w jednej linii.
-- abs(Wynik) - podwojona powierzchnia trjta abc.
-*/
-float Orient2D(const VEC2 &a, const VEC2 &b, const VEC2 &c);
-/// Funkcja wielofunkcyjna
-/**
-- Wynik < 0 - punkt d ley nad paszczyzn definiowan przez trjkt abc,
-  widzian tak e ten trjkt jest zorientowany przeciwnie do ruchu wskazwek
-  zegara.
-- Wynik > 0 - punkt d ley pod paszczyzn definiowan przez trjkt abc,
-  widzian tak e ten trjkt jest zorientowany przeciwnie do ruchu wskazwek
-  zegara.
-- Wynik = 0 - wszystkie cztery punkty le w jednej paszczynie.
-- abs(Wynik) - szeciokrotna objto czworocianu tworzonego przez punkty abcd.
-*/
-float Orient3D(const VEC3 &a, const VEC3 &b, const VEC3 &c, const VEC3 &d);
-
-inline bool PointInCircle(const VEC2 &pt, const VEC2 &circleCenter, float circleRadius)
-{
-	return DistanceSq(pt, circleCenter) <= sqr(circleRadius);
-}
-/// Zwraca true, jeli punkt p naley do trjkta abc
-bool PointInTriangle(const VEC2 &p, const VEC2 &a, const VEC2 &b, const VEC2 &c);
-/// Zwraca true, jeli podany czworokt jest wypuky.
-/** Nie testowana, moe le dziaa dla zdegenerowanych - TODO. */
-bool IsQuadConvex(const VEC2 &a, const VEC2 &b, const VEC2 &c, const VEC2 &d);
-/// Zwraca true, jeli podany czworokt jest wypuky (nie zdegenerowany, nie wklsy, nie samoprzecinajcy si).
-/** Wszystkie cztery wierzchoki musz lee w jednej paszczynie. */
-bool IsQuadConvex(const VEC3 &a, const VEC3 &b, const VEC3 &c, const VEC3 &d);
-/// Dany punkt p i promie (RayOrig, RayDir), oblicza parametr t dla punktu na tym promieniu bdcego rzutem tego punktu na ten promie.
-/** W ten sposb mona obliczy rzut punktu na promie (punkt z promienia najbliszy
-danemu punktowi) jako RayOrig + RayDir*t. Mona te policzy najbliszy punkt
-na pprostej lub odcinku limitujc najpierw t od 0 do 1 czy od 0 do dlugoci odcinka.
-UWAGA! Jeli RayDir nie jest jednostkowy, wynik trzeba podzieli przez LengthSq(RayDir). */
-float ClosestPointOnLine(const VEC3 &p, const VEC3 &RayOrig, const VEC3 &RayDir);
-/// Oblicza najblisze sobie punkty na dwch odcinkach
-/** Dane s dwa odcinki: Seg1_Beg..Seg1_End i Seg2_Beg..Seg2_End.
-Funkcja oblicza najblisze sobie punkty na tych odcinkach.
-Parametry do tych odcinkw zwraca przez OutSeg1_t, OutSeg2_t.
-Te punkty zwraca przez OutSeg1_pt, OutSeg2_pt.
-Caa funkcja zwraca kwadrat odlegoci midzy tymi punktami.
-*/
-float ClosestPointSegmentSegment(
-	const VEC3 &Seg1_Beg, const VEC3 &Seg1_End, const VEC3 &Seg2_Beg, const VEC3 &Seg2_End,
-	float &OutSeg1_t, float &OutSeg2_t, VEC3 &OutSeg1_pt, VEC3 &OutSeg2_pt);
-/// Zwraca kwadrat odlegoci punktu od prostej
-/** \param LineDir   musi by znormalizowane! */
-float PointToLineDistance(const VEC3 &P, const VEC3 &LineOrig, const VEC3 &LineDir);
-/// Zwraca kwadrat odlegoci punktu od odcinka
-float PointToSegmentDistanceSq(const VEC2 &p, const VEC2 &segment_p1, const VEC2 &segment_p2);
-/// Zwraca kwadrat odlegoci punktu od odcinka
-float PointToSegmentDistanceSq(const VEC3 &p, const VEC3 &segment_p1, const VEC3 &segment_p2);
-/// Zwraca true, jeli punkt ley na prostej
-/** \param LineDir   musi by znormalizowane! */
-bool PointOnLine(const VEC3 &P, const VEC3 &LineOrig, const VEC3 &LineDir);
-/// Zwraca parametr T punktu lecego na prostej
-/** \param P   Punkt musi naprawd lee na tej prostej! */
-float PointToLine(const VEC3 &P, const VEC3 &LineOrig, const VEC3 &LineDir);
-/// Zwraca true, jeli punkt ley na odcinku.
-/** \param P   Punkt musi lee na prostej przechodzcej przez ten odcinek! */
-bool PointInLineSegment(const VEC3 &P, const VEC3 &SegmentBeg, const VEC3 &SegmentEnd);
-/// Wyznacza najbliszy punkt lecy na odcinku p1-p2 wzgldem punktu p
-/** \param Out [out] Mona poda NULL.
-\return Zwraca parametr t dla odcinka, wyraony w dugociach odcinka. */
-float ClosestPointOnSegment(VEC2 *Out, const VEC2 &p, const VEC2 &p1, const VEC2 &p2);
-float ClosestPointOnSegment(VEC3 *Out, const VEC3 &p, const VEC3 &p1, const VEC3 &p2);
-/// Wyznacza najbliszy punkt lecy na pprostej wzgldem punktu p
-/** \param Out [out] Mona poda NULL.
-\return Zwraca parametr t dla pprostej, wyraony w dugociach odcinka. */
-float ClosestPointOnRay(VEC2 *Out, const VEC2 &p, const VEC2 &RayOrig, const VEC2 &RayDir);
-float ClosestPointOnRay(VEC3 *Out, const VEC3 &p, const VEC3 &RayOrig, const VEC3 &RayDir);
-/// Wyznacza najbliszy punkt wewntrz prostopadocianu wzgldem punktu p.
-/** Jeli p ley wewntrz tego prostopadocianu, zwrcone zostaje dokadnie p. */
-void ClosestPointInBox(VEC3 *Out, const BOX &Box, const VEC3 &p);
-/// Znajduje punkt OutPoint nalecy do podanego OBB, najbliszy do punktu Point.
-void ClosestPointInObb(VEC3 *OutPoint, const VEC3 &Point, const OBB &Obb);
-/// Znajduje punkt OutPoint nalecy do podanego prostokta 3D, najbliszy do punktu Point.
-void ClosestPointInRect3d(VEC3 *OutPoint, const VEC3 &Point, const RECT3D &Rect3d);
-/// Znajduje punkt OutPoint nalecy do podanego prostokta 3D wyznaczonego przez trzy wierzchoki: a, b, c, najbliszy do punktu Point.
-void ClosestPointInRect3d(VEC3 *OutPoint, const VEC3 &p, const VEC3 &a, const VEC3 &b, const VEC3 &c);
-/// Znajduje punkt OutPoint nalecy do trjkta (a, b, c) najbliszy do punktu p
-void ClosestPointInTriangle(VEC3 *OutPoint, const VEC3 &p, const VEC3 &a, const VEC3 &b, const VEC3 &c);
-/// \copydoc ClosestPointInRect3d(VEC3*, const VEC3&, const VEC3&, const VEC3&, const VEC3&)
-void ClosestPointInTriangle(VEC2 *out, const VEC2 &pt, const VEC2 &triA, const VEC2 &triB, const VEC2 &triC);
-/// Znajduje punkt OutPoint nalecy do podanego czworocianu wyznaczonego przez wierzchoki: a, b, c, d, najbliszy do punktu p.
-void ClosestPointInTetrahedron(VEC3 *OutPoint, const VEC3 &p, const VEC3 &a, const VEC3 &b, const VEC3 &c, const VEC3 &d);
-/// Returns squared distance from point to rectangle. Returns 0 if point inside rectangle.
-float PointToRectDistanceSq(const VEC2 &p, const RECTF &rect);
-float PointToRectManhattanDistance(const VEC2 &p, const RECTF &rect);
-float PointToRectMaxDistance(const VEC2 &p, const RECTF &rect);
-/// Kwadrat odlegoci punktu od prostopadocianu
-/** Jeli p ley wewntrz tego prostopadocianu, zwraca 0. */
-float PointToBoxDistanceSq(const VEC3 &p, const BOX &box);
-float PointToBoxManhattanDistance(const VEC3 &p, const BOX &box);
-float PointToBoxMaxDistance(const VEC3 &p, const BOX &box);
-/// Returns squared distance between two rectangles. Returns 0 if given rectangles overlap.
-float RectToRectDistanceSq(const RECTF &rect1, const RECTF &rect2);
-float RectToRectManhattanDistance(const RECTF &rect1, const RECTF &rect2);
-float RectToRectMaxDistance(const RECTF &rect1, const RECTF &rect2);
-/// Returns squared distance between two axis-aligned boxes. Returns 0 if given boxes overlap.
-float BoxToBoxDistanceSq(const BOX &box1, const BOX &box2);
-float BoxToBoxManhattanDistance(const BOX &box1, const BOX &box2);
-float BoxToBoxMaxDistance(const BOX &box1, const BOX &box2);
-/// Kwadrat odlegoci punktu od OBB.
-float PointToObbDistanceSq(const VEC3 &Point, const OBB &Obb);
-bool CircleToRect(const VEC2 &circleCenter, float circleRadius, const RECTF &rect);
-/// Zwraca true, jeli podany punkt naley do sfery
-bool PointInSphere(const VEC3 &p, const VEC3 &SphereCenter, float SphereRadius);
-/// Zwraca odlego punktu od powierzchni sfery
-/** Jeli punkt ley wewntrz sfery, zwrci odlego ujemn. */
-float PointToSphereDistance(const VEC3 &p, const VEC3 &SphereCenter, float SphereRadius);
-/// Wyznacza najbliszy punkt na powierzchni sfery wzgldem punktu p.
-/** Punkt moe by wewntrz sfery - te jest OK, zwrci z powierzchni sfery.
-Punkt nie moe by dokadnie na rodku sfery - wtedy jest dzielenie przez zero. */
-void ClosestPointOnSphere(VEC3 *Out, const VEC3 &SphereCenter, float SphereRadius, const VEC3 &p);
-/// Zwraca true, jeli podany punkt naley do paszczyzny
-/** Paszczyzna nie musi by znormalizowana. */
-bool PointOnPlane(const VEC3 &p, const PLANE &plane);
-/// Wyznacza najbliszy punkt na paszczynie wzgldem punktu p.
-/** Paszczyzna musi by znormalizowana. */
-void ClosestPointOnPlane(VEC3 *Out, const PLANE &Plane, const VEC3 &p);
-/// Zwraca true, jeli punkt naley do trjkta
-bool PointInTriangle(const VEC3 &point, const VEC3 &pa, const VEC3 &pb, const VEC3 &pc);
-/// Zwraca true, jeli punkt naley do wntrza podanego frustuma
-bool PointInFrustum(const VEC3 &p, const FRUSTUM_PLANES &Frustum);
-bool PointInFrustum(const VEC3 &p, const FRUSTUM_RADAR &Frustum);
-/// Funkcja wyznacza parametry t1 i t2 dla punktw na dwch prostych, w ktrych te proste s najbliej siebie.
-/** Dane s dwie proste (RayOrig1, RayDir1) i (RayOrig2, RayDir2).
-Funkcja wyznacza parametry t1 i t2 dla punktw na tych prostych, w ktrych te proste s najbliej siebie.
-Jeli nie da si takich znale (proste s rwnolege), funkcja zwraca false.
-Te punkty mona policzy ze wzorw p1=RayOrig1+t1*RayDir1 i p2=RayOrig2+t2*RayDir2.
-Proste faktycznie przecinaj si jeli odlego midzy tymi punktami wynosi ok. 0. */
-bool ClosestPointsOnLines(float *OutT1, float *OutT2, const VEC3 &RayOrig1, const VEC3 &RayDir1, const VEC3 &RayOrig2, const VEC3 &RayDir2);
-/// Kolizja promienia z prostopadocianem
-/** Jeli promie nie przecina prostopadocianu, zwraca false.
-Jeli promie przecina prostopadocian, zwraca true i przez OutT zwraca odlego w wielokrotnociach dugoci RayDir.
-Jeli promie przecina prostopadocian od tyu, funkcja te zwraca true i zwraca OutT ujemne.
-Jeli RayOrig jest wewntrz prostopadocianu, funkcja zwraca true i OutT = 0. */
-bool RayToBox(float *OutT, const VEC3 &RayOrig, const VEC3 &RayDir, const BOX &Box);
-/// Wylicza kolizj promienia ze sfer
-/** Jeli nie ma kolizji, zwraca false.
-Jeli jest kolizja, zwraca true i parametr T.
-Jeli kolizja jest z tyu promienia - wczeniej ni jego pocztek - zwraca true i T ujemne.
-Jeli pocztek promienia jest wewntrz sfery, zwraca true i T=0 */
-bool RayToSphere(const VEC3 &RayOrig, const VEC3 &RayDir, const VEC3 &SphereCenter, float SphereRadius, float *OutT);
-/// Przecicie promienia z paszczyzn
-/** \param[out] OutT   Zwrcony parametr dla promienia (NIE mona poda 0)
-\param[out] OutVD   Zwrcona liczba mwica o zwrocie paszczyzny (NIE mona poda 0)
-  OutVD > 0 oznacza, e paszczyzna jest tyem do promienia
-\return   false jeli promie by rwnolegy do paszczyzny i nie udao si nic policzy. */
-bool RayToPlane(const VEC3 &RayOrig, const VEC3 &RayDir, const PLANE &Plane, float *OutT, float *OutVD);
-/// Kolizja promienia z trjktem
-/** \param[out] OutT   Mona poda NULL jeli nie interesuje nas odlego kolizji.
-\param BackfaceCulling   Jeli true, funkcja zawsze uwzgldnia wycznie kolizj
-z trjktem zwrconym w stron CW (jak w DirectX). */
-bool RayToTriangle(
-	const VEC3 &RayOrig, const VEC3 &RayDir,
-	const VEC3 &p0, const VEC3 &p1, const VEC3 &p2,
-	bool BackfaceCulling,
-	float *OutT);
-/// Kolizja promienia z czworoktem w 3D
-/** Czworokt musi by paski, wypuky i zorientowany odpowiednio.
-Kolizja dziaa tylko w jedn stron.
-Dla T ujemnego rwnie zwraca false. Niestety nie zwraca T.
-\param OutPoint Parametr opcjonalny. */
-bool RayToQuad(const VEC3 &RayOrig, const VEC3 &RayDir, const VEC3 QuadPoints[4], VEC3 *OutPoint = NULL);
-/// Kolizja promienia z frustumem
-bool RayToFrustum(const VEC3 &RayOrig, const VEC3 &RayDir, const FRUSTUM_PLANES &Frustum, float *t_near, float *t_far);
-/// Kolizja promienia z dowolnie zorientowanym cylindrem
-/** Jeli kolizja jest z tyu, te zwraca true i OutT wychodzi ujemne.
-Zwraca zawsze ten z dwch punktw przecicia ktry ma mniejsze OutT. */
-bool RayToCylinder(
-	const VEC3 &RayOrig, const VEC3 &RayDir,
-	const VEC3 &CylinderBeg, const VEC3 &CylinderEnd, float CylinderRadius,
-	float *OutT);
-/// Czy punkt ley wewntrz wielociana wypukego.
-/** Paszczyzny wielocianu maj mie wektory normalne zwrcone do wewntrz. */
-bool PointInConvexPolyhedron(const VEC3 &Point, const PLANE PolyhedronPlanes[], size_t PolyhedronPlaneCount);
-bool PointInConvexPolyhedron(const VEC3 &Point, const void *PolyhedronPlanes, size_t PolyhedronPlaneCount, ptrdiff_t PolyhedronPlaneStride);
-/// Kolizja promienia z wielocianem wypukym.
-/** Paszczyzny wielocianu maj mie wektory normalne zwrcone do wewntrz.
-Ta funkcja testuje tylko kolizj pprostej.
-Jeli wielocian jest z tyu promienia, funkcja zwraca false.
-T zawsze wychodz nieujemne. */
-bool RayToConvexPolyhedron(
-	const VEC3 &RayOrig, const VEC3 &RayDir,
-	const PLANE PolyhedronPlanes[], size_t PolyhedronPlaneCount,
-	float *OutBegT, float *OutEndT);
-bool RayToConvexPolyhedron(
-	const VEC3 &RayOrig, const VEC3 &RayDir,
-	const void *PolyhedronPlanes, size_t PolyhedronPlaneCount, ptrdiff_t PolyhedronPlaneStride,
-	float *OutBegT, float *OutEndT);
-/// Zwraca true jeli kula koliduje z prostopadocianem (take jeli jest w jego rodku)
-bool SphereToBox(const VEC3 &SphereCenter, float SphereRadius, const BOX &Box);
-/// Zwraca true, jeli sfera koliduje z prostopadocianem zorientowanym
-bool SphereToObb(const VEC3 &SphereCenter, float SphereRadius, const OBB &Obb);
-/// Zwraca true, jeli sfera koliduje z trjktem
-bool SphereToTriangle(const VEC3 &SphereCenter, float SphereRadius, const VEC3 &TriA, const VEC3 &TriB, const VEC3 &TriC);
-/// Zwraca true, jeli sfera zawiera si w caoci w prostopadocianie
-bool SphereInBox(const VEC3 &SphereCenter, float SphereRadius, const BOX &Box);
-/// Zwraca true, jeli prostopadocian zawiera si w caoci w sferze
-bool BoxInSphere(const BOX &Box, const VEC3 &SphereCenter, float SphereRadius);
-/// Klasyfikuje pooenie prostopadocianu wzgldem paszczyzny
-/**
-- -1 = prostopadocian w caoci po ujemnej stronie paszczyzny
--  0 = prostopadocian przecina paszczyzn
-- +1 = prostopadocian w caoci po dodatniej stronie paszczyzny
-\param plane Paszczyzna musi by znormalizowana */
-int ClassifyBoxToPlane(const PLANE &plane, const BOX &box);
-/// Klasyfikuje pooenie zorientowanego prostopadocianu OBB wzgldem paszczyzny. Zwraca -1, 0, 1.
-int ClassifyObbToPlane(const PLANE &Plane, const OBB &Obb);
-/// Kolizja paszczyzny z prostopadocianem
-/** \param plane Paszczyzna musi by znormalizowana */
-inline bool PlaneToBox(const PLANE &plane, const BOX &box) { return ClassifyBoxToPlane(plane, box) == 0; }
-/// Zwraca true, jeli trjkt zawiera si w prostopadocianie
-bool TriangleInBox(const VEC3 &p1, const VEC3 &p2, const VEC3 &p3, const BOX &Box);
-/// Zwraca true, jeli trjkt przecina prostopadocian lub si w nim zawiera
-/** \param[in] OptTrianglePlane   Mona poda jeli si ju ma wyliczone,
-eby przyspieszy. Nie musi by znormalizowane. */
-bool TriangleToBox(const VEC3 &TriA, const VEC3 &TriB, const VEC3 &TriC, const BOX &Box);
-/// Zwraca true, jeli podany prostopadocian jest widoczny cho troch w bryle widzenia
-/** Uwaga! W rzadkich przypadkach moe stwierdzi kolizj chocia jej nie ma. */
-bool BoxToFrustum_Fast(const BOX &Box, const FRUSTUM_PLANES &Frustum);
-/// Zwraca true, jeli podany prostopadocian jest widoczny cho troch w bryle widzenia
-/**
-Test dokadny, ale wolniejszy i wymaga te reprezentacji punktowej frustuma.
-\param[in] OptFrustumPoints to parametr opcjonalny - podaj jeli masz ju wyliczony. */
-bool BoxToFrustum(const BOX &Box, const FRUSTUM_PLANES &FrustumPlanes, const FRUSTUM_POINTS *OptFrustumPoints = NULL);
-bool BoxToFrustum(const BOX &Box, const FRUSTUM_RADAR &Frustum);
-/// Zwraca true, jeli AABB jest w caoci wewntrz frustuma
-bool BoxInFrustum(const BOX &Box, const FRUSTUM_PLANES &Frustum);
-/// Zwraca true jeli podane dwie sfery koliduj ze sob
-bool SphereToSphere(const VEC3 &Center1, float Radius1, const VEC3 &Center2, float Radius2);
-/// Zwraca true, jeli sfera koliduje z paszczyzn
-/** Paszczyzna musi by znormalizowana. */
-bool SphereToPlane(const VEC3 &SphereCenter, float SphereRadius, const PLANE &Plane);
-/// Klasyfikuje pooenie sfery wzgldem paszczyzny
-/**
-- -1 = sfera w caoci po ujemnej stronie paszczyzny
--  0 = sfera przecina paszczyzn
-- +1 = sfera w caoci po dodatniej stronie paszczyzny
-*/
-int ClassifySphereToPlane(const VEC3 &SphereCenter, float SphereRadius, const PLANE &Plane);
-/// Kolizja kapsuy (lub sfery poruszajcej si od CapsuleBeg do CapsuleEnd) z paszczyzn
-/** \param Plane Paszczyzna musi by znormalizowana. */
-bool CapsuleToPlane(const VEC3 &CapsuleBeg, const VEC3 &CapsuleEnd, float CapsuleRadius, const PLANE &Plane);
-/// Zwraca true, jeli sfera koliduje z frustumem
-/** Uwaga! W rzadkich przypadkach moe stwierdzi kolizj chocia jej nie ma. */
-bool SphereToFrustum_Fast(const VEC3 &SphereCenter, float SphereRadius, const FRUSTUM_PLANES &Frustum);
-/// Zwraca true, jeli sfera koliduje z frustumem
-/** Test dokadny, ale wolniejszy i wymaga te reprezentacji punktowej frustuma.
-\param[in] OptFrustumPoints   Parametr opcjonalny - podaj jeli masz ju wyliczony. */
-bool SphereToFrustum(
-	const VEC3 &SphereCenter, float SphereRadius,
-	const FRUSTUM_PLANES &FrustumPlanes, const FRUSTUM_POINTS *OptFrustumPoints = NULL);
-/// Testuje przecicie sfery z frustumem.
-/** Uwaga! Wyglda na to, e z nienznaych przyczyn ta funkcja nie zwraca true
-take dla sfery ktra nie jest cile kolidujca z frustumem, ale z pewnym
-niewielkim marginesem bdu w kierunku +/- Right.
-*/
-bool SphereToFrustum(const VEC3 &SphereCenter, float SphereRadius, const FRUSTUM_RADAR &Frustum);
-/// Zwraca true, jeli sfera zawiera si w caoci wewntrz frustuma
-bool SphereInFrustum(const VEC3 &SphereCenter, float SphereRadius, const FRUSTUM_PLANES &Frustum);
-/// Wylicza kolizj dwch paszczyzn zwracajc parametry prostej tworzcej ich przecicie
-/** Jesli nie ma kolizji bo paszczyzny s rwnolege, zwraca false.
-Paszczyzny musz by znormalizowane.
-\param OutLineDir [out] nie jest znormalizowany. */
-bool Intersect2Planes(const PLANE &Plane1, const PLANE &Plane2, VEC3 *OutLineOrig, VEC3 *OutLineDir);
-/// Zwraca punkt przecicia trzech paszczyzn lub false, jeli taki punkt nie istnieje
-/** Paszczyzny musz by znormalizowane. */
-bool Intersect3Planes(const PLANE &P1, const PLANE &P2, const PLANE &P3, VEC3 *OutP);
-/// Kolizja paszczyzny z trjktem
-bool PlaneToTriangle(const PLANE &Plane, const VEC3 &p0, const VEC3 &p1, const VEC3 &p2);
-/// Klasyfikuje pooenie trjkta wzgldem paszczyzny
-/**
-- -1 = trjkt w caoci po ujemnej stronie paszczyzny
--  0 = trjkt przecina paszczyzn
-- +1 = trjkt w caoci po dodatniej stronie paszczyzny
-*/
-int ClassifyPlaneToTriangle(const PLANE &Plane, const VEC3 &p0, const VEC3 &p1, const VEC3 &p2);
-/// Kolizja paszczyzny z frustumem (klasyfikacja)
-int ClassifyFrustumToPlane(const FRUSTUM_POINTS &Frustum, const PLANE &Plane);
-/// Zwraca true, jeli dwa odcinki 2D zachodz na siebie
-/** \param OutSeg1_t Parametr opcjonalny. Zwraca parametr 0..1 miejsca przecicia na odcinku Seg1. */
-bool SegmentToSegment(const VEC2 &Seg1_Beg, const VEC2 &Seg1_End, const VEC2 &Seg2_Beg, const VEC2 &Seg2_End, float *OutSeg1_t = NULL);
-/// Testuje kolizj dwch trjktw 3D
-/** Nie wiem co si dzieje jeli trjkty s zdegenerowane. */
-bool TriangleToTriangle(
-	const VEC3 &V0,const VEC3 &V1,const VEC3 &V2,
-	const VEC3 &U0,const VEC3 &U1,const VEC3 &U2);
-/// Testuje, czy trjkt ley w caoci wewntrz frustuma
-bool TriangleInFrustum(const VEC3 &t1, const VEC3 &t2, const VEC3 &t3, const FRUSTUM_PLANES &Frustum);
-/// Testuje kolizj trjkta z frustumem
-/** \param[in] OptTrianglePlane   Podaj jeli masz ju wyliczone, aby przyspieszy.
-\param[in] OptFrustumPoints   Podaj jeli masz ju wyliczone, aby przyspieszy. */
-bool TriangleToFrustum(
-	const VEC3 &t1, const VEC3 &t2, const VEC3 &t3, const PLANE *OptTrianglePlane,
-	const FRUSTUM_PLANES &FrustumPlanes, const FRUSTUM_POINTS *OptFrustumPoints);
-/// Testuje kolizj midzy dwoma frustumami
-bool FrustumToFrustum(
-	const FRUSTUM_PLANES &Frustum1_Planes, const FRUSTUM_POINTS &Frustum1_Points,
-	const FRUSTUM_PLANES &Frustum2_Planes, const FRUSTUM_POINTS &Frustum2_Points);
-/// Kolizja sfery z kapsu
-bool SphereToCapsule(
-	const VEC3 &SphereCenter, float SphereRadius,
-	const VEC3 &Capsule_Beg, const VEC3 &Capsule_End, float Capsule_Radius);
-/// Kolizja kapsuy z kapsu
-bool CapsuleToCapsule(
-	const VEC3 &Capsule1_Beg, const VEC3 &Capsule1_End, float Capsule1_Radius,
-	const VEC3 &Capsule2_Beg, const VEC3 &Capsule2_End, float Capsule2_Radius);
-/// Sprawdza, czy punkt ley wewntrz wypukego wielokta 2D.
-/** Wielokt musi mie wierzchoki zorientowane CW. */
-bool PointInConvexPolygon(const VEC2 &Point, const VEC2 PolygonPoints[], size_t PolygonPointCount);
-bool PointInConvexPolygon(const VEC2 &Point, const void *PolygonPoints, size_t PolygonPointCount, ptrdiff_t PolygonPointStride);
-/// Zwraca true, jeli podany punkt ley wewntrz podanego wielokta (2D).
-/** Wielokt moe mie dowolny ksztat, take niewypuky, a nawet sam si przecina.
-Jego wierzchoki mog biec w dowolnym kierunku. */
-bool PointInPolygon(const VEC2 &Point, const VEC2 PolygonPoints[], size_t PolygonPointCount);
-bool PointInPolygon(const VEC2 &Point, const void *PolygonPoints, size_t PolygonPointCount, ptrdiff_t PolygonPointStride);
-/// Zwraca true, jeli promie przecina wielokt wypuky 3D i wtedy przez OutT zwraca parametr dla promienia.
-/** Wierzchoki wielokta musz lee w jednej paszczynie.
-Jeli kolizja jest od tyu pocztku promienia, zwraca true i OutT ujemne.
-Uwaga! Stosuje rzutowanie na jedn z gwnych paszczyzn, testowana tylko dla jednej z trzech moliwych. BackfaceCulling moe dziaa le.
-\param BackfaceCulling true oznacza, e promie trafia tylko jeli wchodzi z jednej strony,
-z tej z ktrej wierzchoki wielokta s widoczne jako zorientowane w kierunku CW.
-\param PolygonPlane Opcjonalny. Podaj, jeli masz ju wyliczony. */
-bool RayToConvexPolygon(
-	const VEC3 &RayOrig, const VEC3 &RayDir,
-	const VEC3 PolygonPoints[], size_t PolygonPointCount,
-	bool BackfaceCulling, float *OutT, VEC3 *OutPoint, const PLANE *PolygonPlane = NULL);
-bool RayToConvexPolygon(
-	const VEC3 &RayOrig, const VEC3 &RayDir,
-	const void *PolygonPoints, size_t PolygonPointCount, ptrdiff_t PolygonPointStride,
-	bool BackfaceCulling, float *OutT, VEC3 *OutPoint, const PLANE *PolygonPlane = NULL);
-/// Zwraca true, jeli promie przecina wielokt 3D i wtedy przez OutT zwraca parametr dla promienia.
-/** Wierzchoki wielokta musz lee w jednej paszczynie.
-Wielokt moe by dowolny, nie musi by wypuky.
-Uwaga! Stosuje rzutowanie na jedn z gwnych paszczyzn, testowana tylko dla jednej z trzech moliwych. BackfaceCulling moe dziaa le.
-\param BackfaceCulling true oznacza, e promie trafia tylko jeli wchodzi z jednej strony,
-z tej z ktrej wierzchoki wielokta s widoczne jako zorientowane w kierunku CW.
-\param PolygonPlane Opcjonalny. Podaj, jeli masz ju wyliczony. */
-bool RayToPolygon(
-	const VEC3 &RayOrig, const VEC3 &RayDir,
-	const VEC3 PolygonPoints[], size_t PolygonPointCount,
-	bool BackfaceCulling, float *OutT, VEC3 *OutPoint, const PLANE *PolygonPlane = NULL);
-bool RayToPolygon(
-	const VEC3 &RayOrig, const VEC3 &RayDir,
-	const void *PolygonPoints, size_t PolygonPointCount, ptrdiff_t PolygonPointStride,
-	bool BackfaceCulling, float *OutT, VEC3 *OutPoint, const PLANE *PolygonPlane = NULL);
-
-/// Liczy kolizj poruszajcej si sfery z paszczyzn
-/**
-- Paszczyzna musi by znormalizowana.
-- Jako OutT0 i OutT1 mona podawa NULL, jeli nas akurat nie interesuje.
-- Jeli sfera porusza si w drug stron, te wychodzi true i T wychodz ujemne.
-- Jeli sfera koliduje z paszczyzn i porusza si w kierunku do niej rwnolegym, jest T0=0, T1=MAXFLOAT i return true.
-*/
-bool SweptSphereToPlane(const VEC3 &SphereCenter, float SphereRadius, const VEC3 &SphereSweepDir, const PLANE &Plane, float *OutT0, float *OutT1);
-/// Oblicza kolizj poruszajcej si sfery z frustumem
-/**
-- Frustum musi by znormalizowany.
-- Jeli sfera ley w rodku, te oczywicie zwraca true.
-*/
-bool SweptSphereToFrustum(const VEC3 &SphereCenter, float SphereRadius, const VEC3 &SphereSweepDir, const FRUSTUM_PLANES &Frustum);
-/// Analityczna kolizja dwch poruszajcych si sfer.
-/**
-- Jeli nie ma kolizji, zwraca false. T1 i T2 niezdefiniowane.
-- Jeli jest kolizja, zwraca true. Wwczas przez T1 i T2 zwraca czas pocztku i koca kolizji wyraony we wielokrotnociach dugoci SphereSweepDir1 (T1 <= T2).
-- Jeli kolizja nastpuje z tyu, te zwraca true, a T1 i/lub T2 bd ujemne.
-
-\param SphereSweepDir1    Kierunek ruchu sfery 1 w stosunku do sfery 2. Nie musi by znormalizowany.
-*/
-bool SweptSphereToSphere(
-	const VEC3 &SphereCenter1, float SphereRadius1,
-	const VEC3 &SphereCenter2, float SphereRadius2,
-	const VEC3 &SphereSweepDir1,
-	float *OutT1, float *OutT2);
-/// Kolizja poruszajcego si AABB z drugim AABB.
-/**
-- Jeli nie zachodzi, zwraca false.
-- Jeli zachodzi, zwraca true i T jako czas pocztkowy kontaktu.
-- Jeli zachodzi z tyu, zwraca true i T ujemne.
-- Jeli zachodzi w chwili pocztkowej, zwraca true i T=0.
-
-\param SweepDirBox1    Nie musi by znormalizowany. T bdzie wyraone we wielokrotnociach jego dugoci.
-*/
-bool SweptBoxToBox(const BOX &Box1, const BOX &Box2, const VEC3 &SweepDirBox1, float *OutT1, float *OutT2);
-
-/** \param rayDir Must be normalized.
-\param coneDirVec Must be normalized.
-\param coneHalfAngle Must be less than PI_2.
-\return Number of intersections. */
-int RayToCone(const VEC3 &rayOrig, const VEC3 & rayDir, const VEC3 &coneVertex, const VEC3 &coneDirVec, float coneHalfAngle, VEC3 intersections[2]);
-bool PointInCone(const VEC3 &pt, const VEC3 &coneVertex, const VEC3 &coneDirVec, float coneHalfAngle);
-bool SegmentIntersectsOrIsContainedInCone(const VEC3 & segmentPoint1, const VEC3 & segmentPoint2, const VEC3 & coneVertex, const VEC3 & coneDirVec, const float coneHalfAngle, VEC3 intersections[2], int &numIntersectionsFound);
-bool SegmentIntersectsOrIsContainedInCone(const VEC3 & segmentPoint1, const VEC3 & segmentPoint2, const VEC3 & coneVertex, const VEC3 & coneDirVec, const float coneHalfAngle);
-
-//@}
-// math_collisions
-
-/// Z podanej tablicy punktw typu VEC2 znajduje punkt najbliszy wzgldem p, zwraca jego indeks.
-/** \param OutDistance jest opcjonalny, mona poda NULL Jeli odlego od niego nas nie interesuje. */
-size_t ClosestPoint(const VEC2 &p, const VEC2 Points[], size_t PointCount, float *OutDistance = NULL);
-size_t ClosestPoint(const VEC2 &p, const void *Data, size_t PointCount, ptrdiff_t Stride, float *OutDistance = NULL);
-/// Z podanej tablicy punktw typu VEC3 znajduje punkt najbliszy wzgldem p, zwraca jego indeks.
-/** \param OutDistance jest opcjonalny, mona poda NULL Jeli odlego od niego nas nie interesuje. */
-size_t ClosestPoint(const VEC3 &p, const VEC3 Points[], size_t PointCount, float *OutDistance = NULL);
-size_t ClosestPoint(const VEC3 &p, const void *Data, size_t PointCount, ptrdiff_t Stride, float *OutDistance = NULL);
-/// Z podanej tablicy punktw typu VEC2 znajduje punkt najdalszy wzgldem p, zwraca jego indeks.
-/** \param OutDistance jest opcjonalny, mona poda NULL Jeli odlego od niego nas nie interesuje. */
-size_t FurthestPoint(const VEC2 &p, const VEC2 Points[], size_t PointCount, float *OutDistance = NULL);
-size_t FurthestPoint(const VEC2 &p, const void *Data, size_t PointCount, ptrdiff_t Stride, float *OutDistance = NULL);
-/// Z podanej tablicy punktw typu VEC3 znajduje punkt najdalszy wzgldem p, zwraca jego indeks.
-/** \param OutDistance jest opcjonalny, mona poda NULL Jeli odlego od niego nas nie interesuje. */
-size_t FurthestPoint(const VEC3 &p, const VEC3 Points[], size_t PointCount, float *OutDistance = NULL);
-size_t FurthestPoint(const VEC3 &p, const void *Data, size_t PointCount, ptrdiff_t Stride, float *OutDistance = NULL);
-/// Z podanej tablicy punktw typu VEC2 znajduje najbardziej wysunity w kierunku okrelonym przez Dir. Zwraca jego indeks.
-size_t FurthestPointForDir(const VEC2 &Dir, const VEC2 Points[], size_t PointCount);
-size_t FurthestPointForDir(const VEC2 &Dir, const void *Data, size_t PointCount, ptrdiff_t Stride);
-/// Z podanej tablicy punktw typu VEC3 znajduje najbardziej wysunity w kierunku okrelonym przez Dir. Zwraca jego indeks.
-size_t FurthestPointForDir(const VEC3 &Dir, const VEC3 Points[], size_t PointCount);
-size_t FurthestPointForDir(const VEC3 &Dir, const void *Data, size_t PointCount, ptrdiff_t Stride);
-
-/// Tworzy najmniejszy prostokt otaczajcy podany zbir punktw typu VEC2.
-void RectBoundingPoints(RECTF *OutRect, const VEC2 Points[], size_t PointCount);
-void RectBoundingPoints(RECTF *OutRect, const void *Data, size_t PointCount, ptrdiff_t Stride);
-/// Tworzy najmniejszy boks otaczajcy podany zbir punktw typu VEC3.
-void BoxBoundingPoints(BOX *box, const VEC3 points[], size_t PointCount);
-void BoxBoundingPoints(BOX *box, const void *Data, size_t PointCount, ptrdiff_t Stride);
-/// Liczy sfer otaczajc dwie sfery
-void SphereBoundingSpheres(VEC3 *OutCenter, float *OutRadius, const VEC3 &Center1, float Radius1, const VEC3 &Center2, float Radius2);
-
-/// Znajduje okrg otaczajcy podany zbir punktw typu VEC2.
-/** Nie jest to moe najmniejszy okrg, ale przynajmniej ten algorytm jest prosty i szybki. */
-void CircleBoundingPoints(VEC2 *OutSphereCenter, float *OutSphereRadius, const VEC2 Points[], size_t PointCount);
-void CircleBoundingPoints(VEC2 *OutSphereCenter, float *OutSphereRadius, const void *PointData, size_t PointCount, ptrdiff_t PointStride);
-/// Znajduje sfer otaczajc podany zbir punktw typu VEC3.
-/** Nie jest to moe najmniejsza sfera, ale przynajmniej ten algorytm jest prosty i szybki. */
-void SphereBoundingPoints(VEC3 *OutSphereCenter, float *OutSphereRadius, const VEC3 Points[], size_t PointCount);
-void SphereBoundingPoints(VEC3 *OutSphereCenter, float *OutSphereRadius, const void *PointData, size_t PointCount, ptrdiff_t PointStride);
-
-/// Znajduje promie najmniejszego okrgu o rodku (0,0) otaczajcego podany zbir punktw 2D.
-void OriginCircleBoundingPoints(float *OutRadius, const VEC2 Points[], size_t PointCount);
-void OriginCircleBoundingPoints(float *OutRadius, const void *PointData, size_t PointCount, ptrdiff_t PointStride);
-/// Znajduje promie najmniejszej sfery o rodku (0,0) otaczajcej podany zbir punktw 3D.
-void OriginSphereBoundingPoints(float *OutRadius, const VEC3 Points[], size_t PointCount);
-void OriginSphereBoundingPoints(float *OutRadius, const void *PointData, size_t PointCount, ptrdiff_t PointStride);
-
-/// Dla podanego zbioru punktw typu VEC2 oblicza ich centroid, czyli po prostu redni.
-void CalcCentroid(VEC2 *OutCentroid, const VEC2 Points[], size_t PointCount);
-void CalcCentroid(VEC2 *OutCentroid, const void *PointData, size_t PointCount, ptrdiff_t PointStride);
-/// Dla podanego zbioru punktw typu VEC3 oblicza ich centroid, czyli po prostu redni.
-void CalcCentroid(VEC3 *OutCentroid, const VEC3 Points[], size_t PointCount);
-void CalcCentroid(VEC3 *OutCentroid, const void *PointData, size_t PointCount, ptrdiff_t PointStride);
-
-/// Oblicza macierz kowariancji dla podanego zbioru punktw typu VEC3.
-void CalcCovarianceMatrix(MATRIX33 *OutCov, const VEC3 Points[], size_t PointCount);
-void CalcCovarianceMatrix(MATRIX33 *OutCov, const void *PointData, size_t PointCount, ptrdiff_t PointStride);
-/// Oblicza wartoci wasne i wektory wasne dla podanej macierzy symetrycznej (np. macierz kowariancji).
-/** Uwaga! Duo oblicze, procedura iteracyjna. Moe dziaa wolno.
-\param InCovOutEigenvalues [in,out] Jako wejcie - dana macierz. Jako wyjcie - na przektnej ma wartoci wasne.
-\param OutEigenvectors [out] Wektory wasne zapisane w kolumnach. */
-void CalcEigenvaluesAndEigenvectors(MATRIX33 *InCovOutEigenvalues, MATRIX33 *OutEigenvectors);
-
-/// Oblicza sfer otaczajc box
-void BoxBoundingSphere(VEC3 *SphereCenter, float *SphereRadius, const BOX &Box);
-/// Oblicza box otaczajcy sfer
-void SphereBoundingBox(BOX *Out, const VEC3 &SphereCenter, float SphereRadius);
-/// Wylicza AABB otaczajcy podany zbir sfer
-/** \param SphereCount   Musi by wiksze od 0. */
-void BoxBoundingSpheres(BOX *OutBox, const VEC3 SpheresCenter[], const float SpheresRadius[], size_t SphereCount);
-
-/// Losuje punkt wewntrz kuli o rodku w (0,0,0) i promieniu 1. Rozkad rwnomierny.
-void RandomPointInUnitSphere(VEC3 *Out, RandomGenerator &Rand);
-void RandomPointInUnitSphere(VEC3 *Out);
-/// Losuje punkt wewntrz koa o rodku w (0,0) i promieniu 1. Rozkad rwnomierny.
-void RandomPointInUnitCircle(VEC2 *Out, RandomGenerator &Rand);
-void RandomPointInUnitCircle(VEC2 *Out);
-
-/// Calculates orientation of a 3D billboard in according to its parameters and camera parameters.
-/** OutRight, OutUp will be normalized vectors with X, Y directions for the billboard. \n
-DegreesOfFreedom and UseRealDir control billboard orientation mode.
-DegreesOfFreedom may be 0, 1, 2. \n
-0 = billboard not rotating at all (DefinedRight and DefinedUp required). \n
-1 = billboard rotating only around its Y axis (DefinedUp required). \n
-2 = billboard rotating around its Y and X axes (neither DefinedRight nor DefinedUp required). \n
-DefinedRight and DefinedUp are original direction vectors of a billboard. \n
-CamRightDir must be orthogonal to CamReadUpDir, so CamRealUpDir cannot be constant like VEC3_POSITIVE_Y. \n
-CameraToObjectDir must be normalize(BillboardCenterPos - EyePos). */
-void CalcBillboardOrientation(
-	VEC3 *OutRight, VEC3 *OutUp,
-	unsigned DegreesOfFreedom, bool UseRealDir,
-	const VEC3 &DefinedRight, const VEC3 &DefinedUp,
-	const VEC3 &CamRightDir, const VEC3 &CamRealUpDir, const VEC3 &CameraToObjectDir);
-
-/// Klasa, ktra dziki pamitaniu wynikw porednich przyspiesza testowanie kolizji jednego trjkta z wieloma promieniami.
-/** Na podstawie ksiki: Real-Time Collision Detection, Christer Ericson */
-class RayToTriangleCalc
-{
-public:
-	/// Tworzy NIEZAINICJALIZOWANY
-	RayToTriangleCalc() { }
-	/// Tworzy i inicjalizuje
-	RayToTriangleCalc(const VEC3 &TriA, const VEC3 &TriB, const VEC3 &TriC) { Init(TriA, TriB, TriC); }
-	/// Inicjalizuje
-	void Init(const VEC3 &TriA, const VEC3 &TriB, const VEC3 &TriC);
-
-	/// Liczy kolizj podanego promienia z wpisanym do obiektu trjktem.
-	/** Jeli kolizja jest od tyu promienia, rwnie zwraca true i OutT ujemne.
-	\param BackfaceCulling Jeli true, uwzgldnia kolizj tylko od strony z ktrej wierzchoki trjkta s CW.
-	\param OutT [out] Parametr do promienia.
-	\param OutU [out] Wsprzdna barycentryczna.
-	\param OutV [out] Wsprzdna barycentryczna.
-	\param OutW [out] Wsprzdna barycentryczna.
-	\param OutPoint [out] Punkt kolizji. */
-	bool RayToTriangle(
-		const VEC3 &RayOrig, const VEC3 &RayDir, bool BackfaceCulling,
-		float *OutT, float *OutU, float *OutV, float *OutW, VEC3 *OutPoint) const;
-
-private:
-	PLANE m_Plane;
-	PLANE m_EdgePlaneBC;
-	PLANE m_EdgePlaneCA;
-};
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-/** \addtogroup math_poisson_disc Poisson Disc */
-//@{
-
-extern const float POISSON_DISC_1D[];
-const uint32 POISSON_DISC_1D_COUNT = 100;
-
-extern const VEC2 POISSON_DISC_2D[];
-const uint32 POISSON_DISC_2D_COUNT = 100;
-
-extern const VEC3 POISSON_DISC_3D[];
-const uint32 POISSON_DISC_3D_COUNT = 100;
-
-//@}
-// math_poisson_disc
-
-//@}
-// code_math
-
-} // namespace common
-
-
-/** \addtogroup code_math */
-//@{
-/** \addtogroup math_swizzle Vector swizzling
-Here are macros for convinient building vectors from arbitrary components of
-other vector, just like in HLSL and other shader languages.
-
-For example, in HLSL you can extend float2 to float4 with repeating (x,y)
-components two times with code like this:
-
-\verbatim
-float2 v2 = float2(1, 2);
-float4 v4 = v2.xyxy;
-\endverbatim
-
-In C++ with CommonLib, you can do it like this:
-
-\code
-common::VEC2 v2 = common::VEC2(1.f, 2.f);
-common::VEC4 v4 = common::VEC4(v2.x, v2.y, v2.x, v2.y);
-\endcode
-
-But the more convenient way is to use VEC4_SWIZZLE macro:
-
-\code
-common::VEC2 v2 = common::VEC2(1.f, 2.f);
-common::VEC4 v4 = VEC4_SWIZZLE(v2,x,y,x,y);
-\endcode
-
-Source vector can be of any size (VEC2, VEC3, VEC4), as long as you reference
-only existing components (x, y, z, w).
-
-Type of destination vector is determined by using particular macro (e.g.
-VEC3_SWIZZLE returns VEC3).
-
-You can use expression of any type as source value, as long as it can be indexed
-with dot operator. E.g.:
-
-\code
-MATRIX m = ...;
-VEC4 mDiagonal = VEC4_SWIZZLE(m,_11,_22,_33,_44);
-BOX box = ...;
-VEC2 boxRangeX = VEC2_SWIZZLE(box,Min.x,Max.x);
-\endcode
-*/
-//@{
-
-#define VEC2_SWIZZLE(v, c0, c1)         (common::VEC2((v).c0, (v).c1))
-#define VEC3_SWIZZLE(v, c0, c1, c2)     (common::VEC3((v).c0, (v).c1, (v).c2))
-#define VEC4_SWIZZLE(v, c0, c1, c2, c3) (common::VEC4((v).c0, (v).c1, (v).c2, (v).c3))
-
-//@}
-// math_swizzle
-//@}
-// code_math
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-// Konwersje
-
-/** \addtogroup code_sthtostr */
-//@{
-
-template <>
-struct SthToStr_obj<common::POINT_>
-{
-	void operator () (tstring *Str, const common::POINT_ &Sth)
-	{
-		*Str = common::Format(_T("#,#")) % Sth.x % Sth.y;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct StrToSth_obj<common::POINT_>
-{
-	bool operator () (common::POINT_ *Sth, const tstring &Str)
-	{
-		size_t CommaPos = Str.find(_T(','));
-		if (CommaPos == tstring::npos) return false;
-		if (!StrToSth<int>(&Sth->x, Str.substr(0, CommaPos))) return false;
-		if (!StrToSth<int>(&Sth->y, Str.substr(CommaPos+1))) return false;
-		return true;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct SthToStr_obj<common::VEC2>
-{
-	void operator () (tstring *Str, const common::VEC2 &Sth)
-	{
-		*Str = common::Format(_T("#,#")) % Sth.x % Sth.y;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct StrToSth_obj<common::VEC2>
-{
-	bool operator () (common::VEC2 *Sth, const tstring &Str)
-	{
-		size_t CommaPos = Str.find(_T(','));
-		if (CommaPos == tstring::npos) return false;
-		if (!StrToSth<float>(&Sth->x, Str.substr(0, CommaPos))) return false;
-		if (!StrToSth<float>(&Sth->y, Str.substr(CommaPos+1))) return false;
-		return true;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct SthToStr_obj<common::VEC3>
-{
-	void operator () (tstring *Str, const common::VEC3 &Sth)
-	{
-		*Str = common::Format(_T("#,#,#")) % Sth.x % Sth.y % Sth.z;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct StrToSth_obj<common::VEC3>
-{
-	bool operator () (common::VEC3 *Sth, const tstring &Str)
-	{
-		size_t CommaPos1 = Str.find(_T(','));
-		if (CommaPos1 == tstring::npos) return false;
-		size_t CommaPos2 = Str.find(_T(','), CommaPos1+1);
-		if (CommaPos2 == tstring::npos) return false;
-		if (!StrToSth<float>(&Sth->x, Str.substr(0, CommaPos1))) return false;
-		if (!StrToSth<float>(&Sth->y, Str.substr(CommaPos1+1, CommaPos2-(CommaPos1+1)))) return false;
-		if (!StrToSth<float>(&Sth->z, Str.substr(CommaPos2+1))) return false;
-		return true;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct SthToStr_obj<common::VEC4>
-{
-	void operator () (tstring *Str, const common::VEC4 &Sth)
-	{
-		*Str = common::Format(_T("#,#,#,#")) % Sth.x % Sth.y % Sth.z % Sth.w;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct StrToSth_obj<common::VEC4>
-{
-	bool operator () (common::VEC4 *Sth, const tstring &Str)
-	{
-		size_t CommaPos1 = Str.find(_T(','));
-		if (CommaPos1 == tstring::npos) return false;
-		size_t CommaPos2 = Str.find(_T(','), CommaPos1+1);
-		if (CommaPos2 == tstring::npos) return false;
-		size_t CommaPos3 = Str.find(_T(','), CommaPos2+1);
-		if (CommaPos3 == tstring::npos) return false;
-		if (!StrToSth<float>(&Sth->x, Str.substr(0, CommaPos1))) return false;
-		if (!StrToSth<float>(&Sth->y, Str.substr(CommaPos1+1, CommaPos2-(CommaPos1+1)))) return false;
-		if (!StrToSth<float>(&Sth->z, Str.substr(CommaPos2+1, CommaPos3-(CommaPos2+1)))) return false;
-		if (!StrToSth<float>(&Sth->w, Str.substr(CommaPos3+1))) return false;
-		return true;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct SthToStr_obj<common::RECTI>
-{
-	void operator () (tstring *Str, const common::RECTI &Sth)
-	{
-		*Str = common::Format(_T("#,#,#,#")) % Sth.Min.x % Sth.Min.y % Sth.Max.x % Sth.Max.y;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct StrToSth_obj<common::RECTI>
-{
-	bool operator () (common::RECTI *Sth, const tstring &Str)
-	{
-		size_t CommaPos1 = Str.find(_T(','));
-		if (CommaPos1 == tstring::npos) return false;
-		size_t CommaPos2 = Str.find(_T(','), CommaPos1+1);
-		if (CommaPos2 == tstring::npos) return false;
-		size_t CommaPos3 = Str.find(_T(','), CommaPos2+1);
-		if (CommaPos3 == tstring::npos) return false;
-		if (!StrToSth<int>(&Sth->Min.x, Str.substr(0, CommaPos1))) return false;
-		if (!StrToSth<int>(&Sth->Min.y, Str.substr(CommaPos1+1, CommaPos2-(CommaPos1+1)))) return false;
-		if (!StrToSth<int>(&Sth->Max.x, Str.substr(CommaPos2+1, CommaPos3-(CommaPos2+1)))) return false;
-		if (!StrToSth<int>(&Sth->Max.y, Str.substr(CommaPos3+1))) return false;
-		return true;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct SthToStr_obj<common::RECTF>
-{
-	void operator () (tstring *Str, const common::RECTF &Sth)
-	{
-		*Str = common::Format(_T("#,#,#,#")) % Sth.Min.x % Sth.Min.y % Sth.Max.x % Sth.Max.y;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct StrToSth_obj<common::RECTF>
-{
-	bool operator () (common::RECTF *Sth, const tstring &Str)
-	{
-		size_t CommaPos1 = Str.find(_T(','));
-		if (CommaPos1 == tstring::npos) return false;
-		size_t CommaPos2 = Str.find(_T(','), CommaPos1+1);
-		if (CommaPos2 == tstring::npos) return false;
-		size_t CommaPos3 = Str.find(_T(','), CommaPos2+1);
-		if (CommaPos3 == tstring::npos) return false;
-		if (!StrToSth<float>(&Sth->Min.x, Str.substr(0, CommaPos1))) return false;
-		if (!StrToSth<float>(&Sth->Min.y, Str.substr(CommaPos1+1, CommaPos2-(CommaPos1+1)))) return false;
-		if (!StrToSth<float>(&Sth->Max.x, Str.substr(CommaPos2+1, CommaPos3-(CommaPos2+1)))) return false;
-		if (!StrToSth<float>(&Sth->Max.y, Str.substr(CommaPos3+1))) return false;
-		return true;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct SthToStr_obj<common::BOX>
-{
-	void operator () (tstring *Str, const common::BOX &Sth)
-	{
-		*Str = common::Format(_T("#;#")) % Sth.Min % Sth.Max;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct StrToSth_obj<common::BOX>
-{
-	bool operator () (common::BOX *Sth, const tstring &Str)
-	{
-		size_t SemicolonPos = Str.find(_T(';'));
-		if (SemicolonPos == tstring::npos) return false;
-		if (!StrToSth<common::VEC3>(&Sth->Min, Str.substr(0, SemicolonPos))) return false;
-		if (!StrToSth<common::VEC3>(&Sth->Max, Str.substr(SemicolonPos+1))) return false;
-		return true;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <> struct SthToStr_obj<common::COLOR> {
-	void operator () (tstring *Str, const common::COLOR &Sth) { common::ColorToStr(Str, Sth); }
-	static inline bool IsSupported() { return true; }
-};
-template <> struct StrToSth_obj<common::COLOR> {
-	bool operator () (common::COLOR *Sth, const tstring &Str) { return common::StrToColor(Sth, Str); }
-	static inline bool IsSupported() { return true; }
-};
-
-template <> struct SthToStr_obj<common::COLORF> {
-	void operator () (tstring *Str, const common::COLORF &Sth) { common::ColorToStr(Str, Sth); }
-	static inline bool IsSupported() { return true; }
-};
-template <> struct StrToSth_obj<common::COLORF> {
-	bool operator () (common::COLORF *Sth, const tstring &Str) { return common::StrToColor(Sth, Str); }
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct SthToStr_obj<common::PLANE>
-{
-	void operator () (tstring *Str, const common::PLANE &Sth)
-	{
-		*Str = common::Format(_T("#,#,#,#")) % Sth.a % Sth.b % Sth.c % Sth.d;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct StrToSth_obj<common::PLANE>
-{
-	bool operator () (common::PLANE *Sth, const tstring &Str)
-	{
-		size_t CommaPos1 = Str.find(_T(','));
-		if (CommaPos1 == tstring::npos) return false;
-		size_t CommaPos2 = Str.find(_T(','), CommaPos1+1);
-		if (CommaPos2 == tstring::npos) return false;
-		size_t CommaPos3 = Str.find(_T(','), CommaPos2+1);
-		if (CommaPos3 == tstring::npos) return false;
-		if (!StrToSth<float>(&Sth->a, Str.substr(0, CommaPos1))) return false;
-		if (!StrToSth<float>(&Sth->b, Str.substr(CommaPos1+1, CommaPos2-(CommaPos1+1)))) return false;
-		if (!StrToSth<float>(&Sth->c, Str.substr(CommaPos2+1, CommaPos3-(CommaPos2+1)))) return false;
-		if (!StrToSth<float>(&Sth->d, Str.substr(CommaPos3+1))) return false;
-		return true;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct SthToStr_obj<common::LINE2D>
-{
-	void operator () (tstring *Str, const common::LINE2D &Sth)
-	{
-		*Str = common::Format(_T("#,#,#")) % Sth.a % Sth.b % Sth.c;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct StrToSth_obj<common::LINE2D>
-{
-	bool operator () (common::LINE2D *Sth, const tstring &Str)
-	{
-		size_t CommaPos1 = Str.find(_T(','));
-		if (CommaPos1 == tstring::npos) return false;
-		size_t CommaPos2 = Str.find(_T(','), CommaPos1+1);
-		if (CommaPos2 == tstring::npos) return false;
-		if (!StrToSth<float>(&Sth->a, Str.substr(0, CommaPos1))) return false;
-		if (!StrToSth<float>(&Sth->b, Str.substr(CommaPos1+1, CommaPos2-(CommaPos1+1)))) return false;
-		if (!StrToSth<float>(&Sth->c, Str.substr(CommaPos2+1))) return false;
-		return true;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <> struct SthToStr_obj<common::MATRIX> {
-	void operator () (tstring *Str, const common::MATRIX &Sth) { common::MatrixToStr(Str, Sth); }
-	static inline bool IsSupported() { return true; }
-};
-template <> struct StrToSth_obj<common::MATRIX> {
-	bool operator () (common::MATRIX *Sth, const tstring &Str) { return common::StrToMatrix(Sth, Str); }
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct SthToStr_obj<common::QUATERNION>
-{
-	void operator () (tstring *Str, const common::QUATERNION &Sth)
-	{
-		*Str = common::Format(_T("#,#,#,#")) % Sth.x % Sth.y % Sth.z % Sth.w;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct StrToSth_obj<common::QUATERNION>
-{
-	bool operator () (common::QUATERNION *Sth, const tstring &Str)
-	{
-		size_t CommaPos1 = Str.find(_T(','));
-		if (CommaPos1 == tstring::npos) return false;
-		size_t CommaPos2 = Str.find(_T(','), CommaPos1+1);
-		if (CommaPos2 == tstring::npos) return false;
-		size_t CommaPos3 = Str.find(_T(','), CommaPos2+1);
-		if (CommaPos3 == tstring::npos) return false;
-		if (!StrToSth<float>(&Sth->x, Str.substr(0, CommaPos1))) return false;
-		if (!StrToSth<float>(&Sth->y, Str.substr(CommaPos1+1, CommaPos2-(CommaPos1+1)))) return false;
-		if (!StrToSth<float>(&Sth->z, Str.substr(CommaPos2+1, CommaPos3-(CommaPos2+1)))) return false;
-		if (!StrToSth<float>(&Sth->w, Str.substr(CommaPos3+1))) return false;
-		return true;
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct SthToStr_obj<common::AFFINE2D>
-{
-	void operator () (tstring *Str, const common::AFFINE2D &Sth)
-	{
-		common::Affine2dToStr(Str, Sth);
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct StrToSth_obj<common::AFFINE2D>
-{
-	bool operator () (common::AFFINE2D *Sth, const tstring &Str)
-	{
-		return common::StrToAffine2d(Sth, Str);
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-//@}
-// code_sthtostr
-#endif
+/** \file
+\brief Mathematical module
+\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
+
+Part of CommonLib library. \n
+Encoding UTF-8, end of line CR+LF \n
+License: GNU LGPL. \n
+Documentation: \ref Module_Math \n
+Module components: \ref code_math
+*/
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+#pragma once
+#endif
+#ifndef COMMON_MATH_H_
+#define COMMON_MATH_H_
+
+#ifdef _WIN32
+	#include <windows.h> // bo bez tego w d3d9types.h są błędy bo nie zna DWORD itp., poza tym potrzebny jest Point itd.
+#endif
+
+#ifdef USE_DIRECTX
+	#include <d3dx9.h>
+#endif
+
+#include <functional>
+
+namespace common
+{
+
+/** \addtogroup code_math Math Module
+Dokumentacja: \ref Module_Math \n
+Nagłówek: Math.hpp */
+//@{
+
+/// Szablon bazowy do konwersji między typami matematycznymi
+/** Ta wersja nie działa, specjalizacje będą działać. */
+template <typename DestT, typename SrcT>
+DestT & math_cast(const SrcT &x)
+{
+	assert(0 && "Unsupported type in math_cast.");
+}
+
+/// Mała stała
+const float FLOAT_EPSILON = 1e-6f;
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+/** \addtogroup math_point Punkt 2D z liczb całkowitych */
+//@{
+
+/// Punkt 2D z liczb całkowitych
+/**
+Kompatybilny ze strukturą POINT z Win32API.
+Nazywa się tak dziwnie, bo POINT to w Windows API marko i robi problem z nazwą.
+Konwersja do i ze stringa: "x,y", np. "10,1".
+*/
+struct POINT_
+{
+	union
+	{
+		struct
+		{
+			int x, y;
+		};
+		int v[2];
+	};
+
+	static const POINT_ ZERO;
+
+	POINT_() { }
+	POINT_(int x, int y) : x(x), y(y) { }
+
+	bool operator == (const POINT_ &v) const { return x == v.x && y == v.y; }
+	bool operator != (const POINT_ &v) const { return x != v.x || y != v.y; }
+
+	POINT_ operator - () const { return POINT_(-x, -y); }
+	POINT_ operator + (const POINT_ &v) const { return POINT_(x+v.x, y+v.y); }
+	POINT_ operator - (const POINT_ &v) const { return POINT_(x-v.x, y-v.y); }
+	POINT_ & operator += (const POINT_ &v) { x += v.x; y += v.y; return *this; }
+	POINT_ & operator -= (const POINT_ &v) { x -= v.x; y -= v.y; return *this; }
+	POINT_ & operator *= (int v) { x *= v; y *= v; return *this; }
+	POINT_ & operator /= (int v) { x /= v; y /= v; return *this; }
+
+	int & operator [] (size_t Index) { return v[Index]; }
+	const int & operator [] (size_t Index) const { return v[Index]; }
+
+	int * GetArray() { return &x; }
+	const int * GetArray() const { return &x; }
+};
+
+inline POINT_ operator * (const POINT_ &pt, int v) { return POINT_(pt.x*v, pt.y*v); }
+inline POINT_ operator / (const POINT_ &pt, int v) { return POINT_(pt.x/v, pt.y/v); }
+inline POINT_ operator * (int v, const POINT_ &pt) { return POINT_(pt.x*v, pt.y*v); }
+inline POINT_ operator / (int v, const POINT_ &pt) { return POINT_(pt.x/v, pt.y/v); }
+
+#ifdef _WIN32
+	/// Konwersja z common::POINT_ do POINT
+	template <> inline ::POINT & math_cast<::POINT, POINT_>(const POINT_ &x) { return (::POINT&)(x); }
+	/// Konwersja z POINT do common::POINT_
+	template <> inline POINT_ & math_cast<POINT_, ::POINT>(const ::POINT &x) { return (POINT_&)(x); }
+#endif
+
+extern const common::POINT_ POINT_ZERO;
+extern const common::POINT_ POINT_ONE;
+extern const common::POINT_ POINT_NEGATIVE_X;
+extern const common::POINT_ POINT_NEGATIVE_Y;
+extern const common::POINT_ POINT_POSITIVE_X;
+extern const common::POINT_ POINT_POSITIVE_Y;
+
+inline void swap(POINT_ &v1, POINT_ &v2)
+{
+	std::swap(v1.x, v2.x);
+	std::swap(v1.y, v2.y);
+}
+
+inline void Mul(POINT_ *out, const POINT_ &p1, const POINT_ &p2)
+{
+	out->x = p1.x * p2.x;
+	out->y = p1.y * p2.y;
+}
+inline void Div(POINT_ *out, const POINT_ &p1, const POINT_ &p2)
+{
+	out->x = p1.x / p2.x;
+	out->y = p1.y / p2.y;
+}
+
+inline void Mul(POINT_ *inout, const POINT_ &v)
+{
+	inout->x *= v.x;
+	inout->y *= v.y;
+}
+inline void Div(POINT_ *inout, const POINT_ &v)
+{
+	inout->x /= v.x;
+	inout->y /= v.y;
+}
+
+inline void Min(common::POINT_ *out, const common::POINT_ &a, const common::POINT_ &b)
+{
+	out->x = std::min(a.x, b.x);
+	out->y = std::min(a.y, b.y);
+}
+
+inline void Max(common::POINT_ *out, const common::POINT_ &a, const common::POINT_ &b)
+{
+	out->x = std::max(a.x, b.x);
+	out->y = std::max(a.y, b.y);
+}
+
+//@}
+// math_point
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+/** \addtogroup math_vec Wektor floatów 2D, 3D, 4D */
+//@{
+
+#if defined(USE_DIRECTX) && !defined(DOXYGEN)
+	typedef D3DXVECTOR2 VEC2;
+#else
+	/// Wektor floatów 2D
+	struct VEC2
+	{
+		float x, y;
+
+		VEC2() { }
+		VEC2(float x, float y) : x(x), y(y) { }
+		VEC2(const float *Array) : x(Array[0]), y(Array[1]) { }
+
+		operator float * () { return &x; }
+		operator const float * () const { return &x; }
+
+		bool operator == (const VEC2 &v) const { return x == v.x && y == v.y; }
+		bool operator != (const VEC2 &v) const { return x != v.x || y != v.y; }
+
+		VEC2 operator + () const { return *this; }
+		VEC2 operator - () const { return VEC2(-x, -y); }
+		VEC2 operator + (const VEC2 &v) const { return VEC2(x+v.x, y+v.y); }
+		VEC2 operator - (const VEC2 &v) const { return VEC2(x-v.x, y-v.y); }
+		VEC2 & operator += (const VEC2 &v) { x += v.x; y += v.y; return *this; }
+		VEC2 & operator -= (const VEC2 &v) { x -= v.x; y -= v.y; return *this; }
+		VEC2 & operator *= (float v) { x *= v; y *= v; return *this; }
+		VEC2 & operator /= (float v) { float vInv = 1.0f/v; x *= vInv; y *= vInv; return *this; }
+	};
+	inline VEC2 operator * (const VEC2 &pt, float v) { return VEC2(pt.x*v, pt.y*v); }
+	inline VEC2 operator / (const VEC2 &pt, float v) { float vInv = 1.0f/v; return VEC2(pt.x*vInv, pt.y*vInv); }
+	inline VEC2 operator * (float v, const VEC2 &pt) { return VEC2(pt.x*v, pt.y*v); }
+#endif
+
+inline void swap(VEC2 &v1, VEC2 &v2)
+{
+	std::swap(v1.x, v2.x);
+	std::swap(v1.y, v2.y);
+}
+
+#if defined(USE_DIRECTX) && !defined(DOXYGEN)
+	typedef D3DXVECTOR3 VEC3;
+#else
+	/// Wektor floatów 3D
+	struct VEC3
+	{
+		float x, y, z;
+
+		VEC3() { }
+		VEC3(float x, float y, float z) : x(x), y(y), z(z) { }
+		VEC3(const float *Array) : x(Array[0]), y(Array[1]), z(Array[2]) { }
+
+		operator float * () { return &x; }
+		operator const float * () const { return &x; }
+
+		bool operator == (const VEC3 &v) const { return x == v.x && y == v.y && z == v.z; }
+		bool operator != (const VEC3 &v) const { return x != v.x || y != v.y || z != v.z; }
+
+		VEC3 operator + () const { return *this; }
+		VEC3 operator - () const { return VEC3(-x, -y, -z); }
+		VEC3 operator + (const VEC3 &v) const { return VEC3(x+v.x, y+v.y, z+v.z); }
+		VEC3 operator - (const VEC3 &v) const { return VEC3(x-v.x, y-v.y, z-v.z); }
+		VEC3 & operator += (const VEC3 &v) { x += v.x; y += v.y; z += v.z; return *this; }
+		VEC3 & operator -= (const VEC3 &v) { x -= v.x; y -= v.y; z -= v.z; return *this; }
+		VEC3 & operator *= (float v) { x *= v; y *= v; z *= v; return *this; }
+		VEC3 & operator /= (float v) { float vInv = 1.0f/v; x *= vInv; y *= vInv; z *= vInv; return *this; }
+	};
+	inline VEC3 operator * (const VEC3 &pt, float v) { return VEC3(pt.x*v, pt.y*v, pt.z*v); }
+	inline VEC3 operator / (const VEC3 &pt, float v) { float vInv = 1.0f/v; return VEC3(pt.x*vInv, pt.y*vInv, pt.z*vInv); }
+	inline VEC3 operator * (float v, const VEC3 &pt) { return VEC3(pt.x*v, pt.y*v, pt.z*v); }
+#endif
+
+inline void swap(VEC3 &v1, VEC3 &v2)
+{
+	std::swap(v1.x, v2.x);
+	std::swap(v1.y, v2.y);
+	std::swap(v1.z, v2.z);
+}
+
+#if defined(USE_DIRECTX) && !defined(DOXYGEN)
+	typedef D3DXVECTOR4 VEC4;
+#else
+	/// Wektor floatów 4D
+	struct VEC4
+	{
+		float x, y, z, w;
+
+		VEC4() { }
+		VEC4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) { }
+		VEC4(const float *Array) : x(Array[0]), y(Array[1]), z(Array[2]), w(Array[3]) { }
+
+		operator float * () { return &x; }
+		operator const float * () const { return &x; }
+
+		bool operator == (const VEC4 &v) const { return x == v.x && y == v.y && z == v.z && w == v.w; }
+		bool operator != (const VEC4 &v) const { return x != v.x || y != v.y || z != v.z || w != v.w; }
+
+		VEC4 operator + () const { return *this; }
+		VEC4 operator - () const { return VEC4(-x, -y, -z, -w); }
+		VEC4 operator + (const VEC4 &v) const { return VEC4(x+v.x, y+v.y, z+v.z, w+v.w); }
+		VEC4 operator - (const VEC4 &v) const { return VEC4(x-v.x, y-v.y, z-v.z, w-v.w); }
+		VEC4 & operator += (const VEC4 &v) { x += v.x; y += v.y; z += v.z; w += v.w; return *this; }
+		VEC4 & operator -= (const VEC4 &v) { x -= v.x; y -= v.y; z -= v.z; w -= v.w; return *this; }
+		VEC4 & operator *= (float v) { x *= v; y *= v; z *= v; w *= v; return *this; }
+		VEC4 & operator /= (float v) { float vInv = 1.0f/v; x *= vInv; y *= vInv; z *= vInv; w *= vInv; return *this; }
+	};
+	inline VEC4 operator * (const VEC4 &pt, float v) { return VEC4(pt.x*v, pt.y*v, pt.z*v, pt.w*v); }
+	inline VEC4 operator / (const VEC4 &pt, float v) { float vInv = 1.0f/v; return VEC4(pt.x*vInv, pt.y*vInv, pt.z*vInv, pt.w*vInv); }
+	inline VEC4 operator * (float v, const VEC4 &pt) { return VEC4(pt.x*v, pt.y*v, pt.z*v, pt.w*v); }
+#endif
+
+inline void swap(VEC4 &v1, VEC4 &v2)
+{
+	std::swap(v1.x, v2.x);
+	std::swap(v1.y, v2.y);
+	std::swap(v1.z, v2.z);
+	std::swap(v1.w, v2.w);
+}
+
+extern const VEC2 VEC2_ZERO;
+extern const VEC2 VEC2_ONE;
+extern const VEC2 VEC2_POSITIVE_X;
+extern const VEC2 VEC2_POSITIVE_Y;
+extern const VEC2 VEC2_NEGATIVE_X;
+extern const VEC2 VEC2_NEGATIVE_Y;
+
+extern const VEC3 VEC3_ZERO;
+extern const VEC3 VEC3_ONE;
+extern const VEC3 VEC3_POSITIVE_X;
+extern const VEC3 VEC3_POSITIVE_Y;
+extern const VEC3 VEC3_POSITIVE_Z;
+extern const VEC3 VEC3_NEGATIVE_X;
+extern const VEC3 VEC3_NEGATIVE_Y;
+extern const VEC3 VEC3_NEGATIVE_Z;
+
+extern const VEC4 VEC4_ZERO;
+extern const VEC4 VEC4_ONE;
+extern const VEC4 VEC4_POSITIVE_X;
+extern const VEC4 VEC4_POSITIVE_Y;
+extern const VEC4 VEC4_POSITIVE_Z;
+extern const VEC4 VEC4_POSITIVE_W;
+extern const VEC4 VEC4_NEGATIVE_X;
+extern const VEC4 VEC4_NEGATIVE_Y;
+extern const VEC4 VEC4_NEGATIVE_Z;
+extern const VEC4 VEC4_NEGATIVE_W;
+
+/// Zwraca kwadrat długości wektora
+inline float LengthSq(const VEC2 &v)
+{
+	return v.x*v.x + v.y*v.y;
+}
+/// \copydoc LengthSq(const VEC2&)
+inline float LengthSq(const VEC3 &v)
+{
+	return v.x*v.x + v.y*v.y + v.z*v.z;
+}
+/// \copydoc LengthSq(const VEC2&)
+inline float LengthSq(const VEC4 &v)
+{
+	return v.x*v.x + v.y*v.y + v.z*v.z + v.w*v.w;
+}
+
+/// Zwraca długość wektora
+inline float Length(const VEC2 &v)
+{
+	return sqrtf(LengthSq(v));
+}
+/// \copydoc Length(const VEC2&)
+inline float Length(const VEC3 &v)
+{
+	return sqrtf(LengthSq(v));
+}
+/// \copydoc Length(const VEC2&)
+inline float Length(const VEC4 &v)
+{
+	return sqrtf(LengthSq(v));
+}
+
+inline float ManhattanLength(const VEC2 &v)
+{
+	return fabsf(v.x) + fabsf(v.y);
+}
+inline float ManhattanLength(const VEC3 &v)
+{
+	return fabsf(v.x) + fabsf(v.y) + fabsf(v.z);
+}
+inline float ManhattanLength(const VEC4 &v)
+{
+	return fabsf(v.x) + fabsf(v.y) + fabsf(v.z) + fabsf(v.z);
+}
+
+inline float MaxLength(const VEC2 &v)
+{
+	return std::max(fabsf(v.x), fabsf(v.y));
+}
+inline float MaxLength(const VEC3 &v)
+{
+	return max3(fabsf(v.x), fabsf(v.y), fabsf(v.z));
+}
+inline float MaxLength(const VEC4 &v)
+{
+	return std::max(
+		std::max(fabsf(v.x), fabsf(v.y)),
+		std::max(fabsf(v.z), fabsf(v.z)) );
+}
+
+/// Zwraca wektor złożony z mniejszych składowych podanych wektorów
+inline void Min(VEC2 *Out, const VEC2 &v1, const VEC2 &v2)
+{
+	Out->x = std::min(v1.x, v2.x);
+	Out->y = std::min(v1.y, v2.y);
+}
+inline void Min(VEC3 *Out, const VEC3 &v1, const VEC3 &v2)
+{
+	Out->x = std::min(v1.x, v2.x);
+	Out->y = std::min(v1.y, v2.y);
+	Out->z = std::min(v1.z, v2.z);
+}
+inline void Min(VEC4 *Out, const VEC4 &v1, const VEC4 &v2)
+{
+	Out->x = std::min(v1.x, v2.x);
+	Out->y = std::min(v1.y, v2.y);
+	Out->z = std::min(v1.z, v2.z);
+	Out->w = std::min(v1.w, v2.w);
+}
+
+/// Zwraca wektor złożony z większych składowych podanych wektorów
+inline void Max(VEC2 *Out, const VEC2 &v1, const VEC2 &v2)
+{
+	Out->x = std::max(v1.x, v2.x);
+	Out->y = std::max(v1.y, v2.y);
+}
+inline void Max(VEC3 *Out, const VEC3 &v1, const VEC3 &v2)
+{
+	Out->x = std::max(v1.x, v2.x);
+	Out->y = std::max(v1.y, v2.y);
+	Out->z = std::max(v1.z, v2.z);
+}
+inline void Max(VEC4 *Out, const VEC4 &v1, const VEC4 &v2)
+{
+	Out->x = std::max(v1.x, v2.x);
+	Out->y = std::max(v1.y, v2.y);
+	Out->z = std::max(v1.z, v2.z);
+	Out->w = std::max(v1.w, v2.w);
+}
+
+inline void saturate(VEC2 &v)
+{
+	v.x = saturate(v.x); v.y = saturate(v.y);
+}
+inline void saturate(VEC3 &v)
+{
+	v.x = saturate(v.x); v.y = saturate(v.y); v.z = saturate(v.z);
+}
+inline void saturate(VEC4 &v)
+{
+	v.x = saturate(v.x); v.y = saturate(v.y); v.z = saturate(v.z); v.w = saturate(v.w);
+}
+
+/** \addtogroup math_vec_componentop Operacje na poszczególnych składowych wektorów */
+//@{
+
+inline void Mul(VEC2 *Out, const VEC2 &v, float f)
+{
+	Out->x = v.x * f;
+	Out->y = v.y * f;
+}
+inline void Mul(VEC3 *Out, const VEC3 &v, float f)
+{
+	Out->x = v.x * f;
+	Out->y = v.y * f;
+	Out->z = v.z * f;
+}
+inline void Mul(VEC4 *Out, const VEC4 &v, float f)
+{
+	Out->x = v.x * f;
+	Out->y = v.y * f;
+	Out->z = v.z * f;
+	Out->w = v.w * f;
+}
+
+inline void Add(VEC2 *Out, const VEC2 &v1, const VEC2 &v2)
+{
+	Out->x = v1.x + v2.x;
+	Out->y = v1.y + v2.y;
+}
+inline void Add(VEC3 *Out, const VEC3 &v1, const VEC3 &v2)
+{
+	Out->x = v1.x + v2.x;
+	Out->y = v1.y + v2.y;
+	Out->z = v1.z + v2.z;
+}
+inline void Add(VEC4 *Out, const VEC4 &v1, const VEC4 &v2)
+{
+	Out->x = v1.x + v2.x;
+	Out->y = v1.y + v2.y;
+	Out->z = v1.z + v2.z;
+	Out->w = v1.w + v2.w;
+}
+
+inline void Sub(VEC2 *Out, const VEC2 &v1, const VEC2 &v2)
+{
+	Out->x = v1.x - v2.x;
+	Out->y = v1.y - v2.y;
+}
+inline void Sub(VEC3 *Out, const VEC3 &v1, const VEC3 &v2)
+{
+	Out->x = v1.x - v2.x;
+	Out->y = v1.y - v2.y;
+	Out->z = v1.z - v2.z;
+}
+inline void Sub(VEC4 *Out, const VEC4 &v1, const VEC4 &v2)
+{
+	Out->x = v1.x - v2.x;
+	Out->y = v1.y - v2.y;
+	Out->z = v1.z - v2.z;
+	Out->w = v1.w - v2.w;
+}
+
+inline void Mul(VEC2 *Out, const VEC2 &v1, const VEC2 &v2)
+{
+	Out->x = v1.x * v2.x;
+	Out->y = v1.y * v2.y;
+}
+inline void Mul(VEC3 *Out, const VEC3 &v1, const VEC3 &v2)
+{
+	Out->x = v1.x * v2.x;
+	Out->y = v1.y * v2.y;
+	Out->z = v1.z * v2.z;
+}
+inline void Mul(VEC4 *Out, const VEC4 &v1, const VEC4 &v2)
+{
+	Out->x = v1.x * v2.x;
+	Out->y = v1.y * v2.y;
+	Out->z = v1.z * v2.z;
+	Out->w = v1.w * v2.w;
+}
+
+inline void Div(VEC2 *Out, const VEC2 &v1, const VEC2 &v2)
+{
+	Out->x = v1.x / v2.x;
+	Out->y = v1.y / v2.y;
+}
+inline void Div(VEC3 *Out, const VEC3 &v1, const VEC3 &v2)
+{
+	Out->x = v1.x / v2.x;
+	Out->y = v1.y / v2.y;
+	Out->z = v1.z / v2.z;
+}
+inline void Div(VEC4 *Out, const VEC4 &v1, const VEC4 &v2)
+{
+	Out->x = v1.x / v2.x;
+	Out->y = v1.y / v2.y;
+	Out->z = v1.z / v2.z;
+	Out->w = v1.w / v2.w;
+}
+
+inline void Mul(VEC2 *inout, const VEC2 &v)
+{
+	inout->x *= v.x;
+	inout->y *= v.y;
+}
+inline void Mul(VEC3 *inout, const VEC3 &v)
+{
+	inout->x *= v.x;
+	inout->y *= v.y;
+	inout->z *= v.z;
+}
+inline void Mul(VEC4 *inout, const VEC4 &v)
+{
+	inout->x *= v.x;
+	inout->y *= v.y;
+	inout->z *= v.z;
+	inout->w *= v.w;
+}
+
+inline void Div(VEC2 *inout, const VEC2 &v)
+{
+	inout->x /= v.x;
+	inout->y /= v.y;
+}
+inline void Div(VEC3 *inout, const VEC3 &v)
+{
+	inout->x /= v.x;
+	inout->y /= v.y;
+	inout->z /= v.z;
+}
+inline void Div(VEC4 *inout, const VEC4 &v)
+{
+	inout->x /= v.x;
+	inout->y /= v.y;
+	inout->z /= v.z;
+	inout->w /= v.w;
+}
+
+inline void Abs(VEC2 *v) { v->x = fabsf(v->x); v->y = fabsf(v->y); }
+inline void Abs(VEC3 *v) { v->x = fabsf(v->x); v->y = fabsf(v->y); v->z = fabsf(v->z); }
+inline void Abs(VEC4 *v) { v->x = fabsf(v->x); v->y = fabsf(v->y); v->z = fabsf(v->z); v->w = fabsf(v->w); }
+
+//@}
+// math_vec_componentop
+
+/// Iloczyn skalarny wektorów
+inline float Dot(const VEC2 &v1, const VEC2 &v2)
+{
+	return v1.x*v2.x + v1.y*v2.y;
+}
+inline float Dot(const VEC3 &v1, const VEC3 &v2)
+{
+	return v1.x*v2.x + v1.y*v2.y + v1.z*v2.z;
+}
+inline float Dot(const VEC4 &v1, const VEC4 &v2)
+{
+	return v1.x*v2.x + v1.y*v2.y + v1.z*v2.z + v1.w*v2.w;
+}
+
+/// Odwraca znak składowych wektora
+inline void Minus(VEC2 *Out, VEC2 &v) { Out->x = -v.x; Out->y = -v.y; }
+inline void Minus(VEC3 *Out, VEC3 &v) { Out->x = -v.x; Out->y = -v.y; Out->z = -v.z; }
+inline void Minus(VEC4 *Out, VEC4 &v) { Out->x = -v.x; Out->y = -v.y; Out->z = -v.z; Out->w = -v.w; }
+inline void Minus(VEC2 *InOut) { InOut->x = -InOut->x; InOut->y = -InOut->y; }
+inline void Minus(VEC3 *InOut) { InOut->x = -InOut->x; InOut->y = -InOut->y; InOut->z = -InOut->z; }
+inline void Minus(VEC4 *InOut) { InOut->x = -InOut->x; InOut->y = -InOut->y; InOut->z = -InOut->z; InOut->w = -InOut->w; }
+
+/// Iloczyn wektorowy dwóch wektorów dający liczbę mówiącą czy drugi wskazuje na lewo, czy na prawo względem pierwszego
+/** W układzie gdzie X jest w prawo a Y do góry, > 0 znaczy na lewo \n
+W układzie gdzie X jest w prawo a Y w dół, > 0 znaczy na prawo */
+inline float Cross(const VEC2 &v1, const VEC2 &v2)
+{
+	return v1.x*v2.y - v1.y*v2.x;
+}
+
+/// Iloczyn wektorowy dwóch wektorów 3D
+inline void Cross(VEC3 *Out, const VEC3 &v1, const VEC3 &v2)
+{
+	Out->x = v1.y * v2.z - v1.z * v2.y;
+	Out->y = v1.z * v2.x - v1.x * v2.z;
+	Out->z = v1.x * v2.y - v1.y * v2.x;
+}
+
+/// Kwadrat odległości między dwoma punktami
+inline float DistanceSq(const VEC2 &p1, const VEC2 &p2)
+{
+	return LengthSq(p2-p1);
+}
+inline float DistanceSq(const VEC3 &p1, const VEC3 &p2)
+{
+	return LengthSq(p2-p1);
+}
+inline float DistanceSq(const VEC4 &p1, const VEC4 &p2)
+{
+	return LengthSq(p2-p1);
+}
+
+/// Odległość między dwoma punktami
+inline float Distance(const VEC2 &p1, const VEC2 &p2)
+{
+	return Length(p2-p1);
+}
+inline float Distance(const VEC3 &p1, const VEC3 &p2)
+{
+	return Length(p2-p1);
+}
+inline float Distance(const VEC4 &p1, const VEC4 &p2)
+{
+	return Length(p2-p1);
+}
+
+inline float ManhattanDistance(const VEC2 &p1, const VEC2 &p2)
+{
+	return fabsf(p2.x-p1.x) + fabsf(p2.y-p1.y);
+}
+inline float ManhattanDistance(const VEC3 &p1, const VEC3 &p2)
+{
+	return fabsf(p2.x-p1.x) + fabsf(p2.y-p1.y) + fabsf(p2.z-p1.z);
+}
+inline float ManhattanDistance(const VEC4 &p1, const VEC4 &p2)
+{
+	return fabsf(p2.x-p1.x) + fabsf(p2.y-p1.y) + fabsf(p2.z-p1.z) + fabsf(p2.w-p1.w);
+}
+
+inline float MaxDistance(const VEC2 &p1, const VEC2 &p2)
+{
+	return std::max( fabsf(p2.x-p1.x), fabsf(p2.y-p1.y) );
+}
+inline float MaxDistance(const VEC3 &p1, const VEC3 &p2)
+{
+	return max3( fabsf(p2.x-p1.x), fabsf(p2.y-p1.y), fabsf(p2.z-p1.z) );
+}
+inline float MaxDistance(const VEC4 &p1, const VEC4 &p2)
+{
+	return std::max(
+		std::max( fabsf(p2.x-p1.x), fabsf(p2.y-p1.y) ),
+		std::max( fabsf(p2.z-p1.z), fabsf(p2.w-p1.w) ) );
+}
+
+/// Liniowa interpolacja wektorów
+inline void Lerp(VEC2 *Out, const VEC2 &v1, const VEC2 &v2, float t)
+{
+	Out->x = v1.x + t*(v2.x-v1.x);
+	Out->y = v1.y + t*(v2.y-v1.y);
+}
+inline void Lerp(VEC3 *Out, const VEC3 &v1, const VEC3 &v2, float t)
+{
+	Out->x = v1.x + t*(v2.x-v1.x);
+	Out->y = v1.y + t*(v2.y-v1.y);
+	Out->z = v1.z + t*(v2.z-v1.z);
+}
+inline void Lerp(VEC4 *Out, const VEC4 &v1, const VEC4 &v2, float t)
+{
+	Out->x = v1.x + t*(v2.x-v1.x);
+	Out->y = v1.y + t*(v2.y-v1.y);
+	Out->z = v1.z + t*(v2.z-v1.z);
+	Out->w = v1.w + t*(v2.w-v1.w);
+}
+
+/// Normalizuje wektor, czyli zmienia mu długość na 1
+inline void Normalize(VEC2 *Out, const VEC2 &v)
+{
+	float l = 1.0f / Length(v);
+	Out->x = v.x * l;
+	Out->y = v.y * l;
+}
+inline void Normalize(VEC3 *Out, const VEC3 &v)
+{
+	float l = 1.0f / Length(v);
+	Out->x = v.x * l;
+	Out->y = v.y * l;
+	Out->z = v.z * l;
+}
+inline void Normalize(VEC4 *Out, const VEC4 &v)
+{
+	float l = 1.0f / Length(v);
+	Out->x = v.x * l;
+	Out->y = v.y * l;
+	Out->z = v.z * l;
+	Out->w = v.w * l;
+}
+
+/// Normalizuje wektor w miejscu
+inline void Normalize(VEC2 *v)
+{
+	float rcl = 1.0f / Length(*v);
+	v->x *= rcl;
+	v->y *= rcl;
+}
+inline void Normalize(VEC3 *v)
+{
+	float rcl = 1.0f / Length(*v);
+	v->x *= rcl;
+	v->y *= rcl;
+	v->z *= rcl;
+}
+inline void Normalize(VEC4 *v)
+{
+	float rcl = 1.0f / Length(*v);
+	v->x *= rcl;
+	v->y *= rcl;
+	v->z *= rcl;
+	v->w *= rcl;
+}
+
+/// Bezpieczna normalizacja wektora w miejscu. W przypadku wektora zerowego zwraca false.
+inline bool SafeNormalize(VEC2 *v)
+{
+	float lenSq = LengthSq(*v);
+	if (lenSq < FLOAT_EPSILON) return false;
+	float f = 1.f / sqrtf(lenSq);
+	v->x *= f; v->y *= f;
+	return true;
+}
+inline bool SafeNormalize(VEC3 *v)
+{
+	float lenSq = LengthSq(*v);
+	if (lenSq < FLOAT_EPSILON) return false;
+	float f = 1.f / sqrtf(lenSq);
+	v->x *= f; v->y *= f; v->z *= f;
+	return true;
+}
+inline bool SafeNormalize(VEC4 *v)
+{
+	float lenSq = LengthSq(*v);
+	if (lenSq < FLOAT_EPSILON) return false;
+	float f = 1.f / sqrtf(lenSq);
+	v->x *= f; v->y *= f; v->z *= f; v->w *= f;
+	return true;
+}
+
+/// Konwersja z wektora 3D na 4D dopisująca W=1
+inline void Vec3ToVec4(VEC4 *Out, const VEC3 &v)
+{
+	Out->x = v.x;
+	Out->y = v.y;
+	Out->z = v.z;
+	Out->w = 1.0f;
+}
+
+/// Konwersja z wektora 4D na 3D ze zignorowaniem składowej W
+inline void Vec4ToVec3_Ignore(VEC3 *Out, const VEC4 &v)
+{
+	Out->x = v.x;
+	Out->y = v.y;
+	Out->z = v.z;
+}
+/// Konwersja z wektora 4D na 3D ze podzieleniem składowych przez W
+inline void Vec4ToVec3_Div(VEC3 *Out, const VEC4 &v)
+{
+	float rcw = 1.0f / v.w;
+	Out->x = v.x * rcw;
+	Out->y = v.y * rcw;
+	Out->z = v.z * rcw;
+}
+
+/// Zwraca punkt w połowie drogi między podanymi punktami
+inline void MidPoint(VEC2 *Out, const VEC2 &p1, const VEC2 &p2)
+{
+	Out->x = (p1.x+p2.x) * 0.5f;
+	Out->y = (p1.y+p2.y) * 0.5f;
+}
+inline void MidPoint(VEC3 *Out, const VEC3 &p1, const VEC3 &p2)
+{
+	Out->x = (p1.x+p2.x) * 0.5f;
+	Out->y = (p1.y+p2.y) * 0.5f;
+	Out->z = (p1.z+p2.z) * 0.5f;
+}
+inline void MidPoint(VEC4 *Out, const VEC4 &p1, const VEC4 &p2)
+{
+	Out->x = (p1.x+p2.x) * 0.5f;
+	Out->y = (p1.y+p2.y) * 0.5f;
+	Out->z = (p1.z+p2.z) * 0.5f;
+	Out->w = (p1.w+p2.w) * 0.5f;
+}
+
+/// Zwraca true, jeśli podane wektory/punkty są sobie mniej więcej równe
+inline bool VecEqual(const VEC2 &v1, const VEC2 &v2) {
+	return float_equal(v1.x, v2.x) && float_equal(v1.y, v2.y);
+}
+inline bool VecEqual(const VEC3 &v1, const VEC3 &v2) {
+	return float_equal(v1.x, v2.x) && float_equal(v1.y, v2.y) && float_equal(v1.z, v2.z);
+}
+inline bool VecEqual(const VEC4 &v1, const VEC4 &v2) {
+	return float_equal(v1.x, v2.x) && float_equal(v1.y, v2.y) && float_equal(v1.z, v2.z) && float_equal(v1.w, v2.w);
+}
+
+inline bool around(const VEC2 &v1, const VEC2 &v2, float Epsilon) {
+	return around(v1.x, v2.x, Epsilon) && around(v1.y, v2.y, Epsilon);
+}
+inline bool around(const VEC3 &v1, const VEC3 &v2, float Epsilon) {
+	return around(v1.x, v2.x, Epsilon) && around(v1.y, v2.y, Epsilon) && around(v1.z, v2.z, Epsilon);
+}
+inline bool around(const VEC4 &v1, const VEC4 &v2, float Epsilon) {
+	return around(v1.x, v2.x, Epsilon) && around(v1.y, v2.y, Epsilon) && around(v1.z, v2.z, Epsilon) && around(v1.w, v2.w, Epsilon);
+}
+
+/// Zwraca wektor prostopadły do podanego wektora 2D
+/** W układzie w którym X jest w prawo a Y do góry wektor leży na lewo od danego.
+W układzie w którym X jest w prawo a Y w dół, leży na prawo. */
+inline void Perpedicular(VEC2 *Out, const VEC2 &v)
+{
+	Out->x = -v.y;
+	Out->y = v.x;
+}
+
+/// Oblicza wektor kierunku odbicia od płaszczyzny o podanej normalnej
+/**
+\param v wskazuje na kierunek *do* tej płaszczyzny.
+\param PlaneNormal musi być znormalizowany.
+*/
+inline void Reflect(VEC2 *Out, const VEC2 &v, const VEC2 &PlaneNormal)
+{
+	*Out = v - (2.0f * Dot(v, PlaneNormal)) * PlaneNormal;
+}
+inline void Reflect(VEC3 *Out, const VEC3 &v, const VEC3 &PlaneNormal)
+{
+	*Out = v - (2.0f * Dot(v, PlaneNormal)) * PlaneNormal;
+}
+
+/// For the incident vector I and surface normal N, and the ratio of indices of refraction eta, return the refraction vector.
+/** The input parameters for the incident vector I and the surface normal N must
+already be normalized to get the desired results.
+*/
+inline void Refract(VEC2 *out, const VEC2 &I, const VEC2 &N, float eta)
+{
+	float N_dot_I = Dot(N, I);
+	float k = 1.f - eta * eta * (1.f - N_dot_I * N_dot_I);
+	if (k < 0.f)
+		*out = VEC2_ZERO;
+	else
+		*out = eta * I - (eta * N_dot_I + sqrtf(k)) * N;
+}
+/// \copydoc Refract(VEC2, const VEC2&, const VEC2&, float)
+inline void Refract(VEC3 *out, const VEC3 &I, const VEC3 &N, float eta)
+{
+	float N_dot_I = Dot(N, I);
+	float k = 1.f - eta * eta * (1.f - N_dot_I * N_dot_I);
+	if (k < 0.f)
+		*out = VEC3_ZERO;
+	else
+		*out = eta * I - (eta * N_dot_I + sqrtf(k)) * N;
+}
+
+/// Rzutowanie wektora V na wektor N
+/** Jeśli chcemy rozłożyć wektor V na wektor prostopadły i równoległy do N,
+to wektorem równoległym jest Out, a prostopadły obliczamy jako V - Out.
+\param[out] Out Będzie równoległy do N. */
+inline void Project(VEC2 *Out, const VEC2 &V, const VEC2 &N)
+{
+	// Oryginalnie:
+	// *Out = N * ( Dot(V, N) / LengthSq(N) );
+	// Wersja szybsza:
+	float T = (V.x*N.x + V.y*N.y) / (N.x*N.x + N.y*N.y);
+	Out->x = N.x * T;
+	Out->y = N.y * T;
+}
+inline void Project(VEC3 *Out, const VEC3 &V, const VEC3 &N)
+{
+	float T = (V.x*N.x + V.y*N.y + V.z*N.z) / (N.x*N.x + N.y*N.y + N.z*N.z);
+	Out->x = N.x * T;
+	Out->y = N.y * T;
+	Out->z = N.z * T;
+}
+/// Wersja common::Project, kiedy wektor N jest już na pewno znormalizowany.
+inline void Project_N(VEC2 *Out, const VEC2 &V, const VEC2 &N)
+{
+	// Oryginalnie:
+	// *Out = N * Dot(V, N);
+	// Wersja szybsza:
+	float T = V.x*N.x + V.y*N.y;
+	Out->x = N.x * T;
+	Out->y = N.y * T;
+}
+inline void Project_N(VEC3 *Out, const VEC3 &V, const VEC3 &N)
+{
+	float T = V.x*N.x + V.y*N.y + V.z*N.z;
+	Out->x = N.x * T;
+	Out->y = N.y * T;
+	Out->z = N.z * T;
+}
+
+/// Oblicza: u cross v dot w
+inline float ScalarTripleProduct(const VEC3 &u, const VEC3 &v, const VEC3 &w)
+{
+	return u.x * (v.y * w.z - v.z * w.y) - u.y * (v.x * w.z - v.z * w.x) + u.z * (v.x * w.y - v.y * w.x);
+}
+
+/** \addtogroup math_vec_orthogonalisation Ortogonalizacja trzech wektorów
+- Po tym przekształceniu będą do siebie prostopadłe.
+- Wektory wejściowe nie muszą być znormalizowane.
+- Wektory wyjściowe niekoniecznie będą znormalizowane (nawet jeśli wejściowe były).
+*/
+//@{
+/// Ortogonalizacja trzech wektorów - Metoda szybka
+void Orthogonalize_Fast(VEC3 *OutR1, VEC3 *OutR2, VEC3 *OutR3, const VEC3 &R1, const VEC3 &R2, const VEC3 &R3);
+/// Ortogonalizacja trzech wektorów - Metoda dokładna
+void Orthogonalize(VEC3 *OutR1, VEC3 *OutR2, VEC3 *OutR3, const VEC3 &R1, const VEC3 &R2, const VEC3 &R3);
+//@}
+
+/// Wyznacza dwa dowolne wektory prostopadłe do podanego
+/** Zwrócone wektory nie są znormalizowane.
+\param v nie musi być znormalizowany. */
+void PerpedicularVectors(VEC3 *Out1, VEC3 *Out2, const VEC3 &v);
+
+//@}
+// math_vec
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+/** \addtogroup math_triangle Trójkąt */
+//@{
+
+/// Oblicza signed pole powierzchni trójkąta
+/** Wychodzi dodanie, kiedy wierzchołki są CW. */
+float TriangleArea(const VEC2 &p1, const VEC2 &p2, const VEC2 &p3);
+float TriangleArea(const VEC3 &p1, const VEC3 &p2, const VEC3 &p3);
+
+/// Zwraca true, jeśli wierzchołki trójkąta są CW.
+bool TriangleIsCW(const VEC2 &p1, const VEC2 &p2, const VEC2 &p3);
+
+/// Znajduje obwód trójkąta
+float TrianglePerimeter(const VEC2 &p1, const VEC2 &p2, const VEC2 &p3);
+float TrianglePerimeter(const VEC3 &p1, const VEC3 &p2, const VEC3 &p3);
+
+/// Oblicza punkt na powierzhchni trójkąta we wsp. barycentrycznych
+/** f to waga punktu p2, g to waga punktu p3. \n
+Wzór: *Out = p1 + f*(p2-p1) + g*(p3-p1) \n
+Inny wzór: *Out = p1*(1-f-g) + p2*f + p3*g */
+inline void Barycentric(VEC2 *Out, const VEC2 &p1, const VEC2 &p2, const VEC2 &p3, float f, float g)
+{
+	float e = 1.0f-f-g;
+	Out->x = e*p1.x + f*p2.x + g*p3.x;
+	Out->y = e*p1.y + f*p2.y + g*p3.y;
+}
+inline void Barycentric(VEC3 *Out, const VEC3 &p1, const VEC3 &p2, const VEC3 &p3, float f, float g)
+{
+	// Stara wersja, na podstawie DX SDK, dużo wolniejsza:
+	//VEC3 Diff2 = p2-p1;
+	//VEC3 Diff3 = p3-p1;
+	//Out->x = p1.x + f*Diff2.x + g*Diff3.x;
+	//Out->y = p1.y + f*Diff2.y + g*Diff3.y;
+	//Out->z = p1.z + f*Diff2.z + g*Diff3.z;
+
+	float e = 1.0f-f-g;
+	Out->x = e*p1.x + f*p2.x + g*p3.x;
+	Out->y = e*p1.y + f*p2.y + g*p3.y;
+	Out->z = e*p1.z + f*p2.z + g*p3.z;
+}
+inline void Barycentric(VEC4 *Out, const VEC4 &p1, const VEC4 &p2, const VEC4 &p3, float f, float g)
+{
+	float e = 1.0f-f-g;
+	Out->x = e*p1.x + f*p2.x + g*p3.x;
+	Out->y = e*p1.y + f*p2.y + g*p3.y;
+	Out->z = e*p1.z + f*p2.z + g*p3.z;
+	Out->w = e*p1.w + f*p2.w + g*p3.w;
+}
+
+/// Współrzędne barycentryczne punktu p względem trójkąta p1-p2-p3.
+/** Współczynniki e, f, g to wagi wierzchołków p1, p2, p3. \n
+\param out_e [out] Można podać NULL. */
+void CalcBarycentric(const VEC2 &p, const VEC2 &p1, const VEC2 &p2, const VEC2 &p3, float *out_e, float *out_f, float *out_g);
+/// Współrzędne barycentryczne punktu p względem trójkąta p1-p2-p3.
+/** Współczynniki e, f, g to wagi wierzchołków p1, p2, p3. \n
+Punkt p musi leżeć na jednej płaszczyźnie z trójkątem p1-p2-p3. \n
+Normal to wektor normalny trójkąta p1-p2-p3. Można go podać jeśli jest już wyliczony albo podać NULL. */
+void CalcBarycentric(const VEC3 &p, const VEC3 &p1, const VEC3 &p2, const VEC3 &p3, const VEC3 *Normal, float *out_e, float *out_f, float *out_g);
+
+/// Znajduje okrąg wpisany w trójkąt
+void TriangleInscribedCircle(VEC2 *OutCenter, float *OutRadius, const VEC2 &v1, const VEC2 &v2, const VEC2 &v3);
+void TriangleInscribedCircle(VEC3 *OutCenter, float *OutRadius, const VEC3 &v1, const VEC3 &v2, const VEC3 &v3);
+/// Znajduje okrąg opisany na trójkącie
+void TriangleCircumscribedCircle(VEC2 *OutCenter, float *OutRadius, const VEC2 &v1, const VEC2 &v2, const VEC2 &v3);
+void TriangleCircumscribedCircle(VEC3 *OutCenter, float *OutRadius, const VEC3 &v1, const VEC3 &v2, const VEC3 &v3);
+
+//@}
+// math_triangle
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+/** \addtogroup math_ray Promień */
+//@{
+
+/// Zwraca punkt na promieniu
+inline void PointOnRay(VEC2 *Out, const VEC2 &Origin, const VEC2 &Direction, float t)
+{
+	Out->x = Origin.x + t * Direction.x;
+	Out->y = Origin.y + t * Direction.y;
+}
+inline void PointOnRay(VEC3 *Out, const VEC3 &Origin, const VEC3 &Direction, float t)
+{
+	Out->x = Origin.x + t * Direction.x;
+	Out->y = Origin.y + t * Direction.y;
+	Out->z = Origin.z + t * Direction.z;
+}
+
+//@}
+// math_ray
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+/** \addtogroup math_rect Prostokąt */
+//@{
+
+/// Prostokąt z liczb całkowitych
+/**
+RECTI jest kompatybilny ze strukturą RECT z Win32API.
+Konwersja do i ze stringa: "left,top,right,bottom", np. "1,2,3,4".
+Niezależnie od układu współrzędnych, prawidłowy prostokąt jest wtedy, kiedy top
+jest mniejsze co do wartości od bottom, a left od right.
+*/
+struct RECTI
+{
+	POINT_ Min, Max;
+
+	RECTI() { }
+	RECTI(const POINT_ &min_, const POINT_ &max_) : Min(min_), Max(max_) { }
+	RECTI(int minX, int minY, int maxX, int maxY) : Min(minX, minY), Max(maxX, maxY) { }
+	RECTI(const int *Arr) : Min(Arr[0], Arr[1]), Max(Arr[2], Arr[3]) { }
+
+	operator int * () { return &Min.x; }
+	operator const int * () const { return &Min.x; }
+
+	bool operator == (const RECTI &r) const { return Min == r.Min && Max == r.Max; }
+	bool operator != (const RECTI &r) const { return Min != r.Min || Max != r.Max; }
+
+	RECTI operator + () const { return *this; }
+	RECTI operator - () const { return RECTI(-Max, -Min); }
+	RECTI operator + (const POINT_ &p) const { return RECTI(Min+p, Max+p); }
+	RECTI operator - (const POINT_ &p) const { return RECTI(Min-p, Max-p); }
+	RECTI operator * (int s) const { return RECTI(Min*s, Max*s); }
+	RECTI & operator += (const POINT_ &p) { Min += p; Max += p; return *this; }
+	RECTI & operator -= (const POINT_ &p) { Min -= p; Max -= p; return *this; }
+	RECTI & operator *= (int s) { Min *= s; Max *= s; return *this; }
+
+	int & left()   { return Min.x; }
+	int & top()    { return Min.y; }
+	int & right()  { return Max.x; }
+	int & bottom() { return Max.y; }
+	int left()   const { return Min.x; }
+	int top()    const { return Min.y; }
+	int right()  const { return Max.x; }
+	int bottom() const { return Max.y; }
+
+	bool IsValid() const { return Min.x < Max.x && Min.y < Max.y; }
+	void Repair()
+	{
+		if (Max.x < Min.x) std::swap(Min.x, Max.x);
+		if (Max.y < Min.y) std::swap(Min.y, Max.y);
+	}
+
+	/// Powiększa prostokąt z każdej strony o podaną wartość
+	void Extend(int d) { Min.x -= d; Min.y -= d; Max.x += d; Max.y += d; }
+	/// Oblicza i zwraca długość przekątnej
+	float Diagonal() const { return sqrtf( (float)((Max.x-Min.x)*(Max.x-Min.x)) + (float)((Max.y-Min.y)*(Max.y-Min.y)) ); }
+	/// Oblicza i zwraca pole powierzchni
+	int Field() const { return (Max.x-Min.x)*(Max.y-Min.y); }
+
+	void GetSize(POINT_ *out) const { *out = Max - Min; }
+	int GetSizeDim(uint dim) const { return Max[dim] - Min[dim]; }
+
+	void GetHalfSize(POINT_ *out) { *out = (Max - Min) / 2; }
+	int GetHalfSizeDim(uint dim) const { return (Max[dim] - Min[dim]) / 2; }
+
+	void SetSize(const POINT_ &newSize) { Max = Min + newSize; }
+	void SetSizeDim(uint dim, int newSize) { Max[dim] = Min[dim] + newSize; }
+
+	void GetCenter(POINT_ *Out) const { *Out = (Min+Max)/2; }
+	int GetCenterDim(uint dim) const { return (Min[dim]+Max[dim])/2; }
+
+	void GetCorner(POINT_ *out, uint i) const
+	{
+		out->x = (i & 1) ? Max.x : Min.x;
+		out->y = (i & 2) ? Max.y : Min.y;
+	}
+	/// Returns begin point and end point of one of rectangle edges. index must be 0..3.
+	void GetEdge(POINT_ *outP1, POINT_ *outP2, uint index) const;
+
+	void AddInternalPoint(const POINT_ &p)
+	{
+		if (p.x < Min.x) Min.x = p.x;
+		if (p.y < Min.y) Min.y = p.y;
+		if (p.x > Max.x) Max.x = p.x;
+		if (p.y > Max.y) Max.y = p.y;
+	}
+
+	void AddInternalRect(const RECTI &rect)
+	{
+		if (rect.Min.x < Min.x) Min.x = rect.Min.x;
+		if (rect.Min.y < Min.y) Min.y = rect.Min.y;
+		if (rect.Max.x > Max.x) Max.x = rect.Max.x;
+		if (rect.Max.y > Max.y) Max.y = rect.Max.y;
+	}
+};
+
+extern const RECTI RECTI_ZERO;
+extern const RECTI RECTI_ZERO_ONE;
+extern const RECTI RECTI_MINUS_ONE_ONE;
+extern const RECTI RECTI_MAX;
+extern const RECTI RECTI_INV_MAX;
+
+/// Prostokąt z 4 floatów.
+struct RECTF
+{
+	VEC2 Min, Max;
+
+	RECTF() { }
+	RECTF(const VEC2 &min_, const VEC2 &max_) : Min(min_), Max(max_) { }
+	RECTF(float minX, float minY, float maxX, float maxY) : Min(minX, minY), Max(maxX, maxY) { }
+	RECTF(const float *Arr) : Min(Arr[0], Arr[1]), Max(Arr[2], Arr[3]) { }
+
+	operator float * () { return &Min.x; }
+	operator const float * () const { return &Min.x; }
+
+	bool operator == (const RECTF &r) const { return Min == r.Min && Max == r.Max; }
+	bool operator != (const RECTF &r) const { return Min != r.Min || Max != r.Max; }
+
+	RECTF operator + () const { return *this; }
+	RECTF operator - () const { return RECTF(-Max, -Min); }
+	RECTF operator + (const VEC2 &p) const { return RECTF(Min+p, Max+p); }
+	RECTF operator - (const VEC2 &p) const { return RECTF(Min-p, Max-p); }
+	RECTF operator * (float s) const { return RECTF(Min*s, Max*s); }
+	RECTF operator / (float s) const { float sInv = 1.f/s; return RECTF(Min*sInv, Max*sInv); }
+	RECTF & operator += (const VEC2 &p) { Min += p; Max += p; return *this; }
+	RECTF & operator -= (const VEC2 &p) { Min -= p; Max -= p; return *this; }
+	RECTF & operator *= (float s) { Min *= s; Max *= s; return *this; }
+	RECTF & operator /= (float s) { float sInv = 1.f/s; Min *= sInv; Max *= sInv; return *this; }
+
+	float & left()   { return Min.x; }
+	float & top()    { return Min.y; }
+	float & right()  { return Max.x; }
+	float & bottom() { return Max.y; }
+	float left()   const { return Min.x; }
+	float top()    const { return Min.y; }
+	float right()  const { return Max.x; }
+	float bottom() const { return Max.y; }
+
+	bool IsValid() const { return Min.x < Max.x && Min.y < Max.y; }
+	void Repair()
+	{
+		if (Max.x < Min.x) std::swap(Min.x, Max.x);
+		if (Max.y < Min.y) std::swap(Min.y, Max.y);
+	}
+
+	/// Powiększa prostokąt z każdej strony o podaną wartość
+	void Extend(float d) { Min.x -= d; Min.y -= d; Max.x += d; Max.y += d; }
+	/// Oblicza i zwraca długość przekątnej
+	float Diagonal() const { return sqrtf( sqr(Max.x-Min.x) + sqr(Max.y-Min.y) ); }
+	/// Oblicza i zwraca pole powierzchni
+	float Field() const { return (Max.x-Min.x)*(Max.y-Min.y); }
+	
+	void GetSize(VEC2 *out) const { *out = Max - Min; }
+	float GetSizeDim(size_t dim) const { return Max[dim] - Min[dim]; }
+	
+	void GetHalfSize(VEC2 *out) { *out = (Max - Min) * 0.5f; }
+	float GetHalfSizeDim(size_t dim) const { return (Max[dim] - Min[dim]) * 0.5f; }
+
+	/// Zmienia szerokość i wysokość na podaną
+	void SetSize(const VEC2 &newSize) { Max = Min + newSize; }
+	void SetSizeDim(size_t dim, float newSize) { Max[dim] = Min[dim] + newSize; }
+	/// Oblicza i zwraca pozycję środka
+	void GetCenter(VEC2 *Out) const { *Out = (Min+Max)*0.5f; }
+	float GetCenterDim(size_t dim) const { return (Min[dim]+Max[dim])*0.5f; }
+
+	void GetCorner(VEC2 *out, uint i) const
+	{
+		out->x = (i & 1) ? Max.x : Min.x;
+		out->y = (i & 2) ? Max.y : Min.y;
+	}
+	/// Returns begin point and end point of one of rectangle edges. index must be 0..3.
+	void GetEdge(VEC2 *outP1, VEC2 *outP2, uint index) const;
+	/// Returns one of 4 possible quarters of this rect.
+	void GetQuad(RECTF *out, uint index) const;
+
+	void AddInternalPoint(const VEC2 &p)
+	{
+		if (p.x < Min.x) Min.x = p.x;
+		if (p.y < Min.y) Min.y = p.y;
+		if (p.x > Max.x) Max.x = p.x;
+		if (p.y > Max.y) Max.y = p.y;
+	}
+
+	void AddInternalRect(const RECTF &rect)
+	{
+		if (rect.Min.x < Min.x) Min.x = rect.Min.x;
+		if (rect.Min.y < Min.y) Min.y = rect.Min.y;
+		if (rect.Max.x > Max.x) Max.x = rect.Max.x;
+		if (rect.Max.y > Max.y) Max.y = rect.Max.y;
+	}
+};
+
+extern const RECTF RECTF_ZERO;
+extern const RECTF RECTF_ZERO_ONE;
+extern const RECTF RECTF_MINUS_ONE_ONE;
+extern const RECTF RECTF_MAX; ///< Maximal possible rectangle: -FLT_MAX..FLT_MAX
+extern const RECTF RECTF_INV_MAX; ///< Inverted maximal rectangle: FLT_MAX..-FLT_MAX. It's invalid. Use it to initialize rectangle for finding min-max.
+
+#ifdef _WIN32
+	/// Konwersja z common::RECTI do RECT z WinAPI
+	template <> inline ::RECT & math_cast<::RECT, RECTI>(const RECTI &x) { return (::RECT&)(x); }
+	/// Konwersja z RECT z WinAPI do common::RECTI
+	template <> inline RECTI & math_cast<RECTI, ::RECT>(const ::RECT &x) { return (RECTI&)(x); }
+#endif
+
+inline void swap(RECTI &r1, RECTI &r2)
+{
+	std::swap(r1.Min.x, r2.Min.x); std::swap(r1.Min.y, r2.Min.y);
+	std::swap(r1.Max.x, r2.Max.x); std::swap(r1.Max.y, r2.Max.y);
+}
+
+inline void swap(RECTF &r1, RECTF &r2)
+{
+	std::swap(r1.Min, r2.Min);
+	std::swap(r1.Max, r2.Max);
+}
+
+inline void Mul(RECTI *out, const RECTI &rect, const POINT_ &v)
+{
+	Mul(&out->Min, rect.Min, v);
+	Mul(&out->Max, rect.Max, v);
+}
+inline void Mul(RECTF *out, const RECTF &rect, const VEC2 &v)
+{
+	Mul(&out->Min, rect.Min, v);
+	Mul(&out->Max, rect.Max, v);
+}
+inline void Div(RECTI *out, const RECTI &rect, const POINT_ &v)
+{
+	Div(&out->Min, rect.Min, v);
+	Div(&out->Max, rect.Max, v);
+}
+inline void Div(RECTF *out, const RECTF &rect, const VEC2 &v)
+{
+	Div(&out->Min, rect.Min, v);
+	Div(&out->Max, rect.Max, v);
+}
+
+inline void Mul(RECTI *inout, const POINT_ &v)
+{
+	Mul(&inout->Min, v);
+	Mul(&inout->Max, v);
+}
+inline void Mul(RECTF *inout, const VEC2 &v)
+{
+	Mul(&inout->Min, v);
+	Mul(&inout->Max, v);
+}
+inline void Div(RECTI *inout, const POINT_ &v)
+{
+	Div(&inout->Min, v);
+	Div(&inout->Max, v);
+}
+inline void Div(RECTF *inout, const VEC2 &v)
+{
+	Div(&inout->Min, v);
+	Div(&inout->Max, v);
+}
+
+/// Zwraca true, jeśli punkt należy do prostokąta
+inline bool PointInRect(const POINT_ &p, const RECTI &r)
+{
+	return
+		(p.x >= r.Min.x) &&
+		(p.x <= r.Max.x) &&
+		(p.y >= r.Min.y) &&
+		(p.y <= r.Max.y);
+}
+inline bool PointInRect(const VEC2 &p, const RECTF &r)
+{
+	return
+		(p.x >= r.Min.x) &&
+		(p.x <= r.Max.x) &&
+		(p.y >= r.Min.y) &&
+		(p.y <= r.Max.y);
+}
+
+/// Zwraca true, jeśli prostokąt sr zawiera się w całości wewnątrz r
+inline bool RectInRect(const RECTI &sr, const RECTI &r)
+{
+	return
+		(sr.Min.x >= r.Min.x) &&
+		(sr.Max.x <= r.Max.x) &&
+		(sr.Min.y >= r.Min.y) &&
+		(sr.Max.y <= r.Max.y);
+}
+inline bool RectInRect(const RECTF &sr, const RECTF &r)
+{
+	return
+		(sr.Min.x >= r.Min.x) &&
+		(sr.Max.x <= r.Max.x) &&
+		(sr.Min.y >= r.Min.y) &&
+		(sr.Max.y <= r.Max.y);
+}
+
+/// Zwraca true, jeśli podane prostokąty zachodzą na siebie
+inline bool RectToRect(const RECTI &r1, const RECTI &r2)
+{
+	return
+		(r1.Min.x <= r2.Max.x) &&
+		(r1.Max.x >= r2.Min.x) &&
+		(r1.Min.y <= r2.Max.y) &&
+		(r1.Max.y >= r2.Min.y);
+}
+inline bool RectToRect(const RECTF &r1, const RECTF &r2)
+{
+	return
+		(r1.Min.x <= r2.Max.x) &&
+		(r1.Max.x >= r2.Min.x) &&
+		(r1.Min.y <= r2.Max.y) &&
+		(r1.Max.y >= r2.Min.y);
+}
+
+/// Jeśli prostokąty posiadają część wspólną, zwraca ją przez Out i zwraca true
+inline bool Intersection(RECTI *Out, const RECTI &r1, const RECTI &r2)
+{
+	*Out = RECTI(
+		std::max(r1.Min.x, r2.Min.x),
+		std::max(r1.Min.y, r2.Min.y),
+		std::min(r1.Max.x, r2.Max.x),
+		std::min(r1.Max.y, r2.Max.y));
+	return Out->IsValid();
+}
+inline bool Intersection(RECTF *Out, const RECTF &r1, const RECTF &r2)
+{
+	*Out = RECTF(
+		std::max(r1.Min.x, r2.Min.x),
+		std::max(r1.Min.y, r2.Min.y),
+		std::min(r1.Max.x, r2.Max.x),
+		std::min(r1.Max.y, r2.Max.y));
+	return Out->IsValid();
+}
+
+/// Zwraca prostokąt opisany na podanych dwóch prostokątach
+inline void Union(RECTI *Out, const RECTI &r1, const RECTI &r2)
+{
+	Out->Min.x = std::min(r1.Min.x, r2.Min.x);
+	Out->Min.y = std::min(r1.Min.y, r2.Min.y);
+	Out->Max.x = std::max(r1.Max.x, r2.Max.x);
+	Out->Max.y = std::max(r1.Max.y, r2.Max.y);
+}
+inline void Union(RECTF *Out, const RECTF &r1, const RECTF &r2)
+{
+	Out->Min.x = std::min(r1.Min.x, r2.Min.x);
+	Out->Min.y = std::min(r1.Min.y, r2.Min.y);
+	Out->Max.x = std::max(r1.Max.x, r2.Max.x);
+	Out->Max.y = std::max(r1.Max.y, r2.Max.y);
+}
+
+inline void Lerp(RECTF *out, const RECTF &v1, const RECTF &v2, float t)
+{
+	out->Min.x = Lerp(v1.Min.x, v2.Min.x, t);
+	out->Min.y = Lerp(v1.Min.y, v2.Min.y, t);
+	out->Max.x = Lerp(v1.Max.x, v2.Max.x, t);
+	out->Max.y = Lerp(v1.Max.y, v2.Max.y, t);
+}
+
+/// Wyznacza najbliższy punkt wewnątrz prostokąta względem punktu p.
+/** Jeśli p leży wewnątrz tego prostokąta, zwrócone zostaje dokładnie p. */
+void ClosestPointInRect(POINT_ *Out, const RECTI &Rect, const POINT_ &p);
+/// Wyznacza najbliższy punkt wewnątrz prostokąta względem punktu p.
+/** Jeśli p leży wewnątrz tego prostokąta, zwrócone zostaje dokładnie p. */
+void ClosestPointInRect(VEC2 *Out, const RECTF &Rect, const VEC2 &p);
+
+//@}
+// math_rect
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+/** \addtogroup math_aabb AABB
+Prostopadłościan AABB - Axis Aligned Bounding Box */
+//@{
+
+/// AABB z 2 punktów 3D
+/**
+Składnia do konwersji na i z łańcuch: p1x,p1y,p1z;p2x,p2y,p2z, np.:
+"1,2,3;4,5,6"
+*/
+struct BOX
+{
+	VEC3 Min, Max;
+
+	BOX() { }
+	BOX(const VEC3 &Min, const VEC3 &Max) : Min(Min), Max(Max) { }
+	BOX(float p1x, float p1y, float p1z, float p2x, float p2y, float p2z) : Min(p1x, p1y, p1z), Max(p2x, p2y, p2z) { }
+	BOX(const float *Arr) : Min(&Arr[0]), Max(&Arr[3]) { }
+
+	operator float * () { return &Min.x; }
+	operator const float * () const { return &Min.x; }
+
+	bool operator == (const BOX &p) const { return Min == p.Min && Max == p.Max; }
+	bool operator != (const BOX &p) const { return Min != p.Min || Max != p.Max; }
+
+	BOX operator + () const { return *this; }
+	BOX operator - () const { return BOX(-Max, -Min); }
+	BOX operator + (const VEC3 &v) const { return BOX(Min+v, Max+v); }
+	BOX operator - (const VEC3 &v) const { return BOX(Min-v, Max-v); }
+	BOX operator * (float f) const { return BOX(Min*f, Max*f); }
+	BOX operator / (float f) const { float fInv = 1.f/f; return BOX(Min*fInv, Max*fInv); }
+	BOX & operator += (const VEC3 &v) { Min += v; Max += v; return *this; }
+	BOX & operator -= (const VEC3 &v) { Min -= v; Max -= v; return *this; }
+	BOX & operator *= (float f) { Min *= f; Max *= f; return *this; }
+	BOX & operator /= (float f) { float fInv = 1.f/f; Min *= fInv; Max *= fInv; return *this; }
+
+	bool IsValid() { return Min.x < Max.x && Min.y < Max.y && Min.z < Max.z; }
+	void Repair()
+	{
+		if (Max.x < Min.x) std::swap(Min.x, Max.x);
+		if (Max.y < Min.y) std::swap(Min.y, Max.y);
+		if (Max.z < Min.z) std::swap(Min.z, Max.z);
+	}
+
+	/// Powiększa boks z każdej strony o podaną wartość
+	void Extend(float d) { Min.x -= d; Min.y -= d; Min.z -= d; Max.x += d; Max.y += d; Max.z += d; }
+	/// Oblicza i zwraca rozmiary boksa w trzech wymiarach
+	void GetSize(VEC3 *Out) const { Out->x = Max.x-Min.x; Out->y = Max.y-Min.y; Out->z = Max.z-Min.z; }
+	float GetSizeDim(size_t dim) const { return Max[dim]-Min[dim]; }
+	/// Zmienia wielkość na podaną
+	void SetSize(const VEC3 &NewSize) { Max.x = Min.x + NewSize.x; Max.y = Min.y + NewSize.y; Max.z = Min.z + NewSize.z; }
+	void SetSizeDim(size_t dim, float newSize) { Max[dim] = Min[dim] + newSize; }
+	/// Oblicza i zwraca długość przekątnej
+	float Diagonal() const { return sqrtf( (Max.x-Min.x)*(Max.x-Min.x) + (Max.y-Min.y)*(Max.y-Min.y) + (Max.z-Min.z)*(Max.z-Min.z) ); }
+	/// Oblicza i zwraca objętość
+	float Volume() const { return (Max.x-Min.x)*(Max.y-Min.y)*(Max.z-Min.z); }
+	/// Oblicza i zwraca pozycję środka
+	void GetCenter(VEC3 *Out) const { Out->x = (Min.x+Max.x)*0.5f; Out->y = (Min.y+Max.y)*0.5f; Out->z = (Min.z+Max.z)*0.5f; }
+	float GetCenterDim(size_t dim) const { return (Min[dim]+Max[dim])*0.5f; }
+	/// Oblicza i zwraca połowy rozmiarów
+	void GetHalfSize(VEC3 *OutHalfSize) const {
+		OutHalfSize->x = (Max.x-Min.x)*0.5f;
+		OutHalfSize->y = (Max.y-Min.y)*0.5f;
+		OutHalfSize->z = (Max.z-Min.z)*0.5f;
+	}
+	float GetHalfSizeDim(size_t dim) { return (Max[dim]-Min[dim])*0.5f; }
+	/// Zwraca wybrany wierzchołek
+	void GetCorner(VEC3 *Out, uint i) const
+	{
+		Out->x = (i & 1) ? Max.x : Min.x;
+		Out->y = (i & 2) ? Max.y : Min.y;
+		Out->z = (i & 4) ? Max.z : Min.z;
+	}
+	/// Zwraca wszystkie 6 wierzchołków w kolejności
+	/**
+	Trzeba podać wskaźnik do tablicy. Kolejność:
+	\verbatim
+	p1x, p1y, p1z; p2x, p1y, p1z; p1x, p2y, p1z; p2x, p2y, p1z
+	p1x, p1y, p2z; p2x, p1y, p2z; p1x, p2y, p2z; p2x, p2y, p2z
+	\endverbatim
+	*/
+	void GetAllCorners(VEC3 *Out) const
+	{
+		Out[0] = VEC3(Min.x, Min.y, Min.z); Out[1] = VEC3(Max.x, Min.y, Min.z); Out[2] = VEC3(Min.x, Max.y, Min.z); Out[3] = VEC3(Max.x, Max.y, Min.z);
+		Out[4] = VEC3(Min.x, Min.y, Max.z); Out[5] = VEC3(Max.x, Min.y, Max.z); Out[6] = VEC3(Min.x, Max.y, Max.z); Out[7] = VEC3(Max.x, Max.y, Max.z);
+	}
+	/// Returns begin point and end point of selected edge. index must be 0..11.
+	void GetEdge(VEC3 *outP1, VEC3 *outP2, uint index) const;
+	/// Returns one of 8 possible octants of this box.
+	void GetOct(BOX *out, uint index) const;
+
+	/// Powiększa tak żeby na pewno zawierał podany punkt
+	void AddInternalPoint(const VEC3 &p)
+	{
+		Min.x = std::min(Min.x, p.x); Min.y = std::min(Min.y, p.y); Min.z = std::min(Min.z, p.z);
+		Max.x = std::max(Max.x, p.x); Max.y = std::max(Max.y, p.y); Max.z = std::max(Max.z, p.z);
+	}
+	/// Powiększa tak żeby na pewno zawierał podany boks
+	/** Podany boks musi być prawidłowy. */
+	void AddInternalBox(const BOX &b)
+	{
+		Min.x = std::min(Min.x, b.Min.x); Min.y = std::min(Min.y, b.Min.y); Min.z = std::min(Min.z, b.Min.z);
+		Max.x = std::max(Max.x, b.Max.x); Max.y = std::max(Max.y, b.Max.y); Max.z = std::max(Max.z, b.Max.z);
+	}
+};
+
+extern const BOX BOX_ZERO;
+extern const BOX BOX_ZERO_ONE;
+extern const BOX BOX_MINUS_ONE_ONE;
+extern const BOX BOX_MAX; ///< Maximal possible box: -FLT_MAX..FLT_MAX
+extern const BOX BOX_INV_MAX; ///< Inverted maximal box: FLT_MAX..-FLT_MAX. It's invalid. Use it to initialize box for finding min-max.
+
+
+inline void swap(BOX &b1, BOX &b2)
+{
+	std::swap(b1.Min, b2.Min);
+	std::swap(b1.Max, b2.Max);
+}
+
+inline void Mul(BOX *Out, const BOX &b, const VEC3 &v)
+{
+	Mul(&Out->Max, b.Max, v);
+	Mul(&Out->Max, b.Max, v);
+}
+inline void Div(BOX *Out, const BOX &b, const VEC3 &v)
+{
+	Div(&Out->Max, b.Max, v);
+	Div(&Out->Max, b.Max, v);
+}
+
+inline void Mul(BOX *inout, const VEC3 &v)
+{
+	Mul(&inout->Max, v);
+	Mul(&inout->Max, v);
+}
+inline void Div(BOX *inout, const VEC3 &v)
+{
+	Div(&inout->Max, v);
+	Div(&inout->Max, v);
+}
+
+/// Zwraca true, jeśli punkt należy do boksa
+inline bool PointInBox(const VEC3 &p, const BOX &b)
+{
+	return
+		(p.x >= b.Min.x) && (p.x <= b.Max.x) &&
+		(p.y >= b.Min.y) && (p.y <= b.Max.y) &&
+		(p.z >= b.Min.z) && (p.z <= b.Max.z);
+}
+
+/// Zwraca true, jeśli boks sb zawiera się w całości wewnątrz b
+inline bool BoxInBox(const BOX &sb, const BOX &b)
+{
+	return
+		(sb.Min.x >= b.Min.x) && (sb.Max.x <= b.Max.x) &&
+		(sb.Min.y >= b.Min.y) && (sb.Max.y <= b.Max.y) &&
+		(sb.Min.z >= b.Min.z) && (sb.Max.z <= b.Max.z);
+}
+
+/// Zwraca true, jeśli podane boksy zachodzą na siebie
+inline bool BoxToBox(const BOX &b1, const BOX &b2)
+{
+	return
+		(b1.Min.x <= b2.Max.x) && (b1.Max.x >= b2.Min.x) &&
+		(b1.Min.y <= b2.Max.y) && (b1.Max.y >= b2.Min.y) &&
+		(b1.Min.z <= b2.Max.z) && (b1.Max.z >= b2.Min.z);
+}
+
+/// Jeśli boksy posiadają część wspólną, zwraca ją przez Out i zwraca true
+inline bool Intersection(BOX *Out, const BOX &b1, const BOX &b2)
+{
+	*Out = BOX(
+		VEC3(
+			std::max(b1.Min.x, b2.Min.x),
+			std::max(b1.Min.y, b2.Min.y),
+			std::max(b1.Min.z, b2.Min.z)),
+		VEC3(
+			std::min(b1.Max.x, b2.Max.x),
+			std::min(b1.Max.y, b2.Max.y),
+			std::min(b1.Max.z, b2.Max.z)));
+	return Out->IsValid();
+}
+
+/// Zwraca boks opisany na podanych dwóch boksach
+inline void Union(BOX *Out, const BOX &b1, const BOX &b2)
+{
+	*Out = BOX(
+		VEC3(
+			std::min(b1.Min.x, b2.Min.x),
+			std::min(b1.Min.y, b2.Min.y),
+			std::min(b1.Min.z, b2.Min.z)),
+		VEC3(
+			std::max(b1.Max.x, b2.Max.x),
+			std::max(b1.Max.y, b2.Max.y),
+			std::max(b1.Max.z, b2.Max.z)));
+}
+inline void Lerp(BOX *out, const BOX &v1, const BOX &v2, float t)
+{
+	Lerp(&out->Min, v1.Min, v2.Min, t);
+	Lerp(&out->Max, v1.Max, v2.Max, t);
+}
+
+//@}
+// math_aabb
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+/** \addtogroup math_aabb OBB
+Prostopadłościan o dowolnej orientacji OBB - Oriented Bounding Box */
+//@{
+
+/// OBB - Oriented Bounding Box - prostopadłościan o dowolnej orientacji
+struct OBB
+{
+	/// Pozycja środka
+	VEC3 Center;
+	/// Połowa szerokości, wysokości, głębokości
+	VEC3 HalfSize;
+	/// Osie wskazujące lokalne kierunki X, Y, Z.
+	/** Muszą być jednostkowe i wzajemnie prostopadłe. */
+	VEC3 Axes[3];
+};
+
+/// Zwraca true, jeśli dwa prostopadłościany OBB nachodzą na siebie.
+bool ObbToObb(const OBB &a, const OBB &b);
+
+//@}
+// math_obb
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+/** \addtogroup math_rect3d Rect 3D
+Dowolnie zorientowany prostokąt w przestrzeni 3D - tak jakby płaski OBB. */
+//@{
+
+/// Płaski prostokąt, dowolnie zorientowany w przestrzeni 3D.
+struct RECT3D
+{
+	/// Pozycja środka
+	VEC3 Center;
+	/// Połowa szerokości, wysokości
+	VEC2 HalfSize;
+	/// Osie wskazujące lokalne kierunki X, Y.
+	/** Muszą być jednostkowe i wzajemnie prostopadłe. */
+	VEC3 Axes[2];
+};
+
+//@}
+// math_rect3d
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+/** \addtogroup math_colors Kolory
+Stałe z kolorami, operacje generujące kolory itp. wypełniają kanał alfa jedynką.
+*/
+//@{
+
+/// Kolor w formacie A8R8G8B8.
+/**
+Operacje dodawania i odejmowania kolorów, a także dodawania, odejmowania,
+mnożenia i dzielenia przez liczbę pilnują zakresu i w razie czego obcinają,
+nie zawijają.
+*/
+struct COLOR
+{
+	union
+	{
+		/// Cały kolor razem
+		uint32 ARGB;
+		/// Osobno poszczególne składowe
+		PACKED struct
+		{
+			uint8 B, G, R, A;
+		};
+	};
+
+	COLOR() { }
+	COLOR(uint32 c) : ARGB(c) { }
+	COLOR(unsigned long c) : ARGB((uint32)c) { }
+	COLOR(uint8 R, uint8 G, uint8 B) : B(B), G(G), R(R), A(0xFF) { }
+	COLOR(uint8 A, uint8 R, uint8 G, uint8 B) : B(B), G(G), R(R), A(A) { }
+
+	bool operator == (COLOR c) const { return ARGB == c.ARGB; }
+	bool operator != (COLOR c) const { return ARGB != c.ARGB; }
+
+	// Operatory unarne - dany kolor i negatyw koloru
+	COLOR operator + () const { return *this; }
+	COLOR operator - () const { return COLOR(~ARGB); }
+	// Dodawanie i odejmowanie kolorów
+	COLOR operator + (const COLOR &c) const { return COLOR(safe_add(A, c.A), safe_add(R, c.R), safe_add(G, c.G), safe_add(B, c.B)); }
+	COLOR operator - (const COLOR &c) const { return COLOR(safe_sub(A, c.A), safe_sub(R, c.R), safe_sub(G, c.G), safe_sub(B, c.B)); }
+	COLOR & operator += (const COLOR &c) { A = safe_add(A, c.A); R = safe_add(R, c.R); G = safe_add(G, c.G); B = safe_add(B, c.B); return *this; }
+	COLOR & operator -= (const COLOR &c) { A = safe_sub(A, c.A); R = safe_sub(R, c.R); G = safe_sub(G, c.G); B = safe_sub(B, c.B); return *this; }
+	// Mnożenie i dzielenie koloru przez liczbę
+	// Autor: Tarlandil
+	COLOR operator * (float s) const { return COLOR( (uint8)(minmax(0, (int)(A*s), 255)), (uint8)(minmax(0, (int)(R*s), 255)), (uint8)(minmax(0, (int)(G*s), 255)), (uint8)(minmax(0, (int)(B*s), 255)) ); }
+	COLOR operator / (float s) const { float sInv = 1.0f/s; return COLOR( (uint8)(minmax(0, (int)(A*sInv), 255)), (uint8)(minmax(0, (int)(R*sInv), 255)), (uint8)(minmax(0, (int)(G*sInv), 255)), (uint8)(minmax(0, (int)(B*sInv), 255)) ); }
+	COLOR & operator *= (float s) { A = (uint8)(minmax(0, (int)(A*s), 255)); R = (uint8)(minmax(0, (int)(R*s), 255)); G = (uint8)(minmax(0, (int)(G*s), 255)); B = (uint8)(minmax(0, (int)(B*s), 255)); return *this; }
+	COLOR & operator /= (float s) { float sInv = 1.0f/s; A = (uint8)(minmax(0, (int)(A*sInv), 255)); R = (uint8)(minmax(0, (int)(R*sInv), 255)); G = (uint8)(minmax(0, (int)(G*sInv), 255)); B = (uint8)(minmax(0, (int)(B*sInv), 255));  return *this; }
+	// Mnożenie dwóch kolorów, czyli modulacja
+	COLOR operator * (const COLOR &c) const { return COLOR( (uint8)(((int)A*(int)c.A)/255), (uint8)(((int)R*(int)c.R)/255), (uint8)(((int)G*(int)c.G)/255), (uint8)(((int)B*(int)c.B)/255) ); }
+	COLOR & operator *= (const COLOR &c) { A = (uint8)(((int)A*(int)c.A)/255); R = (uint8)(((int)R*(int)c.R)/255); G = (uint8)(((int)G*(int)c.G)/255); B = (uint8)(((int)B*(int)c.B)/255); return *this; }
+};
+
+extern const COLOR COLOR_TRANSPARENT_;
+extern const COLOR COLOR_BLACK;
+extern const COLOR COLOR_GRAY;
+extern const COLOR COLOR_SILVER;
+extern const COLOR COLOR_WHITE;
+extern const COLOR COLOR_FUCHSIA;
+extern const COLOR COLOR_RED;
+extern const COLOR COLOR_ORANGE;
+extern const COLOR COLOR_YELLOW;
+extern const COLOR COLOR_LIME;
+extern const COLOR COLOR_AQUA;
+extern const COLOR COLOR_BLUE;
+extern const COLOR COLOR_PURPLE;
+extern const COLOR COLOR_MAROON;
+extern const COLOR COLOR_OLIVE;
+extern const COLOR COLOR_GREEN;
+extern const COLOR COLOR_TEAL;
+
+/// Kolor z 4 liczb typu float - R, G, B, A.
+/**
+Operacje dodawania i odejmowania kolorów, a także dodawania, odejmowania,
+mnożenia i dzielenia przez liczbę nie pilnują zakresu i wartości składowych
+mogą urosnąć powyżej 1.0 albo zmaleć poniżej 0.0.
+*/
+struct COLORF
+{
+	float R, G, B, A;
+
+	COLORF() { }
+	COLORF(float R, float G, float B) : R(R), G(G), B(B), A(1.0f) { }
+	COLORF(float A, float R, float G, float B) : R(R), G(G), B(B), A(A) { }
+	COLORF(const float *Arr) : R(Arr[0]), G(Arr[1]), B(Arr[2]), A(Arr[3]) { }
+
+	operator float * () { return &R; }
+	operator const float * () const { return &R; }
+
+	bool operator == (const COLORF &c) const { return A == c.A && R == c.R && G == c.G && B == c.B; }
+	bool operator != (const COLORF &c) const { return A != c.A || R != c.R || G != c.G || B != c.B; }
+
+	// Operatory unarne - dany kolor i negatyw koloru
+	COLORF operator + () const { return *this; }
+	COLORF operator - () const { return COLORF(1.0f-A, 1.0f-R, 1.0f-G, 1.0f-B); }
+	// Dodawanie i odejmowanie kolorów
+	COLORF operator + (const COLORF &c) const { return COLORF(A+c.A, R+c.R, G+c.G, B+c.B); }
+	COLORF operator - (const COLORF &c) const { return COLORF(A-c.A, R-c.R, G-c.G, B-c.B); }
+	COLORF & operator += (const COLORF &c) { A += c.A; R += c.R; G += c.G; B += c.B; return *this; }
+	COLORF & operator -= (const COLORF &c) { A -= c.A; R -= c.R; G -= c.G; B -= c.B; return *this; }
+	// Mnożenie i dzielenie koloru przez liczbę
+	COLORF operator * (float s) const { return COLORF(A*s, R*s, G*s, B*s); }
+	COLORF operator / (float s) const { float sInv = 1.0f/s; return COLORF(A*sInv, R*sInv, G*sInv, B*sInv); }
+	COLORF & operator *= (float s) { A *= s; R *= s; G *= s; B *= s; return *this; }
+	COLORF & operator /= (float s) { float sInv = 1.0f/s; A *= sInv; R *= sInv; G *= sInv; B *= sInv; return *this; }
+	// Mnożenie dwóch kolorów, czyli modulacja
+	COLORF operator * (const COLORF &c) const { return COLORF(A*c.A, R*c.R, G*c.G, B*c.B); }
+	COLORF & operator *= (const COLORF &c) { A *= c.A; R *= c.R; G *= c.G; B *= c.B; return *this; }
+
+	/// Sprawdza, czy składowe mieszczą się w zakresie 0.0 .. 1.0
+	bool IsValid() const { return (A >= 0.0f && A <= 1.0f) && (R >= 0.0f && R <= 1.0f) && (G >= 0.0f && G <= 1.0f) && (B >= 0.0f && B <= 1.0f); }
+	/// Sprowadza składowe do zakresu 0.0 .. 1.0
+	void Repair()
+	{
+		A = minmax(0.0f, A, 1.0f); R = minmax(0.0f, R, 1.0f);
+		G = minmax(0.0f, G, 1.0f); B = minmax(0.0f, B, 1.0f);
+	}
+};
+
+inline void swap(COLORF &c1, COLORF &c2)
+{
+	std::swap(c1.A, c2.A); std::swap(c1.R, c2.R);
+	std::swap(c1.G, c2.G); std::swap(c1.B, c2.B);
+}
+
+extern const COLORF COLORF_TRANSPARENT_;
+extern const COLORF COLORF_BLACK;
+extern const COLORF COLORF_GRAY;
+extern const COLORF COLORF_SILVER;
+extern const COLORF COLORF_WHITE;
+extern const COLORF COLORF_FUCHSIA;
+extern const COLORF COLORF_RED;
+extern const COLORF COLORF_ORANGE;
+extern const COLORF COLORF_YELLOW;
+extern const COLORF COLORF_LIME;
+extern const COLORF COLORF_AQUA;
+extern const COLORF COLORF_BLUE;
+extern const COLORF COLORF_PURPLE;
+extern const COLORF COLORF_MAROON;
+extern const COLORF COLORF_OLIVE;
+extern const COLORF COLORF_GREEN;
+extern const COLORF COLORF_TEAL;
+
+inline COLORF operator * (float s, const COLORF &c) { return COLORF(c.A*s, c.R*s, c.G*s, c.B*s); }
+inline COLORF operator / (float s, const COLORF &c) { float sInv = 1.0f/s; return COLORF(c.A*sInv, c.R*sInv, c.G*sInv, c.B*sInv); }
+
+inline COLOR operator * (float s, const COLOR &c) { return COLOR( (uint8)(minmax(0, (int)(c.A*s), 255)), (uint8)(minmax(0, (int)(c.R*s), 255)), (uint8)(minmax(0, (int)(c.G*s), 255)), (uint8)(minmax(0, (int)(c.B*s), 255)) ); }
+inline COLOR operator / (float s, const COLOR &c) { float sInv = 1.0f/s; return COLOR( (uint8)(minmax(0, (int)(c.A*sInv), 255)), (uint8)(minmax(0, (int)(c.R*sInv), 255)), (uint8)(minmax(0, (int)(c.G*sInv), 255)), (uint8)(minmax(0, (int)(c.B*sInv), 255)) ); }
+
+template <> inline uint32 & math_cast<uint32, COLOR>(const COLOR &x) { return (uint32&)(x); }
+template <> inline unsigned long & math_cast<unsigned long, COLOR>(const COLOR &x) { return (unsigned long&)(x); }
+template <> inline COLOR & math_cast<COLOR, uint32>(const uint32 &x) { return (COLOR&)(x); }
+template <> inline COLOR & math_cast<COLOR, unsigned long>(const unsigned long &x) { return (COLOR&)(x); }
+
+#ifdef USE_DIRECTX
+	template <> inline D3DXCOLOR & math_cast<D3DXCOLOR, COLORF>(const COLORF &x) { return (D3DXCOLOR&)(x); }
+	template <> inline COLORF & math_cast<COLORF, D3DXCOLOR>(const D3DXCOLOR &x) { return (COLORF&)(x); }
+#endif
+
+/// Konwersje między tymi dwoma reprezentacjami kolorów
+inline void ColorToColorf(COLORF *Out, COLOR c)
+{
+	Out->R = c.R / 255.0f;
+	Out->G = c.G / 255.0f;
+	Out->B = c.B / 255.0f;
+	Out->A = c.A / 255.0f;
+}
+/** Tu musi być valid, inaczej wyjdzie zawinięte. */
+inline COLOR ColorfToColor(const COLORF &c)
+{
+	return COLOR(
+		(uint8)(minmax(0.0f, c.A, 1.0f)*255.0f+0.5f),
+		(uint8)(minmax(0.0f, c.R, 1.0f)*255.0f+0.5f),
+		(uint8)(minmax(0.0f, c.G, 1.0f)*255.0f+0.5f),
+		(uint8)(minmax(0.0f, c.B, 1.0f)*255.0f+0.5f));
+}
+
+/// Konwersja koloru na łańcuch
+/** Formatem może być:
+- 'x' = RRGGBB szesnastkowo
+- 'X' = AARRGGBB szesnastkowo
+- 'f' = R,G,B floaty
+- 'F' = A,R,G,B floaty
+*/
+void ColorToStr(tstring *Out, COLOR Color, char Format = 'X');
+void ColorToStr(tstring *Out, const COLORF &Color, char Format = 'F');
+/// Konwersja łańcucha na kolor
+/** Jeśli kanał alfa nie podany, zostaje wypełniony wartością maksymalną.
+Łańcuchem może być:
+- jedna z 16 nazw standardowych kolorów (wielkość liter dowolna)
+- wartość szesnastkowa RRGGBB
+- wartość szesnastkowa AARRGGBB
+- liczby float R,G,B
+- liczby float A,R,G,B
+*/
+bool StrToColor(COLOR *Out, const tstring &Str);
+bool StrToColor(COLORF *Out, const tstring &Str);
+
+inline void Add(COLORF *Out, const COLORF &c1, const COLORF &c2)
+{
+	Out->A = c1.A + c2.A; Out->R = c1.R + c2.R;
+	Out->G = c1.G + c2.G; Out->B = c1.B + c2.B;
+}
+inline void Sub(COLORF *Out, const COLORF &c1, const COLORF &c2)
+{
+	Out->A = c1.A - c2.A; Out->R = c1.R - c2.R;
+	Out->G = c1.G - c2.G; Out->B = c1.B - c2.B;
+}
+inline void Mul(COLORF *Out, const COLORF &c1, const COLORF &c2)
+{
+	Out->A = c1.A * c2.A; Out->R = c1.R * c2.R;
+	Out->G = c1.G * c2.G; Out->B = c1.B * c2.B;
+}
+inline void Mul(COLORF *inout, const COLORF &c)
+{
+	inout->A *= c.A; inout->R *= c.R;
+	inout->G *= c.G; inout->B *= c.B;
+}
+inline void Mul(COLORF *Out, const COLORF &c, float s)
+{
+	Out->A = c.A * s; Out->R = c.R * s;
+	Out->G = c.G * s; Out->B = c.B * s;
+}
+inline void Div(COLORF *Out, const COLORF &c, float s)
+{
+	Out->A = c.A / s; Out->R = c.R / s;
+	Out->G = c.G / s; Out->B = c.B / s;
+}
+inline void Negative(COLORF *Out, const COLORF &c)
+{
+	Out->A = 1.0f - c.A; Out->R = 1.0f - c.R;
+	Out->G = 1.0f - c.G; Out->B = 1.0f - c.B;
+}
+
+/// Konwertuje kolor między systemami ARGB i ABGR
+inline COLOR ARGB_ABGR(COLOR color)
+{
+	return COLOR(
+		(color.ARGB & 0xFF00FF00) |
+		((color.ARGB >> 16) & 0x000000FF) |
+		((color.ARGB & 0x000000FF) << 16)
+		);
+}
+
+/// Konwertuje zwykły kolor COLOR (A8R8G8B8) na R5G6B5
+inline uint16 ColorToR5G6B5(COLOR color)
+{
+	return
+		((unsigned short)(color.R >> 3) << 11) |
+		((unsigned short)(color.G >> 2) <<  5) |
+		((unsigned short)(color.B >> 3));
+}
+
+/// Konwertuje kolor R5G6B5 na zwykły kolor COLOR (A8R8G8B8)
+inline COLOR R5G6B5ToColor(uint16 color)
+{
+	return COLOR(
+		255,
+		(uint8)(color >> 11 << 3),
+		(uint8)(color >>  5 << 2),
+		(uint8)(color <<  3));
+}
+
+inline void Lerp(COLORF *Out, const COLORF &c1, const COLORF &c2, float t)
+{
+	Out->A = Lerp(c1.A, c2.A, t);
+	Out->R = Lerp(c1.R, c2.R, t);
+	Out->G = Lerp(c1.G, c2.G, t);
+	Out->B = Lerp(c1.B, c2.B, t);
+}
+inline COLOR Lerp(COLOR c1, COLOR c2, float t)
+{
+	return COLOR(
+		(uint8)(minmax(0, (int)(c1.A + t*((float)c2.A-(float)c1.A)), 255)),
+		(uint8)(minmax(0, (int)(c1.R + t*((float)c2.R-(float)c1.R)), 255)),
+		(uint8)(minmax(0, (int)(c1.G + t*((float)c2.G-(float)c1.G)), 255)),
+		(uint8)(minmax(0, (int)(c1.B + t*((float)c2.B-(float)c1.B)), 255)) );
+}
+inline void saturate(COLORF &v)
+{
+	v.R = saturate(v.R); v.G = saturate(v.G); v.B = saturate(v.B); v.A = saturate(v.A);
+}
+
+/// Konwertuje kolor między HSB a RGB
+/**
+- Hue, Saturation, Brightness = 0..1
+- Kanał alfa zwraca 1.
+*/
+void HsbToRgb(COLORF *Out, float hue, float saturation, float brightness);
+/// Konwertuje kolor RGB na HSB
+void RgbToHsb(float *OutHue, float *OutSaturation, float *OutBrightness, const COLORF &Color);
+
+/// Zwraca kolor tęczy od czerwonego (odpowiada mu t = 0) do niebieskiego (t = 1)
+/** Kanał alfa zwraca 0. */
+inline void ColorRainbow(COLORF *Out, float t)
+{
+	HsbToRgb(Out, t*0.75f, 1.0f, 1.0f);
+}
+
+/// Zwraca jasność podanego koloru (odcień szarości) z zakresu 0..1
+inline float ColorToGrayscale(const COLORF &c)
+{
+	return 0.299f * c.R + 0.587f * c.G + 0.114f * c.B;
+}
+inline float ColorToGrayscale(COLOR &c)
+{
+	return 0.299f * (c.R/255.0f) + 0.587f * (c.G/255.0f) + 0.114f * (c.B/255.0f);
+}
+
+/// Zwraca kolor szary o podanej jasności t = 0..1
+inline void GrayscaleToColor(COLORF *Out, float t)
+{
+	Out->A = 1.0f;
+	Out->R = Out->G = Out->B = t;
+}
+inline void GrayscaleToColor(COLOR *Out, float t)
+{
+	Out->A = 255;
+	Out->R = Out->G = Out->B = (uint8)(t*255.0f);
+}
+
+/// Zmienia kolorowi kontrast na miejscu
+/** Dla t = 0 wychodzi idealnie połówkowy szary. \n
+Dla t = 1 wychodzi kolor oryginalny. \n
+t może też być większe niż 1. \n
+Alfa zostaje bez zmian. */
+inline void AdjustContrast(COLORF *Color, float t)
+{
+	Color->R = 0.5f + t * (Color->R - 0.5f);
+	Color->G = 0.5f + t * (Color->G - 0.5f);
+	Color->B = 0.5f + t * (Color->B - 0.5f);
+}
+
+/// Zmienia kolorowi nasycenie na miejscu
+/** Dla t = 0 wychodzi dany kolor skonwertowany do odcienia szarości. \n
+Dla t = 1 wychodzi kolor oryginalny. \n
+t < 0 zmniejsza nasycenie, t > 0 zwiększa nasycenie \n
+Alfa zostaje bez zmian. */
+inline void AdjustSaturation(COLORF *Color, float t)
+{
+	float gray = ColorToGrayscale(*Color);
+	Color->R = gray + t * (Color->R - gray);
+	Color->G = gray + t * (Color->G - gray);
+	Color->B = gray + t * (Color->B - gray);
+}
+
+/// Przetwarza znormalizowany wektor na kolor XRGB. A zwraca 0.
+inline COLOR VectorToColor(const VEC3 &v)
+{
+	int R = minmax(0, (int)(127.0f * v.x + 128.0f), 255);
+	int G = minmax(0, (int)(127.0f * v.y + 128.0f), 255);
+	int B = minmax(0, (int)(127.0f * v.z + 128.0f), 255);
+	return COLOR((uint32)((R << 16) | (G << 8) | B));
+}
+
+/// Przetwarza kolor na wektor
+inline void ColorToVector(VEC3 *Out, COLOR color)
+{
+	const float o = 1.0f / 127.0f;
+	Out->x = (((color.ARGB >> 16) & 0xFF) - 128.0f) * o;
+	Out->y = (((color.ARGB >>  8) & 0xFF) - 128.0f) * o;
+	Out->z = (((color.ARGB      ) & 0xFF) - 128.0f) * o;
+}
+
+/// Zwraca "odległość" dwóch kolorów wg jakiejśtam byle jakiej metryki. Uwzględnia składowe R, G, B.
+inline uint ColorDistance(COLOR Color1, COLOR Color2)
+{
+	int rd = (int)Color1.R - (int)Color2.R;
+	int gd = (int)Color1.G - (int)Color2.G;
+	int bd = (int)Color1.B - (int)Color2.B;
+	return (uint)(rd*rd + gd*gd + bd*bd);
+}
+
+/// Converts between COLORF and VEC4, where (x,y,z,w) = (R,G,B,A)
+inline VEC4 ColorfToVec4(const COLORF &c) { return VEC4(c.R, c.G, c.B, c.A); }
+/// \copydoc ColorfToVec4
+inline COLORF Vec4ToColorf(const VEC4 &v) { return COLORF(v.w, v.x, v.y, v.z); }
+
+//@}
+// math_colors
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+/** \addtogroup math_plane Płaszczyzna */
+//@{
+
+#if defined(USE_DIRECTX) && !defined(DOXYGEN)
+	typedef D3DXPLANE PLANE;
+#else
+	/// Płaszczyzna
+	/**
+	Reprezentuje płaszczyznę w przestrzeni 3D z jedną stroną dodatnią, a drugą
+	ujemną. Opisana jest równaniem A x + B y + C z + D = 0. Wektor [A,B,C] to wektor
+	normalny wskazujący w kierunku dodatniej półprzestrzeni. Jeśli płaszczyzna jest
+	znormalizowana, wektor normalny jest znormalizowany, a D to odległość
+	płaszczyzny od środka układu współrzędnych.
+	Reprezentacja jako string to A,R,G,B np. "1,2,3,0.2".
+	Płaszczyzna mająca a=b=c=0 (czyli stała ZERO) jest niepoprawna, zdegenerowana.
+	*/
+	struct PLANE
+	{
+		float a, b, c, d;
+
+		PLANE() { }
+		PLANE(float a, float b, float c, float d) : a(a), b(b), c(c), d(d) { }
+		PLANE(const float *Arr) : a(Arr[0]), b(Arr[1]), c(Arr[2]), d(Arr[3]) { }
+
+		operator float * () { return &a; }
+		operator const float * () const { return &a; }
+
+		bool operator == (const PLANE &p) const { return a == p.a && b == p.b && c == p.c && d == p.d; }
+		bool operator != (const PLANE &p) const { return a != p.a || b != p.b || c != p.c || d != p.d; }
+
+		PLANE operator + () const { return *this; }
+		/// Zwraca płaszczyznę zwróconą w przeciwną stronę
+		PLANE operator - () const { return PLANE(-a, -b, -c, -d); }
+
+		PLANE operator * (float s) const { return PLANE(a*s, b*s, c*s, d*s); }
+		PLANE operator / (float s) const { float sInv = 1.0f/s; return PLANE(a*sInv, b*sInv, c*sInv, d*sInv); }
+		PLANE & operator *= (float s) { a *= s; b *= s; c *= s; d *= s; return *this; }
+		PLANE & operator /= (float s) { float sInv = 1.0f/s; a *= sInv; b *= sInv; c *= sInv; d *= sInv; return *this; }
+	};
+	inline PLANE operator * (float s, const PLANE &p) { return PLANE(p.a*s, p.b*s, p.c*s, p.d*s); }
+#endif
+
+extern const PLANE PLANE_ZERO;
+extern const PLANE PLANE_POSITIVE_X; ///< Płaszczyzna pionowa, równoległa do Y i Z, wskazująca na prawo na X
+extern const PLANE PLANE_POSITIVE_Y; ///< Płaszczyzna pozioma, równoległa do X i Z, wskazująca do góry na Y
+extern const PLANE PLANE_POSITIVE_Z; ///< Płaszczyzna pionowa, równoległa do X i Y, wskazująca w głąb na Z
+extern const PLANE PLANE_NEGATIVE_X; ///< Płaszczyzna pionowa, równoległa do Y i Z, wskazująca na lewo na X
+extern const PLANE PLANE_NEGATIVE_Y; ///< Płaszczyzna pozioma, równoległa do X i Z, wskazująca w dół na Y
+extern const PLANE PLANE_NEGATIVE_Z; ///< Płaszczyzna pionowa, równoległa do X i Y, wskazująca do gracza na Z
+
+inline void swap(PLANE &p1, PLANE &p2)
+{
+	std::swap(p1.a, p2.a); std::swap(p1.b, p2.b);
+	std::swap(p1.c, p2.c); std::swap(p1.d, p2.d);
+}
+
+/// Daje dostęp do wektora normalnego podanej płaszczyzny, czyli jej składowych a, b, c zrzutowanych jako VEC3.
+inline VEC3 & GetPlaneNormal(PLANE &Plane) { return (VEC3&)Plane.a; }
+/// Zwraca wektor normalny płaszczyzny, czyli jej składowe a, b, c zrzutowane jako VEC3.
+inline const VEC3 & GetPlaneNormal(const PLANE &Plane) { return (const VEC3&)Plane.a; }
+
+/// Zwraca jakiś punkt leżący na tej płaszczyźnie
+/** \param Plane Musi być znormalizowana. */
+inline void GetPlaneMemberPoint(VEC3 *Out, const PLANE &Plane)
+{
+	*Out = GetPlaneNormal(Plane) * -Plane.d;
+}
+
+/// Zmienia odległość od początku układu współrzędnych.
+/** Płaszczyzna pozostając tak samo zorientowana została przesunięta tak, żeby
+zawierać w sobie podany punkt.
+\param[in,out] Plane Musi być znormalizowana.
+*/
+inline void RecalcPlaneD(PLANE *Plane, const VEC3 &p)
+{
+	Plane->d = -Dot(GetPlaneNormal(*Plane), p);
+}
+
+/// Zwraca true, jeśli podane płaszczyzny są sobie mniej więcej równe
+inline bool PlaneEqual(const PLANE &p1, const PLANE &p2) {
+	return float_equal(p1.a, p2.a) && float_equal(p1.b, p2.b) && float_equal(p1.c, p2.c) && float_equal(p1.d, p2.d);
+}
+
+/// Tworzy płaszczyznę na podstawie trzech punktów
+/** Płaszczyzna będzie zorientowana dodatnio w kierunku tej półprzestrzeni,
+z której wierzchołki trójkąta są widoczne jako zorientowane zgodnie z ruchem
+wskazówek zegara w układzie LH. */
+inline void PointsToPlane(PLANE *Out, const VEC3 &p1, const VEC3 &p2, const VEC3 &p3) {
+	Cross(&GetPlaneNormal(*Out), p2-p1, p3-p1);
+	Normalize(&GetPlaneNormal(*Out));
+	Out->d = -Dot(p1, GetPlaneNormal(*Out));
+}
+/// Tworzy płaszczyznę z wektora normalnego i punktu leżącego na tej płaszczyźnie
+/** Czy Normal musi być znormalizowany? Nie wiem. */
+inline void PointNormalToPlane(PLANE *Out, const VEC3 &Point, const VEC3 &Normal) {
+	Out->a = Normal.x; Out->b = Normal.y; Out->c = Normal.z;
+	Out->d = -Dot(Normal, Point);
+}
+
+/// Skalowanie płaszczyzny
+inline void Mul(PLANE *Out, const PLANE &p, float s)
+{
+	Out->a = p.a * s; Out->b = p.b * s;
+	Out->c = p.c * s; Out->d = p.d * s;
+}
+inline void Div(PLANE *Out, const PLANE &p, float s)
+{
+	Out->a = p.a / s; Out->b = p.b / s;
+	Out->c = p.c / s; Out->d = p.d / s;
+}
+
+/// Iloczyn skalarny płaszczyzny i punktu we współrzędnych jednorodnych
+/** Można użyć do wyznaczenia czy tak zapisany punkt leży na płaszczyźnie,
+po której stronie i jak daleko. */
+inline float Dot(const PLANE &p, const VEC4 &pt)
+{
+	return p.a*pt.x + p.b*pt.y + p.c*pt.z + p.d*pt.w;
+}
+
+/// Iloczyn skalarny płaszczyzny z punktem 3D: a*x+b*y+c*z+d*1
+/** Można użyć do wyznaczenia czy punkt leży na płaszczyźnie, po której stronie
+i jak daleko. */
+inline float DotCoord(const PLANE &p, const VEC3 &pt)
+{
+	return p.a*pt.x + p.b*pt.y + p.c*pt.z + p.d;
+}
+
+/// Iloczyn skalarny płaszczyzny z wektorem 3D: a*x+b*y+c*z+d*0
+/** Przydatny do wyznaczania kąta między płaszczyzną (jej normalną) a wektorem. */
+inline float DotNormal(const PLANE &p, const VEC3 &v)
+{
+	return p.a*v.x + p.b*v.y + p.c*v.z;
+}
+
+/// Normalizacja płaszczyzny
+/** Po tej operacji wektor normalny płaszczyzny jest znormalizowany.
+Płaszczyzna pozostaje położona i zorientowana tam gdzie była. */
+inline void Normalize(PLANE *Out, const PLANE &p)
+{
+	float nlsq = 1.0f / Length(GetPlaneNormal(p));
+	Out->a = p.a * nlsq; Out->b = p.b * nlsq;
+	Out->c = p.c * nlsq; Out->d = p.d * nlsq;
+}
+/// Normalizacja płaszczyzny w miejscu
+inline void Normalize(PLANE *p)
+{
+	float nlsq = 1.0f / Length(GetPlaneNormal(*p));
+	p->a *= nlsq; p->b *= nlsq;
+	p->c *= nlsq; p->d *= nlsq;
+}
+
+/// Returns plane of one of 6 possible box faces.
+/** Face order is: -X, +X, -Y, +Y, -Z, +Z.
+Returned plane is normalized and points to the outside.
+*/
+void GetBoxPlane(PLANE *out, const BOX &box, uint index);
+
+//@}
+// math_plane
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+/** \addtogroup math_line2d Prosta 2D */
+//@{
+
+/// Prosta 2D
+/**
+Reprezentuje prostą w przestrzeni 2D z jedną stroną dodatnią, a drugą
+ujemną. Opisana jest równaniem A x + B y + C = 0. Wektor [A,B] to wektor
+normalny wskazujący w kierunku dodatniej półpłaszczyzny. Jeśli prosta jest
+znormalizowana, wektor normalny jest znormalizowany, a C to odległość prostej
+od środka układu współrzędnych.
+Reprezentacja jako string to A,B,C, np. "2,0,2.1"
+Prosta mająca a = b = 0 (czyli np. stała ZERO) jest niepoprawna, zdegenerowana.
+*/
+struct LINE2D
+{
+	float a, b, c;
+
+	LINE2D() { }
+	LINE2D(float a, float b, float c) : a(a), b(b), c(c) { }
+	LINE2D(const VEC2 &Normal, float c) : a(Normal.x), b(Normal.y), c(c) { }
+	LINE2D(const float *Arr) : a(Arr[0]), b(Arr[1]), c(Arr[2]) { }
+
+	operator float * () { return &a; }
+	operator const float * () const { return &a; }
+
+	VEC2 & GetNormal() { return (VEC2&)a; }
+	const VEC2 & GetNormal() const { return (VEC2&)a; }
+
+	bool operator == (const LINE2D &L) const { return a == L.a && b == L.b && c == L.c; }
+	bool operator != (const LINE2D &L) const { return a != L.a || b != L.b || c != L.c; }
+
+	LINE2D operator + () const { return *this; }
+	/// Zwraca prostą zwróconą w przeciwną stronę
+	LINE2D operator - () const { return LINE2D(-a, -b, -c); }
+
+	// Skalowanie
+	LINE2D operator * (float s) const { return LINE2D(a*s, b*s, c*s); }
+	LINE2D operator / (float s) const { float sInv = 1.0f/s; return LINE2D(a*sInv, b*sInv, c*sInv); }
+	LINE2D & operator *= (float s) { a *= s; b *= s; c *= s; return *this; }
+	LINE2D & operator /= (float s) { float sInv = 1.0f/s; a *= sInv; b *= sInv; c *= sInv; return *this; }
+
+	/// Zwraca wektor wskazujący w kierunku prostej
+	void GetTangent(VEC2 *Out) { Out->x = b; Out->y = -a; }
+
+	/// Zwraca jakiś punkt leżący na tej prostej
+	/** Musi być znormalizowana. */
+	void GetMemberPoint(VEC2 *Out)
+	{
+		*Out = GetNormal() * -c;
+	}
+
+	/// Zmienia odległość od początku układu współrzędnych
+	/** Prosta pozostając tak samo
+	zorientowana zostaje przesunięta tak, żeby zawierać w sobie podany punkt.
+	Musi być znormalizowana. */
+	void RecalcD(const VEC2 &p)
+	{
+		c = -Dot(GetNormal(), p);
+	}
+};
+inline LINE2D operator * (float s, const LINE2D &p) { return LINE2D(p.a*s, p.b*s, p.c*s); }
+inline LINE2D operator / (float s, const LINE2D &p) { float sInv = 1.0f/s; return LINE2D(p.a*sInv, p.b*sInv, p.c*sInv); }
+
+extern const LINE2D LINE2D_ZERO;
+extern const LINE2D LINE2D_POSITIVE_X;
+extern const LINE2D LINE2D_NEGATIVE_X;
+extern const LINE2D LINE2D_POSITIVE_Y;
+extern const LINE2D LINE2D_NEGATIVE_Y;
+
+/// Daje dostęp do wektora normalnego podanej prostej, czyli jej składowych a, b zrzutowanych na VEC2.
+inline VEC2 & GetLineNormal(LINE2D &line) { return (VEC2&)line.a; }
+/// Zwraca wektor normalny prostej, czyli jej składowe a, b zrzutowane na VEC2.
+inline const VEC2 & GetLineNormal(const LINE2D &line) { return (const VEC2&)line.a; }
+
+/// Zwraca true, jeśli podane proste są sobie mniej więcej równe
+inline bool LineEqual(const LINE2D &p1, const LINE2D &p2) {
+	return float_equal(p1.a, p2.a) && float_equal(p1.b, p2.b) && float_equal(p1.c, p2.c);
+}
+
+inline void swap(LINE2D &p1, LINE2D &p2)
+{
+	std::swap(p1.a, p2.a); std::swap(p1.b, p2.b); std::swap(p1.c, p2.c);
+}
+
+/// Tworzy prostą na podstwie dwóch punktów
+/** Wynikowa prosta nie jest znormalizowana. */
+inline void PointsToLine(LINE2D *Out, const VEC2 &p1, const VEC2 &p2) {
+	Out->a = p1.y - p2.y;
+	Out->b = p2.x - p1.x;
+	Out->c = - Out->a * p1.x - Out->b * p1.y;
+}
+
+/// Tworzy prostą z wektora normalnego i punktu leżącego na tej prostej
+inline void PointNormalToLine(LINE2D *Out, const VEC2 &Point, const VEC2 &Normal) {
+	Out->a = Normal.x; Out->b = Normal.y;
+	Out->c = -Dot(Normal, Point);
+}
+
+/// Zwraca true, jeśli podane proste są równoległe
+inline bool LinesParallel(const LINE2D &L1, const LINE2D &L2) {
+	return FLOAT_ALMOST_ZERO(L1.a*L2.b - L2.a*L1.b);
+}
+
+/// Zwraca true, jeśli podane proste są prostopadłe
+inline bool LinesPerpedicular(const LINE2D &L1, const LINE2D &L2) {
+	return FLOAT_ALMOST_ZERO(L1.a*L2.a + L1.b*L2.b);
+}
+
+/// Zwraca dot z wektorów normalnych dwóch prostych
+/** Jeśli te proste są znormalizowane, wynikiem jest cos kąta między tymi prostymi. */
+inline float Dot(const LINE2D &L1, const LINE2D &L2) {
+	return L1.a*L2.a + L1.b*L2.b;
+}
+
+/// Zwraca signed odległość dwóch prostych na płaszczyźnie
+/** Proste muszą być znormalizowane. */
+inline float LineDistance(const LINE2D &L1, const LINE2D &L2) {
+	return L1.c - L2.c;
+}
+
+/// Oblicza punkt przeciecia dwóch prostych
+/** Jeśli proste nie przecinają się, tylko są równoległe lub się pokrywaną, to nie oblicza tylko zwraca false. */
+bool LinesIntersection(VEC2 *Out, const LINE2D &L1, const LINE2D &L2);
+
+/// Skalowanie prostej
+inline void Mul(LINE2D *Out, const LINE2D &p, float s) {
+	Out->a = p.a * s; Out->b = p.b * s; Out->c = p.c * s;
+}
+inline void Div(LINE2D *Out, const LINE2D &p, float s) {
+	Out->a = p.a / s; Out->b = p.b / s; Out->c = p.c / s;
+}
+
+/// Iloczyn skalarny płaszczyzny i punktu we współrzędnych jednorodnych 2D
+/** Można użyć do wyznaczenia czy tak zapisany punkt leży na płaszczyźnie,
+po której stronie i jak daleko. */
+inline float Dot(const LINE2D &p, const VEC3 &pt) {
+	return p.a*pt.x + p.b*pt.y + p.c*pt.z;
+}
+
+/// Iloczyn skalarny prostej 2D z punktem 2D: a*x + b*y + c*1
+/** Można użyć do wyznaczenia czy punkt leży na prostej 2D, po której stronie i jak daleko. */
+inline float DotCoord(const LINE2D &p, const VEC2 &pt) {
+	return p.a*pt.x + p.b*pt.y + p.c;
+}
+
+/// Iloczyn skalarny prostej 2D z wektorem 2D: a*x + b*y + c*z + d*0
+/** Przydatny do wyznaczania kąta między prostą 2D (jej normalną) a wektorem. */
+inline float DotNormal(const LINE2D &p, const VEC2 &v) {
+	return p.a*v.x + p.b*v.y;
+}
+
+/// Normalizacja prostej 2D
+/** Po tej operacji wektor normalny prostej jest znormalizowany.
+Prosta pozostaje położona i zorientowana tam gdzie była. */
+inline void Normalize(LINE2D *Out, const LINE2D &p) {
+	float nlsq = 1.f / Length(p.GetNormal());
+	Out->a = p.a * nlsq; Out->b = p.b * nlsq; Out->c = p.c * nlsq;
+}
+/// Normalizacja prostej w miejscu
+inline void Normalize(LINE2D *p) {
+	float nlsq = 1.f / Length(p->GetNormal());
+	p->a *= nlsq; p->b *= nlsq; p->c *= nlsq;
+}
+
+/// Returns line of one of 4 possible box edges.
+/** Face order is: -X, +X, -Y, +Y.
+Returned line is normalized and points to the outside.
+*/
+void GetRectLine(LINE2D *out, const RECTF &rect, uint index);
+
+//@}
+// math_line3d
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+/** \addtogroup math_matrix Macierz */
+//@{
+
+#if defined(USE_DIRECTX) && !defined(DOXYGEN)
+	typedef D3DXMATRIX MATRIX;
+#else
+	/// Macierz 4 x 4
+	/**
+	Elementy są indeksowane [wiersz,kolumna].
+	Reprezentacja tekstowa to:
+		a11,a12,a13,a14;a21,a22,a23,a24;a31,a32,a33,a34;a41,a42,a43,a44
+	*/
+	struct MATRIX
+	{
+		union
+		{
+			struct
+			{
+				float _11, _12, _13, _14;
+				float _21, _22, _23, _24;
+				float _31, _32, _33, _34;
+				float _41, _42, _43, _44;
+			};
+			float m[4][4]; // [wiersz][kolumna]
+		};
+
+		MATRIX() { }
+		MATRIX(float _11, float _12, float _13, float _14, float _21, float _22, float _23, float _24, float _31, float _32, float _33, float _34, float _41, float _42, float _43, float _44) : _11(_11), _12(_12), _13(_13), _14(_14), _21(_21), _22(_22), _23(_23), _24(_24), _31(_31), _32(_32), _33(_33), _34(_34), _41(_41), _42(_42), _43(_43), _44(_44) { }
+		MATRIX(const float *Array) : _11(Array[0]), _12(Array[1]), _13(Array[2]), _14(Array[3]), _21(Array[4]), _22(Array[5]), _23(Array[6]), _24(Array[7]), _31(Array[8]), _32(Array[9]), _33(Array[10]), _34(Array[11]), _41(Array[12]), _42(Array[13]), _43(Array[14]), _44(Array[15]) { }
+
+		operator float * () { return &_11; }
+		operator const float * () const { return &_11; }
+
+		bool operator == (const MATRIX &m) const { return _11 == m._11 && _12 == m._12 && _13 == m._13 && _14 == m._14 && _21 == m._21 && _22 == m._22 && _23 == m._23 && _24 == m._24 && _31 == m._31 && _32 == m._32 && _33 == m._33 && _34 == m._34 && _41 == m._41 && _42 == m._42 && _43 == m._43 && _44 == m._44; }
+		bool operator != (const MATRIX &m) const { return _11 != m._11 || _12 != m._12 || _13 != m._13 || _14 != m._14 || _21 != m._21 || _22 != m._22 || _23 != m._23 || _24 != m._24 || _31 != m._31 || _32 != m._32 || _33 != m._33 || _34 != m._34 || _41 != m._41 || _42 != m._42 || _43 != m._43 || _44 != m._44; }
+
+		float & operator () (unsigned Row, unsigned Col) { return m[Row][Col]; }
+		float operator () (unsigned Row, unsigned Col) const { return m[Row][Col]; }
+
+		MATRIX operator + () const { return *this; }
+		MATRIX operator - () const;
+		MATRIX operator + (const MATRIX &m) const;
+		MATRIX operator - (const MATRIX &m) const;
+		MATRIX operator * (const MATRIX &m) const
+		{
+			return MATRIX(
+				_11 * m._11 + _12 * m._21 + _13 * m._31 + _14 * m._41,
+				_11 * m._12 + _12 * m._22 + _13 * m._32 + _14 * m._42,
+				_11 * m._13 + _12 * m._23 + _13 * m._33 + _14 * m._43,
+				_11 * m._14 + _12 * m._24 + _13 * m._34 + _14 * m._44,
+
+				_21 * m._11 + _22 * m._21 + _23 * m._31 + _24 * m._41,
+				_21 * m._12 + _22 * m._22 + _23 * m._32 + _24 * m._42,
+				_21 * m._13 + _22 * m._23 + _23 * m._33 + _24 * m._43,
+				_21 * m._14 + _22 * m._24 + _23 * m._34 + _24 * m._44,
+
+				_31 * m._11 + _32 * m._21 + _33 * m._31 + _34 * m._41,
+				_31 * m._12 + _32 * m._22 + _33 * m._32 + _34 * m._42,
+				_31 * m._13 + _32 * m._23 + _33 * m._33 + _34 * m._43,
+				_31 * m._14 + _32 * m._24 + _33 * m._34 + _34 * m._44,
+
+				_41 * m._11 + _42 * m._21 + _43 * m._31 + _44 * m._41,
+				_41 * m._12 + _42 * m._22 + _43 * m._32 + _44 * m._42,
+				_41 * m._13 + _42 * m._23 + _43 * m._33 + _44 * m._43,
+				_41 * m._14 + _42 * m._24 + _43 * m._34 + _44 * m._44);
+		}
+		MATRIX & operator += (const MATRIX &m);
+		MATRIX & operator -= (const MATRIX &m);
+		MATRIX & operator *= (const MATRIX &m);
+
+		MATRIX operator * (float s) const;
+		MATRIX operator / (float s) const;
+		MATRIX & operator *= (float s);
+		MATRIX & operator /= (float s);
+	};
+#endif
+
+extern const MATRIX MATRIX_ZERO;
+extern const MATRIX MATRIX_IDENTITY;
+
+void MatrixToStr(tstring *Out, const MATRIX &m);
+bool StrToMatrix(MATRIX *Out, const tstring &Str);
+
+inline void swap(MATRIX &m1, MATRIX &m2)
+{
+	std::swap(m1._11, m2._11); std::swap(m1._12, m2._12); std::swap(m1._13, m2._13); std::swap(m1._14, m2._14);
+	std::swap(m1._21, m2._21); std::swap(m1._22, m2._22); std::swap(m1._23, m2._23); std::swap(m1._24, m2._24);
+	std::swap(m1._31, m2._31); std::swap(m1._32, m2._32); std::swap(m1._33, m2._33); std::swap(m1._34, m2._34);
+	std::swap(m1._41, m2._41); std::swap(m1._42, m2._42); std::swap(m1._43, m2._43); std::swap(m1._44, m2._44);
+}
+
+/// Zwraca true, jeśli podane macierze są sobie mniej więcej równe
+bool MatrixEqual(const MATRIX &m1, const MATRIX &m2);
+/// Negacja macierzy w miejscu
+void Minus(MATRIX *m);
+/// Dodawanie macierzy
+void Add(MATRIX *Out, const MATRIX &m1, const MATRIX &m2);
+/// Odejmowanie macierzy
+void Sub(MATRIX *Out, const MATRIX &m1, const MATRIX &m2);
+/// Mnożenie macierzy
+void Mul(MATRIX *Out, const MATRIX &m1, const MATRIX &m2);
+/// Mnożenie macierzy przez skalar w miejscu
+void Mul(MATRIX *m, float s);
+/// Dzielenie macierzy przez skalar w miejscu
+void Div(MATRIX *m, float s);
+
+/// Multiplication of 3x3 submatrices
+/** m1 and m2 are assumed to be in form of linear transforms like this
+(4th rows and columns are ignored):
+\verbatim
+_11 _12 _13  0
+_21 _22 _23  0
+_31 _32 _33  0
+ 0   0   0   1
+\endverbatim
+Output matrix has only 3x3 submatrix modified.
+4th row and column stay untouched. \n
+Use this method for better efficiency whenever you deal with transforms that have no translation or perspective projection.
+*/
+void Mul3x3(MATRIX &out, const MATRIX &m1, const MATRIX &m2);
+/// Multiplication of 4x3 submatrices
+/** m1 and m2 are assumed to be in form of affine transforms like this
+(4th columns are ignored):
+\verbatim
+_11 _12 _13  0
+_21 _22 _23  0
+_31 _32 _33  0
+_41 _42 _43  1
+\endverbatim
+Output matrix has only 4x3 submatrix modified.
+4th column stays untouched.
+Use this method for better efficiency whenever you deal with transforms that have no perspective projection.
+*/
+void Mul4x3(MATRIX &out, const MATRIX &m1, const MATRIX &m2);
+
+/// Mnożenie wektora 2D jako [x,y,0,1] przez macierz, wychodzi wektor 4D
+void Transform(VEC4 *Out, const VEC2 &v, const MATRIX &m);
+/// Mnożenie wektora 2D jako [x,y,0,1] przez macierz z olaniem wyjściowego W
+void Transform(VEC2 *Out, const VEC2 &v, const MATRIX &m);
+/// Mnożenie wektora 2D jako [x,y,0,1] przez macierz i sprowadzenie z powrotem do 2D przez podzielenie przez W
+void TransformCoord(VEC2 *Out, const VEC2 &v, const MATRIX &m);
+/// Mnożenie wektora 2D jako [x,y,0,0] przez macierz
+void TransformNormal(VEC2 *Out, const VEC2 &v, const MATRIX &m);
+
+/// Mnożenie wektora 3D jako [X,Y,Z,1] przez macierz, wychodzi wektor 4D
+void Transform(VEC4 *Out, const VEC3 &v, const MATRIX &m);
+/// Mnożenie wektora 3D jako [X,Y,Z,1] przez macierz z olaniem wyjściowego W
+/** Dobre do przekształcania wektorów 3D jeśli macierz reprezentuje przekształcenie liniowe. */
+void Transform(VEC3 *Out, const VEC3 &v, const MATRIX &m);
+/// Mnożenie wektora 3D jako [X,Y,Z,1] przez macierz i sprowadzenie z powrotem do 3D przez podzielenie przez W
+/** Dobre do niezawodnego przekształcania wektorów 3D przez dowolną macierz np. rzutowania. */
+void TransformCoord(VEC3 *Out, const VEC3 &v, const MATRIX &m);
+/// Mnożenie wektora 3D jako [X,Y,Z,0] przez macierz
+/** Dobre do przekształcania wektorów (np. normalnych), nie punktów, bo nie robi translacji. */
+void TransformNormal(VEC3 *Out, const VEC3 &v, const MATRIX &m);
+
+/// Przekształca na raz całą tablicę wektorów - w miejscu lub z tablicy wejściowej do wyjściowej
+void TransformArray(VEC3 OutPoints[], const VEC3 InPoints[], size_t PointCount, const MATRIX &M);
+void TransformArray(VEC3 InOutPoints[], size_t PointCount, const MATRIX &M);
+void TransformNormalArray(VEC3 OutPoints[], const VEC3 InPoints[], size_t PointCount, const MATRIX &M);
+void TransformNormalArray(VEC3 InOutPoints[], size_t PointCount, const MATRIX &M);
+void TransformCoordArray(VEC3 OutPoints[], const VEC3 InPoints[], size_t PointCount, const MATRIX &M);
+void TransformCoordArray(VEC3 InOutPoints[], size_t PointCount, const MATRIX &M);
+
+/// Mnożenie wektora 4D przez macierz
+/** Czyli przekształcenie wektora we współrzędnych jednorodnych przez tą macierz. */
+void Transform(VEC4 *Out, const VEC4 &v, const MATRIX &m);
+
+/// Mnoży wektor przez transpozycję podanej macierzy m (jej podmacierzy 3x3)
+void TransformNormalByTranspose(VEC3 *Out, const VEC3 &v, const MATRIX &m);
+/// Mnoży punkt przez odwrotnosć podanej macierzy m (jej podmacierzy 4x3), ale bez odwracania.
+/** Czyli jeśli macierz zawiera rotację i translację, to wykonuje na punkcie
+przekształcenie odwrotne do tego które jest w tej macierzy. \n
+Pomysłodawca: Krzysiek K. */
+void Untransform(VEC3 *Out, const VEC3 &v, const MATRIX &m);
+/// Mnoży wektor przez odwrotnosć podanej macierzy m (jej podmacierzy 3x3), ale bez odwracania.
+/** Czyli jeśli macierz zawiera rotację i translację, to wykonuje na punkcie
+przekształcenie odwrotne do rotacji, która jest w tej macierzy. */
+void UntransformNormal(VEC3 *Out, const VEC3 &v, const MATRIX &m);
+
+/// Przekształca płaszczyznę przez macierz
+/** \param p Płaszczyzna ma być znormalizowana.
+\param m Macierz ma być odwrotna i transponowana względem normalnej macierzy. */
+void Transform(PLANE *Out, const PLANE &p, const MATRIX &m);
+/// Przekształca promień przez macierz
+void TransformRay(VEC3 *OutOrigin, VEC3 *OutDir, const VEC3 &RayOrigin, const VEC3 &RayDir, const MATRIX &m);
+
+/// Przekształca AABB przez podaną macierz i wylicza AABB tego co wyszło po przekształceniu
+void TransformBox(BOX *Out, const BOX &In, const MATRIX &M);
+/// Przekształca AABB przez podaną macierz i wylicza AABB tego co wyszło po przekształceniu
+/** Wersja dzieląca przez W - można stosować też do macierzy projekcji. */
+void TransformBoxCoord(BOX *Out, const BOX &In, const MATRIX &M);
+
+/// Ustawia translację w macierzy
+void MatrixSetTranslation(MATRIX *InOut, float TranslationX, float TranslationY, float TranslationZ);
+/// Ustawia translację w macierzy
+void MatrixSetTranslation(MATRIX *InOut, const VEC3 &Translation);
+/// Pobiera translację z macierzy
+void MatrixGetTranslation(float *OutTranslationX, float *OutTranslationY, float *OutTranslationZ, const MATRIX &m);
+/// Pobiera translację z macierzy
+void MatrixGetTranslation(VEC3 *OutTranslation, const MATRIX &m);
+
+/// Tworzy macierz przekształcającą do lokalnego układu współrzędnych wyznaczonego przez podane 3 osie
+/** Nastąpi obrót, a jeśli nie są znormalizowane to i skalowanie. */
+void AxesToMatrix(MATRIX *Out, const VEC3 &AxisX, const VEC3 &AxisY, const VEC3 &AxisZ);
+/// Tworzy macierz przekształcającą do lokalnego układu współrzędnych wyznaczonego przez podane 3 osie i pozycję początku tego układu.
+/** Nastąpi obrót, a jeśli osie są znormalizowane to i skalowanie. */
+void AxesToMatrixTranslation(MATRIX *Out, const VEC3 &Origin, const VEC3 &AxisX, const VEC3 &AxisY, const VEC3 &AxisZ);
+
+/// Macierz kamery
+/** Eye to punkt, Forward i Up to wektory. */
+void LookAtLH(MATRIX *Out, const VEC3 &Eye, const VEC3 &Forward, const VEC3 &Up);
+void LookAtRH(MATRIX *Out, const VEC3 &Eye, const VEC3 &Forward, const VEC3 &Up);
+
+/// Tworzy macierz identycznościową
+void Identity(MATRIX *Out);
+/// Tworzy macierz translacji (przesuwania)
+void Translation(MATRIX *Out, float x, float y, float z);
+void Translation(MATRIX *Out, const VEC3 &v);
+/// Tworzy macierz skalowania (powiększania, pomniejszania, rozciągania)
+void Scaling(MATRIX *Out, float sx, float sy, float sz);
+void Scaling(MATRIX *Out, const VEC3 &sv);
+void Scaling(MATRIX *Out, float s);
+/// Tworzy macierz skalowania wzdłuż podanego kierunku
+/** \param k   współczynnik skalowania
+\param n   wektor kierunku, musi być znormalizowany */
+void ScalingAxis(MATRIX *Out, const VEC3 &n, float k);
+
+/// Macierz obrotu 2D
+void Rotation2D(MATRIX *Out, float Angle);
+/// Macierz obrotu wokół osi X
+void RotationX(MATRIX *Out, float Angle);
+/// Macierz obrotu wokół osi Y
+void RotationY(MATRIX *Out, float Angle);
+/// Macierz obrotu wokół osi Z
+void RotationZ(MATRIX *Out, float Angle);
+/** Axis musi być znormalizowany. */
+void RotationAxisLH(MATRIX *Out, const VEC3 &Axis, float Angle);
+inline void RotationAxisRH(MATRIX *Out, const VEC3 &Axis, float Angle) { RotationAxisLH(Out, Axis, -Angle); }
+
+/// Macierz obrotu wokół trzech osi w kolejności Yaw-Pitch-Roll (ZXY) - tzw. kąty Eulera
+/** W przypadku wektora składowe odpowiadają obrotom wokół poszczególnych osi, czyli:
+  X = Pitch, Y = Yaw, Z = Roll
+Przekształca ze wsp. obiektu do świata (object -> interial space).
+Czyli tak naprawdę robi ZXY.
+\param Yaw jest wokół osi Y.
+\param Pitch jest wokół osi X.
+\param Roll jest wokół osi Z. */
+void RotationYawPitchRoll(MATRIX *Out, float Yaw, float Pitch, float Roll);
+void RotationYawPitchRoll(MATRIX *Out, const VEC3 &EulerAngles);
+/// Przekształca ze wsp. świata do obiektu (interial -> object space).
+/** Czyli tworzy macierz dokładnie odwrotną do tej z RotationYawPitchRoll. */
+void RotationYawPitchRollInv(MATRIX *Out, float Yaw, float Pitch, float Roll);
+void RotationYawPitchRollInv(MATRIX *Out, const VEC3 &EulerAngles);
+
+/*/// Przetwarza macierz obrotu (to musi być czysta macierz obrotu) na kąty Eulera
+void RotationMatrixToEulerAngles(const MATRIX &m, float *Yaw, float *Pitch, float *Roll);*/
+
+/// Tworzy macierz rzutowania ortogonalnego
+/** Dane są w układzie kamery. */
+void OrthoLH(MATRIX *Out, float Width, float Height, float ZNear, float ZFar);
+void OrthoRH(MATRIX *Out, float Width, float Height, float ZNear, float ZFar);
+void OrthoOffCenterLH(MATRIX *Out, float Left, float Right, float Bottom, float Top, float ZNear, float ZFar);
+void OrthoOffCenterRH(MATRIX *Out, float Left, float Right, float Bottom, float Top, float ZNear, float ZFar);
+/// Tworzy macierz rzutowania perspektywicznego
+/** Width i Height są wymiarami na płaszczyźnie bliskiej (near).
+Left, Top, Right, Bottom prawdopodobnie też.
+Tworzone macierze są "W-Friendly" - wektor przemnożony przez taką macierz ma w składowej W komponent Z.
+*/
+void PerspectiveLH(MATRIX *Out, float Width, float Height, float ZNear, float ZFar);
+void PerspectiveRH(MATRIX *Out, float Width, float Height, float ZNear, float ZFar);
+void PerspectiveFovLH(MATRIX *Out, float FovY, float Aspect, float ZNear, float ZFar);
+void PerspectiveFovRH(MATRIX *Out, float FovY, float Aspect, float ZNear, float ZFar);
+void PerspectiveOffCenterLH(MATRIX *Out, float Left, float Right, float Bottom, float Top, float ZNear, float ZFar);
+void PerspectiveOffCenterRH(MATRIX *Out, float Left, float Right, float Bottom, float Top, float ZNear, float ZFar);
+/// Wersja tworząca macierz z Z-Far = INFINITY
+void PerspectiveFovLH_Inf(MATRIX *Out, float FovY, float Aspect, float ZNear);
+/// Tworzy macierz spłaszczającą geometrię na podaną płaszczyznę w podanym kierunku padania światła
+/** Płaszczyzna musi być znormalizowana. */
+void MatrixShadow(MATRIX *Out, const VEC4 &Light, const PLANE &Plane);
+/// Tworzy macierz odbijającą geometrię względem podanej płaszczyzny
+/** Płaszczyzna musi być znormalizowana. */
+void MatrixReflect(MATRIX *Out, const PLANE &p);
+
+/// Transpozycja macierzy na miejscu
+void Transpose(MATRIX *m);
+/// Transpozycja macierzy
+void Transpose(MATRIX *Out, const MATRIX &m);
+/// Interpolacja liniowa macierzy
+void Lerp(MATRIX *Out, const MATRIX &m1, const MATRIX &m2, float t);
+/// Wyznacznik macierzy
+float Det(const MATRIX &m);
+/// Odwrotność macierzy
+bool Inverse(MATRIX *Out, const MATRIX &m);
+
+
+/// Macierz 3 x 3
+/**
+Elementy są indeksowane [wiersz,kolumna].
+Reprezentacja tekstowa to:
+	a11,a12,a13,a21,a22,a23,a31,a32,a33
+*/
+struct MATRIX33
+{
+	union
+	{
+		struct
+		{
+			float _11, _12, _13;
+			float _21, _22, _23;
+			float _31, _32, _33;
+		};
+		float m[3][3]; // [wiersz][kolumna]
+	};
+
+	MATRIX33() { }
+	MATRIX33(float _11, float _12, float _13, float _21, float _22, float _23, float _31, float _32, float _33) : _11(_11), _12(_12), _13(_13), _21(_21), _22(_22), _23(_23), _31(_31), _32(_32), _33(_33) { }
+	MATRIX33(const float *Array) : _11(Array[0]), _12(Array[1]), _13(Array[2]), _21(Array[4]), _22(Array[5]), _23(Array[6]), _31(Array[8]), _32(Array[9]), _33(Array[10]) { }
+
+	operator float * () { return &_11; }
+	operator const float * () const { return &_11; }
+
+	bool operator == (const MATRIX33 &m) const { return _11 == m._11 && _12 == m._12 && _13 == m._13 && _21 == m._21 && _22 == m._22 && _23 == m._23 && _31 == m._31 && _32 == m._32 && _33 == m._33; }
+	bool operator != (const MATRIX33 &m) const { return _11 != m._11 || _12 != m._12 || _13 != m._13 || _21 != m._21 || _22 != m._22 || _23 != m._23 || _31 != m._31 || _32 != m._32 || _33 != m._33; }
+
+	float & operator () (unsigned Row, unsigned Col) { return m[Row][Col]; }
+	float operator () (unsigned Row, unsigned Col) const { return m[Row][Col]; }
+
+	MATRIX33 operator + () const { return *this; }
+	MATRIX33 operator - () const;
+	MATRIX33 operator + (const MATRIX33 &m) const;
+	MATRIX33 operator - (const MATRIX33 &m) const;
+	MATRIX33 operator * (const MATRIX33 &m) const
+	{
+		return MATRIX33(
+			_11 * m._11 + _12 * m._21 + _13 * m._31,
+			_11 * m._12 + _12 * m._22 + _13 * m._32,
+			_11 * m._13 + _12 * m._23 + _13 * m._33,
+
+			_21 * m._11 + _22 * m._21 + _23 * m._31,
+			_21 * m._12 + _22 * m._22 + _23 * m._32,
+			_21 * m._13 + _22 * m._23 + _23 * m._33,
+
+			_31 * m._11 + _32 * m._21 + _33 * m._31,
+			_31 * m._12 + _32 * m._22 + _33 * m._32,
+			_31 * m._13 + _32 * m._23 + _33 * m._33);
+	}
+	MATRIX33 & operator += (const MATRIX33 &m);
+	MATRIX33 & operator -= (const MATRIX33 &m);
+	MATRIX33 & operator *= (const MATRIX33 &m);
+
+	MATRIX33 operator * (float s) const;
+	MATRIX33 operator / (float s) const;
+	MATRIX33 & operator *= (float s);
+	MATRIX33 & operator /= (float s);
+};
+
+extern const MATRIX33 MATRIX33_ZERO;
+extern const MATRIX33 MATRIX33_IDENTITY;
+
+/// Konwertuje macierz 3x3 na macierz 4x4
+void Matrix33ToMatrix(MATRIX *Out, const MATRIX33 &m);
+/// Wyciąga podmacierz 3x3 z macierzy 4x4
+void MatrixToMatrix33(MATRIX33 *Out, const MATRIX &m);
+
+/// Tworzy macierz identycznościową
+void Identity(MATRIX33 *Out);
+
+/// Transpozycja macierzy na miejscu
+void Transpose(MATRIX33 *m);
+/// Transpozycja macierzy
+void Transpose(MATRIX33 *Out, const MATRIX33 &m);
+
+//@}
+// math_matrix
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+/** \addtogroup math_quaternion Kwaternion */
+//@{
+
+#if defined(USE_DIRECTX) && !defined(DOXYGEN)
+	typedef D3DXQUATERNION QUATERNION;
+#else
+	/// Kwaternion
+	/**
+	Reprezentacja jako łańcuch to: "x,y,z,w", np.: "1,2,3.5,-10".
+	Kwaterniony są mnożone od drugiej strony niż matematycznie, dzięki czemu można
+	łączyć obroty które reprezentują w porządku naturalnym, tak jak macierze.
+	*/
+	struct QUATERNION
+	{
+		float x, y, z, w;
+
+		QUATERNION() { }
+		QUATERNION(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) { }
+		QUATERNION(const float *Array) : x(Array[0]), y(Array[1]), z(Array[2]), w(Array[3]) { }
+
+		operator float * () { return &x; }
+		operator const float * () const { return &x; }
+
+		bool operator == (const QUATERNION &v) const { return x == v.x && y == v.y && z == v.z && w == v.w; }
+		bool operator != (const QUATERNION &v) const { return x != v.x || y != v.y || z != v.z || w != v.w; }
+
+		QUATERNION operator + () const { return *this; }
+		QUATERNION operator - () const { return QUATERNION(-x, -y, -z, -w); }
+		QUATERNION operator + (const QUATERNION &q) const { return QUATERNION(x+q.x, y+q.y, z+q.z, w+q.w); }
+		QUATERNION operator - (const QUATERNION &q) const { return QUATERNION(x-q.x, y-q.y, z-q.z, w-q.w); }
+		QUATERNION operator * (const QUATERNION &q) const { return QUATERNION(w*q.x + x*q.w + y*q.z - z*q.y, w*q.y + y*q.w + z*q.x - x*q.z, w*q.z + z*q.w + x*q.y - y*q.x, w*q.w - x*q.x - y*q.y - z*q.z); }
+		QUATERNION & operator += (const QUATERNION &q) { x += q.x; y += q.y; z += q.z; w += q.w; return *this; }
+		QUATERNION & operator -= (const QUATERNION &q) { x -= q.x; y -= q.y; z -= q.z; w -= q.w; return *this; }
+		QUATERNION & operator *= (const QUATERNION &q) { QUATERNION R; R.x = w*q.x + x*q.w + y*q.z - z*q.y; R.y = w*q.y + y*q.w + z*q.x - x*q.z; R.z = w*q.z + z*q.w + x*q.y - y*q.x; R.w = w*q.w - x*q.x - y*q.y - z*q.z; *this = R; return *this; }
+		QUATERNION & operator *= (float v) { x *= v; y *= v; z *= v; w *= v; return *this; }
+		QUATERNION & operator /= (float v) { float vInv = 1.0f/v; x *= vInv; y *= vInv; z *= vInv; w *= vInv; return *this; }
+	};
+	inline QUATERNION operator * (const QUATERNION &pt, float v) { return QUATERNION(pt.x*v, pt.y*v, pt.z*v, pt.w*v); }
+	inline QUATERNION operator / (const QUATERNION &pt, float v) { float vInv = 1.0f/v; return QUATERNION(pt.x*vInv, pt.y*vInv, pt.z*vInv, pt.w*vInv); }
+	inline QUATERNION operator * (float v, const QUATERNION &pt) { return QUATERNION(pt.x*v, pt.y*v, pt.z*v, pt.w*v); }
+	inline QUATERNION operator / (float v, const QUATERNION &pt) { float vInv = 1.0f/v; return QUATERNION(pt.x*vInv, pt.y*vInv, pt.z*vInv, pt.w*vInv); }
+#endif
+
+extern const QUATERNION QUATERNION_ZERO;
+extern const QUATERNION QUATERNION_IDENTITY;
+
+inline void swap(QUATERNION &v1, QUATERNION &v2)
+{
+	std::swap(v1.x, v2.x);
+	std::swap(v1.y, v2.y);
+	std::swap(v1.z, v2.z);
+	std::swap(v1.w, v2.w);
+}
+
+/// Zwraca kąt obrotu jaki reprezentuje ten kwaternion
+inline float CalcQuaternionAngle(const QUATERNION &Q) { return safe_acos(Q.w) * 2.0f; }
+/// Zwraca oś obrotu jaką reprezentuje ten kwaternion
+void CalcQuaternionAxis(VEC3 *Out, const QUATERNION &Q);
+
+/// Zwraca true, jeśli podane kwaterniony są sobie mniej więcej równe
+inline bool QuaternionEqual(const QUATERNION &q1, const QUATERNION &q2) {
+	return float_equal(q1.x, q2.x) && float_equal(q1.y, q2.y) && float_equal(q1.z, q2.z) && float_equal(q1.w, q2.w);
+}
+
+/// Ujemny kwaternion
+void Minus(QUATERNION *q);
+inline void Minus(QUATERNION *Out, const QUATERNION &q) { *Out = q; Minus(Out); }
+/// Dodawanie, odejmowanie, mnożenie kwaternionów
+void Add(QUATERNION *Out, const QUATERNION &q1, const QUATERNION &q2);
+void Sub(QUATERNION *Out, const QUATERNION &q1, const QUATERNION &q2);
+void Mul(QUATERNION *Out, const QUATERNION &q1, const QUATERNION &q2);
+/// Mnożenie i dzielenie kwaterniona przez skalar
+void Mul(QUATERNION *q, float v);
+void Div(QUATERNION *q, float v);
+inline void Mul(QUATERNION *Out, const QUATERNION &q, float v) { *Out = q; Mul(Out, v); }
+inline void Div(QUATERNION *Out, const QUATERNION &q, float v) { *Out = q; Div(Out, v); }
+
+/// Tworzy kwaternion na podstawie macierzy obrotu
+void RotationMatrixToQuaternion(QUATERNION *Out, const MATRIX &RotationMatrix);
+/// Przekształca kwaternion w macierz obrotu
+void QuaternionToRotationMatrix(MATRIX *Out, const QUATERNION &q);
+/// Przekształca punkt/wektor przez kwaternion obracając go o ten kwaternion
+/**
+- To nie jest wcale super szybkie i nie przydaje się aż tak często.
+  Lepiej sobie przekształcić kwaternion na macierz.
+- Out = q * p * q^-1
+*/
+void QuaternionTransform(VEC3 *Out, const VEC3 &p, const QUATERNION &q);
+/// Konwersja kątów Eulera na kwaternion (który obraca ze wsp. obiektu do świata, czyli object -> interial space) [a może odwrotnie?]
+/** Ta funkcja działa identycznie z D3DXQuaternionRotationYawPitchRoll. */
+void EulerAnglesToQuaternionO2I(QUATERNION *Out, float Yaw, float Pitch, float Roll);
+/// Konwersja kątów Eulera na kwaternion (który obraca ze wsp. świata do obiektu, czyli interial -> object space) [a może odwrotnie?]
+void EulerAnglesToQuaternionI2O(QUATERNION *Out, float Yaw, float Pitch, float Roll);
+/// Konwersja kwaterniona który obraca ze wsp. obiektu do świata, czyli object -> interial space, na kąty Eulera
+void QuaternionO2IToEulerAngles(float *Yaw, float *Pitch, float *Roll, const QUATERNION &q);
+/// Konwersja kwaterniona który obraca ze wsp. świata do obiektu, czyli interial -> object space, na kąty Eulera
+void QuaternionI2OToEulerAngles(float *Yaw, float *Pitch, float *Roll, const QUATERNION &q);
+
+/// Tworzy kwaternion obracający wokół osi X
+void QuaternionRotationX(QUATERNION *Out, float a);
+/// Tworzy kwaternion obracający wokół osi Y
+void QuaternionRotationY(QUATERNION *Out, float a);
+/// Tworzy kwaternion obracający wokół osi Z
+void QuaternionRotationZ(QUATERNION *Out, float a);
+/// Tworzy kwaternion na podstawie osi obrotu i kąta
+void AxisToQuaternion(QUATERNION *Out, const VEC3 &Axis, float Angle);
+
+/// Oblica "różnicę" dwóch kwaternionów reprezentującą taki obrót że a*Out = b
+/** To jest obliczane tak: Out = a^-1 * b, więc jeśli masz już a^-1 to nie używaj. */
+void QuaternionDiff(QUATERNION *Out, const QUATERNION &a, const QUATERNION &b);
+/// Kwaternion sprzężony do danego
+void Conjugate(QUATERNION *q);
+inline void Conjugate(QUATERNION *Out, const QUATERNION &q) { *Out = q; Conjugate(Out); }
+/// Odwrotność kwaterniona
+void Inverse(QUATERNION *Out, const QUATERNION &q);
+/// Normalizacja kwaternion
+void Normalize(QUATERNION *Out, const QUATERNION &q);
+void Normalize(QUATERNION *InOut);
+/// Iloczyn skalarny dwóch kwaternionów
+float Dot(const QUATERNION &q1, const QUATERNION &q2);
+/// Kwadrat długości kwaterniona
+float LengthSq(const QUATERNION &q);
+/// Długość kwaterniona
+float Length(const QUATERNION &q);
+void Log(QUATERNION *Out, const QUATERNION &q);
+void Exp(QUATERNION *Out, const QUATERNION &q);
+/// Podnieś kwaternion do potęgi.
+/** Wykładnik 0..1 daje interpolacje kwaterniona od identycznościowego do q. */
+void Pow(QUATERNION *InOut, float t);
+inline void Pow(QUATERNION *Out, const QUATERNION &q, float t) { *Out = q; Pow(Out, t); }
+/// Interpolacja normalna kwaternionów
+void Lerp(QUATERNION *Out, const QUATERNION &q1, const QUATERNION &q2, float t);
+/// Interpolacja sferyczna kwaternionów
+/** Sprawdzona, daje wyniki dokładnie tekie same jak D3DXQuaternionSlerp. */
+void Slerp(QUATERNION *Out, const QUATERNION &q0, const QUATERNION &q1, float t);
+/** NIE TESTOWANA */
+void Squad(QUATERNION *Out, const QUATERNION &Q1, const QUATERNION &A, const QUATERNION &B, const QUATERNION &C, float t);
+/** NIE TESTOWANA */
+void SquadSetup(QUATERNION *OutA, QUATERNION *OutB, QUATERNION *OutC, const QUATERNION &Q0, const QUATERNION &Q1, const QUATERNION &Q2, const QUATERNION &Q3);
+
+//@}
+// math_quaternion
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+/** \addtogroup math_affine2d Affine 2D transform */
+//@{
+
+/// Affine transform of 2D point/vector
+/**
+\verbatim
+(xOut, yOut) = | a b |  | x | + | c |
+               | d e |  | y |   | f |
+\endverbatim
+It means that:
+\verbatim
+(xOut, yOut) = (a*x + b*y + c, d*x + e*y + f)
+\endverbatim
+Multiplication order is OpenGL-like, opposite to what MATRIX represents. \n
+Elements are indexed as [row, column]. \n
+Text representation is: a,b,c;d,e,f
+*/
+struct AFFINE2D
+{
+	union {
+		struct {
+			float a, b, c, d, e, f;
+		};
+		float m[2][3];
+	};
+
+	AFFINE2D() { }
+	AFFINE2D(float a, float b, float c, float d, float e, float f) : a(a), b(b), c(c), d(d), e(e), f(f) { }
+	AFFINE2D(const float *arr) : a(arr[0]), b(arr[1]), c(arr[2]), d(arr[3]), e(arr[4]), f(arr[5]) { }
+
+	operator float * () { return &a; }
+	operator const float * () const { return &a; }
+
+	float & operator [] (size_t index) { return (&a)[index]; }
+	float operator [] (size_t index) const { return (&a)[index]; }
+
+	bool operator == (const AFFINE2D &rhs) const { return a == rhs.a && b == rhs.b && c == rhs.c && d == rhs.d && e == rhs.e && f == rhs.f; }
+	bool operator != (const AFFINE2D &rhs) const { return a != rhs.a || b != rhs.b || c != rhs.c || d != rhs.d || e != rhs.e || f != rhs.f; }
+
+	float & operator () (uint row, uint col) { return m[row][col]; }
+	float operator () (uint row, uint col) const { return m[row][col]; }
+
+	AFFINE2D operator + () const { return *this; }
+	AFFINE2D operator - () const { return AFFINE2D(-a, -b, -c, -d, -e, -f); }
+
+	AFFINE2D operator + (const AFFINE2D &rhs) const { return AFFINE2D(a + rhs.a, b + rhs.b, c + rhs.c, d + rhs.d, e + rhs.e, f + rhs.f); }
+	AFFINE2D operator - (const AFFINE2D &rhs) const { return AFFINE2D(a - rhs.a, b - rhs.b, c - rhs.c, d - rhs.d, e - rhs.e, f - rhs.f); }
+	AFFINE2D operator * (const AFFINE2D &rhs) const
+	{
+		return AFFINE2D(
+			a*rhs.a + b*rhs.d, a*rhs.b + b*rhs.e, a*rhs.c + b*rhs.f + c,
+			d*rhs.a + e*rhs.d, d*rhs.b + e*rhs.e, d*rhs.c + e*rhs.f + f);
+	}
+
+	AFFINE2D & operator += (const AFFINE2D &rhs) { a += rhs.a; b += rhs.b; c += rhs.c; d += rhs.d; e += rhs.e; f += rhs.f; return *this; }
+	AFFINE2D & operator -= (const AFFINE2D &rhs) { a -= rhs.a; b -= rhs.b; c -= rhs.c; d -= rhs.d; e -= rhs.e; f -= rhs.f; return *this; }
+	AFFINE2D & operator *= (const AFFINE2D &rhs) { return *this = *this * rhs; }
+
+	AFFINE2D operator * (float s) const { return AFFINE2D(a*s, b*s, c*s, d*s, e*s, f*s); }
+	AFFINE2D operator / (float s) const { s = 1.f/s; return AFFINE2D(a*s, b*s, c*s, d*s, e*s, f*s); }
+	AFFINE2D & operator *= (float s) { a*=s; b*=s; c*=s; d*=s; e*=s; f*=s; return *this; }
+	AFFINE2D & operator /= (float s) { s = 1.f/s; a*=s; b*=s; c*=s; d*=s; e*=s; f*=s; return *this; }
+};
+
+extern const AFFINE2D AFFINE2D_ZERO;
+extern const AFFINE2D AFFINE2D_IDENTITY;
+
+void Affine2dToStr(tstring *Out, const AFFINE2D &aff);
+bool StrToAffine2d(AFFINE2D *Out, const tstring &Str);
+
+inline void swap(AFFINE2D &aff1, AFFINE2D &aff2)
+{
+	std::swap(aff1.a, aff2.a); std::swap(aff1.b, aff2.b); std::swap(aff1.c, aff2.c);
+	std::swap(aff1.d, aff2.d); std::swap(aff1.e, aff2.e); std::swap(aff1.f, aff2.f);
+}
+
+/// Per component multiplication.
+inline void Mul(AFFINE2D &out, const AFFINE2D &lhs, const AFFINE2D &rhs)
+{
+	out.a = lhs.a*rhs.a; out.b = lhs.b*rhs.b; out.c = lhs.c*rhs.c;
+	out.d = lhs.d*rhs.d; out.e = lhs.e*rhs.e; out.f = lhs.f*rhs.f;
+}
+/// Per component division.
+inline void Div(AFFINE2D &out, const AFFINE2D &lhs, const AFFINE2D &rhs)
+{
+	out.a = lhs.a/rhs.a; out.b = lhs.b/rhs.b; out.c = lhs.c/rhs.c;
+	out.d = lhs.d/rhs.d; out.e = lhs.e/rhs.e; out.f = lhs.f/rhs.f;
+}
+
+/// 2D point transformation, including translation.
+inline void Transform(VEC2 &out, const VEC2 &v, const AFFINE2D &aff)
+{
+	out.x = aff.a*v.x + aff.b*v.y + aff.c;
+	out.y = aff.d*v.x + aff.e*v.y + aff.f;
+}
+/// 2D vector transformation by 2x2 submatrix, with no translation.
+inline void TransformNormal(VEC2 &out, const VEC2 &v, const AFFINE2D &aff)
+{
+	out.x = aff.a*v.x + aff.b*v.y;
+	out.y = aff.d*v.x + aff.e*v.y;
+}
+
+inline void Translation(AFFINE2D &out, const VEC2 &v)
+{
+	out = AFFINE2D(
+		1.f, 0.f, v.x,
+		0.f, 1.f, v.y);
+}
+inline void Translation(AFFINE2D &out, float x, float y)
+{
+	out = AFFINE2D(
+		1.f, 0.f, x,
+		0.f, 1.f, y);
+}
+
+inline void Scaling(AFFINE2D &out, float s)
+{
+	out = AFFINE2D(
+		s,   0.f, 0.f,
+		0.f, s,   0.f);
+}
+inline void Scaling(AFFINE2D &out, const VEC2 &v)
+{
+	out = AFFINE2D(
+		v.x, 0.f, 0.f,
+		0.f, v.y, 0.f);
+}
+inline void Scaling(AFFINE2D &out, float x, float y)
+{
+	out = AFFINE2D(
+		x,   0.f, 0.f,
+		0.f, y,   0.f);
+}
+
+inline void Rotation(AFFINE2D &out, float angle)
+{
+	float angleSin, angleCos;
+	sincos(angle, &angleSin, &angleCos);
+	out = AFFINE2D(
+		angleCos, -angleSin, 0.f,
+		angleSin,  angleCos, 0.f);
+}
+
+/// Transposes the 2x2 submatrix.
+inline void Transpose(AFFINE2D &inout)
+{
+	std::swap(inout.b, inout.d);
+}
+
+void Lerp(AFFINE2D &out, const AFFINE2D &lhs, const AFFINE2D &rhs, float t);
+void Inverse(AFFINE2D &out, const AFFINE2D &aff);
+
+/** Transforms between AFFINE2D and MATRIX, where MATRIX looks like this:
+\verbatim
+| a d 0 0 |
+| b e 0 0 |
+| 0 0 1 0 |
+| c f 0 1 |
+\endverbatim
+*/
+void Affine2dToMatrix(MATRIX &out, const AFFINE2D &aff);
+/// \copydoc common::Affine2dToMatrix
+void MatrixToAffine2d(AFFINE2D &out, const MATRIX &m);
+
+//@}
+// math_affine2d
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+/** \addtogroup math_frustum Frustum */
+//@{
+
+struct FRUSTUM_PLANES;
+struct FRUSTUM_POINTS;
+
+/// Frustum opisany 6 płaszczyznami z wektorami normalnymi zwróconymi do wewnątrz.
+/**
+Podczas tworzenia:
+- Jeśli WorldViewProj jest macierzą Proj, otrzymane płaszczyzny są we wsp. widoku.
+- Jeśli WorldViewProj jest macierzą View*Proj, otrzymane płaszczyzny są we wsp. świata.
+- Jeśli WorldViewProj jest macierzą World*View*Proj, otrzymane płaszczyzny są we wsp. lokalnych obiektu.
+*/
+struct FRUSTUM_PLANES
+{
+	/** \name Indeksy do tablicy płaszczyzn
+	Przedrostek PLANE_ jest, bo NEAR zostało gdzieś zdefiniowane jako makro - grrrrr!
+	*/
+	//@{
+	static const size_t PLANE_LEFT   = 0;
+	static const size_t PLANE_RIGHT  = 1;
+	static const size_t PLANE_TOP    = 2;
+	static const size_t PLANE_BOTTOM = 3;
+	static const size_t PLANE_NEAR   = 4;
+	static const size_t PLANE_FAR    = 5;
+	//@}
+
+	PLANE Planes[6];
+
+	/// Tworzy niezainicjalizowany
+	FRUSTUM_PLANES() { }
+	/// Inicjalizuje na podstawie macierzy
+	FRUSTUM_PLANES(const MATRIX &WorldViewProj) { Set(WorldViewProj); }
+	/// Inicjalizuje na podstawie reprezentacji punktowej
+	FRUSTUM_PLANES(const FRUSTUM_POINTS &FrustumPoints) { Set(FrustumPoints); }
+	/// Wypełnia
+	void Set(const MATRIX &WorldViewProj);
+	void Set(const FRUSTUM_POINTS &FrustumPoints);
+	/// Normalizuje płaszczyzny
+	void Normalize();
+
+	PLANE & operator [] (size_t Index) { return Planes[Index]; }
+	const PLANE & operator [] (size_t Index) const { return Planes[Index]; }
+};
+
+/// Frustum zapisany jako 8 wierzchołków
+/**
+Uzyskiwanie przez konwersję macierzy ViewProj do FRUSTUM_PLANES i z niego
+do FRUSTUM_POINTS jest dużo szybsze niż budowanie FRUSTUM_POINTS z macierzy
+ViewProjInv - 2 (Release) - 8 (Debug) razy szybsze!
+*/
+struct FRUSTUM_POINTS
+{
+	/** \name indeksy do tablicy punktów
+	Kolejno na przecięciu płaszczyzn. */
+	//@{
+	static const size_t NEAR_LEFT_BOTTOM  = 0;
+	static const size_t NEAR_RIGHT_BOTTOM = 1;
+	static const size_t NEAR_LEFT_TOP     = 2;
+	static const size_t NEAR_RIGHT_TOP    = 3;
+	static const size_t FAR_LEFT_BOTTOM   = 4;
+	static const size_t FAR_RIGHT_BOTTOM  = 5;
+	static const size_t FAR_LEFT_TOP      = 6;
+	static const size_t FAR_RIGHT_TOP     = 7;
+	//@}
+
+	VEC3 Points[8];
+
+	/// Tworzy niezainicjalizowany
+	FRUSTUM_POINTS() { }
+	/// Inicjalizuje na podstawie płaszczyzn
+	FRUSTUM_POINTS(const FRUSTUM_PLANES &FrustumPlanes) { Set(FrustumPlanes); }
+	/// Inicjalizuje na podstawie ODWROTNOŚCI macierzy View*Projection
+	FRUSTUM_POINTS(const MATRIX &WorldViewProjInv) { Set(WorldViewProjInv); }
+	/// Wypełnia
+	void Set(const FRUSTUM_PLANES &FrustumPlanes);
+	void Set(const MATRIX &WorldViewProjInv);
+
+	VEC3 & operator [] (size_t Index) { return Points[Index]; }
+	const VEC3 & operator [] (size_t Index) const { return Points[Index]; }
+
+	/// Wylicza i zwraca środek frustuma
+	void CalcCenter(VEC3 *Out) const;
+	/// Oblicza najmniejszy AABB otaczający frustum dany tymi punktami
+	void CalcBoundingBox(BOX *Box) const;
+	/// Oblicza sferę otaczającą frustum
+	/** Może nie najlepszą, ale jakąśtam... (a może to jest najlepsza? nie wiem :P) */
+	void CalcBoundingSphere(VEC3 *SphereCenter, float *SphereRadius) const;
+};
+
+/// Frustum - reprezentacja radarowa.
+/**
+- Bardzo szybki jest test kolizji z punktem i ze sferą (common::PointInFrustum,
+  common::SphereToFrustum).
+- UWAGA! Jako wektor Up podawać prawdziwy wektor kamery do góry, tzw. RealUp,
+  który jest naprawdę wzajemnie prostopadły do Forward i Right, a nie ten który
+  zawsze wynosi (0,1,0) - to był błąd którego się naszukałem.
+*/
+class FRUSTUM_RADAR
+{
+private:
+	VEC3 m_Eye;
+	VEC3 m_Forward;
+	VEC3 m_Up;
+	VEC3 m_Right;
+	float m_RFactor;
+	float m_UFactor;
+	float m_RSphereFactor;
+	float m_USphereFactor;
+	float m_ZNear;
+	float m_ZFar;
+
+public:
+	/// Tworzy niezainicjalizowany
+	FRUSTUM_RADAR() { }
+	/// Tworzy w pełni zainicjalizowany
+	FRUSTUM_RADAR(const VEC3 &Eye, const VEC3 &Forward, const VEC3 &Up, const VEC3 &Right, float FovY, float Aspect, float ZNear, float ZFar) { Set(Eye, Forward, Up, Right, FovY, Aspect, ZNear, ZFar); }
+
+	/** \name Pamiętane pola
+	Zwraca poszczególne pamiętane pola (FovY i Aspect nie pamięta bezpośrednio)
+	*/
+	//@{
+	const VEC3 & GetEye() const     { return m_Eye; }
+	const VEC3 & GetForward() const { return m_Forward; }
+	const VEC3 & GetUp() const      { return m_Up; }
+	const VEC3 & GetRight() const   { return m_Right; }
+	float GetZNear() const   { return m_ZNear; }
+	float GetZFar() const    { return m_ZFar; }
+	//@}
+
+	/** \name Dane pomocnicze
+	Zwraca dane pomocnicze
+	*/
+	//@{
+	float GetRFactor() const { return m_RFactor; }
+	float GetUFactor() const { return m_UFactor; }
+	float GetRSphereFactor() const { return m_RSphereFactor; }
+	float GetUSphereFactor() const { return m_USphereFactor; }
+	//@}
+
+	/** \name Ustawianie poszczególnych pól */
+	//@{
+	void SetEye    (const VEC3 &Eye)     { m_Eye = Eye; }
+	void SetForward(const VEC3 &Forward) { m_Forward = Forward; }
+	void SetUp     (const VEC3 &Up)      { m_Up = Up; }
+	void SetRight  (const VEC3 &Right)   { m_Right = Right; }
+	void SetZNear(float ZNear) { m_ZNear = ZNear; }
+	void SetZFor (float ZFar)  { m_ZFar = ZFar; }
+	void SetFovAndAspect(float FovY, float Aspect);
+	//@}
+	
+	/// Kompletnie wypełnia
+	void Set(const VEC3 &Eye, const VEC3 &Forward, const VEC3 &Up, const VEC3 &Right, float FovY, float Aspect, float ZNear, float ZFar) { SetProjection(FovY, Aspect, ZNear, ZFar); SetView(Eye, Forward, Up, Right); }
+	/// Wypełnia jedną połówkę danych
+	void SetProjection(float FovY, float Aspect, float ZNear, float ZFar);
+	/// Wypełnia drugą połówkę danych
+	void SetView(const VEC3 &Eye, const VEC3 &Forward, const VEC3 &Up, const VEC3 &Right);
+};
+
+//@}
+// math_frustum
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+/** \addtogroup mathcapsule Kapsuła */
+//@{
+
+/// Objętość kapsuły
+float CapsuleVolume(const VEC3 &p1, const VEC3 &p2, float R);
+/// Losuje punkt z wnętrza kapsuły. Rozkład równomierny.
+void RandomPointInCapsule(VEC3 *Out, const VEC3 &p1, const VEC3 &p2, float R, RandomGenerator &Rand);
+void RandomPointInCapsule(VEC3 *Out, const VEC3 &p1, const VEC3 &p2, float R);
+
+//@}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// INNE
+
+/** \addtogroup math_smoothcd Wygładzanie zmiennej
+Funkcja wygładzająca zmianę zmiennej w czasie - SmoothCD.
+Nakładki na tą funkcję - szablon specjalizowany dla: float, common::VEC2, common::VEC3.
+Klasa szablonowa enkapsulująca pamiętanie parametrów wygładzania. */
+//@{
+
+template <typename T>
+inline void SmoothCD_T(T *InOutPos, const T &Dest, T *InOutVel, float SmoothTime, float TimeDelta)
+{
+	assert(0 && "SmoothCD_T for invalid template type.");
+}
+
+template <>
+inline void SmoothCD_T<float>(float *InOutPos, const float &Dest, float *InOutVel, float SmoothTime, float TimeDelta)
+{
+	SmoothCD(InOutPos, Dest, InOutVel, SmoothTime, TimeDelta);
+}
+
+template <>
+inline void SmoothCD_T<VEC2>(VEC2 *InOutPos, const VEC2 &Dest, VEC2 *InOutVel, float SmoothTime, float TimeDelta)
+{
+	SmoothCD(&InOutPos->x, Dest.x, &InOutVel->x, SmoothTime, TimeDelta);
+	SmoothCD(&InOutPos->y, Dest.y, &InOutVel->y, SmoothTime, TimeDelta);
+}
+
+template <>
+inline void SmoothCD_T<VEC3>(VEC3 *InOutPos, const VEC3 &Dest, VEC3 *InOutVel, float SmoothTime, float TimeDelta)
+{
+	SmoothCD(&InOutPos->x, Dest.x, &InOutVel->x, SmoothTime, TimeDelta);
+	SmoothCD(&InOutPos->y, Dest.y, &InOutVel->y, SmoothTime, TimeDelta);
+	SmoothCD(&InOutPos->z, Dest.z, &InOutVel->z, SmoothTime, TimeDelta);
+}
+
+template <typename T>
+class SmoothCD_obj
+{
+public:
+	T Pos;
+	T Dest; ///< Zapamiętana ostatnia wartość docelowa - może się przydać.
+	T Vel;
+	float SmoothTime;
+
+	/// Tworzy niezainicjalizowany
+	SmoothCD_obj() { }
+	/// Tworzy zainicjalizowany
+	SmoothCD_obj(const T &Pos, float SmoothTime, const T &Vel) : Pos(Pos), Dest(Pos), Vel(Vel), SmoothTime(SmoothTime) { }
+	/// Ustawia parametry
+	void Set(const T &pos, const T &vel) { this->Pos = pos; this->Dest = pos; this->Vel = vel; }
+
+	/// Wykonuje krok czasowy
+	void Update(const T &dest, float timeDelta) {
+		this->Dest = dest;
+		SmoothCD_T<T>(&Pos, dest, &Vel, SmoothTime, timeDelta);
+	}
+};
+
+//@}
+// math_smoothcd
+
+
+/** \addtogroup math_spherical Współrzędne sferyczne
+- Układ kartezjański: DirectX: X w prawo, Y w górę, Z w głąb
+- Układ sferyczny: Yaw to długość geograficzna, Pitch to szerokość geograficzna, R to promień wodzący
+*/
+//@{
+
+/// Tu można podawać co się chce.
+void SphericalToCartesian(VEC3 *Out, float Yaw, float Pitch, float R);
+
+/**
+\param[out] Yaw
+  Wychodzi -PI..PI.
+  Można podać NULL, jeśli akurat nas nie interesuje - wtedy liczy szybciej.
+\param[out] Pitch
+  Wychodzi -PI/2..PI/2.
+  Można podać NULL, jeśli akurat nas nie interesuje - wtedy liczy szybciej.
+\param[out] R
+  Wychodzi > 0.
+  Można podać NULL, jeśli akurat nas nie interesuje - wtedy liczy szybciej.
+\param Pos
+  Nie podawać wektora zerowego bo wyjdą buraki.
+*/
+void CartesianToSpherical(float *OutYaw, float *OutPitch, float *OutR, const VEC3 &Pos);
+
+//@}
+// math_spherical
+
+/// Zwraca wypukłą otoczkę zbioru punktów 2D.
+/**
+- Na wejściu musi być co najmniej jeden punkt.
+- Punkty będą ułożone zgodnie z ruchem wskazówek zegara, jeśli układ jest X w prawo a Y w dół.
+- Punkty powtarzające się są chyba usuwane, tzn. wynik jest bez powtórzeń.
+- Punkty leżące na prostej krawędzi raz pojawiają się w wyniku a raz nie - niezdefiniowane.
+*/
+void ConvexHull2D(std::vector<VEC2> *OutPoints, const VEC2 InPoints[], size_t InPointCount);
+
+/**
+Macierz rotacji przekształcająca wektory z przestrzeni Half-Life 2 do
+przestrzeni stycznej Tangent Space i jej transpozycja przekształcająca
+z powrotem. To są macierz ortogonalne.
+\verbatim
+b0 = ( -1/sqrt(6), -1/sqrt(2), 1/sqrt(3) )
+b1 = ( -1/sqrt(6),  1/sqrt(2), 1/sqrt(3) )
+b2 = ( sqrt(2/3),   0,         1/sqrt(3) )
+\endverbatim
+*/
+extern const MATRIX HL2_TO_TANGENT_MATRIX;
+extern const MATRIX TANGENT_TO_HL2_MATRIX;
+/// Wektory bazowe HL2 Space wyrażone w Tangent Space
+extern const VEC3 HL2_BASIS_VECTORS[3];
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+/** \addtogroup math_curves Curves */
+//@{
+
+/// Calculates value of Catmull-Rom curve at given point t = 0..1 between points b and c.
+/** Params a, b, c, d are four control points. \n
+Use types like float, VEC2, VEC3, VEC4 as T. */
+template <typename T>
+inline void EvalCatmullRomCurve(T *out, const T &a, const T &b, const T &c, const T &d, float t)
+{
+	float t2 = t * t;
+	float t3 = t2 * t;
+	*out = 0.5f * ( (2.f *b) + (c-a)*t + (2*a - 5*b + 4*c - d)*t2 + (3*b - 3*c + d - a)*t3 );
+}
+
+/// Evaluates tangent (not normalized) of Catmull-Rom curve at given point t = 0..1 between points b and c.
+/** Params a, b, c, d are four control points. \n
+Use types like float, VEC2, VEC3, VEC4 as T. */
+template <typename T>
+inline void EvalCatmullRomCurveDiff(T *out, const T &a, const T &b, const T &c, const T &d, float t)
+{
+	float t2 = t * t;
+	*out = 0.5f * ( (c - a) + 2.f*(a*2.f - b*5.f + c* 4.f - d)*t + 3.f*(a*-1.f + b*3.f -c*3.f + d)*t2 );
+}
+
+/// Calculates value of quadratic Bezier curve at given point t = 0..1 between points a and c.
+/** Param b is a control points of the curve. \n
+Use types like float, VEC2, VEC3, VEC4 as T. */
+template <typename T>
+inline void EvalQuadraticBezierCurve(T *out, const T &a, const T &b, const T &c, float t)
+{
+	float t_inv = 1.f - t;
+	*out = t_inv*t_inv*a + 2.f*t*t_inv*b + t*t*c;
+}
+
+/// Calculates value of cubic Bezier curve at given point t = 0..1 between points a and d.
+/** Params b, c are control points of the curve. \n
+Use types like float, VEC2, VEC3, VEC4 as T. */
+template <typename T>
+inline void EvalCubicBezierCurve(T *out, const T &a, const T &b, const T &c, const T &d, float t)
+{
+	float t2=t*t;
+	float t3=t2*t;
+	float v=1-t;
+	float v2=v*v;
+	float v3=v2*v;
+	*out = a*v3 + b*3.f*v2*t + c*3.f*v*t2 + d*t3; 
+}
+
+/// Evaluates tangent (not normalized) of cubic Bezier curve at given point t = 0..1 between points a and d.
+/** Params b, c are control points of the curve. \n
+Use types like float, VEC2, VEC3, VEC4 as T. */
+template <typename T>
+inline void EvalCubicBezierCurveDiff(T *out, const T &a, const T &b, const T &c, const T &d, float t)
+{
+	float tinv = 1.f - t;
+	float tinvpow2 = tinv * tinv;
+	float upow2 = t * t;
+	float ta = 3.f * tinvpow2;
+	float tb = 6.f * tinv * t;
+	float tc = 3.f * upow2;
+	/*float c0 = -ta;
+	float c1 = ta - tb;
+	float c2 = tb - tc;
+	float c3 = tc;*/ // WTF?! These values never used. Wai it supposed to be this way?
+	*out = b*(ta-tb) + c*(tb-tc) + d*tc - a*ta;
+}
+
+/// Splits cubic Bezier curve in the middle (at t=0.5) into two cubic Bezier curves.
+/** a, b, c, d are points of the input curve. \n
+out1[0], out1[1], out1[2], out1[3] will be points of the first output curve. \n
+out2[0], out2[1], out2[2], out2[3] will be points of the second output curve.
+Use types like float, VEC2, VEC3, VEC4 as T. */
+template <typename T>
+inline void SplitCubicBezierCurve(T out1[4], T out2[4], const T &a, const T &b, const T &c, const T &d)
+{
+	out1[0] = a;
+	out1[1] = a*0.5f   + b*0.5f;
+	out1[2] = a*0.25f  + b*0.5f   + c*0.25f;
+	out1[3] = a*0.125f + b*0.375f + c*0.375f + d*0.125f;
+	out2[3] = d;
+	out2[2] = d*0.5f   + c*0.5f;
+	out2[1] = d*0.25f  + c*0.5f   + b*0.25f;
+	out2[0] = d*0.125f + c*0.375f + b*0.375f + a*0.125f;
+}
+
+/// Splits cubic Bezier curve in the given point (at parameter t) into two cubic Bezier curves.
+/** a, b, c, d are points of the input curve. \n
+out1[0], out1[1], out1[2], out1[3] will be points of the first output curve. \n
+out2[0], out2[1], out2[2], out2[3] will be points of the second output curve.
+Use types like float, VEC2, VEC3, VEC4 as T. */
+template <typename T>
+inline void SplitCubicBezierCurve(T out1[4], T out2[4], const T &a, const T &b, const T &c, const T &d, float t)
+{
+	T p01 = a + (b - a) * t;
+	T p12 = b + (c - b) * t;
+	T p23 = c + (d - c) * t;
+	T pa = p01 + (p12 - p01) * t;
+	T pb = p12 + (p23 - p12) * t;
+	T pc = pa + (pb - pa) * t;
+	out1[0] = a;  out1[1] = p01; out1[2] = pa;  out1[3] = pc;
+	out2[0] = pc; out2[1] = pb;  out2[2] = p23; out2[3] = d;
+}
+
+template <typename T>
+class CubicBezierCurveIntegral
+{
+public:
+	void Setup(const T &a, const T &b, const T &c, const T &d, const T &zero)
+	{
+		m_Data[0] = zero;
+		m_Data[1] = a * 0.25f;
+		m_Data[2] = (a + b) * 0.25f;
+		m_Data[3] = (a + b + c) * 0.25f;
+		m_Data[4] = (a + b + c + d) * 0.25f;
+	}
+
+	void Calc(T *out, float t)
+	{
+		float t2 = t * t;
+		float t3 = t2 * t;
+		float t4 = t3 * t;
+
+		float inv_t = 1.0f - t;
+		float inv_t2 = inv_t * inv_t;
+		float inv_t3 = inv_t2 * inv_t;
+		float inv_t4 = inv_t3 * inv_t;
+
+		*out = m_Data[0]*inv_t4 + m_Data[1]*4*inv_t3*t + m_Data[2]*6*inv_t2*t2 + m_Data[3]*4*inv_t*t3 + m_Data[4]*t4;
+	}
+
+private:
+	T m_Data[5];
+};
+
+float CalcCubicBezierCurveLength(const VEC3 &a, const VEC3 &b, const VEC3 &c, const VEC3 &d, float t1, float t2);
+float GetCubicBezierCurveArcLengthParam(const VEC3 &a, const VEC3 &b, const VEC3 &c, const VEC3 &d, float len, float epsilon);
+/// Calculates Y value and T parameter of cubic Bezier curve intersected with axis-aligned line x.
+bool IntersectCubicBezierCurve2DWithX(const VEC2 curve[4], float x, float eps, float *outY, float *outT, float t0 = 0.f, float t1 = 1.f);
+
+//@}
+// math_curves
+
+
+/** \addtogroup math_comp Comparisons
+*/
+//@{
+
+template <typename Comp> inline bool PointAllCmp(const POINT_ &lhs, const POINT_ &rhs) { Comp compObj; return compObj(lhs.x, rhs.x) && compObj(lhs.y, rhs.y); }
+template <typename Comp> inline bool Vec2AllCmp(const VEC2 &lhs, const VEC2 &rhs) { Comp compObj; return compObj(lhs.x, rhs.x) && compObj(lhs.y, rhs.y); }
+template <typename Comp> inline bool Vec3AllCmp(const VEC3 &lhs, const VEC3 &rhs) { Comp compObj; return compObj(lhs.x, rhs.x) && compObj(lhs.y, rhs.y) && compObj(lhs.z, rhs.z); }
+template <typename Comp> inline bool Vec4AllCmp(const VEC4 &lhs, const VEC4 &rhs) { Comp compObj; return compObj(lhs.x, rhs.x) && compObj(lhs.y, rhs.y) && compObj(lhs.z, rhs.z) && compObj(lhs.w, rhs.w); }
+template <typename Comp> inline bool ColorfAllCmp(const COLORF &lhs, const COLORF &rhs) { Comp compObj; return compObj(lhs.R, rhs.R) && compObj(lhs.G, rhs.G) && compObj(lhs.B, rhs.B) && compObj(lhs.A, rhs.A); }
+template <typename Comp> inline bool ColorAllCmp(COLOR lhs, COLOR rhs) { Comp compObj; return compObj(lhs.R, rhs.R) && compObj(lhs.G, rhs.G) && compObj(lhs.B, rhs.B) && compObj(lhs.A, rhs.A); }
+template <typename Comp> inline bool MatrixAllCmp(const MATRIX &lhs, const MATRIX &rhs)
+{
+	Comp compObj;
+	return compObj(lhs._11, rhs._11) && compObj(lhs._12, rhs._12) && compObj(lhs._13, rhs._13) && compObj(lhs._14, rhs._14)
+		&& compObj(lhs._21, rhs._21) && compObj(lhs._22, rhs._22) && compObj(lhs._23, rhs._23) && compObj(lhs._24, rhs._24)
+		&& compObj(lhs._31, rhs._31) && compObj(lhs._32, rhs._32) && compObj(lhs._33, rhs._33) && compObj(lhs._34, rhs._34)
+		&& compObj(lhs._41, rhs._41) && compObj(lhs._42, rhs._42) && compObj(lhs._43, rhs._43) && compObj(lhs._44, rhs._44);
+}
+
+template <typename Comp> inline bool PointAnyCmp(const POINT_ &lhs, const POINT_ &rhs) { Comp compObj; return compObj(lhs.x, rhs.x) || compObj(lhs.y, rhs.y); }
+template <typename Comp> inline bool Vec2AnyCmp(const VEC2 &lhs, const VEC2 &rhs) { Comp compObj; return compObj(lhs.x, rhs.x) || compObj(lhs.y, rhs.y); }
+template <typename Comp> inline bool Vec3AnyCmp(const VEC3 &lhs, const VEC3 &rhs) { Comp compObj; return compObj(lhs.x, rhs.x) || compObj(lhs.y, rhs.y) || compObj(lhs.z, rhs.z); }
+template <typename Comp> inline bool Vec4AnyCmp(const VEC4 &lhs, const VEC4 &rhs) { Comp compObj; return compObj(lhs.x, rhs.x) || compObj(lhs.y, rhs.y) || compObj(lhs.z, rhs.z) || compObj(lhs.w, rhs.w); }
+template <typename Comp> inline bool ColorfAnyCmp(const COLORF &lhs, const COLORF &rhs) { Comp compObj; return compObj(lhs.R, rhs.R) || compObj(lhs.G, rhs.G) || compObj(lhs.B, rhs.B) || compObj(lhs.A, rhs.A); }
+template <typename Comp> inline bool ColorAnyCmp(COLOR lhs, COLOR rhs) { Comp compObj; return compObj(lhs.R, rhs.R) || compObj(lhs.G, rhs.G) || compObj(lhs.B, rhs.B) || compObj(lhs.A, rhs.A); }
+template <typename Comp> inline bool MatrixAnyCmp(const MATRIX &lhs, const MATRIX &rhs)
+{
+	Comp compObj;
+	return compObj(lhs._11, rhs._11) || compObj(lhs._12, rhs._12) || compObj(lhs._13, rhs._13) || compObj(lhs._14, rhs._14)
+		|| compObj(lhs._21, rhs._21) || compObj(lhs._22, rhs._22) || compObj(lhs._23, rhs._23) || compObj(lhs._24, rhs._24)
+		|| compObj(lhs._31, rhs._31) || compObj(lhs._32, rhs._32) || compObj(lhs._33, rhs._33) || compObj(lhs._34, rhs._34)
+		|| compObj(lhs._41, rhs._41) || compObj(lhs._42, rhs._42) || compObj(lhs._43, rhs._43) || compObj(lhs._44, rhs._44);
+}
+
+inline bool AllGreater(const POINT_ &lhs, const POINT_ &rhs) { return PointAllCmp< std::greater<int> >(lhs, rhs); }
+inline bool AllGreater(const VEC2 &lhs, const VEC2 &rhs) { return Vec2AllCmp< std::greater<float> >(lhs, rhs); }
+inline bool AllGreater(const VEC3 &lhs, const VEC3 &rhs) { return Vec3AllCmp< std::greater<float> >(lhs, rhs); }
+inline bool AllGreater(const VEC4 &lhs, const VEC4 &rhs) { return Vec4AllCmp< std::greater<float> >(lhs, rhs); }
+inline bool AllGreater(const COLORF &lhs, const COLORF &rhs) { return ColorfAllCmp< std::greater<float> >(lhs, rhs); }
+inline bool AllGreater(COLOR lhs, COLOR rhs) { return ColorAllCmp< std::greater<uint8> >(lhs, rhs); }
+inline bool AllGreater(const MATRIX &lhs, const MATRIX &rhs) { return MatrixAllCmp< std::greater<float> >(lhs, rhs); }
+
+inline bool AllGreaterEqual(const POINT_ &lhs, const POINT_ &rhs) { return PointAllCmp< std::greater_equal<int> >(lhs, rhs); }
+inline bool AllGreaterEqual(const VEC2 &lhs, const VEC2 &rhs) { return Vec2AllCmp< std::greater_equal<float> >(lhs, rhs); }
+inline bool AllGreaterEqual(const VEC3 &lhs, const VEC3 &rhs) { return Vec3AllCmp< std::greater_equal<float> >(lhs, rhs); }
+inline bool AllGreaterEqual(const VEC4 &lhs, const VEC4 &rhs) { return Vec4AllCmp< std::greater_equal<float> >(lhs, rhs); }
+inline bool AllGreaterEqual(const COLORF &lhs, const COLORF &rhs) { return ColorfAllCmp< std::greater_equal<float> >(lhs, rhs); }
+inline bool AllGreaterEqual(COLOR lhs, COLOR rhs) { return ColorAllCmp< std::greater_equal<uint8> >(lhs, rhs); }
+inline bool AllGreaterEqual(const MATRIX &lhs, const MATRIX &rhs) { return MatrixAllCmp< std::greater_equal<float> >(lhs, rhs); }
+
+inline bool AllLess(const POINT_ &lhs, const POINT_ &rhs) { return PointAllCmp< std::less<int> >(lhs, rhs); }
+inline bool AllLess(const VEC2 &lhs, const VEC2 &rhs) { return Vec2AllCmp< std::less<float> >(lhs, rhs); }
+inline bool AllLess(const VEC3 &lhs, const VEC3 &rhs) { return Vec3AllCmp< std::less<float> >(lhs, rhs); }
+inline bool AllLess(const VEC4 &lhs, const VEC4 &rhs) { return Vec4AllCmp< std::less<float> >(lhs, rhs); }
+inline bool AllLess(const COLORF &lhs, const COLORF &rhs) { return ColorfAllCmp< std::less<float> >(lhs, rhs); }
+inline bool AllLess(COLOR lhs, COLOR rhs) { return ColorAllCmp< std::less<uint8> >(lhs, rhs); }
+inline bool AllLess(const MATRIX &lhs, const MATRIX &rhs) { return MatrixAllCmp< std::less<float> >(lhs, rhs); }
+
+inline bool AllLessEqual(const POINT_ &lhs, const POINT_ &rhs) { return PointAllCmp< std::less_equal<int> >(lhs, rhs); }
+inline bool AllLessEqual(const VEC2 &lhs, const VEC2 &rhs) { return Vec2AllCmp< std::less_equal<float> >(lhs, rhs); }
+inline bool AllLessEqual(const VEC3 &lhs, const VEC3 &rhs) { return Vec3AllCmp< std::less_equal<float> >(lhs, rhs); }
+inline bool AllLessEqual(const VEC4 &lhs, const VEC4 &rhs) { return Vec4AllCmp< std::less_equal<float> >(lhs, rhs); }
+inline bool AllLessEqual(const COLORF &lhs, const COLORF &rhs) { return ColorfAllCmp< std::less_equal<float> >(lhs, rhs); }
+inline bool AllLessEqual(COLOR lhs, COLOR rhs) { return ColorAllCmp< std::less_equal<uint8> >(lhs, rhs); }
+inline bool AllLessEqual(const MATRIX &lhs, const MATRIX &rhs) { return MatrixAllCmp< std::less_equal<float> >(lhs, rhs); }
+
+inline bool AllEqual(const POINT_ &lhs, const POINT_ &rhs) { return PointAllCmp< std::equal_to<int> >(lhs, rhs); }
+inline bool AllEqual(const VEC2 &lhs, const VEC2 &rhs) { return Vec2AllCmp< std::equal_to<float> >(lhs, rhs); }
+inline bool AllEqual(const VEC3 &lhs, const VEC3 &rhs) { return Vec3AllCmp< std::equal_to<float> >(lhs, rhs); }
+inline bool AllEqual(const VEC4 &lhs, const VEC4 &rhs) { return Vec4AllCmp< std::equal_to<float> >(lhs, rhs); }
+inline bool AllEqual(const COLORF &lhs, const COLORF &rhs) { return ColorfAllCmp< std::equal_to<float> >(lhs, rhs); }
+inline bool AllEqual(COLOR lhs, COLOR rhs) { return ColorAllCmp< std::equal_to<uint8> >(lhs, rhs); }
+inline bool AllEqual(const MATRIX &lhs, const MATRIX &rhs) { return MatrixAllCmp< std::equal_to<float> >(lhs, rhs); }
+
+inline bool AllNotEqual(const POINT_ &lhs, const POINT_ &rhs) { return PointAllCmp< std::not_equal_to<int> >(lhs, rhs); }
+inline bool AllNotEqual(const VEC2 &lhs, const VEC2 &rhs) { return Vec2AllCmp< std::not_equal_to<float> >(lhs, rhs); }
+inline bool AllNotEqual(const VEC3 &lhs, const VEC3 &rhs) { return Vec3AllCmp< std::not_equal_to<float> >(lhs, rhs); }
+inline bool AllNotEqual(const VEC4 &lhs, const VEC4 &rhs) { return Vec4AllCmp< std::not_equal_to<float> >(lhs, rhs); }
+inline bool AllNotEqual(const COLORF &lhs, const COLORF &rhs) { return ColorfAllCmp< std::not_equal_to<float> >(lhs, rhs); }
+inline bool AllNotEqual(COLOR lhs, COLOR rhs) { return ColorAllCmp< std::not_equal_to<uint8> >(lhs, rhs); }
+inline bool AllNotEqual(const MATRIX &lhs, const MATRIX &rhs) { return MatrixAllCmp< std::not_equal_to<float> >(lhs, rhs); }
+
+inline bool AnyGreater(const POINT_ &lhs, const POINT_ &rhs) { return PointAnyCmp< std::greater<int> >(lhs, rhs); }
+inline bool AnyGreater(const VEC2 &lhs, const VEC2 &rhs) { return Vec2AnyCmp< std::greater<float> >(lhs, rhs); }
+inline bool AnyGreater(const VEC3 &lhs, const VEC3 &rhs) { return Vec3AnyCmp< std::greater<float> >(lhs, rhs); }
+inline bool AnyGreater(const VEC4 &lhs, const VEC4 &rhs) { return Vec4AnyCmp< std::greater<float> >(lhs, rhs); }
+inline bool AnyGreater(const COLORF &lhs, const COLORF &rhs) { return ColorfAnyCmp< std::greater<float> >(lhs, rhs); }
+inline bool AnyGreater(COLOR lhs, COLOR rhs) { return ColorAnyCmp< std::greater<uint8> >(lhs, rhs); }
+inline bool AnyGreater(const MATRIX &lhs, const MATRIX &rhs) { return MatrixAnyCmp< std::greater<float> >(lhs, rhs); }
+
+inline bool AnyGreaterEqual(const POINT_ &lhs, const POINT_ &rhs) { return PointAnyCmp< std::greater_equal<int> >(lhs, rhs); }
+inline bool AnyGreaterEqual(const VEC2 &lhs, const VEC2 &rhs) { return Vec2AnyCmp< std::greater_equal<float> >(lhs, rhs); }
+inline bool AnyGreaterEqual(const VEC3 &lhs, const VEC3 &rhs) { return Vec3AnyCmp< std::greater_equal<float> >(lhs, rhs); }
+inline bool AnyGreaterEqual(const VEC4 &lhs, const VEC4 &rhs) { return Vec4AnyCmp< std::greater_equal<float> >(lhs, rhs); }
+inline bool AnyGreaterEqual(const COLORF &lhs, const COLORF &rhs) { return ColorfAnyCmp< std::greater_equal<float> >(lhs, rhs); }
+inline bool AnyGreaterEqual(COLOR lhs, COLOR rhs) { return ColorAnyCmp< std::greater_equal<uint8> >(lhs, rhs); }
+inline bool AnyGreaterEqual(const MATRIX &lhs, const MATRIX &rhs) { return MatrixAnyCmp< std::greater_equal<float> >(lhs, rhs); }
+
+inline bool AnyLess(const POINT_ &lhs, const POINT_ &rhs) { return PointAnyCmp< std::less<int> >(lhs, rhs); }
+inline bool AnyLess(const VEC2 &lhs, const VEC2 &rhs) { return Vec2AnyCmp< std::less<float> >(lhs, rhs); }
+inline bool AnyLess(const VEC3 &lhs, const VEC3 &rhs) { return Vec3AnyCmp< std::less<float> >(lhs, rhs); }
+inline bool AnyLess(const VEC4 &lhs, const VEC4 &rhs) { return Vec4AnyCmp< std::less<float> >(lhs, rhs); }
+inline bool AnyLess(const COLORF &lhs, const COLORF &rhs) { return ColorfAnyCmp< std::less<float> >(lhs, rhs); }
+inline bool AnyLess(COLOR lhs, COLOR rhs) { return ColorAnyCmp< std::less<uint8> >(lhs, rhs); }
+inline bool AnyLess(const MATRIX &lhs, const MATRIX &rhs) { return MatrixAnyCmp< std::less<float> >(lhs, rhs); }
+
+inline bool AnyLessEqual(const POINT_ &lhs, const POINT_ &rhs) { return PointAnyCmp< std::less_equal<int> >(lhs, rhs); }
+inline bool AnyLessEqual(const VEC2 &lhs, const VEC2 &rhs) { return Vec2AnyCmp< std::less_equal<float> >(lhs, rhs); }
+inline bool AnyLessEqual(const VEC3 &lhs, const VEC3 &rhs) { return Vec3AnyCmp< std::less_equal<float> >(lhs, rhs); }
+inline bool AnyLessEqual(const VEC4 &lhs, const VEC4 &rhs) { return Vec4AnyCmp< std::less_equal<float> >(lhs, rhs); }
+inline bool AnyLessEqual(const COLORF &lhs, const COLORF &rhs) { return ColorfAnyCmp< std::less_equal<float> >(lhs, rhs); }
+inline bool AnyLessEqual(COLOR lhs, COLOR rhs) { return ColorAnyCmp< std::less_equal<uint8> >(lhs, rhs); }
+inline bool AnyLessEqual(const MATRIX &lhs, const MATRIX &rhs) { return MatrixAnyCmp< std::less_equal<float> >(lhs, rhs); }
+
+inline bool AnyEqual(const POINT_ &lhs, const POINT_ &rhs) { return PointAnyCmp< std::equal_to<int> >(lhs, rhs); }
+inline bool AnyEqual(const VEC2 &lhs, const VEC2 &rhs) { return Vec2AnyCmp< std::equal_to<float> >(lhs, rhs); }
+inline bool AnyEqual(const VEC3 &lhs, const VEC3 &rhs) { return Vec3AnyCmp< std::equal_to<float> >(lhs, rhs); }
+inline bool AnyEqual(const VEC4 &lhs, const VEC4 &rhs) { return Vec4AnyCmp< std::equal_to<float> >(lhs, rhs); }
+inline bool AnyEqual(const COLORF &lhs, const COLORF &rhs) { return ColorfAnyCmp< std::equal_to<float> >(lhs, rhs); }
+inline bool AnyEqual(COLOR lhs, COLOR rhs) { return ColorAnyCmp< std::equal_to<uint8> >(lhs, rhs); }
+inline bool AnyEqual(const MATRIX &lhs, const MATRIX &rhs) { return MatrixAnyCmp< std::equal_to<float> >(lhs, rhs); }
+
+inline bool AnyNotEqual(const POINT_ &lhs, const POINT_ &rhs) { return PointAnyCmp< std::not_equal_to<int> >(lhs, rhs); }
+inline bool AnyNotEqual(const VEC2 &lhs, const VEC2 &rhs) { return Vec2AnyCmp< std::not_equal_to<float> >(lhs, rhs); }
+inline bool AnyNotEqual(const VEC3 &lhs, const VEC3 &rhs) { return Vec3AnyCmp< std::not_equal_to<float> >(lhs, rhs); }
+inline bool AnyNotEqual(const VEC4 &lhs, const VEC4 &rhs) { return Vec4AnyCmp< std::not_equal_to<float> >(lhs, rhs); }
+inline bool AnyNotEqual(const COLORF &lhs, const COLORF &rhs) { return ColorfAnyCmp< std::not_equal_to<float> >(lhs, rhs); }
+inline bool AnyNotEqual(COLOR lhs, COLOR rhs) { return ColorAnyCmp< std::not_equal_to<uint8> >(lhs, rhs); }
+inline bool AnyNotEqual(const MATRIX &lhs, const MATRIX &rhs) { return MatrixAnyCmp< std::not_equal_to<float> >(lhs, rhs); }
+
+//@}
+// math_vec_comp
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+/** \addtogroup math_collisions Kolizje */
+//@{
+
+/// Funkcja wielofunkcyjna
+/**
+- Wynik > 0 - punkt c leży na lewo od skierowanego odcinka a-b.
+  Trójkąt abc jest skierowany przeciwnie do ruchu wskazówek zegara.
+- Wynik < 0 - punkt c leży na prawo od skierowanego odcinka a-b.
+  Trójkąt abc jest skierowany zgodnie z ruchem wskazówek zegara.
+- Wynik = 0 - podane trzy punkty leżą w jednej linii.
+- abs(Wynik) - podwojona powierzchnia trójąta abc.
+*/
+float Orient2D(const VEC2 &a, const VEC2 &b, const VEC2 &c);
+/// Funkcja wielofunkcyjna
+/**
+- Wynik < 0 - punkt d leży nad płaszczyzną definiowaną przez trójkąt abc,
+  widzianą tak że ten trójkąt jest zorientowany przeciwnie do ruchu wskazówek
+  zegara.
+- Wynik > 0 - punkt d leży pod płaszczyzną definiowaną przez trójkąt abc,
+  widzianą tak że ten trójkąt jest zorientowany przeciwnie do ruchu wskazówek
+  zegara.
+- Wynik = 0 - wszystkie cztery punkty leżą w jednej płaszczyźnie.
+- abs(Wynik) - sześciokrotna objętość czworościanu tworzonego przez punkty abcd.
+*/
+float Orient3D(const VEC3 &a, const VEC3 &b, const VEC3 &c, const VEC3 &d);
+
+inline bool PointInCircle(const VEC2 &pt, const VEC2 &circleCenter, float circleRadius)
+{
+	return DistanceSq(pt, circleCenter) <= sqr(circleRadius);
+}
+/// Zwraca true, jeśli punkt p należy do trójkąta abc
+bool PointInTriangle(const VEC2 &p, const VEC2 &a, const VEC2 &b, const VEC2 &c);
+/// Zwraca true, jeśli podany czworokąt jest wypukły.
+/** Nie testowana, może źle działać dla zdegenerowanych - TODO. */
+bool IsQuadConvex(const VEC2 &a, const VEC2 &b, const VEC2 &c, const VEC2 &d);
+/// Zwraca true, jeśli podany czworokąt jest wypukły (nie zdegenerowany, nie wklęsły, nie samoprzecinający się).
+/** Wszystkie cztery wierzchołki muszą leżeć w jednej płaszczyźnie. */
+bool IsQuadConvex(const VEC3 &a, const VEC3 &b, const VEC3 &c, const VEC3 &d);
+/// Dany punkt p i promień (RayOrig, RayDir), oblicza parametr t dla punktu na tym promieniu będącego rzutem tego punktu na ten promień.
+/** W ten sposób można obliczyć rzut punktu na promień (punkt z promienia najbliższy
+danemu punktowi) jako RayOrig + RayDir*t. Można też policzyć najbliższy punkt
+na półprostej lub odcinku limitując najpierw t od 0 do 1 czy od 0 do dlugości odcinka.
+UWAGA! Jeśli RayDir nie jest jednostkowy, wynik trzeba podzielić przez LengthSq(RayDir). */
+float ClosestPointOnLine(const VEC3 &p, const VEC3 &RayOrig, const VEC3 &RayDir);
+/// Oblicza najbliższe sobie punkty na dwóch odcinkach
+/** Dane są dwa odcinki: Seg1_Beg..Seg1_End i Seg2_Beg..Seg2_End.
+Funkcja oblicza najbliższe sobie punkty na tych odcinkach.
+Parametry do tych odcinków zwraca przez OutSeg1_t, OutSeg2_t.
+Te punkty zwraca przez OutSeg1_pt, OutSeg2_pt.
+Cała funkcja zwraca kwadrat odległości między tymi punktami.
+*/
+float ClosestPointSegmentSegment(
+	const VEC3 &Seg1_Beg, const VEC3 &Seg1_End, const VEC3 &Seg2_Beg, const VEC3 &Seg2_End,
+	float &OutSeg1_t, float &OutSeg2_t, VEC3 &OutSeg1_pt, VEC3 &OutSeg2_pt);
+/// Zwraca kwadrat odległości punktu od prostej
+/** \param LineDir   musi być znormalizowane! */
+float PointToLineDistance(const VEC3 &P, const VEC3 &LineOrig, const VEC3 &LineDir);
+/// Zwraca kwadrat odległości punktu od odcinka
+float PointToSegmentDistanceSq(const VEC2 &p, const VEC2 &segment_p1, const VEC2 &segment_p2);
+/// Zwraca kwadrat odległości punktu od odcinka
+float PointToSegmentDistanceSq(const VEC3 &p, const VEC3 &segment_p1, const VEC3 &segment_p2);
+/// Zwraca true, jeśli punkt leży na prostej
+/** \param LineDir   musi być znormalizowane! */
+bool PointOnLine(const VEC3 &P, const VEC3 &LineOrig, const VEC3 &LineDir);
+/// Zwraca parametr T punktu leżącego na prostej
+/** \param P   Punkt musi naprawdę leżeć na tej prostej! */
+float PointToLine(const VEC3 &P, const VEC3 &LineOrig, const VEC3 &LineDir);
+/// Zwraca true, jeśli punkt leży na odcinku.
+/** \param P   Punkt musi leżeć na prostej przechodzącej przez ten odcinek! */
+bool PointInLineSegment(const VEC3 &P, const VEC3 &SegmentBeg, const VEC3 &SegmentEnd);
+/// Wyznacza najbliższy punkt leżący na odcinku p1-p2 względem punktu p
+/** \param Out [out] Można podać NULL.
+\return Zwraca parametr t dla odcinka, wyrażony w długościach odcinka. */
+float ClosestPointOnSegment(VEC2 *Out, const VEC2 &p, const VEC2 &p1, const VEC2 &p2);
+float ClosestPointOnSegment(VEC3 *Out, const VEC3 &p, const VEC3 &p1, const VEC3 &p2);
+/// Wyznacza najbliższy punkt leżący na półprostej względem punktu p
+/** \param Out [out] Można podać NULL.
+\return Zwraca parametr t dla półprostej, wyrażony w długościach odcinka. */
+float ClosestPointOnRay(VEC2 *Out, const VEC2 &p, const VEC2 &RayOrig, const VEC2 &RayDir);
+float ClosestPointOnRay(VEC3 *Out, const VEC3 &p, const VEC3 &RayOrig, const VEC3 &RayDir);
+/// Wyznacza najbliższy punkt wewnątrz prostopadłościanu względem punktu p.
+/** Jeśli p leży wewnątrz tego prostopadłościanu, zwrócone zostaje dokładnie p. */
+void ClosestPointInBox(VEC3 *Out, const BOX &Box, const VEC3 &p);
+/// Znajduje punkt OutPoint należący do podanego OBB, najbliższy do punktu Point.
+void ClosestPointInObb(VEC3 *OutPoint, const VEC3 &Point, const OBB &Obb);
+/// Znajduje punkt OutPoint należący do podanego prostokąta 3D, najbliższy do punktu Point.
+void ClosestPointInRect3d(VEC3 *OutPoint, const VEC3 &Point, const RECT3D &Rect3d);
+/// Znajduje punkt OutPoint należący do podanego prostokąta 3D wyznaczonego przez trzy wierzchołki: a, b, c, najbliższy do punktu Point.
+void ClosestPointInRect3d(VEC3 *OutPoint, const VEC3 &p, const VEC3 &a, const VEC3 &b, const VEC3 &c);
+/// Znajduje punkt OutPoint należący do trójkąta (a, b, c) najbliższy do punktu p
+void ClosestPointInTriangle(VEC3 *OutPoint, const VEC3 &p, const VEC3 &a, const VEC3 &b, const VEC3 &c);
+/// \copydoc ClosestPointInRect3d(VEC3*, const VEC3&, const VEC3&, const VEC3&, const VEC3&)
+void ClosestPointInTriangle(VEC2 *out, const VEC2 &pt, const VEC2 &triA, const VEC2 &triB, const VEC2 &triC);
+/// Znajduje punkt OutPoint należący do podanego czworościanu wyznaczonego przez wierzchołki: a, b, c, d, najbliższy do punktu p.
+void ClosestPointInTetrahedron(VEC3 *OutPoint, const VEC3 &p, const VEC3 &a, const VEC3 &b, const VEC3 &c, const VEC3 &d);
+/// Returns squared distance from point to rectangle. Returns 0 if point inside rectangle.
+float PointToRectDistanceSq(const VEC2 &p, const RECTF &rect);
+float PointToRectManhattanDistance(const VEC2 &p, const RECTF &rect);
+float PointToRectMaxDistance(const VEC2 &p, const RECTF &rect);
+/// Kwadrat odległości punktu od prostopadłościanu
+/** Jeśli p leży wewnątrz tego prostopadłościanu, zwraca 0. */
+float PointToBoxDistanceSq(const VEC3 &p, const BOX &box);
+float PointToBoxManhattanDistance(const VEC3 &p, const BOX &box);
+float PointToBoxMaxDistance(const VEC3 &p, const BOX &box);
+/// Returns squared distance between two rectangles. Returns 0 if given rectangles overlap.
+float RectToRectDistanceSq(const RECTF &rect1, const RECTF &rect2);
+float RectToRectManhattanDistance(const RECTF &rect1, const RECTF &rect2);
+float RectToRectMaxDistance(const RECTF &rect1, const RECTF &rect2);
+/// Returns squared distance between two axis-aligned boxes. Returns 0 if given boxes overlap.
+float BoxToBoxDistanceSq(const BOX &box1, const BOX &box2);
+float BoxToBoxManhattanDistance(const BOX &box1, const BOX &box2);
+float BoxToBoxMaxDistance(const BOX &box1, const BOX &box2);
+/// Kwadrat odległości punktu od OBB.
+float PointToObbDistanceSq(const VEC3 &Point, const OBB &Obb);
+bool CircleToRect(const VEC2 &circleCenter, float circleRadius, const RECTF &rect);
+/// Zwraca true, jeśli podany punkt należy do sfery
+bool PointInSphere(const VEC3 &p, const VEC3 &SphereCenter, float SphereRadius);
+/// Zwraca odległość punktu od powierzchni sfery
+/** Jeśli punkt leży wewnątrz sfery, zwróci odległość ujemną. */
+float PointToSphereDistance(const VEC3 &p, const VEC3 &SphereCenter, float SphereRadius);
+/// Wyznacza najbliższy punkt na powierzchni sfery względem punktu p.
+/** Punkt może być wewnątrz sfery - też jest OK, zwróci z powierzchni sfery.
+Punkt nie może być dokładnie na środku sfery - wtedy jest dzielenie przez zero. */
+void ClosestPointOnSphere(VEC3 *Out, const VEC3 &SphereCenter, float SphereRadius, const VEC3 &p);
+/// Zwraca true, jeśli podany punkt należy do płaszczyzny
+/** Płaszczyzna nie musi być znormalizowana. */
+bool PointOnPlane(const VEC3 &p, const PLANE &plane);
+/// Wyznacza najbliższy punkt na płaszczyźnie względem punktu p.
+/** Płaszczyzna musi być znormalizowana. */
+void ClosestPointOnPlane(VEC3 *Out, const PLANE &Plane, const VEC3 &p);
+/// Zwraca true, jeśli punkt należy do trójkąta
+bool PointInTriangle(const VEC3 &point, const VEC3 &pa, const VEC3 &pb, const VEC3 &pc);
+/// Zwraca true, jeśli punkt należy do wnętrza podanego frustuma
+bool PointInFrustum(const VEC3 &p, const FRUSTUM_PLANES &Frustum);
+bool PointInFrustum(const VEC3 &p, const FRUSTUM_RADAR &Frustum);
+/// Funkcja wyznacza parametry t1 i t2 dla punktów na dwóch prostych, w których te proste są najbliżej siebie.
+/** Dane są dwie proste (RayOrig1, RayDir1) i (RayOrig2, RayDir2).
+Funkcja wyznacza parametry t1 i t2 dla punktów na tych prostych, w których te proste są najbliżej siebie.
+Jeśli nie da się takich znaleźć (proste są równoległe), funkcja zwraca false.
+Te punkty można policzyć ze wzorów p1=RayOrig1+t1*RayDir1 i p2=RayOrig2+t2*RayDir2.
+Proste faktycznie przecinają się jeśli odległość między tymi punktami wynosi ok. 0. */
+bool ClosestPointsOnLines(float *OutT1, float *OutT2, const VEC3 &RayOrig1, const VEC3 &RayDir1, const VEC3 &RayOrig2, const VEC3 &RayDir2);
+/// Kolizja promienia z prostopadłościanem
+/** Jeśli promień nie przecina prostopadłościanu, zwraca false.
+Jeśli promień przecina prostopadłościan, zwraca true i przez OutT zwraca odległość w wielokrotnościach długości RayDir.
+Jeśli promień przecina prostopadłościan od tyłu, funkcja też zwraca true i zwraca OutT ujemne.
+Jeśli RayOrig jest wewnątrz prostopadłościanu, funkcja zwraca true i OutT = 0. */
+bool RayToBox(float *OutT, const VEC3 &RayOrig, const VEC3 &RayDir, const BOX &Box);
+/// Wylicza kolizję promienia ze sferą
+/** Jeśli nie ma kolizji, zwraca false.
+Jeśli jest kolizja, zwraca true i parametr T.
+Jeśli kolizja jest z tyłu promienia - wcześniej niż jego początek - zwraca true i T ujemne.
+Jeśli początek promienia jest wewnątrz sfery, zwraca true i T=0 */
+bool RayToSphere(const VEC3 &RayOrig, const VEC3 &RayDir, const VEC3 &SphereCenter, float SphereRadius, float *OutT);
+/// Przecięcie promienia z płaszczyzną
+/** \param[out] OutT   Zwrócony parametr dla promienia (NIE można podać 0)
+\param[out] OutVD   Zwrócona liczba mówiąca o zwrocie płaszczyzny (NIE można podać 0)
+  OutVD > 0 oznacza, że płaszczyzna jest tyłem do promienia
+\return   false jeśli promień był równoległy do płaszczyzny i nie udało się nic policzyć. */
+bool RayToPlane(const VEC3 &RayOrig, const VEC3 &RayDir, const PLANE &Plane, float *OutT, float *OutVD);
+/// Kolizja promienia z trójkątem
+/** \param[out] OutT   Można podać NULL jeśli nie interesuje nas odległość kolizji.
+\param BackfaceCulling   Jeśli true, funkcja zawsze uwzględnia wyłącznie kolizję
+z trójkątem zwróconym w stronę CW (jak w DirectX). */
+bool RayToTriangle(
+	const VEC3 &RayOrig, const VEC3 &RayDir,
+	const VEC3 &p0, const VEC3 &p1, const VEC3 &p2,
+	bool BackfaceCulling,
+	float *OutT);
+/// Kolizja promienia z czworokątem w 3D
+/** Czworokąt musi być płaski, wypukły i zorientowany odpowiednio.
+Kolizja działa tylko w jedną stronę.
+Dla T ujemnego również zwraca false. Niestety nie zwraca T.
+\param OutPoint Parametr opcjonalny. */
+bool RayToQuad(const VEC3 &RayOrig, const VEC3 &RayDir, const VEC3 QuadPoints[4], VEC3 *OutPoint = NULL);
+/// Kolizja promienia z frustumem
+bool RayToFrustum(const VEC3 &RayOrig, const VEC3 &RayDir, const FRUSTUM_PLANES &Frustum, float *t_near, float *t_far);
+/// Kolizja promienia z dowolnie zorientowanym cylindrem
+/** Jeśli kolizja jest z tyłu, też zwraca true i OutT wychodzi ujemne.
+Zwraca zawsze ten z dwóch punktów przecięcia który ma mniejsze OutT. */
+bool RayToCylinder(
+	const VEC3 &RayOrig, const VEC3 &RayDir,
+	const VEC3 &CylinderBeg, const VEC3 &CylinderEnd, float CylinderRadius,
+	float *OutT);
+/// Czy punkt leży wewnątrz wielościana wypukłego.
+/** Płaszczyzny wielościanu mają mieć wektory normalne zwrócone do wewnątrz. */
+bool PointInConvexPolyhedron(const VEC3 &Point, const PLANE PolyhedronPlanes[], size_t PolyhedronPlaneCount);
+bool PointInConvexPolyhedron(const VEC3 &Point, const void *PolyhedronPlanes, size_t PolyhedronPlaneCount, ptrdiff_t PolyhedronPlaneStride);
+/// Kolizja promienia z wielościanem wypukłym.
+/** Płaszczyzny wielościanu mają mieć wektory normalne zwrócone do wewnątrz.
+Ta funkcja testuje tylko kolizję półprostej.
+Jeśli wielościan jest z tyłu promienia, funkcja zwraca false.
+T zawsze wychodzą nieujemne. */
+bool RayToConvexPolyhedron(
+	const VEC3 &RayOrig, const VEC3 &RayDir,
+	const PLANE PolyhedronPlanes[], size_t PolyhedronPlaneCount,
+	float *OutBegT, float *OutEndT);
+bool RayToConvexPolyhedron(
+	const VEC3 &RayOrig, const VEC3 &RayDir,
+	const void *PolyhedronPlanes, size_t PolyhedronPlaneCount, ptrdiff_t PolyhedronPlaneStride,
+	float *OutBegT, float *OutEndT);
+/// Zwraca true jeśli kula koliduje z prostopadłościanem (także jeśli jest w jego środku)
+bool SphereToBox(const VEC3 &SphereCenter, float SphereRadius, const BOX &Box);
+/// Zwraca true, jeśli sfera koliduje z prostopadłościanem zorientowanym
+bool SphereToObb(const VEC3 &SphereCenter, float SphereRadius, const OBB &Obb);
+/// Zwraca true, jeśli sfera koliduje z trójkątem
+bool SphereToTriangle(const VEC3 &SphereCenter, float SphereRadius, const VEC3 &TriA, const VEC3 &TriB, const VEC3 &TriC);
+/// Zwraca true, jeśli sfera zawiera się w całości w prostopadłościanie
+bool SphereInBox(const VEC3 &SphereCenter, float SphereRadius, const BOX &Box);
+/// Zwraca true, jeśli prostopadłościan zawiera się w całości w sferze
+bool BoxInSphere(const BOX &Box, const VEC3 &SphereCenter, float SphereRadius);
+/// Klasyfikuje położenie prostopadłościanu względem płaszczyzny
+/**
+- -1 = prostopadłościan w całości po ujemnej stronie płaszczyzny
+-  0 = prostopadłościan przecina płaszczyznę
+- +1 = prostopadłościan w całości po dodatniej stronie płaszczyzny
+\param plane Płaszczyzna musi być znormalizowana */
+int ClassifyBoxToPlane(const PLANE &plane, const BOX &box);
+/// Klasyfikuje położenie zorientowanego prostopadłościanu OBB względem płaszczyzny. Zwraca -1, 0, 1.
+int ClassifyObbToPlane(const PLANE &Plane, const OBB &Obb);
+/// Kolizja płaszczyzny z prostopadłościanem
+/** \param plane Płaszczyzna musi być znormalizowana */
+inline bool PlaneToBox(const PLANE &plane, const BOX &box) { return ClassifyBoxToPlane(plane, box) == 0; }
+/// Zwraca true, jeśli trójkąt zawiera się w prostopadłościanie
+bool TriangleInBox(const VEC3 &p1, const VEC3 &p2, const VEC3 &p3, const BOX &Box);
+/// Zwraca true, jeśli trójkąt przecina prostopadłościan lub się w nim zawiera
+/** \param[in] OptTrianglePlane   Można podać jeśli się już ma wyliczone,
+żeby przyspieszyć. Nie musi być znormalizowane. */
+bool TriangleToBox(const VEC3 &TriA, const VEC3 &TriB, const VEC3 &TriC, const BOX &Box);
+/// Zwraca true, jeśli podany prostopadłościan jest widoczny choć trochę w bryle widzenia
+/** Uwaga! W rzadkich przypadkach może stwierdzić kolizję chociaż jej nie ma. */
+bool BoxToFrustum_Fast(const BOX &Box, const FRUSTUM_PLANES &Frustum);
+/// Zwraca true, jeśli podany prostopadłościan jest widoczny choć trochę w bryle widzenia
+/**
+Test dokładny, ale wolniejszy i wymaga też reprezentacji punktowej frustuma.
+\param[in] OptFrustumPoints to parametr opcjonalny - podaj jeśli masz już wyliczony. */
+bool BoxToFrustum(const BOX &Box, const FRUSTUM_PLANES &FrustumPlanes, const FRUSTUM_POINTS *OptFrustumPoints = NULL);
+bool BoxToFrustum(const BOX &Box, const FRUSTUM_RADAR &Frustum);
+/// Zwraca true, jeśli AABB jest w całości wewnątrz frustuma
+bool BoxInFrustum(const BOX &Box, const FRUSTUM_PLANES &Frustum);
+/// Zwraca true jeśli podane dwie sfery kolidują ze sobą
+bool SphereToSphere(const VEC3 &Center1, float Radius1, const VEC3 &Center2, float Radius2);
+/// Zwraca true, jeśli sfera koliduje z płaszczyzną
+/** Płaszczyzna musi być znormalizowana. */
+bool SphereToPlane(const VEC3 &SphereCenter, float SphereRadius, const PLANE &Plane);
+/// Klasyfikuje położenie sfery względem płaszczyzny
+/**
+- -1 = sfera w całości po ujemnej stronie płaszczyzny
+-  0 = sfera przecina płaszczyznę
+- +1 = sfera w całości po dodatniej stronie płaszczyzny
+*/
+int ClassifySphereToPlane(const VEC3 &SphereCenter, float SphereRadius, const PLANE &Plane);
+/// Kolizja kapsuły (lub sfery poruszającej się od CapsuleBeg do CapsuleEnd) z płaszczyzną
+/** \param Plane Płaszczyzna musi być znormalizowana. */
+bool CapsuleToPlane(const VEC3 &CapsuleBeg, const VEC3 &CapsuleEnd, float CapsuleRadius, const PLANE &Plane);
+/// Zwraca true, jeśli sfera koliduje z frustumem
+/** Uwaga! W rzadkich przypadkach może stwierdzić kolizję chociaż jej nie ma. */
+bool SphereToFrustum_Fast(const VEC3 &SphereCenter, float SphereRadius, const FRUSTUM_PLANES &Frustum);
+/// Zwraca true, jeśli sfera koliduje z frustumem
+/** Test dokładny, ale wolniejszy i wymaga też reprezentacji punktowej frustuma.
+\param[in] OptFrustumPoints   Parametr opcjonalny - podaj jeśli masz już wyliczony. */
+bool SphereToFrustum(
+	const VEC3 &SphereCenter, float SphereRadius,
+	const FRUSTUM_PLANES &FrustumPlanes, const FRUSTUM_POINTS *OptFrustumPoints = NULL);
+/// Testuje przecięcie sfery z frustumem.
+/** Uwaga! Wygląda na to, że z nienznaych przyczyn ta funkcja nie zwraca true
+także dla sfery która nie jest ściśle kolidująca z frustumem, ale z pewnym
+niewielkim marginesem błędu w kierunku +/- Right.
+*/
+bool SphereToFrustum(const VEC3 &SphereCenter, float SphereRadius, const FRUSTUM_RADAR &Frustum);
+/// Zwraca true, jeśli sfera zawiera się w całości wewnątrz frustuma
+bool SphereInFrustum(const VEC3 &SphereCenter, float SphereRadius, const FRUSTUM_PLANES &Frustum);
+/// Wylicza kolizję dwóch płaszczyzn zwracając parametry prostej tworzącej ich przecięcie
+/** Jesli nie ma kolizji bo płaszczyzny są równoległe, zwraca false.
+Płaszczyzny muszą być znormalizowane.
+\param OutLineDir [out] nie jest znormalizowany. */
+bool Intersect2Planes(const PLANE &Plane1, const PLANE &Plane2, VEC3 *OutLineOrig, VEC3 *OutLineDir);
+/// Zwraca punkt przecięcia trzech płaszczyzn lub false, jeśli taki punkt nie istnieje
+/** Płaszczyzny muszą być znormalizowane. */
+bool Intersect3Planes(const PLANE &P1, const PLANE &P2, const PLANE &P3, VEC3 *OutP);
+/// Kolizja płaszczyzny z trójkątem
+bool PlaneToTriangle(const PLANE &Plane, const VEC3 &p0, const VEC3 &p1, const VEC3 &p2);
+/// Klasyfikuje położenie trójkąta względem płaszczyzny
+/**
+- -1 = trójkąt w całości po ujemnej stronie płaszczyzny
+-  0 = trójkąt przecina płaszczyznę
+- +1 = trójkąt w całości po dodatniej stronie płaszczyzny
+*/
+int ClassifyPlaneToTriangle(const PLANE &Plane, const VEC3 &p0, const VEC3 &p1, const VEC3 &p2);
+/// Kolizja płaszczyzny z frustumem (klasyfikacja)
+int ClassifyFrustumToPlane(const FRUSTUM_POINTS &Frustum, const PLANE &Plane);
+/// Zwraca true, jeśli dwa odcinki 2D zachodzą na siebie
+/** \param OutSeg1_t Parametr opcjonalny. Zwraca parametr 0..1 miejsca przecięcia na odcinku Seg1. */
+bool SegmentToSegment(const VEC2 &Seg1_Beg, const VEC2 &Seg1_End, const VEC2 &Seg2_Beg, const VEC2 &Seg2_End, float *OutSeg1_t = NULL);
+/// Testuje kolizję dwóch trójkątów 3D
+/** Nie wiem co się dzieje jeśli trójkąty są zdegenerowane. */
+bool TriangleToTriangle(
+	const VEC3 &V0,const VEC3 &V1,const VEC3 &V2,
+	const VEC3 &U0,const VEC3 &U1,const VEC3 &U2);
+/// Testuje, czy trójkąt leży w całości wewnątrz frustuma
+bool TriangleInFrustum(const VEC3 &t1, const VEC3 &t2, const VEC3 &t3, const FRUSTUM_PLANES &Frustum);
+/// Testuje kolizję trójkąta z frustumem
+/** \param[in] OptTrianglePlane   Podaj jeśli masz już wyliczone, aby przyspieszyć.
+\param[in] OptFrustumPoints   Podaj jeśli masz już wyliczone, aby przyspieszyć. */
+bool TriangleToFrustum(
+	const VEC3 &t1, const VEC3 &t2, const VEC3 &t3, const PLANE *OptTrianglePlane,
+	const FRUSTUM_PLANES &FrustumPlanes, const FRUSTUM_POINTS *OptFrustumPoints);
+/// Testuje kolizję między dwoma frustumami
+bool FrustumToFrustum(
+	const FRUSTUM_PLANES &Frustum1_Planes, const FRUSTUM_POINTS &Frustum1_Points,
+	const FRUSTUM_PLANES &Frustum2_Planes, const FRUSTUM_POINTS &Frustum2_Points);
+/// Kolizja sfery z kapsułą
+bool SphereToCapsule(
+	const VEC3 &SphereCenter, float SphereRadius,
+	const VEC3 &Capsule_Beg, const VEC3 &Capsule_End, float Capsule_Radius);
+/// Kolizja kapsuły z kapsułą
+bool CapsuleToCapsule(
+	const VEC3 &Capsule1_Beg, const VEC3 &Capsule1_End, float Capsule1_Radius,
+	const VEC3 &Capsule2_Beg, const VEC3 &Capsule2_End, float Capsule2_Radius);
+/// Sprawdza, czy punkt leży wewnątrz wypukłego wielokąta 2D.
+/** Wielokąt musi mieć wierzchołki zorientowane CW. */
+bool PointInConvexPolygon(const VEC2 &Point, const VEC2 PolygonPoints[], size_t PolygonPointCount);
+bool PointInConvexPolygon(const VEC2 &Point, const void *PolygonPoints, size_t PolygonPointCount, ptrdiff_t PolygonPointStride);
+/// Zwraca true, jeśli podany punkt leży wewnątrz podanego wielokąta (2D).
+/** Wielokąt może mieć dowolny kształt, także niewypukły, a nawet sam się przecinać.
+Jego wierzchołki mogą biec w dowolnym kierunku. */
+bool PointInPolygon(const VEC2 &Point, const VEC2 PolygonPoints[], size_t PolygonPointCount);
+bool PointInPolygon(const VEC2 &Point, const void *PolygonPoints, size_t PolygonPointCount, ptrdiff_t PolygonPointStride);
+/// Zwraca true, jeśli promień przecina wielokąt wypukły 3D i wtedy przez OutT zwraca parametr dla promienia.
+/** Wierzchołki wielokąta muszą leżeć w jednej płaszczyźnie.
+Jeśli kolizja jest od tyłu początku promienia, zwraca true i OutT ujemne.
+Uwaga! Stosuje rzutowanie na jedną z głównych płaszczyzn, testowana tylko dla jednej z trzech możliwych. BackfaceCulling może działać źle.
+\param BackfaceCulling true oznacza, że promień trafia tylko jeśli wchodzi z jednej strony,
+z tej z której wierzchołki wielokąta są widoczne jako zorientowane w kierunku CW.
+\param PolygonPlane Opcjonalny. Podaj, jeśli masz już wyliczony. */
+bool RayToConvexPolygon(
+	const VEC3 &RayOrig, const VEC3 &RayDir,
+	const VEC3 PolygonPoints[], size_t PolygonPointCount,
+	bool BackfaceCulling, float *OutT, VEC3 *OutPoint, const PLANE *PolygonPlane = NULL);
+bool RayToConvexPolygon(
+	const VEC3 &RayOrig, const VEC3 &RayDir,
+	const void *PolygonPoints, size_t PolygonPointCount, ptrdiff_t PolygonPointStride,
+	bool BackfaceCulling, float *OutT, VEC3 *OutPoint, const PLANE *PolygonPlane = NULL);
+/// Zwraca true, jeśli promień przecina wielokąt 3D i wtedy przez OutT zwraca parametr dla promienia.
+/** Wierzchołki wielokąta muszą leżeć w jednej płaszczyźnie.
+Wielokąt może być dowolny, nie musi być wypukły.
+Uwaga! Stosuje rzutowanie na jedną z głównych płaszczyzn, testowana tylko dla jednej z trzech możliwych. BackfaceCulling może działać źle.
+\param BackfaceCulling true oznacza, że promień trafia tylko jeśli wchodzi z jednej strony,
+z tej z której wierzchołki wielokąta są widoczne jako zorientowane w kierunku CW.
+\param PolygonPlane Opcjonalny. Podaj, jeśli masz już wyliczony. */
+bool RayToPolygon(
+	const VEC3 &RayOrig, const VEC3 &RayDir,
+	const VEC3 PolygonPoints[], size_t PolygonPointCount,
+	bool BackfaceCulling, float *OutT, VEC3 *OutPoint, const PLANE *PolygonPlane = NULL);
+bool RayToPolygon(
+	const VEC3 &RayOrig, const VEC3 &RayDir,
+	const void *PolygonPoints, size_t PolygonPointCount, ptrdiff_t PolygonPointStride,
+	bool BackfaceCulling, float *OutT, VEC3 *OutPoint, const PLANE *PolygonPlane = NULL);
+
+/// Liczy kolizję poruszającej się sfery z płaszczyzną
+/**
+- Płaszczyzna musi być znormalizowana.
+- Jako OutT0 i OutT1 można podawać NULL, jeśli nas akurat nie interesuje.
+- Jeśli sfera porusza się w drugą stronę, też wychodzi true i T wychodzą ujemne.
+- Jeśli sfera koliduje z płaszczyzną i porusza się w kierunku do niej równoległym, jest T0=0, T1=MAXFLOAT i return true.
+*/
+bool SweptSphereToPlane(const VEC3 &SphereCenter, float SphereRadius, const VEC3 &SphereSweepDir, const PLANE &Plane, float *OutT0, float *OutT1);
+/// Oblicza kolizję poruszającej się sfery z frustumem
+/**
+- Frustum musi być znormalizowany.
+- Jeśli sfera leży w środku, też oczywiście zwraca true.
+*/
+bool SweptSphereToFrustum(const VEC3 &SphereCenter, float SphereRadius, const VEC3 &SphereSweepDir, const FRUSTUM_PLANES &Frustum);
+/// Analityczna kolizja dwóch poruszających się sfer.
+/**
+- Jeśli nie ma kolizji, zwraca false. T1 i T2 niezdefiniowane.
+- Jeśli jest kolizja, zwraca true. Wówczas przez T1 i T2 zwraca czas początku i końca kolizji wyrażony we wielokrotnościach długości SphereSweepDir1 (T1 <= T2).
+- Jeśli kolizja następuje z tyłu, też zwraca true, a T1 i/lub T2 będą ujemne.
+
+\param SphereSweepDir1    Kierunek ruchu sfery 1 w stosunku do sfery 2. Nie musi być znormalizowany.
+*/
+bool SweptSphereToSphere(
+	const VEC3 &SphereCenter1, float SphereRadius1,
+	const VEC3 &SphereCenter2, float SphereRadius2,
+	const VEC3 &SphereSweepDir1,
+	float *OutT1, float *OutT2);
+/// Kolizja poruszającego się AABB z drugim AABB.
+/**
+- Jeśli nie zachodzi, zwraca false.
+- Jeśli zachodzi, zwraca true i T jako czas początkowy kontaktu.
+- Jeśli zachodzi z tyłu, zwraca true i T ujemne.
+- Jeśli zachodzi w chwili początkowej, zwraca true i T=0.
+
+\param SweepDirBox1    Nie musi być znormalizowany. T będzie wyrażone we wielokrotnościach jego długości.
+*/
+bool SweptBoxToBox(const BOX &Box1, const BOX &Box2, const VEC3 &SweepDirBox1, float *OutT1, float *OutT2);
+
+/** \param rayDir Must be normalized.
+\param coneDirVec Must be normalized.
+\param coneHalfAngle Must be less than PI_2.
+\return Number of intersections. */
+int RayToCone(const VEC3 &rayOrig, const VEC3 & rayDir, const VEC3 &coneVertex, const VEC3 &coneDirVec, float coneHalfAngle, VEC3 intersections[2]);
+bool PointInCone(const VEC3 &pt, const VEC3 &coneVertex, const VEC3 &coneDirVec, float coneHalfAngle);
+bool SegmentIntersectsOrIsContainedInCone(const VEC3 & segmentPoint1, const VEC3 & segmentPoint2, const VEC3 & coneVertex, const VEC3 & coneDirVec, const float coneHalfAngle, VEC3 intersections[2], int &numIntersectionsFound);
+bool SegmentIntersectsOrIsContainedInCone(const VEC3 & segmentPoint1, const VEC3 & segmentPoint2, const VEC3 & coneVertex, const VEC3 & coneDirVec, const float coneHalfAngle);
+
+//@}
+// math_collisions
+
+/// Z podanej tablicy punktów typu VEC2 znajduje punkt najbliższy względem p, zwraca jego indeks.
+/** \param OutDistance jest opcjonalny, można podać NULL Jeśli odległość od niego nas nie interesuje. */
+size_t ClosestPoint(const VEC2 &p, const VEC2 Points[], size_t PointCount, float *OutDistance = NULL);
+size_t ClosestPoint(const VEC2 &p, const void *Data, size_t PointCount, ptrdiff_t Stride, float *OutDistance = NULL);
+/// Z podanej tablicy punktów typu VEC3 znajduje punkt najbliższy względem p, zwraca jego indeks.
+/** \param OutDistance jest opcjonalny, można podać NULL Jeśli odległość od niego nas nie interesuje. */
+size_t ClosestPoint(const VEC3 &p, const VEC3 Points[], size_t PointCount, float *OutDistance = NULL);
+size_t ClosestPoint(const VEC3 &p, const void *Data, size_t PointCount, ptrdiff_t Stride, float *OutDistance = NULL);
+/// Z podanej tablicy punktów typu VEC2 znajduje punkt najdalszy względem p, zwraca jego indeks.
+/** \param OutDistance jest opcjonalny, można podać NULL Jeśli odległość od niego nas nie interesuje. */
+size_t FurthestPoint(const VEC2 &p, const VEC2 Points[], size_t PointCount, float *OutDistance = NULL);
+size_t FurthestPoint(const VEC2 &p, const void *Data, size_t PointCount, ptrdiff_t Stride, float *OutDistance = NULL);
+/// Z podanej tablicy punktów typu VEC3 znajduje punkt najdalszy względem p, zwraca jego indeks.
+/** \param OutDistance jest opcjonalny, można podać NULL Jeśli odległość od niego nas nie interesuje. */
+size_t FurthestPoint(const VEC3 &p, const VEC3 Points[], size_t PointCount, float *OutDistance = NULL);
+size_t FurthestPoint(const VEC3 &p, const void *Data, size_t PointCount, ptrdiff_t Stride, float *OutDistance = NULL);
+/// Z podanej tablicy punktów typu VEC2 znajduje najbardziej wysunięty w kierunku określonym przez Dir. Zwraca jego indeks.
+size_t FurthestPointForDir(const VEC2 &Dir, const VEC2 Points[], size_t PointCount);
+size_t FurthestPointForDir(const VEC2 &Dir, const void *Data, size_t PointCount, ptrdiff_t Stride);
+/// Z podanej tablicy punktów typu VEC3 znajduje najbardziej wysunięty w kierunku określonym przez Dir. Zwraca jego indeks.
+size_t FurthestPointForDir(const VEC3 &Dir, const VEC3 Points[], size_t PointCount);
+size_t FurthestPointForDir(const VEC3 &Dir, const void *Data, size_t PointCount, ptrdiff_t Stride);
+
+/// Tworzy najmniejszy prostokąt otaczający podany zbiór punktów typu VEC2.
+void RectBoundingPoints(RECTF *OutRect, const VEC2 Points[], size_t PointCount);
+void RectBoundingPoints(RECTF *OutRect, const void *Data, size_t PointCount, ptrdiff_t Stride);
+/// Tworzy najmniejszy boks otaczający podany zbiór punktów typu VEC3.
+void BoxBoundingPoints(BOX *box, const VEC3 points[], size_t PointCount);
+void BoxBoundingPoints(BOX *box, const void *Data, size_t PointCount, ptrdiff_t Stride);
+/// Liczy sferę otaczającą dwie sfery
+void SphereBoundingSpheres(VEC3 *OutCenter, float *OutRadius, const VEC3 &Center1, float Radius1, const VEC3 &Center2, float Radius2);
+
+/// Znajduje okrąg otaczający podany zbiór punktów typu VEC2.
+/** Nie jest to może najmniejszy okrąg, ale przynajmniej ten algorytm jest prosty i szybki. */
+void CircleBoundingPoints(VEC2 *OutSphereCenter, float *OutSphereRadius, const VEC2 Points[], size_t PointCount);
+void CircleBoundingPoints(VEC2 *OutSphereCenter, float *OutSphereRadius, const void *PointData, size_t PointCount, ptrdiff_t PointStride);
+/// Znajduje sferę otaczającą podany zbiór punktów typu VEC3.
+/** Nie jest to może najmniejsza sfera, ale przynajmniej ten algorytm jest prosty i szybki. */
+void SphereBoundingPoints(VEC3 *OutSphereCenter, float *OutSphereRadius, const VEC3 Points[], size_t PointCount);
+void SphereBoundingPoints(VEC3 *OutSphereCenter, float *OutSphereRadius, const void *PointData, size_t PointCount, ptrdiff_t PointStride);
+
+/// Znajduje promień najmniejszego okręgu o środku (0,0) otaczającego podany zbiór punktów 2D.
+void OriginCircleBoundingPoints(float *OutRadius, const VEC2 Points[], size_t PointCount);
+void OriginCircleBoundingPoints(float *OutRadius, const void *PointData, size_t PointCount, ptrdiff_t PointStride);
+/// Znajduje promień najmniejszej sfery o środku (0,0) otaczającej podany zbiór punktów 3D.
+void OriginSphereBoundingPoints(float *OutRadius, const VEC3 Points[], size_t PointCount);
+void OriginSphereBoundingPoints(float *OutRadius, const void *PointData, size_t PointCount, ptrdiff_t PointStride);
+
+/// Dla podanego zbioru punktów typu VEC2 oblicza ich centroid, czyli po prostu średnią.
+void CalcCentroid(VEC2 *OutCentroid, const VEC2 Points[], size_t PointCount);
+void CalcCentroid(VEC2 *OutCentroid, const void *PointData, size_t PointCount, ptrdiff_t PointStride);
+/// Dla podanego zbioru punktów typu VEC3 oblicza ich centroid, czyli po prostu średnią.
+void CalcCentroid(VEC3 *OutCentroid, const VEC3 Points[], size_t PointCount);
+void CalcCentroid(VEC3 *OutCentroid, const void *PointData, size_t PointCount, ptrdiff_t PointStride);
+
+/// Oblicza macierz kowariancji dla podanego zbioru punktów typu VEC3.
+void CalcCovarianceMatrix(MATRIX33 *OutCov, const VEC3 Points[], size_t PointCount);
+void CalcCovarianceMatrix(MATRIX33 *OutCov, const void *PointData, size_t PointCount, ptrdiff_t PointStride);
+/// Oblicza wartości własne i wektory własne dla podanej macierzy symetrycznej (np. macierz kowariancji).
+/** Uwaga! Dużo obliczeń, procedura iteracyjna. Może działać wolno.
+\param InCovOutEigenvalues [in,out] Jako wejście - dana macierz. Jako wyjście - na przekątnej ma wartości własne.
+\param OutEigenvectors [out] Wektory własne zapisane w kolumnach. */
+void CalcEigenvaluesAndEigenvectors(MATRIX33 *InCovOutEigenvalues, MATRIX33 *OutEigenvectors);
+
+/// Oblicza sferę otaczającą box
+void BoxBoundingSphere(VEC3 *SphereCenter, float *SphereRadius, const BOX &Box);
+/// Oblicza box otaczający sferę
+void SphereBoundingBox(BOX *Out, const VEC3 &SphereCenter, float SphereRadius);
+/// Wylicza AABB otaczający podany zbiór sfer
+/** \param SphereCount   Musi być większe od 0. */
+void BoxBoundingSpheres(BOX *OutBox, const VEC3 SpheresCenter[], const float SpheresRadius[], size_t SphereCount);
+
+/// Losuje punkt wewnątrz kuli o środku w (0,0,0) i promieniu 1. Rozkład równomierny.
+void RandomPointInUnitSphere(VEC3 *Out, RandomGenerator &Rand);
+void RandomPointInUnitSphere(VEC3 *Out);
+/// Losuje punkt wewnątrz koła o środku w (0,0) i promieniu 1. Rozkład równomierny.
+void RandomPointInUnitCircle(VEC2 *Out, RandomGenerator &Rand);
+void RandomPointInUnitCircle(VEC2 *Out);
+
+/// Calculates orientation of a 3D billboard in according to its parameters and camera parameters.
+/** OutRight, OutUp will be normalized vectors with X, Y directions for the billboard. \n
+DegreesOfFreedom and UseRealDir control billboard orientation mode.
+DegreesOfFreedom may be 0, 1, 2. \n
+0 = billboard not rotating at all (DefinedRight and DefinedUp required). \n
+1 = billboard rotating only around its Y axis (DefinedUp required). \n
+2 = billboard rotating around its Y and X axes (neither DefinedRight nor DefinedUp required). \n
+DefinedRight and DefinedUp are original direction vectors of a billboard. \n
+CamRightDir must be orthogonal to CamReadUpDir, so CamRealUpDir cannot be constant like VEC3_POSITIVE_Y. \n
+CameraToObjectDir must be normalize(BillboardCenterPos - EyePos). */
+void CalcBillboardOrientation(
+	VEC3 *OutRight, VEC3 *OutUp,
+	unsigned DegreesOfFreedom, bool UseRealDir,
+	const VEC3 &DefinedRight, const VEC3 &DefinedUp,
+	const VEC3 &CamRightDir, const VEC3 &CamRealUpDir, const VEC3 &CameraToObjectDir);
+
+/// Klasa, która dzięki pamiętaniu wyników pośrednich przyspiesza testowanie kolizji jednego trójkąta z wieloma promieniami.
+/** Na podstawie książki: Real-Time Collision Detection, Christer Ericson */
+class RayToTriangleCalc
+{
+public:
+	/// Tworzy NIEZAINICJALIZOWANY
+	RayToTriangleCalc() { }
+	/// Tworzy i inicjalizuje
+	RayToTriangleCalc(const VEC3 &TriA, const VEC3 &TriB, const VEC3 &TriC) { Init(TriA, TriB, TriC); }
+	/// Inicjalizuje
+	void Init(const VEC3 &TriA, const VEC3 &TriB, const VEC3 &TriC);
+
+	/// Liczy kolizję podanego promienia z wpisanym do obiektu trójkątem.
+	/** Jeśli kolizja jest od tyłu promienia, również zwraca true i OutT ujemne.
+	\param BackfaceCulling Jeśli true, uwzględnia kolizję tylko od strony z której wierzchołki trójkąta są CW.
+	\param OutT [out] Parametr do promienia.
+	\param OutU [out] Współrzędna barycentryczna.
+	\param OutV [out] Współrzędna barycentryczna.
+	\param OutW [out] Współrzędna barycentryczna.
+	\param OutPoint [out] Punkt kolizji. */
+	bool RayToTriangle(
+		const VEC3 &RayOrig, const VEC3 &RayDir, bool BackfaceCulling,
+		float *OutT, float *OutU, float *OutV, float *OutW, VEC3 *OutPoint) const;
+
+private:
+	PLANE m_Plane;
+	PLANE m_EdgePlaneBC;
+	PLANE m_EdgePlaneCA;
+};
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+/** \addtogroup math_poisson_disc Poisson Disc */
+//@{
+
+extern const float POISSON_DISC_1D[];
+const uint32 POISSON_DISC_1D_COUNT = 100;
+
+extern const VEC2 POISSON_DISC_2D[];
+const uint32 POISSON_DISC_2D_COUNT = 100;
+
+extern const VEC3 POISSON_DISC_3D[];
+const uint32 POISSON_DISC_3D_COUNT = 100;
+
+//@}
+// math_poisson_disc
+
+//@}
+// code_math
+
+} // namespace common
+
+
+/** \addtogroup code_math */
+//@{
+/** \addtogroup math_swizzle Vector swizzling
+Here are macros for convinient building vectors from arbitrary components of
+other vector, just like in HLSL and other shader languages.
+
+For example, in HLSL you can extend float2 to float4 with repeating (x,y)
+components two times with code like this:
+
+\verbatim
+float2 v2 = float2(1, 2);
+float4 v4 = v2.xyxy;
+\endverbatim
+
+In C++ with CommonLib, you can do it like this:
+
+\code
+common::VEC2 v2 = common::VEC2(1.f, 2.f);
+common::VEC4 v4 = common::VEC4(v2.x, v2.y, v2.x, v2.y);
+\endcode
+
+But the more convenient way is to use VEC4_SWIZZLE macro:
+
+\code
+common::VEC2 v2 = common::VEC2(1.f, 2.f);
+common::VEC4 v4 = VEC4_SWIZZLE(v2,x,y,x,y);
+\endcode
+
+Source vector can be of any size (VEC2, VEC3, VEC4), as long as you reference
+only existing components (x, y, z, w).
+
+Type of destination vector is determined by using particular macro (e.g.
+VEC3_SWIZZLE returns VEC3).
+
+You can use expression of any type as source value, as long as it can be indexed
+with dot operator. E.g.:
+
+\code
+MATRIX m = ...;
+VEC4 mDiagonal = VEC4_SWIZZLE(m,_11,_22,_33,_44);
+BOX box = ...;
+VEC2 boxRangeX = VEC2_SWIZZLE(box,Min.x,Max.x);
+\endcode
+*/
+//@{
+
+#define VEC2_SWIZZLE(v, c0, c1)         (common::VEC2((v).c0, (v).c1))
+#define VEC3_SWIZZLE(v, c0, c1, c2)     (common::VEC3((v).c0, (v).c1, (v).c2))
+#define VEC4_SWIZZLE(v, c0, c1, c2, c3) (common::VEC4((v).c0, (v).c1, (v).c2, (v).c3))
+
+//@}
+// math_swizzle
+//@}
+// code_math
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Konwersje
+
+/** \addtogroup code_sthtostr */
+//@{
+
+template <>
+struct SthToStr_obj<common::POINT_>
+{
+	void operator () (tstring *Str, const common::POINT_ &Sth)
+	{
+		*Str = common::Format(_T("#,#")) % Sth.x % Sth.y;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct StrToSth_obj<common::POINT_>
+{
+	bool operator () (common::POINT_ *Sth, const tstring &Str)
+	{
+		size_t CommaPos = Str.find(_T(','));
+		if (CommaPos == tstring::npos) return false;
+		if (!StrToSth<int>(&Sth->x, Str.substr(0, CommaPos))) return false;
+		if (!StrToSth<int>(&Sth->y, Str.substr(CommaPos+1))) return false;
+		return true;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct SthToStr_obj<common::VEC2>
+{
+	void operator () (tstring *Str, const common::VEC2 &Sth)
+	{
+		*Str = common::Format(_T("#,#")) % Sth.x % Sth.y;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct StrToSth_obj<common::VEC2>
+{
+	bool operator () (common::VEC2 *Sth, const tstring &Str)
+	{
+		size_t CommaPos = Str.find(_T(','));
+		if (CommaPos == tstring::npos) return false;
+		if (!StrToSth<float>(&Sth->x, Str.substr(0, CommaPos))) return false;
+		if (!StrToSth<float>(&Sth->y, Str.substr(CommaPos+1))) return false;
+		return true;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct SthToStr_obj<common::VEC3>
+{
+	void operator () (tstring *Str, const common::VEC3 &Sth)
+	{
+		*Str = common::Format(_T("#,#,#")) % Sth.x % Sth.y % Sth.z;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct StrToSth_obj<common::VEC3>
+{
+	bool operator () (common::VEC3 *Sth, const tstring &Str)
+	{
+		size_t CommaPos1 = Str.find(_T(','));
+		if (CommaPos1 == tstring::npos) return false;
+		size_t CommaPos2 = Str.find(_T(','), CommaPos1+1);
+		if (CommaPos2 == tstring::npos) return false;
+		if (!StrToSth<float>(&Sth->x, Str.substr(0, CommaPos1))) return false;
+		if (!StrToSth<float>(&Sth->y, Str.substr(CommaPos1+1, CommaPos2-(CommaPos1+1)))) return false;
+		if (!StrToSth<float>(&Sth->z, Str.substr(CommaPos2+1))) return false;
+		return true;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct SthToStr_obj<common::VEC4>
+{
+	void operator () (tstring *Str, const common::VEC4 &Sth)
+	{
+		*Str = common::Format(_T("#,#,#,#")) % Sth.x % Sth.y % Sth.z % Sth.w;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct StrToSth_obj<common::VEC4>
+{
+	bool operator () (common::VEC4 *Sth, const tstring &Str)
+	{
+		size_t CommaPos1 = Str.find(_T(','));
+		if (CommaPos1 == tstring::npos) return false;
+		size_t CommaPos2 = Str.find(_T(','), CommaPos1+1);
+		if (CommaPos2 == tstring::npos) return false;
+		size_t CommaPos3 = Str.find(_T(','), CommaPos2+1);
+		if (CommaPos3 == tstring::npos) return false;
+		if (!StrToSth<float>(&Sth->x, Str.substr(0, CommaPos1))) return false;
+		if (!StrToSth<float>(&Sth->y, Str.substr(CommaPos1+1, CommaPos2-(CommaPos1+1)))) return false;
+		if (!StrToSth<float>(&Sth->z, Str.substr(CommaPos2+1, CommaPos3-(CommaPos2+1)))) return false;
+		if (!StrToSth<float>(&Sth->w, Str.substr(CommaPos3+1))) return false;
+		return true;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct SthToStr_obj<common::RECTI>
+{
+	void operator () (tstring *Str, const common::RECTI &Sth)
+	{
+		*Str = common::Format(_T("#,#,#,#")) % Sth.Min.x % Sth.Min.y % Sth.Max.x % Sth.Max.y;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct StrToSth_obj<common::RECTI>
+{
+	bool operator () (common::RECTI *Sth, const tstring &Str)
+	{
+		size_t CommaPos1 = Str.find(_T(','));
+		if (CommaPos1 == tstring::npos) return false;
+		size_t CommaPos2 = Str.find(_T(','), CommaPos1+1);
+		if (CommaPos2 == tstring::npos) return false;
+		size_t CommaPos3 = Str.find(_T(','), CommaPos2+1);
+		if (CommaPos3 == tstring::npos) return false;
+		if (!StrToSth<int>(&Sth->Min.x, Str.substr(0, CommaPos1))) return false;
+		if (!StrToSth<int>(&Sth->Min.y, Str.substr(CommaPos1+1, CommaPos2-(CommaPos1+1)))) return false;
+		if (!StrToSth<int>(&Sth->Max.x, Str.substr(CommaPos2+1, CommaPos3-(CommaPos2+1)))) return false;
+		if (!StrToSth<int>(&Sth->Max.y, Str.substr(CommaPos3+1))) return false;
+		return true;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct SthToStr_obj<common::RECTF>
+{
+	void operator () (tstring *Str, const common::RECTF &Sth)
+	{
+		*Str = common::Format(_T("#,#,#,#")) % Sth.Min.x % Sth.Min.y % Sth.Max.x % Sth.Max.y;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct StrToSth_obj<common::RECTF>
+{
+	bool operator () (common::RECTF *Sth, const tstring &Str)
+	{
+		size_t CommaPos1 = Str.find(_T(','));
+		if (CommaPos1 == tstring::npos) return false;
+		size_t CommaPos2 = Str.find(_T(','), CommaPos1+1);
+		if (CommaPos2 == tstring::npos) return false;
+		size_t CommaPos3 = Str.find(_T(','), CommaPos2+1);
+		if (CommaPos3 == tstring::npos) return false;
+		if (!StrToSth<float>(&Sth->Min.x, Str.substr(0, CommaPos1))) return false;
+		if (!StrToSth<float>(&Sth->Min.y, Str.substr(CommaPos1+1, CommaPos2-(CommaPos1+1)))) return false;
+		if (!StrToSth<float>(&Sth->Max.x, Str.substr(CommaPos2+1, CommaPos3-(CommaPos2+1)))) return false;
+		if (!StrToSth<float>(&Sth->Max.y, Str.substr(CommaPos3+1))) return false;
+		return true;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct SthToStr_obj<common::BOX>
+{
+	void operator () (tstring *Str, const common::BOX &Sth)
+	{
+		*Str = common::Format(_T("#;#")) % Sth.Min % Sth.Max;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct StrToSth_obj<common::BOX>
+{
+	bool operator () (common::BOX *Sth, const tstring &Str)
+	{
+		size_t SemicolonPos = Str.find(_T(';'));
+		if (SemicolonPos == tstring::npos) return false;
+		if (!StrToSth<common::VEC3>(&Sth->Min, Str.substr(0, SemicolonPos))) return false;
+		if (!StrToSth<common::VEC3>(&Sth->Max, Str.substr(SemicolonPos+1))) return false;
+		return true;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <> struct SthToStr_obj<common::COLOR> {
+	void operator () (tstring *Str, const common::COLOR &Sth) { common::ColorToStr(Str, Sth); }
+	static inline bool IsSupported() { return true; }
+};
+template <> struct StrToSth_obj<common::COLOR> {
+	bool operator () (common::COLOR *Sth, const tstring &Str) { return common::StrToColor(Sth, Str); }
+	static inline bool IsSupported() { return true; }
+};
+
+template <> struct SthToStr_obj<common::COLORF> {
+	void operator () (tstring *Str, const common::COLORF &Sth) { common::ColorToStr(Str, Sth); }
+	static inline bool IsSupported() { return true; }
+};
+template <> struct StrToSth_obj<common::COLORF> {
+	bool operator () (common::COLORF *Sth, const tstring &Str) { return common::StrToColor(Sth, Str); }
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct SthToStr_obj<common::PLANE>
+{
+	void operator () (tstring *Str, const common::PLANE &Sth)
+	{
+		*Str = common::Format(_T("#,#,#,#")) % Sth.a % Sth.b % Sth.c % Sth.d;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct StrToSth_obj<common::PLANE>
+{
+	bool operator () (common::PLANE *Sth, const tstring &Str)
+	{
+		size_t CommaPos1 = Str.find(_T(','));
+		if (CommaPos1 == tstring::npos) return false;
+		size_t CommaPos2 = Str.find(_T(','), CommaPos1+1);
+		if (CommaPos2 == tstring::npos) return false;
+		size_t CommaPos3 = Str.find(_T(','), CommaPos2+1);
+		if (CommaPos3 == tstring::npos) return false;
+		if (!StrToSth<float>(&Sth->a, Str.substr(0, CommaPos1))) return false;
+		if (!StrToSth<float>(&Sth->b, Str.substr(CommaPos1+1, CommaPos2-(CommaPos1+1)))) return false;
+		if (!StrToSth<float>(&Sth->c, Str.substr(CommaPos2+1, CommaPos3-(CommaPos2+1)))) return false;
+		if (!StrToSth<float>(&Sth->d, Str.substr(CommaPos3+1))) return false;
+		return true;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct SthToStr_obj<common::LINE2D>
+{
+	void operator () (tstring *Str, const common::LINE2D &Sth)
+	{
+		*Str = common::Format(_T("#,#,#")) % Sth.a % Sth.b % Sth.c;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct StrToSth_obj<common::LINE2D>
+{
+	bool operator () (common::LINE2D *Sth, const tstring &Str)
+	{
+		size_t CommaPos1 = Str.find(_T(','));
+		if (CommaPos1 == tstring::npos) return false;
+		size_t CommaPos2 = Str.find(_T(','), CommaPos1+1);
+		if (CommaPos2 == tstring::npos) return false;
+		if (!StrToSth<float>(&Sth->a, Str.substr(0, CommaPos1))) return false;
+		if (!StrToSth<float>(&Sth->b, Str.substr(CommaPos1+1, CommaPos2-(CommaPos1+1)))) return false;
+		if (!StrToSth<float>(&Sth->c, Str.substr(CommaPos2+1))) return false;
+		return true;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <> struct SthToStr_obj<common::MATRIX> {
+	void operator () (tstring *Str, const common::MATRIX &Sth) { common::MatrixToStr(Str, Sth); }
+	static inline bool IsSupported() { return true; }
+};
+template <> struct StrToSth_obj<common::MATRIX> {
+	bool operator () (common::MATRIX *Sth, const tstring &Str) { return common::StrToMatrix(Sth, Str); }
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct SthToStr_obj<common::QUATERNION>
+{
+	void operator () (tstring *Str, const common::QUATERNION &Sth)
+	{
+		*Str = common::Format(_T("#,#,#,#")) % Sth.x % Sth.y % Sth.z % Sth.w;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct StrToSth_obj<common::QUATERNION>
+{
+	bool operator () (common::QUATERNION *Sth, const tstring &Str)
+	{
+		size_t CommaPos1 = Str.find(_T(','));
+		if (CommaPos1 == tstring::npos) return false;
+		size_t CommaPos2 = Str.find(_T(','), CommaPos1+1);
+		if (CommaPos2 == tstring::npos) return false;
+		size_t CommaPos3 = Str.find(_T(','), CommaPos2+1);
+		if (CommaPos3 == tstring::npos) return false;
+		if (!StrToSth<float>(&Sth->x, Str.substr(0, CommaPos1))) return false;
+		if (!StrToSth<float>(&Sth->y, Str.substr(CommaPos1+1, CommaPos2-(CommaPos1+1)))) return false;
+		if (!StrToSth<float>(&Sth->z, Str.substr(CommaPos2+1, CommaPos3-(CommaPos2+1)))) return false;
+		if (!StrToSth<float>(&Sth->w, Str.substr(CommaPos3+1))) return false;
+		return true;
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct SthToStr_obj<common::AFFINE2D>
+{
+	void operator () (tstring *Str, const common::AFFINE2D &Sth)
+	{
+		common::Affine2dToStr(Str, Sth);
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct StrToSth_obj<common::AFFINE2D>
+{
+	bool operator () (common::AFFINE2D *Sth, const tstring &Str)
+	{
+		return common::StrToAffine2d(Sth, Str);
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+//@}
+// code_sthtostr
+#endif
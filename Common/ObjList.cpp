@@ -1,12 +1,12 @@
-/** \file
-\brief Macros for creating doubly-linked list of objects.
-\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
-
-Part of CommonLib library. \n
-Encoding UTF-8, end of line CR+LF \n
-License: GNU LGPL. \n
-Documentation: \ref Module_ObjList \n
-Module components: \ref code_objlist
-*/
-
-// Totally empty.
+/** \file
+\brief Macros for creating doubly-linked list of objects.
+\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
+
+Part of CommonLib library. \n
+Encoding UTF-8, end of line CR+LF \n
+License: GNU LGPL. \n
+Documentation: \ref Module_ObjList \n
+Module components: \ref code_objlist
+*/
+
+// Totally empty.
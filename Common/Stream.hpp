@@ -1,1124 +1,1124 @@
-/** \file
-\brief Stream class hierarchy
-\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
-
-Part of CommonLib library. \n
-Encoding UTF-8, end of line CR+LF \n
-License: GNU LGPL. \n
-Documentation: \ref Module_Stream \n
-Module components: \ref code_stream
-*/
-#if defined(_MSC_VER) && (_MSC_VER >= 1200)
-#pragma once
-#endif
-#ifndef COMMON_STREAM_H_
-#define COMMON_STREAM_H_
-
-namespace common
-{
-
-/** \addtogroup code_stream Stream Module
-Dokumentacja: \ref Module_Stream \n
-Nagwek: Stream.hpp */
-//@{
-
-extern const size_t BUFFER_SIZE;
-
-/// \internal
-void _ThrowBufEndError(const tchar *File, int Line);
-
-/// Tolerancja bdw podczas dekodowania danych zapisanych tekstowo
-enum DECODE_TOLERANCE
-{
-	DECODE_TOLERANCE_NONE,       ///< adne dodatkowe znaki nie bd tolerowane
-	DECODE_TOLERANCE_WHITESPACE, ///< Biae znaki bd ignorowane i nie spowoduj bdu
-	DECODE_TOLERANCE_ALL,        ///< Wszelkie nieznane znaki bd ignorowane i nie spowoduj bdu
-};
-
-
-/// Abstrakcyjna klasa bazowa strumieni danych binarnych
-class Stream
-{
-public:
-	virtual ~Stream() { }
-
-	/** \name Zapisywanie */
-	//@{
-
-	/// Zapisuje dane
-	/** (W oryginale: zgasza bd) */
-	virtual void Write(const void *Data, size_t Size);
-	virtual void Flush() { }
-
-	/// Zapisuje dane, sama odczytuje rozmiar przekazanej zmiennej
-	template <typename T>
-	void WriteEx(const T &x) { return Write(&x, sizeof(x)); }
-	/// Zapisuje dugo na 1B i acuch
-	/** Jeli acuch za dugi - bd. */
-	void WriteString1(const string &s);
-	void WriteString1(const char *s);
-	void WriteString1(const char *s, size_t NumChars);
-#ifdef _WIN32
-	void WriteString1(const wstring &s);
-	void WriteString1(const wchar_t *s);
-	void WriteString1(const wchar_t *s, size_t NumChars);
-#endif
-	/// Zapisuje dugo na 2B i acuch
-	/** Jeli acuch za dugi - bd. */
-	void WriteString2(const string &s);
-	void WriteString2(const char *s);
-	void WriteString2(const char *s, size_t NumChars);
-#ifdef _WIN32
-	void WriteString2(const wstring &s);
-	void WriteString2(const wchar_t *s);
-	void WriteString2(const wchar_t *s, size_t NumChars);
-#endif
-	/// Zapisuje dugo na 4B i acuch
-	void WriteString4(const string &s);
-	void WriteString4(const char *s);
-	void WriteString4(const char *s, size_t NumChars);
-#ifdef _WIN32
-	void WriteString4(const wstring &s);
-	void WriteString4(const wchar_t *s);
-	void WriteString4(const wchar_t *s, size_t NumChars);
-#endif
-	/// Zapisuje acuch bez dugoci
-	void WriteStringF(const string &s);
-#ifdef _WIN32
-	void WriteStringF(const wstring &s);
-#endif
-	/// Zapisuje warto logiczn za pomoc jednego bajtu
-	void WriteBool(bool b);
-
-	//@}
-
-	/** \name Odczytywanie */
-	//@{
-
-	/// Odczytuje dane
-	/** Jeli osignito koniec, funkcja nie zwraca bdu, a liczba odczytanych bajtw to 0.
-	(W oryginale: zgasza bd)
-	\param Size Liczba bajtw do odczytania
-	\return Zwraca liczb bajtw, jakie udao si odczyta
-	*/
-	virtual size_t Read(void *Data, size_t MaxLength);
-	/// Odczytuje tyle bajtw, ile si zada
-	/** Jeli koniec pliku albo jeli odczytano mniej, zgasza bd.
-	(Mona j przeadowa, ale nie trzeba - ma swoj wersj oryginaln)
-	*/
-	virtual void MustRead(void *Data, size_t Length);
-	/// Tak samo jak MustRead(), ale sama odczytuje rozmiar przekazanej zmiennej
-	/** Zwraca true, jeli osignito koniec strumienia
-	(W oryginale: zgasza bd)
-	*/
-	virtual bool End();
-	/// Pomija co najwyej podan liczb bajtw (chyba e wczeniej osignito koniec).
-	/** (Mona j przeadowa, ale nie trzeba - ma swoj wersj oryginaln)
-	\return Zwraca liczb pominitych bajtw.
-	*/
-	virtual size_t Skip(size_t MaxLength);
-
-	/// Odczytuje dane, sama odczytuje rozmiar przekazanej zmiennej
-	template <typename T>
-	void ReadEx(T *x) { MustRead(x, sizeof(*x)); }
-	/// Odczytuje acuch poprzedzony rozmiarem 1B
-	void ReadString1(string *s);
-	/// Odczytuje acuch poprzedzony rozmiarem 2B
-	void ReadString2(string *s);
-	/// Odczytuje acuch poprzedzony rozmiarem 4B
-	void ReadString4(string *s);
-	/// Odczytuje acuch bez zapisanego rozmiaru
-	void ReadStringF(string *s, size_t NumChars);
-	/// Odczytuje tyle znakw do acucha, ile si da do koca strumienia
-	void ReadStringToEnd(string *s);
-	/// Wersje powyszych funkcji dla Unicode
-#ifdef _WIN32
-	void ReadString1(wstring *s);
-	void ReadString2(wstring *s);
-	void ReadString4(wstring *s);
-	void ReadStringF(wstring *s, size_t NumChars);
-	void ReadStringToEnd(wstring *s);
-#endif
-	/// Odczytuje warto logiczn za pomoc jednego bajtu
-	void ReadBool(bool *b);
-	/// Pomija koniecznie podan liczb bajtw.
-	/** Jeli wczeniej osignito koniec, zgasza bd. */
-	void MustSkip(size_t Length);
-
-	//@}
-
-	/** \name Kopiowanie */
-	//@{
-	/// Odczytuje podan co najwyej liczb bajtw z podanego strumienia
-	/** \return Zwraca liczb odczytanych bajtw */
-	size_t CopyFrom(Stream *s, size_t Size);
-	/// Odczytuje dokadnie podan liczb bajtw z podanego strumienia
-	/** Jeli odczyta mniej, zgasza bd. */
-	void MustCopyFrom(Stream *s, size_t Size);
-	/// Odczytuje dane do koca z podanego strumienia
-	size_t CopyFromToEnd(Stream *s);
-	//@}
-};
-
-/// Abstrakcyjna klasa bazowa strumieni pozwalajcych na odczytywanie rozmiaru i zmian pozycji
-class SeekableStream : public Stream
-{
-public:
-	// ======== Implementacja Stream ========
-	/** W Stream domylnie rzuca bd, tu w SeekableStream dostaje ju wersj oryginaln. Mona j dalej nadpisa. */
-	virtual bool End();
-	/** W Stream ma wersj oryginaln, tu w SeekableStream dostaje lepsz. Mona j dalej nadpisa. */
-	virtual size_t Skip(size_t MaxLength);
-
-	/// Zwraca rozmiar
-	/** W oryginale: zgasza bd. */
-	virtual uint64 GetSize();
-	/// Zwraca pozycj wzgldem pocztku
-	/** W oryginale: zgasza bd. */
-	virtual int64 GetPos();
-	/// Ustawia pozycj wzgldem pocztku
-	/** W oryginale: zgasza bd.
-	\param pos Musi by dodatnie. */
-	virtual void SetPos(int64 pos);
-	/// Ustawia pozycj wzgldem biecej
-	/** Mona j nadpisa, ale ma wersj oryginaln
-	\param pos moe by dodatnie albo ujemne. */
-	virtual void SetPosFromCurrent(int64 pos);
-	/// Ustawia pozycj wzgldem kocowej
-	/** Mona j nadpisa, ale ma wersj oryginaln.
-	Np. abu ustawi na ostatni znak, przesu do -1. */
-	virtual void SetPosFromEnd(int64 pos);
-	/// Ustawia pozycj na pocztku
-	/** Mona j nadpisa, ale ma wersj oryginaln. */
-	virtual void Rewind();
-	/// Ustawia rozmiar na podany
-	/** Po tym wywoaniu pozycja kursora jest niezdefiniowana.
-	W oryginale: zgasza bd. */
-	virtual void SetSize(uint64 Size);
-	/// Obcina strumie od biecej pozycji do koca, czyli ustawia taki rozmiar jak bieca pozycja.
-	/** Mona j nadpisa, ale ma wersj oryginaln. */
-	virtual void Truncate();
-	/// Oprnia strumie
-	/** Mona j nadpisa, ale ma wersj oryginaln. */
-	virtual void Clear();
-};
-
-/// Strumie pusty - nic nie robi
-/**
-Zapis po prostu udaje e zapisuje a nic nie robi.
-Odczyt udaje, e plik jest pusty.
-Przestawianie kursora, ustawianie pozycji itp. udaje si, ale nic nie robi.
-*/
-class NullStream : public SeekableStream
-{
-public:
-	virtual void Write(const void *Data, size_t Size) { }
-	virtual size_t Read(void *Data, size_t MaxLength) { return 0; }
-	virtual bool End() { return true; }
-	virtual size_t Skip(size_t MaxLength) { return 0; }
-	virtual uint64 GetSize() { return 0; }
-	virtual int64 GetPos() { return 0; }
-	virtual void SetPos(int64 pos) { }
-	virtual void SetPosFromCurrent(int64 pos) { }
-	virtual void SetPosFromEnd(int64 pos) { }
-	virtual void Rewind() { }
-	virtual void SetSize(uint64 Size) { }
-	virtual void Truncate() { }
-	virtual void Clear() { }
-};
-
-/// Nakadka przyspieszajca zapisujca do strumienia pojedyncze znaki i inne rzeczy.
-/**
-- Nie jest strumieniem.
-- Tylko zapis.
-- Jest szybka, poniewa:
-  -# Nie ma metod wirtualnych.
-  -# Buforuje, wic nie uywa za kadym razem metod wirtualnych strumienia.
-- Sama zapisuje dane pozostae w buforze w destruktorze.
-  Jeli chcesz to zrobi wczeniej i z kontrol bdw, wywoaj CharWriter::Flush().
-- W trybie Debug dziaa nawet troch wolniej ni zapisywanie po bajcie prosto do strumienia.
-  W trybie Release daje przyspieszenie prawie 10x wzgldem zapisywania po bajcie prosto do strumienia.
-- Celowo nie uywam w tej klasie ERR_TRY .. ERR_CATCH_FUNC, eby byo szybciej.
-*/
-class CharWriter
-{
-private:
-	Stream *m_Stream;
-	std::vector<char> m_Buf;
-	size_t m_BufIndex;
-
-	// Wykonuje Flush danych z bufora do strumienia nie sprawdzajc ju, czy bufor nie jest pusty.
-	// Oczywicie zeruje te BufIndex.
-	void DoFlush() { m_Stream->Write(&m_Buf[0], m_BufIndex); m_BufIndex = 0; }
-
-public:
-	CharWriter(Stream *a_Stream) : m_Stream(a_Stream), m_BufIndex(0) { m_Buf.resize(BUFFER_SIZE); }
-	~CharWriter();
-
-	/// Zapisuje pojedynczy znak
-	void WriteChar(char Ch) { if (m_BufIndex == BUFFER_SIZE) DoFlush(); m_Buf[m_BufIndex++] = Ch; }
-	/// Zapisuje po prostu znaki acucha, bez adnej dugoci
-	void WriteString(const string &s);
-	/// Zapisuje acuch zakoczony zerem
-	void WriteString(const char *s) { WriteString(s, strlen(s)); }
-	/// Zapisuje acuch podanej dugoci
-	void WriteString(const char *s, size_t NumChars) { WriteData(s, NumChars); }
-	/// Zapisuje surowe dane binarne
-	void WriteData(const void *Data, size_t Length);
-	/// Zapisuje dowoln informacj przerobion na posta tekstow, o ile da si przerobi
-	template <typename T> void WriteEx(const T &x) { string s; SthToStr<T>(&s, x); WriteString(s); }
-	/// Wymusza oprnienie bufora i wysanie pozostaych w nim danych do strumienia
-	void Flush() { if (m_BufIndex > 0) DoFlush(); }
-};
-
-#ifdef _WIN32
-/// Nakadka przyspieszajca zapisujca do strumienia pojedyncze znaki Unicode.
-/** Uwaga! Wersja Unicode nie posiada zapisywania surowych danych binarnych. */
-class WCharWriter
-{
-private:
-	Stream *m_Stream;
-	std::vector<wchar_t> m_Buf;
-	size_t m_BufIndex;
-
-	// Wykonuje Flush danych z bufora do strumienia nie sprawdzajc ju, czy bufor nie jest pusty.
-	// Oczywicie zeruje te BufIndex.
-	void DoFlush() { m_Stream->Write(&m_Buf[0], m_BufIndex * sizeof(wchar_t)); m_BufIndex = 0; }
-
-public:
-	WCharWriter(Stream *a_Stream) : m_Stream(a_Stream), m_BufIndex(0) { m_Buf.resize(BUFFER_SIZE); }
-	~WCharWriter();
-
-	/// Zapisuje pojedynczy znak
-	void WriteChar(wchar_t Ch) { if (m_BufIndex == BUFFER_SIZE) DoFlush(); m_Buf[m_BufIndex++] = Ch; }
-	/// Zapisuje po prostu znaki acucha, bez adnej dugoci
-	void WriteString(const wstring &s);
-	/// Zapisuje acuch zakoczony zerem
-	void WriteString(const wchar_t *s) { WriteString(s, wcslen(s)); }
-	/// Zapisuje acuch podanej dugoci
-	void WriteString(const wchar_t *s, size_t NumChars);
-	/// Wymusza oprnienie bufora i wysanie pozostaych w nim danych do strumienia
-	void Flush() { if (m_BufIndex > 0) DoFlush(); }
-};
-#endif
-
-/// Nakadka przyspieszajca odczytujca ze strumienia pojedyncze znaki i inne rzeczy.
-/**
-- Nie jest strumieniem.
-- Tylko odczyt.
-- Jest szybka, poniewa:
-  -# Nie ma metod wirtualnych.
-  -# Buforuje, wic nie uywa za kadym razem metod wirtualnych strumienia.
-- Szybko wzgldem wczytywania pojedynczych znakw prosto ze strumienia: Debug = 10 razy, Release = 450 razy!
-- Celowo nie uywam w tej klasie ERR_TRY .. ERR_CATCH_FUNC, eby byo szybciej.
-*/
-class CharReader
-{
-private:
-	Stream *m_Stream;
-	std::vector<char> m_Buf;
-	// Miejsce, do ktrego doczytaem z bufora
-	size_t m_BufBeg;
-	// Miejsce, do ktrego bufor jest wypeniony danymi
-	size_t m_BufEnd;
-
-	// Wczytuje now porcj danych do strumienia
-	// Wywoywa tylko kiedy bufor si skoczy, tzn. m_BufBeg == m_BufEnd.
-	// Jeli skoczy si strumie i nic nie udao si wczyta, zwraca false.
-	// Jeli nie, zapewnia e w buforze bdzie co najmniej jeden znak.
-	bool EnsureNewChars();
-
-public:
-	CharReader(Stream *a_Stream) : m_Stream(a_Stream), m_BufBeg(0), m_BufEnd(0) { m_Buf.resize(BUFFER_SIZE); }
-
-	/// Czy jestemy na kocu danych?
-	bool End() {
-		return (m_BufBeg == m_BufEnd) && m_Stream->End(); // Nic nie zostao w buforze i nic nie zostao w strumieniu.
-	}
-	/// Jeli mona odczyta nastpny znak, wczytuje go i zwraca true.
-	/** Jeli nie, nie zmienia Out i zwraca false. Oznacza to koniec strumienia. */
-	bool ReadChar(char *Out) { if (m_BufBeg == m_BufEnd) { if (!EnsureNewChars()) return false; } *Out = m_Buf[m_BufBeg++]; return true; }
-	/// Jeli mona odczyta nastpny znak, wczytuje go.
-	/** Jeli nie, rzuca wyjtek. */
-	char MustReadChar() { if (m_BufBeg == m_BufEnd) { if (!EnsureNewChars()) _ThrowBufEndError(__TFILE__, __LINE__); } return m_Buf[m_BufBeg++]; }
-	/// Jeli mona odczyta nastpny znak, podglda go zwracajc przez Out i zwraca true. Nie przesuwa "kursora".
-	/** Jeli nie, nie zmienia Out i zwraca false. Oznacza to koniec strumienia. */
-	bool PeekChar(char *Out) { if (m_BufBeg == m_BufEnd) { if (!EnsureNewChars()) return false; } *Out = m_Buf[m_BufBeg]; return true; }
-	/// Jeli mona odczyta nastpny znak, podglda go zwracajc. Nie przesuwa "kursora".
-	/** Jeli nie, rzuca wyjtek. */
-	char MustPeekChar() { if (m_BufBeg == m_BufEnd) { if (!EnsureNewChars()) _ThrowBufEndError(__TFILE__, __LINE__); } return m_Buf[m_BufBeg]; }
-	/// Wczytuje co najwyej MaxLength znakw do podanego stringa.
-	/** StringStream jest czyszczony - nie musi by pusty ani zaalokowany. (???)
-	\return Zwraca liczb odczytanych znakw. Mniej ni dano oznacza koniec strumienia. */
-	size_t ReadString(string *Out, size_t MaxLength);
-	/// Wczytuje Length znakw do podanego stringa.
-	/** StringStream jest czyszczony - nie musi by pusty ani zaalokowany. (???)
-	Jeli nie uda si odczyta wszystkich Length znakw, rzuca wyjtek. */
-	void MustReadString(string *Out, size_t Length);
-	/// Wczytuje co najwyej MaxLength znakw pod podany wskanik.
-	/** \param[out] Out musi by tablic zaalokowan do dugoci co najmniej MaxLength.
-	\return Zwraca liczb odczytanych znakw. Mniej ni dano oznacza koniec strumienia. */
-	size_t ReadString(char *Out, size_t MaxLength);
-	/// Wczytuje Length znakw pod podany wskanik.
-	/** Jeli nie uda si odczyta wszystkich Length znakw, rzuca wyjtek.
-	\param[out] Out musi by tablic zaalokowan do dugoci co najmniej Length. */
-	void MustReadString(char *Out, size_t Length);
-	/// Wczytuje co najwyej MaxLength bajtw pod podany wskanik.
-	/** \param[out] Out musi by tablic zaalokowan do dugoci co najmniej MaxLength bajtw.
-	\return Zwraca liczb odczytanych bajtw. Mniej ni dano oznacza koniec strumienia. */
-	size_t ReadData(void *Out, size_t MaxLength);
-	/// Wczytuje Length bajtw pod podany wskanik.
-	/** Jeli nie uda si odczyta wszystkich Length bajtw, rzuca wyjtek.
-	\param[out] Out musi by tablic zaalokowan do dugoci co najmniej Length bajtw. */
-	void MustReadData(void *Out, size_t Length);
-	/// Jeli jest nastpny znak do odczytania, pomija go i zwraca true.
-	/** Jeli nie, zwraca false. Oznacza to koniec strumienia. */
-	bool SkipChar() { if (m_BufBeg == m_BufEnd) { if (!EnsureNewChars()) return false; } m_BufBeg++; return true; }
-	/// Jeli jest nastpny znak do odczytania, pomija go.
-	/** Jeli nie, rzuca wyjtek. */
-	void MustSkipChar() { if (m_BufBeg == m_BufEnd) { if (!EnsureNewChars()) _ThrowBufEndError(__TFILE__, __LINE__); } m_BufBeg++; }
-	/// Pomija co najwyej MaxLength znakw.
-	/** \return Zwraca liczb pominitych znakw. Mniej ni dano oznacza koniec strumienia. */
-	size_t Skip(size_t MaxLength);
-	/// Pomija Length znakw.
-	/** Jeli nie uda si pomin wszystkich Length znakw, rzuca wyjtek. */
-	void MustSkip(size_t Length);
-	/// Wczytuje linijk tekstu i jeli si udao, zwraca true.
-	/** Jeli nie udao si wczyta ani jednego znaku, bo to ju koniec strumienia, zwraca false.
-	Czyta znaki do napotkania koca strumienia lub koca wiersza, ktrym s <tt>"\r"</tt>, <tt>"\n"</tt> i <tt>"\r\n"</tt>.
-	Koniec wiersza przeskakuje, ale nie docza go do Out. */
-	bool ReadLine(string *Out);
-	/// Wczytuje linijk tekstu.
-	/** Jeli nie udao si wczyta ani jednego znaku, bo to ju koniec strumienia, rzuca wyjtek.
-	Czyta znaki do napotkania koca strumienia lub koca wiersza, ktrym s <tt>"\r"</tt>, <tt>"\n"</tt> i <tt>"\r\n"</tt>.
-	Koniec wiersza przeskakuje, ale nie docza go do Out. */
-	void MustReadLine(string *Out);
-};
-
-#ifdef _WIN32
-/// Nakadka przyspieszajca odczytujca ze strumienia pojedyncze znaki Unicode.
-/** Uwaga! Wersja Unicode nie posiada odczytywania surowych danych binarnych. */
-class WCharReader
-{
-private:
-	Stream *m_Stream;
-	std::vector<wchar_t> m_Buf;
-	// Miejsce, do ktrego doczytaem z bufora
-	size_t m_BufBeg;
-	// Miejsce, do ktrego bufor jest wypeniony danymi
-	size_t m_BufEnd;
-
-	// Wczytuje now porcj danych do strumienia
-	// Wywoywa tylko kiedy bufor si skoczy, tzn. m_BufBeg == m_BufEnd.
-	// Jeli skoczy si strumie i nic nie udao si wczyta, zwraca false.
-	// Jeli nie, zapewnia e w buforze bdzie co najmniej jeden znak.
-	bool EnsureNewChars();
-
-public:
-	WCharReader(Stream *a_Stream) : m_Stream(a_Stream), m_BufBeg(0), m_BufEnd(0) { m_Buf.resize(BUFFER_SIZE); }
-
-	/// Czy jestemy na kocu danych?
-	bool End() {
-		return (m_BufBeg == m_BufEnd) && m_Stream->End(); // Nic nie zostao w buforze i nic nie zostao w strumieniu.
-	}
-	/// Jeli mona odczyta nastpny znak, wczytuje go i zwraca true.
-	/** Jeli nie, nie zmienia Out i zwraca false. Oznacza to koniec strumienia. */
-	bool ReadChar(wchar_t *Out) { if (m_BufBeg == m_BufEnd) { if (!EnsureNewChars()) return false; } *Out = m_Buf[m_BufBeg++]; return true; }
-	/// Jeli mona odczyta nastpny znak, wczytuje go.
-	/** Jeli nie, rzuca wyjtek. */
-	wchar_t MustReadChar() { if (m_BufBeg == m_BufEnd) { if (!EnsureNewChars()) _ThrowBufEndError(__TFILE__, __LINE__); } return m_Buf[m_BufBeg++]; }
-	/// Jeli mona odczyta nastpny znak, podglda go zwracajc przez Out i zwraca true. Nie przesuwa "kursora".
-	/** Jeli nie, nie zmienia Out i zwraca false. Oznacza to koniec strumienia. */
-	bool PeekChar(wchar_t *Out) { if (m_BufBeg == m_BufEnd) { if (!EnsureNewChars()) return false; } *Out = m_Buf[m_BufBeg]; return true; }
-	/// Jeli mona odczyta nastpny znak, podglda go zwracajc. Nie przesuwa "kursora".
-	/** Jeli nie, rzuca wyjtek. */
-	wchar_t MustPeekChar() { if (m_BufBeg == m_BufEnd) { if (!EnsureNewChars()) _ThrowBufEndError(__TFILE__, __LINE__); } return m_Buf[m_BufBeg]; }
-	/// Wczytuje co najwyej MaxLength znakw do podanego stringa.
-	/** StringStream jest czyszczony - nie musi by pusty ani zaalokowany. (???)
-	\return Zwraca liczb odczytanych znakw. Mniej ni dano oznacza koniec strumienia. */
-	size_t ReadString(wstring *Out, size_t MaxLength);
-	/// Wczytuje Length znakw do podanego stringa.
-	/** StringStream jest czyszczony - nie musi by pusty ani zaalokowany. (???)
-	Jeli nie uda si odczyta wszystkich Length znakw, rzuca wyjtek. */
-	void MustReadString(wstring *Out, size_t Length);
-	/// Wczytuje co najwyej MaxLength znakw pod podany wskanik.
-	/** \param[out] Out musi by tablic zaalokowan do dugoci co najmniej MaxLength.
-	\return Zwraca liczb odczytanych znakw. Mniej ni dano oznacza koniec strumienia. */
-	size_t ReadString(wchar_t *Out, size_t MaxLength);
-	/// Wczytuje Length znakw pod podany wskanik.
-	/** Jeli nie uda si odczyta wszystkich Length znakw, rzuca wyjtek.
-	\param[out] Out musi by tablic zaalokowan do dugoci co najmniej Length. */
-	void MustReadString(wchar_t *Out, size_t Length);
-	/// Jeli jest nastpny znak do odczytania, pomija go i zwraca true.
-	/** Jeli nie, zwraca false. Oznacza to koniec strumienia. */
-	bool SkipChar() { if (m_BufBeg == m_BufEnd) { if (!EnsureNewChars()) return false; } m_BufBeg++; return true; }
-	/// Jeli jest nastpny znak do odczytania, pomija go.
-	/** Jeli nie, rzuca wyjtek. */
-	void MustSkipChar() { if (m_BufBeg == m_BufEnd) { if (!EnsureNewChars()) _ThrowBufEndError(__TFILE__, __LINE__); } m_BufBeg++; }
-	/// Pomija co najwyej MaxLength znakw.
-	/** \return Zwraca liczb pominitych znakw. Mniej ni dano oznacza koniec strumienia. */
-	size_t Skip(size_t MaxLength);
-	/// Pomija Length znakw.
-	/** Jeli nie uda si pomin wszystkich Length znakw, rzuca wyjtek. */
-	void MustSkip(size_t Length);
-	/// Wczytuje linijk tekstu i jeli si udao, zwraca true.
-	/** Jeli nie udao si wczyta ani jednego znaku, bo to ju koniec strumienia, zwraca false.
-	Czyta znaki do napotkania koca strumienia lub koca wiersza, ktrym s <tt>"\r"</tt>, <tt>"\n"</tt> i <tt>"\r\n"</tt>.
-	Koniec wiersza przeskakuje, ale nie docza go do Out. */
-	bool ReadLine(wstring *Out);
-	/// Wczytuje linijk tekstu.
-	/** Jeli nie udao si wczyta ani jednego znaku, bo to ju koniec strumienia, rzuca wyjtek.
-	Czyta znaki do napotkania koca strumienia lub koca wiersza, ktrym s <tt>"\r"</tt>, <tt>"\n"</tt> i <tt>"\r\n"</tt>.
-	Koniec wiersza przeskakuje, ale nie docza go do Out. */
-	void MustReadLine(wstring *Out);
-};
-#endif
-
-#ifdef _UNICODE
-	#define TCharWriter WCharWriter
-	#define TCharReader WCharReader
-#else
-	#define TCharWriter CharWriter
-	#define TCharReader CharReader
-#endif
-
-/// Strumie pamici statycznej
-/** Strumie ma sta dugo i nie moe by rozszerzany - ani automatycznie, ani rcznie. */
-class MemoryStream : public SeekableStream
-{
-private:
-	char *m_Data;
-	size_t m_Size;
-	ptrdiff_t m_Pos;
-	bool m_InternalAlloc;
-
-public:
-	/** \param Data Podaj NULL, aby strumie sam zaalkowa, a w destruktorze zwolni pami.
-	Podaj wskanik, jeli ma korzysta z twojego obszaru pamici.
-	*/
-	MemoryStream(size_t Size, void *Data = 0);
-	virtual ~MemoryStream();
-
-	virtual void Write(const void *Data, size_t Size);
-	virtual size_t Read(void *Data, size_t Size);
-	virtual void MustRead(void *Data, size_t Size);
-
-	virtual uint64 GetSize();
-	virtual int64 GetPos();
-	virtual void SetPos(int64 pos);
-	virtual void Rewind();
-
-	char *Data() { return m_Data; }
-};
-
-/// Strumie pamici, ale dynamicznej.
-/** Strumie mona rozszerza i sam te si rozszerza. */
-class VectorStream : public SeekableStream
-{
-private:
-	char *m_Data;
-	size_t m_Size;
-	size_t m_Capacity;
-	ptrdiff_t m_Pos;
-
-	// Zmienia capacity, a tym samym przealokowuje pami.
-	// O niczym sama nie decyduje ani niczego nie sprawdza.
-	void Reserve(size_t NewCapacity);
-
-public:
-	VectorStream();
-	virtual ~VectorStream();
-
-	virtual void Write(const void *Data, size_t Size);
-	virtual size_t Read(void *Data, size_t Size);
-	virtual void MustRead(void *Data, size_t Size);
-	virtual uint64 GetSize() { return m_Size; }
-	virtual int64 GetPos() { return m_Pos; }
-	virtual void SetPos(int64 pos) { m_Pos = (ptrdiff_t)pos; }
-	virtual void Rewind() { m_Pos = 0; }
-	virtual void SetSize(uint64 Size);
-
-	size_t GetCapacity() { return m_Capacity; }
-	void SetCapacity(size_t Capacity);
-	/** Nie musi pozosta aktualny po wywoaniach metod tej klasy!
-	(moe zosta przealokowany) */
-	char *Data() { return m_Data; }
-};
-
-/// Strumie oparty na acuchu std::string
-/** Potrafi si rozszerza. */
-class StringStream : public SeekableStream
-{
-private:
-	std::string *m_Data;
-	ptrdiff_t m_Pos;
-	bool m_InternalAlloc;
-
-public:
-	/** \param Data Podaj NULL, aby strumie sam zaalokowa, a w destruktorze zwolni acuch.
-	Podaj wskanik, jeli ma korzysta z twojego obszaru pamici. */
-	StringStream(string *Data = 0);
-	virtual ~StringStream();
-
-	virtual void Write(const void *Data, size_t Size);
-	virtual size_t Read(void *Data, size_t Size);
-	virtual void MustRead(void *Data, size_t Size);
-	virtual uint64 GetSize() { return m_Data->length(); }
-	virtual int64 GetPos() { return m_Pos; }
-	virtual void SetPos(int64 pos) { m_Pos = (ptrdiff_t)pos; }
-	virtual void Rewind() { m_Pos = 0; }
-	virtual void SetSize(uint64 Size);
-	virtual void Clear() { m_Data->clear(); }
-
-	size_t GetCapacity() { return m_Data->capacity(); }
-	void SetCapacity(size_t Capacity) { m_Data->reserve(Capacity); }
-	string *Data() { return m_Data; }
-};
-
-/// Abstrakcyjna klasa bazowa nakadek na strumienie
-class OverlayStream : public Stream
-{
-private:
-	Stream *m_Stream;
-
-public:
-	OverlayStream(Stream *a_Stream) : m_Stream(a_Stream) { }
-
-	Stream * GetStream() { return m_Stream; }
-
-	// ======== Implementacja Stream ========
-	virtual bool End() { return m_Stream->End(); }
-	virtual void Flush() { m_Stream->Flush(); }
-};
-
-/// Nakadka na strumie zliczajca ilo zapisanych i odczytanych bajtw
-class CounterOverlayStream : public OverlayStream
-{
-private:
-	uint64 m_WriteCounter;
-	uint64 m_ReadCounter;
-
-public:
-	CounterOverlayStream(Stream *a_Stream);
-
-	// ====== Implementacja Stream ======
-	virtual void Write(const void *Data, size_t Size);
-	virtual size_t Read(void *Data, size_t Size);
-	virtual void MustRead(void *Data, size_t Size);
-    virtual void Flush() { GetStream()->Flush(); }
-
-	uint64 GetWriteCounter() { return m_WriteCounter; }
-	uint64 GetReadCounter() { return m_ReadCounter; }
-	void ResetWriteCounter() { m_WriteCounter = 0; }
-	void ResetReadCounter() { m_ReadCounter = 0; }
-};
-
-/// Nakadka na strumie ograniczajca liczb odczytywanych i zapisywanych bajtw.
-/** Jesli przekroczy limit podczas zapisywania, zapisuje ile si da i rzuca bd zapisu.
-Jeli przekroczy limit podczas odczytywania zachowuje si tak, jakby strumie osign koniec. */
-class LimitOverlayStream : public OverlayStream
-{
-private:
-	// Przechowuj aktualny limit, jaki pozosta.
-	// S zmniejszane przez funkcje odczytujce i zapisujce.
-	uint64 m_WriteLimit;
-	uint64 m_ReadLimit;
-
-public:
-	LimitOverlayStream(Stream *a_Stream, uint64 WriteLimit, uint64 ReadLimit);
-
-	// ====== Implementacja Stream ======
-	virtual void Write(const void *Data, size_t Size);
-	virtual size_t Read(void *Data, size_t Size);
-	virtual void Flush();
-
-	/// Ustawia nowy limit
-	void SetWriteLimit(uint64 WriteLimit);
-	/// Ustawia nowy limit
-	void SetReadLimit(uint64 ReadLimit);
-};
-
-class BufferingStream : public OverlayStream
-{
-public:
-	BufferingStream(Stream *stream, size_t readBufSize, size_t writeBufSize);
-	~BufferingStream();
-
-	// ====== Implementacja Stream ======
-	virtual void Write(const void *Data, size_t Size);
-	virtual void Flush();
-	virtual size_t Read(void *Data, size_t MaxLength);
-	virtual bool End();
-	virtual size_t Skip(size_t MaxLength);
-
-	/// Writes single char/byte
-	void WriteChar(char ch) { if (m_WriteBufIndex == m_WriteBufSize) DoFlush(); m_WriteBuf[m_WriteBufIndex++] = ch; }
-
-private:
-	size_t m_ReadBufSize, m_WriteBufSize;
-	std::vector<char> m_ReadBuf, m_WriteBuf;
-	size_t m_ReadBufBeg, m_ReadBufEnd, m_WriteBufIndex;
-
-	void DoFlush();
-	// Wczytuje now porcj danych do bufora
-	// Wywoywa tylko kiedy bufor si skoczy, tzn. m_ReadBufBeg == m_ReadBufEnd.
-	// Jeli skoczy si strumie i nic nie udao si wczyta, zwraca false.
-	// Jeli nie, zapewnia e w buforze bdzie co najmniej jeden znak.
-	bool EnsureNewChars();
-};
-
-/// Zapisuje zapisywane dane do wielu podczonych do niego strumieni na raz.
-class MultiWriterStream : public Stream
-{
-private:
-	std::vector<Stream*> m_Streams;
-
-public:
-	MultiWriterStream() { }
-	MultiWriterStream(Stream *a_Streams[], size_t StreamCount);
-
-	/// Dodaje strumie do listy.
-	void AddStream(Stream *a_Stream) { m_Streams.push_back(a_Stream); }
-	/// Usuwa strumie z listy. Jeli takiego nie znajdzie, nic nie robi.
-	void RemoveStream(Stream *a_Stream);
-	/// Usuwa wszystkie strumienie z listy.
-	void ClearStreams() { m_Streams.clear(); }
-	size_t GetStreamCount() { return m_Streams.size(); }
-
-	// ======== Implementacja Stream ========
-	virtual void Write(const void *Data, size_t Size);
-	virtual void Flush();
-};
-
-/// Klasa obliczajca hash 32-bitowy z kolejno podawanych blokw danych
-/** Algorytm: Jenkins One-at-a-time hash, http://www.burtleburtle.net/bob/hash/doobs.html
-Strumie tylko do zapisu.
-Prawidowe uycie: Hash_Calc::Write(), Hash_Calc::Write() (lub inne funkcje zapisujce), ..., Hash_Calc::Finish().
-Po wywoaniu Hash_Calc::Finish() nie mona dalej zapisywa danych!
-Hash_Calc::Reset() - rozpoczyna liczenie sumy od nowa. */
-class Hash_Calc : public Stream
-{
-private:
-	uint32 m_Hash;
-
-public:
-	Hash_Calc() : m_Hash(0) { }
-
-	// ======== Implementacja Stream ========
-	virtual void Write(const void *Data, size_t Size);
-
-	/// Koczy obliczenia i zwraca policzon sum
-	uint32 Finish();
-	/// Rozpoczyna liczenie nowej sumy
-	void Reset() { m_Hash = 0; }
-
-	// ======== Statyczne ========
-	/// Po prostu oblicza sum kontroln z podanych danych
-	static uint32 Calc(const void *Buf, size_t BufLen);
-	static uint32 Calc(const string &s);
-#ifdef _WIN32
-	static uint32 Calc(const wstring &s);
-#endif
-};
-
-/// Klasa obliczajca sum CRC32 z kolejno podawanych blokw danych
-/** Strumie tylko do zapisu.
-CRC32_Calc::GetResult() - wyliczon dotychczas sum mona otrzymywa w kadej chwili, a potem dalej dodawa nowe dane.
-CRC32_Calc::Reset() - rozpoczyna liczenie nowej sumy kontrolnej. */
-class CRC32_Calc : public Stream
-{
-private:
-	uint m_CRC;
-
-public:
-	CRC32_Calc() { m_CRC = 0xFFFFFFFFu; }
-
-	// ======== Implementacja Stream ========
-	virtual void Write(const void *Data, size_t Size);
-
-	/// Zwraca policzon dotychczas sum
-	uint GetResult() { return ~m_CRC; }
-	/// Rozpoczyna liczenie nowej sumy
-	void Reset() { m_CRC = 0xFFFFFFFFu; }
-
-	// ======== Statyczne ========
-	/// Po prostu oblicza sum kontroln z podanych danych
-	static uint Calc(const void *Data, size_t DataLength);
-};
-
-/// Suma MD5
-/** Suma ma 128 bitw - 16 bajtw. Jest typu uint8[16]. */
-struct MD5_SUM
-{
-	uint8 Data[16];
-
-	uint8 & operator [] (size_t i) { return Data[i]; }
-	uint8 operator [] (size_t i) const { return Data[i]; }
-
-	bool operator == (const MD5_SUM &s) const
-	{
-		return
-			Data[ 0] == s.Data[ 0] && Data[ 1] == s.Data[ 1] && Data[ 2] == s.Data[ 2] && Data[ 3] == s.Data[ 3] &&
-			Data[ 4] == s.Data[ 4] && Data[ 5] == s.Data[ 5] && Data[ 6] == s.Data[ 6] && Data[ 7] == s.Data[ 7] &&
-			Data[ 8] == s.Data[ 8] && Data[ 9] == s.Data[ 9] && Data[10] == s.Data[10] && Data[11] == s.Data[11] &&
-			Data[12] == s.Data[12] && Data[13] == s.Data[13] && Data[14] == s.Data[14] && Data[15] == s.Data[15];
-	}
-	bool operator != (const MD5_SUM &s) const
-	{
-		return
-			Data[ 0] != s.Data[ 0] || Data[ 1] != s.Data[ 1] || Data[ 2] != s.Data[ 2] || Data[ 3] != s.Data[ 3] ||
-			Data[ 4] != s.Data[ 4] || Data[ 5] != s.Data[ 5] || Data[ 6] != s.Data[ 6] || Data[ 7] != s.Data[ 7] ||
-			Data[ 8] != s.Data[ 8] || Data[ 9] != s.Data[ 9] || Data[10] != s.Data[10] || Data[11] != s.Data[11] ||
-			Data[12] != s.Data[12] || Data[13] != s.Data[13] || Data[14] != s.Data[14] || Data[15] != s.Data[15];
-	}
-	bool operator < (const MD5_SUM &s) const;
-	bool operator > (const MD5_SUM &s) const;
-	bool operator <= (const MD5_SUM &s) const;
-	bool operator >= (const MD5_SUM &s) const;
-};
-
-void MD5ToStr(tstring *Out, const MD5_SUM &MD5);
-bool StrToMD5(MD5_SUM *Out, const tstring &s);
-
-/// Klasa obliczajca sum MD5 z kolejno podawanych blokw danych
-/** Strumie tylko do zapisu.
-Prawidowe uycie: MD5_Calc::Write(), MD5_Calc::Write() (lub inne funkcje zapisujce), ..., MD5_Calc::Finish().
-Po wywoaniu Finish nie mona dalej zapisywa danych!
-MD5_Calc::Reset() - rozpoczyna liczenie sumy od nowa. */
-class MD5_Calc : public Stream
-{
-private:
-	uint32 total[2];
-	uint32 state[4];
-	uint8 buffer[64];
-
-	void Process(uint8 data[64]);
-
-public:
-	MD5_Calc();
-
-	// ======== Implementacja Stream ========
-	virtual void Write(const void *Data, size_t Size);
-
-	/// Koczy obliczenia i zwraca policzon sum
-	void Finish(MD5_SUM *Out);
-	/// Rozpoczyna liczenie nowej sumy
-	void Reset();
-
-	// ======== Statyczne ========
-	/// Po prostu oblicza sum kontroln z podanych danych
-	static void Calc(MD5_SUM *Out, const void *Buf, size_t BufLen);
-};
-
-/// Koduje lub dekoduje zapisywane/odczytywane bajty XOR podany bajt lub cig bajtw.
-/** Mapuje bezporednio bajty na bajty strumienia do ktrego jest podczony,
-nic nie buforuje, wic mona operowa te na strumieniu Stream. */
-class XorCoder : public OverlayStream
-{
-private:
-	std::vector<char> m_Buf;
-	std::vector<char> m_Key;
-	size_t m_EncodeKeyIndex;
-	size_t m_DecodeKeyIndex;
-
-public:
-	XorCoder(Stream *a_Stream, char KeyByte);
-	XorCoder(Stream *a_Stream, const void *KeyData, size_t KeyLength);
-	XorCoder(Stream *a_Stream, const string &Key);
-
-	// ======== Implementacja Stream ========
-	virtual void Write(const void *Data, size_t Size);
-	virtual size_t Read(void *Data, size_t Size);
-
-	/// Resetuje liczniki tak eby kodowanie i dekodowanie odbywao si od pocztku klucza
-	void Reset() { m_EncodeKeyIndex = m_DecodeKeyIndex = 0; }
-
-	// ======== Statyczne ========
-	/// Po prostu przetwarza podane dane
-	static void Code(void *Out, const void *Data, size_t DataLength, const void *Key, size_t KeyLength);
-	/// Po prostu przetwarza podane dane
-	static void Code(string *Out, const string &Data, const string &Key);
-#ifdef _WIN32
-	/// Po prostu przetwarza podane dane
-	static void Code(wstring *Out, const wstring &Data, const wstring &Key);
-#endif
-};
-
-/// Koduje strumie binarnych danych wejciowych na cig zoony ze znakw '0' i '1' (po 8 na kady bajt).
-class BinEncoder : public OverlayStream
-{
-private:
-	CharWriter m_CharWriter;
-
-public:
-	BinEncoder(Stream *a_Stream) : OverlayStream(a_Stream), m_CharWriter(a_Stream) { }
-
-	// ======== Implementacja Stream ========
-	virtual void Write(const void *Data, size_t Size);
-	virtual void Flush() { m_CharWriter.Flush(); OverlayStream::Flush(); }
-
-	// ======== Statyczne ========
-	/// Po prostu koduje podane dane
-	/*** \param[out] Out Bufor wyjciowy Out musi mie zaalokowane przynajmniej DataLength * 8 bajtw. */
-	static void Encode(char *Out, const void *Data, size_t DataLength);
-	/// Po prostu koduje podane dane
-	/** \param[out] Out acuch wyjciowy Out nie musi mie adnego konkretnego rozmiaru -
-	zostaje wyczyszczony i wypeniony od nowa. */
-	static void Encode(string *Out, const void *Data, size_t DataLength);
-};
-
-/// Dekoduje cig znakw wejciowych zapisanych binarnie (znakami '0' i '1') na dane binarne.
-class BinDecoder : public OverlayStream
-{
-private:
-	CharReader m_CharReader;
-	DECODE_TOLERANCE m_Tolerance;
-
-public:
-	BinDecoder(Stream *a_Stream, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
-
-	DECODE_TOLERANCE GetTolerance() { return m_Tolerance; }
-
-	// ======== Implementacja Stream ========
-	virtual size_t Read(void *Out, size_t Size);
-	virtual bool End() { return m_CharReader.End(); }
-
-	// ======== Statyczne ========
-	/// Znajduje dugo zakodowanych danych i zwraca true.
-	/** Jeli nie udao si ustali dugoci, zwraca false. */
-	static bool DecodeLength(size_t *OutLength, const string &s, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
-	static bool DecodeLength(size_t *OutLength, const char *s, size_t s_Length, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
-	/// Dekoduje dane binarne. Zwraca liczb zdekodowanych bajtw.
-	/** Jeli nie udao si zdekodowa (jaki bd), zwraca SIZE_MAX.
-	\param[out] OutData musi by tablic zaalokowan przynajmniej na rozmiar ustalony wywoaniem DecodeLength()
-	lub jeli nie chcesz wywoywa DecodeLength(), na dugo rwn dugoci danych wejciowych / 8. */
-	static size_t Decode(void *OutData, const string &s, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
-	static size_t Decode(void *OutData, const char *s, size_t s_Length, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
-};
-
-/// Koduje strumie binarnych danych wejciowych na zapis szesnastkowy (po 2 znaki na kady bajt).
-class HexEncoder : public OverlayStream
-{
-private:
-	CharWriter m_CharWriter;
-	bool m_UpperCase;
-
-public:
-	HexEncoder(Stream *a_Stream, bool UpperCase = true) : OverlayStream(a_Stream), m_CharWriter(a_Stream), m_UpperCase(UpperCase) { }
-
-	// ======== Implementacja Stream ========
-	virtual void Write(const void *Data, size_t Size);
-	virtual void Flush() { m_CharWriter.Flush(); OverlayStream::Flush(); }
-
-	// ======== Statyczne ========
-	/// Po prostu koduje podane dane
-	/** \param[out] Out Bufor wyjciowy Out musi mie zaalokowane przynajmniej DataLength * 2 znakw. */
-	static void Encode(char *Out, const void *Data, size_t DataLength, bool UpperCase = true);
-	/// Po prostu koduje podane dane
-	/** \param[out] Out acuch wyjciowy Out nie musi mie adnego konkretnego rozmiaru -
-	zostaje wyczyszczony i wypeniony od nowa. */
-	static void Encode(string *Out, const void *Data, size_t DataLength, bool UpperCase = true);
-#ifdef _WIN32
-	static void Encode(wchar_t *Out, const void *Data, size_t DataLength, bool UpperCase = true);
-	static void Encode(wstring *Out, const void *Data, size_t DataLength, bool UpperCase = true);
-#endif
-};
-
-/// Dekoduje cig znakw wejciowych zapisanych szesnastkowo na dane binarne.
-/** Akceptuje zarwno mae, jak i due litery. */
-class HexDecoder : public OverlayStream
-{
-private:
-	CharReader m_CharReader;
-	DECODE_TOLERANCE m_Tolerance;
-
-public:
-	HexDecoder(Stream *a_Stream, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
-
-	DECODE_TOLERANCE GetTolerance() { return m_Tolerance; }
-
-	// ======== Implementacja Stream ========
-	virtual size_t Read(void *Out, size_t Size);
-	virtual bool End() { return m_CharReader.End(); }
-
-	// ======== Statyczne ========
-	/// Znajduje dugo zakodowanych danych i zwraca true.
-	/** Jeli nie udao si ustali dugoci, zwraca false. */
-	static bool DecodeLength(size_t *OutLength, const string &s, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
-	static bool DecodeLength(size_t *OutLength, const char *s, size_t s_Length, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
-	/// Dekoduje dane binarne. Zwraca liczb zdekodowanych bajtw.
-	/** Jeli nie udao si zdekodowa (jaki bd), zwraca SIZE_MAX.
-	\param[out] OutData musi by tablic zaalokowan przynajmniej na rozmiar ustalony wywoaniem DecodeLength
-	lub jeli nie chcesz wywoywa DecodeLength, na dugo rwn dugoci danych wejciowych / 2. */
-	static size_t Decode(void *OutData, const string &s, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
-	/// Dekoduje dane binarne. Zwraca liczb zdekodowanych bajtw.
-	static size_t Decode(void *OutData, const char *s, size_t s_Length, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
-#ifdef _WIN32
-	static size_t Decode(void *OutData, const wstring &s, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
-	static size_t Decode(void *OutData, const wchar_t *s, size_t s_Length, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
-#endif
-};
-
-/// Koduje strumie binarnych danych wejciowych na cig znakw base64.
-/**
-- Zgodny z RFC 4648 "The Base16, Base32, and Base64 Data Encodings"
-- Prawidowe dane wyjciowe powstaj dopiero po zakoczeniu zapisywania, ktre nastpuje w destruktorze.
-  Jeli chcesz zakoczy wczeniej, wywoaj Base64Encoder::Finish(), ale potem nie mona ju nic dopisywa.
-*/
-class Base64Encoder : public OverlayStream
-{
-private:
-	CharWriter m_CharWriter;
-	bool m_Finished; // Czy dane zakoczone
-	uint8 m_Buf[2];
-	size_t m_BufIndex;
-
-	void DoFinish();
-
-public:
-	Base64Encoder(Stream *a_Stream) : OverlayStream(a_Stream), m_CharWriter(a_Stream), m_Finished(false), m_BufIndex(0) { }
-	~Base64Encoder();
-
-	void Finish() { if (!m_Finished) { DoFinish(); m_Finished = true; } }
-
-	// ======== Implementacja Stream ========
-	virtual void Write(const void *Data, size_t Size);
-	virtual void Flush() { m_CharWriter.Flush(); OverlayStream::Flush(); }
-
-	// ======== Statyczne ========
-	/// Oblicza rozmiar bufora na zakodowane dane
-	static size_t EncodeLength(size_t DataLength);
-	/// Po prostu koduje podane dane
-	/** \param[out] Out Bufor wyjciowy Out musi mie zaalokowane przynajmniej tyle bajtw ile wyliczyo EncodeLength.
-	\return Zwraca liczb znakw zapisanych do Out. */
-	static size_t Encode(char *Out, const void *Data, size_t DataLength);
-	/// Po prostu koduje podane dane
-	/** \param[out] Out acuch wyjciowy Out nie musi mie adnego konkretnego rozmiaru -
-	zostaje wyczyszczony i wypeniony od nowa. */
-	static size_t Encode(string *Out, const void *Data, size_t DataLength);
-};
-
-/// Dekoduje cig znakw wejciowych zapisanych w standardzie base64 na dane binarne.
-/*
-- Po napotkaniu kocwki zawierajcej znaki '=' funkcje nie parsuj ju dalej,
-  ale to tylko optymalizacja i nie naley na tym polega.
-- Sposb dziaania strumienia - na raz wczytywane s po 4 znaki i zamieniane na
-  maksymalnie 3 bajty.
-*/
-class Base64Decoder : public OverlayStream
-{
-private:
-	CharReader m_CharReader;
-	DECODE_TOLERANCE m_Tolerance;
-	// Bajty s w kolejnoci: [2][1][0]. Jeli jest mniej, to [1][0][-] albo [0][-][-].
-	uint8 m_Buf[3];
-	// Liczba zdekodowanych bajtw w buforze
-	size_t m_BufLength;
-	// True, jeli sparsowano kocwk z '='
-	bool m_Finished;
-
-	// Czyta 4 znaki ze strumienia podczonego (0 albo 4, inaczej bd) i wypenia m_Buf maksymalnie 3 zdekodowanymi bajtami.
-	// Ustawia m_BufLength i jeli trzeba, to m_Finished.
-	bool ReadNextBuf();
-
-	bool GetNextByte(uint8 *OutByte) { if (m_BufLength == 0) { if (!ReadNextBuf()) return false; } *OutByte = m_Buf[--m_BufLength]; return true; }
-
-public:
-	Base64Decoder(Stream *a_Stream, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
-
-	DECODE_TOLERANCE GetTolerance() { return m_Tolerance; }
-
-	// ======== Implementacja Stream ========
-	virtual size_t Read(void *Out, size_t Size);
-	virtual bool End();
-
-	// ======== Statyczne ========
-	/// Znajduje dugo zakodowanych danych i zwraca true.
-	/** Jeli nie udao si ustali dugoci, zwraca false. */
-	static bool DecodeLength(size_t *OutLength, const string &s, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
-	static bool DecodeLength(size_t *OutLength, const char *s, size_t s_Length, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
-	/// Dekoduje dane binarne. Zwraca liczb zdekodowanych bajtw.
-	/** Jeli nie udao si zdekodowa (jaki bd), zwraca SIZE_MAX.
-	\param[out] OutData musi by tablic zaalokowan przynajmniej na rozmiar ustalony wywoaniem DecodeLength(). */
-	static size_t Decode(void *OutData, const string &s, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
-	static size_t Decode(void *OutData, const char *s, size_t s_Length, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
-};
-
-/// Bufor koowy
-/*
-Dziaa szybko (na tyle na ile szybko moe dziaa strumie, ze
-swoimi metodami wirtualnymi itd.), ale ma z gry ograniczon pojemno. W
-przypadku przepenienia przy zapisie rzuca wyjtek.
-*/
-class RingBuffer : public Stream
-{
-public:
-	RingBuffer(size_t Capacity);
-	virtual ~RingBuffer();
-
-	/// Zwraca liczb bajtw w buforze
-	uint64 GetSize() { return m_Size; }
-	/// Zwraca pojemno bufora
-	size_t GetCapacity() { return m_Capacity; }
-	/// Zwraca true, jeli bufor jest pusty
-	bool IsEmpty() { return GetSize() == 0; }
-	/// Zwraca true, jeli bufor jest peny
-	bool IsFull() { return GetSize() == GetCapacity(); }
-
-	// ======== Implementacja Stream ========
-	virtual void Write(const void *Data, size_t Size);
-	virtual size_t Read(void *Out, size_t MaxLength);
-	virtual void MustRead(void *Out, size_t Length);
-	virtual bool End();
-	virtual size_t Skip(size_t MaxLength);
-
-private:
-	size_t m_Capacity;
-	size_t m_Size;
-	std::vector<char> m_Buf;
-	size_t m_BegIndex;
-	size_t m_EndIndex;
-};
-
-
-/// Kopiuje dane z jednego strumienia do drugiego - co najwyej MaxLength bajtw.
-/** \return Zwraca liczb przekopiowanych danych. */
-inline size_t Copy(Stream *Dst, Stream *Src, size_t MaxLength) { return Dst->CopyFrom(Src, MaxLength); }
-/// Kopiuje dane z jednego strumienia do drugiego - dokadnie Length bajtw.
-/** Jeli si nie uda przekopiowa tylu bajtw, rzuca bd. */
-inline void MustCopy(Stream *Dst, Stream *Src, size_t Length) { return Dst->MustCopyFrom(Src, Length); }
-/// Kopiuje dane z jednego strumienia do drugiego a do koca tego rdowego
-inline size_t CopyToEnd(Stream *Dst, Stream *Src) { return Dst->CopyFromToEnd(Src); }
-
-//@}
-// code_stream
-
-} // namespace common
-
-/** \addtogroup code_sthtostr */
-//@{
-
-template <>
-struct SthToStr_obj<common::MD5_SUM>
-{
-	void operator () (tstring *Str, const common::MD5_SUM &Sth)
-	{
-		common::MD5ToStr(Str, Sth);
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-template <>
-struct StrToSth_obj<common::MD5_SUM>
-{
-	bool operator () (common::MD5_SUM *Sth, const tstring &Str)
-	{
-		return common::StrToMD5(Sth, Str);
-	}
-	static inline bool IsSupported() { return true; }
-};
-
-//@}
-// code_sthtostr
-
-#endif
+/** \file
+\brief Stream class hierarchy
+\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
+
+Part of CommonLib library. \n
+Encoding UTF-8, end of line CR+LF \n
+License: GNU LGPL. \n
+Documentation: \ref Module_Stream \n
+Module components: \ref code_stream
+*/
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+#pragma once
+#endif
+#ifndef COMMON_STREAM_H_
+#define COMMON_STREAM_H_
+
+namespace common
+{
+
+/** \addtogroup code_stream Stream Module
+Dokumentacja: \ref Module_Stream \n
+Nagłówek: Stream.hpp */
+//@{
+
+extern const size_t BUFFER_SIZE;
+
+/// \internal
+void _ThrowBufEndError(const tchar *File, int Line);
+
+/// Tolerancja błędów podczas dekodowania danych zapisanych tekstowo
+enum DECODE_TOLERANCE
+{
+	DECODE_TOLERANCE_NONE,       ///< Żadne dodatkowe znaki nie będą tolerowane
+	DECODE_TOLERANCE_WHITESPACE, ///< Białe znaki będą ignorowane i nie spowodują błędu
+	DECODE_TOLERANCE_ALL,        ///< Wszelkie nieznane znaki będą ignorowane i nie spowodują błądu
+};
+
+
+/// Abstrakcyjna klasa bazowa strumieni danych binarnych
+class Stream
+{
+public:
+	virtual ~Stream() { }
+
+	/** \name Zapisywanie */
+	//@{
+
+	/// Zapisuje dane
+	/** (W oryginale: zgłasza błąd) */
+	virtual void Write(const void *Data, size_t Size);
+	virtual void Flush() { }
+
+	/// Zapisuje dane, sama odczytuje rozmiar przekazanej zmiennej
+	template <typename T>
+	void WriteEx(const T &x) { return Write(&x, sizeof(x)); }
+	/// Zapisuje długość na 1B i łańcuch
+	/** Jeśli łańcuch za długi - błąd. */
+	void WriteString1(const string &s);
+	void WriteString1(const char *s);
+	void WriteString1(const char *s, size_t NumChars);
+#ifdef _WIN32
+	void WriteString1(const wstring &s);
+	void WriteString1(const wchar_t *s);
+	void WriteString1(const wchar_t *s, size_t NumChars);
+#endif
+	/// Zapisuje długość na 2B i łańcuch
+	/** Jeśli łańcuch za długi - błąd. */
+	void WriteString2(const string &s);
+	void WriteString2(const char *s);
+	void WriteString2(const char *s, size_t NumChars);
+#ifdef _WIN32
+	void WriteString2(const wstring &s);
+	void WriteString2(const wchar_t *s);
+	void WriteString2(const wchar_t *s, size_t NumChars);
+#endif
+	/// Zapisuje długość na 4B i łańcuch
+	void WriteString4(const string &s);
+	void WriteString4(const char *s);
+	void WriteString4(const char *s, size_t NumChars);
+#ifdef _WIN32
+	void WriteString4(const wstring &s);
+	void WriteString4(const wchar_t *s);
+	void WriteString4(const wchar_t *s, size_t NumChars);
+#endif
+	/// Zapisuje łańcuch bez długości
+	void WriteStringF(const string &s);
+#ifdef _WIN32
+	void WriteStringF(const wstring &s);
+#endif
+	/// Zapisuje wartość logiczną za pomocą jednego bajtu
+	void WriteBool(bool b);
+
+	//@}
+
+	/** \name Odczytywanie */
+	//@{
+
+	/// Odczytuje dane
+	/** Jeśli osiągnięto koniec, funkcja nie zwraca błędu, a liczba odczytanych bajtów to 0.
+	(W oryginale: zgłasza błąd)
+	\param Size Liczba bajtów do odczytania
+	\return Zwraca liczbę bajtów, jakie udało się odczytać
+	*/
+	virtual size_t Read(void *Data, size_t MaxLength);
+	/// Odczytuje tyle bajtów, ile się zażąda
+	/** Jeśli koniec pliku albo jeśli odczytano mniej, zgłasza błąd.
+	(Można ją przeładować, ale nie trzeba - ma swoją wersję oryginalną)
+	*/
+	virtual void MustRead(void *Data, size_t Length);
+	/// Tak samo jak MustRead(), ale sama odczytuje rozmiar przekazanej zmiennej
+	/** Zwraca true, jeśli osiągnięto koniec strumienia
+	(W oryginale: zgłasza błąd)
+	*/
+	virtual bool End();
+	/// Pomija co najwyżej podaną liczbę bajtów (chyba że wcześniej osiągnięto koniec).
+	/** (Można ją przeładować, ale nie trzeba - ma swoją wersję oryginalną)
+	\return Zwraca liczbę pominiętych bajtów.
+	*/
+	virtual size_t Skip(size_t MaxLength);
+
+	/// Odczytuje dane, sama odczytuje rozmiar przekazanej zmiennej
+	template <typename T>
+	void ReadEx(T *x) { MustRead(x, sizeof(*x)); }
+	/// Odczytuje łańcuch poprzedzony rozmiarem 1B
+	void ReadString1(string *s);
+	/// Odczytuje łańcuch poprzedzony rozmiarem 2B
+	void ReadString2(string *s);
+	/// Odczytuje łańcuch poprzedzony rozmiarem 4B
+	void ReadString4(string *s);
+	/// Odczytuje łańcuch bez zapisanego rozmiaru
+	void ReadStringF(string *s, size_t NumChars);
+	/// Odczytuje tyle znaków do łańcucha, ile się da do końca strumienia
+	void ReadStringToEnd(string *s);
+	/// Wersje powyższych funkcji dla Unicode
+#ifdef _WIN32
+	void ReadString1(wstring *s);
+	void ReadString2(wstring *s);
+	void ReadString4(wstring *s);
+	void ReadStringF(wstring *s, size_t NumChars);
+	void ReadStringToEnd(wstring *s);
+#endif
+	/// Odczytuje wartość logiczną za pomocą jednego bajtu
+	void ReadBool(bool *b);
+	/// Pomija koniecznie podaną liczbę bajtów.
+	/** Jeśli wcześniej osiągnięto koniec, zgłasza błąd. */
+	void MustSkip(size_t Length);
+
+	//@}
+
+	/** \name Kopiowanie */
+	//@{
+	/// Odczytuje podaną co najwyżej liczbę bajtów z podanego strumienia
+	/** \return Zwraca liczbę odczytanych bajtów */
+	size_t CopyFrom(Stream *s, size_t Size);
+	/// Odczytuje dokładnie podaną liczbę bajtów z podanego strumienia
+	/** Jeśli odczyta mniej, zgłasza błąd. */
+	void MustCopyFrom(Stream *s, size_t Size);
+	/// Odczytuje dane do końca z podanego strumienia
+	size_t CopyFromToEnd(Stream *s);
+	//@}
+};
+
+/// Abstrakcyjna klasa bazowa strumieni pozwalających na odczytywanie rozmiaru i zmianę pozycji
+class SeekableStream : public Stream
+{
+public:
+	// ======== Implementacja Stream ========
+	/** W Stream domyślnie rzuca błąd, tu w SeekableStream dostaje już wersję oryginalną. Można ją dalej nadpisać. */
+	virtual bool End();
+	/** W Stream ma wersję oryginalną, tu w SeekableStream dostaje lepszą. Można ją dalej nadpisać. */
+	virtual size_t Skip(size_t MaxLength);
+
+	/// Zwraca rozmiar
+	/** W oryginale: zgłasza błąd. */
+	virtual uint64 GetSize();
+	/// Zwraca pozycję względem początku
+	/** W oryginale: zgłasza błąd. */
+	virtual int64 GetPos();
+	/// Ustawia pozycję względem początku
+	/** W oryginale: zgłasza błąd.
+	\param pos Musi być dodatnie. */
+	virtual void SetPos(int64 pos);
+	/// Ustawia pozycję względem bieżącej
+	/** Można ją nadpisać, ale ma wersję oryginalną
+	\param pos może być dodatnie albo ujemne. */
+	virtual void SetPosFromCurrent(int64 pos);
+	/// Ustawia pozycję względem końcowej
+	/** Można ją nadpisać, ale ma wersję oryginalną.
+	Np. abu ustawić na ostatni znak, przesuń do -1. */
+	virtual void SetPosFromEnd(int64 pos);
+	/// Ustawia pozycję na początku
+	/** Można ją nadpisać, ale ma wersję oryginalną. */
+	virtual void Rewind();
+	/// Ustawia rozmiar na podany
+	/** Po tym wywołaniu pozycja kursora jest niezdefiniowana.
+	W oryginale: zgłasza błąd. */
+	virtual void SetSize(uint64 Size);
+	/// Obcina strumień od bieżącej pozycji do końca, czyli ustawia taki rozmiar jak bieżąca pozycja.
+	/** Można ją nadpisać, ale ma wersję oryginalną. */
+	virtual void Truncate();
+	/// Opróżnia strumień
+	/** Można ją nadpisać, ale ma wersję oryginalną. */
+	virtual void Clear();
+};
+
+/// Strumień pusty - nic nie robi
+/**
+Zapis po prostu udaje że zapisuje a nic nie robi.
+Odczyt udaje, że plik jest pusty.
+Przestawianie kursora, ustawianie pozycji itp. udaje się, ale nic nie robi.
+*/
+class NullStream : public SeekableStream
+{
+public:
+	virtual void Write(const void *Data, size_t Size) { }
+	virtual size_t Read(void *Data, size_t MaxLength) { return 0; }
+	virtual bool End() { return true; }
+	virtual size_t Skip(size_t MaxLength) { return 0; }
+	virtual uint64 GetSize() { return 0; }
+	virtual int64 GetPos() { return 0; }
+	virtual void SetPos(int64 pos) { }
+	virtual void SetPosFromCurrent(int64 pos) { }
+	virtual void SetPosFromEnd(int64 pos) { }
+	virtual void Rewind() { }
+	virtual void SetSize(uint64 Size) { }
+	virtual void Truncate() { }
+	virtual void Clear() { }
+};
+
+/// Nakładka przyspieszająca zapisująca do strumienia pojedyncze znaki i inne rzeczy.
+/**
+- Nie jest strumieniem.
+- Tylko zapis.
+- Jest szybka, ponieważ:
+  -# Nie ma metod wirtualnych.
+  -# Buforuje, więc nie używa za każdym razem metod wirtualnych strumienia.
+- Sama zapisuje dane pozostałe w buforze w destruktorze.
+  Jeśli chcesz to zrobić wcześniej i z kontrolą błędów, wywołaj CharWriter::Flush().
+- W trybie Debug działa nawet trochę wolniej niż zapisywanie po bajcie prosto do strumienia.
+  W trybie Release daje przyspieszenie prawie 10x względem zapisywania po bajcie prosto do strumienia.
+- Celowo nie używam w tej klasie ERR_TRY .. ERR_CATCH_FUNC, żeby było szybciej.
+*/
+class CharWriter
+{
+private:
+	Stream *m_Stream;
+	std::vector<char> m_Buf;
+	size_t m_BufIndex;
+
+	// Wykonuje Flush danych z bufora do strumienia nie sprawdzając już, czy bufor nie jest pusty.
+	// Oczywiście zeruje też BufIndex.
+	void DoFlush() { m_Stream->Write(&m_Buf[0], m_BufIndex); m_BufIndex = 0; }
+
+public:
+	CharWriter(Stream *a_Stream) : m_Stream(a_Stream), m_BufIndex(0) { m_Buf.resize(BUFFER_SIZE); }
+	~CharWriter();
+
+	/// Zapisuje pojedynczy znak
+	void WriteChar(char Ch) { if (m_BufIndex == BUFFER_SIZE) DoFlush(); m_Buf[m_BufIndex++] = Ch; }
+	/// Zapisuje po prostu znaki łańcucha, bez żadnej długości
+	void WriteString(const string &s);
+	/// Zapisuje łańcuch zakończony zerem
+	void WriteString(const char *s) { WriteString(s, strlen(s)); }
+	/// Zapisuje łańcuch podanej długości
+	void WriteString(const char *s, size_t NumChars) { WriteData(s, NumChars); }
+	/// Zapisuje surowe dane binarne
+	void WriteData(const void *Data, size_t Length);
+	/// Zapisuje dowolną informację przerobioną na postać tekstową, o ile da się przerobić
+	template <typename T> void WriteEx(const T &x) { string s; SthToStr<T>(&s, x); WriteString(s); }
+	/// Wymusza opróżnienie bufora i wysłanie pozostałych w nim danych do strumienia
+	void Flush() { if (m_BufIndex > 0) DoFlush(); }
+};
+
+#ifdef _WIN32
+/// Nakładka przyspieszająca zapisująca do strumienia pojedyncze znaki Unicode.
+/** Uwaga! Wersja Unicode nie posiada zapisywania surowych danych binarnych. */
+class WCharWriter
+{
+private:
+	Stream *m_Stream;
+	std::vector<wchar_t> m_Buf;
+	size_t m_BufIndex;
+
+	// Wykonuje Flush danych z bufora do strumienia nie sprawdzając już, czy bufor nie jest pusty.
+	// Oczywiście zeruje też BufIndex.
+	void DoFlush() { m_Stream->Write(&m_Buf[0], m_BufIndex * sizeof(wchar_t)); m_BufIndex = 0; }
+
+public:
+	WCharWriter(Stream *a_Stream) : m_Stream(a_Stream), m_BufIndex(0) { m_Buf.resize(BUFFER_SIZE); }
+	~WCharWriter();
+
+	/// Zapisuje pojedynczy znak
+	void WriteChar(wchar_t Ch) { if (m_BufIndex == BUFFER_SIZE) DoFlush(); m_Buf[m_BufIndex++] = Ch; }
+	/// Zapisuje po prostu znaki łańcucha, bez żadnej długości
+	void WriteString(const wstring &s);
+	/// Zapisuje łańcuch zakończony zerem
+	void WriteString(const wchar_t *s) { WriteString(s, wcslen(s)); }
+	/// Zapisuje łańcuch podanej długości
+	void WriteString(const wchar_t *s, size_t NumChars);
+	/// Wymusza opróżnienie bufora i wysłanie pozostałych w nim danych do strumienia
+	void Flush() { if (m_BufIndex > 0) DoFlush(); }
+};
+#endif
+
+/// Nakładka przyspieszająca odczytująca ze strumienia pojedyncze znaki i inne rzeczy.
+/**
+- Nie jest strumieniem.
+- Tylko odczyt.
+- Jest szybka, ponieważ:
+  -# Nie ma metod wirtualnych.
+  -# Buforuje, więc nie używa za każdym razem metod wirtualnych strumienia.
+- Szybkość względem wczytywania pojedynczych znaków prosto ze strumienia: Debug = 10 razy, Release = 450 razy!
+- Celowo nie używam w tej klasie ERR_TRY .. ERR_CATCH_FUNC, żeby było szybciej.
+*/
+class CharReader
+{
+private:
+	Stream *m_Stream;
+	std::vector<char> m_Buf;
+	// Miejsce, do którego doczytałem z bufora
+	size_t m_BufBeg;
+	// Miejsce, do którego bufor jest wypełniony danymi
+	size_t m_BufEnd;
+
+	// Wczytuje nową porcję danych do strumienia
+	// Wywoływać tylko kiedy bufor się skończył, tzn. m_BufBeg == m_BufEnd.
+	// Jeśli skończył się strumień i nic nie udało się wczytać, zwraca false.
+	// Jeśli nie, zapewnia że w buforze będzie co najmniej jeden znak.
+	bool EnsureNewChars();
+
+public:
+	CharReader(Stream *a_Stream) : m_Stream(a_Stream), m_BufBeg(0), m_BufEnd(0) { m_Buf.resize(BUFFER_SIZE); }
+
+	/// Czy jesteśmy na końcu danych?
+	bool End() {
+		return (m_BufBeg == m_BufEnd) && m_Stream->End(); // Nic nie zostało w buforze i nic nie zostało w strumieniu.
+	}
+	/// Jeśli można odczytać następny znak, wczytuje go i zwraca true.
+	/** Jeśli nie, nie zmienia Out i zwraca false. Oznacza to koniec strumienia. */
+	bool ReadChar(char *Out) { if (m_BufBeg == m_BufEnd) { if (!EnsureNewChars()) return false; } *Out = m_Buf[m_BufBeg++]; return true; }
+	/// Jeśli można odczytać następny znak, wczytuje go.
+	/** Jeśli nie, rzuca wyjątek. */
+	char MustReadChar() { if (m_BufBeg == m_BufEnd) { if (!EnsureNewChars()) _ThrowBufEndError(__TFILE__, __LINE__); } return m_Buf[m_BufBeg++]; }
+	/// Jeśli można odczytać następny znak, podgląda go zwracając przez Out i zwraca true. Nie przesuwa "kursora".
+	/** Jeśli nie, nie zmienia Out i zwraca false. Oznacza to koniec strumienia. */
+	bool PeekChar(char *Out) { if (m_BufBeg == m_BufEnd) { if (!EnsureNewChars()) return false; } *Out = m_Buf[m_BufBeg]; return true; }
+	/// Jeśli można odczytać następny znak, podgląda go zwracając. Nie przesuwa "kursora".
+	/** Jeśli nie, rzuca wyjątek. */
+	char MustPeekChar() { if (m_BufBeg == m_BufEnd) { if (!EnsureNewChars()) _ThrowBufEndError(__TFILE__, __LINE__); } return m_Buf[m_BufBeg]; }
+	/// Wczytuje co najwyżej MaxLength znaków do podanego stringa.
+	/** StringStream jest czyszczony - nie musi być pusty ani zaalokowany. (???)
+	\return Zwraca liczbę odczytanych znaków. Mniej niż żądano oznacza koniec strumienia. */
+	size_t ReadString(string *Out, size_t MaxLength);
+	/// Wczytuje Length znaków do podanego stringa.
+	/** StringStream jest czyszczony - nie musi być pusty ani zaalokowany. (???)
+	Jeśli nie uda się odczytać wszystkich Length znaków, rzuca wyjątek. */
+	void MustReadString(string *Out, size_t Length);
+	/// Wczytuje co najwyżej MaxLength znaków pod podany wskaźnik.
+	/** \param[out] Out musi być tablicą zaalokowaną do długości co najmniej MaxLength.
+	\return Zwraca liczbę odczytanych znaków. Mniej niż żądano oznacza koniec strumienia. */
+	size_t ReadString(char *Out, size_t MaxLength);
+	/// Wczytuje Length znaków pod podany wskaźnik.
+	/** Jeśli nie uda się odczytać wszystkich Length znaków, rzuca wyjątek.
+	\param[out] Out musi być tablicą zaalokowaną do długości co najmniej Length. */
+	void MustReadString(char *Out, size_t Length);
+	/// Wczytuje co najwyżej MaxLength bajtów pod podany wskaźnik.
+	/** \param[out] Out musi być tablicą zaalokowaną do długości co najmniej MaxLength bajtów.
+	\return Zwraca liczbę odczytanych bajtów. Mniej niż żądano oznacza koniec strumienia. */
+	size_t ReadData(void *Out, size_t MaxLength);
+	/// Wczytuje Length bajtów pod podany wskaźnik.
+	/** Jeśli nie uda się odczytać wszystkich Length bajtów, rzuca wyjątek.
+	\param[out] Out musi być tablicą zaalokowaną do długości co najmniej Length bajtów. */
+	void MustReadData(void *Out, size_t Length);
+	/// Jeśli jest następny znak do odczytania, pomija go i zwraca true.
+	/** Jeśli nie, zwraca false. Oznacza to koniec strumienia. */
+	bool SkipChar() { if (m_BufBeg == m_BufEnd) { if (!EnsureNewChars()) return false; } m_BufBeg++; return true; }
+	/// Jeśli jest następny znak do odczytania, pomija go.
+	/** Jeśli nie, rzuca wyjątek. */
+	void MustSkipChar() { if (m_BufBeg == m_BufEnd) { if (!EnsureNewChars()) _ThrowBufEndError(__TFILE__, __LINE__); } m_BufBeg++; }
+	/// Pomija co najwyżej MaxLength znaków.
+	/** \return Zwraca liczbę pominiętych znaków. Mniej niż żądano oznacza koniec strumienia. */
+	size_t Skip(size_t MaxLength);
+	/// Pomija Length znaków.
+	/** Jeśli nie uda się pominąć wszystkich Length znaków, rzuca wyjątek. */
+	void MustSkip(size_t Length);
+	/// Wczytuje linijkę tekstu i jeśli się udało, zwraca true.
+	/** Jeśli nie udało się wczytać ani jednego znaku, bo to już koniec strumienia, zwraca false.
+	Czyta znaki do napotkania końca strumienia lub końca wiersza, którym są <tt>"\r"</tt>, <tt>"\n"</tt> i <tt>"\r\n"</tt>.
+	Koniec wiersza przeskakuje, ale nie dołącza go do Out. */
+	bool ReadLine(string *Out);
+	/// Wczytuje linijkę tekstu.
+	/** Jeśli nie udało się wczytać ani jednego znaku, bo to już koniec strumienia, rzuca wyjątek.
+	Czyta znaki do napotkania końca strumienia lub końca wiersza, którym są <tt>"\r"</tt>, <tt>"\n"</tt> i <tt>"\r\n"</tt>.
+	Koniec wiersza przeskakuje, ale nie dołącza go do Out. */
+	void MustReadLine(string *Out);
+};
+
+#ifdef _WIN32
+/// Nakładka przyspieszająca odczytująca ze strumienia pojedyncze znaki Unicode.
+/** Uwaga! Wersja Unicode nie posiada odczytywania surowych danych binarnych. */
+class WCharReader
+{
+private:
+	Stream *m_Stream;
+	std::vector<wchar_t> m_Buf;
+	// Miejsce, do którego doczytałem z bufora
+	size_t m_BufBeg;
+	// Miejsce, do którego bufor jest wypełniony danymi
+	size_t m_BufEnd;
+
+	// Wczytuje nową porcję danych do strumienia
+	// Wywoływać tylko kiedy bufor się skończył, tzn. m_BufBeg == m_BufEnd.
+	// Jeśli skończył się strumień i nic nie udało się wczytać, zwraca false.
+	// Jeśli nie, zapewnia że w buforze będzie co najmniej jeden znak.
+	bool EnsureNewChars();
+
+public:
+	WCharReader(Stream *a_Stream) : m_Stream(a_Stream), m_BufBeg(0), m_BufEnd(0) { m_Buf.resize(BUFFER_SIZE); }
+
+	/// Czy jesteśmy na końcu danych?
+	bool End() {
+		return (m_BufBeg == m_BufEnd) && m_Stream->End(); // Nic nie zostało w buforze i nic nie zostało w strumieniu.
+	}
+	/// Jeśli można odczytać następny znak, wczytuje go i zwraca true.
+	/** Jeśli nie, nie zmienia Out i zwraca false. Oznacza to koniec strumienia. */
+	bool ReadChar(wchar_t *Out) { if (m_BufBeg == m_BufEnd) { if (!EnsureNewChars()) return false; } *Out = m_Buf[m_BufBeg++]; return true; }
+	/// Jeśli można odczytać następny znak, wczytuje go.
+	/** Jeśli nie, rzuca wyjątek. */
+	wchar_t MustReadChar() { if (m_BufBeg == m_BufEnd) { if (!EnsureNewChars()) _ThrowBufEndError(__TFILE__, __LINE__); } return m_Buf[m_BufBeg++]; }
+	/// Jeśli można odczytać następny znak, podgląda go zwracając przez Out i zwraca true. Nie przesuwa "kursora".
+	/** Jeśli nie, nie zmienia Out i zwraca false. Oznacza to koniec strumienia. */
+	bool PeekChar(wchar_t *Out) { if (m_BufBeg == m_BufEnd) { if (!EnsureNewChars()) return false; } *Out = m_Buf[m_BufBeg]; return true; }
+	/// Jeśli można odczytać następny znak, podgląda go zwracając. Nie przesuwa "kursora".
+	/** Jeśli nie, rzuca wyjątek. */
+	wchar_t MustPeekChar() { if (m_BufBeg == m_BufEnd) { if (!EnsureNewChars()) _ThrowBufEndError(__TFILE__, __LINE__); } return m_Buf[m_BufBeg]; }
+	/// Wczytuje co najwyżej MaxLength znaków do podanego stringa.
+	/** StringStream jest czyszczony - nie musi być pusty ani zaalokowany. (???)
+	\return Zwraca liczbę odczytanych znaków. Mniej niż żądano oznacza koniec strumienia. */
+	size_t ReadString(wstring *Out, size_t MaxLength);
+	/// Wczytuje Length znaków do podanego stringa.
+	/** StringStream jest czyszczony - nie musi być pusty ani zaalokowany. (???)
+	Jeśli nie uda się odczytać wszystkich Length znaków, rzuca wyjątek. */
+	void MustReadString(wstring *Out, size_t Length);
+	/// Wczytuje co najwyżej MaxLength znaków pod podany wskaźnik.
+	/** \param[out] Out musi być tablicą zaalokowaną do długości co najmniej MaxLength.
+	\return Zwraca liczbę odczytanych znaków. Mniej niż żądano oznacza koniec strumienia. */
+	size_t ReadString(wchar_t *Out, size_t MaxLength);
+	/// Wczytuje Length znaków pod podany wskaźnik.
+	/** Jeśli nie uda się odczytać wszystkich Length znaków, rzuca wyjątek.
+	\param[out] Out musi być tablicą zaalokowaną do długości co najmniej Length. */
+	void MustReadString(wchar_t *Out, size_t Length);
+	/// Jeśli jest następny znak do odczytania, pomija go i zwraca true.
+	/** Jeśli nie, zwraca false. Oznacza to koniec strumienia. */
+	bool SkipChar() { if (m_BufBeg == m_BufEnd) { if (!EnsureNewChars()) return false; } m_BufBeg++; return true; }
+	/// Jeśli jest następny znak do odczytania, pomija go.
+	/** Jeśli nie, rzuca wyjątek. */
+	void MustSkipChar() { if (m_BufBeg == m_BufEnd) { if (!EnsureNewChars()) _ThrowBufEndError(__TFILE__, __LINE__); } m_BufBeg++; }
+	/// Pomija co najwyżej MaxLength znaków.
+	/** \return Zwraca liczbę pominiętych znaków. Mniej niż żądano oznacza koniec strumienia. */
+	size_t Skip(size_t MaxLength);
+	/// Pomija Length znaków.
+	/** Jeśli nie uda się pominąć wszystkich Length znaków, rzuca wyjątek. */
+	void MustSkip(size_t Length);
+	/// Wczytuje linijkę tekstu i jeśli się udało, zwraca true.
+	/** Jeśli nie udało się wczytać ani jednego znaku, bo to już koniec strumienia, zwraca false.
+	Czyta znaki do napotkania końca strumienia lub końca wiersza, którym są <tt>"\r"</tt>, <tt>"\n"</tt> i <tt>"\r\n"</tt>.
+	Koniec wiersza przeskakuje, ale nie dołącza go do Out. */
+	bool ReadLine(wstring *Out);
+	/// Wczytuje linijkę tekstu.
+	/** Jeśli nie udało się wczytać ani jednego znaku, bo to już koniec strumienia, rzuca wyjątek.
+	Czyta znaki do napotkania końca strumienia lub końca wiersza, którym są <tt>"\r"</tt>, <tt>"\n"</tt> i <tt>"\r\n"</tt>.
+	Koniec wiersza przeskakuje, ale nie dołącza go do Out. */
+	void MustReadLine(wstring *Out);
+};
+#endif
+
+#ifdef _UNICODE
+	#define TCharWriter WCharWriter
+	#define TCharReader WCharReader
+#else
+	#define TCharWriter CharWriter
+	#define TCharReader CharReader
+#endif
+
+/// Strumień pamięci statycznej
+/** Strumień ma stałą długość i nie może być rozszerzany - ani automatycznie, ani ręcznie. */
+class MemoryStream : public SeekableStream
+{
+private:
+	char *m_Data;
+	size_t m_Size;
+	ptrdiff_t m_Pos;
+	bool m_InternalAlloc;
+
+public:
+	/** \param Data Podaj NULL, aby strumień sam zaalkował, a w destruktorze zwolnił pamięć.
+	Podaj wskaźnik, jeśli ma korzystać z twojego obszaru pamięci.
+	*/
+	MemoryStream(size_t Size, void *Data = 0);
+	virtual ~MemoryStream();
+
+	virtual void Write(const void *Data, size_t Size);
+	virtual size_t Read(void *Data, size_t Size);
+	virtual void MustRead(void *Data, size_t Size);
+
+	virtual uint64 GetSize();
+	virtual int64 GetPos();
+	virtual void SetPos(int64 pos);
+	virtual void Rewind();
+
+	char *Data() { return m_Data; }
+};
+
+/// Strumień pamięci, ale dynamicznej.
+/** Strumień można rozszerzać i sam też się rozszerza. */
+class VectorStream : public SeekableStream
+{
+private:
+	char *m_Data;
+	size_t m_Size;
+	size_t m_Capacity;
+	ptrdiff_t m_Pos;
+
+	// Zmienia capacity, a tym samym przealokowuje pamięć.
+	// O niczym sama nie decyduje ani niczego nie sprawdza.
+	void Reserve(size_t NewCapacity);
+
+public:
+	VectorStream();
+	virtual ~VectorStream();
+
+	virtual void Write(const void *Data, size_t Size);
+	virtual size_t Read(void *Data, size_t Size);
+	virtual void MustRead(void *Data, size_t Size);
+	virtual uint64 GetSize() { return m_Size; }
+	virtual int64 GetPos() { return m_Pos; }
+	virtual void SetPos(int64 pos) { m_Pos = (ptrdiff_t)pos; }
+	virtual void Rewind() { m_Pos = 0; }
+	virtual void SetSize(uint64 Size);
+
+	size_t GetCapacity() { return m_Capacity; }
+	void SetCapacity(size_t Capacity);
+	/** Nie musi pozostać aktualny po wywołaniach metod tej klasy!
+	(może zostać przealokowany) */
+	char *Data() { return m_Data; }
+};
+
+/// Strumień oparty na łańcuchu std::string
+/** Potrafi się rozszerzać. */
+class StringStream : public SeekableStream
+{
+private:
+	std::string *m_Data;
+	ptrdiff_t m_Pos;
+	bool m_InternalAlloc;
+
+public:
+	/** \param Data Podaj NULL, aby strumień sam zaalokował, a w destruktorze zwolnił łańcuch.
+	Podaj wskaźnik, jeśli ma korzystać z twojego obszaru pamięci. */
+	StringStream(string *Data = 0);
+	virtual ~StringStream();
+
+	virtual void Write(const void *Data, size_t Size);
+	virtual size_t Read(void *Data, size_t Size);
+	virtual void MustRead(void *Data, size_t Size);
+	virtual uint64 GetSize() { return m_Data->length(); }
+	virtual int64 GetPos() { return m_Pos; }
+	virtual void SetPos(int64 pos) { m_Pos = (ptrdiff_t)pos; }
+	virtual void Rewind() { m_Pos = 0; }
+	virtual void SetSize(uint64 Size);
+	virtual void Clear() { m_Data->clear(); }
+
+	size_t GetCapacity() { return m_Data->capacity(); }
+	void SetCapacity(size_t Capacity) { m_Data->reserve(Capacity); }
+	string *Data() { return m_Data; }
+};
+
+/// Abstrakcyjna klasa bazowa nakładek na strumienie
+class OverlayStream : public Stream
+{
+private:
+	Stream *m_Stream;
+
+public:
+	OverlayStream(Stream *a_Stream) : m_Stream(a_Stream) { }
+
+	Stream * GetStream() { return m_Stream; }
+
+	// ======== Implementacja Stream ========
+	virtual bool End() { return m_Stream->End(); }
+	virtual void Flush() { m_Stream->Flush(); }
+};
+
+/// Nakładka na strumień zliczająca ilość zapisanych i odczytanych bajtów
+class CounterOverlayStream : public OverlayStream
+{
+private:
+	uint64 m_WriteCounter;
+	uint64 m_ReadCounter;
+
+public:
+	CounterOverlayStream(Stream *a_Stream);
+
+	// ====== Implementacja Stream ======
+	virtual void Write(const void *Data, size_t Size);
+	virtual size_t Read(void *Data, size_t Size);
+	virtual void MustRead(void *Data, size_t Size);
+    virtual void Flush() { GetStream()->Flush(); }
+
+	uint64 GetWriteCounter() { return m_WriteCounter; }
+	uint64 GetReadCounter() { return m_ReadCounter; }
+	void ResetWriteCounter() { m_WriteCounter = 0; }
+	void ResetReadCounter() { m_ReadCounter = 0; }
+};
+
+/// Nakładka na strumień ograniczająca liczbę odczytywanych i zapisywanych bajtów.
+/** Jesli przekroczy limit podczas zapisywania, zapisuje ile się da i rzuca błąd zapisu.
+Jeśli przekroczy limit podczas odczytywania zachowuje się tak, jakby strumień osiągnął koniec. */
+class LimitOverlayStream : public OverlayStream
+{
+private:
+	// Przechowują aktualny limit, jaki pozostał.
+	// Są zmniejszane przez funkcje odczytujące i zapisujące.
+	uint64 m_WriteLimit;
+	uint64 m_ReadLimit;
+
+public:
+	LimitOverlayStream(Stream *a_Stream, uint64 WriteLimit, uint64 ReadLimit);
+
+	// ====== Implementacja Stream ======
+	virtual void Write(const void *Data, size_t Size);
+	virtual size_t Read(void *Data, size_t Size);
+	virtual void Flush();
+
+	/// Ustawia nowy limit
+	void SetWriteLimit(uint64 WriteLimit);
+	/// Ustawia nowy limit
+	void SetReadLimit(uint64 ReadLimit);
+};
+
+class BufferingStream : public OverlayStream
+{
+public:
+	BufferingStream(Stream *stream, size_t readBufSize, size_t writeBufSize);
+	~BufferingStream();
+
+	// ====== Implementacja Stream ======
+	virtual void Write(const void *Data, size_t Size);
+	virtual void Flush();
+	virtual size_t Read(void *Data, size_t MaxLength);
+	virtual bool End();
+	virtual size_t Skip(size_t MaxLength);
+
+	/// Writes single char/byte
+	void WriteChar(char ch) { if (m_WriteBufIndex == m_WriteBufSize) DoFlush(); m_WriteBuf[m_WriteBufIndex++] = ch; }
+
+private:
+	size_t m_ReadBufSize, m_WriteBufSize;
+	std::vector<char> m_ReadBuf, m_WriteBuf;
+	size_t m_ReadBufBeg, m_ReadBufEnd, m_WriteBufIndex;
+
+	void DoFlush();
+	// Wczytuje nową porcję danych do bufora
+	// Wywoływać tylko kiedy bufor się skończył, tzn. m_ReadBufBeg == m_ReadBufEnd.
+	// Jeśli skończył się strumień i nic nie udało się wczytać, zwraca false.
+	// Jeśli nie, zapewnia że w buforze będzie co najmniej jeden znak.
+	bool EnsureNewChars();
+};
+
+/// Zapisuje zapisywane dane do wielu podłączonych do niego strumieni na raz.
+class MultiWriterStream : public Stream
+{
+private:
+	std::vector<Stream*> m_Streams;
+
+public:
+	MultiWriterStream() { }
+	MultiWriterStream(Stream *a_Streams[], size_t StreamCount);
+
+	/// Dodaje strumień do listy.
+	void AddStream(Stream *a_Stream) { m_Streams.push_back(a_Stream); }
+	/// Usuwa strumień z listy. Jeśli takiego nie znajdzie, nic nie robi.
+	void RemoveStream(Stream *a_Stream);
+	/// Usuwa wszystkie strumienie z listy.
+	void ClearStreams() { m_Streams.clear(); }
+	size_t GetStreamCount() { return m_Streams.size(); }
+
+	// ======== Implementacja Stream ========
+	virtual void Write(const void *Data, size_t Size);
+	virtual void Flush();
+};
+
+/// Klasa obliczająca hash 32-bitowy z kolejno podawanych bloków danych
+/** Algorytm: Jenkins One-at-a-time hash, http://www.burtleburtle.net/bob/hash/doobs.html
+Strumień tylko do zapisu.
+Prawidłowe użycie: Hash_Calc::Write(), Hash_Calc::Write() (lub inne funkcje zapisujące), ..., Hash_Calc::Finish().
+Po wywołaniu Hash_Calc::Finish() nie można dalej zapisywać danych!
+Hash_Calc::Reset() - rozpoczyna liczenie sumy od nowa. */
+class Hash_Calc : public Stream
+{
+private:
+	uint32 m_Hash;
+
+public:
+	Hash_Calc() : m_Hash(0) { }
+
+	// ======== Implementacja Stream ========
+	virtual void Write(const void *Data, size_t Size);
+
+	/// Kończy obliczenia i zwraca policzoną sumę
+	uint32 Finish();
+	/// Rozpoczyna liczenie nowej sumy
+	void Reset() { m_Hash = 0; }
+
+	// ======== Statyczne ========
+	/// Po prostu oblicza sumę kontrolną z podanych danych
+	static uint32 Calc(const void *Buf, size_t BufLen);
+	static uint32 Calc(const string &s);
+#ifdef _WIN32
+	static uint32 Calc(const wstring &s);
+#endif
+};
+
+/// Klasa obliczająca sumę CRC32 z kolejno podawanych bloków danych
+/** Strumień tylko do zapisu.
+CRC32_Calc::GetResult() - wyliczoną dotychczas sumę można otrzymywać w każdej chwili, a potem dalej dodawać nowe dane.
+CRC32_Calc::Reset() - rozpoczyna liczenie nowej sumy kontrolnej. */
+class CRC32_Calc : public Stream
+{
+private:
+	uint m_CRC;
+
+public:
+	CRC32_Calc() { m_CRC = 0xFFFFFFFFu; }
+
+	// ======== Implementacja Stream ========
+	virtual void Write(const void *Data, size_t Size);
+
+	/// Zwraca policzoną dotychczas sumę
+	uint GetResult() { return ~m_CRC; }
+	/// Rozpoczyna liczenie nowej sumy
+	void Reset() { m_CRC = 0xFFFFFFFFu; }
+
+	// ======== Statyczne ========
+	/// Po prostu oblicza sumę kontrolną z podanych danych
+	static uint Calc(const void *Data, size_t DataLength);
+};
+
+/// Suma MD5
+/** Suma ma 128 bitów - 16 bajtów. Jest typu uint8[16]. */
+struct MD5_SUM
+{
+	uint8 Data[16];
+
+	uint8 & operator [] (size_t i) { return Data[i]; }
+	uint8 operator [] (size_t i) const { return Data[i]; }
+
+	bool operator == (const MD5_SUM &s) const
+	{
+		return
+			Data[ 0] == s.Data[ 0] && Data[ 1] == s.Data[ 1] && Data[ 2] == s.Data[ 2] && Data[ 3] == s.Data[ 3] &&
+			Data[ 4] == s.Data[ 4] && Data[ 5] == s.Data[ 5] && Data[ 6] == s.Data[ 6] && Data[ 7] == s.Data[ 7] &&
+			Data[ 8] == s.Data[ 8] && Data[ 9] == s.Data[ 9] && Data[10] == s.Data[10] && Data[11] == s.Data[11] &&
+			Data[12] == s.Data[12] && Data[13] == s.Data[13] && Data[14] == s.Data[14] && Data[15] == s.Data[15];
+	}
+	bool operator != (const MD5_SUM &s) const
+	{
+		return
+			Data[ 0] != s.Data[ 0] || Data[ 1] != s.Data[ 1] || Data[ 2] != s.Data[ 2] || Data[ 3] != s.Data[ 3] ||
+			Data[ 4] != s.Data[ 4] || Data[ 5] != s.Data[ 5] || Data[ 6] != s.Data[ 6] || Data[ 7] != s.Data[ 7] ||
+			Data[ 8] != s.Data[ 8] || Data[ 9] != s.Data[ 9] || Data[10] != s.Data[10] || Data[11] != s.Data[11] ||
+			Data[12] != s.Data[12] || Data[13] != s.Data[13] || Data[14] != s.Data[14] || Data[15] != s.Data[15];
+	}
+	bool operator < (const MD5_SUM &s) const;
+	bool operator > (const MD5_SUM &s) const;
+	bool operator <= (const MD5_SUM &s) const;
+	bool operator >= (const MD5_SUM &s) const;
+};
+
+void MD5ToStr(tstring *Out, const MD5_SUM &MD5);
+bool StrToMD5(MD5_SUM *Out, const tstring &s);
+
+/// Klasa obliczająca sumę MD5 z kolejno podawanych bloków danych
+/** Strumień tylko do zapisu.
+Prawidłowe użycie: MD5_Calc::Write(), MD5_Calc::Write() (lub inne funkcje zapisujące), ..., MD5_Calc::Finish().
+Po wywołaniu Finish nie można dalej zapisywać danych!
+MD5_Calc::Reset() - rozpoczyna liczenie sumy od nowa. */
+class MD5_Calc : public Stream
+{
+private:
+	uint32 total[2];
+	uint32 state[4];
+	uint8 buffer[64];
+
+	void Process(uint8 data[64]);
+
+public:
+	MD5_Calc();
+
+	// ======== Implementacja Stream ========
+	virtual void Write(const void *Data, size_t Size);
+
+	/// Kończy obliczenia i zwraca policzoną sumę
+	void Finish(MD5_SUM *Out);
+	/// Rozpoczyna liczenie nowej sumy
+	void Reset();
+
+	// ======== Statyczne ========
+	/// Po prostu oblicza sumę kontrolną z podanych danych
+	static void Calc(MD5_SUM *Out, const void *Buf, size_t BufLen);
+};
+
+/// Koduje lub dekoduje zapisywane/odczytywane bajty XOR podany bajt lub ciąg bajtów.
+/** Mapuje bezpośrednio bajty na bajty strumienia do którego jest podłączony,
+nic nie buforuje, więc można operować też na strumieniu Stream. */
+class XorCoder : public OverlayStream
+{
+private:
+	std::vector<char> m_Buf;
+	std::vector<char> m_Key;
+	size_t m_EncodeKeyIndex;
+	size_t m_DecodeKeyIndex;
+
+public:
+	XorCoder(Stream *a_Stream, char KeyByte);
+	XorCoder(Stream *a_Stream, const void *KeyData, size_t KeyLength);
+	XorCoder(Stream *a_Stream, const string &Key);
+
+	// ======== Implementacja Stream ========
+	virtual void Write(const void *Data, size_t Size);
+	virtual size_t Read(void *Data, size_t Size);
+
+	/// Resetuje liczniki tak żeby kodowanie i dekodowanie odbywało się od początku klucza
+	void Reset() { m_EncodeKeyIndex = m_DecodeKeyIndex = 0; }
+
+	// ======== Statyczne ========
+	/// Po prostu przetwarza podane dane
+	static void Code(void *Out, const void *Data, size_t DataLength, const void *Key, size_t KeyLength);
+	/// Po prostu przetwarza podane dane
+	static void Code(string *Out, const string &Data, const string &Key);
+#ifdef _WIN32
+	/// Po prostu przetwarza podane dane
+	static void Code(wstring *Out, const wstring &Data, const wstring &Key);
+#endif
+};
+
+/// Koduje strumień binarnych danych wejściowych na ciąg złożony ze znaków '0' i '1' (po 8 na każdy bajt).
+class BinEncoder : public OverlayStream
+{
+private:
+	CharWriter m_CharWriter;
+
+public:
+	BinEncoder(Stream *a_Stream) : OverlayStream(a_Stream), m_CharWriter(a_Stream) { }
+
+	// ======== Implementacja Stream ========
+	virtual void Write(const void *Data, size_t Size);
+	virtual void Flush() { m_CharWriter.Flush(); OverlayStream::Flush(); }
+
+	// ======== Statyczne ========
+	/// Po prostu koduje podane dane
+	/*** \param[out] Out Bufor wyjściowy Out musi mieć zaalokowane przynajmniej DataLength * 8 bajtów. */
+	static void Encode(char *Out, const void *Data, size_t DataLength);
+	/// Po prostu koduje podane dane
+	/** \param[out] Out Łańcuch wyjściowy Out nie musi mieć żadnego konkretnego rozmiaru -
+	zostaje wyczyszczony i wypełniony od nowa. */
+	static void Encode(string *Out, const void *Data, size_t DataLength);
+};
+
+/// Dekoduje ciąg znaków wejściowych zapisanych binarnie (znakami '0' i '1') na dane binarne.
+class BinDecoder : public OverlayStream
+{
+private:
+	CharReader m_CharReader;
+	DECODE_TOLERANCE m_Tolerance;
+
+public:
+	BinDecoder(Stream *a_Stream, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
+
+	DECODE_TOLERANCE GetTolerance() { return m_Tolerance; }
+
+	// ======== Implementacja Stream ========
+	virtual size_t Read(void *Out, size_t Size);
+	virtual bool End() { return m_CharReader.End(); }
+
+	// ======== Statyczne ========
+	/// Znajduje długość zakodowanych danych i zwraca true.
+	/** Jeśli nie udało się ustalić długości, zwraca false. */
+	static bool DecodeLength(size_t *OutLength, const string &s, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
+	static bool DecodeLength(size_t *OutLength, const char *s, size_t s_Length, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
+	/// Dekoduje dane binarne. Zwraca liczbę zdekodowanych bajtów.
+	/** Jeśli nie udało się zdekodować (jakiś błąd), zwraca SIZE_MAX.
+	\param[out] OutData musi być tablicą zaalokowaną przynajmniej na rozmiar ustalony wywołaniem DecodeLength()
+	lub jeśli nie chcesz wywoływać DecodeLength(), na długość równą długości danych wejściowych / 8. */
+	static size_t Decode(void *OutData, const string &s, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
+	static size_t Decode(void *OutData, const char *s, size_t s_Length, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
+};
+
+/// Koduje strumień binarnych danych wejściowych na zapis szesnastkowy (po 2 znaki na każdy bajt).
+class HexEncoder : public OverlayStream
+{
+private:
+	CharWriter m_CharWriter;
+	bool m_UpperCase;
+
+public:
+	HexEncoder(Stream *a_Stream, bool UpperCase = true) : OverlayStream(a_Stream), m_CharWriter(a_Stream), m_UpperCase(UpperCase) { }
+
+	// ======== Implementacja Stream ========
+	virtual void Write(const void *Data, size_t Size);
+	virtual void Flush() { m_CharWriter.Flush(); OverlayStream::Flush(); }
+
+	// ======== Statyczne ========
+	/// Po prostu koduje podane dane
+	/** \param[out] Out Bufor wyjściowy Out musi mieć zaalokowane przynajmniej DataLength * 2 znaków. */
+	static void Encode(char *Out, const void *Data, size_t DataLength, bool UpperCase = true);
+	/// Po prostu koduje podane dane
+	/** \param[out] Out Łańcuch wyjściowy Out nie musi mieć żadnego konkretnego rozmiaru -
+	zostaje wyczyszczony i wypełniony od nowa. */
+	static void Encode(string *Out, const void *Data, size_t DataLength, bool UpperCase = true);
+#ifdef _WIN32
+	static void Encode(wchar_t *Out, const void *Data, size_t DataLength, bool UpperCase = true);
+	static void Encode(wstring *Out, const void *Data, size_t DataLength, bool UpperCase = true);
+#endif
+};
+
+/// Dekoduje ciąg znaków wejściowych zapisanych szesnastkowo na dane binarne.
+/** Akceptuje zarówno małe, jak i duże litery. */
+class HexDecoder : public OverlayStream
+{
+private:
+	CharReader m_CharReader;
+	DECODE_TOLERANCE m_Tolerance;
+
+public:
+	HexDecoder(Stream *a_Stream, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
+
+	DECODE_TOLERANCE GetTolerance() { return m_Tolerance; }
+
+	// ======== Implementacja Stream ========
+	virtual size_t Read(void *Out, size_t Size);
+	virtual bool End() { return m_CharReader.End(); }
+
+	// ======== Statyczne ========
+	/// Znajduje długość zakodowanych danych i zwraca true.
+	/** Jeśli nie udało się ustalić długości, zwraca false. */
+	static bool DecodeLength(size_t *OutLength, const string &s, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
+	static bool DecodeLength(size_t *OutLength, const char *s, size_t s_Length, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
+	/// Dekoduje dane binarne. Zwraca liczbę zdekodowanych bajtów.
+	/** Jeśli nie udało się zdekodować (jakiś błąd), zwraca SIZE_MAX.
+	\param[out] OutData musi być tablicą zaalokowaną przynajmniej na rozmiar ustalony wywołaniem DecodeLength
+	lub jeśli nie chcesz wywoływać DecodeLength, na długość równą długości danych wejściowych / 2. */
+	static size_t Decode(void *OutData, const string &s, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
+	/// Dekoduje dane binarne. Zwraca liczbę zdekodowanych bajtów.
+	static size_t Decode(void *OutData, const char *s, size_t s_Length, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
+#ifdef _WIN32
+	static size_t Decode(void *OutData, const wstring &s, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
+	static size_t Decode(void *OutData, const wchar_t *s, size_t s_Length, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
+#endif
+};
+
+/// Koduje strumień binarnych danych wejściowych na ciąg znaków base64.
+/**
+- Zgodny z RFC 4648 "The Base16, Base32, and Base64 Data Encodings"
+- Prawidłowe dane wyjściowe powstają dopiero po zakończeniu zapisywania, które następuje w destruktorze.
+  Jeśli chcesz zakończyć wcześniej, wywołaj Base64Encoder::Finish(), ale potem nie można już nic dopisywać.
+*/
+class Base64Encoder : public OverlayStream
+{
+private:
+	CharWriter m_CharWriter;
+	bool m_Finished; // Czy dane zakończone
+	uint8 m_Buf[2];
+	size_t m_BufIndex;
+
+	void DoFinish();
+
+public:
+	Base64Encoder(Stream *a_Stream) : OverlayStream(a_Stream), m_CharWriter(a_Stream), m_Finished(false), m_BufIndex(0) { }
+	~Base64Encoder();
+
+	void Finish() { if (!m_Finished) { DoFinish(); m_Finished = true; } }
+
+	// ======== Implementacja Stream ========
+	virtual void Write(const void *Data, size_t Size);
+	virtual void Flush() { m_CharWriter.Flush(); OverlayStream::Flush(); }
+
+	// ======== Statyczne ========
+	/// Oblicza rozmiar bufora na zakodowane dane
+	static size_t EncodeLength(size_t DataLength);
+	/// Po prostu koduje podane dane
+	/** \param[out] Out Bufor wyjściowy Out musi mieć zaalokowane przynajmniej tyle bajtów ile wyliczyło EncodeLength.
+	\return Zwraca liczbę znaków zapisanych do Out. */
+	static size_t Encode(char *Out, const void *Data, size_t DataLength);
+	/// Po prostu koduje podane dane
+	/** \param[out] Out Łańcuch wyjściowy Out nie musi mieć żadnego konkretnego rozmiaru -
+	zostaje wyczyszczony i wypełniony od nowa. */
+	static size_t Encode(string *Out, const void *Data, size_t DataLength);
+};
+
+/// Dekoduje ciąg znaków wejściowych zapisanych w standardzie base64 na dane binarne.
+/*
+- Po napotkaniu końcówki zawierającej znaki '=' funkcje nie parsują już dalej,
+  ale to tylko optymalizacja i nie należy na tym polegać.
+- Sposób działania strumienia - na raz wczytywane są po 4 znaki i zamieniane na
+  maksymalnie 3 bajty.
+*/
+class Base64Decoder : public OverlayStream
+{
+private:
+	CharReader m_CharReader;
+	DECODE_TOLERANCE m_Tolerance;
+	// Bajty są w kolejności: [2][1][0]. Jeśli jest mniej, to [1][0][-] albo [0][-][-].
+	uint8 m_Buf[3];
+	// Liczba zdekodowanych bajtów w buforze
+	size_t m_BufLength;
+	// True, jeśli sparsowano końcówkę z '='
+	bool m_Finished;
+
+	// Czyta 4 znaki ze strumienia podłączonego (0 albo 4, inaczej błąd) i wypełnia m_Buf maksymalnie 3 zdekodowanymi bajtami.
+	// Ustawia m_BufLength i jeśli trzeba, to m_Finished.
+	bool ReadNextBuf();
+
+	bool GetNextByte(uint8 *OutByte) { if (m_BufLength == 0) { if (!ReadNextBuf()) return false; } *OutByte = m_Buf[--m_BufLength]; return true; }
+
+public:
+	Base64Decoder(Stream *a_Stream, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
+
+	DECODE_TOLERANCE GetTolerance() { return m_Tolerance; }
+
+	// ======== Implementacja Stream ========
+	virtual size_t Read(void *Out, size_t Size);
+	virtual bool End();
+
+	// ======== Statyczne ========
+	/// Znajduje długość zakodowanych danych i zwraca true.
+	/** Jeśli nie udało się ustalić długości, zwraca false. */
+	static bool DecodeLength(size_t *OutLength, const string &s, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
+	static bool DecodeLength(size_t *OutLength, const char *s, size_t s_Length, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
+	/// Dekoduje dane binarne. Zwraca liczbę zdekodowanych bajtów.
+	/** Jeśli nie udało się zdekodować (jakiś błąd), zwraca SIZE_MAX.
+	\param[out] OutData musi być tablicą zaalokowaną przynajmniej na rozmiar ustalony wywołaniem DecodeLength(). */
+	static size_t Decode(void *OutData, const string &s, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
+	static size_t Decode(void *OutData, const char *s, size_t s_Length, DECODE_TOLERANCE Tolerance = DECODE_TOLERANCE_NONE);
+};
+
+/// Bufor kołowy
+/*
+Działa szybko (na tyle na ile szybko może działać strumień, ze
+swoimi metodami wirtualnymi itd.), ale ma z góry ograniczoną pojemność. W
+przypadku przepełnienia przy zapisie rzuca wyjątek.
+*/
+class RingBuffer : public Stream
+{
+public:
+	RingBuffer(size_t Capacity);
+	virtual ~RingBuffer();
+
+	/// Zwraca liczbę bajtów w buforze
+	uint64 GetSize() { return m_Size; }
+	/// Zwraca pojemność bufora
+	size_t GetCapacity() { return m_Capacity; }
+	/// Zwraca true, jeśli bufor jest pusty
+	bool IsEmpty() { return GetSize() == 0; }
+	/// Zwraca true, jeśli bufor jest pełny
+	bool IsFull() { return GetSize() == GetCapacity(); }
+
+	// ======== Implementacja Stream ========
+	virtual void Write(const void *Data, size_t Size);
+	virtual size_t Read(void *Out, size_t MaxLength);
+	virtual void MustRead(void *Out, size_t Length);
+	virtual bool End();
+	virtual size_t Skip(size_t MaxLength);
+
+private:
+	size_t m_Capacity;
+	size_t m_Size;
+	std::vector<char> m_Buf;
+	size_t m_BegIndex;
+	size_t m_EndIndex;
+};
+
+
+/// Kopiuje dane z jednego strumienia do drugiego - co najwyżej MaxLength bajtów.
+/** \return Zwraca liczbę przekopiowanych danych. */
+inline size_t Copy(Stream *Dst, Stream *Src, size_t MaxLength) { return Dst->CopyFrom(Src, MaxLength); }
+/// Kopiuje dane z jednego strumienia do drugiego - dokładnie Length bajtów.
+/** Jeśli się nie uda przekopiować tylu bajtów, rzuca błąd. */
+inline void MustCopy(Stream *Dst, Stream *Src, size_t Length) { return Dst->MustCopyFrom(Src, Length); }
+/// Kopiuje dane z jednego strumienia do drugiego aż do końca tego źródłowego
+inline size_t CopyToEnd(Stream *Dst, Stream *Src) { return Dst->CopyFromToEnd(Src); }
+
+//@}
+// code_stream
+
+} // namespace common
+
+/** \addtogroup code_sthtostr */
+//@{
+
+template <>
+struct SthToStr_obj<common::MD5_SUM>
+{
+	void operator () (tstring *Str, const common::MD5_SUM &Sth)
+	{
+		common::MD5ToStr(Str, Sth);
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+template <>
+struct StrToSth_obj<common::MD5_SUM>
+{
+	bool operator () (common::MD5_SUM *Sth, const tstring &Str)
+	{
+		return common::StrToMD5(Sth, Str);
+	}
+	static inline bool IsSupported() { return true; }
+};
+
+//@}
+// code_sthtostr
+
+#endif
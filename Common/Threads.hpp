@@ -1,401 +1,446 @@
-/** \file
-\brief Multithreading and synchronization library
-\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
-
-Part of CommonLib library. \n
-Encoding UTF-8, end of line CR+LF \n
-License: GNU LGPL. \n
-Documentation: \ref Module_Threads \n
-Module components: \ref code_threads
-*/
-#if defined(_MSC_VER) && (_MSC_VER >= 1200)
-#pragma once
-#endif
-#ifndef COMMON_THREADS_H_
-#define COMMON_THREADS_H_
-
-namespace common
-{
-
-/** \addtogroup code_threads Threads Module
-Dokumentacja: \ref Module_Threads \n
-Nagwek: Threads.hpp */
-//@{
-
-/// \internal
-class Thread_pimpl;
-/// \internal
-class Mutex_pimpl;
-/// \internal
-class Semaphore_pimpl;
-/// \internal
-class Cond_pimpl;
-/// \internal
-class Barrier_pimpl;
-/// \internal
-class Event_pimpl;
-
-/// Klasa bazowa wtku.
-/**
-- Odziedzicz po tej klasie, eby zdefiniowa wasny typ wtku. Nadpisa metod Thread::Run().
-- Obiekt tej klasy reprezentuje pojedynczy wtek.
-- Wtek mona odpali jeden raz - Thread::Start().
-- Przed zniszczeniem obiektu na odpalony wtek trzeba poczeka - Thread::Join().
-- Obiekt mona tworzy na stosie lub na stercie - obojtne.
-- Obiekt, jeli alokowany new, trzeba zniszczy delete - sam si nie zniszczy.
-*/
-class Thread
-{
-	DECLARE_NO_COPY_CLASS(Thread)
-	friend class Thread_pimpl;
-
-private:
-	scoped_ptr<Thread_pimpl> pimpl;
-	
-protected:
-	/// Napisz swoj wersj z kodem, ktry ma si wykona w osobnym wtku.
-	virtual void Run() = 0;
-
-	/// Koczy dziaanie wtku
-	/**
-	- Wywoywa z funkcji Run().
-	- Lepiej jednak normalnie zakoczy funkcj Run.
-	  Stosowanie Exit() nie ma sensu i jest niebezpieczne dla zasobw.
-	*/
-	void Exit();
-	/// Oddaje sterowanie innemu wtkowi
-	/**
-	- Wywoywa z funkcji Run().
-	- Nazwa taka dziwna, bo jaki cham zdefiniowa makro o nazwie Yield!
-	*/
-	void Yield_();
-
-public:
-	Thread();
-	virtual ~Thread();
-
-	/// Uruchamiamia wtek.
-	void Start();
-	/// Czeka na zakoczenie wtku.
-	/**
-	- Jeli wtek ju si zakoczy, wychodzi od razu.
-	- Jeli wtek jeszcze nie by odpalony albo ju raz byo testowane Join(), nic si nie dzieje.
-	*/
-	void Join();
-
-	/// Brutalnie zabija wtek - nie uywa!
-	void Kill();
-
-// Rzeczy ktre nie wiem jak zrealizowa w pthreads - dziaaj tylko w Windows
-#ifdef _WIN32
-	void* GetNativeHandle(); ///< Returns HANDLE.
-	uint GetNativeId(); ///< Returns DWORD.
-	/// Zwraca true, jeli wtek jest w tej chwili uruchomiony i naprawd jeszcze dziaa
-	bool IsRunning();
-	/// Zatrzymuje wtek, wznawia wtek (posiada wewntrzny licznik zatrzyma)
-	/**
-	- Dziaa tylko midzy Start() a Join().
-	- Raczej nie ma sensu tego uywa.
-	*/
-	void Pause();
-	void Resume();
-
-	/** \name Priorytet wtku
-	Prioritytet wtku jest liczb cakowit. Te stae to niektre wartoci. Mog by te inne.
-	Ustawianie i pobieranie priotytetu wtku dziaa tylko midzy Start() a Join(). */
-	//@{
-	static const int PRIORITY_IDLE;
-	static const int PRIORITY_VERY_LOW;
-	static const int PRIORITY_LOW;
-	static const int PRIORITY_DEFAULT;
-	static const int PRIORITY_HIGH;
-	static const int PRIORITY_VERY_HIGH;
-	static const int PRIORITY_REALTIME;
-	void SetPriority(int Priority);
-	int GetPriority();
-
-	void SetThreadName(const char *s);
-	static void SetThreadNameById(uint threadId, const char *s);
-	static void SetMainThreadName(const char *s);
-	//@}
-#endif
-};
-
-/// Muteks
-/** Obiekt do wyznaczania sekcji krytycznej na wzajemnie wykluczajc si wyczno
-jednego wtku.
-*/
-class Mutex
-{
-	DECLARE_NO_COPY_CLASS(Mutex)
-	friend class Mutex_pimpl;
-	friend class Cond;
-
-private:
-	scoped_ptr<Mutex_pimpl> pimpl;
-
-public:
-	/** \name Flagi bitowe do konstruktora */
-	//@{
-	/// Podaj, jeli bdziesz robi w ramach jednego wtku zagniedone blokowania.
-	static const uint FLAG_RECURSIVE    = 0x01;
-	/// Podaj, jeli bdziesz uywa metody TimeoutLock.
-	static const uint FLAG_WAIT_TIMEOUT = 0x02;
-	//@}
-
-	Mutex(uint Flag);
-	~Mutex();
-
-	/// Blokuje muteks.
-	void Lock();
-	/// Odblokowuje muteks.
-	void Unlock();
-	/// Prbuje wej do sekcji krytycznej.
-	/**
-	- Jeli si uda, wchodzi blokujc muteks i zwraca true.
-	- Jeli si nie uda bo muteks jest zablokowany przez inny wtek, nie blokuje sterowania tylko zawraca false.
-	*/
-	bool TryLock();
-	/// Prbuje wej do sekcji krytycznej czekajc co najwyej podany czas.
-	/**
-	- Jeli si uda, wchodzi blokujc muteks i zwraca true.
-	- Jeli si nie uda przez podany czas, bo muteks jest zablokowany przez inny wtek, zwraca false.
-	*/
-	bool TimeoutLock(uint Milliseconds);
-};
-
-/// Klasa pomagajca blokowa muteks
-/**
-- W konstruktorze blokuje, w destruktorze odblokowuje.
-- Uywaj jej zamiast metod Mutex::Lock i Mutex::Unlock kiedy tylko mona.
-*/
-class MutexLock
-{
-private:
-	Mutex &m_Mutex;
-	DECLARE_NO_COPY_CLASS(MutexLock)
-
-public:
-	MutexLock(Mutex &m) : m_Mutex(m) { m.Lock(); }
-	~MutexLock() { m_Mutex.Unlock(); }
-};
-
-/**
-Dla jeszcze wiszej wygody, zamiast tworzy obiekt klasy MutexLock wystarczy na
-pocztku funkcji czy dowolnego bloku { } postawi to makro (M ma by typu
-Mutex*).
-*/
-#define MUTEX_LOCK(M) common::MutexLock __mutex_lock_obj(M);
-
-/// Semafor zliczajcy
-/**
-- Posiada wewntrznie nieujemn warto cakowit, ktr mona sobie wyobrazi
-  jako liczb dostpnych zasobw. Nie ma do niej dostpu bezporednio.
-- Warto maksymalna tej liczby nie jest okrelona, jest jaka dua.
-*/
-class Semaphore
-{
-	DECLARE_NO_COPY_CLASS(Semaphore)
-
-private:
-	scoped_ptr<Semaphore_pimpl> pimpl;
-
-public:
-	Semaphore(uint InitialValue);
-	~Semaphore();
-
-	/// Opuszcza semafor - zmniejsza jego warto o jeden.
-	/**
-	Jeli semafor jest zerowy, czeka a kto go podniesie zanim go opuci i zwrci sterowanie.
-	*/
-	void P();
-	/// Prbuje opuci semafor - zmniejszy jego warto o jeden.
-	/**
-	- Jeli si uda, zmniejsza i zwraca true.
-	- Jeli si nie uda bo warto wynosi 0, nie blokuje sterowania tylko zawraca false.
-	*/
-	bool TryP();
-	/// Prbuje opuci semafor czekajc co najwyej podany czas.
-	/**
-	- Jeli si uda, zmniejsza i zwraca true.
-	- Jeli si nie uda przez podany czas, bo warto wynosi 0, zwraca false.
-	*/
-	bool TimeoutP(uint Milliseconds);
-
-	/// Podnosi semafor zwikszajc go o 1. Nigdy nie blokuje.
-	void V();
-	/// Podnosi semafor zwikszajc go o ReleaseCount. Nigdy nie blokuje.
-	void V(uint ReleaseCount);
-};
-
-/// Zmienna warunkowa
-/**
-Nie pamita adnego swojego stanu. Pozwala za to zawiesi wtek eby na niej
-poczeka (Wait()) oraz wznowi niezdefiniowany jeden (Signal()) lub wszystkie
-(Broadcast()) czekajce na niej wtki. Sensu nabiera dopiero kiedy zrozumie si
-sposb jej uycia w kontekcie wzorca monitora do sprawdzania warunku.
-*/
-class Cond
-{
-	DECLARE_NO_COPY_CLASS(Cond)
-
-private:
-	scoped_ptr<Cond_pimpl> pimpl;
-
-public:
-	Cond();
-	~Cond();
-
-	/// Odblokowuje muteks, zawiesza wtek czekajc na sygna, po doczekaniu si blokuje muteks z powrotem.
-	/** Muteks m musi by zablokowany w chwili tego wywoania. */
-	void Wait(Mutex *m);
-	/// Odblokowuje muteks, zawiesza wtek czekajc na sygna przez co najwyej podany czas, po doczekaniu si blokuje muteks z powrotem.
-	/**
-	- Jeli w tym czasie nastpio przerwanie czekania przez sygna, zwraca true.
-	- Muteks m musi by zablokowany w chwili tego wywoania.
-	*/
-	bool TimeoutWait(Mutex *m, uint Milliseconds);
-
-	/// Odwiesza przypadkowy jeden czekajcy wtek.
-	/**
-	- Jeli aden wtek nie czeka, nie robi nic.
-	- Nie jest wymagane eby jaki muteks musia by zablokowany w chwili tego wywoania.
-	*/
-	void Signal();
-	/// Odwiesza wszystkie czekajce wtki.
-	/**
-	- Jeli aden wtek nie czeka, nie robi nic.
-	- Nie jest wymagane eby jaki muteks musia by zablokowany w chwili tego wywoania.
-	*/
-	void Broadcast();
-};
-
-/// Bariera
-/**
-Wtki ktre wywouj Wait() blokuj si czekajc, a si ich uzbiera tyle
-czekajcych, ile wynosi przekazany do konstruktora NumThreads. Kiedy ostatni z
-nich wywoa Wait(), wszystkie ruszaj dalej.
-*/
-class Barrier
-{
-	DECLARE_NO_COPY_CLASS(Barrier)
-
-private:
-	scoped_ptr<Barrier_pimpl> pimpl;
-
-public:
-	Barrier(uint NumThreads);
-	~Barrier();
-
-	void Wait();
-};
-
-/// Zdarzenie
-/**
-Ten obiekt, wzorowany na WinAPI. Jest troch podobny do zmiennej warunkowej,
-ale ma swj stan - true lub false.
-*/
-class Event
-{
-	DECLARE_NO_COPY_CLASS(Event);
-
-private:
-	scoped_ptr<Event_pimpl> pimpl;
-
-public:
-	enum TYPE
-	{
-		/** Zdarzenie samo przywrci si do false, kiedy jaki jeden wtek doczeka si true w wywoaniu Wait.
-		SetEvent() wznawia jeden wtek czekajacy na Wait. */
-		TYPE_AUTO_RESET,
-		/** Zdarzenie samo nie przywrci si do false.
-		SetEvent() wznawia wszystkie wtki czekajce na Wait. */
-		TYPE_MANUAL_RESET,
-	};
-
-	Event(bool InitialState, TYPE Type);
-	~Event();
-
-	/// Zmienia stan na true.
-	/**
-	- Event::TYPE_AUTO_RESET: Jeli jakie wtki czekay, wznawia jeden i przestawia z powrotem na false.
-	- Event::TYPE_MANUAL_RESET: Jeli jakie wtki czekay, wznawia je wszystkie.
-	*/
-	void Set();
-	/// Zmienia stan na false.
-	void Reset();
-
-	/// Czeka, a stan bdzie true.
-	/**
-	- Jeli ju jest, zwraca sterowanie od razu.
-	- Event::TYPE_AUTO_RESET: Kiedy si doczeka, przestawia go z powrotem na false.
-	*/
-	void Wait();
-	/// Zwraca stan
-	/** Event::TYPE_AUTO_RESET: Jeli by true, przestawia go z powrotem na false. */
-	bool Test();
-	/// Czeka, a stan bdzie true przez co najwyej podany czas.
-	/**
-	- Jeli jest albo si doczeka a bdzie, zwraca true.
-	- Jeli si nie doczeka przez podany czas (stan jest cay czas false), zwraca false.
-	- Event::TYPE_AUTO_RESET: Kiedy si doczeka na stan true, przestawia go z powrotem na false.
-	*/
-	bool TimeoutWait(uint Milliseconds);
-};
-
-class RWLock
-{
-	DECLARE_NO_COPY_CLASS(RWLock)
-
-public:
-	RWLock() : m_Readers(0), m_ReadersEvent(true, Event::TYPE_AUTO_RESET), m_DataEvent(true, Event::TYPE_AUTO_RESET) { }
-
-	void LockWrite() { m_DataEvent.Wait(); }
-	bool TryLockWrite() { return m_DataEvent.Test(); }
-	bool TimeoutLockWrite(uint Milliseconds) { return m_DataEvent.TimeoutWait(Milliseconds); }
-	void UnlockWrite() { m_DataEvent.Set(); }
-
-	void LockRead()
-	{
-		m_ReadersEvent.Wait();
-		if (m_Readers++ == 0) m_DataEvent.Wait();
-		m_ReadersEvent.Set();
-	}
-	void UnlockRead()
-	{
-		m_ReadersEvent.Wait();
-		if (--m_Readers == 0) m_DataEvent.Set();
-		m_ReadersEvent.Set();
-	}
-
-private:
-	size_t m_Readers;
-	Event m_ReadersEvent, m_DataEvent;
-};
-
-class ReadLock
-{
-	DECLARE_NO_COPY_CLASS(ReadLock)
-public:
-	ReadLock(RWLock &lock) : m_Lock(lock) { lock.LockRead(); }
-	~ReadLock() { m_Lock.UnlockRead(); }
-private:
-	RWLock &m_Lock;
-};
-
-class WriteLock
-{
-	DECLARE_NO_COPY_CLASS(WriteLock)
-public:
-	WriteLock(RWLock &lock) : m_Lock(lock) { lock.LockWrite(); }
-	~WriteLock() { m_Lock.UnlockWrite(); }
-private:
-	RWLock &m_Lock;
-};
-
-//@}
-// code_threads
-
-} // namespace common
-
-#endif
+/** \file
+\brief Multithreading and synchronization library
+\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
+
+Part of CommonLib library. \n
+Encoding UTF-8, end of line CR+LF \n
+License: GNU LGPL. \n
+Documentation: \ref Module_Threads \n
+Module components: \ref code_threads
+*/
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+#pragma once
+#endif
+#ifndef COMMON_THREADS_H_
+#define COMMON_THREADS_H_
+
+namespace common
+{
+
+/** \addtogroup code_threads Threads Module
+Dokumentacja: \ref Module_Threads \n
+Nagłówek: Threads.hpp */
+//@{
+
+/// \internal
+class Thread_pimpl;
+/// \internal
+class Mutex_pimpl;
+/// \internal
+class Semaphore_pimpl;
+/// \internal
+class Cond_pimpl;
+/// \internal
+class Barrier_pimpl;
+/// \internal
+class Event_pimpl;
+
+/// Klasa bazowa wątku.
+/**
+- Odziedzicz po tej klasie, żeby zdefiniować własny typ wątku. Nadpisać metodę Thread::Run().
+- Obiekt tej klasy reprezentuje pojedynczy wątek.
+- Wątek można odpalić jeden raz - Thread::Start().
+- Przed zniszczeniem obiektu na odpalony wątek trzeba poczekać - Thread::Join().
+- Obiekt można tworzyć na stosie lub na stercie - obojętne.
+- Obiekt, jeśli alokowany new, trzeba zniszczyć delete - sam się nie zniszczy.
+*/
+class Thread
+{
+	DECLARE_NO_COPY_CLASS(Thread)
+	friend class Thread_pimpl;
+
+private:
+	scoped_ptr<Thread_pimpl> pimpl;
+	
+protected:
+	/// Napisz swoją wersję z kodem, który ma się wykonać w osobnym wątku.
+	virtual void Run() = 0;
+
+	/// Kończy działanie wątku
+	/**
+	- Wywoływać z funkcji Run().
+	- Lepiej jednak normalnie zakończyć funkcję Run.
+	  Stosowanie Exit() nie ma sensu i jest niebezpieczne dla zasobów.
+	*/
+	void Exit();
+	/// Oddaje sterowanie innemu wątkowi
+	/**
+	- Wywoływać z funkcji Run().
+	- Nazwa taka dziwna, bo jakiś cham zdefiniował makro o nazwie Yield!
+	*/
+	void Yield_();
+
+public:
+	Thread();
+	virtual ~Thread();
+
+	/// Uruchamiamia wątek.
+	void Start();
+	/// Czeka na zakończenie wątku.
+	/**
+	- Jeśli wątek już się zakończył, wychodzi od razu.
+	- Jeśli wątek jeszcze nie był odpalony albo już raz było testowane Join(), nic się nie dzieje.
+	*/
+	void Join();
+
+	/// Brutalnie zabija wątek - nie używać!
+	void Kill();
+
+// Rzeczy które nie wiem jak zrealizować w pthreads - działają tylko w Windows
+#ifdef _WIN32
+	void* GetNativeHandle(); ///< Returns HANDLE.
+	uint GetNativeId(); ///< Returns DWORD.
+	/// Zwraca true, jeśli wątek jest w tej chwili uruchomiony i naprawdę jeszcze działa
+	bool IsRunning();
+	/// Zatrzymuje wątek, wznawia wątek (posiada wewnętrzny licznik zatrzymań)
+	/**
+	- Działa tylko między Start() a Join().
+	- Raczej nie ma sensu tego używać.
+	*/
+	void Pause();
+	void Resume();
+
+	/** \name Priorytet wątku
+	Prioritytet wątku jest liczbą całkowitą. Te stałe to niektóre wartości. Mogą być też inne.
+	Ustawianie i pobieranie priotytetu wątku działa tylko między Start() a Join(). */
+	//@{
+	static const int PRIORITY_IDLE;
+	static const int PRIORITY_VERY_LOW;
+	static const int PRIORITY_LOW;
+	static const int PRIORITY_DEFAULT;
+	static const int PRIORITY_HIGH;
+	static const int PRIORITY_VERY_HIGH;
+	static const int PRIORITY_REALTIME;
+	void SetPriority(int Priority);
+	int GetPriority();
+
+	void SetThreadName(const char *s);
+	static void SetThreadNameById(uint threadId, const char *s);
+	static void SetMainThreadName(const char *s);
+	//@}
+#endif
+};
+
+/// Muteks
+/** Obiekt do wyznaczania sekcji krytycznej na wzajemnie wykluczającą się wyłączność
+jednego wątku.
+*/
+class Mutex
+{
+	DECLARE_NO_COPY_CLASS(Mutex)
+	friend class Mutex_pimpl;
+	friend class Cond;
+
+private:
+	scoped_ptr<Mutex_pimpl> pimpl;
+
+public:
+	/** \name Flagi bitowe do konstruktora */
+	//@{
+	/// Podaj, jeśli będziesz robił w ramach jednego wątku zagnieżdżone blokowania.
+	static const uint FLAG_RECURSIVE    = 0x01;
+	/// Podaj, jeśli będziesz używał metody TimeoutLock.
+	static const uint FLAG_WAIT_TIMEOUT = 0x02;
+	//@}
+
+	Mutex(uint Flag);
+	~Mutex();
+
+	/// Blokuje muteks.
+	void Lock();
+	/// Odblokowuje muteks.
+	void Unlock();
+	/// Próbuje wejść do sekcji krytycznej.
+	/**
+	- Jeśli się uda, wchodzi blokując muteks i zwraca true.
+	- Jeśli się nie uda bo muteks jest zablokowany przez inny wątek, nie blokuje sterowania tylko zawraca false.
+	*/
+	bool TryLock();
+	/// Próbuje wejść do sekcji krytycznej czekając co najwyżej podany czas.
+	/**
+	- Jeśli się uda, wchodzi blokując muteks i zwraca true.
+	- Jeśli się nie uda przez podany czas, bo muteks jest zablokowany przez inny wątek, zwraca false.
+	*/
+	bool TimeoutLock(uint Milliseconds);
+};
+
+/// Klasa pomagająca blokować muteks
+/**
+- W konstruktorze blokuje, w destruktorze odblokowuje.
+- Używaj jej zamiast metod Mutex::Lock i Mutex::Unlock kiedy tylko można.
+*/
+class MutexLock
+{
+private:
+	Mutex &m_Mutex;
+	DECLARE_NO_COPY_CLASS(MutexLock)
+
+public:
+	MutexLock(Mutex &m) : m_Mutex(m) { m.Lock(); }
+	~MutexLock() { m_Mutex.Unlock(); }
+};
+
+/**
+Dla jeszcze więszej wygody, zamiast tworzyć obiekt klasy MutexLock wystarczy na
+początku funkcji czy dowolnego bloku { } postawić to makro (M ma być typu
+Mutex*).
+*/
+#define MUTEX_LOCK(M) common::MutexLock __mutex_lock_obj(M);
+
+/// Semafor zliczający
+/**
+- Posiada wewnętrznie nieujemną wartość całkowitą, którą można sobie wyobrazić
+  jako liczbę dostępnych zasobów. Nie ma do niej dostępu bezpośrednio.
+- Wartość maksymalna tej liczby nie jest określona, jest jakaś duża.
+*/
+class Semaphore
+{
+	DECLARE_NO_COPY_CLASS(Semaphore)
+
+private:
+	scoped_ptr<Semaphore_pimpl> pimpl;
+
+public:
+	Semaphore(uint InitialValue);
+	~Semaphore();
+
+	/// Opuszcza semafor - zmniejsza jego wartość o jeden.
+	/**
+	Jeśli semafor jest zerowy, czeka aż ktoś go podniesie zanim go opuści i zwróci sterowanie.
+	*/
+	void P();
+	/// Próbuje opuścić semafor - zmniejszyć jego wartość o jeden.
+	/**
+	- Jeśli się uda, zmniejsza i zwraca true.
+	- Jeśli się nie uda bo wartość wynosi 0, nie blokuje sterowania tylko zawraca false.
+	*/
+	bool TryP();
+	/// Próbuje opuściś semafor czekając co najwyżej podany czas.
+	/**
+	- Jeśli się uda, zmniejsza i zwraca true.
+	- Jeśli się nie uda przez podany czas, bo wartość wynosi 0, zwraca false.
+	*/
+	bool TimeoutP(uint Milliseconds);
+
+	/// Podnosi semafor zwiększając go o 1. Nigdy nie blokuje.
+	void V();
+	/// Podnosi semafor zwiększając go o ReleaseCount. Nigdy nie blokuje.
+	void V(uint ReleaseCount);
+};
+
+/// Zmienna warunkowa
+/**
+Nie pamięta żadnego swojego stanu. Pozwala za to zawiesić wątek żeby na niej
+poczekał (Wait()) oraz wznowić niezdefiniowany jeden (Signal()) lub wszystkie
+(Broadcast()) czekające na niej wątki. Sensu nabiera dopiero kiedy zrozumie się
+sposób jej użycia w kontekście wzorca monitora do sprawdzania warunku.
+*/
+class Cond
+{
+	DECLARE_NO_COPY_CLASS(Cond)
+
+private:
+	scoped_ptr<Cond_pimpl> pimpl;
+
+public:
+	Cond();
+	~Cond();
+
+	/// Odblokowuje muteks, zawiesza wątek czekając na sygnał, po doczekaniu się blokuje muteks z powrotem.
+	/** Muteks m musi być zablokowany w chwili tego wywołania. */
+	void Wait(Mutex *m);
+	/// Odblokowuje muteks, zawiesza wątek czekając na sygnał przez co najwyżej podany czas, po doczekaniu się blokuje muteks z powrotem.
+	/**
+	- Jeśli w tym czasie nastąpiło przerwanie czekania przez sygnał, zwraca true.
+	- Muteks m musi być zablokowany w chwili tego wywołania.
+	*/
+	bool TimeoutWait(Mutex *m, uint Milliseconds);
+
+	/// Odwiesza przypadkowy jeden czekający wątek.
+	/**
+	- Jeśli żaden wątek nie czeka, nie robi nic.
+	- Nie jest wymagane żeby jakiś muteks musiał być zablokowany w chwili tego wywołania.
+	*/
+	void Signal();
+	/// Odwiesza wszystkie czekające wątki.
+	/**
+	- Jeśli żaden wątek nie czeka, nie robi nic.
+	- Nie jest wymagane żeby jakiś muteks musiał być zablokowany w chwili tego wywołania.
+	*/
+	void Broadcast();
+};
+
+/// Bariera
+/**
+Wątki które wywołują Wait() blokują się czekając, aż się ich uzbiera tyle
+czekających, ile wynosi przekazany do konstruktora NumThreads. Kiedy ostatni z
+nich wywoła Wait(), wszystkie ruszają dalej.
+*/
+class Barrier
+{
+	DECLARE_NO_COPY_CLASS(Barrier)
+
+private:
+	scoped_ptr<Barrier_pimpl> pimpl;
+
+public:
+	Barrier(uint NumThreads);
+	~Barrier();
+
+	void Wait();
+};
+
+/// Zdarzenie
+/**
+Ten obiekt, wzorowany na WinAPI. Jest trochę podobny do zmiennej warunkowej,
+ale ma swój stan - true lub false.
+*/
+class Event
+{
+	DECLARE_NO_COPY_CLASS(Event);
+
+private:
+	scoped_ptr<Event_pimpl> pimpl;
+
+public:
+	enum TYPE
+	{
+		/** Zdarzenie samo przywróci się do false, kiedy jakiś jeden wątek doczeka się true w wywołaniu Wait.
+		SetEvent() wznawia jeden wątek czekajacy na Wait. */
+		TYPE_AUTO_RESET,
+		/** Zdarzenie samo nie przywróci się do false.
+		SetEvent() wznawia wszystkie wątki czekające na Wait. */
+		TYPE_MANUAL_RESET,
+	};
+
+	Event(bool InitialState, TYPE Type);
+	~Event();
+
+	/// Zmienia stan na true.
+	/**
+	- Event::TYPE_AUTO_RESET: Jeśli jakieś wątki czekały, wznawia jeden i przestawia z powrotem na false.
+	- Event::TYPE_MANUAL_RESET: Jeśli jakieś wątki czekały, wznawia je wszystkie.
+	*/
+	void Set();
+	/// Zmienia stan na false.
+	void Reset();
+
+	/// Czeka, aż stan będzie true.
+	/**
+	- Jeśli już jest, zwraca sterowanie od razu.
+	- Event::TYPE_AUTO_RESET: Kiedy się doczeka, przestawia go z powrotem na false.
+	*/
+	void Wait();
+	/// Zwraca stan
+	/** Event::TYPE_AUTO_RESET: Jeśli był true, przestawia go z powrotem na false. */
+	bool Test();
+	/// Czeka, aż stan będzie true przez co najwyżej podany czas.
+	/**
+	- Jeśli jest albo się doczeka aż będzie, zwraca true.
+	- Jeśli się nie doczeka przez podany czas (stan jest cały czas false), zwraca false.
+	- Event::TYPE_AUTO_RESET: Kiedy się doczeka na stan true, przestawia go z powrotem na false.
+	*/
+	bool TimeoutWait(uint Milliseconds);
+};
+
+class RWLock
+{
+	DECLARE_NO_COPY_CLASS(RWLock)
+
+public:
+	RWLock() : m_Readers(0), m_ReadersEvent(true, Event::TYPE_AUTO_RESET), m_DataEvent(true, Event::TYPE_AUTO_RESET) { }
+
+	void LockWrite() { m_DataEvent.Wait(); }
+	bool TryLockWrite() { return m_DataEvent.Test(); }
+	bool TimeoutLockWrite(uint Milliseconds) { return m_DataEvent.TimeoutWait(Milliseconds); }
+	void UnlockWrite() { m_DataEvent.Set(); }
+
+	void LockRead()
+	{
+		m_ReadersEvent.Wait();
+		if (m_Readers++ == 0) m_DataEvent.Wait();
+		m_ReadersEvent.Set();
+	}
+	void UnlockRead()
+	{
+		m_ReadersEvent.Wait();
+		if (--m_Readers == 0) m_DataEvent.Set();
+		m_ReadersEvent.Set();
+	}
+
+private:
+	size_t m_Readers;
+	Event m_ReadersEvent, m_DataEvent;
+};
+
+class ReadLock
+{
+	DECLARE_NO_COPY_CLASS(ReadLock)
+public:
+	ReadLock(RWLock &lock) : m_Lock(lock) { lock.LockRead(); }
+	~ReadLock() { m_Lock.UnlockRead(); }
+private:
+	RWLock &m_Lock;
+};
+
+class WriteLock
+{
+	DECLARE_NO_COPY_CLASS(WriteLock)
+public:
+	WriteLock(RWLock &lock) : m_Lock(lock) { lock.LockWrite(); }
+	~WriteLock() { m_Lock.UnlockWrite(); }
+private:
+	RWLock &m_Lock;
+};
+
+/// Unit of work executed by ThreadPool.
+class ThreadTask
+{
+public:
+	virtual ~ThreadTask() { }
+	/// Override with code to execute on one of the pool threads.
+	/** Errors thrown from here are caught and rethrown by ThreadPool::WaitAll. */
+	virtual void Run() = 0;
+};
+
+/// \internal
+class ThreadPool_pimpl;
+
+/// Fixed set of worker threads executing ThreadTask objects from a shared queue.
+/**
+- Tasks are not owned by the pool - they must stay alive until WaitAll returns.
+  A task can also delete itself as the last thing in Run - the pool doesn't touch it after Run returns.
+- Tasks start in the order they were added, but may finish in any order.
+- Destructor waits for all added tasks to finish.
+*/
+class ThreadPool
+{
+	DECLARE_NO_COPY_CLASS(ThreadPool)
+
+private:
+	scoped_ptr<ThreadPool_pimpl> pimpl;
+
+public:
+	/// \param ThreadCount Number of worker threads. 0 means GetHardwareThreadCount().
+	ThreadPool(uint ThreadCount = 0);
+	~ThreadPool();
+
+	uint GetThreadCount();
+
+	/// Queues task for execution and returns immediately.
+	void AddTask(ThreadTask *Task);
+	/// Waits until all tasks added so far finished.
+	/** If any of them threw an exception, throws Error with its message
+	(the first one, if there were many). */
+	void WaitAll();
+
+	/// Returns number of logical processors available, at least 1.
+	static uint GetHardwareThreadCount();
+};
+
+//@}
+// code_threads
+
+} // namespace common
+
+#endif
@@ -1,807 +1,2502 @@
-/** \file
-\brief Persistent DOM model for a format based on Tokenizer.
-\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
-
-Part of CommonLib library. \n
-Encoding UTF-8, end of line CR+LF \n
-License: GNU LGPL. \n
-Documentation: \ref Module_TokDoc \n
-Module components: \ref code_tokdoc
-*/
-#include "Base.hpp"
-#include "TokDoc.hpp"
-#include "Tokenizer.hpp"
-
-#ifdef _WIN32
-#include "DateTime.hpp"
-#endif
-
-namespace common {
-namespace tokdoc {
-
-////////////////////////////////////////////////////////////////////////////////
-// class Node
-
-Node::Node()
-: m_Parent(NULL)
-, m_FirstChild(NULL), m_LastChild(NULL)
-, m_PrevSibling(NULL), m_NextSibling(NULL)
-{
-
-}
-
-Node::Node( const Node &src )
-: Name(src.Name)
-, Value(src.Value)
-, m_Parent(NULL)
-, m_FirstChild(NULL), m_LastChild(NULL)
-, m_PrevSibling(NULL), m_NextSibling(NULL)
-{
-	CopyChildrenFrom(src);
-}
-
-Node::Node( const tstring &value )
-: Value(value)
-, m_Parent(NULL)
-, m_FirstChild(NULL), m_LastChild(NULL)
-, m_PrevSibling(NULL), m_NextSibling(NULL)
-{
-
-}
-
-Node::Node( const tstring &name, const tstring &value )
-: Name(name)
-, Value(value)
-, m_Parent(NULL)
-, m_FirstChild(NULL), m_LastChild(NULL)
-, m_PrevSibling(NULL), m_NextSibling(NULL)
-{
-
-}
-
-Node::~Node()
-{
-	delete m_FirstChild;
-	delete m_NextSibling;
-}
-
-Node & Node::operator=( const Node &src )
-{
-	if (&src != this)
-		CopyFrom(src);
-	return *this;
-}
-
-void Node::CopyFrom( const Node &src )
-{
-	Name = src.Name;
-	Value = src.Value;
-	CopyChildrenFrom(src);
-}
-
-void Node::CopyChildrenFrom( const Node &src )
-{
-	DeleteAllChildren();
-	for (Node *srcChild = src.GetFirstChild(); srcChild; srcChild = srcChild->GetNextSibling())
-		LinkChildAtEnd(new Node(*srcChild));
-}
-
-void Node::MoveChildrenFrom( Node *src )
-{
-	DeleteAllChildren();
-	for (Node *srcChild = src->GetFirstChild(); srcChild; srcChild = srcChild->GetNextSibling())
-		srcChild->m_Parent = this;
-	m_FirstChild = src->m_FirstChild;
-	m_LastChild = src->m_LastChild;
-	src->m_FirstChild = NULL;
-	src->m_LastChild = NULL;
-}
-
-void Node::LoadChildren( Tokenizer &tok )
-{
-	DeleteAllChildren();
-
-	Node *newChild;
-	bool atEnd = tok.QueryEOF() || tok.QuerySymbol(_T('}'));
-	while (!atEnd)
-	{
-		if (tok.QuerySymbol(_T(',')) || tok.QuerySymbol(_T(';')))
-		{
-			tok.Next();
-			continue;
-		}
-
-		newChild = NULL;
-
-		// Can be name
-		if (tok.QueryToken(Tokenizer::TOKEN_IDENTIFIER, Tokenizer::TOKEN_STRING))
-		{
-			tstring s = tok.GetString();
-			tok.Next();
-
-			// It was a name
-			if (tok.QuerySymbol(_T('=')))
-			{
-				tok.Next();
-				// Name = Value
-				if (tok.QueryToken(Tokenizer::TOKEN_IDENTIFIER)
-					|| tok.QueryToken(Tokenizer::TOKEN_STRING)
-					|| tok.QueryToken(Tokenizer::TOKEN_CHAR)
-					|| tok.QueryToken(Tokenizer::TOKEN_INTEGER)
-					|| tok.QueryToken(Tokenizer::TOKEN_FLOAT))
-				{
-					LinkChildAtEnd(newChild = new Node(s, tok.GetString()));
-					tok.Next();
-				}
-				// No value
-				else
-					LinkChildAtEnd(newChild = new Node(s, tstring()));
-			}
-			// It was a value
-			else
-				LinkChildAtEnd(newChild = new Node(s));
-		}
-		// Must be value
-		else if (tok.QueryToken(Tokenizer::TOKEN_CHAR)
-			|| tok.QueryToken(Tokenizer::TOKEN_INTEGER)
-			|| tok.QueryToken(Tokenizer::TOKEN_FLOAT))
-		{
-			LinkChildAtEnd(newChild = new Node(tok.GetString()));
-			tok.Next();
-		}
-
-		// { Children... }
-		if (tok.QuerySymbol(_T('{')))
-		{
-			tok.Next();
-
-			if (newChild == NULL)
-				LinkChildAtEnd(newChild = new Node());
-
-			newChild->LoadChildren(tok);
-
-			tok.AssertSymbol(_T('}'));
-			tok.Next();
-		}
-
-		// Separator ',' or ';' (not needed at end)
-		atEnd = tok.QueryEOF() || tok.QuerySymbol(_T('}'));
-		bool isSeparator = atEnd ? false : (tok.QuerySymbol(_T(',')) || tok.QuerySymbol(_T(';')));
-		if (isSeparator)
-			tok.Next();
-		else if (!atEnd)
-			tok.CreateError();
-	}
-}
-
-/*void Node::SaveChildren( TokenWriter &tok ) const // TODO
-{
-}*/
-
-Node * Node::FindFirstChild( const tstring &name ) const
-{
-	Node *child = m_FirstChild;
-	while (child && child->Name != name)
-		child = child->GetNextSibling();
-	return child;
-}
-
-Node * Node::FindLastChild( const tstring &name ) const
-{
-	Node *child = m_LastChild;
-	while (child && child->Name != name)
-		child = child->GetPrevSibling();
-	return child;
-}
-
-Node * Node::FindPrevSibling( const tstring &name ) const
-{
-	Node *sibling = m_PrevSibling;
-	if (sibling && sibling->Name != name)
-		sibling = sibling->GetPrevSibling();
-	return sibling;
-}
-
-Node * Node::FindNextSibling( const tstring &name ) const
-{
-	Node *sibling = m_NextSibling;
-	if (sibling && sibling->Name != name)
-		sibling = sibling->GetNextSibling();
-	return sibling;
-}
-
-size_t Node::CalcChildCount() const
-{
-	size_t count = 0;
-	for (Node *child = m_FirstChild; child; child = child->GetNextSibling())
-		count++;
-	return count;
-}
-
-size_t Node::CalcChildCount( const tstring &name ) const
-{
-	size_t count = 0;
-	for (Node *child = m_FirstChild; child; child = child->GetNextSibling())
-		if (child->Name == name)
-			count++;
-	return count;
-}
-
-void Node::Clear()
-{
-	Name.clear();
-	Value.clear();
-	DeleteAllChildren();
-}
-
-void Node::DeleteAllChildren()
-{
-	delete m_FirstChild;
-	m_FirstChild = NULL;
-	m_LastChild = NULL;
-}
-
-void Node::DeleteAllChildren( const tstring &name )
-{
-	Node *child, *nextChild;
-	for (child = m_FirstChild; child; child = nextChild)
-	{
-		nextChild = child->GetNextSibling();
-		if (child->Name == name)
-			DeleteChild(child);
-	}
-}
-
-void Node::InsertChildAtBegin( const Node &addThis )
-{
-	LinkChildAtBegin(new Node(addThis));
-}
-
-void Node::InsertChildAtEnd( const Node &addThis )
-{
-	LinkChildAtEnd(new Node(addThis));
-}
-
-void Node::InsertChildBefore( Node *beforeThis, const Node &addThis )
-{
-	LinkChildBefore(beforeThis, new Node(addThis));
-
-}
-
-void Node::InsertChildAfter( Node *afterThis, const Node &addThis )
-{
-	LinkChildAfter(afterThis, new Node(addThis));
-}
-
-void Node::DeleteChild( Node *deleteThis )
-{
-	UnlinkChild(deleteThis);
-	delete deleteThis;
-}
-
-void Node::LinkChildAtBegin( Node *addThis )
-{
-	assert(addThis && addThis->m_Parent == NULL && addThis->m_PrevSibling == NULL && addThis->m_NextSibling == NULL);
-	
-	Node *beforeThis = m_FirstChild;
-	
-	addThis->m_Parent = this;
-	addThis->m_NextSibling = beforeThis;
-	
-	m_FirstChild = addThis;
-	if (beforeThis)
-		beforeThis->m_PrevSibling = addThis;
-	else
-		m_LastChild = addThis;
-}
-
-void Node::LinkChildAtEnd( Node *addThis )
-{
-	assert(addThis && addThis->m_Parent == NULL && addThis->m_PrevSibling == NULL && addThis->m_NextSibling == NULL);
-	
-	Node *afterThis = m_LastChild;
-	
-	addThis->m_Parent = this;
-	addThis->m_PrevSibling = afterThis;
-	
-	m_LastChild = addThis;
-	if (afterThis)
-		afterThis->m_NextSibling = addThis;
-	else
-		m_FirstChild = addThis;
-}
-
-void Node::LinkChildBefore( Node *beforeThis, Node *addThis )
-{
-	assert(beforeThis && beforeThis->m_Parent == this);
-	assert(addThis && addThis->m_Parent == NULL && addThis->m_PrevSibling == NULL && addThis->m_NextSibling == NULL);
-	
-	Node *afterThis = beforeThis->m_PrevSibling;
-	
-	addThis->m_Parent = this;
-	addThis->m_PrevSibling = afterThis;
-	addThis->m_NextSibling = beforeThis;
-	
-	beforeThis->m_PrevSibling = addThis;
-	if (afterThis)
-		afterThis->m_NextSibling = addThis;
-	else
-		m_FirstChild = addThis;
-}
-
-void Node::LinkChildAfter( Node *afterThis, Node *addThis )
-{
-	assert(afterThis && afterThis->m_Parent == this);
-	assert(addThis && addThis->m_Parent == NULL && addThis->m_PrevSibling == NULL && addThis->m_NextSibling == NULL);
-
-	Node *beforeThis = afterThis->m_NextSibling;
-
-	addThis->m_Parent = this;
-	addThis->m_PrevSibling = afterThis;
-	addThis->m_NextSibling = beforeThis;
-
-	if (beforeThis)
-		beforeThis->m_PrevSibling = addThis;
-	else
-		m_LastChild = addThis;
-	afterThis->m_NextSibling = addThis;
-}
-
-void Node::UnlinkChild( Node *deleteThis )
-{
-	assert(deleteThis && deleteThis->m_Parent == this);
-
-	Node *prev = deleteThis->m_PrevSibling;
-	Node *next = deleteThis->m_NextSibling;
-
-	if (prev)
-		prev->m_NextSibling = next;
-	else
-		m_FirstChild = next;
-	if (next)
-		next->m_PrevSibling = prev;
-	else
-		m_LastChild = prev;
-
-	deleteThis->m_Parent = NULL;
-	deleteThis->m_PrevSibling = NULL;
-	deleteThis->m_NextSibling = NULL;
-}
-
-Node & Node::MustFindFirstChild( const tstring &name ) const
-{
-	Node *node = FindFirstChild(name);
-	if (node == NULL)
-		throw Error(_T("TokDoc Node \"") + name + _T("\" not found"), __TFILE__, __LINE__);
-	return *node;
-}
-
-void Node::SaveChildren( TokenWriter &tok ) const
-{
-	for (Node *child = GetFirstChild(); child; child = child->GetNextSibling())
-	{
-		if (child->Name.empty() && child->Value.empty() && !child->HasChildren())
-			continue;
-
-		if (!child->Name.empty())
-		{
-			tok.WriteString(child->Name);
-			tok.WriteSymbol(_T('='));
-		}
-
-		if (!child->Value.empty())
-			tok.WriteString(child->Value);
-
-		if (child->HasChildren())
-		{
-			tok.WriteSymbol(_T('{'));
-			tok.WriteEOL();
-			child->SaveChildren(tok);
-			tok.WriteSymbol(_T('}'));
-		}
-
-		tok.WriteSymbol(_T(';'));
-		tok.WriteEOL();
-	}
-}
-
-////////////////////////////////////////////////////////////////////////////////
-// Globals
-
-void NodeValueFromEnum( Node &node, uint val, const tchar * const *itemNames, const uint *itemValues, size_t itemCount )
-{
-	node.DeleteAllChildren();
-
-	if (itemValues)
-	{
-		size_t i;
-		for (i = 0; i < itemCount; i++)
-		{
-			if (itemValues[i] == val)
-			{
-				node.Value = itemNames[i];
-				return;
-			}
-		}
-	}
-	else
-	{
-		if ((size_t)val < itemCount)
-		{
-			node.Value = itemNames[(size_t)val];
-			return;
-		}
-	}
-
-	UintToStr(&node.Value, val);
-}
-
-void NodeFrom( Node &node, const POINT_ &val )
-{
-	node.DeleteAllChildren();
-	node.Value.clear();
-
-	Node *childNode;
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.x);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.y);
-}
-
-void NodeFrom( Node &node, const RECTI &val )
-{
-	node.DeleteAllChildren();
-	node.Value.clear();
-
-	Node *childNode;
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.Min.x);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.Min.y);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.Max.x);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.Max.y);
-}
-
-void NodeFrom( Node &node, const VEC2 &val )
-{
-	node.DeleteAllChildren();
-	node.Value.clear();
-
-	Node *childNode;
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.x);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.y);
-}
-
-void NodeFrom( Node &node, const VEC3 &val )
-{
-	node.DeleteAllChildren();
-	node.Value.clear();
-
-	Node *childNode;
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.x);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.y);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.z);
-}
-
-void NodeFrom( Node &node, const VEC4 &val )
-{
-	node.DeleteAllChildren();
-	node.Value.clear();
-
-	Node *childNode;
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.x);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.y);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.z);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.w);
-}
-
-void NodeFrom( Node &node, COLOR val )
-{
-	node.DeleteAllChildren();
-
-	node.Value.reserve(10);
-	tstring valStr;
-	UintToStr2(&valStr, val.ARGB, 8, 16);
-	node.Value = _T("0x");
-	node.Value += valStr;
-}
-
-void NodeFrom( Node &node, const COLORF &val )
-{
-	node.DeleteAllChildren();
-	node.Value.clear();
-
-	Node *childNode;
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.R);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.G);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.B);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.A);
-}
-
-void NodeFrom( Node &node, const RECTF &val )
-{
-	node.DeleteAllChildren();
-	node.Value.clear();
-
-	Node *childNode;
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.Min.x);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.Min.y);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.Max.x);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.Max.y);
-}
-
-void NodeFrom( Node &node, const BOX &val )
-{
-	node.DeleteAllChildren();
-	node.Value.clear();
-
-	Node *childNode;
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.Min.x);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.Min.y);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.Min.z);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.Max.x);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.Max.y);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.Max.z);
-}
-
-void NodeFrom( Node &node, const QUATERNION &val )
-{
-	node.DeleteAllChildren();
-	node.Value.clear();
-
-	Node *childNode;
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.x);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.y);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.z);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.w);
-}
-
-void NodeFrom( Node &node, const MATRIX &val )
-{
-	node.DeleteAllChildren();
-	node.Value.clear();
-
-	Node *childNode;
-
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val._11);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val._12);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val._13);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val._14);
-
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val._21);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val._22);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val._23);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val._24);
-
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val._31);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val._32);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val._33);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val._34);
-
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val._41);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val._42);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val._43);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val._44);
-}
-
-void NodeFrom( Node &node, const AFFINE2D &val )
-{
-	node.DeleteAllChildren();
-	node.Value.clear();
-
-	Node *childNode;
-
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.a);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.b);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.c);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.d);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.e);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.f);
-}
-
-void NodeFrom( Node &node, const LINE2D &val )
-{
-	node.DeleteAllChildren();
-	node.Value.clear();
-
-	Node *childNode;
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.a);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.b);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.c);
-}
-
-void NodeFrom( Node &node, const PLANE &val )
-{
-	node.DeleteAllChildren();
-	node.Value.clear();
-
-	Node *childNode;
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.a);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.b);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.c);
-	node.LinkChildAtEnd(childNode = new Node()); NodeFrom(*childNode, val.d);
-}
-
-#ifdef _WIN32
-
-void NodeFrom( Node &node, GameTime val )
-{
-	NodeFrom(node, val.ToMilliseconds());
-}
-
-bool NodeTo( GameTime &out, const Node &node, bool required )
-{
-	__int64 milliseconds;
-	if (!NodeTo(milliseconds, node, required))
-		return false;
-	out = MillisecondsToGameTime(milliseconds);
-	return true;
-}
-
-#endif // #ifdef _WIN32
-
-bool NodeValueToEnum( uint &out, const Node &node, bool required, const tchar * const *itemNames, const uint *itemValues, size_t itemCount )
-{
-	for (size_t i = 0; i < itemCount; i++)
-	{
-		if (node.Value == itemNames[i])
-		{
-			out = itemValues ? itemValues[i] : (uint32)i;
-			return true;
-		}
-	}
-
-	if (StrToUint(&out, node.Value) == 0)
-		return true;
-
-	if (required)
-		throw Error(_T("Cannot parse TokDoc node \"") + node.Name + _T("\" = \"") + node.Value + _T("\" to enum."), __TFILE__, __LINE__);
-	return false;
-}
-
-bool NodeTo( POINT_ &out, const Node &node, bool required )
-{
-	POINT_ tmpVal;
-	uint index; Node *childNode;
-	for (childNode = node.FindFirstChild(EMPTY_STRING), index = 0; childNode && index < 2; childNode = childNode->FindNextSibling(EMPTY_STRING), index++)
-		if (!NodeTo(tmpVal[index], *childNode, required))
-			return false;
-	out = tmpVal;
-	return true;
-}
-
-bool NodeTo( RECTI &out, const Node &node, bool required )
-{
-	RECTI tmpVal;
-	uint index; Node *childNode;
-	for (childNode = node.FindFirstChild(EMPTY_STRING), index = 0; childNode && index < 4; childNode = childNode->FindNextSibling(EMPTY_STRING), index++)
-		if (!NodeTo(tmpVal[index], *childNode, required))
-			return false;
-	out = tmpVal;
-	return true;
-}
-
-bool NodeTo( VEC2 &out, const Node &node, bool required )
-{
-	VEC2 tmpVal;
-	uint index; Node *childNode;
-	for (childNode = node.FindFirstChild(EMPTY_STRING), index = 0; childNode && index < 2; childNode = childNode->FindNextSibling(EMPTY_STRING), index++)
-		if (!NodeTo(tmpVal[index], *childNode, required))
-			return false;
-	out = tmpVal;
-	return true;
-}
-
-bool NodeTo( VEC3 &out, const Node &node, bool required )
-{
-	VEC3 tmpVal;
-	uint index; Node *childNode;
-	for (childNode = node.FindFirstChild(EMPTY_STRING), index = 0; childNode && index < 3; childNode = childNode->FindNextSibling(EMPTY_STRING), index++)
-		if (!NodeTo(tmpVal[index], *childNode, required))
-			return false;
-	out = tmpVal;
-	return true;
-}
-
-bool NodeTo( VEC4 &out, const Node &node, bool required )
-{
-	VEC4 tmpVal;
-	uint index; Node *childNode;
-	for (childNode = node.FindFirstChild(EMPTY_STRING), index = 0; childNode && index < 4; childNode = childNode->FindNextSibling(EMPTY_STRING), index++)
-		if (!NodeTo(tmpVal[index], *childNode, required))
-			return false;
-	out = tmpVal;
-	return true;
-}
-
-bool NodeTo( COLOR &out, const Node &node, bool required )
-{
-	return NodeTo(out.ARGB, node, required);
-}
-
-bool NodeTo( COLORF &out, const Node &node, bool required )
-{
-	COLORF tmpVal;
-	uint index; Node *childNode;
-	for (childNode = node.FindFirstChild(EMPTY_STRING), index = 0; childNode && index < 4; childNode = childNode->FindNextSibling(EMPTY_STRING), index++)
-		if (!NodeTo(tmpVal[index], *childNode, required))
-			return false;
-	out = tmpVal;
-	return true;
-}
-
-bool NodeTo( RECTF &out, const Node &node, bool required )
-{
-	RECTF tmpVal;
-	uint index; Node *childNode;
-	for (childNode = node.FindFirstChild(EMPTY_STRING), index = 0; childNode && index < 4; childNode = childNode->FindNextSibling(EMPTY_STRING), index++)
-		if (!NodeTo(tmpVal[index], *childNode, required))
-			return false;
-	out = tmpVal;
-	return true;
-}
-
-bool NodeTo( BOX &out, const Node &node, bool required )
-{
-	BOX tmpVal;
-	uint index; Node *childNode;
-	for (childNode = node.FindFirstChild(EMPTY_STRING), index = 0; childNode && index < 6; childNode = childNode->FindNextSibling(EMPTY_STRING), index++)
-		if (!NodeTo(tmpVal[index], *childNode, required))
-			return false;
-	out = tmpVal;
-	return true;
-}
-
-bool NodeTo( QUATERNION &out, const Node &node, bool required )
-{
-	QUATERNION tmpVal;
-	uint index; Node *childNode;
-	for (childNode = node.FindFirstChild(EMPTY_STRING), index = 0; childNode && index < 4; childNode = childNode->FindNextSibling(EMPTY_STRING), index++)
-		if (!NodeTo(tmpVal[index], *childNode, required))
-			return false;
-	out = tmpVal;
-	return true;
-}
-
-bool NodeTo( MATRIX &out, const Node &node, bool required )
-{
-	MATRIX tmpVal;
-	uint index; Node *childNode;
-	for (childNode = node.FindFirstChild(EMPTY_STRING), index = 0; childNode && index < 16; childNode = childNode->FindNextSibling(EMPTY_STRING), index++)
-		if (!NodeTo(tmpVal[index], *childNode, required))
-			return false;
-	out = tmpVal;
-	return true;
-}
-
-bool NodeTo( AFFINE2D &out, const Node &node, bool required )
-{
-	AFFINE2D tmpVal;
-	uint index; Node *childNode;
-	for (childNode = node.FindFirstChild(EMPTY_STRING), index = 0; childNode && index < 6; childNode = childNode->FindNextSibling(EMPTY_STRING), index++)
-		if (!NodeTo(tmpVal[index], *childNode, required))
-			return false;
-	out = tmpVal;
-	return true;
-}
-
-bool NodeTo( LINE2D &out, const Node &node, bool required )
-{
-	LINE2D tmpVal;
-	uint index; Node *childNode;
-	for (childNode = node.FindFirstChild(EMPTY_STRING), index = 0; childNode && index < 3; childNode = childNode->FindNextSibling(EMPTY_STRING), index++)
-		if (!NodeTo(tmpVal[index], *childNode, required))
-			return false;
-	out = tmpVal;
-	return true;
-}
-
-bool NodeTo( PLANE &out, const Node &node, bool required )
-{
-	PLANE tmpVal;
-	uint index; Node *childNode;
-	for (childNode = node.FindFirstChild(EMPTY_STRING), index = 0; childNode && index < 4; childNode = childNode->FindNextSibling(EMPTY_STRING), index++)
-		if (!NodeTo(tmpVal[index], *childNode, required))
-			return false;
-	out = tmpVal;
-	return true;
-}
-
-} // namespace tokdoc
-} // namespace common
+/** \file
+\brief Persistent DOM model for a format based on Tokenizer.
+\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
+
+Part of CommonLib library. \n
+Encoding UTF-8, end of line CR+LF \n
+License: GNU LGPL. \n
+Documentation: \ref Module_TokDoc \n
+Module components: \ref code_tokdoc
+*/
+#include "Base.hpp"
+#include <cstring> // for memcpy
+#include <map>
+#include "TokDoc.hpp"
+#include "Tokenizer.hpp"
+#include "Stream.hpp"
+
+#ifdef _WIN32
+#include "DateTime.hpp"
+#endif
+
+namespace common {
+namespace tokdoc {
+
+////////////////////////////////////////////////////////////////////////////////
+// class Document_pimpl
+
+class Document_pimpl
+{
+public:
+	Document *m_Document;
+	Node m_Root;
+
+	Document_pimpl(Document *document);
+	~Document_pimpl();
+
+	Node * NewNode();
+	/// Puts the node and all its descendants on the list of free nodes.
+	void ReleaseNode(Node *node);
+	const tchar * StoreString(const tchar *s, size_t length);
+	/// Returns the only copy of given name stored in the document.
+	/** \param copy If false and the name is not stored yet, s is remembered as its copy, so it must be in document memory. */
+	const tchar * InternName(const tchar *s, size_t length, bool copy = true);
+	/// Deletes all nodes.
+	/** \param keepBlocks Memory blocks are kept for reuse instead of being freed. */
+	void Clear(bool keepBlocks);
+
+	size_t GetAllocatedBytes() const { return m_AllocatedBytes; }
+	size_t GetNameCount() const { return m_NameCount; }
+
+	void * Allocate(size_t size, size_t align);
+	/// Allocates memory that can be given back with FreeReusable. Aligned to pointer size.
+	void * AllocateReusable(size_t size);
+	/// Keeps the memory for next AllocateReusable of the same size.
+	void FreeReusable(void *p, size_t size);
+
+private:
+	static const size_t FIRST_BLOCK_SIZE = 16 * 1024;
+	static const size_t MAX_BLOCK_SIZE = 4 * 1024 * 1024;
+
+	struct BLOCK
+	{
+		BLOCK *Next;
+		size_t Size;
+	};
+	struct FREE_MEMORY
+	{
+		FREE_MEMORY *Next;
+	};
+	/// Entry of interned names hash table. Data == NULL means empty slot.
+	struct NAME
+	{
+		const tchar *Data;
+		uint32 Length;
+		uint32 Hash;
+	};
+
+	BLOCK *m_Blocks;
+	/// Blocks kept by Clear for reuse, largest first.
+	BLOCK *m_SpareBlocks;
+	char *m_Ptr, *m_End;
+	size_t m_NextBlockSize;
+	size_t m_AllocatedBytes;
+	Node *m_FreeNodes;
+	/// Lists of memory freed by FreeReusable, by size.
+	std::map<size_t, FREE_MEMORY*> m_FreeMemory;
+	// Open addressing with linear probing, size is power of 2, at most half full.
+	std::vector<NAME> m_Names;
+	size_t m_NameCount;
+
+	void FreeBlocks();
+	void GrowNames();
+};
+
+const size_t Document_pimpl::FIRST_BLOCK_SIZE;
+const size_t Document_pimpl::MAX_BLOCK_SIZE;
+
+Document_pimpl::Document_pimpl(Document *document)
+: m_Document(document)
+, m_Root(this)
+, m_Blocks(NULL)
+, m_SpareBlocks(NULL)
+, m_Ptr(NULL), m_End(NULL)
+, m_NextBlockSize(FIRST_BLOCK_SIZE)
+, m_AllocatedBytes(0)
+, m_FreeNodes(NULL)
+, m_NameCount(0)
+{
+}
+
+Document_pimpl::~Document_pimpl()
+{
+	FreeBlocks();
+}
+
+void * Document_pimpl::Allocate(size_t size, size_t align)
+{
+	char *p = (char*)AlignUp<size_t>((size_t)m_Ptr, align);
+	if (m_Ptr == NULL || p > m_End || (size_t)(m_End - p) < size)
+	{
+		BLOCK *block;
+		// Memory of a reused block is already mapped, which makes loading again much faster
+		if (m_SpareBlocks != NULL && m_SpareBlocks->Size >= sizeof(BLOCK) + size + align)
+		{
+			block = m_SpareBlocks;
+			m_SpareBlocks = block->Next;
+		}
+		else
+		{
+			// Blocks grow twice each time, so even a huge document needs only a few of them
+			size_t blockSize = std::max(m_NextBlockSize, sizeof(BLOCK) + size + align);
+			m_NextBlockSize = std::min(m_NextBlockSize * 2, MAX_BLOCK_SIZE);
+
+			block = (BLOCK*)new char[blockSize];
+			block->Size = blockSize;
+			m_AllocatedBytes += blockSize;
+		}
+		block->Next = m_Blocks;
+		m_Blocks = block;
+
+		m_Ptr = (char*)(block + 1);
+		m_End = (char*)block + block->Size;
+		p = (char*)AlignUp<size_t>((size_t)m_Ptr, align);
+	}
+	m_Ptr = p + size;
+	return p;
+}
+
+void * Document_pimpl::AllocateReusable( size_t size )
+{
+	std::map<size_t, FREE_MEMORY*>::iterator it = m_FreeMemory.find(size);
+	if (it == m_FreeMemory.end() || it->second == NULL)
+		return Allocate(std::max(size, sizeof(FREE_MEMORY)), sizeof(void*));
+	FREE_MEMORY *mem = it->second;
+	it->second = mem->Next;
+	return mem;
+}
+
+void Document_pimpl::FreeReusable( void *p, size_t size )
+{
+	FREE_MEMORY *mem = (FREE_MEMORY*)p;
+	FREE_MEMORY *&head = m_FreeMemory[size];
+	mem->Next = head;
+	head = mem;
+}
+
+void Document_pimpl::FreeBlocks()
+{
+	while (m_Blocks)
+	{
+		BLOCK *next = m_Blocks->Next;
+		delete [] (char*)m_Blocks;
+		m_Blocks = next;
+	}
+	while (m_SpareBlocks)
+	{
+		BLOCK *next = m_SpareBlocks->Next;
+		delete [] (char*)m_SpareBlocks;
+		m_SpareBlocks = next;
+	}
+	m_Ptr = m_End = NULL;
+	m_NextBlockSize = FIRST_BLOCK_SIZE;
+	m_AllocatedBytes = 0;
+}
+
+Node * Document_pimpl::NewNode()
+{
+	void *mem;
+	if (m_FreeNodes)
+	{
+		mem = m_FreeNodes;
+		m_FreeNodes = m_FreeNodes->m_NextSibling;
+	}
+	else
+		mem = Allocate(sizeof(Node), sizeof(void*));
+	// Document nodes are never destructed - their strings own no memory
+	return new (mem) Node(this);
+}
+
+void Document_pimpl::ReleaseNode( Node *node )
+{
+	node->DeleteChildIndex();
+	for (Node *child = node->m_FirstChild, *nextChild; child; child = nextChild)
+	{
+		nextChild = child->m_NextSibling;
+		ReleaseNode(child);
+	}
+	node->m_NextSibling = m_FreeNodes;
+	m_FreeNodes = node;
+}
+
+const tchar * Document_pimpl::StoreString( const tchar *s, size_t length )
+{
+	tchar *data = (tchar*)Allocate((length + 1) * sizeof(tchar), sizeof(tchar));
+	memcpy(data, s, length * sizeof(tchar));
+	data[length] = _T('\0');
+	return data;
+}
+
+const tchar * Document_pimpl::InternName( const tchar *s, size_t length, bool copy )
+{
+	if ((m_NameCount + 1) * 2 > m_Names.size())
+		GrowNames();
+
+	uint32 hash = MurmurHash(s, (uint)(length * sizeof(tchar)), 0);
+	size_t mask = m_Names.size() - 1;
+	for (size_t i = hash & mask; ; i = (i + 1) & mask)
+	{
+		NAME &name = m_Names[i];
+		if (name.Data == NULL)
+		{
+			name.Data = copy ? StoreString(s, length) : s;
+			name.Length = (uint32)length;
+			name.Hash = hash;
+			m_NameCount++;
+			return name.Data;
+		}
+		if (name.Hash == hash && name.Length == length && memcmp(name.Data, s, length * sizeof(tchar)) == 0)
+			return name.Data;
+	}
+}
+
+void Document_pimpl::GrowNames()
+{
+	std::vector<NAME> oldNames;
+	oldNames.swap(m_Names);
+	NAME emptyName = { NULL, 0, 0 };
+	m_Names.resize(std::max<size_t>(oldNames.size() * 2, 64), emptyName);
+
+	size_t mask = m_Names.size() - 1;
+	for (size_t oldIndex = 0; oldIndex < oldNames.size(); oldIndex++)
+	{
+		if (oldNames[oldIndex].Data == NULL)
+			continue;
+		size_t i = oldNames[oldIndex].Hash & mask;
+		while (m_Names[i].Data != NULL)
+			i = (i + 1) & mask;
+		m_Names[i] = oldNames[oldIndex];
+	}
+}
+
+void Document_pimpl::Clear(bool keepBlocks)
+{
+	m_Root.m_FirstChild = m_Root.m_LastChild = NULL;
+	// Its memory is in the blocks
+	m_Root.m_ChildIndex = NULL;
+	// Clearing with assign would put the empty name into memory which is about to be freed
+	m_Root.Name.Reset();
+	m_Root.Value.Reset();
+	m_FreeNodes = NULL;
+	m_FreeMemory.clear();
+	m_Names.clear();
+	m_NameCount = 0;
+
+	if (keepBlocks)
+	{
+		// Used blocks go before the spare ones - they are newest, so the largest first
+		if (m_Blocks)
+		{
+			BLOCK *last = m_Blocks;
+			while (last->Next)
+				last = last->Next;
+			last->Next = m_SpareBlocks;
+			m_SpareBlocks = m_Blocks;
+			m_Blocks = NULL;
+		}
+		m_Ptr = m_End = NULL;
+	}
+	else
+		FreeBlocks();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Binary format
+
+/*
+Binary format consists of:
+- BINARY_HEADER
+- uint32 string offsets [StringCount + 1] - in characters, last one equal to StringCharCount
+- tchar characters [StringCharCount] - all distinct strings, each with terminating zero,
+  string 0 is always empty
+- uint8 node records [RecordBytes]
+
+Records of children of the root are stored in pre-order. Each record consists of 3 varints:
+name string index, value string index, size in bytes of records of its children, which follow.
+Varints have 7 bits of value in every byte and high bit set in all but last byte.
+*/
+
+struct BINARY_HEADER
+{
+	uint32 Magic;
+	uint8 CharSize;
+	uint8 Reserved[3];
+	uint32 StringCount;
+	uint32 StringCharCount;
+	uint32 RecordBytes;
+};
+
+// "TDB1"
+static const uint32 BINARY_MAGIC = 0x31424454;
+static const size_t MAX_VAR_UINT_SIZE = 5;
+
+static void ThrowInvalidBinary(const tchar *details)
+{
+	throw Error(tstring(_T("Invalid binary TokDoc data: ")) + details, __TFILE__, __LINE__);
+}
+
+static void ValidateBinaryHeader(const BINARY_HEADER &header)
+{
+	if (header.Magic != BINARY_MAGIC)
+		ThrowInvalidBinary(_T("wrong header"));
+	if (header.CharSize != sizeof(tchar))
+		ThrowInvalidBinary(_T("different character size"));
+	if (header.StringCount == 0 || header.StringCount == 0xFFFFFFFFu || header.StringCharCount == 0)
+		ThrowInvalidBinary(_T("no string table"));
+}
+
+static inline size_t VarUintSize(uint32 v)
+{
+	size_t size = 1;
+	while (v >= 0x80)
+	{
+		v >>= 7;
+		size++;
+	}
+	return size;
+}
+
+static inline uint8 * WriteVarUint(uint8 *p, uint32 v)
+{
+	while (v >= 0x80)
+	{
+		*p++ = (uint8)(v | 0x80);
+		v >>= 7;
+	}
+	*p++ = (uint8)v;
+	return p;
+}
+
+static inline const uint8 * ReadVarUint(const uint8 *p, const uint8 *end, uint32 &out)
+{
+	// Most values fit in one byte
+	if (p < end && *p < 0x80)
+	{
+		out = *p;
+		return p + 1;
+	}
+	uint32 v = 0;
+	for (uint shift = 0; shift < MAX_VAR_UINT_SIZE * 7; shift += 7)
+	{
+		if (p == end)
+			break;
+		uint8 b = *p++;
+		v |= (uint32)(b & 0x7F) << shift;
+		if (b < 0x80)
+		{
+			out = v;
+			return p;
+		}
+	}
+	ThrowInvalidBinary(_T("bad number"));
+	return NULL;
+}
+
+/*
+Saves tree in binary format in two passes. First one gathers distinct strings and sizes
+of children records of every node in pre-order, second one writes the records.
+*/
+class BinaryWriter
+{
+public:
+	BinaryWriter();
+	void Save(const Node &root, Stream &stream);
+
+private:
+	struct STRING_SLOT
+	{
+		uint32 Hash;
+		/// String index + 1, 0 means empty slot.
+		uint32 IndexPlus1;
+	};
+
+	// Open addressing with linear probing, at most half full.
+	std::vector<STRING_SLOT> m_StringSlots;
+	uint32 m_StringCount;
+	std::vector<uint32> m_StringOffsets;
+	std::vector<tchar> m_Chars;
+	// For every node in pre-order: name index, value index, size of children records.
+	std::vector<uint32> m_NodeData;
+
+	uint32 AddString(const NodeString &s);
+	void GrowStrings();
+	size_t Measure(const Node &node);
+	uint8 * WriteRecords(const Node &node, uint8 *p, size_t &nodeIndex) const;
+};
+
+BinaryWriter::BinaryWriter()
+: m_StringCount(1)
+{
+	STRING_SLOT emptySlot = { 0, 0 };
+	m_StringSlots.resize(64, emptySlot);
+	// String 0 is empty
+	m_StringOffsets.push_back(0);
+	m_Chars.push_back(_T('\0'));
+	m_StringOffsets.push_back(1);
+}
+
+uint32 BinaryWriter::AddString( const NodeString &s )
+{
+	if (s.empty())
+		return 0;
+
+	if ((m_StringCount + 1) * 2 > m_StringSlots.size())
+		GrowStrings();
+
+	uint32 hash = MurmurHash(s.data(), (uint)(s.length() * sizeof(tchar)), 0);
+	size_t mask = m_StringSlots.size() - 1;
+	size_t i = hash & mask;
+	for ( ; m_StringSlots[i].IndexPlus1 != 0; i = (i + 1) & mask)
+	{
+		if (m_StringSlots[i].Hash == hash)
+		{
+			uint32 index = m_StringSlots[i].IndexPlus1 - 1;
+			if (s.Equals(&m_Chars[m_StringOffsets[index]], m_StringOffsets[index + 1] - m_StringOffsets[index] - 1))
+				return index;
+		}
+	}
+
+	uint32 index = m_StringCount++;
+	m_StringSlots[i].Hash = hash;
+	m_StringSlots[i].IndexPlus1 = index + 1;
+	m_Chars.insert(m_Chars.end(), s.data(), s.data() + s.length() + 1);
+	if (m_Chars.size() > 0xFFFFFFFFu)
+		throw Error(_T("TokDoc too big for binary format"), __TFILE__, __LINE__);
+	m_StringOffsets.push_back((uint32)m_Chars.size());
+	return index;
+}
+
+void BinaryWriter::GrowStrings()
+{
+	std::vector<STRING_SLOT> oldSlots(m_StringSlots.size() * 2);
+	oldSlots.swap(m_StringSlots);
+	size_t mask = m_StringSlots.size() - 1;
+	for (size_t oldIndex = 0; oldIndex < oldSlots.size(); oldIndex++)
+	{
+		if (oldSlots[oldIndex].IndexPlus1 == 0)
+			continue;
+		size_t i = oldSlots[oldIndex].Hash & mask;
+		while (m_StringSlots[i].IndexPlus1 != 0)
+			i = (i + 1) & mask;
+		m_StringSlots[i] = oldSlots[oldIndex];
+	}
+}
+
+size_t BinaryWriter::Measure( const Node &node )
+{
+	size_t size = 0;
+	for (const Node *child = node.GetFirstChild(); child; child = child->GetNextSibling())
+	{
+		size_t nodeIndex = m_NodeData.size();
+		m_NodeData.push_back(AddString(child->Name));
+		m_NodeData.push_back(AddString(child->Value));
+		m_NodeData.push_back(0);
+
+		size_t childrenSize = Measure(*child);
+		if (childrenSize > 0xFFFFFFFFu)
+			throw Error(_T("TokDoc too big for binary format"), __TFILE__, __LINE__);
+		m_NodeData[nodeIndex + 2] = (uint32)childrenSize;
+
+		size += VarUintSize(m_NodeData[nodeIndex]) + VarUintSize(m_NodeData[nodeIndex + 1]) + VarUintSize((uint32)childrenSize) + childrenSize;
+	}
+	return size;
+}
+
+uint8 * BinaryWriter::WriteRecords( const Node &node, uint8 *p, size_t &nodeIndex ) const
+{
+	for (const Node *child = node.GetFirstChild(); child; child = child->GetNextSibling())
+	{
+		p = WriteVarUint(p, m_NodeData[nodeIndex]);
+		p = WriteVarUint(p, m_NodeData[nodeIndex + 1]);
+		p = WriteVarUint(p, m_NodeData[nodeIndex + 2]);
+		nodeIndex += 3;
+		p = WriteRecords(*child, p, nodeIndex);
+	}
+	return p;
+}
+
+void BinaryWriter::Save( const Node &root, Stream &stream )
+{
+	size_t recordBytes = Measure(root);
+	if (recordBytes > 0xFFFFFFFFu)
+		throw Error(_T("TokDoc too big for binary format"), __TFILE__, __LINE__);
+
+	BINARY_HEADER header = { BINARY_MAGIC, (uint8)sizeof(tchar), { 0, 0, 0 },
+		m_StringCount, (uint32)m_Chars.size(), (uint32)recordBytes };
+	stream.Write(&header, sizeof(header));
+	stream.Write(&m_StringOffsets[0], m_StringOffsets.size() * sizeof(uint32));
+	stream.Write(&m_Chars[0], m_Chars.size() * sizeof(tchar));
+
+	if (recordBytes > 0)
+	{
+		std::vector<uint8> records(recordBytes);
+		size_t nodeIndex = 0;
+		uint8 *end = WriteRecords(root, &records[0], nodeIndex);
+		assert(end == &records[0] + recordBytes);
+		stream.Write(&records[0], recordBytes);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// class Document
+
+Document::Document()
+: pimpl(new Document_pimpl(this))
+{
+}
+
+Document::~Document()
+{
+}
+
+Node & Document::GetRoot()
+{
+	return pimpl->m_Root;
+}
+
+const Node & Document::GetRoot() const
+{
+	return pimpl->m_Root;
+}
+
+void Document::Load( Tokenizer &tok )
+{
+	pimpl->Clear(true);
+	pimpl->m_Root.LoadChildren(tok);
+}
+
+void Document::LoadBinary( Stream &stream )
+{
+	pimpl->Clear(true);
+	pimpl->m_Root.LoadChildrenBinary(stream);
+}
+
+void Document::LoadBinary( const void *data, size_t size )
+{
+	// BinaryDocument needs aligned data - other data is read like from a stream
+	if ((size_t)data % sizeof(uint32) != 0)
+	{
+		MemoryStream stream(size, const_cast<void*>(data));
+		LoadBinary(stream);
+		return;
+	}
+
+	pimpl->Clear(true);
+	BinaryDocument binDoc(data, size);
+	// Characters are copied at once, nodes refer to them
+	size_t charBytes = (binDoc.m_StringOffsets[binDoc.m_StringCount]) * sizeof(tchar);
+	tchar *chars = (tchar*)pimpl->Allocate(charBytes, sizeof(tchar));
+	memcpy(chars, binDoc.m_Chars, charBytes);
+	binDoc.m_Chars = chars;
+	binDoc.m_CharsOwner = pimpl.get();
+	binDoc.GetRoot().CopyChildrenTo(pimpl->m_Root);
+}
+
+void Document::Clear()
+{
+	pimpl->Clear(false);
+}
+
+size_t Document::GetAllocatedBytes() const
+{
+	return pimpl->GetAllocatedBytes();
+}
+
+size_t Document::GetNameCount() const
+{
+	return pimpl->GetNameCount();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// class ChildIndex
+
+/*
+Two hash tables with open addressing and linear probing, both at most half full.
+Names point to the first child with given name and the last one. Links point from every
+child to the previous and next child with the same name. Memory of a document node's
+index comes from the document, otherwise from the heap.
+*/
+class ChildIndex
+{
+public:
+	struct NAME
+	{
+		/// Name of First. NULL means empty slot.
+		const tchar *Data;
+		uint32 Length;
+		uint32 Hash;
+		Node *First, *Last;
+	};
+	struct LINK
+	{
+		/// NULL means empty slot.
+		Node *Key;
+		Node *Prev, *Next;
+	};
+
+	static ChildIndex * Create(const Node &parent);
+	static void Destroy(ChildIndex *index);
+
+	const NAME * FindName(const tchar *name, size_t length) const;
+	const LINK & GetLink(const Node *node) const { return m_Links[FindLink(node)]; }
+
+	/// Adds linked child. Returns false if its place among children with the same name was too hard to find.
+	bool Insert(Node *node);
+	/// Removes child, which must still be linked.
+	void Remove(Node *node);
+
+private:
+	/// Insert doesn't search further for previous child with the same name.
+	static const size_t MAX_INSERT_DISTANCE = 64;
+
+	Document_pimpl *m_Doc;
+	NAME *m_Names;
+	size_t m_NameCapacity, m_NameCount;
+	LINK *m_Links;
+	size_t m_LinkCapacity, m_LinkCount;
+
+	ChildIndex(Document_pimpl *doc);
+	~ChildIndex();
+
+	void * AllocateMemory(size_t size);
+	void FreeMemory(void *p, size_t size);
+
+	static uint32 HashName(const tchar *name, size_t length) { return MurmurHash(name, (uint)(length * sizeof(tchar)), 0); }
+	static size_t HashNode(const Node *node) { return (size_t)(((uintptr_t)node >> 3) * 2654435761u); }
+
+	NAME & AddName(const Node *node);
+	void RemoveName(NAME &name);
+	size_t FindLink(const Node *node) const;
+	LINK & AddLink(Node *node);
+	void RemoveLink(size_t index);
+	void GrowNames();
+	void GrowLinks();
+	void Append(Node *node);
+};
+
+ChildIndex * ChildIndex::Create( const Node &parent )
+{
+	Document_pimpl *doc = parent.GetDocumentPimpl();
+	void *mem = doc ? doc->AllocateReusable(sizeof(ChildIndex)) : new char[sizeof(ChildIndex)];
+	ChildIndex *index = new (mem) ChildIndex(doc);
+	for (Node *child = parent.GetFirstChild(); child; child = child->GetNextSibling())
+		index->Append(child);
+	return index;
+}
+
+void ChildIndex::Destroy( ChildIndex *index )
+{
+	Document_pimpl *doc = index->m_Doc;
+	index->~ChildIndex();
+	if (doc)
+		doc->FreeReusable(index, sizeof(ChildIndex));
+	else
+		delete [] (char*)index;
+}
+
+ChildIndex::ChildIndex( Document_pimpl *doc )
+: m_Doc(doc)
+, m_Names(NULL), m_NameCapacity(0), m_NameCount(0)
+, m_Links(NULL), m_LinkCapacity(0), m_LinkCount(0)
+{
+}
+
+ChildIndex::~ChildIndex()
+{
+	FreeMemory(m_Links, m_LinkCapacity * sizeof(LINK));
+	FreeMemory(m_Names, m_NameCapacity * sizeof(NAME));
+}
+
+void * ChildIndex::AllocateMemory( size_t size )
+{
+	// Index of a document node can be rebuilt many times, so its memory is reused
+	void *p = m_Doc ? m_Doc->AllocateReusable(size) : new char[size];
+	memset(p, 0, size);
+	return p;
+}
+
+void ChildIndex::FreeMemory( void *p, size_t size )
+{
+	if (p == NULL)
+		return;
+	if (m_Doc)
+		m_Doc->FreeReusable(p, size);
+	else
+		delete [] (char*)p;
+}
+
+const ChildIndex::NAME * ChildIndex::FindName( const tchar *name, size_t length ) const
+{
+	if (m_NameCount == 0)
+		return NULL;
+	uint32 hash = HashName(name, length);
+	size_t mask = m_NameCapacity - 1;
+	for (size_t i = hash & mask; m_Names[i].Data != NULL; i = (i + 1) & mask)
+	{
+		const NAME &entry = m_Names[i];
+		if (entry.Hash == hash && entry.Length == length &&
+			(entry.Data == name || memcmp(entry.Data, name, length * sizeof(tchar)) == 0))
+		{
+			return &entry;
+		}
+	}
+	return NULL;
+}
+
+ChildIndex::NAME & ChildIndex::AddName( const Node *node )
+{
+	if ((m_NameCount + 1) * 2 > m_NameCapacity)
+		GrowNames();
+
+	const NodeString &name = node->Name;
+	uint32 hash = HashName(name.data(), name.length());
+	size_t mask = m_NameCapacity - 1;
+	size_t i = hash & mask;
+	for ( ; m_Names[i].Data != NULL; i = (i + 1) & mask)
+	{
+		NAME &entry = m_Names[i];
+		if (entry.Hash == hash && name.Equals(entry.Data, entry.Length))
+			return entry;
+	}
+	NAME &entry = m_Names[i];
+	entry.Data = name.data();
+	entry.Length = (uint32)name.length();
+	entry.Hash = hash;
+	entry.First = entry.Last = NULL;
+	m_NameCount++;
+	return entry;
+}
+
+void ChildIndex::RemoveName( NAME &name )
+{
+	// Shift following entries back, so no tombstones are needed
+	size_t mask = m_NameCapacity - 1;
+	size_t hole = &name - m_Names;
+	for (size_t i = (hole + 1) & mask; m_Names[i].Data != NULL; i = (i + 1) & mask)
+	{
+		size_t home = m_Names[i].Hash & mask;
+		if (((i - home) & mask) >= ((i - hole) & mask))
+		{
+			m_Names[hole] = m_Names[i];
+			hole = i;
+		}
+	}
+	m_Names[hole].Data = NULL;
+	m_NameCount--;
+}
+
+size_t ChildIndex::FindLink( const Node *node ) const
+{
+	size_t mask = m_LinkCapacity - 1;
+	size_t i = HashNode(node) & mask;
+	while (m_Links[i].Key != node)
+	{
+		assert(m_Links[i].Key != NULL);
+		i = (i + 1) & mask;
+	}
+	return i;
+}
+
+ChildIndex::LINK & ChildIndex::AddLink( Node *node )
+{
+	if ((m_LinkCount + 1) * 2 > m_LinkCapacity)
+		GrowLinks();
+
+	size_t mask = m_LinkCapacity - 1;
+	size_t i = HashNode(node) & mask;
+	while (m_Links[i].Key != NULL)
+		i = (i + 1) & mask;
+	LINK &link = m_Links[i];
+	link.Key = node;
+	link.Prev = link.Next = NULL;
+	m_LinkCount++;
+	return link;
+}
+
+void ChildIndex::RemoveLink( size_t index )
+{
+	size_t mask = m_LinkCapacity - 1;
+	size_t hole = index;
+	for (size_t i = (hole + 1) & mask; m_Links[i].Key != NULL; i = (i + 1) & mask)
+	{
+		size_t home = HashNode(m_Links[i].Key) & mask;
+		if (((i - home) & mask) >= ((i - hole) & mask))
+		{
+			m_Links[hole] = m_Links[i];
+			hole = i;
+		}
+	}
+	m_Links[hole].Key = NULL;
+	m_LinkCount--;
+}
+
+void ChildIndex::GrowNames()
+{
+	NAME *oldNames = m_Names;
+	size_t oldCapacity = m_NameCapacity;
+	m_NameCapacity = std::max<size_t>(oldCapacity * 2, 16);
+	m_Names = (NAME*)AllocateMemory(m_NameCapacity * sizeof(NAME));
+
+	size_t mask = m_NameCapacity - 1;
+	for (size_t oldIndex = 0; oldIndex < oldCapacity; oldIndex++)
+	{
+		if (oldNames[oldIndex].Data == NULL)
+			continue;
+		size_t i = oldNames[oldIndex].Hash & mask;
+		while (m_Names[i].Data != NULL)
+			i = (i + 1) & mask;
+		m_Names[i] = oldNames[oldIndex];
+	}
+	FreeMemory(oldNames, oldCapacity * sizeof(NAME));
+}
+
+void ChildIndex::GrowLinks()
+{
+	LINK *oldLinks = m_Links;
+	size_t oldCapacity = m_LinkCapacity;
+	m_LinkCapacity = std::max<size_t>(oldCapacity * 2, 64);
+	m_Links = (LINK*)AllocateMemory(m_LinkCapacity * sizeof(LINK));
+
+	size_t mask = m_LinkCapacity - 1;
+	for (size_t oldIndex = 0; oldIndex < oldCapacity; oldIndex++)
+	{
+		if (oldLinks[oldIndex].Key == NULL)
+			continue;
+		size_t i = HashNode(oldLinks[oldIndex].Key) & mask;
+		while (m_Links[i].Key != NULL)
+			i = (i + 1) & mask;
+		m_Links[i] = oldLinks[oldIndex];
+	}
+	FreeMemory(oldLinks, oldCapacity * sizeof(LINK));
+}
+
+void ChildIndex::Append( Node *node )
+{
+	NAME &name = AddName(node);
+	LINK &link = AddLink(node);
+	link.Prev = name.Last;
+	if (name.Last)
+		m_Links[FindLink(name.Last)].Next = node;
+	else
+	{
+		name.First = node;
+		name.Data = node->Name.data();
+	}
+	name.Last = node;
+}
+
+bool ChildIndex::Insert( Node *node )
+{
+	// Last child or the only one with its name
+	if (node->GetNextSibling() == NULL || FindName(node->Name.data(), node->Name.length()) == NULL)
+	{
+		Append(node);
+		return true;
+	}
+
+	// Otherwise find previous sibling with the same name
+	Node *prev = node->GetPrevSibling();
+	for (size_t distance = 0; prev && prev->Name != node->Name; prev = prev->GetPrevSibling())
+	{
+		if (++distance == MAX_INSERT_DISTANCE)
+			return false;
+	}
+
+	NAME &name = AddName(node);
+	LINK &link = AddLink(node);
+	link.Prev = prev;
+	if (prev)
+	{
+		LINK &prevLink = m_Links[FindLink(prev)];
+		link.Next = prevLink.Next;
+		prevLink.Next = node;
+	}
+	else
+	{
+		link.Next = name.First;
+		name.First = node;
+		name.Data = node->Name.data();
+	}
+	if (link.Next)
+		m_Links[FindLink(link.Next)].Prev = node;
+	else
+		name.Last = node;
+	return true;
+}
+
+void ChildIndex::Remove( Node *node )
+{
+	size_t linkIndex = FindLink(node);
+	Node *prev = m_Links[linkIndex].Prev;
+	Node *next = m_Links[linkIndex].Next;
+	RemoveLink(linkIndex);
+
+	NAME &name = const_cast<NAME&>(*FindName(node->Name.data(), node->Name.length()));
+	if (prev)
+		m_Links[FindLink(prev)].Next = next;
+	else if (next)
+	{
+		name.First = next;
+		name.Data = next->Name.data();
+	}
+	if (next)
+		m_Links[FindLink(next)].Prev = prev;
+	else
+		name.Last = prev;
+
+	if (name.First == node)
+		RemoveName(name);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// class NodeString
+
+NodeString::NodeString( const NodeString &src )
+: m_Data(m_Inline)
+, m_Length(0)
+, m_IsName(false)
+, m_Doc(NULL)
+{
+	m_Inline[0] = _T('\0');
+	Set(src.m_Data, src.m_Length);
+}
+
+NodeString::~NodeString()
+{
+	if (m_Doc == NULL && m_Data != m_Inline)
+		delete [] m_Data;
+}
+
+NodeString & NodeString::operator=( const NodeString &src )
+{
+	Node *indexedParent = m_IsName ? Node::FromName(this)->BeginNameChange() : NULL;
+
+	// Strings in document memory never change, so they can be shared within the document,
+	// but a name must stay interned
+	if (m_Doc != NULL && m_Doc == src.m_Doc && src.m_Data != src.m_Inline && (src.m_IsName || !m_IsName))
+	{
+		m_Data = src.m_Data;
+		m_Length = src.m_Length;
+	}
+	else
+		Set(src.m_Data, src.m_Length);
+
+	if (indexedParent)
+		Node::FromName(this)->EndNameChange(indexedParent);
+	return *this;
+}
+
+NodeString & NodeString::operator=( const tchar *src )
+{
+	assign(src, common_strlen(src));
+	return *this;
+}
+
+void NodeString::assign( const tchar *src, size_t length )
+{
+	Node *indexedParent = m_IsName ? Node::FromName(this)->BeginNameChange() : NULL;
+	Set(src, length);
+	if (indexedParent)
+		Node::FromName(this)->EndNameChange(indexedParent);
+}
+
+void NodeString::Set( const tchar *src, size_t length )
+{
+	assert(length <= 0xFFFFFFFFu);
+	const tchar *oldHeapData = (m_Doc == NULL && m_Data != m_Inline) ? m_Data : NULL;
+
+	if (m_Doc != NULL && m_IsName)
+		m_Data = m_Doc->InternName(src, length);
+	else if (length < INLINE_CAPACITY)
+	{
+		memmove(m_Inline, src, length * sizeof(tchar));
+		m_Inline[length] = _T('\0');
+		m_Data = m_Inline;
+	}
+	else if (m_Doc != NULL)
+		m_Data = m_Doc->StoreString(src, length);
+	else
+	{
+		tchar *data = new tchar[length + 1];
+		memcpy(data, src, length * sizeof(tchar));
+		data[length] = _T('\0');
+		m_Data = data;
+	}
+	m_Length = (uint32)length;
+
+	// src may point into the old data
+	delete [] oldHeapData;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// class Node
+
+Node::Node()
+: m_Parent(NULL)
+, m_FirstChild(NULL), m_LastChild(NULL)
+, m_PrevSibling(NULL), m_NextSibling(NULL)
+, m_ChildIndex(NULL)
+{
+	Name.m_IsName = true;
+}
+
+Node::Node( const Node &src )
+: m_Parent(NULL)
+, m_FirstChild(NULL), m_LastChild(NULL)
+, m_PrevSibling(NULL), m_NextSibling(NULL)
+, m_ChildIndex(NULL)
+{
+	Name.m_IsName = true;
+	CopyFrom(src);
+}
+
+Node::Node( const tstring &value )
+: m_Parent(NULL)
+, m_FirstChild(NULL), m_LastChild(NULL)
+, m_PrevSibling(NULL), m_NextSibling(NULL)
+, m_ChildIndex(NULL)
+{
+	Name.m_IsName = true;
+	Value = value;
+}
+
+Node::Node( const tstring &name, const tstring &value )
+: m_Parent(NULL)
+, m_FirstChild(NULL), m_LastChild(NULL)
+, m_PrevSibling(NULL), m_NextSibling(NULL)
+, m_ChildIndex(NULL)
+{
+	Name.m_IsName = true;
+	Name = name;
+	Value = value;
+}
+
+Node::Node( Document_pimpl *doc )
+: m_Parent(NULL)
+, m_FirstChild(NULL), m_LastChild(NULL)
+, m_PrevSibling(NULL), m_NextSibling(NULL)
+, m_ChildIndex(NULL)
+{
+	Name.m_IsName = true;
+	Name.m_Doc = doc;
+	Value.m_Doc = doc;
+}
+
+Node::~Node()
+{
+	// Children of a document node belong to the document
+	if (GetDocumentPimpl() == NULL)
+		DeleteAllChildren();
+}
+
+void Node::BuildChildIndex() const
+{
+	assert(m_ChildIndex == NULL);
+	m_ChildIndex = ChildIndex::Create(*this);
+}
+
+void Node::DeleteChildIndex() const
+{
+	if (m_ChildIndex)
+	{
+		ChildIndex::Destroy(m_ChildIndex);
+		m_ChildIndex = NULL;
+	}
+}
+
+Node * Node::BeginNameChange()
+{
+	if (m_Parent == NULL || m_Parent->m_ChildIndex == NULL)
+		return NULL;
+	m_Parent->m_ChildIndex->Remove(this);
+	return m_Parent;
+}
+
+void Node::EndNameChange( Node *indexedParent )
+{
+	if (!indexedParent->m_ChildIndex->Insert(this))
+		indexedParent->DeleteChildIndex();
+}
+
+Node & Node::operator=( const Node &src )
+{
+	if (&src != this)
+		CopyFrom(src);
+	return *this;
+}
+
+Node * Node::CreateNode() const
+{
+	Document_pimpl *doc = GetDocumentPimpl();
+	return doc ? doc->NewNode() : new Node();
+}
+
+Node * Node::CreateNode( const tstring &value ) const
+{
+	Node *node = CreateNode();
+	node->Value = value;
+	return node;
+}
+
+Node * Node::CreateNode( const tstring &name, const tstring &value ) const
+{
+	Node *node = CreateNode();
+	node->Name = name;
+	node->Value = value;
+	return node;
+}
+
+Document * Node::GetDocument() const
+{
+	Document_pimpl *doc = GetDocumentPimpl();
+	return doc ? doc->m_Document : NULL;
+}
+
+void Node::DestroyNode( Node *node )
+{
+	Document_pimpl *doc = node->GetDocumentPimpl();
+	if (doc)
+		doc->ReleaseNode(node);
+	else
+		delete node;
+}
+
+void Node::CopyFrom( const Node &src )
+{
+	Name = src.Name;
+	Value = src.Value;
+	CopyChildrenFrom(src);
+}
+
+void Node::CopyChildrenFrom( const Node &src )
+{
+	DeleteAllChildren();
+	for (Node *srcChild = src.GetFirstChild(); srcChild; srcChild = srcChild->GetNextSibling())
+	{
+		Node *child = CreateNode();
+		LinkChildAtEnd(child);
+		child->CopyFrom(*srcChild);
+	}
+}
+
+void Node::MoveChildrenFrom( Node *src )
+{
+	// Nodes can't move between documents - copy them
+	if (src->GetDocumentPimpl() != GetDocumentPimpl())
+	{
+		CopyChildrenFrom(*src);
+		src->DeleteAllChildren();
+		return;
+	}
+
+	DeleteAllChildren();
+	src->DeleteChildIndex();
+	for (Node *srcChild = src->GetFirstChild(); srcChild; srcChild = srcChild->GetNextSibling())
+		srcChild->m_Parent = this;
+	m_FirstChild = src->m_FirstChild;
+	m_LastChild = src->m_LastChild;
+	src->m_FirstChild = NULL;
+	src->m_LastChild = NULL;
+}
+
+void Node::LoadChildren( Tokenizer &tok )
+{
+	DeleteAllChildren();
+
+	Node *newChild;
+	// First string is a name or a value - we know after the next token
+	tstring s;
+	bool atEnd = tok.QueryEOF() || tok.QuerySymbol(_T('}'));
+	while (!atEnd)
+	{
+		if (tok.QuerySymbol(_T(',')) || tok.QuerySymbol(_T(';')))
+		{
+			tok.Next();
+			continue;
+		}
+
+		newChild = NULL;
+
+		// Can be name
+		if (tok.QueryToken(Tokenizer::TOKEN_IDENTIFIER, Tokenizer::TOKEN_STRING))
+		{
+			s.assign(tok.GetStringPtr(), tok.GetStringLength());
+			tok.Next();
+
+			LinkChildAtEnd(newChild = CreateNode());
+			// It was a name
+			if (tok.QuerySymbol(_T('=')))
+			{
+				tok.Next();
+				newChild->Name = s;
+				// Name = Value
+				if (tok.QueryToken(Tokenizer::TOKEN_IDENTIFIER)
+					|| tok.QueryToken(Tokenizer::TOKEN_STRING)
+					|| tok.QueryToken(Tokenizer::TOKEN_CHAR)
+					|| tok.QueryToken(Tokenizer::TOKEN_INTEGER)
+					|| tok.QueryToken(Tokenizer::TOKEN_FLOAT))
+				{
+					newChild->Value.assign(tok.GetStringPtr(), tok.GetStringLength());
+					tok.Next();
+				}
+				// No value
+			}
+			// It was a value
+			else
+				newChild->Value = s;
+		}
+		// Must be value
+		else if (tok.QueryToken(Tokenizer::TOKEN_CHAR)
+			|| tok.QueryToken(Tokenizer::TOKEN_INTEGER)
+			|| tok.QueryToken(Tokenizer::TOKEN_FLOAT))
+		{
+			LinkChildAtEnd(newChild = CreateNode());
+			newChild->Value.assign(tok.GetStringPtr(), tok.GetStringLength());
+			tok.Next();
+		}
+
+		// { Children... }
+		if (tok.QuerySymbol(_T('{')))
+		{
+			tok.Next();
+
+			if (newChild == NULL)
+				LinkChildAtEnd(newChild = CreateNode());
+
+			newChild->LoadChildren(tok);
+
+			tok.AssertSymbol(_T('}'));
+			tok.Next();
+		}
+
+		// Separator ',' or ';' (not needed at end)
+		atEnd = tok.QueryEOF() || tok.QuerySymbol(_T('}'));
+		bool isSeparator = atEnd ? false : (tok.QuerySymbol(_T(',')) || tok.QuerySymbol(_T(';')));
+		if (isSeparator)
+			tok.Next();
+		else if (!atEnd)
+			tok.CreateError();
+	}
+}
+
+/*void Node::SaveChildren( TokenWriter &tok ) const // TODO
+{
+}*/
+
+Node * Node::FindFirstChild( const tstring &name ) const
+{
+	if (m_ChildIndex)
+	{
+		const ChildIndex::NAME *entry = m_ChildIndex->FindName(name.data(), name.length());
+		return entry ? entry->First : NULL;
+	}
+
+	Node *child = m_FirstChild;
+	size_t visited = 0;
+	for ( ; child && child->Name != name; child = child->GetNextSibling())
+		visited++;
+	if (visited >= CHILD_INDEX_MIN_VISITED)
+		BuildChildIndex();
+	return child;
+}
+
+Node * Node::FindLastChild( const tstring &name ) const
+{
+	if (m_ChildIndex)
+	{
+		const ChildIndex::NAME *entry = m_ChildIndex->FindName(name.data(), name.length());
+		return entry ? entry->Last : NULL;
+	}
+
+	Node *child = m_LastChild;
+	size_t visited = 0;
+	for ( ; child && child->Name != name; child = child->GetPrevSibling())
+		visited++;
+	if (visited >= CHILD_INDEX_MIN_VISITED)
+		BuildChildIndex();
+	return child;
+}
+
+Node * Node::FindPrevSibling( const tstring &name ) const
+{
+	// Index knows only siblings with the same name as this node
+	bool sameName = m_Parent && Name == name;
+	if (sameName && m_Parent->m_ChildIndex)
+		return m_Parent->m_ChildIndex->GetLink(this).Prev;
+
+	Node *sibling = m_PrevSibling;
+	size_t visited = 0;
+	for ( ; sibling && sibling->Name != name; sibling = sibling->GetPrevSibling())
+		visited++;
+	if (sameName && visited >= CHILD_INDEX_MIN_VISITED && m_Parent->m_ChildIndex == NULL)
+		m_Parent->BuildChildIndex();
+	return sibling;
+}
+
+Node * Node::FindNextSibling( const tstring &name ) const
+{
+	return FindNextSibling(name.data(), name.length());
+}
+
+Node * Node::FindNextSibling( const tchar *name, size_t length ) const
+{
+	bool sameName = m_Parent && Name.Equals(name, length);
+	if (sameName && m_Parent->m_ChildIndex)
+		return m_Parent->m_ChildIndex->GetLink(this).Next;
+
+	Node *sibling = m_NextSibling;
+	size_t visited = 0;
+	for ( ; sibling && !sibling->Name.Equals(name, length); sibling = sibling->GetNextSibling())
+		visited++;
+	if (sameName && visited >= CHILD_INDEX_MIN_VISITED && m_Parent->m_ChildIndex == NULL)
+		m_Parent->BuildChildIndex();
+	return sibling;
+}
+
+NamedChildRange Node::FindAllChildren( const tstring &name ) const
+{
+	return NamedChildRange(FindFirstChild(name));
+}
+
+size_t Node::CalcChildCount() const
+{
+	size_t count = 0;
+	for (Node *child = m_FirstChild; child; child = child->GetNextSibling())
+		count++;
+	return count;
+}
+
+size_t Node::CalcChildCount( const tstring &name ) const
+{
+	size_t count = 0;
+	for (Node *child = FindFirstChild(name); child; child = child->FindNextSibling(name))
+		count++;
+	return count;
+}
+
+void Node::Clear()
+{
+	Name.clear();
+	Value.clear();
+	DeleteAllChildren();
+}
+
+void Node::DeleteAllChildren()
+{
+	// Iteratively, so a long list of siblings doesn't exhaust the stack
+	Node *child = m_FirstChild, *nextChild;
+	m_FirstChild = NULL;
+	m_LastChild = NULL;
+	DeleteChildIndex();
+	for ( ; child; child = nextChild)
+	{
+		nextChild = child->m_NextSibling;
+		child->m_Parent = NULL;
+		child->m_PrevSibling = NULL;
+		child->m_NextSibling = NULL;
+		DestroyNode(child);
+	}
+}
+
+void Node::DeleteAllChildren( const tstring &name )
+{
+	Node *child, *nextChild;
+	for (child = FindFirstChild(name); child; child = nextChild)
+	{
+		nextChild = child->FindNextSibling(name);
+		DeleteChild(child);
+	}
+}
+
+void Node::InsertChildAtBegin( const Node &addThis )
+{
+	Node *node = CreateNode();
+	node->CopyFrom(addThis);
+	LinkChildAtBegin(node);
+}
+
+void Node::InsertChildAtEnd( const Node &addThis )
+{
+	Node *node = CreateNode();
+	node->CopyFrom(addThis);
+	LinkChildAtEnd(node);
+}
+
+void Node::InsertChildBefore( Node *beforeThis, const Node &addThis )
+{
+	Node *node = CreateNode();
+	node->CopyFrom(addThis);
+	LinkChildBefore(beforeThis, node);
+}
+
+void Node::InsertChildAfter( Node *afterThis, const Node &addThis )
+{
+	Node *node = CreateNode();
+	node->CopyFrom(addThis);
+	LinkChildAfter(afterThis, node);
+}
+
+void Node::DeleteChild( Node *deleteThis )
+{
+	UnlinkChild(deleteThis);
+	DestroyNode(deleteThis);
+}
+
+void Node::LinkChildAtBegin( Node *addThis )
+{
+	assert(addThis && addThis->m_Parent == NULL && addThis->m_PrevSibling == NULL && addThis->m_NextSibling == NULL);
+	assert(addThis->GetDocumentPimpl() == GetDocumentPimpl());
+	
+	Node *beforeThis = m_FirstChild;
+	
+	addThis->m_Parent = this;
+	addThis->m_NextSibling = beforeThis;
+	
+	m_FirstChild = addThis;
+	if (beforeThis)
+		beforeThis->m_PrevSibling = addThis;
+	else
+		m_LastChild = addThis;
+
+	if (m_ChildIndex && !m_ChildIndex->Insert(addThis))
+		DeleteChildIndex();
+}
+
+void Node::LinkChildAtEnd( Node *addThis )
+{
+	assert(addThis && addThis->m_Parent == NULL && addThis->m_PrevSibling == NULL && addThis->m_NextSibling == NULL);
+	assert(addThis->GetDocumentPimpl() == GetDocumentPimpl());
+	
+	Node *afterThis = m_LastChild;
+	
+	addThis->m_Parent = this;
+	addThis->m_PrevSibling = afterThis;
+	
+	m_LastChild = addThis;
+	if (afterThis)
+		afterThis->m_NextSibling = addThis;
+	else
+		m_FirstChild = addThis;
+
+	if (m_ChildIndex && !m_ChildIndex->Insert(addThis))
+		DeleteChildIndex();
+}
+
+void Node::LinkChildBefore( Node *beforeThis, Node *addThis )
+{
+	assert(beforeThis && beforeThis->m_Parent == this);
+	assert(addThis && addThis->m_Parent == NULL && addThis->m_PrevSibling == NULL && addThis->m_NextSibling == NULL);
+	assert(addThis->GetDocumentPimpl() == GetDocumentPimpl());
+	
+	Node *afterThis = beforeThis->m_PrevSibling;
+	
+	addThis->m_Parent = this;
+	addThis->m_PrevSibling = afterThis;
+	addThis->m_NextSibling = beforeThis;
+	
+	beforeThis->m_PrevSibling = addThis;
+	if (afterThis)
+		afterThis->m_NextSibling = addThis;
+	else
+		m_FirstChild = addThis;
+
+	if (m_ChildIndex && !m_ChildIndex->Insert(addThis))
+		DeleteChildIndex();
+}
+
+void Node::LinkChildAfter( Node *afterThis, Node *addThis )
+{
+	assert(afterThis && afterThis->m_Parent == this);
+	assert(addThis && addThis->m_Parent == NULL && addThis->m_PrevSibling == NULL && addThis->m_NextSibling == NULL);
+	assert(addThis->GetDocumentPimpl() == GetDocumentPimpl());
+
+	Node *beforeThis = afterThis->m_NextSibling;
+
+	addThis->m_Parent = this;
+	addThis->m_PrevSibling = afterThis;
+	addThis->m_NextSibling = beforeThis;
+
+	if (beforeThis)
+		beforeThis->m_PrevSibling = addThis;
+	else
+		m_LastChild = addThis;
+	afterThis->m_NextSibling = addThis;
+
+	if (m_ChildIndex && !m_ChildIndex->Insert(addThis))
+		DeleteChildIndex();
+}
+
+void Node::UnlinkChild( Node *deleteThis )
+{
+	assert(deleteThis && deleteThis->m_Parent == this);
+
+	if (m_ChildIndex)
+		m_ChildIndex->Remove(deleteThis);
+
+	Node *prev = deleteThis->m_PrevSibling;
+	Node *next = deleteThis->m_NextSibling;
+
+	if (prev)
+		prev->m_NextSibling = next;
+	else
+		m_FirstChild = next;
+	if (next)
+		next->m_PrevSibling = prev;
+	else
+		m_LastChild = prev;
+
+	deleteThis->m_Parent = NULL;
+	deleteThis->m_PrevSibling = NULL;
+	deleteThis->m_NextSibling = NULL;
+}
+
+Node & Node::MustFindFirstChild( const tstring &name ) const
+{
+	Node *node = FindFirstChild(name);
+	if (node == NULL)
+		throw Error(_T("TokDoc Node \"") + name + _T("\" not found"), __TFILE__, __LINE__);
+	return *node;
+}
+
+void Node::SaveChildren( TokenWriter &tok ) const
+{
+	for (Node *child = GetFirstChild(); child; child = child->GetNextSibling())
+	{
+		if (child->Name.empty() && child->Value.empty() && !child->HasChildren())
+			continue;
+
+		if (!child->Name.empty())
+		{
+			tok.WriteString(child->Name.data(), child->Name.length());
+			tok.WriteSymbol(_T('='));
+		}
+
+		if (!child->Value.empty())
+			tok.WriteString(child->Value.data(), child->Value.length());
+
+		if (child->HasChildren())
+		{
+			tok.WriteSymbol(_T('{'));
+			tok.WriteEOL();
+			child->SaveChildren(tok);
+			tok.WriteSymbol(_T('}'));
+		}
+
+		tok.WriteSymbol(_T(';'));
+		tok.WriteEOL();
+	}
+}
+
+// Reads count elements in limited portions, so a damaged count in the header ends with
+// an error at the end of data instead of allocating a huge buffer first.
+template <typename T>
+static void ReadBinaryArray(Stream &stream, std::vector<T> &out, size_t count)
+{
+	const size_t MAX_PORTION = 1024 * 1024 / sizeof(T);
+	out.clear();
+	while (out.size() < count)
+	{
+		size_t oldSize = out.size();
+		size_t portion = std::min(count - oldSize, std::max(oldSize, MAX_PORTION));
+		out.resize(oldSize + portion);
+		stream.MustRead(&out[oldSize], portion * sizeof(T));
+	}
+}
+
+void Node::LoadChildrenBinary( Stream &stream )
+{
+	DeleteAllChildren();
+
+	BINARY_HEADER header;
+	stream.MustRead(&header, sizeof(header));
+	ValidateBinaryHeader(header);
+
+	std::vector<uint32> stringOffsets;
+	ReadBinaryArray(stream, stringOffsets, (size_t)header.StringCount + 1);
+	if (stringOffsets[header.StringCount] != header.StringCharCount)
+		ThrowInvalidBinary(_T("bad string table"));
+
+	std::vector<tchar> charVector;
+	ReadBinaryArray(stream, charVector, header.StringCharCount);
+	// Node of a document gets the characters in document memory and refers to them
+	Document_pimpl *doc = GetDocumentPimpl();
+	const tchar *chars = &charVector[0];
+	if (doc)
+	{
+		tchar *docChars = (tchar*)doc->Allocate(charVector.size() * sizeof(tchar), sizeof(tchar));
+		memcpy(docChars, &charVector[0], charVector.size() * sizeof(tchar));
+		chars = docChars;
+	}
+
+	std::vector<uint8> records;
+	ReadBinaryArray(stream, records, header.RecordBytes);
+
+	BinaryDocument binDoc(header.StringCount, &stringOffsets[0], chars, records.empty() ? NULL : &records[0], records.size(), doc);
+	binDoc.GetRoot().CopyChildrenTo(*this);
+}
+
+void Node::SaveChildrenBinary( Stream &stream ) const
+{
+	BinaryWriter writer;
+	writer.Save(*this, stream);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// class NodeReader
+
+NodeReader::NodeReader( Tokenizer &tok )
+: m_Tok(tok)
+, m_Event(EVENT_NONE)
+, m_Depth(0)
+, m_HasChildren(false)
+, m_LeafEndPending(false)
+{
+}
+
+NodeReader::EVENT NodeReader::Next()
+{
+	if (m_Event == EVENT_END)
+		return m_Event;
+
+	if (m_LeafEndPending)
+	{
+		m_LeafEndPending = false;
+		FinishNode();
+		return m_Event = EVENT_END_NODE;
+	}
+
+	// Depth of the next node - children of a node with children are one level deeper
+	if (m_Event == EVENT_BEGIN_NODE)
+		m_Depth++;
+
+	while (m_Tok.QuerySymbol(_T(',')) || m_Tok.QuerySymbol(_T(';')))
+		m_Tok.Next();
+
+	if (m_Tok.QueryEOF() || m_Tok.QuerySymbol(_T('}')))
+	{
+		if (m_Depth == 0)
+			return m_Event = EVENT_END;
+		// Children of a node end
+		if (m_Tok.QueryEOF())
+			m_Tok.CreateError(_T("Unexpected end of TokDoc document"));
+		EndChildren();
+		return m_Event = EVENT_END_NODE;
+	}
+
+	m_Name.clear();
+	m_Value.clear();
+	bool any = false;
+	// Can be name
+	if (m_Tok.QueryToken(Tokenizer::TOKEN_IDENTIFIER, Tokenizer::TOKEN_STRING))
+	{
+		m_Value.assign(m_Tok.GetStringPtr(), m_Tok.GetStringLength());
+		m_Tok.Next();
+		any = true;
+		// It was a name
+		if (m_Tok.QuerySymbol(_T('=')))
+		{
+			m_Tok.Next();
+			m_Name.swap(m_Value);
+			m_Value.clear();
+			// Name = Value
+			if (m_Tok.QueryToken(Tokenizer::TOKEN_IDENTIFIER)
+				|| m_Tok.QueryToken(Tokenizer::TOKEN_STRING)
+				|| m_Tok.QueryToken(Tokenizer::TOKEN_CHAR)
+				|| m_Tok.QueryToken(Tokenizer::TOKEN_INTEGER)
+				|| m_Tok.QueryToken(Tokenizer::TOKEN_FLOAT))
+			{
+				m_Value.assign(m_Tok.GetStringPtr(), m_Tok.GetStringLength());
+				m_Tok.Next();
+			}
+		}
+	}
+	// Must be value
+	else if (m_Tok.QueryToken(Tokenizer::TOKEN_CHAR)
+		|| m_Tok.QueryToken(Tokenizer::TOKEN_INTEGER)
+		|| m_Tok.QueryToken(Tokenizer::TOKEN_FLOAT))
+	{
+		m_Value.assign(m_Tok.GetStringPtr(), m_Tok.GetStringLength());
+		m_Tok.Next();
+		any = true;
+	}
+
+	// { Children... }
+	m_HasChildren = m_Tok.QuerySymbol(_T('{'));
+	if (m_HasChildren)
+		m_Tok.Next();
+	else if (!any)
+		m_Tok.CreateError();
+	else
+		m_LeafEndPending = true;
+
+	return m_Event = EVENT_BEGIN_NODE;
+}
+
+void NodeReader::SkipChildren()
+{
+	assert(m_Event == EVENT_BEGIN_NODE);
+	if (!m_HasChildren)
+	{
+		Next();
+		return;
+	}
+
+	// Only braces matter, everything between them is skipped token by token
+	uint level = 1;
+	for (;;)
+	{
+		if (m_Tok.QueryEOF())
+			m_Tok.CreateError(_T("Unexpected end of TokDoc document"));
+		if (m_Tok.QuerySymbol(_T('{')))
+			level++;
+		else if (m_Tok.QuerySymbol(_T('}')) && --level == 0)
+			break;
+		m_Tok.Next();
+	}
+	m_Depth++;
+	EndChildren();
+	m_Event = EVENT_END_NODE;
+}
+
+void NodeReader::ReadNode( Node &out )
+{
+	assert(m_Event == EVENT_BEGIN_NODE);
+	out.Name = m_Name;
+	out.Value = m_Value;
+	if (m_HasChildren)
+	{
+		out.LoadChildren(m_Tok);
+		m_Depth++;
+		EndChildren();
+		m_Event = EVENT_END_NODE;
+	}
+	else
+	{
+		out.DeleteAllChildren();
+		Next();
+	}
+}
+
+void NodeReader::FinishNode()
+{
+	// Separator ',' or ';' (not needed at end)
+	bool atEnd = m_Tok.QueryEOF() || m_Tok.QuerySymbol(_T('}'));
+	if (!atEnd)
+	{
+		if (m_Tok.QuerySymbol(_T(',')) || m_Tok.QuerySymbol(_T(';')))
+			m_Tok.Next();
+		else
+			m_Tok.CreateError();
+	}
+}
+
+void NodeReader::EndChildren()
+{
+	m_Tok.AssertSymbol(_T('}'));
+	m_Tok.Next();
+	m_Depth--;
+	m_LeafEndPending = false;
+	FinishNode();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// class NodeWriter
+
+NodeWriter::NodeWriter( TokenWriter &tok )
+: m_Tok(tok)
+{
+}
+
+void NodeWriter::OpenChildren()
+{
+	if (!m_Levels.empty() && m_Levels.back() != LEVEL_CHILDREN)
+	{
+		m_Tok.WriteSymbol(_T('{'));
+		m_Tok.WriteEOL();
+		m_Levels.back() = LEVEL_CHILDREN;
+	}
+}
+
+void NodeWriter::BeginNode( const tchar *name, size_t nameLength, const tchar *value, size_t valueLength )
+{
+	OpenChildren();
+
+	if (nameLength > 0)
+	{
+		m_Tok.WriteString(name, nameLength);
+		m_Tok.WriteSymbol(_T('='));
+	}
+	if (valueLength > 0)
+		m_Tok.WriteString(value, valueLength);
+
+	m_Levels.push_back(nameLength == 0 && valueLength == 0 ? LEVEL_EMPTY : LEVEL_STARTED);
+}
+
+void NodeWriter::EndNode()
+{
+	assert(!m_Levels.empty());
+	LEVEL_STATE state = m_Levels.back();
+	m_Levels.pop_back();
+
+	// Node without name, value and children is not written at all, like in Node::SaveChildren
+	if (state == LEVEL_EMPTY)
+		return;
+	if (state == LEVEL_CHILDREN)
+		m_Tok.WriteSymbol(_T('}'));
+	m_Tok.WriteSymbol(_T(';'));
+	m_Tok.WriteEOL();
+}
+
+void NodeWriter::WriteNode( const Node &node )
+{
+	BeginNode(node.Name.data(), node.Name.length(), node.Value.data(), node.Value.length());
+	if (node.HasChildren())
+	{
+		OpenChildren();
+		node.SaveChildren(m_Tok);
+	}
+	EndNode();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// class BinaryNode
+
+void BinaryNode::Decode( RECORD &out ) const
+{
+	// Root
+	if (m_Record == NULL)
+	{
+		out.NameIndex = out.ValueIndex = 0;
+		out.ChildrenBegin = m_Doc->m_Records;
+		out.ChildrenEnd = m_Doc->m_RecordsEnd;
+		return;
+	}
+
+	uint32 childrenSize;
+	const uint8 *p = ReadVarUint(m_Record, m_SiblingsEnd, out.NameIndex);
+	p = ReadVarUint(p, m_SiblingsEnd, out.ValueIndex);
+	p = ReadVarUint(p, m_SiblingsEnd, childrenSize);
+	if (out.NameIndex >= m_Doc->m_StringCount || out.ValueIndex >= m_Doc->m_StringCount || childrenSize > (size_t)(m_SiblingsEnd - p))
+		ThrowInvalidBinary(_T("bad node"));
+	out.ChildrenBegin = p;
+	out.ChildrenEnd = p + childrenSize;
+}
+
+const tchar * BinaryNode::GetName() const
+{
+	RECORD record;
+	Decode(record);
+	return m_Doc->GetString(record.NameIndex);
+}
+
+size_t BinaryNode::GetNameLength() const
+{
+	RECORD record;
+	Decode(record);
+	return m_Doc->GetStringLength(record.NameIndex);
+}
+
+const tchar * BinaryNode::GetValue() const
+{
+	RECORD record;
+	Decode(record);
+	return m_Doc->GetString(record.ValueIndex);
+}
+
+size_t BinaryNode::GetValueLength() const
+{
+	RECORD record;
+	Decode(record);
+	return m_Doc->GetStringLength(record.ValueIndex);
+}
+
+bool BinaryNode::HasChildren() const
+{
+	RECORD record;
+	Decode(record);
+	return record.ChildrenBegin != record.ChildrenEnd;
+}
+
+BinaryNode BinaryNode::GetFirstChild() const
+{
+	RECORD record;
+	Decode(record);
+	if (record.ChildrenBegin == record.ChildrenEnd)
+		return BinaryNode();
+	return BinaryNode(m_Doc, record.ChildrenBegin, record.ChildrenEnd);
+}
+
+BinaryNode BinaryNode::GetNextSibling() const
+{
+	if (m_Record == NULL)
+		return BinaryNode();
+	RECORD record;
+	Decode(record);
+	if (record.ChildrenEnd == m_SiblingsEnd)
+		return BinaryNode();
+	return BinaryNode(m_Doc, record.ChildrenEnd, m_SiblingsEnd);
+}
+
+BinaryNode BinaryNode::FindFirstChild( const tstring &name ) const
+{
+	BinaryNode child = GetFirstChild();
+	if (!child.IsNull() && child.GetNameLength() == name.length() && memcmp(child.GetName(), name.data(), name.length() * sizeof(tchar)) == 0)
+		return child;
+	return child.IsNull() ? child : child.FindNextSibling(name);
+}
+
+BinaryNode BinaryNode::FindNextSibling( const tstring &name ) const
+{
+	if (m_Record == NULL)
+		return BinaryNode();
+	RECORD record;
+	Decode(record);
+	for (const uint8 *p = record.ChildrenEnd; p != m_SiblingsEnd; p = record.ChildrenEnd)
+	{
+		BinaryNode sibling(m_Doc, p, m_SiblingsEnd);
+		sibling.Decode(record);
+		if (m_Doc->GetStringLength(record.NameIndex) == name.length() &&
+			memcmp(m_Doc->GetString(record.NameIndex), name.data(), name.length() * sizeof(tchar)) == 0)
+		{
+			return sibling;
+		}
+	}
+	return BinaryNode();
+}
+
+size_t BinaryNode::CalcChildCount() const
+{
+	size_t count = 0;
+	for (BinaryNode child = GetFirstChild(); !child.IsNull(); child = child.GetNextSibling())
+		count++;
+	return count;
+}
+
+void BinaryNode::CopyTo( Node &node ) const
+{
+	RECORD record;
+	Decode(record);
+	node.Name.assign(m_Doc->GetString(record.NameIndex), m_Doc->GetStringLength(record.NameIndex));
+	node.Value.assign(m_Doc->GetString(record.ValueIndex), m_Doc->GetStringLength(record.ValueIndex));
+	node.DeleteAllChildren();
+	CopyChildrenTo(node);
+}
+
+void BinaryNode::CopyChildrenTo( Node &node ) const
+{
+	assert(!node.HasChildren());
+
+	// Strings can be shared if they are in memory of the same document
+	Document_pimpl *doc = node.GetDocumentPimpl();
+	bool shareStrings = doc != NULL && doc == m_Doc->m_CharsOwner;
+	// Interned names by string index
+	std::vector<const tchar*> names;
+	if (shareStrings)
+		names.resize(m_Doc->m_StringCount, NULL);
+
+	// Iteratively, with a stack of parents whose children are being created
+	struct LEVEL
+	{
+		Node *Parent;
+		const uint8 *End;
+	};
+	std::vector<LEVEL> levels;
+	RECORD record;
+	Decode(record);
+	Node *parent = &node;
+	const uint8 *p = record.ChildrenBegin, *end = record.ChildrenEnd;
+	for (;;)
+	{
+		if (p == end)
+		{
+			if (levels.empty())
+				break;
+			parent = levels.back().Parent;
+			end = levels.back().End;
+			levels.pop_back();
+			continue;
+		}
+
+		BinaryNode(m_Doc, p, end).Decode(record);
+		Node *child = parent->CreateNode();
+		if (shareStrings)
+		{
+			if (record.NameIndex != 0)
+			{
+				if (names[record.NameIndex] == NULL)
+					names[record.NameIndex] = doc->InternName(m_Doc->GetString(record.NameIndex), m_Doc->GetStringLength(record.NameIndex), false);
+				child->Name.m_Data = names[record.NameIndex];
+				child->Name.m_Length = (uint32)m_Doc->GetStringLength(record.NameIndex);
+			}
+			if (record.ValueIndex != 0)
+			{
+				child->Value.m_Data = m_Doc->GetString(record.ValueIndex);
+				child->Value.m_Length = (uint32)m_Doc->GetStringLength(record.ValueIndex);
+			}
+		}
+		else
+		{
+			child->Name.assign(m_Doc->GetString(record.NameIndex), m_Doc->GetStringLength(record.NameIndex));
+			child->Value.assign(m_Doc->GetString(record.ValueIndex), m_Doc->GetStringLength(record.ValueIndex));
+		}
+		parent->LinkChildAtEnd(child);
+
+		p = record.ChildrenEnd;
+		if (record.ChildrenBegin != record.ChildrenEnd)
+		{
+			LEVEL level = { parent, end };
+			levels.push_back(level);
+			parent = child;
+			p = record.ChildrenBegin;
+			end = record.ChildrenEnd;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// class BinaryDocument
+
+BinaryDocument::BinaryDocument( const void *data, size_t size )
+: m_CharsOwner(NULL)
+{
+	const uint8 *bytes = (const uint8*)data;
+	// Header and string offsets are read in place as uint32
+	if ((size_t)data % sizeof(uint32) != 0)
+		ThrowInvalidBinary(_T("data not aligned to 4 bytes"));
+	if (size < sizeof(BINARY_HEADER))
+		ThrowInvalidBinary(_T("too short"));
+	const BINARY_HEADER &header = *(const BINARY_HEADER*)bytes;
+	ValidateBinaryHeader(header);
+
+	size_t offsetsBytes = ((size_t)header.StringCount + 1) * sizeof(uint32);
+	size_t charBytes = (size_t)header.StringCharCount * sizeof(tchar);
+	if ((size - sizeof(BINARY_HEADER)) / sizeof(uint32) < (size_t)header.StringCount + 1 ||
+		size - sizeof(BINARY_HEADER) - offsetsBytes < charBytes ||
+		size - sizeof(BINARY_HEADER) - offsetsBytes - charBytes < header.RecordBytes)
+	{
+		ThrowInvalidBinary(_T("too short"));
+	}
+
+	m_StringCount = header.StringCount;
+	m_StringOffsets = (const uint32*)(bytes + sizeof(BINARY_HEADER));
+	m_Chars = (const tchar*)(bytes + sizeof(BINARY_HEADER) + offsetsBytes);
+	m_Records = bytes + sizeof(BINARY_HEADER) + offsetsBytes + charBytes;
+	m_RecordsEnd = m_Records + header.RecordBytes;
+	ValidateStrings(header.StringCharCount);
+}
+
+BinaryDocument::BinaryDocument( uint32 stringCount, const uint32 *stringOffsets, const tchar *chars, const uint8 *records, size_t recordBytes, Document_pimpl *charsOwner )
+: m_StringCount(stringCount)
+, m_StringOffsets(stringOffsets)
+, m_Chars(chars)
+, m_Records(records)
+, m_RecordsEnd(records + recordBytes)
+, m_CharsOwner(charsOwner)
+{
+	ValidateStrings(stringOffsets[stringCount]);
+}
+
+void BinaryDocument::ValidateStrings( uint32 charCount ) const
+{
+	// String 0 is empty, every string ends with zero
+	if (m_StringOffsets[0] != 0 || m_StringOffsets[1] != 1 || m_StringOffsets[m_StringCount] != charCount)
+		ThrowInvalidBinary(_T("bad string table"));
+	for (uint32 i = 0; i < m_StringCount; i++)
+	{
+		if (m_StringOffsets[i + 1] <= m_StringOffsets[i] || m_StringOffsets[i + 1] > charCount || m_Chars[m_StringOffsets[i + 1] - 1] != _T('\0'))
+			ThrowInvalidBinary(_T("bad string table"));
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Globals
+
+void NodeValueFromEnum( Node &node, uint val, const tchar * const *itemNames, const uint *itemValues, size_t itemCount )
+{
+	node.DeleteAllChildren();
+
+	if (itemValues)
+	{
+		size_t i;
+		for (i = 0; i < itemCount; i++)
+		{
+			if (itemValues[i] == val)
+			{
+				node.Value = itemNames[i];
+				return;
+			}
+		}
+	}
+	else
+	{
+		if ((size_t)val < itemCount)
+		{
+			node.Value = itemNames[(size_t)val];
+			return;
+		}
+	}
+
+	tchar valStr[INT_TO_STR_BUFFER_SIZE];
+	size_t valLength = UintToStr(valStr, val);
+	node.Value.assign(valStr, valLength);
+}
+
+void NodeFrom( Node &node, const POINT_ &val )
+{
+	node.DeleteAllChildren();
+	node.Value.clear();
+
+	Node *childNode;
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.x);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.y);
+}
+
+void NodeFrom( Node &node, const RECTI &val )
+{
+	node.DeleteAllChildren();
+	node.Value.clear();
+
+	Node *childNode;
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.Min.x);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.Min.y);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.Max.x);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.Max.y);
+}
+
+void NodeFrom( Node &node, const VEC2 &val )
+{
+	node.DeleteAllChildren();
+	node.Value.clear();
+
+	Node *childNode;
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.x);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.y);
+}
+
+void NodeFrom( Node &node, const VEC3 &val )
+{
+	node.DeleteAllChildren();
+	node.Value.clear();
+
+	Node *childNode;
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.x);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.y);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.z);
+}
+
+void NodeFrom( Node &node, const VEC4 &val )
+{
+	node.DeleteAllChildren();
+	node.Value.clear();
+
+	Node *childNode;
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.x);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.y);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.z);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.w);
+}
+
+void NodeFrom( Node &node, COLOR val )
+{
+	node.DeleteAllChildren();
+
+	tchar valStr[2 + INT_TO_STR_BUFFER_SIZE];
+	valStr[0] = _T('0');
+	valStr[1] = _T('x');
+	size_t valLength = 2 + UintToStr2(valStr + 2, val.ARGB, 8, 16);
+	node.Value.assign(valStr, valLength);
+}
+
+void NodeFrom( Node &node, const COLORF &val )
+{
+	node.DeleteAllChildren();
+	node.Value.clear();
+
+	Node *childNode;
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.R);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.G);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.B);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.A);
+}
+
+void NodeFrom( Node &node, const RECTF &val )
+{
+	node.DeleteAllChildren();
+	node.Value.clear();
+
+	Node *childNode;
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.Min.x);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.Min.y);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.Max.x);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.Max.y);
+}
+
+void NodeFrom( Node &node, const BOX &val )
+{
+	node.DeleteAllChildren();
+	node.Value.clear();
+
+	Node *childNode;
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.Min.x);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.Min.y);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.Min.z);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.Max.x);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.Max.y);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.Max.z);
+}
+
+void NodeFrom( Node &node, const QUATERNION &val )
+{
+	node.DeleteAllChildren();
+	node.Value.clear();
+
+	Node *childNode;
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.x);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.y);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.z);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.w);
+}
+
+void NodeFrom( Node &node, const MATRIX &val )
+{
+	node.DeleteAllChildren();
+	node.Value.clear();
+
+	Node *childNode;
+
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val._11);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val._12);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val._13);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val._14);
+
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val._21);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val._22);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val._23);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val._24);
+
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val._31);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val._32);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val._33);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val._34);
+
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val._41);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val._42);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val._43);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val._44);
+}
+
+void NodeFrom( Node &node, const AFFINE2D &val )
+{
+	node.DeleteAllChildren();
+	node.Value.clear();
+
+	Node *childNode;
+
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.a);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.b);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.c);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.d);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.e);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.f);
+}
+
+void NodeFrom( Node &node, const LINE2D &val )
+{
+	node.DeleteAllChildren();
+	node.Value.clear();
+
+	Node *childNode;
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.a);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.b);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.c);
+}
+
+void NodeFrom( Node &node, const PLANE &val )
+{
+	node.DeleteAllChildren();
+	node.Value.clear();
+
+	Node *childNode;
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.a);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.b);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.c);
+	node.LinkChildAtEnd(childNode = node.CreateNode()); NodeFrom(*childNode, val.d);
+}
+
+#ifdef _WIN32
+
+void NodeFrom( Node &node, GameTime val )
+{
+	NodeFrom(node, val.ToMilliseconds());
+}
+
+bool NodeTo( GameTime &out, const Node &node, bool required )
+{
+	__int64 milliseconds;
+	if (!NodeTo(milliseconds, node, required))
+		return false;
+	out = MillisecondsToGameTime(milliseconds);
+	return true;
+}
+
+#endif // #ifdef _WIN32
+
+bool NodeValueToEnum( uint &out, const Node &node, bool required, const tchar * const *itemNames, const uint *itemValues, size_t itemCount )
+{
+	for (size_t i = 0; i < itemCount; i++)
+	{
+		if (node.Value == itemNames[i])
+		{
+			out = itemValues ? itemValues[i] : (uint32)i;
+			return true;
+		}
+	}
+
+	if (StrToUint(&out, node.Value.data(), node.Value.length(), 10) == 0)
+		return true;
+
+	if (required)
+		throw Error(_T("Cannot parse TokDoc node \"") + node.Name + _T("\" = \"") + node.Value + _T("\" to enum."), __TFILE__, __LINE__);
+	return false;
+}
+
+bool NodeTo( POINT_ &out, const Node &node, bool required )
+{
+	POINT_ tmpVal;
+	uint index; Node *childNode;
+	for (childNode = node.FindFirstChild(EMPTY_STRING), index = 0; childNode && index < 2; childNode = childNode->FindNextSibling(EMPTY_STRING), index++)
+		if (!NodeTo(tmpVal[index], *childNode, required))
+			return false;
+	out = tmpVal;
+	return true;
+}
+
+bool NodeTo( RECTI &out, const Node &node, bool required )
+{
+	RECTI tmpVal;
+	uint index; Node *childNode;
+	for (childNode = node.FindFirstChild(EMPTY_STRING), index = 0; childNode && index < 4; childNode = childNode->FindNextSibling(EMPTY_STRING), index++)
+		if (!NodeTo(tmpVal[index], *childNode, required))
+			return false;
+	out = tmpVal;
+	return true;
+}
+
+bool NodeTo( VEC2 &out, const Node &node, bool required )
+{
+	VEC2 tmpVal;
+	uint index; Node *childNode;
+	for (childNode = node.FindFirstChild(EMPTY_STRING), index = 0; childNode && index < 2; childNode = childNode->FindNextSibling(EMPTY_STRING), index++)
+		if (!NodeTo(tmpVal[index], *childNode, required))
+			return false;
+	out = tmpVal;
+	return true;
+}
+
+bool NodeTo( VEC3 &out, const Node &node, bool required )
+{
+	VEC3 tmpVal;
+	uint index; Node *childNode;
+	for (childNode = node.FindFirstChild(EMPTY_STRING), index = 0; childNode && index < 3; childNode = childNode->FindNextSibling(EMPTY_STRING), index++)
+		if (!NodeTo(tmpVal[index], *childNode, required))
+			return false;
+	out = tmpVal;
+	return true;
+}
+
+bool NodeTo( VEC4 &out, const Node &node, bool required )
+{
+	VEC4 tmpVal;
+	uint index; Node *childNode;
+	for (childNode = node.FindFirstChild(EMPTY_STRING), index = 0; childNode && index < 4; childNode = childNode->FindNextSibling(EMPTY_STRING), index++)
+		if (!NodeTo(tmpVal[index], *childNode, required))
+			return false;
+	out = tmpVal;
+	return true;
+}
+
+bool NodeTo( COLOR &out, const Node &node, bool required )
+{
+	return NodeTo(out.ARGB, node, required);
+}
+
+bool NodeTo( COLORF &out, const Node &node, bool required )
+{
+	COLORF tmpVal;
+	uint index; Node *childNode;
+	for (childNode = node.FindFirstChild(EMPTY_STRING), index = 0; childNode && index < 4; childNode = childNode->FindNextSibling(EMPTY_STRING), index++)
+		if (!NodeTo(tmpVal[index], *childNode, required))
+			return false;
+	out = tmpVal;
+	return true;
+}
+
+bool NodeTo( RECTF &out, const Node &node, bool required )
+{
+	RECTF tmpVal;
+	uint index; Node *childNode;
+	for (childNode = node.FindFirstChild(EMPTY_STRING), index = 0; childNode && index < 4; childNode = childNode->FindNextSibling(EMPTY_STRING), index++)
+		if (!NodeTo(tmpVal[index], *childNode, required))
+			return false;
+	out = tmpVal;
+	return true;
+}
+
+bool NodeTo( BOX &out, const Node &node, bool required )
+{
+	BOX tmpVal;
+	uint index; Node *childNode;
+	for (childNode = node.FindFirstChild(EMPTY_STRING), index = 0; childNode && index < 6; childNode = childNode->FindNextSibling(EMPTY_STRING), index++)
+		if (!NodeTo(tmpVal[index], *childNode, required))
+			return false;
+	out = tmpVal;
+	return true;
+}
+
+bool NodeTo( QUATERNION &out, const Node &node, bool required )
+{
+	QUATERNION tmpVal;
+	uint index; Node *childNode;
+	for (childNode = node.FindFirstChild(EMPTY_STRING), index = 0; childNode && index < 4; childNode = childNode->FindNextSibling(EMPTY_STRING), index++)
+		if (!NodeTo(tmpVal[index], *childNode, required))
+			return false;
+	out = tmpVal;
+	return true;
+}
+
+bool NodeTo( MATRIX &out, const Node &node, bool required )
+{
+	MATRIX tmpVal;
+	uint index; Node *childNode;
+	for (childNode = node.FindFirstChild(EMPTY_STRING), index = 0; childNode && index < 16; childNode = childNode->FindNextSibling(EMPTY_STRING), index++)
+		if (!NodeTo(tmpVal[index], *childNode, required))
+			return false;
+	out = tmpVal;
+	return true;
+}
+
+bool NodeTo( AFFINE2D &out, const Node &node, bool required )
+{
+	AFFINE2D tmpVal;
+	uint index; Node *childNode;
+	for (childNode = node.FindFirstChild(EMPTY_STRING), index = 0; childNode && index < 6; childNode = childNode->FindNextSibling(EMPTY_STRING), index++)
+		if (!NodeTo(tmpVal[index], *childNode, required))
+			return false;
+	out = tmpVal;
+	return true;
+}
+
+bool NodeTo( LINE2D &out, const Node &node, bool required )
+{
+	LINE2D tmpVal;
+	uint index; Node *childNode;
+	for (childNode = node.FindFirstChild(EMPTY_STRING), index = 0; childNode && index < 3; childNode = childNode->FindNextSibling(EMPTY_STRING), index++)
+		if (!NodeTo(tmpVal[index], *childNode, required))
+			return false;
+	out = tmpVal;
+	return true;
+}
+
+bool NodeTo( PLANE &out, const Node &node, bool required )
+{
+	PLANE tmpVal;
+	uint index; Node *childNode;
+	for (childNode = node.FindFirstChild(EMPTY_STRING), index = 0; childNode && index < 4; childNode = childNode->FindNextSibling(EMPTY_STRING), index++)
+		if (!NodeTo(tmpVal[index], *childNode, required))
+			return false;
+	out = tmpVal;
+	return true;
+}
+
+} // namespace tokdoc
+} // namespace common
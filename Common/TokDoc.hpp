@@ -1,295 +1,741 @@
-/** \file
-\brief Persistent DOM model for a format based on Tokenizer.
-\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
-
-Part of CommonLib library. \n
-Encoding UTF-8, end of line CR+LF \n
-License: GNU LGPL. \n
-Documentation: \ref Module_TokDoc \n
-Module components: \ref code_tokdoc
-*/
-#if defined(_MSC_VER) && (_MSC_VER >= 1200)
-#pragma once
-#endif
-#ifndef COMMON_TOKDOC_H_
-#define COMMON_TOKDOC_H_
-
-#include "Math.hpp"
-
-namespace common {
-
-#ifdef _WIN32
-struct GameTime;
-#endif
-
-class Tokenizer;
-class TokenWriter;
-
-/** \addtogroup code_tokdoc TokDoc Module
-Documentation: \ref Module_TokDoc \n
-Header: TokDoc.hpp */
-//@{
-namespace tokdoc {
-
-/// Main class that contains a tree node of TokDoc document. Can have name, value and subnodes.
-class Node
-{
-public:
-	tstring Name, Value;
-
-	Node();
-	Node(const Node &src);
-	Node(const tstring &value);
-	Node(const tstring &name, const tstring &value);
-	~Node();
-
-	Node & operator = (const Node &src);
-
-	void CopyFrom(const Node &src);
-	void CopyChildrenFrom(const Node &src);
-	void MoveChildrenFrom(Node *src);
-
-	/** \param tok Must be configured WITHOUT flag FLAG_TOKEN_EOL. */
-	void LoadChildren(Tokenizer &tok);
-	void SaveChildren(TokenWriter &tok) const;
-
-	Node * GetParent() const { return m_Parent; }
-	Node * GetFirstChild() const { return m_FirstChild; }
-	Node * GetLastChild() const { return m_LastChild; }
-	Node * GetPrevSibling() const { return m_PrevSibling; }
-	Node * GetNextSibling() const { return m_NextSibling; }
-
-	Node * FindFirstChild(const tstring &name) const;
-	Node * FindLastChild(const tstring &name) const;
-	Node * FindPrevSibling(const tstring &name) const;
-	Node * FindNextSibling(const tstring &name) const;
-	Node & MustFindFirstChild(const tstring &name) const;
-
-	size_t CalcChildCount() const;
-	size_t CalcChildCount(const tstring &name) const;
-	bool HasChildren() const { return m_FirstChild != NULL; }
-
-	void Clear();
-	void DeleteAllChildren();
-	void DeleteAllChildren(const tstring &name);
-
-	void InsertChildAtBegin(const Node &addThis);
-	void InsertChildAtEnd(const Node &addThis);
-	void InsertChildBefore(Node *beforeThis, const Node &addThis);
-	void InsertChildAfter(Node *afterThis, const Node &addThis);
-	void DeleteChild(Node *deleteThis);
-
-	void LinkChildAtBegin(Node *addThis);
-	void LinkChildAtEnd(Node *addThis);
-	void LinkChildBefore(Node *beforeThis, Node *addThis);
-	void LinkChildAfter(Node *afterThis, Node *addThis);
-	void UnlinkChild(Node *deleteThis);
-
-private:
-	Node *m_Parent;
-	Node *m_FirstChild, *m_LastChild;
-	Node *m_PrevSibling, *m_NextSibling;
-};
-
-/// Converts value of any type (supported by SthToStr) to string stored into Value of given node.
-template <typename T>
-inline void NodeValueFromSth(Node &node, const T &val)
-{
-	SthToStr<T>(&node.Value, val);
-}
-
-/// Parses string from Value of given node to value of any type (supported by StrToSth).
-template <typename T>
-inline bool NodeValueToSth(T &out, const Node &node, bool required)
-{
-	if (required)
-		MustStrToSth<T>(&out, node.Value);
-	else
-	{
-		T tmpVal;
-		if (StrToSth(&tmpVal, node.Value))
-			out = tmpVal;
-		else
-			return false;
-	}
-	return true;
-}
-
-/// Converts enumeration value (given as uint) into string with the value name stored into Value of given node.
-/** If val is other than values of items given, val is converted to numeric string, like "123".
-\param itemValues Can be NULL, which means consecutive items have values 0, 1, 2, ... */
-void NodeValueFromEnum(Node &node, uint val,
-	const tchar * const *itemNames, const uint *itemValues, size_t itemCount);
-/// Parses string from Value of given node to enumeration value (given as uint&).
-/** node.Value may be one of given item names or a numeric string, like "123".
-\param itemValues Can be NULL, which means consecutive items have values 0, 1, 2, ... */
-bool NodeValueToEnum(uint &out, const Node &node, bool required,
-	const tchar * const *itemNames, const uint *itemValues, size_t itemCount);
-
-template <typename T>
-inline void NodeFromVector(Node &node, const std::vector<T> &vec)
-{
-	node.DeleteAllChildren();
-	node.Value.clear();
-
-	for (size_t i = 0; i < vec.size(); i++)
-	{
-		Node *childNode = new Node();
-		node.LinkChildAtEnd(childNode);
-		NodeFrom(*childNode, vec[i]);
-	}
-}
-
-template <typename T>
-inline bool NodeToVector(std::vector<T> &out, const Node &node, bool required)
-{
-	out.clear();
-	T tmpVal;
-	for (Node *childNode = node.FindFirstChild(EMPTY_STRING); childNode; childNode = childNode->FindNextSibling(EMPTY_STRING))
-	{
-		if (!NodeTo(tmpVal, childNode->Value, required))
-			return false;
-		out.push_back(tmpVal);
-	}
-	return true;
-}
-
-/// \internal
-inline bool _StrIsUintWithBase(const tstring &s)
-{
-	return s.length() > 2 && s[0] == '0' && (s[1] == 'x' || s[1] == 'X');
-}
-
-/// Parses Value string of given node to unsigned integer of type T, while supporting standard numbers like "123" as well as hexadecimal notation like "0x123FF".
-template <typename T>
-inline bool NodeValueToUint(T &out, const Node &node, bool required)
-{
-	if (_StrIsUintWithBase(node.Value))
-	{
-		tstring valStr = node.Value.substr(2);
-		bool ok = StrToUint(&out, valStr, 16) == 0;
-		if (required && !ok)
-			throw Error(_T("Cannot parse TokDoc node \"") + node.Name + _T("\" = \"") + node.Value + _T("\" to unsigned integer."), __TFILE__, __LINE__);
-		return ok;
-	}
-	else
-		return NodeValueToSth(out, node, required);
-}
-
-template <typename T, typename UT>
-inline bool NodeValueToInt(T &out, const Node &node, bool required)
-{
-	if (_StrIsUintWithBase(node.Value))
-		return NodeValueToUint((UT&)out, node, required);
-	else
-		return NodeValueToSth(out, node, required);
-}
-
-inline void NodeFrom(Node &node, bool val) { NodeValueFromSth(node, val); }
-inline void NodeFrom(Node &node, tchar val) { node.DeleteAllChildren(); node.Value.resize(1); node.Value[0] = val; }
-inline void NodeFrom(Node &node, const tstring &val) { node.DeleteAllChildren(); node.Value = val; }
-inline void NodeFrom(Node &node, const tchar *val) { node.DeleteAllChildren(); node.Value = val; }
-inline void NodeFrom(Node &node, uint8 val) { node.DeleteAllChildren(); NodeValueFromSth(node, val); }
-inline void NodeFrom(Node &node, uint16 val) { node.DeleteAllChildren(); NodeValueFromSth(node, val); }
-inline void NodeFrom(Node &node, uint32 val) { node.DeleteAllChildren(); NodeValueFromSth(node, val); }
-inline void NodeFrom(Node &node, uint64 val) { node.DeleteAllChildren(); NodeValueFromSth(node, val); }
-inline void NodeFrom(Node &node, int16 val) { node.DeleteAllChildren(); NodeValueFromSth(node, val); }
-inline void NodeFrom(Node &node, int32 val) { node.DeleteAllChildren(); NodeValueFromSth(node, val); }
-inline void NodeFrom(Node &node, int64 val) { node.DeleteAllChildren(); NodeValueFromSth(node, val); }
-inline void NodeFrom(Node &node, unsigned long val) { node.DeleteAllChildren(); NodeValueFromSth(node, val); }
-inline void NodeFrom(Node &node, long val) {node.DeleteAllChildren();  NodeValueFromSth(node, val); }
-inline void NodeFrom(Node &node, float val) { node.DeleteAllChildren(); NodeValueFromSth(node, val); }
-inline void NodeFrom(Node &node, double val) { node.DeleteAllChildren(); NodeValueFromSth(node, val); }
-
-inline bool NodeTo(bool &out, const Node &node, bool required) { return NodeValueToSth(out, node, required); }
-inline bool NodeTo(tchar &out, const Node &node, bool required) { return NodeValueToSth(out, node, required); }
-inline bool NodeTo(tstring &out, const Node &node, bool required) { out = node.Value; return true; }
-inline bool NodeTo(uint8 &out, const Node &node, bool required) { return NodeValueToUint(out, node, required); }
-inline bool NodeTo(uint16 &out, const Node &node, bool required) { return NodeValueToUint(out, node, required); }
-inline bool NodeTo(uint32 &out, const Node &node, bool required) { return NodeValueToUint(out, node, required); }
-inline bool NodeTo(uint64 &out, const Node &node, bool required) { return NodeValueToUint(out, node, required); }
-inline bool NodeTo(unsigned long &out, const Node &node, bool required) { return NodeValueToUint(out, node, required); }
-inline bool NodeTo(int16 &out, const Node &node, bool required) { return NodeValueToInt<int16, uint16>(out, node, required); }
-inline bool NodeTo(int32 &out, const Node &node, bool required) { return NodeValueToInt<int32, uint32>(out, node, required); }
-inline bool NodeTo(int64 &out, const Node &node, bool required) { return NodeValueToInt<int64, uint64>(out, node, required); }
-inline bool NodeTo(long &out, const Node &node, bool required) { return NodeValueToInt<long, unsigned long>(out, node, required); }
-inline bool NodeTo(float &out, const Node &node, bool required) { return NodeValueToSth(out, node, required); }
-inline bool NodeTo(double &out, const Node &node, bool required) { return NodeValueToSth(out, node, required); }
-
-// ======== Time types ========
-
-#ifdef _WIN32
-void NodeFrom(Node &node, GameTime val);
-bool NodeTo(GameTime &out, const Node &node, bool required);
-#endif // #ifdef _WIN32
-
-// ======== Math types ========
-
-void NodeFrom(Node &node, const POINT_ &val);
-void NodeFrom(Node &node, const RECTI &val);
-void NodeFrom(Node &node, const VEC2 &val);
-void NodeFrom(Node &node, const VEC3 &val);
-void NodeFrom(Node &node, const VEC4 &val);
-void NodeFrom(Node &node, COLOR val);
-void NodeFrom(Node &node, const COLORF &val);
-void NodeFrom(Node &node, const RECTF &val);
-void NodeFrom(Node &node, const BOX &val);
-void NodeFrom(Node &node, const QUATERNION &val);
-void NodeFrom(Node &node, const MATRIX &val);
-void NodeFrom(Node &node, const AFFINE2D &val);
-void NodeFrom(Node &node, const LINE2D &val);
-void NodeFrom(Node &node, const PLANE &val);
-
-bool NodeTo(POINT_ &out, const Node &node, bool required);
-bool NodeTo(RECTI &out, const Node &node, bool required);
-bool NodeTo(VEC2 &out, const Node &node, bool required);
-bool NodeTo(VEC3 &out, const Node &node, bool required);
-bool NodeTo(VEC4 &out, const Node &node, bool required);
-bool NodeTo(COLOR &out, const Node &node, bool required);
-bool NodeTo(COLORF &out, const Node &node, bool required);
-bool NodeTo(RECTF &out, const Node &node, bool required);
-bool NodeTo(BOX &out, const Node &node, bool required);
-bool NodeTo(QUATERNION &out, const Node &node, bool required);
-bool NodeTo(MATRIX &out, const Node &node, bool required);
-bool NodeTo(AFFINE2D &out, const Node &node, bool required);
-bool NodeTo(LINE2D &out, const Node &node, bool required);
-bool NodeTo(PLANE &out, const Node &node, bool required);
-
-
-template <typename T>
-void SubnodeFrom(Node &node, const tstring &subnodeName, const T &val)
-{
-	Node *subnode = node.FindFirstChild(subnodeName);
-	if (subnode == NULL)
-		node.LinkChildAtEnd(subnode = new Node(subnodeName, EMPTY_STRING));
-	NodeFrom(*subnode, val);
-}
-
-/// Condition for SubnodeTo() telling about how to treat errors.
-enum SUBNODE_COND
-{
-	SUBNODE_OPTIONAL_CORRECT, ///< Optional, but must be correct if exists. Subnode not exists: return false. Parse error: throw exception.
-	SUBNODE_REQUIRED,         ///< Strictly required. Subnode not exists or parse error: throw exception.
-	SUBNODE_OPTIONAL,         ///< Libearlly optional. Subnode not exists or parse error: return false.
-};
-
-template <typename T>
-bool SubnodeTo(T &out, const Node &node, const tstring &subnodeName, SUBNODE_COND required)
-{
-	Node *subnode = node.FindFirstChild(subnodeName);
-	if (subnode == NULL)
-	{
-		if (required == SUBNODE_REQUIRED)
-			throw Error(_T("TokDoc subnode \"") + subnodeName + _T("\" not found"), __TFILE__, __LINE__);
-		return false;
-	}
-	return NodeTo(out, *subnode, required != SUBNODE_OPTIONAL);
-}
-
-
-//@}
-// code_tokdoc
-} // namespace tokdoc
-} // namespace common
-
-#endif
+/** \file
+\brief Persistent DOM model for a format based on Tokenizer.
+\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
+
+Part of CommonLib library. \n
+Encoding UTF-8, end of line CR+LF \n
+License: GNU LGPL. \n
+Documentation: \ref Module_TokDoc \n
+Module components: \ref code_tokdoc
+*/
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+#pragma once
+#endif
+#ifndef COMMON_TOKDOC_H_
+#define COMMON_TOKDOC_H_
+
+#include "Math.hpp"
+#include "Error.hpp"
+
+namespace common {
+
+#ifdef _WIN32
+struct GameTime;
+#endif
+
+class Tokenizer;
+class TokenWriter;
+class Stream;
+
+/** \addtogroup code_tokdoc TokDoc Module
+Documentation: \ref Module_TokDoc \n
+Header: TokDoc.hpp */
+//@{
+namespace tokdoc {
+
+class Node;
+class Document;
+/// \internal
+class Document_pimpl;
+/// \internal
+class ChildIndex;
+class NamedChildRange;
+
+/// Name or value of a Node.
+/** Behaves mostly like const tstring - can be compared with strings, concatenated,
+converted to tstring and assigned from strings. Characters are always followed by
+terminating zero.
+
+Short strings (up to INLINE_CAPACITY - 1 characters) are stored inside the object.
+Longer strings of nodes that belong to a Document are stored in its memory and names
+are always interned - every distinct name is stored once. Longer strings of other nodes
+are separate copies on the heap. */
+class NodeString
+{
+	friend class Node;
+	friend class Document_pimpl;
+	friend class BinaryNode;
+
+public:
+	static const size_t INLINE_CAPACITY = 8;
+
+	NodeString() : m_Data(m_Inline), m_Length(0), m_IsName(false), m_Doc(NULL) { m_Inline[0] = _T('\0'); }
+	/// Creates a standalone copy, not belonging to any Document.
+	NodeString(const NodeString &src);
+	~NodeString();
+
+	NodeString & operator = (const NodeString &src);
+	NodeString & operator = (const tstring &src) { assign(src.data(), src.length()); return *this; }
+	NodeString & operator = (const tchar *src);
+	void assign(const tchar *src, size_t length);
+	void clear() { assign(m_Inline, 0); }
+
+	bool empty() const { return m_Length == 0; }
+	size_t length() const { return m_Length; }
+	size_t size() const { return m_Length; }
+	const tchar * data() const { return m_Data; }
+	const tchar * c_str() const { return m_Data; }
+	tchar operator [] (size_t index) const { assert(index < m_Length); return m_Data[index]; }
+	tstring str() const { return tstring(m_Data, m_Length); }
+	operator tstring () const { return str(); }
+
+	bool Equals(const tchar *s, size_t length) const
+	{
+		return length == m_Length && (m_Data == s || memcmp(m_Data, s, length * sizeof(tchar)) == 0);
+	}
+
+private:
+	/// Changes the string without updating child index of the parent node.
+	void Set(const tchar *src, size_t length);
+	/// Makes the string empty without storing anything in document memory.
+	void Reset() { m_Inline[0] = _T('\0'); m_Data = m_Inline; m_Length = 0; }
+
+	const tchar *m_Data;
+	uint32 m_Length;
+	bool m_IsName;
+	/// NULL if not in a Document - then m_Data, if not m_Inline, is owned.
+	Document_pimpl *m_Doc;
+	tchar m_Inline[INLINE_CAPACITY];
+};
+
+inline bool operator == (const NodeString &lhs, const NodeString &rhs) { return lhs.Equals(rhs.data(), rhs.length()); }
+inline bool operator == (const NodeString &lhs, const tstring &rhs) { return lhs.Equals(rhs.data(), rhs.length()); }
+inline bool operator == (const tstring &lhs, const NodeString &rhs) { return rhs.Equals(lhs.data(), lhs.length()); }
+inline bool operator == (const NodeString &lhs, const tchar *rhs) { return lhs.Equals(rhs, common_strlen(rhs)); }
+inline bool operator == (const tchar *lhs, const NodeString &rhs) { return rhs.Equals(lhs, common_strlen(lhs)); }
+inline bool operator != (const NodeString &lhs, const NodeString &rhs) { return !(lhs == rhs); }
+inline bool operator != (const NodeString &lhs, const tstring &rhs) { return !(lhs == rhs); }
+inline bool operator != (const tstring &lhs, const NodeString &rhs) { return !(lhs == rhs); }
+inline bool operator != (const NodeString &lhs, const tchar *rhs) { return !(lhs == rhs); }
+inline bool operator != (const tchar *lhs, const NodeString &rhs) { return !(lhs == rhs); }
+
+inline tstring operator + (const tstring &lhs, const NodeString &rhs) { tstring r(lhs); r.append(rhs.data(), rhs.length()); return r; }
+inline tstring operator + (const NodeString &lhs, const tstring &rhs) { tstring r(lhs.data(), lhs.length()); r += rhs; return r; }
+inline tstring operator + (const tchar *lhs, const NodeString &rhs) { tstring r(lhs); r.append(rhs.data(), rhs.length()); return r; }
+inline tstring operator + (const NodeString &lhs, const tchar *rhs) { tstring r(lhs.data(), lhs.length()); r += rhs; return r; }
+
+/// Main class that contains a tree node of TokDoc document. Can have name, value and subnodes.
+/** Node can exist on its own - then it owns its children, which are allocated with new -
+or belong to a Document, which allocates it and owns it. Nodes of different documents, or
+a document node and a standalone node, cannot be linked together - copy them instead
+(InsertChild*, CopyFrom). Create new nodes with CreateNode() of the parent, so the same
+code works for both.
+
+Searching children by name is linear, but when it has to go through many children,
+the node builds an index of its children by name, so next searches take constant time.
+The index is kept up to date when children are linked, unlinked or renamed. Because it's
+built from const methods, concurrent searches in the same node from many threads are
+not safe, unless the index has already been built. */
+class Node
+{
+	friend class NodeString;
+	friend class Document_pimpl;
+	friend class ChildIndex;
+	friend class BinaryNode;
+	friend class NamedChildRange;
+
+public:
+	NodeString Name, Value;
+
+	/// Creates standalone node.
+	Node();
+	/// Creates standalone copy of given node with all its children.
+	Node(const Node &src);
+	Node(const tstring &value);
+	Node(const tstring &name, const tstring &value);
+	~Node();
+
+	Node & operator = (const Node &src);
+
+	/// Creates new node, not linked anywhere, in the same Document as this one or standalone (with new) if this one is standalone.
+	Node * CreateNode() const;
+	Node * CreateNode(const tstring &value) const;
+	Node * CreateNode(const tstring &name, const tstring &value) const;
+	/// Returns document that owns this node or NULL if it is standalone.
+	Document * GetDocument() const;
+
+	void CopyFrom(const Node &src);
+	void CopyChildrenFrom(const Node &src);
+	void MoveChildrenFrom(Node *src);
+
+	/** \param tok Must be configured WITHOUT flag FLAG_TOKEN_EOL. */
+	void LoadChildren(Tokenizer &tok);
+	void SaveChildren(TokenWriter &tok) const;
+	/// Loads children from binary format - see SaveChildrenBinary.
+	void LoadChildrenBinary(Stream &stream);
+	/// Saves children in compact binary format, which can be loaded much faster than text.
+	/** Data are in byte order and character size of the machine, so the format is for
+	data produced and used by the same program, like a cache of a text document. */
+	void SaveChildrenBinary(Stream &stream) const;
+
+	Node * GetParent() const { return m_Parent; }
+	Node * GetFirstChild() const { return m_FirstChild; }
+	Node * GetLastChild() const { return m_LastChild; }
+	Node * GetPrevSibling() const { return m_PrevSibling; }
+	Node * GetNextSibling() const { return m_NextSibling; }
+
+	Node * FindFirstChild(const tstring &name) const;
+	Node * FindLastChild(const tstring &name) const;
+	Node * FindPrevSibling(const tstring &name) const;
+	Node * FindNextSibling(const tstring &name) const;
+	Node & MustFindFirstChild(const tstring &name) const;
+	/// Returns range of all children with given name, in order.
+	NamedChildRange FindAllChildren(const tstring &name) const;
+
+	size_t CalcChildCount() const;
+	size_t CalcChildCount(const tstring &name) const;
+	bool HasChildren() const { return m_FirstChild != NULL; }
+
+	void Clear();
+	void DeleteAllChildren();
+	void DeleteAllChildren(const tstring &name);
+
+	void InsertChildAtBegin(const Node &addThis);
+	void InsertChildAtEnd(const Node &addThis);
+	void InsertChildBefore(Node *beforeThis, const Node &addThis);
+	void InsertChildAfter(Node *afterThis, const Node &addThis);
+	/// Unlinks and destroys the node. Don't use delete on nodes of a Document.
+	void DeleteChild(Node *deleteThis);
+
+	void LinkChildAtBegin(Node *addThis);
+	void LinkChildAtEnd(Node *addThis);
+	void LinkChildBefore(Node *beforeThis, Node *addThis);
+	void LinkChildAfter(Node *afterThis, Node *addThis);
+	void UnlinkChild(Node *deleteThis);
+
+private:
+	Node *m_Parent;
+	Node *m_FirstChild, *m_LastChild;
+	Node *m_PrevSibling, *m_NextSibling;
+	/// Index of children by name, NULL if not built.
+	mutable ChildIndex *m_ChildIndex;
+
+	/// Creates node belonging to a document.
+	explicit Node(Document_pimpl *doc);
+	Document_pimpl * GetDocumentPimpl() const { return Name.m_Doc; }
+	/// Destroys standalone node or returns document node to the document for reuse.
+	static void DestroyNode(Node *node);
+
+	/// Builds index of children if the search had to visit this many of them.
+	static const size_t CHILD_INDEX_MIN_VISITED = 32;
+	Node * FindNextSibling(const tchar *name, size_t length) const;
+	void BuildChildIndex() const;
+	void DeleteChildIndex() const;
+	/// Name is the first member, so the node can be found from the address of its name.
+	static Node * FromName(NodeString *name) { return reinterpret_cast<Node*>(name); }
+	/// Called before and after name of this node changes. Keep the index of the parent up to date.
+	Node * BeginNameChange();
+	void EndNameChange(Node *indexedParent);
+};
+
+/// Range of child nodes with the same name, returned by Node::FindAllChildren.
+/** Can be used in a loop like:
+\code
+NamedChildRange range = node.FindAllChildren(_T("Item"));
+for (NamedChildRange::iterator it = range.begin(); it != range.end(); ++it)
+	Process(*it);
+\endcode
+Don't rename or unlink the current node while iterating. */
+class NamedChildRange
+{
+public:
+	class iterator
+	{
+		friend class NamedChildRange;
+
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef Node value_type;
+		typedef ptrdiff_t difference_type;
+		typedef Node * pointer;
+		typedef Node & reference;
+
+		iterator() : m_Node(NULL) { }
+		Node & operator * () const { return *m_Node; }
+		Node * operator -> () const { return m_Node; }
+		/// All nodes of the range have the same name, so the iterator doesn't need the range.
+		iterator & operator ++ () { m_Node = m_Node->FindNextSibling(m_Node->Name.data(), m_Node->Name.length()); return *this; }
+		iterator operator ++ (int) { iterator r = *this; ++*this; return r; }
+		bool operator == (const iterator &rhs) const { return m_Node == rhs.m_Node; }
+		bool operator != (const iterator &rhs) const { return m_Node != rhs.m_Node; }
+
+	private:
+		Node *m_Node;
+
+		explicit iterator(Node *node) : m_Node(node) { }
+	};
+
+	explicit NamedChildRange(Node *first) : m_First(first) { }
+
+	iterator begin() const { return iterator(m_First); }
+	iterator end() const { return iterator(NULL); }
+	bool empty() const { return m_First == NULL; }
+
+private:
+	Node *m_First;
+};
+
+/// Owner of a TokDoc tree that allocates all its nodes and strings from its own memory.
+/**
+Nodes and strings are allocated one after another from large memory blocks, so loading a
+big document doesn't make an allocation per node and nodes close in the document are
+close in memory. Names are interned - every distinct name is stored once. Destroying or
+clearing the document frees just the blocks, without visiting nodes.
+
+Nodes deleted from the tree are reused by next CreateNode(), but memory of strings that
+were overwritten or deleted is freed only with the whole document. Document is not
+thread-safe.
+*/
+class Document
+{
+	DECLARE_NO_COPY_CLASS(Document)
+
+public:
+	Document();
+	~Document();
+
+	/// Root node. Has no name and value, its children are top-level nodes of the document.
+	Node & GetRoot();
+	const Node & GetRoot() const;
+	/// Creates new node that belongs to this document, not linked anywhere yet.
+	Node * CreateNode() { return GetRoot().CreateNode(); }
+	Node * CreateNode(const tstring &value) { return GetRoot().CreateNode(value); }
+	Node * CreateNode(const tstring &name, const tstring &value) { return GetRoot().CreateNode(name, value); }
+
+	/// Replaces contents of the document with the one loaded from tokenizer - see Node::LoadChildren.
+	/** Memory blocks of previous contents are reused, so loading a document again is faster. */
+	void Load(Tokenizer &tok);
+	void Save(TokenWriter &tok) const { GetRoot().SaveChildren(tok); }
+	/// Replaces contents of the document with the one loaded from binary format - see Node::SaveChildrenBinary.
+	/** All strings are read into document memory at once and nodes refer to them. */
+	void LoadBinary(Stream &stream);
+	/// Replaces contents of the document with binary format stored in memory.
+	void LoadBinary(const void *data, size_t size);
+	void SaveBinary(Stream &stream) const { GetRoot().SaveChildrenBinary(stream); }
+	/// Deletes all nodes and frees all memory.
+	void Clear();
+
+	/// Number of bytes in memory blocks allocated so far.
+	size_t GetAllocatedBytes() const;
+	/// Number of distinct names stored.
+	size_t GetNameCount() const;
+
+private:
+	scoped_ptr<Document_pimpl> pimpl;
+};
+
+/// Reads TokDoc document from Tokenizer node by node, without building a tree.
+/**
+Memory use doesn't depend on the document size, so it's suitable for documents too big
+to load and, with Tokenizer reading from a Stream, nodes can be processed while the
+rest of the document is still being read. Usage:
+
+\code
+tok.Next();
+NodeReader reader(tok);
+while (reader.Next() != NodeReader::EVENT_END)
+{
+	if (reader.GetEvent() == NodeReader::EVENT_BEGIN_NODE && reader.GetName() == _T("Item"))
+	{
+		Node item;
+		reader.ReadNode(item);
+		Process(item);
+	}
+}
+\endcode
+
+Every node generates EVENT_BEGIN_NODE, then events of all its children, then EVENT_END_NODE.
+Reading ends on end of the document or symbol <tt>}</tt> which closes the list of
+nodes it started in, like in Node::LoadChildren. That symbol is not consumed.
+*/
+class NodeReader
+{
+public:
+	enum EVENT
+	{
+		/// Next() has not been called yet.
+		EVENT_NONE,
+		/// Name, value and HasChildren of the node are available.
+		EVENT_BEGIN_NODE,
+		EVENT_END_NODE,
+		/// No more nodes.
+		EVENT_END,
+	};
+
+	/** \param tok Must be configured WITHOUT flag FLAG_TOKEN_EOL and be at the first token. */
+	NodeReader(Tokenizer &tok);
+
+	/// Reads next event and returns it.
+	EVENT Next();
+	EVENT GetEvent() const { return m_Event; }
+	/// Depth of current node. Top-level nodes have depth 0.
+	uint GetDepth() const { return m_Depth; }
+
+	/// Name of current node. Valid after EVENT_BEGIN_NODE.
+	const tstring & GetName() const { return m_Name; }
+	/// Value of current node. Valid after EVENT_BEGIN_NODE.
+	const tstring & GetValue() const { return m_Value; }
+	/// Valid after EVENT_BEGIN_NODE.
+	bool HasChildren() const { return m_HasChildren; }
+
+	/// Skips all children of current node without parsing them.
+	/** Call only after EVENT_BEGIN_NODE. Current event becomes EVENT_END_NODE of this node. */
+	void SkipChildren();
+	/// Reads current node with all its children into given node, replacing its contents.
+	/** Call only after EVENT_BEGIN_NODE. Current event becomes EVENT_END_NODE of this node. */
+	void ReadNode(Node &out);
+
+private:
+	Tokenizer &m_Tok;
+	EVENT m_Event;
+	uint m_Depth;
+	tstring m_Name, m_Value;
+	bool m_HasChildren;
+	/// Current node has no children - its EVENT_END_NODE is next.
+	bool m_LeafEndPending;
+
+	/// Consumes separator after a node.
+	void FinishNode();
+	/// Consumes '}' that ends children of current node.
+	void EndChildren();
+};
+
+/// Writes TokDoc document to TokenWriter node by node, without building a tree.
+/**
+Output is the same as Node::SaveChildren would write for the same tree.
+Memory use depends only on the depth of nesting. Usage:
+
+\code
+NodeWriter writer(tok);
+writer.BeginNode(_T("Items"), EMPTY_STRING);
+for (size_t i = 0; i < count; i++)
+	writer.WriteNode(_T("Item"), items[i]);
+writer.EndNode();
+\endcode
+*/
+class NodeWriter
+{
+public:
+	/** \param tok Should have symbols registered like for Node::SaveChildren. */
+	NodeWriter(TokenWriter &tok);
+
+	/// Starts a node. Its children are written until matching EndNode.
+	void BeginNode(const tstring &name, const tstring &value) { BeginNode(name.data(), name.length(), value.data(), value.length()); }
+	void EndNode();
+	/// Writes node without children.
+	void WriteNode(const tstring &name, const tstring &value) { BeginNode(name, value); EndNode(); }
+	/// Writes given node with all its children.
+	void WriteNode(const Node &node);
+
+	/// Number of nodes begun and not ended yet.
+	size_t GetDepth() const { return m_Levels.size(); }
+
+private:
+	enum LEVEL_STATE
+	{
+		/// Node has no name nor value and nothing has been written yet.
+		LEVEL_EMPTY,
+		/// Name or value has been written, but no children yet.
+		LEVEL_STARTED,
+		/// Symbol '{' has been written.
+		LEVEL_CHILDREN,
+	};
+
+	TokenWriter &m_Tok;
+	std::vector<LEVEL_STATE> m_Levels;
+
+	void BeginNode(const tchar *name, size_t nameLength, const tchar *value, size_t valueLength);
+	/// Called before writing a child of current node.
+	void OpenChildren();
+};
+
+class BinaryDocument;
+
+/// Read-only node of a document in binary format, navigated in place by BinaryDocument.
+/** Lightweight handle - copy it by value. Null handle means no node.
+Navigation is forward only - there is no parent, previous sibling or last child. */
+class BinaryNode
+{
+	friend class BinaryDocument;
+	friend class Node;
+	friend class Document;
+
+public:
+	BinaryNode() : m_Doc(NULL), m_Record(NULL), m_SiblingsEnd(NULL) { }
+
+	bool IsNull() const { return m_Doc == NULL; }
+
+	/// Name, with terminating zero.
+	const tchar * GetName() const;
+	size_t GetNameLength() const;
+	tstring GetNameStr() const { return tstring(GetName(), GetNameLength()); }
+	/// Value, with terminating zero.
+	const tchar * GetValue() const;
+	size_t GetValueLength() const;
+	tstring GetValueStr() const { return tstring(GetValue(), GetValueLength()); }
+
+	bool HasChildren() const;
+	BinaryNode GetFirstChild() const;
+	BinaryNode GetNextSibling() const;
+	BinaryNode FindFirstChild(const tstring &name) const;
+	BinaryNode FindNextSibling(const tstring &name) const;
+	size_t CalcChildCount() const;
+
+	/// Copies this node with all its children to given node, replacing its contents.
+	void CopyTo(Node &node) const;
+
+private:
+	struct RECORD
+	{
+		uint32 NameIndex, ValueIndex;
+		const uint8 *ChildrenBegin, *ChildrenEnd;
+	};
+
+	const BinaryDocument *m_Doc;
+	/// NULL for root.
+	const uint8 *m_Record;
+	const uint8 *m_SiblingsEnd;
+
+	BinaryNode(const BinaryDocument *doc, const uint8 *record, const uint8 *siblingsEnd) : m_Doc(doc), m_Record(record), m_SiblingsEnd(siblingsEnd) { }
+	void Decode(RECORD &out) const;
+	/// Creates children of given node from children of this one. Node must have no children.
+	void CopyChildrenTo(Node &node) const;
+};
+
+/// Document in binary format (see Node::SaveChildrenBinary) navigated in place, without loading.
+/** Data must stay in memory, unchanged, as long as this object and its nodes are used.
+It can be for example a memory-mapped file. Data must be aligned to 4 bytes, because
+the header and string table are read in place - Document::LoadBinary accepts any address.
+Header is validated in the constructor, which throws Error on invalid or misaligned data. */
+class BinaryDocument
+{
+	friend class BinaryNode;
+	friend class Node;
+	friend class Document;
+
+public:
+	BinaryDocument(const void *data, size_t size);
+
+	/// Root node. Has no name and value, its children are top-level nodes of the document.
+	BinaryNode GetRoot() const { return BinaryNode(this, NULL, m_RecordsEnd); }
+	size_t GetStringCount() const { return m_StringCount; }
+
+private:
+	uint32 m_StringCount;
+	const uint32 *m_StringOffsets;
+	const tchar *m_Chars;
+	const uint8 *m_Records, *m_RecordsEnd;
+	/// Document that has m_Chars in its memory, so its nodes can refer to them, or NULL.
+	Document_pimpl *m_CharsOwner;
+
+	/// Creates document from parts already read. Validates the string table.
+	BinaryDocument(uint32 stringCount, const uint32 *stringOffsets, const tchar *chars, const uint8 *records, size_t recordBytes, Document_pimpl *charsOwner);
+	void ValidateStrings(uint32 charCount) const;
+
+	const tchar * GetString(uint32 index) const { return m_Chars + m_StringOffsets[index]; }
+	size_t GetStringLength(uint32 index) const { return m_StringOffsets[index + 1] - m_StringOffsets[index] - 1; }
+};
+
+/// Converts value of any type (supported by SthToStr) to string stored into Value of given node.
+template <typename T>
+inline void NodeValueFromSth(Node &node, const T &val)
+{
+	tstring valStr;
+	SthToStr<T>(&valStr, val);
+	node.Value = valStr;
+}
+
+/// Parses string from Value of given node to value of any type (supported by StrToSth).
+template <typename T>
+inline bool NodeValueToSth(T &out, const Node &node, bool required)
+{
+	if (required)
+		MustStrToSth<T>(&out, node.Value);
+	else
+	{
+		T tmpVal;
+		if (StrToSth(&tmpVal, node.Value))
+			out = tmpVal;
+		else
+			return false;
+	}
+	return true;
+}
+
+/// Converts enumeration value (given as uint) into string with the value name stored into Value of given node.
+/** If val is other than values of items given, val is converted to numeric string, like "123".
+\param itemValues Can be NULL, which means consecutive items have values 0, 1, 2, ... */
+void NodeValueFromEnum(Node &node, uint val,
+	const tchar * const *itemNames, const uint *itemValues, size_t itemCount);
+/// Parses string from Value of given node to enumeration value (given as uint&).
+/** node.Value may be one of given item names or a numeric string, like "123".
+\param itemValues Can be NULL, which means consecutive items have values 0, 1, 2, ... */
+bool NodeValueToEnum(uint &out, const Node &node, bool required,
+	const tchar * const *itemNames, const uint *itemValues, size_t itemCount);
+
+template <typename T>
+inline void NodeFromVector(Node &node, const std::vector<T> &vec)
+{
+	node.DeleteAllChildren();
+	node.Value.clear();
+
+	for (size_t i = 0; i < vec.size(); i++)
+	{
+		Node *childNode = node.CreateNode();
+		node.LinkChildAtEnd(childNode);
+		NodeFrom(*childNode, vec[i]);
+	}
+}
+
+template <typename T>
+inline bool NodeToVector(std::vector<T> &out, const Node &node, bool required)
+{
+	out.clear();
+	T tmpVal;
+	for (Node *childNode = node.FindFirstChild(EMPTY_STRING); childNode; childNode = childNode->FindNextSibling(EMPTY_STRING))
+	{
+		if (!NodeTo(tmpVal, *childNode, required))
+			return false;
+		out.push_back(tmpVal);
+	}
+	return true;
+}
+
+/// \internal
+inline bool _StrIsUintWithBase(const NodeString &s)
+{
+	return s.length() > 2 && s[0] == '0' && (s[1] == 'x' || s[1] == 'X');
+}
+
+/// Parses Value string of given node to unsigned integer of type T, while supporting standard numbers like "123" as well as hexadecimal notation like "0x123FF".
+template <typename T>
+inline bool NodeValueToUint(T &out, const Node &node, bool required)
+{
+	if (_StrIsUintWithBase(node.Value))
+	{
+		bool ok = StrToUint(&out, node.Value.data() + 2, node.Value.length() - 2, 16) == 0;
+		if (required && !ok)
+			throw Error(_T("Cannot parse TokDoc node \"") + node.Name + _T("\" = \"") + node.Value + _T("\" to unsigned integer."), __TFILE__, __LINE__);
+		return ok;
+	}
+	else
+		return NodeValueToSth(out, node, required);
+}
+
+template <typename T, typename UT>
+inline bool NodeValueToInt(T &out, const Node &node, bool required)
+{
+	if (_StrIsUintWithBase(node.Value))
+		return NodeValueToUint((UT&)out, node, required);
+	else
+		return NodeValueToSth(out, node, required);
+}
+
+inline void NodeFrom(Node &node, bool val) { NodeValueFromSth(node, val); }
+inline void NodeFrom(Node &node, tchar val) { node.DeleteAllChildren(); node.Value.assign(&val, 1); }
+inline void NodeFrom(Node &node, const tstring &val) { node.DeleteAllChildren(); node.Value = val; }
+inline void NodeFrom(Node &node, const tchar *val) { node.DeleteAllChildren(); node.Value = val; }
+inline void NodeFrom(Node &node, uint8 val) { node.DeleteAllChildren(); NodeValueFromSth(node, val); }
+inline void NodeFrom(Node &node, uint16 val) { node.DeleteAllChildren(); NodeValueFromSth(node, val); }
+inline void NodeFrom(Node &node, uint32 val) { node.DeleteAllChildren(); NodeValueFromSth(node, val); }
+inline void NodeFrom(Node &node, uint64 val) { node.DeleteAllChildren(); NodeValueFromSth(node, val); }
+inline void NodeFrom(Node &node, int16 val) { node.DeleteAllChildren(); NodeValueFromSth(node, val); }
+inline void NodeFrom(Node &node, int32 val) { node.DeleteAllChildren(); NodeValueFromSth(node, val); }
+inline void NodeFrom(Node &node, int64 val) { node.DeleteAllChildren(); NodeValueFromSth(node, val); }
+inline void NodeFrom(Node &node, unsigned long val) { node.DeleteAllChildren(); NodeValueFromSth(node, val); }
+inline void NodeFrom(Node &node, long val) {node.DeleteAllChildren();  NodeValueFromSth(node, val); }
+inline void NodeFrom(Node &node, float val) { node.DeleteAllChildren(); NodeValueFromSth(node, val); }
+inline void NodeFrom(Node &node, double val) { node.DeleteAllChildren(); NodeValueFromSth(node, val); }
+
+inline bool NodeTo(bool &out, const Node &node, bool required) { return NodeValueToSth(out, node, required); }
+inline bool NodeTo(tchar &out, const Node &node, bool required) { return NodeValueToSth(out, node, required); }
+inline bool NodeTo(tstring &out, const Node &node, bool required) { out.assign(node.Value.data(), node.Value.length()); return true; }
+inline bool NodeTo(uint8 &out, const Node &node, bool required) { return NodeValueToUint(out, node, required); }
+inline bool NodeTo(uint16 &out, const Node &node, bool required) { return NodeValueToUint(out, node, required); }
+inline bool NodeTo(uint32 &out, const Node &node, bool required) { return NodeValueToUint(out, node, required); }
+inline bool NodeTo(uint64 &out, const Node &node, bool required) { return NodeValueToUint(out, node, required); }
+inline bool NodeTo(unsigned long &out, const Node &node, bool required) { return NodeValueToUint(out, node, required); }
+inline bool NodeTo(int16 &out, const Node &node, bool required) { return NodeValueToInt<int16, uint16>(out, node, required); }
+inline bool NodeTo(int32 &out, const Node &node, bool required) { return NodeValueToInt<int32, uint32>(out, node, required); }
+inline bool NodeTo(int64 &out, const Node &node, bool required) { return NodeValueToInt<int64, uint64>(out, node, required); }
+inline bool NodeTo(long &out, const Node &node, bool required) { return NodeValueToInt<long, unsigned long>(out, node, required); }
+inline bool NodeTo(float &out, const Node &node, bool required) { return NodeValueToSth(out, node, required); }
+inline bool NodeTo(double &out, const Node &node, bool required) { return NodeValueToSth(out, node, required); }
+
+// ======== Time types ========
+
+#ifdef _WIN32
+void NodeFrom(Node &node, GameTime val);
+bool NodeTo(GameTime &out, const Node &node, bool required);
+#endif // #ifdef _WIN32
+
+// ======== Math types ========
+
+void NodeFrom(Node &node, const POINT_ &val);
+void NodeFrom(Node &node, const RECTI &val);
+void NodeFrom(Node &node, const VEC2 &val);
+void NodeFrom(Node &node, const VEC3 &val);
+void NodeFrom(Node &node, const VEC4 &val);
+void NodeFrom(Node &node, COLOR val);
+void NodeFrom(Node &node, const COLORF &val);
+void NodeFrom(Node &node, const RECTF &val);
+void NodeFrom(Node &node, const BOX &val);
+void NodeFrom(Node &node, const QUATERNION &val);
+void NodeFrom(Node &node, const MATRIX &val);
+void NodeFrom(Node &node, const AFFINE2D &val);
+void NodeFrom(Node &node, const LINE2D &val);
+void NodeFrom(Node &node, const PLANE &val);
+
+bool NodeTo(POINT_ &out, const Node &node, bool required);
+bool NodeTo(RECTI &out, const Node &node, bool required);
+bool NodeTo(VEC2 &out, const Node &node, bool required);
+bool NodeTo(VEC3 &out, const Node &node, bool required);
+bool NodeTo(VEC4 &out, const Node &node, bool required);
+bool NodeTo(COLOR &out, const Node &node, bool required);
+bool NodeTo(COLORF &out, const Node &node, bool required);
+bool NodeTo(RECTF &out, const Node &node, bool required);
+bool NodeTo(BOX &out, const Node &node, bool required);
+bool NodeTo(QUATERNION &out, const Node &node, bool required);
+bool NodeTo(MATRIX &out, const Node &node, bool required);
+bool NodeTo(AFFINE2D &out, const Node &node, bool required);
+bool NodeTo(LINE2D &out, const Node &node, bool required);
+bool NodeTo(PLANE &out, const Node &node, bool required);
+
+
+template <typename T>
+void SubnodeFrom(Node &node, const tstring &subnodeName, const T &val)
+{
+	Node *subnode = node.FindFirstChild(subnodeName);
+	if (subnode == NULL)
+		node.LinkChildAtEnd(subnode = node.CreateNode(subnodeName, EMPTY_STRING));
+	NodeFrom(*subnode, val);
+}
+
+/// Condition for SubnodeTo() telling about how to treat errors.
+enum SUBNODE_COND
+{
+	SUBNODE_OPTIONAL_CORRECT, ///< Optional, but must be correct if exists. Subnode not exists: return false. Parse error: throw exception.
+	SUBNODE_REQUIRED,         ///< Strictly required. Subnode not exists or parse error: throw exception.
+	SUBNODE_OPTIONAL,         ///< Libearlly optional. Subnode not exists or parse error: return false.
+};
+
+template <typename T>
+bool SubnodeTo(T &out, const Node &node, const tstring &subnodeName, SUBNODE_COND required)
+{
+	Node *subnode = node.FindFirstChild(subnodeName);
+	if (subnode == NULL)
+	{
+		if (required == SUBNODE_REQUIRED)
+			throw Error(_T("TokDoc subnode \"") + subnodeName + _T("\" not found"), __TFILE__, __LINE__);
+		return false;
+	}
+	return NodeTo(out, *subnode, required != SUBNODE_OPTIONAL);
+}
+
+
+//@}
+// code_tokdoc
+} // namespace tokdoc
+} // namespace common
+
+#endif
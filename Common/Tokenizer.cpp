@@ -1,1213 +1,1774 @@
-/** \file
-\brief Parser of language syntax similar to C/C++
-\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
-
-Part of CommonLib library. \n
-Encoding UTF-8, end of line CR+LF \n
-License: GNU LGPL. \n
-Documentation: \ref Module_Tokenizer \n
-Module components: \ref code_tokenizer
-*/
-#include "Base.hpp"
-#include <map>
-#include "Stream.hpp"
-#include "Tokenizer.hpp"
-
-
-namespace common
-{
-
-TokenizerError::TokenizerError(size_t Char, size_t Row, size_t Col, const tstring &Msg, const tstring &File, int a_Line) :
-	m_Char(Char),
-	m_Row(Row),
-	m_Col(Col)
-{
-	if (Msg.empty())
-		Push(Format(_T("Tokenizer(row=#, col=#, char=#)")) % m_Row % m_Col % m_Char, __TFILE__, __LINE__);
-	else
-		Push(Format(_T("Tokenizer(row=#, col=#, char=#) #")) % m_Row % m_Col % m_Char % Msg, __TFILE__, __LINE__);
-}
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-// Klasa Tokenizer_pimpl
-
-typedef std::map<tstring, uint> KEYWORDS_MAP;
-
-class Tokenizer_pimpl
-{
-public:
-	// Ktre znaki s symbolami
-	bool m_Symbols[256];
-
-	// Flagi
-	bool m_FlagTokenEOL;
-	bool m_FlagMultilineStrings;
-
-	// Strumie do pobierania (jeden z tych trzech strumieni jest != NULL)
-	// - Z konstruktora char*, wchar_t*, wstring - strumie pamiciowy, mj wasny
-	scoped_ptr<MemoryStream> m_MemoryStream;
-	// - Z konstruktora string - strumie acuchowy, mj wasny
-	scoped_ptr<StringStream> m_StringStream;
-	// - Z konstruktora Stream* - strumie dowolny, zewntrzny
-	Stream *m_ExternalStream;
-	// CharReader do jednego z powyszych strumieni
-	scoped_ptr<TCharReader> m_CharReader;
-
-	// WARSTWA I - wczytywanie znakw
-	size_t m_CurrChar, m_CurrRow, m_CurrCol;
-	bool m_L1End; // albo to jest true...
-	tchar m_L1Char; // ...albo tu jest ostatnio wczytany znak
-	void L1Next();
-
-	// Zarejestrowane dane
-	KEYWORDS_MAP m_Keywords;
-
-	// Informacje na temat ostatnio odczytanego tokena
-	size_t m_LastChar, m_LastRow, m_LastCol;
-	Tokenizer::TOKEN m_LastToken;
-	tstring m_LastString; // wypeniany zawsze przy odczytaniu nastpnego tokena
-	uint m_LastId; // wypeniany przy TOKEN_KEYWORD
-
-	~Tokenizer_pimpl() { }
-
-	void InitSymbols();
-
-	tchar ParseStringChar();
-	void Parse();
-
-	template <typename T> bool GetUint(T *Out);
-	template <typename T> bool GetInt(T *Out);
-	template <typename T> T MustGetUint();
-	template <typename T> T MustGetInt();
-};
-
-void Tokenizer_pimpl::L1Next()
-{
-	m_L1End = !m_CharReader->ReadChar(&m_L1Char);
-
-	if (!m_L1End)
-	{
-		// Liczniki
-		m_CurrChar++;
-		if (m_L1Char == _T('\n'))
-		{
-			m_CurrRow++;
-			m_CurrCol = 0;
-		}
-		else
-			m_CurrCol++;
-
-		// Sekwencja "\\\n" lub "\\\r\n" jest pomijana - amanie linii za pomoc znaku \ ...
-		if (m_L1Char == _T('\\'))
-		{
-			tchar Ch;
-			if (m_CharReader->PeekChar(&Ch) && Ch == _T('\r'))
-			{
-				m_CharReader->SkipChar();
-				m_CurrChar++;
-			}
-			if (m_CharReader->PeekChar(&Ch) && Ch == _T('\n'))
-			{
-				m_CharReader->SkipChar();
-				m_CurrChar++;
-				m_CurrRow++;
-				m_CurrCol = 0;
-				L1Next();
-			}
-		}
-	}
-}
-
-void Tokenizer_pimpl::InitSymbols()
-{
-	std::fill(&m_Symbols[0], &m_Symbols[256], false);
-
-	const tchar * DEFAULT_SYMBOLS = _T("`~!@#$%^&*()=[]{};:,.<>?\\|");
-
-#ifdef _WIN32
-	size_t SymbolCount = _tcslen(DEFAULT_SYMBOLS);
-#else
-	size_t SymbolCount = strlen(DEFAULT_SYMBOLS);
-#endif
-	for (size_t i = 0; i < SymbolCount; i++)
-		m_Symbols[(uint8)DEFAULT_SYMBOLS[i]] = true;
-}
-
-tchar Tokenizer_pimpl::ParseStringChar()
-{
-	// Musi by tu ju sprawdzone, e nie jest koniec oraz e m_L1Char nie jest znakiem koczcym acuch/znak
-	assert(!m_L1End);
-
-	// Escape sequence
-	if (m_L1Char == _T('\\'))
-	{
-		L1Next();
-		if (m_L1End)
-			throw TokenizerError(m_LastChar, m_LastRow, m_LastCol, _T("Unexpected and of data inside escape sequence."), __TFILE__, __LINE__);
-		// Staa szesnastkowa
-		if (m_L1Char == 'x')
-		{
-			uint8 Number1, Number2;
-			L1Next();
-
-			// Nastpne dwa znaki
-
-			if (m_L1End)
-				throw TokenizerError(m_LastChar, m_LastRow, m_LastCol, _T("Unexpected and of data inside escape sequence."), __TFILE__, __LINE__);
-			Number1 = HexDigitToNumber(m_L1Char);
-			L1Next();
-
-			if (m_L1End)
-				throw TokenizerError(m_LastChar, m_LastRow, m_LastCol, _T("Unexpected and of data inside escape sequence."), __TFILE__, __LINE__);
-			Number2 = HexDigitToNumber(m_L1Char);
-			L1Next();
-
-			if (Number1 == 0xFF || Number2 == 0xFF)
-				throw TokenizerError(m_LastChar, m_LastRow, m_LastCol, _T("Invalid hexadecimal escape sequence."), __TFILE__, __LINE__);
-
-			return (tchar)(Number1 << 4 | Number2);
-		}
-		// Zwyka staa
-		else
-		{
-			tchar R;
-			switch (m_L1Char)
-			{
-			case _T('n'): R = _T('\n'); break;
-			case _T('t'): R = _T('\t'); break;
-			case _T('v'): R = _T('\v'); break;
-			case _T('b'): R = _T('\b'); break;
-			case _T('r'): R = _T('\r'); break;
-			case _T('f'): R = _T('\f'); break;
-			case _T('a'): R = _T('\a'); break;
-			case _T('0'): R = _T('\0'); break;
-			case _T('\\'):
-			case _T('?'):
-			case _T('"'):
-			case _T('\''):
-				R = m_L1Char;
-				// Zostaje to co jest
-				break;
-			default:
-				throw TokenizerError(m_LastChar, m_LastRow, m_LastCol, _T("Unknown escape sequence: \\") + CharToStrR(m_L1Char), __TFILE__, __LINE__);
-			}
-			L1Next();
-			return R;
-		}
-	}
-	else
-	{
-		tchar R = m_L1Char;
-		L1Next();
-		return R;
-	}
-}
-
-void Tokenizer_pimpl::Parse()
-{
-	for (;;)
-	{
-		m_LastChar = m_CurrChar;
-		m_LastRow = m_CurrRow;
-		m_LastCol = m_CurrCol;
-
-		// EOF
-		if (m_L1End)
-		{
-			m_LastString.clear();
-			m_LastToken = Tokenizer::TOKEN_EOF;
-			return;
-		}
-
-		// Symbol
-		if (m_Symbols[(uint8)m_L1Char])
-		{
-			CharToStr(&m_LastString, m_L1Char);
-			m_LastToken = Tokenizer::TOKEN_SYMBOL;
-			L1Next();
-			return;
-		}
-		// Biay znak
-		else if (m_L1Char == _T(' ') || m_L1Char == _T('\t') || m_L1Char == _T('\r') || m_L1Char == _T('\v'))
-		{
-			L1Next();
-			continue;
-		}
-		// Nagwek Unicode
-#ifdef _UNICODE
-		else if (m_L1Char == L'\xFFFE')
-		{
-			L1Next();
-			continue;
-		}
-#endif
-		// Koniec wiersza
-		else if (m_L1Char == _T('\n'))
-		{
-			// Jako token
-			if (m_FlagTokenEOL)
-			{
-				m_LastString = _T("\n");
-				m_LastToken = Tokenizer::TOKEN_EOL;
-				L1Next();
-				return;
-			}
-			// Jako biay znak
-			else
-			{
-				L1Next();
-				continue;
-			}
-		}
-		// Staa znakowa
-		else if (m_L1Char == _T('\''))
-		{
-			// Nastpny znak
-			L1Next();
-			if (m_L1End)
-				throw TokenizerError(m_LastChar, m_LastRow, m_LastCol, _T("Unexpected end of data inside character constant."), __TFILE__, __LINE__);
-			// Znak (sekwencja ucieczki lub zwyky)
-			CharToStr(&m_LastString, ParseStringChar());
-			// Nastpny znak - to musi by zakoczenie '
-			if (m_L1End)
-				throw TokenizerError(m_LastChar, m_LastRow, m_LastCol, _T("Unexpected end of data inside character constant."), __TFILE__, __LINE__);
-			if (m_L1Char != _T('\''))
-				throw TokenizerError(m_LastChar, m_LastRow, m_LastCol, _T("End of character constant expected: '"), __TFILE__, __LINE__);
-			m_LastToken = Tokenizer::TOKEN_CHAR;
-			L1Next();
-			return;
-		}
-		// Staa acuchowa
-		else if (m_L1Char == _T('"'))
-		{
-			L1Next();
-			m_LastString.clear();
-			for (;;)
-			{
-				// Nastpny znak
-				if (m_L1End)
-					throw TokenizerError(m_LastChar, m_LastRow, m_LastCol, _T("Unexpected end of data inside string constant."), __TFILE__, __LINE__);
-				// Koniec acucha
-				if (m_L1Char == _T('"'))
-				{
-					L1Next();
-					break;
-				}
-				// Koniec wiersza, podczas gdy nie moe go by
-				else if ( (m_L1Char == _T('\r') || m_L1Char == _T('\n')) && !m_FlagMultilineStrings )
-					throw TokenizerError(m_LastChar, m_LastRow, m_LastCol, _T("Unexpected end of data inside string constant."), __TFILE__, __LINE__);
-				// Znak (sekwencja ucieczki lub zwyky)
-				else
-					m_LastString += ParseStringChar();
-			}
-			m_LastToken = Tokenizer::TOKEN_STRING;
-			return;
-		}
-		// Identyfikator lub sowo kluczowe
-		else if ( (m_L1Char <= _T('Z') && m_L1Char >= _T('A')) || (m_L1Char <= _T('z') && m_L1Char >= _T('a')) || m_L1Char == _T('_') )
-		{
-			CharToStr(&m_LastString, m_L1Char);
-			L1Next();
-			// Wczytaj nastpne znaki
-			while ( !m_L1End &&
-				( (m_L1Char <= _T('Z') && m_L1Char >= _T('A')) || (m_L1Char <= _T('z') && m_L1Char >= _T('a')) || (m_L1Char <= _T('9') && m_L1Char >= _T('0')) || m_L1Char == _T('_') ) )
-			{
-				m_LastString += m_L1Char;
-				L1Next();
-			}
-			// Znajd sowo kluczowe
-			KEYWORDS_MAP::iterator it = m_Keywords.find(m_LastString);
-			if (it == m_Keywords.end())
-				m_LastToken = Tokenizer::TOKEN_IDENTIFIER;
-			else
-			{
-				m_LastToken = Tokenizer::TOKEN_KEYWORD;
-				m_LastId = it->second;
-			}
-			return;
-		}
-		// Znak '/' moe rozpoczyna komentarz // , /* lub by zwykym symbolem
-		else if (m_L1Char == _T('/'))
-		{
-			L1Next();
-			if (!m_L1End)
-			{
-				// Pocztek komentarza //
-				if (m_L1Char == _T('/'))
-				{
-					L1Next();
-					// Pomi znaki do koca wiersza lub koca dokumentu
-					while (!m_L1End && m_L1Char != _T('\n'))
-						L1Next();
-					// Dalsze poszukiwanie tokena
-					continue;
-				}
-				// Pocztek komentarza /*
-				else if (m_L1Char == _T('*'))
-				{
-					L1Next();
-					bool WasAsterisk = false;
-					// Czytaj kolejne znaki
-					for (;;)
-					{
-						if (m_L1End)
-							throw TokenizerError(m_LastChar, m_LastRow, m_LastCol, _T("Unfinished comment /* */"), __TFILE__, __LINE__);
-						
-						if (m_L1Char == _T('*'))
-							WasAsterisk = true;
-						else if (m_L1Char == _T('/') && WasAsterisk)
-							// Koniec komentarza
-							break;
-						else
-							WasAsterisk = false;
-
-						L1Next();
-					}
-					// Dalsze poszukiwanie tokena
-					L1Next();
-					continue;
-				}
-			}
-			// Zwyky symbol '/'
-			CharToStr(&m_LastString, _T('/'));
-			m_LastToken = Tokenizer::TOKEN_SYMBOL;
-			L1Next();
-			return;
-		}
-		// Liczba cakowita lub zmiennoprzecinkowa
-		else if ( (m_L1Char <= _T('9') && m_L1Char >= _T('0')) || m_L1Char == _T('+') || m_L1Char == _T('-') )
-		{
-			// Pena poprawna skadnia liczb to mniej wicej (wyraenie regularne, \o \d \h to cyfra w danym systemie):
-			// [+-]?(0[xX]\h+|0\o+|(\d+\.\d*|\d*\.\d+|\d+)([dDeE][+-]?\d+)?)
-			// Ale e nie chce mi si tego a tak dokadnie parsowa, to zaakceptuj tutaj dowolny cig
-			// dowolnych cyfr, liter i znakw '.', '+' i '-' - ewentualny bd skadni i tak wyjdzie, tylko e pniej.
-			// Liczba jest na pewno cakowita, jeli zaczyna si od "0x" lub "0X" (nowo! tu by bd i 0xEE rozpoznawao jako zmiennoprzecinkowa!)
-			// Liczba jest zmiennoprzecinkowa wtedy, kiedy zawiera jeden ze znakw: [.dDeE]
-			CharToStr(&m_LastString, m_L1Char);
-			L1Next();
-			bool IsFloat = false;
-			while (!m_L1End && (
-				(m_L1Char <= _T('9') && m_L1Char >= _T('0')) ||
-				(m_L1Char <= _T('Z') && m_L1Char >= _T('A')) ||
-				(m_L1Char <= _T('z') && m_L1Char >= _T('a')) ||
-				m_L1Char == _T('+') || m_L1Char == _T('-') || m_L1Char == _T('.') ) )
-			{
-				if (m_L1Char == _T('.') || m_L1Char == _T('d') || m_L1Char == _T('D') || m_L1Char == _T('e') || m_L1Char == _T('E'))
-					IsFloat = true;
-				m_LastString += m_L1Char;
-				L1Next();
-			}
-			if (m_LastString.length() > 1 && m_LastString[0] == _T('0') && (m_LastString[1] == _T('x') || m_LastString[1] == _T('X')))
-				m_LastToken = Tokenizer::TOKEN_INTEGER;
-			else
-				m_LastToken = (IsFloat ? Tokenizer::TOKEN_FLOAT : Tokenizer::TOKEN_INTEGER);
-			return;
-		}
-		// Nieznany znak
-		else
-			throw TokenizerError(m_LastChar, m_LastRow, m_LastCol, Format(_T("Unrecognized character (code=0x#): \'#\'.")) % IntToStrR(TCHAR_TO_INT(m_L1Char), 16) % m_L1Char, __TFILE__, __LINE__);
-	}
-}
-
-template <typename T>
-bool Tokenizer_pimpl::GetUint(T *Out)
-{
-	if (m_LastString == _T("0"))
-	{
-		*Out = T();
-		return true;
-	}
-
-	// semkowo lub szesnastkowo
-	if (!m_LastString.empty() && m_LastString[0] == _T('0'))
-	{
-		// Szesnastkowo
-		if (m_LastString.length() > 1 && (m_LastString[1] == _T('x') || m_LastString[1] == _T('X')))
-			return ( StrToUint<T>(Out, m_LastString.substr(2), 16) == 0 );
-		// semkowo
-		else
-			return ( StrToUint<T>(Out, m_LastString.substr(1), 8) == 0 );
-	}
-	// Dziesitnie
-	else
-		return ( StrToUint<T>(Out, m_LastString) == 0 );
-}
-
-template <typename T>
-bool Tokenizer_pimpl::GetInt(T *Out)
-{
-	if (m_LastString == _T("0") || m_LastString == _T("-0") || m_LastString == _T("+0"))
-	{
-		*Out = T();
-		return true;
-	}
-
-	// Pocztkowy '+' lub '-'
-	if (!m_LastString.empty() && (m_LastString[0] == _T('+') || m_LastString[0] == _T('-')))
-	{
-		// Plus - tak jakby go nie byo, ale wszystko jest o znak dalej
-		if (m_LastString[0] == _T('+'))
-		{
-			// semkowo lub szesnastkowo
-			if (m_LastString.length() > 1 && m_LastString[1] == _T('0'))
-			{
-				// Szesnastkowo
-				if (m_LastString.length() > 2 && (m_LastString[2] == _T('x') || m_LastString[2] == _T('X')))
-					return ( StrToInt<T>(Out, m_LastString.substr(3), 16) == 0 );
-				// semkowo
-				else
-					return ( StrToInt<T>(Out, m_LastString.substr(2), 8) == 0 );
-			}
-			// Dziesitnie
-			else
-				return ( StrToInt<T>(Out, m_LastString.substr(1)) == 0 );
-		}
-		// Minus - uwzgldnij go
-		else
-		{
-			// semkowo lub szesnastkowo
-			if (m_LastString.length() > 1 && m_LastString[1] == _T('0'))
-			{
-				// Szesnastkowo
-				if (m_LastString.length() > 2 && (m_LastString[2] == _T('x') || m_LastString[2] == _T('X')))
-					return ( StrToInt<T>(Out, _T("-") + m_LastString.substr(3), 16) == 0 );
-				// semkowo
-				else
-					return ( StrToInt<T>(Out, _T("-") + m_LastString.substr(2), 8) == 0 );
-			}
-			// Dziesitnie
-			else
-				return ( StrToInt<T>(Out, _T("-") + m_LastString.substr(1)) == 0 );
-		}
-	}
-	else
-	{
-		// semkowo lub szesnastkowo
-		if (!m_LastString.empty() && m_LastString[0] == _T('0'))
-		{
-			// Szesnastkowo
-			if (m_LastString.length() > 1 && (m_LastString[1] == _T('x') || m_LastString[1] == _T('X')))
-				return ( StrToInt<T>(Out, m_LastString.substr(2), 16) == 0 );
-			// semkowo
-			else
-				return ( StrToInt<T>(Out, m_LastString.substr(1), 8) == 0 );
-		}
-		// Dziesitnie
-		else
-			return ( StrToInt<T>(Out, m_LastString) == 0 );
-	}
-}
-
-template <typename T>
-T Tokenizer_pimpl::MustGetUint()
-{
-	T R;
-	if (!GetUint(&R))
-		throw TokenizerError(m_LastChar, m_LastRow, m_LastCol, _T("Cannot convert tstring to unsigned integer number."), __TFILE__, __LINE__);
-	return R;
-}
-
-template <typename T>
-T Tokenizer_pimpl::MustGetInt()
-{
-	T R;
-	if (!GetInt(&R))
-		throw TokenizerError(m_LastChar, m_LastRow, m_LastCol, _T("Cannot convert tstring to signed integer number."), __TFILE__, __LINE__);
-	return R;
-}
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-// Klasa Tokenizer
-
-Tokenizer::Tokenizer(const tchar *Input, size_t NumChars, uint Flags) :
-	pimpl(new Tokenizer_pimpl())
-{
-	pimpl->InitSymbols();
-
-	pimpl->m_FlagTokenEOL = ((Flags & FLAG_TOKEN_EOL) != 0);
-	pimpl->m_FlagMultilineStrings = ((Flags & FLAG_MULTILINE_STRINGS) != 0);
-
-	pimpl->m_MemoryStream.reset(new MemoryStream(NumChars * sizeof(tchar), const_cast<tchar*>(Input)));
-	pimpl->m_StringStream.reset();
-	pimpl->m_ExternalStream = NULL;
-	pimpl->m_CharReader.reset(new TCharReader(pimpl->m_MemoryStream.get()));
-
-	pimpl->m_CurrChar = 0; pimpl->m_CurrRow = 1; pimpl->m_CurrCol = 0;
-	pimpl->L1Next();
-
-	pimpl->m_LastChar = 0; pimpl->m_LastRow = 1; pimpl->m_LastCol = 0;
-	pimpl->m_LastToken = TOKEN_EOF;
-	pimpl->m_LastId = 0;
-}
-
-Tokenizer::Tokenizer(const tstring *Input, uint Flags) :
-	pimpl(new Tokenizer_pimpl())
-{
-	pimpl->InitSymbols();
-
-	pimpl->m_FlagTokenEOL = ((Flags & FLAG_TOKEN_EOL) != 0);
-	pimpl->m_FlagMultilineStrings = ((Flags & FLAG_MULTILINE_STRINGS) != 0);
-
-	pimpl->m_ExternalStream = NULL;
-
-#ifdef _UNICODE
-	pimpl->m_MemoryStream.reset(new MemoryStream(Input->length() * sizeof(tchar), const_cast<tchar*>(Input->data())));
-	pimpl->m_StringStream.reset();
-	pimpl->m_CharReader.reset(new TCharReader(pimpl->m_MemoryStream.get()));
-#else
-	pimpl->m_MemoryStream.reset();
-	pimpl->m_StringStream.reset(new StringStream(const_cast<tstring*>(Input)));
-	pimpl->m_CharReader.reset(new TCharReader(pimpl->m_StringStream.get()));
-#endif
-
-	pimpl->m_CurrChar = 0; pimpl->m_CurrRow = 1; pimpl->m_CurrCol = 0;
-	pimpl->L1Next();
-
-	pimpl->m_LastChar = 0; pimpl->m_LastRow = 1; pimpl->m_LastCol = 0;
-	pimpl->m_LastToken = TOKEN_EOF;
-	pimpl->m_LastId = 0;
-}
-
-Tokenizer::Tokenizer(Stream *Input, uint Flags) :
-	pimpl(new Tokenizer_pimpl())
-{
-	pimpl->InitSymbols();
-
-	pimpl->m_FlagTokenEOL = ((Flags & FLAG_TOKEN_EOL) != 0);
-	pimpl->m_FlagMultilineStrings = ((Flags & FLAG_MULTILINE_STRINGS) != 0);
-
-	pimpl->m_MemoryStream.reset();
-	pimpl->m_StringStream.reset();
-	pimpl->m_ExternalStream = Input;
-	pimpl->m_CharReader.reset(new TCharReader(Input));
-
-	pimpl->m_CurrChar = 0; pimpl->m_CurrRow = 1; pimpl->m_CurrCol = 0;
-	pimpl->L1Next();
-
-	pimpl->m_LastChar = 0; pimpl->m_LastRow = 1; pimpl->m_LastCol = 0;
-	pimpl->m_LastToken = TOKEN_EOF;
-	pimpl->m_LastId = 0;
-}
-
-Tokenizer::~Tokenizer()
-{
-	pimpl->m_CharReader.reset();
-	pimpl->m_ExternalStream = NULL;
-	pimpl->m_StringStream.reset();
-	pimpl->m_MemoryStream.reset();
-
-	pimpl.reset();
-}
-
-void Tokenizer::RegisterKeyword(uint Id, const tstring &Keyword)
-{
-	pimpl->m_Keywords.insert(KEYWORDS_MAP::value_type(Keyword, Id));
-}
-
-void Tokenizer::RegisterKeywords(const tchar **Keywords, size_t KeywordCount)
-{
-	for (size_t i = 0; i < KeywordCount; i++)
-		RegisterKeyword((uint)i, Keywords[i]);
-}
-
-void Tokenizer::Next()
-{
-	pimpl->Parse();
-}
-
-Tokenizer::TOKEN Tokenizer::GetToken()
-{
-	return pimpl->m_LastToken;
-}
-
-size_t Tokenizer::GetCharNum()
-{
-	return pimpl->m_LastChar;
-}
-
-size_t Tokenizer::GetRowNum()
-{
-	return pimpl->m_LastRow;
-}
-
-size_t Tokenizer::GetColNum()
-{
-	return pimpl->m_LastCol;
-}
-
-const tstring & Tokenizer::GetString()
-{
-	return pimpl->m_LastString;
-}
-
-tchar Tokenizer::GetChar()
-{
-	assert(GetToken() == TOKEN_CHAR || GetToken() == TOKEN_SYMBOL);
-
-	return pimpl->m_LastString[0];
-}
-
-uint Tokenizer::GetId()
-{
-	assert(GetToken() == TOKEN_KEYWORD);
-
-	return pimpl->m_LastId;
-}
-
-bool Tokenizer::GetUint1(uint8 *Out) { AssertToken(TOKEN_INTEGER); return pimpl->GetUint<uint8>(Out); }
-bool Tokenizer::GetUint2(uint16 *Out) { AssertToken(TOKEN_INTEGER); return pimpl->GetUint<uint16>(Out); }
-bool Tokenizer::GetUint4(uint32 *Out) { AssertToken(TOKEN_INTEGER); return pimpl->GetUint<uint32>(Out); }
-bool Tokenizer::GetUint8(uint64 *Out) { AssertToken(TOKEN_INTEGER); return pimpl->GetUint<uint64>(Out); }
-
-bool Tokenizer::GetInt1(int8 *Out) { AssertToken(TOKEN_INTEGER); return pimpl->GetInt<int8>(Out); }
-bool Tokenizer::GetInt2(int16 *Out) { AssertToken(TOKEN_INTEGER); return pimpl->GetInt<int16>(Out); }
-bool Tokenizer::GetInt4(int32 *Out) { AssertToken(TOKEN_INTEGER); return pimpl->GetInt<int32>(Out); }
-bool Tokenizer::GetInt8(int64 *Out) { AssertToken(TOKEN_INTEGER); return pimpl->GetInt<int64>(Out); }
-
-uint8 Tokenizer::MustGetUint1() { AssertToken(TOKEN_INTEGER); return pimpl->MustGetUint<uint8>(); }
-uint16 Tokenizer::MustGetUint2() { AssertToken(TOKEN_INTEGER); return pimpl->MustGetUint<uint16>(); }
-uint32 Tokenizer::MustGetUint4() { AssertToken(TOKEN_INTEGER); return pimpl->MustGetUint<uint32>(); }
-uint64 Tokenizer::MustGetUint8() { AssertToken(TOKEN_INTEGER); return pimpl->MustGetUint<uint64>(); }
-
-int8 Tokenizer::MustGetInt1() { AssertToken(TOKEN_INTEGER); return pimpl->MustGetInt<int8>(); }
-int16 Tokenizer::MustGetInt2() { AssertToken(TOKEN_INTEGER); return pimpl->MustGetInt<int16>(); }
-int32 Tokenizer::MustGetInt4() { AssertToken(TOKEN_INTEGER); return pimpl->MustGetInt<int32>(); }
-int64 Tokenizer::MustGetInt8() { AssertToken(TOKEN_INTEGER); return pimpl->MustGetInt<int64>(); }
-
-bool Tokenizer::GetFloat(float *Out)
-{
-	AssertToken(TOKEN_INTEGER, TOKEN_FLOAT);
-
-	return ( StrToFloat(Out, pimpl->m_LastString) == 0 );
-}
-
-bool Tokenizer::GetDouble(double *Out)
-{
-	AssertToken(TOKEN_INTEGER, TOKEN_FLOAT);
-
-	return ( StrToDouble(Out, pimpl->m_LastString) == 0 );
-}
-
-float Tokenizer::MustGetFloat()
-{
-	float R;
-	if (!GetFloat(&R))
-		throw TokenizerError(pimpl->m_LastChar, pimpl->m_LastRow, pimpl->m_LastCol, _T("Cannot convert tstring to float number."), __TFILE__, __LINE__);
-	return R;
-}
-
-double Tokenizer::MustGetDouble()
-{
-	double R;
-	if (!GetDouble(&R))
-		throw TokenizerError(pimpl->m_LastChar, pimpl->m_LastRow, pimpl->m_LastCol, _T("Cannot convert tstring to double number."), __TFILE__, __LINE__);
-	return R;
-}
-
-void Tokenizer::CreateError()
-{
-	throw TokenizerError(pimpl->m_LastChar, pimpl->m_LastRow, pimpl->m_LastCol, _T("Unknown error"), __TFILE__, __LINE__);
-}
-
-void Tokenizer::CreateError(const tstring &Msg)
-{
-	throw TokenizerError(pimpl->m_LastChar, pimpl->m_LastRow, pimpl->m_LastCol, Msg, __TFILE__, __LINE__);
-}
-
-bool Tokenizer::QueryToken(Tokenizer::TOKEN Token)
-{
-	return (GetToken() == Token);
-}
-
-bool Tokenizer::QueryToken(TOKEN Token1, TOKEN Token2)
-{
-	return (GetToken() == Token1 || GetToken() == Token2);
-}
-
-bool Tokenizer::QueryEOF()
-{
-	return QueryToken(TOKEN_EOF);
-}
-
-bool Tokenizer::QueryEOL()
-{
-	return QueryToken(TOKEN_EOL);
-}
-
-bool Tokenizer::QuerySymbol(tchar Symbol)
-{
-	return (GetToken() == TOKEN_SYMBOL && GetChar() == Symbol);
-}
-
-bool Tokenizer::QueryIdentifier(const tstring &Identifier)
-{
-	return (GetToken() == TOKEN_IDENTIFIER && GetString() == Identifier);
-}
-
-bool Tokenizer::QueryKeyword(uint KeywordId)
-{
-	return (GetToken() == TOKEN_KEYWORD && GetId() == KeywordId);
-}
-
-bool Tokenizer::QueryKeyword(const tstring &Keyword)
-{
-	return (GetToken() == TOKEN_KEYWORD && GetString() == Keyword);
-}
-
-void Tokenizer::AssertToken(Tokenizer::TOKEN Token)
-{
-	if (Token != GetToken())
-		CreateError(_T("Expected: ") + tstring(GetTokenName(Token)));
-}
-
-void Tokenizer::AssertToken(TOKEN Token1, TOKEN Token2)
-{
-	if (Token1 != GetToken() && Token2 != GetToken())
-		CreateError(_T("Expected: ") + tstring(GetTokenName(Token1)) + _T(" or ") + GetTokenName(Token2));
-}
-
-void Tokenizer::AssertEOF()
-{
-	AssertToken(TOKEN_EOF);
-}
-
-void Tokenizer::AssertEOL()
-{
-	AssertToken(TOKEN_EOL);
-}
-
-void Tokenizer::AssertSymbol(tchar Symbol)
-{
-	if (GetToken() != TOKEN_SYMBOL || GetChar() != Symbol)
-		CreateError(_T("Expected symbol: ") + CharToStrR(Symbol));
-}
-
-void Tokenizer::AssertIdentifier(const tstring &Identifier)
-{
-	if (GetToken() != TOKEN_IDENTIFIER || GetString() != Identifier)
-		CreateError(_T("Expected identifier: ") + Identifier);
-}
-
-void Tokenizer::AssertKeyword(uint KeywordId)
-{
-	if (GetToken() != TOKEN_KEYWORD || GetId() != KeywordId)
-		CreateError(_T("Expected keyword number ") + UintToStrR(KeywordId));
-}
-
-void Tokenizer::AssertKeyword(const tstring &Keyword)
-{
-	if (GetToken() != TOKEN_KEYWORD || GetString() != Keyword)
-		CreateError(_T("Expected keyword: ") + Keyword);
-}
-
-const tchar * Tokenizer::GetTokenName(TOKEN Token)
-{
-	switch (Token)
-	{
-	case TOKEN_EOF:         return _T("End of data");
-	case TOKEN_EOL:         return _T("End of line");
-	case TOKEN_SYMBOL:      return _T("Symbol");
-	case TOKEN_INTEGER:     return _T("Integer number");
-	case TOKEN_FLOAT:       return _T("Float number");
-	case TOKEN_CHAR:        return _T("Character constant");
-	case TOKEN_IDENTIFIER:  return _T("Identifier");
-	case TOKEN_KEYWORD:     return _T("Keyword");
-	case TOKEN_STRING:      return _T("String");
-	default:                return _T("Unknown");
-	}
-}
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-// class TokenWriter
-
-void TokenWriter::Escape(tstring *Out, const tstring &In, uint EscapeFlags)
-{
-	Out->clear();
-	Out->reserve(In.length());
-
-	bool EscapeEOL   = ( (EscapeFlags & ESCAPE_EOL  ) != 0 );
-	bool EscapeOther = ( (EscapeFlags & ESCAPE_OTHER) != 0 );
-
-	tchar Ch;
-	for (size_t i = 0; i < In.length(); i++)
-	{
-		Ch = In[i]; 
-		if (Ch == _T('\r'))
-		{
-			if (EscapeEOL)
-				*Out += _T("\\r");
-			else
-				*Out += _T('\r');
-		}
-		else if (Ch == _T('\n'))
-		{
-			if (EscapeEOL)
-				*Out += _T("\\n");
-			else
-				*Out += _T('\n');
-		}
-		else if (Ch == _T('\\') || Ch == _T('\'') || Ch == _T('\"'))
-		{
-			*Out += '\\';
-			*Out += Ch;
-		}
-		else if (Ch == _T('\0')) *Out += _T("\\0");
-		else if (Ch == _T('\v')) *Out += _T("\\v");
-		else if (Ch == _T('\b')) *Out += _T("\\b");
-		else if (Ch == _T('\f')) *Out += _T("\\f");
-		else if (Ch == _T('\a')) *Out += _T("\\a");
-		else if (Ch == _T('\t')) *Out += Ch;
-		else if ( ((uint8)Ch < 32 || (uint8)Ch > 126) && EscapeOther )
-		{
-			*Out += _T("\\x");
-			tstring s;
-			UintToStr2(&s, (uint8)Ch, 2, 16);
-			*Out += s;
-		}
-		else
-			*Out += Ch;
-	}
-}
-
-TokenWriter::TokenWriter( tstring *outStr )
-: m_OutString(outStr)
-, m_OutStream(NULL)
-{
-	Ctor();
-}
-
-TokenWriter::TokenWriter( common::Stream *outStream )
-: m_OutString(NULL)
-, m_OutStream(outStream)
-{
-	Ctor();
-}
-
-void TokenWriter::Ctor()
-{
-	m_Level = 0;
-	m_WasEOL = m_SpaceRequired = false;
-	m_EOL = EOL;
-	m_Indent = _T('\t');
-	m_EscapeFlags = ESCAPE_EOL;
-}
-
-void TokenWriter::WriteSpace( tchar ch )
-{
-	WriteRaw(ch);
-	m_WasEOL = m_SpaceRequired = false;
-}
-
-void TokenWriter::WriteSpace( const tstring &s )
-{
-	WriteRaw(s);
-	m_WasEOL = m_SpaceRequired = false;
-}
-
-void TokenWriter::WriteEOL()
-{
-	WriteRaw(m_EOL);
-	m_WasEOL = true;
-	m_SpaceRequired = false;
-}
-
-void TokenWriter::WriteIdentifier( const tstring &s )
-{
-	if (m_WasEOL) WriteIndent(m_Level);
-	else if (m_SpaceRequired) WriteSpace();
-
-	WriteRaw(s);
-
-	m_SpaceRequired = true;
-	m_WasEOL = false;
-}
-
-void TokenWriter::WriteSymbol( tchar ch )
-{
-	int levelDelta = GetSymbolLevelDelta(ch);
-	if (levelDelta == -1) LevelDec();
-
-	if (m_WasEOL) WriteIndent(m_Level);
-	else if (m_SpaceRequired && IsSymbolSpaceBefore(ch)) WriteSpace();
-
-	WriteRaw(ch);
-
-	if (levelDelta == 1) LevelInc();
-
-	m_SpaceRequired = IsSymbolSpaceAfter(ch);
-	m_WasEOL = false;
-}
-
-void TokenWriter::WriteSymbol( const tstring &s )
-{
-	assert(!s.empty());
-	if (s.length() == 1)
-	{
-		WriteSymbol(s[0]);
-		return;
-	}
-	
-	// Here only multicharacter
-
-	int levelDelta = GetSymbolLevelDelta(s);
-	if (levelDelta == -1) LevelDec();
-
-	if (m_WasEOL) WriteIndent(m_Level);
-	else if (m_SpaceRequired && IsSymbolSpaceBefore(s)) WriteSpace();
-
-	WriteRaw(s);
-
-	if (levelDelta == 1) LevelInc();
-
-	m_SpaceRequired = IsSymbolSpaceAfter(s);
-	m_WasEOL = false;
-}
-
-void TokenWriter::WriteString( const tstring &s )
-{
-	if (m_WasEOL) WriteIndent(m_Level);
-	else if (m_SpaceRequired) WriteSpace();
-
-	// TODO: This method might be written better, without rewriting whole string to another string before WriteRaw.
-	tstring escapedStr;
-	Escape(&escapedStr, s, m_EscapeFlags);
-
-	static char delim = _T('"');
-
-	WriteRaw(delim);
-	WriteRaw(escapedStr);
-	WriteRaw(delim);
-
-	m_SpaceRequired = true;
-	m_WasEOL = false;
-}
-
-void TokenWriter::WriteIndent( uint level )
-{
-	for (unsigned i = 0; i < level; i++)
-		WriteRaw(m_Indent);
-}
-
-void TokenWriter::WriteRaw( tchar ch )
-{
-	if (m_OutString)
-		*m_OutString += ch;
-	else if (m_OutStream)
-		m_OutStream->WriteEx(ch);
-}
-
-void TokenWriter::WriteRaw( const tchar *s )
-{
-	if (m_OutString)
-		*m_OutString += s;
-	else if (m_OutStream)
-		m_OutStream->WriteStringF(s);
-}
-
-void TokenWriter::WriteRaw( const tstring &s )
-{
-	if (m_OutString)
-		*m_OutString += s;
-	else if (m_OutStream)
-		m_OutStream->WriteStringF(s);
-}
-
-void TokenWriter::WriteKeyword( const tstring &s)
-{
-	int levelDelta = GetKeywordLevelDelta(s);
-	if (levelDelta == -1)
-		LevelDec();
-
-	if (m_WasEOL) WriteIndent(m_Level);
-	else if (m_SpaceRequired) WriteSpace();
-
-	WriteRaw(s);
-
-	if (levelDelta == 1)
-		LevelInc();
-
-	m_SpaceRequired = true;
-	m_WasEOL = false;
-}
-
-void TokenWriter::RegisterSymbol( tchar ch, bool spaceBefore, bool spaceAfter, int levelDelta )
-{
-	if (spaceBefore)
-		m_Symbols_Chars_SpaceBefore += ch;
-	if (spaceAfter)
-		m_Symbols_Chars_SpaceAfter += ch;
-
-	assert(levelDelta >= -1 && levelDelta <= 1);
-	if (levelDelta == -1)
-		m_Symbols_Chars_LevelDec += ch;
-	else if (levelDelta == 1)
-		m_Symbols_Chars_LevelInc += ch;
-}
-
-void TokenWriter::RegisterSymbol( const tstring &s, bool spaceBefore, bool spaceAfter, int levelDelta )
-{
-	if (spaceBefore)
-		m_Symbols_Strings_SpaceBefore.push_back(s);
-	if (spaceAfter)
-		m_Symbols_Strings_SpaceAfter.push_back(s);
-
-	assert(levelDelta >= -1 && levelDelta <= 1);
-	if (levelDelta == -1)
-		m_Symbols_Strings_LevelDec.push_back(s);
-	else if (levelDelta == 1)
-		m_Symbols_Strings_LevelInc.push_back(s);
-}
-
-void TokenWriter::RegisterKeyword( const tstring &s, int levelDelta )
-{
-	assert(levelDelta >= -1 && levelDelta <= 1);
-	if (levelDelta == -1)
-		m_Keywords_LevelDec.push_back(s);
-	else if (levelDelta == 1)
-		m_Keywords_LevelInc.push_back(s);
-}
-
-int TokenWriter::GetKeywordLevelDelta( const tstring &s )
-{
-	STRING_VECTOR::iterator it = std::find(m_Keywords_LevelInc.begin(), m_Keywords_LevelInc.end(), s);
-	if (it != m_Keywords_LevelInc.end())
-		return 1;
-	it = std::find(m_Keywords_LevelDec.begin(), m_Keywords_LevelDec.end(), s);
-	if (it != m_Keywords_LevelDec.end())
-		return -1;
-	return 0;
-}
-
-int TokenWriter::GetSymbolLevelDelta( tchar ch )
-{
-	size_t pos = m_Symbols_Chars_LevelInc.find(ch);
-	if (pos != tstring::npos)
-		return 1;
-	pos = m_Symbols_Chars_LevelDec.find(ch);
-	if (pos != tstring::npos)
-		return -1;
-	return 0;
-}
-
-int TokenWriter::GetSymbolLevelDelta( const tstring &s )
-{
-	assert(!s.empty());
-	if (s.length() == 1)
-		return GetSymbolLevelDelta(s[0]);
-
-	STRING_VECTOR::iterator it = std::find(m_Symbols_Strings_LevelInc.begin(), m_Symbols_Strings_LevelInc.end(), s);
-	if (it != m_Symbols_Strings_LevelInc.end())
-		return 1;
-	it = std::find(m_Symbols_Strings_LevelDec.begin(), m_Symbols_Strings_LevelDec.end(), s);
-	if (it != m_Symbols_Strings_LevelDec.end())
-		return -1;
-	return 0;
-}
-
-bool TokenWriter::IsSymbolSpaceBefore( tchar ch )
-{
-	return m_Symbols_Chars_SpaceBefore.find(ch) != tstring::npos;
-}
-
-bool TokenWriter::IsSymbolSpaceBefore( const tstring &s )
-{
-	return std::find(m_Symbols_Strings_SpaceBefore.begin(), m_Symbols_Strings_SpaceBefore.end(), s) != m_Symbols_Strings_SpaceBefore.end();
-}
-
-bool TokenWriter::IsSymbolSpaceAfter( tchar ch )
-{
-	return m_Symbols_Chars_SpaceAfter.find(ch) != tstring::npos;
-}
-
-void TokenWriter::WriteUint1( uint8 v, bool hex )
-{
-	tstring s;
-	UintToStr(&s, v, hex ? 16 : 10);
-	WriteNumberString(hex ? _T("0x") + s : s);
-}
-
-void TokenWriter::WriteUint2( uint16 v, bool hex )
-{
-	tstring s;
-	UintToStr(&s, v, hex ? 16 : 10);
-	WriteNumberString(hex ? _T("0x") + s : s);
-}
-
-void TokenWriter::WriteUint4( uint32 v, bool hex )
-{
-	tstring s;
-	UintToStr(&s, v, hex ? 16 : 10);
-	WriteNumberString(hex ? _T("0x") + s : s);
-}
-
-void TokenWriter::WriteUint8( uint64 v, bool hex )
-{
-	tstring s;
-	UintToStr(&s, v, hex ? 16 : 10);
-	WriteNumberString(hex ? _T("0x") + s : s);
-}
-
-void TokenWriter::WriteInt1( int8 v ) { tstring s; IntToStr(&s, v); WriteNumberString(s); }
-void TokenWriter::WriteInt2( int16 v ) { tstring s; IntToStr(&s, v); WriteNumberString(s); }
-void TokenWriter::WriteInt4( int32 v ) { tstring s; IntToStr(&s, v); WriteNumberString(s); }
-void TokenWriter::WriteInt8( int64 v ) { tstring s; IntToStr(&s, v); WriteNumberString(s); }
-
-void TokenWriter::WriteFloat(  float v, char Mode, int Precision  ) { tstring s; FloatToStr (&s, v, Mode, Precision); WriteNumberString(s); }
-void TokenWriter::WriteDouble( double v, char Mode, int Precision ) { tstring s; DoubleToStr(&s, v, Mode, Precision); WriteNumberString(s); }
-
-void TokenWriter::WriteNumberString( const tstring &v )
-{
-	if (m_WasEOL) WriteIndent(m_Level);
-	else if (m_SpaceRequired) WriteSpace();
-
-	WriteRaw(v);
-
-	m_SpaceRequired = true;
-	m_WasEOL = false;
-}
-
-void TokenWriter::WriteComment( const tstring &s, bool alwaysMultiline /*= false*/ )
-{
-	if (alwaysMultiline || ContainsEOL(s))
-		WriteMultiLineComment(s);
-	else
-		WriteSingleLineComment(s);
-}
-
-void TokenWriter::WriteMultiLineComment( const tstring &s )
-{
-	assert(s.find(_T("*/")) == tstring::npos);
-
-	if (m_WasEOL) WriteIndent(m_Level);
-	else if (m_SpaceRequired) WriteSpace();
-
-	WriteRaw(_T("/*"));
-	WriteRaw(s);
-	WriteRaw(_T("*/"));
-
-	m_SpaceRequired = true;
-	m_WasEOL = false;
-}
-
-void TokenWriter::WriteSingleLineComment( const tstring &s )
-{
-	if (m_WasEOL) WriteIndent(m_Level);
-	else if (m_SpaceRequired) WriteSpace();
-
-	WriteRaw(_T("//"));
-	WriteRaw(s);
-	WriteRaw(m_EOL);
-
-	m_SpaceRequired = false;
-	m_WasEOL = true;
-}
-
-bool TokenWriter::IsSymbolSpaceAfter( const tstring &s )
-{
-	return std::find(m_Symbols_Strings_SpaceAfter.begin(), m_Symbols_Strings_SpaceAfter.end(), s) != m_Symbols_Strings_SpaceAfter.end();
-}
-
-
-} // namespace common
+/** \file
+\brief Parser of language syntax similar to C/C++
+\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
+
+Part of CommonLib library. \n
+Encoding UTF-8, end of line CR+LF \n
+License: GNU LGPL. \n
+Documentation: \ref Module_Tokenizer \n
+Module components: \ref code_tokenizer
+*/
+#include "Base.hpp"
+#include <map>
+#include "Stream.hpp"
+#include "Tokenizer.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h> // for scanning the document
+	#define COMMON_TOKENIZER_SSE2
+#endif
+#ifdef _MSC_VER
+	#include <intrin.h> // for _BitScanForward
+#endif
+
+
+namespace common
+{
+
+TokenizerError::TokenizerError(size_t Char, size_t Row, size_t Col, const tstring &Msg, const tstring &File, int a_Line) :
+	m_Char(Char),
+	m_Row(Row),
+	m_Col(Col)
+{
+	if (Msg.empty())
+		Push(Format(_T("Tokenizer(row=#, col=#, char=#)")) % m_Row % m_Col % m_Char, __TFILE__, __LINE__);
+	else
+		Push(Format(_T("Tokenizer(row=#, col=#, char=#) #")) % m_Row % m_Col % m_Char % Msg, __TFILE__, __LINE__);
+}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Klasa Tokenizer_pimpl
+
+typedef std::map<tstring, uint> KEYWORDS_MAP;
+
+// Miejsce w tablicy mieszającej słów kluczowych. Str == NULL - puste.
+struct KEYWORD_SLOT
+{
+	const tchar *Str;
+	size_t Length;
+	uint Hash;
+	uint Id;
+};
+
+class Tokenizer_pimpl
+{
+public:
+	// Które znaki są symbolami
+	bool m_Symbols[256];
+
+	// Flagi
+	bool m_FlagTokenEOL;
+	bool m_FlagMultilineStrings;
+
+	// Dokument w postaci ciągłego bufora (konstruktory tchar* i tstring*) - czytany
+	// bezpośrednio wskaźnikiem, bez strumienia. Jeśli m_BufBegin == NULL, czytany jest strumień.
+	const tchar *m_BufBegin, *m_BufEnd;
+	// Następny nieprzeczytany znak
+	const tchar *m_BufPtr;
+	// Miejsce w buforze znaku m_L1Char
+	const tchar *m_L1Pos;
+
+	// Strumień do pobierania, kiedy dokument nie jest w buforze
+	// - Z konstruktora Stream* - strumień dowolny, zewnętrzny
+	Stream *m_ExternalStream;
+	// CharReader do powyższego strumienia
+	scoped_ptr<TCharReader> m_CharReader;
+
+	// WARSTWA I - wczytywanie znaków
+	// (w trybie bufora liczniki nie są używane - pozycję liczy UpdateLastPos)
+	size_t m_CurrChar, m_CurrRow, m_CurrCol;
+	bool m_L1End; // albo to jest true...
+	tchar m_L1Char; // ...albo tu jest ostatnio wczytany znak
+	void L1Next();
+	void L1NextStream();
+
+	// Zarejestrowane dane
+	KEYWORDS_MAP m_Keywords;
+
+	// Doskonała funkcja mieszająca słów kluczowych (hash and displace), tworzona przez
+	// FinalizeKeywords z m_Keywords. Hash = MurmurHash treści z ziarnem m_KeywordHashSeed.
+	// Kubełek = Hash & (m_KeywordSeeds.size()-1), miejsce = WangMix(Hash + Ziarno kubełka * Złota liczba) & (m_KeywordSlots.size()-1).
+	// Każde słowo ma inne miejsce, więc szukanie to jedno porównanie.
+	bool m_KeywordsFinal;
+	uint m_KeywordHashSeed;
+	std::vector<uint> m_KeywordSeeds;
+	std::vector<KEYWORD_SLOT> m_KeywordSlots;
+	size_t m_KeywordMinLength, m_KeywordMaxLength;
+	void FinalizeKeywords();
+	bool BuildKeywordTable(size_t SlotCount);
+
+	// Informacje na temat ostatnio odczytanego tokena
+	size_t m_LastChar, m_LastRow, m_LastCol;
+	Tokenizer::TOKEN m_LastToken;
+	// Treść tokena - wskazuje do bufora dokumentu albo do m_LastString
+	const tchar *m_ViewPtr;
+	size_t m_ViewLen;
+	tstring m_LastString; // aktualny tylko jeśli m_LastStringReady
+	bool m_LastStringReady;
+	uint m_LastId; // wypełniany przy TOKEN_KEYWORD
+
+	// Leniwie liczona pozycja początku tokena w trybie bufora
+	const tchar *m_LastPtr;
+	bool m_LastPosValid;
+	const tchar *m_PosPtr, *m_PosLineStart;
+	size_t m_PosRow, m_PosColAdjust;
+
+	Tokenizer_pimpl(uint Flags);
+	~Tokenizer_pimpl() { }
+
+	void InitSymbols();
+	void InitBuffer(const tchar *Input, size_t NumChars);
+
+	void CountPosChar(const tchar *p);
+	void UpdateLastPos();
+	size_t LastChar() { UpdateLastPos(); return m_LastChar; }
+	size_t LastRow() { UpdateLastPos(); return m_LastRow; }
+	size_t LastCol() { UpdateLastPos(); return m_LastCol; }
+
+	void SetView(const tchar *Ptr, size_t Len) { m_ViewPtr = Ptr; m_ViewLen = Len; m_LastStringReady = false; }
+	void SetViewToString() { m_ViewPtr = m_LastString.data(); m_ViewLen = m_LastString.length(); m_LastStringReady = true; }
+	const tstring & GetLastString();
+	bool ViewEquals(const tstring &s) { return m_ViewLen == s.length() && std::char_traits<tchar>::compare(m_ViewPtr, s.data(), m_ViewLen) == 0; }
+
+	tchar ParseStringChar();
+	void Parse();
+	void FindKeyword();
+
+	template <typename T> bool GetUint(T *Out);
+	template <typename T> bool GetInt(T *Out);
+	template <typename T> T MustGetUint();
+	template <typename T> T MustGetInt();
+};
+
+inline bool IsIdentifierChar(tchar Ch)
+{
+	return (Ch <= _T('Z') && Ch >= _T('A')) || (Ch <= _T('z') && Ch >= _T('a')) || (Ch <= _T('9') && Ch >= _T('0')) || Ch == _T('_');
+}
+
+inline bool IsNumberChar(tchar Ch)
+{
+	return (Ch <= _T('9') && Ch >= _T('0')) ||
+		(Ch <= _T('Z') && Ch >= _T('A')) ||
+		(Ch <= _T('z') && Ch >= _T('a')) ||
+		Ch == _T('+') || Ch == _T('-') || Ch == _T('.');
+}
+
+inline bool IsFloatChar(tchar Ch)
+{
+	return Ch == _T('.') || Ch == _T('d') || Ch == _T('D') || Ch == _T('e') || Ch == _T('E');
+}
+
+inline bool IsWhitespaceChar(tchar Ch, bool SkipEOL)
+{
+	return Ch == _T(' ') || Ch == _T('\t') || Ch == _T('\r') || Ch == _T('\v') || (Ch == _T('\n') && SkipEOL);
+}
+
+// Skanowanie bufora dokumentu. Każda funkcja zwraca wskaźnik na pierwszy znak od p,
+// który nie należy do przeskakiwanego ciągu, albo End. Z SSE2 sprawdzają po 16 znaków
+// (8 dla tchar = wchar_t), resztę pojedynczo.
+
+#ifdef COMMON_TOKENIZER_SSE2
+
+#ifdef _UNICODE
+	const size_t SIMD_CHARS = 8;
+	inline __m128i SimdSplat(tchar Ch) { return _mm_set1_epi16((short)Ch); }
+	inline __m128i SimdEq(__m128i a, __m128i b) { return _mm_cmpeq_epi16(a, b); }
+	inline __m128i SimdGt(__m128i a, __m128i b) { return _mm_cmpgt_epi16(a, b); }
+	inline __m128i SimdLt(__m128i a, __m128i b) { return _mm_cmplt_epi16(a, b); }
+	// Bit na każdy znak
+	inline uint SimdMask(__m128i v) { return (uint)_mm_movemask_epi8(_mm_packs_epi16(v, _mm_setzero_si128())) & 0xFF; }
+#else
+	const size_t SIMD_CHARS = 16;
+	inline __m128i SimdSplat(tchar Ch) { return _mm_set1_epi8(Ch); }
+	inline __m128i SimdEq(__m128i a, __m128i b) { return _mm_cmpeq_epi8(a, b); }
+	inline __m128i SimdGt(__m128i a, __m128i b) { return _mm_cmpgt_epi8(a, b); }
+	inline __m128i SimdLt(__m128i a, __m128i b) { return _mm_cmplt_epi8(a, b); }
+	inline uint SimdMask(__m128i v) { return (uint)_mm_movemask_epi8(v); }
+#endif
+	const uint SIMD_FULL_MASK = (1u << SIMD_CHARS) - 1;
+
+	inline __m128i SimdLoad(const tchar *p) { return _mm_loadu_si128((const __m128i*)p); }
+	inline __m128i SimdEq(__m128i v, tchar Ch) { return SimdEq(v, SimdSplat(Ch)); }
+	// Porównanie ze znakiem - znaki spoza ASCII są ujemne, więc nigdy nie mieszczą się w zakresie
+	inline __m128i SimdInRange(__m128i v, tchar Lo, tchar Hi) { return _mm_and_si128(SimdGt(v, SimdSplat(Lo - 1)), SimdLt(v, SimdSplat(Hi + 1))); }
+
+	inline uint LowestBitIndex(uint v)
+	{
+	#ifdef _MSC_VER
+		unsigned long Index; _BitScanForward(&Index, v); return (uint)Index;
+	#else
+		return (uint)__builtin_ctz(v);
+	#endif
+	}
+	inline uint HighestBitIndex(uint v)
+	{
+	#ifdef _MSC_VER
+		unsigned long Index; _BitScanReverse(&Index, v); return (uint)Index;
+	#else
+		return 31 - (uint)__builtin_clz(v);
+	#endif
+	}
+
+#endif
+
+const tchar * SkipWhitespace(const tchar *p, const tchar *End, bool SkipEOL)
+{
+#ifdef COMMON_TOKENIZER_SSE2
+	const __m128i EOLMask = SkipEOL ? SimdSplat(_T('\n')) : SimdSplat(_T(' '));
+	while ((size_t)(End - p) >= SIMD_CHARS)
+	{
+		__m128i v = SimdLoad(p);
+		__m128i Ws = _mm_or_si128(_mm_or_si128(SimdEq(v, _T(' ')), SimdEq(v, _T('\t'))),
+			_mm_or_si128(_mm_or_si128(SimdEq(v, _T('\r')), SimdEq(v, _T('\v'))), SimdEq(v, EOLMask)));
+		uint Mask = ~SimdMask(Ws) & SIMD_FULL_MASK;
+		if (Mask != 0)
+			return p + LowestBitIndex(Mask);
+		p += SIMD_CHARS;
+	}
+#endif
+	while (p != End && IsWhitespaceChar(*p, SkipEOL))
+		p++;
+	return p;
+}
+
+const tchar * SkipIdentifier(const tchar *p, const tchar *End)
+{
+#ifdef COMMON_TOKENIZER_SSE2
+	while ((size_t)(End - p) >= SIMD_CHARS)
+	{
+		__m128i v = SimdLoad(p);
+		// Litera małą lub wielka - bit 0x20 ustawiony daje małą
+		__m128i Ident = _mm_or_si128(SimdInRange(_mm_or_si128(v, SimdSplat(0x20)), _T('a'), _T('z')),
+			_mm_or_si128(SimdInRange(v, _T('0'), _T('9')), SimdEq(v, _T('_'))));
+		uint Mask = ~SimdMask(Ident) & SIMD_FULL_MASK;
+		if (Mask != 0)
+			return p + LowestBitIndex(Mask);
+		p += SIMD_CHARS;
+	}
+#endif
+	while (p != End && IsIdentifierChar(*p))
+		p++;
+	return p;
+}
+
+// Do pierwszego wystąpienia Ch1 lub Ch2
+const tchar * FindChar2(const tchar *p, const tchar *End, tchar Ch1, tchar Ch2)
+{
+#ifdef COMMON_TOKENIZER_SSE2
+	const __m128i v1 = SimdSplat(Ch1), v2 = SimdSplat(Ch2);
+	while ((size_t)(End - p) >= SIMD_CHARS)
+	{
+		__m128i v = SimdLoad(p);
+		uint Mask = SimdMask(_mm_or_si128(SimdEq(v, v1), SimdEq(v, v2)));
+		if (Mask != 0)
+			return p + LowestBitIndex(Mask);
+		p += SIMD_CHARS;
+	}
+#endif
+	while (p != End && *p != Ch1 && *p != Ch2)
+		p++;
+	return p;
+}
+
+// Do znaku, którego nie może zawierać łańcuch przetwarzany bez kopiowania: '"', '\\', '\r', '\n'
+const tchar * FindStringEnd(const tchar *p, const tchar *End)
+{
+#ifdef COMMON_TOKENIZER_SSE2
+	while ((size_t)(End - p) >= SIMD_CHARS)
+	{
+		__m128i v = SimdLoad(p);
+		__m128i Stop = _mm_or_si128(_mm_or_si128(SimdEq(v, _T('"')), SimdEq(v, _T('\\'))),
+			_mm_or_si128(SimdEq(v, _T('\r')), SimdEq(v, _T('\n'))));
+		uint Mask = SimdMask(Stop);
+		if (Mask != 0)
+			return p + LowestBitIndex(Mask);
+		p += SIMD_CHARS;
+	}
+#endif
+	while (p != End && *p != _T('"') && *p != _T('\\') && *p != _T('\r') && *p != _T('\n'))
+		p++;
+	return p;
+}
+
+Tokenizer_pimpl::Tokenizer_pimpl(uint Flags) :
+	m_FlagTokenEOL((Flags & Tokenizer::FLAG_TOKEN_EOL) != 0),
+	m_FlagMultilineStrings((Flags & Tokenizer::FLAG_MULTILINE_STRINGS) != 0),
+	m_BufBegin(NULL), m_BufEnd(NULL), m_BufPtr(NULL), m_L1Pos(NULL),
+	m_ExternalStream(NULL),
+	m_CurrChar(0), m_CurrRow(1), m_CurrCol(0),
+	m_L1End(true), m_L1Char(_T('\0')),
+	m_KeywordsFinal(true), m_KeywordHashSeed(0),
+	m_KeywordMinLength(0), m_KeywordMaxLength(0),
+	m_LastChar(0), m_LastRow(1), m_LastCol(0),
+	m_LastToken(Tokenizer::TOKEN_EOF),
+	m_ViewPtr(NULL), m_ViewLen(0),
+	m_LastStringReady(true),
+	m_LastId(0),
+	m_LastPtr(NULL), m_LastPosValid(true),
+	m_PosPtr(NULL), m_PosLineStart(NULL),
+	m_PosRow(1), m_PosColAdjust(0)
+{
+	InitSymbols();
+	SetViewToString();
+}
+
+void Tokenizer_pimpl::InitBuffer(const tchar *Input, size_t NumChars)
+{
+	m_BufBegin = m_BufPtr = m_L1Pos = Input;
+	m_BufEnd = Input + NumChars;
+	m_LastPtr = m_PosPtr = m_PosLineStart = Input;
+	L1Next();
+}
+
+void Tokenizer_pimpl::L1Next()
+{
+	if (m_BufBegin == NULL)
+	{
+		L1NextStream();
+		return;
+	}
+
+	m_L1End = (m_BufPtr == m_BufEnd);
+	if (!m_L1End)
+	{
+		m_L1Pos = m_BufPtr;
+		m_L1Char = *m_BufPtr++;
+
+		// Sekwencja "\\\n" lub "\\\r\n" jest pomijana - tak samo jak w L1NextStream
+		if (m_L1Char == _T('\\'))
+		{
+			if (m_BufPtr != m_BufEnd && *m_BufPtr == _T('\r'))
+				m_BufPtr++;
+			if (m_BufPtr != m_BufEnd && *m_BufPtr == _T('\n'))
+			{
+				m_BufPtr++;
+				L1Next();
+			}
+		}
+	}
+}
+
+void Tokenizer_pimpl::L1NextStream()
+{
+	m_L1End = !m_CharReader->ReadChar(&m_L1Char);
+
+	if (!m_L1End)
+	{
+		// Liczniki
+		m_CurrChar++;
+		if (m_L1Char == _T('\n'))
+		{
+			m_CurrRow++;
+			m_CurrCol = 0;
+		}
+		else
+			m_CurrCol++;
+
+		// Sekwencja "\\\n" lub "\\\r\n" jest pomijana - łamanie linii za pomocą znaku \ ...
+		if (m_L1Char == _T('\\'))
+		{
+			tchar Ch;
+			if (m_CharReader->PeekChar(&Ch) && Ch == _T('\r'))
+			{
+				m_CharReader->SkipChar();
+				m_CurrChar++;
+			}
+			if (m_CharReader->PeekChar(&Ch) && Ch == _T('\n'))
+			{
+				m_CharReader->SkipChar();
+				m_CurrChar++;
+				m_CurrRow++;
+				m_CurrCol = 0;
+				L1NextStream();
+			}
+		}
+	}
+}
+
+void Tokenizer_pimpl::CountPosChar(const tchar *p)
+{
+	if (*p == _T('\n'))
+	{
+		m_PosRow++;
+		m_PosLineStart = p + 1;
+		m_PosColAdjust = 0;
+	}
+	else if (*p == _T('\r') && p > m_BufBegin && p[-1] == _T('\\') && (p + 1 == m_BufEnd || p[1] != _T('\n')))
+		m_PosColAdjust++;
+}
+
+void Tokenizer_pimpl::UpdateLastPos()
+{
+	if (m_LastPosValid)
+		return;
+
+	// Liczy wiersze i kolumny tak samo jak L1NextStream. Każdy znak '\\' jest czytany
+	// przez warstwę I, więc '\r' po nim, po którym nie ma '\n', był pominięty bez
+	// zwiększania kolumny.
+	const tchar *p = m_PosPtr;
+#ifdef COMMON_TOKENIZER_SSE2
+	// Końce wierszy liczone blokami. Blok z "\\\r" sprawdzany jest pojedynczo.
+	while ((size_t)(m_LastPtr - p) >= SIMD_CHARS)
+	{
+		__m128i v = SimdLoad(p);
+		uint CRMask = SimdMask(SimdEq(v, _T('\r')));
+		if (CRMask != 0)
+		{
+			uint PrevBackslashMask = (SimdMask(SimdEq(v, _T('\\'))) << 1) | (p > m_BufBegin && p[-1] == _T('\\') ? 1 : 0);
+			if ((CRMask & PrevBackslashMask) != 0)
+			{
+				for (const tchar *BlockEnd = p + SIMD_CHARS; p < BlockEnd; p++)
+					CountPosChar(p);
+				continue;
+			}
+		}
+		uint EOLMask = SimdMask(SimdEq(v, _T('\n')));
+		if (EOLMask != 0)
+		{
+			m_PosRow += CountBitsSet((uint32)EOLMask);
+			m_PosLineStart = p + HighestBitIndex(EOLMask) + 1;
+			m_PosColAdjust = 0;
+		}
+		p += SIMD_CHARS;
+	}
+#endif
+	for (; p < m_LastPtr; p++)
+		CountPosChar(p);
+	m_PosPtr = p;
+
+	m_LastChar = (size_t)(m_LastPtr - m_BufBegin);
+	m_LastRow = m_PosRow;
+	m_LastCol = (size_t)(m_LastPtr - m_PosLineStart) - m_PosColAdjust;
+	m_LastPosValid = true;
+}
+
+const tstring & Tokenizer_pimpl::GetLastString()
+{
+	if (!m_LastStringReady)
+	{
+		m_LastString.assign(m_ViewPtr, m_ViewLen);
+		SetViewToString();
+	}
+	return m_LastString;
+}
+
+void Tokenizer_pimpl::InitSymbols()
+{
+	std::fill(&m_Symbols[0], &m_Symbols[256], false);
+
+	const tchar * DEFAULT_SYMBOLS = _T("`~!@#$%^&*()=[]{};:,.<>?\\|");
+
+#ifdef _WIN32
+	size_t SymbolCount = _tcslen(DEFAULT_SYMBOLS);
+#else
+	size_t SymbolCount = strlen(DEFAULT_SYMBOLS);
+#endif
+	for (size_t i = 0; i < SymbolCount; i++)
+		m_Symbols[(uint8)DEFAULT_SYMBOLS[i]] = true;
+}
+
+tchar Tokenizer_pimpl::ParseStringChar()
+{
+	// Musi być tu już sprawdzone, że nie jest koniec oraz że m_L1Char nie jest znakiem kończącym łańcuch/znak
+	assert(!m_L1End);
+
+	// Escape sequence
+	if (m_L1Char == _T('\\'))
+	{
+		L1Next();
+		if (m_L1End)
+			throw TokenizerError(LastChar(), LastRow(), LastCol(), _T("Unexpected and of data inside escape sequence."), __TFILE__, __LINE__);
+		// Stała szesnastkowa
+		if (m_L1Char == 'x')
+		{
+			uint8 Number1, Number2;
+			L1Next();
+
+			// Następne dwa znaki
+
+			if (m_L1End)
+				throw TokenizerError(LastChar(), LastRow(), LastCol(), _T("Unexpected and of data inside escape sequence."), __TFILE__, __LINE__);
+			Number1 = HexDigitToNumber(m_L1Char);
+			L1Next();
+
+			if (m_L1End)
+				throw TokenizerError(LastChar(), LastRow(), LastCol(), _T("Unexpected and of data inside escape sequence."), __TFILE__, __LINE__);
+			Number2 = HexDigitToNumber(m_L1Char);
+			L1Next();
+
+			if (Number1 == 0xFF || Number2 == 0xFF)
+				throw TokenizerError(LastChar(), LastRow(), LastCol(), _T("Invalid hexadecimal escape sequence."), __TFILE__, __LINE__);
+
+			return (tchar)(Number1 << 4 | Number2);
+		}
+		// Zwykła stała
+		else
+		{
+			tchar R;
+			switch (m_L1Char)
+			{
+			case _T('n'): R = _T('\n'); break;
+			case _T('t'): R = _T('\t'); break;
+			case _T('v'): R = _T('\v'); break;
+			case _T('b'): R = _T('\b'); break;
+			case _T('r'): R = _T('\r'); break;
+			case _T('f'): R = _T('\f'); break;
+			case _T('a'): R = _T('\a'); break;
+			case _T('0'): R = _T('\0'); break;
+			case _T('\\'):
+			case _T('?'):
+			case _T('"'):
+			case _T('\''):
+				R = m_L1Char;
+				// Zostaje to co jest
+				break;
+			default:
+				throw TokenizerError(LastChar(), LastRow(), LastCol(), _T("Unknown escape sequence: \\") + CharToStrR(m_L1Char), __TFILE__, __LINE__);
+			}
+			L1Next();
+			return R;
+		}
+	}
+	else
+	{
+		tchar R = m_L1Char;
+		L1Next();
+		return R;
+	}
+}
+
+const uint KEYWORD_SEED_MUL = 0x9E3779B9u;
+
+bool Tokenizer_pimpl::BuildKeywordTable(size_t SlotCount)
+{
+	size_t BucketCount = 1;
+	while (BucketCount * 2 <= m_Keywords.size())
+		BucketCount *= 2;
+	size_t BucketMask = BucketCount - 1, SlotMask = SlotCount - 1;
+
+	// Podział na kubełki
+	std::vector< std::vector<KEYWORD_SLOT> > Buckets(BucketCount);
+	for (KEYWORDS_MAP::iterator it = m_Keywords.begin(); it != m_Keywords.end(); ++it)
+	{
+		KEYWORD_SLOT Slot;
+		Slot.Str = it->first.data();
+		Slot.Length = it->first.length();
+		Slot.Hash = MurmurHash(Slot.Str, (uint)(Slot.Length * sizeof(tchar)), m_KeywordHashSeed);
+		Slot.Id = it->second;
+		Buckets[Slot.Hash & BucketMask].push_back(Slot);
+	}
+
+	// Kubełki od największych
+	std::vector< std::pair<size_t, size_t> > Sizes(BucketCount);
+	for (size_t i = 0; i < BucketCount; i++)
+		Sizes[i] = std::make_pair(Buckets[i].size(), i);
+	std::sort(Sizes.begin(), Sizes.end());
+	std::vector<size_t> Order(BucketCount);
+	for (size_t i = 0; i < BucketCount; i++)
+		Order[i] = Sizes[BucketCount - 1 - i].second;
+
+	m_KeywordSeeds.assign(BucketCount, 0);
+	m_KeywordSlots.assign(SlotCount, KEYWORD_SLOT());
+	for (size_t i = 0; i < SlotCount; i++)
+		m_KeywordSlots[i].Str = NULL;
+
+	const uint MAX_SEED = 0x10000;
+	std::vector<size_t> Positions;
+	for (size_t bi = 0; bi < BucketCount && !Buckets[Order[bi]].empty(); bi++)
+	{
+		std::vector<KEYWORD_SLOT> &Bucket = Buckets[Order[bi]];
+		uint Seed;
+		for (Seed = 0; Seed < MAX_SEED; Seed++)
+		{
+			Positions.clear();
+			size_t i;
+			for (i = 0; i < Bucket.size(); i++)
+			{
+				size_t Pos = WangMix(Bucket[i].Hash + Seed * KEYWORD_SEED_MUL) & SlotMask;
+				if (m_KeywordSlots[Pos].Str != NULL || std::find(Positions.begin(), Positions.end(), Pos) != Positions.end())
+					break;
+				Positions.push_back(Pos);
+			}
+			if (i == Bucket.size())
+				break;
+		}
+		if (Seed == MAX_SEED)
+			return false;
+
+		m_KeywordSeeds[Order[bi]] = Seed;
+		for (size_t i = 0; i < Bucket.size(); i++)
+			m_KeywordSlots[Positions[i]] = Bucket[i];
+	}
+	return true;
+}
+
+void Tokenizer_pimpl::FinalizeKeywords()
+{
+	m_KeywordSeeds.clear();
+	m_KeywordSlots.clear();
+	m_KeywordMinLength = m_KeywordMaxLength = 0;
+
+	if (!m_Keywords.empty())
+	{
+		m_KeywordMinLength = m_Keywords.begin()->first.length();
+		for (KEYWORDS_MAP::iterator it = m_Keywords.begin(); it != m_Keywords.end(); ++it)
+		{
+			m_KeywordMinLength = std::min(m_KeywordMinLength, it->first.length());
+			m_KeywordMaxLength = std::max(m_KeywordMaxLength, it->first.length());
+		}
+
+		// Zapełnienie tablicy najwyżej w połowie. Jeśli się nie uda (np. dwa słowa mają
+		// ten sam hash), większa tablica i inne ziarno.
+		size_t SlotCount = 2;
+		while (SlotCount < m_Keywords.size() * 2)
+			SlotCount *= 2;
+		for (m_KeywordHashSeed = 0; !BuildKeywordTable(SlotCount); m_KeywordHashSeed++)
+		{
+			if (SlotCount < m_Keywords.size() * 16)
+				SlotCount *= 2;
+		}
+	}
+
+	m_KeywordsFinal = true;
+}
+
+void Tokenizer_pimpl::FindKeyword()
+{
+	m_LastToken = Tokenizer::TOKEN_IDENTIFIER;
+	if (m_ViewLen < m_KeywordMinLength || m_ViewLen > m_KeywordMaxLength)
+		return;
+
+	uint Hash = MurmurHash(m_ViewPtr, (uint)(m_ViewLen * sizeof(tchar)), m_KeywordHashSeed);
+	uint Seed = m_KeywordSeeds[Hash & (m_KeywordSeeds.size() - 1)];
+	const KEYWORD_SLOT &Slot = m_KeywordSlots[WangMix(Hash + Seed * KEYWORD_SEED_MUL) & (m_KeywordSlots.size() - 1)];
+	if (Slot.Hash == Hash && Slot.Length == m_ViewLen && Slot.Str != NULL &&
+		std::char_traits<tchar>::compare(Slot.Str, m_ViewPtr, m_ViewLen) == 0)
+	{
+		m_LastToken = Tokenizer::TOKEN_KEYWORD;
+		m_LastId = Slot.Id;
+	}
+}
+
+void Tokenizer_pimpl::Parse()
+{
+	// W trybie bufora długie ciągi znaków (białe znaki, identyfikatory, liczby, łańcuchy
+	// bez sekwencji ucieczki, komentarze) są przeskakiwane wskaźnikiem, a treść tokena jest
+	// wskazywana w buforze bez kopiowania. Znak '\\' zawsze przerywa takie przeskakiwanie,
+	// bo może zaczynać łamanie linii - wtedy dalej działa zwykła ścieżka znak po znaku.
+	bool Buf = (m_BufBegin != NULL);
+
+	for (;;)
+	{
+		if (Buf)
+		{
+			m_LastPtr = m_BufPtr;
+			m_LastPosValid = false;
+		}
+		else
+		{
+			m_LastChar = m_CurrChar;
+			m_LastRow = m_CurrRow;
+			m_LastCol = m_CurrCol;
+		}
+
+		// EOF
+		if (m_L1End)
+		{
+			if (Buf)
+				SetView(m_BufEnd, 0);
+			else
+				m_LastString.clear();
+			m_LastToken = Tokenizer::TOKEN_EOF;
+			return;
+		}
+
+		// Symbol
+		if (m_Symbols[(uint8)m_L1Char])
+		{
+			if (Buf)
+				SetView(m_L1Pos, 1);
+			else
+				CharToStr(&m_LastString, m_L1Char);
+			m_LastToken = Tokenizer::TOKEN_SYMBOL;
+			L1Next();
+			return;
+		}
+		// Biały znak
+		else if (m_L1Char == _T(' ') || m_L1Char == _T('\t') || m_L1Char == _T('\r') || m_L1Char == _T('\v'))
+		{
+			if (Buf)
+			{
+				m_BufPtr = SkipWhitespace(m_BufPtr, m_BufEnd, !m_FlagTokenEOL);
+			}
+			L1Next();
+			continue;
+		}
+		// Nagłówek Unicode
+#ifdef _UNICODE
+		else if (m_L1Char == L'\xFFFE')
+		{
+			L1Next();
+			continue;
+		}
+#endif
+		// Koniec wiersza
+		else if (m_L1Char == _T('\n'))
+		{
+			// Jako token
+			if (m_FlagTokenEOL)
+			{
+				if (Buf)
+					SetView(m_L1Pos, 1);
+				else
+					m_LastString = _T("\n");
+				m_LastToken = Tokenizer::TOKEN_EOL;
+				L1Next();
+				return;
+			}
+			// Jako biały znak
+			else
+			{
+				L1Next();
+				continue;
+			}
+		}
+		// Stała znakowa
+		else if (m_L1Char == _T('\''))
+		{
+			// Następny znak
+			L1Next();
+			if (m_L1End)
+				throw TokenizerError(LastChar(), LastRow(), LastCol(), _T("Unexpected end of data inside character constant."), __TFILE__, __LINE__);
+			// Znak (sekwencja ucieczki lub zwykły)
+			CharToStr(&m_LastString, ParseStringChar());
+			// Następny znak - to musi być zakończenie '
+			if (m_L1End)
+				throw TokenizerError(LastChar(), LastRow(), LastCol(), _T("Unexpected end of data inside character constant."), __TFILE__, __LINE__);
+			if (m_L1Char != _T('\''))
+				throw TokenizerError(LastChar(), LastRow(), LastCol(), _T("End of character constant expected: '"), __TFILE__, __LINE__);
+			SetViewToString();
+			m_LastToken = Tokenizer::TOKEN_CHAR;
+			L1Next();
+			return;
+		}
+		// Stała łańcuchowa
+		else if (m_L1Char == _T('"'))
+		{
+			m_LastToken = Tokenizer::TOKEN_STRING;
+			if (Buf)
+			{
+				const tchar *Beg = m_BufPtr, *p = FindStringEnd(m_BufPtr, m_BufEnd);
+				// Cały łańcuch bez sekwencji ucieczki i końców wiersza
+				if (p != m_BufEnd && *p == _T('"'))
+				{
+					SetView(Beg, p - Beg);
+					m_BufPtr = p + 1;
+					L1Next();
+					return;
+				}
+				m_LastString.assign(Beg, p - Beg);
+				m_BufPtr = p;
+			}
+			else
+				m_LastString.clear();
+			L1Next();
+			for (;;)
+			{
+				// Następny znak
+				if (m_L1End)
+					throw TokenizerError(LastChar(), LastRow(), LastCol(), _T("Unexpected end of data inside string constant."), __TFILE__, __LINE__);
+				// Koniec łańcucha
+				if (m_L1Char == _T('"'))
+				{
+					L1Next();
+					break;
+				}
+				// Koniec wiersza, podczas gdy nie może go być
+				else if ( (m_L1Char == _T('\r') || m_L1Char == _T('\n')) && !m_FlagMultilineStrings )
+					throw TokenizerError(LastChar(), LastRow(), LastCol(), _T("Unexpected end of data inside string constant."), __TFILE__, __LINE__);
+				// Znak (sekwencja ucieczki lub zwykły)
+				else
+					m_LastString += ParseStringChar();
+			}
+			SetViewToString();
+			return;
+		}
+		// Identyfikator lub słowo kluczowe
+		else if ( (m_L1Char <= _T('Z') && m_L1Char >= _T('A')) || (m_L1Char <= _T('z') && m_L1Char >= _T('a')) || m_L1Char == _T('_') )
+		{
+			if (Buf)
+			{
+				const tchar *Beg = m_L1Pos, *p = SkipIdentifier(m_BufPtr, m_BufEnd);
+				m_BufPtr = p;
+				if (p == m_BufEnd || *p != _T('\\'))
+				{
+					SetView(Beg, p - Beg);
+					L1Next();
+					FindKeyword();
+					return;
+				}
+				m_LastString.assign(Beg, p - Beg);
+			}
+			else
+				CharToStr(&m_LastString, m_L1Char);
+			L1Next();
+			// Wczytaj następne znaki
+			while (!m_L1End && IsIdentifierChar(m_L1Char))
+			{
+				m_LastString += m_L1Char;
+				L1Next();
+			}
+			SetViewToString();
+			// Znajdź słowo kluczowe
+			FindKeyword();
+			return;
+		}
+		// Znak '/' może rozpoczynać komentarz // , /* lub być zwykłym symbolem
+		else if (m_L1Char == _T('/'))
+		{
+			const tchar *SlashPos = m_L1Pos;
+			L1Next();
+			if (!m_L1End)
+			{
+				// Początek komentarza //
+				if (m_L1Char == _T('/'))
+				{
+					// Pomiń znaki do końca wiersza lub końca dokumentu
+					do
+					{
+						if (Buf)
+							m_BufPtr = FindChar2(m_BufPtr, m_BufEnd, _T('\n'), _T('\\'));
+						L1Next();
+					}
+					while (!m_L1End && m_L1Char != _T('\n'));
+					// Dalsze poszukiwanie tokena
+					continue;
+				}
+				// Początek komentarza /*
+				else if (m_L1Char == _T('*'))
+				{
+					L1Next();
+					bool WasAsterisk = false;
+					// Czytaj kolejne znaki
+					for (;;)
+					{
+						if (m_L1End)
+							throw TokenizerError(LastChar(), LastRow(), LastCol(), _T("Unfinished comment /* */"), __TFILE__, __LINE__);
+						
+						if (m_L1Char == _T('*'))
+							WasAsterisk = true;
+						else if (m_L1Char == _T('/') && WasAsterisk)
+							// Koniec komentarza
+							break;
+						else
+						{
+							WasAsterisk = false;
+							if (Buf)
+								m_BufPtr = FindChar2(m_BufPtr, m_BufEnd, _T('*'), _T('\\'));
+						}
+
+						L1Next();
+					}
+					// Dalsze poszukiwanie tokena
+					L1Next();
+					continue;
+				}
+			}
+			// Zwykły symbol '/'
+			if (Buf)
+				SetView(SlashPos, 1);
+			else
+				CharToStr(&m_LastString, _T('/'));
+			m_LastToken = Tokenizer::TOKEN_SYMBOL;
+			L1Next();
+			return;
+		}
+		// Liczba całkowita lub zmiennoprzecinkowa
+		else if ( (m_L1Char <= _T('9') && m_L1Char >= _T('0')) || m_L1Char == _T('+') || m_L1Char == _T('-') )
+		{
+			// Pełna poprawna składnia liczb to mniej więcej (wyrażenie regularne, \o \d \h to cyfra w danym systemie):
+			// [+-]?(0[xX]\h+|0\o+|(\d+\.\d*|\d*\.\d+|\d+)([dDeE][+-]?\d+)?)
+			// Ale że nie chce mi się tego aż tak dokładnie parsować, to zaakceptuję tutaj dowolny ciąg
+			// dowolnych cyfr, liter i znaków '.', '+' i '-' - ewentualny błąd składni i tak wyjdzie, tylko że później.
+			// Liczba jest na pewno całkowita, jeśli zaczyna się od "0x" lub "0X" (nowość! tu był błąd i 0xEE rozpoznawało jako zmiennoprzecinkowa!)
+			// Liczba jest zmiennoprzecinkowa wtedy, kiedy zawiera jeden ze znaków: [.dDeE]
+			bool IsFloat = false;
+			bool Done = false;
+			if (Buf)
+			{
+				const tchar *Beg = m_L1Pos, *p = m_BufPtr;
+				while (p != m_BufEnd && IsNumberChar(*p))
+				{
+					if (IsFloatChar(*p))
+						IsFloat = true;
+					p++;
+				}
+				m_BufPtr = p;
+				if (p == m_BufEnd || *p != _T('\\'))
+				{
+					SetView(Beg, p - Beg);
+					Done = true;
+				}
+				else
+					m_LastString.assign(Beg, p - Beg);
+			}
+			else
+				CharToStr(&m_LastString, m_L1Char);
+			L1Next();
+			if (!Done)
+			{
+				while (!m_L1End && IsNumberChar(m_L1Char))
+				{
+					if (IsFloatChar(m_L1Char))
+						IsFloat = true;
+					m_LastString += m_L1Char;
+					L1Next();
+				}
+				SetViewToString();
+			}
+			if (m_ViewLen > 1 && m_ViewPtr[0] == _T('0') && (m_ViewPtr[1] == _T('x') || m_ViewPtr[1] == _T('X')))
+				m_LastToken = Tokenizer::TOKEN_INTEGER;
+			else
+				m_LastToken = (IsFloat ? Tokenizer::TOKEN_FLOAT : Tokenizer::TOKEN_INTEGER);
+			return;
+		}
+		// Nieznany znak
+		else
+			throw TokenizerError(LastChar(), LastRow(), LastCol(), Format(_T("Unrecognized character (code=0x#): \'#\'.")) % IntToStrR(TCHAR_TO_INT(m_L1Char), 16) % m_L1Char, __TFILE__, __LINE__);
+	}
+}
+
+// Rozpoznaje przedrostek 0x (szesnastkowo) lub 0 (ósemkowo) i przesuwa za niego
+static unsigned SkipNumberBasePrefix(const tchar **Ptr, size_t *Length)
+{
+	const tchar *S = *Ptr;
+	if (*Length > 0 && S[0] == _T('0'))
+	{
+		// Szesnastkowo
+		if (*Length > 1 && (S[1] == _T('x') || S[1] == _T('X')))
+		{
+			*Ptr += 2; *Length -= 2;
+			return 16;
+		}
+		// Ósemkowo
+		*Ptr += 1; *Length -= 1;
+		return 8;
+	}
+	// Dziesiętnie
+	return 10;
+}
+
+template <typename T>
+bool Tokenizer_pimpl::GetUint(T *Out)
+{
+	// Bezpośrednio na widoku tokenu, bez kopiowania łańcucha
+	const tchar *S = m_ViewPtr;
+	size_t Length = m_ViewLen;
+
+	if (Length == 1 && S[0] == _T('0'))
+	{
+		*Out = T();
+		return true;
+	}
+
+	unsigned Base = SkipNumberBasePrefix(&S, &Length);
+	return ( StrToUint<T>(Out, S, Length, Base) == 0 );
+}
+
+template <typename T>
+bool Tokenizer_pimpl::GetInt(T *Out)
+{
+	const tchar *S = m_ViewPtr;
+	size_t Length = m_ViewLen;
+
+	if ((Length == 1 && S[0] == _T('0')) ||
+		(Length == 2 && S[1] == _T('0') && (S[0] == _T('-') || S[0] == _T('+'))))
+	{
+		*Out = T();
+		return true;
+	}
+
+	// Początkowy '+' lub '-'
+	if (Length > 0 && (S[0] == _T('+') || S[0] == _T('-')))
+	{
+		bool Negative = (S[0] == _T('-'));
+		S++; Length--;
+		unsigned Base = SkipNumberBasePrefix(&S, &Length);
+		// Plus - tak jakby go nie było, ale wszystko jest o znak dalej
+		if (!Negative)
+			return ( StrToInt<T>(Out, S, Length, Base) == 0 );
+		// Minus - uwzględnij go. Za nim nie może być drugiego znaku.
+		if (Length > 0 && (S[0] == _T('+') || S[0] == _T('-')))
+			return false;
+		return ( _StrToIntMagnitude<T>(Out, true, S, Length, Base) == 0 );
+	}
+	else
+	{
+		unsigned Base = SkipNumberBasePrefix(&S, &Length);
+		return ( StrToInt<T>(Out, S, Length, Base) == 0 );
+	}
+}
+
+template <typename T>
+T Tokenizer_pimpl::MustGetUint()
+{
+	T R;
+	if (!GetUint(&R))
+		throw TokenizerError(LastChar(), LastRow(), LastCol(), _T("Cannot convert tstring to unsigned integer number."), __TFILE__, __LINE__);
+	return R;
+}
+
+template <typename T>
+T Tokenizer_pimpl::MustGetInt()
+{
+	T R;
+	if (!GetInt(&R))
+		throw TokenizerError(LastChar(), LastRow(), LastCol(), _T("Cannot convert tstring to signed integer number."), __TFILE__, __LINE__);
+	return R;
+}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Klasa Tokenizer
+
+Tokenizer::Tokenizer(const tchar *Input, size_t NumChars, uint Flags) :
+	pimpl(new Tokenizer_pimpl(Flags))
+{
+	pimpl->InitBuffer(Input, NumChars);
+}
+
+Tokenizer::Tokenizer(const tstring *Input, uint Flags) :
+	pimpl(new Tokenizer_pimpl(Flags))
+{
+	pimpl->InitBuffer(Input->data(), Input->length());
+}
+
+Tokenizer::Tokenizer(Stream *Input, uint Flags) :
+	pimpl(new Tokenizer_pimpl(Flags))
+{
+	pimpl->m_ExternalStream = Input;
+	pimpl->m_CharReader.reset(new TCharReader(Input));
+
+	pimpl->L1Next();
+}
+
+Tokenizer::~Tokenizer()
+{
+	pimpl->m_CharReader.reset();
+	pimpl->m_ExternalStream = NULL;
+
+	pimpl.reset();
+}
+
+void Tokenizer::RegisterKeyword(uint Id, const tstring &Keyword)
+{
+	pimpl->m_Keywords.insert(KEYWORDS_MAP::value_type(Keyword, Id));
+	pimpl->m_KeywordsFinal = false;
+}
+
+void Tokenizer::RegisterKeywords(const tchar **Keywords, size_t KeywordCount)
+{
+	for (size_t i = 0; i < KeywordCount; i++)
+		RegisterKeyword((uint)i, Keywords[i]);
+}
+
+void Tokenizer::FinalizeKeywords()
+{
+	pimpl->FinalizeKeywords();
+}
+
+void Tokenizer::Next()
+{
+	if (!pimpl->m_KeywordsFinal)
+		pimpl->FinalizeKeywords();
+	pimpl->Parse();
+	if (pimpl->m_BufBegin == NULL)
+		pimpl->SetViewToString();
+}
+
+Tokenizer::TOKEN Tokenizer::GetToken()
+{
+	return pimpl->m_LastToken;
+}
+
+size_t Tokenizer::GetCharNum()
+{
+	return pimpl->LastChar();
+}
+
+size_t Tokenizer::GetRowNum()
+{
+	return pimpl->LastRow();
+}
+
+size_t Tokenizer::GetColNum()
+{
+	return pimpl->LastCol();
+}
+
+const tstring & Tokenizer::GetString()
+{
+	return pimpl->GetLastString();
+}
+
+const tchar * Tokenizer::GetStringPtr()
+{
+	return pimpl->m_ViewPtr;
+}
+
+size_t Tokenizer::GetStringLength()
+{
+	return pimpl->m_ViewLen;
+}
+
+tchar Tokenizer::GetChar()
+{
+	assert(GetToken() == TOKEN_CHAR || GetToken() == TOKEN_SYMBOL);
+
+	return pimpl->m_ViewPtr[0];
+}
+
+uint Tokenizer::GetId()
+{
+	assert(GetToken() == TOKEN_KEYWORD);
+
+	return pimpl->m_LastId;
+}
+
+bool Tokenizer::GetUint1(uint8 *Out) { AssertToken(TOKEN_INTEGER); return pimpl->GetUint<uint8>(Out); }
+bool Tokenizer::GetUint2(uint16 *Out) { AssertToken(TOKEN_INTEGER); return pimpl->GetUint<uint16>(Out); }
+bool Tokenizer::GetUint4(uint32 *Out) { AssertToken(TOKEN_INTEGER); return pimpl->GetUint<uint32>(Out); }
+bool Tokenizer::GetUint8(uint64 *Out) { AssertToken(TOKEN_INTEGER); return pimpl->GetUint<uint64>(Out); }
+
+bool Tokenizer::GetInt1(int8 *Out) { AssertToken(TOKEN_INTEGER); return pimpl->GetInt<int8>(Out); }
+bool Tokenizer::GetInt2(int16 *Out) { AssertToken(TOKEN_INTEGER); return pimpl->GetInt<int16>(Out); }
+bool Tokenizer::GetInt4(int32 *Out) { AssertToken(TOKEN_INTEGER); return pimpl->GetInt<int32>(Out); }
+bool Tokenizer::GetInt8(int64 *Out) { AssertToken(TOKEN_INTEGER); return pimpl->GetInt<int64>(Out); }
+
+uint8 Tokenizer::MustGetUint1() { AssertToken(TOKEN_INTEGER); return pimpl->MustGetUint<uint8>(); }
+uint16 Tokenizer::MustGetUint2() { AssertToken(TOKEN_INTEGER); return pimpl->MustGetUint<uint16>(); }
+uint32 Tokenizer::MustGetUint4() { AssertToken(TOKEN_INTEGER); return pimpl->MustGetUint<uint32>(); }
+uint64 Tokenizer::MustGetUint8() { AssertToken(TOKEN_INTEGER); return pimpl->MustGetUint<uint64>(); }
+
+int8 Tokenizer::MustGetInt1() { AssertToken(TOKEN_INTEGER); return pimpl->MustGetInt<int8>(); }
+int16 Tokenizer::MustGetInt2() { AssertToken(TOKEN_INTEGER); return pimpl->MustGetInt<int16>(); }
+int32 Tokenizer::MustGetInt4() { AssertToken(TOKEN_INTEGER); return pimpl->MustGetInt<int32>(); }
+int64 Tokenizer::MustGetInt8() { AssertToken(TOKEN_INTEGER); return pimpl->MustGetInt<int64>(); }
+
+bool Tokenizer::GetFloat(float *Out)
+{
+	AssertToken(TOKEN_INTEGER, TOKEN_FLOAT);
+
+	return ( StrToFloat(Out, pimpl->m_ViewPtr, pimpl->m_ViewLen) == 0 );
+}
+
+bool Tokenizer::GetDouble(double *Out)
+{
+	AssertToken(TOKEN_INTEGER, TOKEN_FLOAT);
+
+	return ( StrToDouble(Out, pimpl->m_ViewPtr, pimpl->m_ViewLen) == 0 );
+}
+
+float Tokenizer::MustGetFloat()
+{
+	float R;
+	if (!GetFloat(&R))
+		throw TokenizerError(pimpl->LastChar(), pimpl->LastRow(), pimpl->LastCol(), _T("Cannot convert tstring to float number."), __TFILE__, __LINE__);
+	return R;
+}
+
+double Tokenizer::MustGetDouble()
+{
+	double R;
+	if (!GetDouble(&R))
+		throw TokenizerError(pimpl->LastChar(), pimpl->LastRow(), pimpl->LastCol(), _T("Cannot convert tstring to double number."), __TFILE__, __LINE__);
+	return R;
+}
+
+void Tokenizer::CreateError()
+{
+	throw TokenizerError(pimpl->LastChar(), pimpl->LastRow(), pimpl->LastCol(), _T("Unknown error"), __TFILE__, __LINE__);
+}
+
+void Tokenizer::CreateError(const tstring &Msg)
+{
+	throw TokenizerError(pimpl->LastChar(), pimpl->LastRow(), pimpl->LastCol(), Msg, __TFILE__, __LINE__);
+}
+
+bool Tokenizer::QueryToken(Tokenizer::TOKEN Token)
+{
+	return (GetToken() == Token);
+}
+
+bool Tokenizer::QueryToken(TOKEN Token1, TOKEN Token2)
+{
+	return (GetToken() == Token1 || GetToken() == Token2);
+}
+
+bool Tokenizer::QueryEOF()
+{
+	return QueryToken(TOKEN_EOF);
+}
+
+bool Tokenizer::QueryEOL()
+{
+	return QueryToken(TOKEN_EOL);
+}
+
+bool Tokenizer::QuerySymbol(tchar Symbol)
+{
+	return (GetToken() == TOKEN_SYMBOL && GetChar() == Symbol);
+}
+
+bool Tokenizer::QueryIdentifier(const tstring &Identifier)
+{
+	return (GetToken() == TOKEN_IDENTIFIER && pimpl->ViewEquals(Identifier));
+}
+
+bool Tokenizer::QueryKeyword(uint KeywordId)
+{
+	return (GetToken() == TOKEN_KEYWORD && GetId() == KeywordId);
+}
+
+bool Tokenizer::QueryKeyword(const tstring &Keyword)
+{
+	return (GetToken() == TOKEN_KEYWORD && pimpl->ViewEquals(Keyword));
+}
+
+void Tokenizer::AssertToken(Tokenizer::TOKEN Token)
+{
+	if (Token != GetToken())
+		CreateError(_T("Expected: ") + tstring(GetTokenName(Token)));
+}
+
+void Tokenizer::AssertToken(TOKEN Token1, TOKEN Token2)
+{
+	if (Token1 != GetToken() && Token2 != GetToken())
+		CreateError(_T("Expected: ") + tstring(GetTokenName(Token1)) + _T(" or ") + GetTokenName(Token2));
+}
+
+void Tokenizer::AssertEOF()
+{
+	AssertToken(TOKEN_EOF);
+}
+
+void Tokenizer::AssertEOL()
+{
+	AssertToken(TOKEN_EOL);
+}
+
+void Tokenizer::AssertSymbol(tchar Symbol)
+{
+	if (GetToken() != TOKEN_SYMBOL || GetChar() != Symbol)
+		CreateError(_T("Expected symbol: ") + CharToStrR(Symbol));
+}
+
+void Tokenizer::AssertIdentifier(const tstring &Identifier)
+{
+	if (GetToken() != TOKEN_IDENTIFIER || !pimpl->ViewEquals(Identifier))
+		CreateError(_T("Expected identifier: ") + Identifier);
+}
+
+void Tokenizer::AssertKeyword(uint KeywordId)
+{
+	if (GetToken() != TOKEN_KEYWORD || GetId() != KeywordId)
+		CreateError(_T("Expected keyword number ") + UintToStrR(KeywordId));
+}
+
+void Tokenizer::AssertKeyword(const tstring &Keyword)
+{
+	if (GetToken() != TOKEN_KEYWORD || !pimpl->ViewEquals(Keyword))
+		CreateError(_T("Expected keyword: ") + Keyword);
+}
+
+const tchar * Tokenizer::GetTokenName(TOKEN Token)
+{
+	switch (Token)
+	{
+	case TOKEN_EOF:         return _T("End of data");
+	case TOKEN_EOL:         return _T("End of line");
+	case TOKEN_SYMBOL:      return _T("Symbol");
+	case TOKEN_INTEGER:     return _T("Integer number");
+	case TOKEN_FLOAT:       return _T("Float number");
+	case TOKEN_CHAR:        return _T("Character constant");
+	case TOKEN_IDENTIFIER:  return _T("Identifier");
+	case TOKEN_KEYWORD:     return _T("Keyword");
+	case TOKEN_STRING:      return _T("String");
+	default:                return _T("Unknown");
+	}
+}
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// class TokenWriter
+
+// Zapisuje do Out sekwencję ucieczki dla znaku (najwyżej 4 znaki, bez zera na końcu) i zwraca jej długość.
+// Jeśli znak nie wymaga escapowania, zwraca 0.
+static inline size_t EscapeChar(tchar *Out, tchar Ch, uint EscapeFlags)
+{
+	tchar Code;
+	switch (Ch)
+	{
+	case _T('\r'):
+		if ((EscapeFlags & TokenWriter::ESCAPE_EOL) == 0)
+			return 0;
+		Code = _T('r');
+		break;
+	case _T('\n'):
+		if ((EscapeFlags & TokenWriter::ESCAPE_EOL) == 0)
+			return 0;
+		Code = _T('n');
+		break;
+	case _T('\\'):
+	case _T('\''):
+	case _T('\"'):
+		Code = Ch;
+		break;
+	case _T('\0'): Code = _T('0'); break;
+	case _T('\v'): Code = _T('v'); break;
+	case _T('\b'): Code = _T('b'); break;
+	case _T('\f'): Code = _T('f'); break;
+	case _T('\a'): Code = _T('a'); break;
+	case _T('\t'):
+		return 0;
+	default:
+		if ( ((uint8)Ch < 32 || (uint8)Ch > 126) && (EscapeFlags & TokenWriter::ESCAPE_OTHER) != 0 )
+		{
+			Out[0] = _T('\\');
+			Out[1] = _T('x');
+			// Dwie cyfry szesnastkowe wprost - UintToStr2 wymagałby bufora INT_TO_STR_BUFFER_SIZE
+			Out[2] = _T("0123456789ABCDEF")[(uint8)Ch >> 4];
+			Out[3] = _T("0123456789ABCDEF")[(uint8)Ch & 0xF];
+			return 4;
+		}
+		return 0;
+	}
+	Out[0] = _T('\\');
+	Out[1] = Code;
+	return 2;
+}
+
+void TokenWriter::Escape(tstring *Out, const tstring &In, uint EscapeFlags)
+{
+	Out->clear();
+	Out->reserve(In.length());
+
+	tchar Seq[4];
+	size_t RunBeg = 0;
+	for (size_t i = 0; i < In.length(); i++)
+	{
+		size_t SeqLength = EscapeChar(Seq, In[i], EscapeFlags);
+		if (SeqLength > 0)
+		{
+			Out->append(In, RunBeg, i - RunBeg);
+			Out->append(Seq, SeqLength);
+			RunBeg = i + 1;
+		}
+	}
+	Out->append(In, RunBeg, In.length() - RunBeg);
+}
+
+TokenWriter::TokenWriter( tstring *outStr )
+: m_OutString(outStr)
+, m_OutStream(NULL)
+{
+	Ctor();
+}
+
+TokenWriter::TokenWriter( common::Stream *outStream )
+: m_OutString(NULL)
+, m_OutStream(outStream)
+{
+	Ctor();
+}
+
+TokenWriter::~TokenWriter()
+{
+	if (m_BufLength > 0)
+	{
+		try
+		{
+			Flush();
+		}
+		catch (...)
+		{
+			assert(0 && "Exception caught in TokenWriter::~TokenWriter while calling TokenWriter::Flush.");
+		}
+	}
+}
+
+void TokenWriter::Flush()
+{
+	if (m_BufLength > 0)
+	{
+		// Bufor jest opróżniany przed zapisem, żeby po wyjątku nie zapisywać go drugi raz
+		size_t length = m_BufLength;
+		m_BufLength = 0;
+		m_OutStream->Write(m_Buf, length * sizeof(tchar));
+	}
+}
+
+void TokenWriter::Ctor()
+{
+	m_BufLength = 0;
+	m_Level = 0;
+	m_WasEOL = m_SpaceRequired = false;
+	m_EOL = EOL;
+	m_Indent = _T('\t');
+	m_EscapeFlags = ESCAPE_EOL;
+}
+
+void TokenWriter::WriteSpace( tchar ch )
+{
+	WriteRaw(ch);
+	m_WasEOL = m_SpaceRequired = false;
+}
+
+void TokenWriter::WriteSpace( const tstring &s )
+{
+	WriteRaw(s);
+	m_WasEOL = m_SpaceRequired = false;
+}
+
+void TokenWriter::WriteEOL()
+{
+	WriteRaw(m_EOL);
+	m_WasEOL = true;
+	m_SpaceRequired = false;
+}
+
+void TokenWriter::WriteIdentifier( const tstring &s )
+{
+	if (m_WasEOL) WriteIndent(m_Level);
+	else if (m_SpaceRequired) WriteSpace();
+
+	WriteRaw(s);
+
+	m_SpaceRequired = true;
+	m_WasEOL = false;
+}
+
+void TokenWriter::WriteSymbol( tchar ch )
+{
+	int levelDelta = GetSymbolLevelDelta(ch);
+	if (levelDelta == -1) LevelDec();
+
+	if (m_WasEOL) WriteIndent(m_Level);
+	else if (m_SpaceRequired && IsSymbolSpaceBefore(ch)) WriteSpace();
+
+	WriteRaw(ch);
+
+	if (levelDelta == 1) LevelInc();
+
+	m_SpaceRequired = IsSymbolSpaceAfter(ch);
+	m_WasEOL = false;
+}
+
+void TokenWriter::WriteSymbol( const tstring &s )
+{
+	assert(!s.empty());
+	if (s.length() == 1)
+	{
+		WriteSymbol(s[0]);
+		return;
+	}
+	
+	// Here only multicharacter
+
+	int levelDelta = GetSymbolLevelDelta(s);
+	if (levelDelta == -1) LevelDec();
+
+	if (m_WasEOL) WriteIndent(m_Level);
+	else if (m_SpaceRequired && IsSymbolSpaceBefore(s)) WriteSpace();
+
+	WriteRaw(s);
+
+	if (levelDelta == 1) LevelInc();
+
+	m_SpaceRequired = IsSymbolSpaceAfter(s);
+	m_WasEOL = false;
+}
+
+void TokenWriter::WriteString( const tchar *s, size_t length )
+{
+	if (m_WasEOL) WriteIndent(m_Level);
+	else if (m_SpaceRequired) WriteSpace();
+
+	WriteRaw(_T('"'));
+	WriteEscaped(s, length);
+	WriteRaw(_T('"'));
+
+	m_SpaceRequired = true;
+	m_WasEOL = false;
+}
+
+void TokenWriter::WriteIndent( uint level )
+{
+	for (unsigned i = 0; i < level; i++)
+		WriteRaw(m_Indent);
+}
+
+void TokenWriter::WriteRaw( const tchar *s, size_t length )
+{
+	if (m_OutString)
+		m_OutString->append(s, length);
+	else
+	{
+		if (length > BUFFER_SIZE - m_BufLength)
+		{
+			Flush();
+			// Długi kawałek idzie do strumienia bezpośrednio
+			if (length >= BUFFER_SIZE)
+			{
+				m_OutStream->Write(s, length * sizeof(tchar));
+				return;
+			}
+		}
+		memcpy(m_Buf + m_BufLength, s, length * sizeof(tchar));
+		m_BufLength += length;
+	}
+}
+
+void TokenWriter::WriteEscaped( const tchar *s, size_t length )
+{
+	// Fragmenty bez znaków specjalnych są zapisywane w całości
+	tchar seq[4];
+	size_t runBeg = 0;
+	for (size_t i = 0; i < length; i++)
+	{
+		tchar ch = s[i];
+		if (ch >= _T(' ') && ch <= _T('~') && ch != _T('\\') && ch != _T('\'') && ch != _T('"'))
+			continue;
+		size_t seqLength = EscapeChar(seq, ch, m_EscapeFlags);
+		if (seqLength > 0)
+		{
+			WriteRaw(s + runBeg, i - runBeg);
+			WriteRaw(seq, seqLength);
+			runBeg = i + 1;
+		}
+	}
+	WriteRaw(s + runBeg, length - runBeg);
+}
+
+void TokenWriter::WriteKeyword( const tstring &s)
+{
+	int levelDelta = GetKeywordLevelDelta(s);
+	if (levelDelta == -1)
+		LevelDec();
+
+	if (m_WasEOL) WriteIndent(m_Level);
+	else if (m_SpaceRequired) WriteSpace();
+
+	WriteRaw(s);
+
+	if (levelDelta == 1)
+		LevelInc();
+
+	m_SpaceRequired = true;
+	m_WasEOL = false;
+}
+
+void TokenWriter::RegisterSymbol( tchar ch, bool spaceBefore, bool spaceAfter, int levelDelta )
+{
+	if (spaceBefore)
+		m_Symbols_Chars_SpaceBefore += ch;
+	if (spaceAfter)
+		m_Symbols_Chars_SpaceAfter += ch;
+
+	assert(levelDelta >= -1 && levelDelta <= 1);
+	if (levelDelta == -1)
+		m_Symbols_Chars_LevelDec += ch;
+	else if (levelDelta == 1)
+		m_Symbols_Chars_LevelInc += ch;
+}
+
+void TokenWriter::RegisterSymbol( const tstring &s, bool spaceBefore, bool spaceAfter, int levelDelta )
+{
+	if (spaceBefore)
+		m_Symbols_Strings_SpaceBefore.push_back(s);
+	if (spaceAfter)
+		m_Symbols_Strings_SpaceAfter.push_back(s);
+
+	assert(levelDelta >= -1 && levelDelta <= 1);
+	if (levelDelta == -1)
+		m_Symbols_Strings_LevelDec.push_back(s);
+	else if (levelDelta == 1)
+		m_Symbols_Strings_LevelInc.push_back(s);
+}
+
+void TokenWriter::RegisterKeyword( const tstring &s, int levelDelta )
+{
+	assert(levelDelta >= -1 && levelDelta <= 1);
+	if (levelDelta == -1)
+		m_Keywords_LevelDec.push_back(s);
+	else if (levelDelta == 1)
+		m_Keywords_LevelInc.push_back(s);
+}
+
+int TokenWriter::GetKeywordLevelDelta( const tstring &s )
+{
+	STRING_VECTOR::iterator it = std::find(m_Keywords_LevelInc.begin(), m_Keywords_LevelInc.end(), s);
+	if (it != m_Keywords_LevelInc.end())
+		return 1;
+	it = std::find(m_Keywords_LevelDec.begin(), m_Keywords_LevelDec.end(), s);
+	if (it != m_Keywords_LevelDec.end())
+		return -1;
+	return 0;
+}
+
+int TokenWriter::GetSymbolLevelDelta( tchar ch )
+{
+	size_t pos = m_Symbols_Chars_LevelInc.find(ch);
+	if (pos != tstring::npos)
+		return 1;
+	pos = m_Symbols_Chars_LevelDec.find(ch);
+	if (pos != tstring::npos)
+		return -1;
+	return 0;
+}
+
+int TokenWriter::GetSymbolLevelDelta( const tstring &s )
+{
+	assert(!s.empty());
+	if (s.length() == 1)
+		return GetSymbolLevelDelta(s[0]);
+
+	STRING_VECTOR::iterator it = std::find(m_Symbols_Strings_LevelInc.begin(), m_Symbols_Strings_LevelInc.end(), s);
+	if (it != m_Symbols_Strings_LevelInc.end())
+		return 1;
+	it = std::find(m_Symbols_Strings_LevelDec.begin(), m_Symbols_Strings_LevelDec.end(), s);
+	if (it != m_Symbols_Strings_LevelDec.end())
+		return -1;
+	return 0;
+}
+
+bool TokenWriter::IsSymbolSpaceBefore( tchar ch )
+{
+	return m_Symbols_Chars_SpaceBefore.find(ch) != tstring::npos;
+}
+
+bool TokenWriter::IsSymbolSpaceBefore( const tstring &s )
+{
+	return std::find(m_Symbols_Strings_SpaceBefore.begin(), m_Symbols_Strings_SpaceBefore.end(), s) != m_Symbols_Strings_SpaceBefore.end();
+}
+
+bool TokenWriter::IsSymbolSpaceAfter( tchar ch )
+{
+	return m_Symbols_Chars_SpaceAfter.find(ch) != tstring::npos;
+}
+
+// Liczba bez znaku dziesiętnie albo jako 0x... szesnastkowo, do bufora na stosie
+template <typename T>
+static void UintToTokenStr(tchar *Out, T v, bool hex)
+{
+	if (hex)
+	{
+		Out[0] = _T('0');
+		Out[1] = _T('x');
+		UintToStr<T>(Out + 2, v, 16);
+	}
+	else
+		UintToStr<T>(Out, v);
+}
+
+void TokenWriter::WriteUint1( uint8 v, bool hex )
+{
+	tchar s[INT_TO_STR_BUFFER_SIZE + 2];
+	UintToTokenStr<uint8>(s, v, hex);
+	WriteNumberString(s);
+}
+
+void TokenWriter::WriteUint2( uint16 v, bool hex )
+{
+	tchar s[INT_TO_STR_BUFFER_SIZE + 2];
+	UintToTokenStr<uint16>(s, v, hex);
+	WriteNumberString(s);
+}
+
+void TokenWriter::WriteUint4( uint32 v, bool hex )
+{
+	tchar s[INT_TO_STR_BUFFER_SIZE + 2];
+	UintToTokenStr<uint32>(s, v, hex);
+	WriteNumberString(s);
+}
+
+void TokenWriter::WriteUint8( uint64 v, bool hex )
+{
+	tchar s[INT_TO_STR_BUFFER_SIZE + 2];
+	UintToTokenStr<uint64>(s, v, hex);
+	WriteNumberString(s);
+}
+
+void TokenWriter::WriteInt1( int8 v ) { tchar s[INT_TO_STR_BUFFER_SIZE]; IntToStr<int8> (s, v); WriteNumberString(s); }
+void TokenWriter::WriteInt2( int16 v ) { tchar s[INT_TO_STR_BUFFER_SIZE]; IntToStr<int16>(s, v); WriteNumberString(s); }
+void TokenWriter::WriteInt4( int32 v ) { tchar s[INT_TO_STR_BUFFER_SIZE]; IntToStr<int32>(s, v); WriteNumberString(s); }
+void TokenWriter::WriteInt8( int64 v ) { tchar s[INT_TO_STR_BUFFER_SIZE]; IntToStr<int64>(s, v); WriteNumberString(s); }
+
+void TokenWriter::WriteFloat(  float v, char Mode, int Precision  ) { tchar s[DOUBLE_TO_STR_BUFFER_SIZE]; FloatToStr (s, v, Mode, Precision); WriteNumberString(s); }
+void TokenWriter::WriteDouble( double v, char Mode, int Precision ) { tchar s[DOUBLE_TO_STR_BUFFER_SIZE]; DoubleToStr(s, v, Mode, Precision); WriteNumberString(s); }
+
+void TokenWriter::WriteNumberString( const tstring &v )
+{
+	if (m_WasEOL) WriteIndent(m_Level);
+	else if (m_SpaceRequired) WriteSpace();
+
+	WriteRaw(v);
+
+	m_SpaceRequired = true;
+	m_WasEOL = false;
+}
+
+void TokenWriter::WriteNumberString( const tchar *v )
+{
+	if (m_WasEOL) WriteIndent(m_Level);
+	else if (m_SpaceRequired) WriteSpace();
+
+	WriteRaw(v);
+
+	m_SpaceRequired = true;
+	m_WasEOL = false;
+}
+
+void TokenWriter::WriteComment( const tstring &s, bool alwaysMultiline /*= false*/ )
+{
+	if (alwaysMultiline || ContainsEOL(s))
+		WriteMultiLineComment(s);
+	else
+		WriteSingleLineComment(s);
+}
+
+void TokenWriter::WriteMultiLineComment( const tstring &s )
+{
+	assert(s.find(_T("*/")) == tstring::npos);
+
+	if (m_WasEOL) WriteIndent(m_Level);
+	else if (m_SpaceRequired) WriteSpace();
+
+	WriteRaw(_T("/*"));
+	WriteRaw(s);
+	WriteRaw(_T("*/"));
+
+	m_SpaceRequired = true;
+	m_WasEOL = false;
+}
+
+void TokenWriter::WriteSingleLineComment( const tstring &s )
+{
+	if (m_WasEOL) WriteIndent(m_Level);
+	else if (m_SpaceRequired) WriteSpace();
+
+	WriteRaw(_T("//"));
+	WriteRaw(s);
+	WriteRaw(m_EOL);
+
+	m_SpaceRequired = false;
+	m_WasEOL = true;
+}
+
+bool TokenWriter::IsSymbolSpaceAfter( const tstring &s )
+{
+	return std::find(m_Symbols_Strings_SpaceAfter.begin(), m_Symbols_Strings_SpaceAfter.end(), s) != m_Symbols_Strings_SpaceAfter.end();
+}
+
+
+} // namespace common
@@ -1,257 +1,297 @@
-/** \file
-\brief Parser of language syntax similar to C/C++
-\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
-
-Part of CommonLib library. \n
-Encoding UTF-8, end of line CR+LF \n
-License: GNU LGPL. \n
-Documentation: \ref Module_Tokenizer \n
-Module components: \ref code_tokenizer
-*/
-#if defined(_MSC_VER) && (_MSC_VER >= 1200)
-#pragma once
-#endif
-#ifndef COMMON_TOKENIZER_H_
-#define COMMON_TOKENIZER_H_
-
-#include "Error.hpp"
-
-namespace common
-{
-
-class Stream;
-
-/** \addtogroup code_tokenizer Tokenizer Module
-Dokumentacja: \ref Module_Tokenizer \n
-Nagwek: Tokenizer.hpp */
-//@{
-
-/// Klasa bdu dla tokenizera
-class TokenizerError : public Error
-{
-private:
-	size_t m_Char, m_Row, m_Col;
-public:
-	TokenizerError(size_t Char, size_t Row, size_t Col, const tstring &Msg = _T(""), const tstring &File = _T(""), int a_Line = 0);
-
-	size_t GetCharNum() { return m_Char; }
-	size_t GetRowNum() { return m_Row; }
-	size_t GetColNum() { return m_Col; }
-};
-
-/// \internal
-class Tokenizer_pimpl;
-
-/// Tokenizer
-class Tokenizer
-{
-private:
-	scoped_ptr<Tokenizer_pimpl> pimpl;
-
-public:
-	/// Koniec wiersza '\n' ma by uznawany za osobnego rodzaju token, nie za zwyczajny biay znak
-	static const uint FLAG_TOKEN_EOL         = 0x01;
-	/// acuch "" moe si rozciga na wiele wierszy zawierajc w treci koniec wiersza
-	static const uint FLAG_MULTILINE_STRINGS = 0x02;
-
-	/// Rodzaje tokenw
-	enum TOKEN
-	{
-		TOKEN_EOF,        ///< Koniec caego dokumentu (dalej nie parsowa)
-		TOKEN_EOL,        ///< Token koca linii (tylko kiedy FLAG_TOKEN_EOL)
-		TOKEN_SYMBOL,     ///< Jednoznakowy symbol (np. kropka)
-		TOKEN_INTEGER,    ///< Liczba cakowita, np. <tt>-123</tt>
-		TOKEN_FLOAT,      ///< Liczba zmiennoprzecinkowa, np. <tt>10.5</tt>
-		TOKEN_CHAR,       ///< Staa znakowa, np. <tt>'A'</tt>
-		TOKEN_IDENTIFIER, ///< Identyfikator, np. <tt>abc_123</tt>
-		TOKEN_KEYWORD,    ///< Sowo kluczowe, czyli identyfikator pasujcy do zarejestrowanych sw kluczowych
-		TOKEN_STRING,     ///< Staa acuchowa, np. <tt>"ABC"</tt>
-	};
-
-	/// Tworzy z dokumentu podanego przez acuch tchar*
-	Tokenizer(const tchar *Input, size_t NumChars, uint Flags);
-	/// Tworzy z dokumentu podanego przez tstring
-	Tokenizer(const tstring *Input, uint Flags);
-	/// Tworzy z dokumentu wczytywanego z dowolnego strumienia
-	Tokenizer(Stream *Input, uint Flags);
-
-	~Tokenizer();
-
-	/** \name Konfiguracja */
-	//@{
-	void RegisterKeyword(uint Id, const tstring &Keyword);
-	/// Wczytuje ca list sw kluczowych w postaci tablicy acuchw tchar*.
-	/** Sowa kluczowe bd miay kolejne identyfikatory 0, 1, 2 itd. */
-	void RegisterKeywords(const tchar **Keywords, size_t KeywordCount);
-	//@}
-
-	/** \name Funkcje podstawowe
-	Zwracaj informacje na temat ostatnio odczytanego tokena. */
-	//@{
-
-	/// Odczytuje nastpny token
-	void Next();
-
-	/// Zwraca typ tokena
-	TOKEN GetToken();
-
-	size_t GetCharNum();
-	size_t GetRowNum();
-	size_t GetColNum();
-
-	/// Dziaa zawsze, ale zastosowanie gwnie dla GetToken() == common::Tokenizer::TOKEN_IDENTIFIER lub common::Tokenizer::TOKEN_STRING
-	const tstring & GetString();
-	/// Tylko jeli GetToken() == common::Tokenizer::TOKEN_CHAR lub common::Tokenizer::TOKEN_SYMBOL
-	tchar GetChar();
-	/// Tylko jeli GetToken() == common::Tokenizer::TOKEN_KEYWORD
-	uint GetId();
-	/// Tylko jeli GetToken() == common::Tokenizer::TOKEN_INTEGER
-	bool GetUint1(uint8 *Out);
-	bool GetUint2(uint16 *Out);
-	bool GetUint4(uint32 *Out);
-	bool GetUint8(uint64 *Out);
-	bool GetInt1(int8 *Out);
-	bool GetInt2(int16 *Out);
-	bool GetInt4(int32 *Out);
-	bool GetInt8(int64 *Out);
-	uint8 MustGetUint1();
-	uint16 MustGetUint2();
-	uint32 MustGetUint4();
-	uint64 MustGetUint8();
-	int8 MustGetInt1();
-	int16 MustGetInt2();
-	int32 MustGetInt4();
-	int64 MustGetInt8();
-	/** Tylko jeli GetToken() == common::Tokenizer::TOKEN_INTEGER lub common::Tokenizer::TOKEN_FLOAT */
-	bool GetFloat(float *Out);
-	/** Tylko jeli GetToken() == common::Tokenizer::TOKEN_INTEGER lub common::Tokenizer::TOKEN_FLOAT */
-	bool GetDouble(double *Out);
-	float MustGetFloat();
-	double MustGetDouble();
-
-	//@}
-
-	/// Rzuca wyjtek z bdem parsowania. Domylny komunikat.
-	void CreateError();
-	/// Rzuca wyjtek z bdem parsowania. Wasny komunikat.
-	void CreateError(const tstring &Msg);
-
-	/** \name Zapytania
-	Zwracaj true, jeli ostatnio sparsowany token jest taki jak tu podany. */
-	//@{
-	bool QueryToken(TOKEN Token);
-	bool QueryToken(TOKEN Token1, TOKEN Token2);
-	bool QueryEOF();
-	bool QueryEOL();
-	bool QuerySymbol(tchar Symbol);
-	bool QueryIdentifier(const tstring &Identifier);
-	bool QueryKeyword(uint KeywordId);
-	bool QueryKeyword(const tstring &Keyword);
-	//@}
-
-	/** \name Asercje
-	Rzucaj wyjtek, jeli ostatnio wczytany token nie spenia danego warunku. */
-	//@{
-	/// Rzuca wyjtek z bdem parsowania, jeli ostatnio sparsowany token nie jest podanego rodzaju.
-	void AssertToken(TOKEN Token);
-	/// Rzuca wyjtek z bdem parsowania, jeli ostatnio sparsowany token nie jest jednego z dwch podanych rodzajw.
-	void AssertToken(TOKEN Token1, TOKEN Token2);
-	void AssertEOF();
-	void AssertEOL();
-	void AssertSymbol(tchar Symbol);
-	void AssertIdentifier(const tstring &Identifier);
-	void AssertKeyword(uint KeywordId);
-	void AssertKeyword(const tstring &Keyword);
-	//@}
-
-	/// Zamienia typ tokena na jego czytelny dla uytkownika opis tekstowy, np. "Staa znakowa"
-	static const tchar * GetTokenName(TOKEN Token);
-};
-
-class TokenWriter
-{
-public:
-	static const uint ESCAPE_EOL   = 0x01; ///< Zamienia znaki koca wiersza na <tt>\\r \\n</tt> na sekwencje ucieczki
-	static const uint ESCAPE_OTHER = 0x02; ///< Zamienia znaki niedostne z klawiatury (w tym polskie litery) na <tt>\\xHH</tt>
-	/// Escapuje acuch zgodnie ze skadni tokenizera
-	/** \param EscapeFlags Uywa staych ESCAPE_EOL, ESCAPE_OTHER. */
-	static void Escape(tstring *Out, const tstring &In, uint EscapeFlags);
-
-	TokenWriter(tstring *outStr);
-	TokenWriter(common::Stream *outStream);
-
-	//====== Configuration
-	const tstring & GetEOL() { return m_EOL; }
-	const tstring & GetIndent() { return m_Indent; }
-	void SetEOL(const tstring &s) { m_EOL = s; }
-	void SetIndent(const tstring &s) { m_Indent = s; }
-	uint GetEscapeFlags() { return m_EscapeFlags; }
-	void SetEscapeFlags(uint v) { m_EscapeFlags = v; }
-	void RegisterSymbol(tchar ch, bool spaceBefore, bool spaceAfter, int levelDelta);
-	void RegisterSymbol(const tstring &s, bool spaceBefore, bool spaceAfter, int levelDelta);
-	void RegisterKeyword(const tstring &s, int levelDelta);
-	
-	uint GetLevel() { return m_Level; }
-
-	void WriteSpace(tchar ch = _T(' '));
-	void WriteSpace(const tstring &s);
-	void WriteEOL();
-
-	void WriteKeyword(const tstring &s);
-	void WriteIdentifier(const tstring &s);
-	void WriteSymbol(tchar ch);
-	void WriteSymbol(const tstring &s);
-	void WriteString(const tstring &s);
-	void WriteUint1(uint8 v, bool hex = false);
-	void WriteUint2(uint16 v, bool hex = false);
-	void WriteUint4(uint32 v, bool hex = false);
-	void WriteUint8(uint64 v, bool hex = false);
-	void WriteInt1(int8 v);
-	void WriteInt2(int16 v);
-	void WriteInt4(int32 v);
-	void WriteInt8(int64 v);
-	void WriteFloat(float v, char Mode = 'g', int Precision = 6);
-	void WriteDouble(double v, char Mode = 'g', int Precision = 6);
-	void WriteNumberString(const tstring &v);
-	void WriteComment(const tstring &s, bool alwaysMultiline = false);
-
-private:
-	tstring *m_OutString;
-	common::Stream *m_OutStream;
-
-	tstring m_EOL, m_Indent;
-	uint m_EscapeFlags;
-	tstring m_Symbols_Chars_SpaceBefore, m_Symbols_Chars_SpaceAfter;
-	tstring m_Symbols_Chars_LevelInc, m_Symbols_Chars_LevelDec;
-	STRING_VECTOR m_Symbols_Strings_SpaceBefore, m_Symbols_Strings_SpaceAfter;
-	STRING_VECTOR m_Symbols_Strings_LevelInc, m_Symbols_Strings_LevelDec;
-	STRING_VECTOR m_Keywords_LevelInc, m_Keywords_LevelDec;
-
-	uint m_Level;
-	bool m_WasEOL;
-	bool m_SpaceRequired;
-
-	void Ctor();
-	void WriteIndent(uint level);
-	void LevelInc() { m_Level++; }
-	void LevelDec() { assert(m_Level > 0); m_Level--; }
-	void WriteRaw(tchar ch);
-	void WriteRaw(const tchar *s);
-	void WriteRaw(const tstring &s);
-	int GetKeywordLevelDelta(const tstring &s);
-	int GetSymbolLevelDelta(tchar ch);
-	int GetSymbolLevelDelta(const tstring &s);
-	bool IsSymbolSpaceBefore(tchar ch);
-	bool IsSymbolSpaceBefore(const tstring &s);
-	bool IsSymbolSpaceAfter(tchar ch);
-	bool IsSymbolSpaceAfter(const tstring &s);
-	void WriteMultiLineComment(const tstring &s);
-	void WriteSingleLineComment(const tstring &s);
-};
-
-//@}
-// code_tokenizer
-
-} // namespace common
-
-#endif
+/** \file
+\brief Parser of language syntax similar to C/C++
+\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
+
+Part of CommonLib library. \n
+Encoding UTF-8, end of line CR+LF \n
+License: GNU LGPL. \n
+Documentation: \ref Module_Tokenizer \n
+Module components: \ref code_tokenizer
+*/
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+#pragma once
+#endif
+#ifndef COMMON_TOKENIZER_H_
+#define COMMON_TOKENIZER_H_
+
+#include "Error.hpp"
+
+namespace common
+{
+
+class Stream;
+
+/** \addtogroup code_tokenizer Tokenizer Module
+Dokumentacja: \ref Module_Tokenizer \n
+Nagłówek: Tokenizer.hpp */
+//@{
+
+/// Klasa błędu dla tokenizera
+class TokenizerError : public Error
+{
+private:
+	size_t m_Char, m_Row, m_Col;
+public:
+	TokenizerError(size_t Char, size_t Row, size_t Col, const tstring &Msg = _T(""), const tstring &File = _T(""), int a_Line = 0);
+
+	size_t GetCharNum() { return m_Char; }
+	size_t GetRowNum() { return m_Row; }
+	size_t GetColNum() { return m_Col; }
+};
+
+/// \internal
+class Tokenizer_pimpl;
+
+/// Tokenizer
+class Tokenizer
+{
+private:
+	scoped_ptr<Tokenizer_pimpl> pimpl;
+
+public:
+	/// Koniec wiersza '\n' ma być uznawany za osobnego rodzaju token, nie za zwyczajny biały znak
+	static const uint FLAG_TOKEN_EOL         = 0x01;
+	/// Łańcuch "" może się rozciągać na wiele wierszy zawierając w treści koniec wiersza
+	static const uint FLAG_MULTILINE_STRINGS = 0x02;
+
+	/// Rodzaje tokenów
+	enum TOKEN
+	{
+		TOKEN_EOF,        ///< Koniec całego dokumentu (dalej nie parsować)
+		TOKEN_EOL,        ///< Token końca linii (tylko kiedy FLAG_TOKEN_EOL)
+		TOKEN_SYMBOL,     ///< Jednoznakowy symbol (np. kropka)
+		TOKEN_INTEGER,    ///< Liczba całkowita, np. <tt>-123</tt>
+		TOKEN_FLOAT,      ///< Liczba zmiennoprzecinkowa, np. <tt>10.5</tt>
+		TOKEN_CHAR,       ///< Stała znakowa, np. <tt>'A'</tt>
+		TOKEN_IDENTIFIER, ///< Identyfikator, np. <tt>abc_123</tt>
+		TOKEN_KEYWORD,    ///< Słowo kluczowe, czyli identyfikator pasujący do zarejestrowanych słów kluczowych
+		TOKEN_STRING,     ///< Stała łańcuchowa, np. <tt>"ABC"</tt>
+	};
+
+	/// Tworzy z dokumentu podanego przez łańcuch tchar*
+	Tokenizer(const tchar *Input, size_t NumChars, uint Flags);
+	/// Tworzy z dokumentu podanego przez tstring
+	Tokenizer(const tstring *Input, uint Flags);
+	/// Tworzy z dokumentu wczytywanego z dowolnego strumienia
+	Tokenizer(Stream *Input, uint Flags);
+
+	~Tokenizer();
+
+	/** \name Konfiguracja */
+	//@{
+	void RegisterKeyword(uint Id, const tstring &Keyword);
+	/// Wczytuje całą listę słów kluczowych w postaci tablicy łańcuchów tchar*.
+	/** Słowa kluczowe będą miały kolejne identyfikatory 0, 1, 2 itd. */
+	void RegisterKeywords(const tchar **Keywords, size_t KeywordCount);
+	/// Buduje tablicę do szybkiego rozpoznawania zarejestrowanych słów kluczowych.
+	/** Jest to doskonała funkcja mieszająca - sprawdzenie, czy identyfikator jest słowem
+	kluczowym, to jedno policzenie hasha i jedno porównanie, bez kopiowania tokena.
+	Wywoływana automatycznie przez pierwsze Next() po rejestracji słów kluczowych,
+	więc jawne wywołanie pozwala jedynie ponieść ten koszt wcześniej. */
+	void FinalizeKeywords();
+	//@}
+
+	/** \name Funkcje podstawowe
+	Zwracają informacje na temat ostatnio odczytanego tokena. */
+	//@{
+
+	/// Odczytuje następny token
+	void Next();
+
+	/// Zwraca typ tokena
+	TOKEN GetToken();
+
+	size_t GetCharNum();
+	size_t GetRowNum();
+	size_t GetColNum();
+
+	/// Działa zawsze, ale zastosowanie głównie dla GetToken() == common::Tokenizer::TOKEN_IDENTIFIER lub common::Tokenizer::TOKEN_STRING
+	const tstring & GetString();
+	/// Zwraca treść tokena bez kopiowania - wskaźnik i długość w znakach
+	/** Dla dokumentu podanego jako tchar* lub tstring wskazuje zwykle wprost do jego
+	treści, a łańcuch z sekwencjami ucieczki - do wewnętrznego bufora. Nie jest
+	zakończony zerem. Ważny do następnego wywołania Next(). GetString() tworzy
+	tstring dopiero przy pierwszym wywołaniu dla danego tokena. */
+	const tchar * GetStringPtr();
+	size_t GetStringLength();
+	/// Tylko jeśli GetToken() == common::Tokenizer::TOKEN_CHAR lub common::Tokenizer::TOKEN_SYMBOL
+	tchar GetChar();
+	/// Tylko jeśli GetToken() == common::Tokenizer::TOKEN_KEYWORD
+	uint GetId();
+	/// Tylko jeśli GetToken() == common::Tokenizer::TOKEN_INTEGER
+	bool GetUint1(uint8 *Out);
+	bool GetUint2(uint16 *Out);
+	bool GetUint4(uint32 *Out);
+	bool GetUint8(uint64 *Out);
+	bool GetInt1(int8 *Out);
+	bool GetInt2(int16 *Out);
+	bool GetInt4(int32 *Out);
+	bool GetInt8(int64 *Out);
+	uint8 MustGetUint1();
+	uint16 MustGetUint2();
+	uint32 MustGetUint4();
+	uint64 MustGetUint8();
+	int8 MustGetInt1();
+	int16 MustGetInt2();
+	int32 MustGetInt4();
+	int64 MustGetInt8();
+	/** Tylko jeśli GetToken() == common::Tokenizer::TOKEN_INTEGER lub common::Tokenizer::TOKEN_FLOAT */
+	bool GetFloat(float *Out);
+	/** Tylko jeśli GetToken() == common::Tokenizer::TOKEN_INTEGER lub common::Tokenizer::TOKEN_FLOAT */
+	bool GetDouble(double *Out);
+	float MustGetFloat();
+	double MustGetDouble();
+
+	//@}
+
+	/// Rzuca wyjątek z błędem parsowania. Domyślny komunikat.
+	void CreateError();
+	/// Rzuca wyjątek z błędem parsowania. Własny komunikat.
+	void CreateError(const tstring &Msg);
+
+	/** \name Zapytania
+	Zwracają true, jeśli ostatnio sparsowany token jest taki jak tu podany. */
+	//@{
+	bool QueryToken(TOKEN Token);
+	bool QueryToken(TOKEN Token1, TOKEN Token2);
+	bool QueryEOF();
+	bool QueryEOL();
+	bool QuerySymbol(tchar Symbol);
+	bool QueryIdentifier(const tstring &Identifier);
+	bool QueryKeyword(uint KeywordId);
+	bool QueryKeyword(const tstring &Keyword);
+	//@}
+
+	/** \name Asercje
+	Rzucają wyjątek, jeśli ostatnio wczytany token nie spełnia danego warunku. */
+	//@{
+	/// Rzuca wyjątek z błędem parsowania, jeśli ostatnio sparsowany token nie jest podanego rodzaju.
+	void AssertToken(TOKEN Token);
+	/// Rzuca wyjątek z błędem parsowania, jeśli ostatnio sparsowany token nie jest jednego z dwóch podanych rodzajów.
+	void AssertToken(TOKEN Token1, TOKEN Token2);
+	void AssertEOF();
+	void AssertEOL();
+	void AssertSymbol(tchar Symbol);
+	void AssertIdentifier(const tstring &Identifier);
+	void AssertKeyword(uint KeywordId);
+	void AssertKeyword(const tstring &Keyword);
+	//@}
+
+	/// Zamienia typ tokena na jego czytelny dla użytkownika opis tekstowy, np. "Stała znakowa"
+	static const tchar * GetTokenName(TOKEN Token);
+};
+
+class TokenWriter
+{
+public:
+	static const uint ESCAPE_EOL   = 0x01; ///< Zamieniać znaki końca wiersza na <tt>\\r \\n</tt> na sekwencje ucieczki
+	static const uint ESCAPE_OTHER = 0x02; ///< Zamieniać znaki niedostęne z klawiatury (w tym polskie litery) na <tt>\\xHH</tt>
+	/// Escapuje łańcuch zgodnie ze składnią tokenizera
+	/** \param EscapeFlags Używać stałych ESCAPE_EOL, ESCAPE_OTHER. */
+	static void Escape(tstring *Out, const tstring &In, uint EscapeFlags);
+
+	TokenWriter(tstring *outStr);
+	/// Zapis do strumienia idzie przez wewnętrzny bufor.
+	/** Przed użyciem strumienia w czasie życia obiektu trzeba wywołać Flush. Destruktor wywołuje Flush sam. */
+	TokenWriter(common::Stream *outStream);
+	~TokenWriter();
+
+	/// Zapisuje zawartość bufora do strumienia
+	void Flush();
+
+	//====== Configuration
+	const tstring & GetEOL() { return m_EOL; }
+	const tstring & GetIndent() { return m_Indent; }
+	void SetEOL(const tstring &s) { m_EOL = s; }
+	void SetIndent(const tstring &s) { m_Indent = s; }
+	uint GetEscapeFlags() { return m_EscapeFlags; }
+	void SetEscapeFlags(uint v) { m_EscapeFlags = v; }
+	void RegisterSymbol(tchar ch, bool spaceBefore, bool spaceAfter, int levelDelta);
+	void RegisterSymbol(const tstring &s, bool spaceBefore, bool spaceAfter, int levelDelta);
+	void RegisterKeyword(const tstring &s, int levelDelta);
+	
+	uint GetLevel() { return m_Level; }
+
+	void WriteSpace(tchar ch = _T(' '));
+	void WriteSpace(const tstring &s);
+	void WriteEOL();
+
+	void WriteKeyword(const tstring &s);
+	void WriteIdentifier(const tstring &s);
+	void WriteSymbol(tchar ch);
+	void WriteSymbol(const tstring &s);
+	void WriteString(const tstring &s) { WriteString(s.data(), s.length()); }
+	void WriteString(const tchar *s, size_t length);
+	void WriteUint1(uint8 v, bool hex = false);
+	void WriteUint2(uint16 v, bool hex = false);
+	void WriteUint4(uint32 v, bool hex = false);
+	void WriteUint8(uint64 v, bool hex = false);
+	void WriteInt1(int8 v);
+	void WriteInt2(int16 v);
+	void WriteInt4(int32 v);
+	void WriteInt8(int64 v);
+	/// Mode i Precision jak w DoubleToStr. Domyślnie najkrótsza postać, która wczytana da dokładnie tę samą liczbę.
+	void WriteFloat(float v, char Mode = 'r', int Precision = 6);
+	void WriteDouble(double v, char Mode = 'r', int Precision = 6);
+	void WriteNumberString(const tstring &v);
+	void WriteNumberString(const tchar *v);
+	void WriteComment(const tstring &s, bool alwaysMultiline = false);
+
+private:
+	/// Rozmiar bufora dla zapisu do strumienia, w znakach
+	static const size_t BUFFER_SIZE = 4096;
+
+	tstring *m_OutString;
+	common::Stream *m_OutStream;
+	tchar m_Buf[BUFFER_SIZE];
+	size_t m_BufLength;
+
+	tstring m_EOL, m_Indent;
+	uint m_EscapeFlags;
+	tstring m_Symbols_Chars_SpaceBefore, m_Symbols_Chars_SpaceAfter;
+	tstring m_Symbols_Chars_LevelInc, m_Symbols_Chars_LevelDec;
+	STRING_VECTOR m_Symbols_Strings_SpaceBefore, m_Symbols_Strings_SpaceAfter;
+	STRING_VECTOR m_Symbols_Strings_LevelInc, m_Symbols_Strings_LevelDec;
+	STRING_VECTOR m_Keywords_LevelInc, m_Keywords_LevelDec;
+
+	uint m_Level;
+	bool m_WasEOL;
+	bool m_SpaceRequired;
+
+	void Ctor();
+	void WriteIndent(uint level);
+	void LevelInc() { m_Level++; }
+	void LevelDec() { assert(m_Level > 0); m_Level--; }
+	void WriteRaw(tchar ch)
+	{
+		if (m_OutString)
+			*m_OutString += ch;
+		else
+		{
+			if (m_BufLength == BUFFER_SIZE)
+				Flush();
+			m_Buf[m_BufLength++] = ch;
+		}
+	}
+	void WriteRaw(const tchar *s, size_t length);
+	void WriteRaw(const tchar *s) { WriteRaw(s, common_strlen(s)); }
+	void WriteRaw(const tstring &s) { WriteRaw(s.data(), s.length()); }
+	/// Zapisuje łańcuch od razu z sekwencjami ucieczki, bez łańcucha pośredniego
+	void WriteEscaped(const tchar *s, size_t length);
+	int GetKeywordLevelDelta(const tstring &s);
+	int GetSymbolLevelDelta(tchar ch);
+	int GetSymbolLevelDelta(const tstring &s);
+	bool IsSymbolSpaceBefore(tchar ch);
+	bool IsSymbolSpaceBefore(const tstring &s);
+	bool IsSymbolSpaceAfter(tchar ch);
+	bool IsSymbolSpaceAfter(const tstring &s);
+	void WriteMultiLineComment(const tstring &s);
+	void WriteSingleLineComment(const tstring &s);
+};
+
+//@}
+// code_tokenizer
+
+} // namespace common
+
+#endif
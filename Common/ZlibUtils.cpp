@@ -1,614 +1,2923 @@
-/** \file
-\brief Auxiliary module for zlib library
-\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
-
-Part of CommonLib library. \n
-Encoding UTF-8, end of line CR+LF \n
-License: GNU LGPL. \n
-Documentation: \ref Module_ZlibUtils\n
-Module components: \ref code_zlibutils
-*/
-#include "Base.hpp"
-extern "C" {
-	#include <errno.h>
-	#include <zlib.h>
-	#include <string.h> // dla strnlen
-}
-#include "DateTime.hpp"
-#include "ZlibUtils.hpp"
-
-
-namespace common
-{
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-// Klasa ZlibCompressionStreamError
-
-ZlibError::ZlibError(int Code, const tstring &Msg, const tstring &File, int Line)
-{
-	if (Code == Z_ERRNO)
-	{
-	#ifdef _WIN32
-		#ifdef _MSC_VER
-			tchar buf[256];
-			_tcserror_s(buf, _countof(buf), errno);
-			Push(_T("(zlib(errno),") + IntToStrR(errno) + _T(") ") + buf);
-		#else
-			Push(_T("(zlib(errno),") + IntToStrR(errno) + _T(") ") + _tcserror(errno));
-		#endif
-	#else
-		Push(_T("(zlib(errno),") + IntToStrR(errno) + _T(") ") + strerror(errno));
-	#endif
-	}
-	else
-		Push(Format(_T("(zlib,#) #")) % Code % StringToTstringR(zError(Code)));
-
-	Push(Msg, File, Line);
-}
-
-
-const int ZLIB_DEFAULT_LEVEL = Z_DEFAULT_COMPRESSION;
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-// Klasa ZlibCompressionStream_pimpl
-
-class ZlibCompressionStream_pimpl
-{
-private:
-	Stream *m_Stream;
-	z_stream m_ZStream;
-	std::vector<char> m_OutBuf;
-	// Tu jest tutaj, bo cho tego panowie szanowni autorzy zliba dziady pi*** nie udokumentowali,
-	// to header podany w deflateSetHeader musi istnie przy wywoaniu deflate, bo dopiero wtedy nagwek
-	// si zapisuje, a deflateSetHeader tylko zachowuje sobie w state wskanik do niego!!!
-	gz_header m_Header;
-	std::vector<char> m_Header_FileName;
-	std::vector<char> m_Header_Comment;
-
-public:
-	// Wersja ZlibError
-	ZlibCompressionStream_pimpl(Stream *a_Stream, int Level, int WindowBits = 15);
-	// Wersja Gzip
-	ZlibCompressionStream_pimpl(Stream *a_Stream, const string *FileName, const string *Comment, int Level, int WindowBits = 15);
-	~ZlibCompressionStream_pimpl();
-
-	void Write(const void *Data, size_t Size);
-	void Flush();
-};
-
-ZlibCompressionStream_pimpl::ZlibCompressionStream_pimpl(Stream *a_Stream, int Level, int WindowBits) :
-	m_Stream(a_Stream)
-{
-	m_OutBuf.resize(BUFFER_SIZE);
-
-	m_ZStream.zalloc = Z_NULL;
-	m_ZStream.zfree = Z_NULL;
-	m_ZStream.opaque = Z_NULL;
-
-	int R = deflateInit2(&m_ZStream, Level, Z_DEFLATED, WindowBits, 8, Z_DEFAULT_STRATEGY);
-	if (R != Z_OK)
-		throw ZlibError(R, _T("Cannot initialize zlib compression."), __TFILE__, __LINE__);
-}
-
-ZlibCompressionStream_pimpl::ZlibCompressionStream_pimpl(Stream *a_Stream, const string *FileName, const string *Comment, int Level, int WindowBits) :
-	m_Stream(a_Stream)
-{
-	m_OutBuf.resize(BUFFER_SIZE);
-
-	m_ZStream.zalloc = Z_NULL;
-	m_ZStream.zfree = Z_NULL;
-	m_ZStream.opaque = Z_NULL;
-
-	int R = deflateInit2(&m_ZStream, Level, Z_DEFLATED, WindowBits + 16, 8, Z_DEFAULT_STRATEGY);
-	if (R != Z_OK)
-		throw ZlibError(R, _T("Cannot initialize gzip compression."), __TFILE__, __LINE__);
-
-	// Nagwek gzip
-	common_memzero(&m_Header, sizeof(m_Header));
-	m_Header.time = (uLong)Now().GetTicks();
-#ifdef _WIN32
-	m_Header.os = 0;
-#else
-	m_Header.os = 3;
-#endif
-	m_Header.extra = Z_NULL;
-	if (FileName != NULL && !FileName->empty())
-	{
-		m_Header_FileName.resize(FileName->length()+1);
-		std::copy(FileName->begin(), FileName->end(), m_Header_FileName.begin());
-		m_Header_FileName[FileName->length()] = '\0';
-		m_Header.name = (Bytef*)&m_Header_FileName[0];
-	}
-	else
-		m_Header.name = Z_NULL;
-	if (Comment != NULL && !Comment->empty())
-	{
-		m_Header_Comment.resize(Comment->length()+1);
-		std::copy(Comment->begin(), Comment->end(), m_Header_Comment.begin());
-		m_Header_Comment[Comment->length()] = '\0';
-		m_Header.comment = (Bytef*)&m_Header_Comment[0];
-	}
-	else
-		m_Header.comment = Z_NULL;
-
-	R = deflateSetHeader(&m_ZStream, &m_Header);
-	if (R != Z_OK)
-		throw ZlibError(R, _T("Nie mona ustawi nagwka gzip"), __TFILE__, __LINE__);
-}
-
-ZlibCompressionStream_pimpl::~ZlibCompressionStream_pimpl()
-{
-	try
-	{
-		char Foo = '\0';
-		m_ZStream.next_in = (Bytef*)&Foo;
-		m_ZStream.avail_in = 0;
-
-		int R;
-		do
-		{
-			m_ZStream.next_out = (Bytef*)&m_OutBuf[0];
-			m_ZStream.avail_out = (uInt)BUFFER_SIZE;
-
-			R = deflate(&m_ZStream, Z_FINISH);
-
-			if (m_ZStream.avail_out < (uInt)BUFFER_SIZE)
-				m_Stream->Write(&m_OutBuf[0], (uInt)BUFFER_SIZE - m_ZStream.avail_out);
-		}
-		while (R != Z_STREAM_END);
-
-		deflateEnd(&m_ZStream);
-	}
-	catch (...)
-	{
-		assert(0 && "ZlibCompressionStream.dtor - exception.");
-	}
-}
-
-void ZlibCompressionStream_pimpl::Write(const void *Data, size_t Size)
-{
-	if (Size == 0) return;
-    assert(Size <= UINT_MAX);
-
-	m_ZStream.next_in = (Bytef*)Data;
-	m_ZStream.avail_in = (uInt)Size;
-
-	do
-	{
-		m_ZStream.next_out = (Bytef*)&m_OutBuf[0];
-		m_ZStream.avail_out = (uInt)BUFFER_SIZE;
-
-		deflate(&m_ZStream, Z_NO_FLUSH); // Nie sprawdzamy bdu, bo podobno nie trzeba a nawet nie naley, bo zdarza si Z_BUF_ERROR.
-
-		if (m_ZStream.avail_out < (uInt)BUFFER_SIZE)
-			m_Stream->Write(&m_OutBuf[0], (uInt)BUFFER_SIZE - m_ZStream.avail_out);
-	}
-	while (m_ZStream.avail_out == 0); // Tak, dziwne, ale wanie taki warunek + ten assert jest w przykadzie w zlib.
-	assert(m_ZStream.avail_in == 0);
-}
-
-void ZlibCompressionStream_pimpl::Flush()
-{
-	char Foo = '\0';
-	m_ZStream.next_in = (Bytef*)&Foo;
-	m_ZStream.avail_in = 0;
-
-	do
-	{
-		m_ZStream.next_out = (Bytef*)&m_OutBuf[0];
-		m_ZStream.avail_out = (uInt)BUFFER_SIZE;
-
-		deflate(&m_ZStream, Z_SYNC_FLUSH);
-
-		if (m_ZStream.avail_out < (uInt)BUFFER_SIZE)
-			m_Stream->Write(&m_OutBuf[0], (uInt)BUFFER_SIZE - m_ZStream.avail_out);
-	}
-	while (m_ZStream.avail_out == 0);
-}
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-// Klasa ZlibCompressionStream
-
-ZlibCompressionStream::ZlibCompressionStream(Stream *a_Stream, int Level, int WindowBits) :
-	OverlayStream(a_Stream),
-	pimpl(new ZlibCompressionStream_pimpl(a_Stream, Level, WindowBits))
-{
-}
-
-ZlibCompressionStream::~ZlibCompressionStream()
-{
-	pimpl.reset();
-}
-
-void ZlibCompressionStream::Write(const void *Data, size_t Size)
-{
-	pimpl->Write(Data, Size);
-}
-
-void ZlibCompressionStream::Flush()
-{
-	pimpl->Flush();
-}
-
-size_t ZlibCompressionStream::CompressLength(size_t DataLength)
-{
-    assert(DataLength <= ULONG_MAX);
-	return compressBound((uLong)DataLength);
-}
-
-size_t ZlibCompressionStream::Compress(void *OutData, size_t BufLength, const void *Data, size_t DataLength, int Level)
-{
-    assert(BufLength <= ULONG_MAX && DataLength <= ULONG_MAX);
-	uLongf DestLen = (uLongf)BufLength;
-	int R = compress2((Bytef*)OutData, &DestLen, (const Bytef*)Data, (uLong)DataLength, Level);
-	if (R != Z_OK)
-		throw ZlibError(R, _T("Cannot compress data with zlib."), __TFILE__, __LINE__);
-	return DestLen;
-}
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-// Klasa GzipCompressionStream
-
-GzipCompressionStream::GzipCompressionStream(Stream *a_Stream, const string *FileName, const string *Comment, int Level, int WindowBits) :
-	OverlayStream(a_Stream),
-	pimpl(new ZlibCompressionStream_pimpl(a_Stream, FileName, Comment, Level, WindowBits))
-{
-}
-
-GzipCompressionStream::~GzipCompressionStream()
-{
-	pimpl.reset();
-}
-
-void GzipCompressionStream::Write(const void *Data, size_t Size)
-{
-	pimpl->Write(Data, Size);
-}
-
-void GzipCompressionStream::Flush()
-{
-	pimpl->Flush();
-}
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-// Klasa ZlibDecompressionStream_pimpl
-
-class ZlibDecompressionStream_pimpl
-{
-private:
-	Stream *m_Stream;
-	z_stream m_ZStream;
-	std::vector<char> m_InBuf;
-	size_t m_InBufLen;
-	bool m_OutEnd;
-	gz_header m_Header;
-	std::vector<char> m_Header_FileName;
-	std::vector<char> m_Header_Comment;
-
-	void EnsureBuf(Stream *a_Stream);
-
-public:
-	// Wersja zlib
-	ZlibDecompressionStream_pimpl(Stream *a_Stream, bool Gzip, int WindowBits = 15);
-	// Wersja gzip
-	~ZlibDecompressionStream_pimpl();
-
-	size_t Read(void *Out, size_t MaxLength);
-	bool End();
-
-	bool GetHeaderFileName(string *OutFileName);
-	bool GetHeaderComment(string *OutComment);
-};
-
-void ZlibDecompressionStream_pimpl::EnsureBuf(Stream *a_Stream)
-{
-	// Nie pamitam skd to si wzio, ale natknem si na bd e ta asercja zwracaa false,
-	// a jej zakomentowanie sprawio e wszystko dziaa dobrze.
-//	assert(m_InBufLen == 0);
-	m_InBufLen = a_Stream->Read(&m_InBuf[0], BUFFER_SIZE);
-}
-
-ZlibDecompressionStream_pimpl::ZlibDecompressionStream_pimpl(Stream *a_Stream, bool Gzip, int WindowBits) :
-	m_Stream(a_Stream)
-{
-	m_InBuf.resize(BUFFER_SIZE);
-	m_InBufLen = 0;
-
-	m_ZStream.zalloc = Z_NULL;
-	m_ZStream.zfree = Z_NULL;
-	m_ZStream.opaque = Z_NULL;
-
-	EnsureBuf(m_Stream);
-	m_ZStream.next_in = (Bytef*)&m_InBuf[0];
-	m_ZStream.avail_in = (uInt)m_InBufLen;
-
-	// Tak te moe by
-	//m_ZStream.next_in = 0;
-	//m_ZStream.avail_in = Z_NULL;
-
-	if (Gzip)
-	{
-		int R = inflateInit2(&m_ZStream, WindowBits + 16);
-		if (R != Z_OK)
-			throw ZlibError(R, _T("Cannot initialize gzip decompression."), __TFILE__, __LINE__);
-
-		// Odczytanie nagwka
-		m_Header_FileName.resize(256);
-		m_Header_Comment.resize(256);
-		m_Header.extra = Z_NULL;
-		m_Header.extra_len = 0;
-		m_Header.name = (Bytef*)&m_Header_FileName[0];
-		m_Header.name_max = 256;
-		m_Header.comment = (Bytef*)&m_Header_Comment[0];
-		m_Header.comm_max = 256;
-		R = inflateGetHeader(&m_ZStream, &m_Header);
-		if (R != Z_OK)
-			throw ZlibError(R, _T("zlib.inflateGetHeader"), __TFILE__, __LINE__);
-	}
-	else
-	{
-		int R = inflateInit2(&m_ZStream, WindowBits);
-		if (R != Z_OK)
-			throw ZlibError(R, _T("Cannot initialize zlib decompression."), __TFILE__, __LINE__);
-	}
-
-	char Foo = '\0';
-	m_ZStream.next_out = (Bytef*)&Foo;
-	m_ZStream.avail_out = 0;
-	
-	int R = inflate(&m_ZStream, Z_NO_FLUSH);
-	m_OutEnd = (R == Z_STREAM_END);
-	// Tego jednak nie, bo tutaj jeli nie Z_STREAM_END, to zwraca Z_BUF_ERROR, bo mamy avail_in=0 i avail_out=0
-//	if (R != Z_OK && R != Z_STREAM_END)
-//		throw ZlibError(R, _T("Cannot start zlib decompression."), __TFILE__, __LINE__);
-}
-
-ZlibDecompressionStream_pimpl::~ZlibDecompressionStream_pimpl()
-{
-	inflateEnd(&m_ZStream);
-}
-
-size_t ZlibDecompressionStream_pimpl::Read(void *Out, size_t MaxLength)
-{
-	if (m_OutEnd == true || MaxLength == 0)
-		return 0;
-
-    assert(MaxLength <= UINT_MAX);
-
-	// avail_out wskazuje na liczb pozostaych bajtw do odczytania w tym wywoaniu Read.
-	//   Wic (MaxLength - avail_out) to liczba zwrconych przez zlib bajtw w tym wywoaniu Read.
-	// avail_in to liczba niepobranych jeszcze przez zlib danych z bufora InBuf.
-	//   Wic (InBufLen - avail_in) to liczba przetworznych ju przez zlib bajtw danego bufora InBuf.
-
-	// Miejsce do pisania
-	m_ZStream.avail_out = (uInt)MaxLength;
-	m_ZStream.next_out = (Bytef*)Out;
-
-	for (;;)
-	{
-		// Przeczytane ju pene MaxLength bajtw
-		if (m_ZStream.avail_out == 0)
-			return MaxLength;
-
-		// Zapewnij dane do czytania
-		if (m_ZStream.avail_in == 0)
-		{
-			EnsureBuf(m_Stream);
-			// Koniec danych wejciowych, a wci nie koniec strumienia zlib - niewtpliwy bd, niedokoczone dane
-			if (m_InBufLen == 0)
-				throw Error(_T("Zlib decompression stream error: Unfinished data."), __TFILE__, __LINE__);
-			m_ZStream.next_in = (Bytef*)&m_InBuf[0];
-			m_ZStream.avail_in = (uInt)m_InBufLen;
-		}
-
-		int R = inflate(&m_ZStream, Z_NO_FLUSH);
-
-		// ZlibError wykry koniec strumienia
-		if (R == Z_STREAM_END)
-		{
-			m_OutEnd = true;
-			return MaxLength - m_ZStream.avail_out;
-		}
-		// Bd
-		else if (R != Z_OK)
-			throw ZlibError(R, _T("Zlib compression stream error."), __TFILE__, __LINE__);
-	}
-}
-
-bool ZlibDecompressionStream_pimpl::End()
-{
-	return m_OutEnd;
-}
-
-bool ZlibDecompressionStream_pimpl::GetHeaderFileName(string *OutFileName)
-{
-	if (m_Header.done != 1) return false;
-	if (m_Header.name == Z_NULL) return false;
-
-	OutFileName->assign(&m_Header_FileName[0], strnlen(&m_Header_FileName[0], 256));
-	return true;
-}
-
-bool ZlibDecompressionStream_pimpl::GetHeaderComment(string *OutComment)
-{
-	if (m_Header.done != 1) return false;
-	if (m_Header.comment == Z_NULL) return false;
-
-	OutComment->assign(&m_Header_Comment[0], strnlen(&m_Header_Comment[0], 256));
-	return true;
-}
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-// Klasa ZlibDecompressionStream
-
-ZlibDecompressionStream::ZlibDecompressionStream(Stream *a_Stream, int WindowBits) :
-	OverlayStream(a_Stream),
-	pimpl(new ZlibDecompressionStream_pimpl(a_Stream, false, WindowBits))
-{
-}
-
-ZlibDecompressionStream::~ZlibDecompressionStream()
-{
-	pimpl.reset();
-}
-
-size_t ZlibDecompressionStream::Read(void *Out, size_t MaxLength)
-{
-	return pimpl->Read(Out, MaxLength);
-}
-
-bool ZlibDecompressionStream::End()
-{
-	return pimpl->End();
-}
-
-size_t ZlibDecompressionStream::Decompress(void *OutData, size_t BufLength, const void *Data, size_t DataLength)
-{
-    assert(BufLength <= ULONG_MAX && DataLength <= ULONG_MAX);
-	uLongf DestLen = (uLongf)BufLength;
-	int R = uncompress((Bytef*)OutData, &DestLen, (Bytef*)Data, (uLong)DataLength);
-	if (R != Z_OK)
-		throw ZlibError(R, _T("Cannot decompress data with zlib."), __TFILE__, __LINE__);
-	return DestLen;
-}
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-// Klasa GzipDecompressionStream
-
-GzipDecompressionStream::GzipDecompressionStream(Stream *a_Stream, int WindowBits) :
-	OverlayStream(a_Stream),
-	pimpl(new ZlibDecompressionStream_pimpl(a_Stream, true, WindowBits))
-{
-}
-
-GzipDecompressionStream::~GzipDecompressionStream()
-{
-	pimpl.reset();
-}
-
-size_t GzipDecompressionStream::Read(void *Out, size_t MaxLength)
-{
-	return pimpl->Read(Out, MaxLength);
-}
-
-bool GzipDecompressionStream::End()
-{
-	return pimpl->End();
-}
-
-bool GzipDecompressionStream::GetHeaderFileName(string *OutFileName)
-{
-	return pimpl->GetHeaderFileName(OutFileName);
-}
-
-bool GzipDecompressionStream::GetHeaderComment(string *OutComment)
-{
-	return pimpl->GetHeaderComment(OutComment);
-}
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-// Klasa GzipFileStream
-
-class GzipFileStream_pimpl
-{
-public:
-	gzFile File;
-	char OneCharBuf;
-	bool m_End;
-};
-
-GzipFileStream::GzipFileStream(const string &FileName, GZIP_FILE_MODE Mode, int Level) :
-	pimpl(new GzipFileStream_pimpl)
-{
-	char ModeSz[4];
-	ModeSz[0] = (Mode == GZFM_WRITE ? 'w' : 'r');
-	ModeSz[1] = 'b';
-	if (Level == Z_DEFAULT_COMPRESSION)
-		ModeSz[2] = '\0';
-	else
-	{
-		ModeSz[2] = (char)(Level + '0');
-		ModeSz[3] = '\0';
-	}
-
-	pimpl->File = gzopen(FileName.c_str(), ModeSz);
-
-	if (pimpl->File == NULL)
-	{
-		if (errno == 0)
-			throw ZlibError(Z_MEM_ERROR, _T("Cannot open gzip file: ") + StringToTstringR(FileName), __TFILE__, __LINE__);
-		else
-			throw ErrnoError(_T("Cannot open gzip file: ") + StringToTstringR(FileName), __TFILE__, __LINE__);
-	}
-
-	if (Mode == GZFM_READ)
-	{
-		int R = gzread(pimpl->File, &pimpl->OneCharBuf, 1);
-		if (R == -1)
-			throw Error(_T("Cannot read first byte from gzip file"), __TFILE__, __LINE__);
-		pimpl->m_End = (R == 0);
-	}
-}
-
-GzipFileStream::~GzipFileStream()
-{
-	gzclose(pimpl->File);
-}
-
-void GzipFileStream::Write(const void *Data, size_t Size)
-{
-    assert(Size <= UINT_MAX);
-	size_t Written = (size_t)gzwrite(pimpl->File, Data, (unsigned int)Size);
-	if (Written != Size)
-		throw Error(Format(_T("Cannot write to gzip file - #/# bytes written.")) % Written % Size, __TFILE__, __LINE__);
-}
-
-void GzipFileStream::Flush()
-{
-	int R = gzflush(pimpl->File, Z_SYNC_FLUSH);
-	if (R != Z_OK)
-		throw ZlibError(R, _T("zlib.GzipFileStream.Flush"), __TFILE__, __LINE__);
-}
-
-size_t GzipFileStream::Read(void *Out, size_t MaxLength)
-{
-	if (pimpl->m_End) return 0;
-	if (MaxLength == 0) return 0;
-
-	char *Out2 = (char*)Out;
-	*Out2 = pimpl->OneCharBuf;
-	MaxLength--;
-	Out2++;
-
-    assert(MaxLength <= UINT_MAX);
-
-	int BytesRead = gzread(pimpl->File, Out2, (unsigned int)MaxLength);
-
-	if (BytesRead == -1)
-		throw Error(Format(_T("Cannot read # bytes from gzip file.")) % (MaxLength+1), __TFILE__, __LINE__);
-	else if ((size_t)BytesRead < MaxLength)
-		pimpl->m_End = 0;
-	else
-	{
-		int R = gzread(pimpl->File, &pimpl->OneCharBuf, 1);
-		if (R == -1)
-			throw Error(_T("Cannot read byte from gzip file."), __TFILE__, __LINE__);
-		pimpl->m_End = (R == 0);
-	}
-
-	return (size_t)BytesRead + 1;
-}
-
-bool GzipFileStream::End()
-{
-	return pimpl->m_End;
-}
-
-} // namespace common
+/** \file
+\brief Auxiliary module for zlib library
+\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
+
+Part of CommonLib library. \n
+Encoding UTF-8, end of line CR+LF \n
+License: GNU LGPL. \n
+Documentation: \ref Module_ZlibUtils\n
+Module components: \ref code_zlibutils
+*/
+#include "Base.hpp"
+extern "C" {
+	#include <errno.h>
+	#include <zlib.h>
+	#include <string.h> // dla strnlen
+}
+#include <deque>
+#include "DateTime.hpp"
+#include "Threads.hpp"
+#include "ZlibUtils.hpp"
+
+
+namespace common
+{
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Klasa ZlibCompressionStreamError
+
+ZlibError::ZlibError(int Code, const tstring &Msg, const tstring &File, int Line)
+{
+	if (Code == Z_ERRNO)
+	{
+	#ifdef _WIN32
+		#ifdef _MSC_VER
+			tchar buf[256];
+			_tcserror_s(buf, _countof(buf), errno);
+			Push(_T("(zlib(errno),") + IntToStrR(errno) + _T(") ") + buf);
+		#else
+			Push(_T("(zlib(errno),") + IntToStrR(errno) + _T(") ") + _tcserror(errno));
+		#endif
+	#else
+		Push(_T("(zlib(errno),") + IntToStrR(errno) + _T(") ") + strerror(errno));
+	#endif
+	}
+	else
+		Push(Format(_T("(zlib,#) #")) % Code % StringToTstringR(zError(Code)));
+
+	Push(Msg, File, Line);
+}
+
+
+const int ZLIB_DEFAULT_LEVEL = Z_DEFAULT_COMPRESSION;
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Klasa ZlibCompressionStream_pimpl
+
+class ZlibCompressionStream_pimpl
+{
+private:
+	Stream *m_Stream;
+	z_stream m_ZStream;
+	std::vector<char> m_OutBuf;
+	// Tu jest tutaj, bo choć tego panowie szanowni autorzy zliba dziady pi*** nie udokumentowali,
+	// to header podany w deflateSetHeader musi istnieć przy wywołaniu deflate, bo dopiero wtedy nagłówek
+	// się zapisuje, a deflateSetHeader tylko zachowuje sobie w state wskaźnik do niego!!!
+	gz_header m_Header;
+	std::vector<char> m_Header_FileName;
+	std::vector<char> m_Header_Comment;
+
+public:
+	// Wersja ZlibError
+	ZlibCompressionStream_pimpl(Stream *a_Stream, int Level, int WindowBits = 15);
+	// Wersja Gzip
+	ZlibCompressionStream_pimpl(Stream *a_Stream, const string *FileName, const string *Comment, int Level, int WindowBits = 15);
+	~ZlibCompressionStream_pimpl();
+
+	void Write(const void *Data, size_t Size);
+	void Flush();
+};
+
+ZlibCompressionStream_pimpl::ZlibCompressionStream_pimpl(Stream *a_Stream, int Level, int WindowBits) :
+	m_Stream(a_Stream)
+{
+	m_OutBuf.resize(BUFFER_SIZE);
+
+	m_ZStream.zalloc = Z_NULL;
+	m_ZStream.zfree = Z_NULL;
+	m_ZStream.opaque = Z_NULL;
+
+	int R = deflateInit2(&m_ZStream, Level, Z_DEFLATED, WindowBits, 8, Z_DEFAULT_STRATEGY);
+	if (R != Z_OK)
+		throw ZlibError(R, _T("Cannot initialize zlib compression."), __TFILE__, __LINE__);
+}
+
+ZlibCompressionStream_pimpl::ZlibCompressionStream_pimpl(Stream *a_Stream, const string *FileName, const string *Comment, int Level, int WindowBits) :
+	m_Stream(a_Stream)
+{
+	m_OutBuf.resize(BUFFER_SIZE);
+
+	m_ZStream.zalloc = Z_NULL;
+	m_ZStream.zfree = Z_NULL;
+	m_ZStream.opaque = Z_NULL;
+
+	int R = deflateInit2(&m_ZStream, Level, Z_DEFLATED, WindowBits + 16, 8, Z_DEFAULT_STRATEGY);
+	if (R != Z_OK)
+		throw ZlibError(R, _T("Cannot initialize gzip compression."), __TFILE__, __LINE__);
+
+	// Nagłówek gzip
+	common_memzero(&m_Header, sizeof(m_Header));
+	m_Header.time = (uLong)Now().GetTicks();
+#ifdef _WIN32
+	m_Header.os = 0;
+#else
+	m_Header.os = 3;
+#endif
+	m_Header.extra = Z_NULL;
+	if (FileName != NULL && !FileName->empty())
+	{
+		m_Header_FileName.resize(FileName->length()+1);
+		std::copy(FileName->begin(), FileName->end(), m_Header_FileName.begin());
+		m_Header_FileName[FileName->length()] = '\0';
+		m_Header.name = (Bytef*)&m_Header_FileName[0];
+	}
+	else
+		m_Header.name = Z_NULL;
+	if (Comment != NULL && !Comment->empty())
+	{
+		m_Header_Comment.resize(Comment->length()+1);
+		std::copy(Comment->begin(), Comment->end(), m_Header_Comment.begin());
+		m_Header_Comment[Comment->length()] = '\0';
+		m_Header.comment = (Bytef*)&m_Header_Comment[0];
+	}
+	else
+		m_Header.comment = Z_NULL;
+
+	R = deflateSetHeader(&m_ZStream, &m_Header);
+	if (R != Z_OK)
+		throw ZlibError(R, _T("Nie można ustawić nagłówka gzip"), __TFILE__, __LINE__);
+}
+
+ZlibCompressionStream_pimpl::~ZlibCompressionStream_pimpl()
+{
+	try
+	{
+		char Foo = '\0';
+		m_ZStream.next_in = (Bytef*)&Foo;
+		m_ZStream.avail_in = 0;
+
+		int R;
+		do
+		{
+			m_ZStream.next_out = (Bytef*)&m_OutBuf[0];
+			m_ZStream.avail_out = (uInt)BUFFER_SIZE;
+
+			R = deflate(&m_ZStream, Z_FINISH);
+
+			if (m_ZStream.avail_out < (uInt)BUFFER_SIZE)
+				m_Stream->Write(&m_OutBuf[0], (uInt)BUFFER_SIZE - m_ZStream.avail_out);
+		}
+		while (R != Z_STREAM_END);
+
+		deflateEnd(&m_ZStream);
+	}
+	catch (...)
+	{
+		assert(0 && "ZlibCompressionStream.dtor - exception.");
+	}
+}
+
+void ZlibCompressionStream_pimpl::Write(const void *Data, size_t Size)
+{
+	if (Size == 0) return;
+    assert(Size <= UINT_MAX);
+
+	m_ZStream.next_in = (Bytef*)Data;
+	m_ZStream.avail_in = (uInt)Size;
+
+	do
+	{
+		m_ZStream.next_out = (Bytef*)&m_OutBuf[0];
+		m_ZStream.avail_out = (uInt)BUFFER_SIZE;
+
+		deflate(&m_ZStream, Z_NO_FLUSH); // Nie sprawdzamy błędu, bo podobno nie trzeba a nawet nie należy, bo zdarza się Z_BUF_ERROR.
+
+		if (m_ZStream.avail_out < (uInt)BUFFER_SIZE)
+			m_Stream->Write(&m_OutBuf[0], (uInt)BUFFER_SIZE - m_ZStream.avail_out);
+	}
+	while (m_ZStream.avail_out == 0); // Tak, dziwne, ale właśnie taki warunek + ten assert jest w przykładzie w zlib.
+	assert(m_ZStream.avail_in == 0);
+}
+
+void ZlibCompressionStream_pimpl::Flush()
+{
+	char Foo = '\0';
+	m_ZStream.next_in = (Bytef*)&Foo;
+	m_ZStream.avail_in = 0;
+
+	do
+	{
+		m_ZStream.next_out = (Bytef*)&m_OutBuf[0];
+		m_ZStream.avail_out = (uInt)BUFFER_SIZE;
+
+		deflate(&m_ZStream, Z_SYNC_FLUSH);
+
+		if (m_ZStream.avail_out < (uInt)BUFFER_SIZE)
+			m_Stream->Write(&m_OutBuf[0], (uInt)BUFFER_SIZE - m_ZStream.avail_out);
+	}
+	while (m_ZStream.avail_out == 0);
+}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Klasa ZlibCompressionStream
+
+ZlibCompressionStream::ZlibCompressionStream(Stream *a_Stream, int Level, int WindowBits) :
+	OverlayStream(a_Stream),
+	pimpl(new ZlibCompressionStream_pimpl(a_Stream, Level, WindowBits))
+{
+}
+
+ZlibCompressionStream::~ZlibCompressionStream()
+{
+	pimpl.reset();
+}
+
+void ZlibCompressionStream::Write(const void *Data, size_t Size)
+{
+	pimpl->Write(Data, Size);
+}
+
+void ZlibCompressionStream::Flush()
+{
+	pimpl->Flush();
+}
+
+size_t ZlibCompressionStream::CompressLength(size_t DataLength)
+{
+    assert(DataLength <= ULONG_MAX);
+	return compressBound((uLong)DataLength);
+}
+
+size_t ZlibCompressionStream::Compress(void *OutData, size_t BufLength, const void *Data, size_t DataLength, int Level)
+{
+    assert(BufLength <= ULONG_MAX && DataLength <= ULONG_MAX);
+	uLongf DestLen = (uLongf)BufLength;
+	int R = compress2((Bytef*)OutData, &DestLen, (const Bytef*)Data, (uLong)DataLength, Level);
+	if (R != Z_OK)
+		throw ZlibError(R, _T("Cannot compress data with zlib."), __TFILE__, __LINE__);
+	return DestLen;
+}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Klasa GzipCompressionStream
+
+GzipCompressionStream::GzipCompressionStream(Stream *a_Stream, const string *FileName, const string *Comment, int Level, int WindowBits) :
+	OverlayStream(a_Stream),
+	pimpl(new ZlibCompressionStream_pimpl(a_Stream, FileName, Comment, Level, WindowBits))
+{
+}
+
+GzipCompressionStream::~GzipCompressionStream()
+{
+	pimpl.reset();
+}
+
+void GzipCompressionStream::Write(const void *Data, size_t Size)
+{
+	pimpl->Write(Data, Size);
+}
+
+void GzipCompressionStream::Flush()
+{
+	pimpl->Flush();
+}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Klasa ParallelGzipCompressionStream
+
+static const size_t DEFLATE_WINDOW_SIZE = 32 * 1024;
+
+// Compresses one block into raw deflate data. Each task slot keeps its z_stream for the whole time.
+class GzipBlockTask : public ThreadTask
+{
+public:
+	z_stream m_ZStream;
+	bool m_ZStreamInitialized;
+	int m_Level;
+	std::vector<char> m_In;
+	size_t m_InSize;
+	// Last bytes of previous block, NULL for the first one
+	const char *m_Dict;
+	size_t m_DictSize;
+	// Z_FINISH instead of Z_SYNC_FLUSH
+	bool m_Last;
+	std::vector<char> m_Out;
+	size_t m_OutSize;
+	uLong m_CRC;
+
+	GzipBlockTask() : m_ZStreamInitialized(false), m_Level(ZLIB_DEFAULT_LEVEL), m_InSize(0), m_Dict(NULL), m_DictSize(0), m_Last(false), m_OutSize(0), m_CRC(0) { }
+	void Release();
+
+	virtual void Run();
+};
+
+void GzipBlockTask::Release()
+{
+	if (m_ZStreamInitialized)
+	{
+		deflateEnd(&m_ZStream);
+		m_ZStreamInitialized = false;
+	}
+}
+
+void GzipBlockTask::Run()
+{
+	int R;
+	if (m_ZStreamInitialized)
+		R = deflateReset(&m_ZStream);
+	else
+	{
+		m_ZStream.zalloc = Z_NULL;
+		m_ZStream.zfree = Z_NULL;
+		m_ZStream.opaque = Z_NULL;
+		// Raw deflate - gzip header and trailer are written by ParallelGzipCompressionStream
+		R = deflateInit2(&m_ZStream, m_Level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+		m_ZStreamInitialized = (R == Z_OK);
+	}
+	if (R != Z_OK)
+		throw ZlibError(R, _T("Cannot initialize gzip block compression."), __TFILE__, __LINE__);
+
+	if (m_DictSize > 0)
+	{
+		R = deflateSetDictionary(&m_ZStream, (const Bytef*)m_Dict, (uInt)m_DictSize);
+		if (R != Z_OK)
+			throw ZlibError(R, _T("Cannot set gzip block dictionary."), __TFILE__, __LINE__);
+	}
+
+	m_CRC = crc32(0L, Z_NULL, 0);
+	if (m_InSize > 0)
+		m_CRC = crc32(m_CRC, (const Bytef*)&m_In[0], (uInt)m_InSize);
+
+	// Room for sync flush marker and final block comes on top of deflateBound
+	size_t OutCapacity = deflateBound(&m_ZStream, (uLong)m_InSize) + 16;
+	if (m_Out.size() < OutCapacity)
+		m_Out.resize(OutCapacity);
+
+	char Foo = '\0';
+	m_ZStream.next_in = (Bytef*)(m_InSize > 0 ? &m_In[0] : &Foo);
+	m_ZStream.avail_in = (uInt)m_InSize;
+	m_ZStream.next_out = (Bytef*)&m_Out[0];
+	m_ZStream.avail_out = (uInt)m_Out.size();
+
+	int Flush = m_Last ? Z_FINISH : Z_SYNC_FLUSH;
+	for (;;)
+	{
+		R = deflate(&m_ZStream, Flush);
+		if (R == Z_STREAM_ERROR)
+			throw ZlibError(R, _T("Cannot compress gzip block."), __TFILE__, __LINE__);
+		if (m_Last ? (R == Z_STREAM_END) : (m_ZStream.avail_in == 0 && m_ZStream.avail_out > 0))
+			break;
+		// Should not happen thanks to deflateBound, but be safe
+		size_t Used = m_Out.size() - m_ZStream.avail_out;
+		m_Out.resize(m_Out.size() * 2);
+		m_ZStream.next_out = (Bytef*)&m_Out[Used];
+		m_ZStream.avail_out = (uInt)(m_Out.size() - Used);
+	}
+	m_OutSize = m_Out.size() - m_ZStream.avail_out;
+}
+
+class ParallelGzipCompressionStream_pimpl
+{
+public:
+	Stream *m_Stream;
+	size_t m_BlockSize;
+	scoped_ptr<ThreadPool> m_Pool;
+	// Batch of blocks compressed together - only first m_FilledCount are complete
+	std::vector<GzipBlockTask> m_Tasks;
+	size_t m_FilledCount;
+	// Last bytes of the last block of previous batch - dictionary for the next one
+	std::vector<char> m_History;
+	uLong m_CRC;
+	uint64 m_TotalSize;
+	bool m_Finished;
+
+	ParallelGzipCompressionStream_pimpl(Stream *a_Stream, const string *FileName, const string *Comment, int Level, uint ThreadCount, size_t BlockSize);
+	~ParallelGzipCompressionStream_pimpl();
+
+	void Write(const void *Data, size_t Size);
+	void Flush();
+	void Finish();
+
+private:
+	void WriteHeader(const string *FileName, const string *Comment, int Level);
+	void ProcessBatch();
+};
+
+ParallelGzipCompressionStream_pimpl::ParallelGzipCompressionStream_pimpl(Stream *a_Stream, const string *FileName, const string *Comment, int Level, uint ThreadCount, size_t BlockSize) :
+	m_Stream(a_Stream),
+	m_BlockSize(BlockSize),
+	m_FilledCount(0),
+	m_CRC(crc32(0L, Z_NULL, 0)),
+	m_TotalSize(0),
+	m_Finished(false)
+{
+	if (BlockSize < DEFLATE_WINDOW_SIZE || BlockSize > 0x7FFFFFFF)
+		throw Error(Format(_T("Invalid gzip block size: #.")) % BlockSize, __TFILE__, __LINE__);
+
+	if (ThreadCount == 0)
+		ThreadCount = ThreadPool::GetHardwareThreadCount();
+	if (ThreadCount > 1)
+		m_Pool.reset(new ThreadPool(ThreadCount));
+
+	m_Tasks.resize(ThreadCount > 1 ? ThreadCount * 2 : 1);
+	for (size_t i = 0; i < m_Tasks.size(); i++)
+		m_Tasks[i].m_Level = Level;
+
+	WriteHeader(FileName, Comment, Level);
+}
+
+ParallelGzipCompressionStream_pimpl::~ParallelGzipCompressionStream_pimpl()
+{
+	for (size_t i = 0; i < m_Tasks.size(); i++)
+		m_Tasks[i].Release();
+}
+
+void ParallelGzipCompressionStream_pimpl::WriteHeader(const string *FileName, const string *Comment, int Level)
+{
+	bool HasFileName = (FileName != NULL && !FileName->empty());
+	bool HasComment = (Comment != NULL && !Comment->empty());
+
+	uint8 Header[10];
+	Header[0] = 0x1F;
+	Header[1] = 0x8B;
+	Header[2] = Z_DEFLATED;
+	Header[3] = (uint8)((HasFileName ? 0x08 : 0) | (HasComment ? 0x10 : 0));
+	uint32 Time = (uint32)Now().GetTicks();
+	Header[4] = (uint8)(Time);
+	Header[5] = (uint8)(Time >> 8);
+	Header[6] = (uint8)(Time >> 16);
+	Header[7] = (uint8)(Time >> 24);
+	Header[8] = (uint8)(Level == ZLIB_BEST_LEVEL ? 2 : (Level == ZLIB_FASTEST_LEVEL ? 4 : 0));
+#ifdef _WIN32
+	Header[9] = 0;
+#else
+	Header[9] = 3;
+#endif
+	m_Stream->Write(Header, 10);
+
+	if (HasFileName)
+		m_Stream->Write(FileName->c_str(), FileName->length() + 1);
+	if (HasComment)
+		m_Stream->Write(Comment->c_str(), Comment->length() + 1);
+}
+
+void ParallelGzipCompressionStream_pimpl::Write(const void *Data, size_t Size)
+{
+	if (m_Finished)
+		throw Error(_T("Cannot write to ParallelGzipCompressionStream - already finished."), __TFILE__, __LINE__);
+
+	const char *Src = (const char*)Data;
+	while (Size > 0)
+	{
+		GzipBlockTask &Task = m_Tasks[m_FilledCount];
+		if (Task.m_In.size() < m_BlockSize)
+			Task.m_In.resize(m_BlockSize);
+
+		size_t ToCopy = std::min(Size, m_BlockSize - Task.m_InSize);
+		memcpy(&Task.m_In[Task.m_InSize], Src, ToCopy);
+		Task.m_InSize += ToCopy;
+		Src += ToCopy;
+		Size -= ToCopy;
+
+		if (Task.m_InSize == m_BlockSize)
+		{
+			m_FilledCount++;
+			if (m_FilledCount == m_Tasks.size())
+				ProcessBatch();
+		}
+	}
+}
+
+void ParallelGzipCompressionStream_pimpl::ProcessBatch()
+{
+	for (size_t i = 0; i < m_FilledCount; i++)
+	{
+		GzipBlockTask &Task = m_Tasks[i];
+		if (i == 0)
+		{
+			Task.m_Dict = m_History.empty() ? NULL : &m_History[0];
+			Task.m_DictSize = m_History.size();
+		}
+		else
+		{
+			const GzipBlockTask &Prev = m_Tasks[i - 1];
+			Task.m_DictSize = std::min(Prev.m_InSize, DEFLATE_WINDOW_SIZE);
+			Task.m_Dict = Task.m_DictSize > 0 ? &Prev.m_In[Prev.m_InSize - Task.m_DictSize] : NULL;
+		}
+	}
+
+	if (m_Pool != NULL && m_FilledCount > 1)
+	{
+		for (size_t i = 0; i < m_FilledCount; i++)
+			m_Pool->AddTask(&m_Tasks[i]);
+		m_Pool->WaitAll();
+	}
+	else
+	{
+		for (size_t i = 0; i < m_FilledCount; i++)
+			m_Tasks[i].Run();
+	}
+
+	for (size_t i = 0; i < m_FilledCount; i++)
+	{
+		GzipBlockTask &Task = m_Tasks[i];
+		if (Task.m_OutSize > 0)
+			m_Stream->Write(&Task.m_Out[0], Task.m_OutSize);
+		m_CRC = crc32_combine(m_CRC, Task.m_CRC, (z_off_t)Task.m_InSize);
+		m_TotalSize += Task.m_InSize;
+	}
+
+	const GzipBlockTask &LastTask = m_Tasks[m_FilledCount - 1];
+	size_t HistorySize = std::min(LastTask.m_InSize, DEFLATE_WINDOW_SIZE);
+	if (HistorySize > 0)
+		m_History.assign(&LastTask.m_In[LastTask.m_InSize - HistorySize], &LastTask.m_In[0] + LastTask.m_InSize);
+
+	for (size_t i = 0; i < m_FilledCount; i++)
+		m_Tasks[i].m_InSize = 0;
+	m_FilledCount = 0;
+}
+
+void ParallelGzipCompressionStream_pimpl::Flush()
+{
+	if (m_Finished) return;
+
+	if (m_Tasks[m_FilledCount].m_InSize > 0)
+	{
+		m_FilledCount++;
+		ProcessBatch();
+	}
+	else if (m_FilledCount > 0)
+		ProcessBatch();
+	m_Stream->Flush();
+}
+
+void ParallelGzipCompressionStream_pimpl::Finish()
+{
+	if (m_Finished) return;
+	m_Finished = true;
+
+	// Last block may be empty - it carries just the final deflate block
+	m_Tasks[m_FilledCount].m_Last = true;
+	m_FilledCount++;
+	ProcessBatch();
+
+	uint8 Trailer[8];
+	uint32 CRC = (uint32)m_CRC;
+	uint32 Size = (uint32)m_TotalSize; // ISIZE is stored modulo 2^32
+	for (uint i = 0; i < 4; i++)
+	{
+		Trailer[i] = (uint8)(CRC >> (i * 8));
+		Trailer[i + 4] = (uint8)(Size >> (i * 8));
+	}
+	m_Stream->Write(Trailer, 8);
+	m_Stream->Flush();
+}
+
+ParallelGzipCompressionStream::ParallelGzipCompressionStream(Stream *a_Stream, const string *FileName, const string *Comment, int Level, uint ThreadCount, size_t BlockSize) :
+	OverlayStream(a_Stream),
+	pimpl(new ParallelGzipCompressionStream_pimpl(a_Stream, FileName, Comment, Level, ThreadCount, BlockSize))
+{
+}
+
+ParallelGzipCompressionStream::~ParallelGzipCompressionStream()
+{
+	try
+	{
+		pimpl->Finish();
+	}
+	catch (...)
+	{
+		assert(0 && "ParallelGzipCompressionStream.dtor - exception.");
+	}
+}
+
+void ParallelGzipCompressionStream::Write(const void *Data, size_t Size)
+{
+	pimpl->Write(Data, Size);
+}
+
+void ParallelGzipCompressionStream::Flush()
+{
+	pimpl->Flush();
+}
+
+void ParallelGzipCompressionStream::Finish()
+{
+	pimpl->Finish();
+}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Klasa ZlibDecompressionStream_pimpl
+
+class ZlibDecompressionStream_pimpl
+{
+private:
+	Stream *m_Stream;
+	z_stream m_ZStream;
+	std::vector<char> m_InBuf;
+	size_t m_InBufLen;
+	bool m_Gzip;
+	bool m_OutEnd;
+	gz_header m_Header;
+	std::vector<char> m_Header_FileName;
+	std::vector<char> m_Header_Comment;
+
+	void EnsureBuf(Stream *a_Stream);
+	// Po końcu członu gzip - jeśli są dalsze dane, rozpoczyna dekompresję następnego członu i zwraca true.
+	bool NextMember();
+
+public:
+	// Wersja zlib
+	ZlibDecompressionStream_pimpl(Stream *a_Stream, bool Gzip, int WindowBits = 15);
+	// Wersja gzip
+	~ZlibDecompressionStream_pimpl();
+
+	size_t Read(void *Out, size_t MaxLength);
+	bool End();
+
+	bool GetHeaderFileName(string *OutFileName);
+	bool GetHeaderComment(string *OutComment);
+};
+
+void ZlibDecompressionStream_pimpl::EnsureBuf(Stream *a_Stream)
+{
+	// Nie pamiętam skąd to się wzięło, ale natknąłem się na błąd że ta asercja zwracała false,
+	// a jej zakomentowanie sprawiło że wszystko działa dobrze.
+//	assert(m_InBufLen == 0);
+	m_InBufLen = a_Stream->Read(&m_InBuf[0], BUFFER_SIZE);
+}
+
+bool ZlibDecompressionStream_pimpl::NextMember()
+{
+	if (!m_Gzip)
+		return false;
+
+	if (m_ZStream.avail_in == 0)
+	{
+		EnsureBuf(m_Stream);
+		if (m_InBufLen == 0)
+			return false;
+		m_ZStream.next_in = (Bytef*)&m_InBuf[0];
+		m_ZStream.avail_in = (uInt)m_InBufLen;
+	}
+
+	// Śmieci po ostatnim członie są ignorowane, tak jak robi to gzip
+	if (*m_ZStream.next_in != 0x1F)
+		return false;
+
+	// Nagłówek pierwszego członu zostaje zachowany - inflateReset odłącza m_Header
+	int R = inflateReset(&m_ZStream);
+	if (R != Z_OK)
+		throw ZlibError(R, _T("Cannot start decompression of next gzip member."), __TFILE__, __LINE__);
+	return true;
+}
+
+ZlibDecompressionStream_pimpl::ZlibDecompressionStream_pimpl(Stream *a_Stream, bool Gzip, int WindowBits) :
+	m_Stream(a_Stream),
+	m_Gzip(Gzip)
+{
+	m_InBuf.resize(BUFFER_SIZE);
+	m_InBufLen = 0;
+
+	m_ZStream.zalloc = Z_NULL;
+	m_ZStream.zfree = Z_NULL;
+	m_ZStream.opaque = Z_NULL;
+
+	EnsureBuf(m_Stream);
+	m_ZStream.next_in = (Bytef*)&m_InBuf[0];
+	m_ZStream.avail_in = (uInt)m_InBufLen;
+
+	// Tak też może być
+	//m_ZStream.next_in = 0;
+	//m_ZStream.avail_in = Z_NULL;
+
+	if (Gzip)
+	{
+		int R = inflateInit2(&m_ZStream, WindowBits + 16);
+		if (R != Z_OK)
+			throw ZlibError(R, _T("Cannot initialize gzip decompression."), __TFILE__, __LINE__);
+
+		// Odczytanie nagłówka
+		m_Header_FileName.resize(256);
+		m_Header_Comment.resize(256);
+		m_Header.extra = Z_NULL;
+		m_Header.extra_len = 0;
+		m_Header.name = (Bytef*)&m_Header_FileName[0];
+		m_Header.name_max = 256;
+		m_Header.comment = (Bytef*)&m_Header_Comment[0];
+		m_Header.comm_max = 256;
+		R = inflateGetHeader(&m_ZStream, &m_Header);
+		if (R != Z_OK)
+			throw ZlibError(R, _T("zlib.inflateGetHeader"), __TFILE__, __LINE__);
+	}
+	else
+	{
+		int R = inflateInit2(&m_ZStream, WindowBits);
+		if (R != Z_OK)
+			throw ZlibError(R, _T("Cannot initialize zlib decompression."), __TFILE__, __LINE__);
+	}
+
+	char Foo = '\0';
+	m_ZStream.next_out = (Bytef*)&Foo;
+	m_ZStream.avail_out = 0;
+	
+	int R = inflate(&m_ZStream, Z_NO_FLUSH);
+	// Puste człony
+	while (R == Z_STREAM_END && NextMember())
+		R = inflate(&m_ZStream, Z_NO_FLUSH);
+	m_OutEnd = (R == Z_STREAM_END);
+	// Tego jednak nie, bo tutaj jeśli nie Z_STREAM_END, to zwraca Z_BUF_ERROR, bo mamy avail_in=0 i avail_out=0
+//	if (R != Z_OK && R != Z_STREAM_END)
+//		throw ZlibError(R, _T("Cannot start zlib decompression."), __TFILE__, __LINE__);
+}
+
+ZlibDecompressionStream_pimpl::~ZlibDecompressionStream_pimpl()
+{
+	inflateEnd(&m_ZStream);
+}
+
+size_t ZlibDecompressionStream_pimpl::Read(void *Out, size_t MaxLength)
+{
+	if (m_OutEnd == true || MaxLength == 0)
+		return 0;
+
+    assert(MaxLength <= UINT_MAX);
+
+	// avail_out wskazuje na liczbę pozostałych bajtów do odczytania w tym wywołaniu Read.
+	//   Więc (MaxLength - avail_out) to liczba zwróconych przez zlib bajtów w tym wywołaniu Read.
+	// avail_in to liczba niepobranych jeszcze przez zlib danych z bufora InBuf.
+	//   Więc (InBufLen - avail_in) to liczba przetworznych już przez zlib bajtów danego bufora InBuf.
+
+	// Miejsce do pisania
+	m_ZStream.avail_out = (uInt)MaxLength;
+	m_ZStream.next_out = (Bytef*)Out;
+
+	for (;;)
+	{
+		// Przeczytane już pełne MaxLength bajtów
+		if (m_ZStream.avail_out == 0)
+			return MaxLength;
+
+		// Zapewnij dane do czytania
+		if (m_ZStream.avail_in == 0)
+		{
+			EnsureBuf(m_Stream);
+			// Koniec danych wejściowych, a wciąż nie koniec strumienia zlib - niewątpliwy błąd, niedokończone dane
+			if (m_InBufLen == 0)
+				throw Error(_T("Zlib decompression stream error: Unfinished data."), __TFILE__, __LINE__);
+			m_ZStream.next_in = (Bytef*)&m_InBuf[0];
+			m_ZStream.avail_in = (uInt)m_InBufLen;
+		}
+
+		int R = inflate(&m_ZStream, Z_NO_FLUSH);
+
+		// ZlibError wykrył koniec strumienia
+		if (R == Z_STREAM_END)
+		{
+			// Plik gzip może się składać z wielu członów połączonych jeden za drugim
+			if (NextMember())
+				continue;
+			m_OutEnd = true;
+			return MaxLength - m_ZStream.avail_out;
+		}
+		// Błąd
+		else if (R != Z_OK)
+			throw ZlibError(R, _T("Zlib compression stream error."), __TFILE__, __LINE__);
+	}
+}
+
+bool ZlibDecompressionStream_pimpl::End()
+{
+	return m_OutEnd;
+}
+
+bool ZlibDecompressionStream_pimpl::GetHeaderFileName(string *OutFileName)
+{
+	if (m_Header.done != 1) return false;
+	if (m_Header.name == Z_NULL) return false;
+
+	OutFileName->assign(&m_Header_FileName[0], strnlen(&m_Header_FileName[0], 256));
+	return true;
+}
+
+bool ZlibDecompressionStream_pimpl::GetHeaderComment(string *OutComment)
+{
+	if (m_Header.done != 1) return false;
+	if (m_Header.comment == Z_NULL) return false;
+
+	OutComment->assign(&m_Header_Comment[0], strnlen(&m_Header_Comment[0], 256));
+	return true;
+}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Klasa ZlibDecompressionStream
+
+ZlibDecompressionStream::ZlibDecompressionStream(Stream *a_Stream, int WindowBits) :
+	OverlayStream(a_Stream),
+	pimpl(new ZlibDecompressionStream_pimpl(a_Stream, false, WindowBits))
+{
+}
+
+ZlibDecompressionStream::~ZlibDecompressionStream()
+{
+	pimpl.reset();
+}
+
+size_t ZlibDecompressionStream::Read(void *Out, size_t MaxLength)
+{
+	return pimpl->Read(Out, MaxLength);
+}
+
+bool ZlibDecompressionStream::End()
+{
+	return pimpl->End();
+}
+
+size_t ZlibDecompressionStream::Decompress(void *OutData, size_t BufLength, const void *Data, size_t DataLength)
+{
+    assert(BufLength <= ULONG_MAX && DataLength <= ULONG_MAX);
+	uLongf DestLen = (uLongf)BufLength;
+	int R = uncompress((Bytef*)OutData, &DestLen, (Bytef*)Data, (uLong)DataLength);
+	if (R != Z_OK)
+		throw ZlibError(R, _T("Cannot decompress data with zlib."), __TFILE__, __LINE__);
+	return DestLen;
+}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Klasa GzipDecompressionStream
+
+GzipDecompressionStream::GzipDecompressionStream(Stream *a_Stream, int WindowBits) :
+	OverlayStream(a_Stream),
+	pimpl(new ZlibDecompressionStream_pimpl(a_Stream, true, WindowBits))
+{
+}
+
+GzipDecompressionStream::~GzipDecompressionStream()
+{
+	pimpl.reset();
+}
+
+size_t GzipDecompressionStream::Read(void *Out, size_t MaxLength)
+{
+	return pimpl->Read(Out, MaxLength);
+}
+
+bool GzipDecompressionStream::End()
+{
+	return pimpl->End();
+}
+
+bool GzipDecompressionStream::GetHeaderFileName(string *OutFileName)
+{
+	return pimpl->GetHeaderFileName(OutFileName);
+}
+
+bool GzipDecompressionStream::GetHeaderComment(string *OutComment)
+{
+	return pimpl->GetHeaderComment(OutComment);
+}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Klasa ParallelGzipDecompressionStream
+
+static const size_t GZIP_HEADER_MIN_SIZE = 10;
+
+// Checks fixed part of gzip header - signature, method, reserved flags, extra flags and OS
+static bool LooksLikeGzipHeader(const char *Data, size_t Size)
+{
+	if (Size < GZIP_HEADER_MIN_SIZE)
+		return false;
+	const uint8 *Bytes = (const uint8*)Data;
+	return Bytes[0] == 0x1F && Bytes[1] == 0x8B && Bytes[2] == Z_DEFLATED &&
+		(Bytes[3] & 0xE0) == 0 &&
+		(Bytes[8] == 0 || Bytes[8] == 2 || Bytes[8] == 4) &&
+		(Bytes[9] <= 13 || Bytes[9] == 255);
+}
+
+// Decompresses one gzip member starting at given candidate offset, up to the end of the batch.
+class GzipMemberTask : public ThreadTask
+{
+public:
+	enum RESULT
+	{
+		RESULT_COMPLETE,
+		RESULT_NEED_MORE_INPUT,
+		RESULT_ERROR,
+	};
+
+	const char *m_In;
+	size_t m_InSize;
+	RESULT m_Result;
+	int m_ErrorCode;
+	// Compressed bytes of the member, valid if RESULT_COMPLETE
+	size_t m_Consumed;
+	// Gzip header was accepted by zlib - error after it means damaged data, not garbage
+	bool m_HeaderDone;
+	std::vector<char> m_Out;
+
+	GzipMemberTask() : m_In(NULL), m_InSize(0), m_Result(RESULT_ERROR), m_ErrorCode(Z_OK), m_Consumed(0), m_HeaderDone(false), m_ZStreamInitialized(false) { }
+	~GzipMemberTask();
+
+	// Never throws - error is expected for false candidates
+	virtual void Run();
+
+private:
+	z_stream m_ZStream;
+	gz_header m_Header;
+	bool m_ZStreamInitialized;
+};
+
+GzipMemberTask::~GzipMemberTask()
+{
+	if (m_ZStreamInitialized)
+		inflateEnd(&m_ZStream);
+}
+
+void GzipMemberTask::Run()
+{
+	m_Result = RESULT_ERROR;
+	m_Consumed = 0;
+	m_HeaderDone = false;
+	m_Out.clear();
+
+	if (m_ZStreamInitialized)
+		m_ErrorCode = inflateReset(&m_ZStream);
+	else
+	{
+		m_ZStream.zalloc = Z_NULL;
+		m_ZStream.zfree = Z_NULL;
+		m_ZStream.opaque = Z_NULL;
+		m_ZStream.next_in = Z_NULL;
+		m_ZStream.avail_in = 0;
+		m_ErrorCode = inflateInit2(&m_ZStream, 15 + 16);
+		m_ZStreamInitialized = (m_ErrorCode == Z_OK);
+	}
+	if (m_ErrorCode != Z_OK)
+		return;
+	// Only to know when the header ends - its fields are not stored
+	common_memzero(&m_Header, sizeof(m_Header));
+	m_ErrorCode = inflateGetHeader(&m_ZStream, &m_Header);
+	if (m_ErrorCode != Z_OK)
+		return;
+
+	m_ZStream.next_in = (Bytef*)m_In;
+	m_ZStream.avail_in = (uInt)m_InSize;
+
+	size_t OutLen = 0;
+	// Input may be much longer than the member, so start small
+	m_Out.resize(65536);
+	for (;;)
+	{
+		if (OutLen == m_Out.size())
+			m_Out.resize(m_Out.size() * 2);
+		m_ZStream.next_out = (Bytef*)&m_Out[OutLen];
+		m_ZStream.avail_out = (uInt)std::min<size_t>(m_Out.size() - OutLen, UINT_MAX);
+		uInt AvailOut = m_ZStream.avail_out;
+
+		int R = inflate(&m_ZStream, Z_NO_FLUSH);
+		OutLen += AvailOut - m_ZStream.avail_out;
+		m_HeaderDone = (m_Header.done == 1);
+
+		if (R == Z_STREAM_END)
+		{
+			m_Result = RESULT_COMPLETE;
+			m_Consumed = m_InSize - m_ZStream.avail_in;
+			break;
+		}
+		if (R != Z_OK && R != Z_BUF_ERROR)
+		{
+			m_ErrorCode = R;
+			break;
+		}
+		if (m_ZStream.avail_in == 0 && m_ZStream.avail_out > 0)
+		{
+			m_Result = RESULT_NEED_MORE_INPUT;
+			break;
+		}
+	}
+	m_Out.resize(OutLen);
+}
+
+class ParallelGzipDecompressionStream_pimpl
+{
+public:
+	Stream *m_Stream;
+	size_t m_BatchSize;
+	scoped_ptr<ThreadPool> m_Pool;
+	// Tasks are allocated once and reused - each keeps its z_stream
+	std::vector<GzipMemberTask*> m_Tasks;
+	// Compressed data of current batch, m_BufPos is beginning of the next member
+	std::vector<char> m_Buf;
+	size_t m_BufPos;
+	bool m_InputEnd;
+	// At least one member has been decompressed - data that is not a gzip member is garbage after the end
+	bool m_MemberFound;
+	// Decompressed data waiting for Read, m_ReadyPos is position in the first element
+	std::deque< std::vector<char> > m_Ready;
+	size_t m_ReadyPos;
+	bool m_Finished;
+	// Sequential decompression of a member longer than the batch
+	bool m_Streaming;
+	z_stream m_ZStream;
+	bool m_ZStreamInitialized;
+	std::vector<char> m_InBuf;
+
+	ParallelGzipDecompressionStream_pimpl(Stream *a_Stream, uint ThreadCount, size_t BatchSize);
+	~ParallelGzipDecompressionStream_pimpl();
+
+	// Makes at least some progress - adds to m_Ready or sets m_Finished
+	void Produce();
+	bool End();
+	size_t Read(void *Out, size_t MaxLength);
+
+private:
+	void FillBuffer();
+	void ProcessBatch();
+	void StartStreaming();
+	void StreamStep();
+};
+
+ParallelGzipDecompressionStream_pimpl::ParallelGzipDecompressionStream_pimpl(Stream *a_Stream, uint ThreadCount, size_t BatchSize) :
+	m_Stream(a_Stream),
+	m_BatchSize(std::max<size_t>(BatchSize, BUFFER_SIZE)),
+	m_BufPos(0),
+	m_InputEnd(false),
+	m_MemberFound(false),
+	m_ReadyPos(0),
+	m_Finished(false),
+	m_Streaming(false),
+	m_ZStreamInitialized(false)
+{
+	if (m_BatchSize > UINT_MAX)
+		throw Error(Format(_T("Invalid gzip batch size: #.")) % BatchSize, __TFILE__, __LINE__);
+
+	if (ThreadCount == 0)
+		ThreadCount = ThreadPool::GetHardwareThreadCount();
+	if (ThreadCount > 1)
+		m_Pool.reset(new ThreadPool(ThreadCount));
+}
+
+ParallelGzipDecompressionStream_pimpl::~ParallelGzipDecompressionStream_pimpl()
+{
+	for (size_t i = 0; i < m_Tasks.size(); i++)
+		delete m_Tasks[i];
+	if (m_ZStreamInitialized)
+		inflateEnd(&m_ZStream);
+}
+
+void ParallelGzipDecompressionStream_pimpl::FillBuffer()
+{
+	if (m_BufPos > 0)
+	{
+		m_Buf.erase(m_Buf.begin(), m_Buf.begin() + m_BufPos);
+		m_BufPos = 0;
+	}
+
+	// Rest left after sequential decompression can be longer than the batch
+	size_t Size = m_Buf.size();
+	if (Size >= m_BatchSize)
+		return;
+	m_Buf.resize(m_BatchSize);
+	while (Size < m_BatchSize && !m_InputEnd)
+	{
+		size_t ReadLen = m_Stream->Read(&m_Buf[Size], m_BatchSize - Size);
+		if (ReadLen == 0)
+			m_InputEnd = true;
+		Size += ReadLen;
+	}
+	m_Buf.resize(Size);
+}
+
+void ParallelGzipDecompressionStream_pimpl::Produce()
+{
+	if (m_Streaming)
+		StreamStep();
+	else
+	{
+		FillBuffer();
+		// End of data. Garbage after the last member is ignored, like gzip does,
+		// but data without any member is not gzip at all.
+		if (m_Buf.empty() || m_Buf[0] != 0x1F)
+		{
+			if (!m_MemberFound)
+				throw Error(_T("Invalid gzip header."), __TFILE__, __LINE__);
+			m_Finished = true;
+			return;
+		}
+		ProcessBatch();
+	}
+}
+
+void ParallelGzipDecompressionStream_pimpl::ProcessBatch()
+{
+	// Candidates for beginnings of members. The first one is certain.
+	std::vector<size_t> Starts;
+	Starts.push_back(0);
+	const char *Buf = &m_Buf[0];
+	size_t BufSize = m_Buf.size();
+	for (size_t i = 1; i + GZIP_HEADER_MIN_SIZE <= BufSize; i++)
+	{
+		if (Buf[i] == 0x1F && LooksLikeGzipHeader(Buf + i, BufSize - i))
+			Starts.push_back(i);
+	}
+
+	while (m_Tasks.size() < Starts.size())
+		m_Tasks.push_back(new GzipMemberTask());
+	for (size_t i = 0; i < Starts.size(); i++)
+	{
+		m_Tasks[i]->m_In = Buf + Starts[i];
+		m_Tasks[i]->m_InSize = BufSize - Starts[i];
+	}
+
+	if (m_Pool != NULL && Starts.size() > 1)
+	{
+		for (size_t i = 0; i < Starts.size(); i++)
+			m_Pool->AddTask(m_Tasks[i]);
+		m_Pool->WaitAll();
+	}
+	else
+		m_Tasks[0]->Run();
+
+	// Follow the chain of members which really end where the next one starts
+	size_t Pos = 0;
+	GzipMemberTask *Task = m_Tasks[0];
+	for (;;)
+	{
+		if (Task->m_Result == GzipMemberTask::RESULT_ERROR)
+		{
+			// zlib rejected the header of a following member - the rest is garbage, ignored like gzip does
+			if (!Task->m_HeaderDone)
+			{
+				if (!m_MemberFound)
+					throw ZlibError(Task->m_ErrorCode, _T("Invalid gzip header."), __TFILE__, __LINE__);
+				m_BufPos = BufSize;
+				m_Finished = true;
+				return;
+			}
+			throw ZlibError(Task->m_ErrorCode, Format(_T("Cannot decompress gzip member at batch offset #.")) % Pos, __TFILE__, __LINE__);
+		}
+		if (Task->m_Result == GzipMemberTask::RESULT_NEED_MORE_INPUT)
+		{
+			// Whole batch is one unfinished member - decompress it sequentially
+			if (Pos == 0)
+			{
+				m_BufPos = 0;
+				StartStreaming();
+			}
+			// Last member will be done again as the first one of the next batch
+			else
+				m_BufPos = Pos;
+			return;
+		}
+
+		m_Ready.push_back(std::vector<char>());
+		m_Ready.back().swap(Task->m_Out);
+		Pos += Task->m_Consumed;
+		m_MemberFound = true;
+
+		if (Pos == BufSize)
+		{
+			m_BufPos = Pos;
+			return;
+		}
+		std::vector<size_t>::iterator It = std::lower_bound(Starts.begin(), Starts.end(), Pos);
+		if (It != Starts.end() && *It == Pos)
+		{
+			Task = m_Tasks[It - Starts.begin()];
+			// Task not run if there was no pool
+			if (m_Pool == NULL || Starts.size() == 1)
+				Task->Run();
+		}
+		else
+		{
+			// Scan missed this member - its header is too close to the end of the batch
+			// or doesn't look typical. Let zlib decide, using a spare task.
+			if (m_Tasks.size() == Starts.size())
+				m_Tasks.push_back(new GzipMemberTask());
+			Task = m_Tasks[Starts.size()];
+			Task->m_In = Buf + Pos;
+			Task->m_InSize = BufSize - Pos;
+			Task->Run();
+		}
+	}
+}
+
+void ParallelGzipDecompressionStream_pimpl::StartStreaming()
+{
+	int R;
+	if (m_ZStreamInitialized)
+		R = inflateReset(&m_ZStream);
+	else
+	{
+		m_ZStream.zalloc = Z_NULL;
+		m_ZStream.zfree = Z_NULL;
+		m_ZStream.opaque = Z_NULL;
+		m_ZStream.next_in = Z_NULL;
+		m_ZStream.avail_in = 0;
+		R = inflateInit2(&m_ZStream, 15 + 16);
+		m_ZStreamInitialized = (R == Z_OK);
+	}
+	if (R != Z_OK)
+		throw ZlibError(R, _T("Cannot initialize gzip decompression."), __TFILE__, __LINE__);
+
+	// Input comes first from the whole m_Buf, then directly from the stream
+	m_ZStream.next_in = (Bytef*)&m_Buf[m_BufPos];
+	m_ZStream.avail_in = (uInt)(m_Buf.size() - m_BufPos);
+	m_Streaming = true;
+}
+
+void ParallelGzipDecompressionStream_pimpl::StreamStep()
+{
+	std::vector<char> Out(BUFFER_SIZE * 16);
+	m_ZStream.next_out = (Bytef*)&Out[0];
+	m_ZStream.avail_out = (uInt)Out.size();
+
+	while (m_ZStream.avail_out > 0)
+	{
+		if (m_ZStream.avail_in == 0)
+		{
+			if (m_InBuf.empty())
+				m_InBuf.resize(BUFFER_SIZE * 16);
+			size_t ReadLen = m_Stream->Read(&m_InBuf[0], m_InBuf.size());
+			if (ReadLen == 0)
+				throw Error(_T("Gzip decompression stream error: Unfinished data."), __TFILE__, __LINE__);
+			m_ZStream.next_in = (Bytef*)&m_InBuf[0];
+			m_ZStream.avail_in = (uInt)ReadLen;
+		}
+
+		int R = inflate(&m_ZStream, Z_NO_FLUSH);
+		if (R == Z_STREAM_END)
+		{
+			// Rest of the input becomes beginning of the next batch
+			std::vector<char> Rest((char*)m_ZStream.next_in, (char*)m_ZStream.next_in + m_ZStream.avail_in);
+			m_Buf.swap(Rest);
+			m_BufPos = 0;
+			m_Streaming = false;
+			m_MemberFound = true;
+			break;
+		}
+		else if (R != Z_OK && R != Z_BUF_ERROR)
+			throw ZlibError(R, _T("Gzip decompression stream error."), __TFILE__, __LINE__);
+	}
+
+	Out.resize(Out.size() - m_ZStream.avail_out);
+	m_Ready.push_back(std::vector<char>());
+	m_Ready.back().swap(Out);
+}
+
+bool ParallelGzipDecompressionStream_pimpl::End()
+{
+	for (;;)
+	{
+		while (!m_Ready.empty() && m_ReadyPos == m_Ready.front().size())
+		{
+			m_Ready.pop_front();
+			m_ReadyPos = 0;
+		}
+		if (!m_Ready.empty())
+			return false;
+		if (m_Finished)
+			return true;
+		Produce();
+	}
+}
+
+size_t ParallelGzipDecompressionStream_pimpl::Read(void *Out, size_t MaxLength)
+{
+	char *Dst = (char*)Out;
+	size_t Total = 0;
+	while (Total < MaxLength && !End())
+	{
+		const std::vector<char> &Front = m_Ready.front();
+		size_t Len = std::min(MaxLength - Total, Front.size() - m_ReadyPos);
+		memcpy(Dst + Total, &Front[m_ReadyPos], Len);
+		m_ReadyPos += Len;
+		Total += Len;
+	}
+	return Total;
+}
+
+ParallelGzipDecompressionStream::ParallelGzipDecompressionStream(Stream *a_Stream, uint ThreadCount, size_t BatchSize) :
+	OverlayStream(a_Stream),
+	pimpl(new ParallelGzipDecompressionStream_pimpl(a_Stream, ThreadCount, BatchSize))
+{
+}
+
+ParallelGzipDecompressionStream::~ParallelGzipDecompressionStream()
+{
+	pimpl.reset();
+}
+
+size_t ParallelGzipDecompressionStream::Read(void *Out, size_t MaxLength)
+{
+	return pimpl->Read(Out, MaxLength);
+}
+
+bool ParallelGzipDecompressionStream::End()
+{
+	return pimpl->End();
+}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Klasa ZlibCompressor
+
+class ZlibCompressor_pimpl
+{
+public:
+	z_stream m_ZStream;
+	int m_WindowBits;
+	// Freshly initialized stream doesn't need reset
+	bool m_Used;
+	std::vector<char> m_Dict;
+};
+
+ZlibCompressor::ZlibCompressor(int Level, int WindowBits) :
+	pimpl(new ZlibCompressor_pimpl)
+{
+	pimpl->m_WindowBits = WindowBits;
+	pimpl->m_Used = false;
+
+	pimpl->m_ZStream.zalloc = Z_NULL;
+	pimpl->m_ZStream.zfree = Z_NULL;
+	pimpl->m_ZStream.opaque = Z_NULL;
+
+	int R = deflateInit2(&pimpl->m_ZStream, Level, Z_DEFLATED, WindowBits, 8, Z_DEFAULT_STRATEGY);
+	if (R != Z_OK)
+		throw ZlibError(R, _T("Cannot initialize zlib compression."), __TFILE__, __LINE__);
+}
+
+ZlibCompressor::~ZlibCompressor()
+{
+	deflateEnd(&pimpl->m_ZStream);
+}
+
+void ZlibCompressor::SetDictionary(const void *Dict, size_t DictLength)
+{
+	if (DictLength > 0 && pimpl->m_WindowBits > 15)
+		throw Error(_T("Preset dictionary is not supported in gzip format."), __TFILE__, __LINE__);
+
+	// Only the window size is ever used by deflate
+	if (DictLength > DEFLATE_WINDOW_SIZE)
+	{
+		Dict = (const char*)Dict + (DictLength - DEFLATE_WINDOW_SIZE);
+		DictLength = DEFLATE_WINDOW_SIZE;
+	}
+	pimpl->m_Dict.assign((const char*)Dict, (const char*)Dict + DictLength);
+}
+
+size_t ZlibCompressor::CompressLength(size_t DataLength)
+{
+	assert(DataLength <= ULONG_MAX);
+	// deflateBound doesn't know yet about dictionary id stored in zlib header
+	return deflateBound(&pimpl->m_ZStream, (uLong)DataLength) + (pimpl->m_Dict.empty() ? 0 : 4);
+}
+
+size_t ZlibCompressor::Compress(void *OutData, size_t BufLength, const void *Data, size_t DataLength)
+{
+	assert(BufLength <= UINT_MAX && DataLength <= UINT_MAX);
+
+	z_stream &ZStream = pimpl->m_ZStream;
+	int R;
+	if (pimpl->m_Used)
+	{
+		R = deflateReset(&ZStream);
+		if (R != Z_OK)
+			throw ZlibError(R, _T("deflateReset"), __TFILE__, __LINE__);
+	}
+	pimpl->m_Used = true;
+
+	if (!pimpl->m_Dict.empty())
+	{
+		R = deflateSetDictionary(&ZStream, (const Bytef*)&pimpl->m_Dict[0], (uInt)pimpl->m_Dict.size());
+		if (R != Z_OK)
+			throw ZlibError(R, _T("deflateSetDictionary"), __TFILE__, __LINE__);
+	}
+
+	char Foo = '\0';
+	ZStream.next_in = (Bytef*)(DataLength > 0 ? Data : &Foo);
+	ZStream.avail_in = (uInt)DataLength;
+	ZStream.next_out = (Bytef*)OutData;
+	ZStream.avail_out = (uInt)BufLength;
+
+	R = deflate(&ZStream, Z_FINISH);
+	if (R == Z_OK || R == Z_BUF_ERROR)
+		throw Error(Format(_T("Cannot compress data with zlib - output buffer of # bytes too small.")) % BufLength, __TFILE__, __LINE__);
+	else if (R != Z_STREAM_END)
+		throw ZlibError(R, _T("Cannot compress data with zlib."), __TFILE__, __LINE__);
+
+	return BufLength - ZStream.avail_out;
+}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Klasa ZlibDecompressor
+
+class ZlibDecompressor_pimpl
+{
+public:
+	z_stream m_ZStream;
+	int m_WindowBits;
+	bool m_Used;
+	std::vector<char> m_Dict;
+
+	void SetDictionary();
+};
+
+void ZlibDecompressor_pimpl::SetDictionary()
+{
+	int R = inflateSetDictionary(&m_ZStream, (const Bytef*)&m_Dict[0], (uInt)m_Dict.size());
+	if (R != Z_OK)
+		throw ZlibError(R, _T("inflateSetDictionary"), __TFILE__, __LINE__);
+}
+
+ZlibDecompressor::ZlibDecompressor(int WindowBits) :
+	pimpl(new ZlibDecompressor_pimpl)
+{
+	pimpl->m_WindowBits = WindowBits;
+	pimpl->m_Used = false;
+
+	pimpl->m_ZStream.zalloc = Z_NULL;
+	pimpl->m_ZStream.zfree = Z_NULL;
+	pimpl->m_ZStream.opaque = Z_NULL;
+	pimpl->m_ZStream.next_in = Z_NULL;
+	pimpl->m_ZStream.avail_in = 0;
+
+	int R = inflateInit2(&pimpl->m_ZStream, WindowBits);
+	if (R != Z_OK)
+		throw ZlibError(R, _T("Cannot initialize zlib decompression."), __TFILE__, __LINE__);
+}
+
+ZlibDecompressor::~ZlibDecompressor()
+{
+	inflateEnd(&pimpl->m_ZStream);
+}
+
+void ZlibDecompressor::SetDictionary(const void *Dict, size_t DictLength)
+{
+	if (DictLength > DEFLATE_WINDOW_SIZE)
+	{
+		Dict = (const char*)Dict + (DictLength - DEFLATE_WINDOW_SIZE);
+		DictLength = DEFLATE_WINDOW_SIZE;
+	}
+	pimpl->m_Dict.assign((const char*)Dict, (const char*)Dict + DictLength);
+}
+
+size_t ZlibDecompressor::Decompress(void *OutData, size_t BufLength, const void *Data, size_t DataLength)
+{
+	assert(BufLength <= UINT_MAX && DataLength <= UINT_MAX);
+
+	z_stream &ZStream = pimpl->m_ZStream;
+	int R;
+	if (pimpl->m_Used)
+	{
+		R = inflateReset(&ZStream);
+		if (R != Z_OK)
+			throw ZlibError(R, _T("inflateReset"), __TFILE__, __LINE__);
+	}
+	pimpl->m_Used = true;
+
+	// Raw deflate has no header that could request the dictionary
+	if (pimpl->m_WindowBits < 0 && !pimpl->m_Dict.empty())
+		pimpl->SetDictionary();
+
+	char Foo = '\0';
+	ZStream.next_in = (Bytef*)(DataLength > 0 ? Data : &Foo);
+	ZStream.avail_in = (uInt)DataLength;
+	ZStream.next_out = (Bytef*)(BufLength > 0 ? OutData : &Foo);
+	ZStream.avail_out = (uInt)BufLength;
+
+	R = inflate(&ZStream, Z_FINISH);
+	if (R == Z_NEED_DICT)
+	{
+		if (pimpl->m_Dict.empty())
+			throw Error(_T("Cannot decompress data with zlib - preset dictionary required."), __TFILE__, __LINE__);
+		pimpl->SetDictionary();
+		R = inflate(&ZStream, Z_FINISH);
+	}
+
+	if (R == Z_BUF_ERROR)
+	{
+		if (ZStream.avail_out == 0)
+			throw Error(Format(_T("Cannot decompress data with zlib - output buffer of # bytes too small.")) % BufLength, __TFILE__, __LINE__);
+		else
+			throw Error(_T("Cannot decompress data with zlib - unfinished data."), __TFILE__, __LINE__);
+	}
+	else if (R != Z_STREAM_END)
+		throw ZlibError(R, _T("Cannot decompress data with zlib."), __TFILE__, __LINE__);
+
+	return BufLength - ZStream.avail_out;
+}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Klasa ZlibCodec
+
+ZlibCodec::ZlibCodec(int Level, bool Gzip) :
+	m_Level(Level),
+	m_Gzip(Gzip)
+{
+}
+
+ZlibCodec::~ZlibCodec()
+{
+}
+
+const tchar * ZlibCodec::GetName()
+{
+	return m_Gzip ? _T("gzip") : _T("zlib");
+}
+
+OverlayStream * ZlibCodec::CreateEncoder(Stream *a_Stream)
+{
+	if (m_Gzip)
+		return new GzipCompressionStream(a_Stream, NULL, NULL, m_Level);
+	else
+		return new ZlibCompressionStream(a_Stream, m_Level);
+}
+
+OverlayStream * ZlibCodec::CreateDecoder(Stream *a_Stream)
+{
+	if (m_Gzip)
+		return new GzipDecompressionStream(a_Stream);
+	else
+		return new ZlibDecompressionStream(a_Stream);
+}
+
+size_t ZlibCodec::CompressLength(size_t DataLength)
+{
+	if (m_Compressor == NULL)
+		m_Compressor.reset(new ZlibCompressor(m_Level, m_Gzip ? 31 : 15));
+	return m_Compressor->CompressLength(DataLength);
+}
+
+size_t ZlibCodec::Compress(void *OutData, size_t BufLength, const void *Data, size_t DataLength)
+{
+	if (m_Compressor == NULL)
+		m_Compressor.reset(new ZlibCompressor(m_Level, m_Gzip ? 31 : 15));
+	return m_Compressor->Compress(OutData, BufLength, Data, DataLength);
+}
+
+size_t ZlibCodec::Decompress(void *OutData, size_t BufLength, const void *Data, size_t DataLength)
+{
+	if (m_Decompressor == NULL)
+		m_Decompressor.reset(new ZlibDecompressor(m_Gzip ? 31 : 15));
+	return m_Decompressor->Decompress(OutData, BufLength, Data, DataLength);
+}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Klasa GzipIndex
+
+static const uint32 GZIP_INDEX_MAGIC = 0x31495A47; // "GZI1"
+
+GzipIndex::GzipIndex() :
+	m_Gzip(false),
+	m_CompressedSize(0),
+	m_UncompressedSize(0)
+{
+}
+
+void GzipIndex::Build(Stream *CompressedData, uint64 Span)
+{
+	m_Points.clear();
+	m_Gzip = false;
+	m_CompressedSize = 0;
+	m_UncompressedSize = 0;
+
+	std::vector<char> InBuf(BUFFER_SIZE);
+	// Circular buffer with last uncompressed data
+	std::vector<char> Window(DEFLATE_WINDOW_SIZE);
+
+	z_stream ZStream;
+	ZStream.zalloc = Z_NULL;
+	ZStream.zfree = Z_NULL;
+	ZStream.opaque = Z_NULL;
+	ZStream.next_in = Z_NULL;
+	ZStream.avail_in = 0;
+	// Automatic detection of gzip or zlib header
+	int R = inflateInit2(&ZStream, 15 + 32);
+	if (R != Z_OK)
+		throw ZlibError(R, _T("Cannot initialize decompression for building gzip index."), __TFILE__, __LINE__);
+
+	try
+	{
+		uint64 TotalIn = 0, TotalOut = 0, LastPointOut = 0, MemberStartOut = 0;
+		bool InMember = true, FirstInput = true;
+		ZStream.next_out = (Bytef*)&Window[0];
+		ZStream.avail_out = (uInt)DEFLATE_WINDOW_SIZE;
+
+		for (;;)
+		{
+			if (ZStream.avail_in == 0)
+			{
+				size_t InLen = CompressedData->Read(&InBuf[0], InBuf.size());
+				if (InLen == 0)
+				{
+					if (InMember)
+						throw Error(_T("Unexpected end of compressed data."), __TFILE__, __LINE__);
+					break;
+				}
+				if (FirstInput)
+				{
+					m_Gzip = (InLen >= 2 && (uint8)InBuf[0] == 0x1F && (uint8)InBuf[1] == 0x8B);
+					FirstInput = false;
+				}
+				ZStream.next_in = (Bytef*)&InBuf[0];
+				ZStream.avail_in = (uInt)InLen;
+			}
+
+			// Next member of concatenated gzip file
+			if (!InMember)
+			{
+				if (!m_Gzip)
+					throw Error(_T("Unexpected data after the end of zlib stream."), __TFILE__, __LINE__);
+				R = inflateReset(&ZStream);
+				if (R != Z_OK)
+					throw ZlibError(R, _T("inflateReset"), __TFILE__, __LINE__);
+				InMember = true;
+				MemberStartOut = TotalOut;
+			}
+
+			if (ZStream.avail_out == 0)
+			{
+				ZStream.next_out = (Bytef*)&Window[0];
+				ZStream.avail_out = (uInt)DEFLATE_WINDOW_SIZE;
+			}
+
+			// Z_BLOCK stops at every deflate block boundary
+			TotalIn += ZStream.avail_in;
+			TotalOut += ZStream.avail_out;
+			R = inflate(&ZStream, Z_BLOCK);
+			TotalIn -= ZStream.avail_in;
+			TotalOut -= ZStream.avail_out;
+
+			if (R == Z_STREAM_END)
+			{
+				InMember = false;
+				continue;
+			}
+			if (R != Z_OK && R != Z_BUF_ERROR)
+				throw ZlibError(R == Z_NEED_DICT ? Z_DATA_ERROR : R, _T("Cannot decompress data."), __TFILE__, __LINE__);
+
+			// Bit 7 - end of block or header, bit 6 - last block of the stream
+			if ((ZStream.data_type & 128) != 0 && (ZStream.data_type & 64) == 0 &&
+				(TotalOut == MemberStartOut || TotalOut - LastPointOut >= Span))
+			{
+				m_Points.push_back(ACCESS_POINT());
+				ACCESS_POINT &Point = m_Points.back();
+				Point.UncompressedOffset = TotalOut;
+				Point.CompressedOffset = TotalIn;
+				Point.Bits = (uint8)(ZStream.data_type & 7);
+
+				// Linearize the circular buffer and take as much as belongs to this member
+				size_t WindowSize = (size_t)std::min<uint64>(TotalOut - MemberStartOut, DEFLATE_WINDOW_SIZE);
+				size_t Left = ZStream.avail_out;
+				std::vector<char> Linear(DEFLATE_WINDOW_SIZE);
+				if (Left > 0)
+					memcpy(&Linear[0], &Window[DEFLATE_WINDOW_SIZE - Left], Left);
+				if (Left < DEFLATE_WINDOW_SIZE)
+					memcpy(&Linear[Left], &Window[0], DEFLATE_WINDOW_SIZE - Left);
+				Point.Window.assign(Linear.end() - WindowSize, Linear.end());
+
+				LastPointOut = TotalOut;
+			}
+		}
+
+		m_CompressedSize = TotalIn;
+		m_UncompressedSize = TotalOut;
+	}
+	catch (...)
+	{
+		inflateEnd(&ZStream);
+		throw;
+	}
+
+	inflateEnd(&ZStream);
+}
+
+size_t GzipIndex::FindPoint(uint64 UncompressedOffset) const
+{
+	assert(!m_Points.empty());
+
+	size_t Beg = 0, End = m_Points.size();
+	while (End - Beg > 1)
+	{
+		size_t Mid = (Beg + End) / 2;
+		if (m_Points[Mid].UncompressedOffset <= UncompressedOffset)
+			Beg = Mid;
+		else
+			End = Mid;
+	}
+	return Beg;
+}
+
+void GzipIndex::SaveToStream(Stream *s) const
+{
+	s->WriteEx(GZIP_INDEX_MAGIC);
+	s->WriteEx((uint8)(m_Gzip ? 1 : 0));
+	s->WriteEx(m_CompressedSize);
+	s->WriteEx(m_UncompressedSize);
+	s->WriteEx((uint32)m_Points.size());
+	for (size_t i = 0; i < m_Points.size(); i++)
+	{
+		const ACCESS_POINT &Point = m_Points[i];
+		s->WriteEx(Point.UncompressedOffset);
+		s->WriteEx(Point.CompressedOffset);
+		s->WriteEx(Point.Bits);
+		s->WriteEx((uint32)Point.Window.size());
+		if (!Point.Window.empty())
+			s->Write(&Point.Window[0], Point.Window.size());
+	}
+}
+
+void GzipIndex::LoadFromStream(Stream *s)
+{
+	m_Points.clear();
+
+	uint32 Magic, PointCount;
+	uint8 Gzip;
+	s->ReadEx(&Magic);
+	if (Magic != GZIP_INDEX_MAGIC)
+		throw Error(_T("Invalid gzip index header."), __TFILE__, __LINE__);
+	s->ReadEx(&Gzip);
+	s->ReadEx(&m_CompressedSize);
+	s->ReadEx(&m_UncompressedSize);
+	s->ReadEx(&PointCount);
+	m_Gzip = (Gzip != 0);
+
+	// PointCount comes from the file - vector grows with points really read, not to PointCount at once
+	std::vector<ACCESS_POINT> Points;
+	for (uint32 i = 0; i < PointCount; i++)
+	{
+		Points.push_back(ACCESS_POINT());
+		ACCESS_POINT &Point = Points.back();
+		uint32 WindowSize;
+		s->ReadEx(&Point.UncompressedOffset);
+		s->ReadEx(&Point.CompressedOffset);
+		s->ReadEx(&Point.Bits);
+		s->ReadEx(&WindowSize);
+		if (Point.Bits > 7 || WindowSize > DEFLATE_WINDOW_SIZE ||
+			Point.CompressedOffset > m_CompressedSize || Point.UncompressedOffset > m_UncompressedSize ||
+			(i > 0 && Point.UncompressedOffset < Points[i-1].UncompressedOffset))
+			throw Error(Format(_T("Invalid gzip index access point #.")) % i, __TFILE__, __LINE__);
+		Point.Window.resize(WindowSize);
+		if (WindowSize > 0)
+			s->MustRead(&Point.Window[0], WindowSize);
+	}
+	m_Points.swap(Points);
+}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Klasa GzipSeekableDecompressionStream
+
+class GzipSeekableDecompressionStream_pimpl
+{
+public:
+	SeekableStream *m_Stream;
+	const GzipIndex *m_Index;
+	z_stream m_ZStream;
+	bool m_ZStreamInitialized;
+	std::vector<char> m_InBuf;
+	// Position requested by SetPos
+	uint64 m_Pos;
+	// Position of m_ZStream in uncompressed data, valid if m_Started
+	uint64 m_StreamPos;
+	bool m_Started;
+	// Decoding raw deflate data started at an access point - member trailer must be skipped manually
+	bool m_Raw;
+	// Between members of concatenated gzip file
+	bool m_MemberEnd;
+
+	GzipSeekableDecompressionStream_pimpl(SeekableStream *a_Stream, const GzipIndex *Index);
+	~GzipSeekableDecompressionStream_pimpl();
+
+	size_t Read(void *Out, size_t MaxLength);
+
+private:
+	void StartAtPoint(size_t PointIndex);
+	bool FillInput();
+	// Decompresses up to MaxLength bytes at m_StreamPos. Returns 0 only at the end of data.
+	size_t Decompress(char *Out, size_t MaxLength);
+};
+
+GzipSeekableDecompressionStream_pimpl::GzipSeekableDecompressionStream_pimpl(SeekableStream *a_Stream, const GzipIndex *Index) :
+	m_Stream(a_Stream),
+	m_Index(Index),
+	m_ZStreamInitialized(false),
+	m_Pos(0),
+	m_StreamPos(0),
+	m_Started(false),
+	m_Raw(true),
+	m_MemberEnd(false)
+{
+	if (Index->GetPointCount() == 0)
+		throw Error(_T("Gzip index is empty."), __TFILE__, __LINE__);
+	if (a_Stream->GetSize() != Index->GetCompressedSize())
+		throw Error(_T("Gzip index does not match compressed data."), __TFILE__, __LINE__);
+
+	m_InBuf.resize(BUFFER_SIZE);
+
+	m_ZStream.zalloc = Z_NULL;
+	m_ZStream.zfree = Z_NULL;
+	m_ZStream.opaque = Z_NULL;
+	m_ZStream.next_in = Z_NULL;
+	m_ZStream.avail_in = 0;
+	int R = inflateInit2(&m_ZStream, -15);
+	if (R != Z_OK)
+		throw ZlibError(R, _T("Cannot initialize decompression."), __TFILE__, __LINE__);
+	m_ZStreamInitialized = true;
+}
+
+GzipSeekableDecompressionStream_pimpl::~GzipSeekableDecompressionStream_pimpl()
+{
+	if (m_ZStreamInitialized)
+		inflateEnd(&m_ZStream);
+}
+
+bool GzipSeekableDecompressionStream_pimpl::FillInput()
+{
+	if (m_ZStream.avail_in > 0)
+		return true;
+	size_t InLen = m_Stream->Read(&m_InBuf[0], m_InBuf.size());
+	m_ZStream.next_in = (Bytef*)&m_InBuf[0];
+	m_ZStream.avail_in = (uInt)InLen;
+	return InLen > 0;
+}
+
+void GzipSeekableDecompressionStream_pimpl::StartAtPoint(size_t PointIndex)
+{
+	const GzipIndex::ACCESS_POINT &Point = m_Index->GetPoint(PointIndex);
+
+	int R = inflateReset2(&m_ZStream, -15);
+	if (R != Z_OK)
+		throw ZlibError(R, _T("inflateReset2"), __TFILE__, __LINE__);
+	m_ZStream.avail_in = 0;
+
+	if (Point.Bits > 0)
+	{
+		uint8 Byte;
+		m_Stream->SetPos((int64)Point.CompressedOffset - 1);
+		m_Stream->ReadEx(&Byte);
+		R = inflatePrime(&m_ZStream, Point.Bits, Byte >> (8 - Point.Bits));
+		if (R != Z_OK)
+			throw ZlibError(R, _T("inflatePrime"), __TFILE__, __LINE__);
+	}
+	else
+		m_Stream->SetPos((int64)Point.CompressedOffset);
+
+	if (!Point.Window.empty())
+	{
+		R = inflateSetDictionary(&m_ZStream, (const Bytef*)&Point.Window[0], (uInt)Point.Window.size());
+		if (R != Z_OK)
+			throw ZlibError(R, _T("inflateSetDictionary"), __TFILE__, __LINE__);
+	}
+
+	m_StreamPos = Point.UncompressedOffset;
+	m_Raw = true;
+	m_MemberEnd = false;
+	m_Started = true;
+}
+
+size_t GzipSeekableDecompressionStream_pimpl::Decompress(char *Out, size_t MaxLength)
+{
+	m_ZStream.next_out = (Bytef*)Out;
+	m_ZStream.avail_out = (uInt)std::min<size_t>(MaxLength, UINT_MAX);
+	uInt OutLen = m_ZStream.avail_out;
+
+	while (m_ZStream.avail_out == OutLen)
+	{
+		if (m_MemberEnd)
+		{
+			// Raw deflate does not consume the trailer - gzip has CRC32 and ISIZE, zlib has Adler-32
+			if (m_Raw)
+			{
+				size_t TrailerSize = m_Index->IsGzip() ? 8 : 4;
+				while (TrailerSize > 0)
+				{
+					if (!FillInput())
+						throw Error(_T("Unexpected end of compressed data."), __TFILE__, __LINE__);
+					size_t Skip = std::min<size_t>(TrailerSize, m_ZStream.avail_in);
+					m_ZStream.next_in += Skip;
+					m_ZStream.avail_in -= (uInt)Skip;
+					TrailerSize -= Skip;
+				}
+			}
+			if (!FillInput())
+				return 0;
+			// Next gzip member starts with its own header
+			int R = inflateReset2(&m_ZStream, 15 + 16);
+			if (R != Z_OK)
+				throw ZlibError(R, _T("inflateReset2"), __TFILE__, __LINE__);
+			m_Raw = false;
+			m_MemberEnd = false;
+		}
+
+		if (!FillInput())
+			throw Error(_T("Unexpected end of compressed data."), __TFILE__, __LINE__);
+
+		int R = inflate(&m_ZStream, Z_NO_FLUSH);
+		if (R == Z_STREAM_END)
+			m_MemberEnd = true;
+		else if (R != Z_OK && R != Z_BUF_ERROR)
+			throw ZlibError(R == Z_NEED_DICT ? Z_DATA_ERROR : R, _T("Cannot decompress data."), __TFILE__, __LINE__);
+	}
+
+	size_t Decompressed = OutLen - m_ZStream.avail_out;
+	m_StreamPos += Decompressed;
+	return Decompressed;
+}
+
+size_t GzipSeekableDecompressionStream_pimpl::Read(void *Out, size_t MaxLength)
+{
+	if (MaxLength == 0 || m_Pos >= m_Index->GetUncompressedSize())
+		return 0;
+
+	// Going backward or farther than the next access point - start from the access point
+	size_t PointIndex = m_Index->FindPoint(m_Pos);
+	if (!m_Started || m_Pos < m_StreamPos || m_Index->GetPoint(PointIndex).UncompressedOffset > m_StreamPos)
+		StartAtPoint(PointIndex);
+
+	// Skip data between current stream position and the requested one
+	if (m_StreamPos < m_Pos)
+	{
+		std::vector<char> Discard(BUFFER_SIZE);
+		while (m_StreamPos < m_Pos)
+		{
+			if (Decompress(&Discard[0], (size_t)std::min<uint64>(Discard.size(), m_Pos - m_StreamPos)) == 0)
+				throw Error(_T("Unexpected end of compressed data."), __TFILE__, __LINE__);
+		}
+	}
+
+	char *Dst = (char*)Out;
+	size_t Total = 0;
+	while (Total < MaxLength)
+	{
+		size_t Len = Decompress(Dst + Total, MaxLength - Total);
+		if (Len == 0)
+			break;
+		Total += Len;
+	}
+	m_Pos = m_StreamPos;
+	return Total;
+}
+
+GzipSeekableDecompressionStream::GzipSeekableDecompressionStream(SeekableStream *a_Stream, const GzipIndex *Index) :
+	pimpl(new GzipSeekableDecompressionStream_pimpl(a_Stream, Index))
+{
+}
+
+GzipSeekableDecompressionStream::~GzipSeekableDecompressionStream()
+{
+	pimpl.reset();
+}
+
+SeekableStream * GzipSeekableDecompressionStream::GetStream()
+{
+	return pimpl->m_Stream;
+}
+
+size_t GzipSeekableDecompressionStream::Read(void *Out, size_t MaxLength)
+{
+	return pimpl->Read(Out, MaxLength);
+}
+
+bool GzipSeekableDecompressionStream::End()
+{
+	return pimpl->m_Pos >= pimpl->m_Index->GetUncompressedSize();
+}
+
+uint64 GzipSeekableDecompressionStream::GetSize()
+{
+	return pimpl->m_Index->GetUncompressedSize();
+}
+
+int64 GzipSeekableDecompressionStream::GetPos()
+{
+	return (int64)pimpl->m_Pos;
+}
+
+void GzipSeekableDecompressionStream::SetPos(int64 pos)
+{
+	if (pos < 0)
+		throw Error(_T("Cannot set negative position in GzipSeekableDecompressionStream."), __TFILE__, __LINE__);
+	pimpl->m_Pos = (uint64)pos;
+}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Klasa GzipFileStream
+
+class GzipFileWriterThread;
+
+class GzipFileStream_pimpl
+{
+public:
+	gzFile File;
+	char OneCharBuf;
+	bool m_End;
+
+	// ----- Used only in GZFM_WRITE_ASYNC mode -----
+
+	struct ASYNC_ITEM
+	{
+		// Index to m_Buffers, NO_BUFFER for flush request without data
+		size_t BufferIndex;
+		size_t Length;
+		bool Flush;
+	};
+	static const size_t NO_BUFFER = (size_t)-1;
+
+	bool m_Async;
+	size_t m_BufferSize;
+	size_t m_MaxBufferCount;
+	// Protects everything below except m_Current* which belong to the writing thread
+	Mutex m_Mutex;
+	// Signalled when item was queued or m_ThreadEnd was set. Background thread waits.
+	Cond m_QueueNotEmptyOrExit;
+	// Signalled when buffer was returned to m_FreeBuffers or background thread became idle. Writer waits.
+	Cond m_BufferFreeOrIdle;
+	std::vector< std::vector<char> > m_Buffers;
+	std::deque<size_t> m_FreeBuffers;
+	std::deque<ASYNC_ITEM> m_Queue;
+	// Background thread is processing an item taken from the queue
+	bool m_Busy;
+	bool m_ThreadEnd;
+	bool m_HasError;
+	tstring m_ErrorMsg;
+	scoped_ptr<GzipFileWriterThread> m_Thread;
+	size_t m_CurrentIndex;
+	size_t m_CurrentLength;
+
+	GzipFileStream_pimpl() : File(NULL), m_End(false), m_Async(false), m_Mutex(0), m_Busy(false), m_ThreadEnd(false), m_HasError(false), m_CurrentIndex(NO_BUFFER), m_CurrentLength(0) { }
+
+	void CheckOpen();
+	void WriteAsync(const void *Data, size_t Size);
+	void FlushAsync();
+	void StopThread();
+	void ThreadFunc();
+
+private:
+	// Throws error reported by background thread. Mutex must be locked.
+	void ThrowAsyncError();
+	void AcquireBuffer();
+	void Submit(bool Flush);
+};
+
+class GzipFileWriterThread : public Thread
+{
+private:
+	GzipFileStream_pimpl *m_Pimpl;
+
+protected:
+	virtual void Run() { m_Pimpl->ThreadFunc(); }
+
+public:
+	GzipFileWriterThread(GzipFileStream_pimpl *Pimpl) : m_Pimpl(Pimpl) { }
+};
+
+void GzipFileStream_pimpl::CheckOpen()
+{
+	if (File == NULL)
+		throw Error(_T("GzipFileStream is closed."), __TFILE__, __LINE__);
+}
+
+void GzipFileStream_pimpl::ThrowAsyncError()
+{
+	tstring Msg;
+	Msg.swap(m_ErrorMsg);
+	// Background thread discards all further data, so following calls fail too
+	m_ErrorMsg = _T("Previous background write to gzip file failed.");
+	throw Error(Msg, __TFILE__, __LINE__);
+}
+
+void GzipFileStream_pimpl::AcquireBuffer()
+{
+	MUTEX_LOCK(m_Mutex);
+	while (m_FreeBuffers.empty() && m_Buffers.size() == m_MaxBufferCount && !m_HasError)
+		m_BufferFreeOrIdle.Wait(&m_Mutex);
+	if (m_HasError)
+		ThrowAsyncError();
+
+	if (m_FreeBuffers.empty())
+	{
+		m_Buffers.push_back(std::vector<char>(m_BufferSize));
+		m_CurrentIndex = m_Buffers.size() - 1;
+	}
+	else
+	{
+		m_CurrentIndex = m_FreeBuffers.front();
+		m_FreeBuffers.pop_front();
+	}
+	m_CurrentLength = 0;
+}
+
+void GzipFileStream_pimpl::Submit(bool Flush)
+{
+	ASYNC_ITEM Item;
+	Item.BufferIndex = m_CurrentIndex;
+	Item.Length = m_CurrentLength;
+	Item.Flush = Flush;
+
+	MUTEX_LOCK(m_Mutex);
+	m_Queue.push_back(Item);
+	m_QueueNotEmptyOrExit.Signal();
+	m_CurrentIndex = NO_BUFFER;
+	m_CurrentLength = 0;
+}
+
+void GzipFileStream_pimpl::WriteAsync(const void *Data, size_t Size)
+{
+	const char *Src = (const char*)Data;
+	while (Size > 0)
+	{
+		if (m_CurrentIndex == NO_BUFFER)
+			AcquireBuffer();
+		// m_Buffers is modified only by AcquireBuffer on this thread and never reallocated, so no lock is needed here
+		std::vector<char> &Buf = m_Buffers[m_CurrentIndex];
+		size_t ToCopy = std::min(Size, m_BufferSize - m_CurrentLength);
+		memcpy(&Buf[m_CurrentLength], Src, ToCopy);
+		m_CurrentLength += ToCopy;
+		Src += ToCopy;
+		Size -= ToCopy;
+		if (m_CurrentLength == m_BufferSize)
+			Submit(false);
+	}
+}
+
+void GzipFileStream_pimpl::FlushAsync()
+{
+	Submit(true);
+
+	MUTEX_LOCK(m_Mutex);
+	while (!m_Queue.empty() || m_Busy)
+		m_BufferFreeOrIdle.Wait(&m_Mutex);
+	if (m_HasError)
+		ThrowAsyncError();
+}
+
+void GzipFileStream_pimpl::StopThread()
+{
+	if (m_Thread == NULL)
+		return;
+	if (m_CurrentIndex != NO_BUFFER)
+		Submit(false);
+	{
+		MUTEX_LOCK(m_Mutex);
+		m_ThreadEnd = true;
+		m_QueueNotEmptyOrExit.Signal();
+	}
+	m_Thread->Join();
+	m_Thread.reset();
+}
+
+void GzipFileStream_pimpl::ThreadFunc()
+{
+	for (;;)
+	{
+		ASYNC_ITEM Item;
+		bool Discard;
+		const char *Data;
+		{
+			MUTEX_LOCK(m_Mutex);
+			while (m_Queue.empty() && !m_ThreadEnd)
+				m_QueueNotEmptyOrExit.Wait(&m_Mutex);
+			// Kończymy dopiero kiedy kolejka jest pusta
+			if (m_Queue.empty())
+				break;
+			Item = m_Queue.front();
+			m_Queue.pop_front();
+			m_Busy = true;
+			Discard = m_HasError;
+			Data = (Item.BufferIndex != NO_BUFFER ? &m_Buffers[Item.BufferIndex][0] : NULL);
+		}
+
+		tstring ErrorMsg;
+		bool Failed = false;
+		if (!Discard)
+		{
+			if (Item.Length > 0 && gzwrite(File, Data, (unsigned)Item.Length) != (int)Item.Length)
+			{
+				int ErrNum;
+				const char *ErrMsg = gzerror(File, &ErrNum);
+				ErrorMsg = Format(_T("Cannot write to gzip file - #.")) % StringToTstringR(ErrMsg);
+				Failed = true;
+			}
+			else if (Item.Flush)
+			{
+				int R = gzflush(File, Z_SYNC_FLUSH);
+				if (R != Z_OK)
+				{
+					ZlibError(R, _T("zlib.GzipFileStream.Flush"), __TFILE__, __LINE__).GetMessage_(&ErrorMsg);
+					Failed = true;
+				}
+			}
+		}
+
+		{
+			MUTEX_LOCK(m_Mutex);
+			if (Failed && !m_HasError)
+			{
+				m_HasError = true;
+				m_ErrorMsg = ErrorMsg;
+			}
+			if (Item.BufferIndex != NO_BUFFER)
+				m_FreeBuffers.push_back(Item.BufferIndex);
+			m_Busy = false;
+			m_BufferFreeOrIdle.Broadcast();
+		}
+	}
+}
+
+GzipFileStream::GzipFileStream(const string &FileName, GZIP_FILE_MODE Mode, int Level, size_t AsyncBufferSize, uint AsyncQueueLength) :
+	pimpl(new GzipFileStream_pimpl)
+{
+	if (Mode == GZFM_WRITE_ASYNC && (AsyncBufferSize == 0 || AsyncBufferSize > UINT_MAX || AsyncQueueLength == 0))
+		throw Error(_T("Invalid parameters of asynchronous gzip file writing."), __TFILE__, __LINE__);
+
+	char ModeSz[4];
+	ModeSz[0] = (Mode == GZFM_READ ? 'r' : 'w');
+	ModeSz[1] = 'b';
+	if (Level == Z_DEFAULT_COMPRESSION)
+		ModeSz[2] = '\0';
+	else
+	{
+		ModeSz[2] = (char)(Level + '0');
+		ModeSz[3] = '\0';
+	}
+
+	pimpl->File = gzopen(FileName.c_str(), ModeSz);
+
+	if (pimpl->File == NULL)
+	{
+		if (errno == 0)
+			throw ZlibError(Z_MEM_ERROR, _T("Cannot open gzip file: ") + StringToTstringR(FileName), __TFILE__, __LINE__);
+		else
+			throw ErrnoError(_T("Cannot open gzip file: ") + StringToTstringR(FileName), __TFILE__, __LINE__);
+	}
+
+	if (Mode == GZFM_READ)
+	{
+		int R = gzread(pimpl->File, &pimpl->OneCharBuf, 1);
+		if (R == -1)
+			throw Error(_T("Cannot read first byte from gzip file"), __TFILE__, __LINE__);
+		pimpl->m_End = (R == 0);
+	}
+	else if (Mode == GZFM_WRITE_ASYNC)
+	{
+		pimpl->m_Async = true;
+		pimpl->m_BufferSize = AsyncBufferSize;
+		// Queued buffers + one being filled + one being compressed
+		pimpl->m_MaxBufferCount = AsyncQueueLength + 2;
+		// Reserved up front, so that background thread can use buffers while new ones are added
+		pimpl->m_Buffers.reserve(pimpl->m_MaxBufferCount);
+	#if ZLIB_VERNUM >= 0x1240
+		// Bigger internal buffer means fewer write calls on the background thread
+		gzbuffer(pimpl->File, 128 * 1024);
+	#endif
+		pimpl->m_Thread.reset(new GzipFileWriterThread(pimpl.get()));
+		pimpl->m_Thread->Start();
+	}
+}
+
+GzipFileStream::~GzipFileStream()
+{
+	// Błędy zapisu są tu ignorowane - kto chce je dostać, powinien wywołać Close
+	pimpl->StopThread();
+	if (pimpl->File != NULL)
+		gzclose(pimpl->File);
+}
+
+void GzipFileStream::Close()
+{
+	pimpl->CheckOpen();
+
+	bool HasError = false;
+	tstring ErrorMsg;
+	if (pimpl->m_Async)
+	{
+		pimpl->StopThread();
+		HasError = pimpl->m_HasError;
+		ErrorMsg = pimpl->m_ErrorMsg;
+	}
+
+	int R = gzclose(pimpl->File);
+	pimpl->File = NULL;
+	if (HasError)
+		throw Error(ErrorMsg, __TFILE__, __LINE__);
+	if (R != Z_OK)
+		throw ZlibError(R, _T("Cannot close gzip file."), __TFILE__, __LINE__);
+}
+
+void GzipFileStream::Write(const void *Data, size_t Size)
+{
+	pimpl->CheckOpen();
+	if (pimpl->m_Async)
+	{
+		pimpl->WriteAsync(Data, Size);
+		return;
+	}
+
+    assert(Size <= UINT_MAX);
+	size_t Written = (size_t)gzwrite(pimpl->File, Data, (unsigned int)Size);
+	if (Written != Size)
+		throw Error(Format(_T("Cannot write to gzip file - #/# bytes written.")) % Written % Size, __TFILE__, __LINE__);
+}
+
+void GzipFileStream::Flush()
+{
+	pimpl->CheckOpen();
+	if (pimpl->m_Async)
+	{
+		pimpl->FlushAsync();
+		return;
+	}
+
+	int R = gzflush(pimpl->File, Z_SYNC_FLUSH);
+	if (R != Z_OK)
+		throw ZlibError(R, _T("zlib.GzipFileStream.Flush"), __TFILE__, __LINE__);
+}
+
+size_t GzipFileStream::Read(void *Out, size_t MaxLength)
+{
+	if (pimpl->m_End) return 0;
+	if (MaxLength == 0) return 0;
+	pimpl->CheckOpen();
+
+	char *Out2 = (char*)Out;
+	*Out2 = pimpl->OneCharBuf;
+	MaxLength--;
+	Out2++;
+
+    assert(MaxLength <= UINT_MAX);
+
+	int BytesRead = gzread(pimpl->File, Out2, (unsigned int)MaxLength);
+
+	if (BytesRead == -1)
+		throw Error(Format(_T("Cannot read # bytes from gzip file.")) % (MaxLength+1), __TFILE__, __LINE__);
+	else if ((size_t)BytesRead < MaxLength)
+		pimpl->m_End = 0;
+	else
+	{
+		int R = gzread(pimpl->File, &pimpl->OneCharBuf, 1);
+		if (R == -1)
+			throw Error(_T("Cannot read byte from gzip file."), __TFILE__, __LINE__);
+		pimpl->m_End = (R == 0);
+	}
+
+	return (size_t)BytesRead + 1;
+}
+
+bool GzipFileStream::End()
+{
+	return pimpl->m_End;
+}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Chunked container - common part
+
+static const uint32 CHUNKED_HEADER_MAGIC = 0x31435A43; // "CZC1"
+static const uint32 CHUNKED_FOOTER_MAGIC = 0x45435A43; // "CZCE"
+static const size_t CHUNKED_HEADER_SIZE = 8;
+static const size_t CHUNKED_INDEX_ENTRY_SIZE = 20;
+static const size_t CHUNKED_FOOTER_SIZE = 40;
+
+struct CHUNKED_INDEX_ENTRY
+{
+	uint64 CompressedOffset;
+	uint32 CompressedSize;
+	uint32 UncompressedSize;
+	uint32 CRC;
+	// Not stored in the file - calculated while loading the index
+	uint64 UncompressedOffset;
+};
+
+// Compresses one chunk. Used as a ThreadTask or run directly on the calling thread.
+class ChunkCompressTask : public ThreadTask
+{
+public:
+	std::vector<char> m_In;
+	size_t m_InSize;
+	std::vector<char> m_Out;
+	size_t m_OutSize;
+	uint32 m_CRC;
+	int m_Level;
+
+	virtual void Run();
+};
+
+void ChunkCompressTask::Run()
+{
+	m_CRC = CRC32_Calc::Calc(m_InSize ? &m_In[0] : NULL, m_InSize);
+
+	uLongf DestLen = compressBound((uLong)m_InSize);
+	if (m_Out.size() < (size_t)DestLen)
+		m_Out.resize(DestLen);
+	int R = compress2((Bytef*)&m_Out[0], &DestLen, (const Bytef*)(m_InSize ? &m_In[0] : NULL), (uLong)m_InSize, m_Level);
+	if (R != Z_OK)
+		throw ZlibError(R, _T("Cannot compress chunk."), __TFILE__, __LINE__);
+	m_OutSize = DestLen;
+}
+
+// Decompresses one chunk straight to the destination memory and checks its CRC.
+class ChunkDecompressTask : public ThreadTask
+{
+public:
+	std::vector<char> m_In;
+	const CHUNKED_INDEX_ENTRY *m_Entry;
+	size_t m_ChunkIndex;
+	char *m_Out;
+
+	virtual void Run();
+};
+
+void ChunkDecompressTask::Run()
+{
+	uLongf DestLen = (uLongf)m_Entry->UncompressedSize;
+	if (DestLen > 0 || m_Entry->CompressedSize > 0)
+	{
+		int R = uncompress((Bytef*)m_Out, &DestLen, (const Bytef*)&m_In[0], (uLong)m_Entry->CompressedSize);
+		if (R != Z_OK)
+			throw ZlibError(R, Format(_T("Cannot decompress chunk #.")) % m_ChunkIndex, __TFILE__, __LINE__);
+	}
+	if (DestLen != m_Entry->UncompressedSize)
+		throw Error(Format(_T("Chunk # has invalid uncompressed size: # instead of #.")) % m_ChunkIndex % (uint32)DestLen % m_Entry->UncompressedSize, __TFILE__, __LINE__);
+	if (CRC32_Calc::Calc(m_Out, DestLen) != m_Entry->CRC)
+		throw Error(Format(_T("Chunk # is corrupted - CRC32 mismatch.")) % m_ChunkIndex, __TFILE__, __LINE__);
+}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Klasa ChunkedCompressionStream
+
+class ChunkedCompressionStream_pimpl
+{
+public:
+	Stream *m_Stream;
+	size_t m_ChunkSize;
+	scoped_ptr<ThreadPool> m_Pool;
+	// Batch of chunks compressed together - only first m_FilledCount are used
+	std::vector<ChunkCompressTask> m_Tasks;
+	size_t m_FilledCount;
+	std::vector<CHUNKED_INDEX_ENTRY> m_Index;
+	uint64 m_CompressedOffset;
+	uint64 m_UncompressedSize;
+	bool m_Finished;
+
+	ChunkedCompressionStream_pimpl(Stream *a_Stream, size_t ChunkSize, int Level, uint ThreadCount);
+
+	void Write(const void *Data, size_t Size);
+	void Flush();
+	void Finish();
+
+private:
+	// Closes the chunk being filled, compresses the batch if it is complete or Force
+	void CloseChunk(bool Force);
+	void ProcessBatch();
+};
+
+ChunkedCompressionStream_pimpl::ChunkedCompressionStream_pimpl(Stream *a_Stream, size_t ChunkSize, int Level, uint ThreadCount) :
+	m_Stream(a_Stream),
+	m_ChunkSize(ChunkSize),
+	m_FilledCount(0),
+	m_CompressedOffset(CHUNKED_HEADER_SIZE),
+	m_UncompressedSize(0),
+	m_Finished(false)
+{
+	if (ChunkSize == 0 || ChunkSize > 0x7FFFFFFF)
+		throw Error(Format(_T("Invalid chunk size: #.")) % ChunkSize, __TFILE__, __LINE__);
+
+	if (ThreadCount == 0)
+		ThreadCount = ThreadPool::GetHardwareThreadCount();
+	if (ThreadCount > 1)
+		m_Pool.reset(new ThreadPool(ThreadCount));
+
+	// Two chunks per thread, so that threads which finish early have some more work
+	m_Tasks.resize(ThreadCount > 1 ? ThreadCount * 2 : 1);
+	for (size_t i = 0; i < m_Tasks.size(); i++)
+	{
+		m_Tasks[i].m_InSize = 0;
+		m_Tasks[i].m_Level = Level;
+	}
+
+	m_Stream->WriteEx(CHUNKED_HEADER_MAGIC);
+	m_Stream->WriteEx((uint32)ChunkSize);
+}
+
+void ChunkedCompressionStream_pimpl::Write(const void *Data, size_t Size)
+{
+	if (m_Finished)
+		throw Error(_T("Cannot write to ChunkedCompressionStream - already finished."), __TFILE__, __LINE__);
+
+	const char *Src = (const char*)Data;
+	while (Size > 0)
+	{
+		ChunkCompressTask &Task = m_Tasks[m_FilledCount];
+		if (Task.m_In.size() < m_ChunkSize)
+			Task.m_In.resize(m_ChunkSize);
+
+		size_t ToCopy = std::min(Size, m_ChunkSize - Task.m_InSize);
+		memcpy(&Task.m_In[Task.m_InSize], Src, ToCopy);
+		Task.m_InSize += ToCopy;
+		Src += ToCopy;
+		Size -= ToCopy;
+
+		if (Task.m_InSize == m_ChunkSize)
+			CloseChunk(false);
+	}
+}
+
+void ChunkedCompressionStream_pimpl::CloseChunk(bool Force)
+{
+	if (m_Tasks[m_FilledCount].m_InSize > 0)
+		m_FilledCount++;
+	if (m_FilledCount > 0 && (Force || m_FilledCount == m_Tasks.size()))
+		ProcessBatch();
+}
+
+void ChunkedCompressionStream_pimpl::ProcessBatch()
+{
+	if (m_Pool != NULL && m_FilledCount > 1)
+	{
+		for (size_t i = 0; i < m_FilledCount; i++)
+			m_Pool->AddTask(&m_Tasks[i]);
+		m_Pool->WaitAll();
+	}
+	else
+	{
+		for (size_t i = 0; i < m_FilledCount; i++)
+			m_Tasks[i].Run();
+	}
+
+	for (size_t i = 0; i < m_FilledCount; i++)
+	{
+		ChunkCompressTask &Task = m_Tasks[i];
+		m_Stream->Write(&Task.m_Out[0], Task.m_OutSize);
+
+		CHUNKED_INDEX_ENTRY Entry;
+		Entry.CompressedOffset = m_CompressedOffset;
+		Entry.CompressedSize = (uint32)Task.m_OutSize;
+		Entry.UncompressedSize = (uint32)Task.m_InSize;
+		Entry.CRC = Task.m_CRC;
+		Entry.UncompressedOffset = m_UncompressedSize;
+		m_Index.push_back(Entry);
+
+		m_CompressedOffset += Task.m_OutSize;
+		m_UncompressedSize += Task.m_InSize;
+		Task.m_InSize = 0;
+	}
+	m_FilledCount = 0;
+}
+
+void ChunkedCompressionStream_pimpl::Flush()
+{
+	if (m_Finished) return;
+
+	CloseChunk(true);
+	m_Stream->Flush();
+}
+
+void ChunkedCompressionStream_pimpl::Finish()
+{
+	if (m_Finished) return;
+
+	CloseChunk(true);
+	m_Finished = true;
+
+	VectorStream IndexData;
+	IndexData.SetCapacity(m_Index.size() * CHUNKED_INDEX_ENTRY_SIZE);
+	for (size_t i = 0; i < m_Index.size(); i++)
+	{
+		IndexData.WriteEx(m_Index[i].CompressedOffset);
+		IndexData.WriteEx(m_Index[i].CompressedSize);
+		IndexData.WriteEx(m_Index[i].UncompressedSize);
+		IndexData.WriteEx(m_Index[i].CRC);
+	}
+	MD5_SUM IndexMD5;
+	MD5_Calc::Calc(&IndexMD5, IndexData.Data(), (size_t)IndexData.GetSize());
+
+	if (IndexData.GetSize() > 0)
+		m_Stream->Write(IndexData.Data(), (size_t)IndexData.GetSize());
+	m_Stream->WriteEx(m_CompressedOffset);
+	m_Stream->WriteEx((uint32)m_Index.size());
+	m_Stream->WriteEx(m_UncompressedSize);
+	m_Stream->WriteEx(IndexMD5);
+	m_Stream->WriteEx(CHUNKED_FOOTER_MAGIC);
+	m_Stream->Flush();
+}
+
+ChunkedCompressionStream::ChunkedCompressionStream(Stream *a_Stream, size_t ChunkSize, int Level, uint ThreadCount) :
+	OverlayStream(a_Stream),
+	pimpl(new ChunkedCompressionStream_pimpl(a_Stream, ChunkSize, Level, ThreadCount))
+{
+}
+
+ChunkedCompressionStream::~ChunkedCompressionStream()
+{
+	try
+	{
+		pimpl->Finish();
+	}
+	catch (...)
+	{
+		assert(0 && "ChunkedCompressionStream.dtor - exception.");
+	}
+}
+
+void ChunkedCompressionStream::Write(const void *Data, size_t Size)
+{
+	pimpl->Write(Data, Size);
+}
+
+void ChunkedCompressionStream::Flush()
+{
+	pimpl->Flush();
+}
+
+void ChunkedCompressionStream::Finish()
+{
+	pimpl->Finish();
+}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Klasa ChunkedDecompressionStream
+
+class ChunkedDecompressionStream_pimpl
+{
+public:
+	SeekableStream *m_Stream;
+	// Position of the header in m_Stream
+	uint64 m_Base;
+	size_t m_ChunkSize;
+	std::vector<CHUNKED_INDEX_ENTRY> m_Index;
+	uint64 m_UncompressedSize;
+	uint64 m_Pos;
+	scoped_ptr<ThreadPool> m_Pool;
+	std::vector<ChunkDecompressTask> m_Tasks;
+	// Cache for partial reads
+	std::vector<char> m_Cache;
+	size_t m_CacheChunk; // MAXUINT32 if empty
+
+	ChunkedDecompressionStream_pimpl(SeekableStream *a_Stream, uint ThreadCount);
+
+	void LoadIndex();
+	size_t FindChunk(uint64 Pos);
+	// Decompresses chunks [First, First+Count) into consecutive memory at Out. Count <= m_Tasks.size().
+	void DecompressChunks(size_t First, size_t Count, char *Out);
+	void EnsureCached(size_t ChunkIndex);
+	size_t Read(void *Out, size_t MaxLength);
+	void Verify();
+};
+
+ChunkedDecompressionStream_pimpl::ChunkedDecompressionStream_pimpl(SeekableStream *a_Stream, uint ThreadCount) :
+	m_Stream(a_Stream),
+	m_Pos(0),
+	m_CacheChunk(MAXUINT32)
+{
+	if (ThreadCount == 0)
+		ThreadCount = ThreadPool::GetHardwareThreadCount();
+	if (ThreadCount > 1)
+		m_Pool.reset(new ThreadPool(ThreadCount));
+	m_Tasks.resize(ThreadCount > 1 ? ThreadCount * 2 : 1);
+
+	LoadIndex();
+}
+
+void ChunkedDecompressionStream_pimpl::LoadIndex()
+{
+	m_Base = (uint64)m_Stream->GetPos();
+	uint64 StreamSize = m_Stream->GetSize();
+	if (StreamSize < m_Base + CHUNKED_HEADER_SIZE + CHUNKED_FOOTER_SIZE)
+		throw Error(_T("Chunked container is too short."), __TFILE__, __LINE__);
+	uint64 ContainerSize = StreamSize - m_Base;
+
+	uint32 Magic, ChunkSize;
+	m_Stream->ReadEx(&Magic);
+	m_Stream->ReadEx(&ChunkSize);
+	if (Magic != CHUNKED_HEADER_MAGIC || ChunkSize == 0 || ChunkSize > 0x7FFFFFFF)
+		throw Error(_T("Invalid chunked container header."), __TFILE__, __LINE__);
+	m_ChunkSize = ChunkSize;
+
+	m_Stream->SetPos((int64)(StreamSize - CHUNKED_FOOTER_SIZE));
+	uint64 IndexOffset;
+	uint32 ChunkCount;
+	MD5_SUM IndexMD5;
+	m_Stream->ReadEx(&IndexOffset);
+	m_Stream->ReadEx(&ChunkCount);
+	m_Stream->ReadEx(&m_UncompressedSize);
+	m_Stream->ReadEx(&IndexMD5);
+	m_Stream->ReadEx(&Magic);
+	if (Magic != CHUNKED_FOOTER_MAGIC)
+		throw Error(_T("Invalid chunked container footer."), __TFILE__, __LINE__);
+	if (IndexOffset < CHUNKED_HEADER_SIZE ||
+		IndexOffset + (uint64)ChunkCount * CHUNKED_INDEX_ENTRY_SIZE != ContainerSize - CHUNKED_FOOTER_SIZE)
+	{
+		throw Error(_T("Invalid chunked container index location."), __TFILE__, __LINE__);
+	}
+
+	std::vector<char> IndexData(ChunkCount * CHUNKED_INDEX_ENTRY_SIZE);
+	MD5_SUM ActualMD5;
+	if (ChunkCount > 0)
+	{
+		m_Stream->SetPos((int64)(m_Base + IndexOffset));
+		m_Stream->MustRead(&IndexData[0], IndexData.size());
+	}
+	MD5_Calc::Calc(&ActualMD5, IndexData.empty() ? NULL : &IndexData[0], IndexData.size());
+	if (ActualMD5 != IndexMD5)
+		throw Error(_T("Chunked container index is corrupted - MD5 mismatch."), __TFILE__, __LINE__);
+
+	m_Index.resize(ChunkCount);
+	uint64 UncompressedOffset = 0;
+	if (ChunkCount > 0)
+	{
+		MemoryStream IndexStream(IndexData.size(), &IndexData[0]);
+		for (uint32 i = 0; i < ChunkCount; i++)
+		{
+			CHUNKED_INDEX_ENTRY &Entry = m_Index[i];
+			IndexStream.ReadEx(&Entry.CompressedOffset);
+			IndexStream.ReadEx(&Entry.CompressedSize);
+			IndexStream.ReadEx(&Entry.UncompressedSize);
+			IndexStream.ReadEx(&Entry.CRC);
+			Entry.UncompressedOffset = UncompressedOffset;
+			UncompressedOffset += Entry.UncompressedSize;
+			if (Entry.CompressedOffset < CHUNKED_HEADER_SIZE || Entry.CompressedOffset + Entry.CompressedSize > IndexOffset)
+				throw Error(Format(_T("Chunk # lies outside of the container.")) % i, __TFILE__, __LINE__);
+			// MD5 detects only accidental damage - size of the chunk buffer must not come from the file unchecked
+			if (Entry.UncompressedSize > m_ChunkSize)
+				throw Error(Format(_T("Chunk # is larger than chunk size.")) % i, __TFILE__, __LINE__);
+		}
+	}
+	if (UncompressedOffset != m_UncompressedSize)
+		throw Error(_T("Chunked container index is inconsistent with total size."), __TFILE__, __LINE__);
+}
+
+size_t ChunkedDecompressionStream_pimpl::FindChunk(uint64 Pos)
+{
+	assert(Pos < m_UncompressedSize);
+
+	// Last chunk starting at or before Pos
+	size_t Beg = 0, End = m_Index.size();
+	while (End - Beg > 1)
+	{
+		size_t Mid = (Beg + End) / 2;
+		if (m_Index[Mid].UncompressedOffset <= Pos)
+			Beg = Mid;
+		else
+			End = Mid;
+	}
+	return Beg;
+}
+
+void ChunkedDecompressionStream_pimpl::DecompressChunks(size_t First, size_t Count, char *Out)
+{
+	assert(Count > 0 && Count <= m_Tasks.size());
+
+	// Reading from the underlying stream must be sequential
+	for (size_t i = 0; i < Count; i++)
+	{
+		ChunkDecompressTask &Task = m_Tasks[i];
+		Task.m_ChunkIndex = First + i;
+		Task.m_Entry = &m_Index[First + i];
+		Task.m_Out = Out;
+		Out += Task.m_Entry->UncompressedSize;
+
+		Task.m_In.resize(std::max<size_t>(1, Task.m_Entry->CompressedSize));
+		m_Stream->SetPos((int64)(m_Base + Task.m_Entry->CompressedOffset));
+		m_Stream->MustRead(&Task.m_In[0], Task.m_Entry->CompressedSize);
+	}
+
+	if (m_Pool != NULL && Count > 1)
+	{
+		for (size_t i = 0; i < Count; i++)
+			m_Pool->AddTask(&m_Tasks[i]);
+		m_Pool->WaitAll();
+	}
+	else
+	{
+		for (size_t i = 0; i < Count; i++)
+			m_Tasks[i].Run();
+	}
+}
+
+void ChunkedDecompressionStream_pimpl::EnsureCached(size_t ChunkIndex)
+{
+	if (m_CacheChunk == ChunkIndex)
+		return;
+
+	m_CacheChunk = MAXUINT32;
+	m_Cache.resize(std::max<size_t>(1, m_Index[ChunkIndex].UncompressedSize));
+	DecompressChunks(ChunkIndex, 1, &m_Cache[0]);
+	m_CacheChunk = ChunkIndex;
+}
+
+size_t ChunkedDecompressionStream_pimpl::Read(void *Out, size_t MaxLength)
+{
+	char *Dst = (char*)Out;
+	size_t Total = 0;
+
+	while (MaxLength > 0 && m_Pos < m_UncompressedSize)
+	{
+		size_t ChunkIndex = FindChunk(m_Pos);
+		const CHUNKED_INDEX_ENTRY &Entry = m_Index[ChunkIndex];
+
+		// Whole chunks go directly to the output, in parallel
+		if (m_Pos == Entry.UncompressedOffset && MaxLength >= Entry.UncompressedSize)
+		{
+			size_t Count = 0, Bytes = 0;
+			while (Count < m_Tasks.size() && ChunkIndex + Count < m_Index.size() &&
+				Bytes + m_Index[ChunkIndex + Count].UncompressedSize <= MaxLength)
+			{
+				Bytes += m_Index[ChunkIndex + Count].UncompressedSize;
+				Count++;
+			}
+			DecompressChunks(ChunkIndex, Count, Dst);
+			Dst += Bytes; Total += Bytes; MaxLength -= Bytes; m_Pos += Bytes;
+		}
+		// Partial chunk - through the cache
+		else
+		{
+			EnsureCached(ChunkIndex);
+			size_t InChunk = (size_t)(m_Pos - Entry.UncompressedOffset);
+			size_t Bytes = std::min(MaxLength, (size_t)Entry.UncompressedSize - InChunk);
+			memcpy(Dst, &m_Cache[InChunk], Bytes);
+			Dst += Bytes; Total += Bytes; MaxLength -= Bytes; m_Pos += Bytes;
+		}
+	}
+
+	return Total;
+}
+
+void ChunkedDecompressionStream_pimpl::Verify()
+{
+	std::vector<char> Buf;
+	for (size_t First = 0; First < m_Index.size(); )
+	{
+		size_t Count = std::min(m_Tasks.size(), m_Index.size() - First);
+		size_t Bytes = 0;
+		for (size_t i = 0; i < Count; i++)
+			Bytes += m_Index[First + i].UncompressedSize;
+		Buf.resize(std::max<size_t>(1, Bytes));
+		DecompressChunks(First, Count, &Buf[0]);
+		First += Count;
+	}
+}
+
+ChunkedDecompressionStream::ChunkedDecompressionStream(SeekableStream *a_Stream, uint ThreadCount) :
+	pimpl(new ChunkedDecompressionStream_pimpl(a_Stream, ThreadCount))
+{
+}
+
+ChunkedDecompressionStream::~ChunkedDecompressionStream()
+{
+	pimpl.reset();
+}
+
+SeekableStream * ChunkedDecompressionStream::GetStream()
+{
+	return pimpl->m_Stream;
+}
+
+uint ChunkedDecompressionStream::GetChunkCount()
+{
+	return (uint)pimpl->m_Index.size();
+}
+
+size_t ChunkedDecompressionStream::GetChunkSize()
+{
+	return pimpl->m_ChunkSize;
+}
+
+void ChunkedDecompressionStream::Verify()
+{
+	pimpl->Verify();
+}
+
+size_t ChunkedDecompressionStream::Read(void *Out, size_t MaxLength)
+{
+	return pimpl->Read(Out, MaxLength);
+}
+
+bool ChunkedDecompressionStream::End()
+{
+	return pimpl->m_Pos >= pimpl->m_UncompressedSize;
+}
+
+uint64 ChunkedDecompressionStream::GetSize()
+{
+	return pimpl->m_UncompressedSize;
+}
+
+int64 ChunkedDecompressionStream::GetPos()
+{
+	return (int64)pimpl->m_Pos;
+}
+
+void ChunkedDecompressionStream::SetPos(int64 pos)
+{
+	if (pos < 0)
+		throw Error(_T("Cannot set negative position in ChunkedDecompressionStream."), __TFILE__, __LINE__);
+	pimpl->m_Pos = (uint64)pos;
+}
+
+} // namespace common
@@ -1,185 +1,552 @@
-/** \file
-\brief Auxiliary module for zlib library
-\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
-
-Part of CommonLib library. \n
-Encoding UTF-8, end of line CR+LF \n
-License: GNU LGPL. \n
-Documentation: \ref Module_ZlibUtils\n
-Module components: \ref code_zlibutils
-*/
-#if defined(_MSC_VER) && (_MSC_VER >= 1200)
-#pragma once
-#endif
-#ifndef COMMON_ZLIB_UTILS_H_
-#define COMMON_ZLIB_UTILS_H_
-
-#include "Stream.hpp"
-#include "Error.hpp"
-
-namespace common
-{
-
-/** \addtogroup code_zlibutils ZlibUtils Module
-Dokumentacja: \ref Module_ZlibUtils \n
-Nagwek: ZlibUtils.hpp */
-//@{
-
-/// Klasa wyjtku dla bdu zgoszonego przez bibliotek zlib
-class ZlibError : public Error
-{
-public:
-	ZlibError(int Code, const tstring &Msg = _T(""), const tstring &File = _T(""), int Line = 0);
-};
-
-/** \name Poziomy kompresji Zlib. */
-//@{
-/// Brak kompresji (co nie znaczy e dane zostan dosownie przepisane)
-const int ZLIB_STORE_LEVEL   = 0;
-/// Najsabsza kompresja, ale najszybsza
-const int ZLIB_FASTEST_LEVEL = 1;
-/// Najlepsza jako kompresji
-const int ZLIB_BEST_LEVEL    = 9;
-/// Domylny poziom kompresji
-extern const int ZLIB_DEFAULT_LEVEL;
-//@}
-
-/// \internal
-class ZlibCompressionStream_pimpl;
-/// \internal
-class ZlibDecompressionStream_pimpl;
-
-/// Strumie do zapisu, ktry kompresuje dane w formacie zlib.
-class ZlibCompressionStream : public OverlayStream
-{
-private:
-	scoped_ptr<ZlibCompressionStream_pimpl> pimpl;
-
-public:
-	ZlibCompressionStream(Stream *a_Stream, int Level = ZLIB_DEFAULT_LEVEL, int WindowBits = 15);
-	virtual ~ZlibCompressionStream();
-
-	// ======== Implementacja Stream ========
-	
-	virtual void Write(const void *Data, size_t Size);
-	/** Moe spowodowa, e skompresowane dane bd inaczej wygaday i obniy jako kompresji. */
-	virtual void Flush();
-	
-	/// Oblicza maksymalny rozmiar bufora na skompresowane dane
-	static size_t CompressLength(size_t DataLength);
-	/// Po prostu kompresuje podane dane
-	/**
-	\return Zwraca dugo skompresowanych danych.
-	\param[out] OutData Musi by buforem o dugoci conajmniej takiej, jak obliczona przez CompressLength.
-	\param BufLength Dugo zaalokowanej pamici na OutData, podawana i sprawdzana na wszelki wypadek.
-	*/
-	static size_t Compress(void *OutData, size_t BufLength, const void *Data, size_t DataLength, int Level = ZLIB_DEFAULT_LEVEL);
-};
-
-/// Strumie do zapisu, ktry kompresuje w formacie gzip doczajc nagwek gzip z podanymi parametrami.
-/** Wszystko jak w klasie ZlibCompressionStream. */
-class GzipCompressionStream : public OverlayStream
-{
-private:
-	scoped_ptr<ZlibCompressionStream_pimpl> pimpl;
-
-public:
-	/**
-	\param FileName Jeli ma nie by, mona poda NULL.
-	\param Comment Jeli ma nie by, mona poda NULL.
-	*/
-	GzipCompressionStream(Stream *a_Stream, const string *FileName, const string *Comment, int Level = ZLIB_DEFAULT_LEVEL, int WindowBits = 15);
-	virtual ~GzipCompressionStream();
-
-	// ======== Implementacja Stream ========
-	
-	virtual void Write(const void *Data, size_t Size);
-	virtual void Flush();
-};
-
-/// Strumie do odczytu dekompresujcy dane w formacie Zlib.
-class ZlibDecompressionStream : public OverlayStream
-{
-private:
-	scoped_ptr<ZlibDecompressionStream_pimpl> pimpl;
-
-public:
-	ZlibDecompressionStream(Stream *a_Stream, int WindowBits = 15);
-	virtual ~ZlibDecompressionStream();
-
-	// ======== Implementacja Stream ========
-	
-	virtual size_t Read(void *Out, size_t MaxLength);
-	virtual bool End();
-
-	/// Po prostu dekompresuje podane dane
-	/**
-	Rozmiar danych po dekompresji musi by gdzie zapamitany i odpowiednio duy bufor musi by ju zaalkowany.
-	\return Zwraca dugo rozkompresowanych danych.
-	\param BufLength Dugo zaalokowanej pamici na OutData, podawana i sprawdzana na wszelki wypadek.
-	*/
-	static size_t Decompress(void *OutData, size_t BufLength, const void *Data, size_t DataLength);
-};
-
-/// Strumie do odczytu, ktry dekompresuje dane w formacie gzip odczytujc te nagwek.
-/** Wszystko podobnie jak w klasie ZlibCompressionStream. */
-class GzipDecompressionStream : public OverlayStream
-{
-private:
-	scoped_ptr<ZlibDecompressionStream_pimpl> pimpl;
-
-public:
-	GzipDecompressionStream(Stream *a_Stream, int WindowBits = 15);
-	virtual ~GzipDecompressionStream();
-
-	// ======== Implementacja Stream ========
-	
-	virtual size_t Read(void *Out, size_t MaxLength);
-	virtual bool End();
-
-	/** \name Pobieranie informacji z nagwka.
-	Jeli plik posiada nagwek, ten nagwek przechowuje dan informacj i
-	zosta ju w toku odczytywania odczytany, zwraca true i zwraca przez parametr
-	z t informacj. */
-	//@{
-	bool GetHeaderFileName(string *OutFileName);
-	bool GetHeaderComment(string *OutComment);
-	//@}
-};
-
-/// Tryb otwarcia pliku GZip
-enum GZIP_FILE_MODE
-{
-	GZFM_WRITE, ///< Do zapisu
-	GZFM_READ,  ///< Do odczytu
-};
-
-/// \internal
-class GzipFileStream_pimpl;
-
-/// Obsuga pliku w formacie gzip (zalecane rozszerzenie ".gz")
-class GzipFileStream : public Stream
-{
-private:
-	scoped_ptr<GzipFileStream_pimpl> pimpl;
-
-public:
-	/** Level ma znaczenie tylko przy zapisie. */
-	GzipFileStream(const string &FileName, GZIP_FILE_MODE Mode, int Level = ZLIB_DEFAULT_LEVEL);
-	virtual ~GzipFileStream();
-
-	// ======== Implementacja Stream ========
-	
-	virtual void Write(const void *Data, size_t Size);
-	virtual void Flush();
-	
-	virtual size_t Read(void *Out, size_t MaxLength);
-	virtual bool End();
-};
-
-//@}
-// code_zlibutils
-
-} // namespace common
-
-#endif
+/** \file
+\brief Auxiliary module for zlib library
+\author Adam Sawicki - sawickiap@poczta.onet.pl - http://asawicki.info/ \n
+
+Part of CommonLib library. \n
+Encoding UTF-8, end of line CR+LF \n
+License: GNU LGPL. \n
+Documentation: \ref Module_ZlibUtils\n
+Module components: \ref code_zlibutils
+*/
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+#pragma once
+#endif
+#ifndef COMMON_ZLIB_UTILS_H_
+#define COMMON_ZLIB_UTILS_H_
+
+#include "Stream.hpp"
+#include "Error.hpp"
+#include "Compression.hpp"
+
+namespace common
+{
+
+/** \addtogroup code_zlibutils ZlibUtils Module
+Dokumentacja: \ref Module_ZlibUtils \n
+Nagłówek: ZlibUtils.hpp */
+//@{
+
+/// Klasa wyjątku dla błędu zgłoszonego przez bibliotekę zlib
+class ZlibError : public Error
+{
+public:
+	ZlibError(int Code, const tstring &Msg = _T(""), const tstring &File = _T(""), int Line = 0);
+};
+
+/** \name Poziomy kompresji Zlib. */
+//@{
+/// Brak kompresji (co nie znaczy że dane zostaną dosłownie przepisane)
+const int ZLIB_STORE_LEVEL   = 0;
+/// Najsłabsza kompresja, ale najszybsza
+const int ZLIB_FASTEST_LEVEL = 1;
+/// Najlepsza jakość kompresji
+const int ZLIB_BEST_LEVEL    = 9;
+/// Domyślny poziom kompresji
+extern const int ZLIB_DEFAULT_LEVEL;
+//@}
+
+/// \internal
+class ZlibCompressionStream_pimpl;
+/// \internal
+class ZlibDecompressionStream_pimpl;
+
+/// Strumień do zapisu, który kompresuje dane w formacie zlib.
+class ZlibCompressionStream : public OverlayStream
+{
+private:
+	scoped_ptr<ZlibCompressionStream_pimpl> pimpl;
+
+public:
+	ZlibCompressionStream(Stream *a_Stream, int Level = ZLIB_DEFAULT_LEVEL, int WindowBits = 15);
+	virtual ~ZlibCompressionStream();
+
+	// ======== Implementacja Stream ========
+	
+	virtual void Write(const void *Data, size_t Size);
+	/** Może spowodować, że skompresowane dane będą inaczej wygładały i obniżyć jakość kompresji. */
+	virtual void Flush();
+	
+	/// Oblicza maksymalny rozmiar bufora na skompresowane dane
+	static size_t CompressLength(size_t DataLength);
+	/// Po prostu kompresuje podane dane
+	/**
+	\return Zwraca długość skompresowanych danych.
+	\param[out] OutData Musi być buforem o długości conajmniej takiej, jak obliczona przez CompressLength.
+	\param BufLength Długość zaalokowanej pamięci na OutData, podawana i sprawdzana na wszelki wypadek.
+	*/
+	static size_t Compress(void *OutData, size_t BufLength, const void *Data, size_t DataLength, int Level = ZLIB_DEFAULT_LEVEL);
+};
+
+/// Strumień do zapisu, który kompresuje w formacie gzip dołączając nagłówek gzip z podanymi parametrami.
+/** Wszystko jak w klasie ZlibCompressionStream. */
+class GzipCompressionStream : public OverlayStream
+{
+private:
+	scoped_ptr<ZlibCompressionStream_pimpl> pimpl;
+
+public:
+	/**
+	\param FileName Jeśli ma nie być, można podać NULL.
+	\param Comment Jeśli ma nie być, można podać NULL.
+	*/
+	GzipCompressionStream(Stream *a_Stream, const string *FileName, const string *Comment, int Level = ZLIB_DEFAULT_LEVEL, int WindowBits = 15);
+	virtual ~GzipCompressionStream();
+
+	// ======== Implementacja Stream ========
+	
+	virtual void Write(const void *Data, size_t Size);
+	virtual void Flush();
+};
+
+/// \internal
+class ParallelGzipCompressionStream_pimpl;
+
+/// Write-only stream compressing in gzip format on many threads.
+/**
+Input is split into blocks compressed in parallel, each primed with last 32 KB
+of the previous block as a preset dictionary. Blocks end with Z_SYNC_FLUSH and
+are concatenated into a single deflate stream, CRC32 of blocks is combined, so the
+output is one standard gzip member readable by gunzip or GzipDecompressionStream.
+Compression ratio is only slightly worse than GzipCompressionStream.
+Trailer is written by Finish(), or by the destructor if Finish() was not called.
+*/
+class ParallelGzipCompressionStream : public OverlayStream
+{
+private:
+	scoped_ptr<ParallelGzipCompressionStream_pimpl> pimpl;
+
+public:
+	/// Default uncompressed size of a single block - 128 KB.
+	static const size_t DEFAULT_BLOCK_SIZE = 128 * 1024;
+
+	/**
+	\param FileName Jeśli ma nie być, można podać NULL.
+	\param Comment Jeśli ma nie być, można podać NULL.
+	\param ThreadCount 0 means number of logical processors.
+	\param BlockSize Must be at least 32 KB.
+	*/
+	ParallelGzipCompressionStream(Stream *a_Stream, const string *FileName, const string *Comment, int Level = ZLIB_DEFAULT_LEVEL, uint ThreadCount = 0, size_t BlockSize = DEFAULT_BLOCK_SIZE);
+	virtual ~ParallelGzipCompressionStream();
+
+	// ======== Implementacja Stream ========
+
+	virtual void Write(const void *Data, size_t Size);
+	/** Compresses pending data as a shorter block, so that everything written so far can be decompressed. */
+	virtual void Flush();
+
+	/// Writes pending data and gzip trailer. Nothing can be written after that.
+	void Finish();
+};
+
+/// Strumień do odczytu dekompresujący dane w formacie Zlib.
+class ZlibDecompressionStream : public OverlayStream
+{
+private:
+	scoped_ptr<ZlibDecompressionStream_pimpl> pimpl;
+
+public:
+	ZlibDecompressionStream(Stream *a_Stream, int WindowBits = 15);
+	virtual ~ZlibDecompressionStream();
+
+	// ======== Implementacja Stream ========
+	
+	virtual size_t Read(void *Out, size_t MaxLength);
+	virtual bool End();
+
+	/// Po prostu dekompresuje podane dane
+	/**
+	Rozmiar danych po dekompresji musi być gdzieś zapamiętany i odpowiednio duży bufor musi być już zaalkowany.
+	\return Zwraca długość rozkompresowanych danych.
+	\param BufLength Długość zaalokowanej pamięci na OutData, podawana i sprawdzana na wszelki wypadek.
+	*/
+	static size_t Decompress(void *OutData, size_t BufLength, const void *Data, size_t DataLength);
+};
+
+/// Strumień do odczytu, który dekompresuje dane w formacie gzip odczytując też nagłówek.
+/** Wszystko podobnie jak w klasie ZlibCompressionStream.
+Obsługuje pliki złożone z wielu członów (gzip members) połączonych jeden za drugim -
+zwraca dane ze wszystkich po kolei. Informacje z nagłówka dotyczą pierwszego członu. */
+class GzipDecompressionStream : public OverlayStream
+{
+private:
+	scoped_ptr<ZlibDecompressionStream_pimpl> pimpl;
+
+public:
+	GzipDecompressionStream(Stream *a_Stream, int WindowBits = 15);
+	virtual ~GzipDecompressionStream();
+
+	// ======== Implementacja Stream ========
+	
+	virtual size_t Read(void *Out, size_t MaxLength);
+	virtual bool End();
+
+	/** \name Pobieranie informacji z nagłówka.
+	Jeśli plik posiada nagłówek, ten nagłówek przechowuje daną informację i
+	został już w toku odczytywania odczytany, zwraca true i zwraca przez parametr
+	z tą informację. */
+	//@{
+	bool GetHeaderFileName(string *OutFileName);
+	bool GetHeaderComment(string *OutComment);
+	//@}
+};
+
+/// \internal
+class ZlibCompressor_pimpl;
+/// \internal
+class ZlibDecompressor_pimpl;
+
+/// \internal
+class ParallelGzipDecompressionStream_pimpl;
+
+/// Read-only stream decompressing multi-member gzip data with members decompressed in parallel.
+/**
+Compressed data is read in batches. Beginnings of members are found by scanning
+for gzip headers, then every candidate is decompressed on a ThreadPool and the chain
+of members which really follow one another is delivered in order. False candidates
+found inside compressed data are simply discarded.
+
+Gives speedup only for data made of many members, like concatenated logs or output
+of tools compressing in independent blocks. A member longer than the batch is
+decompressed sequentially. CRC32 and length of every member are checked.
+Data after the last member which is not a gzip member is ignored, like gzip does,
+but input without any member throws Error.
+*/
+class ParallelGzipDecompressionStream : public OverlayStream
+{
+private:
+	scoped_ptr<ParallelGzipDecompressionStream_pimpl> pimpl;
+
+public:
+	/// Default amount of compressed data processed in one batch - 8 MB.
+	static const size_t DEFAULT_BATCH_SIZE = 8 * 1024 * 1024;
+
+	/** \param ThreadCount 0 means number of logical processors. */
+	ParallelGzipDecompressionStream(Stream *a_Stream, uint ThreadCount = 0, size_t BatchSize = DEFAULT_BATCH_SIZE);
+	virtual ~ParallelGzipDecompressionStream();
+
+	// ======== Implementacja Stream ========
+
+	virtual size_t Read(void *Out, size_t MaxLength);
+	virtual bool End();
+};
+
+/// Reusable context for compressing many small independent messages.
+/**
+Unlike ZlibCompressionStream::Compress, which initializes and frees whole zlib
+state on every call, this object keeps it and only resets it between messages.
+Output goes straight to the caller's buffer. Not thread-safe - use one object per thread.
+*/
+class ZlibCompressor
+{
+	DECLARE_NO_COPY_CLASS(ZlibCompressor)
+
+private:
+	scoped_ptr<ZlibCompressor_pimpl> pimpl;
+
+public:
+	/** \param WindowBits 8..15 for zlib format, -15..-8 for raw deflate, 24..31 for gzip. */
+	ZlibCompressor(int Level = ZLIB_DEFAULT_LEVEL, int WindowBits = 15);
+	~ZlibCompressor();
+
+	/// Sets preset dictionary used for all following messages. Pass empty to disable.
+	/** Decompressor must use the same dictionary. Not supported for gzip format.
+	Data is copied. Only last 32 KB of it is used. */
+	void SetDictionary(const void *Dict, size_t DictLength);
+
+	/// Returns maximum compressed size of a message of given length.
+	size_t CompressLength(size_t DataLength);
+	/// Compresses one message as complete zlib/raw/gzip stream.
+	/**
+	\return Length of compressed data.
+	\param BufLength Size of OutData. If too small, Error is thrown - use CompressLength to be sure.
+	*/
+	size_t Compress(void *OutData, size_t BufLength, const void *Data, size_t DataLength);
+};
+
+/// Reusable context for decompressing many small independent messages.
+/** Counterpart of ZlibCompressor. Not thread-safe - use one object per thread. */
+class ZlibDecompressor
+{
+	DECLARE_NO_COPY_CLASS(ZlibDecompressor)
+
+private:
+	scoped_ptr<ZlibDecompressor_pimpl> pimpl;
+
+public:
+	/** \param WindowBits 8..15 for zlib format, -15..-8 for raw deflate, 24..31 for gzip, 40..47 for autodetection of zlib or gzip. */
+	ZlibDecompressor(int WindowBits = 15);
+	~ZlibDecompressor();
+
+	/// Sets preset dictionary. Pass empty to disable. Data is copied.
+	void SetDictionary(const void *Dict, size_t DictLength);
+
+	/// Decompresses one complete message directly into caller's buffer.
+	/**
+	\return Length of decompressed data.
+	\param BufLength Size of OutData. If decompressed data doesn't fit, Error is thrown.
+	*/
+	size_t Decompress(void *OutData, size_t BufLength, const void *Data, size_t DataLength);
+};
+
+/// CompressionCodec using zlib or gzip format.
+/**
+Streams are ZlibCompressionStream/GzipCompressionStream and ZlibDecompressionStream/GzipDecompressionStream.
+Block functions use ZlibCompressor and ZlibDecompressor kept inside the object, created on first use.
+*/
+class ZlibCodec : public CompressionCodec
+{
+	DECLARE_NO_COPY_CLASS(ZlibCodec)
+
+private:
+	int m_Level;
+	bool m_Gzip;
+	scoped_ptr<ZlibCompressor> m_Compressor;
+	scoped_ptr<ZlibDecompressor> m_Decompressor;
+
+public:
+	/** \param Gzip true to produce gzip format instead of zlib. */
+	ZlibCodec(int Level = ZLIB_DEFAULT_LEVEL, bool Gzip = false);
+	virtual ~ZlibCodec();
+
+	virtual const tchar * GetName();
+	virtual OverlayStream * CreateEncoder(Stream *a_Stream);
+	virtual OverlayStream * CreateDecoder(Stream *a_Stream);
+	virtual size_t CompressLength(size_t DataLength);
+	virtual size_t Compress(void *OutData, size_t BufLength, const void *Data, size_t DataLength);
+	virtual size_t Decompress(void *OutData, size_t BufLength, const void *Data, size_t DataLength);
+};
+
+/// Index of access points allowing random access to data compressed in gzip or zlib format.
+/**
+Built in one sequential pass over compressed data. Every Span bytes of uncompressed
+data, at a deflate block boundary, it records position in both compressed and
+uncompressed data together with last 32 KB of uncompressed data (the inflate window).
+Decompression can then start from the nearest access point instead of the beginning -
+see GzipSeekableDecompressionStream.
+
+Concatenated gzip members are supported - each member gets its own access point.
+Memory usage is about 32 KB per access point.
+*/
+class GzipIndex
+{
+public:
+	/// Default distance between access points - 1 MB of uncompressed data.
+	static const uint64 DEFAULT_SPAN = 1024 * 1024;
+
+	struct ACCESS_POINT
+	{
+		/// Offset in uncompressed data
+		uint64 UncompressedOffset;
+		/// Offset of the first byte of the deflate block in compressed data. If Bits > 0, that byte is partially used by the previous block.
+		uint64 CompressedOffset;
+		/// Number of bits (0..7) from byte at CompressedOffset-1 which belong to this block.
+		uint8 Bits;
+		/// Uncompressed data preceding this point within the same member, up to 32 KB.
+		std::vector<char> Window;
+	};
+
+	GzipIndex();
+
+	/// Builds the index reading all data from the stream. Previous content is discarded.
+	/** \param Span Minimum distance between access points in uncompressed bytes. */
+	void Build(Stream *CompressedData, uint64 Span = DEFAULT_SPAN);
+
+	/// True if data was in gzip format, false if in zlib format.
+	bool IsGzip() const { return m_Gzip; }
+	uint64 GetCompressedSize() const { return m_CompressedSize; }
+	uint64 GetUncompressedSize() const { return m_UncompressedSize; }
+	size_t GetPointCount() const { return m_Points.size(); }
+	const ACCESS_POINT & GetPoint(size_t Index) const { return m_Points[Index]; }
+	/// Returns index of the last access point at or before given uncompressed offset.
+	size_t FindPoint(uint64 UncompressedOffset) const;
+
+	void SaveToStream(Stream *s) const;
+	/// Throws Error if data is not a valid index.
+	void LoadFromStream(Stream *s);
+
+private:
+	bool m_Gzip;
+	uint64 m_CompressedSize;
+	uint64 m_UncompressedSize;
+	std::vector<ACCESS_POINT> m_Points;
+};
+
+/// \internal
+class GzipSeekableDecompressionStream_pimpl;
+
+/// Read-only seekable stream decompressing gzip or zlib data with the help of GzipIndex.
+/**
+SetPos is cheap. Next Read after seeking starts decompression from the nearest
+access point, or continues from current position if target is not farther than
+the next access point.
+*/
+class GzipSeekableDecompressionStream : public SeekableStream
+{
+private:
+	scoped_ptr<GzipSeekableDecompressionStream_pimpl> pimpl;
+
+public:
+	/** \param Index Must have been built for exactly this compressed data and stay alive
+	as long as this object. Mismatch of compressed size throws Error. */
+	GzipSeekableDecompressionStream(SeekableStream *a_Stream, const GzipIndex *Index);
+	virtual ~GzipSeekableDecompressionStream();
+
+	SeekableStream * GetStream();
+
+	// ======== Implementacja Stream ========
+
+	virtual size_t Read(void *Out, size_t MaxLength);
+	virtual bool End();
+
+	// ======== Implementacja SeekableStream ========
+
+	virtual uint64 GetSize();
+	virtual int64 GetPos();
+	virtual void SetPos(int64 pos);
+};
+
+/// Tryb otwarcia pliku GZip
+enum GZIP_FILE_MODE
+{
+	GZFM_WRITE, ///< Do zapisu
+	GZFM_READ,  ///< Do odczytu
+	/// Write with compression and file I/O done on a background thread.
+	/** Write only copies data into one of a limited number of buffers and queues it.
+	When all buffers are waiting for the background thread, Write blocks until one is free. */
+	GZFM_WRITE_ASYNC,
+};
+
+/// \internal
+class GzipFileStream_pimpl;
+
+/// Obsługa pliku w formacie gzip (zalecane rozszerzenie ".gz")
+/**
+In GZFM_WRITE_ASYNC mode errors reported by the background thread are thrown from
+the next call to Write, Flush or Close.
+*/
+class GzipFileStream : public Stream
+{
+private:
+	scoped_ptr<GzipFileStream_pimpl> pimpl;
+
+public:
+	/// Default size of a single buffer in GZFM_WRITE_ASYNC mode - 256 KB.
+	static const size_t DEFAULT_ASYNC_BUFFER_SIZE = 256 * 1024;
+	/// Default number of filled buffers that can wait for the background thread in GZFM_WRITE_ASYNC mode.
+	static const uint DEFAULT_ASYNC_QUEUE_LENGTH = 8;
+
+	/** Level ma znaczenie tylko przy zapisie.
+	AsyncBufferSize and AsyncQueueLength are used only in GZFM_WRITE_ASYNC mode. */
+	GzipFileStream(const string &FileName, GZIP_FILE_MODE Mode, int Level = ZLIB_DEFAULT_LEVEL,
+		size_t AsyncBufferSize = DEFAULT_ASYNC_BUFFER_SIZE, uint AsyncQueueLength = DEFAULT_ASYNC_QUEUE_LENGTH);
+	/** Closes the file if Close() was not called, ignoring errors. */
+	virtual ~GzipFileStream();
+
+	/// Writes all pending data and closes the file, throwing on error.
+	/** Nothing can be read or written after that. */
+	void Close();
+
+	// ======== Implementacja Stream ========
+	
+	virtual void Write(const void *Data, size_t Size);
+	/** In GZFM_WRITE_ASYNC mode waits until the background thread writes all data queued so far. */
+	virtual void Flush();
+	
+	virtual size_t Read(void *Out, size_t MaxLength);
+	virtual bool End();
+};
+
+/** \name Chunked container
+Format written by ChunkedCompressionStream and read by ChunkedDecompressionStream.
+Data is split into chunks, each compressed independently with zlib, so any of them
+can be decompressed without touching the others.
+
+- Header: magic "CZC1" (uint32), nominal chunk size (uint32).
+- Chunks: zlib streams, one after another.
+- Index, one entry per chunk: offset of compressed data relative to beginning of
+  the header (uint64), compressed size (uint32), uncompressed size (uint32),
+  CRC32 of uncompressed data (uint32).
+- Footer: offset of the index (uint64), chunk count (uint32), total uncompressed
+  size (uint64), MD5 of the index (16 bytes), magic "CZCE" (uint32).
+
+Numbers are written with Stream::WriteEx, so in native (little endian) byte order. */
+//@{
+/// Default uncompressed size of a single chunk - 1 MB.
+const size_t CHUNKED_DEFAULT_CHUNK_SIZE = 1024 * 1024;
+//@}
+
+/// \internal
+class ChunkedCompressionStream_pimpl;
+/// \internal
+class ChunkedDecompressionStream_pimpl;
+
+/// Write-only stream compressing data into the chunked container format.
+/**
+Full chunks are collected in batches and compressed in parallel on a ThreadPool,
+then written to the underlying stream in order. Index and footer are written by
+Finish(), or by the destructor if Finish() was not called.
+*/
+class ChunkedCompressionStream : public OverlayStream
+{
+private:
+	scoped_ptr<ChunkedCompressionStream_pimpl> pimpl;
+
+public:
+	/** \param ChunkSize Uncompressed size of each chunk, except the last one.
+	\param ThreadCount 0 means number of logical processors, 1 means compress on the calling thread. */
+	ChunkedCompressionStream(Stream *a_Stream, size_t ChunkSize = CHUNKED_DEFAULT_CHUNK_SIZE, int Level = ZLIB_DEFAULT_LEVEL, uint ThreadCount = 0);
+	virtual ~ChunkedCompressionStream();
+
+	// ======== Implementacja Stream ========
+
+	virtual void Write(const void *Data, size_t Size);
+	/** Closes current chunk even if it is not full, so too frequent flushing hurts compression ratio. */
+	virtual void Flush();
+
+	/// Writes pending data, the index and the footer. Nothing can be written after that.
+	void Finish();
+};
+
+/// Read-only seekable stream returning uncompressed data from the chunked container format.
+/**
+Underlying stream must contain the container from its current position up to its end.
+Reads covering many whole chunks decompress them in parallel straight into the
+destination buffer. Other reads go through a cache holding one decompressed chunk.
+CRC32 of every decompressed chunk is checked - mismatch throws Error.
+*/
+class ChunkedDecompressionStream : public SeekableStream
+{
+private:
+	scoped_ptr<ChunkedDecompressionStream_pimpl> pimpl;
+
+public:
+	/** Reads and validates the index.
+	\param ThreadCount 0 means number of logical processors, 1 means decompress on the calling thread. */
+	ChunkedDecompressionStream(SeekableStream *a_Stream, uint ThreadCount = 0);
+	virtual ~ChunkedDecompressionStream();
+
+	SeekableStream * GetStream();
+	uint GetChunkCount();
+	/// Returns nominal chunk size stored in the header.
+	size_t GetChunkSize();
+	/// Decompresses all chunks and checks their CRC32. Throws Error on first corrupted chunk.
+	void Verify();
+
+	// ======== Implementacja Stream ========
+
+	virtual size_t Read(void *Out, size_t MaxLength);
+	virtual bool End();
+
+	// ======== Implementacja SeekableStream ========
+
+	virtual uint64 GetSize();
+	virtual int64 GetPos();
+	virtual void SetPos(int64 pos);
+};
+
+//@}
+// code_zlibutils
+
+} // namespace common
+
+#endif
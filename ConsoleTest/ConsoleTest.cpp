@@ -1,2130 +1,3404 @@
-#include "../Common/Base.hpp"
-#include "../Common/FreeList.hpp"
-#include "../Common/Error.hpp"
-#include "../Common/Math.hpp"
-#include "../Common/Profiler.hpp"
-#include "../Common/DateTime.hpp"
-#include "../Common/Threads.hpp"
-#include "../Common/Stream.hpp"
-#include "../Common/Files.hpp"
-#include "../Common/Tokenizer.hpp"
-#include "../Common/TokDoc.hpp"
-#include "../Common/ZlibUtils.hpp"
-#include "../Common/Logger.hpp"
-#include "../Common/ObjList.hpp"
-
-#ifdef _WIN32
-	#include "../Common/BstrString.hpp"
-#endif
-
-#include <iostream>
-#include <ios>
-#include <queue>
-
-using namespace std;
-using namespace common;
-
-#ifdef _UNICODE
-	#define tcout wcout
-	#define tcin wcin
-#else
-	#define tcout cout
-	#define tcin cin
-#endif
-
-static Profiler g_Profiler;
-
-void WriteLine(const tstring &s)
-{
-	tcout << s << endl;
-}
-
-void PrintProfile()
-{
-	tstring Profile;
-	g_Profiler.FormatString(&Profile, PROFILER_UNITS_MILLISECONDS);
-	WriteLine(Profile);
-}
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-
-class SingletonClass : public Singleton<SingletonClass>
-{
-public:
-	SingletonClass()
-	{
-		tcout << _T("  Singleton Constructor") << endl;
-	}
-
-	~SingletonClass()
-	{
-		tcout << _T("  Singleton Destructor") << endl;
-	}
-
-	void Method()
-	{
-		tcout << _T("  Singleton Method") << endl;
-	}
-};
-
-void Initialize()
-{
-	GameTime::Initialize();
-}
-
-void TestBase()
-{
-	WriteLine(_T("==================== BASE ===================="));
-
-	{
-		tcout << _T("Conversion between uint32, unsigned and size_t - shouldn't be compiler warning") << endl;
-		const uint32 cu4 = 1234567890;
-		const unsigned cu = 123456789;
-		const size_t cs = 12345678;
-		uint32 u4 = cu, u4_2 = cs;
-		unsigned u = cu4, u_2 = cs;
-		size_t s = cu4, s_2 = cu;
-	}
-
-	{
-		tcout << _T("Basic numeric types:") << endl;
-		tcout << _T("  sizeof(int8) = ") << sizeof(int8) << endl;
-		tcout << _T("  sizeof(int16) = ") << sizeof(int16) << endl;
-		tcout << _T("  sizeof(int32) = ") << sizeof(int32) << endl;
-		tcout << _T("  sizeof(int64) = ") << sizeof(int64) << endl;
-		tcout << _T("  sizeof(uint8) = ") << sizeof(uint8) << endl;
-		tcout << _T("  sizeof(uint16) = ") << sizeof(uint16) << endl;
-		tcout << _T("  sizeof(uint32) = ") << sizeof(uint32) << endl;
-		tcout << _T("  sizeof(uint64) = ") << sizeof(uint64) << endl;
-	}
-
-	{
-		tcout << _T("absolute_cast") << endl;
-		const int ci = 123456789;
-		tcout << _T("  int = ") << ci << endl;
-		float f = absolute_cast<float>(ci);
-		tcout << _T("  float = ") << f << endl;
-		uint32 ui = absolute_cast<uint32>(ci);
-		tcout << _T("  uint32 = ") << ui << endl;
-	}
-
-	{
-		tcout << _T("Singleton:") << endl;
-		tcout << _T("- Using singleton for the first time") << endl;
-		SingletonClass::GetInstance().Method();
-		tcout << _T("- Using singleton for second time") << endl;
-		SingletonClass::GetInstance().Method();
-	}
-
-	{
-		tcout << _T("Safe arithemtic:") << endl;
-		tcout << _T("  SafeAdd<uint8>(120, 250) = ") << (int)safe_add<uint8>(120, 250) << endl;
-		tcout << _T("  SafeSub<uint8>(120, 250) = ") << (int)safe_sub<uint8>(120, 250) << endl;
-		tcout << _T("  SafeMul<uint8>(120, 250) = ") << (int)safe_mul<uint8>(120, 250) << endl;
-	}
-
-	{
-		tcout << _T("Random generator:") << endl;
-		tcout << _T("  uint32: ") << g_Rand.RandUint() << _T(' ') << g_Rand.RandUint() << _T(' ') << g_Rand.RandUint() << _T(' ') << g_Rand.RandUint() << endl;
-		tcout << _T("  float: ") << g_Rand.RandFloat() << _T(' ') << g_Rand.RandFloat() << _T(' ') << g_Rand.RandFloat() << _T(' ') << g_Rand.RandFloat() << endl;
-		tcout << _T("  bool: ") << g_Rand.RandBool() << _T(' ') << g_Rand.RandBool() << _T(' ') << g_Rand.RandBool() << _T(' ') << g_Rand.RandBool() << endl;
-		tcout << _T("  Byte: ") << (int)g_Rand.RandByte() << _T(' ') << (int)g_Rand.RandByte() << _T(' ') << (int)g_Rand.RandByte() << _T(' ') << (int)g_Rand.RandByte() << endl;
-		tcout << _T("  Normal(sigma=1): ") << g_Rand.RandNormal(1.0f) << _T(' ') << g_Rand.RandNormal(1.0f) << _T(' ') << g_Rand.RandNormal(1.0f) << _T(' ') << g_Rand.RandNormal(1.0f) << endl;
-
-		RandomGenerator DR1(123);
-		tcout << _T("  Deterministic #1 (seed 123): ") << DR1.RandUint() << _T(' ') << DR1.RandFloat() << _T(' ') << DR1.RandBool() << endl;
-		RandomGenerator DR2(123);
-		tcout << _T("  Deterministic #2 (seed 123): ") << DR2.RandUint() << _T(' ') << DR2.RandFloat() << _T(' ') << DR2.RandBool() << endl;
-	}
-
-	{
-		tcout << _T("Conversions:") << endl;
-
-		tchar ch = _T('A');
-		int i = 123;
-		uint32 u = 323456789;
-		float f = 3.14f;
-		double d = 10.5;
-		bool b = true;
-		tstring s = _T("Foo");
-		int ai[] = { 1, 2, 3 };
-		std::vector<int> vi(&ai[0], &ai[3]);
-		tstring as[] = { _T("a"), _T("bb"), _T("ccc"), _T("dddd") };
-		std::vector<tstring> vs(&as[0], &as[4]);
-
-		tstring TMP;
-		SthToStr(&TMP, ch); tcout << _T("  tchar to tstring: ") << TMP << endl;
-		StrToSth(&ch, TMP); tcout << _T("  tstring to tchar: ") << ch << endl;
-		SthToStr(&TMP, i ); tcout << _T("  int to tstring: ") << TMP << endl;
-		StrToSth(&i, TMP);  tcout << _T("  tstring to int: ") << i << endl;
-		SthToStr(&TMP, u ); tcout << _T("  uint32 to tstring: ") << TMP << endl;
-		StrToSth(&u, TMP);  tcout << _T("  tstring to uint32: ") << u << endl;
-		SthToStr(&TMP, f ); tcout << _T("  float to tstring: ") << TMP << endl;
-		StrToSth(&f, TMP);  tcout << _T("  tstring to float: ") << f << endl;
-		SthToStr(&TMP, d ); tcout << _T("  double to tstring: ") << TMP << endl;
-		StrToSth(&d, TMP);  tcout << _T("  tstring to double: ") << d << endl;
-		SthToStr(&TMP, b ); tcout << _T("  bool to tstring: ") << TMP << endl;
-		StrToSth(&b, TMP);  tcout << _T("  tstring to bool: ") << b << endl;
-		SthToStr(&TMP, s ); tcout << _T("  tstring to tstring: ") << TMP << endl;
-		StrToSth(&s, TMP);  tcout << _T("  tstring to tstring: ") << s << endl;
-		SthToStr(&TMP, vi); tcout << _T("  vector<int> to tstring: ") << TMP << endl;
-		StrToSth(&vi, TMP); tcout << _T("  tstring to vector<int>:"); for (size_t si1 = 0; si1 < vi.size(); si1++) tcout << _T(' ') << vi[si1]; tcout << endl;
-		SthToStr(&TMP, vs); tcout << _T("  vector<tstring> to tstring: ") << TMP << endl;
-		StrToSth(&vs, TMP); tcout << _T("  tstring to vector<tstring>:"); for (size_t si2 = 0; si2 < vs.size(); si2++) tcout << _T(' ') << vs[si2]; tcout << endl;
-
-		tcout << _T("- Format: ") << (Format(_T("#, #, #, #, #, #, #, #, #")) % ch % i % u % f % d % b % s % vi % vs).str() << endl;
-	}
-
-	// Sort2, Sort3
-	{
-		int arr[3] = { 2, 3, 1 };
-		Sort3(arr[0], arr[1], arr[2]);
-		assert(arr[0] == 1);
-		assert(arr[1] == 2);
-		assert(arr[2] == 3);
-	}
-
-	{
-		tchar s[128];
-		common_sprintf(s, _countof(s), _T("common_sprintf: 1=%i, 2.5=%g"), 1, 2.5);
-		tcout << s << endl;
-	}
-    
-    // CountBitsSet
-    {
-        uint result;
-
-        uint8_t u8;
-        u8 = 0x00; result = CountBitsSet(u8); assert(result == 0);
-        u8 = 0x01; result = CountBitsSet(u8); assert(result == 1);
-        u8 = 0x02; result = CountBitsSet(u8); assert(result == 1);
-        u8 = 0x04; result = CountBitsSet(u8); assert(result == 1);
-        u8 = 0x08; result = CountBitsSet(u8); assert(result == 1);
-        u8 = 0x10; result = CountBitsSet(u8); assert(result == 1);
-        u8 = 0x20; result = CountBitsSet(u8); assert(result == 1);
-        u8 = 0x40; result = CountBitsSet(u8); assert(result == 1);
-        u8 = 0x80; result = CountBitsSet(u8); assert(result == 1);
-        u8 = 0x03; result = CountBitsSet(u8); assert(result == 2);
-        u8 = 0x81; result = CountBitsSet(u8); assert(result == 2);
-        u8 = 0xFF; result = CountBitsSet(u8); assert(result == 8);
-
-        uint16_t u16;
-        u16 = 0x0000; result = CountBitsSet(u16); assert(result == 0);
-        u16 = 0x0001; result = CountBitsSet(u16); assert(result == 1);
-        u16 = 0x0002; result = CountBitsSet(u16); assert(result == 1);
-        u16 = 0x0004; result = CountBitsSet(u16); assert(result == 1);
-        u16 = 0x0008; result = CountBitsSet(u16); assert(result == 1);
-        u16 = 0x0010; result = CountBitsSet(u16); assert(result == 1);
-        u16 = 0x0020; result = CountBitsSet(u16); assert(result == 1);
-        u16 = 0x0040; result = CountBitsSet(u16); assert(result == 1);
-        u16 = 0x0080; result = CountBitsSet(u16); assert(result == 1);
-        u16 = 0x0200; result = CountBitsSet(u16); assert(result == 1);
-        u16 = 0x4000; result = CountBitsSet(u16); assert(result == 1);
-        u16 = 0x8000; result = CountBitsSet(u16); assert(result == 1);
-        u16 = 0x0003; result = CountBitsSet(u16); assert(result == 2);
-        u16 = 0x0081; result = CountBitsSet(u16); assert(result == 2);
-        u16 = 0x0110; result = CountBitsSet(u16); assert(result == 2);
-        u16 = 0xF021; result = CountBitsSet(u16); assert(result == 6);
-        u16 = 0xFF00; result = CountBitsSet(u16); assert(result == 8);
-        u16 = 0xFFFF; result = CountBitsSet(u16); assert(result == 16);
-
-        uint32_t u32;
-        u32 = 0x00000000; result = CountBitsSet(u32); assert(result == 0);
-        u32 = 0x00000001; result = CountBitsSet(u32); assert(result == 1);
-        u32 = 0x00000002; result = CountBitsSet(u32); assert(result == 1);
-        u32 = 0x00000004; result = CountBitsSet(u32); assert(result == 1);
-        u32 = 0x00000008; result = CountBitsSet(u32); assert(result == 1);
-        u32 = 0x00000010; result = CountBitsSet(u32); assert(result == 1);
-        u32 = 0x00000020; result = CountBitsSet(u32); assert(result == 1);
-        u32 = 0x00000040; result = CountBitsSet(u32); assert(result == 1);
-        u32 = 0x00000080; result = CountBitsSet(u32); assert(result == 1);
-        u32 = 0x00000200; result = CountBitsSet(u32); assert(result == 1);
-        u32 = 0x00004000; result = CountBitsSet(u32); assert(result == 1);
-        u32 = 0x00008000; result = CountBitsSet(u32); assert(result == 1);
-        u32 = 0x00400000; result = CountBitsSet(u32); assert(result == 1);
-        u32 = 0x00000003; result = CountBitsSet(u32); assert(result == 2);
-        u32 = 0x00000081; result = CountBitsSet(u32); assert(result == 2);
-        u32 = 0x00000110; result = CountBitsSet(u32); assert(result == 2);
-        u32 = 0x0000F021; result = CountBitsSet(u32); assert(result == 6);
-        u32 = 0x0000FF00; result = CountBitsSet(u32); assert(result == 8);
-        u32 = 0x0000FFFF; result = CountBitsSet(u32); assert(result == 16);
-        u32 = 0x12481248; result = CountBitsSet(u32); assert(result == 8);
-        u32 = 0x80014002; result = CountBitsSet(u32); assert(result == 4);
-        u32 = 0xFFFFFFFF; result = CountBitsSet(u32); assert(result == 32);
-
-        uint64_t u64;
-        u64 = 0x0000000000000000; result = CountBitsSet(u64); assert(result == 0);
-        u64 = 0x0000000000000001; result = CountBitsSet(u64); assert(result == 1);
-        u64 = 0x0000000000000002; result = CountBitsSet(u64); assert(result == 1);
-        u64 = 0x0000000000000004; result = CountBitsSet(u64); assert(result == 1);
-        u64 = 0x0000000000000008; result = CountBitsSet(u64); assert(result == 1);
-        u64 = 0x0000000000000010; result = CountBitsSet(u64); assert(result == 1);
-        u64 = 0x0000000000000020; result = CountBitsSet(u64); assert(result == 1);
-        u64 = 0x0000000000000040; result = CountBitsSet(u64); assert(result == 1);
-        u64 = 0x0000000000000080; result = CountBitsSet(u64); assert(result == 1);
-        u64 = 0x0000000000000200; result = CountBitsSet(u64); assert(result == 1);
-        u64 = 0x0000000000004000; result = CountBitsSet(u64); assert(result == 1);
-        u64 = 0x0000000000008000; result = CountBitsSet(u64); assert(result == 1);
-        u64 = 0x0000000000400000; result = CountBitsSet(u64); assert(result == 1);
-        u64 = 0x0000000400000000; result = CountBitsSet(u64); assert(result == 1);
-        u64 = 0x0000800000000000; result = CountBitsSet(u64); assert(result == 1);
-        u64 = 0x8000000000000000; result = CountBitsSet(u64); assert(result == 1);
-        u64 = 0x0000000000000003; result = CountBitsSet(u64); assert(result == 2);
-        u64 = 0x0000000000000081; result = CountBitsSet(u64); assert(result == 2);
-        u64 = 0x0000000000000110; result = CountBitsSet(u64); assert(result == 2);
-        u64 = 0x0005000000000000; result = CountBitsSet(u64); assert(result == 2);
-        u64 = 0x0500000000000000; result = CountBitsSet(u64); assert(result == 2);
-        u64 = 0x000000000000F021; result = CountBitsSet(u64); assert(result == 6);
-        u64 = 0x000000000000FF00; result = CountBitsSet(u64); assert(result == 8);
-        u64 = 0x000000000000FFFF; result = CountBitsSet(u64); assert(result == 16);
-        u64 = 0x0000000012481248; result = CountBitsSet(u64); assert(result == 8);
-        u64 = 0x0000000080014002; result = CountBitsSet(u64); assert(result == 4);
-        u64 = 0x00000000FFFFFFFF; result = CountBitsSet(u64); assert(result == 32);
-        u64 = 0xFFFFFFFFFFFFFFFF; result = CountBitsSet(u64); assert(result == 64);
-    }
-
-    // PtrToStr
-    {
-        int* ptr = nullptr;
-        wstring str1, str2;
-        PtrToStr(&str1, ptr);
-        ptr += 8;
-        PtrToStr(&str2, ptr);
-
-#ifdef _WIN64
-        assert(str1 == L"0000000000000000");
-        assert(str2 == L"0000000000000020");
-#else
-        assert(str1 == L"00000000");
-        assert(str2 == L"00000020");
-#endif
-    }
-
-    // ValidateWildcard
-    {
-        assert(ValidateWildcard(L"", L"") == true);
-        assert(ValidateWildcard(L"", L"aaa") == false);
-        
-        assert(ValidateWildcard(L"*", L"") == true);
-        assert(ValidateWildcard(L"*", L"a") == true);
-        assert(ValidateWildcard(L"*", L"aaa") == true);
-        
-        assert(ValidateWildcard(L"?", L"") == false);
-        assert(ValidateWildcard(L"?", L"a") == true);
-        assert(ValidateWildcard(L"?", L"aaa") == false);
-        
-        assert(ValidateWildcard(L"?a", L"") == false);
-        assert(ValidateWildcard(L"?a", L"xa") == true);
-        assert(ValidateWildcard(L"?a", L"xaa") == false);
-        assert(ValidateWildcard(L"?a", L"axa") == false);
-        
-        assert(ValidateWildcard(L"a?", L"") == false);
-        assert(ValidateWildcard(L"a?", L"ax") == true);
-        assert(ValidateWildcard(L"a?", L"axa") == false);
-        assert(ValidateWildcard(L"a?", L"axa") == false);
-
-        assert(ValidateWildcard(L"a?bb", L"") == false);
-        assert(ValidateWildcard(L"a?bb", L"aXbb") == true);
-        assert(ValidateWildcard(L"a?bb", L"abb") == false);
-        assert(ValidateWildcard(L"a?bb", L"bXbb") == false);
-        assert(ValidateWildcard(L"a?bb", L"aXaa") == false);
-        assert(ValidateWildcard(L"a?bb", L"aXbba") == false);
-        assert(ValidateWildcard(L"a?bb", L"aaXbb") == false);
-
-        assert(ValidateWildcard(L"aa*", L"") == false);
-        assert(ValidateWildcard(L"aa*", L"aa") == true);
-        assert(ValidateWildcard(L"aa*", L"ab") == false);
-        assert(ValidateWildcard(L"aa*", L"aaXXX") == true);
-        assert(ValidateWildcard(L"aa*", L"abXXX") == false);
-        
-        assert(ValidateWildcard(L"*ab", L"") == false);
-        assert(ValidateWildcard(L"*ab", L"ab") == true);
-        assert(ValidateWildcard(L"*ab", L"aC") == false);
-        assert(ValidateWildcard(L"*ab", L"XXXab") == true);
-        assert(ValidateWildcard(L"*ab", L"XXXaC") == false);
-        assert(ValidateWildcard(L"*ab", L"XXXaCC") == false);
-        assert(ValidateWildcard(L"*ab", L"XXXabCC") == false);
-
-        assert(ValidateWildcard(L"xy*abc", L"") == false);
-        assert(ValidateWildcard(L"xy*abc", L"xyabc") == true);
-        assert(ValidateWildcard(L"xy*abc", L"xy") == false);
-        assert(ValidateWildcard(L"xy*abc", L"abc") == false);
-        assert(ValidateWildcard(L"xy*abc", L"xabc") == false);
-        assert(ValidateWildcard(L"xy*abc", L"xyXXXabc") == true);
-        assert(ValidateWildcard(L"xy*abc", L"xZabc") == false);
-        assert(ValidateWildcard(L"xy*abc", L"xyXXXaDc") == false);
-
-        assert(ValidateWildcard(L"???", L"") == false);
-        assert(ValidateWildcard(L"???", L"ab") == false);
-        assert(ValidateWildcard(L"???", L"abc") == true);
-        assert(ValidateWildcard(L"???", L"abcdef") == false);
-
-        assert(ValidateWildcard(L"??*?", L"") == false);
-        assert(ValidateWildcard(L"?*??", L"ab") == false);
-        assert(ValidateWildcard(L"*???", L"abc") == true);
-        assert(ValidateWildcard(L"???*", L"abcd") == true);
-        
-        assert(ValidateWildcard(L"a?b?c*d", L"") == false);
-        assert(ValidateWildcard(L"a?b?c*d", L"abc") == false);
-        assert(ValidateWildcard(L"a?b?c*d", L"ad") == false);
-        assert(ValidateWildcard(L"a?b?c*d", L"abcd") == false);
-        assert(ValidateWildcard(L"a?b?c*d", L"aXbYcd") == true);
-        assert(ValidateWildcard(L"a?b?c*d", L"aXbYcZZZd") == true);
-        assert(ValidateWildcard(L"a?b?c*d", L"BXbYcZZZd") == false);
-        assert(ValidateWildcard(L"a?b?c*d", L"aXbY") == false);
-    }
-}
-
-void TestError()
-{
-	WriteLine(_T("==================== ERROR ===================="));
-
-	try
-	{
-		{
-			ERR_TRY;
-			{
-				ERR_TRY;
-
-				throw Error(_T("Some error."), __TFILE__, __LINE__);
-
-				ERR_CATCH(_T("Message in catch."));
-			}
-			ERR_CATCH_FUNC;
-		}
-	}
-	catch (Error &Err)
-	{
-		tstring s;
-		Err.GetMessage_(&s);
-		tcout << _T("Error Message:") << endl;
-		tcout << s << endl;
-	}
-}
-
-void TestMath()
-{
-	WriteLine(_T("==================== MATH ===================="));
-
-	{
-		tcout << _T("Testing POINT_") << endl;
-		const tstring s1 = _T("123,456");
-		POINT_ P1; tcout << StrToSth(&P1, s1) << endl;
-		POINT_ P2 = (P1 + P1) * 7;
-		tcout << (Format(_T("Result: #")) % P2).str() << endl;
-	}
-
-	{
-		tcout << _T("Testing VEC2") << endl;
-		const tstring s1 = _T("123,456");
-		VEC2 V1; tcout << StrToSth(&V1, s1) << endl;
-		VEC2 V2 = (V1 + V1) * 7.0f;
-		tcout << (Format(_T("Result: #")) % V2).str() << endl;
-	}
-
-	{
-		tcout << _T("Testing VEC3") << endl;
-		const tstring s1 = _T("123,456,789");
-		VEC3 V1; tcout << StrToSth(&V1, s1) << endl;
-		VEC3 V2 = (V1 + V1) * 7.0f;
-		tcout << (Format(_T("Result: #")) % V2).str() << endl;
-	}
-
-	{
-		tcout << _T("Testing VEC4") << endl;
-		const tstring s1 = _T("123,456,789,012");
-		VEC4 V1; tcout << StrToSth(&V1, s1) << endl;
-		VEC4 V2 = (V1 + V1) * 7.0f;
-		tcout << (Format(_T("Result: #")) % V2).str() << endl;
-	}
-
-	{
-		tcout << _T("Testing RECTI") << endl;
-		const tstring s1 = _T("123,456,789,012");
-		RECTI V1; tcout << StrToSth(&V1, s1) << endl;
-		RECTI V2 = (V1 + POINT_(1, 2)) * 7;
-		tcout << (Format(_T("Result: #")) % V2).str() << endl;
-	}
-
-	{
-		tcout << _T("Testing RECTF") << endl;
-		const tstring s1 = _T("123,456,789,012");
-		RECTF V1; tcout << StrToSth(&V1, s1) << endl;
-		RECTF V2 = (V1 + VEC2(1.0f, 2.0f)) * 7.0f;
-		tcout << (Format(_T("Result: #")) % V2).str() << endl;
-	}
-
-	{
-		tcout << _T("Testing BOX") << endl;
-		const tstring s1 = _T("1,2,3;4,5,6");
-		BOX V1; tcout << StrToSth(&V1, s1) << endl;
-		BOX V2 = (V1 + VEC3(1.0f, 2.0f, 3.0f)) * 7.0f;
-		tcout << (Format(_T("Result: #")) % V2).str() << endl;
-	}
-
-	{
-		tcout << _T("Testing COLOR") << endl;
-		const tstring s1 = _T("red");
-		const tstring s2 = _T("008080FF");
-		COLOR c1; tcout << StrToSth(&c1, s1) << endl;
-		COLOR c2; tcout << StrToSth(&c2, s2) << endl;
-		tcout << (Format(_T("Color1 = #, Color2 = #")) % c1 % c2).str() << endl;
-		tcout << (Format(_T("Color1+Color2 = #, Color1-Color2 = #, Color1*Color2 = #")) % (c1+c2) % (c1-c2) % (c1*c2)).str() << endl;
-	}
-
-	{
-		tcout << _T("Testing COLORF") << endl;
-		const tstring s1 = _T("red");
-		const tstring s2 = _T("008080FF");
-		COLORF c1; tcout << StrToSth(&c1, s1) << endl;
-		COLORF c2; tcout << StrToSth(&c2, s2) << endl;
-		tcout << (Format(_T("Color1 = #, Color2 = #")) % c1 % c2).str() << endl;
-		tcout << (Format(_T("Color1+Color2 = #, Color1-Color2 = #, Color1*Color2 = #")) % (c1+c2) % (c1-c2) % (c1*c2)).str() << endl;
-	}
-
-	{
-		tcout << _T("Testing MATRIX, PLANE, VEC*") << endl;
-
-		MATRIX m1; PerspectiveFovLH(&m1, PI_2, 4.0f/3.0f, 1.0f, 100.0f);
-		MATRIX m2; RotationYawPitchRoll(&m2, 1.0f, 2.0f, 3.0f);
-
-		PLANE plane;
-		GetPlaneNormal(plane) =VEC3_POSITIVE_Y;
-		plane.d = 1.0f;
-		tcout << (Format(_T("Plane = #")) % plane).str() << endl;
-		VEC3 vector(1.0f, 2.0f, 3.0f);
-		tcout << (Format(_T("Vector = #")) % vector).str() << endl;
-
-		PLANE plane2;
-		Transform(&plane2, plane, m1);
-		tcout << (Format(_T("Transformed plane 1 = #")) % plane2).str() << endl;
-		Transform(&plane2, plane, m2);
-		tcout << (Format(_T("Transformed plane 2 = #")) % plane2).str() << endl;
-
-		VEC3 vector2;
-		TransformCoord(&vector2, vector, m1);
-		tcout << (Format(_T("Transformed vector 1 = #")) % vector2).str() << endl;
-		TransformCoord(&vector2, vector, m2);
-		tcout << (Format(_T("Transformed vector 2 = #")) % vector2).str() << endl;
-	}
-
-	// Swizzle
-	{
-		VEC3 v1 = VEC3(1.f, 2.f, 3.f);
-		VEC2 v2 = VEC2_SWIZZLE(v1, x, x);
-		assert(around(v2.x, v1.x, 1e-6f) && around(v2.y, v1.x, 1e-6f));
-		VEC4 v3 = VEC4_SWIZZLE(v1, z, y, x, z);
-		assert(around(v3.x, v1.z, 1e-6f) && around(v3.y, v1.y, 1e-6f) && around(v3.z, v1.x, 1e-6f) && around(v3.w, v1.z, 1e-6f));
-
-		MATRIX m;
-		Identity(&m);
-		VEC4 mDiagonal = VEC4_SWIZZLE(m,_11,_22,_33,_44);
-		BOX box = BOX_ZERO;
-		VEC2 boxRangeX = VEC2_SWIZZLE(box,Min.x,Max.x);
-	}
-
-    // TriangleToTriangle
-    {
-        // TODO Fix!
-        /*
-        // Both degenerated.
-        assert(TriangleToTriangle(
-            VEC3(0.0f, 0.0f, 0.0f), VEC3(0.0f, 0.0f, 0.0f), VEC3(0.0f, 0.0f, 0.0f),
-            VEC3(1.0f, 1.0f, 1.0f), VEC3(1.0f, 1.0f, 1.0f), VEC3(1.0f, 1.0f, 1.0f)) == false);
-
-        // Really colliding triangles.
-        assert(TriangleToTriangle(
-            VEC3(3.0f, -1.0f, -0.1f), VEC3(0.0f, 3.0f, -0.3f), VEC3(-2.0f, -2.0f, -0.2f),
-            VEC3(-2.0f, 1.0f, -0.1f), VEC3(3.0f, 3.0f, -0.3f), VEC3(1.0f, -3.0f, 0.3f)) == true);
-        */
-    }
-}
-
-void TestProfiler()
-{
-	WriteLine(_T("==================== PROFILER ===================="));
-	{
-		PROFILE_GUARD(g_Profiler, _T("Everything"));
-
-		tcout << _T("Waiting 100 ms...") << endl;
-		{
-			PROFILE_GUARD(g_Profiler, _T("Waiting 100 ms"));
-			Wait(100);
-		}
-
-		tcout << _T("Making many computations...") << endl;
-		int i, j;
-		for (i = 0; i < 100; i++)
-		{
-			PROFILE_GUARD(g_Profiler, _T("Computations"));
-			int Array[1000];
-			for (j = 0; j < 1000; j++)
-			{
-				Array[j] = i*j / (i+j+1);
-			}
-		}
-	}
-
-	tstring Result;
-	g_Profiler.FormatString(&Result, PROFILER_UNITS_MILLISECONDS);
-	tcout << _T("Result:") << endl << Result << endl;
-}
-
-void TestFlatProfiler()
-{
-	FlatProfiler<tstring> flatProfiler;
-
-	{
-		FlatProfilerSampler<tstring> sampler(flatProfiler, _T("Main"));
-		for (uint i = 0; i < 10; i++)
-		{
-			{
-				FlatProfilerSampler<tstring> sampler(flatProfiler, _T("Wait10"));
-				Wait(10);
-			}
-			{
-				FlatProfilerSampler<tstring> sampler(flatProfiler, _T("Wait2"));
-				Wait(2);
-			}
-		}
-	}
-
-	tstring profile;
-	flatProfiler.FormatString(&profile, PROFILER_UNITS_MILLISECONDS);
-	WriteLine(_T("FlatProfiler result:"));
-	WriteLine(profile);
-}
-
-void TestStream()
-{
-	WriteLine(_T("==================== Stream ===================="));
-	
-	{
-		PROFILE_GUARD(g_Profiler, _T("Reading files from streams by byte"))
-
-		{
-			PROFILE_GUARD(g_Profiler, _T("FileStream"))
-
-				FileStream fs(_T("SomeFile1"), FM_READ);
-			char byte;
-			while (!fs.End())
-				fs.Read(&byte, 1);
-		}
-
-		{
-			PROFILE_GUARD(g_Profiler, _T("FileStream + BufferingStream"))
-
-				FileStream fs(_T("SomeFile2"), FM_READ);
-			BufferingStream bs(&fs, 65536, 0);
-			char byte;
-			while (!bs.End())
-				bs.Read(&byte, 1);
-		}
-	}
-}
-
-void TestEncoderDecoder()
-{
-	WriteLine(_T("==================== Kodowanie Base64 ===================="));
-
-	const uint COUNT = 100;
-	const uint MAX_SIZE = 65536;
-	char *SrcData = new char[MAX_SIZE];
-	char *DstData = new char[MAX_SIZE];
-	char *EncodedData = new char[MAX_SIZE*2];
-
-	for (uint i = 0; i < COUNT; i++)
-	{
-		uint Size = g_Rand.RandUint(1, MAX_SIZE+1);
-		uint EncodedSize;
-		g_Rand.RandData(SrcData, Size);
-		
-		{
-			MemoryStream SrcM(Size, SrcData);
-			MemoryStream EncodedM(Size*2, EncodedData);
-			{
-				Base64Encoder Hex(&EncodedM);
-				CopyToEnd(&Hex, &SrcM);
-			}
-			EncodedSize = (uint)EncodedM.GetPos();
-		}
-		{
-			MemoryStream EncodedM(EncodedSize, EncodedData);
-			MemoryStream DstM(Size, DstData);
-			try
-			{
-				Base64Decoder Hex(&EncodedM);
-				CopyToEnd(&DstM, &Hex);
-			}
-			catch (...)
-			{
-				string Src; Src.assign(SrcData, Size);
-				string Encoded; Encoded.assign(EncodedData, Size);
-				tcout << (Format(_T("Wyjatek dekodowania. SrcData=#, EncodedData=#")) % StringToTstringR(Src) % StringToTstringR(Encoded)).str() << endl;
-				throw;
-			}
-		}
-
-		if (memcmp(SrcData, DstData, Size) != 0)
-			tcout << _T("FAILED!") << endl;
-	}
-
-	delete [] EncodedData;
-	delete [] DstData;
-	delete [] SrcData;
-}
-
-class SmartPtrTestClass
-{
-private:
-	int m_i;
-
-public:
-	SmartPtrTestClass() : m_i(0) { tcout << _T("- ctor default ") << m_i << endl; }
-	SmartPtrTestClass(int i) : m_i(i) { tcout << _T("- ctor ") << m_i << endl; }
-	~SmartPtrTestClass() { tcout << _T("- dtor ") << m_i << endl; }
-	void F() { tcout << _T("- F ") << m_i << endl; }
-	void Release() { tcout << _T("- Release ") << m_i << endl; }
-};
-
-typedef int MY_HANDLE;
-
-void CreateHandle(MY_HANDLE *Out, int x)
-{
-	tcout << _T("- CreateHandle: ") << x << endl;
-	*Out = x;
-}
-
-void DestroyHandle(MY_HANDLE h)
-{
-	tcout << _T("- DestroyHandle: ") << h << endl;
-}
-
-class DestroyHandlePolicy { public: template <typename T> static void Destroy(T p) { if (p != 0) DestroyHandle(p); } };
-
-void TestSmartPointers()
-{
-	WriteLine(_T("==================== Inteligente wskaniki ===================="));
-
-	tcout << _T("- scoped_ptr 1\n");
-	{
-		scoped_ptr<SmartPtrTestClass> p1;
-		p1.reset(new SmartPtrTestClass(1));
-		p1->F();
-		p1.reset();
-		assert( p1 == p1.get() );
-		assert( p1.get() == p1 );
-		assert( p1 == NULL );
-		assert( NULL == p1 );
-	}
-	tcout << _T("- scoped_ptr 2\n");
-	{
-		scoped_ptr<SmartPtrTestClass> p2(new SmartPtrTestClass(1));
-		p2.reset(new SmartPtrTestClass(2));
-		(*p2).F();
-	}
-
-	tcout << _T("common::shared_ptr 1\n");
-	{
-		common::shared_ptr<SmartPtrTestClass> p1;
-		p1.reset(new SmartPtrTestClass(1));
-		p1->F();
-		p1.reset();
-		assert( p1 == p1.get() );
-		assert( p1.get() == p1 );
-		assert( p1 == NULL );
-		assert( NULL == p1 );
-	}
-	tcout << _T("common::shared_ptr 2\n");
-	{
-		common::shared_ptr<SmartPtrTestClass> p2(new SmartPtrTestClass(1));
-		p2.reset(new SmartPtrTestClass(2));
-		(*p2).F();
-	}
-	tcout << _T("common::shared_ptr 3\n");
-	{
-		common::shared_ptr<SmartPtrTestClass> p1;
-		common::shared_ptr<SmartPtrTestClass> p2(new SmartPtrTestClass(1));
-		p1 = p2;
-		assert( p1 == p2 );
-		p2.reset();
-		p1.get()->F();
-		common::shared_ptr<SmartPtrTestClass> p3;
-		p3 = p1;
-		(*p3).F();
-		p3.reset(common::shared_ptr<SmartPtrTestClass>(new SmartPtrTestClass(101)));
-		p3.reset(new SmartPtrTestClass(102));
-		p3.reset(NULL);
-		swap(p3, p1);
-		p3->F();
-		assert( p3.unique() );
-	}
-	tcout << _T("common::shared_ptr(Release)\n");
-	{
-		common::shared_ptr<SmartPtrTestClass, ReleasePolicy> p1(new SmartPtrTestClass(66));
-		common::shared_ptr<SmartPtrTestClass, ReleasePolicy> p2(p1);
-		p2->F();
-	}
-	tcout << _T("scoped_ptr(array)\n");
-	{
-		scoped_ptr<SmartPtrTestClass, DeleteArrayPolicy> p1(new SmartPtrTestClass[3]);
-		p1.get()[0].F();
-	}
-	tcout << _T("scoped_handle\n");
-	{
-		typedef scoped_handle<MY_HANDLE, DestroyHandlePolicy> my_scoped_handle;
-		MY_HANDLE hv;
-		CreateHandle(&hv, 1);
-		my_scoped_handle h1(hv);
-		CreateHandle(&hv, 2);
-		h1.reset(hv);
-	}
-	tcout << _T("shared_handle\n");
-	{
-		typedef shared_handle<MY_HANDLE, DestroyHandlePolicy> my_shared_handle;
-		MY_HANDLE hv;
-		my_shared_handle p1(0);
-		CreateHandle(&hv, 1);
-		my_shared_handle p2(hv);
-		p1 = p2;
-		assert( p1 == p2 );
-		p2.reset(0);
-		assert( p1 != p2 );
-		my_shared_handle p3(0);
-		p3 = p1;
-		CreateHandle(&hv, 101);
-		p3.reset(my_shared_handle(hv));
-		CreateHandle(&hv, 102);
-		p3.reset(hv);
-		p3.reset(0);
-		swap(p3, p1);
-		assert( p3.unique() );
-	}
-	tcout << _T("scoped_ptr (array)\n");
-	{
-		scoped_ptr<SmartPtrTestClass, DeleteArrayPolicy> p1;
-		p1.reset(new SmartPtrTestClass[3]);
-		p1[0].F();
-		p1[1].F();
-		p1[2].F();
-		p1.reset();
-	}
-}
-
-
-void TestFreeList()
-{
-	WriteLine(_T("==================== FreeList ===================="));
-
-	const uint COUNT = 10;
-
-	FreeList<ptrdiff_t> lista(COUNT);
-	scoped_ptr<ptrdiff_t*, DeleteArrayPolicy> tablica(new ptrdiff_t*[COUNT]);
-
-	for (uint i = 0; i < COUNT; i++)
-		tablica.get()[i] = lista.New_ctor();
-
-	tcout << _T("Przed wypelnieniem:\n");
-	for (uint i = 0; i < COUNT; i++)
-		tcout << *tablica.get()[i] << _T(' ');
-	tcout << endl;
-
-	for (uint i = 0; i < COUNT; i++)
-		*tablica.get()[i] = i;
-
-	tcout << _T("Po wypelnieniu:\n");
-	for (uint i = 0; i < COUNT; i++)
-		tcout << *tablica.get()[i] << _T(' ');
-	tcout << endl;
-
-	for (uint i = 0; i < COUNT; i++)
-		lista.Delete(tablica.get()[i]);
-}
-
-void TestDynamicFreeList()
-{
-	WriteLine(_T("==================== DynamicFreeList ===================="));
-
-	const uint BLOCK_COUNT = 3;
-	const uint COUNT = 10;
-
-	DynamicFreeList<ptrdiff_t> lista(BLOCK_COUNT);
-	scoped_ptr<ptrdiff_t*, DeleteArrayPolicy> tablica(new ptrdiff_t*[COUNT]);
-
-	tcout << (Format(_T("Stats: Empty=#, Full=#, BlockCount=#, BlockCapacity=#, UsedCount=#, FreeCount=#, Capacity=#, BlockSize=#, ...\n")) %
-		lista.IsEmpty() % lista.IsFull() % lista.GetBlockCount() % lista.GetBlockCapacity() % lista.GetUsedCount() % lista.GetFreeCount() % lista.GetCapacity() % lista.GetBlockSize()).str();
-
-	tcout << _T("Alokacja...\n");
-
-	for (uint i = 0; i < COUNT; i++)
-		tablica.get()[i] = lista.New();
-
-	tcout << _T("Elementy:\n");
-	for (uint i = 0; i < COUNT; i++)
-		tcout << *tablica.get()[i] << _T(' ');
-	tcout << endl;
-
-	tcout << _T("Wypelnianie...:\n");
-
-	for (uint i = 0; i < COUNT; i++)
-		*tablica.get()[i] = i;
-
-	tcout << (Format(_T("Stats: Empty=#, Full=#, BlockCount=#, BlockCapacity=#, UsedCount=#, FreeCount=#, Capacity=#, BlockSize=#, ...\n")) %
-		lista.IsEmpty() % lista.IsFull() % lista.GetBlockCount() % lista.GetBlockCapacity() % lista.GetUsedCount() % lista.GetFreeCount() % lista.GetCapacity() % lista.GetBlockSize()).str();
-
-	tcout << _T("Elementy:\n");
-	for (uint i = 0; i < COUNT; i++)
-		tcout << *tablica.get()[i] << _T(' ');
-	tcout << endl;
-
-	tcout << _T("Zwalnianie...:\n");
-	for (uint i = 0; i < COUNT; i++)
-		lista.Delete(tablica.get()[i]);
-
-	tcout << (Format(_T("Stats: Empty=#, Full=#, BlockCount=#, BlockCapacity=#, UsedCount=#, FreeCount=#, Capacity=#, BlockSize=#, ...\n")) %
-		lista.IsEmpty() % lista.IsFull() % lista.GetBlockCount() % lista.GetBlockCapacity() % lista.GetUsedCount() % lista.GetFreeCount() % lista.GetCapacity() % lista.GetBlockSize()).str();
-}
-
-/*
-template <typename T>
-void AdvancedFreeListTestAndProfile()
-{
-	const uint BLOCK_SIZE = 128;
-	const uint MAX_SIZE = 1024*10;
-	const uint OP_COUNT = MAX_SIZE;
-	std::vector<T*> Pointers;
-	std::vector<int> OpSequence; // > 0 = numer wskanika do zwolnienia, -1 = alokacja nowego
-	OpSequence.resize(OP_COUNT);
-	for (uint op = 0; op < OP_COUNT; op++)
-		OpSequence[op] = (g_Rand.RandUint(10) == 0) ? (int)g_Rand.RandUint(MAX_SIZE) : -1;
-
-	{
-		FreeList<T> List(MAX_SIZE);
-
-		PROFILE_GUARD(g_Profiler, _T("FreeList"));
-		for (uint op = 0; op < OP_COUNT; op++)
-		{
-			if (OpSequence[op] == -1)
-				Pointers.push_back(List.New());
-			else if (!Pointers.empty())
-			{
-				uint Index = op % Pointers.size();
-				List.Delete(Pointers[Index]);
-				Pointers.erase(Pointers.begin()+Index);
-			}
-		}
-		while (!Pointers.empty())
-		{
-			List.Delete(Pointers.back());
-			Pointers.pop_back();
-		}
-	}
-
-	{
-		DynamicFreeList<T> List(BLOCK_SIZE);
-
-		PROFILE_GUARD(g_Profiler, _T("DynamicFreeList"));
-		for (uint op = 0; op < OP_COUNT; op++)
-		{
-			if (OpSequence[op] == -1)
-				Pointers.push_back(List.New());
-			else if (!Pointers.empty())
-			{
-				uint Index = op % Pointers.size();
-				List.Delete(Pointers[Index]);
-				Pointers.erase(Pointers.begin()+Index);
-			}
-		}
-		while (!Pointers.empty())
-		{
-			List.Delete(Pointers.back());
-			Pointers.pop_back();
-		}
-	}
-
-	{
-		PROFILE_GUARD(g_Profiler, _T("new i delete"));
-		for (uint op = 0; op < OP_COUNT; op++)
-		{
-			if (OpSequence[op] == -1)
-				Pointers.push_back(new T);
-			else if (!Pointers.empty())
-			{
-				uint Index = op % Pointers.size();
-				delete Pointers[Index];
-				Pointers.erase(Pointers.begin()+Index);
-			}
-		}
-		while (!Pointers.empty())
-		{
-			delete Pointers.back();
-			Pointers.pop_back();
-		}
-	}
-}
-
-class DuzaKlasa
-{
-	char Zapelniacz[1024];
-};
-
-void CompelexTestFreeLists()
-{
-	for (uint TestI = 0; TestI < 10; TestI++)
-	{
-		{
-			PROFILE_GUARD(g_Profiler, _T("Element typu int"));
-			AdvancedFreeListTestAndProfile<int>();
-		}
-		{
-			PROFILE_GUARD(g_Profiler, _T("Element typu zajmujacego 1024 bajty"));
-			AdvancedFreeListTestAndProfile<DuzaKlasa>();
-		}
-	}
-}
-*/
-
-void TestZlibUtils()
-{
-	WriteLine(_T("==================== ZLIB UTILS ===================="));
-
-	const char * const INPUT_DATA = "Ala ma kota, To jest test, Hello World, ble ble ble, delelele, blfzcf i dupadupa";
-	
-	{
-		size_t OutputBufLen = ZlibCompressionStream::CompressLength(strlen(INPUT_DATA));
-		scoped_ptr<char, DeleteArrayPolicy> OutputData(new char[OutputBufLen]);
-
-		size_t OutputSize = ZlibCompressionStream::Compress(OutputData.get(), OutputBufLen, INPUT_DATA, strlen(INPUT_DATA));
-
-		scoped_ptr<char, DeleteArrayPolicy> Input2Data(new char[strlen(INPUT_DATA)]);
-		size_t Input2Size = ZlibDecompressionStream::Decompress(Input2Data.get(), strlen(INPUT_DATA), OutputData.get(), OutputSize);
-		WriteLine(Format(_T("InputLen=#, OutputBufMaxLen=#, OutputSize=#, InputLen2=#")) % strlen(INPUT_DATA) % OutputBufLen % OutputSize % Input2Size);
-
-		for (uint i = 0; INPUT_DATA[i] != '\0'; i++)
-			assert( INPUT_DATA[i] == Input2Data[i] );
-	}
-
-	{
-		VectorStream v1;
-		{
-			ZlibCompressionStream c1(&v1);
-			c1.Write(INPUT_DATA, strlen(INPUT_DATA));
-		}
-		v1.Rewind();
-		VectorStream v1d;
-		{
-			ZlibDecompressionStream d1(&v1);
-			assert (d1.End() == false );
-			CopyToEnd(&v1d, &d1);
-			assert (d1.End() == true );
-		}
-		bool Correct1 = (v1d.GetSize() == strlen(INPUT_DATA));
-		if (Correct1)
-		{
-			for (uint i = 0; INPUT_DATA[i] != '\0'; i++)
-			{
-				if (INPUT_DATA[i] != v1d.Data()[i])
-				{
-					Correct1 = false;
-					break;
-				}
-			}
-		}
-		WriteLine(Format(_T("Compression/decompression (cao):\n  in_len=#, out_len=#, po_dekompresji_len=#, correct=#")) % strlen(INPUT_DATA) % v1.GetSize() % v1d.GetSize() % Correct1);
-
-		VectorStream v2;
-		{
-			ZlibCompressionStream c2(&v2);
-			for (uint i = 0; INPUT_DATA[i] != '\0'; i++)
-				c2.Write(&INPUT_DATA[i], 1);
-			c2.Flush();
-		}
-		v2.Rewind();
-		VectorStream v2d;
-		{
-			ZlibDecompressionStream d2(&v2);
-			for (uint i = 0; INPUT_DATA[i] != '\0'; i++)
-			{
-				assert( d2.End() == false );
-				char Ch;
-				d2.MustRead(&Ch, 1);
-				v2d.Write(&Ch, 1);
-			}
-			assert( d2.End() == true );
-		}
-		bool Correct2 = (v2d.GetSize() == strlen(INPUT_DATA));
-		if (Correct2)
-		{
-			for (uint i = 0; INPUT_DATA[i] != '\0'; i++)
-			{
-				if (INPUT_DATA[i] != v2d.Data()[i])
-				{
-					Correct2 = false;
-					break;
-				}
-			}
-		}
-		WriteLine(Format(_T("Compression/decompression (po znaku):\n  in_len=#, out_len=#, po_dekompresji_len=#, correct=#")) % strlen(INPUT_DATA) % v2.GetSize() % v2d.GetSize() % Correct2);
-
-		// Test dla pustego
-		VectorStream ev;
-		{
-			ZlibCompressionStream c(&ev);
-		}
-		ev.Rewind();
-		VectorStream evd;
-		{
-			ZlibDecompressionStream d(&ev);
-			assert( d.End() == true );
-			CopyToEnd(&evd, &d);
-			assert( d.End() == true );
-		}
-		WriteLine(Format(_T("Compression/decompression (pusty):\n  in_len=(0), out_len=#, po_dekompresji_len=#")) % ev.GetSize() % evd.GetSize());
-	}
-
-	// Test gzip
-	{
-		const string FileName1 = "Plik.test", Comment1 = "Komentarz";
-
-		// Test 1 - plik
-		{
-			common::GzipFileStream Plik("Archive.gz", common::GZFM_WRITE);
-			Plik.Write(INPUT_DATA, strlen(INPUT_DATA));
-		}
-		{
-			common::GzipFileStream Plik("Archive.gz", common::GZFM_READ);
-			assert( Plik.End() == false );
-			std::vector<char> Data;
-			Data.resize(strlen(INPUT_DATA));
-			Plik.MustRead(&Data[0], strlen(INPUT_DATA));
-			assert( Plik.End() == true );
-			char Foo;
-			assert( Plik.Read(&Foo, 1) == 0 );
-			assert( std::equal(&INPUT_DATA[0], &INPUT_DATA[strlen(INPUT_DATA)], Data.begin()) );
-			WriteLine(_T("Gzip - file - PASSED"));
-		}
-
-		common::DeleteFile(_T("Archive.gz"));
-
-		// Test 2 - strumie
-		{
-			common::FileStream Plik(_T("Archive.gz"), common::FM_WRITE);
-			GzipCompressionStream Gzip(&Plik, &FileName1, &Comment1);
-			Gzip.WriteStringF(INPUT_DATA);
-		}
-		{
-			common::FileStream Plik(_T("Archive.gz"), common::FM_READ);
-			string FileName2, Comment2;
-			GzipDecompressionStream Gzip(&Plik);
-			std::vector<char> Data;
-			Data.resize(strlen(INPUT_DATA));
-			for (uint i = 0; INPUT_DATA[i] != '\0'; i++)
-			{
-				assert( Gzip.End() == false );
-				Gzip.MustRead(&Data[i], 1);
-			}
-			assert( Gzip.End() == true );
-			char Foo;
-			assert( Gzip.Read(&Foo, 1) == 0 );
-			assert( std::equal(&INPUT_DATA[0], &INPUT_DATA[strlen(INPUT_DATA)], Data.begin()) );
-			assert( Gzip.GetHeaderFileName(&FileName2) == true );
-			assert( Gzip.GetHeaderComment(&Comment2) == true );
-			assert( FileName2 == FileName1 );
-			assert( Comment2 == Comment1 );
-			WriteLine(_T("Gzip - stream - PASSED"));
-		}
-
-		common::DeleteFile(_T("Archive.gz"));
-	}
-}
-
-void TestFiles()
-{
-	WriteLine(_T("==================== FILES ===================="));
-
-	tstring Name;
-	common::FILE_ITEM_TYPE Type;
-
-#ifdef _WIN32
-	const tchar * PATHS[] =
-	{
-		_T("D:"),
-		_T("C:\\Windows"),
-		_T("EmptyDir"),
-		_T("")
-	};
-#else
-	const tchar * PATHS[] =
-	{
-		_T("/"),
-		_T("/boot"),
-		_T("EmptyDir"),
-		_T("")
-	};
-#endif
-
-#ifdef _WIN32
-	for (uint i = 0; _tcslen(PATHS[i]) > 0; i++)
-#else
-	for (uint i = 0; strlen(PATHS[i]) > 0; i++)
-#endif
-	{
-		WriteLine(Format(_T("Listowanie katalogu: #")) % PATHS[i]);
-		common::DirLister Lister(PATHS[i]);
-		while (Lister.ReadNext(&Name, &Type))
-			tcout << (Format(_T("- # # ")) % ((Type == common::IT_DIR) ? _T("DIR ") : _T("FILE")) % Name).str();
-		tcout << endl;
-	}
-
-	{
-		common::DATETIME ctime, mtime, atime; uint64 size; common::FILE_ITEM_TYPE type;
-		common::MustGetFileItemInfo(_T("EmptyDir"), &type, &size, &mtime, &ctime, &atime);
-		WriteLine(Format(_T("MustGetFileItemInfo(\"EmptyDir\"): Type=#, Size=#\n  MTime=#\n  CTime=#\n  ATime=#")) %
-			(uint)type % size % common::TMSTRUCT(mtime) % common::TMSTRUCT(ctime) % common::TMSTRUCT(atime));
-		common::MustGetFileItemInfo(_T("TwoCharFile.txt"), &type, &size, &mtime, &ctime, &atime);
-		WriteLine(Format(_T("MustGetFileItemInfo(\"TwoCharFile.txt\"): Type=#, Size=#\n  MTime=#\n  CTime=#\n  ATime=#")) %
-			(uint)type % size % common::TMSTRUCT(mtime) % common::TMSTRUCT(ctime) % common::TMSTRUCT(atime));
-	}
-
-	{
-		WriteLine(Format(_T("GetFileItemType(\"EmptyDir\") = #")) % (uint)common::GetFileItemType(_T("EmptyDir")));
-		WriteLine(Format(_T("GetFileItemType(\"TwoCharFile.txt\") = #")) % (uint)common::GetFileItemType(_T("TwoCharFile.txt")));
-		WriteLine(Format(_T("GetFileItemType(\"Wrong.foo\") = #")) % (uint)common::GetFileItemType(_T("Wrong.foo")));
-	}
-
-	{
-		common::MustUpdateFileTimeToNow(_T("TwoCharFile.txt"));
-		common::DATETIME ctime, mtime, atime;
-		common::MustGetFileItemInfo(_T("TwoCharFile.txt"), NULL, NULL, &mtime, &ctime, &atime);
-		WriteLine(Format(_T("MustGetFileItemInfo(\"TwoCharFile.txt\") after MustUpdateFileTimeToNow:\n  MTime=#\n  CTime=#\n  ATime=#")) %
-			common::TMSTRUCT(mtime) % common::TMSTRUCT(ctime) % common::TMSTRUCT(atime));
-	}
-
-	{
-		tstring Dir = _T("EmptyDir") + CharToStrR(DIR_SEP) + _T("Test1") + CharToStrR(DIR_SEP) + _T("Test2");
-		common::MustCreateDirectoryChain(Dir);
-		assert( common::GetFileItemType(Dir) == common::IT_DIR );
-		common::MustDeleteDirectory(Dir);
-		common::MustDeleteDirectory(_T("EmptyDir") + CharToStrR(DIR_SEP) + _T("Test1"));
-		assert( common::GetFileItemType(Dir) == common::IT_NONE );
-		WriteLine(_T("MustCreateDirectoryChain and MustDeleteDirectory test succeeded."));
-	}
-
-	{
-		tstring FileName1 = _T("TEMP1");
-		tstring FileName2 = _T("TEMP2");
-		assert( common::GetFileItemType(FileName1) == common::IT_NONE );
-		assert( common::GetFileItemType(FileName2) == common::IT_NONE );
-		{
-			common::FileStream Plik(FileName1, common::FM_WRITE);
-		}
-		assert( common::GetFileItemType(FileName1) == common::IT_FILE );
-		assert( common::GetFileItemType(FileName2) == common::IT_NONE );
-		common::MustMoveItem(FileName1, FileName2);
-		assert( common::GetFileItemType(FileName1) == common::IT_NONE );
-		assert( common::GetFileItemType(FileName2) == common::IT_FILE );
-		common::MustDeleteFile(FileName2);
-		assert( common::GetFileItemType(FileName1) == common::IT_NONE );
-		assert( common::GetFileItemType(FileName2) == common::IT_NONE );
-		WriteLine(_T("MustMoveFile and MustDeleteFile test succeeded."));
-	}
-}
-
-void TestDateTime()
-{
-	WriteLine(_T("==================== DATETIME ===================="));
-
-	{
-		tcout << _T("Time measurement:") << endl;
-		tcout << _T("  Current time = ") << GetCurrentGameTime().ToSeconds_d() << endl;
-		tcout << _T("  Waiting 0.1 s...") << endl;
-		Wait(100);
-		tcout << _T("  Current time = ") << GetCurrentGameTime().ToSeconds_d() << endl;
-	}
-
-	tstring s, s1, s2;
-
-	common::DATETIME dtnow = common::Now();
-	common::TMSTRUCT tmnow = common::TMSTRUCT(dtnow);
-	WriteLine(Format(_T("Now  = # = #")) % dtnow % tmnow);
-
-	common::DATETIME dtunow = common::UNow();
-	common::TMSTRUCT tmunow = common::TMSTRUCT(dtunow);
-	WriteLine(Format(_T("UNow = # = #")) % dtunow % tmunow);
-
-	common::DateToStr(&s, tmunow, _T("wu, d Nf y h:m:s:i"));
-	WriteLine(Format(_T("UNow (wasny format) = #")) % s);
-
-	common::TMSTRUCT tmunow2;
-	assert( common::StrToDate(&tmunow2, s, _T("wu, d Nf y h:m:s:i")) );
-	WriteLine(Format(_T("tstring > TMSTRUCT = #")) % tmunow2);
-
-	common::DATETIME dtunow2(tmunow2);
-	WriteLine(Format(_T("TMSTRUCT > DATETIME = #")) % dtunow2);
-
-	common::TIMESPAN ts = common::TIMESPAN::Hour() + common::TIMESPAN::Minutes(15);
-	ts.ToString(&s1, true);
-	ts.ToString_Nice(&s2);
-	WriteLine(Format(_T("TIMESPAN: # = # = #")) % ts % s1 % s2);
-
-	common::DATETIME dt_plus_ts = dtnow - ts;
-	common::TMSTRUCT dt_plus_ts_tm(dt_plus_ts);
-	WriteLine(Format(_T("Now - TIMESPAN = #, dzie tygodnia: #")) % dt_plus_ts_tm % common::GetWeekDayName(dt_plus_ts_tm.GetWeekDay(), common::NAME_LONG_LOWERCASE));
-
-	common::DATESPAN ds(0, 0, 0, 15);
-	common::TMSTRUCT tm_plus_ds = tmnow - ds;
-	WriteLine(Format(_T("Now - DATESPAN(15 dni) = #, dzie tygodnia: #")) % tm_plus_ds % common::GetWeekDayName(tm_plus_ds.GetWeekDay(), common::NAME_LONG_LOWERCASE));
-
-	common::TMSTRUCT tm_custom(28, common::OCT, 2007, 13, 14, 15, 16);
-	WriteLine(Format(_T("Wasna data = #, WeekDay=#")) % tm_custom % common::GetWeekDayName(tm_custom.GetWeekDay(), common::NAME_SHORT_LOWERCASE));
-	//WriteLine(Format(_T("Wasna data = #, WeekDay=#, DayOfYear=#, WeekOfYear=#, WeekOfMonth=#")) %
-	//	tm_custom % common::GetWeekDayName(tm_custom.GetWeekDay(), common::NAME_SHORT_LOWERCASE) %
-	//	tm_custom.GetDayOfYear() % tm_custom.GetWeekOfYear() % tm_custom.GetWeekOfMonth());
-}
-
-void TestCmdLineParser()
-{
-	WriteLine(_T("==================== CMD LINE PARSER ===================="));
-
-	const tchar * CMD_LINE = _T("-a -b -c param -abc=\"param\" \"-cparam\" /AA --AA \"/BBB\"=param DUPA --BBB \"param\"");
-	CmdLineParser Parser(CMD_LINE);
-	Parser.RegisterOpt(1, _T('a'), false);
-	Parser.RegisterOpt(2, _T('b'), false);
-	Parser.RegisterOpt(3, _T('c'), true);
-	Parser.RegisterOpt(11, _T("AA"), false);
-	Parser.RegisterOpt(12, _T("BBB"), true);
-
-	int Id; tstring Param, RS;
-	CmdLineParser::RESULT R;
-	do
-	{
-		R = Parser.ReadNext();
-		Id = Parser.GetOptId();
-		Param = Parser.GetParameter();
-		switch (R)
-		{
-		case CmdLineParser::RESULT_END:       RS = _T("RESULT_END      "); break;
-		case CmdLineParser::RESULT_OPT:       RS = _T("RESULT_OPT      "); break;
-		case CmdLineParser::RESULT_ERROR:     RS = _T("RESULT_ERROR    "); break;
-		case CmdLineParser::RESULT_PARAMETER: RS = _T("RESULT_PARAMETER"); break;
-		}
-		WriteLine(Format(_T("Opt: Result=#, Id=#, Param=#")) % RS % Id % Param);
-	} while (R != CmdLineParser::RESULT_END && R != CmdLineParser::RESULT_ERROR);
-}
-
-void TestTokenizer()
-{
-	WriteLine(_T("==================== TOKENIZER ===================="));
-	string FileS;
-	LoadStringFromFile(_T("Tokens.dat"), &FileS);
-	tstring File = StringToTstringR(FileS);
-	Tokenizer tokenizer(&File, Tokenizer::FLAG_MULTILINE_STRINGS);
-
-	const tchar *KEYWORDS[] = { _T("false"), _T("true") };
-	tokenizer.RegisterKeywords(KEYWORDS, 2);
-
-	Tokenizer::TOKEN t;
-	tstring s;
-	size_t hn, rn, cn;
-	do
-	{
-		tokenizer.Next();
-
-		t = tokenizer.GetToken();
-		hn = tokenizer.GetCharNum();
-		rn = tokenizer.GetRowNum();
-		cn = tokenizer.GetColNum();
-		s  = tokenizer.GetString();
-
-		WriteLine(Format(_T("Token: char=#, row=#, col=#, type=#, tstring=#")) % hn % rn % cn % tokenizer.GetTokenName(t) % s);
-
-		if (t == Tokenizer::TOKEN_INTEGER)
-			WriteLine(Format(_T("  value=#")) % tokenizer.MustGetInt4());
-		else if (t == Tokenizer::TOKEN_FLOAT)
-			WriteLine(Format(_T("  value=#")) % tokenizer.MustGetFloat());
-
-	} while (t != Tokenizer::TOKEN_EOF);
-
-	const tchar * const TEXT_TO_ESCAPE = _T("abcd tab:\t vtab:\v eol:\r\n quot:\" apos:\' strange=\xE0 _");
-	tstring Escaped;
-	TokenWriter::Escape(&Escaped, TEXT_TO_ESCAPE, TokenWriter::ESCAPE_EOL | TokenWriter::ESCAPE_OTHER);
-	WriteLine(_T("Text to escape : ") + tstring(TEXT_TO_ESCAPE));
-	WriteLine(_T("Escaped text   : ") + Escaped);
-}
-
-scoped_ptr<Mutex> g_Mutex;
-
-void WriteLineMT(const tstring &s)
-{
-	MUTEX_LOCK(*g_Mutex.get());
-	WriteLine(s);
-}
-
-class MyThread : public Thread
-{
-private:
-	tstring m_Id;
-
-protected:
-	virtual void Run();
-
-public:
-	MyThread(const tstring &Id) : m_Id(Id) { }
-};
-
-void MyThread::Run()
-{
-	WriteLineMT(Format(_T("Thread #: Begin")) % m_Id);
-	for (uint i = 0; i < 3; i++)
-	{
-		{
-			MUTEX_LOCK(*g_Mutex.get());
-			{
-				MUTEX_LOCK(*g_Mutex.get());
-
-				Wait(g_Rand.RandUint(100, 200));
-				WriteLineMT(Format(_T("Thread #: Iter=#")) % m_Id % i);
-			}
-		}
-		//Yield_();
-	}
-	WriteLineMT(Format(_T("Thread #: End")) % m_Id);
-}
-
-class ProducerConsumerBuffer
-{
-private:
-	Semaphore m_ElementCount;
-	Semaphore m_EmptyCount;
-	std::queue<char> m_Queue;
-
-public:
-	ProducerConsumerBuffer();
-	void Push(char Ch);
-	char Pop();
-};
-
-ProducerConsumerBuffer::ProducerConsumerBuffer() :
-	m_ElementCount(0),
-	m_EmptyCount(3)
-{
-}
-
-void ProducerConsumerBuffer::Push(char Ch)
-{
-	m_EmptyCount.P();
-
-	{
-		MUTEX_LOCK(*g_Mutex.get());
-		m_Queue.push(Ch);
-	}
-
-	m_ElementCount.V();
-}
-
-char ProducerConsumerBuffer::Pop()
-{
-	char R;
-
-	m_ElementCount.P();
-
-	{
-		MUTEX_LOCK(*g_Mutex.get());
-		R = m_Queue.front();
-		m_Queue.pop();
-	}
-
-	m_EmptyCount.V();
-
-	return R;
-}
-
-class ProducerThread : public Thread
-{
-private:
-	ProducerConsumerBuffer *m_Buffer;
-
-protected:
-	virtual void Run();
-
-public:
-	ProducerThread(ProducerConsumerBuffer *Buffer) : m_Buffer(Buffer) { }
-};
-
-void ProducerThread::Run()
-{
-	WriteLineMT(_T("Producer: Producing 5 chars..."));
-	for (uint i = 0; i < 5; i++)
-	{
-		char Ch = (char)(i+_T('A'));
-		m_Buffer->Push(Ch);
-		WriteLineMT(_T("Producer: Produced char: ") + CharToStrR(Ch));
-	}
-
-	m_Buffer->Push(_T('\0'));
-}
-
-class ConsumerThread : public Thread
-{
-private:
-	ProducerConsumerBuffer *m_Buffer;
-
-protected:
-	virtual void Run();
-
-public:
-	ConsumerThread(ProducerConsumerBuffer *Buffer) : m_Buffer(Buffer) { }
-};
-
-void ConsumerThread::Run()
-{
-    WriteLineMT(_T("Consumer: Waiting 2000 ms..."));
-	Wait(2000);
-
-	char Ch;
-
-	for (;;)
-	{
-		Ch = m_Buffer->Pop();
-		if (Ch == _T('\0')) break;
-		WriteLineMT(_T("Consumer: Consumed char: ") + CharToStrR(Ch));
-		Wait(1000);
-	}
-}
-
-class ProducerConsumerBuffer2
-{
-private:
-	Cond m_BufferNotEmpty;
-	Cond m_BufferNotFull;
-	Mutex m_Mutex;
-	std::queue<char> m_Queue;
-
-public:
-	ProducerConsumerBuffer2();
-	void Push(char Ch);
-	char Pop();
-};
-
-ProducerConsumerBuffer2::ProducerConsumerBuffer2() :
-	m_Mutex(0)
-{
-}
-
-void ProducerConsumerBuffer2::Push(char Ch)
-{
-	MUTEX_LOCK(m_Mutex);
-
-	while (m_Queue.size() == 3)
-		m_BufferNotFull.Wait(&m_Mutex);
-
-	m_Queue.push(Ch);
-
-	m_BufferNotEmpty.Signal();
-}
-
-char ProducerConsumerBuffer2::Pop()
-{
-	MUTEX_LOCK(m_Mutex);
-
-	while (m_Queue.size() == 0)
-		m_BufferNotEmpty.Wait(&m_Mutex);
-
-	char R = m_Queue.front();
-	m_Queue.pop();
-
-	m_BufferNotFull.Signal();
-
-	return R;
-}
-
-class ProducerThread2 : public Thread
-{
-private:
-	ProducerConsumerBuffer2 *m_Buffer;
-
-protected:
-	virtual void Run();
-
-public:
-	ProducerThread2(ProducerConsumerBuffer2 *Buffer) : m_Buffer(Buffer) { }
-};
-
-void ProducerThread2::Run()
-{
-	WriteLineMT(_T("Producer: Producing 5 chars..."));
-	for (uint i = 0; i < 5; i++)
-	{
-		char Ch = (char)(i+_T('A'));
-		m_Buffer->Push(Ch);
-		WriteLineMT(_T("Producer: Produced char: ") + CharToStrR(Ch));
-	}
-
-	m_Buffer->Push(_T('\0'));
-}
-
-class ConsumerThread2 : public Thread
-{
-private:
-	ProducerConsumerBuffer2 *m_Buffer;
-
-protected:
-	virtual void Run();
-
-public:
-	ConsumerThread2(ProducerConsumerBuffer2 *Buffer) : m_Buffer(Buffer) { }
-};
-
-void ConsumerThread2::Run()
-{
-	WriteLineMT(_T("Consumer: Waiting 2000 ms..."));
-	Wait(2000);
-
-	char Ch;
-
-	for (;;)
-	{
-		Ch = m_Buffer->Pop();
-		if (Ch == _T('\0')) break;
-		WriteLineMT(_T("Consumer: Consumed char: ") + CharToStrR(Ch));
-		Wait(1000);
-	}
-}
-
-class WaitingThread : public Thread
-{
-private:
-	tchar m_Id;
-	Barrier *m_Barrier;
-
-protected:
-	virtual void Run();
-
-public:
-	WaitingThread(char Id, Barrier *b) : m_Id(Id), m_Barrier(b) { }
-};
-
-void WaitingThread::Run()
-{
-	for (uint i = 0; i < 5; i++)
-	{
-		uint Time = g_Rand.RandUint(100, 1000);
-		WriteLineMT(Format(_T("WaitingThread # Iter # waiting for # ms before barrier.")) % m_Id % i % Time);
-		Wait(Time);
-		m_Barrier->Wait();
-	}
-}
-
-class CancellableThread : public Thread
-{
-private:
-	Event m_CancelEvent;
-
-protected:
-	virtual void Run();
-
-public:
-	CancellableThread();
-
-	void Cancel();
-};
-
-void CancellableThread::Run()
-{
-	for (uint i = 0; i < 10; i++)
-	{
-		WriteLineMT(Format(_T("CancellableThread: Iter #")) % i);
-		Wait(100);
-		if (m_CancelEvent.Test())
-		{
-			WriteLineMT(_T("CancellableThread: Cancelled"));
-			return;
-		}
-	}
-
-	WriteLineMT(_T("CancellableThread: Done all iters, wainting for cancel..."));
-	m_CancelEvent.Wait();
-	WriteLineMT(_T("CancellableThread: Got cancel."));
-}
-
-CancellableThread::CancellableThread() :
-	m_CancelEvent(false, Event::TYPE_AUTO_RESET)
-{
-}
-
-void CancellableThread::Cancel()
-{
-	m_CancelEvent.Set();
-}
-
-
-void TestThreads()
-{
-	WriteLine(_T("==================== THREADS ===================="));
-
-	g_Mutex.reset(new Mutex(Mutex::FLAG_RECURSIVE));
-    
-    {
-		WriteLine(_T("-------------------- Basic test --------------------"));
-		scoped_ptr<MyThread> Threads[4];
-
-		for (uint i = 0; i < 4; i++)
-			Threads[i].reset(new MyThread(UintToStrR(i)));
-			
-		for (uint i = 0; i < 4; i++)
-			Threads[i]->Start();
-
-		#ifdef _WIN32
-			Threads[0]->SetPriority(Thread::PRIORITY_HIGH);
-			WriteLine(Format(_T("Main: Thread 1 Running: #")) % Threads[0]->IsRunning());
-		#endif
-
-		for (uint i = 0; i < 4; i++)
-			Threads[i]->Join();
-
-		#ifdef _WIN32
-			WriteLine(Format(_T("Main: Thread 1 Running: #")) % Threads[0]->IsRunning());
-		#endif
-	}
-
-	{
-		WriteLine(_T("-------------------- Producer-consumer (semaphore) --------------------"));
-		ProducerConsumerBuffer Buf;
-		ProducerThread Producer(&Buf);
-		ConsumerThread Consumer(&Buf);
-		Producer.Start();
-		Consumer.Start();
-		Producer.Join();
-		Consumer.Join();
-	}
-	
-	{
-		WriteLine(_T("-------------------- Semaphore::TimeoutP --------------------"));
-		WriteLine(_T("Tu ma by czekanie 2 s..."));
-		Semaphore sem(0);
-		sem.TimeoutP(2000);
-		WriteLine(_T("Ju."));
-	}
-
-	{
-		WriteLine(_T("-------------------- Producer-consumer 2 (cond) --------------------"));
-		ProducerConsumerBuffer2 Buf;
-		ProducerThread2 Producer(&Buf);
-		ConsumerThread2 Consumer(&Buf);
-		Producer.Start();
-		Consumer.Start();
-		Producer.Join();
-		Consumer.Join();
-	}
-	
-    {
-		WriteLine(_T("-------------------- WaitingThread (barrier) --------------------"));
-		Barrier B(5);
-		scoped_ptr<WaitingThread> Threads[5];
-		for (uint i = 0; i < 5; i++)
-			Threads[i].reset(new WaitingThread((char)(i + _T('0')), &B));
-		for (uint i = 0; i < 5; i++)
-			Threads[i]->Start();
-		for (uint i = 0; i < 5; i++)
-			Threads[i]->Join();
-	}
-
-	
-	{
-		WriteLine(_T("-------------------- CancellableThread (event) --------------------"));
-
-		WriteLine(_T("Test 1: Cancelling before iters finished. Event::Test"));
-		CancellableThread T1;
-		T1.Start();
-		Wait(300);
-		T1.Cancel();
-		T1.Join();
-
-		WriteLine(_T("Test 2: Cancelling after iters finished. Event::Wait"));
-		CancellableThread T2;
-		T2.Start();
-		Wait(1200);
-		T2.Cancel();
-		T2.Join();
-	}
-
-	g_Mutex.reset();
-}
-
-class LoggingThread : public Thread
-{
-private:
-	common::Logger & m_Logger;
-	tstring m_ThreadName;
-
-protected:
-	virtual void Run();
-
-public:
-	LoggingThread(common::Logger & Logger, const tstring &ThreadName) : m_Logger(Logger), m_ThreadName(ThreadName) { }
-
-	void CustomRun() { Run(); }
-};
-
-void LoggingThread::Run()
-{
-	for (int i = 0; i < 10; i++)
-	{
-		m_Logger.Log(1, Format(_T("Message from thread \"#\" number \"#\"")) % m_ThreadName % i);
-	}
-}
-
-void TestLogger()
-{
-	WriteLine(_T("==================== LOGGER ===================="));
-
-	common::CreateLogger(true);
-
-	common::Logger & Logger = common::GetLogger();
-
-	scoped_ptr<common::ILog> HtmlLog(new common::HtmlFileLog(_T("Log.html"), common::FILE_MODE_NORMAL));
-	scoped_ptr<common::ILog> ConsoleLog(new common::OstreamLog(&tcout));
-
-	Logger.AddLogMapping(0xFFFFFFFF, HtmlLog.get());
-	Logger.AddLogMapping(0xFFFFFFFF, ConsoleLog.get());
-
-	Logger.SetPrefixFormat(_T("[%D %T] "));
-
-	LoggingThread Thread1(Logger, _T("Thread1"));
-	LoggingThread Thread2(Logger, _T("Thread2"));
-
-	Thread1.Start();
-	Thread2.Start();
-
-	LoggingThread MainThread(Logger, _T("MainThread"));
-	MainThread.CustomRun();
-
-	Thread2.Join();
-	Thread1.Join();
-
-	common::DestroyLogger();
-
-	ConsoleLog.reset(0);
-	HtmlLog.reset(0);
-}
-
-#ifdef _WIN32
-void TestBstrString()
-{
-	BstrString b1 = "Dupa";
-	BstrString b2 = L"dupA";
-	assert(BstrString::Cmp(b1, b2, true) == 0);
-	BstrString b3 = b1 + b2;
-	BstrString b4 = b3.substr(3, 2);
-	b4 += string("am");
-	assert(b4.length() == 4);
-	cout << "Here should be \"adam\": " << b4.c_str() << endl;
-}
-#endif // #ifdef _WIN32
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-// Test for ObjList
-
-// HPP
-
-class ItemClassStatic
-{
-public:
-	ItemClassStatic();
-	~ItemClassStatic();
-
-	STATIC_OBJLIST_ITEM_METHODS(ListClassStatic, ItemClassStatic, NAME)
-
-private:
-	STATIC_OBJLIST_ITEM_FIELDS(ListClassStatic, ItemClassStatic, NAME)
-};
-
-class ListClassStatic
-{
-public:
-	STATIC_OBJLIST_LIST_METHODS(ListClassStatic, ItemClassStatic, NAME)
-
-private:
-	STATIC_OBJLIST_LIST_FIELDS(ListClassStatic, ItemClassStatic, NAME)
-};
-
-class ListClass;
-
-class ItemClass
-{
-public:
-	ItemClass();
-	~ItemClass();
-
-	OBJLIST_ITEM_METHODS(ListClass, ItemClass, NAME)
-
-private:
-	OBJLIST_ITEM_FIELDS(ListClass, ItemClass, NAME)
-};
-
-class ListClass
-{
-public:
-	ListClass();
-	~ListClass();
-
-	OBJLIST_LIST_METHODS(ListClass, ItemClass,NAME)
-
-private:
-	OBJLIST_LIST_FIELDS(ListClass, ItemClass, NAME)
-};
-
-// CPP
-
-ItemClassStatic::ItemClassStatic()
-{
-	STATIC_OBJLIST_ITEM_CTOR(ListClassStatic, ItemClassStatic, NAME);
-}
-
-ItemClassStatic::~ItemClassStatic()
-{
-	STATIC_OBJLIST_ITEM_DTOR(ListClassStatic, ItemClassStatic, NAME);
-}
-
-STATIC_OBJLIST_LIST_IMPL(ListClassStatic, ItemClassStatic, NAME)
-
-ItemClass::ItemClass()
-{
-	OBJLIST_ITEM_CTOR(ListClass, ItemClass, NAME)
-}
-
-ItemClass::~ItemClass()
-{
-	OBJLIST_ITEM_DTOR(ListClass, ItemClass, NAME)
-}
-
-OBJLIST_LIST_IMPL(ListClass, ItemClass, NAME)
-
-ListClass::ListClass()
-{
-	OBJLIST_LIST_CTOR(ListClass, ItemClass, NAME)
-}
-
-ListClass::~ListClass()
-{
-	OBJLIST_LIST_DTOR(ListClass, ItemClass, NAME)
-}
-
-void TestObjListStatic()
-{
-	ItemClassStatic i1, i2, i3;
-	ListClassStatic::NAME_InsertBack(&i1);
-	ListClassStatic::NAME_InsertBack(&i2);
-	ListClassStatic::NAME_InsertBack(&i3);
-	assert(ListClassStatic::NAME_GetItemCount() == 3);
-	uint count = 0;
-	for (ItemClassStatic *i = ListClassStatic::NAME_GetFirst(); i != NULL; i = i->NAME_GetNext())
-	{
-		switch (count)
-		{
-		case 0: assert(i == &i1); break;
-		case 1: assert(i == &i2); break;
-		case 2: assert(i == &i3); break;
-		}
-		count++;
-	}
-	assert(count == 3);
-	ListClassStatic::NAME_Remove(&i2);
-	ListClassStatic::NAME_Remove(&i1);
-	assert(ListClassStatic::NAME_GetItemCount() == 1);
-	ListClassStatic::NAME_Clear();
-	assert(ListClassStatic::NAME_GetItemCount() == 0);
-	assert(i1.NAME_IsOnList() == false);
-	assert(i2.NAME_IsOnList() == false);
-	assert(i3.NAME_IsOnList() == false);
-}
-
-void TestObjListNormal()
-{
-	ListClass myList;
-	ItemClass i1, i2, i3;
-	myList.NAME_InsertBack(&i1);
-	myList.NAME_InsertBack(&i2);
-	myList.NAME_InsertBack(&i3);
-	assert(myList.NAME_GetItemCount() == 3);
-	uint count = 0;
-	for (ItemClass *i = myList.NAME_GetFirst(); i != NULL; i = i->NAME_GetNext())
-	{
-		switch (count)
-		{
-		case 0: assert(i == &i1); break;
-		case 1: assert(i == &i2); break;
-		case 2: assert(i == &i3); break;
-		}
-		count++;
-	}
-	assert(count == 3);
-	myList.NAME_Remove(&i2);
-	myList.NAME_Remove(&i1);
-	assert(myList.NAME_GetItemCount() == 1);
-	myList.NAME_Clear();
-	assert(myList.NAME_GetItemCount() == 0);
-	assert(i1.NAME_IsOnList() == false);
-	assert(i2.NAME_IsOnList() == false);
-	assert(i3.NAME_IsOnList() == false);
-}
-
-void TestObjList()
-{
-	WriteLine(_T("==================== OBJ LIST ===================="));
-	
-	TestObjListStatic();
-	TestObjListNormal();
-}
-
-void TestTokDoc()
-{
-	WriteLine(_T("==================== TOK DOC ===================="));
-
-	using namespace tokdoc;
-
-	const int intVal = 1;
-	const float floatVal = 1.f;
-	const VEC4 vectorVal = VEC4(1.f, 2.f, 3.f, 4.f);
-	tstring stringVal = _T("String 1");
-	const int arr[] = { 1, 2, 3, 4 };
-
-	tstring docStr;
-
-	{
-		Node doc;
-		
-		{
-			Node config;
-			SubnodeFrom(config, _T("int8"), intVal);
-			SubnodeFrom(config, _T("float1"), floatVal);
-			SubnodeFrom(config, _T("vector1"), vectorVal);
-			SubnodeFrom(config, _T("string1"), stringVal);
-			
-			{
-				Node vecNode;
-				NodeFromVector(vecNode, std::vector<int>(arr, arr+_countof(arr)));
-				vecNode.Name = _T("stdvector1");
-				config.InsertChildAtEnd(vecNode);
-			}
-
-			config.LinkChildAtBegin(new Node(_T("LonelyVal")));
-
-			Node *docConfigNode = new Node();
-			doc.LinkChildAtEnd(docConfigNode);
-			docConfigNode->CopyFrom(config);
-			docConfigNode->Name = _T("Config");
-		}
-
-		{
-			TokenWriter tok(&docStr);
-			tok.RegisterSymbol(_T('{'), true, true, 1);
-			tok.RegisterSymbol(_T('}'), true, true, -1);
-			tok.RegisterSymbol(_T('='), true, true, 0);
-			tok.RegisterSymbol(_T(','), false, true, 0);
-			tok.RegisterSymbol(_T(';'), false, true, 0);
-			doc.SaveChildren(tok);
-		}
-	}
-
-	WriteLine(docStr);
-
-	{
-		Node doc;
-
-		{
-			Tokenizer tok(&docStr, Tokenizer::FLAG_MULTILINE_STRINGS);
-			tok.Next();
-			doc.LoadChildren(tok);
-		}
-
-		Node &configNode = doc.MustFindFirstChild(_T("Config"));
-
-		int intTmp;
-		SubnodeTo(intTmp, configNode, _T("int8"), SUBNODE_REQUIRED);
-		assert(intTmp == intVal);
-
-		float floatTmp;
-		SubnodeTo(floatTmp, configNode, _T("float1"), SUBNODE_REQUIRED);
-		assert(floatTmp == floatVal);
-
-		VEC4 vectorTmp;
-		SubnodeTo(vectorTmp, configNode, _T("vector1"), SUBNODE_REQUIRED);
-		assert(vectorTmp == vectorVal);
-
-		tstring stringTmp;
-		SubnodeTo(stringTmp, configNode, _T("string1"), SUBNODE_REQUIRED);
-		assert(stringTmp == stringVal);
-
-		std::vector<int> stdVectorTmp;
-		Node &vectorNode = configNode.MustFindFirstChild(_T("stdvector1"));
-		NodeToVector(stdVectorTmp, vectorNode, true);
-		assert(stdVectorTmp == std::vector<int>(arr, arr+_countof(arr)));
-
-		assert(configNode.GetFirstChild() && configNode.GetFirstChild()->Name == EMPTY_STRING);
-	}
-}
-
-
-//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
-
-void Test()
-{
-	Initialize();
-	
-    TestBase();
-	TestError();
-	TestMath();
-	TestProfiler();
-	TestFlatProfiler();
-	TestStream();
-	TestEncoderDecoder();
-	TestSmartPointers();
-	TestFreeList();
-	TestDynamicFreeList();
-	TestZlibUtils();
-	TestFiles();
-	TestDateTime();
-	TestCmdLineParser();
-	TestTokenizer();
-	TestThreads();
-	TestLogger();
-#ifdef _WIN32
-	TestBstrString();
-#endif
-	TestObjList();
-	TestTokDoc();
-
-	tstring Result;
-	g_Profiler.FormatString(&Result, PROFILER_UNITS_MILLISECONDS);
-	tcout << _T("Result:") << endl << Result << endl;
-}
-
-#ifdef _WIN32
-int _tmain(int argc, tchar* argv[], tchar* envp[])
-#else
-int main(int argc, char* argv[])
-#endif
-{
-	setlocale(LC_ALL, "polish");
-
-	try
-	{
-		Test();
-	}
-	catch (const Error& Err)
-	{
-		tcout << _T("!!!!!!!!!!! EXCEPTION !!!!!!!!!!!") << endl;
-		tstring s;
-		Err.GetMessage_(&s);
-		WriteLine(s);
-	}
-	return 0;
-}
-
-#ifdef USE_DIRECTX
-#pragma comment(lib, "d3d9.lib")
-#pragma comment(lib, "d3dx9.lib")
-#pragma comment(lib, "dxerr.lib")
-#endif
+#include "../Common/Base.hpp"
+#include "../Common/FreeList.hpp"
+#include "../Common/Error.hpp"
+#include "../Common/Math.hpp"
+#include "../Common/Profiler.hpp"
+#include "../Common/DateTime.hpp"
+#include "../Common/Threads.hpp"
+#include "../Common/Stream.hpp"
+#include "../Common/Compression.hpp"
+#include "../Common/Files.hpp"
+#include "../Common/Tokenizer.hpp"
+#include "../Common/TokDoc.hpp"
+#include "../Common/ZlibUtils.hpp"
+#include "../Common/Logger.hpp"
+#include "../Common/ObjList.hpp"
+
+#ifdef _WIN32
+	#include "../Common/BstrString.hpp"
+#endif
+
+#include <iostream>
+#include <ios>
+#include <queue>
+#include <map>
+
+using namespace std;
+using namespace common;
+
+#ifdef _UNICODE
+	#define tcout wcout
+	#define tcin wcin
+#else
+	#define tcout cout
+	#define tcin cin
+#endif
+
+static Profiler g_Profiler;
+
+void WriteLine(const tstring &s)
+{
+	tcout << s << endl;
+}
+
+void PrintProfile()
+{
+	tstring Profile;
+	g_Profiler.FormatString(&Profile, PROFILER_UNITS_MILLISECONDS);
+	WriteLine(Profile);
+}
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+
+class SingletonClass : public Singleton<SingletonClass>
+{
+public:
+	SingletonClass()
+	{
+		tcout << _T("  Singleton Constructor") << endl;
+	}
+
+	~SingletonClass()
+	{
+		tcout << _T("  Singleton Destructor") << endl;
+	}
+
+	void Method()
+	{
+		tcout << _T("  Singleton Method") << endl;
+	}
+};
+
+void Initialize()
+{
+	GameTime::Initialize();
+}
+
+void TestBase()
+{
+	WriteLine(_T("==================== BASE ===================="));
+
+	{
+		tcout << _T("Conversion between uint32, unsigned and size_t - shouldn't be compiler warning") << endl;
+		const uint32 cu4 = 1234567890;
+		const unsigned cu = 123456789;
+		const size_t cs = 12345678;
+		uint32 u4 = cu, u4_2 = cs;
+		unsigned u = cu4, u_2 = cs;
+		size_t s = cu4, s_2 = cu;
+	}
+
+	{
+		tcout << _T("Basic numeric types:") << endl;
+		tcout << _T("  sizeof(int8) = ") << sizeof(int8) << endl;
+		tcout << _T("  sizeof(int16) = ") << sizeof(int16) << endl;
+		tcout << _T("  sizeof(int32) = ") << sizeof(int32) << endl;
+		tcout << _T("  sizeof(int64) = ") << sizeof(int64) << endl;
+		tcout << _T("  sizeof(uint8) = ") << sizeof(uint8) << endl;
+		tcout << _T("  sizeof(uint16) = ") << sizeof(uint16) << endl;
+		tcout << _T("  sizeof(uint32) = ") << sizeof(uint32) << endl;
+		tcout << _T("  sizeof(uint64) = ") << sizeof(uint64) << endl;
+	}
+
+	{
+		tcout << _T("absolute_cast") << endl;
+		const int ci = 123456789;
+		tcout << _T("  int = ") << ci << endl;
+		float f = absolute_cast<float>(ci);
+		tcout << _T("  float = ") << f << endl;
+		uint32 ui = absolute_cast<uint32>(ci);
+		tcout << _T("  uint32 = ") << ui << endl;
+	}
+
+	{
+		tcout << _T("Singleton:") << endl;
+		tcout << _T("- Using singleton for the first time") << endl;
+		SingletonClass::GetInstance().Method();
+		tcout << _T("- Using singleton for second time") << endl;
+		SingletonClass::GetInstance().Method();
+	}
+
+	{
+		tcout << _T("Safe arithemtic:") << endl;
+		tcout << _T("  SafeAdd<uint8>(120, 250) = ") << (int)safe_add<uint8>(120, 250) << endl;
+		tcout << _T("  SafeSub<uint8>(120, 250) = ") << (int)safe_sub<uint8>(120, 250) << endl;
+		tcout << _T("  SafeMul<uint8>(120, 250) = ") << (int)safe_mul<uint8>(120, 250) << endl;
+	}
+
+	{
+		tcout << _T("Random generator:") << endl;
+		tcout << _T("  uint32: ") << g_Rand.RandUint() << _T(' ') << g_Rand.RandUint() << _T(' ') << g_Rand.RandUint() << _T(' ') << g_Rand.RandUint() << endl;
+		tcout << _T("  float: ") << g_Rand.RandFloat() << _T(' ') << g_Rand.RandFloat() << _T(' ') << g_Rand.RandFloat() << _T(' ') << g_Rand.RandFloat() << endl;
+		tcout << _T("  bool: ") << g_Rand.RandBool() << _T(' ') << g_Rand.RandBool() << _T(' ') << g_Rand.RandBool() << _T(' ') << g_Rand.RandBool() << endl;
+		tcout << _T("  Byte: ") << (int)g_Rand.RandByte() << _T(' ') << (int)g_Rand.RandByte() << _T(' ') << (int)g_Rand.RandByte() << _T(' ') << (int)g_Rand.RandByte() << endl;
+		tcout << _T("  Normal(sigma=1): ") << g_Rand.RandNormal(1.0f) << _T(' ') << g_Rand.RandNormal(1.0f) << _T(' ') << g_Rand.RandNormal(1.0f) << _T(' ') << g_Rand.RandNormal(1.0f) << endl;
+
+		RandomGenerator DR1(123);
+		tcout << _T("  Deterministic #1 (seed 123): ") << DR1.RandUint() << _T(' ') << DR1.RandFloat() << _T(' ') << DR1.RandBool() << endl;
+		RandomGenerator DR2(123);
+		tcout << _T("  Deterministic #2 (seed 123): ") << DR2.RandUint() << _T(' ') << DR2.RandFloat() << _T(' ') << DR2.RandBool() << endl;
+	}
+
+	{
+		tcout << _T("Conversions:") << endl;
+
+		tchar ch = _T('A');
+		int i = 123;
+		uint32 u = 323456789;
+		float f = 3.14f;
+		double d = 10.5;
+		bool b = true;
+		tstring s = _T("Foo");
+		int ai[] = { 1, 2, 3 };
+		std::vector<int> vi(&ai[0], &ai[3]);
+		tstring as[] = { _T("a"), _T("bb"), _T("ccc"), _T("dddd") };
+		std::vector<tstring> vs(&as[0], &as[4]);
+
+		tstring TMP;
+		SthToStr(&TMP, ch); tcout << _T("  tchar to tstring: ") << TMP << endl;
+		StrToSth(&ch, TMP); tcout << _T("  tstring to tchar: ") << ch << endl;
+		SthToStr(&TMP, i ); tcout << _T("  int to tstring: ") << TMP << endl;
+		StrToSth(&i, TMP);  tcout << _T("  tstring to int: ") << i << endl;
+		SthToStr(&TMP, u ); tcout << _T("  uint32 to tstring: ") << TMP << endl;
+		StrToSth(&u, TMP);  tcout << _T("  tstring to uint32: ") << u << endl;
+		SthToStr(&TMP, f ); tcout << _T("  float to tstring: ") << TMP << endl;
+		StrToSth(&f, TMP);  tcout << _T("  tstring to float: ") << f << endl;
+		SthToStr(&TMP, d ); tcout << _T("  double to tstring: ") << TMP << endl;
+		StrToSth(&d, TMP);  tcout << _T("  tstring to double: ") << d << endl;
+		SthToStr(&TMP, b ); tcout << _T("  bool to tstring: ") << TMP << endl;
+		StrToSth(&b, TMP);  tcout << _T("  tstring to bool: ") << b << endl;
+		SthToStr(&TMP, s ); tcout << _T("  tstring to tstring: ") << TMP << endl;
+		StrToSth(&s, TMP);  tcout << _T("  tstring to tstring: ") << s << endl;
+		SthToStr(&TMP, vi); tcout << _T("  vector<int> to tstring: ") << TMP << endl;
+		StrToSth(&vi, TMP); tcout << _T("  tstring to vector<int>:"); for (size_t si1 = 0; si1 < vi.size(); si1++) tcout << _T(' ') << vi[si1]; tcout << endl;
+		SthToStr(&TMP, vs); tcout << _T("  vector<tstring> to tstring: ") << TMP << endl;
+		StrToSth(&vs, TMP); tcout << _T("  tstring to vector<tstring>:"); for (size_t si2 = 0; si2 < vs.size(); si2++) tcout << _T(' ') << vs[si2]; tcout << endl;
+
+		tcout << _T("- Format: ") << (Format(_T("#, #, #, #, #, #, #, #, #")) % ch % i % u % f % d % b % s % vi % vs).str() << endl;
+	}
+
+	// Parsowanie liczb - poprawne zaokrąglenie, zakresy, fragment łańcucha
+	{
+		double d;
+		assert(StrToDouble(&d, _T("0.1")) == 0 && d == 0.1);
+		assert(StrToDouble(&d, _T("1.7976931348623157e308")) == 0 && d == 1.7976931348623157e308);
+		assert(StrToDouble(&d, _T("4.9406564584124654e-324")) == 0 && d == 4.9406564584124654e-324);
+		// Dokładnie w połowie między 2^53 a 2^53+2 - remis do parzystej, a dalsza cyfra rozstrzyga
+		assert(StrToDouble(&d, _T("9007199254740993")) == 0 && d == 9007199254740992.0);
+		assert(StrToDouble(&d, _T("9007199254740993.000000000000000000001")) == 0 && d == 9007199254740994.0);
+		assert(StrToDouble(&d, _T("1.5e")) != 0);
+		float f;
+		assert(StrToFloat(&f, _T("3.4028235e38")) == 0 && f == 3.4028235e38f);
+
+		const tchar *Span = _T("12345xyz");
+		int32 i;
+		assert(StrToInt(&i, Span, 5, 10) == 0 && i == 12345);
+		assert(StrToInt(&i, Span, 6, 10) == -1);
+		assert(StrToInt(&i, _T("-2147483648"), 11, 10) == 0 && i == std::numeric_limits<int32>::min());
+		assert(StrToInt(&i, _T("2147483648"), 10, 10) == -2);
+		uint64 u;
+		assert(StrToUint(&u, _T("18446744073709551615"), 20, 10) == 0 && u == 0xFFFFFFFFFFFFFFFFull);
+		assert(StrToUint(&u, _T("ff"), 2, 16) == 0 && u == 255);
+	}
+
+	// Formatowanie liczb - najkrótsza postać odwracalna i tryby zgodne z printf
+	{
+		tchar Buf[DOUBLE_TO_STR_BUFFER_SIZE];
+		DoubleToStr(Buf, 0.1, 'r');
+		assert(tstring(Buf) == _T("0.1"));
+		FloatToStr(Buf, 0.1f, 'r');
+		assert(tstring(Buf) == _T("0.1"));
+		DoubleToStr(Buf, 1e23, 'r');
+		assert(tstring(Buf) == _T("1e+23"));
+		DoubleToStr(Buf, 0.1, 'e', 6);
+		assert(tstring(Buf) == _T("1.000000e-01"));
+		DoubleToStr(Buf, 0.125, 'f', 2);
+		assert(tstring(Buf) == _T("0.12"));
+		DoubleToStr(Buf, 9.999999999999999e22, 'e', 15);
+		assert(tstring(Buf) == _T("9.999999999999999e+22"));
+		DoubleToStr(Buf, 1234567.0, 'g', 6);
+		assert(tstring(Buf) == _T("1.23457e+06"));
+
+		double d = 0.0;
+		DoubleToStr(Buf, 2.0 / 3.0, 'r');
+		assert(StrToDouble(&d, Buf) == 0 && d == 2.0 / 3.0);
+	}
+
+	// Liczby całkowite do bufora
+	{
+		tchar Buf[INT_TO_STR_BUFFER_SIZE];
+		assert(UintToStr(Buf, 0u) == 1 && tstring(Buf) == _T("0"));
+		assert(UintToStr(Buf, 18446744073709551615ull) == 20 && tstring(Buf) == _T("18446744073709551615"));
+		assert(IntToStr(Buf, std::numeric_limits<int32>::min()) == 11 && tstring(Buf) == _T("-2147483648"));
+		IntToStr(Buf, -255, 16);
+		assert(tstring(Buf) == _T("-FF"));
+		IntToStr2(Buf, -7, 4);
+		assert(tstring(Buf) == _T("-007"));
+		assert((Format(_T("#,#")) % -12 % 3000000000u).str() == _T("-12,3000000000"));
+	}
+
+	// Sort2, Sort3
+	{
+		int arr[3] = { 2, 3, 1 };
+		Sort3(arr[0], arr[1], arr[2]);
+		assert(arr[0] == 1);
+		assert(arr[1] == 2);
+		assert(arr[2] == 3);
+	}
+
+	{
+		tchar s[128];
+		common_sprintf(s, _countof(s), _T("common_sprintf: 1=%i, 2.5=%g"), 1, 2.5);
+		tcout << s << endl;
+	}
+    
+    // CountBitsSet
+    {
+        uint result;
+
+        uint8_t u8;
+        u8 = 0x00; result = CountBitsSet(u8); assert(result == 0);
+        u8 = 0x01; result = CountBitsSet(u8); assert(result == 1);
+        u8 = 0x02; result = CountBitsSet(u8); assert(result == 1);
+        u8 = 0x04; result = CountBitsSet(u8); assert(result == 1);
+        u8 = 0x08; result = CountBitsSet(u8); assert(result == 1);
+        u8 = 0x10; result = CountBitsSet(u8); assert(result == 1);
+        u8 = 0x20; result = CountBitsSet(u8); assert(result == 1);
+        u8 = 0x40; result = CountBitsSet(u8); assert(result == 1);
+        u8 = 0x80; result = CountBitsSet(u8); assert(result == 1);
+        u8 = 0x03; result = CountBitsSet(u8); assert(result == 2);
+        u8 = 0x81; result = CountBitsSet(u8); assert(result == 2);
+        u8 = 0xFF; result = CountBitsSet(u8); assert(result == 8);
+
+        uint16_t u16;
+        u16 = 0x0000; result = CountBitsSet(u16); assert(result == 0);
+        u16 = 0x0001; result = CountBitsSet(u16); assert(result == 1);
+        u16 = 0x0002; result = CountBitsSet(u16); assert(result == 1);
+        u16 = 0x0004; result = CountBitsSet(u16); assert(result == 1);
+        u16 = 0x0008; result = CountBitsSet(u16); assert(result == 1);
+        u16 = 0x0010; result = CountBitsSet(u16); assert(result == 1);
+        u16 = 0x0020; result = CountBitsSet(u16); assert(result == 1);
+        u16 = 0x0040; result = CountBitsSet(u16); assert(result == 1);
+        u16 = 0x0080; result = CountBitsSet(u16); assert(result == 1);
+        u16 = 0x0200; result = CountBitsSet(u16); assert(result == 1);
+        u16 = 0x4000; result = CountBitsSet(u16); assert(result == 1);
+        u16 = 0x8000; result = CountBitsSet(u16); assert(result == 1);
+        u16 = 0x0003; result = CountBitsSet(u16); assert(result == 2);
+        u16 = 0x0081; result = CountBitsSet(u16); assert(result == 2);
+        u16 = 0x0110; result = CountBitsSet(u16); assert(result == 2);
+        u16 = 0xF021; result = CountBitsSet(u16); assert(result == 6);
+        u16 = 0xFF00; result = CountBitsSet(u16); assert(result == 8);
+        u16 = 0xFFFF; result = CountBitsSet(u16); assert(result == 16);
+
+        uint32_t u32;
+        u32 = 0x00000000; result = CountBitsSet(u32); assert(result == 0);
+        u32 = 0x00000001; result = CountBitsSet(u32); assert(result == 1);
+        u32 = 0x00000002; result = CountBitsSet(u32); assert(result == 1);
+        u32 = 0x00000004; result = CountBitsSet(u32); assert(result == 1);
+        u32 = 0x00000008; result = CountBitsSet(u32); assert(result == 1);
+        u32 = 0x00000010; result = CountBitsSet(u32); assert(result == 1);
+        u32 = 0x00000020; result = CountBitsSet(u32); assert(result == 1);
+        u32 = 0x00000040; result = CountBitsSet(u32); assert(result == 1);
+        u32 = 0x00000080; result = CountBitsSet(u32); assert(result == 1);
+        u32 = 0x00000200; result = CountBitsSet(u32); assert(result == 1);
+        u32 = 0x00004000; result = CountBitsSet(u32); assert(result == 1);
+        u32 = 0x00008000; result = CountBitsSet(u32); assert(result == 1);
+        u32 = 0x00400000; result = CountBitsSet(u32); assert(result == 1);
+        u32 = 0x00000003; result = CountBitsSet(u32); assert(result == 2);
+        u32 = 0x00000081; result = CountBitsSet(u32); assert(result == 2);
+        u32 = 0x00000110; result = CountBitsSet(u32); assert(result == 2);
+        u32 = 0x0000F021; result = CountBitsSet(u32); assert(result == 6);
+        u32 = 0x0000FF00; result = CountBitsSet(u32); assert(result == 8);
+        u32 = 0x0000FFFF; result = CountBitsSet(u32); assert(result == 16);
+        u32 = 0x12481248; result = CountBitsSet(u32); assert(result == 8);
+        u32 = 0x80014002; result = CountBitsSet(u32); assert(result == 4);
+        u32 = 0xFFFFFFFF; result = CountBitsSet(u32); assert(result == 32);
+
+        uint64_t u64;
+        u64 = 0x0000000000000000; result = CountBitsSet(u64); assert(result == 0);
+        u64 = 0x0000000000000001; result = CountBitsSet(u64); assert(result == 1);
+        u64 = 0x0000000000000002; result = CountBitsSet(u64); assert(result == 1);
+        u64 = 0x0000000000000004; result = CountBitsSet(u64); assert(result == 1);
+        u64 = 0x0000000000000008; result = CountBitsSet(u64); assert(result == 1);
+        u64 = 0x0000000000000010; result = CountBitsSet(u64); assert(result == 1);
+        u64 = 0x0000000000000020; result = CountBitsSet(u64); assert(result == 1);
+        u64 = 0x0000000000000040; result = CountBitsSet(u64); assert(result == 1);
+        u64 = 0x0000000000000080; result = CountBitsSet(u64); assert(result == 1);
+        u64 = 0x0000000000000200; result = CountBitsSet(u64); assert(result == 1);
+        u64 = 0x0000000000004000; result = CountBitsSet(u64); assert(result == 1);
+        u64 = 0x0000000000008000; result = CountBitsSet(u64); assert(result == 1);
+        u64 = 0x0000000000400000; result = CountBitsSet(u64); assert(result == 1);
+        u64 = 0x0000000400000000; result = CountBitsSet(u64); assert(result == 1);
+        u64 = 0x0000800000000000; result = CountBitsSet(u64); assert(result == 1);
+        u64 = 0x8000000000000000; result = CountBitsSet(u64); assert(result == 1);
+        u64 = 0x0000000000000003; result = CountBitsSet(u64); assert(result == 2);
+        u64 = 0x0000000000000081; result = CountBitsSet(u64); assert(result == 2);
+        u64 = 0x0000000000000110; result = CountBitsSet(u64); assert(result == 2);
+        u64 = 0x0005000000000000; result = CountBitsSet(u64); assert(result == 2);
+        u64 = 0x0500000000000000; result = CountBitsSet(u64); assert(result == 2);
+        u64 = 0x000000000000F021; result = CountBitsSet(u64); assert(result == 6);
+        u64 = 0x000000000000FF00; result = CountBitsSet(u64); assert(result == 8);
+        u64 = 0x000000000000FFFF; result = CountBitsSet(u64); assert(result == 16);
+        u64 = 0x0000000012481248; result = CountBitsSet(u64); assert(result == 8);
+        u64 = 0x0000000080014002; result = CountBitsSet(u64); assert(result == 4);
+        u64 = 0x00000000FFFFFFFF; result = CountBitsSet(u64); assert(result == 32);
+        u64 = 0xFFFFFFFFFFFFFFFF; result = CountBitsSet(u64); assert(result == 64);
+    }
+
+    // PtrToStr
+    {
+        int* ptr = nullptr;
+        wstring str1, str2;
+        PtrToStr(&str1, ptr);
+        ptr += 8;
+        PtrToStr(&str2, ptr);
+
+#ifdef _WIN64
+        assert(str1 == L"0000000000000000");
+        assert(str2 == L"0000000000000020");
+#else
+        assert(str1 == L"00000000");
+        assert(str2 == L"00000020");
+#endif
+    }
+
+    // ValidateWildcard
+    {
+        assert(ValidateWildcard(L"", L"") == true);
+        assert(ValidateWildcard(L"", L"aaa") == false);
+        
+        assert(ValidateWildcard(L"*", L"") == true);
+        assert(ValidateWildcard(L"*", L"a") == true);
+        assert(ValidateWildcard(L"*", L"aaa") == true);
+        
+        assert(ValidateWildcard(L"?", L"") == false);
+        assert(ValidateWildcard(L"?", L"a") == true);
+        assert(ValidateWildcard(L"?", L"aaa") == false);
+        
+        assert(ValidateWildcard(L"?a", L"") == false);
+        assert(ValidateWildcard(L"?a", L"xa") == true);
+        assert(ValidateWildcard(L"?a", L"xaa") == false);
+        assert(ValidateWildcard(L"?a", L"axa") == false);
+        
+        assert(ValidateWildcard(L"a?", L"") == false);
+        assert(ValidateWildcard(L"a?", L"ax") == true);
+        assert(ValidateWildcard(L"a?", L"axa") == false);
+        assert(ValidateWildcard(L"a?", L"axa") == false);
+
+        assert(ValidateWildcard(L"a?bb", L"") == false);
+        assert(ValidateWildcard(L"a?bb", L"aXbb") == true);
+        assert(ValidateWildcard(L"a?bb", L"abb") == false);
+        assert(ValidateWildcard(L"a?bb", L"bXbb") == false);
+        assert(ValidateWildcard(L"a?bb", L"aXaa") == false);
+        assert(ValidateWildcard(L"a?bb", L"aXbba") == false);
+        assert(ValidateWildcard(L"a?bb", L"aaXbb") == false);
+
+        assert(ValidateWildcard(L"aa*", L"") == false);
+        assert(ValidateWildcard(L"aa*", L"aa") == true);
+        assert(ValidateWildcard(L"aa*", L"ab") == false);
+        assert(ValidateWildcard(L"aa*", L"aaXXX") == true);
+        assert(ValidateWildcard(L"aa*", L"abXXX") == false);
+        
+        assert(ValidateWildcard(L"*ab", L"") == false);
+        assert(ValidateWildcard(L"*ab", L"ab") == true);
+        assert(ValidateWildcard(L"*ab", L"aC") == false);
+        assert(ValidateWildcard(L"*ab", L"XXXab") == true);
+        assert(ValidateWildcard(L"*ab", L"XXXaC") == false);
+        assert(ValidateWildcard(L"*ab", L"XXXaCC") == false);
+        assert(ValidateWildcard(L"*ab", L"XXXabCC") == false);
+
+        assert(ValidateWildcard(L"xy*abc", L"") == false);
+        assert(ValidateWildcard(L"xy*abc", L"xyabc") == true);
+        assert(ValidateWildcard(L"xy*abc", L"xy") == false);
+        assert(ValidateWildcard(L"xy*abc", L"abc") == false);
+        assert(ValidateWildcard(L"xy*abc", L"xabc") == false);
+        assert(ValidateWildcard(L"xy*abc", L"xyXXXabc") == true);
+        assert(ValidateWildcard(L"xy*abc", L"xZabc") == false);
+        assert(ValidateWildcard(L"xy*abc", L"xyXXXaDc") == false);
+
+        assert(ValidateWildcard(L"???", L"") == false);
+        assert(ValidateWildcard(L"???", L"ab") == false);
+        assert(ValidateWildcard(L"???", L"abc") == true);
+        assert(ValidateWildcard(L"???", L"abcdef") == false);
+
+        assert(ValidateWildcard(L"??*?", L"") == false);
+        assert(ValidateWildcard(L"?*??", L"ab") == false);
+        assert(ValidateWildcard(L"*???", L"abc") == true);
+        assert(ValidateWildcard(L"???*", L"abcd") == true);
+        
+        assert(ValidateWildcard(L"a?b?c*d", L"") == false);
+        assert(ValidateWildcard(L"a?b?c*d", L"abc") == false);
+        assert(ValidateWildcard(L"a?b?c*d", L"ad") == false);
+        assert(ValidateWildcard(L"a?b?c*d", L"abcd") == false);
+        assert(ValidateWildcard(L"a?b?c*d", L"aXbYcd") == true);
+        assert(ValidateWildcard(L"a?b?c*d", L"aXbYcZZZd") == true);
+        assert(ValidateWildcard(L"a?b?c*d", L"BXbYcZZZd") == false);
+        assert(ValidateWildcard(L"a?b?c*d", L"aXbY") == false);
+    }
+}
+
+void TestError()
+{
+	WriteLine(_T("==================== ERROR ===================="));
+
+	try
+	{
+		{
+			ERR_TRY;
+			{
+				ERR_TRY;
+
+				throw Error(_T("Some error."), __TFILE__, __LINE__);
+
+				ERR_CATCH(_T("Message in catch."));
+			}
+			ERR_CATCH_FUNC;
+		}
+	}
+	catch (Error &Err)
+	{
+		tstring s;
+		Err.GetMessage_(&s);
+		tcout << _T("Error Message:") << endl;
+		tcout << s << endl;
+	}
+}
+
+void TestMath()
+{
+	WriteLine(_T("==================== MATH ===================="));
+
+	{
+		tcout << _T("Testing POINT_") << endl;
+		const tstring s1 = _T("123,456");
+		POINT_ P1; tcout << StrToSth(&P1, s1) << endl;
+		POINT_ P2 = (P1 + P1) * 7;
+		tcout << (Format(_T("Result: #")) % P2).str() << endl;
+	}
+
+	{
+		tcout << _T("Testing VEC2") << endl;
+		const tstring s1 = _T("123,456");
+		VEC2 V1; tcout << StrToSth(&V1, s1) << endl;
+		VEC2 V2 = (V1 + V1) * 7.0f;
+		tcout << (Format(_T("Result: #")) % V2).str() << endl;
+	}
+
+	{
+		tcout << _T("Testing VEC3") << endl;
+		const tstring s1 = _T("123,456,789");
+		VEC3 V1; tcout << StrToSth(&V1, s1) << endl;
+		VEC3 V2 = (V1 + V1) * 7.0f;
+		tcout << (Format(_T("Result: #")) % V2).str() << endl;
+	}
+
+	{
+		tcout << _T("Testing VEC4") << endl;
+		const tstring s1 = _T("123,456,789,012");
+		VEC4 V1; tcout << StrToSth(&V1, s1) << endl;
+		VEC4 V2 = (V1 + V1) * 7.0f;
+		tcout << (Format(_T("Result: #")) % V2).str() << endl;
+	}
+
+	{
+		tcout << _T("Testing RECTI") << endl;
+		const tstring s1 = _T("123,456,789,012");
+		RECTI V1; tcout << StrToSth(&V1, s1) << endl;
+		RECTI V2 = (V1 + POINT_(1, 2)) * 7;
+		tcout << (Format(_T("Result: #")) % V2).str() << endl;
+	}
+
+	{
+		tcout << _T("Testing RECTF") << endl;
+		const tstring s1 = _T("123,456,789,012");
+		RECTF V1; tcout << StrToSth(&V1, s1) << endl;
+		RECTF V2 = (V1 + VEC2(1.0f, 2.0f)) * 7.0f;
+		tcout << (Format(_T("Result: #")) % V2).str() << endl;
+	}
+
+	{
+		tcout << _T("Testing BOX") << endl;
+		const tstring s1 = _T("1,2,3;4,5,6");
+		BOX V1; tcout << StrToSth(&V1, s1) << endl;
+		BOX V2 = (V1 + VEC3(1.0f, 2.0f, 3.0f)) * 7.0f;
+		tcout << (Format(_T("Result: #")) % V2).str() << endl;
+	}
+
+	{
+		tcout << _T("Testing COLOR") << endl;
+		const tstring s1 = _T("red");
+		const tstring s2 = _T("008080FF");
+		COLOR c1; tcout << StrToSth(&c1, s1) << endl;
+		COLOR c2; tcout << StrToSth(&c2, s2) << endl;
+		tcout << (Format(_T("Color1 = #, Color2 = #")) % c1 % c2).str() << endl;
+		tcout << (Format(_T("Color1+Color2 = #, Color1-Color2 = #, Color1*Color2 = #")) % (c1+c2) % (c1-c2) % (c1*c2)).str() << endl;
+	}
+
+	{
+		tcout << _T("Testing COLORF") << endl;
+		const tstring s1 = _T("red");
+		const tstring s2 = _T("008080FF");
+		COLORF c1; tcout << StrToSth(&c1, s1) << endl;
+		COLORF c2; tcout << StrToSth(&c2, s2) << endl;
+		tcout << (Format(_T("Color1 = #, Color2 = #")) % c1 % c2).str() << endl;
+		tcout << (Format(_T("Color1+Color2 = #, Color1-Color2 = #, Color1*Color2 = #")) % (c1+c2) % (c1-c2) % (c1*c2)).str() << endl;
+	}
+
+	{
+		tcout << _T("Testing MATRIX, PLANE, VEC*") << endl;
+
+		MATRIX m1; PerspectiveFovLH(&m1, PI_2, 4.0f/3.0f, 1.0f, 100.0f);
+		MATRIX m2; RotationYawPitchRoll(&m2, 1.0f, 2.0f, 3.0f);
+
+		PLANE plane;
+		GetPlaneNormal(plane) =VEC3_POSITIVE_Y;
+		plane.d = 1.0f;
+		tcout << (Format(_T("Plane = #")) % plane).str() << endl;
+		VEC3 vector(1.0f, 2.0f, 3.0f);
+		tcout << (Format(_T("Vector = #")) % vector).str() << endl;
+
+		PLANE plane2;
+		Transform(&plane2, plane, m1);
+		tcout << (Format(_T("Transformed plane 1 = #")) % plane2).str() << endl;
+		Transform(&plane2, plane, m2);
+		tcout << (Format(_T("Transformed plane 2 = #")) % plane2).str() << endl;
+
+		VEC3 vector2;
+		TransformCoord(&vector2, vector, m1);
+		tcout << (Format(_T("Transformed vector 1 = #")) % vector2).str() << endl;
+		TransformCoord(&vector2, vector, m2);
+		tcout << (Format(_T("Transformed vector 2 = #")) % vector2).str() << endl;
+	}
+
+	// Swizzle
+	{
+		VEC3 v1 = VEC3(1.f, 2.f, 3.f);
+		VEC2 v2 = VEC2_SWIZZLE(v1, x, x);
+		assert(around(v2.x, v1.x, 1e-6f) && around(v2.y, v1.x, 1e-6f));
+		VEC4 v3 = VEC4_SWIZZLE(v1, z, y, x, z);
+		assert(around(v3.x, v1.z, 1e-6f) && around(v3.y, v1.y, 1e-6f) && around(v3.z, v1.x, 1e-6f) && around(v3.w, v1.z, 1e-6f));
+
+		MATRIX m;
+		Identity(&m);
+		VEC4 mDiagonal = VEC4_SWIZZLE(m,_11,_22,_33,_44);
+		BOX box = BOX_ZERO;
+		VEC2 boxRangeX = VEC2_SWIZZLE(box,Min.x,Max.x);
+	}
+
+    // TriangleToTriangle
+    {
+        // TODO Fix!
+        /*
+        // Both degenerated.
+        assert(TriangleToTriangle(
+            VEC3(0.0f, 0.0f, 0.0f), VEC3(0.0f, 0.0f, 0.0f), VEC3(0.0f, 0.0f, 0.0f),
+            VEC3(1.0f, 1.0f, 1.0f), VEC3(1.0f, 1.0f, 1.0f), VEC3(1.0f, 1.0f, 1.0f)) == false);
+
+        // Really colliding triangles.
+        assert(TriangleToTriangle(
+            VEC3(3.0f, -1.0f, -0.1f), VEC3(0.0f, 3.0f, -0.3f), VEC3(-2.0f, -2.0f, -0.2f),
+            VEC3(-2.0f, 1.0f, -0.1f), VEC3(3.0f, 3.0f, -0.3f), VEC3(1.0f, -3.0f, 0.3f)) == true);
+        */
+    }
+}
+
+void TestProfiler()
+{
+	WriteLine(_T("==================== PROFILER ===================="));
+	{
+		PROFILE_GUARD(g_Profiler, _T("Everything"));
+
+		tcout << _T("Waiting 100 ms...") << endl;
+		{
+			PROFILE_GUARD(g_Profiler, _T("Waiting 100 ms"));
+			Wait(100);
+		}
+
+		tcout << _T("Making many computations...") << endl;
+		int i, j;
+		for (i = 0; i < 100; i++)
+		{
+			PROFILE_GUARD(g_Profiler, _T("Computations"));
+			int Array[1000];
+			for (j = 0; j < 1000; j++)
+			{
+				Array[j] = i*j / (i+j+1);
+			}
+		}
+	}
+
+	tstring Result;
+	g_Profiler.FormatString(&Result, PROFILER_UNITS_MILLISECONDS);
+	tcout << _T("Result:") << endl << Result << endl;
+}
+
+void TestFlatProfiler()
+{
+	FlatProfiler<tstring> flatProfiler;
+
+	{
+		FlatProfilerSampler<tstring> sampler(flatProfiler, _T("Main"));
+		for (uint i = 0; i < 10; i++)
+		{
+			{
+				FlatProfilerSampler<tstring> sampler(flatProfiler, _T("Wait10"));
+				Wait(10);
+			}
+			{
+				FlatProfilerSampler<tstring> sampler(flatProfiler, _T("Wait2"));
+				Wait(2);
+			}
+		}
+	}
+
+	tstring profile;
+	flatProfiler.FormatString(&profile, PROFILER_UNITS_MILLISECONDS);
+	WriteLine(_T("FlatProfiler result:"));
+	WriteLine(profile);
+}
+
+void TestStream()
+{
+	WriteLine(_T("==================== Stream ===================="));
+	
+	{
+		PROFILE_GUARD(g_Profiler, _T("Reading files from streams by byte"))
+
+		{
+			PROFILE_GUARD(g_Profiler, _T("FileStream"))
+
+				FileStream fs(_T("SomeFile1"), FM_READ);
+			char byte;
+			while (!fs.End())
+				fs.Read(&byte, 1);
+		}
+
+		{
+			PROFILE_GUARD(g_Profiler, _T("FileStream + BufferingStream"))
+
+				FileStream fs(_T("SomeFile2"), FM_READ);
+			BufferingStream bs(&fs, 65536, 0);
+			char byte;
+			while (!bs.End())
+				bs.Read(&byte, 1);
+		}
+	}
+}
+
+void TestEncoderDecoder()
+{
+	WriteLine(_T("==================== Kodowanie Base64 ===================="));
+
+	const uint COUNT = 100;
+	const uint MAX_SIZE = 65536;
+	char *SrcData = new char[MAX_SIZE];
+	char *DstData = new char[MAX_SIZE];
+	char *EncodedData = new char[MAX_SIZE*2];
+
+	for (uint i = 0; i < COUNT; i++)
+	{
+		uint Size = g_Rand.RandUint(1, MAX_SIZE+1);
+		uint EncodedSize;
+		g_Rand.RandData(SrcData, Size);
+		
+		{
+			MemoryStream SrcM(Size, SrcData);
+			MemoryStream EncodedM(Size*2, EncodedData);
+			{
+				Base64Encoder Hex(&EncodedM);
+				CopyToEnd(&Hex, &SrcM);
+			}
+			EncodedSize = (uint)EncodedM.GetPos();
+		}
+		{
+			MemoryStream EncodedM(EncodedSize, EncodedData);
+			MemoryStream DstM(Size, DstData);
+			try
+			{
+				Base64Decoder Hex(&EncodedM);
+				CopyToEnd(&DstM, &Hex);
+			}
+			catch (...)
+			{
+				string Src; Src.assign(SrcData, Size);
+				string Encoded; Encoded.assign(EncodedData, Size);
+				tcout << (Format(_T("Wyjatek dekodowania. SrcData=#, EncodedData=#")) % StringToTstringR(Src) % StringToTstringR(Encoded)).str() << endl;
+				throw;
+			}
+		}
+
+		if (memcmp(SrcData, DstData, Size) != 0)
+			tcout << _T("FAILED!") << endl;
+	}
+
+	delete [] EncodedData;
+	delete [] DstData;
+	delete [] SrcData;
+}
+
+class SmartPtrTestClass
+{
+private:
+	int m_i;
+
+public:
+	SmartPtrTestClass() : m_i(0) { tcout << _T("- ctor default ") << m_i << endl; }
+	SmartPtrTestClass(int i) : m_i(i) { tcout << _T("- ctor ") << m_i << endl; }
+	~SmartPtrTestClass() { tcout << _T("- dtor ") << m_i << endl; }
+	void F() { tcout << _T("- F ") << m_i << endl; }
+	void Release() { tcout << _T("- Release ") << m_i << endl; }
+};
+
+typedef int MY_HANDLE;
+
+void CreateHandle(MY_HANDLE *Out, int x)
+{
+	tcout << _T("- CreateHandle: ") << x << endl;
+	*Out = x;
+}
+
+void DestroyHandle(MY_HANDLE h)
+{
+	tcout << _T("- DestroyHandle: ") << h << endl;
+}
+
+class DestroyHandlePolicy { public: template <typename T> static void Destroy(T p) { if (p != 0) DestroyHandle(p); } };
+
+void TestSmartPointers()
+{
+	WriteLine(_T("==================== Inteligente wskaźniki ===================="));
+
+	tcout << _T("- scoped_ptr 1\n");
+	{
+		scoped_ptr<SmartPtrTestClass> p1;
+		p1.reset(new SmartPtrTestClass(1));
+		p1->F();
+		p1.reset();
+		assert( p1 == p1.get() );
+		assert( p1.get() == p1 );
+		assert( p1 == NULL );
+		assert( NULL == p1 );
+	}
+	tcout << _T("- scoped_ptr 2\n");
+	{
+		scoped_ptr<SmartPtrTestClass> p2(new SmartPtrTestClass(1));
+		p2.reset(new SmartPtrTestClass(2));
+		(*p2).F();
+	}
+
+	tcout << _T("common::shared_ptr 1\n");
+	{
+		common::shared_ptr<SmartPtrTestClass> p1;
+		p1.reset(new SmartPtrTestClass(1));
+		p1->F();
+		p1.reset();
+		assert( p1 == p1.get() );
+		assert( p1.get() == p1 );
+		assert( p1 == NULL );
+		assert( NULL == p1 );
+	}
+	tcout << _T("common::shared_ptr 2\n");
+	{
+		common::shared_ptr<SmartPtrTestClass> p2(new SmartPtrTestClass(1));
+		p2.reset(new SmartPtrTestClass(2));
+		(*p2).F();
+	}
+	tcout << _T("common::shared_ptr 3\n");
+	{
+		common::shared_ptr<SmartPtrTestClass> p1;
+		common::shared_ptr<SmartPtrTestClass> p2(new SmartPtrTestClass(1));
+		p1 = p2;
+		assert( p1 == p2 );
+		p2.reset();
+		p1.get()->F();
+		common::shared_ptr<SmartPtrTestClass> p3;
+		p3 = p1;
+		(*p3).F();
+		p3.reset(common::shared_ptr<SmartPtrTestClass>(new SmartPtrTestClass(101)));
+		p3.reset(new SmartPtrTestClass(102));
+		p3.reset(NULL);
+		swap(p3, p1);
+		p3->F();
+		assert( p3.unique() );
+	}
+	tcout << _T("common::shared_ptr(Release)\n");
+	{
+		common::shared_ptr<SmartPtrTestClass, ReleasePolicy> p1(new SmartPtrTestClass(66));
+		common::shared_ptr<SmartPtrTestClass, ReleasePolicy> p2(p1);
+		p2->F();
+	}
+	tcout << _T("scoped_ptr(array)\n");
+	{
+		scoped_ptr<SmartPtrTestClass, DeleteArrayPolicy> p1(new SmartPtrTestClass[3]);
+		p1.get()[0].F();
+	}
+	tcout << _T("scoped_handle\n");
+	{
+		typedef scoped_handle<MY_HANDLE, DestroyHandlePolicy> my_scoped_handle;
+		MY_HANDLE hv;
+		CreateHandle(&hv, 1);
+		my_scoped_handle h1(hv);
+		CreateHandle(&hv, 2);
+		h1.reset(hv);
+	}
+	tcout << _T("shared_handle\n");
+	{
+		typedef shared_handle<MY_HANDLE, DestroyHandlePolicy> my_shared_handle;
+		MY_HANDLE hv;
+		my_shared_handle p1(0);
+		CreateHandle(&hv, 1);
+		my_shared_handle p2(hv);
+		p1 = p2;
+		assert( p1 == p2 );
+		p2.reset(0);
+		assert( p1 != p2 );
+		my_shared_handle p3(0);
+		p3 = p1;
+		CreateHandle(&hv, 101);
+		p3.reset(my_shared_handle(hv));
+		CreateHandle(&hv, 102);
+		p3.reset(hv);
+		p3.reset(0);
+		swap(p3, p1);
+		assert( p3.unique() );
+	}
+	tcout << _T("scoped_ptr (array)\n");
+	{
+		scoped_ptr<SmartPtrTestClass, DeleteArrayPolicy> p1;
+		p1.reset(new SmartPtrTestClass[3]);
+		p1[0].F();
+		p1[1].F();
+		p1[2].F();
+		p1.reset();
+	}
+}
+
+
+void TestFreeList()
+{
+	WriteLine(_T("==================== FreeList ===================="));
+
+	const uint COUNT = 10;
+
+	FreeList<ptrdiff_t> lista(COUNT);
+	scoped_ptr<ptrdiff_t*, DeleteArrayPolicy> tablica(new ptrdiff_t*[COUNT]);
+
+	for (uint i = 0; i < COUNT; i++)
+		tablica.get()[i] = lista.New_ctor();
+
+	tcout << _T("Przed wypelnieniem:\n");
+	for (uint i = 0; i < COUNT; i++)
+		tcout << *tablica.get()[i] << _T(' ');
+	tcout << endl;
+
+	for (uint i = 0; i < COUNT; i++)
+		*tablica.get()[i] = i;
+
+	tcout << _T("Po wypelnieniu:\n");
+	for (uint i = 0; i < COUNT; i++)
+		tcout << *tablica.get()[i] << _T(' ');
+	tcout << endl;
+
+	for (uint i = 0; i < COUNT; i++)
+		lista.Delete(tablica.get()[i]);
+}
+
+void TestDynamicFreeList()
+{
+	WriteLine(_T("==================== DynamicFreeList ===================="));
+
+	const uint BLOCK_COUNT = 3;
+	const uint COUNT = 10;
+
+	DynamicFreeList<ptrdiff_t> lista(BLOCK_COUNT);
+	scoped_ptr<ptrdiff_t*, DeleteArrayPolicy> tablica(new ptrdiff_t*[COUNT]);
+
+	tcout << (Format(_T("Stats: Empty=#, Full=#, BlockCount=#, BlockCapacity=#, UsedCount=#, FreeCount=#, Capacity=#, BlockSize=#, ...\n")) %
+		lista.IsEmpty() % lista.IsFull() % lista.GetBlockCount() % lista.GetBlockCapacity() % lista.GetUsedCount() % lista.GetFreeCount() % lista.GetCapacity() % lista.GetBlockSize()).str();
+
+	tcout << _T("Alokacja...\n");
+
+	for (uint i = 0; i < COUNT; i++)
+		tablica.get()[i] = lista.New();
+
+	tcout << _T("Elementy:\n");
+	for (uint i = 0; i < COUNT; i++)
+		tcout << *tablica.get()[i] << _T(' ');
+	tcout << endl;
+
+	tcout << _T("Wypelnianie...:\n");
+
+	for (uint i = 0; i < COUNT; i++)
+		*tablica.get()[i] = i;
+
+	tcout << (Format(_T("Stats: Empty=#, Full=#, BlockCount=#, BlockCapacity=#, UsedCount=#, FreeCount=#, Capacity=#, BlockSize=#, ...\n")) %
+		lista.IsEmpty() % lista.IsFull() % lista.GetBlockCount() % lista.GetBlockCapacity() % lista.GetUsedCount() % lista.GetFreeCount() % lista.GetCapacity() % lista.GetBlockSize()).str();
+
+	tcout << _T("Elementy:\n");
+	for (uint i = 0; i < COUNT; i++)
+		tcout << *tablica.get()[i] << _T(' ');
+	tcout << endl;
+
+	tcout << _T("Zwalnianie...:\n");
+	for (uint i = 0; i < COUNT; i++)
+		lista.Delete(tablica.get()[i]);
+
+	tcout << (Format(_T("Stats: Empty=#, Full=#, BlockCount=#, BlockCapacity=#, UsedCount=#, FreeCount=#, Capacity=#, BlockSize=#, ...\n")) %
+		lista.IsEmpty() % lista.IsFull() % lista.GetBlockCount() % lista.GetBlockCapacity() % lista.GetUsedCount() % lista.GetFreeCount() % lista.GetCapacity() % lista.GetBlockSize()).str();
+}
+
+/*
+template <typename T>
+void AdvancedFreeListTestAndProfile()
+{
+	const uint BLOCK_SIZE = 128;
+	const uint MAX_SIZE = 1024*10;
+	const uint OP_COUNT = MAX_SIZE;
+	std::vector<T*> Pointers;
+	std::vector<int> OpSequence; // > 0 = numer wskaźnika do zwolnienia, -1 = alokacja nowego
+	OpSequence.resize(OP_COUNT);
+	for (uint op = 0; op < OP_COUNT; op++)
+		OpSequence[op] = (g_Rand.RandUint(10) == 0) ? (int)g_Rand.RandUint(MAX_SIZE) : -1;
+
+	{
+		FreeList<T> List(MAX_SIZE);
+
+		PROFILE_GUARD(g_Profiler, _T("FreeList"));
+		for (uint op = 0; op < OP_COUNT; op++)
+		{
+			if (OpSequence[op] == -1)
+				Pointers.push_back(List.New());
+			else if (!Pointers.empty())
+			{
+				uint Index = op % Pointers.size();
+				List.Delete(Pointers[Index]);
+				Pointers.erase(Pointers.begin()+Index);
+			}
+		}
+		while (!Pointers.empty())
+		{
+			List.Delete(Pointers.back());
+			Pointers.pop_back();
+		}
+	}
+
+	{
+		DynamicFreeList<T> List(BLOCK_SIZE);
+
+		PROFILE_GUARD(g_Profiler, _T("DynamicFreeList"));
+		for (uint op = 0; op < OP_COUNT; op++)
+		{
+			if (OpSequence[op] == -1)
+				Pointers.push_back(List.New());
+			else if (!Pointers.empty())
+			{
+				uint Index = op % Pointers.size();
+				List.Delete(Pointers[Index]);
+				Pointers.erase(Pointers.begin()+Index);
+			}
+		}
+		while (!Pointers.empty())
+		{
+			List.Delete(Pointers.back());
+			Pointers.pop_back();
+		}
+	}
+
+	{
+		PROFILE_GUARD(g_Profiler, _T("new i delete"));
+		for (uint op = 0; op < OP_COUNT; op++)
+		{
+			if (OpSequence[op] == -1)
+				Pointers.push_back(new T);
+			else if (!Pointers.empty())
+			{
+				uint Index = op % Pointers.size();
+				delete Pointers[Index];
+				Pointers.erase(Pointers.begin()+Index);
+			}
+		}
+		while (!Pointers.empty())
+		{
+			delete Pointers.back();
+			Pointers.pop_back();
+		}
+	}
+}
+
+class DuzaKlasa
+{
+	char Zapelniacz[1024];
+};
+
+void CompelexTestFreeLists()
+{
+	for (uint TestI = 0; TestI < 10; TestI++)
+	{
+		{
+			PROFILE_GUARD(g_Profiler, _T("Element typu int"));
+			AdvancedFreeListTestAndProfile<int>();
+		}
+		{
+			PROFILE_GUARD(g_Profiler, _T("Element typu zajmujacego 1024 bajty"));
+			AdvancedFreeListTestAndProfile<DuzaKlasa>();
+		}
+	}
+}
+*/
+
+void TestZlibUtils()
+{
+	WriteLine(_T("==================== ZLIB UTILS ===================="));
+
+	const char * const INPUT_DATA = "Ala ma kota, To jest test, Hello World, ble ble ble, delelele, blfzcf i dupadupa";
+	
+	{
+		size_t OutputBufLen = ZlibCompressionStream::CompressLength(strlen(INPUT_DATA));
+		scoped_ptr<char, DeleteArrayPolicy> OutputData(new char[OutputBufLen]);
+
+		size_t OutputSize = ZlibCompressionStream::Compress(OutputData.get(), OutputBufLen, INPUT_DATA, strlen(INPUT_DATA));
+
+		scoped_ptr<char, DeleteArrayPolicy> Input2Data(new char[strlen(INPUT_DATA)]);
+		size_t Input2Size = ZlibDecompressionStream::Decompress(Input2Data.get(), strlen(INPUT_DATA), OutputData.get(), OutputSize);
+		WriteLine(Format(_T("InputLen=#, OutputBufMaxLen=#, OutputSize=#, InputLen2=#")) % strlen(INPUT_DATA) % OutputBufLen % OutputSize % Input2Size);
+
+		for (uint i = 0; INPUT_DATA[i] != '\0'; i++)
+			assert( INPUT_DATA[i] == Input2Data[i] );
+	}
+
+	{
+		VectorStream v1;
+		{
+			ZlibCompressionStream c1(&v1);
+			c1.Write(INPUT_DATA, strlen(INPUT_DATA));
+		}
+		v1.Rewind();
+		VectorStream v1d;
+		{
+			ZlibDecompressionStream d1(&v1);
+			assert (d1.End() == false );
+			CopyToEnd(&v1d, &d1);
+			assert (d1.End() == true );
+		}
+		bool Correct1 = (v1d.GetSize() == strlen(INPUT_DATA));
+		if (Correct1)
+		{
+			for (uint i = 0; INPUT_DATA[i] != '\0'; i++)
+			{
+				if (INPUT_DATA[i] != v1d.Data()[i])
+				{
+					Correct1 = false;
+					break;
+				}
+			}
+		}
+		WriteLine(Format(_T("Compression/decompression (całość):\n  in_len=#, out_len=#, po_dekompresji_len=#, correct=#")) % strlen(INPUT_DATA) % v1.GetSize() % v1d.GetSize() % Correct1);
+
+		VectorStream v2;
+		{
+			ZlibCompressionStream c2(&v2);
+			for (uint i = 0; INPUT_DATA[i] != '\0'; i++)
+				c2.Write(&INPUT_DATA[i], 1);
+			c2.Flush();
+		}
+		v2.Rewind();
+		VectorStream v2d;
+		{
+			ZlibDecompressionStream d2(&v2);
+			for (uint i = 0; INPUT_DATA[i] != '\0'; i++)
+			{
+				assert( d2.End() == false );
+				char Ch;
+				d2.MustRead(&Ch, 1);
+				v2d.Write(&Ch, 1);
+			}
+			assert( d2.End() == true );
+		}
+		bool Correct2 = (v2d.GetSize() == strlen(INPUT_DATA));
+		if (Correct2)
+		{
+			for (uint i = 0; INPUT_DATA[i] != '\0'; i++)
+			{
+				if (INPUT_DATA[i] != v2d.Data()[i])
+				{
+					Correct2 = false;
+					break;
+				}
+			}
+		}
+		WriteLine(Format(_T("Compression/decompression (po znaku):\n  in_len=#, out_len=#, po_dekompresji_len=#, correct=#")) % strlen(INPUT_DATA) % v2.GetSize() % v2d.GetSize() % Correct2);
+
+		// Test dla pustego
+		VectorStream ev;
+		{
+			ZlibCompressionStream c(&ev);
+		}
+		ev.Rewind();
+		VectorStream evd;
+		{
+			ZlibDecompressionStream d(&ev);
+			assert( d.End() == true );
+			CopyToEnd(&evd, &d);
+			assert( d.End() == true );
+		}
+		WriteLine(Format(_T("Compression/decompression (pusty):\n  in_len=(0), out_len=#, po_dekompresji_len=#")) % ev.GetSize() % evd.GetSize());
+	}
+
+	// Test gzip
+	{
+		const string FileName1 = "Plik.test", Comment1 = "Komentarz";
+
+		// Test 1 - plik
+		{
+			common::GzipFileStream Plik("Archive.gz", common::GZFM_WRITE);
+			Plik.Write(INPUT_DATA, strlen(INPUT_DATA));
+		}
+		{
+			common::GzipFileStream Plik("Archive.gz", common::GZFM_READ);
+			assert( Plik.End() == false );
+			std::vector<char> Data;
+			Data.resize(strlen(INPUT_DATA));
+			Plik.MustRead(&Data[0], strlen(INPUT_DATA));
+			assert( Plik.End() == true );
+			char Foo;
+			assert( Plik.Read(&Foo, 1) == 0 );
+			assert( std::equal(&INPUT_DATA[0], &INPUT_DATA[strlen(INPUT_DATA)], Data.begin()) );
+			WriteLine(_T("Gzip - file - PASSED"));
+		}
+
+		// Test 1a - plik zapisywany w tle
+		{
+			common::GzipFileStream Plik("Archive.gz", common::GZFM_WRITE_ASYNC, ZLIB_DEFAULT_LEVEL, 16, 2);
+			for (size_t i = 0; i < 100; i++)
+				Plik.Write(INPUT_DATA, strlen(INPUT_DATA));
+			Plik.Flush();
+			Plik.Write(INPUT_DATA, strlen(INPUT_DATA));
+			Plik.Close();
+		}
+		{
+			common::GzipFileStream Plik("Archive.gz", common::GZFM_READ);
+			std::vector<char> Data(strlen(INPUT_DATA));
+			for (size_t i = 0; i < 101; i++)
+			{
+				Plik.MustRead(&Data[0], strlen(INPUT_DATA));
+				assert( std::equal(&INPUT_DATA[0], &INPUT_DATA[strlen(INPUT_DATA)], Data.begin()) );
+			}
+			char Foo;
+			assert( Plik.Read(&Foo, 1) == 0 );
+			WriteLine(_T("Gzip - async file - PASSED"));
+		}
+
+		common::DeleteFile(_T("Archive.gz"));
+
+		// Test 2 - strumień
+		{
+			common::FileStream Plik(_T("Archive.gz"), common::FM_WRITE);
+			GzipCompressionStream Gzip(&Plik, &FileName1, &Comment1);
+			Gzip.WriteStringF(INPUT_DATA);
+		}
+		{
+			common::FileStream Plik(_T("Archive.gz"), common::FM_READ);
+			string FileName2, Comment2;
+			GzipDecompressionStream Gzip(&Plik);
+			std::vector<char> Data;
+			Data.resize(strlen(INPUT_DATA));
+			for (uint i = 0; INPUT_DATA[i] != '\0'; i++)
+			{
+				assert( Gzip.End() == false );
+				Gzip.MustRead(&Data[i], 1);
+			}
+			assert( Gzip.End() == true );
+			char Foo;
+			assert( Gzip.Read(&Foo, 1) == 0 );
+			assert( std::equal(&INPUT_DATA[0], &INPUT_DATA[strlen(INPUT_DATA)], Data.begin()) );
+			assert( Gzip.GetHeaderFileName(&FileName2) == true );
+			assert( Gzip.GetHeaderComment(&Comment2) == true );
+			assert( FileName2 == FileName1 );
+			assert( Comment2 == Comment1 );
+			WriteLine(_T("Gzip - stream - PASSED"));
+		}
+
+		common::DeleteFile(_T("Archive.gz"));
+	}
+
+	// Test parallel gzip
+	{
+		std::vector<char> Data(1000000);
+		for (size_t i = 0; i < Data.size(); i++)
+			Data[i] = INPUT_DATA[i * i / 1000 % strlen(INPUT_DATA)];
+
+		const string FileName1 = "Plik.test";
+		VectorStream Compressed;
+		{
+			ParallelGzipCompressionStream Gzip(&Compressed, &FileName1, NULL, ZLIB_DEFAULT_LEVEL, 4);
+			Gzip.Write(&Data[0], 12345);
+			Gzip.Flush();
+			Gzip.Write(&Data[12345], Data.size() - 12345);
+		}
+		Compressed.Rewind();
+
+		VectorStream Decompressed;
+		string FileName2;
+		{
+			GzipDecompressionStream Gzip(&Compressed);
+			CopyToEnd(&Decompressed, &Gzip);
+			assert( Gzip.GetHeaderFileName(&FileName2) == true );
+		}
+		assert( FileName2 == FileName1 );
+		assert( Decompressed.GetSize() == Data.size() );
+		assert( memcmp(Decompressed.Data(), &Data[0], Data.size()) == 0 );
+		WriteLine(Format(_T("Parallel gzip - in_len=#, out_len=# - PASSED")) % Data.size() % Compressed.GetSize());
+	}
+
+	// Test multi-member gzip
+	{
+		std::vector<char> Data(1000000);
+		for (size_t i = 0; i < Data.size(); i++)
+			Data[i] = INPUT_DATA[g_Rand.RandUint((uint32)strlen(INPUT_DATA))];
+
+		VectorStream Compressed;
+		for (size_t Pos = 0; Pos < Data.size(); )
+		{
+			size_t Len = std::min((size_t)g_Rand.RandUint(100000), Data.size() - Pos);
+			GzipCompressionStream Gzip(&Compressed, NULL, NULL);
+			Gzip.Write(&Data[Pos], Len);
+			Pos += Len;
+		}
+
+		VectorStream Decompressed1;
+		Compressed.Rewind();
+		{
+			GzipDecompressionStream Gzip(&Compressed);
+			CopyToEnd(&Decompressed1, &Gzip);
+		}
+		assert( Decompressed1.GetSize() == Data.size() );
+		assert( memcmp(Decompressed1.Data(), &Data[0], Data.size()) == 0 );
+
+		VectorStream Decompressed2;
+		Compressed.Rewind();
+		{
+			ParallelGzipDecompressionStream Gzip(&Compressed, 4, 256 * 1024);
+			CopyToEnd(&Decompressed2, &Gzip);
+		}
+		assert( Decompressed2.GetSize() == Data.size() );
+		assert( memcmp(Decompressed2.Data(), &Data[0], Data.size()) == 0 );
+		WriteLine(_T("Gzip multi-member - PASSED"));
+	}
+
+	// Test multi-member gzip with member boundaries near the end of a batch
+	{
+		const size_t MEMBER_SIZE = 8000;
+		std::vector<char> Data(3 * MEMBER_SIZE);
+		for (size_t i = 0; i < Data.size(); i++)
+			Data[i] = INPUT_DATA[g_Rand.RandUint((uint32)strlen(INPUT_DATA))];
+
+		VectorStream Compressed;
+		size_t MemberEnds[3];
+		for (size_t i = 0; i < 3; i++)
+		{
+			{
+				GzipCompressionStream Gzip(&Compressed, NULL, NULL);
+				Gzip.Write(&Data[i * MEMBER_SIZE], MEMBER_SIZE);
+			}
+			MemberEnds[i] = (size_t)Compressed.GetSize();
+		}
+		assert( MemberEnds[0] > BUFFER_SIZE + 16 );
+		// Unusual OS field in the last header - valid, but not typical
+		Compressed.Data()[MemberEnds[1] + 9] = (char)200;
+		// Garbage after the last member is ignored
+		Compressed.Write("\0garbage", 8);
+
+		// Header of the second member straddles the end of the first batch
+		for (size_t BatchSize = MemberEnds[0] - 4; BatchSize <= MemberEnds[0] + 12; BatchSize++)
+		{
+			VectorStream Decompressed;
+			Compressed.Rewind();
+			{
+				ParallelGzipDecompressionStream Gzip(&Compressed, 4, BatchSize);
+				CopyToEnd(&Decompressed, &Gzip);
+			}
+			assert( Decompressed.GetSize() == Data.size() );
+			assert( memcmp(Decompressed.Data(), &Data[0], Data.size()) == 0 );
+		}
+		WriteLine(_T("Gzip members at batch end - PASSED"));
+	}
+
+	// Garbage is ignored only after a member - input without any member is an error
+	{
+		const char * const BAD_INPUTS[] = { "", "Not gzip data", "\x1F\x8B\x08\xE0 not really gzip header" };
+		for (size_t i = 0; i < _countof(BAD_INPUTS); i++)
+		{
+			MemoryStream BadInput(strlen(BAD_INPUTS[i]), (void*)BAD_INPUTS[i]);
+			ParallelGzipDecompressionStream Gzip(&BadInput, 4);
+			char Buf[16];
+			bool ErrorDetected = false;
+			try
+			{
+				Gzip.Read(Buf, sizeof(Buf));
+			}
+			catch (const Error &)
+			{
+				ErrorDetected = true;
+			}
+			assert( ErrorDetected );
+		}
+
+		// Member decompressed sequentially, because it's longer than the batch, followed by garbage
+		std::vector<char> Data(BUFFER_SIZE * 8);
+		for (size_t i = 0; i < Data.size(); i++)
+			Data[i] = (char)g_Rand.RandUint(256);
+		VectorStream Compressed;
+		{
+			GzipCompressionStream Gzip(&Compressed, NULL, NULL);
+			Gzip.Write(&Data[0], Data.size());
+		}
+		Compressed.Write("garbage", 7);
+		Compressed.Rewind();
+		VectorStream Decompressed;
+		{
+			ParallelGzipDecompressionStream Gzip(&Compressed, 4, BUFFER_SIZE);
+			CopyToEnd(&Decompressed, &Gzip);
+		}
+		assert( Decompressed.GetSize() == Data.size() );
+		assert( memcmp(Decompressed.Data(), &Data[0], Data.size()) == 0 );
+		WriteLine(_T("Gzip without members - PASSED"));
+	}
+
+	// Test reusable contexts with preset dictionary
+	{
+		const char * const DICT = "Ala ma kota, To jest test, Hello World";
+		ZlibCompressor Compressor;
+		ZlibDecompressor Decompressor;
+		Compressor.SetDictionary(DICT, strlen(DICT));
+		Decompressor.SetDictionary(DICT, strlen(DICT));
+
+		char Compressed[256], Decompressed[256];
+		for (uint i = 0; i < 10; i++)
+		{
+			size_t Len = strlen(INPUT_DATA) - i;
+			assert( Compressor.CompressLength(Len) <= sizeof(Compressed) );
+			size_t CompressedLen = Compressor.Compress(Compressed, sizeof(Compressed), INPUT_DATA, Len);
+			size_t DecompressedLen = Decompressor.Decompress(Decompressed, sizeof(Decompressed), Compressed, CompressedLen);
+			assert( DecompressedLen == Len );
+			assert( memcmp(Decompressed, INPUT_DATA, Len) == 0 );
+		}
+		WriteLine(_T("Zlib contexts - PASSED"));
+
+		// Benchmark - many small messages
+		const uint MESSAGE_COUNT = 100000;
+		tstring Message;
+		{
+			PROFILE_GUARD(g_Profiler, _T("Small messages - static Compress/Decompress"));
+			for (uint i = 0; i < MESSAGE_COUNT; i++)
+			{
+				Message = Format(_T("Ala ma kota # razy, Hello World")) % i;
+				size_t CompressedLen = ZlibCompressionStream::Compress(Compressed, sizeof(Compressed), Message.data(), Message.length() * sizeof(tchar));
+				ZlibDecompressionStream::Decompress(Decompressed, sizeof(Decompressed), Compressed, CompressedLen);
+			}
+		}
+		{
+			PROFILE_GUARD(g_Profiler, _T("Small messages - ZlibCompressor/ZlibDecompressor"));
+			for (uint i = 0; i < MESSAGE_COUNT; i++)
+			{
+				Message = Format(_T("Ala ma kota # razy, Hello World")) % i;
+				size_t CompressedLen = Compressor.Compress(Compressed, sizeof(Compressed), Message.data(), Message.length() * sizeof(tchar));
+				Decompressor.Decompress(Decompressed, sizeof(Decompressed), Compressed, CompressedLen);
+			}
+		}
+	}
+
+	// Test gzip index
+	{
+		std::vector<char> Data(1000000);
+		for (size_t i = 0; i < Data.size(); i++)
+			Data[i] = INPUT_DATA[g_Rand.RandUint((uint32)strlen(INPUT_DATA))];
+
+		// Two concatenated members
+		VectorStream Compressed;
+		{
+			GzipCompressionStream Gzip(&Compressed, NULL, NULL);
+			Gzip.Write(&Data[0], 300000);
+		}
+		{
+			GzipCompressionStream Gzip(&Compressed, NULL, NULL);
+			Gzip.Write(&Data[300000], Data.size() - 300000);
+		}
+		Compressed.Rewind();
+
+		GzipIndex Index1;
+		Index1.Build(&Compressed, 100000);
+		VectorStream IndexData;
+		Index1.SaveToStream(&IndexData);
+		IndexData.Rewind();
+		GzipIndex Index2;
+		Index2.LoadFromStream(&IndexData);
+		assert( Index2.GetPointCount() == Index1.GetPointCount() );
+		assert( Index2.GetUncompressedSize() == Data.size() );
+
+		// Damaged number of points must not make the index allocate memory for all of them
+		{
+			VectorStream BadIndexData;
+			BadIndexData.Write(IndexData.Data(), (size_t)IndexData.GetSize());
+			uint32 BadPointCount = 0xFFFFFFFF;
+			memcpy(BadIndexData.Data() + 21, &BadPointCount, sizeof(BadPointCount));
+			BadIndexData.Rewind();
+			GzipIndex BadIndex;
+			bool ErrorDetected = false;
+			try
+			{
+				BadIndex.LoadFromStream(&BadIndexData);
+			}
+			catch (const Error &)
+			{
+				ErrorDetected = true;
+			}
+			assert( ErrorDetected );
+			assert( BadIndex.GetPointCount() == 0 );
+		}
+
+		GzipSeekableDecompressionStream Gzip(&Compressed, &Index2);
+		std::vector<char> Data2(Data.size());
+		for (uint i = 0; i < 100; i++)
+		{
+			size_t Pos = g_Rand.RandUint((uint32)Data.size());
+			size_t Len = std::min((size_t)g_Rand.RandUint(200000), Data.size() - Pos);
+			Gzip.SetPos(Pos);
+			Gzip.MustRead(&Data2[0], Len);
+			assert( memcmp(&Data2[0], &Data[Pos], Len) == 0 );
+		}
+		WriteLine(Format(_T("Gzip index - points=#, index_len=# - PASSED")) % Index2.GetPointCount() % IndexData.GetSize());
+	}
+
+	// Test chunked container
+	{
+		std::vector<char> Data(1000000);
+		for (size_t i = 0; i < Data.size(); i++)
+			Data[i] = (char)(i * 7 % 251 ^ i >> 10);
+
+		VectorStream Container;
+		{
+			ChunkedCompressionStream Chunked(&Container, 65536);
+			Chunked.Write(&Data[0], 100000);
+			Chunked.Flush();
+			Chunked.Write(&Data[100000], Data.size() - 100000);
+		}
+		Container.Rewind();
+
+		ChunkedDecompressionStream Chunked(&Container);
+		assert( Chunked.GetSize() == Data.size() );
+		Chunked.Verify();
+
+		std::vector<char> Data2(Data.size());
+		Chunked.MustRead(&Data2[0], Data2.size());
+		assert( Chunked.End() == true );
+		assert( Data2 == Data );
+
+		for (uint i = 0; i < 100; i++)
+		{
+			size_t Pos = g_Rand.RandUint((uint32)Data.size());
+			size_t Len = std::min((size_t)g_Rand.RandUint(200000), Data.size() - Pos);
+			Chunked.SetPos(Pos);
+			Chunked.MustRead(&Data2[0], Len);
+			assert( memcmp(&Data2[0], &Data[Pos], Len) == 0 );
+		}
+
+		// Chunk larger than chunk size must be rejected, even if index MD5 is correct
+		{
+			VectorStream Crafted;
+			Crafted.Write(Container.Data(), (size_t)Container.GetSize());
+			size_t FooterOffset = (size_t)Crafted.GetSize() - 40;
+			uint64 IndexOffset;
+			uint32 ChunkCount;
+			memcpy(&IndexOffset, Crafted.Data() + FooterOffset, sizeof(IndexOffset));
+			memcpy(&ChunkCount, Crafted.Data() + FooterOffset + 8, sizeof(ChunkCount));
+			// Whole data moved to the first chunk, so the total size still matches
+			uint32 BigSize = (uint32)Data.size();
+			memcpy(Crafted.Data() + (size_t)IndexOffset + 12, &BigSize, sizeof(BigSize));
+			for (uint32 i = 1; i < ChunkCount; i++)
+				memset(Crafted.Data() + (size_t)IndexOffset + i * 20 + 12, 0, sizeof(uint32));
+			MD5_SUM IndexMD5;
+			MD5_Calc::Calc(&IndexMD5, Crafted.Data() + (size_t)IndexOffset, ChunkCount * 20);
+			memcpy(Crafted.Data() + FooterOffset + 20, &IndexMD5, sizeof(IndexMD5));
+			Crafted.Rewind();
+			bool ErrorDetected = false;
+			try
+			{
+				ChunkedDecompressionStream CraftedChunked(&Crafted);
+			}
+			catch (const Error &)
+			{
+				ErrorDetected = true;
+			}
+			assert( ErrorDetected );
+		}
+
+		// Damaged chunk must be detected
+		Container.Data()[20] ^= 0x55;
+		Container.Rewind();
+		ChunkedDecompressionStream Damaged(&Container);
+		bool ErrorDetected = false;
+		try
+		{
+			Damaged.Verify();
+		}
+		catch (const Error &)
+		{
+			ErrorDetected = true;
+		}
+		assert( ErrorDetected );
+
+		WriteLine(Format(_T("Chunked container - chunks=#, in_len=#, out_len=# - PASSED")) % Chunked.GetChunkCount() % Data.size() % Container.GetSize());
+	}
+}
+
+void TestCompression()
+{
+	const char * const WORDS[] = { "Ala ", "ma ", "kota, ", "Hello ", "World\n", "To jest test. " };
+	std::string Data;
+	while (Data.size() < 4000000)
+	{
+		Data += WORDS[g_Rand.RandUint(_countof(WORDS))];
+		if (g_Rand.RandUint(8) == 0)
+			Data += (char)('0' + g_Rand.RandUint(10));
+	}
+
+	// Blocks of all sizes up to a few bytes, with all levels
+	std::vector<char> Compressed(LzCompressor::CompressLength(Data.size()));
+	std::vector<char> Decompressed(Data.size());
+	for (int Level = LZ_FASTEST_LEVEL; Level <= LZ_BEST_LEVEL; Level++)
+	{
+		for (size_t Len = 0; Len < 100; Len++)
+		{
+			size_t CompressedLen = LzCompressor::Compress(&Compressed[0], Compressed.size(), Data.data(), Len, Level);
+			size_t DecompressedLen = LzCompressor::Decompress(&Decompressed[0], Len, &Compressed[0], CompressedLen);
+			assert( DecompressedLen == Len );
+			assert( memcmp(&Decompressed[0], Data.data(), Len) == 0 );
+		}
+	}
+
+	// Damaged data must cause Error, never access outside of buffers
+	{
+		size_t CompressedLen = LzCompressor::Compress(&Compressed[0], Compressed.size(), Data.data(), 10000);
+		for (uint i = 0; i < 1000; i++)
+		{
+			std::vector<char> Damaged(Compressed.begin(), Compressed.begin() + CompressedLen);
+			Damaged[g_Rand.RandUint((uint32)CompressedLen)] = (char)g_Rand.RandUint(256);
+			try
+			{
+				LzCompressor::Decompress(&Decompressed[0], 10000, &Damaged[0], g_Rand.RandUint((uint32)CompressedLen) + 1);
+			}
+			catch (const Error &)
+			{
+			}
+		}
+	}
+
+	// The same code for all codecs
+	LzCodec Lz;
+	ZlibCodec Zlib;
+	ZlibCodec Gzip(ZLIB_DEFAULT_LEVEL, true);
+	CompressionCodec * const CODECS[] = { &Lz, &Zlib, &Gzip };
+	for (size_t ci = 0; ci < _countof(CODECS); ci++)
+	{
+		CompressionCodec *Codec = CODECS[ci];
+
+		VectorStream Packed;
+		{
+			scoped_ptr<OverlayStream> Encoder(Codec->CreateEncoder(&Packed));
+			size_t Pos = 0;
+			while (Pos < Data.size())
+			{
+				size_t Len = std::min((size_t)g_Rand.RandUint(100000), Data.size() - Pos);
+				Encoder->Write(&Data[Pos], Len);
+				Pos += Len;
+			}
+		}
+		Packed.Rewind();
+		{
+			scoped_ptr<OverlayStream> Decoder(Codec->CreateDecoder(&Packed));
+			Decoder->MustRead(&Decompressed[0], Data.size());
+			assert( Decoder->End() );
+			assert( memcmp(&Decompressed[0], Data.data(), Data.size()) == 0 );
+		}
+
+		Compressed.resize(Codec->CompressLength(Data.size()));
+		size_t CompressedLen, DecompressedLen;
+		{
+			PROFILE_GUARD(g_Profiler, Format(_T("Codec # - Compress")) % Codec->GetName());
+			CompressedLen = Codec->Compress(&Compressed[0], Compressed.size(), Data.data(), Data.size());
+		}
+		{
+			PROFILE_GUARD(g_Profiler, Format(_T("Codec # - Decompress")) % Codec->GetName());
+			for (uint i = 0; i < 10; i++)
+				DecompressedLen = Codec->Decompress(&Decompressed[0], Decompressed.size(), &Compressed[0], CompressedLen);
+		}
+		assert( DecompressedLen == Data.size() );
+		assert( memcmp(&Decompressed[0], Data.data(), Data.size()) == 0 );
+
+		WriteLine(Format(_T("Codec # - in_len=#, block_len=#, stream_len=# - PASSED")) % Codec->GetName() % Data.size() % CompressedLen % Packed.GetSize());
+	}
+}
+
+void TestFiles()
+{
+	WriteLine(_T("==================== FILES ===================="));
+
+	tstring Name;
+	common::FILE_ITEM_TYPE Type;
+
+#ifdef _WIN32
+	const tchar * PATHS[] =
+	{
+		_T("D:"),
+		_T("C:\\Windows"),
+		_T("EmptyDir"),
+		_T("")
+	};
+#else
+	const tchar * PATHS[] =
+	{
+		_T("/"),
+		_T("/boot"),
+		_T("EmptyDir"),
+		_T("")
+	};
+#endif
+
+#ifdef _WIN32
+	for (uint i = 0; _tcslen(PATHS[i]) > 0; i++)
+#else
+	for (uint i = 0; strlen(PATHS[i]) > 0; i++)
+#endif
+	{
+		WriteLine(Format(_T("Listowanie katalogu: #")) % PATHS[i]);
+		common::DirLister Lister(PATHS[i]);
+		while (Lister.ReadNext(&Name, &Type))
+			tcout << (Format(_T("- # # ")) % ((Type == common::IT_DIR) ? _T("DIR ") : _T("FILE")) % Name).str();
+		tcout << endl;
+	}
+
+	{
+		common::DATETIME ctime, mtime, atime; uint64 size; common::FILE_ITEM_TYPE type;
+		common::MustGetFileItemInfo(_T("EmptyDir"), &type, &size, &mtime, &ctime, &atime);
+		WriteLine(Format(_T("MustGetFileItemInfo(\"EmptyDir\"): Type=#, Size=#\n  MTime=#\n  CTime=#\n  ATime=#")) %
+			(uint)type % size % common::TMSTRUCT(mtime) % common::TMSTRUCT(ctime) % common::TMSTRUCT(atime));
+		common::MustGetFileItemInfo(_T("TwoCharFile.txt"), &type, &size, &mtime, &ctime, &atime);
+		WriteLine(Format(_T("MustGetFileItemInfo(\"TwoCharFile.txt\"): Type=#, Size=#\n  MTime=#\n  CTime=#\n  ATime=#")) %
+			(uint)type % size % common::TMSTRUCT(mtime) % common::TMSTRUCT(ctime) % common::TMSTRUCT(atime));
+	}
+
+	{
+		WriteLine(Format(_T("GetFileItemType(\"EmptyDir\") = #")) % (uint)common::GetFileItemType(_T("EmptyDir")));
+		WriteLine(Format(_T("GetFileItemType(\"TwoCharFile.txt\") = #")) % (uint)common::GetFileItemType(_T("TwoCharFile.txt")));
+		WriteLine(Format(_T("GetFileItemType(\"Wrong.foo\") = #")) % (uint)common::GetFileItemType(_T("Wrong.foo")));
+	}
+
+	{
+		common::MustUpdateFileTimeToNow(_T("TwoCharFile.txt"));
+		common::DATETIME ctime, mtime, atime;
+		common::MustGetFileItemInfo(_T("TwoCharFile.txt"), NULL, NULL, &mtime, &ctime, &atime);
+		WriteLine(Format(_T("MustGetFileItemInfo(\"TwoCharFile.txt\") after MustUpdateFileTimeToNow:\n  MTime=#\n  CTime=#\n  ATime=#")) %
+			common::TMSTRUCT(mtime) % common::TMSTRUCT(ctime) % common::TMSTRUCT(atime));
+	}
+
+	{
+		tstring Dir = _T("EmptyDir") + CharToStrR(DIR_SEP) + _T("Test1") + CharToStrR(DIR_SEP) + _T("Test2");
+		common::MustCreateDirectoryChain(Dir);
+		assert( common::GetFileItemType(Dir) == common::IT_DIR );
+		common::MustDeleteDirectory(Dir);
+		common::MustDeleteDirectory(_T("EmptyDir") + CharToStrR(DIR_SEP) + _T("Test1"));
+		assert( common::GetFileItemType(Dir) == common::IT_NONE );
+		WriteLine(_T("MustCreateDirectoryChain and MustDeleteDirectory test succeeded."));
+	}
+
+	{
+		tstring FileName1 = _T("TEMP1");
+		tstring FileName2 = _T("TEMP2");
+		assert( common::GetFileItemType(FileName1) == common::IT_NONE );
+		assert( common::GetFileItemType(FileName2) == common::IT_NONE );
+		{
+			common::FileStream Plik(FileName1, common::FM_WRITE);
+		}
+		assert( common::GetFileItemType(FileName1) == common::IT_FILE );
+		assert( common::GetFileItemType(FileName2) == common::IT_NONE );
+		common::MustMoveItem(FileName1, FileName2);
+		assert( common::GetFileItemType(FileName1) == common::IT_NONE );
+		assert( common::GetFileItemType(FileName2) == common::IT_FILE );
+		common::MustDeleteFile(FileName2);
+		assert( common::GetFileItemType(FileName1) == common::IT_NONE );
+		assert( common::GetFileItemType(FileName2) == common::IT_NONE );
+		WriteLine(_T("MustMoveFile and MustDeleteFile test succeeded."));
+	}
+
+	{
+		// Tree: WalkDir/A/File0..File49, WalkDir/A/Sub/File, WalkDir/B/Pruned/File
+		tstring Root = _T("WalkDir");
+		tstring A = Root + CharToStrR(DIR_SEP) + _T("A");
+		tstring Pruned = Root + CharToStrR(DIR_SEP) + _T("B") + CharToStrR(DIR_SEP) + _T("Pruned");
+		common::MustCreateDirectoryChain(A + CharToStrR(DIR_SEP) + _T("Sub"));
+		common::MustCreateDirectoryChain(Pruned);
+		for (uint i = 0; i < 50; i++)
+			common::SaveStringToFile(A + CharToStrR(DIR_SEP) + _T("File") + UintToStrR(i), string(i, 'x'));
+		common::SaveStringToFile(A + CharToStrR(DIR_SEP) + _T("Sub") + CharToStrR(DIR_SEP) + _T("File"), "x");
+		common::SaveStringToFile(Pruned + CharToStrR(DIR_SEP) + _T("File"), "x");
+
+		class PruneFilter : public common::DirWalkerFilter
+		{
+		public:
+			virtual bool EnterDir(const common::DIR_WALKER_ENTRY &Entry) { return Entry.Path.find(_T("Pruned")) == tstring::npos; }
+		};
+		PruneFilter Filter;
+
+		common::DirWalker Walker(Root, common::DirWalker::FLAG_STAT, &Filter, 4, 16);
+		std::vector<common::DIR_WALKER_ENTRY> Batch;
+		uint FileCount = 0, DirCount = 0;
+		uint64 TotalSize = 0;
+		while (Walker.ReadBatch(&Batch))
+		{
+			assert( !Batch.empty() && Batch.size() <= 16 );
+			for (size_t i = 0; i < Batch.size(); i++)
+			{
+				if (Batch[i].Type == common::IT_DIR)
+					DirCount++;
+				else
+				{
+					FileCount++;
+					TotalSize += Batch[i].Size;
+				}
+			}
+		}
+		// A, Sub, B, Pruned (listed but not entered)
+		assert( DirCount == 4 );
+		assert( FileCount == 51 );
+		assert( TotalSize == 49 * 50 / 2 + 1 );
+
+		for (uint i = 0; i < 50; i++)
+			common::MustDeleteFile(A + CharToStrR(DIR_SEP) + _T("File") + UintToStrR(i));
+		common::MustDeleteFile(A + CharToStrR(DIR_SEP) + _T("Sub") + CharToStrR(DIR_SEP) + _T("File"));
+		common::MustDeleteFile(Pruned + CharToStrR(DIR_SEP) + _T("File"));
+		common::MustDeleteDirectory(A + CharToStrR(DIR_SEP) + _T("Sub"));
+		common::MustDeleteDirectory(A);
+		common::MustDeleteDirectory(Pruned);
+		common::MustDeleteDirectory(Root + CharToStrR(DIR_SEP) + _T("B"));
+		common::MustDeleteDirectory(Root);
+		WriteLine(_T("DirWalker test succeeded."));
+	}
+
+	{
+		tstring Root = _T("WatchDir");
+		tstring FileName = Root + CharToStrR(DIR_SEP) + _T("File");
+		tstring TmpFileName = Root + CharToStrR(DIR_SEP) + _T("Tmp");
+		common::MustCreateDirectory(Root);
+		for (uint Pass = 0; Pass < 2; Pass++)
+		{
+			common::FileWatcher Watcher(Root, Pass == 0 ? 0 : common::FileWatcher::FLAG_POLLING, NULL, 50, 100);
+			assert( Pass == 0 || Watcher.IsPolling() );
+
+			common::SaveStringToFile(FileName, "ABC");
+			// Created and deleted before delivery - coalesced into nothing with inotify
+			common::SaveStringToFile(TmpFileName, "ABC");
+			common::MustDeleteFile(TmpFileName);
+
+			std::vector<common::FILE_WATCHER_EVENT> Events;
+			bool Found = false;
+			for (uint i = 0; i < 50 && !Found; i++)
+			{
+				if (Watcher.GetEvents(&Events, 100))
+				{
+					for (size_t j = 0; j < Events.size(); j++)
+					{
+						assert( Pass == 1 || Events[j].Path != _T("Tmp") );
+						if (Events[j].Path == _T("File") && Events[j].Action == common::FWA_CREATED)
+							Found = true;
+					}
+				}
+			}
+			assert( Found );
+
+			common::MustDeleteFile(FileName);
+		}
+		common::MustDeleteDirectory(Root);
+		WriteLine(_T("FileWatcher test succeeded."));
+	}
+
+	{
+		std::vector<tstring> Paths;
+		for (uint i = 0; i < 20; i++)
+		{
+			Paths.push_back(_T("HashFile") + UintToStrR(i));
+			common::SaveStringToFile(Paths.back(), string(i * 100, 'a' + i));
+			// Old enough to be cached
+			common::MustUpdateFileTime(Paths.back(), common::DATETIME(1000000000), common::DATETIME(1000000000));
+		}
+
+		common::FileHashCache Cache;
+		std::vector<common::MD5_SUM> Hashes1, Hashes2;
+		Cache.GetHashes(&Hashes1, Paths);
+		assert( Cache.GetCount() == 20 );
+		common::MD5_SUM Hash;
+		string Data;
+		common::LoadStringFromFile(Paths[7], &Data);
+		common::MD5_Calc::Calc(&Hash, Data.data(), Data.length());
+		assert( Hashes1[7] == Hash );
+
+		common::VectorStream Stream;
+		Cache.SaveToStream(&Stream);
+		Stream.Rewind();
+		common::FileHashCache Cache2;
+		bool Loaded = Cache2.LoadFromStream(&Stream);
+		assert( Loaded && Cache2.GetCount() == 20 );
+		Cache2.GetHashes(&Hashes2, Paths);
+		uint64 HitCount, MissCount;
+		Cache2.GetStats(&HitCount, &MissCount);
+		assert( HitCount == 20 && MissCount == 0 && Hashes2 == Hashes1 );
+
+		// Changed size must be noticed
+		common::SaveStringToFile(Paths[3], "Changed");
+		common::MustUpdateFileTime(Paths[3], common::DATETIME(1000000000), common::DATETIME(1000000000));
+		Cache2.GetHash(&Hash, Paths[3]);
+		assert( Hash != Hashes1[3] );
+
+		// Damaged data is ignored
+		Stream.SetPos(10);
+		Stream.WriteEx((uint8)0xFF);
+		Stream.Rewind();
+		Loaded = Cache2.LoadFromStream(&Stream);
+		assert( !Loaded && Cache2.GetCount() == 0 );
+
+		for (uint i = 0; i < 20; i++)
+			common::MustDeleteFile(Paths[i]);
+		WriteLine(_T("FileHashCache test succeeded."));
+	}
+
+	// Unicode text files
+	{
+		// Polish letters and a character outside BMP
+		const wchar_t *Text = L"Za\x17C\xF3\x142\x107 g\x119\x15Bl\x105 ja\x17A\x144 \x263A\r\n";
+		wstring W = Text;
+		if (sizeof(wchar_t) == 2)
+		{
+			W += (wchar_t)0xD83D;
+			W += (wchar_t)0xDE00;
+		}
+		else
+			W += (wchar_t)0x1F600;
+
+		const unsigned ENCODINGS[] = {
+			common::FILE_ENCODING_UTF8, common::FILE_ENCODING_UTF16_LE, common::FILE_ENCODING_UTF16_BE,
+			common::FILE_ENCODING_UTF32_LE, common::FILE_ENCODING_UTF32_BE };
+		for (uint i = 0; i < 5; i++)
+		{
+			common::VectorStream Stream;
+			common::SaveUnicodeToStream(&Stream, W, ENCODINGS[i] | common::FILE_ENCODING_FORCE_BOM);
+
+			wstring Loaded;
+			common::FILE_ENCODING Detected;
+			Stream.Rewind();
+			common::LoadUnicodeFromStream(&Stream, &Loaded, common::FILE_ENCODING_AUTODETECT, &Detected);
+			assert( Loaded == W && Detected == ENCODINGS[i] );
+
+			Stream.Rewind();
+			common::LoadUnicodeFromStream(&Stream, &Loaded, ENCODINGS[i]);
+			assert( Loaded == W );
+		}
+
+		// Invalid UTF-8 reports offset of the bad byte
+		const char BadUtf8[] = "abc\xE0\x80\x80";
+		size_t ErrorOffset;
+		wstring Out;
+		bool Ok = common::Utf8ToWstring(&Out, BadUtf8, 6, &ErrorOffset);
+		assert( !Ok && ErrorOffset == 3 && Out.empty() );
+
+		// ... but autodetected UTF-8 falls back to ANSI
+		common::MemoryStream BadStream(6, (void*)BadUtf8);
+		common::FILE_ENCODING Detected;
+		common::LoadUnicodeFromStream(&BadStream, &Out, common::FILE_ENCODING_AUTODETECT, &Detected);
+		assert( Detected == common::FILE_ENCODING_ANSI && Out.length() == 6 );
+
+		WriteLine(_T("Unicode text files test succeeded."));
+	}
+
+	// Atomic save
+	{
+		common::MustCreateDirectory(_T("AtomicDir"));
+		common::SaveStringToFile(_T("AtomicDir/A.txt"), "Old");
+		common::SaveStringToFileAtomic(_T("AtomicDir/A.txt"), "New");
+		string S;
+		common::LoadStringFromFile(_T("AtomicDir/A.txt"), &S);
+		assert( S == "New" );
+
+		// Committed stream replaces the content, also when written past the internal buffer
+		tstring TempFileName;
+		const string LongData = string(100000, 'L') + "End";
+		{
+			common::AtomicFileStream File(_T("AtomicDir/A.txt"));
+			TempFileName = File.GetTempFileName();
+			File.WriteStringF(string("Begin"));
+			File.WriteStringF(LongData);
+			File.Commit();
+		}
+		common::LoadStringFromFile(_T("AtomicDir/A.txt"), &S);
+		assert( S == "Begin" + LongData );
+		assert( common::GetFileItemType(TempFileName) == common::IT_NONE );
+		common::SaveStringToFileAtomic(_T("AtomicDir/A.txt"), "New");
+
+		// Not committed stream leaves the file untouched and deletes its temporary file
+		{
+			common::AtomicFileStream File(_T("AtomicDir/A.txt"));
+			File.WriteStringF(string("Partial"));
+			File.WriteStringF(LongData);
+			TempFileName = File.GetTempFileName();
+			assert( common::GetFileItemType(TempFileName) == common::IT_FILE );
+		}
+		common::LoadStringFromFile(_T("AtomicDir/A.txt"), &S);
+		assert( S == "New" );
+		assert( common::GetFileItemType(TempFileName) == common::IT_NONE );
+
+		// Batch - Rollback and destruction without Commit leave the file untouched
+		{
+			common::AtomicFileBatch Batch;
+			Batch.SaveString(_T("AtomicDir/A.txt"), "Batch 1");
+			Batch.SaveString(_T("AtomicDir/B.txt"), "Batch 1");
+			Batch.Rollback();
+			assert( Batch.GetCount() == 0 );
+			Batch.SaveString(_T("AtomicDir/A.txt"), "Batch 2");
+		}
+		common::LoadStringFromFile(_T("AtomicDir/A.txt"), &S);
+		assert( S == "New" );
+		assert( common::GetFileItemType(_T("AtomicDir/B.txt")) == common::IT_NONE );
+		{
+			common::AtomicFileBatch Batch;
+			Batch.SaveString(_T("AtomicDir/A.txt"), "Batch 3");
+			Batch.Commit();
+		}
+		common::LoadStringFromFile(_T("AtomicDir/A.txt"), &S);
+		assert( S == "Batch 3" );
+
+		// No temporary file is left behind
+		{
+			common::DirLister Lister(_T("AtomicDir"));
+			tstring Name;
+			common::FILE_ITEM_TYPE Type;
+			uint FileCount = 0;
+			while (Lister.ReadNext(&Name, &Type))
+			{
+				if (Type == common::IT_FILE)
+				{
+					assert( Name == _T("A.txt") );
+					FileCount++;
+				}
+			}
+			assert( FileCount == 1 );
+		}
+		common::SaveStringToFileAtomic(_T("AtomicDir/A.txt"), "New");
+
+		// Benchmark - latency per saved file
+		const uint FILE_COUNT = 100;
+		const string Data(1000, 'A');
+		const tchar * const METHODS[] = {
+			_T("SaveStringToFile"), _T("Atomic, DURABILITY_NONE"), _T("Atomic, DURABILITY_DATA"), _T("Atomic, DURABILITY_FULL"),
+			_T("AtomicFileBatch, DURABILITY_FULL"), _T("AtomicFileBatch, DURABILITY_FULL, FLAG_SYNCFS") };
+		for (uint Method = 0; Method < _countof(METHODS); Method++)
+		{
+			GameTime StartTime = GetCurrentGameTime();
+			{
+				PROFILE_GUARD(g_Profiler, Format(_T("Saving # files - #")) % FILE_COUNT % METHODS[Method]);
+				if (Method < 4)
+				{
+					for (uint i = 0; i < FILE_COUNT; i++)
+					{
+						tstring Path = Format(_T("AtomicDir/File#.dat")) % i;
+						if (Method == 0)
+							common::SaveStringToFile(Path, Data);
+						else
+							common::SaveStringToFileAtomic(Path, Data, (common::FILE_DURABILITY)(Method - 1));
+					}
+				}
+				else
+				{
+					common::AtomicFileBatch Batch(common::FILE_DURABILITY_FULL, Method == 5 ? common::AtomicFileBatch::FLAG_SYNCFS : 0);
+					for (uint i = 0; i < FILE_COUNT; i++)
+						Batch.SaveString(Format(_T("AtomicDir/File#.dat")) % i, Data);
+					assert( Batch.GetCount() == FILE_COUNT );
+					Batch.Commit();
+				}
+			}
+			double Latency = (GetCurrentGameTime() - StartTime).ToSeconds_d() * 1e6 / FILE_COUNT;
+			WriteLine(Format(_T("# - # us per file")) % METHODS[Method] % Latency);
+		}
+
+		for (uint i = 0; i < FILE_COUNT; i++)
+			common::MustDeleteFile(Format(_T("AtomicDir/File#.dat")) % i);
+		common::MustDeleteFile(_T("AtomicDir/A.txt"));
+		common::MustDeleteDirectory(_T("AtomicDir"));
+		WriteLine(_T("Atomic save test succeeded."));
+	}
+
+	// Batched metadata queries
+	{
+		common::MustCreateDirectory(_T("InfoDir"));
+		std::vector<tstring> Paths;
+		for (uint i = 0; i < 1000; i++)
+		{
+			Paths.push_back(Format(_T("InfoDir/File#.txt")) % i);
+			common::SaveStringToFile(Paths.back(), string(i % 10, 'A'));
+		}
+		Paths.push_back(_T("InfoDir"));
+		Paths.push_back(_T("InfoDir/NonExisting.txt"));
+
+		std::vector<common::FILE_ITEM_INFO> Infos;
+		{
+			PROFILE_GUARD(g_Profiler, _T("GetFileItemInfos - 1002 paths"));
+			common::GetFileItemInfos(&Infos, Paths, common::FILE_INFO_SIZE | common::FILE_INFO_MODIFICATION_TIME);
+		}
+		assert( Infos.size() == Paths.size() );
+		for (uint i = 0; i < 1000; i++)
+		{
+			uint64 Size;
+			common::DATETIME ModificationTime;
+			common::MustGetFileItemInfo(Paths[i], NULL, &Size, &ModificationTime);
+			assert( Infos[i].Type == common::IT_FILE && Infos[i].Size == Size );
+			assert( Infos[i].ModificationTime.ToDatetime().GetTicks() == ModificationTime.GetTicks() );
+		}
+		assert( Infos[1000].Type == common::IT_DIR && Infos[1001].Type == common::IT_NONE );
+
+		for (uint i = 0; i < 1000; i++)
+			common::MustDeleteFile(Paths[i]);
+		common::MustDeleteDirectory(_T("InfoDir"));
+		WriteLine(_T("GetFileItemInfos test succeeded."));
+	}
+
+	// File content cache
+	{
+		// Old modification time, so that files are not too fresh to be cached
+		const common::DATETIME OldTime = common::DATETIME(1000000000);
+		common::MustCreateDirectory(_T("CacheDir"));
+		for (uint i = 0; i < 10; i++)
+		{
+			tstring Path = Format(_T("CacheDir/File#.txt")) % i;
+			common::SaveStringToFile(Path, string(1000, (char)('A' + i)));
+			common::MustUpdateFileTime(Path, OldTime, OldTime);
+		}
+
+		common::FileCache Cache(5000, 10000);
+		common::FileContent First, Second;
+		Cache.Get(&First, _T("CacheDir/File0.txt"));
+		Cache.Get(&Second, _T("CacheDir/File0.txt"));
+		assert( First.GetSize() == 1000 && First.GetData()[0] == 'A' && !First.IsMapped() );
+		// The same buffer is shared
+		assert( Second.GetData() == First.GetData() );
+
+		// Changed file is loaded again, old content stays valid
+		common::SaveStringToFile(_T("CacheDir/File0.txt"), "Changed");
+		common::MustUpdateFileTime(_T("CacheDir/File0.txt"), OldTime, OldTime);
+		Cache.Get(&Second, _T("CacheDir/File0.txt"));
+		assert( Second.GetSize() == 7 && First.GetData()[0] == 'A' );
+
+		// Least recently used files are evicted to fit in the budget
+		for (uint i = 1; i < 10; i++)
+		{
+			common::FileContent Content;
+			Cache.Get(&Content, Format(_T("CacheDir/File#.txt")) % i);
+		}
+		assert( Cache.GetUsedBytes() <= 5000 && Cache.GetCount() == 5 );
+
+		// Large files are memory-mapped
+		common::FileCache MappingCache(common::FileCache::DEFAULT_BUDGET, 500);
+		common::FileContent Mapped;
+		MappingCache.Get(&Mapped, _T("CacheDir/File9.txt"));
+		assert( Mapped.IsMapped() && Mapped.GetSize() == 1000 && Mapped.GetData()[999] == 'J' );
+
+		uint64 HitCount, MissCount;
+		Cache.GetStats(&HitCount, &MissCount);
+		assert( HitCount == 1 && MissCount == 11 );
+
+		for (uint i = 0; i < 10; i++)
+			common::MustDeleteFile(Format(_T("CacheDir/File#.txt")) % i);
+		common::MustDeleteDirectory(_T("CacheDir"));
+		WriteLine(_T("FileCache test succeeded."));
+	}
+}
+
+void TestDateTime()
+{
+	WriteLine(_T("==================== DATETIME ===================="));
+
+	{
+		tcout << _T("Time measurement:") << endl;
+		tcout << _T("  Current time = ") << GetCurrentGameTime().ToSeconds_d() << endl;
+		tcout << _T("  Waiting 0.1 s...") << endl;
+		Wait(100);
+		tcout << _T("  Current time = ") << GetCurrentGameTime().ToSeconds_d() << endl;
+	}
+
+	tstring s, s1, s2;
+
+	common::DATETIME dtnow = common::Now();
+	common::TMSTRUCT tmnow = common::TMSTRUCT(dtnow);
+	WriteLine(Format(_T("Now  = # = #")) % dtnow % tmnow);
+
+	common::DATETIME dtunow = common::UNow();
+	common::TMSTRUCT tmunow = common::TMSTRUCT(dtunow);
+	WriteLine(Format(_T("UNow = # = #")) % dtunow % tmunow);
+
+	common::DateToStr(&s, tmunow, _T("wu, d Nf y h:m:s:i"));
+	WriteLine(Format(_T("UNow (własny format) = #")) % s);
+
+	common::TMSTRUCT tmunow2;
+	assert( common::StrToDate(&tmunow2, s, _T("wu, d Nf y h:m:s:i")) );
+	WriteLine(Format(_T("tstring > TMSTRUCT = #")) % tmunow2);
+
+	common::DATETIME dtunow2(tmunow2);
+	WriteLine(Format(_T("TMSTRUCT > DATETIME = #")) % dtunow2);
+
+	common::TIMESPAN ts = common::TIMESPAN::Hour() + common::TIMESPAN::Minutes(15);
+	ts.ToString(&s1, true);
+	ts.ToString_Nice(&s2);
+	WriteLine(Format(_T("TIMESPAN: # = # = #")) % ts % s1 % s2);
+
+	common::DATETIME dt_plus_ts = dtnow - ts;
+	common::TMSTRUCT dt_plus_ts_tm(dt_plus_ts);
+	WriteLine(Format(_T("Now - TIMESPAN = #, dzień tygodnia: #")) % dt_plus_ts_tm % common::GetWeekDayName(dt_plus_ts_tm.GetWeekDay(), common::NAME_LONG_LOWERCASE));
+
+	common::DATESPAN ds(0, 0, 0, 15);
+	common::TMSTRUCT tm_plus_ds = tmnow - ds;
+	WriteLine(Format(_T("Now - DATESPAN(15 dni) = #, dzień tygodnia: #")) % tm_plus_ds % common::GetWeekDayName(tm_plus_ds.GetWeekDay(), common::NAME_LONG_LOWERCASE));
+
+	common::TMSTRUCT tm_custom(28, common::OCT, 2007, 13, 14, 15, 16);
+	WriteLine(Format(_T("Własna data = #, WeekDay=#")) % tm_custom % common::GetWeekDayName(tm_custom.GetWeekDay(), common::NAME_SHORT_LOWERCASE));
+	//WriteLine(Format(_T("Własna data = #, WeekDay=#, DayOfYear=#, WeekOfYear=#, WeekOfMonth=#")) %
+	//	tm_custom % common::GetWeekDayName(tm_custom.GetWeekDay(), common::NAME_SHORT_LOWERCASE) %
+	//	tm_custom.GetDayOfYear() % tm_custom.GetWeekOfYear() % tm_custom.GetWeekOfMonth());
+}
+
+void TestCmdLineParser()
+{
+	WriteLine(_T("==================== CMD LINE PARSER ===================="));
+
+	const tchar * CMD_LINE = _T("-a -b -c param -abc=\"param\" \"-cparam\" /AA --AA \"/BBB\"=param DUPA --BBB \"param\"");
+	CmdLineParser Parser(CMD_LINE);
+	Parser.RegisterOpt(1, _T('a'), false);
+	Parser.RegisterOpt(2, _T('b'), false);
+	Parser.RegisterOpt(3, _T('c'), true);
+	Parser.RegisterOpt(11, _T("AA"), false);
+	Parser.RegisterOpt(12, _T("BBB"), true);
+
+	int Id; tstring Param, RS;
+	CmdLineParser::RESULT R;
+	do
+	{
+		R = Parser.ReadNext();
+		Id = Parser.GetOptId();
+		Param = Parser.GetParameter();
+		switch (R)
+		{
+		case CmdLineParser::RESULT_END:       RS = _T("RESULT_END      "); break;
+		case CmdLineParser::RESULT_OPT:       RS = _T("RESULT_OPT      "); break;
+		case CmdLineParser::RESULT_ERROR:     RS = _T("RESULT_ERROR    "); break;
+		case CmdLineParser::RESULT_PARAMETER: RS = _T("RESULT_PARAMETER"); break;
+		}
+		WriteLine(Format(_T("Opt: Result=#, Id=#, Param=#")) % RS % Id % Param);
+	} while (R != CmdLineParser::RESULT_END && R != CmdLineParser::RESULT_ERROR);
+}
+
+// Tokenizer working on a buffer must give the same tokens and positions as the one reading a stream
+void CompareBufferAndStreamTokenizer(const tstring &doc)
+{
+	Tokenizer bufTok(doc.data(), doc.length(), Tokenizer::FLAG_MULTILINE_STRINGS);
+	MemoryStream docStream(doc.length() * sizeof(tchar), const_cast<tchar*>(doc.data()));
+	Tokenizer streamTok(&docStream, Tokenizer::FLAG_MULTILINE_STRINGS);
+	do
+	{
+		bufTok.Next();
+		streamTok.Next();
+		assert(bufTok.GetToken() == streamTok.GetToken());
+		assert(tstring(bufTok.GetStringPtr(), bufTok.GetStringLength()) == streamTok.GetString());
+		assert(bufTok.GetCharNum() == streamTok.GetCharNum() && bufTok.GetRowNum() == streamTok.GetRowNum() && bufTok.GetColNum() == streamTok.GetColNum());
+	} while (!bufTok.QueryEOF());
+}
+
+void TestTokenizer()
+{
+	WriteLine(_T("==================== TOKENIZER ===================="));
+	string FileS;
+	LoadStringFromFile(_T("Tokens.dat"), &FileS);
+	tstring File = StringToTstringR(FileS);
+	Tokenizer tokenizer(&File, Tokenizer::FLAG_MULTILINE_STRINGS);
+
+	const tchar *KEYWORDS[] = { _T("false"), _T("true") };
+	tokenizer.RegisterKeywords(KEYWORDS, 2);
+
+	Tokenizer::TOKEN t;
+	tstring s;
+	size_t hn, rn, cn;
+	do
+	{
+		tokenizer.Next();
+
+		t = tokenizer.GetToken();
+		hn = tokenizer.GetCharNum();
+		rn = tokenizer.GetRowNum();
+		cn = tokenizer.GetColNum();
+		s  = tokenizer.GetString();
+
+		WriteLine(Format(_T("Token: char=#, row=#, col=#, type=#, tstring=#")) % hn % rn % cn % tokenizer.GetTokenName(t) % s);
+
+		if (t == Tokenizer::TOKEN_INTEGER)
+			WriteLine(Format(_T("  value=#")) % tokenizer.MustGetInt4());
+		else if (t == Tokenizer::TOKEN_FLOAT)
+			WriteLine(Format(_T("  value=#")) % tokenizer.MustGetFloat());
+
+	} while (t != Tokenizer::TOKEN_EOF);
+
+	// Buffer and stream input must give the same tokens; buffer tokens point into the document
+	{
+		Tokenizer bufTok(File.data(), File.length(), Tokenizer::FLAG_MULTILINE_STRINGS);
+		MemoryStream fileStream(File.length() * sizeof(tchar), const_cast<tchar*>(File.data()));
+		Tokenizer streamTok(&fileStream, Tokenizer::FLAG_MULTILINE_STRINGS);
+		size_t viewCount = 0;
+		do
+		{
+			bufTok.Next();
+			streamTok.Next();
+			assert(bufTok.GetToken() == streamTok.GetToken());
+			assert(bufTok.GetCharNum() == streamTok.GetCharNum() && bufTok.GetRowNum() == streamTok.GetRowNum() && bufTok.GetColNum() == streamTok.GetColNum());
+			assert(tstring(bufTok.GetStringPtr(), bufTok.GetStringLength()) == streamTok.GetString());
+			if (bufTok.GetStringPtr() >= File.data() && bufTok.GetStringPtr() < File.data() + File.length())
+				viewCount++;
+		} while (!bufTok.QueryEOF());
+		WriteLine(Format(_T("Tokens without copy: #")) % viewCount);
+	}
+
+	{
+		// Runs longer than a 16-character block, escapes and "\\\r\n" at every offset relative to block edges
+		for (size_t shift = 0; shift <= 16; shift++)
+		{
+			tstring doc(shift, _T(' '));
+			doc += _T("identifier_longer_than_sixteen_characters\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t=                    12345;\r\n");
+			doc += _T("\"string longer than sixteen characters \\\" with \\\\ escapes \\n and \\t \\x41\"\n");
+			doc += _T("\"line continued \\\r\n in string\" \\\r\n\r");
+			doc += _T("/* comment longer than sixteen characters\r\n\\\r\nsecond line\n\r\n\r */ ");
+			doc += _T("// single line comment longer than sixteen \\ \r\n");
+			doc += _T("\"multiline\r\nstring\n\rwith mixed\r\r\n line ends\" x\n\n\n\r\n\r\n y\r\r\r\n\n\r\r");
+			doc += tstring(40, _T('\n')) + tstring(40, _T('\r')) + _T("z ") + tstring(shift, _T('a')) + _T(" /* \\\r\n\\\r\\\r\n */");
+			// Lone '\r' after '\\' doesn't end the line, so the column of the next token depends on it
+			for (size_t pad = 0; pad <= 16; pad++)
+				doc += _T("/*") + tstring(pad, _T(' ')) + _T("\\\r") + tstring(16, _T(' ')) + _T("*/ azAZ09_identifier_with_range_edges_azAZ09_\n");
+			CompareBufferAndStreamTokenizer(doc);
+		}
+	}
+
+	// Benchmark - grammar with 200 keywords, compared to lookup in std::map
+	{
+		const uint KEYWORD_COUNT = 200, TOKEN_COUNT = 1000000;
+		STRING_VECTOR keywords;
+		std::map<tstring, uint> keywordMap;
+		for (uint i = 0; i < KEYWORD_COUNT; i++)
+		{
+			keywords.push_back(Format(_T("keyword_#")) % i);
+			keywordMap[keywords.back()] = i;
+		}
+		tstring doc;
+		for (uint i = 0; i < TOKEN_COUNT; i++)
+		{
+			if (i % 4 == 3)
+				doc += Format(_T("ident_# ")) % i;
+			else
+				doc += keywords[i * 7 % KEYWORD_COUNT] + _T(' ');
+		}
+
+		Tokenizer kwTok(&doc, 0);
+		for (uint i = 0; i < KEYWORD_COUNT; i++)
+			kwTok.RegisterKeyword(i, keywords[i]);
+		kwTok.FinalizeKeywords();
+		uint keywordCount = 0, mapKeywordCount = 0;
+		GameTime startTime = GetCurrentGameTime();
+		{
+			PROFILE_GUARD(g_Profiler, _T("Tokenizer with 200 keywords"));
+			for (kwTok.Next(); !kwTok.QueryEOF(); kwTok.Next())
+			{
+				if (kwTok.GetToken() == Tokenizer::TOKEN_KEYWORD)
+				{
+					assert(keywords[kwTok.GetId()] == kwTok.GetString());
+					keywordCount++;
+				}
+			}
+		}
+		double hashTime = (GetCurrentGameTime() - startTime).ToSeconds_d();
+
+		Tokenizer idTok(&doc, 0);
+		startTime = GetCurrentGameTime();
+		{
+			PROFILE_GUARD(g_Profiler, _T("Tokenizer with 200 keywords in std::map"));
+			for (idTok.Next(); !idTok.QueryEOF(); idTok.Next())
+			{
+				if (keywordMap.find(idTok.GetString()) != keywordMap.end())
+					mapKeywordCount++;
+			}
+		}
+		double mapTime = (GetCurrentGameTime() - startTime).ToSeconds_d();
+		assert(keywordCount == TOKEN_COUNT / 4 * 3 && mapKeywordCount == keywordCount);
+		WriteLine(Format(_T("200 keywords: # ns per token, with std::map: # ns per token")) % (hashTime * 1e9 / TOKEN_COUNT) % (mapTime * 1e9 / TOKEN_COUNT));
+	}
+
+	const tchar * const TEXT_TO_ESCAPE = _T("abcd tab:\t vtab:\v eol:\r\n quot:\" apos:\' strange=\xE0 _");
+	tstring Escaped;
+	TokenWriter::Escape(&Escaped, TEXT_TO_ESCAPE, TokenWriter::ESCAPE_EOL | TokenWriter::ESCAPE_OTHER);
+	WriteLine(_T("Text to escape : ") + tstring(TEXT_TO_ESCAPE));
+	WriteLine(_T("Escaped text   : ") + Escaped);
+}
+
+scoped_ptr<Mutex> g_Mutex;
+
+void WriteLineMT(const tstring &s)
+{
+	MUTEX_LOCK(*g_Mutex.get());
+	WriteLine(s);
+}
+
+class MyThread : public Thread
+{
+private:
+	tstring m_Id;
+
+protected:
+	virtual void Run();
+
+public:
+	MyThread(const tstring &Id) : m_Id(Id) { }
+};
+
+void MyThread::Run()
+{
+	WriteLineMT(Format(_T("Thread #: Begin")) % m_Id);
+	for (uint i = 0; i < 3; i++)
+	{
+		{
+			MUTEX_LOCK(*g_Mutex.get());
+			{
+				MUTEX_LOCK(*g_Mutex.get());
+
+				Wait(g_Rand.RandUint(100, 200));
+				WriteLineMT(Format(_T("Thread #: Iter=#")) % m_Id % i);
+			}
+		}
+		//Yield_();
+	}
+	WriteLineMT(Format(_T("Thread #: End")) % m_Id);
+}
+
+class ProducerConsumerBuffer
+{
+private:
+	Semaphore m_ElementCount;
+	Semaphore m_EmptyCount;
+	std::queue<char> m_Queue;
+
+public:
+	ProducerConsumerBuffer();
+	void Push(char Ch);
+	char Pop();
+};
+
+ProducerConsumerBuffer::ProducerConsumerBuffer() :
+	m_ElementCount(0),
+	m_EmptyCount(3)
+{
+}
+
+void ProducerConsumerBuffer::Push(char Ch)
+{
+	m_EmptyCount.P();
+
+	{
+		MUTEX_LOCK(*g_Mutex.get());
+		m_Queue.push(Ch);
+	}
+
+	m_ElementCount.V();
+}
+
+char ProducerConsumerBuffer::Pop()
+{
+	char R;
+
+	m_ElementCount.P();
+
+	{
+		MUTEX_LOCK(*g_Mutex.get());
+		R = m_Queue.front();
+		m_Queue.pop();
+	}
+
+	m_EmptyCount.V();
+
+	return R;
+}
+
+class ProducerThread : public Thread
+{
+private:
+	ProducerConsumerBuffer *m_Buffer;
+
+protected:
+	virtual void Run();
+
+public:
+	ProducerThread(ProducerConsumerBuffer *Buffer) : m_Buffer(Buffer) { }
+};
+
+void ProducerThread::Run()
+{
+	WriteLineMT(_T("Producer: Producing 5 chars..."));
+	for (uint i = 0; i < 5; i++)
+	{
+		char Ch = (char)(i+_T('A'));
+		m_Buffer->Push(Ch);
+		WriteLineMT(_T("Producer: Produced char: ") + CharToStrR(Ch));
+	}
+
+	m_Buffer->Push(_T('\0'));
+}
+
+class ConsumerThread : public Thread
+{
+private:
+	ProducerConsumerBuffer *m_Buffer;
+
+protected:
+	virtual void Run();
+
+public:
+	ConsumerThread(ProducerConsumerBuffer *Buffer) : m_Buffer(Buffer) { }
+};
+
+void ConsumerThread::Run()
+{
+    WriteLineMT(_T("Consumer: Waiting 2000 ms..."));
+	Wait(2000);
+
+	char Ch;
+
+	for (;;)
+	{
+		Ch = m_Buffer->Pop();
+		if (Ch == _T('\0')) break;
+		WriteLineMT(_T("Consumer: Consumed char: ") + CharToStrR(Ch));
+		Wait(1000);
+	}
+}
+
+class ProducerConsumerBuffer2
+{
+private:
+	Cond m_BufferNotEmpty;
+	Cond m_BufferNotFull;
+	Mutex m_Mutex;
+	std::queue<char> m_Queue;
+
+public:
+	ProducerConsumerBuffer2();
+	void Push(char Ch);
+	char Pop();
+};
+
+ProducerConsumerBuffer2::ProducerConsumerBuffer2() :
+	m_Mutex(0)
+{
+}
+
+void ProducerConsumerBuffer2::Push(char Ch)
+{
+	MUTEX_LOCK(m_Mutex);
+
+	while (m_Queue.size() == 3)
+		m_BufferNotFull.Wait(&m_Mutex);
+
+	m_Queue.push(Ch);
+
+	m_BufferNotEmpty.Signal();
+}
+
+char ProducerConsumerBuffer2::Pop()
+{
+	MUTEX_LOCK(m_Mutex);
+
+	while (m_Queue.size() == 0)
+		m_BufferNotEmpty.Wait(&m_Mutex);
+
+	char R = m_Queue.front();
+	m_Queue.pop();
+
+	m_BufferNotFull.Signal();
+
+	return R;
+}
+
+class ProducerThread2 : public Thread
+{
+private:
+	ProducerConsumerBuffer2 *m_Buffer;
+
+protected:
+	virtual void Run();
+
+public:
+	ProducerThread2(ProducerConsumerBuffer2 *Buffer) : m_Buffer(Buffer) { }
+};
+
+void ProducerThread2::Run()
+{
+	WriteLineMT(_T("Producer: Producing 5 chars..."));
+	for (uint i = 0; i < 5; i++)
+	{
+		char Ch = (char)(i+_T('A'));
+		m_Buffer->Push(Ch);
+		WriteLineMT(_T("Producer: Produced char: ") + CharToStrR(Ch));
+	}
+
+	m_Buffer->Push(_T('\0'));
+}
+
+class ConsumerThread2 : public Thread
+{
+private:
+	ProducerConsumerBuffer2 *m_Buffer;
+
+protected:
+	virtual void Run();
+
+public:
+	ConsumerThread2(ProducerConsumerBuffer2 *Buffer) : m_Buffer(Buffer) { }
+};
+
+void ConsumerThread2::Run()
+{
+	WriteLineMT(_T("Consumer: Waiting 2000 ms..."));
+	Wait(2000);
+
+	char Ch;
+
+	for (;;)
+	{
+		Ch = m_Buffer->Pop();
+		if (Ch == _T('\0')) break;
+		WriteLineMT(_T("Consumer: Consumed char: ") + CharToStrR(Ch));
+		Wait(1000);
+	}
+}
+
+class WaitingThread : public Thread
+{
+private:
+	tchar m_Id;
+	Barrier *m_Barrier;
+
+protected:
+	virtual void Run();
+
+public:
+	WaitingThread(char Id, Barrier *b) : m_Id(Id), m_Barrier(b) { }
+};
+
+void WaitingThread::Run()
+{
+	for (uint i = 0; i < 5; i++)
+	{
+		uint Time = g_Rand.RandUint(100, 1000);
+		WriteLineMT(Format(_T("WaitingThread # Iter # waiting for # ms before barrier.")) % m_Id % i % Time);
+		Wait(Time);
+		m_Barrier->Wait();
+	}
+}
+
+class CancellableThread : public Thread
+{
+private:
+	Event m_CancelEvent;
+
+protected:
+	virtual void Run();
+
+public:
+	CancellableThread();
+
+	void Cancel();
+};
+
+void CancellableThread::Run()
+{
+	for (uint i = 0; i < 10; i++)
+	{
+		WriteLineMT(Format(_T("CancellableThread: Iter #")) % i);
+		Wait(100);
+		if (m_CancelEvent.Test())
+		{
+			WriteLineMT(_T("CancellableThread: Cancelled"));
+			return;
+		}
+	}
+
+	WriteLineMT(_T("CancellableThread: Done all iters, wainting for cancel..."));
+	m_CancelEvent.Wait();
+	WriteLineMT(_T("CancellableThread: Got cancel."));
+}
+
+CancellableThread::CancellableThread() :
+	m_CancelEvent(false, Event::TYPE_AUTO_RESET)
+{
+}
+
+void CancellableThread::Cancel()
+{
+	m_CancelEvent.Set();
+}
+
+
+void TestThreads()
+{
+	WriteLine(_T("==================== THREADS ===================="));
+
+	g_Mutex.reset(new Mutex(Mutex::FLAG_RECURSIVE));
+    
+    {
+		WriteLine(_T("-------------------- Basic test --------------------"));
+		scoped_ptr<MyThread> Threads[4];
+
+		for (uint i = 0; i < 4; i++)
+			Threads[i].reset(new MyThread(UintToStrR(i)));
+			
+		for (uint i = 0; i < 4; i++)
+			Threads[i]->Start();
+
+		#ifdef _WIN32
+			Threads[0]->SetPriority(Thread::PRIORITY_HIGH);
+			WriteLine(Format(_T("Main: Thread 1 Running: #")) % Threads[0]->IsRunning());
+		#endif
+
+		for (uint i = 0; i < 4; i++)
+			Threads[i]->Join();
+
+		#ifdef _WIN32
+			WriteLine(Format(_T("Main: Thread 1 Running: #")) % Threads[0]->IsRunning());
+		#endif
+	}
+
+	{
+		WriteLine(_T("-------------------- Producer-consumer (semaphore) --------------------"));
+		ProducerConsumerBuffer Buf;
+		ProducerThread Producer(&Buf);
+		ConsumerThread Consumer(&Buf);
+		Producer.Start();
+		Consumer.Start();
+		Producer.Join();
+		Consumer.Join();
+	}
+	
+	{
+		WriteLine(_T("-------------------- Semaphore::TimeoutP --------------------"));
+		WriteLine(_T("Tu ma być czekanie 2 s..."));
+		Semaphore sem(0);
+		sem.TimeoutP(2000);
+		WriteLine(_T("Już."));
+	}
+
+	{
+		WriteLine(_T("-------------------- Producer-consumer 2 (cond) --------------------"));
+		ProducerConsumerBuffer2 Buf;
+		ProducerThread2 Producer(&Buf);
+		ConsumerThread2 Consumer(&Buf);
+		Producer.Start();
+		Consumer.Start();
+		Producer.Join();
+		Consumer.Join();
+	}
+	
+    {
+		WriteLine(_T("-------------------- WaitingThread (barrier) --------------------"));
+		Barrier B(5);
+		scoped_ptr<WaitingThread> Threads[5];
+		for (uint i = 0; i < 5; i++)
+			Threads[i].reset(new WaitingThread((char)(i + _T('0')), &B));
+		for (uint i = 0; i < 5; i++)
+			Threads[i]->Start();
+		for (uint i = 0; i < 5; i++)
+			Threads[i]->Join();
+	}
+
+	
+	{
+		WriteLine(_T("-------------------- CancellableThread (event) --------------------"));
+
+		WriteLine(_T("Test 1: Cancelling before iters finished. Event::Test"));
+		CancellableThread T1;
+		T1.Start();
+		Wait(300);
+		T1.Cancel();
+		T1.Join();
+
+		WriteLine(_T("Test 2: Cancelling after iters finished. Event::Wait"));
+		CancellableThread T2;
+		T2.Start();
+		Wait(1200);
+		T2.Cancel();
+		T2.Join();
+	}
+
+	g_Mutex.reset();
+}
+
+class LoggingThread : public Thread
+{
+private:
+	common::Logger & m_Logger;
+	tstring m_ThreadName;
+
+protected:
+	virtual void Run();
+
+public:
+	LoggingThread(common::Logger & Logger, const tstring &ThreadName) : m_Logger(Logger), m_ThreadName(ThreadName) { }
+
+	void CustomRun() { Run(); }
+};
+
+void LoggingThread::Run()
+{
+	for (int i = 0; i < 10; i++)
+	{
+		m_Logger.Log(1, Format(_T("Message from thread \"#\" number \"#\"")) % m_ThreadName % i);
+	}
+}
+
+void TestLogger()
+{
+	WriteLine(_T("==================== LOGGER ===================="));
+
+	common::CreateLogger(true);
+
+	common::Logger & Logger = common::GetLogger();
+
+	scoped_ptr<common::ILog> HtmlLog(new common::HtmlFileLog(_T("Log.html"), common::FILE_MODE_NORMAL));
+	scoped_ptr<common::ILog> ConsoleLog(new common::OstreamLog(&tcout));
+
+	Logger.AddLogMapping(0xFFFFFFFF, HtmlLog.get());
+	Logger.AddLogMapping(0xFFFFFFFF, ConsoleLog.get());
+
+	Logger.SetPrefixFormat(_T("[%D %T] "));
+
+	LoggingThread Thread1(Logger, _T("Thread1"));
+	LoggingThread Thread2(Logger, _T("Thread2"));
+
+	Thread1.Start();
+	Thread2.Start();
+
+	LoggingThread MainThread(Logger, _T("MainThread"));
+	MainThread.CustomRun();
+
+	Thread2.Join();
+	Thread1.Join();
+
+	common::DestroyLogger();
+
+	ConsoleLog.reset(0);
+	HtmlLog.reset(0);
+}
+
+#ifdef _WIN32
+void TestBstrString()
+{
+	BstrString b1 = "Dupa";
+	BstrString b2 = L"dupA";
+	assert(BstrString::Cmp(b1, b2, true) == 0);
+	BstrString b3 = b1 + b2;
+	BstrString b4 = b3.substr(3, 2);
+	b4 += string("am");
+	assert(b4.length() == 4);
+	cout << "Here should be \"adam\": " << b4.c_str() << endl;
+}
+#endif // #ifdef _WIN32
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+// Test for ObjList
+
+// HPP
+
+class ItemClassStatic
+{
+public:
+	ItemClassStatic();
+	~ItemClassStatic();
+
+	STATIC_OBJLIST_ITEM_METHODS(ListClassStatic, ItemClassStatic, NAME)
+
+private:
+	STATIC_OBJLIST_ITEM_FIELDS(ListClassStatic, ItemClassStatic, NAME)
+};
+
+class ListClassStatic
+{
+public:
+	STATIC_OBJLIST_LIST_METHODS(ListClassStatic, ItemClassStatic, NAME)
+
+private:
+	STATIC_OBJLIST_LIST_FIELDS(ListClassStatic, ItemClassStatic, NAME)
+};
+
+class ListClass;
+
+class ItemClass
+{
+public:
+	ItemClass();
+	~ItemClass();
+
+	OBJLIST_ITEM_METHODS(ListClass, ItemClass, NAME)
+
+private:
+	OBJLIST_ITEM_FIELDS(ListClass, ItemClass, NAME)
+};
+
+class ListClass
+{
+public:
+	ListClass();
+	~ListClass();
+
+	OBJLIST_LIST_METHODS(ListClass, ItemClass,NAME)
+
+private:
+	OBJLIST_LIST_FIELDS(ListClass, ItemClass, NAME)
+};
+
+// CPP
+
+ItemClassStatic::ItemClassStatic()
+{
+	STATIC_OBJLIST_ITEM_CTOR(ListClassStatic, ItemClassStatic, NAME);
+}
+
+ItemClassStatic::~ItemClassStatic()
+{
+	STATIC_OBJLIST_ITEM_DTOR(ListClassStatic, ItemClassStatic, NAME);
+}
+
+STATIC_OBJLIST_LIST_IMPL(ListClassStatic, ItemClassStatic, NAME)
+
+ItemClass::ItemClass()
+{
+	OBJLIST_ITEM_CTOR(ListClass, ItemClass, NAME)
+}
+
+ItemClass::~ItemClass()
+{
+	OBJLIST_ITEM_DTOR(ListClass, ItemClass, NAME)
+}
+
+OBJLIST_LIST_IMPL(ListClass, ItemClass, NAME)
+
+ListClass::ListClass()
+{
+	OBJLIST_LIST_CTOR(ListClass, ItemClass, NAME)
+}
+
+ListClass::~ListClass()
+{
+	OBJLIST_LIST_DTOR(ListClass, ItemClass, NAME)
+}
+
+void TestObjListStatic()
+{
+	ItemClassStatic i1, i2, i3;
+	ListClassStatic::NAME_InsertBack(&i1);
+	ListClassStatic::NAME_InsertBack(&i2);
+	ListClassStatic::NAME_InsertBack(&i3);
+	assert(ListClassStatic::NAME_GetItemCount() == 3);
+	uint count = 0;
+	for (ItemClassStatic *i = ListClassStatic::NAME_GetFirst(); i != NULL; i = i->NAME_GetNext())
+	{
+		switch (count)
+		{
+		case 0: assert(i == &i1); break;
+		case 1: assert(i == &i2); break;
+		case 2: assert(i == &i3); break;
+		}
+		count++;
+	}
+	assert(count == 3);
+	ListClassStatic::NAME_Remove(&i2);
+	ListClassStatic::NAME_Remove(&i1);
+	assert(ListClassStatic::NAME_GetItemCount() == 1);
+	ListClassStatic::NAME_Clear();
+	assert(ListClassStatic::NAME_GetItemCount() == 0);
+	assert(i1.NAME_IsOnList() == false);
+	assert(i2.NAME_IsOnList() == false);
+	assert(i3.NAME_IsOnList() == false);
+}
+
+void TestObjListNormal()
+{
+	ListClass myList;
+	ItemClass i1, i2, i3;
+	myList.NAME_InsertBack(&i1);
+	myList.NAME_InsertBack(&i2);
+	myList.NAME_InsertBack(&i3);
+	assert(myList.NAME_GetItemCount() == 3);
+	uint count = 0;
+	for (ItemClass *i = myList.NAME_GetFirst(); i != NULL; i = i->NAME_GetNext())
+	{
+		switch (count)
+		{
+		case 0: assert(i == &i1); break;
+		case 1: assert(i == &i2); break;
+		case 2: assert(i == &i3); break;
+		}
+		count++;
+	}
+	assert(count == 3);
+	myList.NAME_Remove(&i2);
+	myList.NAME_Remove(&i1);
+	assert(myList.NAME_GetItemCount() == 1);
+	myList.NAME_Clear();
+	assert(myList.NAME_GetItemCount() == 0);
+	assert(i1.NAME_IsOnList() == false);
+	assert(i2.NAME_IsOnList() == false);
+	assert(i3.NAME_IsOnList() == false);
+}
+
+void TestObjList()
+{
+	WriteLine(_T("==================== OBJ LIST ===================="));
+	
+	TestObjListStatic();
+	TestObjListNormal();
+}
+
+void TestTokDoc()
+{
+	WriteLine(_T("==================== TOK DOC ===================="));
+
+	using namespace tokdoc;
+
+	const int intVal = 1;
+	const float floatVal = 1.f;
+	const VEC4 vectorVal = VEC4(1.f, 2.f, 3.f, 4.f);
+	tstring stringVal = _T("String 1");
+	const int arr[] = { 1, 2, 3, 4 };
+
+	tstring docStr;
+
+	{
+		Node doc;
+		
+		{
+			Node config;
+			SubnodeFrom(config, _T("int8"), intVal);
+			SubnodeFrom(config, _T("float1"), floatVal);
+			SubnodeFrom(config, _T("vector1"), vectorVal);
+			SubnodeFrom(config, _T("string1"), stringVal);
+			
+			{
+				Node vecNode;
+				NodeFromVector(vecNode, std::vector<int>(arr, arr+_countof(arr)));
+				vecNode.Name = _T("stdvector1");
+				config.InsertChildAtEnd(vecNode);
+			}
+
+			config.LinkChildAtBegin(new Node(_T("LonelyVal")));
+
+			Node *docConfigNode = new Node();
+			doc.LinkChildAtEnd(docConfigNode);
+			docConfigNode->CopyFrom(config);
+			docConfigNode->Name = _T("Config");
+		}
+
+		{
+			TokenWriter tok(&docStr);
+			tok.RegisterSymbol(_T('{'), true, true, 1);
+			tok.RegisterSymbol(_T('}'), true, true, -1);
+			tok.RegisterSymbol(_T('='), true, true, 0);
+			tok.RegisterSymbol(_T(','), false, true, 0);
+			tok.RegisterSymbol(_T(';'), false, true, 0);
+			doc.SaveChildren(tok);
+		}
+	}
+
+	WriteLine(docStr);
+
+	{
+		Node doc;
+
+		{
+			Tokenizer tok(&docStr, Tokenizer::FLAG_MULTILINE_STRINGS);
+			tok.Next();
+			doc.LoadChildren(tok);
+		}
+
+		Node &configNode = doc.MustFindFirstChild(_T("Config"));
+
+		int intTmp;
+		SubnodeTo(intTmp, configNode, _T("int8"), SUBNODE_REQUIRED);
+		assert(intTmp == intVal);
+
+		float floatTmp;
+		SubnodeTo(floatTmp, configNode, _T("float1"), SUBNODE_REQUIRED);
+		assert(floatTmp == floatVal);
+
+		VEC4 vectorTmp;
+		SubnodeTo(vectorTmp, configNode, _T("vector1"), SUBNODE_REQUIRED);
+		assert(vectorTmp == vectorVal);
+
+		tstring stringTmp;
+		SubnodeTo(stringTmp, configNode, _T("string1"), SUBNODE_REQUIRED);
+		assert(stringTmp == stringVal);
+
+		std::vector<int> stdVectorTmp;
+		Node &vectorNode = configNode.MustFindFirstChild(_T("stdvector1"));
+		NodeToVector(stdVectorTmp, vectorNode, true);
+		assert(stdVectorTmp == std::vector<int>(arr, arr+_countof(arr)));
+
+		assert(configNode.GetFirstChild() && configNode.GetFirstChild()->Name == EMPTY_STRING);
+	}
+
+	{
+		Document doc;
+
+		{
+			Tokenizer tok(&docStr, Tokenizer::FLAG_MULTILINE_STRINGS);
+			tok.Next();
+			doc.Load(tok);
+		}
+
+		Node &configNode = doc.GetRoot().MustFindFirstChild(_T("Config"));
+		assert(configNode.GetDocument() == &doc);
+
+		tstring stringTmp;
+		SubnodeTo(stringTmp, configNode, _T("string1"), SUBNODE_REQUIRED);
+		assert(stringTmp == stringVal);
+
+		// New nodes go to the same document, copies outside it are standalone
+		SubnodeFrom(configNode, _T("string2"), tstring(_T("Value long enough to be stored in the arena")));
+		assert(configNode.MustFindFirstChild(_T("string2")).GetDocument() == &doc);
+		Node configCopy(configNode);
+		assert(configCopy.GetDocument() == NULL);
+		assert(configCopy.MustFindFirstChild(_T("string2")).Value == _T("Value long enough to be stored in the arena"));
+
+		tstring savedStr;
+		{
+			TokenWriter tok(&savedStr);
+			doc.Save(tok);
+		}
+		assert(savedStr.find(_T("string2")) != tstring::npos);
+
+		doc.GetRoot().Name = _T("Root name long enough to be stored in the arena");
+		doc.Clear();
+		assert(!doc.GetRoot().HasChildren() && configCopy.HasChildren());
+		// Root name doesn't point to the freed memory
+		assert(doc.GetRoot().Name.empty() && doc.GetRoot().Name.c_str()[0] == _T('\0'));
+
+		doc.GetRoot().Name = _T("Root name long enough to be stored in the arena");
+		{
+			Tokenizer tok(&savedStr, Tokenizer::FLAG_MULTILINE_STRINGS);
+			tok.Next();
+			doc.Load(tok);
+		}
+		assert(doc.GetRoot().Name.c_str()[0] == _T('\0') && doc.GetRoot().FindFirstChild(_T("Config")) != NULL);
+	}
+
+	// Node with many children - lookups by name build an index
+	{
+		Node wideNode;
+		for (uint i = 0; i < 1000; i++)
+			wideNode.LinkChildAtEnd(new Node(_T("Item") + UintToStrR(i % 100), UintToStrR(i)));
+
+		assert(wideNode.FindFirstChild(_T("Item99"))->Value == _T("99"));
+		assert(wideNode.FindLastChild(_T("Item99"))->Value == _T("999"));
+		assert(wideNode.CalcChildCount(_T("Item5")) == 10);
+
+		Node *renamedNode = wideNode.FindFirstChild(_T("Item5"));
+		renamedNode->Name = _T("Renamed");
+		assert(wideNode.FindFirstChild(_T("Renamed")) == renamedNode);
+		assert(wideNode.FindFirstChild(_T("Item5"))->Value == _T("105"));
+		wideNode.LinkChildBefore(wideNode.GetFirstChild(), new Node(_T("Item5"), _T("First")));
+
+		uint count = 0;
+		NamedChildRange range = wideNode.FindAllChildren(_T("Item5"));
+		for (NamedChildRange::iterator it = range.begin(); it != range.end(); ++it, count++)
+			assert(count > 0 || it->Value == _T("First"));
+		assert(count == 10);
+		// Iterator stays valid after the range it came from is destroyed
+		count = 0;
+		for (NamedChildRange::iterator it = wideNode.FindAllChildren(_T("Item5")).begin(); it != NamedChildRange::iterator(); ++it)
+			count++;
+		assert(count == 10);
+
+		wideNode.DeleteAllChildren(_T("Item5"));
+		assert(wideNode.FindFirstChild(_T("Item5")) == NULL && wideNode.CalcChildCount() == 991);
+	}
+
+	// Index of a document node doesn't take new memory on every change
+	{
+		Document wideDoc;
+		Node &wideRoot = wideDoc.GetRoot();
+		for (uint i = 0; i < 1000; i++)
+			wideRoot.LinkChildAtEnd(wideRoot.CreateNode(_T("Item") + UintToStrR(i % 100), UintToStrR(i)));
+		Node *middleNode = wideRoot.FindLastChild(_T("Item50"));
+
+		size_t allocatedBytes = 0;
+		for (uint i = 0; i < 1000; i++)
+		{
+			if (i == 100)
+				allocatedBytes = wideDoc.GetAllocatedBytes();
+			assert(wideRoot.FindFirstChild(_T("Missing")) == NULL);
+			Node *newNode = wideRoot.CreateNode(_T("New") + UintToStrR(i % 10), EMPTY_STRING);
+			wideRoot.LinkChildBefore(middleNode, newNode);
+			assert(wideRoot.FindFirstChild(newNode->Name) == newNode);
+			wideRoot.DeleteChild(newNode);
+		}
+		assert(wideDoc.GetAllocatedBytes() == allocatedBytes);
+	}
+
+	// Binary format
+	{
+		Node doc;
+		{
+			Tokenizer tok(&docStr, Tokenizer::FLAG_MULTILINE_STRINGS);
+			tok.Next();
+			doc.LoadChildren(tok);
+		}
+
+		VectorStream binStream;
+		doc.SaveChildrenBinary(binStream);
+
+		binStream.Rewind();
+		Node nodeFromBinary;
+		nodeFromBinary.LoadChildrenBinary(binStream);
+
+		Document docFromBinary;
+		docFromBinary.LoadBinary(binStream.Data(), (size_t)binStream.GetSize());
+
+		tstring str1, str2;
+		{
+			TokenWriter tok(&str1);
+			nodeFromBinary.SaveChildren(tok);
+		}
+		{
+			TokenWriter tok(&str2);
+			docFromBinary.Save(tok);
+		}
+		assert(str1 == str2 && docFromBinary.GetRoot().CalcChildCount() == doc.CalcChildCount());
+
+		BinaryDocument binDoc(binStream.Data(), (size_t)binStream.GetSize());
+		BinaryNode configBinNode = binDoc.GetRoot().FindFirstChild(_T("Config"));
+		assert(!configBinNode.IsNull());
+		BinaryNode stringBinNode = configBinNode.FindFirstChild(_T("string1"));
+		assert(!stringBinNode.IsNull() && stringBinNode.GetValueStr() == stringVal);
+		assert(configBinNode.FindFirstChild(_T("stdvector1")).CalcChildCount() == _countof(arr));
+		assert(configBinNode.GetNextSibling().IsNull());
+
+		// Misaligned data - rejected by BinaryDocument, but Document loads it
+		{
+			std::vector<uint32> alignedBuf((size_t)binStream.GetSize() / sizeof(uint32) + 2);
+			char *misalignedData = (char*)&alignedBuf[0] + 1;
+			memcpy(misalignedData, binStream.Data(), (size_t)binStream.GetSize());
+			bool misalignedErrorThrown = false;
+			try
+			{
+				BinaryDocument misalignedDoc(misalignedData, (size_t)binStream.GetSize());
+			}
+			catch (const Error &)
+			{
+				misalignedErrorThrown = true;
+			}
+			assert(misalignedErrorThrown);
+			Document docFromMisaligned;
+			docFromMisaligned.LoadBinary(misalignedData, (size_t)binStream.GetSize());
+			tstring str3;
+			{
+				TokenWriter tok(&str3);
+				docFromMisaligned.Save(tok);
+			}
+			assert(str3 == str1);
+		}
+
+		// Damaged counts in the header - StringCount, StringCharCount, RecordBytes - don't allocate that much
+		for (size_t fieldOffset = 8; fieldOffset <= 16; fieldOffset += 4)
+		{
+			VectorStream badStream;
+			badStream.Write(binStream.Data(), (size_t)binStream.GetSize());
+			uint32 badCount = 0x7FFFFFF0;
+			memcpy(badStream.Data() + fieldOffset, &badCount, sizeof(badCount));
+			badStream.Rewind();
+			bool streamErrorThrown = false;
+			try
+			{
+				Document badDoc;
+				badDoc.LoadBinary(badStream);
+			}
+			catch (const Error &)
+			{
+				streamErrorThrown = true;
+			}
+			assert(streamErrorThrown);
+		}
+
+		// Damaged data
+		binStream.Data()[0] = 'X';
+		bool errorThrown = false;
+		try
+		{
+			BinaryDocument badDoc(binStream.Data(), (size_t)binStream.GetSize());
+		}
+		catch (const Error &)
+		{
+			errorThrown = true;
+		}
+		assert(errorThrown);
+	}
+
+	// Streaming reader and writer
+	{
+		Node doc;
+		{
+			Tokenizer tok(&docStr, Tokenizer::FLAG_MULTILINE_STRINGS);
+			tok.Next();
+			doc.LoadChildren(tok);
+		}
+
+		uint maxDepth = 0, beginCount = 0, endCount = 0;
+		{
+			Tokenizer tok(&docStr, Tokenizer::FLAG_MULTILINE_STRINGS);
+			tok.Next();
+			NodeReader reader(tok);
+			while (reader.Next() != NodeReader::EVENT_END)
+			{
+				if (reader.GetEvent() == NodeReader::EVENT_BEGIN_NODE)
+				{
+					beginCount++;
+					maxDepth = std::max(maxDepth, reader.GetDepth());
+				}
+				else
+					endCount++;
+			}
+			tok.AssertEOF();
+		}
+		assert(beginCount == endCount && beginCount > doc.CalcChildCount() && maxDepth == 2);
+
+		Node configNode;
+		{
+			Tokenizer tok(&docStr, Tokenizer::FLAG_MULTILINE_STRINGS);
+			tok.Next();
+			NodeReader reader(tok);
+			while (reader.Next() != NodeReader::EVENT_END)
+			{
+				if (reader.GetName() == _T("Config"))
+					reader.ReadNode(configNode);
+				else
+					reader.SkipChildren();
+				assert(reader.GetEvent() == NodeReader::EVENT_END_NODE && reader.GetDepth() == 0);
+			}
+		}
+		assert(configNode.GetFirstChild() != NULL && configNode.FindFirstChild(_T("string1"))->Value == stringVal);
+
+		tstring str1, str2;
+		{
+			TokenWriter tok(&str1);
+			doc.SaveChildren(tok);
+		}
+		{
+			TokenWriter tok(&str2);
+			NodeWriter writer(tok);
+			for (const Node *node = doc.GetFirstChild(); node != NULL; node = node->GetNextSibling())
+			{
+				if (node->Name == _T("Config"))
+				{
+					writer.BeginNode(node->Name, node->Value);
+					for (const Node *subnode = node->GetFirstChild(); subnode != NULL; subnode = subnode->GetNextSibling())
+						writer.WriteNode(*subnode);
+					writer.EndNode();
+				}
+				else
+					writer.WriteNode(*node);
+			}
+			assert(writer.GetDepth() == 0);
+		}
+		assert(str1 == str2);
+
+		// Output to a stream goes through the writer's buffer
+		VectorStream textStream;
+		{
+			TokenWriter tok(&textStream);
+			doc.SaveChildren(tok);
+			tok.WriteString(tstring(5000, _T('\n')));
+		}
+		TokenWriter::Escape(&str2, tstring(5000, _T('\n')), TokenWriter::ESCAPE_EOL);
+		str1 += _T('"') + str2 + _T('"');
+		assert(textStream.GetSize() == str1.length() * sizeof(tchar)
+			&& memcmp(textStream.Data(), str1.data(), str1.length() * sizeof(tchar)) == 0);
+	}
+}
+
+
+//HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH
+
+void Test()
+{
+	Initialize();
+	
+    TestBase();
+	TestError();
+	TestMath();
+	TestProfiler();
+	TestFlatProfiler();
+	TestStream();
+	TestEncoderDecoder();
+	TestSmartPointers();
+	TestFreeList();
+	TestDynamicFreeList();
+	TestZlibUtils();
+	TestCompression();
+	TestFiles();
+	TestDateTime();
+	TestCmdLineParser();
+	TestTokenizer();
+	TestThreads();
+	TestLogger();
+#ifdef _WIN32
+	TestBstrString();
+#endif
+	TestObjList();
+	TestTokDoc();
+
+	tstring Result;
+	g_Profiler.FormatString(&Result, PROFILER_UNITS_MILLISECONDS);
+	tcout << _T("Result:") << endl << Result << endl;
+}
+
+#ifdef _WIN32
+int _tmain(int argc, tchar* argv[], tchar* envp[])
+#else
+int main(int argc, char* argv[])
+#endif
+{
+	setlocale(LC_ALL, "polish");
+
+	try
+	{
+		Test();
+	}
+	catch (const Error& Err)
+	{
+		tcout << _T("!!!!!!!!!!! EXCEPTION !!!!!!!!!!!") << endl;
+		tstring s;
+		Err.GetMessage_(&s);
+		WriteLine(s);
+	}
+	return 0;
+}
+
+#ifdef USE_DIRECTX
+#pragma comment(lib, "d3d9.lib")
+#pragma comment(lib, "d3dx9.lib")
+#pragma comment(lib, "dxerr.lib")
+#endif